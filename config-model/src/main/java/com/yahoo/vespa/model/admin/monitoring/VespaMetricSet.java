@@ -234,6 +234,11 @@ public class VespaMetricSet {
         metrics.add(new Metric("content.proton.documentdb.attribute.resource_usage.multi_value.average"));
         metrics.add(new Metric("content.proton.documentdb.attribute.resource_usage.feeding_blocked.last"));
 
+        // ranking expression compilation
+        metrics.add(new Metric("content.proton.ranking_expression.compiled.last"));
+        metrics.add(new Metric("content.proton.ranking_expression.compile_time.last"));
+        metrics.add(new Metric("content.proton.ranking_expression.max_compile_time.last"));
+
         // transaction log
         metrics.add(new Metric("content.proton.transactionlog.entries.average"));
         metrics.add(new Metric("content.proton.transactionlog.disk_usage.average"));
@@ -42,7 +42,7 @@ public:
     { }
 
     const ConfigKey& getKey() const override { return _key; }
-    const ConfigValue & getValue() const override { return _value; }
+    const ConfigValue & getValue() const override { ++numGetValueCalls; return _value; }
     const ConfigState & getConfigState() const override { return _state; }
     bool hasValidResponse() const override { return _valid; }
     bool validateResponse() override { return _valid; }
@@ -61,6 +61,7 @@ public:
     int _errorCode;
     bool _isError;
     Trace _trace;
+    static int numGetValueCalls;
 
 
     static ConfigResponse::UP createOKResponse(const ConfigKey & key, const ConfigValue & value, uint64_t timestamp = 10, const vespalib::string & md5 = "a")
@@ -79,6 +80,8 @@ public:
     }
 };
 
+int MyConfigResponse::numGetValueCalls = 0;
+
 class MyHolder : public IConfigHolder
 {
 public:
@@ -185,6 +188,31 @@ TEST("require that important(the change) request is delivered to holder even if
     ASSERT_EQUAL("l34t", cfg2.myField);
 }
 
+TEST("require that config value is not read when only the generation changed") {
+    const ConfigKey testKey(ConfigKey::create<MyConfig>("mykey"));
+    const ConfigValue testValue(createValue("l33t", "a"));
+    IConfigHolder::SP latch(new MyHolder());
+    FRTConfigAgent handler(latch, testTimingValues);
+
+    MyConfigResponse::numGetValueCalls = 0;
+    handler.handleResponse(MyConfigRequest(testKey),
+                           MyConfigResponse::createOKResponse(testKey, testValue, 1, testValue.getMd5()));
+    ASSERT_TRUE(latch->provide());
+    int numCalls = MyConfigResponse::numGetValueCalls;
+    ASSERT_TRUE(numCalls > 0);
+
+    handler.handleResponse(MyConfigRequest(testKey),
+                           MyConfigResponse::createOKResponse(testKey, testValue, 2, testValue.getMd5()));
+    EXPECT_EQUAL(numCalls, MyConfigResponse::numGetValueCalls);
+    EXPECT_EQUAL(2, handler.getConfigState().generation);
+    ConfigUpdate::UP update(latch->provide());
+    ASSERT_TRUE(update);
+    EXPECT_FALSE(update->hasChanged());
+    EXPECT_EQUAL(2, update->getGeneration());
+    MyConfig cfg(update->getValue());
+    EXPECT_EQUAL("l33t", cfg.myField);
+}
+
 TEST("require that successful request sets correct wait time") {
     const ConfigKey testKey(ConfigKey::create<MyConfig>("mykey"));
     const ConfigValue testValue(createValue("l33t", "a"));
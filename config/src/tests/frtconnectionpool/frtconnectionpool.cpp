@@ -23,6 +23,7 @@ public:
     void testSetErrorAllHashBased();
     void testSuspensionTimeout();
     void testManySources();
+    void testSharedPool();
 };
 
 TEST_APPHOOK(Test);
@@ -61,6 +62,9 @@ int Test::Main() {
     testManySources();
     TEST_FLUSH();
 
+    testSharedPool();
+    TEST_FLUSH();
+
     TEST_DONE();
     return 0;
 }
@@ -244,3 +248,30 @@ void Test::testManySources() {
     EXPECT_EQUAL(timesUsed["host0"], (int)hostnames.size() / 2);
     EXPECT_EQUAL(timesUsed["host1"], (int)hostnames.size() / 2);
 }
+
+/**
+ * Tests that pools for the same config servers are shared while in use.
+ */
+void Test::testSharedPool() {
+    const ServerSpec spec(_sources);
+    ConnectionFactory::SP pool1 = FRTConnectionPool::getShared(spec, timingValues);
+    ConnectionFactory::SP pool2 = FRTConnectionPool::getShared(ServerSpec(_sources), timingValues);
+    EXPECT_TRUE(pool1.get() == pool2.get());
+
+    ServerSpec::HostSpecList otherSources;
+    otherSources.push_back("host3");
+    ConnectionFactory::SP otherPool = FRTConnectionPool::getShared(ServerSpec(otherSources), timingValues);
+    EXPECT_TRUE(pool1.get() != otherPool.get());
+
+    TimingValues otherTimingValues;
+    otherTimingValues.fatalDelay += 1000;
+    ConnectionFactory::SP otherTimingPool = FRTConnectionPool::getShared(spec, otherTimingValues);
+    EXPECT_TRUE(pool1.get() != otherTimingPool.get());
+
+    std::weak_ptr<ConnectionFactory> released(pool1);
+    pool1.reset();
+    pool2.reset();
+    EXPECT_TRUE(released.expired());
+    ConnectionFactory::SP pool3 = FRTConnectionPool::getShared(spec, timingValues);
+    EXPECT_TRUE(pool3.get() != nullptr);
+}
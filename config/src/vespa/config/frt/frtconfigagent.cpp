@@ -47,24 +47,30 @@ FRTConfigAgent::handleOKResponse(const ConfigRequest & request, ConfigResponse::
 
     ConfigState newState = response->getConfigState();
     if ( ! request.verifyState(newState)) {
-        handleUpdatedGeneration(response->getKey(), newState, response->getValue());
+        handleUpdatedGeneration(response->getKey(), newState, *response);
     }
     setWaitTime(_timingValues.successDelay, 1);
     _nextTimeout = _timingValues.successTimeout;
 }
 
 void
-FRTConfigAgent::handleUpdatedGeneration(const ConfigKey & key, const ConfigState & newState, const ConfigValue & configValue)
+FRTConfigAgent::handleUpdatedGeneration(const ConfigKey & key, const ConfigState & newState, const ConfigResponse & response)
 {
-    if (LOG_WOULD_LOG(spam)) {
-        LOG(spam, "new generation %ld md5:%s for key %s", newState.generation, newState.md5.c_str(), key.toString().c_str());
-        LOG(spam, "Old config: md5:%s \n%s", _latest.getMd5().c_str(), _latest.asJson().c_str());
-        LOG(spam, "New config: md5:%s \n%s", configValue.getMd5().c_str(), configValue.asJson().c_str());
-    }
     bool changed = false;
-    if (_latest.getMd5() != configValue.getMd5()) {
-        _latest = configValue;
-        changed = true;
+    // Only decode the payload when the content differs from what we have
+    if (_latest.getMd5() != newState.md5) {
+        const ConfigValue & configValue(response.getValue());
+        if (LOG_WOULD_LOG(spam)) {
+            LOG(spam, "new generation %ld md5:%s for key %s", newState.generation, newState.md5.c_str(), key.toString().c_str());
+            LOG(spam, "Old config: md5:%s \n%s", _latest.getMd5().c_str(), _latest.asJson().c_str());
+            LOG(spam, "New config: md5:%s \n%s", configValue.getMd5().c_str(), configValue.asJson().c_str());
+        }
+        if (_latest.getMd5() != configValue.getMd5()) {
+            _latest = configValue;
+            changed = true;
+        }
+    } else if (LOG_WOULD_LOG(spam)) {
+        LOG(spam, "new generation %ld with unchanged md5:%s for key %s", newState.generation, newState.md5.c_str(), key.toString().c_str());
     }
     _configState = newState;
 
@@ -32,7 +32,7 @@ public:
     uint64_t getWaitTime() const override;
     const ConfigState & getConfigState() const override;
 private:
-    void handleUpdatedGeneration(const ConfigKey & key, const ConfigState & newState, const ConfigValue & configValue);
+    void handleUpdatedGeneration(const ConfigKey & key, const ConfigState & newState, const ConfigResponse & response);
     void handleOKResponse(const ConfigRequest & request, ConfigResponse::UP response);
     void handleErrorResponse(const ConfigRequest & request, ConfigResponse::UP response);
     void setWaitTime(uint64_t delay, int multiplier);
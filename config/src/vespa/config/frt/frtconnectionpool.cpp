@@ -2,11 +2,31 @@
 
 #include "frtconnectionpool.h"
 #include <vespa/vespalib/util/host_name.h>
+#include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/fnet/frt/supervisor.h>
 #include <vespa/fnet/transport.h>
+#include <mutex>
 
 namespace config {
 
+namespace {
+
+std::mutex _sharedLock;
+std::map<vespalib::string, std::weak_ptr<ConnectionFactory>> _sharedPools;
+
+vespalib::string
+makeSharedKey(const ServerSpec & spec, const TimingValues & timingValues)
+{
+    vespalib::asciistream key;
+    for (size_t i(0); i < spec.numHosts(); i++) {
+        key << spec.getHost(i) << ",";
+    }
+    key << timingValues.transientDelay << ":" << timingValues.fatalDelay;
+    return key.str();
+}
+
+}
+
 FRTConnectionPool::FRTConnectionKey::FRTConnectionKey(int idx, const vespalib::string& hostname)
     : _idx(idx),
       _hostname(hostname)
@@ -44,6 +64,26 @@ FRTConnectionPool::~FRTConnectionPool()
     _supervisor->ShutDown(true);
 }
 
+ConnectionFactory::SP
+FRTConnectionPool::getShared(const ServerSpec & spec, const TimingValues & timingValues)
+{
+    vespalib::string key(makeSharedKey(spec, timingValues));
+    std::lock_guard<std::mutex> guard(_sharedLock);
+    for (auto itr = _sharedPools.begin(); itr != _sharedPools.end();) {
+        if (itr->second.expired()) {
+            itr = _sharedPools.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+    ConnectionFactory::SP pool(_sharedPools[key].lock());
+    if (!pool) {
+        pool = std::make_shared<FRTConnectionPool>(spec, timingValues);
+        _sharedPools[key] = pool;
+    }
+    return pool;
+}
+
 void
 FRTConnectionPool::syncTransport()
 {
@@ -42,6 +42,20 @@ public:
     FRTConnectionPool(const ServerSpec & spec, const TimingValues & timingValues);
     ~FRTConnectionPool();
 
+    /**
+     * Returns a connection pool shared by all source factories using the
+     * same config servers and timing values, creating it if no such pool
+     * is alive. Sharing the pool lets all config contexts in a process use
+     * a single supervisor, transport thread and set of connections instead
+     * of one per context. All use of the connections happens in tasks run
+     * by the transport thread of the pool, so no extra locking is needed.
+     *
+     * @param spec the config servers to connect to
+     * @param timingValues timing values used by the connections
+     * @return the shared connection pool
+     */
+    static ConnectionFactory::SP getShared(const ServerSpec & spec, const TimingValues & timingValues);
+
     void syncTransport() override;
 
     /**
@@ -4,8 +4,8 @@
 
 namespace config {
 
-FRTSourceFactory::FRTSourceFactory(ConnectionFactory::UP connectionFactory, const TimingValues & timingValues, int protocolVersion, int traceLevel, const VespaVersion & vespaVersion, const CompressionType & compressionType)
-    : _connectionFactory(connectionFactory.release()),
+FRTSourceFactory::FRTSourceFactory(ConnectionFactory::SP connectionFactory, const TimingValues & timingValues, int protocolVersion, int traceLevel, const VespaVersion & vespaVersion, const CompressionType & compressionType)
+    : _connectionFactory(std::move(connectionFactory)),
       _requestFactory(protocolVersion, traceLevel, vespaVersion, compressionType),
       _timingValues(timingValues)
 {
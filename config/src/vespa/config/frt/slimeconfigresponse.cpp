@@ -18,7 +18,8 @@ SlimeConfigResponse::SlimeConfigResponse(FRT_RPCRequest * request)
       _key(),
       _value(),
       _trace(),
-      _filled(false)
+      _filled(false),
+      _valueFilled(false)
 {
 }
 
@@ -35,7 +36,6 @@ SlimeConfigResponse::fill()
     _data.reset(data);
     _key = readKey();
     _state = readState();
-    _value = readConfigValue();
     readTrace();
     _filled = true;
     if (LOG_WOULD_LOG(debug)) {
@@ -43,6 +43,17 @@ SlimeConfigResponse::fill()
     }
 }
 
+const ConfigValue &
+SlimeConfigResponse::getValue() const
+{
+    // The payload is decoded on demand, as it is not needed when only the generation changed
+    if ( ! _valueFilled) {
+        _value = readConfigValue();
+        _valueFilled = true;
+    }
+    return _value;
+}
+
 void
 SlimeConfigResponse::readTrace()
 {
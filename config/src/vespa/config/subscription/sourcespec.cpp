@@ -123,7 +123,7 @@ SourceFactory::UP
 ServerSpec::createSourceFactory(const TimingValues & timingValues) const
 {
     const auto vespaVersion = VespaVersion::getCurrentVersion();
-    return SourceFactory::UP(new FRTSourceFactory(ConnectionFactory::UP(new FRTConnectionPool(*this, timingValues)), timingValues, _protocolVersion, _traceLevel, vespaVersion, _compressionType));
+    return SourceFactory::UP(new FRTSourceFactory(FRTConnectionPool::getShared(*this, timingValues), timingValues, _protocolVersion, _traceLevel, vespaVersion, _compressionType));
 }
 
 
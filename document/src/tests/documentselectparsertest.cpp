@@ -46,6 +46,7 @@ class DocumentSelectParserTest : public CppUnit::TestFixture {
     CPPUNIT_TEST(test_function_call_on_doctype_throws_exception);
     CPPUNIT_TEST(test_parse_utilities_handle_well_formed_input);
     CPPUNIT_TEST(test_parse_utilities_handle_malformed_input);
+    CPPUNIT_TEST(test_regex_and_glob_matching_with_many_distinct_expressions);
     CPPUNIT_TEST_SUITE_END();
 
     BucketIdFactory _bucketIdFactory;
@@ -111,6 +112,7 @@ public:
     void test_function_call_on_doctype_throws_exception();
     void test_parse_utilities_handle_well_formed_input();
     void test_parse_utilities_handle_malformed_input();
+    void test_regex_and_glob_matching_with_many_distinct_expressions();
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(DocumentSelectParserTest);
@@ -1238,6 +1240,23 @@ void DocumentSelectParserTest::testDocumentUpdates4()
     PARSEI("-6 % 10 = -6", *_update[0], True);
 }
 
+void DocumentSelectParserTest::test_regex_and_glob_matching_with_many_distinct_expressions()
+{
+    createDocs();
+    // Compiled expressions are cached between evaluations, make sure
+    // results stay correct both for repeated and for more expressions
+    // than the cache holds.
+    for (int round = 0; round < 2; ++round) {
+        for (int i = 0; i < 100; ++i) {
+            std::string num(std::to_string(i));
+            PARSE("\"foo" + num + "\" =~ \"^foo" + num + "$\"", *_doc[0], True);
+            PARSE("\"foo" + num + "\" =~ \"^bar" + num + "$\"", *_doc[0], False);
+            PARSE("\"foo" + num + "\" = \"f*" + num + "\"", *_doc[0], True);
+            PARSE("\"foo" + num + "\" = \"b*" + num + "\"", *_doc[0], False);
+        }
+    }
+}
+
 void DocumentSelectParserTest::testUtf8()
 {
     createDocs();
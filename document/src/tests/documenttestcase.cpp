@@ -46,6 +46,7 @@ struct DocumentTest : public CppUnit::TestFixture {
     void testAnnotationDeserialization();
     void testGetSerializedSize();
     void testDeserializeMultiple();
+    void testDeserializeWithBackingBuffer();
     void testSizeOf();
 
     CPPUNIT_TEST_SUITE(DocumentTest);
@@ -70,6 +71,7 @@ struct DocumentTest : public CppUnit::TestFixture {
     CPPUNIT_TEST(testAnnotationDeserialization);
     CPPUNIT_TEST(testGetSerializedSize);
     CPPUNIT_TEST(testDeserializeMultiple);
+    CPPUNIT_TEST(testDeserializeWithBackingBuffer);
     CPPUNIT_TEST(testSizeOf);
     CPPUNIT_TEST_SUITE_END();
 };
@@ -78,7 +80,7 @@ CPPUNIT_TEST_SUITE_REGISTRATION(DocumentTest);
 
 void DocumentTest::testSizeOf()
 {
-    CPPUNIT_ASSERT_EQUAL(136ul, sizeof(Document));
+    CPPUNIT_ASSERT_EQUAL(160ul, sizeof(Document));
     CPPUNIT_ASSERT_EQUAL(72ul, sizeof(StructFieldValue));
     CPPUNIT_ASSERT_EQUAL(24ul, sizeof(StructuredFieldValue));
     CPPUNIT_ASSERT_EQUAL(64ul, sizeof(SerializableArray));
@@ -1431,4 +1433,46 @@ DocumentTest::testDeserializeMultiple()
     CPPUNIT_ASSERT_EQUAL(correct, sv3);
 }
 
+void
+DocumentTest::testDeserializeWithBackingBuffer()
+{
+    TestDocRepo testDocRepo;
+    const DocumentTypeRepo& repo(testDocRepo.getTypeRepo());
+    const DocumentType* docType(repo.getDocumentType("testdoctype1"));
+    CPPUNIT_ASSERT(docType != 0);
+
+    Document doc1(*docType, DocumentId("doc:test:1"));
+    doc1.setValue(doc1.getField("headerval"), IntFieldValue(42));
+    doc1.setValue(doc1.getField("content"), StringFieldValue("badger"));
+    Document doc2(*docType, DocumentId("doc:test:2"));
+    doc2.setValue(doc2.getField("content"), StringFieldValue("mushroom"));
+
+    vespalib::nbostream stream;
+    doc1.serialize(stream);
+    doc2.serialize(stream);
+    vespalib::nbostream copy(stream.peek(), stream.size());
+
+    Document result1;
+    Document result2;
+    {
+        vespalib::nbostream input(stream.peek(), stream.size());
+        result1.deserializeWithBackingBuffer(repo, input);
+        result2.deserializeWithBackingBuffer(repo, input);
+        CPPUNIT_ASSERT_EQUAL(size_t(0), input.size());
+        // Overwrite the input, the documents must not refer to it.
+        memset(const_cast<char *>(stream.peek()), 0, stream.size());
+    }
+    CPPUNIT_ASSERT_EQUAL(doc1, result1);
+    CPPUNIT_ASSERT_EQUAL(doc2, result2);
+
+    // Copies own their data and outlive the original.
+    std::unique_ptr<Document> copied(new Document(result1));
+    result1 = Document();
+    CPPUNIT_ASSERT_EQUAL(doc1, *copied);
+
+    Document plain;
+    plain.deserialize(repo, copy);
+    CPPUNIT_ASSERT_EQUAL(doc1, plain);
+}
+
 } // document
@@ -22,10 +22,12 @@ struct StructFieldValueTest : public CppUnit::TestFixture {
 
     void testStruct();
     void testEmptyStruct();
+    void testNumericFieldValueWithoutMaterializing();
 
     CPPUNIT_TEST_SUITE(StructFieldValueTest);
     CPPUNIT_TEST(testStruct);
     CPPUNIT_TEST(testEmptyStruct);
+    CPPUNIT_TEST(testNumericFieldValueWithoutMaterializing);
 
     CPPUNIT_TEST_SUITE_END();
 
@@ -50,7 +52,9 @@ createBuilder() {
                      Struct("test.header")
                              .addField("int", DataType::T_INT)
                              .addField("long", DataType::T_LONG)
-                             .addField("content", DataType::T_STRING),
+                             .addField("content", DataType::T_STRING)
+                             .addField("byte", DataType::T_BYTE)
+                             .addField("double", DataType::T_DOUBLE),
                      Struct("test.body"));
     return builder;
 }
@@ -78,6 +82,40 @@ void StructFieldValueTest::testEmptyStruct()
     CPPUNIT_ASSERT(value == value2);
 }
 
+void StructFieldValueTest::testNumericFieldValueWithoutMaterializing()
+{
+    FixedTypeRepo repo(doc_repo, *doc_repo.getDocumentType(42));
+    const DataType &type = *repo.getDataType("test.header");
+    StructFieldValue value(type);
+    const Field &intF = value.getField("int");
+    const Field &longF = value.getField("long");
+    const Field &byteF = value.getField("byte");
+    const Field &doubleF = value.getField("double");
+    const Field &strF = value.getField("content");
+    value.setValue(intF, IntFieldValue(-7));
+    value.setValue(byteF, ByteFieldValue(-3));
+    value.setValue(doubleF, DoubleFieldValue(2.5));
+    value.setValue(strF, StringFieldValue("foo"));
+
+    std::unique_ptr<ByteBuffer> buffer(value.serialize());
+    buffer->flip();
+    StructFieldValue value2(type);
+    deserialize(*buffer, value2, repo);
+
+    int64_t intValue = 0;
+    double doubleValue = 0.0;
+    CPPUNIT_ASSERT(value2.getIntegerFieldValue(intF, intValue));
+    CPPUNIT_ASSERT_EQUAL(int64_t(-7), intValue);
+    CPPUNIT_ASSERT(value2.getIntegerFieldValue(byteF, intValue));
+    CPPUNIT_ASSERT_EQUAL(int64_t(-3), intValue);
+    CPPUNIT_ASSERT(!value2.getIntegerFieldValue(longF, intValue));
+    CPPUNIT_ASSERT(!value2.getIntegerFieldValue(strF, intValue));
+    CPPUNIT_ASSERT(!value2.getIntegerFieldValue(doubleF, intValue));
+    CPPUNIT_ASSERT(value2.getFloatingPointFieldValue(doubleF, doubleValue));
+    CPPUNIT_ASSERT_EQUAL(2.5, doubleValue);
+    CPPUNIT_ASSERT(!value2.getFloatingPointFieldValue(intF, doubleValue));
+}
+
 void StructFieldValueTest::testStruct()
 {
     const DocumentType *doc_type = doc_repo.getDocumentType(42);
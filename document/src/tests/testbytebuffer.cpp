@@ -488,4 +488,31 @@ void ByteBuffer_Test::test_SerializableArray()
     CPPUNIT_ASSERT(copy.get(0).c_str() != array.get(0).c_str());
     CPPUNIT_ASSERT_EQUAL(0, strcmp(copy.get(0).c_str(), array.get(0).c_str()));
     CPPUNIT_ASSERT_EQUAL(16ul, sizeof(SerializableArray::Entry));
+
+    SerializableArray sorted;
+    sorted.set(30, "c", 1);
+    sorted.set(10, "a", 1);
+    sorted.set(20, "bb", 2);
+    sorted.set(10, "aaa", 3);
+    CPPUNIT_ASSERT(sorted.isSortedById());
+    CPPUNIT_ASSERT_EQUAL(3ul, sorted.getEntries().size());
+    CPPUNIT_ASSERT_EQUAL(10, sorted.getEntries()[0].id());
+    CPPUNIT_ASSERT_EQUAL(20, sorted.getEntries()[1].id());
+    CPPUNIT_ASSERT_EQUAL(30, sorted.getEntries()[2].id());
+    CPPUNIT_ASSERT_EQUAL(3ul, sorted.get(10).size());
+    CPPUNIT_ASSERT_EQUAL(2ul, sorted.get(20).size());
+    CPPUNIT_ASSERT(!sorted.has(15));
+    sorted.clear(20);
+    CPPUNIT_ASSERT(!sorted.has(20));
+    CPPUNIT_ASSERT(sorted.has(30));
+
+    SerializableArray unsorted;
+    SerializableArray::EntryMap entries;
+    entries.push_back(SerializableArray::Entry(7, 1, 0u));
+    entries.push_back(SerializableArray::Entry(3, 2, 1u));
+    unsorted.assign(entries, std::unique_ptr<ByteBuffer>(ByteBuffer::copyBuffer("xyz", 3)),
+                    vespalib::compression::CompressionConfig::NONE, 3);
+    CPPUNIT_ASSERT(!unsorted.isSortedById());
+    CPPUNIT_ASSERT_EQUAL(0, strncmp("x", unsorted.get(7).c_str(), 1));
+    CPPUNIT_ASSERT_EQUAL(0, strncmp("yz", unsorted.get(3).c_str(), 2));
 }
@@ -13,6 +13,7 @@
 #include <vespa/vespalib/util/xmlstream.h>
 #include <sstream>
 #include <limits>
+#include <arpa/inet.h>
 
 using vespalib::nbostream;
 using vespalib::make_string;
@@ -155,6 +156,7 @@ Document::swap(Document & rhs)
     _fields.swap(rhs._fields);
     _id.swap(rhs._id);
     std::swap(_lastModified, rhs._lastModified);
+    _backingBuffer.swap(rhs._backingBuffer);
 }
 
 const DocumentType&
@@ -416,6 +418,33 @@ void Document::deserialize(const DocumentTypeRepo& repo, vespalib::nbostream & o
     }
 }
 
+void Document::deserializeWithBackingBuffer(const DocumentTypeRepo& repo, vespalib::nbostream & os) {
+    const size_t headerSize = sizeof(uint16_t) + sizeof(uint32_t);
+    if (os.size() < headerSize) {
+        deserialize(repo, os);
+        return;
+    }
+    uint16_t version;
+    uint32_t len;
+    memcpy(&version, os.peek(), sizeof(version));
+    memcpy(&len, os.peek() + sizeof(version), sizeof(len));
+    version = ntohs(version);
+    len = ntohl(len);
+    size_t docSize = headerSize + len;
+    if ((version < 7) || (docSize > os.size())) {
+        // Older formats do not carry a fixed size length, let the ordinary path handle (or reject) them.
+        deserialize(repo, os);
+        return;
+    }
+    vespalib::alloc::Alloc oldBuffer;
+    oldBuffer.swap(_backingBuffer);
+    vespalib::alloc::Alloc::alloc(docSize).swap(_backingBuffer);
+    memcpy(_backingBuffer.get(), os.peek(), docSize);
+    vespalib::nbostream_longlivedbuf stream(_backingBuffer.get(), docSize);
+    deserialize(repo, stream);
+    os.adjustReadPos(docSize);
+}
+
 void Document::deserialize(const DocumentTypeRepo& repo, ByteBuffer& data) {
     nbostream stream(data.getBufferAtPos(), data.getRemaining());
     deserialize(repo, stream);
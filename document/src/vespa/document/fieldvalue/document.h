@@ -18,6 +18,7 @@
 #include "structfieldvalue.h"
 #include <vespa/document/base/documentid.h>
 #include <vespa/document/base/field.h>
+#include <vespa/vespalib/util/alloc.h>
 
 namespace document {
 
@@ -26,6 +27,8 @@ class Document : public StructuredFieldValue
 private:
     DocumentId _id;
     StructFieldValue _fields;
+    // Serialized form the fields refer into, see deserializeWithBackingBuffer.
+    vespalib::alloc::Alloc _backingBuffer;
 
         // To avoid having to return another container object out of docblocks
         // the meta data has been added to document. This will not be serialized
@@ -128,6 +131,13 @@ public:
     /** Deserialize document contained in given bytebuffer. */
     void deserialize(const DocumentTypeRepo& repo, ByteBuffer& data);
     void deserialize(const DocumentTypeRepo& repo, vespalib::nbostream & os);
+    /**
+     * Copies the serialized document into one buffer owned by this document
+     * and deserializes from it. Struct chunks and string values then refer
+     * into that buffer instead of being allocated one by one, and they are
+     * all freed together with the document.
+     */
+    void deserializeWithBackingBuffer(const DocumentTypeRepo& repo, vespalib::nbostream & os);
     /** Deserialize document contained in given bytebuffers. */
     void deserialize(const DocumentTypeRepo& repo, ByteBuffer& body, ByteBuffer& header);
     void deserializeHeader(const DocumentTypeRepo& repo, ByteBuffer& header);
@@ -28,8 +28,22 @@ public:
 
 SerializableArray::Statistics SerializableArray::_stats;
 
+namespace {
+
+bool lessById(const SerializableArray::Entry & lhs, int id) { return lhs.id() < id; }
+
+bool
+strictlyOrderedById(const SerializableArray::EntryMap & entries)
+{
+    return std::adjacent_find(entries.begin(), entries.end(),
+                              [](const auto & a, const auto & b) { return a.id() >= b.id(); }) == entries.end();
+}
+
+}
+
 SerializableArray::SerializableArray()
     : _serializedCompression(CompressionConfig::NONE),
+      _sortedById(true),
       _uncompressedLength(0)
 {
 }
@@ -48,6 +62,7 @@ SerializableArray::SerializableArray(const SerializableArray& other)
       _uncompSerData(other._uncompSerData.get() ? new ByteBuffer(*other._uncompSerData) : NULL),
       _compSerData(other._compSerData.get() ? new ByteBuffer(*other._compSerData) : NULL),
       _serializedCompression(other._serializedCompression),
+      _sortedById(other._sortedById),
       _uncompressedLength(other._uncompressedLength)
 {
     for (size_t i(0); i < _entries.size(); i++) {
@@ -73,7 +88,10 @@ SerializableArray::swap(SerializableArray& other)
     _owned.swap(other._owned);
     std::swap(_uncompSerData, other._uncompSerData);
     std::swap(_compSerData, other._compSerData);
-    std::swap(_serializedCompression, other._serializedCompression);
+    CompressionConfig::Type compression = _serializedCompression;
+    _serializedCompression = other._serializedCompression;
+    other._serializedCompression = compression;
+    std::swap(_sortedById, other._sortedById);
     std::swap(_uncompressedLength, other._uncompressedLength);
 }
 
@@ -84,6 +102,7 @@ void SerializableArray::clear()
     _compSerData.reset();
     _serializedCompression = CompressionConfig::NONE;
     _uncompressedLength = 0;
+    _sortedById = true;
 }
 
 SerializableArray::~SerializableArray()
@@ -102,11 +121,20 @@ SerializableArray::set(int id, ByteBuffer::UP buffer)
     maybeDecompress();
     Entry e(id, buffer->getRemaining(), buffer->getBuffer());
     ensure(_owned)[id] = std::move(buffer);
-    EntryMap::iterator it = find(id);
-    if (it == _entries.end()) {
-        _entries.push_back(e);
+    if (_sortedById) {
+        EntryMap::iterator it = std::lower_bound(_entries.begin(), _entries.end(), id, lessById);
+        if (it == _entries.end() || it->id() != id) {
+            _entries.insert(it, e);
+        } else {
+            *it = e;
+        }
     } else {
-        *it = e;
+        EntryMap::iterator it = find(id);
+        if (it == _entries.end()) {
+            _entries.push_back(e);
+        } else {
+            *it = e;
+        }
     }
     invalidate();
 }
@@ -119,12 +147,20 @@ void SerializableArray::set(int id, const char* value, int len)
 SerializableArray::EntryMap::const_iterator
 SerializableArray::find(int id) const
 {
+    if (_sortedById) {
+        EntryMap::const_iterator it = std::lower_bound(_entries.begin(), _entries.end(), id, lessById);
+        return (it != _entries.end() && it->id() == id) ? it : _entries.end();
+    }
     return std::find_if(_entries.begin(), _entries.end(), [id](const auto& e){ return e.id() == id; });
 }
 
 SerializableArray::EntryMap::iterator
 SerializableArray::find(int id)
 {
+    if (_sortedById) {
+        EntryMap::iterator it = std::lower_bound(_entries.begin(), _entries.end(), id, lessById);
+        return (it != _entries.end() && it->id() == id) ? it : _entries.end();
+    }
     return std::find_if(_entries.begin(), _entries.end(), [id](const auto& e){ return e.id() == id; });
 }
 
@@ -230,6 +266,7 @@ void SerializableArray::assign(EntryMap & entries,
 
     _entries.clear();
     _entries.swap(entries);
+    _sortedById = strictlyOrderedById(_entries);
     if (CompressionConfig::isCompressed(_serializedCompression)) {
         _compSerData.reset(buffer.release());
         _uncompressedLength = uncompressed_length;
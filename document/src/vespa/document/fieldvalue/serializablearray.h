@@ -179,6 +179,12 @@ public:
     SerializableArray(const SerializableArray&); // Public only for test
     SerializableArray& operator=(const SerializableArray&) = delete;
     const EntryMap & getEntries() const { return _entries; }
+    /**
+     * True when the entries are strictly ordered by field id, which allows
+     * lookup by binary search. Entries added with set() keep this order;
+     * deserialized entries keep their wire order, which is normally sorted.
+     */
+    bool isSortedById() const { return _sortedById; }
 private:
     bool shouldDecompress() const {
         return _compSerData.get() && !_uncompSerData.get();
@@ -206,7 +212,8 @@ private:
     /** Data we deserialized from, if applicable. */
     ByteBufferUP             _uncompSerData;
     ByteBufferUP             _compSerData;
-    CompressionConfig::Type  _serializedCompression;
+    CompressionConfig::Type  _serializedCompression : 8;
+    bool                     _sortedById;
 
     uint32_t     _uncompressedLength;
 
@@ -125,6 +125,16 @@ bool StructFieldValue::serializeField(int field_id, uint16_t version,
 void StructFieldValue::getRawFieldIds(vector<int> &raw_ids) const {
     raw_ids.clear();
 
+    if (_chunks.size() == 1 && _chunks[0].isSortedById()) {
+        // Common case: ids are already unique and in order.
+        const SerializableArray::EntryMap & entries = _chunks[0].getEntries();
+        raw_ids.reserve(entries.size());
+        for (const SerializableArray::Entry & entry : entries) {
+            raw_ids.emplace_back(entry.id());
+        }
+        return;
+    }
+
     size_t count(0);
     for (uint32_t i = 0; i < _chunks.size(); ++i) {
         count += _chunks[i].getEntries().size();
@@ -216,6 +226,51 @@ StructFieldValue::getRawField(uint32_t id) const
     return vespalib::ConstBufferRef();
 }
 
+bool
+StructFieldValue::getIntegerFieldValue(const Field &field, int64_t &value) const
+{
+    int typeId = field.getDataType().getId();
+    if (typeId != DataType::T_BYTE && typeId != DataType::T_SHORT &&
+        typeId != DataType::T_INT && typeId != DataType::T_LONG)
+    {
+        return false;
+    }
+    vespalib::ConstBufferRef buf = getRawField(field.getId());
+    if (buf.size() == 0) {
+        return false;
+    }
+    nbostream_longlivedbuf stream(buf.c_str(), buf.size());
+    switch (typeId) {
+    case DataType::T_BYTE:  { int8_t v;   stream >> v; value = v; break; }
+    case DataType::T_SHORT: { uint16_t v; stream >> v; value = static_cast<int16_t>(v); break; }
+    case DataType::T_INT:   { uint32_t v; stream >> v; value = static_cast<int32_t>(v); break; }
+    default:                { uint64_t v; stream >> v; value = static_cast<int64_t>(v); break; }
+    }
+    return true;
+}
+
+bool
+StructFieldValue::getFloatingPointFieldValue(const Field &field, double &value) const
+{
+    int typeId = field.getDataType().getId();
+    if (typeId != DataType::T_FLOAT && typeId != DataType::T_DOUBLE) {
+        return false;
+    }
+    vespalib::ConstBufferRef buf = getRawField(field.getId());
+    if (buf.size() == 0) {
+        return false;
+    }
+    nbostream_longlivedbuf stream(buf.c_str(), buf.size());
+    if (typeId == DataType::T_FLOAT) {
+        float v;
+        stream >> v;
+        value = v;
+    } else {
+        stream >> value;
+    }
+    return true;
+}
+
 bool
 StructFieldValue::getFieldValue(const Field& field, FieldValue& value) const
 {
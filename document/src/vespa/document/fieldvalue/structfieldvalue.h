@@ -76,6 +76,19 @@ public:
 
     const Chunks & getChunks() const {  return _chunks; }
 
+    /**
+     * Read a byte, short, int or long field directly from its serialized
+     * form without creating a FieldValue. Returns false if the field is
+     * not set or is not of one of those types.
+     */
+    bool getIntegerFieldValue(const Field &field, int64_t &value) const;
+    /**
+     * Read a float or double field directly from its serialized form
+     * without creating a FieldValue. Returns false if the field is not set
+     * or is not of one of those types.
+     */
+    bool getFloatingPointFieldValue(const Field &field, double &value) const;
+
     // raw_ids may contain ids for elements not in the struct's datatype.
     void getRawFieldIds(std::vector<int> &raw_ids) const;
     void getRawFieldIds(std::vector<int> &raw_ids, const FieldSet& fieldSet) const;
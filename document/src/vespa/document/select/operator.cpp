@@ -5,6 +5,7 @@
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
 #include <cassert>
+#include <memory>
 
 namespace document::select {
 
@@ -119,13 +120,44 @@ RegexOperator::traceImpl(const Value& a, const Value& b, std::ostream& out) cons
     return result;
 }
 
+namespace {
+
+// Selections are evaluated for every document visited, and the
+// expression string of a regex or glob comparison is almost always a
+// constant from the selection itself. Keep the compiled expressions
+// around per thread instead of compiling them again for each document.
+// The cache is simply dropped if a selection turns out to produce a lot
+// of distinct expressions.
+constexpr size_t MAX_CACHED_REGEXPS = 64;
+
+using RegexpCache = vespalib::hash_map<vespalib::string, std::unique_ptr<vespalib::Regexp>>;
+
+thread_local RegexpCache _tlRegexpCache;
+
+const vespalib::Regexp &
+getCompiledRegexp(const vespalib::stringref & expr)
+{
+    RegexpCache::iterator it = _tlRegexpCache.find(expr);
+    if (it != _tlRegexpCache.end()) {
+        return *it->second;
+    }
+    if (_tlRegexpCache.size() >= MAX_CACHED_REGEXPS) {
+        _tlRegexpCache.clear();
+    }
+    std::unique_ptr<vespalib::Regexp> compiled(std::make_unique<vespalib::Regexp>(expr));
+    const vespalib::Regexp &result(*compiled);
+    _tlRegexpCache[expr] = std::move(compiled);
+    return result;
+}
+
+}
+
 ResultList
 RegexOperator::match(const vespalib::string& val, const vespalib::stringref & expr) const
 {
         // Should we catch this in parsing?
     if (expr.size() == 0) return ResultList(Result::True);
-    vespalib::Regexp expression(expr);
-    return ResultList(Result::get(expression.match(val)));
+    return ResultList(Result::get(getCompiledRegexp(expr).match(val)));
 }
 
 const RegexOperator RegexOperator::REGEX("=~");
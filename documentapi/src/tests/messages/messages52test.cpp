@@ -60,6 +60,24 @@ Messages52Test::testPutDocumentMessage()
         }
     }
 
+    DocumentProtocol lazyProtocol(_loadTypes, getTypeRepoSp(), "", true);
+    mbus::Blob blob = encode(msg);
+    auto lazyUp = lazyProtocol.decode(getVersion(), blob);
+    if (EXPECT_TRUE(lazyUp.get() != nullptr)) {
+        auto & lazyMsg = static_cast<PutDocumentMessage &>(*lazyUp);
+        EXPECT_TRUE(lazyMsg.hasSerializedDocument());
+        EXPECT_EQUAL(msg.getTimestamp(), lazyMsg.getTimestamp());
+        EXPECT_EQUAL(msg.getCondition().getSelection(), lazyMsg.getCondition().getSelection());
+
+        mbus::Blob forwarded = lazyProtocol.encode(getVersion(), lazyMsg);
+        EXPECT_TRUE(lazyMsg.hasSerializedDocument());
+        EXPECT_EQUAL(blob.size(), forwarded.size());
+        EXPECT_EQUAL(0, memcmp(blob.data(), forwarded.data(), blob.size()));
+
+        EXPECT_EQUAL(msg.getDocument().getId().toString(), lazyMsg.getDocument().getId().toString());
+        EXPECT_FALSE(lazyMsg.hasSerializedDocument());
+    }
+
     return true;
 }
 
@@ -196,11 +196,18 @@ public:
     /**
      * Constructs a new document protocol using the given id for config subscription.
      *
-     * @param configId The id to use when subscribing to config.
+     * @param configId     The id to use when subscribing to config.
+     * @param lazyDocument Whether to defer deserialization of the document in
+     *                     received put messages until it is accessed. A node
+     *                     that only forwards puts then passes the original
+     *                     bytes on instead of serializing the document again.
+     *                     A corrupt document is then no longer reported as a
+     *                     decode error, but as an exception when accessed.
      */
     DocumentProtocol(const LoadTypeSet& loadTypes,
                      std::shared_ptr<document::DocumentTypeRepo> repo,
-                     const string &configId = "");
+                     const string &configId = "",
+                     bool lazyDocument = false);
     ~DocumentProtocol();
 
     /**
@@ -3,6 +3,7 @@
 #include "writedocumentreply.h"
 #include <vespa/documentapi/messagebus/documentprotocol.h>
 #include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/util/bytebuffer.h>
 #include <vespa/vespalib/util/exceptions.h>
 
 namespace documentapi {
@@ -10,12 +11,16 @@ namespace documentapi {
 PutDocumentMessage::PutDocumentMessage() :
     TestAndSetMessage(),
     _document(),
+    _serializedDocument(),
+    _repo(nullptr),
     _time(0)
 {}
 
 PutDocumentMessage::PutDocumentMessage(document::Document::SP document) :
     TestAndSetMessage(),
     _document(),
+    _serializedDocument(),
+    _repo(nullptr),
     _time(0)
 {
     setDocument(std::move(document));
@@ -38,7 +43,7 @@ PutDocumentMessage::hasSequenceId() const
 uint64_t
 PutDocumentMessage::getSequenceId() const
 {
-    return *reinterpret_cast<const uint64_t*>(_document->getId().getGlobalId().get());
+    return *reinterpret_cast<const uint64_t*>(getDocument().getId().getGlobalId().get());
 }
 
 uint32_t
@@ -54,6 +59,56 @@ PutDocumentMessage::setDocument(document::Document::SP document)
         throw vespalib::IllegalArgumentException("Document can not be null.", VESPA_STRLOC);
     }
     _document = std::move(document);
+    _serializedDocument.clear();
+}
+
+void
+PutDocumentMessage::setSerializedDocument(const document::DocumentTypeRepo &repo, vespalib::ConstBufferRef buf)
+{
+    if (buf.size() == 0) {
+        throw vespalib::IllegalArgumentException("Serialized document can not be empty.", VESPA_STRLOC);
+    }
+    _document.reset();
+    _serializedDocument.assign(buf.c_str(), buf.c_str() + buf.size());
+    _repo = &repo;
+}
+
+void
+PutDocumentMessage::deserializeDocument() const
+{
+    document::ByteBuffer buf(&_serializedDocument[0], _serializedDocument.size());
+    _document = std::make_shared<document::Document>(*_repo, buf);
+    std::vector<char>().swap(_serializedDocument);
+}
+
+const PutDocumentMessage::DocumentSP &
+PutDocumentMessage::getDocumentSP() const
+{
+    if (hasSerializedDocument()) {
+        deserializeDocument();
+    }
+    return _document;
+}
+
+PutDocumentMessage::DocumentSP
+PutDocumentMessage::stealDocument()
+{
+    if (hasSerializedDocument()) {
+        deserializeDocument();
+    }
+    return std::move(_document);
+}
+
+PutDocumentMessage::DocumentSP
+PutDocumentMessage::stealDocument(std::vector<char> &serializedDocument)
+{
+    serializedDocument.clear();
+    if (hasSerializedDocument()) {
+        document::ByteBuffer buf(&_serializedDocument[0], _serializedDocument.size());
+        _document = std::make_shared<document::Document>(*_repo, buf);
+        serializedDocument.swap(_serializedDocument);
+    }
+    return std::move(_document);
 }
 
 }
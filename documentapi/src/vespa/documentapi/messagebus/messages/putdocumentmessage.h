@@ -2,15 +2,24 @@
 #pragma once
 
 #include "testandsetmessage.h"
+#include <vespa/vespalib/util/buffer.h>
+#include <vector>
 
-namespace document { class Document; }
+namespace document {
+    class Document;
+    class DocumentTypeRepo;
+}
 namespace documentapi {
 
 class PutDocumentMessage : public TestAndSetMessage {
 private:
     using DocumentSP = std::shared_ptr<document::Document>;
-    DocumentSP _document;
-    uint64_t   _time;
+    mutable DocumentSP                 _document;
+    mutable std::vector<char>          _serializedDocument;
+    const document::DocumentTypeRepo * _repo;
+    uint64_t                           _time;
+
+    void deserializeDocument() const;
 
 protected:
     DocumentReply::UP doCreateReply() const override;
@@ -37,9 +46,19 @@ public:
      *
      * @return The document.
      */
-    const DocumentSP & getDocumentSP() const { return _document; }
-    DocumentSP stealDocument() { return std::move(_document); }
-    const document::Document & getDocument() const { return *_document; }
+    const DocumentSP & getDocumentSP() const;
+    DocumentSP stealDocument();
+
+    /**
+     * Like stealDocument(), but also hands over the serialized form the
+     * document was lazily decoded from, so that a receiver can forward the
+     * document without serializing it again. The serialized form is left
+     * empty if the document was not held in serialized form.
+     *
+     * @param serializedDocument Receives the serialized document.
+     */
+    DocumentSP stealDocument(std::vector<char> &serializedDocument);
+    const document::Document & getDocument() const { return *getDocumentSP(); }
 
     /**
      * Sets the document to put.
@@ -48,6 +67,31 @@ public:
      */
     void setDocument(DocumentSP document);
 
+    /**
+     * Sets the document to put in its serialized form. The document is not
+     * deserialized until it is first accessed, and as long as it has not been,
+     * encoding this message writes these bytes as they are. This lets a
+     * message be forwarded without paying for a deserialize/serialize
+     * round trip of a document nobody looks at.
+     *
+     * @param repo The repo to deserialize with. Must outlive this message.
+     * @param buf  The serialized document.
+     */
+    void setSerializedDocument(const document::DocumentTypeRepo &repo, vespalib::ConstBufferRef buf);
+
+    /**
+     * Returns whether the document is still only held in serialized form.
+     */
+    bool hasSerializedDocument() const { return ! _serializedDocument.empty(); }
+
+    /**
+     * Returns the serialized document as given to setSerializedDocument(). Only
+     * valid while hasSerializedDocument() is true.
+     */
+    vespalib::ConstBufferRef getSerializedDocument() const {
+        return vespalib::ConstBufferRef(&_serializedDocument[0], _serializedDocument.size());
+    }
+
     /**
      * Returns the timestamp of the document to put.
      *
@@ -648,9 +648,43 @@ RoutableFactories50::MultiOperationReplyFactory::doEncode(const DocumentReply &o
     return true;
 }
 
+namespace {
+
+/**
+ * Returns the number of bytes the document serialized at the current position
+ * of the given buffer occupies, or 0 if that can not be told without
+ * deserializing it.
+ */
+size_t
+getSerializedDocumentSize(const document::ByteBuffer &buf)
+{
+    // Version 7 and 8 documents start with a 16 bit version and a 32 bit size
+    // covering everything that follows it.
+    const size_t headerSize = sizeof(uint16_t) + sizeof(uint32_t);
+    if (buf.getRemaining() < headerSize) {
+        return 0;
+    }
+    nbostream header(buf.getBufferAtPos(), headerSize);
+    uint16_t version;
+    uint32_t dataSize;
+    header >> version >> dataSize;
+    if ((version < 7) || (version > 8) || (dataSize > buf.getRemaining() - headerSize)) {
+        return 0;
+    }
+    return headerSize + dataSize;
+}
+
+}
+
 void
 RoutableFactories50::PutDocumentMessageFactory::decodeInto(PutDocumentMessage & msg, document::ByteBuffer & buf) const {
-    msg.setDocument(make_shared<document::Document>(_repo, buf));
+    size_t docSize = _lazyDocument ? getSerializedDocumentSize(buf) : 0;
+    if (docSize > 0) {
+        msg.setSerializedDocument(_repo, vespalib::ConstBufferRef(buf.getBufferAtPos(), docSize));
+        buf.incPos(docSize);
+    } else {
+        msg.setDocument(make_shared<document::Document>(_repo, buf));
+    }
     msg.setTimestamp(static_cast<uint64_t>(decodeLong(buf)));
 }
 
@@ -658,10 +692,14 @@ bool
 RoutableFactories50::PutDocumentMessageFactory::doEncode(const DocumentMessage &obj, vespalib::GrowableByteBuffer &buf) const
 {
     auto & msg = static_cast<const PutDocumentMessage &>(obj);
-    nbostream stream;
-
-    msg.getDocument().serialize(stream);
-    buf.putBytes(stream.peek(), stream.size());
+    if (msg.hasSerializedDocument()) {
+        vespalib::ConstBufferRef doc = msg.getSerializedDocument();
+        buf.putBytes(doc.c_str(), doc.size());
+    } else {
+        nbostream stream;
+        msg.getDocument().serialize(stream);
+        buf.putBytes(stream.peek(), stream.size());
+    }
     buf.putLong(static_cast<int64_t>(msg.getTimestamp()));
 
     return true;
@@ -294,6 +294,7 @@ public:
     class PutDocumentMessageFactory : public DocumentMessageFactory {
     protected:
         const document::DocumentTypeRepo &_repo;
+        bool _lazyDocument;
         DocumentMessage::UP doDecode(document::ByteBuffer &buf) const override {
             return decodeMessage<PutDocumentMessage>(this, buf);
         }
@@ -301,7 +302,12 @@ public:
         bool doEncode(const DocumentMessage &msg, vespalib::GrowableByteBuffer &buf) const override;
     public:
         void decodeInto(PutDocumentMessage & msg, document::ByteBuffer & buf) const;
-        PutDocumentMessageFactory(const document::DocumentTypeRepo &r) : _repo(r) {}
+        /**
+         * If lazyDocument is set, decoded messages keep the document in
+         * serialized form (see PutDocumentMessage::setSerializedDocument()).
+         */
+        PutDocumentMessageFactory(const document::DocumentTypeRepo &r, bool lazyDocument = false)
+            : _repo(r), _lazyDocument(lazyDocument) {}
     };
     class PutDocumentReplyFactory : public DocumentReplyFactory {
     protected:
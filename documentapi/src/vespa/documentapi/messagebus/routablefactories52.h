@@ -26,7 +26,8 @@ public:
         bool doEncode(const DocumentMessage & msg, vespalib::GrowableByteBuffer & buf) const override;
     public:
         void decodeInto(PutDocumentMessage & msg, document::ByteBuffer & buf) const;
-        PutDocumentMessageFactory(const document::DocumentTypeRepo & r) : super::PutDocumentMessageFactory(r) {}
+        PutDocumentMessageFactory(const document::DocumentTypeRepo & r, bool lazyDocument = false)
+            : super::PutDocumentMessageFactory(r, lazyDocument) {}
     };
 
     class RemoveDocumentMessageFactory : public RoutableFactories50::RemoveDocumentMessageFactory {
@@ -101,9 +101,8 @@ RoutableRepository::encode(const vespalib::Version &version, const mbus::Routabl
             type, version.toString().c_str());
         return mbus::Blob(0);
     }
-    mbus::Blob ret(out.position());
-    memcpy(ret.data(), out.getBuffer(), out.position());
-    return ret;
+    uint32_t size = out.position();
+    return mbus::Blob(out.stealBuffer(), size);
 }
 
 void
@@ -4,6 +4,7 @@
 #include <vespa/eval/eval/key_gen.h>
 #include <vespa/eval/eval/test/eval_spec.h>
 #include <set>
+#include <thread>
 
 using namespace vespalib::eval;
 
@@ -144,6 +145,39 @@ TEST("require that cache usage works") {
     TEST_DO(verify_cache(0, 0));
 }
 
+TEST("require that functions can be compiled in the background") {
+    TEST_DO(verify_cache(0, 0));
+    auto function = std::make_shared<Function>(Function::parse("x+y"));
+    CompileCache::Token::UP token_a = CompileCache::compile_async(function, PassParams::SEPARATE);
+    function.reset();
+    EXPECT_EQUAL(5.0, token_a->get().get_function<2>()(2.0, 3.0));
+    EXPECT_TRUE(token_a->try_get() != nullptr);
+    TEST_DO(verify_cache(1, 1));
+    CompileCache::Token::UP token_b = CompileCache::compile(Function::parse("x+y"), PassParams::SEPARATE);
+    EXPECT_EQUAL(&token_a->get(), &token_b->get());
+    TEST_DO(verify_cache(1, 2));
+    token_a.reset();
+    token_b.reset();
+    TEST_DO(verify_cache(0, 0));
+}
+
+TEST("require that compilation statistics are tracked") {
+    CompileCache::Stats before = CompileCache::get_stats();
+    CompileCache::Token::UP token_a = CompileCache::compile(Function::parse("x-y"), PassParams::SEPARATE);
+    CompileCache::Token::UP token_b = CompileCache::compile(Function::parse("x-y"), PassParams::SEPARATE);
+    CompileCache::Token::UP token_c = CompileCache::compile_async(std::make_shared<Function>(Function::parse("x/y")),
+                                                                  PassParams::SEPARATE);
+    token_c->get();
+    // the background thread records its statistics after the result is ready
+    while (CompileCache::get_stats().num_compiled < (before.num_compiled + 2)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CompileCache::Stats after = CompileCache::get_stats();
+    EXPECT_EQUAL(before.num_compiled + 2, after.num_compiled);
+    EXPECT_GREATER(after.total_compile_time_s, before.total_compile_time_s);
+    EXPECT_GREATER_EQUAL(after.total_compile_time_s, after.max_compile_time_s);
+}
+
 //-----------------------------------------------------------------------------
 
 TEST_MAIN() { TEST_RUN_ALL(); }
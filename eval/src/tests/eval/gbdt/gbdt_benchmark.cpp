@@ -2,6 +2,7 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/eval/eval/gbdt.h>
 #include <vespa/eval/eval/vm_forest.h>
+#include <vespa/eval/eval/quick_forest.h>
 #include <vespa/eval/eval/llvm/deinline_forest.h>
 #include <vespa/eval/eval/llvm/compiled_function.h>
 #include <vespa/eval/eval/function.h>
@@ -60,6 +61,22 @@ struct VMForestStrategy : CompileStrategy {
 };
 VMForestStrategy vm_forest;
 
+struct QuickForestStrategy : CompileStrategy {
+    const char *name() const override {
+        return "quick-forest";
+    }
+    const char *code_name() const override {
+        return "QuickForest::optimize_chain";
+    }
+    CompiledFunction compile(const Function &function) const override {
+        return CompiledFunction(function, PassParams::ARRAY, QuickForest::optimize_chain);
+    }
+    CompiledFunction compile_lazy(const Function &function) const override {
+        return CompiledFunction(function, PassParams::LAZY, QuickForest::optimize_chain);
+    }
+};
+QuickForestStrategy quick_forest;
+
 struct DeinlineForestStrategy : CompileStrategy {
     const char *name() const override {
         return "deinline-forest";
@@ -88,7 +105,7 @@ struct Option {
     const char *code_name() const { return strategy.code_name(); }
 };
 
-std::vector<Option> all_options({{0, none},{1, vm_forest}});
+std::vector<Option> all_options({{0, none},{1, vm_forest},{2, quick_forest}});
 
 //-----------------------------------------------------------------------------
 
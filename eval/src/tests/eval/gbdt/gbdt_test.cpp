@@ -2,6 +2,7 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/eval/eval/gbdt.h>
 #include <vespa/eval/eval/vm_forest.h>
+#include <vespa/eval/eval/quick_forest.h>
 #include <vespa/eval/eval/function.h>
 #include <vespa/eval/eval/llvm/deinline_forest.h>
 #include <vespa/eval/eval/llvm/compiled_function.h>
@@ -284,6 +285,53 @@ TEST("require that models with too large sets are rejected by general vm optimiz
 
 //-----------------------------------------------------------------------------
 
+TEST("require that quick forest optimizer works") {
+    Function function = Function::parse("if((a<1),1.0,if((b<1),if((c<1),2.0,3.0),4.0))+"
+                                        "if((d<1),10.0,if((e<1),if((f<1),20.0,30.0),40.0))+"
+                                        "if((a<2),100.0,200.0)");
+    CompiledFunction compiled_function(function, PassParams::ARRAY, QuickForest::optimize_chain);
+    ASSERT_EQUAL(1u, compiled_function.get_forests().size());
+    EXPECT_TRUE(dynamic_cast<QuickForest*>(compiled_function.get_forests()[0].get()) != nullptr);
+    auto f = compiled_function.get_function();
+    EXPECT_EQUAL(111.0, f(&std::vector<double>({0.5, 0.0, 0.0, 0.5, 0.0, 0.0})[0]));
+    EXPECT_EQUAL(122.0, f(&std::vector<double>({1.5, 0.5, 0.5, 1.5, 0.5, 0.5})[0]));
+    EXPECT_EQUAL(133.0, f(&std::vector<double>({1.5, 0.5, 1.5, 1.5, 0.5, 1.5})[0]));
+    EXPECT_EQUAL(244.0, f(&std::vector<double>({2.5, 1.5, 0.0, 1.5, 1.5, 0.0})[0]));
+    EXPECT_EQUAL(244.0, f(&std::vector<double>({std::nan(""), 1.5, 0.0, 1.5, 1.5, 0.0})[0]));
+}
+
+TEST("require that quick forest optimizer handles trees with max leafs") {
+    Function function = Function::parse(Model().less_percent(100).make_forest(10, QuickForest::MAX_LEAFS));
+    CompiledFunction none(function, PassParams::ARRAY, Optimize::none);
+    CompiledFunction quick_forest(function, PassParams::ARRAY, QuickForest::optimize_chain);
+    ASSERT_EQUAL(1u, quick_forest.get_forests().size());
+    for (double value: {0.0, 0.25, 0.5, 0.75, 1.0}) {
+        std::vector<double> inputs(function.num_params(), value);
+        EXPECT_EQUAL(eval_double(function, inputs), quick_forest.get_function()(&inputs[0]));
+    }
+}
+
+TEST("require that models with in checks or too large trees are rejected by quick forest optimizer") {
+    Function function = Function::parse(Model().less_percent(100).make_forest(300, 30));
+    auto trees = extract_trees(function.root());
+    ForestStats stats(trees);
+    EXPECT_TRUE(Optimize::apply_chain(QuickForest::optimize_chain, stats, trees).valid());
+    stats.total_in_checks = 1;
+    EXPECT_TRUE(!Optimize::apply_chain(QuickForest::optimize_chain, stats, trees).valid());
+    stats.total_in_checks = 0;
+    stats.tree_sizes.back().size = QuickForest::MAX_LEAFS + 1;
+    EXPECT_TRUE(!Optimize::apply_chain(QuickForest::optimize_chain, stats, trees).valid());
+}
+
+TEST("require that very large forests are evaluated with quick forest by default") {
+    Function function = Function::parse(Model().less_percent(100).make_forest(1500, 16));
+    CompiledFunction compiled_function(function, PassParams::ARRAY);
+    ASSERT_EQUAL(1u, compiled_function.get_forests().size());
+    EXPECT_TRUE(dynamic_cast<QuickForest*>(compiled_function.get_forests()[0].get()) != nullptr);
+}
+
+//-----------------------------------------------------------------------------
+
 double eval_compiled(const CompiledFunction &cfun, std::vector<double> &params) {
     ASSERT_EQUAL(params.size(), cfun.num_params());
     if (cfun.pass_params() == PassParams::ARRAY) {
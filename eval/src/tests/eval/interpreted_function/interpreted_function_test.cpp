@@ -301,6 +301,100 @@ TEST("require that expressions similar to inner product are not optimized") {
 
 //-----------------------------------------------------------------------------
 
+TensorSpec make_dense_spec(const vespalib::string &type_spec, double seed) {
+    ValueType type = ValueType::from_spec(type_spec);
+    TensorSpec spec(type_spec);
+    std::vector<size_t> labels(type.dimensions().size(), 0);
+    for (double value = seed; true; value += 1.0) {
+        TensorSpec::Address addr;
+        for (size_t i = 0; i < labels.size(); ++i) {
+            addr.emplace(type.dimensions()[i].name, labels[i]);
+        }
+        spec.add(addr, value);
+        size_t idx = labels.size();
+        while ((idx > 0) && (++labels[idx - 1] == type.dimensions()[idx - 1].size)) {
+            labels[--idx] = 0;
+        }
+        if (idx == 0) {
+            return spec;
+        }
+    }
+}
+
+struct ElementwiseChain {
+    Function            function;
+    TensorSpec          a;
+    TensorSpec          b;
+    NodeTypes           types;
+    InterpretedFunction interpreted;
+    ~ElementwiseChain() {}
+    ElementwiseChain(const vespalib::string &expr, const vespalib::string &b_type = "tensor(x[2],y[3])")
+        : function(Function::parse({"a", "b", "c"}, expr)),
+          a(make_dense_spec("tensor(x[2],y[3])", 1.0)),
+          b(make_dense_spec(b_type, 10.0)),
+          types(function, {ValueType::from_spec(a.type()), ValueType::from_spec(b.type()), ValueType::double_type()}),
+          interpreted(DefaultTensorEngine::ref(), function, types) {}
+    TensorSpec eval(const TensorEngine &engine, const InterpretedFunction &ifun) const {
+        InterpretedFunction::Context ctx(ifun);
+        Value::UP va = engine.from_spec(a);
+        Value::UP vb = engine.from_spec(b);
+        DoubleValue vc(0.5);
+        InterpretedFunction::SimpleObjectParams params({*va,*vb,vc});
+        return engine.to_spec(ifun.eval(ctx, params));
+    }
+    void verify(size_t expect_program_size) const {
+        EXPECT_EQUAL(expect_program_size, interpreted.program_size());
+        InterpretedFunction reference(SimpleTensorEngine::ref(), function, types);
+        EXPECT_EQUAL(eval(SimpleTensorEngine::ref(), reference), eval(DefaultTensorEngine::ref(), interpreted));
+    }
+};
+
+TEST("require that chains of map and join on dense tensors are compiled into a single operation") {
+    TEST_DO(ElementwiseChain("map(a*b+c,f(x)(x*x))").verify(1));
+    TEST_DO(ElementwiseChain("join(map(a,f(x)(x+1)),b,f(x,y)(x-y*c))").verify(1));
+    TEST_DO(ElementwiseChain("relu(a-b)*(c+1)").verify(1));
+    TEST_DO(ElementwiseChain("reduce(map(a,f(x)(x+1))*b,sum)").verify(1));
+    TEST_DO(ElementwiseChain("reduce(sigmoid(a*b),max)").verify(1));
+}
+
+TEST("require that single and mixed tensor operations are not compiled into a single operation") {
+    TEST_DO(ElementwiseChain("a*b").verify(3));
+    TEST_DO(ElementwiseChain("reduce(a+b,sum,x)").verify(4));
+    TEST_DO(ElementwiseChain("(a*b)+reduce(a,sum)").verify(6));
+    TEST_DO(ElementwiseChain("map(a*b,f(x)(x*x))", "tensor(x[2])").verify(4));
+}
+
+TEST("require that stash is planned to hold all intermediate results in a single chunk") {
+    auto function = Function::parse({"a", "b"}, "map(a*b,f(x)(x+1))");
+    TensorSpec a = make_dense_spec("tensor(x[1000])", 1.0);
+    TensorSpec b = make_dense_spec("tensor(x[1000])", 2.0);
+    NodeTypes types(function, {ValueType::from_spec(a.type()), ValueType::from_spec(b.type())});
+    InterpretedFunction ifun(DefaultTensorEngine::ref(), function, types);
+    EXPECT_GREATER_EQUAL(ifun.stash_size(), 4 * 1000 * sizeof(double));
+    InterpretedFunction::Context ctx(ifun);
+    EXPECT_EQUAL(ifun.stash_size(), ctx.stash().get_chunk_size());
+    Value::UP va = DefaultTensorEngine::ref().from_spec(a);
+    Value::UP vb = DefaultTensorEngine::ref().from_spec(b);
+    InterpretedFunction::SimpleObjectParams params({*va,*vb});
+    TensorSpec expect = DefaultTensorEngine::ref().to_spec(ifun.eval(ctx, params));
+    size_t used = ctx.stash().count_used();
+    EXPECT_GREATER_EQUAL(used, 1000 * sizeof(double));
+    EXPECT_LESS_EQUAL(used, ctx.stash().get_chunk_size());
+    for (size_t i = 0; i < 3; ++i) {
+        EXPECT_EQUAL(expect, DefaultTensorEngine::ref().to_spec(ifun.eval(ctx, params)));
+        EXPECT_EQUAL(used, ctx.stash().count_used());
+    }
+}
+
+TEST("require that stash is not planned for unknown types") {
+    auto function = Function::parse({"a", "b"}, "a*b");
+    InterpretedFunction ifun(SimpleTensorEngine::ref(), function, NodeTypes());
+    InterpretedFunction::Context ctx(ifun);
+    EXPECT_EQUAL(Stash().get_chunk_size(), ctx.stash().get_chunk_size());
+}
+
+//-----------------------------------------------------------------------------
+
 TEST("require that functions with non-compilable lambdas cannot be interpreted") {
     auto good_map = Function::parse("map(a,f(x)(x+1))");
     auto good_join = Function::parse("join(a,b,f(x,y)(x+y))");
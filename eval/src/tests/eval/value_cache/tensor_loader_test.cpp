@@ -4,6 +4,7 @@
 #include <vespa/eval/eval/simple_tensor_engine.h>
 #include <vespa/eval/eval/tensor_spec.h>
 #include <vespa/eval/eval/tensor.h>
+#include <vespa/vespalib/io/fileutil.h>
 
 using namespace vespalib::eval;
 
@@ -75,4 +76,61 @@ TEST_F("require that bad lz4 file fails to load creating empty result", Constant
     TEST_DO(verify_tensor(sparse_tensor_nocells(), f1.create(TEST_PATH("bad_lz4.json.lz4"), "tensor(x{},y{})")));
 }
 
+const vespalib::string cache_dir("tensor_cache");
+
+size_t num_cache_files() {
+    return vespalib::listDirectory(cache_dir).size();
+}
+
+TEST("require that loaded tensors are kept in the binary cache") {
+    vespalib::rmdir(cache_dir, true);
+    {
+        ConstantTensorLoader loader(SimpleTensorEngine::ref(), cache_dir);
+        TEST_DO(verify_tensor(make_dense_tensor(), loader.create(TEST_PATH("dense.json"), "tensor(x[2],y[2])")));
+        TEST_DO(verify_tensor(make_sparse_tensor(), loader.create(TEST_PATH("sparse.json.lz4"), "tensor(x{},y{})")));
+        EXPECT_EQUAL(2u, num_cache_files());
+    }
+    {
+        ConstantTensorLoader loader(SimpleTensorEngine::ref(), cache_dir);
+        TEST_DO(verify_tensor(make_dense_tensor(), loader.create(TEST_PATH("dense.json"), "tensor(x[2],y[2])")));
+        TEST_DO(verify_tensor(make_sparse_tensor(), loader.create(TEST_PATH("sparse.json.lz4"), "tensor(x{},y{})")));
+        EXPECT_EQUAL(2u, num_cache_files());
+    }
+    vespalib::rmdir(cache_dir, true);
+}
+
+TEST("require that files with the same content share a cache entry") {
+    vespalib::rmdir(cache_dir, true);
+    vespalib::copy(TEST_PATH("dense.json"), "dense_copy.json");
+    ConstantTensorLoader loader(SimpleTensorEngine::ref(), cache_dir);
+    TEST_DO(verify_tensor(make_dense_tensor(), loader.create(TEST_PATH("dense.json"), "tensor(x[2],y[2])")));
+    TEST_DO(verify_tensor(make_dense_tensor(), loader.create("dense_copy.json", "tensor(x[2],y[2])")));
+    EXPECT_EQUAL(1u, num_cache_files());
+    vespalib::unlink("dense_copy.json");
+    vespalib::rmdir(cache_dir, true);
+}
+
+TEST("require that invalid files are not cached") {
+    vespalib::rmdir(cache_dir, true);
+    ConstantTensorLoader loader(SimpleTensorEngine::ref(), cache_dir);
+    TEST_DO(verify_tensor(sparse_tensor_nocells(), loader.create(TEST_PATH("invalid.json"), "tensor(x{},y{})")));
+    TEST_DO(verify_tensor(sparse_tensor_nocells(), loader.create(TEST_PATH("bad_lz4.json.lz4"), "tensor(x{},y{})")));
+    EXPECT_EQUAL(0u, num_cache_files());
+    vespalib::rmdir(cache_dir, true);
+}
+
+TEST("require that corrupt cache files are ignored") {
+    vespalib::rmdir(cache_dir, true);
+    ConstantTensorLoader loader(SimpleTensorEngine::ref(), cache_dir);
+    TEST_DO(verify_tensor(make_dense_tensor(), loader.create(TEST_PATH("dense.json"), "tensor(x[2],y[2])")));
+    ASSERT_EQUAL(1u, num_cache_files());
+    vespalib::string cache_file = cache_dir + "/" + vespalib::listDirectory(cache_dir)[0];
+    vespalib::File file(cache_file);
+    file.open(0);
+    file.write("garbage", 7, 20);
+    file.close();
+    TEST_DO(verify_tensor(make_dense_tensor(), loader.create(TEST_PATH("dense.json"), "tensor(x[2],y[2])")));
+    vespalib::rmdir(cache_dir, true);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,114 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/eval/eval/simple_tensor_engine.h>
+#include <vespa/eval/eval/tensor_function.h>
+#include <vespa/eval/eval/tensor_spec.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
+#include <vespa/eval/tensor/dense/dense_elementwise_function.h>
+#include <vespa/vespalib/util/stash.h>
+
+using namespace vespalib;
+using namespace vespalib::eval;
+using namespace vespalib::eval::tensor_function;
+using vespalib::tensor::DefaultTensorEngine;
+using vespalib::tensor::DenseElementwiseFunction;
+
+const TensorEngine &ref_engine = SimpleTensorEngine::ref();
+const TensorEngine &prod_engine = DefaultTensorEngine::ref();
+
+// (a + b) * c, with a and b tensors and c a double
+double my_cell_fun(const double *args) { return (args[0] + args[2]) * args[3]; }
+
+TensorSpec makeSpec(const vespalib::string &type, size_t xSize, size_t ySize, double seed) {
+    TensorSpec spec(type);
+    for (size_t x = 0; x < xSize; ++x) {
+        for (size_t y = 0; y < ySize; ++y) {
+            spec.add({{"x", x}, {"y", y}}, seed + (x * ySize) + y);
+        }
+    }
+    return spec;
+}
+
+struct Fixture {
+    ValueType type;
+    TensorSpec a;
+    TensorSpec b;
+    Stash stash;
+    const Node &elementwiseNode;
+    Fixture(const vespalib::string &typeSpec, const vespalib::string &bTypeSpec = "")
+        : type(ValueType::from_spec(typeSpec)),
+          a(makeSpec(typeSpec, 2, 3, 1.0)),
+          b(makeSpec(typeSpec, 2, 3, 10.0)),
+          stash(),
+          elementwiseNode(elementwise(type,
+                                      {&inject(type, 0, stash),
+                                       &inject(bTypeSpec.empty() ? type : ValueType::from_spec(bTypeSpec), 1, stash),
+                                       &inject(ValueType::double_type(), 2, stash)},
+                                      {0, 2, 3}, 4, my_cell_fun, stash))
+    {}
+    ~Fixture() {}
+    const TensorFunction &compile(const Node &node) {
+        return prod_engine.compile(node, stash);
+    }
+    TensorSpec eval(const TensorEngine &engine, const TensorFunction &function, double c) {
+        Value::UP aValue = engine.from_spec(a);
+        Value::UP bValue = engine.from_spec(b);
+        DoubleValue cValue(c);
+        std::vector<Value::CREF> params({*aValue, *bValue, cValue});
+        Stash evalStash;
+        return engine.to_spec(function.eval(params, evalStash));
+    }
+};
+
+TEST_F("require that elementwise operation on dense tensors is compiled", Fixture("tensor(x[2],y[3])")) {
+    const TensorFunction &function = f.compile(f.elementwiseNode);
+    const DenseElementwiseFunction *dense = as<DenseElementwiseFunction>(function);
+    ASSERT_TRUE(dense);
+    EXPECT_FALSE(dense->aggregate());
+    EXPECT_EQUAL(6u, dense->numCells());
+    ASSERT_EQUAL(3u, dense->inputs().size());
+    EXPECT_TRUE(dense->inputs()[0].isTensor);
+    EXPECT_TRUE(dense->inputs()[1].isTensor);
+    EXPECT_FALSE(dense->inputs()[2].isTensor);
+    EXPECT_EQUAL(2u, dense->inputs()[1].argIdx);
+}
+
+TEST_F("require that compiled elementwise operation gives same result as generic one", Fixture("tensor(x[2],y[3])")) {
+    TensorSpec expect = f.eval(ref_engine, f.elementwiseNode, 0.5);
+    EXPECT_EQUAL(expect, f.eval(prod_engine, f.compile(f.elementwiseNode), 0.5));
+    EXPECT_EQUAL(expect, f.eval(prod_engine, f.elementwiseNode, 0.5));
+    TensorSpec::Address addr({{"x", 1}, {"y", 2}});
+    EXPECT_EQUAL((6.0 + 15.0) * 0.5, double(expect.cells().find(addr)->second));
+}
+
+TEST_F("require that reduce of elementwise operation is compiled into aggregation", Fixture("tensor(x[2],y[3])")) {
+    for (Aggr aggr: {Aggr::SUM, Aggr::MAX, Aggr::MIN, Aggr::AVG, Aggr::PROD, Aggr::COUNT}) {
+        const Node &reduceNode = reduce(f.elementwiseNode, aggr, {}, f.stash);
+        const TensorFunction &function = f.compile(reduceNode);
+        const DenseElementwiseFunction *dense = as<DenseElementwiseFunction>(function);
+        ASSERT_TRUE(dense);
+        EXPECT_TRUE(dense->aggregate());
+        EXPECT_EQUAL(f.eval(ref_engine, reduceNode, 2.0), f.eval(prod_engine, function, 2.0));
+    }
+}
+
+TEST_F("require that partial reduce of elementwise operation is not compiled", Fixture("tensor(x[2],y[3])")) {
+    const Node &reduceNode = reduce(f.elementwiseNode, Aggr::SUM, {"x"}, f.stash);
+    EXPECT_TRUE(as<Reduce>(f.compile(reduceNode)));
+}
+
+TEST_F("require that elementwise operation on abstract dense tensors is not compiled", Fixture("tensor(x[],y[])")) {
+    EXPECT_TRUE(as<Elementwise>(f.compile(f.elementwiseNode)));
+}
+
+TEST_F("require that elementwise operation on tensors with different types is not compiled", Fixture("tensor(x[2],y[3])", "tensor(x[2])")) {
+    EXPECT_TRUE(as<Elementwise>(f.compile(f.elementwiseNode)));
+}
+
+TEST_F("require that elementwise operation on sparse tensors is not compiled", Fixture("tensor(x{},y{})")) {
+    const TensorFunction &function = f.compile(f.elementwiseNode);
+    EXPECT_TRUE(as<Elementwise>(function));
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,72 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/log/log.h>
+LOG_SETUP("dense_matmul_function_test");
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/eval/eval/tensor_function.h>
+#include <vespa/eval/eval/operation.h>
+#include <vespa/eval/eval/simple_tensor.h>
+#include <vespa/eval/eval/simple_tensor_engine.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
+#include <vespa/eval/tensor/dense/dense_tensor_function_compiler.h>
+#include <vespa/eval/tensor/dense/dense_matmul_function.h>
+
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/stash.h>
+
+using namespace vespalib;
+using namespace vespalib::eval;
+using namespace vespalib::tensor;
+
+const TensorEngine &ref_engine = SimpleTensorEngine::ref();
+const TensorEngine &prod_engine = DefaultTensorEngine::ref();
+
+std::vector<eval::Value::CREF> wrap(std::vector<eval::Value::CREF> params) {
+    return std::move(params);
+}
+
+TensorSpec make_matrix(const vespalib::string &d1name, size_t d1sz,
+                       const vespalib::string &d2name, size_t d2sz, double seed)
+{
+    TensorSpec ret(make_string("tensor(%s[%zu],%s[%zu])",
+                               d1name.c_str(), d1sz,
+                               d2name.c_str(), d2sz));
+    for (size_t i = 0; i < d1sz; ++i) {
+        for (size_t j = 0; j < d2sz; ++j) {
+            ret.add({{d1name,i},{d2name,j}}, seed + i*7.0 + j*43.0);
+        }
+    }
+    return ret;
+}
+
+void verify_result(const TensorSpec &a, const TensorSpec &b, const vespalib::string &dim) {
+    Stash stash;
+    Value::UP ref_a = ref_engine.from_spec(a);
+    Value::UP ref_b = ref_engine.from_spec(b);
+    const Value &joined = ref_engine.join(*ref_a, *ref_b, operation::Mul::f, stash);
+    const Value &expect = ref_engine.reduce(joined, Aggr::SUM, {dim}, stash);
+
+    Value::UP prod_a = prod_engine.from_spec(a);
+    Value::UP prod_b = prod_engine.from_spec(b);
+    const auto &ir = tensor_function::reduce(tensor_function::join(
+                    tensor_function::inject(prod_a->type(), 0, stash),
+                    tensor_function::inject(prod_b->type(), 1, stash),
+                    operation::Mul::f, stash), Aggr::SUM, {dim}, stash);
+    const TensorFunction &fun = DenseTensorFunctionCompiler::compile(ir, stash);
+    EXPECT_TRUE(as<DenseMatMulFunction>(fun));
+    const Value &actual = fun.eval(wrap({*prod_a, *prod_b}), stash);
+    EXPECT_EQUAL(ref_engine.to_spec(expect), prod_engine.to_spec(actual));
+}
+
+TEST("require that matrix product gives same results as reference join/reduce") {
+    for (size_t common: {1, 3, 16}) {
+        TEST_DO(verify_result(make_matrix("x", 2, "y", common, 1.0), make_matrix("y", common, "z", 5, 2.0), "y"));
+        TEST_DO(verify_result(make_matrix("y", common, "z", 5, 1.0), make_matrix("x", 2, "y", common, 2.0), "y"));
+        TEST_DO(verify_result(make_matrix("x", common, "y", 3, 1.0), make_matrix("x", common, "z", 4, 2.0), "x"));
+        TEST_DO(verify_result(make_matrix("x", 3, "z", common, 1.0), make_matrix("y", 4, "z", common, 2.0), "z"));
+        TEST_DO(verify_result(make_matrix("a", common, "x", 3, 1.0), make_matrix("b", 4, "a", common, 2.0), "a"));
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
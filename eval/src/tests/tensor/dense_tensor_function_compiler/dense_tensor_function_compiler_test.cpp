@@ -2,6 +2,7 @@
 
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/eval/tensor/dense/dense_dot_product_function.h>
+#include <vespa/eval/tensor/dense/dense_matmul_function.h>
 #include <vespa/eval/tensor/dense/dense_xw_product_function.h>
 #include <vespa/eval/tensor/dense/dense_tensor_function_compiler.h>
 #include <vespa/eval/eval/operation.h>
@@ -148,6 +149,42 @@ TEST("require that xw products with incompatible dimensions are not compiled") {
     TEST_DO(assertNotCompiledXWProduct("tensor(y[5])", "tensor(x[3],y[4])", "y"));
 }
 
+void
+assertCompiledMatMul(const vespalib::string &lhsType,
+                     const vespalib::string &rhsType,
+                     const vespalib::string &dim,
+                     size_t lhsId, size_t lhsSize, size_t commonSize, size_t rhsSize,
+                     bool lhsCommonInner, bool rhsCommonInner)
+{
+    Stash stash;
+    const TensorFunction &func = compileXWProduct(lhsType, rhsType, dim, stash);
+    const DenseMatMulFunction *matMul = as<DenseMatMulFunction>(func);
+    ASSERT_TRUE(matMul);
+    EXPECT_EQUAL(lhsId, matMul->lhsId());
+    EXPECT_EQUAL((lhsId == 1) ? 3u : 1u, matMul->rhsId());
+    EXPECT_EQUAL(lhsSize, matMul->lhsSize());
+    EXPECT_EQUAL(commonSize, matMul->commonSize());
+    EXPECT_EQUAL(rhsSize, matMul->rhsSize());
+    EXPECT_EQUAL(lhsCommonInner, matMul->lhsCommonInner());
+    EXPECT_EQUAL(rhsCommonInner, matMul->rhsCommonInner());
+}
+
+TEST("require that matrix products with compatible dimensions are compiled") {
+    TEST_DO(assertCompiledMatMul("tensor(x[2],y[3])", "tensor(y[3],z[4])", "y", 1, 2, 3, 4, true, false));
+    TEST_DO(assertCompiledMatMul("tensor(y[3],z[4])", "tensor(x[2],y[3])", "y", 3, 2, 3, 4, true, false));
+    TEST_DO(assertCompiledMatMul("tensor(x[2],y[3])", "tensor(x[2],z[4])", "x", 1, 3, 2, 4, false, false));
+    TEST_DO(assertCompiledMatMul("tensor(a[3],x[2])", "tensor(a[3],z[4])", "a", 1, 2, 3, 4, false, false));
+    TEST_DO(assertCompiledMatMul("tensor(x[2],z[3])", "tensor(y[4],z[3])", "z", 1, 2, 3, 4, true, true));
+}
+
+TEST("require that matrix products with incompatible dimensions are not compiled") {
+    Stash stash;
+    EXPECT_TRUE(as<Reduce>(compileXWProduct("tensor(x[2],y[3])", "tensor(y[4],z[4])", "y", stash)));
+    EXPECT_TRUE(as<Reduce>(compileXWProduct("tensor(x[2],y[3])", "tensor(y[3],z[])", "y", stash)));
+    EXPECT_TRUE(as<Reduce>(compileXWProduct("tensor(x[2],y[3])", "tensor(y[3],z[4])", "x", stash)));
+    EXPECT_TRUE(as<Reduce>(compileXWProduct("tensor(x[2],y[3])", "tensor(x[2],y[3])", "y", stash)));
+}
+
 //-----------------------------------------------------------------------------
 
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,95 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/eval/eval/operation.h>
+#include <vespa/eval/eval/simple_tensor_engine.h>
+#include <vespa/eval/eval/tensor_spec.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
+#include <vespa/vespalib/util/stash.h>
+
+using namespace vespalib;
+using namespace vespalib::eval;
+using vespalib::tensor::DefaultTensorEngine;
+using join_fun_t = TensorEngine::join_fun_t;
+
+const TensorEngine &ref_engine = SimpleTensorEngine::ref();
+const TensorEngine &prod_engine = DefaultTensorEngine::ref();
+
+TensorSpec makeSpec(const vespalib::string &type, const std::vector<std::pair<vespalib::string, size_t>> &dims, double seed) {
+    TensorSpec spec(type);
+    size_t numCells = 1;
+    for (const auto &dim: dims) {
+        numCells *= dim.second;
+    }
+    for (size_t i = 0; i < numCells; ++i) {
+        TensorSpec::Address address;
+        size_t rest = i;
+        for (auto dim = dims.rbegin(); dim != dims.rend(); ++dim) {
+            address.emplace(dim->first, TensorSpec::Label(rest % dim->second));
+            rest /= dim->second;
+        }
+        spec.add(address, seed + i);
+    }
+    return spec;
+}
+
+TensorSpec join(const TensorEngine &engine, const TensorSpec &a, const TensorSpec &b, join_fun_t function) {
+    Stash stash;
+    Value::UP lhs = engine.from_spec(a);
+    Value::UP rhs = engine.from_spec(b);
+    return engine.to_spec(engine.join(*lhs, *rhs, function, stash));
+}
+
+TensorSpec reduce(const TensorEngine &engine, const TensorSpec &a, Aggr aggr, const std::vector<vespalib::string> &dimensions) {
+    Stash stash;
+    Value::UP arg = engine.from_spec(a);
+    return engine.to_spec(engine.reduce(*arg, aggr, dimensions, stash));
+}
+
+void verifyJoin(const TensorSpec &a, const TensorSpec &b) {
+    EXPECT_EQUAL(join(ref_engine, a, b, operation::Mul::f), join(prod_engine, a, b, operation::Mul::f));
+    EXPECT_EQUAL(join(ref_engine, a, b, operation::Add::f), join(prod_engine, a, b, operation::Add::f));
+    EXPECT_EQUAL(join(ref_engine, a, b, operation::Sub::f), join(prod_engine, a, b, operation::Sub::f));
+    EXPECT_EQUAL(join(ref_engine, b, a, operation::Sub::f), join(prod_engine, b, a, operation::Sub::f));
+}
+
+void verifyReduce(const TensorSpec &a, const std::vector<vespalib::string> &dimensions) {
+    EXPECT_EQUAL(reduce(ref_engine, a, Aggr::SUM, dimensions), reduce(prod_engine, a, Aggr::SUM, dimensions));
+    EXPECT_EQUAL(reduce(ref_engine, a, Aggr::MAX, dimensions), reduce(prod_engine, a, Aggr::MAX, dimensions));
+}
+
+TEST("require that dense tensors with identical types are joined correctly") {
+    TEST_DO(verifyJoin(makeSpec("tensor(x[5])", {{"x", 5}}, 1.0),
+                       makeSpec("tensor(x[5])", {{"x", 5}}, 3.0)));
+    TEST_DO(verifyJoin(makeSpec("tensor(x[2],y[3])", {{"x", 2}, {"y", 3}}, 1.0),
+                       makeSpec("tensor(x[2],y[3])", {{"x", 2}, {"y", 3}}, 2.0)));
+}
+
+TEST("require that a vector is broadcast correctly over a matrix") {
+    TEST_DO(verifyJoin(makeSpec("tensor(x[2],y[3])", {{"x", 2}, {"y", 3}}, 1.0),
+                       makeSpec("tensor(y[3])", {{"y", 3}}, 5.0)));
+    TEST_DO(verifyJoin(makeSpec("tensor(x[2],y[3])", {{"x", 2}, {"y", 3}}, 1.0),
+                       makeSpec("tensor(x[2])", {{"x", 2}}, 5.0)));
+    TEST_DO(verifyJoin(makeSpec("tensor(x[2],y[3],z[4])", {{"x", 2}, {"y", 3}, {"z", 4}}, 1.0),
+                       makeSpec("tensor(y[3],z[4])", {{"y", 3}, {"z", 4}}, 7.0)));
+    TEST_DO(verifyJoin(makeSpec("tensor(x[2],y[3],z[4])", {{"x", 2}, {"y", 3}, {"z", 4}}, 1.0),
+                       makeSpec("tensor(x[2],z[4])", {{"x", 2}, {"z", 4}}, 7.0)));
+}
+
+TEST("require that non-matching dimension sizes are not broadcast") {
+    TEST_DO(verifyJoin(makeSpec("tensor(x[2],y[3])", {{"x", 2}, {"y", 3}}, 1.0),
+                       makeSpec("tensor(y[2])", {{"y", 2}}, 5.0)));
+}
+
+TEST("require that dense tensors are reduced correctly") {
+    TensorSpec matrix = makeSpec("tensor(x[3],y[4],z[5])", {{"x", 3}, {"y", 4}, {"z", 5}}, 1.0);
+    TEST_DO(verifyReduce(matrix, {"x"}));
+    TEST_DO(verifyReduce(matrix, {"y"}));
+    TEST_DO(verifyReduce(matrix, {"z"}));
+    TEST_DO(verifyReduce(matrix, {"x", "z"}));
+    TEST_DO(verifyReduce(matrix, {"z", "y", "x"}));
+    TEST_DO(verifyReduce(matrix, {}));
+    TEST_DO(verifyReduce(makeSpec("tensor(x[7])", {{"x", 7}}, 3.0), {"x"}));
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,159 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/eval/eval/operation.h>
+#include <vespa/eval/eval/simple_tensor_engine.h>
+#include <vespa/eval/eval/tensor_spec.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
+#include <vespa/eval/tensor/mixed/mixed_tensor.h>
+#include <vespa/eval/tensor/serialization/typed_binary_format.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/util/stash.h>
+#include <vespa/vespalib/util/stringfmt.h>
+
+using namespace vespalib;
+using namespace vespalib::eval;
+using vespalib::tensor::DefaultTensorEngine;
+using vespalib::tensor::MixedTensor;
+using vespalib::tensor::TypedBinaryFormat;
+using join_fun_t = TensorEngine::join_fun_t;
+
+const TensorEngine &ref_engine = SimpleTensorEngine::ref();
+const TensorEngine &prod_engine = DefaultTensorEngine::ref();
+
+struct Dim {
+    vespalib::string name;
+    size_t size;
+    bool mapped;
+};
+
+Dim mapped(const vespalib::string &name, size_t size) { return {name, size, true}; }
+Dim indexed(const vespalib::string &name, size_t size) { return {name, size, false}; }
+
+TensorSpec makeSpec(const vespalib::string &type, const std::vector<Dim> &dims, double seed) {
+    TensorSpec spec(type);
+    size_t numCells = 1;
+    for (const auto &dim: dims) {
+        numCells *= dim.size;
+    }
+    for (size_t i = 0; i < numCells; ++i) {
+        TensorSpec::Address address;
+        size_t rest = i;
+        for (auto dim = dims.rbegin(); dim != dims.rend(); ++dim) {
+            if (dim->mapped) {
+                address.emplace(dim->name, TensorSpec::Label(make_string("l%zu", rest % dim->size)));
+            } else {
+                address.emplace(dim->name, TensorSpec::Label(rest % dim->size));
+            }
+            rest /= dim->size;
+        }
+        spec.add(address, seed + i);
+    }
+    return spec;
+}
+
+bool isMixed(const Value &value) {
+    return (dynamic_cast<const MixedTensor *>(value.as_tensor()) != nullptr);
+}
+
+TensorSpec join(const TensorEngine &engine, const TensorSpec &a, const TensorSpec &b, join_fun_t function) {
+    Stash stash;
+    Value::UP lhs = engine.from_spec(a);
+    Value::UP rhs = engine.from_spec(b);
+    return engine.to_spec(engine.join(*lhs, *rhs, function, stash));
+}
+
+TensorSpec reduce(const TensorEngine &engine, const TensorSpec &a, Aggr aggr, const std::vector<vespalib::string> &dimensions) {
+    Stash stash;
+    Value::UP arg = engine.from_spec(a);
+    return engine.to_spec(engine.reduce(*arg, aggr, dimensions, stash));
+}
+
+TensorSpec map(const TensorEngine &engine, const TensorSpec &a, TensorEngine::map_fun_t function) {
+    Stash stash;
+    Value::UP arg = engine.from_spec(a);
+    return engine.to_spec(engine.map(*arg, function, stash));
+}
+
+void verifyJoin(const TensorSpec &a, const TensorSpec &b) {
+    EXPECT_EQUAL(join(ref_engine, a, b, operation::Mul::f), join(prod_engine, a, b, operation::Mul::f));
+    EXPECT_EQUAL(join(ref_engine, a, b, operation::Add::f), join(prod_engine, a, b, operation::Add::f));
+    EXPECT_EQUAL(join(ref_engine, a, b, operation::Sub::f), join(prod_engine, a, b, operation::Sub::f));
+    EXPECT_EQUAL(join(ref_engine, b, a, operation::Sub::f), join(prod_engine, b, a, operation::Sub::f));
+}
+
+void verifyReduce(const TensorSpec &a, const std::vector<vespalib::string> &dimensions) {
+    EXPECT_EQUAL(reduce(ref_engine, a, Aggr::SUM, dimensions), reduce(prod_engine, a, Aggr::SUM, dimensions));
+    EXPECT_EQUAL(reduce(ref_engine, a, Aggr::MAX, dimensions), reduce(prod_engine, a, Aggr::MAX, dimensions));
+}
+
+TensorSpec embeddings = makeSpec("tensor(cat{},x[4])", {mapped("cat", 3), indexed("x", 4)}, 1.0);
+
+TEST("require that mixed tensors get a native representation") {
+    Value::UP value = prod_engine.from_spec(embeddings);
+    EXPECT_TRUE(isMixed(*value));
+    EXPECT_EQUAL(embeddings, prod_engine.to_spec(*value));
+    EXPECT_EQUAL(ref_engine.to_spec(*ref_engine.from_spec(embeddings)), prod_engine.to_spec(*value));
+}
+
+TEST("require that mixed tensors can be serialized") {
+    Value::UP value = prod_engine.from_spec(embeddings);
+    nbostream data;
+    prod_engine.encode(*value, data);
+    Value::UP decoded = prod_engine.decode(data);
+    EXPECT_TRUE(isMixed(*decoded));
+    EXPECT_EQUAL(embeddings, prod_engine.to_spec(*decoded));
+    const auto &tensor = static_cast<const tensor::Tensor &>(*value->as_tensor());
+    EXPECT_TRUE(tensor.equals(static_cast<const tensor::Tensor &>(*decoded->as_tensor())));
+    EXPECT_TRUE(tensor.equals(*tensor.clone()));
+}
+
+TEST("require that mixed tensors are joined with dense tensors") {
+    TEST_DO(verifyJoin(embeddings, makeSpec("tensor(x[4])", {indexed("x", 4)}, 5.0)));
+    TEST_DO(verifyJoin(embeddings, makeSpec("tensor(y[2])", {indexed("y", 2)}, 5.0)));
+    TEST_DO(verifyJoin(makeSpec("tensor(cat{},x[2],y[3])", {mapped("cat", 2), indexed("x", 2), indexed("y", 3)}, 1.0),
+                       makeSpec("tensor(y[3])", {indexed("y", 3)}, 7.0)));
+}
+
+TEST("require that mixed tensors with the same mapped dimensions are joined") {
+    TEST_DO(verifyJoin(embeddings, makeSpec("tensor(cat{},x[4])", {mapped("cat", 2), indexed("x", 4)}, 3.0)));
+    TEST_DO(verifyJoin(embeddings, makeSpec("tensor(cat{},y[2])", {mapped("cat", 4), indexed("y", 2)}, 3.0)));
+}
+
+TEST("require that other joins with mixed tensors fall back to the reference implementation") {
+    TEST_DO(verifyJoin(embeddings, makeSpec("tensor(cat{})", {mapped("cat", 2)}, 3.0)));
+    TEST_DO(verifyJoin(embeddings, makeSpec("tensor(ctx{},x[4])", {mapped("ctx", 2), indexed("x", 4)}, 3.0)));
+}
+
+TEST("require that mixed tensors are reduced correctly") {
+    TensorSpec tensor = makeSpec("tensor(a{},b{},x[3],y[2])",
+                                 {mapped("a", 2), mapped("b", 3), indexed("x", 3), indexed("y", 2)}, 1.0);
+    TEST_DO(verifyReduce(tensor, {"a"}));
+    TEST_DO(verifyReduce(tensor, {"x"}));
+    TEST_DO(verifyReduce(tensor, {"a", "y"}));
+    TEST_DO(verifyReduce(tensor, {"x", "y"}));
+    TEST_DO(verifyReduce(tensor, {"a", "b"}));
+    TEST_DO(verifyReduce(tensor, {"a", "b", "x", "y"}));
+    TEST_DO(verifyReduce(tensor, {}));
+}
+
+TEST("require that a dot product per category can be computed") {
+    TensorSpec query = makeSpec("tensor(x[4])", {indexed("x", 4)}, 2.0);
+    Stash stash;
+    Value::UP lhs = prod_engine.from_spec(embeddings);
+    Value::UP rhs = prod_engine.from_spec(query);
+    const Value &product = prod_engine.join(*lhs, *rhs, operation::Mul::f, stash);
+    EXPECT_TRUE(isMixed(product));
+    const Value &result = prod_engine.reduce(product, Aggr::SUM, {"x"}, stash);
+    TensorSpec expect("tensor(cat{})");
+    expect.add({{"cat", "l0"}}, 1*2 + 2*3 + 3*4 + 4*5).
+        add({{"cat", "l1"}}, 5*2 + 6*3 + 7*4 + 8*5).
+        add({{"cat", "l2"}}, 9*2 + 10*3 + 11*4 + 12*5);
+    EXPECT_EQUAL(expect, prod_engine.to_spec(result));
+}
+
+TEST("require that mixed tensors are mapped correctly") {
+    EXPECT_EQUAL(map(ref_engine, embeddings, operation::Neg::f), map(prod_engine, embeddings, operation::Neg::f));
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
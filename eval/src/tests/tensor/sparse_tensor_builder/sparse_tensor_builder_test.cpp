@@ -106,6 +106,53 @@ TEST("Test sparse tensor address combiner") {
 
 }
 
+TEST("require that address combiner projects labels of overlapping dimensions") {
+    TensorAddressCombiner combiner(ValueType::tensor_type({{"a"}, {"b"}, {"d"}}),
+                                   ValueType::tensor_type({{"b"}, {"c"}, {"d"}}));
+    SparseTensorAddressBuilder lhs;
+    lhs.add("1");
+    lhs.add("2");
+    lhs.add("4");
+    SparseTensorAddressBuilder rhs;
+    rhs.add("2");
+    rhs.add("3");
+    rhs.add("4");
+    SparseTensorAddressBuilder expected;
+    expected.add("2");
+    expected.add("4");
+    SparseTensorAddressBuilder projected;
+    combiner.projectLhs(lhs.getAddressRef(), projected);
+    EXPECT_TRUE(expected.getAddressRef() == projected.getAddressRef());
+    combiner.projectRhs(rhs.getAddressRef(), projected);
+    EXPECT_TRUE(expected.getAddressRef() == projected.getAddressRef());
+}
+
+Tensor::UP
+buildTensor(const vespalib::string &dim1, const vespalib::string &dim2,
+            const std::vector<std::tuple<vespalib::string, vespalib::string, double>> &cells)
+{
+    SparseTensorBuilder builder;
+    for (const auto &cell : cells) {
+        builder.add_label(builder.define_dimension(dim1), std::get<0>(cell)).
+            add_label(builder.define_dimension(dim2), std::get<1>(cell)).add_cell(std::get<2>(cell));
+    }
+    return builder.build();
+}
+
+TEST("require that join only combines cells with matching labels in overlapping dimensions")
+{
+    Tensor::UP lhs = buildTensor("x", "y", {{"1", "a", 1}, {"1", "b", 2}, {"2", "a", 3}, {"3", "c", 4}});
+    Tensor::UP rhs = buildTensor("y", "z", {{"a", "1", 5}, {"a", "2", 6}, {"b", "1", 7}, {"d", "1", 8}});
+    Tensor::UP result = lhs->join([](double a, double b) { return a * b; }, *rhs);
+    TensorSpec expSpec("tensor(x{},y{},z{})");
+    expSpec.add({{"x", "1"}, {"y", "a"}, {"z", "1"}}, 5).
+        add({{"x", "1"}, {"y", "a"}, {"z", "2"}}, 6).
+        add({{"x", "1"}, {"y", "b"}, {"z", "1"}}, 14).
+        add({{"x", "2"}, {"y", "a"}, {"z", "1"}}, 15).
+        add({{"x", "2"}, {"y", "a"}, {"z", "2"}}, 18);
+    EXPECT_EQUAL(expSpec, result->toSpec());
+}
+
 TEST("Test essential object sizes") {
     EXPECT_EQUAL(16u, sizeof(SparseTensorAddressRef));
     EXPECT_EQUAL(24u, sizeof(std::pair<SparseTensorAddressRef, double>));
@@ -8,6 +8,7 @@
 #include "operation.h"
 #include <vespa/vespalib/util/classname.h>
 #include <vespa/eval/eval/llvm/compile_cache.h>
+#include <vespa/eval/eval/llvm/compiled_function.h>
 #include <vespa/vespalib/util/benchmark_timer.h>
 #include <set>
 
@@ -134,6 +135,69 @@ void op_tensor_function_arg_arg(State &state, uint64_t param) {
     state.stack.push_back(meta.function.eval(ConstArrayRef<Value::CREF>(params, 2), state.stash));
 }
 
+struct TensorFunctionArgsMeta {
+    const TensorFunction &function;
+    std::vector<size_t> params;
+    TensorFunctionArgsMeta(const TensorFunction &function_in, const std::vector<size_t> &params_in)
+        : function(function_in), params(params_in) {}
+};
+
+void op_tensor_function_args(State &state, uint64_t param) {
+    const TensorFunctionArgsMeta &meta = unwrap_param<TensorFunctionArgsMeta>(param);
+    std::vector<Value::CREF> params;
+    params.reserve(meta.params.size());
+    for (size_t param_id: meta.params) {
+        params.push_back(state.params->resolve(param_id, state.stash));
+    }
+    state.stack.push_back(meta.function.eval(ConstArrayRef<Value::CREF>(params), state.stash));
+}
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Checks if an expression subtree only does map and join (directly or
+ * through operators and calls) on tensors of the given type, mixed
+ * with plain double calculations. Such a subtree can be compiled into
+ * a single function calculating one result cell at a time.
+ **/
+struct ElementwiseChecker : public NodeTraverser {
+    const NodeTypes &types;
+    const ValueType &type;
+    bool ok;
+    size_t num_ops;
+    std::set<size_t> tensor_params;
+    std::set<size_t> double_params;
+
+    ElementwiseChecker(const NodeTypes &types_in, const ValueType &type_in)
+        : types(types_in), type(type_in), ok(true), num_ops(0), tensor_params(), double_params() {}
+
+    bool open(const Node &node) override {
+        if (!ok) {
+            return false;
+        }
+        const ValueType &node_type = types.get_type(node);
+        if (node_type.is_double()) {
+            if (auto symbol = as<Symbol>(node)) {
+                double_params.insert(symbol->id());
+            } else if (check_type<TensorMap, TensorJoin, TensorReduce, TensorRename, TensorLambda, TensorConcat>(node)) {
+                ok = false;
+            }
+            return ok;
+        }
+        if (!(node_type == type)) {
+            ok = false;
+        } else if (auto symbol = as<Symbol>(node)) {
+            tensor_params.insert(symbol->id());
+        } else if (as<Operator>(node) || as<Call>(node) || check_type<TensorMap, TensorJoin, Neg, Not, In>(node)) {
+            ++num_ops;
+        } else {
+            ok = false;
+        }
+        return ok;
+    }
+    void close(const Node &) override {}
+};
+
 //-----------------------------------------------------------------------------
 
 bool step_labels(std::vector<double> &labels, const ValueType &type) {
@@ -148,6 +212,42 @@ bool step_labels(std::vector<double> &labels, const ValueType &type) {
     return false;
 }
 
+/**
+ * Plans the stash needed to evaluate a function with known types.
+ * Every node may leave a value in the stash, and nodes with a
+ * concrete dense tensor type may also leave its cells there. The
+ * chunk size is chosen so that all of this fits in a single chunk,
+ * which is kept when the stash is cleared between evaluations.
+ **/
+struct StashPlanner : public NodeTraverser {
+    static constexpr size_t value_overhead = 64;
+    const NodeTypes &types;
+    size_t total_size;
+    size_t max_cells_size;
+
+    explicit StashPlanner(const NodeTypes &types_in)
+        : types(types_in), total_size(0), max_cells_size(0) {}
+
+    bool open(const Node &) override { return true; }
+    void close(const Node &node) override {
+        total_size += value_overhead;
+        const ValueType &type = types.get_type(node);
+        if (type.is_dense() && !type.is_abstract()) {
+            size_t cells_size = sizeof(double);
+            for (const auto &dim: type.dimensions()) {
+                cells_size *= dim.size;
+            }
+            total_size += cells_size;
+            max_cells_size = std::max(max_cells_size, cells_size);
+        }
+    }
+    size_t chunk_size() const {
+        // allocations must be smaller than a quarter of a chunk to
+        // be placed inside it (see Stash::is_small)
+        return std::max(total_size, 4 * (max_cells_size + sizeof(char *)));
+    }
+};
+
 //-----------------------------------------------------------------------------
 
 struct ProgramBuilder : public NodeVisitor, public NodeTraverser {
@@ -155,9 +255,12 @@ struct ProgramBuilder : public NodeVisitor, public NodeTraverser {
     Stash                    &stash;
     const TensorEngine       &tensor_engine;
     const NodeTypes          &types;
+    size_t                    num_params;
 
-    ProgramBuilder(std::vector<Instruction> &program_in, Stash &stash_in, const TensorEngine &tensor_engine_in, const NodeTypes &types_in)
-        : program(program_in), stash(stash_in), tensor_engine(tensor_engine_in), types(types_in) {}
+    ProgramBuilder(std::vector<Instruction> &program_in, Stash &stash_in, const TensorEngine &tensor_engine_in,
+                   const NodeTypes &types_in, size_t num_params_in)
+        : program(program_in), stash(stash_in), tensor_engine(tensor_engine_in), types(types_in),
+          num_params(num_params_in) {}
 
     //-------------------------------------------------------------------------
 
@@ -193,6 +296,56 @@ struct ProgramBuilder : public NodeVisitor, public NodeTraverser {
                 is_typed_tensor_param(node.get_child(1)));
     }
 
+    bool is_concrete_dense_tensor(const ValueType &type) const {
+        return (type.is_dense() && !type.dimensions().empty() && !type.is_abstract());
+    }
+
+    // Chains of map/join on dense tensors of the same type (optionally
+    // reduced to a double) are compiled into a single function
+    // calculating one cell at a time, avoiding intermediate tensors.
+    bool try_make_elementwise_op(const Node &node) {
+        const Node *cell_root = &node;
+        auto reduce = as<TensorReduce>(node);
+        if (reduce) {
+            if (!types.get_type(node).is_double() || is_typed_tensor_product_of_params(node.get_child(0))) {
+                return false;
+            }
+            cell_root = &node.get_child(0);
+        }
+        const ValueType &type = types.get_type(*cell_root);
+        if (!is_concrete_dense_tensor(type)) {
+            return false;
+        }
+        ElementwiseChecker checker(types, type);
+        cell_root->traverse(checker);
+        if (!checker.ok || (checker.num_ops < 2)) {
+            return false;
+        }
+        std::vector<const tensor_function::Node *> inputs;
+        std::vector<size_t> params;
+        for (size_t param: checker.tensor_params) {
+            inputs.push_back(&tensor_function::inject(type, inputs.size(), stash));
+            params.push_back(param);
+        }
+        for (size_t param: checker.double_params) {
+            inputs.push_back(&tensor_function::inject(ValueType::double_type(), inputs.size(), stash));
+            params.push_back(param);
+        }
+        const auto &cell_fun = stash.create<CompiledFunction>(*cell_root, num_params, PassParams::ARRAY, gbdt::Optimize::none);
+        const tensor_function::Node *ir = &tensor_function::elementwise(type, inputs, params, num_params,
+                                                                        cell_fun.get_function(), stash);
+        if (reduce) {
+            ir = &tensor_function::reduce(*ir, reduce->aggr(), reduce->dimensions(), stash);
+        }
+        const auto &fun = tensor_engine.compile(*ir, stash);
+        if (&fun == ir) {
+            return false; // no gain unless the tensor engine has a native implementation
+        }
+        const auto &meta = stash.create<TensorFunctionArgsMeta>(fun, params);
+        program.emplace_back(op_tensor_function_args, wrap_param<TensorFunctionArgsMeta>(meta));
+        return true;
+    }
+
     //-------------------------------------------------------------------------
 
     void make_const_op(const Node &node, const Value &value) {
@@ -445,6 +598,11 @@ struct ProgramBuilder : public NodeVisitor, public NodeTraverser {
             node.accept(*this);
             return false;
         }
+        if (check_type<TensorMap, TensorJoin, TensorReduce, Neg, Not, In>(node) || as<Operator>(node) || as<Call>(node)) {
+            if (try_make_elementwise_op(node)) {
+                return false;
+            }
+        }
         return true;
     }
 
@@ -495,10 +653,10 @@ InterpretedFunction::SimpleObjectParams::resolve(size_t idx, Stash &) const
     return params[idx];
 }
 
-InterpretedFunction::State::State(const TensorEngine &engine_in)
+InterpretedFunction::State::State(const TensorEngine &engine_in, size_t stash_size)
     : engine(engine_in),
       params(nullptr),
-      stash(),
+      stash(stash_size),
       stack(),
       program_offset(0)
 {
@@ -524,7 +682,7 @@ InterpretedFunction::State::replace(size_t prune_cnt, const Value &value) {
 }
 
 InterpretedFunction::Context::Context(const InterpretedFunction &ifun)
-    : _state(ifun._tensor_engine)
+    : _state(ifun._tensor_engine, ifun._stash_size)
 {
 }
 
@@ -532,9 +690,13 @@ InterpretedFunction::InterpretedFunction(const TensorEngine &engine, const nodes
     : _program(),
       _stash(),
       _num_params(num_params_in),
+      _stash_size(0),
       _tensor_engine(engine)
 {
-    ProgramBuilder program_builder(_program, _stash, _tensor_engine, types);
+    StashPlanner stash_planner(types);
+    root.traverse(stash_planner);
+    _stash_size = stash_planner.chunk_size();
+    ProgramBuilder program_builder(_program, _stash, _tensor_engine, types, _num_params);
     root.traverse(program_builder);
 }
 
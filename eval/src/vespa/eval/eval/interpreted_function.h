@@ -61,7 +61,7 @@ public:
         uint32_t                 program_offset;
         uint32_t                 if_cnt;
 
-        State(const TensorEngine &engine_in);
+        State(const TensorEngine &engine_in, size_t stash_size);
         ~State();
 
         void init(const LazyParams &params_in);
@@ -77,6 +77,7 @@ public:
     public:
         explicit Context(const InterpretedFunction &ifun);
         uint32_t if_cnt() const { return _state.if_cnt; }
+        const Stash &stash() const { return _state.stash; }
     };
     using op_function = void (*)(State &, uint64_t);
     class Instruction {
@@ -96,6 +97,7 @@ private:
     std::vector<Instruction> _program;
     Stash                    _stash;
     size_t                   _num_params;
+    size_t                   _stash_size;
     const TensorEngine      &_tensor_engine;
 
 public:
@@ -107,6 +109,9 @@ public:
     ~InterpretedFunction();
     size_t program_size() const { return _program.size(); }
     size_t num_params() const { return _num_params; }
+    // chunk size used for the stash of each evaluation context; large
+    // enough to hold all intermediate results when the types are known
+    size_t stash_size() const { return _stash_size; }
     const Value &eval(Context &ctx, const LazyParams &params) const;
     double estimate_cost_us(const std::vector<double> &params, double budget = 5.0) const;
     static Function::Issues detect_issues(const Function &function);
@@ -2,13 +2,54 @@
 
 #include "compile_cache.h"
 #include <vespa/eval/eval/key_gen.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <chrono>
 #include <thread>
 
 namespace vespalib {
 namespace eval {
 
+namespace {
+
+// same stack size as the dedicated threads used for synchronous compilation
+constexpr uint32_t compile_stack_size = 8 * 1024 * 1024;
+
+vespalib::Executor &async_compile_executor() {
+    static vespalib::ThreadStackExecutor executor(1, compile_stack_size);
+    return executor;
+}
+
+} // namespace vespalib::eval::<unnamed>
+
 std::mutex CompileCache::_lock;
 CompileCache::Map CompileCache::_cached;
+CompileCache::Stats CompileCache::_stats;
+
+void
+CompileCache::Result::set(CompiledFunction &&cf_in)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    cf = std::make_unique<CompiledFunction>(std::move(cf_in));
+    cond.notify_all();
+}
+
+const CompiledFunction *
+CompileCache::Result::try_get()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return cf.get();
+}
+
+const CompiledFunction &
+CompileCache::Result::get()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    while (!cf) {
+        cond.wait(guard);
+    }
+    return *cf;
+}
 
 void
 CompileCache::release(Map::iterator entry)
@@ -19,6 +60,24 @@ CompileCache::release(Map::iterator entry)
     }
 }
 
+double
+CompileCache::compile_into(const Function &function, PassParams pass_params, Result &result)
+{
+    auto before = std::chrono::steady_clock::now();
+    CompiledFunction cf(function, pass_params);
+    double compile_time_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - before).count();
+    result.set(std::move(cf));
+    return compile_time_s;
+}
+
+void
+CompileCache::add_compile_time(double compile_time_s)
+{
+    ++_stats.num_compiled;
+    _stats.total_compile_time_s += compile_time_s;
+    _stats.max_compile_time_s = std::max(_stats.max_compile_time_s, compile_time_s);
+}
+
 CompileCache::Token::UP
 CompileCache::compile(const Function &function, PassParams pass_params)
 {
@@ -29,6 +88,33 @@ CompileCache::compile(const Function &function, PassParams pass_params)
     return std::move(compile_ctx.token);
 }
 
+CompileCache::Token::UP
+CompileCache::compile_async(std::shared_ptr<const Function> function, PassParams pass_params)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    vespalib::string key = gen_key(*function, pass_params);
+    auto pos = _cached.find(key);
+    if (pos != _cached.end()) {
+        ++(pos->second.num_refs);
+        return Token::UP(new Token(pos));
+    }
+    auto res = _cached.emplace(std::move(key), Value());
+    assert(res.second);
+    Result::SP result = res.first->second.result;
+    auto task = makeLambdaTask([function, pass_params, result]()
+                               {
+                                   double compile_time_s = compile_into(*function, pass_params, *result);
+                                   std::lock_guard<std::mutex> task_guard(_lock);
+                                   add_compile_time(compile_time_s);
+                               });
+    if (async_compile_executor().execute(std::move(task))) {
+        // executor is shut down (process exit); compile synchronously instead
+        std::thread thread([&]() { add_compile_time(compile_into(*function, pass_params, *result)); });
+        thread.join();
+    }
+    return Token::UP(new Token(res.first));
+}
+
 size_t
 CompileCache::num_cached()
 {
@@ -47,6 +133,13 @@ CompileCache::count_refs()
     return refs;
 }
 
+CompileCache::Stats
+CompileCache::get_stats()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _stats;
+}
+
 void
 CompileCache::do_compile(CompileContext &ctx) {
     vespalib::string key = gen_key(ctx.function, ctx.pass_params);
@@ -55,8 +148,9 @@ CompileCache::do_compile(CompileContext &ctx) {
         ++(pos->second.num_refs);
         ctx.token.reset(new Token(pos));
     } else {
-        auto res = _cached.emplace(std::move(key), Value(CompiledFunction(ctx.function, ctx.pass_params)));
+        auto res = _cached.emplace(std::move(key), Value());
         assert(res.second);
+        add_compile_time(compile_into(ctx.function, ctx.pass_params, *res.first->second.result));
         ctx.token.reset(new Token(res.first));
     }
 }
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "compiled_function.h"
+#include <condition_variable>
 #include <mutex>
 
 namespace vespalib {
@@ -15,21 +16,47 @@ namespace eval {
  * to query the cache. The cache itself will not keep anything alive,
  * but will let you find compiled functions that are currently in use
  * by others.
+ *
+ * Functions may also be compiled asynchronously by a background
+ * thread. This lets the caller use a slower fallback (like an
+ * interpreted function) until the compiled function is ready,
+ * instead of blocking during application configuration.
  **/
 class CompileCache
 {
+public:
+    struct Stats {
+        size_t num_compiled;
+        double total_compile_time_s;
+        double max_compile_time_s;
+        Stats() : num_compiled(0), total_compile_time_s(0.0), max_compile_time_s(0.0) {}
+    };
+
 private:
     typedef vespalib::string Key;
+    struct Result {
+        using SP = std::shared_ptr<Result>;
+        std::mutex lock;
+        std::condition_variable cond;
+        std::unique_ptr<CompiledFunction> cf;
+        Result() : lock(), cond(), cf() {}
+        void set(CompiledFunction &&cf_in);
+        const CompiledFunction *try_get();
+        const CompiledFunction &get();
+    };
     struct Value {
         size_t num_refs;
-        CompiledFunction cf;
-        Value(CompiledFunction &&cf_in) : num_refs(1), cf(std::move(cf_in)) {}
+        Result::SP result;
+        Value() : num_refs(1), result(std::make_shared<Result>()) {}
     };
     typedef std::map<Key,Value> Map;
     static std::mutex _lock;
     static Map _cached;
+    static Stats _stats;
 
     static void release(Map::iterator entry);
+    static double compile_into(const Function &function, PassParams pass_params, Result &result);
+    static void add_compile_time(double compile_time_s); // _lock must be held
 
 public:
     class Token
@@ -41,12 +68,17 @@ public:
             : entry(entry_in) {}
     public:
         typedef std::unique_ptr<Token> UP;
-        const CompiledFunction &get() const { return entry->second.cf; }
+        // wait for the function to be compiled if needed
+        const CompiledFunction &get() const { return entry->second.result->get(); }
+        // returns nullptr if the function is not compiled yet
+        const CompiledFunction *try_get() const { return entry->second.result->try_get(); }
         ~Token() { CompileCache::release(entry); }
     };
     static Token::UP compile(const Function &function, PassParams pass_params);
+    static Token::UP compile_async(std::shared_ptr<const Function> function, PassParams pass_params);
     static size_t num_cached();
     static size_t count_refs();
+    static Stats get_stats();
 
 private:
     struct CompileContext {
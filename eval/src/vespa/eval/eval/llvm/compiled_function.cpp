@@ -30,14 +30,20 @@ double my_resolve(void *ctx, size_t idx) { return ((double *)ctx)[idx]; }
 
 CompiledFunction::CompiledFunction(const Function &function_in, PassParams pass_params_in,
                                    const gbdt::Optimize::Chain &forest_optimizers)
+    : CompiledFunction(function_in.root(), function_in.num_params(), pass_params_in, forest_optimizers)
+{
+}
+
+CompiledFunction::CompiledFunction(const nodes::Node &root_in, size_t num_params_in, PassParams pass_params_in,
+                                   const gbdt::Optimize::Chain &forest_optimizers)
     : _llvm_wrapper(),
       _address(nullptr),
-      _num_params(function_in.num_params()),
+      _num_params(num_params_in),
       _pass_params(pass_params_in)
 {
-    size_t id = _llvm_wrapper.make_function(function_in.num_params(),
+    size_t id = _llvm_wrapper.make_function(_num_params,
                                             _pass_params,
-                                            function_in.root(),
+                                            root_in,
                                             forest_optimizers);
     _llvm_wrapper.compile();
     _address = _llvm_wrapper.get_function_address(id);
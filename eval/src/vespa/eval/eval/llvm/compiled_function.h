@@ -11,7 +11,10 @@ namespace eval {
 
 /**
  * A Function that has been compiled to machine code using LLVM. Note
- * that tensors are currently not supported for compiled functions.
+ * that tensors are generally not supported for compiled functions.
+ * The exception is compiling an expression subtree that only does
+ * map and join on tensors of the same type; the result is a function
+ * calculating a single cell from the corresponding parameter cells.
  **/
 class CompiledFunction
 {
@@ -41,6 +44,8 @@ public:
                      const gbdt::Optimize::Chain &forest_optimizers);
     CompiledFunction(const Function &function_in, PassParams pass_params_in)
         : CompiledFunction(function_in, pass_params_in, gbdt::Optimize::best) {}
+    CompiledFunction(const nodes::Node &root_in, size_t num_params_in, PassParams pass_params_in,
+                     const gbdt::Optimize::Chain &forest_optimizers);
     CompiledFunction(CompiledFunction &&rhs);
     size_t num_params() const { return _num_params; }
     PassParams pass_params() const { return _pass_params; }
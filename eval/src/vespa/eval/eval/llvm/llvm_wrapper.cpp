@@ -15,6 +15,7 @@
 #include <llvm/LinkAllPasses.h>
 #include <llvm/Transforms/IPO/PassManagerBuilder.h>
 #include <vespa/eval/eval/check_type.h>
+#include <vespa/eval/eval/tensor_nodes.h>
 #include <vespa/vespalib/stllike/hash_set.h>
 #include <vespa/vespalib/util/approx.h>
 
@@ -75,6 +76,7 @@ struct FunctionBuilder : public NodeVisitor, public NodeTraverser {
     llvm::IRBuilder<>         builder;
     std::vector<llvm::Value*> params;
     std::vector<llvm::Value*> values;
+    const std::vector<llvm::Value*> *lambda_args;
     llvm::Function           *function;
     size_t                    num_params;
     PassParams                pass_params;
@@ -132,6 +134,7 @@ struct FunctionBuilder : public NodeVisitor, public NodeTraverser {
           builder(context),
           params(),
           values(),
+          lambda_args(nullptr),
           function(nullptr),
           num_params(num_params_in),
           pass_params(pass_params_in),
@@ -351,7 +354,12 @@ struct FunctionBuilder : public NodeVisitor, public NodeTraverser {
         push_double(item.value());
     }
     void visit(const Symbol &item) override {
-        push(get_param(item.id()));
+        if (lambda_args != nullptr) {
+            assert(item.id() < lambda_args->size());
+            push((*lambda_args)[item.id()]);
+        } else {
+            push(get_param(item.id()));
+        }
     }
     void visit(const String &item) override {
         push_double(item.hash());
@@ -417,13 +425,27 @@ struct FunctionBuilder : public NodeVisitor, public NodeTraverser {
         make_error(0);
     }
 
-    // tensor nodes (not supported in compiled expressions)
+    // tensor nodes; map and join are compiled by inlining their
+    // lambdas, which calculates a single cell of the result when all
+    // tensors in the expression have the same type (see
+    // InterpretedFunction). Other tensor nodes are not supported.
+
+    void inline_lambda(const Function &lambda, const std::vector<llvm::Value*> &args) {
+        assert(args.size() == lambda.num_params());
+        const std::vector<llvm::Value*> *outer_args = lambda_args;
+        lambda_args = &args;
+        lambda.root().traverse(*this); // NB: recursion
+        lambda_args = outer_args;
+    }
 
     void visit(const TensorMap &node) override {
-        make_error(node.num_children());
+        llvm::Value *a = pop_double();
+        inline_lambda(node.lambda(), {a});
     }
     void visit(const TensorJoin &node) override {
-        make_error(node.num_children());
+        llvm::Value *b = pop_double();
+        llvm::Value *a = pop_double();
+        inline_lambda(node.lambda(), {a, b});
     }
     void visit(const TensorReduce &node) override {
         make_error(node.num_children());
@@ -0,0 +1,141 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "quick_forest.h"
+#include <vespa/eval/eval/basic_nodes.h>
+#include <vespa/eval/eval/call_nodes.h>
+#include <vespa/eval/eval/operator_nodes.h>
+#include <vespa/vespalib/util/optimized.h>
+#include <algorithm>
+#include <cassert>
+
+namespace vespalib {
+namespace eval {
+namespace gbdt {
+
+namespace {
+
+//-----------------------------------------------------------------------------
+
+struct Check {
+    uint32_t feature;
+    double   threshold;
+    uint32_t tree_id;
+    uint64_t mask;
+    bool operator<(const Check &rhs) const {
+        if (feature != rhs.feature) {
+            return (feature < rhs.feature);
+        }
+        return (threshold < rhs.threshold);
+    }
+};
+
+uint64_t leaf_bits(size_t num_leafs) {
+    return (num_leafs == QuickForest::MAX_LEAFS) ? ~uint64_t(0) : ((uint64_t(1) << num_leafs) - 1);
+}
+
+void encode_node(const nodes::Node &node, uint32_t tree_id, size_t first_leaf,
+                 std::vector<double> &leafs, std::vector<Check> &checks)
+{
+    auto if_node = nodes::as<nodes::If>(node);
+    if (if_node) {
+        auto less = nodes::as<nodes::Less>(if_node->cond());
+        assert(less);
+        auto symbol = nodes::as<nodes::Symbol>(less->lhs());
+        assert(symbol);
+        assert(less->rhs().is_const());
+        size_t true_begin = (leafs.size() - first_leaf);
+        encode_node(if_node->true_expr(), tree_id, first_leaf, leafs, checks);
+        size_t true_end = (leafs.size() - first_leaf);
+        assert(true_end <= QuickForest::MAX_LEAFS);
+        uint64_t true_leafs = (leaf_bits(true_end) & ~leaf_bits(true_begin));
+        checks.push_back(Check{uint32_t(symbol->id()), less->rhs().get_const_value(), tree_id, ~true_leafs});
+        encode_node(if_node->false_expr(), tree_id, first_leaf, leafs, checks);
+    } else {
+        assert(node.is_const());
+        leafs.push_back(node.get_const_value());
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+} // namespace vespalib::eval::gbdt::<unnamed>
+
+QuickForest::QuickForest(size_t num_params, const std::vector<const nodes::Node *> &trees)
+    : _feature_offsets(),
+      _thresholds(),
+      _tree_ids(),
+      _masks(),
+      _init_leafs(),
+      _leaf_offsets(),
+      _leafs()
+{
+    std::vector<Check> checks;
+    for (uint32_t tree_id = 0; tree_id < trees.size(); ++tree_id) {
+        size_t first_leaf = _leafs.size();
+        _leaf_offsets.push_back(first_leaf);
+        encode_node(*trees[tree_id], tree_id, first_leaf, _leafs, checks);
+        size_t num_leafs = (_leafs.size() - first_leaf);
+        assert(num_leafs <= MAX_LEAFS);
+        _init_leafs.push_back(leaf_bits(num_leafs));
+    }
+    std::stable_sort(checks.begin(), checks.end());
+    _thresholds.reserve(checks.size());
+    _tree_ids.reserve(checks.size());
+    _masks.reserve(checks.size());
+    size_t check_idx = 0;
+    for (uint32_t feature = 0; feature < num_params; ++feature) {
+        _feature_offsets.push_back(_thresholds.size());
+        for (; (check_idx < checks.size()) && (checks[check_idx].feature == feature); ++check_idx) {
+            _thresholds.push_back(checks[check_idx].threshold);
+            _tree_ids.push_back(checks[check_idx].tree_id);
+            _masks.push_back(checks[check_idx].mask);
+        }
+    }
+    assert(check_idx == checks.size());
+    _feature_offsets.push_back(_thresholds.size());
+}
+
+QuickForest::~QuickForest() = default;
+
+Optimize::Result
+QuickForest::optimize(const ForestStats &stats,
+                      const std::vector<const nodes::Node *> &trees)
+{
+    if ((stats.total_in_checks > 0) || stats.tree_sizes.empty() ||
+        (stats.tree_sizes.back().size > MAX_LEAFS))
+    {
+        return Optimize::Result();
+    }
+    return Optimize::Result(Forest::UP(new QuickForest(stats.num_params, trees)), eval);
+}
+
+double
+QuickForest::eval(const Forest *forest, const double *input)
+{
+    const QuickForest &self = *((const QuickForest *)forest);
+    std::vector<uint64_t> leafs(self._init_leafs);
+    const double *thresholds = &self._thresholds[0];
+    const uint32_t *tree_ids = &self._tree_ids[0];
+    const uint64_t *masks = &self._masks[0];
+    for (size_t feature = 0; (feature + 1) < self._feature_offsets.size(); ++feature) {
+        double value = input[feature];
+        uint32_t end = self._feature_offsets[feature + 1];
+        // checks are sorted by threshold; stop at the first one that is true
+        for (uint32_t i = self._feature_offsets[feature]; (i < end) && !(value < thresholds[i]); ++i) {
+            leafs[tree_ids[i]] &= masks[i];
+        }
+    }
+    double sum = 0.0;
+    for (size_t tree_id = 0; tree_id < leafs.size(); ++tree_id) {
+        sum += self._leafs[self._leaf_offsets[tree_id] + Optimized::lsbIdx(leafs[tree_id])];
+    }
+    return sum;
+}
+
+Optimize::Chain QuickForest::optimize_chain({optimize});
+
+//-----------------------------------------------------------------------------
+
+} // namespace vespalib::eval::gbdt
+} // namespace vespalib::eval
+} // namespace vespalib
@@ -0,0 +1,47 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "gbdt.h"
+
+namespace vespalib {
+namespace eval {
+namespace gbdt {
+
+/**
+ * GBDT forest optimizer evaluating all trees at once by feature
+ * instead of one tree at a time (QuickScorer). Each tree keeps a
+ * bitvector of possible exit leafs. All checks are grouped by
+ * feature and sorted by threshold, making it possible to find all
+ * false checks for a feature with a single linear scan. Each false
+ * check removes the leafs in its true subtree from the bitvector of
+ * its tree. The exit leaf of each tree is the leftmost remaining
+ * one. Only forests with less checks and at most 64 leafs per tree
+ * are supported.
+ **/
+class QuickForest : public Forest
+{
+public:
+    static constexpr size_t MAX_LEAFS = 64;
+
+private:
+    std::vector<uint32_t> _feature_offsets;
+    std::vector<double>   _thresholds;
+    std::vector<uint32_t> _tree_ids;
+    std::vector<uint64_t> _masks;
+    std::vector<uint64_t> _init_leafs;
+    std::vector<uint32_t> _leaf_offsets;
+    std::vector<double>   _leafs;
+
+public:
+    QuickForest(size_t num_params, const std::vector<const nodes::Node *> &trees);
+    ~QuickForest();
+    static Optimize::Result optimize(const ForestStats &stats,
+                                     const std::vector<const nodes::Node *> &trees);
+    static double eval(const Forest *forest, const double *);
+    static Optimize::Chain optimize_chain;
+};
+
+} // namespace vespalib::eval::gbdt
+} // namespace vespalib::eval
+} // namespace vespalib
@@ -6,6 +6,8 @@
 #include "tensor.h"
 #include "tensor_engine.h"
 #include "simple_tensor_engine.h"
+#include "tensor_spec.h"
+#include <cassert>
 
 namespace vespalib {
 namespace eval {
@@ -53,6 +55,46 @@ Join::eval(ConstArrayRef<Value::CREF> params, Stash &stash) const
     return engine.join(a, b, function, stash);
 }
 
+const Value &
+Elementwise::eval(ConstArrayRef<Value::CREF> params, Stash &stash) const
+{
+    // generic fallback; tensor engines are expected to compile this into something faster
+    std::vector<double> args(num_args, 0.0);
+    std::vector<TensorSpec> specs;
+    std::vector<size_t> spec_arg_idx;
+    const TensorEngine *engine = &SimpleTensorEngine::ref();
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        const Value &value = inputs[i]->eval(params, stash);
+        if (auto tensor = value.as_tensor()) {
+            engine = &tensor->engine();
+            specs.push_back(engine->to_spec(value));
+            spec_arg_idx.push_back(arg_idx[i]);
+        } else {
+            args[arg_idx[i]] = value.as_double();
+        }
+    }
+    if (specs.empty()) {
+        return stash.create<DoubleValue>(function(&args[0]));
+    }
+    TensorSpec result(result_type.to_spec());
+    using CellItr = TensorSpec::Cells::const_iterator;
+    std::vector<CellItr> cells;
+    for (const auto &spec: specs) {
+        cells.push_back(spec.cells().begin());
+    }
+    // all inputs have the same type, so their cells are visited in the same order
+    for (; cells[0] != specs[0].cells().end(); ) {
+        for (size_t i = 0; i < cells.size(); ++i) {
+            args[spec_arg_idx[i]] = cells[i]->second;
+        }
+        result.add(cells[0]->first, function(&args[0]));
+        for (auto &cell: cells) {
+            ++cell;
+        }
+    }
+    return *stash.create<Value::UP>(engine->from_spec(result));
+}
+
 //-----------------------------------------------------------------------------
 
 const Node &inject(const ValueType &type, size_t tensor_id, Stash &stash) {
@@ -74,6 +116,14 @@ const Node &join(const Node &lhs_tensor, const Node &rhs_tensor, join_fun_t func
     return stash.create<Join>(result_type, lhs_tensor, rhs_tensor, function);
 }
 
+const Node &elementwise(const ValueType &type, const std::vector<const Node *> &inputs,
+                        const std::vector<size_t> &arg_idx, size_t num_args,
+                        cell_fun_t function, Stash &stash)
+{
+    assert(inputs.size() == arg_idx.size());
+    return stash.create<Elementwise>(type, inputs, arg_idx, num_args, function);
+}
+
 } // namespace vespalib::eval::tensor_function
 } // namespace vespalib::eval
 } // namespace vespalib
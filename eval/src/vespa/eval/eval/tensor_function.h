@@ -57,6 +57,7 @@ namespace tensor_function {
 
 using map_fun_t = double (*)(double);
 using join_fun_t = double (*)(double, double);
+using cell_fun_t = double (*)(const double *);
 
 /**
  * Interface used to describe a tensor function as a tree of nodes
@@ -124,10 +125,37 @@ struct Join : Node {
     const Value &eval(ConstArrayRef<Value::CREF> params, Stash &stash) const override;
 };
 
+/**
+ * Elementwise combination of any number of inputs. All tensor inputs
+ * have the same type as the result, while double inputs are used as
+ * is for all cells. Each result cell is calculated by calling the
+ * function with an array of 'num_args' values, where the value of
+ * input i (the input cell for tensors) is found at index
+ * 'arg_idx[i]'. The function is typically a chain of map/join
+ * operations compiled into a single function.
+ **/
+struct Elementwise : Node {
+    const std::vector<const Node *> inputs;
+    const std::vector<size_t> arg_idx;
+    const size_t num_args;
+    const cell_fun_t function;
+    Elementwise(const ValueType &result_type_in,
+                const std::vector<const Node *> &inputs_in,
+                const std::vector<size_t> &arg_idx_in,
+                size_t num_args_in,
+                cell_fun_t function_in)
+        : Node(result_type_in), inputs(inputs_in), arg_idx(arg_idx_in),
+          num_args(num_args_in), function(function_in) {}
+    const Value &eval(ConstArrayRef<Value::CREF> params, Stash &stash) const override;
+};
+
 const Node &inject(const ValueType &type, size_t tensor_id, Stash &stash);
 const Node &reduce(const Node &tensor, Aggr aggr, const std::vector<vespalib::string> &dimensions, Stash &stash);
 const Node &map(const Node &tensor, map_fun_t function, Stash &stash);
 const Node &join(const Node &lhs_tensor, const Node &rhs_tensor, join_fun_t function, Stash &stash);
+const Node &elementwise(const ValueType &type, const std::vector<const Node *> &inputs,
+                        const std::vector<size_t> &arg_idx, size_t num_args,
+                        cell_fun_t function, Stash &stash);
 
 } // namespace vespalib::eval::tensor_function
 } // namespace vespalib::eval
@@ -7,7 +7,17 @@
 #include <vespa/vespalib/io/mapped_file_input.h>
 #include <vespa/vespalib/data/lz4_input_decoder.h>
 #include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/xxhash/xxhash.h>
 #include <set>
+#include <cinttypes>
+#include <ctime>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".vespalib.eval.value_cache.constant_tensor_loader");
@@ -41,33 +51,123 @@ struct AddressExtractor : ObjectTraverser {
     }
 };
 
-void decode_json(const vespalib::string &path, Input &input, Slime &slime) {
+bool decode_json(const vespalib::string &path, Input &input, Slime &slime) {
     if (slime::JsonFormat::decode(input, slime) == 0) {
         LOG(warning, "file contains invalid json: %s", path.c_str());
+        return false;
     }
+    return true;
 }
 
-void decode_json(const vespalib::string &path, Slime &slime) {
-    MappedFileInput file(path);
-    if (!file.valid()) {
-        LOG(warning, "could not read file: %s", path.c_str());
+bool decode_file(const vespalib::string &path, MappedFileInput &file, Slime &slime) {
+    if (ends_with(path, ".lz4")) {
+        size_t buffer_size = 64 * 1024;
+        Lz4InputDecoder lz4_decoder(file, buffer_size);
+        bool ok = decode_json(path, lz4_decoder, slime);
+        if (lz4_decoder.failed()) {
+            LOG(warning, "file contains lz4 errors (%s): %s",
+                lz4_decoder.reason().c_str(), path.c_str());
+            return false;
+        }
+        return ok;
     } else {
-        if (ends_with(path, ".lz4")) {
-            size_t buffer_size = 64 * 1024;
-            Lz4InputDecoder lz4_decoder(file, buffer_size);            
-            decode_json(path, lz4_decoder, slime);
-            if (lz4_decoder.failed()) {
-                LOG(warning, "file contains lz4 errors (%s): %s",
-                    lz4_decoder.reason().c_str(), path.c_str());
-            }
-        } else {
-            decode_json(path, file, slime);            
+        return decode_json(path, file, slime);
+    }
+}
+
+// binary cache files: magic, payload size, payload hash, payload
+
+constexpr uint32_t CACHE_MAGIC = 0x54434331; // "TCC1"
+constexpr size_t CACHE_HEADER_SIZE = sizeof(uint32_t) + 2 * sizeof(uint64_t);
+constexpr time_t CACHE_MAX_UNUSED_SECONDS = 30 * 24 * 3600;
+
+vespalib::string cache_file_name(const vespalib::string &cache_dir, Memory content, const vespalib::string &type) {
+    uint64_t content_hash = XXH64(content.data, content.size, 0);
+    uint64_t type_hash = XXH64(type.data(), type.size(), 0);
+    return make_string("%s/%016" PRIx64 "-%016" PRIx64 ".tensor", cache_dir.c_str(), content_hash, type_hash);
+}
+
+Value::UP load_cached(const TensorEngine &engine, const vespalib::string &cache_file, const ValueType &type) {
+    MappedFileInput file(cache_file);
+    if (!file.valid()) {
+        return Value::UP();
+    }
+    Memory data = file.get();
+    if (data.size < CACHE_HEADER_SIZE) {
+        LOG(warning, "ignoring truncated tensor cache file: %s", cache_file.c_str());
+        return Value::UP();
+    }
+    nbostream header(data.data, CACHE_HEADER_SIZE);
+    uint32_t magic;
+    uint64_t size;
+    uint64_t hash;
+    header >> magic >> size >> hash;
+    const char *payload = data.data + CACHE_HEADER_SIZE;
+    if ((magic != CACHE_MAGIC) || (size != (data.size - CACHE_HEADER_SIZE)) ||
+        (hash != XXH64(payload, size, 0)))
+    {
+        LOG(warning, "ignoring corrupt tensor cache file: %s", cache_file.c_str());
+        return Value::UP();
+    }
+    nbostream input(payload, size);
+    Value::UP value = engine.decode(input);
+    if (value->type() != type) {
+        LOG(warning, "ignoring tensor cache file with wrong type (%s): %s",
+            value->type().to_spec().c_str(), cache_file.c_str());
+        return Value::UP();
+    }
+    ::utime(cache_file.c_str(), nullptr); // mark as recently used
+    return value;
+}
+
+void store_cached(const TensorEngine &engine, const vespalib::string &cache_file, const Value &value) {
+    nbostream payload;
+    engine.encode(value, payload);
+    nbostream header;
+    header << CACHE_MAGIC << uint64_t(payload.size()) << uint64_t(XXH64(payload.peek(), payload.size(), 0));
+    vespalib::string tmp_file = make_string("%s.%d.tmp", cache_file.c_str(), getpid());
+    try {
+        File file(tmp_file);
+        file.open(File::CREATE | File::TRUNC);
+        file.write(header.peek(), header.size(), 0);
+        file.write(payload.peek(), payload.size(), header.size());
+        file.close();
+        vespalib::rename(tmp_file, cache_file);
+    } catch (const IoException &e) {
+        LOG(warning, "could not write tensor cache file %s: %s", cache_file.c_str(), e.getMessage().c_str());
+        vespalib::unlink(tmp_file);
+    }
+}
+
+void prune_cache(const vespalib::string &cache_dir) {
+    time_t now = time(nullptr);
+    for (const auto &name: listDirectory(cache_dir)) {
+        if (!ends_with(name, ".tensor") && !ends_with(name, ".tmp")) {
+            continue;
+        }
+        vespalib::string path = cache_dir + "/" + name;
+        struct stat info;
+        if ((::stat(path.c_str(), &info) == 0) && ((now - info.st_mtime) > CACHE_MAX_UNUSED_SECONDS)) {
+            LOG(debug, "removing unused tensor cache file: %s", path.c_str());
+            vespalib::unlink(path);
         }
     }
 }
 
 } // namespace vespalib::eval::<unnamed>
 
+ConstantTensorLoader::ConstantTensorLoader(const TensorEngine &engine, const vespalib::string &cache_dir)
+    : _engine(engine),
+      _cache_dir(cache_dir)
+{
+    try {
+        vespalib::mkdir(_cache_dir, true);
+        prune_cache(_cache_dir);
+    } catch (const IoException &e) {
+        LOG(warning, "could not prepare tensor cache directory %s: %s", _cache_dir.c_str(), e.getMessage().c_str());
+    }
+}
+
 ConstantValue::UP
 ConstantTensorLoader::create(const vespalib::string &path, const vespalib::string &type) const
 {
@@ -77,7 +177,20 @@ ConstantTensorLoader::create(const vespalib::string &path, const vespalib::strin
         return std::make_unique<SimpleConstantValue>(_engine.from_spec(TensorSpec("double")));
     }
     Slime slime;
-    decode_json(path, slime);
+    vespalib::string cache_file;
+    bool cacheable = false;
+    MappedFileInput file(path);
+    if (!file.valid()) {
+        LOG(warning, "could not read file: %s", path.c_str());
+    } else {
+        if (!_cache_dir.empty()) {
+            cache_file = cache_file_name(_cache_dir, file.get(), type);
+            if (Value::UP cached = load_cached(_engine, cache_file, value_type)) {
+                return std::make_unique<SimpleConstantValue>(std::move(cached));
+            }
+        }
+        cacheable = decode_file(path, file, slime);
+    }
     std::set<vespalib::string> indexed;
     for (const auto &dimension: value_type.dimensions()) {
         if (dimension.is_indexed()) {
@@ -92,7 +205,11 @@ ConstantTensorLoader::create(const vespalib::string &path, const vespalib::strin
         cells[i]["address"].traverse(extractor);
         spec.add(address, cells[i]["value"].asDouble());
     }
-    return std::make_unique<SimpleConstantValue>(_engine.from_spec(spec));
+    Value::UP value = _engine.from_spec(spec);
+    if (cacheable && !cache_file.empty()) {
+        store_cached(_engine, cache_file, *value);
+    }
+    return std::make_unique<SimpleConstantValue>(std::move(value));
 }
 
 } // namespace vespalib::eval
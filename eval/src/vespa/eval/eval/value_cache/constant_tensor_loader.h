@@ -15,13 +15,22 @@ namespace eval {
  * structure used when feeding. The tensor is created by first
  * building a generic TensorSpec object and then converting it to a
  * specific tensor using the TensorEngine interface.
+ *
+ * If a cache directory is given, loaded tensors are also stored there
+ * in the binary format of the tensor engine, keyed by a hash of the
+ * file content and the tensor type. Loading a file with the same
+ * content later (after a restart or a reconfig) will then read the
+ * binary copy instead of parsing json. Cached tensors that have not
+ * been used for a while are removed when the loader is created.
  **/
 class ConstantTensorLoader : public ConstantValueFactory
 {
 private:
     const TensorEngine &_engine;
+    const vespalib::string _cache_dir;
 public:
-    ConstantTensorLoader(const TensorEngine &engine) : _engine(engine) {}
+    ConstantTensorLoader(const TensorEngine &engine) : _engine(engine), _cache_dir() {}
+    ConstantTensorLoader(const TensorEngine &engine, const vespalib::string &cache_dir);
     ConstantValue::UP create(const vespalib::string &path, const vespalib::string &type) const override;
 };
 
@@ -8,6 +8,7 @@
 #include "dense/dense_tensor.h"
 #include "dense/dense_tensor_builder.h"
 #include "dense/dense_tensor_function_compiler.h"
+#include "mixed/mixed_tensor.h"
 #include <vespa/eval/eval/value.h>
 #include <vespa/eval/eval/tensor_spec.h>
 #include <vespa/eval/eval/simple_tensor_engine.h>
@@ -54,11 +55,6 @@ const Value &to_simple(const Value &value, Stash &stash) {
 
 const Value &to_default(const Value &value, Stash &stash) {
     if (auto tensor = value.as_tensor()) {
-        if (auto simple = dynamic_cast<const eval::SimpleTensor *>(tensor)) {
-            if (!Tensor::supported({simple->type()})) {
-                return stash.create<WrappedSimpleTensor>(*simple);
-            }
-        }
         nbostream data;
         tensor->engine().encode(*tensor, data);
         return *stash.create<Value::UP>(default_engine().decode(data));
@@ -86,6 +82,16 @@ Value::UP to_value(std::unique_ptr<Tensor> tensor) {
     return std::make_unique<DoubleValue>(tensor->as_double());
 }
 
+bool is_mixed(const tensor::Tensor &tensor) {
+    return (dynamic_cast<const MixedTensor *>(&tensor) != nullptr);
+}
+
+// mixed tensors support map and reduce natively, but only some joins
+
+bool supported_native(const tensor::Tensor &tensor) {
+    return (tensor::Tensor::supported({tensor.type()}) || is_mixed(tensor));
+}
+
 const Value &fallback_join(const Value &a, const Value &b, join_fun_t function, Stash &stash) {
     return to_default(simple_engine().join(to_simple(a, stash), to_simple(b, stash), function, stash), stash);
 }
@@ -127,7 +133,7 @@ DefaultTensorEngine::from_spec(const TensorSpec &spec) const
         }
     }
     if (is_dense && is_sparse) {
-        return std::make_unique<WrappedSimpleTensor>(eval::SimpleTensor::create(spec));
+        return MixedTensor::create(spec);
     } else if (is_dense) {
         DenseTensorBuilder builder;
         std::map<vespalib::string,DenseTensorBuilder::Dimension> dimension_map;
@@ -221,7 +227,7 @@ DefaultTensorEngine::map(const Value &a, map_fun_t function, Stash &stash) const
     } else if (auto tensor = a.as_tensor()) {
         assert(&tensor->engine() == this);
         const tensor::Tensor &my_a = static_cast<const tensor::Tensor &>(*tensor);
-        if (!tensor::Tensor::supported({my_a.type()})) {
+        if (!supported_native(my_a)) {
             return to_default(simple_engine().map(to_simple(a, stash), function, stash), stash);
         }
         CellFunctionFunAdapter cell_function(function);
@@ -240,7 +246,7 @@ DefaultTensorEngine::join(const Value &a, const Value &b, join_fun_t function, S
         } else if (auto tensor_b = b.as_tensor()) {
             assert(&tensor_b->engine() == this);
             const tensor::Tensor &my_b = static_cast<const tensor::Tensor &>(*tensor_b);
-            if (!tensor::Tensor::supported({my_b.type()})) {
+            if (!supported_native(my_b)) {
                 return fallback_join(a, b, function, stash);
             }
             CellFunctionBindLeftAdapter cell_function(function, a.as_double());
@@ -252,7 +258,7 @@ DefaultTensorEngine::join(const Value &a, const Value &b, join_fun_t function, S
         assert(&tensor_a->engine() == this);
         const tensor::Tensor &my_a = static_cast<const tensor::Tensor &>(*tensor_a);
         if (b.is_double()) {
-            if (!tensor::Tensor::supported({my_a.type()})) {
+            if (!supported_native(my_a)) {
                 return fallback_join(a, b, function, stash);
             }
             CellFunctionBindRightAdapter cell_function(function, b.as_double());
@@ -260,6 +266,12 @@ DefaultTensorEngine::join(const Value &a, const Value &b, join_fun_t function, S
         } else if (auto tensor_b = b.as_tensor()) {
             assert(&tensor_b->engine() == this);
             const tensor::Tensor &my_b = static_cast<const tensor::Tensor &>(*tensor_b);
+            if (is_mixed(my_a) || is_mixed(my_b)) {
+                if (auto result = MixedTensor::joinTensors(function, my_a, my_b)) {
+                    return to_value(std::move(result), stash);
+                }
+                return fallback_join(a, b, function, stash);
+            }
             if (!tensor::Tensor::supported({my_a.type(), my_b.type()})) {
                 return fallback_join(a, b, function, stash);
             }
@@ -286,7 +298,7 @@ DefaultTensorEngine::reduce(const Value &a, Aggr aggr, const std::vector<vespali
     } else if (auto tensor = a.as_tensor()) {
         assert(&tensor->engine() == this);
         const tensor::Tensor &my_a = static_cast<const tensor::Tensor &>(*tensor);
-        if (!tensor::Tensor::supported({my_a.type()})) {
+        if (!supported_native(my_a)) {
             return fallback_reduce(a, aggr, dimensions, stash);
         }
         switch (aggr) {
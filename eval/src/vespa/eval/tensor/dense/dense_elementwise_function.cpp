@@ -0,0 +1,107 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "dense_elementwise_function.h"
+#include <vespa/eval/eval/aggr.h>
+#include <vespa/eval/eval/value.h>
+#include <vespa/vespalib/util/stash.h>
+#include <cassert>
+
+namespace vespalib::tensor {
+
+using CellsRef = DenseTensorView::CellsRef;
+
+namespace {
+
+size_t
+calcNumCells(const eval::ValueType &type)
+{
+    size_t numCells = 1;
+    for (const auto &dim : type.dimensions()) {
+        numCells *= dim.size;
+    }
+    return numCells;
+}
+
+CellsRef
+getCellsRef(const eval::Value &value)
+{
+    const DenseTensorView &denseTensor = static_cast<const DenseTensorView &>(value);
+    return denseTensor.cellsRef();
+}
+
+}
+
+DenseElementwiseFunction::DenseElementwiseFunction(const eval::ValueType &resultType,
+                                                   const std::vector<Input> &inputs,
+                                                   size_t numArgs,
+                                                   eval::tensor_function::cell_fun_t function)
+    : _resultType(resultType),
+      _inputs(inputs),
+      _numArgs(numArgs),
+      _numCells(calcNumCells(resultType)),
+      _function(function),
+      _aggregate(false),
+      _aggr(eval::Aggr::SUM)
+{
+}
+
+DenseElementwiseFunction::DenseElementwiseFunction(const eval::ValueType &resultType,
+                                                   const std::vector<Input> &inputs,
+                                                   size_t numArgs,
+                                                   eval::tensor_function::cell_fun_t function,
+                                                   eval::Aggr aggr)
+    : _resultType(resultType),
+      _inputs(inputs),
+      _numArgs(numArgs),
+      _numCells(calcNumCells(resultType)),
+      _function(function),
+      _aggregate(true),
+      _aggr(aggr)
+{
+}
+
+const eval::Value &
+DenseElementwiseFunction::eval(ConstArrayRef<eval::Value::CREF> params, Stash &stash) const
+{
+    ArrayRef<double> args = stash.create_array<double>(_numArgs, 0.0);
+    std::vector<std::pair<const double *, size_t>> tensorArgs;
+    tensorArgs.reserve(_inputs.size());
+    for (const Input &input : _inputs) {
+        const eval::Value &value = params[input.paramId];
+        if (input.isTensor) {
+            CellsRef cells = getCellsRef(value);
+            assert(cells.size() == _numCells);
+            tensorArgs.emplace_back(cells.cbegin(), input.argIdx);
+        } else {
+            args[input.argIdx] = value.as_double();
+        }
+    }
+    auto calcCell = [&](size_t cellIdx) {
+        for (const auto &tensorArg : tensorArgs) {
+            args[tensorArg.second] = tensorArg.first[cellIdx];
+        }
+        return _function(&args[0]);
+    };
+    if (!_aggregate) {
+        ArrayRef<double> outputCells = stash.create_array<double>(_numCells);
+        for (size_t i = 0; i < _numCells; ++i) {
+            outputCells[i] = calcCell(i);
+        }
+        return stash.create<DenseTensorView>(_resultType, outputCells);
+    }
+    if (_aggr == eval::Aggr::SUM) {
+        double sum = 0.0;
+        for (size_t i = 0; i < _numCells; ++i) {
+            sum += calcCell(i);
+        }
+        return stash.create<eval::DoubleValue>(sum);
+    }
+    eval::Aggregator &aggregator = eval::Aggregator::create(_aggr, stash);
+    aggregator.first(calcCell(0));
+    for (size_t i = 1; i < _numCells; ++i) {
+        aggregator.next(calcCell(i));
+    }
+    return stash.create<eval::DoubleValue>(aggregator.result());
+}
+
+}
@@ -0,0 +1,57 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/eval/tensor_function.h>
+#include "dense_tensor_view.h"
+
+namespace vespalib::tensor {
+
+/**
+ * Tensor function calculating each cell of a dense tensor from the
+ * corresponding cells of dense input tensors (of the same type) and
+ * double inputs, using a single (compiled) cell function. The result
+ * may optionally be aggregated into a single double, avoiding the
+ * intermediate tensor.
+ */
+class DenseElementwiseFunction : public eval::TensorFunction
+{
+public:
+    struct Input {
+        size_t paramId;
+        size_t argIdx;
+        bool isTensor;
+        Input(size_t paramId_in, size_t argIdx_in, bool isTensor_in)
+            : paramId(paramId_in), argIdx(argIdx_in), isTensor(isTensor_in) {}
+    };
+
+private:
+    const eval::ValueType _resultType; // type of the cell tensor
+    const std::vector<Input> _inputs;
+    const size_t _numArgs;
+    const size_t _numCells;
+    const eval::tensor_function::cell_fun_t _function;
+    const bool _aggregate;
+    const eval::Aggr _aggr;
+
+public:
+    DenseElementwiseFunction(const eval::ValueType &resultType,
+                             const std::vector<Input> &inputs,
+                             size_t numArgs,
+                             eval::tensor_function::cell_fun_t function);
+    DenseElementwiseFunction(const eval::ValueType &resultType,
+                             const std::vector<Input> &inputs,
+                             size_t numArgs,
+                             eval::tensor_function::cell_fun_t function,
+                             eval::Aggr aggr);
+    ~DenseElementwiseFunction() {}
+
+    const std::vector<Input> &inputs() const { return _inputs; }
+    size_t numCells() const { return _numCells; }
+    bool aggregate() const { return _aggregate; }
+    eval::Aggr aggr() const { return _aggr; }
+
+    const eval::Value &eval(ConstArrayRef<eval::Value::CREF> params, Stash &stash) const override;
+};
+
+}
@@ -0,0 +1,112 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "dense_matmul_function.h"
+#include "dense_tensor_view.h"
+#include <vespa/eval/eval/value.h>
+#include <vespa/vespalib/util/stash.h>
+#include <assert.h>
+
+namespace vespalib::tensor {
+
+DenseMatMulFunction::DenseMatMulFunction(const eval::ValueType &resultType,
+                                         size_t lhsId,
+                                         size_t rhsId,
+                                         size_t lhsSize,
+                                         size_t commonSize,
+                                         size_t rhsSize,
+                                         bool lhsCommonInner,
+                                         bool rhsCommonInner)
+    : _resultType(resultType),
+      _lhsId(lhsId),
+      _rhsId(rhsId),
+      _lhsSize(lhsSize),
+      _commonSize(commonSize),
+      _rhsSize(rhsSize),
+      _lhsCommonInner(lhsCommonInner),
+      _rhsCommonInner(rhsCommonInner),
+      _hwAccelerator(hwaccelrated::IAccelrated::getAccelrator())
+{}
+
+// both tensors have the common dimension innermost; each result
+// cell is a dot product of two contiguous rows
+void
+DenseMatMulFunction::multiDotProduct(CellsRef lhs, CellsRef rhs, ArrayRef<double> result) const
+{
+    double *out = result.begin();
+    for (size_t i = 0; i < _lhsSize; ++i) {
+        const double *lhsRow = lhs.cbegin() + i * _commonSize;
+        for (size_t j = 0; j < _rhsSize; ++j) {
+            *out++ = _hwAccelerator->dotProduct(lhsRow, rhs.cbegin() + j * _commonSize, _commonSize);
+        }
+    }
+    assert(out == result.end());
+}
+
+// the rhs tensor has the common dimension outermost; each rhs row is
+// scaled and added to a contiguous result row
+void
+DenseMatMulFunction::accumulateRows(CellsRef lhs, CellsRef rhs, ArrayRef<double> result) const
+{
+    size_t lhsOuterStride = _lhsCommonInner ? _commonSize : 1;
+    size_t lhsCommonStride = _lhsCommonInner ? 1 : _lhsSize;
+    for (size_t i = 0; i < _lhsSize; ++i) {
+        double *out = result.begin() + i * _rhsSize;
+        for (size_t k = 0; k < _commonSize; ++k) {
+            double factor = lhs[i * lhsOuterStride + k * lhsCommonStride];
+            const double *rhsRow = rhs.cbegin() + k * _rhsSize;
+            for (size_t j = 0; j < _rhsSize; ++j) {
+                out[j] += factor * rhsRow[j];
+            }
+        }
+    }
+}
+
+// only the rhs tensor has the common dimension innermost
+void
+DenseMatMulFunction::stridedProduct(CellsRef lhs, CellsRef rhs, ArrayRef<double> result) const
+{
+    double *out = result.begin();
+    for (size_t i = 0; i < _lhsSize; ++i) {
+        for (size_t j = 0; j < _rhsSize; ++j) {
+            const double *rhsRow = rhs.cbegin() + j * _commonSize;
+            double cell = 0.0;
+            for (size_t k = 0; k < _commonSize; ++k) {
+                cell += lhs[k * _lhsSize + i] * rhsRow[k];
+            }
+            *out++ = cell;
+        }
+    }
+    assert(out == result.end());
+}
+
+namespace {
+
+DenseTensorView::CellsRef
+getCellsRef(const eval::Value &value)
+{
+    const DenseTensorView &denseTensor = static_cast<const DenseTensorView &>(value);
+    return denseTensor.cellsRef();
+}
+
+} // namespace <unnamed>
+
+const eval::Value &
+DenseMatMulFunction::eval(ConstArrayRef<eval::Value::CREF> params, Stash &stash) const
+{
+    DenseTensorView::CellsRef lhsCells = getCellsRef(params[_lhsId]);
+    DenseTensorView::CellsRef rhsCells = getCellsRef(params[_rhsId]);
+    assert(lhsCells.size() == _lhsSize * _commonSize);
+    assert(rhsCells.size() == _commonSize * _rhsSize);
+
+    ArrayRef<double> outputCells = stash.create_array<double>(_lhsSize * _rhsSize, 0.0);
+    if (_lhsCommonInner && _rhsCommonInner) {
+        multiDotProduct(lhsCells, rhsCells, outputCells);
+    } else if (!_rhsCommonInner) {
+        accumulateRows(lhsCells, rhsCells, outputCells);
+    } else {
+        stridedProduct(lhsCells, rhsCells, outputCells);
+    }
+    return stash.create<DenseTensorView>(_resultType, outputCells);
+}
+
+}
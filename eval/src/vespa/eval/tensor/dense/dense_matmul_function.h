@@ -0,0 +1,60 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/eval/tensor_function.h>
+#include "dense_tensor_view.h"
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
+
+namespace vespalib::tensor {
+
+/**
+ * Tensor function for the product of two 2-dimensional dense
+ * tensors sharing one dimension, summed over the shared dimension
+ * (matrix multiplication). The outer dimension of the lhs tensor is
+ * the outermost dimension of the result.
+ */
+class DenseMatMulFunction : public eval::TensorFunction
+{
+private:
+    using CellsRef = DenseTensorView::CellsRef;
+
+    const eval::ValueType _resultType;
+    const size_t _lhsId;
+    const size_t _rhsId;
+    const size_t _lhsSize;
+    const size_t _commonSize;
+    const size_t _rhsSize;
+    const bool _lhsCommonInner;
+    const bool _rhsCommonInner;
+    hwaccelrated::IAccelrated::UP _hwAccelerator;
+
+    void multiDotProduct(CellsRef lhs, CellsRef rhs, ArrayRef<double> result) const;
+    void accumulateRows(CellsRef lhs, CellsRef rhs, ArrayRef<double> result) const;
+    void stridedProduct(CellsRef lhs, CellsRef rhs, ArrayRef<double> result) const;
+public:
+    DenseMatMulFunction(const eval::ValueType &resultType,
+                        size_t lhsId,
+                        size_t rhsId,
+                        size_t lhsSize,
+                        size_t commonSize,
+                        size_t rhsSize,
+                        bool lhsCommonInner,
+                        bool rhsCommonInner);
+
+    ~DenseMatMulFunction() {}
+
+    size_t lhsId() const { return _lhsId; }
+    size_t rhsId() const { return _rhsId; }
+
+    size_t lhsSize() const { return _lhsSize; }
+    size_t commonSize() const { return _commonSize; }
+    size_t rhsSize() const { return _rhsSize; }
+
+    bool lhsCommonInner() const { return _lhsCommonInner; }
+    bool rhsCommonInner() const { return _rhsCommonInner; }
+
+    const eval::Value &eval(ConstArrayRef<eval::Value::CREF> params, Stash &stash) const override;
+};
+
+}
@@ -8,10 +8,62 @@
 
 namespace vespalib::tensor::dense {
 
+/**
+ * Check if the dimensions of 'inner' are the innermost dimensions
+ * of 'outer', with the same sizes. In that case the cells of 'inner'
+ * line up with each contiguous block of the cells of 'outer'.
+ */
+inline bool
+isInnerBroadcast(const eval::ValueType &outer, const eval::ValueType &inner)
+{
+    const auto &outerDims = outer.dimensions();
+    const auto &innerDims = inner.dimensions();
+    if (outer.is_abstract() || inner.is_abstract() || (innerDims.size() > outerDims.size())) {
+        return false;
+    }
+    size_t offset = outerDims.size() - innerDims.size();
+    for (size_t i = 0; i < innerDims.size(); ++i) {
+        if (outerDims[offset + i] != innerDims[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Join all blocks of outer cells with the inner cells, using plain
+ * contiguous loops that the compiler is able to vectorize.
+ */
+template <bool innerIsRhs, typename Function>
+std::unique_ptr<Tensor>
+applyInnerBroadcast(const DenseTensorView &outer, const DenseTensorView &inner, Function &&func)
+{
+    const double *outerCells = outer.cellsRef().cbegin();
+    const double *innerCells = inner.cellsRef().cbegin();
+    size_t innerSize = inner.cellsRef().size();
+    DenseTensorView::Cells cells(outer.cellsRef().size());
+    double *dst = &cells[0];
+    for (size_t offset = 0; offset < cells.size(); offset += innerSize) {
+        const double *src = outerCells + offset;
+        for (size_t i = 0; i < innerSize; ++i) {
+            dst[offset + i] = innerIsRhs ? func(src[i], innerCells[i]) : func(innerCells[i], src[i]);
+        }
+    }
+    return std::make_unique<DenseTensor>(outer.fast_type(), std::move(cells));
+}
+
 template <typename Function>
 std::unique_ptr<Tensor>
 apply(const DenseTensorView &lhs, const DenseTensorView &rhs, Function &&func)
 {
+    if ((lhs.cellsRef().size() > 0) && (rhs.cellsRef().size() > 0)) {
+        if (isInnerBroadcast(lhs.fast_type(), rhs.fast_type())) {
+            return applyInnerBroadcast<true>(lhs, rhs, func);
+        }
+        if (isInnerBroadcast(rhs.fast_type(), lhs.fast_type())) {
+            return applyInnerBroadcast<false>(rhs, lhs, func);
+        }
+    }
     DenseTensorAddressCombiner combiner(lhs.fast_type(), rhs.fast_type());
     DirectDenseTensorBuilder builder(DenseTensorAddressCombiner::combineDimensions(lhs.fast_type(), rhs.fast_type()));
     for (DenseTensorCellsIterator lhsItr = lhs.cellsIterator(); lhsItr.valid(); lhsItr.next()) {
@@ -1,6 +1,8 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "dense_dot_product_function.h"
+#include "dense_elementwise_function.h"
+#include "dense_matmul_function.h"
 #include "dense_xw_product_function.h"
 #include "dense_tensor_function_compiler.h"
 #include <vespa/eval/eval/operation.h>
@@ -54,6 +56,41 @@ const TensorFunction &createDenseXWProduct(const ValueType &res, const Inject &v
                                                 common_is_inner);
 }
 
+// lhs and rhs are matrices sharing the reduced dimension; the outer
+// dimension of lhs must be the outermost dimension of the result
+bool isDenseMatMul(const ValueType &res, const ValueType &lhs, const ValueType &rhs,
+                   const std::vector<vespalib::string> &dimensions)
+{
+    if (isConcreteDenseTensor(res, 2) &&
+        isConcreteDenseTensor(lhs, 2) &&
+        isConcreteDenseTensor(rhs, 2) &&
+        (dimensions.size() == 1))
+    {
+        size_t npos = ValueType::Dimension::npos;
+        size_t lhs_common = lhs.dimension_index(dimensions[0]);
+        size_t rhs_common = rhs.dimension_index(dimensions[0]);
+        if ((lhs_common != npos) && (rhs_common != npos) &&
+            (lhs.dimensions()[lhs_common].size == rhs.dimensions()[rhs_common].size))
+        {
+            return ((lhs.dimensions()[1 - lhs_common] == res.dimensions()[0]) &&
+                    (rhs.dimensions()[1 - rhs_common] == res.dimensions()[1]));
+        }
+    }
+    return false;
+}
+
+const TensorFunction &createDenseMatMul(const ValueType &res, const Inject &lhs, const Inject &rhs,
+                                        const vespalib::string &dimension, Stash &stash)
+{
+    bool lhs_common_inner = (lhs.result_type.dimension_index(dimension) == 1);
+    bool rhs_common_inner = (rhs.result_type.dimension_index(dimension) == 1);
+    size_t common_size = lhs.result_type.dimensions()[lhs_common_inner ? 1 : 0].size;
+    return stash.create<DenseMatMulFunction>(res, lhs.tensor_id, rhs.tensor_id,
+                                             res.dimensions()[0].size, common_size,
+                                             res.dimensions()[1].size,
+                                             lhs_common_inner, rhs_common_inner);
+}
+
 struct InnerProductFunctionCompiler
 {
     static const TensorFunction &compile(const Node &expr, Stash &stash) {
@@ -73,6 +110,56 @@ struct InnerProductFunctionCompiler
                     if (isDenseXWProduct(expr.result_type, rhs->result_type, lhs->result_type)) {
                         return createDenseXWProduct(expr.result_type, *rhs, *lhs, stash);
                     }
+                    if (isDenseMatMul(expr.result_type, lhs->result_type, rhs->result_type, reduce->dimensions)) {
+                        return createDenseMatMul(expr.result_type, *lhs, *rhs, reduce->dimensions[0], stash);
+                    }
+                    if (isDenseMatMul(expr.result_type, rhs->result_type, lhs->result_type, reduce->dimensions)) {
+                        return createDenseMatMul(expr.result_type, *rhs, *lhs, reduce->dimensions[0], stash);
+                    }
+                }
+            }
+        }
+        return expr;
+    }
+};
+
+struct ElementwiseFunctionCompiler
+{
+    static bool getInputs(const Elementwise &elementwise, std::vector<DenseElementwiseFunction::Input> &inputs) {
+        if (!isConcreteDenseTensor(elementwise.result_type, elementwise.result_type.dimensions().size())) {
+            return false;
+        }
+        for (size_t i = 0; i < elementwise.inputs.size(); ++i) {
+            const Inject *inject = as<Inject>(*elementwise.inputs[i]);
+            if (!inject) {
+                return false;
+            }
+            if (inject->result_type.is_double()) {
+                inputs.emplace_back(inject->tensor_id, elementwise.arg_idx[i], false);
+            } else if (inject->result_type == elementwise.result_type) {
+                inputs.emplace_back(inject->tensor_id, elementwise.arg_idx[i], true);
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static const TensorFunction &compile(const Node &expr, Stash &stash) {
+        std::vector<DenseElementwiseFunction::Input> inputs;
+        if (const Elementwise *elementwise = as<Elementwise>(expr)) {
+            if (getInputs(*elementwise, inputs)) {
+                return stash.create<DenseElementwiseFunction>(elementwise->result_type, inputs,
+                                                              elementwise->num_args, elementwise->function);
+            }
+        }
+        const Reduce *reduce = as<Reduce>(expr);
+        if (reduce && reduce->result_type.is_double()) {
+            if (const Elementwise *elementwise = as<Elementwise>(reduce->tensor)) {
+                if (getInputs(*elementwise, inputs)) {
+                    return stash.create<DenseElementwiseFunction>(elementwise->result_type, inputs,
+                                                                  elementwise->num_args, elementwise->function,
+                                                                  reduce->aggr);
                 }
             }
         }
@@ -85,7 +172,11 @@ struct InnerProductFunctionCompiler
 const TensorFunction &
 DenseTensorFunctionCompiler::compile(const eval::tensor_function::Node &expr, Stash &stash)
 {
-    return InnerProductFunctionCompiler::compile(expr, stash);
+    const TensorFunction &result = InnerProductFunctionCompiler::compile(expr, stash);
+    if (&result != &expr) {
+        return result;
+    }
+    return ElementwiseFunctionCompiler::compile(expr, stash);
 }
 
 }
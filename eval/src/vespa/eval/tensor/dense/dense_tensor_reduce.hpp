@@ -68,6 +68,22 @@ public:
     reduceCells(CellsRef cellsIn, Function &&func) {
         auto itr_in = cellsIn.cbegin();
         auto itr_out = _cellsResult.begin();
+        if ((_innerDimSize == 1) && (_sumDimSize > 1)) {
+            // reducing the innermost dimension; accumulate each contiguous run locally
+            for (size_t outerDim = 0; outerDim < _outerDimSize; ++outerDim) {
+                double acc = *itr_in;
+                ++itr_in;
+                for (size_t sumDim = 1; sumDim < _sumDimSize; ++sumDim) {
+                    acc = func(acc, *itr_in);
+                    ++itr_in;
+                }
+                *itr_out = acc;
+                ++itr_out;
+            }
+            assert(itr_out == _cellsResult.end());
+            assert(itr_in == cellsIn.cend());
+            return std::make_unique<DenseTensor>(std::move(_type), std::move(_cellsResult));
+        }
         for (size_t outerDim = 0; outerDim < _outerDimSize; ++outerDim) {
             auto saved_itr = itr_out;
             for (size_t innerDim = 0; innerDim < _innerDimSize; ++innerDim) {
@@ -98,13 +114,33 @@ reduce(const DenseTensorView &tensor, const vespalib::string &dimensionToRemove,
     return reducer.reduceCells(tensor.cellsRef(), func);
 }
 
+template <typename Function>
+DenseTensor::UP
+reduceAll(const DenseTensorView &tensor, Function &&func)
+{
+    CellsRef cells = tensor.cellsRef();
+    double acc = cells[0];
+    for (size_t i = 1; i < cells.size(); ++i) {
+        acc = func(acc, cells[i]);
+    }
+    return std::make_unique<DenseTensor>(eval::ValueType::double_type(), Cells({acc}));
+}
+
+bool
+reducesAllDimensions(const DenseTensorView &tensor, const std::vector<vespalib::string> &dimensions)
+{
+    return ((tensor.cellsRef().size() > 0) && tensor.fast_type().reduce(dimensions).is_double());
+}
+
 }
 
 template <typename Function>
 std::unique_ptr<Tensor>
 reduce(const DenseTensorView &tensor, const std::vector<vespalib::string> &dimensions, Function &&func)
 {
-    if (dimensions.size() == 1) {
+    if ((dimensions.size() > 1) && reducesAllDimensions(tensor, dimensions)) {
+        return reduceAll(tensor, func);
+    } else if (dimensions.size() == 1) {
         return reduce(tensor, dimensions[0], func);
     } else if (dimensions.size() > 0) {
         DenseTensor::UP result = reduce(tensor, dimensions[0], func);
@@ -0,0 +1,125 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "mixed_tensor.h"
+#include <vespa/eval/tensor/direct_tensor_builder.h>
+#include <vespa/eval/tensor/dense/dense_tensor.h>
+#include <vespa/eval/tensor/sparse/direct_sparse_tensor_builder.h>
+#include <cassert>
+
+namespace vespalib::tensor {
+
+/**
+ * Utility class to build tensors of type MixedTensor, to be used by
+ * tensor operations. Dense subspaces are inserted by their sparse
+ * address. The built tensor is a DenseTensor if the type has no
+ * mapped dimensions and a SparseTensor if it has no indexed
+ * dimensions, so results of operations that remove all dimensions of
+ * one kind get the representation best suited for them.
+ */
+template <> class DirectTensorBuilder<MixedTensor>
+{
+public:
+    using TensorImplType = MixedTensor;
+    using Index = MixedTensor::Index;
+    using Cells = MixedTensor::Cells;
+
+private:
+    Stash _stash;
+    eval::ValueType _type;
+    size_t _subspaceSize;
+    Index _index;
+    Cells _cells;
+
+    template <class Function>
+    void insertSubspace(SparseTensorAddressRef address, ConstArrayRef<double> cells, Function &&func, bool combine) {
+        assert(cells.size() == _subspaceSize);
+        auto res = _index.insert(std::make_pair(address, uint32_t(_index.size())));
+        double *dst;
+        if (res.second) {
+            res.first->first = SparseTensorAddressRef(address, _stash);
+            _cells.resize(_cells.size() + _subspaceSize);
+            dst = &_cells[res.first->second * _subspaceSize];
+            std::copy(cells.cbegin(), cells.cend(), dst);
+        } else {
+            assert(combine);
+            dst = &_cells[res.first->second * _subspaceSize];
+            for (size_t i = 0; i < _subspaceSize; ++i) {
+                dst[i] = func(dst[i], cells[i]);
+            }
+        }
+    }
+
+public:
+    DirectTensorBuilder(const eval::ValueType &type_in)
+        : _stash(TensorImplType::STASH_CHUNK_SIZE),
+          _type(type_in),
+          _subspaceSize(1),
+          _index(),
+          _cells()
+    {
+        for (const auto &dim : _type.dimensions()) {
+            if (dim.is_indexed()) {
+                _subspaceSize *= dim.size;
+            }
+        }
+    }
+
+    ~DirectTensorBuilder() {}
+
+    const eval::ValueType &fast_type() const { return _type; }
+    size_t subspaceSize() const { return _subspaceSize; }
+
+    /**
+     * Returns the cells of the dense subspace with the given sparse
+     * address, adding it with all cells set to 0 if it does not
+     * exist. The returned reference is invalidated when the next
+     * subspace is added.
+     */
+    ArrayRef<double> subspace(SparseTensorAddressRef address) {
+        auto res = _index.insert(std::make_pair(address, uint32_t(_index.size())));
+        if (res.second) {
+            res.first->first = SparseTensorAddressRef(address, _stash);
+            _cells.resize(_cells.size() + _subspaceSize, 0.0);
+        }
+        return ArrayRef<double>(_cells.data() + res.first->second * _subspaceSize, _subspaceSize);
+    }
+
+    template <class Function>
+    void insertSubspace(SparseTensorAddressRef address, ConstArrayRef<double> cells, Function &&func) {
+        insertSubspace(address, cells, func, true);
+    }
+
+    void insertSubspace(SparseTensorAddressRef address, ConstArrayRef<double> cells) {
+        // This address should not already exist and a new subspace should be inserted.
+        insertSubspace(address, cells, [](double, double) -> double { abort(); }, false);
+    }
+
+    void reserve(uint32_t estimatedSubspaces) {
+        _index.resize(estimatedSubspaces*2);
+        _cells.reserve(estimatedSubspaces * _subspaceSize);
+    }
+
+    Tensor::UP build() {
+        if (_type.is_double() || _type.is_dense()) {
+            if (_index.empty()) {
+                _cells.resize(_subspaceSize, 0.0);
+            }
+            assert(_cells.size() == _subspaceSize);
+            return std::make_unique<DenseTensor>(std::move(_type), std::move(_cells));
+        }
+        if (_type.is_sparse()) {
+            DirectTensorBuilder<SparseTensor> builder(_type);
+            builder.reserve(_index.size());
+            for (const auto &entry : _index) {
+                builder.insertCell(entry.first, _cells[entry.second]);
+            }
+            return builder.build();
+        }
+        return std::make_unique<MixedTensor>(std::move(_type), std::move(_index),
+                                             std::move(_cells), std::move(_stash));
+    }
+};
+
+}
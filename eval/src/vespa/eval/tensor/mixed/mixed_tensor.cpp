@@ -0,0 +1,365 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "mixed_tensor.h"
+#include "direct_mixed_tensor_builder.h"
+#include <vespa/eval/tensor/tensor_address_builder.h>
+#include <vespa/eval/tensor/tensor_visitor.h>
+#include <vespa/eval/tensor/dense/dense_tensor_view.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor_address_builder.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor_address_decoder.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor_address_reducer.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <cassert>
+
+using vespalib::eval::TensorSpec;
+using vespalib::eval::ValueType;
+
+namespace vespalib::tensor {
+
+namespace {
+
+using Index = MixedTensor::Index;
+using Cells = MixedTensor::Cells;
+
+ValueType
+selectDimensions(const ValueType &type, bool indexed)
+{
+    std::vector<ValueType::Dimension> dimensions;
+    for (const auto &dim : type.dimensions()) {
+        if (dim.is_indexed() == indexed) {
+            dimensions.push_back(dim);
+        }
+    }
+    return (dimensions.empty() ?
+            ValueType::double_type() :
+            ValueType::tensor_type(std::move(dimensions)));
+}
+
+size_t
+calcSubspaceSize(const ValueType &denseType)
+{
+    size_t size = 1;
+    for (const auto &dim : denseType.dimensions()) {
+        size *= dim.size;
+    }
+    return size;
+}
+
+void
+copyIndex(Index &index, const Index &index_in, Stash &stash)
+{
+    index.resize(index_in.size()*2);
+    for (const auto &entry : index_in) {
+        SparseTensorAddressRef newRef(entry.first, stash);
+        index[newRef] = entry.second;
+    }
+}
+
+/**
+ * Calls the given function with the labels of all dimensions for
+ * each cell in the tensor, in the order of the tensor type
+ * dimensions.
+ */
+template <typename Function>
+void
+visitCells(const MixedTensor &tensor, Function &&func)
+{
+    const auto &dimensions = tensor.fast_type().dimensions();
+    std::vector<vespalib::string> labels(dimensions.size());
+    std::vector<size_t> indexes(dimensions.size(), 0);
+    for (const auto &entry : tensor.index()) {
+        SparseTensorAddressDecoder decoder(entry.first);
+        for (size_t i = 0; i < dimensions.size(); ++i) {
+            if (dimensions[i].is_mapped()) {
+                labels[i] = decoder.decodeLabel();
+            }
+        }
+        assert(!decoder.valid());
+        std::fill(indexes.begin(), indexes.end(), 0);
+        for (double value : tensor.subspace(entry.second)) {
+            func(labels, indexes, value);
+            for (size_t i = dimensions.size(); i-- > 0; ) {
+                if (dimensions[i].is_indexed()) {
+                    if (++indexes[i] < dimensions[i].size) {
+                        break;
+                    }
+                    indexes[i] = 0;
+                }
+            }
+        }
+    }
+}
+
+const DenseTensorView &
+asDense(const Tensor &tensor)
+{
+    return static_cast<const DenseTensorView &>(tensor);
+}
+
+/**
+ * Join each dense subspace of a mixed tensor with a dense tensor.
+ */
+template <bool denseIsLhs>
+Tensor::UP
+joinWithDense(Tensor::join_fun_t function, const MixedTensor &mixed, const DenseTensorView &dense,
+              const ValueType &resultType)
+{
+    DirectTensorBuilder<MixedTensor> builder(resultType);
+    builder.reserve(mixed.index().size());
+    for (const auto &entry : mixed.index()) {
+        DenseTensorView subspace(mixed.denseType(), mixed.subspace(entry.second));
+        Tensor::UP result = (denseIsLhs ?
+                             dense.join(function, subspace) :
+                             subspace.join(function, dense));
+        if (!result) {
+            return Tensor::UP();
+        }
+        builder.insertSubspace(entry.first, asDense(*result).cellsRef());
+    }
+    return builder.build();
+}
+
+/**
+ * Join the dense subspaces of two mixed tensors with the same mapped
+ * dimensions, pairing subspaces with equal sparse addresses.
+ */
+Tensor::UP
+joinMatching(Tensor::join_fun_t function, const MixedTensor &lhs, const MixedTensor &rhs,
+             const ValueType &resultType)
+{
+    DirectTensorBuilder<MixedTensor> builder(resultType);
+    builder.reserve(std::min(lhs.index().size(), rhs.index().size()));
+    for (const auto &entry : lhs.index()) {
+        auto itr = rhs.index().find(entry.first);
+        if (itr != rhs.index().end()) {
+            DenseTensorView lhsSubspace(lhs.denseType(), lhs.subspace(entry.second));
+            DenseTensorView rhsSubspace(rhs.denseType(), rhs.subspace(itr->second));
+            Tensor::UP result = lhsSubspace.join(function, rhsSubspace);
+            if (!result) {
+                return Tensor::UP();
+            }
+            builder.insertSubspace(entry.first, asDense(*result).cellsRef());
+        }
+    }
+    return builder.build();
+}
+
+}
+
+MixedTensor::MixedTensor(ValueType &&type_in, Index &&index_in, Cells &&cells_in, Stash &&stash_in)
+    : _type(std::move(type_in)),
+      _sparseType(selectDimensions(_type, false)),
+      _denseType(selectDimensions(_type, true)),
+      _subspaceSize(calcSubspaceSize(_denseType)),
+      _index(std::move(index_in)),
+      _cells(std::move(cells_in)),
+      _stash(std::move(stash_in))
+{
+    assert(_cells.size() == _index.size() * _subspaceSize);
+}
+
+MixedTensor::~MixedTensor() = default;
+
+bool
+MixedTensor::isMixed(const ValueType &type)
+{
+    bool mapped = false;
+    bool indexed = false;
+    for (const auto &dim : type.dimensions()) {
+        mapped = (mapped || dim.is_mapped());
+        indexed = (indexed || dim.is_indexed());
+    }
+    return (mapped && indexed);
+}
+
+Tensor::UP
+MixedTensor::create(const TensorSpec &spec)
+{
+    ValueType type = ValueType::from_spec(spec.type());
+    DirectTensorBuilder<MixedTensor> builder(type);
+    SparseTensorAddressBuilder sparseAddress;
+    for (const auto &cell : spec.cells()) {
+        const auto &address = cell.first;
+        size_t offset = 0;
+        sparseAddress.clear();
+        for (const auto &dimension : type.dimensions()) {
+            auto binding = address.find(dimension.name);
+            assert(binding != address.end());
+            if (dimension.is_mapped()) {
+                sparseAddress.add(binding->second.name);
+            } else {
+                offset = (offset * dimension.size) + binding->second.index;
+            }
+        }
+        builder.subspace(sparseAddress.getAddressRef())[offset] = cell.second;
+    }
+    return builder.build();
+}
+
+Tensor::UP
+MixedTensor::joinTensors(join_fun_t function, const Tensor &lhs, const Tensor &rhs)
+{
+    ValueType resultType = ValueType::join(lhs.type(), rhs.type());
+    if (resultType.is_error()) {
+        return Tensor::UP();
+    }
+    const MixedTensor *lhsMixed = dynamic_cast<const MixedTensor *>(&lhs);
+    const MixedTensor *rhsMixed = dynamic_cast<const MixedTensor *>(&rhs);
+    if (lhsMixed && rhsMixed) {
+        if (lhsMixed->sparseType() == rhsMixed->sparseType()) {
+            return joinMatching(function, *lhsMixed, *rhsMixed, resultType);
+        }
+    } else if (lhsMixed) {
+        if (auto rhsDense = dynamic_cast<const DenseTensorView *>(&rhs)) {
+            return joinWithDense<false>(function, *lhsMixed, *rhsDense, resultType);
+        }
+    } else if (rhsMixed) {
+        if (auto lhsDense = dynamic_cast<const DenseTensorView *>(&lhs)) {
+            return joinWithDense<true>(function, *rhsMixed, *lhsDense, resultType);
+        }
+    }
+    return Tensor::UP();
+}
+
+const ValueType &
+MixedTensor::type() const
+{
+    return _type;
+}
+
+double
+MixedTensor::as_double() const
+{
+    double result = 0.0;
+    for (double cell : _cells) {
+        result += cell;
+    }
+    return result;
+}
+
+Tensor::UP
+MixedTensor::apply(const CellFunction &func) const
+{
+    Stash stash(STASH_CHUNK_SIZE);
+    Index index;
+    copyIndex(index, _index, stash);
+    Cells cells(_cells.size());
+    for (size_t i = 0; i < cells.size(); ++i) {
+        cells[i] = func.apply(_cells[i]);
+    }
+    return std::make_unique<MixedTensor>(ValueType(_type), std::move(index), std::move(cells), std::move(stash));
+}
+
+Tensor::UP
+MixedTensor::join(join_fun_t function, const Tensor &arg) const
+{
+    return joinTensors(function, *this, arg);
+}
+
+Tensor::UP
+MixedTensor::reduce(join_fun_t op, const std::vector<vespalib::string> &dimensions) const
+{
+    std::vector<vespalib::string> reduceDimensions(dimensions.empty() ? _type.dimension_names() : dimensions);
+    ValueType resultType = _type.reduce(reduceDimensions);
+    if (resultType.is_error()) {
+        return Tensor::UP();
+    }
+    std::vector<vespalib::string> denseDimensions;
+    std::vector<vespalib::string> sparseDimensions;
+    for (const auto &dim : _type.dimensions()) {
+        if (std::find(reduceDimensions.begin(), reduceDimensions.end(), dim.name) != reduceDimensions.end()) {
+            (dim.is_indexed() ? denseDimensions : sparseDimensions).push_back(dim.name);
+        }
+    }
+    DirectTensorBuilder<MixedTensor> builder(resultType);
+    sparse::TensorAddressReducer addressReducer(_sparseType, sparseDimensions);
+    for (const auto &entry : _index) {
+        addressReducer.reduce(entry.first);
+        if (denseDimensions.empty()) {
+            builder.insertSubspace(addressReducer.getAddressRef(), subspace(entry.second), op);
+        } else {
+            DenseTensorView denseSubspace(_denseType, subspace(entry.second));
+            Tensor::UP result = denseSubspace.reduce(op, denseDimensions);
+            builder.insertSubspace(addressReducer.getAddressRef(), asDense(*result).cellsRef(), op);
+        }
+    }
+    return builder.build();
+}
+
+bool
+MixedTensor::equals(const Tensor &arg) const
+{
+    const MixedTensor *rhs = dynamic_cast<const MixedTensor *>(&arg);
+    if (!rhs || (_type != rhs->_type) || (_index.size() != rhs->_index.size())) {
+        return false;
+    }
+    for (const auto &entry : _index) {
+        auto itr = rhs->_index.find(entry.first);
+        if (itr == rhs->_index.end()) {
+            return false;
+        }
+        ConstArrayRef<double> lhsCells = subspace(entry.second);
+        ConstArrayRef<double> rhsCells = rhs->subspace(itr->second);
+        if (!std::equal(lhsCells.cbegin(), lhsCells.cend(), rhsCells.cbegin())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Tensor::UP
+MixedTensor::clone() const
+{
+    Stash stash(STASH_CHUNK_SIZE);
+    Index index;
+    copyIndex(index, _index, stash);
+    return std::make_unique<MixedTensor>(ValueType(_type), std::move(index), Cells(_cells), std::move(stash));
+}
+
+TensorSpec
+MixedTensor::toSpec() const
+{
+    TensorSpec result(_type.to_spec());
+    const auto &dimensions = _type.dimensions();
+    visitCells(*this, [&](const std::vector<vespalib::string> &labels,
+                          const std::vector<size_t> &indexes, double value)
+               {
+                   TensorSpec::Address address;
+                   for (size_t i = 0; i < dimensions.size(); ++i) {
+                       if (dimensions[i].is_mapped()) {
+                           address.emplace(dimensions[i].name, TensorSpec::Label(labels[i]));
+                       } else {
+                           address.emplace(dimensions[i].name, TensorSpec::Label(indexes[i]));
+                       }
+                   }
+                   result.add(address, value);
+               });
+    return result;
+}
+
+void
+MixedTensor::accept(TensorVisitor &visitor) const
+{
+    TensorAddressBuilder addrBuilder;
+    const auto &dimensions = _type.dimensions();
+    visitCells(*this, [&](const std::vector<vespalib::string> &labels,
+                          const std::vector<size_t> &indexes, double value)
+               {
+                   addrBuilder.clear();
+                   for (size_t i = 0; i < dimensions.size(); ++i) {
+                       if (dimensions[i].is_mapped()) {
+                           addrBuilder.add(dimensions[i].name, labels[i]);
+                       } else {
+                           addrBuilder.add(dimensions[i].name, make_string("%zu", indexes[i]));
+                       }
+                   }
+                   visitor.visit(addrBuilder.build(), value);
+               });
+}
+
+}
+
+VESPALIB_SWISS_HASH_MAP_INSTANTIATE_H_E(vespalib::tensor::SparseTensorAddressRef, uint32_t,
+                                        vespalib::hash<vespalib::tensor::SparseTensorAddressRef>,
+                                        std::equal_to<vespalib::tensor::SparseTensorAddressRef>);
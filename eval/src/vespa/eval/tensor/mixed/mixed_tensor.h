@@ -0,0 +1,80 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/tensor/cell_function.h>
+#include <vespa/eval/tensor/tensor.h>
+#include <vespa/eval/tensor/types.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor_address_ref.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/vespalib/util/arrayref.h>
+#include <vespa/vespalib/util/stash.h>
+
+namespace vespalib::tensor {
+
+/**
+ * A tensor with both mapped and indexed dimensions. The labels of
+ * the mapped dimensions are stored as serialized sparse tensor
+ * addresses, each mapping to a dense subspace with all the cells
+ * spanned by the indexed dimensions. The dense subspaces are stored
+ * back to back in a single array, which lets operations on the
+ * indexed dimensions be delegated to the dense tensor
+ * implementation.
+ */
+class MixedTensor : public Tensor
+{
+public:
+    using Index = hash_map<SparseTensorAddressRef, uint32_t, hash<SparseTensorAddressRef>,
+                           std::equal_to<SparseTensorAddressRef>, swiss_probing>;
+    using Cells = std::vector<double>;
+
+    static constexpr size_t STASH_CHUNK_SIZE = 16384u;
+
+private:
+    eval::ValueType _type;
+    eval::ValueType _sparseType;
+    eval::ValueType _denseType;
+    size_t _subspaceSize;
+    Index _index;
+    Cells _cells;
+    Stash _stash;
+
+public:
+    MixedTensor(eval::ValueType &&type_in, Index &&index_in, Cells &&cells_in, Stash &&stash_in);
+    ~MixedTensor() override;
+
+    /**
+     * Returns true if the given type has both mapped and indexed dimensions.
+     */
+    static bool isMixed(const eval::ValueType &type);
+    static Tensor::UP create(const eval::TensorSpec &spec);
+
+    /**
+     * Join two tensors where at least one is a mixed tensor. Returns
+     * an empty pointer if the combination of tensor types is not
+     * handled natively; the caller should then fall back to the
+     * reference implementation.
+     */
+    static Tensor::UP joinTensors(join_fun_t function, const Tensor &lhs, const Tensor &rhs);
+
+    const eval::ValueType &fast_type() const { return _type; }
+    const eval::ValueType &sparseType() const { return _sparseType; }
+    const eval::ValueType &denseType() const { return _denseType; }
+    size_t subspaceSize() const { return _subspaceSize; }
+    const Index &index() const { return _index; }
+    ConstArrayRef<double> subspace(uint32_t idx) const {
+        return ConstArrayRef<double>(_cells.data() + idx * _subspaceSize, _subspaceSize);
+    }
+
+    const eval::ValueType &type() const override;
+    double as_double() const override;
+    Tensor::UP apply(const CellFunction &func) const override;
+    Tensor::UP join(join_fun_t function, const Tensor &arg) const override;
+    Tensor::UP reduce(join_fun_t op, const std::vector<vespalib::string> &dimensions) const override;
+    bool equals(const Tensor &arg) const override;
+    Tensor::UP clone() const override;
+    eval::TensorSpec toSpec() const override;
+    void accept(TensorVisitor &visitor) const override;
+};
+
+}
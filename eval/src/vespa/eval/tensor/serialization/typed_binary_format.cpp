@@ -8,7 +8,9 @@
 #include <vespa/eval/tensor/tensor.h>
 #include <vespa/eval/tensor/dense/dense_tensor.h>
 #include <vespa/eval/eval/simple_tensor.h>
+#include <vespa/eval/eval/simple_tensor_engine.h>
 #include <vespa/eval/tensor/wrapped_simple_tensor.h>
+#include <vespa/eval/tensor/mixed/mixed_tensor.h>
 
 using vespalib::nbostream;
 
@@ -24,6 +26,8 @@ TypedBinaryFormat::serialize(nbostream &stream, const Tensor &tensor)
         DenseBinaryFormat::serialize(stream, *denseTensor);
     } else if (auto wrapped = dynamic_cast<const WrappedSimpleTensor *>(&tensor)) {
         eval::SimpleTensor::encode(wrapped->get(), stream);
+    } else if (auto mixed = dynamic_cast<const MixedTensor *>(&tensor)) {
+        eval::SimpleTensor::encode(*eval::SimpleTensor::create(mixed->toSpec()), stream);
     } else {
         stream.putInt1_4Bytes(SPARSE_BINARY_FORMAT_TYPE);
         SparseBinaryFormat::serialize(stream, tensor);
@@ -46,7 +50,8 @@ TypedBinaryFormat::deserialize(nbostream &stream)
     }
     if (formatId == MIXED_BINARY_FORMAT_TYPE) {
         stream.adjustReadPos(read_pos - stream.rp());
-        return std::make_unique<WrappedSimpleTensor>(eval::SimpleTensor::decode(stream));
+        auto simple = eval::SimpleTensor::decode(stream);
+        return MixedTensor::create(eval::SimpleTensorEngine::ref().to_spec(*simple));
     }
     abort();
 }
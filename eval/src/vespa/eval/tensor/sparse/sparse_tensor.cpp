@@ -190,4 +190,6 @@ SparseTensor::reduce(join_fun_t op,
 
 }
 
-VESPALIB_HASH_MAP_INSTANTIATE(vespalib::tensor::SparseTensorAddressRef, double);
+VESPALIB_SWISS_HASH_MAP_INSTANTIATE_H_E(vespalib::tensor::SparseTensorAddressRef, double,
+                                        vespalib::hash<vespalib::tensor::SparseTensorAddressRef>,
+                                        std::equal_to<vespalib::tensor::SparseTensorAddressRef>);
@@ -21,7 +21,8 @@ namespace vespalib::tensor {
 class SparseTensor : public Tensor
 {
 public:
-    using Cells = hash_map<SparseTensorAddressRef, double>;
+    using Cells = hash_map<SparseTensorAddressRef, double, hash<SparseTensorAddressRef>,
+                           std::equal_to<SparseTensorAddressRef>, swiss_probing>;
 
     static constexpr size_t STASH_CHUNK_SIZE = 16384u;
 
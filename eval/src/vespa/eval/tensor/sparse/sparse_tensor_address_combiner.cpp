@@ -42,6 +42,21 @@ TensorAddressCombiner::numOverlappingDimensions() const {
     return count;
 }
 
+void
+TensorAddressCombiner::project(SparseTensorAddressRef ref, AddressOp other,
+                               SparseTensorAddressBuilder &out) const
+{
+    out.clear();
+    SparseTensorAddressDecoder addr(ref);
+    for (auto op : _ops) {
+        if (op == AddressOp::BOTH) {
+            out.add(addr.decodeLabel());
+        } else if (op != other) {
+            addr.skipLabel();
+        }
+    }
+}
+
 bool
 TensorAddressCombiner::combine(SparseTensorAddressRef lhsRef,
                                SparseTensorAddressRef rhsRef)
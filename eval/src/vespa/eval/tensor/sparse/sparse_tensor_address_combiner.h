@@ -18,12 +18,25 @@ class TensorAddressCombiner : public SparseTensorAddressBuilder
 
     std::vector<AddressOp> _ops;
 
+    void project(SparseTensorAddressRef ref, AddressOp other, SparseTensorAddressBuilder &out) const;
 public:
     TensorAddressCombiner(const eval::ValueType &lhs, const eval::ValueType &rhs);
     ~TensorAddressCombiner();
 
     bool combine(SparseTensorAddressRef lhsRef, SparseTensorAddressRef rhsRef);
     size_t numOverlappingDimensions() const;
+
+    /**
+     * Serializes the labels of the overlapping dimensions of a lhs
+     * (or rhs) address. Two addresses can only be combined if their
+     * projections are equal.
+     */
+    void projectLhs(SparseTensorAddressRef lhsRef, SparseTensorAddressBuilder &out) const {
+        project(lhsRef, AddressOp::RHS, out);
+    }
+    void projectRhs(SparseTensorAddressRef rhsRef, SparseTensorAddressBuilder &out) const {
+        project(rhsRef, AddressOp::LHS, out);
+    }
     size_t numDimensions() const { return _ops.size(); }
 };
 
@@ -6,6 +6,8 @@
 #include "sparse_tensor_address_combiner.h"
 #include <vespa/eval/tensor/direct_tensor_builder.h>
 #include "direct_sparse_tensor_builder.h"
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <cassert>
 
 namespace vespalib::tensor::sparse {
 
@@ -15,19 +17,53 @@ apply(const SparseTensor &lhs, const SparseTensor &rhs, Function &&func)
 {
     DirectTensorBuilder<SparseTensor> builder(lhs.combineDimensionsWith(rhs));
     TensorAddressCombiner addressCombiner(lhs.fast_type(), rhs.fast_type());
-    size_t estimatedCells = (lhs.cells().size() * rhs.cells().size());
-    if (addressCombiner.numOverlappingDimensions() != 0) {
-        estimatedCells = std::min(lhs.cells().size(), rhs.cells().size());
-    }
-    builder.reserve(estimatedCells*2);
-    for (const auto &lhsCell : lhs.cells()) {
-        for (const auto &rhsCell : rhs.cells()) {
-            bool combineSuccess = addressCombiner.combine(lhsCell.first, rhsCell.first);
-            if (combineSuccess) {
+    if (addressCombiner.numOverlappingDimensions() == 0) {
+        builder.reserve(lhs.cells().size() * rhs.cells().size() * 2);
+        for (const auto &lhsCell : lhs.cells()) {
+            for (const auto &rhsCell : rhs.cells()) {
+                addressCombiner.combine(lhsCell.first, rhsCell.first);
                 builder.insertCell(addressCombiner.getAddressRef(),
                                    func(lhsCell.second, rhsCell.second));
             }
         }
+        return builder.build();
+    }
+    builder.reserve(std::min(lhs.cells().size(), rhs.cells().size())*2);
+    // Index the rhs cells on their labels in the overlapping dimensions,
+    // so that each lhs cell is only combined with the rhs cells it matches.
+    using Cell = SparseTensor::Cells::value_type;
+    Stash stash;
+    hash_map<SparseTensorAddressRef, uint32_t, hash<SparseTensorAddressRef>,
+             std::equal_to<SparseTensorAddressRef>, swiss_probing> firstMatch(rhs.cells().size());
+    std::vector<std::pair<const Cell *, uint32_t>> matches; // cell, next match
+    matches.reserve(rhs.cells().size());
+    SparseTensorAddressBuilder projected;
+    for (const auto &rhsCell : rhs.cells()) {
+        addressCombiner.projectRhs(rhsCell.first, projected);
+        uint32_t idx = matches.size();
+        auto inserted = firstMatch.insert(std::make_pair(projected.getAddressRef(), idx));
+        if (inserted.second) {
+            inserted.first->first = SparseTensorAddressRef(projected.getAddressRef(), stash);
+            matches.emplace_back(&rhsCell, UINT32_MAX);
+        } else {
+            matches.emplace_back(&rhsCell, inserted.first->second);
+            inserted.first->second = idx;
+        }
+    }
+    for (const auto &lhsCell : lhs.cells()) {
+        addressCombiner.projectLhs(lhsCell.first, projected);
+        auto found = firstMatch.find(projected.getAddressRef());
+        if (found == firstMatch.end()) {
+            continue;
+        }
+        for (uint32_t idx = found->second; idx != UINT32_MAX; idx = matches[idx].second) {
+            const Cell &rhsCell = *matches[idx].first;
+            bool combineSuccess = addressCombiner.combine(lhsCell.first, rhsCell.first);
+            assert(combineSuccess);
+            (void) combineSuccess;
+            builder.insertCell(addressCombiner.getAddressRef(),
+                               func(lhsCell.second, rhsCell.second));
+        }
     }
     return builder.build();
 }
@@ -288,9 +288,11 @@ public:
                 Progress(rc, "Map address: 0x%p", mmapBuffer);
 
                 if (mmapEnabled) {
-                    rc = 0;
+                    Progress(file.willNeed(0, bufSize), "Prefetching %d bytes of memory map", bufSize);
+                    Progress(!file.willNeed(bufSize, 10), "Prefetching beyond the memory map is ignored");
+                    rc = true;
                     for (i = 0; i < bufSize; i++) {
-                        rc |= (mmapBuffer[i] == i % 256);
+                        rc &= (mmapBuffer[i] == static_cast<char>(i % 256));
                     }
                     Progress(rc, "Reading %d bytes from memory map", bufSize);
                 }
@@ -679,6 +681,8 @@ public:
             Progress(position == 4, "File pointer should be 4 after reading 4 bytes");
             Progress(strcmp(buffer, "This") == 0, "[This]=[%s]", buffer);
 
+            Progress(file.willNeed(8, 6), "Prefetching 6 bytes at offset 8");
+            Progress(!file.willNeed(8, 0), "Prefetching nothing is ignored");
             file.ReadBuf(buffer, 6, 8);
             buffer[6] = '\0';
             position = file.GetPosition();
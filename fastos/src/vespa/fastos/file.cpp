@@ -490,6 +490,11 @@ void FastOS_FileInterface::dropFromCache() const
 {
 }
 
+bool FastOS_FileInterface::willNeed(int64_t, size_t) const
+{
+    return false;
+}
+
 FastOS_DirectoryScanInterface::FastOS_DirectoryScanInterface(const char *path)
     : _searchPath(strdup(path))
 {
@@ -587,6 +587,15 @@ public:
      **/
     virtual void dropFromCache() const;
 
+    /**
+     * Hint that the given range of the file will be read soon, so the
+     * OS may start fetching it asynchronously. Has no effect on
+     * file content and may be ignored.
+     *
+     * @return true if the hint was passed on to the OS
+     **/
+    virtual bool willNeed(int64_t offset, size_t length) const;
+
     enum Error
     {
         ERR_ZERO = 1,   // No error                       New style
@@ -11,6 +11,7 @@
 #include <sstream>
 #include <cassert>
 #include <cstring>
+#include <algorithm>
 #include <unistd.h>
 #include <fcntl.h>
 #include <dirent.h>
@@ -248,6 +249,25 @@ void FastOS_UNIX_File::dropFromCache() const
     posix_fadvise(_filedes, 0, 0, POSIX_FADV_DONTNEED);
 }
 
+bool FastOS_UNIX_File::willNeed(int64_t offset, size_t length) const
+{
+    if ((offset < 0) || (length == 0)) {
+        return false;
+    }
+    if (_mmapbase != nullptr) {
+        if (offset >= int64_t(_mmaplen)) {
+            return false;
+        }
+        size_t pageMask(getpagesize() - 1);
+        size_t start(offset & ~pageMask);
+        size_t end(std::min(size_t(offset) + length, _mmaplen));
+        return posix_madvise(static_cast<char *>(_mmapbase) + start, end - start, POSIX_MADV_WILLNEED) == 0;
+    } else if (_filedes >= 0) {
+        return posix_fadvise(_filedes, offset, length, POSIX_FADV_WILLNEED) == 0;
+    }
+    return false;
+}
+
 
 bool
 FastOS_UNIX_File::Close(void)
@@ -86,6 +86,7 @@ public:
     bool Sync() override;
     bool SetSize(int64_t newSize) override;
     void dropFromCache() const override;
+    bool willNeed(int64_t offset, size_t length) const override;
 
     static bool Delete(const char *filename);
     static int GetLastOSError() { return errno; }
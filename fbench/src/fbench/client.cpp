@@ -7,6 +7,7 @@
 #include <util/filereader.h>
 #include <cassert>
 #include <cstring>
+#include <deque>
 
 Client::Client(ClientArguments *args)
     : _args(args),
@@ -157,9 +158,6 @@ Client::run()
 {
     char inputFilename[1024];
     char outputFilename[1024];
-    char timestr[64];
-    int  linelen;
-    ///   int  reslen;
 
     std::this_thread::sleep_for(std::chrono::milliseconds(_args->_delay));
 
@@ -192,6 +190,24 @@ Client::run()
         _reader->SetFilePos(_args->_queryfileOffset);
 
     UrlReader urlSource(*_reader, *_args);
+    if (_args->_pipelineDepth > 1) {
+        runPipelined(urlSource, inputFilename);
+    } else {
+        runSequential(urlSource, inputFilename);
+    }
+    _masterTimer->Stop();
+    _status->SetRealTime(_masterTimer->GetTimespan());
+    _status->SetReuseCount(_http->GetReuseCount());
+    printf(".");
+    fflush(stdout);
+    _done = true;
+}
+
+void
+Client::runSequential(UrlReader &urlSource, const char *inputFilename)
+{
+    char   timestr[64];
+    int    linelen;
     size_t urlNumber = 0;
 
     // run queries
@@ -268,12 +284,92 @@ Client::run()
         // Update current time span to calculate Q/s
         _status->SetRealTime(_masterTimer->GetCurrent());
     }
-    _masterTimer->Stop();
-    _status->SetRealTime(_masterTimer->GetTimespan());
-    _status->SetReuseCount(_http->GetReuseCount());
-    printf(".");
-    fflush(stdout);
-    _done = true;
+}
+
+void
+Client::runPipelined(UrlReader &urlSource, const char *inputFilename)
+{
+    using clock = std::chrono::steady_clock;
+    struct Pending {
+        std::string       url;
+        clock::time_point sent;
+        bool              ok;
+    };
+    char                timestr[64];
+    std::deque<Pending> pending;
+    size_t              urlNumber = 0;
+    bool                eof = false;
+
+    // keep up to '_pipelineDepth' requests in flight on the connection
+    while (!_stop || !pending.empty()) {
+        while (!_stop && !eof && (int)pending.size() < _args->_pipelineDepth) {
+            int linelen = urlSource.nextUrl(_linebuf, _linebufsize);
+            if (linelen <= 0) {
+                if (urlNumber == 0) {
+                    fprintf(stderr, "Client %d: ERROR: could not read any lines from '%s'\n",
+                            _args->_myNum, inputFilename);
+                    _status->SetError("Could not read any lines from query file.");
+                }
+                eof = true;
+                break;
+            }
+            ++urlNumber;
+            if (linelen >= _linebufsize) {
+                if (_args->_ignoreCount == 0)
+                    _status->SkippedRequest();
+                continue;
+            }
+            if (linelen + (int)_args->_queryStringToAppend.length() < _linebufsize) {
+                strcat(_linebuf, _args->_queryStringToAppend.c_str());
+            }
+            int cLen = _args->_usePostMode ? urlSource.nextContent() : 0;
+            bool ok = _http->Send(_linebuf, _args->_usePostMode, urlSource.content(), cLen);
+            pending.push_back(Pending{_linebuf, clock::now(), ok});
+            if (!ok) {
+                break;
+            }
+        }
+        if (pending.empty()) {
+            break;
+        }
+        Pending request = std::move(pending.front());
+        pending.pop_front();
+        if (_output) {
+            _output->write("URL: ", strlen("URL: "));
+            _output->write(request.url.data(), request.url.size());
+            _output->write("\n\n", 2);
+        }
+        auto fetch_status = request.ok ? _http->Receive(_output.get())
+                                       : HTTPClient::FetchStatus(false, 0, -1, 0);
+        double ms = std::chrono::duration<double, std::milli>(clock::now() - request.sent).count();
+        _status->AddRequestStatus(fetch_status.RequestStatus());
+        if (fetch_status.Ok() && fetch_status.TotalHitCount() == 0)
+            ++_status->_zeroHitQueries;
+        if (_output) {
+            if (!fetch_status.Ok()) {
+                _output->write("\nFBENCH: URL FETCH FAILED!\n",
+                               strlen("\nFBENCH: URL FETCH FAILED!\n"));
+            } else {
+                sprintf(timestr, "\nTIME USED: %0.4f s\n", ms / 1000.0);
+                _output->write(timestr, strlen(timestr));
+            }
+            _output->write(FBENCH_DELIMITER + 1, strlen(FBENCH_DELIMITER) - 1);
+        }
+        if (fetch_status.ResultSize() >= _args->_byteLimit) {
+            if (_args->_ignoreCount == 0)
+                _status->ResponseTime(ms);
+        } else {
+            if (_args->_ignoreCount == 0)
+                _status->RequestFailed();
+        }
+        if (_args->_ignoreCount > 0) {
+            _args->_ignoreCount--;
+            if (_args->_ignoreCount == 0)
+                _masterTimer->Start();
+        }
+        // Update current time span to calculate Q/s
+        _status->SetRealTime(_masterTimer->GetCurrent());
+    }
 }
 
 void Client::stop() {
@@ -102,6 +102,13 @@ struct ClientArguments
      **/
     bool        _headerBenchmarkdataCoverage;
 
+    /**
+     * Number of requests this client may have outstanding on its
+     * connection at the same time (HTTP/1.1 pipelining). A depth of 1
+     * disables pipelining.
+     **/
+    int         _pipelineDepth;
+
     uint64_t    _queryfileOffset;
     uint64_t    _queryfileEndOffset;
     bool        _singleQueryFile;
@@ -119,7 +126,7 @@ struct ClientArguments
                     bool keepAlive, bool headerBenchmarkdataCoverage,
                     uint64_t queryfileOffset, uint64_t queryfileEndOffset, bool singleQueryFile,
                     const std::string & queryStringToAppend, const std::string & extraHeaders,
-                    const std::string &authority, bool postMode)
+                    const std::string &authority, bool postMode, int pipelineDepth)
         : _myNum(myNum),
           _totNum(totNum),
           _filenamePattern(filenamePattern),
@@ -135,6 +142,7 @@ struct ClientArguments
           _keepAlive(keepAlive),
           _usePostMode(postMode),
           _headerBenchmarkdataCoverage(headerBenchmarkdataCoverage),
+          _pipelineDepth(pipelineDepth),
           _queryfileOffset(queryfileOffset),
           _queryfileEndOffset(queryfileEndOffset),
           _singleQueryFile(singleQueryFile),
@@ -154,6 +162,7 @@ class Timer;
 class HTTPClient;
 class FileReader;
 class ClientStatus;
+class UrlReader;
 /**
  * This class implements a single test client. The clients are run in
  * separate threads to simulate several simultanious users. The
@@ -181,6 +190,8 @@ private:
     Client &operator=(const Client &);
     static void runMe(Client * client);
     void run();
+    void runSequential(UrlReader &urlSource, const char *inputFilename);
+    void runPipelined(UrlReader &urlSource, const char *inputFilename);
 
 public:
     typedef std::unique_ptr<Client> UP;
@@ -24,7 +24,10 @@ FBench::FBench()
       _usePostMode(false),
       _headerBenchmarkdataCoverage(false),
       _seconds(60),
-      _singleQueryFile(false)
+      _singleQueryFile(false),
+      _pipelineDepth(1),
+      _intervalStatus(),
+      _intervalStart()
 {
 }
 
@@ -41,7 +44,7 @@ FBench::InitBenchmark(int numClients, int ignoreCount, int cycle,
                       int byteLimit, int restartLimit, int maxLineSize,
                       bool keepAlive, bool headerBenchmarkdataCoverage, int seconds,
                       bool singleQueryFile, const std::string & queryStringToAppend, const std::string & extraHeaders,
-                      const std::string &authority, bool postMode)
+                      const std::string &authority, bool postMode, int pipelineDepth)
 {
     _clients.resize(numClients);
     _ignoreCount     = ignoreCount;
@@ -63,6 +66,7 @@ FBench::InitBenchmark(int numClients, int ignoreCount, int cycle,
     _headerBenchmarkdataCoverage = headerBenchmarkdataCoverage;
     _seconds = seconds;
     _singleQueryFile = singleQueryFile;
+    _pipelineDepth   = pipelineDepth;
 }
 
 void
@@ -86,7 +90,8 @@ FBench::CreateClients()
                                 _byteLimit, _restartLimit, _maxLineSize,
                                 _keepAlive, _headerBenchmarkdataCoverage,
                                 off_beg, off_end,
-                                _singleQueryFile, _queryStringToAppend, _extraHeaders, _authority, _usePostMode));
+                                _singleQueryFile, _queryStringToAppend, _extraHeaders, _authority, _usePostMode,
+                                _pipelineDepth));
         ++i;
     }
 }
@@ -149,7 +154,7 @@ FBench::PrintSummary()
     }
     double avg = status.GetAverage();
 
-    maxRate = (avg > 0) ? realNumClients * 1000.0 / avg : 0;
+    maxRate = (avg > 0) ? realNumClients * _pipelineDepth * 1000.0 / avg : 0;
     actualRate = (status._realTime > 0) ?
                  realNumClients * 1000.0 * status._requestCnt / status._realTime : 0;
 
@@ -205,12 +210,39 @@ FBench::PrintSummary()
     fflush(stdout);
 }
 
+void
+FBench::PrintInterval(int second)
+{
+    auto status = std::make_unique<ClientStatus>();
+    for (auto & client : _clients) {
+        if (!client->GetStatus()._error) {
+            status->Merge(client->GetStatus());
+        }
+    }
+    auto now = std::chrono::steady_clock::now();
+    ClientStatus interval;
+    interval.Merge(*status);
+    if (_intervalStatus) {
+        interval.Subtract(*_intervalStatus);
+    }
+    if (_intervalStatus) {
+        double elapsed = std::chrono::duration<double>(now - _intervalStart).count();
+        printf("[%6d s] %10.2f Q/s %8ld failed, response time avg %8.2f ms, 50%% %8.2f ms, 99%% %8.2f ms\n",
+               second, (elapsed > 0) ? interval._requestCnt / elapsed : 0,
+               interval._failCnt, interval.GetAverage(),
+               interval.GetPercentile(50), interval.GetPercentile(99));
+        fflush(stdout);
+    }
+    _intervalStatus = std::move(status);
+    _intervalStart = now;
+}
+
 void
 FBench::Usage()
 {
     printf("usage: vespa-fbench [-H extraHeader] [-a queryStringToAppend ] [-n numClients] [-c cycleTime] [-l limit] [-i ignoreCount]\n");
     printf("              [-s seconds] [-q queryFilePattern] [-o outputFilePattern]\n");
-    printf("              [-r restartLimit] [-m maxLineSize] [-k] <hostname> <port>\n\n");
+    printf("              [-r restartLimit] [-m maxLineSize] [-d depth] [-I] [-k] <hostname> <port>\n\n");
     printf(" -H <str> : append extra header to each get request.\n");
     printf(" -A <str> : assign autority.  <str> should be hostname:port format. Overrides Host: header sent.\n");
     printf(" -P       : use POST for requests instead of GET.\n");
@@ -229,6 +261,9 @@ FBench::Usage()
     printf(" -m <num> : max line size in input query files [8192].\n");
     printf("            Can not be less than the minimum [1024].\n");
     printf(" -p <num> : print summary every <num> seconds.\n");
+    printf(" -I       : print query rate and response times of each second.\n");
+    printf(" -d <num> : pipeline up to <num> requests on each client connection [1].\n");
+    printf("            (the cycle time is ignored when pipelining)\n");
     printf(" -k       : disable HTTP keep-alive.\n");
     printf(" -y       : write data on coverage to output file (must used with -x).\n");
     printf(" -z       : use single query file to be distributed between clients.\n\n");
@@ -273,6 +308,8 @@ FBench::Main(int argc, char *argv[])
     std::string authority;
 
     int  printInterval = 0;
+    bool intervalStats = false;
+    int  pipelineDepth = 1;
 
     // parse options and override defaults.
     int         idx;
@@ -282,7 +319,7 @@ FBench::Main(int argc, char *argv[])
 
     idx = 1;
     optError = false;
-    while((opt = GetOpt(argc, argv, "H:A:a:n:c:l:i:s:q:o:r:m:p:kxyzP", arg, idx)) != -1) {
+    while((opt = GetOpt(argc, argv, "H:A:a:n:c:l:i:s:q:o:r:m:p:d:kxyzIP", arg, idx)) != -1) {
         switch(opt) {
         case 'A':
             authority = arg;
@@ -335,6 +372,14 @@ FBench::Main(int argc, char *argv[])
             if (printInterval < 0)
                 optError = true;
             break;
+        case 'I':
+            intervalStats = true;
+            break;
+        case 'd':
+            pipelineDepth = atoi(arg);
+            if (pipelineDepth < 1)
+                optError = true;
+            break;
         case 'k':
             keepAlive = false;
             break;
@@ -354,6 +399,11 @@ FBench::Main(int argc, char *argv[])
         }
     }
 
+    if (pipelineDepth > 1 && !keepAlive) {
+        fprintf(stderr, "Pipelining requires HTTP keep-alive\n");
+        return -1;
+    }
+
     if ( argc < (idx + 2) || optError) {
         Usage();
         return -1;
@@ -423,10 +473,13 @@ FBench::Main(int argc, char *argv[])
                   keepAlive,
                   headerBenchmarkdataCoverage, seconds,
                   singleQueryFile, queryStringToAppend, extraHeaders,
-                  authority, usePostMode);
+                  authority, usePostMode, pipelineDepth);
 
     CreateClients();
     StartClients();
+    if (intervalStats) {
+        PrintInterval(0);
+    }
 
     if (seconds < 0) {
         unsigned int secondCount = 0;
@@ -436,6 +489,9 @@ FBench::Main(int argc, char *argv[])
                 Exit();
             }
             std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+            if (intervalStats) {
+                PrintInterval(secondCount + 1);
+            }
             if (printInterval != 0 && ++secondCount % printInterval == 0) {
                 printf("\nRuntime: %d sec\n", secondCount);
                 PrintSummary();
@@ -454,6 +510,10 @@ FBench::Main(int argc, char *argv[])
             std::this_thread::sleep_for(std::chrono::milliseconds(int(sleepTimer.GetRemaining())));
             sleepTimer.Start();
 
+            if (intervalStats) {
+                PrintInterval(_seconds - seconds + 1);
+            }
+
             if (seconds % 60 == 0) {
                 printf("[dummydate]: PROGRESS: vespa-fbench: Seconds left %d\n", seconds);
             }
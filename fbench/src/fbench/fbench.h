@@ -31,19 +31,23 @@ private:
     std::string         _queryStringToAppend;
     std::string         _extraHeaders;
     std::string         _authority;
+    int                 _pipelineDepth;
+    std::unique_ptr<ClientStatus> _intervalStatus;
+    std::chrono::steady_clock::time_point _intervalStart;
 
     void InitBenchmark(int numClients, int ignoreCount, int cycle,
                        const char *filenamePattern, const char *outputPattern,
                        int byteLimit, int restartLimit, int maxLineSize,
                        bool keepAlive, bool headerBenchmarkdataCoverage, int seconds,
                        bool singleQueryFile, const std::string & queryStringToAppend, const std::string & extraHeaders,
-                       const std::string &authority, bool postMode);
+                       const std::string &authority, bool postMode, int pipelineDepth);
 
     void CreateClients();
     void StartClients();
     void StopClients();
     bool ClientsDone();
     void PrintSummary();
+    void PrintInterval(int second);
 
     FBench(const FBench &);
     FBench &operator=(const FBench &);
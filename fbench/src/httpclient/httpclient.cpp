@@ -95,15 +95,9 @@ HTTPClient::ReadLine(char *buf, size_t bufsize)
     return len;
 }
 
-bool
-HTTPClient::Connect(const char *url, bool usePost, const char *content, int cLen)
+std::string
+HTTPClient::BuildRequest(const char *url, bool usePost, int contentLen) const
 {
-    char tmp[4096];
-    char *req = NULL;
-    uint32_t req_max = 0;
-    uint32_t url_len = strlen(url);
-    uint32_t host_len = _hostname.size();
-
     // Add additional headers
     std::string headers = _extraHeaders;
 
@@ -113,86 +107,75 @@ HTTPClient::Connect(const char *url, bool usePost, const char *content, int cLen
     if ( _headerBenchmarkdataCoverage ) {
         headers += "X-Yahoo-Vespa-Benchmarkdata-Coverage: true\r\n";
     }
-
-    if (url_len + host_len + headers.length() + FIXED_REQ_MAX < sizeof(tmp)) {
-        req = tmp;
-        req_max = sizeof(tmp);
-    } else {
-        req_max = url_len + host_len + headers.length() + FIXED_REQ_MAX;
-        req = new char[req_max];
-        assert(req != NULL);
-    }
-
     if (!_keepAlive) {
         headers += "Connection: close\r\n";
     }
     headers += "User-Agent: fbench/4.2.10\r\n";
 
-    // create request
+    std::string req;
+    req.reserve(strlen(url) + _authority.size() + headers.length() + FIXED_REQ_MAX);
+    req += usePost ? "POST " : "GET ";
+    req += url;
+    req += " HTTP/1.1\r\nHost: ";
+    req += _authority;
+    req += "\r\n";
     if (usePost) {
-        snprintf(req, req_max,
-                 "POST %s HTTP/1.1\r\n"
-                 "Host: %s\r\n"
-                 "Content-Length: %d\r\n"
-                 "%s"
-                 "\r\n",
-                 url, _authority.c_str(), cLen, headers.c_str());
-    } else {
-        snprintf(req, req_max,
-                 "GET %s HTTP/1.1\r\n"
-                 "Host: %s\r\n"
-                 "%s"
-                 "\r\n",
-                 url, _authority.c_str(), headers.c_str());
+        req += "Content-Length: " + std::to_string(contentLen) + "\r\n";
+    }
+    req += headers;
+    req += "\r\n";
+    return req;
+}
+
+bool
+HTTPClient::OpenSocket()
+{
+    if (_socket->SetSoBlocking(true)
+        && _socket->Connect()
+        && _socket->SetNoDelay(true)
+        && _socket->SetSoLinger(false, 0))
+    {
+        return true;
     }
+    _socket->Close();
+    return false;
+}
+
+bool
+HTTPClient::Connect(const char *url, bool usePost, const char *content, int cLen)
+{
+    std::string req = BuildRequest(url, usePost, cLen);
 
     // try to reuse connection if keep-alive is enabled
     if (_keepAlive
         && _socket->IsOpened()
-        && _socket->Write(req, strlen(req)) == (ssize_t)strlen(req)
+        && _socket->Write(req.data(), req.size()) == (ssize_t)req.size()
         && (!usePost || _socket->Write(content, cLen) == (ssize_t)cLen)
         && FillBuffer() > 0) {
-
         // DEBUG
         // printf("Socket Connection reused!\n");
         _reuseCount++;
-        if (req != tmp) {
-            delete [] req;
-        }
         return true;
     } else {
         _socket->Close();
         ResetBuffer();
     }
-
     // try to open new connection to server
-    if (_socket->SetSoBlocking(true)
-        && _socket->Connect()
-        && _socket->SetNoDelay(true)
-        && _socket->SetSoLinger(false, 0)
-        && _socket->Write(req, strlen(req)) == (ssize_t)strlen(req)
+    if (OpenSocket()
+        && _socket->Write(req.data(), req.size()) == (ssize_t)req.size()
         && (!usePost || _socket->Write(content, cLen) == (ssize_t)cLen))
     {
-
         // DEBUG
         // printf("New Socket connection!\n");
-        if (req != tmp) {
-            delete [] req;
-        }
         return true;
     } else {
         _socket->Close();
     }
-
     // DEBUG
     // printf("Connect FAILED!\n");
-    if (req != tmp) {
-        delete [] req;
-    }
     return false;
 }
 
-
 char *
 HTTPClient::SplitString(char *input, int &argc, char **argv, int maxargs)
 {
@@ -353,10 +336,19 @@ HTTPClient::Open(const char *url, bool usePost, const char *content, int cLen)
     _dataRead  = 0;
     _dataDone  = false;
     _isOpen    = Connect(url, usePost, content, cLen);
-    if(!_isOpen || !ReadHTTPHeader()) {
+    if(!_isOpen || !ReadResponseHeader()) {
         Close();
         return false;
     }
+    return true;
+}
+
+bool
+HTTPClient::ReadResponseHeader()
+{
+    if (!ReadHTTPHeader()) {
+        return false;
+    }
     if(_chunkedEncodingGiven) {
         _chunkSeq  = 0;
         _chunkLeft = 0;
@@ -421,6 +413,9 @@ HTTPClient::ContentLengthReader::Read(HTTPClient &client,
     if (client._bufused > client._bufpos) { // data in buffer ?
         fromBuffer = (((size_t)(client._bufused - client._bufpos)) > len) ?
                      len : client._bufused - client._bufpos;
+        // the buffer may hold the start of a pipelined response
+        fromBuffer = (fromBuffer > client._contentLength - client._dataRead) ?
+                     client._contentLength - client._dataRead : fromBuffer;
         memcpy(buf, client._buf + client._bufpos, fromBuffer);
         client._bufpos += fromBuffer;
         client._dataRead += fromBuffer;
@@ -516,16 +511,58 @@ HTTPClient::Close()
 HTTPClient::FetchStatus
 HTTPClient::Fetch(const char *url, std::ostream *file,
                   bool usePost, const char *content, int contentLen)
+{
+    if (!Open(url, usePost, content, contentLen)) {
+        return FetchStatus(false, _requestStatus, _totalHitCount, 0);
+    }
+    return ReadContent(file);
+}
+
+bool
+HTTPClient::Send(const char *url, bool usePost, const char *content, int contentLen)
+{
+    std::string req = BuildRequest(url, usePost, contentLen);
+    if (_socket->IsOpened()) {
+        _reuseCount++;
+    } else {
+        ResetBuffer();
+        if (!OpenSocket()) {
+            return false;
+        }
+    }
+    if (_socket->Write(req.data(), req.size()) == (ssize_t)req.size()
+        && (!usePost || _socket->Write(content, contentLen) == (ssize_t)contentLen))
+    {
+        return true;
+    }
+    _socket->Close();
+    return false;
+}
+
+HTTPClient::FetchStatus
+HTTPClient::Receive(std::ostream *file)
+{
+    if (_isOpen)
+        Close();
+
+    _dataRead  = 0;
+    _dataDone  = false;
+    _isOpen    = _socket->IsOpened();
+    if (!_isOpen || !ReadResponseHeader()) {
+        Close();
+        return FetchStatus(false, _requestStatus, _totalHitCount, 0);
+    }
+    return ReadContent(file);
+}
+
+HTTPClient::FetchStatus
+HTTPClient::ReadContent(std::ostream *file)
 {
     size_t  buflen   = FETCH_BUFLEN;
     char    buf[FETCH_BUFLEN];      // NB: ensure big enough thread stack.
     ssize_t readRes  = 0;
     ssize_t written  = 0;
 
-    if (!Open(url, usePost, content, contentLen)) {
-        return FetchStatus(false, _requestStatus, _totalHitCount, 0);
-    }
-
     // Write headerinfo
     if (file) {
         file->write(_headerinfo.c_str(), _headerinfo.length());
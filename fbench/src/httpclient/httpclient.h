@@ -7,9 +7,10 @@
 
 /**
  * This class implements a HTTP client that may be used to fetch
- * documents from a HTTP server. It uses the HTTP 1.1 protocol, but in
- * order to keep the external interface simple, it does not support
- * request pipelining.
+ * documents from a HTTP server. It uses the HTTP 1.1 protocol. The
+ * simple interface (@ref Fetch) does one request at a time, while
+ * @ref Send and @ref Receive may be used to pipeline several requests
+ * on the same keep-alive connection.
  **/
 class HTTPClient
 {
@@ -160,6 +161,23 @@ protected:
   bool Connect(const char *url, bool usePost = false,
                const char *content = NULL, int contentLen = 0);
 
+  /**
+   * Build the HTTP request header for the given url.
+   *
+   * @return the request header, ending with an empty line.
+   * @param url the url to request.
+   * @param usePost whether to use POST in the request
+   * @param contentLen length of content in bytes (POST only)
+   **/
+  std::string BuildRequest(const char *url, bool usePost, int contentLen) const;
+
+  /**
+   * Open a new physical connection to the server.
+   *
+   * @return success(true)/failure(false)
+   **/
+  bool OpenSocket();
+
   /**
    * Read the next line of text from the data stream into 'buf'. If
    * the line is longer than ('bufsize' - 1), the first ('bufsize' -
@@ -205,6 +223,14 @@ protected:
    **/
   bool ReadChunkHeader();
 
+  /**
+   * Read the HTTP header of the next response on the connection and
+   * select how to read the response content.
+   *
+   * @return success(true)/failure(false)
+   **/
+  bool ReadResponseHeader();
+
 public:
 
   /**
@@ -336,4 +362,38 @@ public:
    **/
   FetchStatus Fetch(const char *url, std::ostream *file = NULL,
                     bool usePost = false, const char *content = NULL, int contentLen = 0);
+
+  /**
+   * Send a request without waiting for the response. Several requests
+   * may be sent back to back on the same connection (HTTP/1.1
+   * pipelining); the responses must then be read in the same order
+   * with @ref Receive. A new connection is opened if the current one
+   * has been closed. Note that all requests sent but not yet received
+   * are lost if the server closes the connection.
+   *
+   * @return success(true)/failure(false)
+   * @param url the url to request.
+   * @param usePost whether to use POST in the request
+   * @param content if usePost is true, the content to post
+   * @param contentLen length of content in bytes
+   **/
+  bool Send(const char *url, bool usePost = false,
+            const char *content = NULL, int contentLen = 0);
+
+  /**
+   * Read the response to the oldest request sent with @ref Send that
+   * has not been received yet.
+   *
+   * @return FetchStatus object which can be queried for status.
+   * @param file where to save the fetched document. If this parameter
+   *             is NULL, the content will be read and then discarded.
+   **/
+  FetchStatus Receive(std::ostream *file = NULL);
+
+private:
+  /**
+   * Read the content of the currently open response, save it to
+   * 'file' if given and close the response.
+   **/
+  FetchStatus ReadContent(std::ostream *file);
 };
@@ -98,6 +98,33 @@ ClientStatus::Merge(const ClientStatus & status)
     }
 }
 
+void
+ClientStatus::Subtract(const ClientStatus & status)
+{
+    if (_timetable.size() != status._timetable.size()) {
+        printf("ClientStatus::Subtract() : incompatible data structures!\n");
+        return;
+    }
+
+    _skipCnt -= status._skipCnt;
+    _failCnt -= status._failCnt;
+    _overtimeCnt -= status._overtimeCnt;
+    _totalTime -= status._totalTime;
+    _realTime -= status._realTime;
+    _requestCnt -= status._requestCnt;
+    for (size_t i = 0; i < _timetable.size(); i++)
+        _timetable[i] -= status._timetable[i];
+    _higherCnt -= status._higherCnt;
+    _reuseCnt -= status._reuseCnt;
+    _zeroHitQueries -= status._zeroHitQueries;
+
+    for (const auto& entry : status._requestStatusDistribution) {
+        auto it = _requestStatusDistribution.find(entry.first);
+        if (it != _requestStatusDistribution.end())
+            it->second -= entry.second;
+    }
+}
+
 double
 ClientStatus::GetMin()
 {
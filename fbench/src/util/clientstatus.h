@@ -174,6 +174,16 @@ struct ClientStatus
      **/
     void Merge(const ClientStatus & status);
 
+    /**
+     * Remove the requests counted in 'status' from this struct, where
+     * 'status' is an earlier snapshot of the same clients. This is
+     * used to get the status of a time interval. The min and max
+     * response times are kept as is, since they can not be subtracted.
+     *
+     * @param status The earlier snapshot to subtract.
+     **/
+    void Subtract(const ClientStatus & status);
+
     /**
      * @return the minimum response time.
      **/
@@ -19,6 +19,7 @@
 
 namespace {
 const char* programName = "filedistributor";
+const int metricsSnapshotIntervalSecs = 60;
 }
 
 #include <vespa/log/log.h>
@@ -111,6 +112,10 @@ class FileDistributor : public config::IFetcherCallback<ZookeepersConfig>,
             _stateServer->myComponents.addConfig(curr);
         }
 
+        void snapshotMetrics() {
+            _stateServer->snapshot(_downloader->getStats());
+        }
+
         ~Components() {
             _configFetcher.close();
             //Do not waste time retrying zookeeper operations when going down.
@@ -214,12 +219,17 @@ public:
         // We do not want back to back reinitializing as it gives zero time for serving
         // some torrents.
         int postPoneAskedToReinitializedSecs = 50;
+        int secsToMetricsSnapshot = metricsSnapshotIntervalSecs;
 
         while (!askedToShutDown() &&
 	       (postPoneAskedToReinitializedSecs > 0 || !askedToReinitialize()) &&
 	       !completeReconfigurationNeeded())
         {
             postPoneAskedToReinitializedSecs--;
+            if (--secsToMetricsSnapshot <= 0) {
+                _components->snapshotMetrics();
+                secsToMetricsSnapshot = metricsSnapshotIntervalSecs;
+            }
             std::this_thread::sleep_for(1s);
         }
         _components.reset();
@@ -6,6 +6,8 @@
 #include <vespa/filedistribution/model/zkfacade.h>
 #include <vespa/filedistribution/model/filedistributionmodel.h>
 #include <vespa/filedistribution/model/filedistributionmodelimpl.h>
+#include <vespa/filedistribution/distributor/state_server_impl.h>
+#include <vespa/vespalib/data/slime/slime.h>
 
 using namespace filedistribution;
 
@@ -14,3 +16,21 @@ BOOST_AUTO_TEST_CASE(test_retrieve_status) {
     // TODO:
 }
 
+
+BOOST_AUTO_TEST_CASE(test_download_metrics_snapshot) {
+    DownloadStats prev(DownloadStats::zero());
+    DownloadStats curr(DownloadStats::zero());
+    prev.totalDownload = 1000;
+    curr.totalDownload = 7000;
+    curr.totalFailedBytes = 16384;
+    curr.numPeers = 3;
+    vespalib::Slime slime;
+    vespalib::string json = makeDownloadMetricsSnapshot(prev, curr, 100, 160);
+    BOOST_REQUIRE(vespalib::slime::JsonFormat::decode(json, slime) > 0);
+    const vespalib::slime::Inspector &values = slime.get()["values"];
+    BOOST_CHECK_EQUAL("filedistribution.bytes.downloaded", values[0]["name"].asString().make_string());
+    BOOST_CHECK_EQUAL(6000, values[0]["values"]["count"].asLong());
+    BOOST_CHECK_EQUAL(100.0, values[0]["values"]["rate"].asDouble());
+    BOOST_CHECK_EQUAL(16384, values[2]["values"]["count"].asLong());
+    BOOST_CHECK_EQUAL(3, values[4]["values"]["last"].asLong());
+}
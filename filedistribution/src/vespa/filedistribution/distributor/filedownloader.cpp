@@ -410,6 +410,28 @@ void FileDownloader::runEventLoop() {
     drain();
 }
 
+DownloadStats
+FileDownloader::getStats() const {
+    DownloadStats stats(DownloadStats::zero());
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+    const libtorrent::session_status status = _session.status();
+#pragma GCC diagnostic pop
+    stats.totalDownload = status.total_payload_download;
+    stats.totalUpload = status.total_payload_upload;
+    stats.totalFailedBytes = status.total_failed_bytes;
+    stats.totalRedundantBytes = status.total_redundant_bytes;
+    stats.numPeers = status.num_peers;
+    for (const torrent_handle & torrent : _session.get_torrents()) {
+        ++stats.numTorrents;
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+        if (torrent.is_finished()) {
+#pragma GCC diagnostic pop
+            ++stats.numFinished;
+        }
+    }
+    return stats;
+}
+
 bool
 FileDownloader::closed() const
 {
@@ -9,6 +9,7 @@
 
 #include <vespa/filedistribution/rpc/fileprovider.h>
 #include "hostname.h"
+#include "state_server_impl.h"
 #include <vespa/filedistribution/common/buffer.h>
 #include <vespa/filedistribution/common/exception.h>
 #include <vespa/filedistribution/model/filedbmodel.h>
@@ -70,6 +71,7 @@ public:
     std::string infoHash2FileReference(const libtorrent::sha1_hash& hash);
     void setMaxDownloadSpeed(double MBPerSec);
     void setMaxUploadSpeed(double MBPerSec);
+    DownloadStats getStats() const;
     void close();
     bool drained() const { return _outstanding_SRD_requests == 0; }
 
@@ -1,7 +1,122 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "state_server_impl.h"
+#include <vespa/vespalib/data/slime/slime.h>
+#include <ctime>
 
 namespace filedistribution {
 
+namespace {
+
+class MetricSnapshot
+{
+private:
+    vespalib::Slime _data;
+    vespalib::slime::Cursor& _metrics;
+    vespalib::slime::Cursor& _values;
+    double _snapLen;
+
+public:
+    MetricSnapshot(uint32_t prevTime, uint32_t currTime);
+    void addCount(const char *name, const char *desc, uint64_t count);
+    void addGauge(const char *name, const char *desc, uint64_t value);
+
+    vespalib::string asString() const {
+        return _data.toString();
+    }
+};
+
+MetricSnapshot::MetricSnapshot(uint32_t prevTime, uint32_t currTime)
+    : _data(),
+      _metrics(_data.setObject()),
+      _values(_metrics.setArray("values")),
+      _snapLen(currTime - prevTime)
+{
+    vespalib::slime::Cursor& snapshot = _metrics.setObject("snapshot");
+    snapshot.setLong("from", prevTime);
+    snapshot.setLong("to",   currTime);
+    if (_snapLen < 1.0) {
+        _snapLen = 1.0;
+    }
+}
+
+void
+MetricSnapshot::addCount(const char *name, const char *desc, uint64_t count)
+{
+    using namespace vespalib::slime::convenience;
+    Cursor& value = _values.addObject();
+    value.setString("name", name);
+    value.setString("description", desc);
+    Cursor& inner = value.setObject("values");
+    inner.setLong("count", count);
+    inner.setDouble("rate", count / _snapLen);
+}
+
+void
+MetricSnapshot::addGauge(const char *name, const char *desc, uint64_t gauge)
+{
+    using namespace vespalib::slime::convenience;
+    Cursor& value = _values.addObject();
+    value.setString("name", name);
+    value.setString("description", desc);
+    Cursor& inner = value.setObject("values");
+    inner.setLong("last", gauge);
+}
+
+} // namespace <unnamed>
+
+vespalib::string
+makeDownloadMetricsSnapshot(const DownloadStats &prev, const DownloadStats &curr,
+                            uint32_t prevTime, uint32_t currTime)
+{
+    MetricSnapshot snapshot(prevTime, currTime);
+    snapshot.addCount("filedistribution.bytes.downloaded",
+                      "payload bytes downloaded from peers",
+                      curr.totalDownload - prev.totalDownload);
+    snapshot.addCount("filedistribution.bytes.uploaded",
+                      "payload bytes uploaded to peers",
+                      curr.totalUpload - prev.totalUpload);
+    snapshot.addCount("filedistribution.bytes.hashfailed",
+                      "bytes discarded because a piece failed its hash check",
+                      curr.totalFailedBytes - prev.totalFailedBytes);
+    snapshot.addCount("filedistribution.bytes.redundant",
+                      "bytes downloaded more than once",
+                      curr.totalRedundantBytes - prev.totalRedundantBytes);
+    snapshot.addGauge("filedistribution.peers",
+                      "number of connected peers",
+                      curr.numPeers);
+    snapshot.addGauge("filedistribution.files",
+                      "number of files known to the downloader",
+                      curr.numTorrents);
+    snapshot.addGauge("filedistribution.files.finished",
+                      "number of files completely downloaded",
+                      curr.numFinished);
+    return snapshot.asString();
+}
+
+StateServerImpl::StateServerImpl(int port)
+    : myHealth(),
+      myMetrics(),
+      myComponents(),
+      myStateServer(port, myHealth, myMetrics, myComponents),
+      _lock(),
+      _startStats(DownloadStats::zero()),
+      _lastStats(DownloadStats::zero()),
+      _startTime(time(NULL)),
+      _lastSnapshotTime(_startTime)
+{ }
+
+StateServerImpl::~StateServerImpl() { }
+
+void
+StateServerImpl::snapshot(const DownloadStats &current)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    uint32_t now = time(NULL);
+    myMetrics.setMetrics(makeDownloadMetricsSnapshot(_lastStats, current, _lastSnapshotTime, now));
+    myMetrics.setTotalMetrics(makeDownloadMetricsSnapshot(_startStats, current, _startTime, now));
+    _lastStats = current;
+    _lastSnapshotTime = now;
+}
+
 } // namespace filedistribution
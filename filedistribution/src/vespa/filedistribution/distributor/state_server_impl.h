@@ -6,16 +6,46 @@
 #include <vespa/vespalib/net/simple_metrics_producer.h>
 #include <vespa/vespalib/net/simple_health_producer.h>
 #include <vespa/vespalib/net/simple_component_config_producer.h>
+#include <mutex>
 
 namespace filedistribution {
 
+/**
+ * Cumulative transfer counters for the torrent session, sampled
+ * periodically to produce throughput metrics.
+ */
+struct DownloadStats {
+    uint64_t totalDownload;
+    uint64_t totalUpload;
+    uint64_t totalFailedBytes;     // bytes discarded by piece hash check
+    uint64_t totalRedundantBytes;
+    uint32_t numPeers;
+    uint32_t numTorrents;
+    uint32_t numFinished;
+
+    static DownloadStats zero() { return DownloadStats{0, 0, 0, 0, 0, 0, 0}; }
+};
+
+vespalib::string makeDownloadMetricsSnapshot(const DownloadStats &prev, const DownloadStats &curr,
+                                             uint32_t prevTime, uint32_t currTime);
+
 struct StateServerImpl {
     vespalib::SimpleHealthProducer myHealth;
     vespalib::SimpleMetricsProducer myMetrics;
     vespalib::SimpleComponentConfigProducer myComponents;
     vespalib::StateServer myStateServer;
 
-    StateServerImpl(int port) : myStateServer(port, myHealth, myMetrics, myComponents) {}
+    StateServerImpl(int port);
+    ~StateServerImpl();
+
+    void snapshot(const DownloadStats &current);
+
+private:
+    std::mutex _lock;
+    DownloadStats _startStats;
+    DownloadStats _lastStats;
+    uint32_t _startTime;
+    uint32_t _lastSnapshotTime;
 };
 
 } // namespace filedistribution
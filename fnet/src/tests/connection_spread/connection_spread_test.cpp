@@ -25,8 +25,10 @@ struct Fixture {
     FastOS_ThreadPool thread_pool;
     FNET_Transport client;
     FNET_Transport server;
-    Fixture() : streamer(), adapter(), thread_pool(128 * 1024), client(8), server(8)
+    Fixture(bool balance = false) : streamer(), adapter(), thread_pool(128 * 1024), client(8), server(8)
     {
+        client.SetBalanceConnections(balance);
+        server.SetBalanceConnections(balance);
         ASSERT_TRUE(client.Start(&thread_pool));
         ASSERT_TRUE(server.Start(&thread_pool));
     }
@@ -59,25 +61,35 @@ void check_threads(FNET_Transport &transport, size_t num_threads, const vespalib
     }
 }
 
-TEST_F("require that connections are spread among transport threads", Fixture)
+void require_connections_are_spread(Fixture &f)
 {
-    FNET_Connector *listener = f1.server.Listen("tcp/0", &f1.streamer, &f1.adapter);
+    FNET_Connector *listener = f.server.Listen("tcp/0", &f.streamer, &f.adapter);
     ASSERT_TRUE(listener);
     uint32_t port = listener->GetPortNumber();
     vespalib::string spec = vespalib::make_string("tcp/localhost:%u", port);
     std::vector<FNET_Connection *> connections;
     for (size_t i = 0; i < 256; ++i) {
         std::this_thread::sleep_for(1ms);
-        connections.push_back(f1.client.Connect(spec.c_str(), &f1.streamer));
+        connections.push_back(f.client.Connect(spec.c_str(), &f.streamer));
         ASSERT_TRUE(connections.back());
     }
-    f1.wait_for_components(256, 257);    
-    check_threads(f1.client, 8, "client");
-    check_threads(f1.server, 8, "server");
+    f.wait_for_components(256, 257);    
+    check_threads(f.client, 8, "client");
+    check_threads(f.server, 8, "server");
     listener->SubRef();
     for (FNET_Connection *conn: connections) {
         conn->SubRef();
     }
 }
 
+TEST_F("require that connections are spread among transport threads", Fixture)
+{
+    TEST_DO(require_connections_are_spread(f1));
+}
+
+TEST_F("require that balanced connections are spread among transport threads", Fixture(true))
+{
+    TEST_DO(require_connections_are_spread(f1));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -51,6 +51,28 @@ TEST("testResize") {
     EXPECT_TRUE(buf.GetDataLen() == 0);
 }
 
+TEST("require that large data is referenced when a ref sink is attached") {
+    char small[4] = { 'a', 'b', 'c', 'd' };
+    char large[16] = { 0 };
+    std::vector<FNET_DataRef> refs;
+    FNET_DataBuffer buf(64);
+    buf.WriteBytesRef(large, sizeof(large));
+    EXPECT_EQUAL(16u, buf.GetDataLen());
+    buf.SetRefSink(&refs, 8);
+    buf.WriteBytesRef(small, sizeof(small));
+    buf.WriteBytesRef(large, sizeof(large));
+    buf.WriteInt32(42);
+    EXPECT_EQUAL(24u, buf.GetDataLen());
+    ASSERT_EQUAL(1u, refs.size());
+    EXPECT_EQUAL(20u, refs[0].pos);
+    EXPECT_TRUE(refs[0].data == large);
+    EXPECT_EQUAL(16u, refs[0].len);
+    buf.SetRefSink(nullptr, 0);
+    buf.WriteBytesRef(large, sizeof(large));
+    EXPECT_EQUAL(40u, buf.GetDataLen());
+    EXPECT_EQUAL(1u, refs.size());
+}
+
 TEST("testSpeed") {
   FNET_DataBuffer buf0(20000);
   FNET_DataBuffer buf1(20000);
@@ -11,8 +11,14 @@ struct Rpc : FRT_Invokable {
     FastOS_ThreadPool thread_pool;
     FNET_Transport    transport;
     FRT_Supervisor    orb;
-    Rpc(size_t num_threads)
-        : thread_pool(128 * 1024), transport(num_threads), orb(&transport, &thread_pool) {}
+    Rpc(size_t num_threads, bool tuned)
+        : thread_pool(128 * 1024), transport(num_threads), orb(&transport, &thread_pool)
+    {
+        if (tuned) {
+            transport.SetBalanceConnections(true);
+            transport.SetWorkerEncodeThreshold(1);
+        }
+    }
     void start() {
         ASSERT_TRUE(transport.Start(&thread_pool));
     }
@@ -31,7 +37,7 @@ struct Rpc : FRT_Invokable {
 
 struct Server : Rpc {
     uint32_t port;
-    Server(size_t num_threads) : Rpc(num_threads), port(listen()) {
+    Server(size_t num_threads, bool tuned = false) : Rpc(num_threads, tuned), port(listen()) {
         init_rpc();
         start();
     }
@@ -51,7 +57,9 @@ struct Server : Rpc {
 
 struct Client : Rpc {
     uint32_t port;
-    Client(size_t num_threads, const Server &server) : Rpc(num_threads), port(server.port) {
+    Client(size_t num_threads, const Server &server, bool tuned = false)
+        : Rpc(num_threads, tuned), port(server.port)
+    {
         start();
     }
     FRT_Target *connect() { return Rpc::connect(port); }
@@ -126,4 +134,7 @@ TEST_MT_FFF("parallel rpc with 8/1 transport threads and 128 user threads",
 TEST_MT_FFF("parallel rpc with 8/8 transport threads and 128 user threads",
             128, Server(8), Client(8, f1), Result(num_threads)) { perform_test(thread_id, f2, f3); }
 
+TEST_MT_FFF("parallel rpc with 8/8 balanced transport threads, worker encoding and 128 user threads",
+            128, Server(8, true), Client(8, f1, true), Result(num_threads)) { perform_test(thread_id, f2, f3); }
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -169,9 +169,10 @@ TEST("testExplicitShared") {
     EXPECT_EQUAL(1, blob.refcnt);
 }
 
-TEST("testImplicitShared") {
+void testImplicitShared(uint32_t zeroCopyThreshold) {
     DataSet dataSet;
     FRT_Supervisor orb;
+    orb.GetTransport()->SetZeroCopyThreshold(zeroCopyThreshold);
     FRT_RPCRequest *req = orb.AllocRPCRequest();
     ServerSampler serverSampler(dataSet, req);
     {
@@ -258,4 +259,12 @@ TEST("testImplicitShared") {
     orb.ShutDown(true);
 }
 
+TEST("testImplicitShared") {
+    TEST_DO(testImplicitShared(0));
+}
+
+TEST("testImplicitSharedWithZeroCopy") {
+    TEST_DO(testImplicitShared(Data::SMALL + 1));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
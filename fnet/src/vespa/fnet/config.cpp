@@ -8,6 +8,8 @@ FNET_Config::FNET_Config()
       _iocTimeOut(0),
       _maxInputBufferSize(0x10000),
       _maxOutputBufferSize(0x10000),
+      _workerEncodeThreshold(0),
+      _zeroCopyThreshold(0),
       _tcpNoDelay(true),
       _logStats(false),
       _directWrite(true)
@@ -16,6 +16,8 @@ public:
     uint32_t  _iocTimeOut;
     uint32_t  _maxInputBufferSize;
     uint32_t  _maxOutputBufferSize;
+    uint32_t  _workerEncodeThreshold;
+    uint32_t  _zeroCopyThreshold;
     bool      _tcpNoDelay;
     bool      _logStats;
     bool      _directWrite;
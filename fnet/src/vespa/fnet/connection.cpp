@@ -9,6 +9,7 @@
 #include "config.h"
 #include "transport_thread.h"
 #include "transport.h"
+#include <algorithm>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".fnet");
@@ -51,6 +52,32 @@ SyncPacket::Free()
         _cond.notify_one();
     }
 }
+
+
+/**
+ * A packet holding the complete byte stream representation of
+ * another packet, as produced by the packet streamer. Used to move
+ * the encoding of large packets out of the transport thread.
+ **/
+class EncodedPacket : public FNET_Packet {
+private:
+    FNET_DataBuffer _buf;
+
+public:
+    EncodedPacket(FNET_IPacketStreamer &streamer, FNET_Packet &packet,
+                  uint32_t chid, uint32_t len)
+        : _buf(len)
+    {
+        streamer.Encode(&packet, chid, &_buf);
+    }
+    bool IsEncodedPacket() override { return true; }
+    uint32_t GetPCODE() override { return FNET_NOID; }
+    uint32_t GetLength() override { return _buf.GetDataLen(); }
+    void Encode(FNET_DataBuffer *dst) override {
+        dst->WriteBytes(_buf.GetData(), _buf.GetDataLen());
+    }
+    bool Decode(FNET_DataBuffer *, uint32_t) override { return false; }
+};
 }
 
 
@@ -307,38 +334,47 @@ FNET_Connection::Write(bool direct)
     FNET_Packet     *packet;
     FNET_Context     context;
 
+    uint32_t zeroCopyThreshold = GetConfig()->_zeroCopyThreshold;
+    _output.SetRefSink((zeroCopyThreshold > 0) ? &_newRefs : nullptr, zeroCopyThreshold);
     do {
 
         // fill output buffer
 
-        while (_output.GetDataLen() < FNET_WRITE_SIZE) {
+        while (_output.GetDataLen() + _outputRefLen < FNET_WRITE_SIZE) {
             if (_myQueue.IsEmpty_NoLock())
                 break;
 
             packet = _myQueue.DequeuePacket_NoLock(&context);
             if (packet->IsRegularPacket()) { // ignore non-regular packets
-                _streamer->Encode(packet, context._value.INT, &_output);
+                if (packet->IsEncodedPacket()) {
+                    packet->Encode(&_output);
+                } else {
+                    _streamer->Encode(packet, context._value.INT, &_output);
+                }
                 writtenPackets++;
             }
-            packet->Free();
+            if (_newRefs.empty()) {
+                packet->Free();
+            } else {
+                HoldOutputRefs(packet);
+            }
         }
 
-        if (_output.GetDataLen() == 0) {
+        if (_output.GetDataLen() == 0 && _outputRefs.empty()) {
             res = 0;
             break;
         }
 
         // write data
 
-        res = _socket.write(_output.GetData(), _output.GetDataLen());
+        res = WriteOutput();
         writeCnt++;
         if (res > 0) {
-            _output.DataToDead((uint32_t)res);
             writtenData += (uint32_t)res;
-            _output.resetIfEmpty();
         }
     } while (res > 0 &&
              _output.GetDataLen() == 0 &&
+             _outputRefs.empty() &&
              !_myQueue.IsEmpty_NoLock() &&
              writeCnt < FNET_WRITE_REDO);
 
@@ -359,7 +395,7 @@ FNET_Connection::Write(bool direct)
     std::unique_lock<std::mutex> guard(_ioc_lock);
     _writeWork = _queue.GetPacketCnt_NoLock()
                  + _myQueue.GetPacketCnt_NoLock()
-                 + ((_output.GetDataLen() > 0) ? 1 : 0);
+                 + ((_output.GetDataLen() > 0 || !_outputRefs.empty()) ? 1 : 0);
     _flags._writeLock = false;
     if (_flags._discarding) {
         _ioc_cond.notify_all();
@@ -393,6 +429,102 @@ FNET_Connection::Write(bool direct)
     return !broken;
 }
 
+
+void
+FNET_Connection::HoldOutputRefs(FNET_Packet *packet)
+{
+    for (const FNET_DataRef &ref: _newRefs) {
+        _outputRefs.push_back(OutputRef{_outputPos + ref.pos, ref.data, ref.len, nullptr});
+        _outputRefLen += ref.len;
+    }
+    _outputRefs.back().packet = packet;
+    _newRefs.clear();
+}
+
+
+ssize_t
+FNET_Connection::WriteOutput()
+{
+    if (_outputRefs.empty()) {
+        ssize_t res = _socket.write(_output.GetData(), _output.GetDataLen());
+        if (res > 0) {
+            _output.DataToDead((uint32_t)res);
+            _outputPos += res;
+            _output.resetIfEmpty();
+        }
+        return res;
+    }
+
+    // gather output buffer segments and referenced data in stream order
+    struct iovec iov[FNET_WRITE_IOV];
+    int          iovCnt = 0;
+    uint32_t     done   = 0; // output buffer bytes gathered
+    bool         all    = true;
+    for (const OutputRef &ref: _outputRefs) {
+        uint32_t pos = ref.pos - _outputPos;
+        if (pos > done) {
+            if (iovCnt == FNET_WRITE_IOV) {
+                all = false;
+                break;
+            }
+            iov[iovCnt++] = { _output.GetData() + done, pos - done };
+            done = pos;
+        }
+        if (iovCnt == FNET_WRITE_IOV) {
+            all = false;
+            break;
+        }
+        iov[iovCnt++] = { const_cast<char *>(ref.data), ref.len };
+    }
+    if (all && done < _output.GetDataLen() && iovCnt < FNET_WRITE_IOV) {
+        iov[iovCnt++] = { _output.GetData() + done, _output.GetDataLen() - done };
+    }
+    ssize_t res = _socket.writev(iov, iovCnt);
+
+    // discard written data
+    size_t left = (res > 0) ? res : 0;
+    while (left > 0) {
+        uint32_t bufLen = _outputRefs.empty()
+                          ? _output.GetDataLen()
+                          : uint32_t(_outputRefs.front().pos - _outputPos);
+        if (bufLen > 0) {
+            uint32_t n = std::min(size_t(bufLen), left);
+            _output.DataToDead(n);
+            _outputPos += n;
+            left -= n;
+        } else {
+            OutputRef &ref = _outputRefs.front();
+            uint32_t n = std::min(size_t(ref.len), left);
+            ref.data += n;
+            ref.len -= n;
+            _outputRefLen -= n;
+            left -= n;
+            if (ref.len == 0) {
+                if (ref.packet != nullptr) {
+                    ref.packet->Free();
+                }
+                _outputRefs.pop_front();
+            }
+        }
+    }
+    _output.resetIfEmpty();
+    return res;
+}
+
+
+void
+FNET_Connection::DiscardOutputRefs()
+{
+    while (!_outputRefs.empty()) {
+        FNET_Packet *packet = _outputRefs.front().packet;
+        _outputRefs.pop_front();
+        if (packet != nullptr) {
+            packet->Free();
+        }
+    }
+    _outputRefLen = 0;
+}
+
 ////////////////////
 // PUBLIC METHODS //
 ////////////////////
@@ -421,6 +553,10 @@ FNET_Connection::FNET_Connection(FNET_TransportThread *owner,
       _queue(256),
       _myQueue(256),
       _output(FNET_WRITE_SIZE * 2),
+      _newRefs(),
+      _outputRefs(),
+      _outputPos(0),
+      _outputRefLen(0),
       _channels(),
       _callbackTarget(nullptr),
       _cleanup(nullptr)
@@ -456,6 +592,10 @@ FNET_Connection::FNET_Connection(FNET_TransportThread *owner,
       _queue(256),
       _myQueue(256),
       _output(FNET_WRITE_SIZE * 2),
+      _newRefs(),
+      _outputRefs(),
+      _outputPos(0),
+      _outputRefLen(0),
       _channels(),
       _callbackTarget(nullptr),
       _cleanup(nullptr)
@@ -476,6 +616,7 @@ FNET_Connection::~FNET_Connection()
     }
     assert(_cleanup == nullptr);
     assert(!_flags._writeLock);
+    DiscardOutputRefs();
 }
 
 
@@ -618,6 +759,15 @@ FNET_Connection::PostPacket(FNET_Packet *packet, uint32_t chid)
     uint32_t writeWork;
 
     assert(packet != nullptr);
+    uint32_t encodeThreshold = GetConfig()->_workerEncodeThreshold;
+    if (encodeThreshold > 0 && packet->IsRegularPacket()) {
+        uint32_t len = packet->GetLength();
+        if (len >= encodeThreshold) {
+            FNET_Packet *encoded = new EncodedPacket(*_streamer, *packet, chid, len);
+            packet->Free();
+            packet = encoded;
+        }
+    }
     std::unique_lock<std::mutex> guard(_ioc_lock);
     if (_state >= FNET_CLOSING) {
         if (_flags._discarding) {
@@ -682,6 +832,7 @@ FNET_Connection::Close()
     _resolve_handler.reset();
     detach_selector();
     SetState(FNET_CLOSED);
+    DiscardOutputRefs();
     _ioc_socket_fd = -1;
     _socket.reset();
 }
@@ -9,6 +9,7 @@
 #include "packetqueue.h"
 #include <vespa/vespalib/net/socket_handle.h>
 #include <vespa/vespalib/net/async_resolver.h>
+#include <deque>
 
 class FNET_IPacketStreamer;
 class FNET_IServerAdapter;
@@ -60,7 +61,8 @@ public:
         FNET_READ_SIZE  = 8192,
         FNET_READ_REDO  = 10,
         FNET_WRITE_SIZE = 8192,
-        FNET_WRITE_REDO = 10
+        FNET_WRITE_REDO = 10,
+        FNET_WRITE_IOV  = 64
     };
 
 private:
@@ -86,6 +88,12 @@ private:
         ~ResolveHandler();
     };
     using ResolveHandlerSP = std::shared_ptr<ResolveHandler>;
+    struct OutputRef {
+        uint64_t     pos;    // output stream offset of referenced data
+        const char  *data;   // referenced data
+        uint32_t     len;    // referenced data length
+        FNET_Packet *packet; // packet to free when data is written
+    };
     FNET_IPacketStreamer    *_streamer;        // custom packet streamer
     FNET_IServerAdapter     *_serverAdapter;   // only on server side
     FNET_Channel            *_adminChannel;    // only on client side
@@ -103,6 +111,10 @@ private:
     FNET_PacketQueue_NoLock  _queue;           // outer output queue
     FNET_PacketQueue_NoLock  _myQueue;         // inner output queue
     FNET_DataBuffer          _output;          // output buffer
+    std::vector<FNET_DataRef> _newRefs;        // refs made by last encode
+    std::deque<OutputRef>    _outputRefs;      // refs following _output
+    uint64_t                 _outputPos;       // stream offset of _output
+    uint32_t                 _outputRefLen;    // bytes in _outputRefs
     FNET_ChannelLookup       _channels;        // channel 'DB'
     FNET_Channel            *_callbackTarget;  // target of current callback
 
@@ -215,6 +227,30 @@ private:
      **/
     bool Write(bool direct);
 
+    /**
+     * Take ownership of the references made while encoding the given
+     * packet into the output buffer. The packet is freed when the last
+     * of its referenced data has been written.
+     *
+     * @param packet the packet that was just encoded.
+     **/
+    void HoldOutputRefs(FNET_Packet *packet);
+
+    /**
+     * Write as much as possible of the pending output (the output
+     * buffer interleaved with referenced packet data) to the socket
+     * and discard what was written.
+     *
+     * @return result of the socket write.
+     **/
+    ssize_t WriteOutput();
+
+    /**
+     * Drop all referenced packet data that has not been written,
+     * freeing the packets holding it.
+     **/
+    void DiscardOutputRefs();
+
     bool writePendingAfterConnect();
 public:
 
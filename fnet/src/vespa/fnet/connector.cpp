@@ -46,7 +46,7 @@ FNET_Connector::HandleReadEvent()
     SocketHandle handle = _server_socket.accept();
     if (handle.valid()) {
         FNET_Transport &transport = Owner()->owner();
-        FNET_TransportThread *thread = transport.select_thread(&handle, sizeof(handle));
+        FNET_TransportThread *thread = transport.select_connection_thread(&handle, sizeof(handle));
         if (thread->tune(handle)) {
             std::unique_ptr<FNET_Connection> conn = std::make_unique<FNET_Connection>(thread, _streamer, _serverAdapter, std::move(handle), GetSpec());
             if (conn->Init()) {
@@ -6,7 +6,9 @@ FNET_DataBuffer::FNET_DataBuffer(uint32_t len)
     : _bufstart(nullptr),
       _bufend(nullptr),
       _datapt(nullptr),
-      _freept(nullptr)
+      _freept(nullptr),
+      _refs(nullptr),
+      _minRefLen(0)
 {
     if (len > 0 && len < 256)
         len = 256;
@@ -28,7 +30,9 @@ FNET_DataBuffer::FNET_DataBuffer(char *buf, uint32_t len)
     : _bufstart(buf),
       _bufend(buf + len),
       _datapt(_bufstart),
-      _freept(_bufstart)
+      _freept(_bufstart),
+      _refs(nullptr),
+      _minRefLen(0)
 {
 }
 
@@ -95,7 +99,6 @@ FNET_DataBuffer::Pack(uint32_t needbytes)
             bufsize *= 2;
 
         Alloc newBuf(Alloc::alloc(bufsize));
-        memset(newBuf.get(), 0x55, bufsize);
         memcpy(newBuf.get(), _datapt, GetDataLen());
         _ownedBuf.swap(newBuf);
         _bufstart = static_cast<char *>(_ownedBuf.get());
@@ -6,6 +6,20 @@
 #include <vespa/vespalib/util/alloc.h>
 #include <cassert>
 #include <cstring>
+#include <vector>
+
+/**
+ * A reference to memory outside a databuffer that logically belongs
+ * to the data stored in it. The position is the length of the data
+ * part of the buffer when the reference was made; the referenced
+ * bytes follow the bytes stored in the buffer up to that point.
+ **/
+struct FNET_DataRef
+{
+    uint32_t    pos;
+    const char *data;
+    uint32_t    len;
+};
 
 /**
  * This is a buffer that may hold the stream representation of
@@ -37,6 +51,8 @@ private:
     char  *_datapt;
     char  *_freept;
     Alloc  _ownedBuf;
+    std::vector<FNET_DataRef> *_refs;
+    uint32_t                   _minRefLen;
 
     FNET_DataBuffer(const FNET_DataBuffer &);
     FNET_DataBuffer &operator=(const FNET_DataBuffer &);
@@ -592,6 +608,43 @@ public:
         _freept += len;
     }
 
+    /**
+     * Write bytes to this buffer, or refer to them without copying if
+     * a reference sink is attached (see @ref SetRefSink) and there are
+     * at least as many bytes as the sink threshold. The caller must
+     * make sure referenced memory stays valid until the owner of the
+     * sink is done with it; packets writing by reference keep the
+     * memory alive until they are freed.
+     *
+     * @param src source byte buffer.
+     * @param len number of bytes to write.
+     **/
+    void WriteBytesRef(const void *src, uint32_t len)
+    {
+        if (_refs != nullptr && len >= _minRefLen) {
+            _refs->push_back(FNET_DataRef{GetDataLen(), static_cast<const char *>(src), len});
+        } else {
+            WriteBytes(src, len);
+        }
+    }
+
+    /**
+     * Attach a reference sink to this buffer. Subsequent calls to
+     * @ref WriteBytesRef writing at least minLen bytes will append a
+     * reference to the sink instead of copying the bytes. Pass
+     * nullptr to detach the sink. Only the owner of the buffer should
+     * do this, since it needs to interleave the referenced memory with
+     * the buffer content when consuming it.
+     *
+     * @param refs where to store references, or nullptr.
+     * @param minLen smallest number of bytes to refer to.
+     **/
+    void SetRefSink(std::vector<FNET_DataRef> *refs, uint32_t minLen)
+    {
+        _refs = refs;
+        _minRefLen = minLen;
+    }
+
     /**
      * Write bytes to this buffer. Skip checking for free space.
      *
@@ -1340,8 +1340,8 @@ FRT_Values::EncodeCopy(FNET_DataBuffer *dst)
 
         case FRT_VALUE_DATA:
             dst->WriteBytesFast(&(_values[i]._data._len), sizeof(uint32_t));
-            dst->WriteBytesFast(_values[i]._data._buf,
-                                _values[i]._data._len);
+            dst->WriteBytesRef(_values[i]._data._buf,
+                               _values[i]._data._len);
             break;
 
         case FRT_VALUE_DATA_ARRAY:
@@ -1352,7 +1352,7 @@ FRT_Values::EncodeCopy(FNET_DataBuffer *dst)
             dst->WriteBytesFast(&len, sizeof(len));
             for (; len > 0; len--, pt++) {
                 dst->WriteBytesFast(&(pt->_len), sizeof(uint32_t));
-                dst->WriteBytesFast(pt->_buf, pt->_len);
+                dst->WriteBytesRef(pt->_buf, pt->_len);
             }
         }
         break;
@@ -1487,8 +1487,8 @@ FRT_Values::EncodeBig(FNET_DataBuffer *dst)
 
         case FRT_VALUE_DATA:
             dst->WriteInt32Fast(_values[i]._data._len);
-            dst->WriteBytesFast(_values[i]._data._buf,
-                                _values[i]._data._len);
+            dst->WriteBytesRef(_values[i]._data._buf,
+                               _values[i]._data._len);
             break;
 
         case FRT_VALUE_DATA_ARRAY:
@@ -1499,7 +1499,7 @@ FRT_Values::EncodeBig(FNET_DataBuffer *dst)
             dst->WriteInt32Fast(len);
             for (; len > 0; len--, pt++) {
                 dst->WriteInt32Fast(pt->_len);
-                dst->WriteBytesFast(pt->_buf, pt->_len);
+                dst->WriteBytesRef(pt->_buf, pt->_len);
             }
         }
         break;
@@ -58,6 +58,19 @@ public:
     virtual bool IsControlPacket() { return false; }
 
 
+    /**
+     * Check if this packet already holds its complete byte stream
+     * representation, including the packet header normally written by
+     * the packet streamer. Such packets are created by the connection
+     * when large packets are encoded outside the transport thread, and
+     * are written to the network as-is. Regular packet
+     * implementations do not need to override this method.
+     *
+     * @return whether this packet is already encoded (false)
+     **/
+    virtual bool IsEncodedPacket() { return false; }
+
+
     /**
      * Method used to extract the command associated with this
      * packet. Packets that let the @ref IsControlPacket method return
@@ -24,7 +24,8 @@ struct HashState {
 
 FNET_Transport::FNET_Transport(vespalib::AsyncResolver::SP resolver, size_t num_threads)
     : _async_resolver(std::move(resolver)),
-      _threads()
+      _threads(),
+      _balance_connections(false)
 {
     assert(num_threads >= 1);
     for (size_t i = 0; i < num_threads; ++i) {
@@ -53,6 +54,29 @@ FNET_Transport::select_thread(const void *key, size_t key_len) const
     return _threads[thread_id].get();
 }
 
+FNET_TransportThread *
+FNET_Transport::select_connection_thread(const void *key, size_t key_len) const
+{
+    if (!_balance_connections || (_threads.size() == 1)) {
+        return select_thread(key, key_len);
+    }
+    HashState hash_state(key, key_len);
+    uint64_t hash_value = XXH64(&hash_state, sizeof(hash_state), 0);
+    size_t first = (hash_value % _threads.size());
+    size_t second = ((hash_value >> 32) % (_threads.size() - 1));
+    if (second >= first) {
+        ++second;
+    }
+    FNET_TransportThread *a = _threads[first].get();
+    FNET_TransportThread *b = _threads[second].get();
+    uint32_t load_a = a->get_load();
+    uint32_t load_b = b->get_load();
+    if (load_a != load_b) {
+        return (load_a < load_b) ? a : b;
+    }
+    return (a->GetNumIOComponents() <= b->GetNumIOComponents()) ? a : b;
+}
+
 FNET_Connector *
 FNET_Transport::Listen(const char *spec, FNET_IPacketStreamer *streamer,
                        FNET_IServerAdapter *serverAdapter)
@@ -67,7 +91,7 @@ FNET_Transport::Connect(const char *spec, FNET_IPacketStreamer *streamer,
                         FNET_IServerAdapter *serverAdapter,
                         FNET_Context connContext)
 {
-    return select_thread(spec, strlen(spec))->Connect(spec, streamer, adminHandler, adminContext, serverAdapter, connContext);
+    return select_connection_thread(spec, strlen(spec))->Connect(spec, streamer, adminHandler, adminContext, serverAdapter, connContext);
 }
 
 uint32_t
@@ -104,6 +128,22 @@ FNET_Transport::SetMaxOutputBufferSize(uint32_t bytes)
     }
 }
 
+void
+FNET_Transport::SetWorkerEncodeThreshold(uint32_t bytes)
+{
+    for (const auto &thread: _threads) {
+        thread->SetWorkerEncodeThreshold(bytes);
+    }
+}
+
+void
+FNET_Transport::SetZeroCopyThreshold(uint32_t bytes)
+{
+    for (const auto &thread: _threads) {
+        thread->SetZeroCopyThreshold(bytes);
+    }
+}
+
 void
 FNET_Transport::SetDirectWrite(bool directWrite)
 {
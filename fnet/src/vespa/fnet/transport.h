@@ -29,6 +29,7 @@ private:
 
     vespalib::AsyncResolver::SP _async_resolver;
     Threads _threads;
+    bool _balance_connections;
 
 public:
     /**
@@ -65,6 +66,18 @@ public:
      **/
     FNET_TransportThread *select_thread(const void *key, size_t key_len) const;
 
+    /**
+     * Select the transport thread that should handle a new
+     * connection. If connection balancing is enabled, two candidate
+     * threads are picked the same way as by select_thread and the
+     * one with the lowest recent load is selected (ties are broken
+     * by the number of IO components). Otherwise, this is the same
+     * as select_thread.
+     *
+     * @return selected transport thread
+     **/
+    FNET_TransportThread *select_connection_thread(const void *key, size_t key_len) const;
+
     /**
      * Add a network listener in an abstract way. The given 'spec'
      * string has the following format: 'type/where'. 'type' specifies
@@ -164,6 +177,41 @@ public:
      **/
     void SetMaxOutputBufferSize(uint32_t bytes);
 
+    /**
+     * Set the size threshold for encoding outgoing packets in the
+     * thread posting them instead of in the transport thread. This
+     * moves the encoding cost of large packets (typically big RPC
+     * replies) away from the transport threads. The packet streamers
+     * used with this transport must support concurrent calls to
+     * Encode when this is enabled. This feature is disabled by
+     * default.
+     *
+     * @param bytes packet size threshold. 0 means disabled.
+     **/
+    void SetWorkerEncodeThreshold(uint32_t bytes);
+
+    /**
+     * Set the size threshold for writing packet data to the network
+     * directly from packet memory instead of copying it into the
+     * output buffer of the connection. Only data written by packets
+     * using FNET_DataBuffer::WriteBytesRef (like large FRT data
+     * values) is affected. Packets referring to their own memory are
+     * kept alive until their data is written. This feature is
+     * disabled by default.
+     *
+     * @param bytes data size threshold. 0 means disabled.
+     **/
+    void SetZeroCopyThreshold(uint32_t bytes);
+
+    /**
+     * Enable or disable load based selection of transport threads for
+     * new connections (both incoming and outgoing). See
+     * select_connection_thread. This feature is disabled by default.
+     *
+     * @param balance true if new connections should be balanced.
+     **/
+    void SetBalanceConnections(bool balance) { _balance_connections = balance; }
+
     /**
      * Enable or disable the direct write optimization. This is
      * enabled by default and favors low latency above throughput.
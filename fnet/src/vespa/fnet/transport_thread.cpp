@@ -175,6 +175,9 @@ FNET_TransportThread::UpdateStats()
     {
         std::lock_guard<std::mutex> guard(_lock);
         _stats.Update(&_counters, ms / 1000.0);
+        _load.store(uint32_t(_stats._packetReadRate + _stats._packetWriteRate +
+                             _stats._dataReadRate + _stats._dataWriteRate),
+                    std::memory_order_relaxed);
     }
     _counters.Clear();
 
@@ -218,6 +221,7 @@ FNET_TransportThread::FNET_TransportThread(FNET_Transport &owner_in)
       _timeOutHead(nullptr),
       _componentsTail(nullptr),
       _componentCnt(0),
+      _load(0),
       _deleteList(nullptr),
       _selector(),
       _queue(),
@@ -13,6 +13,7 @@
 #include <vespa/vespalib/net/selector.h>
 #include <mutex>
 #include <condition_variable>
+#include <atomic>
 
 class FNET_Transport;
 class FNET_ControlPacket;
@@ -61,6 +62,7 @@ private:
     FNET_IOComponent        *_timeOutHead;    // first IOC in list to time out
     FNET_IOComponent        *_componentsTail; // I/O component list tail
     uint32_t                 _componentCnt;   // # of components
+    std::atomic<uint32_t>    _load;           // recent work rate
     FNET_IOComponent        *_deleteList;     // IOC delete list
     Selector                 _selector;       // I/O event generator
     FNET_PacketQueue_NoLock  _queue;          // outer event queue
@@ -301,6 +303,19 @@ public:
     uint32_t GetNumIOComponents() { return _componentCnt; }
 
 
+    /**
+     * Obtain an estimate of how busy this transport thread has been
+     * lately. The estimate is the sum of the packet rates (packets/s)
+     * and data rates (kB/s) in both directions, as calculated by the
+     * last statistics update. It is used to select the least loaded
+     * transport thread for new connections and may be read from any
+     * thread.
+     *
+     * @return recent load of this transport thread.
+     **/
+    uint32_t get_load() const { return _load.load(std::memory_order_relaxed); }
+
+
     /**
      * Set the I/O Component timeout. Idle I/O Components with timeout
      * enabled (determined by calling the ShouldTimeOut method) will
@@ -346,6 +361,34 @@ public:
     { _config._maxOutputBufferSize = bytes; }
 
 
+    /**
+     * Set the size threshold for encoding outgoing packets in the
+     * thread posting them. Packets at least this large are encoded
+     * into a separate buffer before they are queued on the
+     * connection, leaving only a memory copy for the transport
+     * thread. The packet streamer must support concurrent calls to
+     * Encode for this to be safe.
+     *
+     * @param bytes packet size threshold. 0 means disabled.
+     **/
+    void SetWorkerEncodeThreshold(uint32_t bytes)
+    { _config._workerEncodeThreshold = bytes; }
+
+
+    /**
+     * Set the size threshold for writing packet data to the network
+     * directly from packet memory. Packets encoding data with
+     * FNET_DataBuffer::WriteBytesRef will have byte ranges at least
+     * this large referenced from the output of the connection instead
+     * of copied into it; the connection flushes its output with
+     * writev and frees such packets when their data is written.
+     *
+     * @param bytes data size threshold. 0 means disabled.
+     **/
+    void SetZeroCopyThreshold(uint32_t bytes)
+    { _config._zeroCopyThreshold = bytes; }
+
+
     /**
      * Enable or disable the direct write optimization. This is
      * enabled by default and favors low latency above throughput.
@@ -26,4 +26,5 @@ $SOURCE_DIRECTORY/vectorizer_test.sh
 
 # perf tests
 ./fsa_vectorizer_perf_test_app
+./fsa_segmenter_perf_test_app
 ./fsa_fsa_perf_test_app
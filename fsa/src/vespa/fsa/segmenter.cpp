@@ -19,12 +19,16 @@ namespace fsa {
 
 Segmenter::Segments::Segments()
   : _text(), _segments(), _map(),
-    _segmentation(Segmenter::SEGMENTATION_METHODS,NULL)
+    _segmentation(Segmenter::SEGMENTATION_METHODS,NULL),
+    _built(Segmenter::SEGMENTATION_METHODS,false),
+    _nextid(), _maxScore()
 { }
 
 Segmenter::Segments::~Segments()
 {
-  clear();
+  for(unsigned int i=0;i<SEGMENTATION_METHODS;i++){
+    delete _segmentation[i];
+  }
 }
 
 void
@@ -33,9 +37,10 @@ Segmenter::Segments::clear()
   _segments.clear();
   _map.init(_text.size());
   initSingles();
+  // Keep the segmentation objects around so that a Segments object
+  // reused across calls does not reallocate them for every text.
   for(unsigned int i=0;i<SEGMENTATION_METHODS;i++){
-    delete _segmentation[i];
-    _segmentation[i] = nullptr;
+    _built[i] = false;
   }
 }
 
@@ -63,8 +68,12 @@ void Segmenter::Segments::buildSegmentation(Segmenter::SegmentationMethod method
   int pos, next=n_txt;
   unsigned int maxsc,conn;
   int bestval,temp=0,bias;
-  std::vector<int> nextid(n_sgm,-1);
-  std::vector<unsigned int> maxScore(n_sgm,0);
+  std::vector<int> &nextid = _nextid;
+  std::vector<unsigned int> &maxScore = _maxScore;
+
+  nextid.assign(n_sgm,-1);
+  maxScore.assign(n_sgm,0);
+  _built[method] = true;
 
   if(_segmentation[method]==NULL){
     _segmentation[method] = new Segmenter::Segmentation;
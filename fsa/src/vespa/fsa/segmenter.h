@@ -325,6 +325,9 @@ public:
     std::vector<Segment>           _segments;         /**< Detected segments.           */
     SegmentMap                     _map;              /**< Map of segments.             */
     std::vector<Segmentation*>     _segmentation;     /**< Pre-built segmentations.     */
+    std::vector<bool>              _built;            /**< Valid segmentations.         */
+    std::vector<int>               _nextid;           /**< Scratch space, reused.       */
+    std::vector<unsigned int>      _maxScore;         /**< Scratch space, reused.       */
 
 
     /**
@@ -529,7 +532,7 @@ public:
     {
       if(method<SEGMENTATION_WEIGHTED || method>=SEGMENTATION_METHODS)
         method=SEGMENTATION_WEIGHTED;
-      if(_segmentation[method]==NULL){
+      if(!_built[method]){
         buildSegmentation(method);
       }
       return _segmentation[method];
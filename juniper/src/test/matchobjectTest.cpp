@@ -316,6 +316,33 @@ void MatchObjectTest::testParams()
 }
 
 
+/**
+ * Test that the special token registry is owned by the match object,
+ * and shared by all results for the same query.
+ */
+void MatchObjectTest::testSpecialTokens() {
+    {
+        TestQuery q("AND(a,b)");
+        _test(q._qhandle.MatchObj(0)->SpecialTokens() == NULL);
+    }
+    {
+        QueryNode* query = new QueryNode(2, 0, 0);
+        QueryTerm* special = new QueryTerm("c++", 3, 0);
+        special->_options |= X_SPECIALTOKEN;
+        query->AddChild(special);
+        query->AddChild(new QueryTerm("word", 4, 0));
+        MatchObject mo(query, false);
+        const juniper::SpecialTokenRegistry* registry = mo.SpecialTokens();
+        _test(registry != NULL);
+        if (registry != NULL) {
+            _test(registry->getSpecialTokens().size() == 1u);
+            _test(registry->getSpecialTokens()[0] == special);
+        }
+        _test(mo.SpecialTokens() == registry);
+    }
+}
+
+
 /*************************************************************************
  *                      Test administration methods
  *************************************************************************/
@@ -353,6 +380,8 @@ void MatchObjectTest::init() {
         &MatchObjectTest::testCombined;
     test_methods_["testParams"] =
         &MatchObjectTest::testParams;
+    test_methods_["testSpecialTokens"] =
+        &MatchObjectTest::testSpecialTokens;
 }
 
 /*************************************************************************
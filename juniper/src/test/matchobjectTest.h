@@ -56,6 +56,10 @@ class MatchObjectTest : public Test {
      */
     void testParams();
 
+    /** Test that special tokens are found once per match object
+     */
+    void testSpecialTokens();
+
 
     /*************************************************************************
      *                      Test administration methods
@@ -85,15 +85,12 @@ Result::Result(Config* config, QueryHandle* qhandle,
     _matcher.reset(new Matcher(this));
     _matcher->SetProximityFactor(mp.ProximityFactor());
 
-    _registry.reset(new SpecialTokenRegistry(_matcher->getQuery()));
-
     if (qhandle->_log_mask)
         _matcher->set_log(qhandle->_log_mask);
 
     _tokenizer->SetSuccessor(_matcher.get());
-    if (!_registry->getSpecialTokens().empty()) {
-        _tokenizer->setRegistry(_registry.get());
-    }
+    // The special tokens are found once per query, not once per document
+    _tokenizer->setRegistry(_mo->SpecialTokens());
 }
 
 Result::~Result()
@@ -16,13 +16,41 @@ Forwarder::Forwarder(Metrics &metrics)
       _metrics(metrics),
       _forwardMap(),
       _levelparser(),
+      _pending(),
       knownServices(),
       _badLines(0)
 {}
 Forwarder::~Forwarder() {}
 
+namespace {
+
+// flush batched lines when this much is pending
+constexpr size_t flushLimit = 64 * 1024;
+
+}
+
 void
 Forwarder::forwardText(const char *text, int len)
+{
+    flush();
+    writeText(text, len);
+}
+
+void
+Forwarder::flush()
+{
+    if ( ! _pending.empty()) {
+        // nothing stays pending if the write fails
+        std::string pending;
+        pending.swap(_pending);
+        writeText(pending.data(), pending.size());
+        pending.clear();
+        _pending.swap(pending);
+    }
+}
+
+void
+Forwarder::writeText(const char *text, int len)
 {
     int wsize = write(_logserverfd, text, len);
 
@@ -61,7 +89,10 @@ Forwarder::forwardLine(const char *line, const char *eol)
     assert (line[linelen - 1] == '\n');
 
     if (parseline(line, eol)) {
-        forwardText(line, linelen);
+        _pending.append(line, linelen);
+        if (_pending.size() >= flushLimit) {
+            flush();
+        }
     }
 }
 
@@ -4,6 +4,7 @@
 #include "metrics.h"
 #include <vespa/vespalib/util/hashmap.h>
 #include <map>
+#include <string>
 
 namespace logdemon {
 
@@ -27,6 +28,7 @@ private:
     Metrics &_metrics;
     ForwardMap _forwardMap;
     LevelParser _levelparser;
+    std::string _pending;
     const char *copystr(const char *b, const char *e) {
         int len = e - b;
         char *ret = new char[len+1];
@@ -35,15 +37,18 @@ private:
         return ret;
     }
     bool parseline(const char *linestart, const char *lineend);
+    void writeText(const char *text, int len);
 public:
     Services knownServices;
     int _badLines;
     Forwarder(Metrics &metrics);
     ~Forwarder();
     void forwardText(const char *text, int len);
+    // lines are batched, call flush() to send them to the logserver
     void forwardLine(const char *line, const char *eol);
+    void flush();
     void setForwardMap(const ForwardMap & forwardMap) { _forwardMap = forwardMap; }
-    void setLogserverFD(int fd) { _logserverfd = fd; }
+    void setLogserverFD(int fd) { _logserverfd = fd; _pending.clear(); }
     int  getLogserverFD() { return _logserverfd; }
     void sendMode();
 };
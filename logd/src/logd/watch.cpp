@@ -265,6 +265,7 @@ Watcher::watchfile()
                     l = nnl;
                     nnl = strchr(l, '\n');
                 }
+                _forwarder.flush();
             } else {
                 LOG(error, "could not read from %s: %s",
                     filename, strerror(errno));
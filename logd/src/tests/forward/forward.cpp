@@ -37,16 +37,25 @@ struct ForwardFixture {
         return ss.str();
     }
 
-    void verifyForward(bool doForward) {
+    void forwardLine() {
         const std::string & line(logLine);
         forwarder.forwardLine(line.c_str(), line.c_str() + line.length());
+    }
+
+    ssize_t forwardedBytes() {
         fsync(fd);
         int rfd = open(fname.c_str(), O_RDONLY);
         char *buffer[2048];
         ssize_t bytes = read(rfd, buffer, 2048);
-        ssize_t expected = doForward ? line.length() : 0;
-        EXPECT_EQUAL(expected, bytes);
         close(rfd);
+        return bytes;
+    }
+
+    void verifyForward(bool doForward) {
+        forwardLine();
+        forwarder.flush();
+        ssize_t expected = doForward ? logLine.length() : 0;
+        EXPECT_EQUAL(expected, forwardedBytes());
     }
 };
 
@@ -67,4 +76,15 @@ TEST_FF("require that forwarder does not forward if not set", Forwarder(m), Forw
     f2.verifyForward(false);
 }
 
+TEST_FF("require that forwarded lines are batched until flushed", Forwarder(m), ForwardFixture(f1, "forward.txt")) {
+    ForwardMap forwardMap;
+    forwardMap[Logger::event] = true;
+    f1.setForwardMap(forwardMap);
+    f2.forwardLine();
+    f2.forwardLine();
+    EXPECT_EQUAL(0, f2.forwardedBytes());
+    f1.flush();
+    EXPECT_EQUAL(ssize_t(2 * f2.logLine.length()), f2.forwardedBytes());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -20,6 +20,7 @@ class MemCacheTest : public SingleDiskMemFileTestUtils
     CPPUNIT_TEST(testDeleteDoesNotReAddMemoryUsage);
     CPPUNIT_TEST(testEraseDoesNotReAddMemoryUsage);
     CPPUNIT_TEST(testGetWithNoCreation);
+    CPPUNIT_TEST(testScannedBodyDoesNotEvictOtherFiles);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -35,6 +36,7 @@ public:
     void testDeleteDoesNotReAddMemoryUsage();
     void testEraseDoesNotReAddMemoryUsage();
     void testGetWithNoCreation();
+    void testScannedBodyDoesNotEvictOtherFiles();
 
 private:
     framework::defaultimplementation::ComponentRegisterImpl::UP _register;
@@ -59,6 +61,18 @@ private:
         file->_cacheSizeOverride.bodySize = bodySz;
     }
 
+    void setScannedSize(const document::BucketId& id,
+                        uint64_t metaSize,
+                        uint64_t headerSz,
+                        uint64_t bodySz)
+    {
+        MemFilePtr file(_cache->get(id, env(), env().getDirectory()));
+        file->_cacheSizeOverride.metaSize = metaSize;
+        file->_cacheSizeOverride.headerSize = headerSz;
+        file->_cacheSizeOverride.bodySize = bodySz;
+        file->setFlag(HEADER_BLOCK_READ | BODY_BLOCK_READ);
+    }
+
     std::string
     getBucketStatus(uint32_t buckets)
     {
@@ -393,5 +407,32 @@ MemCacheTest::testEraseDoesNotReAddMemoryUsage()
 
 }
 
+void
+MemCacheTest::testScannedBodyDoesNotEvictOtherFiles()
+{
+    setup(1400);
+
+    setSize(BucketId(16, 1), 150, 100, 0);
+    setSize(BucketId(16, 2), 100, 100, 900);
+    setScannedSize(BucketId(16, 3), 50, 0, 300);
+
+    CPPUNIT_ASSERT_EQUAL(1400ul, cacheSize());
+    CPPUNIT_ASSERT_EQUAL(
+            std::string(
+                    "BucketId(0x4000000000000001) header\n"
+                    "BucketId(0x4000000000000002) body,header\n"
+                    "BucketId(0x4000000000000003) meta only\n"),
+            getBucketStatus(3));
+    CPPUNIT_ASSERT_EQUAL(0UL, _cache->getMetrics().body_evictions.getValue());
+    CPPUNIT_ASSERT_EQUAL(1UL, _cache->getMetrics().scan_body_evictions.getValue());
+
+    // Scanned bodies are kept as long as there is room for them
+    setup(4000);
+    setSize(BucketId(16, 1), 150, 100, 0);
+    setScannedSize(BucketId(16, 2), 100, 100, 900);
+    CPPUNIT_ASSERT_EQUAL(1350ul, cacheSize());
+    CPPUNIT_ASSERT_EQUAL(0UL, _cache->getMetrics().scan_body_evictions.getValue());
+}
+
 } // memfile
 } // storage
@@ -59,6 +59,7 @@ struct MemFileTest : public SingleDiskMemFileTestUtils
     void testAddSlotWhenDiskFull();
     void testGetSerializedSize();
     void testGetBucketInfo();
+    void testIncrementalBucketInfoMatchesFullScan();
     void testCopySlotsPreservesLocationSharing();
     void testFlushingToNonExistingFileAlwaysRunsCompaction();
     void testOrderDocSchemeDocumentsCanBeAddedToFile();
@@ -85,6 +86,7 @@ struct MemFileTest : public SingleDiskMemFileTestUtils
     CPPUNIT_TEST(testAddSlotWhenDiskFull);
     CPPUNIT_TEST(testGetSerializedSize);
     CPPUNIT_TEST(testGetBucketInfo);
+    CPPUNIT_TEST(testIncrementalBucketInfoMatchesFullScan);
     CPPUNIT_TEST(testCopySlotsPreservesLocationSharing);
     CPPUNIT_TEST(testFlushingToNonExistingFileAlwaysRunsCompaction);
     CPPUNIT_TEST(testOrderDocSchemeDocumentsCanBeAddedToFile);
@@ -895,6 +897,44 @@ MemFileTest::testGetBucketInfo()
     CPPUNIT_ASSERT_EQUAL(wantedUniqueSize, info.getDocumentSize());
 }
 
+void
+MemFileTest::testIncrementalBucketInfoMatchesFullScan()
+{
+    MemFilePtr file(getMemFile(document::BucketId(16, 4)));
+    AutoFlush af(file);
+    Document::SP doc1(createRandomDocumentAtLocation(4, 1234, 10, 100));
+    Document::SP doc2(createRandomDocumentAtLocation(4, 5678, 10, 100));
+
+    // Slots added in timestamp order are accounted for incrementally
+    file->addPutSlot(*doc1, Timestamp(1000));
+    file->addPutSlot(*doc2, Timestamp(1001));
+    file->addPutSlot(*doc1, Timestamp(1002));
+    file->addRemoveSlot(*file->getSlotAtTime(Timestamp(1001)), Timestamp(1003));
+    BucketInfo incremental = file->getBucketInfo();
+    CPPUNIT_ASSERT_EQUAL(1u, incremental.getDocumentCount());
+    CPPUNIT_ASSERT_EQUAL(4u, incremental.getEntryCount());
+    uint32_t wantedUniqueSize = (*file)[2].getLocation(HEADER)._size
+                                + (*file)[2].getLocation(BODY)._size;
+    CPPUNIT_ASSERT_EQUAL(wantedUniqueSize, incremental.getDocumentSize());
+
+    // Forces a full scan of all slots
+    file->setFlag(BUCKET_INFO_OUTDATED);
+    CPPUNIT_ASSERT_EQUAL(incremental, file->getBucketInfo());
+
+    // Slot older than the newest one requires a full scan
+    file->addPutSlot(*doc2, Timestamp(999));
+    BucketInfo afterInsert = file->getBucketInfo();
+    CPPUNIT_ASSERT_EQUAL(1u, afterInsert.getDocumentCount());
+    CPPUNIT_ASSERT_EQUAL(5u, afterInsert.getEntryCount());
+
+    // Incremental accounting resumes after the full scan
+    file->addPutSlot(*doc2, Timestamp(1004));
+    incremental = file->getBucketInfo();
+    CPPUNIT_ASSERT_EQUAL(2u, incremental.getDocumentCount());
+    file->setFlag(BUCKET_INFO_OUTDATED);
+    CPPUNIT_ASSERT_EQUAL(incremental, file->getBucketInfo());
+}
+
 void
 MemFileTest::testCopySlotsPreservesLocationSharing()
 {
@@ -34,6 +34,7 @@ struct MemFileV1SerializerTest : public SingleDiskMemFileTestUtils
     void testLocationDiskIoPlannerMergeReads();
     void testLocationDiskIoPlannerAlignReads();
     void testLocationDiskIoPlannerOneDocument();
+    void testLocationDiskIoPlannerSequentialScan();
     void testSeparateReadsForHeaderAndBody();
     void testLocationsRemappedConsistently();
     void testHeaderBufferTooSmall();
@@ -59,6 +60,7 @@ struct MemFileV1SerializerTest : public SingleDiskMemFileTestUtils
     CPPUNIT_TEST(testLocationDiskIoPlannerMergeReads);
     CPPUNIT_TEST(testLocationDiskIoPlannerAlignReads);
     CPPUNIT_TEST(testLocationDiskIoPlannerOneDocument);
+    CPPUNIT_TEST(testLocationDiskIoPlannerSequentialScan);
     CPPUNIT_TEST(testSeparateReadsForHeaderAndBody);
     CPPUNIT_TEST(testPartialWriteTooMuchFreeSpace);
     CPPUNIT_TEST(testPartialWriteNotEnoughFreeSpace);
@@ -548,6 +550,34 @@ MemFileV1SerializerTest::testLocationDiskIoPlannerMergeReads()
     }
 }
 
+void
+MemFileV1SerializerTest::testLocationDiskIoPlannerSequentialScan()
+{
+    // Three 1k locations spread over 5k, with gaps too large to read through.
+    std::vector<DataLocation> locations;
+    locations.push_back(DataLocation(0, 1024));
+    locations.push_back(DataLocation(2048, 1024));
+    locations.push_back(DataLocation(4096, 1024));
+
+    DummyMemFileIOInterface dummyIo;
+    {
+        LocationDiskIoPlanner planner(dummyIo, BODY, locations, 512, 0);
+        CPPUNIT_ASSERT_EQUAL(3, (int)planner.getIoOperations().size());
+    }
+    {
+        LocationDiskIoPlanner planner(dummyIo, BODY, locations, 512, 0, 0.6);
+        CPPUNIT_ASSERT_EQUAL(1, (int)planner.getIoOperations().size());
+        CPPUNIT_ASSERT_EQUAL(
+                DataLocation(0, 5120),
+                planner.getIoOperations()[0]);
+    }
+    {
+        // Wanted data fills too little of the span to read it all
+        LocationDiskIoPlanner planner(dummyIo, BODY, locations, 512, 0, 0.7);
+        CPPUNIT_ASSERT_EQUAL(3, (int)planner.getIoOperations().size());
+    }
+}
+
 void
 MemFileV1SerializerTest::testLocationDiskIoPlannerOneDocument()
 {
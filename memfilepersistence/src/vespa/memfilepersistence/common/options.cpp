@@ -23,6 +23,7 @@ Options::Options()
       _cacheSize(0),
       _initialIndexRead(65536),
       _maximumGapToReadThrough(65536),
+      _sequentialReadFillRatio(0.5),
       _diskFullFactor(0.98),
       _growFactor(2.0),
       _overrepresentMetaDataFactor(1.2),
@@ -52,6 +53,7 @@ Options::Options(const vespa::config::storage::StorMemfilepersistenceConfig& new
       _cacheSize(newConfig.cacheSize),
       _initialIndexRead(newConfig.initialIndexRead),
       _maximumGapToReadThrough(newConfig.maximumGapToReadThrough),
+      _sequentialReadFillRatio(newConfig.sequentialReadFillRatio),
       _diskFullFactor(newConfig.diskFullFactor),
       _growFactor(newConfig.growFactor),
       _overrepresentMetaDataFactor(newConfig.overrepresentMetaDataFactor),
@@ -79,6 +81,7 @@ Options::operator==(const Options& options) const {
         && _cacheSize == options._cacheSize
         && _initialIndexRead == options._initialIndexRead
         && _maximumGapToReadThrough == options._maximumGapToReadThrough
+        && _sequentialReadFillRatio == options._sequentialReadFillRatio
         && _diskFullFactor == options._diskFullFactor
         && _defaultRemoveDocType == options._defaultRemoveDocType)
     {
@@ -216,6 +219,7 @@ void Options::print(std::ostream& out, bool verbose,
         << s << "Initial index read: " << _initialIndexRead << " b"
         << s << "Maximum gap to read through: "
              << _maximumGapToReadThrough << " b"
+        << s << "Sequential read fill ratio: " << _sequentialReadFillRatio
         << s << "Disk full factor: " << _diskFullFactor
         << s << "Grow factor: " << _growFactor
         << s << "Overrepresent meta data factor: "
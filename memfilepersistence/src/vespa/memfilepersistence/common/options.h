@@ -47,6 +47,7 @@ struct Options : public vespalib::Printable
     uint64_t _cacheSize;
     uint32_t _initialIndexRead;
     uint32_t _maximumGapToReadThrough;
+    double _sequentialReadFillRatio;
 
     double _diskFullFactor;
     double _growFactor;
@@ -11,13 +11,14 @@ LocationDiskIoPlanner::LocationDiskIoPlanner(
         DocumentPart part,
         const std::vector<DataLocation>& desiredLocations,
         uint32_t maxGap,
-        uint32_t blockStartIndex)
+        uint32_t blockStartIndex,
+        double sequentialFillRatio)
     : _io(io),
       _operations(),
       _part(part),
       _blockStartIndex(blockStartIndex)
 {
-    processLocations(desiredLocations, maxGap);
+    processLocations(desiredLocations, maxGap, sequentialFillRatio);
 }
 
 namespace {
@@ -47,7 +48,8 @@ LocationDiskIoPlanner::scheduleLocation(DataLocation loc,
 void
 LocationDiskIoPlanner::processLocations(
         const std::vector<DataLocation>& desiredLocations,
-        uint32_t maxGap)
+        uint32_t maxGap,
+        double sequentialFillRatio)
 {
     // Build list of disk read operations to do
     std::vector<DataLocation> allOps;
@@ -59,9 +61,11 @@ LocationDiskIoPlanner::processLocations(
 
     // Sort list, and join elements close together into single IO ops
     std::sort(allOps.begin(), allOps.end());
+    uint64_t wantedSize = 0;
     for (size_t i = 0; i < allOps.size(); ++i) {
         uint32_t start = alignDown(allOps[i]._pos);
         uint32_t stop = alignUp(allOps[i]._pos + allOps[i]._size);
+        wantedSize += allOps[i]._size;
         if (i != 0) {
             uint32_t lastStop = _operations.back()._pos
                               + _operations.back()._size;
@@ -73,6 +77,17 @@ LocationDiskIoPlanner::processLocations(
 
         _operations.push_back(DataLocation(start, stop - start));
     }
+
+    // If we want most of the span anyway, read all of it in one go rather
+    // than seeking past the gaps.
+    if (_operations.size() > 1 && sequentialFillRatio > 0) {
+        uint32_t start = _operations.front()._pos;
+        uint32_t stop = _operations.back()._pos + _operations.back()._size;
+        if (wantedSize >= sequentialFillRatio * (stop - start)) {
+            _operations.clear();
+            _operations.push_back(DataLocation(start, stop - start));
+        }
+    }
 }
 
 uint32_t
@@ -8,6 +8,11 @@
  * When accessing many locations on disk, it is not necessarily ideal to do a
  * disk access per location. This class creates a minimal set of locations to
  * access to avoid accessing more than a maximum gap of uninteresting data.
+ *
+ * Bulk operations like visiting and merging typically want most of the data
+ * of a block. If the wanted data fills at least the given fraction of the span
+ * it is located in, the entire span is read in a single sequential operation
+ * regardless of the gaps in between.
  */
 #pragma once
 
@@ -27,7 +32,8 @@ public:
                           DocumentPart part,
                           const std::vector<DataLocation>& desiredLocations,
                           uint32_t maxGap,
-                          uint32_t blockStartIndex);
+                          uint32_t blockStartIndex,
+                          double sequentialFillRatio = 0.0);
 
     const std::vector<DataLocation>& getIoOperations() const {
         return _operations;
@@ -51,7 +57,8 @@ private:
 
     void processLocations(
             const std::vector<DataLocation>& desiredLocations,
-            uint32_t maxGap);
+            uint32_t maxGap,
+            double sequentialFillRatio);
 
     void scheduleLocation(DataLocation loc, std::vector<DataLocation>&);
 };
@@ -284,7 +284,8 @@ MemFileV1Serializer::cacheLocations(MemFileIOInterface& io,
             part,
             locations,
             options._maximumGapToReadThrough,
-            blockStartIndex);
+            blockStartIndex,
+            options._sequentialReadFillRatio);
 
     if (planner.getIoOperations().empty()) {
         LOG(spam, "%s: no disk read operations required for %zu %s locations",
@@ -0,0 +1,153 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "bucket_info_aggregate.h"
+#include <vespa/vespalib/util/crc.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <algorithm>
+
+namespace storage {
+namespace memfile {
+
+BucketInfoAggregate::BucketInfoAggregate()
+    : _newest(),
+      _uniqueCount(0),
+      _uniqueSize(0),
+      _checksum(0),
+      _maxHeaderExtent(0),
+      _maxBodyExtent(0),
+      _valid(true)
+{
+}
+
+BucketInfoAggregate::~BucketInfoAggregate() {}
+
+uint32_t
+BucketInfoAggregate::calcChecksum(const GlobalId& gid, Timestamp time)
+{
+    vespalib::crc_32_type calculator;
+    calculator.process_bytes(gid.get(), GlobalId::LENGTH);
+    calculator.process_bytes(&time, sizeof(Timestamp));
+    return calculator.checksum();
+}
+
+void
+BucketInfoAggregate::invalidate()
+{
+    SlotMap().swap(_newest);
+    _uniqueCount = 0;
+    _uniqueSize = 0;
+    _checksum = 0;
+    _maxHeaderExtent = 0;
+    _maxBodyExtent = 0;
+    _valid = false;
+}
+
+void
+BucketInfoAggregate::clear()
+{
+    invalidate();
+    _valid = true;
+}
+
+void
+BucketInfoAggregate::addExtents(const MemSlot& slot)
+{
+    // We now always write sequentially within the blocks, so used size
+    // for one block is effectively the max location extent seen within
+    // it.
+    _maxHeaderExtent = std::max(_maxHeaderExtent,
+                                slot.getLocation(HEADER)._pos
+                                + slot.getLocation(HEADER)._size);
+    _maxBodyExtent = std::max(_maxBodyExtent,
+                              slot.getLocation(BODY)._pos
+                              + slot.getLocation(BODY)._size);
+}
+
+void
+BucketInfoAggregate::addUnique(const MemSlot& slot)
+{
+    uint32_t slotSize = slot.getLocation(HEADER)._size
+                        + slot.getLocation(BODY)._size;
+    _newest[slot.getGlobalId()] = NewestSlot{slot.getTimestamp(), slotSize, slot.deleted()};
+    if (slot.deleted()) {
+        return;
+    }
+    _uniqueSize += slotSize;
+    ++_uniqueCount;
+    _checksum ^= calcChecksum(slot.getGlobalId(), slot.getTimestamp());
+}
+
+void
+BucketInfoAggregate::removeUnique(const GlobalId& gid, const NewestSlot& slot)
+{
+    if (slot.deleted) {
+        return;
+    }
+    _uniqueSize -= slot.size;
+    --_uniqueCount;
+    _checksum ^= calcChecksum(gid, slot.timestamp);
+}
+
+void
+BucketInfoAggregate::rebuild(const std::vector<MemSlot>& slots)
+{
+    clear();
+    _newest.resize(slots.size() * 2);
+    for (auto it(slots.rbegin()), e(slots.rend()); it != e; ++it) {
+        addExtents(*it);
+        if (_newest.find(it->getGlobalId()) == _newest.end()) {
+            addUnique(*it);
+        }
+    }
+}
+
+void
+BucketInfoAggregate::append(const MemSlot& slot)
+{
+    if (!_valid) {
+        return;
+    }
+    addExtents(slot);
+    auto found = _newest.find(slot.getGlobalId());
+    if (found != _newest.end()) {
+        removeUnique(found->first, found->second);
+    }
+    addUnique(slot);
+}
+
+void
+BucketInfoAggregate::refreshExtents(const std::vector<MemSlot>& slots)
+{
+    if (!_valid) {
+        return;
+    }
+    _maxHeaderExtent = 0;
+    _maxBodyExtent = 0;
+    for (const MemSlot& slot : slots) {
+        addExtents(slot);
+    }
+}
+
+Types::BucketInfo
+BucketInfoAggregate::getBucketInfo(uint32_t slotCount) const
+{
+    uint32_t checksum = _checksum;
+    if (_uniqueCount > 0 && checksum < 2) {
+        checksum += 2;
+    }
+    // Only set used size if we have any entries at all.
+    uint32_t usedSize = 0;
+    if (slotCount > 0) {
+        usedSize = 64 + 40 * slotCount + _maxHeaderExtent + _maxBodyExtent;
+    }
+    return spi::BucketInfo(spi::BucketChecksum(checksum),
+                           _uniqueCount,
+                           _uniqueSize,
+                           slotCount,
+                           usedSize,
+                           BucketInfo::READY,
+                           BucketInfo::NOT_ACTIVE);
+}
+
+} // memfile
+} // storage
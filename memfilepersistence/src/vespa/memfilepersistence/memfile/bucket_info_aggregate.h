@@ -0,0 +1,68 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "memslot.h"
+#include <vespa/memfilepersistence/common/types.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+
+namespace storage {
+namespace memfile {
+
+/**
+ * Aggregates needed to calculate the bucket info of a memfile, tracking
+ * the newest slot of each document. Slots newer than all slots seen so
+ * far can be appended incrementally, so filling a file in timestamp order
+ * (as done when loading, feeding and splitting) does not require a full
+ * scan of the slots when the bucket info is needed.
+ *
+ * Any other change to the slots requires the aggregate to be invalidated
+ * and rebuilt from the slots.
+ */
+class BucketInfoAggregate : private Types
+{
+    struct NewestSlot {
+        Timestamp timestamp;
+        uint32_t size;
+        bool deleted;
+    };
+    using SlotMap = vespalib::hash_map<GlobalId, NewestSlot, GlobalId::hash>;
+
+    SlotMap _newest;
+    uint32_t _uniqueCount;
+    uint32_t _uniqueSize;
+    uint32_t _checksum;
+    uint32_t _maxHeaderExtent;
+    uint32_t _maxBodyExtent;
+    bool _valid;
+
+    static uint32_t calcChecksum(const GlobalId& gid, Timestamp time);
+    void addExtents(const MemSlot& slot);
+    void addUnique(const MemSlot& slot);
+    void removeUnique(const GlobalId& gid, const NewestSlot& slot);
+
+public:
+    BucketInfoAggregate();
+    ~BucketInfoAggregate();
+
+    bool valid() const { return _valid; }
+    void invalidate();
+    /** Reset to the valid state of a file without slots. */
+    void clear();
+
+    /** Rebuild from the given slots, sorted on increasing timestamp. */
+    void rebuild(const std::vector<MemSlot>& slots);
+
+    /** Account for a slot newer than all slots added so far. */
+    void append(const MemSlot& slot);
+
+    /**
+     * Recalculate the used extents of the blocks after the slots have been
+     * relocated, without changing which slots they are.
+     */
+    void refreshExtents(const std::vector<MemSlot>& slots);
+
+    BucketInfo getBucketInfo(uint32_t slotCount) const;
+};
+
+} // memfile
+} // storage
@@ -8,7 +8,6 @@
 #include <vespa/memfilepersistence/common/environment.h>
 #include <vespa/memfilepersistence/common/exceptions.h>
 #include <vespa/document/util/stringutil.h>
-#include <vespa/vespalib/util/crc.h>
 #include <ext/algorithm>
 #include <iomanip>
 
@@ -70,6 +69,7 @@ MemFile::MemFile(const FileSpecification& file,
                  const LoadOptions& opts)
     : _flags(BUCKET_INFO_OUTDATED),
       _info(),
+      _infoAggregate(),
       _entries(),
       _file(file),
       _currentVersion(UNKNOWN),
@@ -86,6 +86,7 @@ MemFile::MemFile(const FileSpecification& file, Environment& env,
                  bool callLoadFile)
     : _flags(BUCKET_INFO_OUTDATED),
       _info(),
+      _infoAggregate(),
       _entries(),
       _file(file),
       _currentVersion(UNKNOWN),
@@ -334,11 +335,12 @@ MemFile::addSlot(const MemSlot& slot)
 
     // Optimize common case where slot we're adding has a higher
     // timestamp than the last slot already stored.
-    if (!_entries.empty()
-        && slot.getTimestamp() > _entries.back().getTimestamp())
+    if (_entries.empty()
+        || slot.getTimestamp() > _entries.back().getTimestamp())
     {
         _flags |= BUCKET_INFO_OUTDATED | SLOTS_ALTERED;
         _entries.push_back(slot);
+        _infoAggregate.append(slot);
         return;
     }
 
@@ -364,6 +366,7 @@ MemFile::addSlot(const MemSlot& slot)
         entries.push_back(slot);
     }
     _flags |= BUCKET_INFO_OUTDATED | SLOTS_ALTERED;
+    _infoAggregate.invalidate();
     _entries.swap(entries);
 }
 
@@ -428,6 +431,7 @@ void
 MemFile::removeSlot(const MemSlot& slot)
 {
     _flags |= BUCKET_INFO_OUTDATED | SLOTS_ALTERED;
+    _infoAggregate.invalidate();
     std::vector<MemSlot>::iterator it(
             std::lower_bound(_entries.begin(), _entries.end(),
                              slot.getTimestamp(),
@@ -466,6 +470,7 @@ MemFile::removeSlots(const std::vector<const MemSlot*>& slotsToRemove)
     _entries.swap(slots);
     if (_entries.size() != slots.size()) {
         _flags |= BUCKET_INFO_OUTDATED | SLOTS_ALTERED;
+        _infoAggregate.invalidate();
     }
         // Verify that we found all slots to remove
     if (r < slotsToRemove.size()) {
@@ -487,6 +492,7 @@ void
 MemFile::modifySlot(const MemSlot& slot)
 {
     _flags |= BUCKET_INFO_OUTDATED | SLOTS_ALTERED;
+    _infoAggregate.invalidate();
     // MemSlot actually pointed to by const MemSlot* is non-const
     // in entries-vector, so this should be well defined according
     // to the C++ ISO standard
@@ -629,8 +635,10 @@ MemFile::ensureEntriesCached(bool includeBody) const
         }
 
         _buffer->ensureCached(_env, HEADER, headerLocations);
+        _flags |= HEADER_BLOCK_READ;
         if (includeBody) {
             _buffer->ensureCached(_env, BODY, bodyLocations);
+            _flags |= BODY_BLOCK_READ;
         }
     } RETHROW_NON_MEMFILE_EXCEPTIONS;
 }
@@ -687,66 +695,10 @@ const Types::BucketInfo&
 MemFile::getBucketInfo() const
 {
     if (_flags & BUCKET_INFO_OUTDATED) {
-        uint32_t uniqueCount = 0, uniqueSize = 0, usedSize = 0;
-        uint32_t checksum = 0;
-
-        typedef vespalib::hash_set<GlobalId, GlobalId::hash> SeenMap;
-        SeenMap seen(_entries.size() * 2);
-        uint32_t maxHeaderExtent = 0, maxBodyExtent = 0;
-
-        MemSlotVector::const_reverse_iterator e(_entries.rend());
-        for (MemSlotVector::const_reverse_iterator it(_entries.rbegin());
-             it != e; ++it)
-        {
-            const MemSlot& slot(*it);
-            // We now always write sequentially within the blocks, so used size
-            // for one block is effectively the max location extent seen within
-            // it.
-            maxHeaderExtent = std::max(maxHeaderExtent,
-                                       slot.getLocation(HEADER)._pos
-                                       + slot.getLocation(HEADER)._size);
-            maxBodyExtent = std::max(maxBodyExtent,
-                                     slot.getLocation(BODY)._pos
-                                     + slot.getLocation(BODY)._size);
-
-            SeenMap::insert_result inserted(seen.insert(slot.getGlobalId()));
-            if (!inserted.second) {
-                continue;
-            }
-            if (slot.deleted()) continue;
-
-            const uint32_t slotSize = slot.getLocation(HEADER)._size
-                                      + slot.getLocation(BODY)._size;
-            uniqueSize += slotSize;
-            ++uniqueCount;
-
-            vespalib::crc_32_type calculator;
-            calculator.process_bytes(slot.getGlobalId().get(),
-                                     GlobalId::LENGTH);
-            Timestamp time = slot.getTimestamp();
-            calculator.process_bytes(&time, sizeof(Timestamp));
-            checksum ^= calculator.checksum();
-        }
-
-        if (uniqueCount > 0 && checksum < 2) {
-            checksum += 2;
+        if (!_infoAggregate.valid()) {
+            _infoAggregate.rebuild(_entries);
         }
-
-        // Only set used size if we have any entries at all.
-        if (!_entries.empty()) {
-            usedSize = 64 + 40 * _entries.size()
-                       + maxHeaderExtent + maxBodyExtent;
-        }
-
-        spi::BucketInfo info(spi::BucketChecksum(checksum),
-                             uniqueCount,
-                             uniqueSize,
-                             _entries.size(),
-                             usedSize,
-                             BucketInfo::READY,
-                             BucketInfo::NOT_ACTIVE);
-
-        _info = info;
+        _info = _infoAggregate.getBucketInfo(_entries.size());
         _flags &= ~BUCKET_INFO_OUTDATED;
     }
     return _info;
@@ -760,6 +712,8 @@ MemFile::flushToDisk(FlushFlag flag)
         try{
             _env._memFileMapper.flush(*this, _env);
         } RETHROW_NON_MEMFILE_EXCEPTIONS;
+        // Flushing relocates slots
+        _infoAggregate.refreshExtents(_entries);
     } else {
         LOG(spam, "Not flushing %s as it is not altered", toString().c_str());
     }
@@ -776,14 +730,17 @@ MemFile::clearCache(DocumentPart part)
     _buffer->clear(part);
     if (part == HEADER) {
         _cacheSizeOverride.headerSize = 0;
+        _flags &= ~HEADER_BLOCK_READ;
     } else {
         _cacheSizeOverride.bodySize = 0;
+        _flags &= ~BODY_BLOCK_READ;
     }
 }
 
 bool
 MemFile::repair(std::ostream& errorReport, uint32_t verifyFlags)
 {
+    _infoAggregate.invalidate();
     try{
         return _env._memFileMapper.repair(
                 *this, _env, errorReport, verifyFlags);
@@ -797,6 +754,7 @@ MemFile::resetMetaState()
     _flags = BUCKET_INFO_OUTDATED;
     _currentVersion = UNKNOWN;
     _info = BucketInfo();
+    _infoAggregate.clear();
     _entries.clear();
 }
 
@@ -28,6 +28,7 @@
 #pragma once
 
 #include "memslot.h"
+#include "bucket_info_aggregate.h"
 #include "slotiterator.h"
 #include "memfileiointerface.h"
 #include <vespa/memfilepersistence/common/filespecification.h>
@@ -65,6 +66,7 @@ private:
 
     mutable uint32_t _flags;
     mutable BucketInfo _info;
+    mutable BucketInfoAggregate _infoAggregate;
     MemFileIOInterface::UP _buffer;
     MemSlotVector _entries;
     FileSpecification _file;
@@ -208,6 +210,9 @@ public:
 
     void setFlag(uint32_t flags) {
         verifyLegalFlags(flags, LEGAL_MEMFILE_FLAGS, "MemFile::setFlag");
+        if (flags & BUCKET_INFO_OUTDATED) {
+            _infoAggregate.invalidate();
+        }
         _flags |= flags;
     }
 
@@ -261,7 +266,9 @@ public:
 
     /**
      * Fetches the bucket info. If metadata is altered, info will be
-     * recalculated, and bucket database updated.
+     * recalculated, and bucket database updated. Slots added in timestamp
+     * order are accounted for incrementally, other changes require a scan
+     * of all slots.
      */
     const BucketInfo& getBucketInfo() const;
 
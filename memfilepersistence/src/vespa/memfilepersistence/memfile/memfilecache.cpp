@@ -31,6 +31,21 @@ MemFileCache::returnToCache(MemFileCache::Entry& entry)
 
     MemoryUsage newUsage = entry._file.getCacheSize();
 
+    // Files that had their entire body block read were typically scanned by
+    // visiting, merging or maintenance operations that are not likely to
+    // want it again soon. Rather than letting such a body push data of other
+    // files out of the cache, drop it right away if it does not fit.
+    if (entry._file.bodyBlockCached() && !entry._file.slotsAltered()
+        && newUsage.bodySize > 0 && _cacheLimit.sum() > 0
+        && _memoryUsage.sum() + newUsage.sum() > _cacheLimit.sum())
+    {
+        LOG(debug, "Dropping scanned body of %s rather than evicting other "
+            "files to make room for it", id.toString().c_str());
+        entry._file.clearCache(BODY);
+        newUsage = entry._file.getCacheSize();
+        _metrics.scan_body_evictions.inc();
+    }
+
     if (_cacheLimit.sum() == 0 || newUsage.sum() == 0) {
         entry._file.flushToDisk();
         eraseNoLock(id);
@@ -30,7 +30,10 @@ MemFilePersistenceCacheMetrics::MemFilePersistenceCacheMetrics(MetricSet& owner)
       meta_evictions("meta_evictions", "", "Bucket meta data evictions", this),
       header_evictions("header_evictions", "", "Bucket header (and "
                        "implicitly body, if present) data evictions", this),
-      body_evictions("body_evictions", "", "Bucket body data evictions", this)
+      body_evictions("body_evictions", "", "Bucket body data evictions", this),
+      scan_body_evictions("scan_body_evictions", "", "Bucket body data read "
+                          "by a scan of the entire file that was dropped "
+                          "instead of being cached", this)
 { }
 
 MemFilePersistenceCacheMetrics::~MemFilePersistenceCacheMetrics() { }
@@ -35,6 +35,7 @@ public:
     metrics::LongCountMetric meta_evictions;
     metrics::LongCountMetric header_evictions;
     metrics::LongCountMetric body_evictions;
+    metrics::LongCountMetric scan_body_evictions;
 
     MemFilePersistenceCacheMetrics(metrics::MetricSet& owner);
     ~MemFilePersistenceCacheMetrics();
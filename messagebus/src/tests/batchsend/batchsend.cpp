@@ -0,0 +1,122 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/messagebus/destinationsession.h>
+#include <vespa/messagebus/sourcesession.h>
+#include <vespa/messagebus/sourcesessionparams.h>
+#include <vespa/messagebus/testlib/receptor.h>
+#include <vespa/messagebus/testlib/simplemessage.h>
+#include <vespa/messagebus/testlib/simpleprotocol.h>
+#include <vespa/messagebus/testlib/simplereply.h>
+#include <vespa/messagebus/testlib/slobrok.h>
+#include <vespa/messagebus/testlib/testserver.h>
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <set>
+
+using namespace mbus;
+using vespalib::make_string;
+
+struct Fixture {
+    Slobrok                slobrok;
+    TestServer             srcServer;
+    TestServer             dstServer;
+    Receptor               srcHandler;
+    Receptor               dstHandler;
+    SourceSession::UP      srcSession;
+    DestinationSession::UP dstSession;
+
+    Fixture(double batchWindow, uint32_t maxBatchSize)
+        : slobrok(),
+          srcServer(MessageBusParams().setRetryPolicy(IRetryPolicy::SP()).addProtocol(std::make_shared<SimpleProtocol>()),
+                    RPCNetworkParams().setSlobrokConfig(slobrok.config())
+                                      .setBatchWindowSecs(batchWindow)
+                                      .setMaxBatchSize(maxBatchSize)),
+          dstServer(MessageBusParams().addProtocol(std::make_shared<SimpleProtocol>()),
+                    RPCNetworkParams().setIdentity(Identity("dst")).setSlobrokConfig(slobrok.config())),
+          srcHandler(),
+          dstHandler(),
+          srcSession(srcServer.mb.createSourceSession(SourceSessionParams().setReplyHandler(srcHandler))),
+          dstSession(dstServer.mb.createDestinationSession(DestinationSessionParams().setName("session").setMessageHandler(dstHandler)))
+    {
+        ASSERT_TRUE(srcServer.waitSlobrok("dst/session"));
+    }
+
+    void send(const string &value) {
+        EXPECT_TRUE(srcSession->send(std::make_unique<SimpleMessage>(value), Route::parse("dst/session")).isAccepted());
+    }
+
+    std::vector<Message::UP> receive(uint32_t numMessages) {
+        std::vector<Message::UP> msgs;
+        for (uint32_t i = 0; i < numMessages; ++i) {
+            Message::UP msg = dstHandler.getMessage();
+            if (!EXPECT_TRUE(msg)) {
+                break;
+            }
+            msgs.push_back(std::move(msg));
+        }
+        return msgs;
+    }
+
+    void reply(Message::UP msg) {
+        auto reply = std::make_unique<SimpleReply>(static_cast<SimpleMessage&>(*msg).getValue() + " reply");
+        msg->swapState(*reply);
+        dstSession->reply(std::move(reply));
+    }
+
+    std::set<string> receiveReplies(uint32_t numReplies) {
+        std::set<string> values;
+        for (uint32_t i = 0; i < numReplies; ++i) {
+            Reply::UP reply = srcHandler.getReply();
+            if (!EXPECT_TRUE(reply)) {
+                break;
+            }
+            EXPECT_FALSE(reply->hasErrors());
+            EXPECT_EQUAL(SimpleProtocol::REPLY, reply->getType());
+            values.insert(static_cast<SimpleReply&>(*reply).getValue());
+        }
+        return values;
+    }
+};
+
+TEST_F("require that a full batch is sent without waiting for the window", Fixture(3600.0, 4)) {
+    for (uint32_t i = 0; i < 4; ++i) {
+        f1.send(make_string("msg%u", i));
+    }
+    std::vector<Message::UP> msgs = f1.receive(4);
+    ASSERT_EQUAL(4u, msgs.size());
+    EXPECT_FALSE(f1.srcHandler.getReply(0));
+
+    // Replies are returned together, in whatever order they are made.
+    while ( ! msgs.empty()) {
+        f1.reply(std::move(msgs.back()));
+        msgs.pop_back();
+    }
+    std::set<string> expected = { "msg0 reply", "msg1 reply", "msg2 reply", "msg3 reply" };
+    EXPECT_TRUE(expected == f1.receiveReplies(4));
+}
+
+TEST_F("require that a partial batch is sent when the window closes", Fixture(0.05, 64)) {
+    for (uint32_t i = 0; i < 3; ++i) {
+        f1.send(make_string("msg%u", i));
+    }
+    std::vector<Message::UP> msgs = f1.receive(3);
+    ASSERT_EQUAL(3u, msgs.size());
+    for (auto &msg : msgs) {
+        f1.reply(std::move(msg));
+    }
+    std::set<string> expected = { "msg0 reply", "msg1 reply", "msg2 reply" };
+    EXPECT_TRUE(expected == f1.receiveReplies(3));
+}
+
+TEST_F("require that messages are sent one by one when batching is disabled", Fixture(0.0, 64)) {
+    f1.send("msg0");
+    f1.send("msg1");
+    std::vector<Message::UP> msgs = f1.receive(2);
+    ASSERT_EQUAL(2u, msgs.size());
+    f1.reply(std::move(msgs[1]));
+    EXPECT_TRUE(std::set<string>({ "msg1 reply" }) == f1.receiveReplies(1));
+    f1.reply(std::move(msgs[0]));
+    EXPECT_TRUE(std::set<string>({ "msg0 reply" }) == f1.receiveReplies(1));
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -5,6 +5,8 @@
 #include <vespa/messagebus/routablequeue.h>
 #include <vespa/messagebus/emptyreply.h>
 #include <vespa/vespalib/testkit/testapp.h>
+#include <thread>
+#include <vector>
 
 #include <vespa/log/log.h>
 LOG_SETUP("sequencer_test");
@@ -85,6 +87,7 @@ class Test : public vespalib::TestApp {
 private:
     void testSyncNone();
     void testSyncId();
+    void testConcurrentSend();
 
 public:
     int Main() override {
@@ -92,6 +95,7 @@ public:
 
         testSyncNone(); TEST_FLUSH();
         testSyncId();   TEST_FLUSH();
+        testConcurrentSend(); TEST_FLUSH();
 
         TEST_DONE();
     }
@@ -192,3 +196,35 @@ Test::testSyncId()
     EXPECT_EQUAL(0u, src.size());
     EXPECT_EQUAL(0u, dst.size());
 }
+
+void
+Test::testConcurrentSend()
+{
+    const uint32_t numThreads = 8;
+    const uint32_t numMessages = 200;
+    const uint32_t numIds = 64;
+    MyQueue     src;
+    MyQueue     dst;
+    Sequencer   seq(dst);
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&, t]() {
+                for (uint32_t i = 0; i < numMessages; ++i) {
+                    seq.handleMessage(src.createMessage(true, (t * numMessages + i) % numIds));
+                }
+            });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    // only one message per sequence id is sent at a time
+    EXPECT_EQUAL(numIds, dst.size());
+    uint32_t replied = 0;
+    while (dst.size() > 0) {
+        dst.replyNext();
+        ++replied;
+    }
+    EXPECT_EQUAL(numThreads * numMessages, replied);
+    EXPECT_EQUAL(numThreads * numMessages, src.size());
+}
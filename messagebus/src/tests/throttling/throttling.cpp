@@ -76,6 +76,7 @@ bool waitPending(SourceSession& session, uint32_t size)
 class Test : public vespalib::TestApp {
 private:
     uint32_t getWindowSize(DynamicThrottlePolicy &policy, DynamicTimer &timer, uint32_t maxPending);
+    uint32_t getWindowSizeWithCapacity(DynamicThrottlePolicy &policy, DynamicTimer &timer, uint32_t capacity);
 
 protected:
     void testMaxPendingCount();
@@ -85,6 +86,8 @@ protected:
     void testIdleTimePeriod();
     void testMinWindowSize();
     void testMaxWindowSize();
+    void testLatencyAdaptiveWindowSize();
+    void testLatencyAdaptiveMaxLatency();
 
 public:
     int Main() override;
@@ -102,6 +105,8 @@ Test::Main()
     testIdleTimePeriod();    TEST_FLUSH();
     testMinWindowSize();     TEST_FLUSH();
     testMaxWindowSize();     TEST_FLUSH();
+    testLatencyAdaptiveWindowSize(); TEST_FLUSH();
+    testLatencyAdaptiveMaxLatency(); TEST_FLUSH();
 
     TEST_DONE();
 }
@@ -334,6 +339,77 @@ Test::testMaxWindowSize()
 
 }
 
+void
+Test::testLatencyAdaptiveWindowSize()
+{
+    std::unique_ptr<DynamicTimer> ptr(new DynamicTimer());
+    DynamicTimer *timer = ptr.get();
+    DynamicThrottlePolicy policy(std::move(ptr));
+
+    policy.setWindowSizeIncrement(5);
+    policy.setLatencyAdaptive(true);
+    policy.setQueueTarget(10);
+
+    double windowSize = getWindowSizeWithCapacity(policy, *timer, 100);
+    EXPECT_TRUE(windowSize >= 100 && windowSize <= 115);
+    EXPECT_APPROX(1000.0, policy.getMinLatency(), 1.0);
+    EXPECT_TRUE(policy.getQueueEstimate() <= 15);
+
+    windowSize = getWindowSizeWithCapacity(policy, *timer, 200);
+    EXPECT_TRUE(windowSize >= 200 && windowSize <= 215);
+
+    windowSize = getWindowSizeWithCapacity(policy, *timer, 50);
+    EXPECT_TRUE(windowSize >= 50 && windowSize <= 65);
+
+    windowSize = getWindowSizeWithCapacity(policy, *timer, 500);
+    EXPECT_TRUE(windowSize >= 500 && windowSize <= 515);
+
+    windowSize = getWindowSizeWithCapacity(policy, *timer, 100);
+    EXPECT_TRUE(windowSize >= 100 && windowSize <= 115);
+}
+
+void
+Test::testLatencyAdaptiveMaxLatency()
+{
+    std::unique_ptr<DynamicTimer> ptr(new DynamicTimer());
+    DynamicTimer *timer = ptr.get();
+    DynamicThrottlePolicy policy(std::move(ptr));
+
+    policy.setWindowSizeIncrement(5);
+    policy.setLatencyAdaptive(true);
+    policy.setQueueTarget(1000);
+    policy.setMaxLatency(1200);
+
+    double windowSize = getWindowSizeWithCapacity(policy, *timer, 100);
+    EXPECT_TRUE(windowSize >= 100 && windowSize <= 125);
+    EXPECT_TRUE(policy.getLatency() <= 1250);
+}
+
+uint32_t
+Test::getWindowSizeWithCapacity(DynamicThrottlePolicy &policy, DynamicTimer &timer, uint32_t capacity)
+{
+    SimpleMessage msg("foo");
+    SimpleReply reply("bar");
+
+    // The destination replies after 1000 ms, or later when more than capacity messages are pending.
+    for (uint32_t i = 0; i < 999; ++i) {
+        uint32_t numPending = 0;
+        while (policy.canSend(msg, numPending)) {
+            policy.processMessage(msg);
+            ++numPending;
+        }
+
+        timer._millis += std::max(1000ul, numPending * 1000ul / capacity);
+
+        for( ; numPending > 0 ; --numPending) {
+            policy.processReply(reply);
+        }
+    }
+    uint32_t ret = policy.getMaxPendingCount();
+    printf("getWindowSizeWithCapacity() = %d\n", ret);
+    return ret;
+}
+
 uint32_t
 Test::getWindowSize(DynamicThrottlePolicy &policy, DynamicTimer &timer, uint32_t maxPending)
 {
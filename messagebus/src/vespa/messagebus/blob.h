@@ -26,6 +26,17 @@ public:
         _payload(Alloc::alloc(s)),
         _sz(s)
     { }
+    /**
+     * Create a blob that takes over the given memory, of which the first
+     * s bytes are data.
+     *
+     * @param payload memory to take over
+     * @param s size of the data in payload
+     **/
+    Blob(Alloc payload, uint32_t s) :
+        _payload(std::move(payload)),
+        _sz(s)
+    { }
     Blob(Blob && rhs) noexcept :
         _payload(std::move(rhs._payload)),
         _sz(rhs._sz)
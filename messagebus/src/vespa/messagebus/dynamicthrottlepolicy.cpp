@@ -23,7 +23,16 @@ DynamicThrottlePolicy::DynamicThrottlePolicy() :
     _minWindowSize(_windowSizeIncrement),
     _windowSizeBackOff(0.9),
     _weight(1),
-    _localMaxThroughput(0)
+    _localMaxThroughput(0),
+    _latencyAdaptive(false),
+    _queueTarget(10),
+    _maxLatency(0),
+    _pending(0),
+    _timeOfLastPendingChange(_timer->getMilliTime()),
+    _pendingIntegral(0),
+    _latency(0),
+    _minLatency(0),
+    _queueEstimate(0)
 { }
 
 DynamicThrottlePolicy::DynamicThrottlePolicy(double windowSizeIncrement) :
@@ -41,7 +50,16 @@ DynamicThrottlePolicy::DynamicThrottlePolicy(double windowSizeIncrement) :
     _minWindowSize(_windowSizeIncrement),
     _windowSizeBackOff(0.9),
     _weight(1),
-    _localMaxThroughput(0)
+    _localMaxThroughput(0),
+    _latencyAdaptive(false),
+    _queueTarget(10),
+    _maxLatency(0),
+    _pending(0),
+    _timeOfLastPendingChange(_timer->getMilliTime()),
+    _pendingIntegral(0),
+    _latency(0),
+    _minLatency(0),
+    _queueEstimate(0)
 { }
 
 DynamicThrottlePolicy::DynamicThrottlePolicy(ITimer::UP timer) :
@@ -59,7 +77,16 @@ DynamicThrottlePolicy::DynamicThrottlePolicy(ITimer::UP timer) :
     _minWindowSize(_windowSizeIncrement),
     _windowSizeBackOff(0.9),
     _weight(1),
-    _localMaxThroughput(0)
+    _localMaxThroughput(0),
+    _latencyAdaptive(false),
+    _queueTarget(10),
+    _maxLatency(0),
+    _pending(0),
+    _timeOfLastPendingChange(_timer->getMilliTime()),
+    _pendingIntegral(0),
+    _latency(0),
+    _minLatency(0),
+    _queueEstimate(0)
 { }
 
 DynamicThrottlePolicy &
@@ -104,6 +131,27 @@ DynamicThrottlePolicy::setIdleTimePeriod(uint64_t period)
     return *this;
 }
 
+DynamicThrottlePolicy &
+DynamicThrottlePolicy::setLatencyAdaptive(bool enabled)
+{
+    _latencyAdaptive = enabled;
+    return *this;
+}
+
+DynamicThrottlePolicy &
+DynamicThrottlePolicy::setQueueTarget(double queueTarget)
+{
+    _queueTarget = queueTarget;
+    return *this;
+}
+
+DynamicThrottlePolicy &
+DynamicThrottlePolicy::setMaxLatency(double maxLatency)
+{
+    _maxLatency = maxLatency;
+    return *this;
+}
+
 DynamicThrottlePolicy &
 DynamicThrottlePolicy::setMaxWindowSize(double max)
 {
@@ -135,15 +183,28 @@ DynamicThrottlePolicy::canSend(const Message &msg, uint32_t pendingCount)
     uint64_t time = _timer->getMilliTime();
     if (time - _timeOfLastMessage > _idleTimePeriod) {
         _windowSize = std::min(_windowSize, (double) pendingCount + _windowSizeIncrement);
+        _minLatency = 0; // destination may have changed while idle, learn its latency again
     }
     _timeOfLastMessage = time;
     return pendingCount < _windowSize;
 }
 
+void
+DynamicThrottlePolicy::updatePendingIntegral()
+{
+    uint64_t time = _timer->getMilliTime();
+    _pendingIntegral += (double)_pending * (time - _timeOfLastPendingChange);
+    _timeOfLastPendingChange = time;
+}
+
 void
 DynamicThrottlePolicy::processMessage(Message &msg)
 {
     StaticThrottlePolicy::processMessage(msg);
+    if (_latencyAdaptive) {
+        updatePendingIntegral();
+        ++_pending;
+    }
     if (++_numSent < _windowSize * _resizeRate) {
         return;
     }
@@ -156,6 +217,18 @@ DynamicThrottlePolicy::processMessage(Message &msg)
     _numSent = 0;
     _numOk = 0;
 
+    if (_latencyAdaptive) {
+        resizeByLatency(throughput, elapsed);
+    } else {
+        resizeByThroughput(throughput, elapsed);
+    }
+    _windowSize = std::max(_minWindowSize, _windowSize);
+    _windowSize = std::min(_maxWindowSize, _windowSize);
+}
+
+void
+DynamicThrottlePolicy::resizeByThroughput(double throughput, double elapsed)
+{
     if (throughput > _localMaxThroughput * 1.01) {
         LOG(debug, "WindowSize = %.2f, Throughput = %f", _windowSize, throughput);
         _localMaxThroughput = throughput;
@@ -180,14 +253,44 @@ DynamicThrottlePolicy::processMessage(Message &msg)
             _windowSize += _weight*_windowSizeIncrement;
         }
     }
-    _windowSize = std::max(_minWindowSize, _windowSize);
-    _windowSize = std::min(_maxWindowSize, _windowSize);
+}
+
+void
+DynamicThrottlePolicy::resizeByLatency(double throughput, double elapsed)
+{
+    updatePendingIntegral();
+    double averagePending = _pendingIntegral / elapsed;
+    _pendingIntegral = 0;
+    if (!(elapsed > 0) || !(throughput > 0)) {
+        return; // nothing measured, keep window
+    }
+    // Little's law: pending = throughput * latency
+    _latency = averagePending / throughput;
+    _minLatency = (_minLatency > 0) ? std::min(_latency, _minLatency) : _latency;
+    double bandwidthDelay = throughput * _minLatency;
+    _queueEstimate = std::max(0.0, _windowSize - bandwidthDelay);
+    LOG(debug, "WindowSize = %.2f, Throughput = %f, Latency = %.2f, MinLatency = %.2f, Queued = %.2f",
+        _windowSize, throughput, _latency, _minLatency, _queueEstimate);
+
+    bool overLatency = (_maxLatency > 0) && (_latency > _maxLatency);
+    if (overLatency || (_queueEstimate > _queueTarget)) {
+        double newSize = overLatency ? throughput * _maxLatency : bandwidthDelay + _queueTarget;
+        _windowSize = std::min(newSize, _windowSize - _windowSizeIncrement);
+    } else if (_queueEstimate < _queueTarget / 2) {
+        _windowSize += _weight*_windowSizeIncrement;
+    }
 }
 
 void
 DynamicThrottlePolicy::processReply(Reply &reply)
 {
     StaticThrottlePolicy::processReply(reply);
+    if (_latencyAdaptive) {
+        updatePendingIntegral();
+        if (_pending > 0) {
+            --_pending;
+        }
+    }
     if (!reply.hasErrors()) {
         ++_numOk;
     }
@@ -12,6 +12,13 @@ namespace mbus {
  *
  * <b>NOTE:</b> By context, "pending" is refering to the number of sent messages that have not been replied to
  * yet.
+ *
+ * When latency adaptive resizing is enabled, the window is instead sized from the round trip latency
+ * estimated using Little's law (average pending messages divided by throughput). The lowest latency seen is
+ * taken as the latency of an unloaded destination (forgotten after an idle time period), and the difference between the current window and the
+ * bandwidth-delay product (throughput times lowest latency) estimates the number of messages queued at the
+ * destination. The window grows while that estimate is below half the queue target, and shrinks back to the
+ * bandwidth-delay product plus the queue target when it is above the target, in the spirit of TCP Vegas.
  */
 class DynamicThrottlePolicy: public StaticThrottlePolicy {
 public:
@@ -31,6 +38,19 @@ private:
     double      _windowSizeBackOff;
     double      _weight;
     double      _localMaxThroughput;
+    bool        _latencyAdaptive;
+    double      _queueTarget;
+    double      _maxLatency;
+    uint32_t    _pending;
+    uint64_t    _timeOfLastPendingChange;
+    double      _pendingIntegral;
+    double      _latency;
+    double      _minLatency;
+    double      _queueEstimate;
+
+    void updatePendingIntegral();
+    void resizeByThroughput(double throughput, double elapsed);
+    void resizeByLatency(double throughput, double elapsed);
 
 public:
     /**
@@ -117,6 +137,48 @@ public:
      */
     DynamicThrottlePolicy &setIdleTimePeriod(uint64_t period);
 
+    /**
+     * Enables or disables resizing the window from estimated latency instead of from measured efficiency.
+     *
+     * @param enabled Whether to resize from latency.
+     * @return This, to allow chaining.
+     */
+    DynamicThrottlePolicy &setLatencyAdaptive(bool enabled);
+
+    /**
+     * Sets the number of messages the latency adaptive algorithm aims to keep queued at the destination in
+     * addition to what is needed to cover the round trip time.
+     *
+     * @param queueTarget The number of messages to set.
+     * @return This, to allow chaining.
+     */
+    DynamicThrottlePolicy &setQueueTarget(double queueTarget);
+
+    /**
+     * Sets an upper bound on the estimated latency in milliseconds. When latency adaptive resizing is
+     * enabled the window shrinks whenever the estimate exceeds this. A value of 0 means no bound.
+     *
+     * @param maxLatency The bound to set.
+     * @return This, to allow chaining.
+     */
+    DynamicThrottlePolicy &setMaxLatency(double maxLatency);
+
+    /**
+     * Returns the latency in milliseconds estimated at the last resize, when latency adaptive.
+     */
+    double getLatency() const { return _latency; }
+
+    /**
+     * Returns the lowest latency in milliseconds estimated so far, when latency adaptive.
+     */
+    double getMinLatency() const { return _minLatency; }
+
+    /**
+     * Returns the number of messages estimated to be queued at the destination at the last resize, when
+     * latency adaptive.
+     */
+    double getQueueEstimate() const { return _queueEstimate; }
+
     /**
      * Sets the maximium number of pending operations allowed at any time, in
      * order to avoid using too much resources.
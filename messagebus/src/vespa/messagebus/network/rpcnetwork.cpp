@@ -124,7 +124,9 @@ RPCNetwork::RPCNetwork(const RPCNetworkParams &params) :
     _sendV1(std::make_unique<RPCSendV1>()),
     _sendV2(std::make_unique<RPCSendV2>()),
     _sendAdapters(),
-    _compressionConfig(params.getCompressionConfig())
+    _compressionConfig(params.getCompressionConfig()),
+    _batchWindowSecs(params.getBatchWindowSecs()),
+    _maxBatchSize(params.getMaxBatchSize())
 {
     _transport->SetDirectWrite(false);
     _transport->SetMaxInputBufferSize(params.getMaxInputBufferSize());
@@ -366,6 +368,7 @@ RPCNetwork::send(RPCNetwork::SendContext &ctx)
 void
 RPCNetwork::sync()
 {
+    _sendV2->flushBatches();
     SyncTask task(_scheduler);
     _executor->sync();
     task.await();
@@ -374,6 +377,7 @@ RPCNetwork::sync()
 void
 RPCNetwork::shutdown()
 {
+    _sendV2->flushBatches();
     _transport->ShutDown(false);
     _threadPool->Close();
     _executor->shutdown();
@@ -23,6 +23,7 @@ namespace slobrok {
 
 namespace mbus {
 
+class RPCSendV2;
 class RPCServicePool;
 class RPCTargetPool;
 class RPCNetworkParams;
@@ -74,9 +75,11 @@ private:
     int                                             _requestedPort;
     std::unique_ptr<vespalib::ThreadStackExecutor>  _executor;
     std::unique_ptr<RPCSendAdapter>                 _sendV1;
-    std::unique_ptr<RPCSendAdapter>                 _sendV2;
+    std::unique_ptr<RPCSendV2>                      _sendV2;
     SendAdapterMap                                  _sendAdapters;
     CompressionConfig                               _compressionConfig;
+    double                                          _batchWindowSecs;
+    uint32_t                                        _maxBatchSize;
 
     /**
      * Resolves and assigns a service address for the given recipient using the
@@ -225,6 +228,8 @@ public:
     void postShutdownHook() override;
     const slobrok::api::IMirrorAPI &getMirror() const override;
     CompressionConfig getCompressionConfig() { return _compressionConfig; }
+    double getBatchWindowSecs() const { return _batchWindowSecs; }
+    uint32_t getMaxBatchSize() const { return _maxBatchSize; }
     void invoke(FRT_RPCRequest *req);
     vespalib::Executor & getExecutor();
 };
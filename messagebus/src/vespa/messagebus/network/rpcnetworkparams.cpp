@@ -11,7 +11,9 @@ RPCNetworkParams::RPCNetworkParams() :
     _maxInputBufferSize(256*1024),
     _maxOutputBufferSize(256*1024),
     _connectionExpireSecs(30),
-    _compressionConfig(CompressionConfig::LZ4, 6, 90, 1024)
+    _compressionConfig(CompressionConfig::LZ4, 6, 90, 1024),
+    _batchWindowSecs(0),
+    _maxBatchSize(64)
 { }
 
 RPCNetworkParams::~RPCNetworkParams() {}
@@ -21,6 +21,8 @@ private:
     uint32_t          _maxOutputBufferSize;
     double            _connectionExpireSecs;
     CompressionConfig _compressionConfig;
+    double            _batchWindowSecs;
+    uint32_t          _maxBatchSize;
 
 public:
     RPCNetworkParams();
@@ -160,6 +162,51 @@ public:
         return *this;
     }
 
+    /**
+     * Returns the number of seconds a message may wait for others to the same
+     * recipient to be sent along with it in a single batch request. Batching
+     * is disabled when this is 0.
+     *
+     * @return The number of seconds.
+     */
+    double getBatchWindowSecs() const {
+        return _batchWindowSecs;
+    }
+
+    /**
+     * Sets the number of seconds a message may wait for others to the same
+     * recipient to be sent along with it in a single batch request. Only
+     * enable this when all recipients are able to receive batch requests.
+     *
+     * @param secs The number of seconds, 0 to disable batching.
+     * @return This, to allow chaining.
+     */
+    RPCNetworkParams &setBatchWindowSecs(double secs) {
+        _batchWindowSecs = secs;
+        return *this;
+    }
+
+    /**
+     * Returns the maximum number of messages sent in a single batch request.
+     *
+     * @return The number of messages.
+     */
+    uint32_t getMaxBatchSize() const {
+        return _maxBatchSize;
+    }
+
+    /**
+     * Sets the maximum number of messages sent in a single batch request. A
+     * batch is sent as soon as it is full, without waiting for the window.
+     *
+     * @param maxBatchSize The number of messages.
+     * @return This, to allow chaining.
+     */
+    RPCNetworkParams &setMaxBatchSize(uint32_t maxBatchSize) {
+        _maxBatchSize = maxBatchSize;
+        return *this;
+    }
+
     RPCNetworkParams &setCompressionConfig(CompressionConfig compressionConfig) {
         _compressionConfig = compressionConfig;
         return *this;
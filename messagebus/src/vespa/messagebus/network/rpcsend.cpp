@@ -78,10 +78,11 @@ RPCSend::attach(RPCNetwork &net)
 }
 
 void
-RPCSend::replyError(FRT_RPCRequest *req, const vespalib::Version &version, uint32_t traceLevel, const Error &err)
+RPCSend::replyError(FRT_RPCRequest *req, const vespalib::Version &version, uint32_t traceLevel, const Error &err,
+                    BatchReplyContext *batch, uint32_t batchIndex)
 {
     Reply::UP reply(new EmptyReply());
-    reply->setContext(Context(new ReplyContext(*req, version)));
+    reply->setContext(Context(new ReplyContext(*req, version, batch, batchIndex)));
     reply->getTrace().setLevel(traceLevel);
     reply->addError(err);
     handleReply(std::move(reply));
@@ -91,6 +92,10 @@ void
 RPCSend::handleDiscard(Context ctx)
 {
     ReplyContext::UP tmp(static_cast<ReplyContext*>(ctx.value.PTR));
+    if (tmp->getBatch() != nullptr) {
+        tmp->getBatch()->handleDiscard(tmp->getBatchIndex());
+        return;
+    }
     FRT_RPCRequest &req = tmp->getRequest();
     FNET_Channel *chn = req.GetContext()._value.CHANNEL;
     req.SubRef();
@@ -109,6 +114,13 @@ RPCSend::send(RoutingNode &recipient, const vespalib::Version &version, BlobRef
     send(recipient, version, FillByCopy(payload), timeRemaining);
 }
 
+bool
+RPCSend::sendInBatch(SendContext::UP &, const vespalib::Version &, const Route &, RPCServiceAddress &,
+                     const Message &, uint32_t, const PayLoadFiller &, uint64_t)
+{
+    return false;
+}
+
 void
 RPCSend::send(RoutingNode &recipient, const vespalib::Version &version,
               const PayLoadFiller & payload, uint64_t timeRemaining)
@@ -119,15 +131,20 @@ RPCSend::send(RoutingNode &recipient, const vespalib::Version &version,
     Route route = recipient.getRoute();
     Hop hop = route.removeHop(0);
 
-    FRT_RPCRequest *req = _net->allocRequest();
-    encodeRequest(*req, version, route, address, msg, recipient.getTrace().getLevel(),  payload, timeRemaining);
-
     if (ctx->getTrace().shouldTrace(TraceLevel::SEND_RECEIVE)) {
         ctx->getTrace().trace(TraceLevel::SEND_RECEIVE,
                               make_string("Sending message (version %s) from %s to '%s' with %.2f seconds timeout.",
                                           version.toString().c_str(), _clientIdent.c_str(),
                                           address.getServiceName().c_str(), ctx->getTimeout()));
     }
+    if (!hop.getIgnoreResult() &&
+        sendInBatch(ctx, version, route, address, msg, recipient.getTrace().getLevel(), payload, timeRemaining))
+    {
+        return;
+    }
+
+    FRT_RPCRequest *req = _net->allocRequest();
+    encodeRequest(*req, version, route, address, msg, recipient.getTrace().getLevel(),  payload, timeRemaining);
 
     if (hop.getIgnoreResult()) {
         address.getTarget().getFRTTarget().InvokeVoid(req);
@@ -151,35 +168,46 @@ RPCSend::RequestDone(FRT_RPCRequest *req)
     doRequestDone(req);
 }
 
+Error
+RPCSend::createRequestError(FRT_RPCRequest &req, const string &serviceName, double timeout) const
+{
+    switch (req.GetErrorCode()) {
+    case FRTE_RPC_TIMEOUT:
+        return Error(ErrorCode::TIMEOUT,
+                     make_string("A timeout occured while waiting for '%s' (%g seconds expired); %s",
+                                 serviceName.c_str(), timeout, req.GetErrorMessage()));
+    case FRTE_RPC_CONNECTION:
+        return Error(ErrorCode::CONNECTION_ERROR,
+                     make_string("A connection error occured for '%s'; %s",
+                                 serviceName.c_str(), req.GetErrorMessage()));
+    default:
+        return Error(ErrorCode::NETWORK_ERROR,
+                     make_string("A network error occured for '%s'; %s",
+                                 serviceName.c_str(), req.GetErrorMessage()));
+    }
+}
+
 void
 RPCSend::doRequestDone(FRT_RPCRequest *req) {
     SendContext::UP ctx(static_cast<SendContext*>(req->GetContext()._value.VOIDP));
     const string &serviceName = static_cast<RPCServiceAddress&>(ctx->getRecipient().getServiceAddress()).getServiceName();
     Reply::UP reply;
     Error error;
-    Trace & trace = ctx->getTrace();
     if (!req->CheckReturnTypes(getReturnSpec())) {
         reply.reset(new EmptyReply());
-        switch (req->GetErrorCode()) {
-            case FRTE_RPC_TIMEOUT:
-                error = Error(ErrorCode::TIMEOUT,
-                              make_string("A timeout occured while waiting for '%s' (%g seconds expired); %s",
-                                          serviceName.c_str(), ctx->getTimeout(), req->GetErrorMessage()));
-                break;
-            case FRTE_RPC_CONNECTION:
-                error = Error(ErrorCode::CONNECTION_ERROR,
-                              make_string("A connection error occured for '%s'; %s",
-                                          serviceName.c_str(), req->GetErrorMessage()));
-                break;
-            default:
-                error = Error(ErrorCode::NETWORK_ERROR,
-                              make_string("A network error occured for '%s'; %s",
-                                          serviceName.c_str(), req->GetErrorMessage()));
-        }
+        error = createRequestError(*req, serviceName, ctx->getTimeout());
     } else {
         FRT_Values &ret = *req->GetReturn();
-        reply = createReply(ret, serviceName, error, trace.getRoot());
+        reply = createReply(ret, serviceName, error, ctx->getTrace().getRoot());
     }
+    deliverReply(std::move(ctx), std::move(reply), error);
+    req->SubRef();
+}
+
+void
+RPCSend::deliverReply(SendContext::UP ctx, Reply::UP reply, const Error &error)
+{
+    Trace & trace = ctx->getTrace();
     if (trace.shouldTrace(TraceLevel::SEND_RECEIVE)) {
         trace.trace(TraceLevel::SEND_RECEIVE,
                     make_string("Reply (type %d) received at %s.", reply->getType(), _clientIdent.c_str()));
@@ -189,7 +217,6 @@ RPCSend::doRequestDone(FRT_RPCRequest *req) {
         reply->addError(error);
     }
     _net->getOwner().deliverReply(std::move(reply), ctx->getRecipient());
-    req->SubRef();
 }
 
 std::unique_ptr<Reply>
@@ -247,6 +274,10 @@ RPCSend::doHandleReply(const IProtocol * protocol, Reply::UP reply) {
             reply->addError(Error(ErrorCode::ENCODE_ERROR, "An error occured while encoding the reply, see log."));
         }
     }
+    if (ctx->getBatch() != nullptr) {
+        ctx->getBatch()->handleReply(ctx->getBatchIndex(), ctx->getVersion(), *reply, std::move(payload));
+        return;
+    }
     FRT_Values &ret = *req.GetReturn();
     createResponse(ret, version, *reply, std::move(payload));
     req.Return();
@@ -265,44 +296,59 @@ RPCSend::doRequest(FRT_RPCRequest *req)
     FRT_Values &args = *req->GetParams();
 
     std::unique_ptr<Params> params = toParams(args);
-    IProtocol * protocol = _net->getOwner().getProtocol(params->getProtocol());
-    if (protocol == nullptr) {
-        replyError(req, params->getVersion(), params->getTraceLevel(),
-                   Error(ErrorCode::UNKNOWN_PROTOCOL,
-                         make_string("Protocol '%s' is not known by %s.", params->getProtocol().c_str(), _serverIdent.c_str())));
+    Error error;
+    Message::UP msg = decodeMessage(*params, error);
+    req->DiscardBlobs();
+    if ( ! msg ) {
+        replyError(req, params->getVersion(), params->getTraceLevel(), error);
         return;
     }
-    Routable::UP routable = protocol->decode(params->getVersion(), params->getPayload());
-    req->DiscardBlobs();
+    deliverMessage(*req, std::move(msg), *params, nullptr, 0);
+}
+
+Message::UP
+RPCSend::decodeMessage(const Params &params, Error &error) const
+{
+    IProtocol * protocol = _net->getOwner().getProtocol(params.getProtocol());
+    if (protocol == nullptr) {
+        error = Error(ErrorCode::UNKNOWN_PROTOCOL,
+                      make_string("Protocol '%s' is not known by %s.", params.getProtocol().c_str(), _serverIdent.c_str()));
+        return Message::UP();
+    }
+    Routable::UP routable = protocol->decode(params.getVersion(), params.getPayload());
     if ( ! routable ) {
-        replyError(req, params->getVersion(), params->getTraceLevel(),
-                   Error(ErrorCode::DECODE_ERROR,
-                         make_string("Protocol '%s' failed to decode routable.", params->getProtocol().c_str())));
-        return;
+        error = Error(ErrorCode::DECODE_ERROR,
+                      make_string("Protocol '%s' failed to decode routable.", params.getProtocol().c_str()));
+        return Message::UP();
     }
     if (routable->isReply()) {
-        replyError(req, params->getVersion(), params->getTraceLevel(),
-                   Error(ErrorCode::DECODE_ERROR, "Payload decoded to a reply when expecting a mesage."));
-        return;
+        error = Error(ErrorCode::DECODE_ERROR, "Payload decoded to a reply when expecting a mesage.");
+        return Message::UP();
     }
-    Message::UP msg(static_cast<Message*>(routable.release()));
-    vespalib::stringref route = params->getRoute();
+    return Message::UP(static_cast<Message*>(routable.release()));
+}
+
+void
+RPCSend::deliverMessage(FRT_RPCRequest &req, Message::UP msg, const Params &params,
+                        BatchReplyContext *batch, uint32_t batchIndex)
+{
+    vespalib::stringref route = params.getRoute();
     if (!route.empty()) {
         msg->setRoute(Route::parse(route));
     }
-    msg->setContext(Context(new ReplyContext(*req, params->getVersion())));
+    msg->setContext(Context(new ReplyContext(req, params.getVersion(), batch, batchIndex)));
     msg->pushHandler(*this, *this);
-    msg->setRetryEnabled(params->useRetry());
-    msg->setRetry(params->getRetries());
+    msg->setRetryEnabled(params.useRetry());
+    msg->setRetry(params.getRetries());
     msg->setTimeReceivedNow();
-    msg->setTimeRemaining(params->getRemainingTime());
-    msg->getTrace().setLevel(params->getTraceLevel());
+    msg->setTimeRemaining(params.getRemainingTime());
+    msg->getTrace().setLevel(params.getTraceLevel());
     if (msg->getTrace().shouldTrace(TraceLevel::SEND_RECEIVE)) {
         msg->getTrace().trace(TraceLevel::SEND_RECEIVE,
                               make_string("Message (type %d) received at %s for session '%s'.",
-                                          msg->getType(), _serverIdent.c_str(), string(params->getSession()).c_str()));
+                                          msg->getType(), _serverIdent.c_str(), string(params.getSession()).c_str()));
     }
-    _net->getOwner().deliverMessage(std::move(msg), params->getSession());
+    _net->getOwner().deliverMessage(std::move(msg), params.getSession());
 }
 
 } // namespace mbus
@@ -21,6 +21,11 @@ class Message;
 class RPCServiceAddress;
 class IProtocol;
 
+namespace network::internal {
+    class SendContext;
+    class BatchReplyContext;
+}
+
 class PayLoadFiller
 {
 public:
@@ -64,10 +69,45 @@ protected:
     virtual void createResponse(FRT_Values & ret, const string & version, Reply & reply, Blob payload) const = 0;
     virtual std::unique_ptr<Params> toParams(const FRT_Values &param) const = 0;
 
+    using SendContext = network::internal::SendContext;
+    using BatchReplyContext = network::internal::BatchReplyContext;
+
+    /**
+     * Lets an adapter take over sending a message as part of a batch request
+     * to the recipient. The default is to send each message on its own.
+     *
+     * @return True if the adapter took over the send context.
+     */
+    virtual bool sendInBatch(std::unique_ptr<SendContext> &ctx, const vespalib::Version &version, const Route & route,
+                             RPCServiceAddress & address, const Message & msg, uint32_t traceLevel,
+                             const PayLoadFiller &filler, uint64_t timeRemaining);
+
     void send(RoutingNode &recipient, const vespalib::Version &version,
               const PayLoadFiller & filler, uint64_t timeRemaining);
     std::unique_ptr<Reply> decode(vespalib::stringref protocol, const vespalib::Version & version,
                                   BlobRef payload, Error & error) const;
+    /**
+     * Decodes the message carried by the given request parameters.
+     *
+     * @param params The parameters of the request.
+     * @param error  Set to the reason if the message could not be decoded.
+     * @return The message, or nullptr if it could not be decoded.
+     */
+    std::unique_ptr<Message> decodeMessage(const Params &params, Error &error) const;
+    /**
+     * Prepares a decoded message for being replied to through the given
+     * request, and hands it to the owner of the network.
+     */
+    void deliverMessage(FRT_RPCRequest &req, std::unique_ptr<Message> msg, const Params &params,
+                        BatchReplyContext *batch, uint32_t batchIndex);
+    /**
+     * Creates the error to give the reply to a message whose request failed.
+     */
+    Error createRequestError(FRT_RPCRequest &req, const string &serviceName, double timeout) const;
+    /**
+     * Hands the reply to a sent message to the owner of the network.
+     */
+    void deliverReply(std::unique_ptr<SendContext> ctx, std::unique_ptr<Reply> reply, const Error &error);
     /**
      * Send an error reply for a given request.
      *
@@ -75,18 +115,21 @@ protected:
      * @param version    The version to serialize for.
      * @param traceLevel The trace level to set in the reply.
      * @param err        The error to reply with.
+     * @param batch      The batch of the message within the request, if any.
+     * @param batchIndex The index of the message within the batch.
      */
-    void replyError(FRT_RPCRequest *req, const vespalib::Version &version, uint32_t traceLevel, const Error &err);
+    void replyError(FRT_RPCRequest *req, const vespalib::Version &version, uint32_t traceLevel, const Error &err,
+                    BatchReplyContext *batch = nullptr, uint32_t batchIndex = 0);
 public:
     RPCSend();
     ~RPCSend();
 
     void invoke(FRT_RPCRequest *req);
+    void attach(RPCNetwork &net) override;
 private:
     void doRequest(FRT_RPCRequest *req);
     void doRequestDone(FRT_RPCRequest *req);
     void doHandleReply(const IProtocol * protocol, std::unique_ptr<Reply> reply);
-    void attach(RPCNetwork &net) final override;
     void handleDiscard(Context ctx) final override;
     void sendByHandover(RoutingNode &recipient, const vespalib::Version &version,
                         Blob payload, uint64_t timeRemaining) final override;
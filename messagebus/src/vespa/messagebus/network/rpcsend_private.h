@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include <vespa/messagebus/blob.h>
 #include <vespa/messagebus/trace.h>
 #include <vespa/messagebus/routing/routingnode.h>
 
@@ -28,24 +29,50 @@ public:
     double getTimeout() { return _timeout; }
 };
 
+/**
+ * Collects the replies to the messages that arrived together in a single batch
+ * request, and returns them all once the last one is in. Each message of the
+ * batch is identified by its index in the request.
+ */
+class BatchReplyContext {
+public:
+    virtual ~BatchReplyContext() { }
+
+    /**
+     * Called with the reply to, and encoded payload of, a message of the batch.
+     */
+    virtual void handleReply(uint32_t index, const vespalib::Version &version, mbus::Reply &reply, mbus::Blob payload) = 0;
+
+    /**
+     * Called instead of handleReply() for a message of the batch that was discarded.
+     */
+    virtual void handleDiscard(uint32_t index) = 0;
+};
+
 /**
  * Implements a helper class to hold the necessary context to send a reply as an
  * rpc return value. This object is held in the callstack of the reply.
  */
 class ReplyContext {
 private:
-    FRT_RPCRequest   &_request;
-    vespalib::Version _version;
+    FRT_RPCRequest    &_request;
+    vespalib::Version  _version;
+    BatchReplyContext *_batch;
+    uint32_t           _batchIndex;
 
 public:
     typedef std::unique_ptr<ReplyContext> UP;
     ReplyContext(const ReplyContext &) = delete;
     ReplyContext & operator = (const ReplyContext &) = delete;
 
-    ReplyContext(FRT_RPCRequest &request, const vespalib::Version &version)
-            : _request(request), _version(version) { }
+    ReplyContext(FRT_RPCRequest &request, const vespalib::Version &version,
+                 BatchReplyContext *batch = nullptr, uint32_t batchIndex = 0)
+            : _request(request), _version(version), _batch(batch), _batchIndex(batchIndex) { }
     FRT_RPCRequest &getRequest() { return _request; }
     const vespalib::Version &getVersion() { return _version; }
+    /** Returns the batch the message arrived in, or nullptr if it arrived on its own. */
+    BatchReplyContext *getBatch() { return _batch; }
+    uint32_t getBatchIndex() const { return _batchIndex; }
 };
 
 
@@ -1,14 +1,18 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "rpcsendv2.h"
+#include "rpcsend_private.h"
 #include "rpcnetwork.h"
 #include "rpcserviceaddress.h"
 #include <vespa/messagebus/emptyreply.h>
+#include <vespa/messagebus/errorcode.h>
 #include <vespa/messagebus/tracelevel.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/util/compressor.h>
+#include <vespa/fnet/channel.h>
+#include <vespa/fnet/task.h>
 #include <vespa/fnet/frt/reflection.h>
 
 using vespalib::make_string;
@@ -25,12 +29,19 @@ using namespace vespalib::slime;
 
 namespace mbus {
 
+using network::internal::BatchReplyContext;
+using network::internal::SendContext;
+
 namespace {
 
 const char *METHOD_NAME   = "mbus.slime";
 const char *METHOD_PARAMS = "bixbix";
 const char *METHOD_RETURN = "bixbix";
 
+const char *BATCH_METHOD_NAME   = "mbus.slime.batch";
+const char *BATCH_METHOD_PARAMS = "BIX";
+const char *BATCH_METHOD_RETURN = "BIX";
+
 Memory VERSION_F("version");
 Memory ROUTE_F("route");
 Memory SESSION_F("session");
@@ -49,6 +60,152 @@ Memory SERVICE_F("service");
 
 }
 
+RPCSendV2::EncodedSlime::EncodedSlime()
+    : encoding(CompressionConfig::NONE),
+      decodedSize(0),
+      buf(),
+      size(0)
+{ }
+
+RPCSendV2::EncodedSlime::~EncodedSlime() = default;
+
+/**
+ * The messages queued for a single target while waiting for the batch window
+ * to close, or for the batch to fill up.
+ */
+struct RPCSendV2::PendingBatch {
+    FRT_Target                   *target;
+    double                        timeout;
+    std::vector<SendContext::UP>  contexts;
+    std::vector<EncodedSlime>     requests;
+
+    PendingBatch(FRT_Target &target_in)
+        : target(&target_in),
+          timeout(0),
+          contexts(),
+          requests()
+    {
+        target->AddRef();
+    }
+    ~PendingBatch() {
+        target->SubRef();
+    }
+};
+
+namespace {
+
+class FlushTask : public FNET_Task {
+public:
+    FlushTask(FNET_Scheduler &scheduler, RPCSendV2 &owner)
+        : FNET_Task(&scheduler),
+          _owner(owner)
+    { }
+    void PerformTask() override {
+        _owner.flushBatches();
+    }
+private:
+    RPCSendV2 &_owner;
+};
+
+/**
+ * The send contexts of the messages of a batch request in flight, held as
+ * the context of the request.
+ */
+struct SentBatch {
+    std::vector<SendContext::UP> contexts;
+};
+
+/**
+ * Collects the replies to the messages of a batch request received from a
+ * peer, and returns them once all are in. Deletes itself when done.
+ */
+class BatchReply : public BatchReplyContext {
+public:
+    BatchReply(const RPCSendV2 &owner, FRT_RPCRequest &req, uint32_t numMessages)
+        : _owner(owner),
+          _req(req),
+          _lock(),
+          _replies(numMessages),
+          _pending(numMessages),
+          _discarded(false)
+    { }
+
+    void handleReply(uint32_t index, const Version &version, Reply &reply, Blob payload) override {
+        RPCSendV2::EncodedSlime encoded = _owner.encodeResponse(version.toString(), reply, std::move(payload));
+        bool done;
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            _replies[index] = std::move(encoded);
+            done = (--_pending == 0);
+        }
+        if (done) {
+            finish();
+        }
+    }
+
+    void handleDiscard(uint32_t) override {
+        bool done;
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            _discarded = true;
+            done = (--_pending == 0);
+        }
+        if (done) {
+            finish();
+        }
+    }
+
+private:
+    void finish() {
+        if (_discarded) {
+            FNET_Channel *chn = _req.GetContext()._value.CHANNEL;
+            _req.SubRef();
+            chn->Free();
+        } else {
+            FRT_Values &ret = *_req.GetReturn();
+            uint32_t numReplies = _replies.size();
+            uint8_t *encodings = ret.AddInt8Array(numReplies);
+            uint32_t *decodedSizes = ret.AddInt32Array(numReplies);
+            FRT_DataValue *payloads = ret.AddDataArray(numReplies);
+            for (uint32_t i = 0; i < numReplies; ++i) {
+                const RPCSendV2::EncodedSlime &reply = _replies[i];
+                encodings[i] = reply.encoding;
+                decodedSizes[i] = reply.decodedSize;
+                ret.SetData(&payloads[i], static_cast<const char *>(reply.buf.get()), reply.size);
+            }
+            _req.Return();
+        }
+        delete this;
+    }
+
+    const RPCSendV2                       &_owner;
+    FRT_RPCRequest                        &_req;
+    std::mutex                             _lock;
+    std::vector<RPCSendV2::EncodedSlime>   _replies;
+    uint32_t                               _pending;
+    bool                                   _discarded;
+};
+
+}
+
+RPCSendV2::RPCSendV2()
+    : RPCSend(),
+      _batchWindow(0),
+      _maxBatchSize(1),
+      _batchLock(),
+      _pendingBatches(),
+      _flushScheduled(false),
+      _flushTask(),
+      _batchWaiter(*this)
+{ }
+
+RPCSendV2::~RPCSendV2()
+{
+    if (_flushTask) {
+        _flushTask->Kill();
+    }
+}
+
 bool RPCSendV2::isCompatible(stringref method, stringref request, stringref response)
 {
     return  (method == METHOD_NAME) &&
@@ -56,6 +213,15 @@ bool RPCSendV2::isCompatible(stringref method, stringref request, stringref resp
             (response == METHOD_RETURN);
 }
 
+void
+RPCSendV2::attach(RPCNetwork &net)
+{
+    RPCSend::attach(net);
+    _batchWindow = net.getBatchWindowSecs();
+    _maxBatchSize = std::max(1u, net.getMaxBatchSize());
+    _flushTask = std::make_unique<FlushTask>(net.getScheduler(), *this);
+}
+
 void
 RPCSendV2::build(FRT_ReflectionBuilder & builder)
 {
@@ -73,6 +239,16 @@ RPCSendV2::build(FRT_ReflectionBuilder & builder)
     builder.ReturnDesc("body_encoding",  "0=raw, 6=lz4");
     builder.ReturnDesc("body_decoded_size", "Uncompressed body blob size");
     builder.ReturnDesc("body_payload", "The reply body blob in slime.");
+
+    builder.DefineMethod(BATCH_METHOD_NAME, BATCH_METHOD_PARAMS, BATCH_METHOD_RETURN, true,
+                         FRT_METHOD(RPCSendV2::invokeBatch), this);
+    builder.MethodDesc("Send a batch of message bus slime requests and get all their replies back together.");
+    builder.ParamDesc("encodings", "Per message: 0=raw, 6=lz4");
+    builder.ParamDesc("decoded_sizes", "Per message: Uncompressed blob size");
+    builder.ParamDesc("payloads", "Per message: The message blob in slime");
+    builder.ReturnDesc("encodings", "Per message: 0=raw, 6=lz4");
+    builder.ReturnDesc("decoded_sizes", "Per message: Uncompressed blob size");
+    builder.ReturnDesc("payloads", "Per message: The reply blob in slime.");
 }
 
 const char *
@@ -81,6 +257,7 @@ RPCSendV2::getReturnSpec() const {
 }
 
 namespace {
+
 class OutputBuf : public vespalib::Output {
 public:
     OutputBuf(size_t estimatedSize) : _buf(estimatedSize) { }
@@ -96,20 +273,67 @@ private:
     }
     DataBuffer _buf;
 };
+
+/**
+ * Encodes the given slime and compresses it according to the given config.
+ * When the data is not compressed, the encode buffer is handed over as it is
+ * instead of being copied.
+ */
+RPCSendV2::EncodedSlime
+encodeSlime(const CompressionConfig &config, const Slime &slime)
+{
+    OutputBuf rBuf(8192);
+    BinaryFormat::encode(slime, rBuf);
+    DataBuffer &plain = rBuf.getBuf();
+    ConstBufferRef toCompress(plain.getData(), plain.getDataLen());
+    RPCSendV2::EncodedSlime encoded;
+    encoded.decodedSize = toCompress.size();
+    DataBuffer compressed(0);
+    if ((config.type != CompressionConfig::NONE) && (toCompress.size() >= config.minSize)) {
+        compressed.ensureFree(vespalib::roundUp2inN(toCompress.size()));
+        encoded.encoding = compress(config, toCompress, compressed, false);
+    }
+    if (encoded.encoding == CompressionConfig::NONE) {
+        encoded.size = toCompress.size();
+        encoded.buf = plain.stealBuffer();
+    } else {
+        encoded.size = compressed.getDataLen();
+        encoded.buf = compressed.stealBuffer();
+    }
+    return encoded;
 }
 
 void
-RPCSendV2::encodeRequest(FRT_RPCRequest &req, const Version &version, const Route & route,
+addEncoded(FRT_Values &values, RPCSendV2::EncodedSlime encoded)
+{
+    values.AddInt8(encoded.encoding);
+    values.AddInt32(encoded.decodedSize);
+    values.AddData(std::move(encoded.buf), encoded.size);
+}
+
+/**
+ * Decodes the given payload into slime. The payload blob of the slime is
+ * not copied, but references the uncompressed buffer (which in turn
+ * references the rpc data itself when the payload is not compressed).
+ * Both must be kept alive for as long as the payload blob is used.
+ */
+void
+decodeSlime(uint8_t encoding, uint32_t uncompressedSize, const FRT_DataValue &data,
+            DataBuffer &uncompressed, Slime &slime)
+{
+    ConstBufferRef blob(data._buf, data._len);
+    decompress(CompressionConfig::toType(encoding), uncompressedSize, blob, uncompressed, true);
+    assert(uncompressedSize == uncompressed.getDataLen());
+    BinaryFormat::decode_borrowed(Memory(uncompressed.getData(), uncompressed.getDataLen()), slime);
+}
+
+}
+
+RPCSendV2::EncodedSlime
+RPCSendV2::encodeRequest(const Version &version, const Route & route,
                          const RPCServiceAddress & address, const Message & msg, uint32_t traceLevel,
                          const PayLoadFiller &filler, uint64_t timeRemaining) const
 {
-    FRT_Values &args = *req.GetParams();
-    req.SetMethodName(METHOD_NAME);
-    // Place holder for auxillary data to be transfered later.
-    args.AddInt8(CompressionConfig::NONE);
-    args.AddInt32(0);
-    args.AddData("", 0);
-
     Slime slime;
     Cursor & root = slime.setObject();
 
@@ -123,15 +347,129 @@ RPCSendV2::encodeRequest(FRT_RPCRequest &req, const Version &version, const Rout
     root.setLong(TRACELEVEL_F, traceLevel);
     filler.fill(BLOB_F, root);
 
-    OutputBuf rBuf(8192);
-    BinaryFormat::encode(slime, rBuf);
-    ConstBufferRef toCompress(rBuf.getBuf().getData(), rBuf.getBuf().getDataLen());
-    DataBuffer buf(vespalib::roundUp2inN(rBuf.getBuf().getDataLen()));
-    CompressionConfig::Type type = compress(_net->getCompressionConfig(), toCompress, buf, false);
+    return encodeSlime(_net->getCompressionConfig(), slime);
+}
 
-    args.AddInt8(type);
-    args.AddInt32(toCompress.size());
-    args.AddData(buf.stealBuffer(), buf.getDataLen());
+void
+RPCSendV2::encodeRequest(FRT_RPCRequest &req, const Version &version, const Route & route,
+                         const RPCServiceAddress & address, const Message & msg, uint32_t traceLevel,
+                         const PayLoadFiller &filler, uint64_t timeRemaining) const
+{
+    FRT_Values &args = *req.GetParams();
+    req.SetMethodName(METHOD_NAME);
+    // Place holder for auxillary data to be transfered later.
+    args.AddInt8(CompressionConfig::NONE);
+    args.AddInt32(0);
+    args.AddData("", 0);
+
+    addEncoded(args, encodeRequest(version, route, address, msg, traceLevel, filler, timeRemaining));
+}
+
+bool
+RPCSendV2::sendInBatch(SendContext::UP &ctx, const Version &version, const Route & route,
+                       RPCServiceAddress & address, const Message & msg, uint32_t traceLevel,
+                       const PayLoadFiller &filler, uint64_t timeRemaining)
+{
+    if (_batchWindow <= 0) {
+        return false;
+    }
+    EncodedSlime request = encodeRequest(version, route, address, msg, traceLevel, filler, timeRemaining);
+    FRT_Target &target = address.getTarget().getFRTTarget();
+    std::unique_ptr<PendingBatch> full;
+    bool scheduleFlush = false;
+    {
+        std::lock_guard<std::mutex> guard(_batchLock);
+        std::unique_ptr<PendingBatch> &batch = _pendingBatches[&target];
+        if ( ! batch) {
+            batch = std::make_unique<PendingBatch>(target);
+        }
+        batch->timeout = std::max(batch->timeout, ctx->getTimeout());
+        batch->contexts.push_back(std::move(ctx));
+        batch->requests.push_back(std::move(request));
+        if (batch->contexts.size() >= _maxBatchSize) {
+            full = std::move(batch);
+            _pendingBatches.erase(&target);
+        } else if ( ! _flushScheduled) {
+            _flushScheduled = true;
+            scheduleFlush = true;
+        }
+    }
+    if (scheduleFlush) {
+        _flushTask->Schedule(_batchWindow);
+    }
+    if (full) {
+        sendBatch(std::move(full));
+    }
+    return true;
+}
+
+void
+RPCSendV2::flushBatches()
+{
+    PendingBatchMap batches;
+    {
+        std::lock_guard<std::mutex> guard(_batchLock);
+        batches.swap(_pendingBatches);
+        _flushScheduled = false;
+    }
+    for (auto &entry : batches) {
+        sendBatch(std::move(entry.second));
+    }
+}
+
+void
+RPCSendV2::sendBatch(std::unique_ptr<PendingBatch> batch)
+{
+    uint32_t numMessages = batch->requests.size();
+    FRT_RPCRequest *req = _net->allocRequest();
+    req->SetMethodName(BATCH_METHOD_NAME);
+    FRT_Values &args = *req->GetParams();
+    uint8_t *encodings = args.AddInt8Array(numMessages);
+    uint32_t *decodedSizes = args.AddInt32Array(numMessages);
+    FRT_DataValue *payloads = args.AddDataArray(numMessages);
+    for (uint32_t i = 0; i < numMessages; ++i) {
+        const EncodedSlime &request = batch->requests[i];
+        encodings[i] = request.encoding;
+        decodedSizes[i] = request.decodedSize;
+        args.SetData(&payloads[i], static_cast<const char *>(request.buf.get()), request.size);
+    }
+    auto *sent = new SentBatch();
+    sent->contexts.swap(batch->contexts);
+    req->SetContext(FNET_Context(sent));
+    batch->target->InvokeAsync(req, batch->timeout, &_batchWaiter);
+}
+
+void
+RPCSendV2::BatchRequestWaiter::RequestDone(FRT_RPCRequest *req)
+{
+    _owner.batchRequestDone(req);
+}
+
+void
+RPCSendV2::batchRequestDone(FRT_RPCRequest *req)
+{
+    std::unique_ptr<SentBatch> sent(static_cast<SentBatch*>(req->GetContext()._value.VOIDP));
+    uint32_t numMessages = sent->contexts.size();
+    FRT_Values &ret = *req->GetReturn();
+    bool ok = req->CheckReturnTypes(BATCH_METHOD_RETURN) &&
+              (ret[0]._int8_array._len == numMessages) &&
+              (ret[1]._int32_array._len == numMessages) &&
+              (ret[2]._data_array._len == numMessages);
+    for (uint32_t i = 0; i < numMessages; ++i) {
+        SendContext::UP ctx = std::move(sent->contexts[i]);
+        const string &serviceName = static_cast<RPCServiceAddress&>(ctx->getRecipient().getServiceAddress()).getServiceName();
+        Reply::UP reply;
+        Error error;
+        if ( ! ok) {
+            reply.reset(new EmptyReply());
+            error = createRequestError(*req, serviceName, ctx->getTimeout());
+        } else {
+            reply = createReply(ret[0]._int8_array._pt[i], ret[1]._int32_array._pt[i], ret[2]._data_array._pt[i],
+                                serviceName, error, ctx->getTrace().getRoot());
+        }
+        deliverReply(std::move(ctx), std::move(reply), error);
+    }
+    req->SubRef();
 }
 
 namespace {
@@ -139,16 +477,11 @@ namespace {
 class ParamsV2 : public RPCSend::Params
 {
 public:
-    ParamsV2(const FRT_Values &arg)
-        : _slime()
+    ParamsV2(uint8_t encoding, uint32_t uncompressedSize, const FRT_DataValue &data)
+        : _uncompressed(0),
+          _slime()
     {
-        uint8_t encoding = arg[3]._intval8;
-        uint32_t uncompressedSize = arg[4]._intval32;
-        DataBuffer uncompressed(arg[5]._data._buf, arg[5]._data._len);
-        ConstBufferRef blob(arg[5]._data._buf, arg[5]._data._len);
-        decompress(CompressionConfig::toType(encoding), uncompressedSize, blob, uncompressed, true);
-        assert(uncompressedSize == uncompressed.getDataLen());
-        BinaryFormat::decode(Memory(uncompressed.getData(), uncompressed.getDataLen()), _slime);
+        decodeSlime(encoding, uncompressedSize, data, _uncompressed, _slime);
     }
 
     uint32_t getTraceLevel() const override { return _slime.get()[TRACELEVEL_F].asLong(); }
@@ -168,12 +501,14 @@ public:
     stringref getProtocol() const override {
         return _slime.get()[PROTOCOL_F].asString().make_stringref();
     }
+    // Only valid until the blobs of the request are discarded.
     BlobRef getPayload() const override {
         Memory m = _slime.get()[BLOB_F].asData();
         return BlobRef(m.data, m.size);
     }
 private:
-    Slime _slime;
+    DataBuffer _uncompressed;
+    Slime      _slime;
 };
 
 }
@@ -181,21 +516,64 @@ private:
 std::unique_ptr<RPCSend::Params>
 RPCSendV2::toParams(const FRT_Values &args) const
 {
-    return std::make_unique<ParamsV2>(args);
+    return std::make_unique<ParamsV2>(args[3]._intval8, args[4]._intval32, args[5]._data);
+}
+
+void
+RPCSendV2::invokeBatch(FRT_RPCRequest *req)
+{
+    FRT_Values &args = *req->GetParams();
+    uint32_t numMessages = args[0]._int8_array._len;
+    if ((args[1]._int32_array._len != numMessages) || (args[2]._data_array._len != numMessages)) {
+        req->SetError(FRTE_RPC_WRONG_PARAMS, "All parameter arrays must have the same length.");
+        return;
+    }
+    if (numMessages == 0) {
+        FRT_Values &ret = *req->GetReturn();
+        ret.AddInt8Array(0);
+        ret.AddInt32Array(0);
+        ret.AddDataArray(0);
+        return;
+    }
+    req->Detach();
+
+    // All messages are decoded before any of them is delivered, since the
+    // request may be returned as soon as the last reply is in.
+    auto *batch = new BatchReply(*this, *req, numMessages);
+    std::vector<std::unique_ptr<Params>> params;
+    std::vector<Message::UP> msgs;
+    std::vector<Error> errors(numMessages);
+    params.reserve(numMessages);
+    msgs.reserve(numMessages);
+    for (uint32_t i = 0; i < numMessages; ++i) {
+        params.push_back(std::make_unique<ParamsV2>(args[0]._int8_array._pt[i], args[1]._int32_array._pt[i],
+                                                    args[2]._data_array._pt[i]));
+        msgs.push_back(decodeMessage(*params.back(), errors[i]));
+    }
+    req->DiscardBlobs();
+    for (uint32_t i = 0; i < numMessages; ++i) {
+        if ( ! msgs[i]) {
+            replyError(req, params[i]->getVersion(), params[i]->getTraceLevel(), errors[i], batch, i);
+        } else {
+            deliverMessage(*req, std::move(msgs[i]), *params[i], batch, i);
+        }
+    }
 }
 
 std::unique_ptr<Reply>
 RPCSendV2::createReply(const FRT_Values & ret, const string & serviceName,
                        Error & error, vespalib::TraceNode & rootTrace) const
 {
-    uint8_t encoding = ret[3]._intval8;
-    uint32_t uncompressedSize = ret[4]._intval32;
-    DataBuffer uncompressed(ret[5]._data._buf, ret[5]._data._len);
-    ConstBufferRef blob(ret[5]._data._buf, ret[5]._data._len);
-    decompress(CompressionConfig::toType(encoding), uncompressedSize, blob, uncompressed, true);
-    assert(uncompressedSize == uncompressed.getDataLen());
+    return createReply(ret[3]._intval8, ret[4]._intval32, ret[5]._data, serviceName, error, rootTrace);
+}
+
+std::unique_ptr<Reply>
+RPCSendV2::createReply(uint8_t encoding, uint32_t decodedSize, const FRT_DataValue &data,
+                       const string & serviceName, Error & error, vespalib::TraceNode & rootTrace) const
+{
+    DataBuffer uncompressed(0);
     Slime slime;
-    BinaryFormat::decode(Memory(uncompressed.getData(), uncompressed.getDataLen()), slime);
+    decodeSlime(encoding, decodedSize, data, uncompressed, slime);
     Inspector & root = slime.get();
     Version version(root[VERSION_F].asString().make_string());
     Memory payload = root[BLOB_F].asData();
@@ -219,14 +597,9 @@ RPCSendV2::createReply(const FRT_Values & ret, const string & serviceName,
     return reply;
 }
 
-void
-RPCSendV2::createResponse(FRT_Values & ret, const string & version, Reply & reply, Blob payload) const
+RPCSendV2::EncodedSlime
+RPCSendV2::encodeResponse(const string & version, Reply & reply, Blob payload) const
 {
-    // Place holder for auxillary data to be transfered later.
-    ret.AddInt8(CompressionConfig::NONE);
-    ret.AddInt32(0);
-    ret.AddData("", 0);
-
     Slime slime;
     Cursor & root = slime.setObject();
 
@@ -248,16 +621,18 @@ RPCSendV2::createResponse(FRT_Values & ret, const string & version, Reply & repl
         }
     }
 
-    OutputBuf rBuf(8192);
-    BinaryFormat::encode(slime, rBuf);
-    ConstBufferRef toCompress(rBuf.getBuf().getData(), rBuf.getBuf().getDataLen());
-    DataBuffer buf(vespalib::roundUp2inN(rBuf.getBuf().getDataLen()));
-    CompressionConfig::Type type = compress(_net->getCompressionConfig(), toCompress, buf, false);
+    return encodeSlime(_net->getCompressionConfig(), slime);
+}
 
-    ret.AddInt8(type);
-    ret.AddInt32(toCompress.size());
-    ret.AddData(buf.stealBuffer(), buf.getDataLen());
+void
+RPCSendV2::createResponse(FRT_Values & ret, const string & version, Reply & reply, Blob payload) const
+{
+    // Place holder for auxillary data to be transfered later.
+    ret.AddInt8(CompressionConfig::NONE);
+    ret.AddInt32(0);
+    ret.AddData("", 0);
 
+    addEncoded(ret, encodeResponse(version, reply, std::move(payload)));
 }
 
 } // namespace mbus
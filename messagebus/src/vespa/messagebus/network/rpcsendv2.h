@@ -2,23 +2,92 @@
 #pragma once
 
 #include "rpcsend.h"
+#include <vespa/vespalib/util/alloc.h>
+#include <map>
+#include <mutex>
+
+class FNET_Task;
+class FRT_Target;
 
 namespace mbus {
 
+/**
+ * Sends messages as slime encoded requests. If the network is set up with a
+ * batch window (see RPCNetworkParams::setBatchWindowSecs()), messages to the
+ * same target that are sent within the window of each other are packed into
+ * a single batch request, and their replies are returned together once the
+ * last of them is ready.
+ */
 class RPCSendV2 : public RPCSend {
 public:
+    RPCSendV2();
+    ~RPCSendV2();
     static bool isCompatible(vespalib::stringref method, vespalib::stringref request, vespalib::stringref response);
+    void attach(RPCNetwork &net) override;
+
+    /**
+     * Sends all messages queued for batching right away.
+     */
+    void flushBatches();
+
+    /**
+     * An encoded (and possibly compressed) slime object along with how it is
+     * encoded.
+     */
+    struct EncodedSlime {
+        uint8_t                encoding;
+        uint32_t               decodedSize;
+        vespalib::alloc::Alloc buf;
+        uint32_t               size;
+
+        EncodedSlime();
+        EncodedSlime(EncodedSlime &&) noexcept = default;
+        EncodedSlime & operator = (EncodedSlime &&) noexcept = default;
+        ~EncodedSlime();
+    };
+    EncodedSlime encodeResponse(const string & version, Reply & reply, Blob payload) const;
+
 private:
+    class BatchRequestWaiter : public FRT_IRequestWait {
+    public:
+        BatchRequestWaiter(RPCSendV2 &owner) : _owner(owner) { }
+        void RequestDone(FRT_RPCRequest *req) override;
+    private:
+        RPCSendV2 &_owner;
+    };
+    struct PendingBatch;
+    using PendingBatchMap = std::map<FRT_Target *, std::unique_ptr<PendingBatch>>;
+
+    double                     _batchWindow;
+    uint32_t                   _maxBatchSize;
+    std::mutex                 _batchLock;
+    PendingBatchMap            _pendingBatches;
+    bool                       _flushScheduled;
+    std::unique_ptr<FNET_Task> _flushTask;
+    BatchRequestWaiter         _batchWaiter;
+
     void build(FRT_ReflectionBuilder & builder) override;
     const char * getReturnSpec() const override;
     std::unique_ptr<Params> toParams(const FRT_Values &param) const override;
     void encodeRequest(FRT_RPCRequest &req, const vespalib::Version &version, const Route & route,
                        const RPCServiceAddress & address, const Message & msg, uint32_t traceLevel,
                        const PayLoadFiller &filler, uint64_t timeRemaining) const override;
+    bool sendInBatch(std::unique_ptr<SendContext> &ctx, const vespalib::Version &version, const Route & route,
+                     RPCServiceAddress & address, const Message & msg, uint32_t traceLevel,
+                     const PayLoadFiller &filler, uint64_t timeRemaining) override;
 
     std::unique_ptr<Reply> createReply(const FRT_Values & response, const string & serviceName,
                                        Error & error, vespalib::TraceNode & rootTrace) const override;
+    std::unique_ptr<Reply> createReply(uint8_t encoding, uint32_t decodedSize, const FRT_DataValue &payload,
+                                       const string & serviceName, Error & error, vespalib::TraceNode & rootTrace) const;
     void createResponse(FRT_Values & ret, const string & version, Reply & reply, Blob payload) const override;
+    EncodedSlime encodeRequest(const vespalib::Version &version, const Route & route,
+                               const RPCServiceAddress & address, const Message & msg, uint32_t traceLevel,
+                               const PayLoadFiller &filler, uint64_t timeRemaining) const;
+
+    void sendBatch(std::unique_ptr<PendingBatch> batch);
+    void invokeBatch(FRT_RPCRequest *req);
+    void batchRequestDone(FRT_RPCRequest *req);
 };
 
 } // namespace mbus
@@ -7,26 +7,29 @@ using vespalib::make_string;
 
 namespace mbus {
 
+static_assert(Sequencer::NUM_SHARDS == 32, "shard id is the top 5 bits of the hash");
+
 Sequencer::Sequencer(IMessageHandler &sender) :
-    _lock(),
     _sender(sender),
-    _seqMap()
+    _shards()
 {
     // empty
 }
 
 Sequencer::~Sequencer()
 {
-    for (QueueMap::iterator it = _seqMap.begin(); it != _seqMap.end(); ++it) {
-        MessageQueue *queue = it->second;
-        if (queue != nullptr) {
-            while (queue->size() > 0) {
-                Message *msg = queue->front();
-                queue->pop();
-                msg->discard();
-                delete msg;
+    for (Shard &shard : _shards) {
+        for (QueueMap::iterator it = shard.seqMap.begin(); it != shard.seqMap.end(); ++it) {
+            MessageQueue *queue = it->second;
+            if (queue != nullptr) {
+                while (queue->size() > 0) {
+                    Message *msg = queue->front();
+                    queue->pop();
+                    msg->discard();
+                    delete msg;
+                }
+                delete queue;
             }
-            delete queue;
         }
     }
 }
@@ -37,9 +40,10 @@ Sequencer::filter(Message::UP msg)
     uint64_t seqId = msg->getSequenceId();
     msg->setContext(Context(seqId));
     {
-        vespalib::LockGuard guard(_lock);
-        QueueMap::iterator it = _seqMap.find(seqId);
-        if (it != _seqMap.end()) {
+        Shard &shard = getShard(seqId);
+        vespalib::LockGuard guard(shard.lock);
+        QueueMap::iterator it = shard.seqMap.find(seqId);
+        if (it != shard.seqMap.end()) {
             if (it->second == nullptr) {
                 it->second = new MessageQueue();
             }
@@ -49,7 +53,7 @@ Sequencer::filter(Message::UP msg)
             msg.release();
             return Message::UP();
         }
-        _seqMap[seqId] = nullptr; // insert empty queue
+        shard.seqMap[seqId] = nullptr; // insert empty queue
     }
     return std::move(msg);
 }
@@ -85,15 +89,16 @@ Sequencer::handleReply(Reply::UP reply)
                             make_string("Sequencer received reply with sequence id '%" PRIu64 "'.", seq));
     Message::UP msg;
     {
-        vespalib::LockGuard guard(_lock);
-        QueueMap::iterator it = _seqMap.find(seq);
+        Shard &shard = getShard(seq);
+        vespalib::LockGuard guard(shard.lock);
+        QueueMap::iterator it = shard.seqMap.find(seq);
+        assert(it != shard.seqMap.end());
         MessageQueue *que = it->second;
-        assert(it != _seqMap.end());
         if (que == nullptr || que->size() == 0) {
             if (que != nullptr) {
                 delete que;
             }
-            _seqMap.erase(it);
+            shard.seqMap.erase(it);
         } else {
             msg.reset(que->front());
             que->pop();
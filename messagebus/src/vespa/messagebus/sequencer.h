@@ -3,6 +3,7 @@
 #pragma once
 
 #include <map>
+#include <array>
 #include <vespa/vespalib/util/sync.h>
 #include "imessagehandler.h"
 #include "ireplyhandler.h"
@@ -16,17 +17,33 @@ namespace mbus {
  * A Sequencer ensures correct sequencing of pending messages. When a Sequencer is created, it is given an
  * object implementing the IMessageHandler API to use for sending messages. This class is used by the
  * SourceSession class and is not intended for external use.
+ *
+ * The sequencing state is split into shards by a hash of the sequence id, each with its own lock, so that
+ * threads sending messages with different sequence ids rarely contend. No lock is held while sending.
  */
 class Sequencer : public IMessageHandler,
                   public IReplyHandler
 {
-private:
-    vespalib::Lock   _lock;
-    IMessageHandler &_sender;
+public:
+    static constexpr size_t NUM_SHARDS = 32;
 
+private:
     typedef Queue<Message*> MessageQueue;
     typedef std::map<uint64_t, MessageQueue*> QueueMap;
-    QueueMap _seqMap;
+
+    struct Shard {
+        vespalib::Lock lock;
+        QueueMap       seqMap;
+    };
+
+    IMessageHandler                 &_sender;
+    std::array<Shard, NUM_SHARDS>    _shards;
+
+    static size_t getShardId(uint64_t seqId) {
+        // Fibonacci hashing, sequence ids are often bucket ids with most entropy in the high bits
+        return (seqId * 0x9e3779b97f4a7c15ul) >> 59;
+    }
+    Shard &getShard(uint64_t seqId) { return _shards[getShardId(seqId)]; }
 
 private:
     /**
@@ -3,6 +3,7 @@
 #include <vespa/vdstestlib/cppunit/macros.h>
 #include <vespa/vespalib/objects/floatingpointtype.h>
 #include <vespa/metrics/countmetric.h>
+#include <thread>
 
 using vespalib::Double;
 
@@ -10,9 +11,11 @@ namespace metrics {
 
 struct CountMetricTest : public CppUnit::TestFixture {
     void testLongCountMetric();
+    void testThreadShardedCountMetric();
 
     CPPUNIT_TEST_SUITE(CountMetricTest);
     CPPUNIT_TEST(testLongCountMetric);
+    CPPUNIT_TEST(testThreadShardedCountMetric);
     CPPUNIT_TEST_SUITE_END();
 };
 
@@ -50,4 +53,37 @@ void CountMetricTest::testLongCountMetric()
 //    (void) expected;
 }
 
+void CountMetricTest::testThreadShardedCountMetric()
+{
+    LongCountMetric m("test", "tag", "description");
+    m.useThreadShards(4);
+    CPPUNIT_ASSERT(m.usesThreadShards());
+    CPPUNIT_ASSERT(!m.used());
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < 8; ++i) {
+        threads.emplace_back([&m]() {
+            for (uint32_t j = 0; j < 10000; ++j) {
+                m.inc();
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    CPPUNIT_ASSERT_EQUAL(uint64_t(80000), m.getValue());
+    m.dec(5);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(79995), m.getValue());
+
+    LongCountMetric copy(m);
+    CPPUNIT_ASSERT(!copy.usesThreadShards());
+    CPPUNIT_ASSERT_EQUAL(uint64_t(79995), copy.getValue());
+
+    m.set(10);
+    m.inc(2);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(12), m.getValue());
+    m.reset();
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0), m.getValue());
+    CPPUNIT_ASSERT(!m.used());
+}
+
 }
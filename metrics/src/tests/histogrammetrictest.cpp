@@ -0,0 +1,117 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vdstestlib/cppunit/macros.h>
+#include <vespa/metrics/histogrammetric.h>
+#include <vespa/metrics/metricset.h>
+#include <thread>
+
+namespace metrics {
+
+struct HistogramMetricTest : public CppUnit::TestFixture {
+    void testHistogramBuckets();
+    void testHistogramPercentiles();
+    void testHistogramMerge();
+    void testThreadShardedRecording();
+    void testSnapshotKeepsDistribution();
+
+    CPPUNIT_TEST_SUITE(HistogramMetricTest);
+    CPPUNIT_TEST(testHistogramBuckets);
+    CPPUNIT_TEST(testHistogramPercentiles);
+    CPPUNIT_TEST(testHistogramMerge);
+    CPPUNIT_TEST(testThreadShardedRecording);
+    CPPUNIT_TEST(testSnapshotKeepsDistribution);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(HistogramMetricTest);
+
+void HistogramMetricTest::testHistogramBuckets()
+{
+    CPPUNIT_ASSERT_EQUAL(0u, Histogram::getBucket(0.0));
+    CPPUNIT_ASSERT_EQUAL(0u, Histogram::getBucket(-1.0));
+    CPPUNIT_ASSERT_EQUAL(Histogram::NUM_BUCKETS - 1, Histogram::getBucket(1e12));
+    for (double value : {0.000002, 0.0013, 0.5, 1.0, 3.7, 1000.0}) {
+        uint32_t bucket = Histogram::getBucket(value);
+        CPPUNIT_ASSERT(Histogram::getBucketLowerBound(bucket) <= value);
+        CPPUNIT_ASSERT(value < Histogram::getBucketUpperBound(bucket));
+        // bucket width is at most 1/8 of its lower bound
+        CPPUNIT_ASSERT(Histogram::getBucketUpperBound(bucket) <= Histogram::getBucketLowerBound(bucket) * 1.125 + 1e-12);
+    }
+}
+
+void HistogramMetricTest::testHistogramPercentiles()
+{
+    Histogram histogram;
+    CPPUNIT_ASSERT_EQUAL(0.0, histogram.getPercentile(0.99));
+    for (uint32_t i = 1; i <= 1000; ++i) {
+        histogram.add(i * 0.001);
+    }
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1000), histogram.getCount());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5005, histogram.getAverage(), 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, histogram.getPercentile(0.5), 0.5 * 0.125);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.99, histogram.getPercentile(0.99), 0.99 * 0.125);
+    CPPUNIT_ASSERT_EQUAL(1.0, histogram.getPercentile(1.0));
+    CPPUNIT_ASSERT_EQUAL(0.001, histogram.getMin());
+}
+
+void HistogramMetricTest::testHistogramMerge()
+{
+    Histogram a;
+    Histogram b;
+    for (uint32_t i = 0; i < 99; ++i) {
+        a.add(0.01);
+    }
+    b.add(2.0);
+    a.merge(b);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(100), a.getCount());
+    CPPUNIT_ASSERT_EQUAL(2.0, a.getMax());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.01, a.getPercentile(0.5), 0.01 * 0.125);
+    CPPUNIT_ASSERT(a.getPercentile(0.999) > 1.0);
+    a.clear();
+    CPPUNIT_ASSERT(a.empty());
+}
+
+void HistogramMetricTest::testThreadShardedRecording()
+{
+    HistogramMetric m("latency", "", "description", nullptr, 4);
+    CPPUNIT_ASSERT(!m.used());
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < 8; ++i) {
+        threads.emplace_back([&m, i]() {
+            for (uint32_t j = 0; j < 1000; ++j) {
+                m.addValue((i + 1) * 0.001);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    CPPUNIT_ASSERT_EQUAL(uint64_t(8000), m.getCount());
+    CPPUNIT_ASSERT_EQUAL(int64_t(8000), m.getLongValue("count"));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0045, m.getDoubleValue("average"), 1e-9);
+    CPPUNIT_ASSERT_EQUAL(0.001, m.getDoubleValue("min"));
+    CPPUNIT_ASSERT_EQUAL(0.008, m.getDoubleValue("max"));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.008, m.getDoubleValue("p99"), 0.008 * 0.125);
+    m.reset();
+    CPPUNIT_ASSERT(!m.used());
+}
+
+void HistogramMetricTest::testSnapshotKeepsDistribution()
+{
+    MetricSet set("set", "", "description");
+    HistogramMetric m("latency", "", "description", &set);
+    for (uint32_t i = 1; i <= 100; ++i) {
+        m.addValue(i);
+    }
+    std::vector<Metric::UP> ownerList;
+    std::unique_ptr<MetricSet> snapshot(set.clone(ownerList, Metric::INACTIVE, nullptr, true));
+    Metric *copy = snapshot->getMetric("latency");
+    CPPUNIT_ASSERT(copy != nullptr);
+    CPPUNIT_ASSERT_EQUAL(int64_t(100), copy->getLongValue("count"));
+    m.addToSnapshot(*copy, ownerList);
+    CPPUNIT_ASSERT_EQUAL(int64_t(200), copy->getLongValue("count"));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(50.0, copy->getDoubleValue("p50"), 50.0 * 0.125);
+    CPPUNIT_ASSERT_EQUAL(100.0, copy->getDoubleValue("max"));
+}
+
+} // metrics
@@ -0,0 +1,65 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+/**
+ * \class CounterShards
+ * \ingroup metrics
+ *
+ * \brief Per thread partial sums of a counter.
+ *
+ * Each updating thread adds to its own cache line sized slot with a relaxed
+ * atomic add, so concurrent updaters neither retry nor share cache lines. The
+ * slots are summed when the counter is read, which only happens when taking
+ * snapshots or printing.
+ */
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+namespace metrics {
+
+namespace countershards {
+
+/** Small per thread number used to pick a slot. */
+uint32_t getThreadIndex();
+
+}
+
+template <typename T>
+class CounterShards {
+    struct alignas(64) Slot {
+        std::atomic<T> _value;
+        Slot() : _value(0) {}
+    };
+    std::unique_ptr<Slot[]> _slots;
+    uint32_t _numSlots;
+
+    Slot &mySlot() { return _slots[countershards::getThreadIndex() % _numSlots]; }
+
+public:
+    CounterShards(uint32_t numSlots)
+        : _slots(new Slot[numSlots == 0 ? 1 : numSlots]),
+          _numSlots(numSlots == 0 ? 1 : numSlots)
+    {}
+
+    void add(T value) { mySlot()._value.fetch_add(value, std::memory_order_relaxed); }
+    void sub(T value) { mySlot()._value.fetch_sub(value, std::memory_order_relaxed); }
+
+    T sum() const {
+        T result(0);
+        for (uint32_t i = 0; i < _numSlots; ++i) {
+            result += _slots[i]._value.load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    void reset() {
+        for (uint32_t i = 0; i < _numSlots; ++i) {
+            _slots[i]._value.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    uint32_t size() const { return _numSlots; }
+    uint32_t getMemoryUsage() const { return _numSlots * sizeof(Slot); }
+};
+
+} // metrics
@@ -9,6 +9,18 @@ LOG_SETUP(".metrics.metric.count");
 
 namespace metrics {
 
+namespace countershards {
+
+uint32_t
+getThreadIndex()
+{
+    static std::atomic<uint32_t> nextIndex(0);
+    thread_local uint32_t index = nextIndex++;
+    return index;
+}
+
+}
+
 void
 AbstractCountMetric::logWarning(const char* msg, const char * op) const
 {
@@ -14,6 +14,7 @@
 #pragma once
 
 #include "countmetricvalues.h"
+#include "countershards.h"
 #include <vespa/metrics/metric.h>
 
 namespace metrics {
@@ -54,10 +55,18 @@ class CountMetric : public AbstractCountMetric
 {
     using Values = CountMetricValues<T>;
     MetricValueSet<Values> _values;
+    std::unique_ptr<CounterShards<T>> _shards;
 
     enum Flag { LOG_IF_UNSET = 2 };
 
     bool logIfUnset() const { return _values.hasFlag(LOG_IF_UNSET); }
+    Values currentValues() const {
+        Values values(_values.getValues());
+        if (_shards) {
+            values._value += _shards->sum();
+        }
+        return values;
+    }
 
 public:
     CountMetric(const String& name, const String& tags,
@@ -67,14 +76,25 @@ public:
                 const String& description, MetricSet* owner = 0);
 
     CountMetric(const CountMetric<T, SumOnAdd>& other, CopyType, MetricSet* owner);
+    CountMetric(const CountMetric<T, SumOnAdd>& other);
+    CountMetric & operator=(const CountMetric<T, SumOnAdd>& other);
 
     ~CountMetric();
 
     MetricValueClass::UP getValues() const override {
-        return MetricValueClass::UP(new Values(_values.getValues()));
+        return MetricValueClass::UP(new Values(currentValues()));
     }
     void logOnlyIfSet() { _values.removeFlag(LOG_IF_UNSET); }
 
+    /**
+     * Let inc() and dec() add to per thread slots instead of updating the
+     * shared value set. Use this for counters updated by many threads. No
+     * overflow check is done on the sharded path. Copies of the metric,
+     * like snapshots, are not sharded.
+     */
+    void useThreadShards(uint32_t numShards);
+    bool usesThreadShards() const { return bool(_shards); }
+
     void set(T value);
     void inc(T value = 1);
     void dec(T value = 1);
@@ -100,9 +120,14 @@ public:
         return new CountMetric<T, SumOnAdd>(*this, type, owner);
     }
 
-    T getValue() const { return _values.getValues()._value; }
+    T getValue() const { return currentValues()._value; }
 
-    void reset() override { _values.reset(); }
+    void reset() override {
+        _values.reset();
+        if (_shards) {
+            _shards->reset();
+        }
+    }
 
     bool logFromTotalMetrics() const override { return true; }
     bool logEvent(const String& fullName) const override;
@@ -123,7 +148,7 @@ public:
     bool inUse(const MetricValueClass& v) const  override {
         return static_cast<const Values&>(v).inUse();
     }
-    bool used() const override { return _values.getValues().inUse(); }
+    bool used() const override { return currentValues().inUse(); }
     bool sumOnAdd() const override { return SumOnAdd; }
     void addMemoryUsage(MemoryConsumption&) const override;
     void printDebug(std::ostream&, const std::string& indent) const override;
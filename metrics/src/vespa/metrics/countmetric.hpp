@@ -11,7 +11,8 @@ template <typename T, bool SumOnAdd>
 CountMetric<T, SumOnAdd>::CountMetric(const String& name, const String& tags,
                                       const String& desc, MetricSet* owner)
     : AbstractCountMetric(name, tags, desc, owner),
-      _values()
+      _values(),
+      _shards()
 {
     _values.setFlag(LOG_IF_UNSET);
 }
@@ -20,7 +21,8 @@ template <typename T, bool SumOnAdd>
 CountMetric<T, SumOnAdd>::CountMetric(const String& name, Tags dimensions,
                                       const String& desc, MetricSet* owner)
     : AbstractCountMetric(name, std::move(dimensions), desc, owner),
-      _values()
+      _values(),
+      _shards()
 {
     _values.setFlag(LOG_IF_UNSET);
 }
@@ -29,8 +31,41 @@ template <typename T, bool SumOnAdd>
 CountMetric<T, SumOnAdd>::CountMetric(const CountMetric<T, SumOnAdd>& other,
                                       CopyType copyType, MetricSet* owner)
     : AbstractCountMetric(other, owner),
-      _values(other._values, copyType == CLONE ? other._values.size() : 1)
+      _values(other._values, copyType == CLONE ? other._values.size() : 1),
+      _shards()
 {
+    if (other._shards) {
+        Values values(other.currentValues());
+        while (!_values.setValues(values)) {}
+    }
+}
+
+template <typename T, bool SumOnAdd>
+CountMetric<T, SumOnAdd>::CountMetric(const CountMetric<T, SumOnAdd>& other)
+    : AbstractCountMetric(other),
+      _values(other._values),
+      _shards()
+{
+    if (other._shards) {
+        Values values(other.currentValues());
+        while (!_values.setValues(values)) {}
+    }
+}
+
+template <typename T, bool SumOnAdd>
+CountMetric<T, SumOnAdd>&
+CountMetric<T, SumOnAdd>::operator=(const CountMetric<T, SumOnAdd>& other)
+{
+    AbstractCountMetric::operator=(other);
+    _values = other._values;
+    if (_shards) {
+        _shards->reset();
+    }
+    if (other._shards) {
+        Values values(other.currentValues());
+        while (!_values.setValues(values)) {}
+    }
+    return *this;
 }
 
 template <typename T, bool SumOnAdd>
@@ -90,6 +125,15 @@ CountMetric<T, SumOnAdd>::operator--(int) {
     return tmp;
 }
 
+template <typename T, bool SumOnAdd>
+void
+CountMetric<T, SumOnAdd>::useThreadShards(uint32_t numShards)
+{
+    if (!_shards) {
+        _shards.reset(new CounterShards<T>(numShards));
+    }
+}
+
 template <typename T, bool SumOnAdd>
 void
 CountMetric<T, SumOnAdd>::set(T value)
@@ -97,12 +141,19 @@ CountMetric<T, SumOnAdd>::set(T value)
     Values values;
     values._value = value;
     while (!_values.setValues(values)) {}
+    if (_shards) {
+        _shards->reset();
+    }
 }
 
 template <typename T, bool SumOnAdd>
 void
 CountMetric<T, SumOnAdd>::inc(T value)
 {
+    if (_shards) {
+        _shards->add(value);
+        return;
+    }
     bool overflow;
     Values values;
     do {
@@ -120,6 +171,10 @@ template <typename T, bool SumOnAdd>
 void
 CountMetric<T, SumOnAdd>::dec(T value)
 {
+    if (_shards) {
+        _shards->sub(value);
+        return;
+    }
     bool underflow;
     Values values;
     do {
@@ -140,7 +195,7 @@ CountMetric<T, SumOnAdd>::addToSnapshot(
 {
     CountMetric<T, SumOnAdd>& o(
             reinterpret_cast<CountMetric<T, SumOnAdd>&>(other));
-    o.inc(_values.getValues()._value);
+    o.inc(currentValues()._value);
 }
 
 template <typename T, bool SumOnAdd>
@@ -150,9 +205,9 @@ CountMetric<T, SumOnAdd>::addToPart(Metric& other) const
     CountMetric<T, SumOnAdd>& o(
             reinterpret_cast<CountMetric<T, SumOnAdd>&>(other));
     if (SumOnAdd) {
-        o.inc(_values.getValues()._value);
+        o.inc(currentValues()._value);
     } else {
-        o.set((_values.getValues()._value + o._values.getValues()._value) / 2);
+        o.set((currentValues()._value + o.currentValues()._value) / 2);
     }
 }
 
@@ -160,7 +215,7 @@ template <typename T, bool SumOnAdd>
 bool
 CountMetric<T, SumOnAdd>::logEvent(const String& fullName) const
 {
-    Values values(_values.getValues());
+    Values values(currentValues());
     if (!logIfUnset() && values._value == 0) return false;
     sendLogCountEvent(
             fullName, static_cast<uint64_t>(values._value));
@@ -174,7 +229,7 @@ CountMetric<T, SumOnAdd>::print(std::ostream& out, bool verbose,
                                 uint64_t secondsPassed) const
 {
     (void) indent;
-    Values values(_values.getValues());
+    Values values(currentValues());
     if (values._value == 0 && !verbose) return;
     out << this->_name << (SumOnAdd ? " count=" : " value=") << values._value;
     if (SumOnAdd) {
@@ -191,6 +246,9 @@ CountMetric<T, SumOnAdd>::addMemoryUsage(MemoryConsumption& mc) const
 {
     ++mc._countMetricCount;
     mc._countMetricValues += _values.getMemoryUsageAllocatedInternally();
+    if (_shards) {
+        mc._countMetricValues += _shards->getMemoryUsage();
+    }
     mc._countMetricMeta += sizeof(CountMetric<T, SumOnAdd>)
                          - sizeof(Metric);
     Metric::addMemoryUsage(mc);
@@ -201,7 +259,7 @@ void
 CountMetric<T, SumOnAdd>::printDebug(std::ostream& out,
                                      const std::string& indent) const
 {
-    Values values(_values.getValues());
+    Values values(currentValues());
     out << "count=" << values._value << " ";
     Metric::printDebug(out, indent);
 }
@@ -0,0 +1,147 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "histogram.h"
+#include <algorithm>
+#include <cmath>
+
+namespace metrics {
+
+Histogram::Histogram()
+    : _buckets(),
+      _count(0),
+      _total(0.0),
+      _min(0.0),
+      _max(0.0)
+{
+}
+
+Histogram::Histogram(const Histogram &) = default;
+Histogram & Histogram::operator = (const Histogram &) = default;
+Histogram::~Histogram() = default;
+
+uint32_t
+Histogram::getBucket(double value)
+{
+    if (!(value >= std::ldexp(1.0, MIN_EXPONENT))) {
+        return 0;
+    }
+    int exponent;
+    double mantissa = std::frexp(value, &exponent); // value = mantissa * 2^exponent, mantissa in [0.5, 1)
+    int octave = exponent - 1 - MIN_EXPONENT;
+    if (octave >= (MAX_EXPONENT - MIN_EXPONENT)) {
+        return NUM_BUCKETS - 1;
+    }
+    uint32_t sub = static_cast<uint32_t>((mantissa * 2.0 - 1.0) * SUB_BUCKETS);
+    return 1 + octave * SUB_BUCKETS + std::min(sub, SUB_BUCKETS - 1);
+}
+
+double
+Histogram::getBucketLowerBound(uint32_t bucket)
+{
+    if (bucket == 0) {
+        return 0.0;
+    }
+    uint32_t octave = (bucket - 1) / SUB_BUCKETS;
+    uint32_t sub = (bucket - 1) % SUB_BUCKETS;
+    return std::ldexp(1.0 + double(sub) / SUB_BUCKETS, MIN_EXPONENT + int(octave));
+}
+
+double
+Histogram::getBucketUpperBound(uint32_t bucket)
+{
+    if (bucket + 1 >= NUM_BUCKETS) {
+        return std::ldexp(1.0, MAX_EXPONENT + 1);
+    }
+    return getBucketLowerBound(bucket + 1);
+}
+
+void
+Histogram::add(double value, uint64_t count)
+{
+    if ((count == 0) || !std::isfinite(value)) {
+        return;
+    }
+    if (_buckets.empty()) {
+        _buckets.resize(NUM_BUCKETS, 0);
+    }
+    _buckets[getBucket(value)] += count;
+    if (_count == 0) {
+        _min = _max = value;
+    } else {
+        _min = std::min(_min, value);
+        _max = std::max(_max, value);
+    }
+    _count += count;
+    _total += value * count;
+}
+
+void
+Histogram::addBucketCounts(const uint64_t *counts, double total, double min, double max)
+{
+    uint64_t added = 0;
+    for (uint32_t i = 0; i < NUM_BUCKETS; ++i) {
+        added += counts[i];
+    }
+    if (added == 0) {
+        return;
+    }
+    if (_buckets.empty()) {
+        _buckets.resize(NUM_BUCKETS, 0);
+    }
+    for (uint32_t i = 0; i < NUM_BUCKETS; ++i) {
+        _buckets[i] += counts[i];
+    }
+    if (_count == 0) {
+        _min = min;
+        _max = max;
+    } else {
+        _min = std::min(_min, min);
+        _max = std::max(_max, max);
+    }
+    _count += added;
+    _total += total;
+}
+
+void
+Histogram::merge(const Histogram &rhs)
+{
+    if (rhs._count == 0) {
+        return;
+    }
+    addBucketCounts(&rhs._buckets[0], rhs._total, rhs._min, rhs._max);
+}
+
+void
+Histogram::clear()
+{
+    std::fill(_buckets.begin(), _buckets.end(), 0);
+    _count = 0;
+    _total = 0.0;
+    _min = 0.0;
+    _max = 0.0;
+}
+
+double
+Histogram::getPercentile(double fraction) const
+{
+    if (_count == 0) {
+        return 0.0;
+    }
+    double rank = std::max(0.0, std::min(1.0, fraction)) * _count;
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < NUM_BUCKETS; ++i) {
+        uint64_t inBucket = _buckets[i];
+        if ((inBucket > 0) && (seen + inBucket >= rank)) {
+            double low = std::max(getBucketLowerBound(i), _min);
+            double high = std::min(getBucketUpperBound(i), _max);
+            if (high <= low) {
+                return low;
+            }
+            return low + (high - low) * ((rank - seen) / inBucket);
+        }
+        seen += inBucket;
+    }
+    return _max;
+}
+
+} // metrics
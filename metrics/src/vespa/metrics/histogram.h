@@ -0,0 +1,80 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+/**
+ * \class metrics::Histogram
+ * \ingroup metrics
+ *
+ * \brief Mergeable log-linear histogram of non-negative values.
+ *
+ * Each power of two between 2^MIN_EXPONENT and 2^MAX_EXPONENT is split into
+ * 2^SUB_BUCKET_BITS linear sub buckets, so the relative error of a
+ * percentile estimate is bounded independently of the magnitude of the
+ * values (HDR style). Values below the range are counted in the first
+ * bucket and values above it in the last one. With latencies measured in
+ * seconds the range covers a microsecond to several days.
+ *
+ * Buckets are allocated when the first value is added, so an unused
+ * histogram is cheap to copy. Histograms are merged by adding bucket counts,
+ * which makes them suitable for aggregating per thread and per query
+ * recordings.
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace metrics {
+
+class Histogram {
+public:
+    static constexpr uint32_t SUB_BUCKET_BITS = 3;
+    static constexpr uint32_t SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+    static constexpr int MIN_EXPONENT = -20;
+    static constexpr int MAX_EXPONENT = 20;
+    static constexpr uint32_t NUM_BUCKETS = 2 + (MAX_EXPONENT - MIN_EXPONENT) * SUB_BUCKETS;
+
+private:
+    std::vector<uint64_t> _buckets;
+    uint64_t _count;
+    double _total;
+    double _min;
+    double _max;
+
+public:
+    Histogram();
+    Histogram(const Histogram &);
+    Histogram(Histogram &&) = default;
+    Histogram & operator = (const Histogram &);
+    Histogram & operator = (Histogram &&) = default;
+    ~Histogram();
+
+    static uint32_t getBucket(double value);
+    /** Smallest value counted in the given bucket. */
+    static double getBucketLowerBound(uint32_t bucket);
+    /** Smallest value counted in the next bucket. */
+    static double getBucketUpperBound(uint32_t bucket);
+
+    void add(double value) { add(value, 1); }
+    void add(double value, uint64_t count);
+    /** Add raw bucket counts (NUM_BUCKETS entries) and their summary. */
+    void addBucketCounts(const uint64_t *counts, double total, double min, double max);
+    void merge(const Histogram &rhs);
+    void clear();
+
+    bool empty() const { return (_count == 0); }
+    uint64_t getCount() const { return _count; }
+    double getTotal() const { return _total; }
+    double getMin() const { return (_count > 0) ? _min : 0.0; }
+    double getMax() const { return (_count > 0) ? _max : 0.0; }
+    double getAverage() const { return (_count > 0) ? (_total / _count) : 0.0; }
+    uint64_t getBucketCount(uint32_t bucket) const {
+        return _buckets.empty() ? 0 : _buckets[bucket];
+    }
+
+    /**
+     * Estimate the value below which the given fraction (0.0 - 1.0) of
+     * the values fall, interpolating linearly within the bucket.
+     */
+    double getPercentile(double fraction) const;
+};
+
+} // metrics
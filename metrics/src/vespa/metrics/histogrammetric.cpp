@@ -0,0 +1,318 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "histogrammetric.h"
+#include "countershards.h"
+#include "memoryconsumption.h"
+#include <vespa/vespalib/util/exceptions.h>
+#include <cmath>
+#include <ostream>
+
+namespace metrics {
+
+namespace {
+
+bool
+lookupPercentile(const vespalib::stringref & id, double &fraction)
+{
+    for (const auto &percentile : HistogramMetric::getPercentileIds()) {
+        if (id == percentile.first) {
+            fraction = percentile.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+atomicAdd(std::atomic<double> &target, double value)
+{
+    double old = target.load(std::memory_order_relaxed);
+    while (!target.compare_exchange_weak(old, old + value, std::memory_order_relaxed)) { }
+}
+
+void
+atomicMin(std::atomic<double> &target, double value)
+{
+    double old = target.load(std::memory_order_relaxed);
+    while ((value < old) && !target.compare_exchange_weak(old, value, std::memory_order_relaxed)) { }
+}
+
+void
+atomicMax(std::atomic<double> &target, double value)
+{
+    double old = target.load(std::memory_order_relaxed);
+    while ((value > old) && !target.compare_exchange_weak(old, value, std::memory_order_relaxed)) { }
+}
+
+}
+
+double
+HistogramMetricValues::getDoubleValue(const stringref & id) const
+{
+    if (id == "count") return _histogram.getCount();
+    if (id == "total") return _histogram.getTotal();
+    if (id == "min") return _histogram.getMin();
+    if (id == "max") return _histogram.getMax();
+    if (id == "last" || id == "average") return _histogram.getAverage();
+    double fraction;
+    if (lookupPercentile(id, fraction)) {
+        return _histogram.getPercentile(fraction);
+    }
+    throw vespalib::IllegalArgumentException("No value " + vespalib::string(id) + " in histogram metric.", VESPA_STRLOC);
+}
+
+uint64_t
+HistogramMetricValues::getLongValue(const stringref & id) const
+{
+    if (id == "count") return _histogram.getCount();
+    return static_cast<uint64_t>(getDoubleValue(id));
+}
+
+void
+HistogramMetricValues::output(const std::string& id, std::ostream& out) const
+{
+    if (id == "count") { out << _histogram.getCount(); return; }
+    out << getDoubleValue(id);
+}
+
+void
+HistogramMetricValues::output(const std::string& id, vespalib::JsonStream& stream) const
+{
+    if (id == "count") { stream << _histogram.getCount(); return; }
+    stream << getDoubleValue(id);
+}
+
+struct HistogramMetric::Shard {
+    std::atomic<uint64_t> buckets[Histogram::NUM_BUCKETS];
+    std::atomic<double> total;
+    std::atomic<double> min;
+    std::atomic<double> max;
+
+    Shard() : total(0.0), min(INFINITY), max(-INFINITY) {
+        for (auto &bucket : buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+    void clear() {
+        for (auto &bucket : buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        total.store(0.0, std::memory_order_relaxed);
+        min.store(INFINITY, std::memory_order_relaxed);
+        max.store(-INFINITY, std::memory_order_relaxed);
+    }
+    void add(double value) {
+        buckets[Histogram::getBucket(value)].fetch_add(1, std::memory_order_relaxed);
+        atomicAdd(total, value);
+        atomicMin(min, value);
+        atomicMax(max, value);
+    }
+    void addTo(Histogram &histogram) const {
+        uint64_t counts[Histogram::NUM_BUCKETS];
+        for (uint32_t i = 0; i < Histogram::NUM_BUCKETS; ++i) {
+            counts[i] = buckets[i].load(std::memory_order_relaxed);
+        }
+        histogram.addBucketCounts(counts, total.load(std::memory_order_relaxed),
+                                  min.load(std::memory_order_relaxed),
+                                  max.load(std::memory_order_relaxed));
+    }
+};
+
+const std::vector<std::pair<std::string, double>> &
+HistogramMetric::getPercentileIds()
+{
+    static const std::vector<std::pair<std::string, double>> ids = {
+        {"p50", 0.50}, {"p90", 0.90}, {"p95", 0.95}, {"p99", 0.99}, {"p999", 0.999}
+    };
+    return ids;
+}
+
+HistogramMetric::HistogramMetric(const String& name, const String& tags,
+                                 const String& description, MetricSet* owner,
+                                 uint32_t numShards)
+    : AbstractValueMetric(name, tags, description, owner),
+      _numShards(numShards == 0 ? 1 : numShards),
+      _shards(new std::atomic<Shard *>[_numShards])
+{
+    for (uint32_t i = 0; i < _numShards; ++i) {
+        _shards[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+HistogramMetric::HistogramMetric(const HistogramMetric& other, CopyType copyType, MetricSet* owner)
+    : AbstractValueMetric(other, owner),
+      _numShards(copyType == CLONE ? other._numShards : 1),
+      _shards(new std::atomic<Shard *>[_numShards])
+{
+    for (uint32_t i = 0; i < _numShards; ++i) {
+        _shards[i].store(nullptr, std::memory_order_relaxed);
+    }
+    addHistogram(other.getHistogram());
+}
+
+HistogramMetric::~HistogramMetric()
+{
+    for (uint32_t i = 0; i < _numShards; ++i) {
+        delete _shards[i].load(std::memory_order_relaxed);
+    }
+}
+
+HistogramMetric::Shard &
+HistogramMetric::getShard()
+{
+    std::atomic<Shard *> &slot = _shards[countershards::getThreadIndex() % _numShards];
+    Shard *shard = slot.load(std::memory_order_acquire);
+    if (shard == nullptr) {
+        Shard *created = new Shard();
+        if (slot.compare_exchange_strong(shard, created, std::memory_order_acq_rel)) {
+            shard = created;
+        } else {
+            delete created;
+        }
+    }
+    return *shard;
+}
+
+void
+HistogramMetric::clearShards()
+{
+    for (uint32_t i = 0; i < _numShards; ++i) {
+        Shard *shard = _shards[i].load(std::memory_order_acquire);
+        if (shard != nullptr) {
+            shard->clear();
+        }
+    }
+}
+
+void
+HistogramMetric::addValue(double value)
+{
+    if (!std::isfinite(value)) {
+        logNonFiniteValueWarning();
+        return;
+    }
+    getShard().add(value);
+}
+
+void
+HistogramMetric::addHistogram(const Histogram &histogram)
+{
+    if (histogram.empty()) {
+        return;
+    }
+    Shard &shard = getShard();
+    for (uint32_t i = 0; i < Histogram::NUM_BUCKETS; ++i) {
+        uint64_t count = histogram.getBucketCount(i);
+        if (count > 0) {
+            shard.buckets[i].fetch_add(count, std::memory_order_relaxed);
+        }
+    }
+    atomicAdd(shard.total, histogram.getTotal());
+    atomicMin(shard.min, histogram.getMin());
+    atomicMax(shard.max, histogram.getMax());
+}
+
+Histogram
+HistogramMetric::getHistogram() const
+{
+    Histogram histogram;
+    for (uint32_t i = 0; i < _numShards; ++i) {
+        const Shard *shard = _shards[i].load(std::memory_order_acquire);
+        if (shard != nullptr) {
+            shard->addTo(histogram);
+        }
+    }
+    return histogram;
+}
+
+MetricValueClass::UP
+HistogramMetric::getValues() const
+{
+    auto values = std::make_unique<HistogramMetricValues>();
+    values->_histogram = getHistogram();
+    return values;
+}
+
+bool
+HistogramMetric::inUse(const MetricValueClass& v) const
+{
+    return !static_cast<const HistogramMetricValues&>(v)._histogram.empty();
+}
+
+bool
+HistogramMetric::logEvent(const String& fullName) const
+{
+    Histogram histogram(getHistogram());
+    if (histogram.empty()) return false;
+    sendLogEvent(fullName, histogram.getAverage());
+    return true;
+}
+
+void
+HistogramMetric::print(std::ostream& out, bool verbose,
+                       const std::string& indent, uint64_t secondsPassed) const
+{
+    (void) indent;
+    (void) secondsPassed;
+    Histogram histogram(getHistogram());
+    if (histogram.empty() && !verbose) return;
+    out << _name << " average=" << histogram.getAverage();
+    if (!histogram.empty()) {
+        out << " min=" << histogram.getMin() << " max=" << histogram.getMax();
+        for (const auto &percentile : getPercentileIds()) {
+            out << " " << percentile.first << "=" << histogram.getPercentile(percentile.second);
+        }
+    }
+    out << " count=" << histogram.getCount() << " total=" << histogram.getTotal();
+}
+
+int64_t
+HistogramMetric::getLongValue(const stringref & id) const
+{
+    HistogramMetricValues values;
+    values._histogram = getHistogram();
+    return values.getLongValue(id);
+}
+
+double
+HistogramMetric::getDoubleValue(const stringref & id) const
+{
+    HistogramMetricValues values;
+    values._histogram = getHistogram();
+    return values.getDoubleValue(id);
+}
+
+void
+HistogramMetric::addMemoryUsage(MemoryConsumption& mc) const
+{
+    ++mc._valueMetricCount;
+    for (uint32_t i = 0; i < _numShards; ++i) {
+        if (_shards[i].load(std::memory_order_relaxed) != nullptr) {
+            mc._valueMetricValues += sizeof(Shard);
+        }
+    }
+    mc._valueMetricMeta += sizeof(HistogramMetric) - sizeof(Metric)
+                           + _numShards * sizeof(std::atomic<Shard *>);
+    Metric::addMemoryUsage(mc);
+}
+
+void
+HistogramMetric::printDebug(std::ostream& out, const std::string& indent) const
+{
+    out << "count=" << getCount() << " ";
+    Metric::printDebug(out, indent);
+}
+
+void
+HistogramMetric::addToPart(Metric& other) const
+{
+    static_cast<HistogramMetric&>(other).addHistogram(getHistogram());
+}
+
+void
+HistogramMetric::addToSnapshot(Metric& other, std::vector<Metric::UP> &) const
+{
+    static_cast<HistogramMetric&>(other).addHistogram(getHistogram());
+}
+
+} // metrics
@@ -0,0 +1,88 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+/**
+ * @class metrics::HistogramMetric
+ * @ingroup metrics
+ *
+ * @brief Creates a metric keeping the distribution of the values added.
+ *
+ * A histogram metric reports the same values as an average value metric
+ * (average, count, min, max and total), and in addition the percentiles
+ * p50, p90, p95, p99 and p999 estimated from a log-linear histogram (see
+ * Histogram). Values are recorded into per thread shards, each allocated
+ * the first time a thread records a value, so concurrent recording threads
+ * do not contend. Histograms are merged when taking snapshots and when
+ * summing metrics, so percentiles stay correct across periods and parts.
+ *
+ * The "last" value is not tracked, and is reported as the average.
+ */
+#pragma once
+
+#include "histogram.h"
+#include "valuemetric.h"
+#include <atomic>
+#include <memory>
+
+namespace metrics {
+
+struct HistogramMetricValues : MetricValueClass {
+    Histogram _histogram;
+
+    double getDoubleValue(const stringref & id) const override;
+    uint64_t getLongValue(const stringref & id) const override;
+    void output(const std::string& id, std::ostream& out) const override;
+    void output(const std::string& id, vespalib::JsonStream& stream) const override;
+};
+
+class HistogramMetric : public AbstractValueMetric {
+    struct Shard;
+    using String = Metric::String;
+
+    uint32_t _numShards;
+    std::unique_ptr<std::atomic<Shard *>[]> _shards;
+
+    Shard &getShard();
+    void clearShards();
+
+public:
+    static constexpr uint32_t DEFAULT_SHARDS = 8;
+
+    /** Percentile value ids reported in addition to the regular value metric ids. */
+    static const std::vector<std::pair<std::string, double>> &getPercentileIds();
+
+    HistogramMetric(const String& name, const String& tags,
+                    const String& description, MetricSet* owner = 0,
+                    uint32_t numShards = DEFAULT_SHARDS);
+    HistogramMetric(const HistogramMetric&, CopyType, MetricSet* owner);
+    ~HistogramMetric();
+
+    HistogramMetric* clone(std::vector<Metric::UP> &, CopyType type, MetricSet* owner,
+                           bool /*includeUnused*/) const override {
+        return new HistogramMetric(*this, type, owner);
+    }
+
+    void addValue(double value);
+    void addHistogram(const Histogram &histogram);
+
+    Histogram getHistogram() const;
+    double getPercentile(double fraction) const { return getHistogram().getPercentile(fraction); }
+    uint64_t getCount() const { return getHistogram().getCount(); }
+
+    MetricValueClass::UP getValues() const override;
+    bool inUse(const MetricValueClass& v) const override;
+    bool summedAverage() const override { return false; }
+    bool hasPercentiles() const override { return true; }
+
+    void reset() override { clearShards(); }
+    bool logEvent(const String& fullName) const override;
+    void print(std::ostream&, bool verbose,
+               const std::string& indent, uint64_t secondsPassed) const override;
+    int64_t getLongValue(const stringref & id) const override;
+    double getDoubleValue(const stringref & id) const override;
+    bool used() const override { return getCount() > 0; }
+    void addMemoryUsage(MemoryConsumption&) const override;
+    void printDebug(std::ostream&, const std::string& indent) const override;
+    void addToPart(Metric&) const override;
+    void addToSnapshot(Metric&, std::vector<Metric::UP> &) const override;
+};
+
+} // metrics
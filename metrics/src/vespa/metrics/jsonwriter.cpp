@@ -2,6 +2,7 @@
 #include "jsonwriter.h"
 
 #include "countmetric.h"
+#include "histogrammetric.h"
 #include "valuemetric.h"
 #include "metricsnapshot.h"
 
@@ -160,6 +161,12 @@ JsonWriter::visitValueMetric(const AbstractValueMetric& m, bool)
     values->output("max", _stream);
     _stream << "last";
     values->output("last", _stream);
+    if (m.hasPercentiles()) {
+        for (const auto &percentile : HistogramMetric::getPercentileIds()) {
+            _stream << percentile.first;
+            values->output(percentile.first, _stream);
+        }
+    }
     _stream << End();
     writeCommonPostfix(m);
     return true;
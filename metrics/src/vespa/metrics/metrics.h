@@ -8,6 +8,7 @@
 #include <vespa/metrics/metric.h>
 #include <vespa/metrics/countmetric.h>
 #include <vespa/metrics/valuemetric.h>
+#include <vespa/metrics/histogrammetric.h>
 #include <vespa/metrics/loadmetric.h>
 #include <vespa/metrics/summetric.h>
 #include <vespa/metrics/metricset.h>
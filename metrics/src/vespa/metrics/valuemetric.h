@@ -26,6 +26,8 @@ struct AbstractValueMetric : public Metric {
     virtual MetricValueClass::UP getValues() const = 0;
     virtual bool inUse(const MetricValueClass& v) const = 0;
     virtual bool summedAverage() const = 0;
+    /** Whether the values also contain the percentiles listed by HistogramMetric. */
+    virtual bool hasPercentiles() const { return false; }
 
 protected:
     AbstractValueMetric(const String& name, const String& tags,
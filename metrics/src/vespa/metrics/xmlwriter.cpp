@@ -2,6 +2,7 @@
 
 #include "xmlwriter.h"
 #include "countmetric.h"
+#include "histogrammetric.h"
 #include "metricset.h"
 #include "metricsnapshot.h"
 #include "valuemetric.h"
@@ -79,6 +80,11 @@ XmlWriter::visitValueMetric(const AbstractValueMetric& metric, bool)
         if (values->getLongValue("count") > 0) {
             _xos << XmlAttribute("min", values->toString("min"))
                  << XmlAttribute("max", values->toString("max"));
+            if (metric.hasPercentiles()) {
+                for (const auto &percentile : HistogramMetric::getPercentileIds()) {
+                    _xos << XmlAttribute(percentile.first, values->toString(percentile.first));
+                }
+            }
         }
         _xos << XmlAttribute("count", values->getLongValue("count"));
         if (_verbosity >= 2) {
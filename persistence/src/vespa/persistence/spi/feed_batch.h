@@ -0,0 +1,73 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "result.h"
+#include <vespa/document/base/documentid.h>
+#include <vector>
+
+namespace storage::spi {
+
+/**
+ * A sequence of put and remove operations against a single bucket, handed
+ * to the persistence provider in one call (see
+ * PersistenceProvider::feedBatch()). Each operation keeps its own timestamp
+ * and gets its own result, in the order the operations were added.
+ */
+class FeedBatch {
+public:
+    enum class Type {
+        PUT,
+        REMOVE,
+        REMOVE_IF_FOUND
+    };
+
+    class Operation {
+    public:
+        Operation(Timestamp timestamp, const DocumentSP &doc)
+            : _type(Type::PUT), _timestamp(timestamp), _doc(doc), _id() {}
+        Operation(Type type, Timestamp timestamp, const DocumentId &id)
+            : _type(type), _timestamp(timestamp), _doc(), _id(id) {}
+
+        Type getType() const { return _type; }
+        Timestamp getTimestamp() const { return _timestamp; }
+        /** Only set for puts. */
+        const DocumentSP &getDocument() const { return _doc; }
+        /** Only set for removes. */
+        const DocumentId &getDocumentId() const { return _id; }
+    private:
+        Type       _type;
+        Timestamp  _timestamp;
+        DocumentSP _doc;
+        DocumentId _id;
+    };
+
+    using OperationList = std::vector<Operation>;
+
+    FeedBatch() : _operations() {}
+
+    void addPut(Timestamp timestamp, const DocumentSP &doc) {
+        _operations.emplace_back(timestamp, doc);
+    }
+    void addRemove(Timestamp timestamp, const DocumentId &id) {
+        _operations.emplace_back(Type::REMOVE, timestamp, id);
+    }
+    void addRemoveIfFound(Timestamp timestamp, const DocumentId &id) {
+        _operations.emplace_back(Type::REMOVE_IF_FOUND, timestamp, id);
+    }
+
+    const OperationList &getOperations() const { return _operations; }
+    size_t size() const { return _operations.size(); }
+    bool empty() const { return _operations.empty(); }
+    void clear() { _operations.clear(); }
+
+private:
+    OperationList _operations;
+};
+
+/**
+ * The results of the operations in a FeedBatch, in the same order. For puts
+ * the wasFound() flag carries no meaning.
+ */
+using FeedBatchResult = std::vector<RemoveResult>;
+
+}
@@ -7,6 +7,34 @@ namespace spi {
 
 PersistenceProvider::~PersistenceProvider() { }
 
+FeedBatchResult
+PersistenceProvider::feedBatch(const Bucket& bucket, const FeedBatch& batch, Context& context)
+{
+    FeedBatchResult results;
+    results.reserve(batch.size());
+    for (const FeedBatch::Operation& op : batch.getOperations()) {
+        switch (op.getType()) {
+        case FeedBatch::Type::PUT:
+        {
+            Result result = put(bucket, op.getTimestamp(), op.getDocument(), context);
+            if (result.hasError()) {
+                results.emplace_back(result.getErrorCode(), result.getErrorMessage());
+            } else {
+                results.emplace_back(false);
+            }
+            break;
+        }
+        case FeedBatch::Type::REMOVE:
+            results.push_back(remove(bucket, op.getTimestamp(), op.getDocumentId(), context));
+            break;
+        case FeedBatch::Type::REMOVE_IF_FOUND:
+            results.push_back(removeIfFound(bucket, op.getTimestamp(), op.getDocumentId(), context));
+            break;
+        }
+    }
+    return results;
+}
+
 } // spi
 } // storage
 
@@ -6,6 +6,7 @@
 #include "context.h"
 #include "docentry.h"
 #include "documentselection.h"
+#include "feed_batch.h"
 #include "partitionstate.h"
 #include "result.h"
 #include "selection.h"
@@ -214,6 +215,17 @@ struct PersistenceProvider
                                 const DocumentUpdateSP& update,
                                 Context&) = 0;
 
+    /**
+     * Performs all the puts and removes in the given batch against the given
+     * bucket, as if they were issued one by one in order, and returns one
+     * result per operation. Providers with a noticeable fixed cost per write
+     * operation (like a commit or a round trip to another thread) can
+     * override this to pay that cost once for the whole batch.
+     * <p/>
+     * The default implementation calls put(), remove() and removeIfFound().
+     */
+    virtual FeedBatchResult feedBatch(const Bucket&, const FeedBatch&, Context&);
+
     /**
      * The service layer may choose to batch certain commands. This means that
      * the service layer will lock the bucket only once, then perform several
@@ -13,10 +13,15 @@ Config::Config() :
     _enableOnlyBitVector(false),
     _isFilter(false),
     _fastAccess(false),
+    _mmapLoad(false),
+    _hugePages(false),
+    _paged(false),
     _growStrategy(),
     _compactionStrategy(),
     _predicateParams(),
-    _tensorType(vespalib::eval::ValueType::error_type())
+    _tensorType(vespalib::eval::ValueType::error_type()),
+    _tensorCellType(TensorCellType::DOUBLE),
+    _hnswIndexParams()
 {
 }
 
@@ -32,10 +37,15 @@ Config::Config(BasicType bt,
       _enableOnlyBitVector(false),
       _isFilter(false),
       _fastAccess(false),
+      _mmapLoad(false),
+      _hugePages(false),
+      _paged(false),
       _growStrategy(),
       _compactionStrategy(),
       _predicateParams(),
-      _tensorType(vespalib::eval::ValueType::error_type())
+      _tensorType(vespalib::eval::ValueType::error_type()),
+      _tensorCellType(TensorCellType::DOUBLE),
+      _hnswIndexParams()
 {
 }
 
@@ -4,7 +4,9 @@
 
 #include "basictype.h"
 #include "collectiontype.h"
+#include "hnsw_index_params.h"
 #include "predicate_params.h"
+#include "tensor_cell_type.h"
 #include <vespa/searchcommon/common/growstrategy.h>
 #include <vespa/searchcommon/common/compaction_strategy.h>
 #include <vespa/eval/eval/value_type.h>
@@ -28,6 +30,8 @@ public:
     bool huge()                           const { return _huge; }
     const PredicateParams &predicateParams() const { return _predicateParams; }
     vespalib::eval::ValueType tensorType() const { return _tensorType; }
+    TensorCellType tensorCellType() const { return _tensorCellType; }
+    const HnswIndexParams &hnswIndexParams() const { return _hnswIndexParams; }
 
     /**
      * Check if attribute posting list can consist of a bitvector in
@@ -49,6 +53,30 @@ public:
      */
     bool fastAccess() const { return _fastAccess; }
 
+    /**
+     * Check if a saved single value numeric attribute should be loaded
+     * by mapping its data file private (copy-on-write) instead of
+     * reading it. This only affects loading, and is not part of
+     * config equality.
+     */
+    bool mmapLoad() const { return _mmapLoad; }
+
+    /**
+     * Check if the document vectors of single value attributes should be
+     * allocated aligned to huge pages and advised to be backed by
+     * transparent huge pages. This only affects memory layout, and is
+     * not part of config equality.
+     */
+    bool hugePages() const { return _hugePages; }
+
+    /**
+     * Check if the values of string and multi-value attributes should be
+     * stored in file backed memory, where only recently accessed pages
+     * stay resident. Meant for large, rarely accessed attributes. This
+     * only affects memory layout, and is not part of config equality.
+     */
+    bool paged() const { return _paged; }
+
     const GrowStrategy & getGrowStrategy() const { return _growStrategy; }
     const CompactionStrategy &getCompactionStrategy() const { return _compactionStrategy; }
     void setHuge(bool v)                         { _huge = v; }
@@ -57,6 +85,10 @@ public:
     void setTensorType(const vespalib::eval::ValueType &tensorType_in) {
         _tensorType = tensorType_in;
     }
+    void setTensorCellType(TensorCellType tensorCellType_in) {
+        _tensorCellType = tensorCellType_in;
+    }
+    void setHnswIndexParams(const HnswIndexParams &v) { _hnswIndexParams = v; }
 
     /**
      * Enable attribute posting list to consist of a bitvector in
@@ -84,6 +116,9 @@ public:
     }
 
     void setFastAccess(bool v) { _fastAccess = v; }
+    void setMmapLoad(bool v) { _mmapLoad = v; }
+    void setHugePages(bool v) { _hugePages = v; }
+    void setPaged(bool v) { _paged = v; }
     Config & setGrowStrategy(const GrowStrategy &gs) { _growStrategy = gs; return *this; }
     Config &setCompactionStrategy(const CompactionStrategy &compactionStrategy) { _compactionStrategy = compactionStrategy; return *this; }
     bool operator!=(const Config &b) const { return !(operator==(b)); }
@@ -103,7 +138,9 @@ public:
                _compactionStrategy == b._compactionStrategy &&
                _predicateParams == b._predicateParams &&
             (_basicType.type() != BasicType::Type::TENSOR ||
-             _tensorType == b._tensorType);
+             (_tensorType == b._tensorType &&
+              _tensorCellType == b._tensorCellType &&
+              _hnswIndexParams == b._hnswIndexParams));
     }
 
 private:
@@ -115,10 +152,15 @@ private:
     bool           _enableOnlyBitVector;
     bool           _isFilter;
     bool           _fastAccess;
+    bool           _mmapLoad;
+    bool           _hugePages;
+    bool           _paged;
     GrowStrategy   _growStrategy;
     CompactionStrategy _compactionStrategy;
     PredicateParams    _predicateParams;
     vespalib::eval::ValueType _tensorType;
+    TensorCellType            _tensorCellType;
+    HnswIndexParams           _hnswIndexParams;
 };
 }  // namespace attribute
 }  // namespace search
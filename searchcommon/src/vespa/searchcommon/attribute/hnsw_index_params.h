@@ -0,0 +1,46 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+
+namespace search {
+namespace attribute {
+
+/*
+ * Parameters for the approximate nearest neighbor (HNSW) index of
+ * dense tensor attributes.
+ */
+class HnswIndexParams
+{
+    bool     _enabled;
+    uint32_t _maxLinksPerNode;
+    uint32_t _neighborsToExploreAtInsert;
+public:
+    HnswIndexParams()
+        : _enabled(false),
+          _maxLinksPerNode(16),
+          _neighborsToExploreAtInsert(100)
+    {
+    }
+    HnswIndexParams(bool enabled_in, uint32_t maxLinksPerNode_in, uint32_t neighborsToExploreAtInsert_in)
+        : _enabled(enabled_in),
+          _maxLinksPerNode(maxLinksPerNode_in),
+          _neighborsToExploreAtInsert(neighborsToExploreAtInsert_in)
+    {
+    }
+
+    bool enabled() const { return _enabled; }
+    // Max number of links for a node in the levels above level 0, level 0 allows twice as many.
+    uint32_t maxLinksPerNode() const { return _maxLinksPerNode; }
+    // Number of candidate neighbors examined when inserting a node.
+    uint32_t neighborsToExploreAtInsert() const { return _neighborsToExploreAtInsert; }
+    bool operator==(const HnswIndexParams &rhs) const {
+        return ((_enabled == rhs._enabled) &&
+                (_maxLinksPerNode == rhs._maxLinksPerNode) &&
+                (_neighborsToExploreAtInsert == rhs._neighborsToExploreAtInsert));
+    }
+};
+
+}  // namespace attribute
+}  // namespace search
@@ -6,6 +6,7 @@
 #include "basictype.h"
 #include <vespa/searchcommon/common/iblobconverter.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <limits>
 
 namespace search {
 
@@ -272,6 +273,18 @@ public:
      */
     virtual const IDocumentWeightAttribute *asDocumentWeightAttribute() const = 0;
 
+    static constexpr uint64_t UNTRACKED_GENERATION = std::numeric_limits<uint64_t>::max();
+
+    /**
+     * Returns a number that is changed each time changes to the
+     * content of this attribute vector become visible to readers, or
+     * UNTRACKED_GENERATION if such changes are not tracked. Used to
+     * tell if results cached from earlier searches are still valid.
+     *
+     * @return content generation
+     **/
+    virtual uint64_t getContentGeneration() const = 0;
+
     /**
      * Returns the basic type of this attribute vector.
      *
@@ -0,0 +1,30 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcommon/attribute/tensor_cell_type.h>
+#include <vespa/vespalib/util/exceptions.h>
+
+namespace search {
+namespace attribute {
+
+const TensorCellType::TypeInfo TensorCellType::_typeTable[TensorCellType::MAX_TYPE] = {
+    { TensorCellType::DOUBLE,   sizeof(double),   "double" },
+    { TensorCellType::FLOAT,    sizeof(float),    "float" },
+    { TensorCellType::BFLOAT16, sizeof(uint16_t), "bfloat16" }
+};
+
+TensorCellType::Type
+TensorCellType::asType(const vespalib::string &t)
+{
+    for (size_t i(0); i < sizeof(_typeTable)/sizeof(_typeTable[0]); i++) {
+        if (t == _typeTable[i]._name) {
+            return _typeTable[i]._type;
+        }
+    }
+    throw vespalib::IllegalStateException(t +
+                                " not recognized as "
+                                "valid tensor cell type");
+    return DOUBLE;
+}
+
+}
+}
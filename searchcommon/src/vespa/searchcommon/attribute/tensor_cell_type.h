@@ -0,0 +1,49 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+
+namespace search {
+namespace attribute {
+
+/**
+ * Type of the cells used when storing a dense tensor attribute in
+ * memory and on disk. Cells are converted to and from double when
+ * tensors are set and read.
+ */
+class TensorCellType
+{
+ public:
+    enum Type {
+        DOUBLE    =  0,
+        FLOAT     =  1,
+        BFLOAT16  =  2,
+        MAX_TYPE
+    };
+
+    TensorCellType(Type t) : _type(t) { }
+    explicit
+    TensorCellType(const vespalib::string & t) : _type(asType(t)) { }
+
+    Type type() const { return _type; }
+    const char * asString() const { return _typeTable[_type]._name; }
+    size_t cellSize() const { return _typeTable[_type]._cellSize; }
+    bool operator==(const TensorCellType &b) const { return _type == b._type; }
+    bool operator!=(const TensorCellType &b) const { return _type != b._type; }
+
+  private:
+    static Type asType(const vespalib::string & t);
+
+    Type _type;
+
+    struct TypeInfo {
+        Type _type;
+        unsigned int _cellSize;
+        const char * _name;
+    };
+    static const TypeInfo _typeTable[MAX_TYPE];
+};
+
+}
+}
@@ -201,6 +201,7 @@ public:
                                _config_stores.getConfigStore(docType.toString()),
                                std::make_shared<vespalib::ThreadStackExecutor>
                                (16, 128 * 1024),
+                               DocumentDB::InitializeThreads(),
                                HwInfo()));
     }
 };
@@ -0,0 +1,481 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/config-imported-fields.h>
+#include <vespa/config-rank-profiles.h>
+#include <vespa/config-stor-distribution.h>
+#include <vespa/config-summarymap.h>
+#include <vespa/document/fieldvalue/intfieldvalue.h>
+#include <vespa/document/fieldvalue/stringfieldvalue.h>
+#include <vespa/document/repo/configbuilder.h>
+#include <vespa/document/repo/documenttyperepo.h>
+#include <vespa/document/test/make_bucket_space.h>
+#include <vespa/document/update/assignvalueupdate.h>
+#include <vespa/document/update/documentupdate.h>
+#include <vespa/fastos/app.h>
+#include <vespa/fastos/file.h>
+#include <vespa/persistence/spi/clusterstate.h>
+#include <vespa/searchcommon/common/schemaconfigurer.h>
+#include <vespa/searchcore/proton/common/hw_info.h>
+#include <vespa/searchcore/proton/matching/querylimiter.h>
+#include <vespa/searchcore/proton/metrics/metricswireservice.h>
+#include <vespa/searchcore/proton/persistenceengine/ipersistenceengineowner.h>
+#include <vespa/searchcore/proton/persistenceengine/i_resource_write_filter.h>
+#include <vespa/searchcore/proton/persistenceengine/persistenceengine.h>
+#include <vespa/searchcore/proton/reference/document_db_reference_registry.h>
+#include <vespa/searchcore/proton/server/bootstrapconfig.h>
+#include <vespa/searchcore/proton/server/document_db_maintenance_config.h>
+#include <vespa/searchcore/proton/server/documentdb.h>
+#include <vespa/searchcore/proton/server/documentdbconfigmanager.h>
+#include <vespa/searchcore/proton/server/fileconfigmanager.h>
+#include <vespa/searchcore/proton/server/idocumentdbowner.h>
+#include <vespa/searchcore/proton/server/memoryconfigstore.h>
+#include <vespa/searchcore/proton/server/persistencehandlerproxy.h>
+#include <vespa/searchlib/index/dummyfileheadercontext.h>
+#include <vespa/searchlib/transactionlog/translogserver.h>
+#include <vespa/searchsummary/config/config-juniperrc.h>
+#include <vespa/vdslib/distribution/distribution.h>
+#include <vespa/vdslib/state/clusterstate.h>
+#include <vespa/vdslib/state/node.h>
+#include <vespa/vdslib/state/nodestate.h>
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <algorithm>
+#include <chrono>
+#include <getopt.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP("vespa-feed-bm");
+
+using namespace cloud::config::filedistribution;
+using namespace config;
+using namespace proton;
+using namespace vespa::config::search::core;
+using namespace vespa::config::search::summary;
+using namespace vespa::config::search;
+
+using document::AssignValueUpdate;
+using document::BucketId;
+using document::BucketSpace;
+using document::DataType;
+using document::Document;
+using document::DocumentId;
+using document::DocumentType;
+using document::DocumentTypeRepo;
+using document::DocumentUpdate;
+using document::DocumenttypesConfig;
+using document::FieldUpdate;
+using document::IntFieldValue;
+using document::StringFieldValue;
+using document::config_builder::DocumenttypesConfigBuilderHelper;
+using document::config_builder::Struct;
+using search::TuneFileDocumentDB;
+using search::index::DummyFileHeaderContext;
+using search::index::Schema;
+using search::index::SchemaBuilder;
+using search::transactionlog::TransLogServer;
+using storage::spi::PartitionId;
+using storage::spi::PersistenceProvider;
+using storage::spi::Timestamp;
+
+typedef std::chrono::steady_clock Clock;
+
+namespace {
+
+const int32_t doc_type_id = 787121340;
+const vespalib::string type_name = "test";
+const vespalib::string header_name = type_name + ".header";
+const vespalib::string body_name = type_name + ".body";
+const vespalib::string int_field = "int_field";
+const vespalib::string string_field = "string_field";
+const vespalib::string base_dir = "testdb";
+const int tls_listen_port = 9017;
+
+/**
+ * The schema shapes that can be benchmarked. Comparing the numbers
+ * for the different shapes tells how much of the feed cost is spent
+ * in the document store, the attributes and the memory index.
+ **/
+enum class SchemaShape { DOCSTORE, ATTRIBUTE, INDEX, FULL };
+
+bool hasAttribute(SchemaShape shape) { return (shape == SchemaShape::ATTRIBUTE) || (shape == SchemaShape::FULL); }
+bool hasIndex(SchemaShape shape) { return (shape == SchemaShape::INDEX) || (shape == SchemaShape::FULL); }
+
+const char *
+shapeName(SchemaShape shape)
+{
+    switch (shape) {
+    case SchemaShape::DOCSTORE:  return "docstore";
+    case SchemaShape::ATTRIBUTE: return "attribute";
+    case SchemaShape::INDEX:     return "index";
+    case SchemaShape::FULL:      return "full";
+    }
+    return "unknown";
+}
+
+std::shared_ptr<DocumenttypesConfig>
+makeDocTypesConfig()
+{
+    DocumenttypesConfigBuilderHelper builder;
+    builder.document(doc_type_id, type_name,
+                     Struct(header_name), Struct(body_name).
+                     addField(int_field, DataType::T_INT).
+                     addField(string_field, DataType::T_STRING));
+    return std::make_shared<DocumenttypesConfig>(builder.config());
+}
+
+DocumentDBConfig::SP
+makeDocumentDBConfig(SchemaShape shape, const std::shared_ptr<DocumenttypesConfig> &typeCfg,
+                     const DocumentTypeRepo::SP &repo)
+{
+    IndexschemaConfigBuilder indexBuilder;
+    if (hasIndex(shape)) {
+        indexBuilder.indexfield.resize(1);
+        indexBuilder.indexfield[0].name = string_field;
+    }
+    AttributesConfigBuilder attributesBuilder;
+    if (hasAttribute(shape)) {
+        attributesBuilder.attribute.resize(1);
+        attributesBuilder.attribute[0].name = int_field;
+        attributesBuilder.attribute[0].datatype = AttributesConfigBuilder::Attribute::Datatype::INT32;
+    }
+    auto indexschema = std::make_shared<IndexschemaConfig>(indexBuilder);
+    auto attributes = std::make_shared<AttributesConfig>(attributesBuilder);
+    auto summary = std::make_shared<SummaryConfig>();
+    auto schema = std::make_shared<Schema>();
+    SchemaBuilder::build(*indexschema, *schema);
+    SchemaBuilder::build(*attributes, *schema);
+    SchemaBuilder::build(*summary, *schema);
+    return std::make_shared<DocumentDBConfig>(1,
+                                              std::make_shared<RankProfilesConfig>(),
+                                              std::make_shared<matching::RankingConstants>(),
+                                              indexschema,
+                                              attributes,
+                                              summary,
+                                              std::make_shared<SummarymapConfig>(),
+                                              std::make_shared<JuniperrcConfig>(),
+                                              typeCfg,
+                                              repo,
+                                              std::make_shared<ImportedFieldsConfig>(),
+                                              std::make_shared<TuneFileDocumentDB>(),
+                                              schema,
+                                              std::make_shared<DocumentDBMaintenanceConfig>(),
+                                              search::LogDocumentStore::Config(),
+                                              "client",
+                                              type_name);
+}
+
+storage::spi::ClusterState
+makeClusterState()
+{
+    using storage::lib::Distribution;
+    using storage::lib::Node;
+    using storage::lib::NodeState;
+    using storage::lib::NodeType;
+    using storage::lib::State;
+    using vespa::config::content::StorDistributionConfigBuilder;
+    typedef StorDistributionConfigBuilder::Group Group;
+    typedef Group::Nodes Nodes;
+    storage::lib::ClusterState cstate;
+    StorDistributionConfigBuilder dc;
+
+    cstate.setNodeState(Node(NodeType::STORAGE, 0),
+                        NodeState(NodeType::STORAGE, State::UP, "dummy desc", 1.0, 1));
+    cstate.setClusterState(State::UP);
+    dc.redundancy = 1;
+    dc.readyCopies = 1;
+    dc.group.push_back(Group());
+    Group &g(dc.group[0]);
+    g.index = "invalid";
+    g.name = "invalid";
+    g.capacity = 1.0;
+    g.partitions = "";
+    g.nodes.push_back(Nodes());
+    Nodes &n(g.nodes[0]);
+    n.index = 0;
+    Distribution dist(dc);
+    return storage::spi::ClusterState(cstate, 0, dist);
+}
+
+struct MyDBOwner : public IDocumentDBOwner
+{
+    std::shared_ptr<IDocumentDBReferenceRegistry> _registry;
+    MyDBOwner() : _registry(std::make_shared<DocumentDBReferenceRegistry>()) {}
+    bool isInitializing() const override { return false; }
+    uint32_t getDistributionKey() const override { return -1; }
+    std::shared_ptr<IDocumentDBReferenceRegistry> getDocumentDBReferenceRegistry() const override {
+        return _registry;
+    }
+};
+
+struct MyPersistenceEngineOwner : public IPersistenceEngineOwner
+{
+    void setClusterState(const storage::spi::ClusterState &) override { }
+};
+
+struct MyResourceWriteFilter : public IResourceWriteFilter
+{
+    bool acceptWriteOperation() const override { return true; }
+    State getAcceptState() const override { return IResourceWriteFilter::State(); }
+};
+
+/**
+ * Latency samples for one kind of feed operation.
+ **/
+class OpStats
+{
+private:
+    vespalib::string    _name;
+    std::vector<double> _latencies;
+    double              _elapsed;
+
+    double percentile(const std::vector<double> &sorted, double p) const {
+        size_t idx = std::min(sorted.size() - 1, size_t(p * sorted.size()));
+        return sorted[idx];
+    }
+public:
+    OpStats(const vespalib::string &name, size_t expected)
+        : _name(name), _latencies(), _elapsed(0.0)
+    {
+        _latencies.reserve(expected);
+    }
+    void add(double latency) { _latencies.push_back(latency); }
+    void setElapsed(double elapsed) { _elapsed = elapsed; }
+    void report() const {
+        if (_latencies.empty()) {
+            return;
+        }
+        std::vector<double> sorted(_latencies);
+        std::sort(sorted.begin(), sorted.end());
+        fprintf(stdout, "%-8s %8zu ops %10.1f ops/s   latency(ms) p50=%.3f p90=%.3f p99=%.3f max=%.3f\n",
+                _name.c_str(), sorted.size(), sorted.size() / _elapsed,
+                percentile(sorted, 0.5) * 1000.0, percentile(sorted, 0.9) * 1000.0,
+                percentile(sorted, 0.99) * 1000.0, sorted.back() * 1000.0);
+    }
+};
+
+double
+secondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+}
+
+/**
+ * Benchmark of the proton feed pipeline. A document db for a small
+ * document type is started in a temporary directory and fed through
+ * the persistence provider api, in the same way as the service layer
+ * feeds proton. All puts, then all updates and then all removes are
+ * timed and reported.
+ **/
+class FeedBmApp : public FastOS_Application
+{
+private:
+    SchemaShape _shape;
+    uint32_t    _documents;
+    uint32_t    _buckets;
+
+    void usage();
+    bool getOptions();
+    int runBenchmark();
+public:
+    FeedBmApp();
+    int Main() override;
+};
+
+FeedBmApp::FeedBmApp()
+    : _shape(SchemaShape::FULL),
+      _documents(100000),
+      _buckets(64)
+{
+}
+
+void
+FeedBmApp::usage()
+{
+    fprintf(stderr,
+            "USAGE: vespa-feed-bm [--schema docstore|attribute|index|full]\n"
+            "                     [--documents num] [--buckets num]\n");
+}
+
+bool
+FeedBmApp::getOptions()
+{
+    int c;
+    const char *optArgument = nullptr;
+    int longopt_index = 0;
+    static struct option longopts[] = {
+        { "schema", 1, nullptr, 0 },
+        { "documents", 1, nullptr, 0 },
+        { "buckets", 1, nullptr, 0 },
+        { nullptr, 0, nullptr, 0 }
+    };
+    enum longopts_enum {
+        LONGOPT_SCHEMA,
+        LONGOPT_DOCUMENTS,
+        LONGOPT_BUCKETS
+    };
+    int optIndex = 1;
+    while ((c = GetOptLong("", optArgument, optIndex, longopts, &longopt_index)) != -1) {
+        if (c != 0) {
+            return false;
+        }
+        switch (longopt_index) {
+        case LONGOPT_SCHEMA:
+            if (strcmp(optArgument, "docstore") == 0) {
+                _shape = SchemaShape::DOCSTORE;
+            } else if (strcmp(optArgument, "attribute") == 0) {
+                _shape = SchemaShape::ATTRIBUTE;
+            } else if (strcmp(optArgument, "index") == 0) {
+                _shape = SchemaShape::INDEX;
+            } else if (strcmp(optArgument, "full") == 0) {
+                _shape = SchemaShape::FULL;
+            } else {
+                return false;
+            }
+            break;
+        case LONGOPT_DOCUMENTS:
+            _documents = atoi(optArgument);
+            break;
+        case LONGOPT_BUCKETS:
+            _buckets = std::max(1, atoi(optArgument));
+            break;
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
+int
+FeedBmApp::runBenchmark()
+{
+    auto typeCfg = makeDocTypesConfig();
+    auto repo = std::make_shared<DocumentTypeRepo>(*typeCfg);
+    const DocumentType *docType = repo->getDocumentType(type_name);
+    DocTypeName docTypeName(type_name);
+    BucketSpace bucketSpace(document::test::makeBucketSpace(type_name));
+
+    vespalib::mkdir(base_dir, false);
+    vespalib::mkdir(base_dir + "/" + docTypeName.toString(), false);
+    vespalib::string inputCfg = base_dir + "/" + docTypeName.toString() + "/baseconfig";
+    {
+        FileConfigManager fileCfg(inputCfg, "", docTypeName.getName());
+        fileCfg.saveConfig(*makeDocumentDBConfig(_shape, typeCfg, repo), 1);
+    }
+    config::DirSpec spec(inputCfg + "/config-1");
+    auto tuneFileDocDB = std::make_shared<TuneFileDocumentDB>();
+    DocumentDBConfigHelper mgr(spec, docTypeName.getName());
+    auto bootstrap = std::make_shared<BootstrapConfig>(1, typeCfg, repo,
+                                                       std::make_shared<ProtonConfig>(),
+                                                       std::make_shared<FiledistributorrpcConfig>(),
+                                                       tuneFileDocDB);
+    mgr.forwardConfig(bootstrap);
+    mgr.nextGeneration(0);
+
+    DummyFileHeaderContext fileHeaderContext;
+    TransLogServer tls("tls", tls_listen_port, base_dir, fileHeaderContext);
+    matching::QueryLimiter queryLimiter;
+    vespalib::Clock clock;
+    DummyWireService metricsWireService;
+    MemoryConfigStores configStores;
+    vespalib::ThreadStackExecutor summaryExecutor(8, 128 * 1024);
+    MyDBOwner owner;
+    auto docDb = std::make_shared<DocumentDB>(base_dir, mgr.getConfig(),
+                                              vespalib::make_string("tcp/localhost:%d", tls_listen_port),
+                                              queryLimiter, clock, docTypeName, bucketSpace,
+                                              *bootstrap->getProtonConfigSP(), owner,
+                                              summaryExecutor, summaryExecutor, tls, metricsWireService,
+                                              fileHeaderContext, configStores.getConfigStore(docTypeName.toString()),
+                                              std::make_shared<vespalib::ThreadStackExecutor>(16, 128 * 1024),
+                                              HwInfo());
+    docDb->start();
+    docDb->waitForOnlineState();
+
+    MyPersistenceEngineOwner engineOwner;
+    MyResourceWriteFilter writeFilter;
+    PersistenceEngine engine(engineOwner, writeFilter, -1, false);
+    engine.putHandler(bucketSpace, docTypeName, std::make_shared<PersistenceHandlerProxy>(docDb));
+    storage::spi::LoadType loadType(0, "default");
+    storage::spi::Context context(loadType, storage::spi::Priority(0), storage::spi::Trace::TraceLevel(0));
+    engine.setClusterState(bucketSpace, makeClusterState());
+    std::vector<storage::spi::Bucket> buckets;
+    for (uint32_t i = 0; i < _buckets; ++i) {
+        storage::spi::Bucket bucket(document::Bucket(bucketSpace, BucketId(16, i)), PartitionId(0));
+        engine.createBucket(bucket, context);
+        engine.setActiveState(bucket, storage::spi::BucketInfo::ACTIVE);
+        buckets.push_back(bucket);
+    }
+
+    std::vector<DocumentId> ids;
+    ids.reserve(_documents);
+    for (uint32_t i = 0; i < _documents; ++i) {
+        ids.emplace_back(vespalib::make_string("id:test:%s:n=%u:%u", type_name.c_str(), i % _buckets, i));
+    }
+    const document::Field &intField = docType->getField(int_field);
+    const document::Field &stringField = docType->getField(string_field);
+    uint64_t timestamp = 1000;
+    fprintf(stdout, "schema=%s documents=%u buckets=%u\n", shapeName(_shape), _documents, _buckets);
+
+    OpStats putStats("put", _documents);
+    Clock::time_point start = Clock::now();
+    for (uint32_t i = 0; i < _documents; ++i) {
+        auto doc = std::make_shared<Document>(*docType, ids[i]);
+        doc->setValue(intField, IntFieldValue(i));
+        doc->setValue(stringField, StringFieldValue(vespalib::make_string("word%u common word%u", i % 1000, i % 17)));
+        Clock::time_point opStart = Clock::now();
+        engine.put(buckets[i % _buckets], Timestamp(++timestamp), doc, context);
+        putStats.add(secondsSince(opStart));
+    }
+    putStats.setElapsed(secondsSince(start));
+
+    OpStats updateStats("update", _documents);
+    start = Clock::now();
+    for (uint32_t i = 0; i < _documents; ++i) {
+        auto upd = std::make_shared<DocumentUpdate>(*docType, ids[i]);
+        upd->addUpdate(FieldUpdate(intField).addUpdate(AssignValueUpdate(IntFieldValue(i + 1))));
+        Clock::time_point opStart = Clock::now();
+        engine.update(buckets[i % _buckets], Timestamp(++timestamp), upd, context);
+        updateStats.add(secondsSince(opStart));
+    }
+    updateStats.setElapsed(secondsSince(start));
+
+    OpStats removeStats("remove", _documents);
+    start = Clock::now();
+    for (uint32_t i = 0; i < _documents; ++i) {
+        Clock::time_point opStart = Clock::now();
+        engine.remove(buckets[i % _buckets], Timestamp(++timestamp), ids[i], context);
+        removeStats.add(secondsSince(opStart));
+    }
+    removeStats.setElapsed(secondsSince(start));
+
+    putStats.report();
+    updateStats.report();
+    removeStats.report();
+
+    engine.destroyIterators();
+    engine.removeHandler(bucketSpace, docTypeName);
+    docDb->close();
+    return 0;
+}
+
+int
+FeedBmApp::Main()
+{
+    if (!getOptions()) {
+        usage();
+        return 1;
+    }
+    FastOS_FileInterface::EmptyAndRemoveDirectory(base_dir.c_str());
+    int result = runBenchmark();
+    FastOS_FileInterface::EmptyAndRemoveDirectory(base_dir.c_str());
+    return result;
+}
+
+int
+main(int argc, char **argv)
+{
+    FeedBmApp app;
+    return app.Entry(argc, argv);
+}
@@ -3,6 +3,7 @@
 #include <vespa/config/helper/configgetter.h>
 
 #include <vespa/searchcore/proton/server/replaypacketdispatcher.h>
+#include <vespa/searchcore/proton/feedoperation/feedoperation.h>
 #include <vespa/searchlib/common/fileheadercontext.h>
 #include <vespa/searchlib/transactionlog/translogclient.h>
 #include <vespa/searchlib/transactionlog/translogserver.h>
@@ -14,7 +15,10 @@
 #include <vespa/document/update/documentupdate.h>
 #include <vespa/config/helper/configgetter.hpp>
 #include <vespa/fastos/app.h>
+#include <vespa/fastos/timestamp.h>
 #include <iostream>
+#include <algorithm>
+#include <unordered_map>
 
 #include <vespa/log/log.h>
 LOG_SETUP("vespa-transactionlog-inspect");
@@ -283,6 +287,71 @@ public:
 };
 
 
+/**
+ * Class the receives all concrete operations as part of a domain visit
+ * and counts how many operations touch each document.
+ */
+class HotDocumentCounter : public IReplayPacketHandler
+{
+private:
+    DocumentTypeRepo &_repo;
+    DummyStreamHandler _streamHandler;
+    std::unordered_map<std::string, size_t> _counts;
+
+    void count(const document::DocumentId &docId) { ++_counts[docId.toString()]; }
+
+public:
+    typedef std::pair<std::string, size_t> DocCount;
+
+    HotDocumentCounter(DocumentTypeRepo &repo)
+        : _repo(repo),
+          _streamHandler(),
+          _counts()
+    {
+    }
+    virtual void replay(const PutOperation &op) override {
+        if (op.getDocument().get() != NULL) {
+            count(op.getDocument()->getId());
+        }
+    }
+    virtual void replay(const RemoveOperation &op) override { count(op.getDocumentId()); }
+    virtual void replay(const UpdateOperation &op) override {
+        if (op.getUpdate().get() != NULL) {
+            count(op.getUpdate()->getId());
+        }
+    }
+    virtual void replay(const NoopOperation &) override { }
+    virtual void replay(const NewConfigOperation &) override { }
+    virtual void replay(const WipeHistoryOperation &) override { }
+    virtual void replay(const DeleteBucketOperation &) override { }
+    virtual void replay(const SplitBucketOperation &) override { }
+    virtual void replay(const JoinBucketsOperation &) override { }
+    virtual void replay(const PruneRemovedDocumentsOperation &) override { }
+    virtual void replay(const SpoolerReplayStartOperation &) override { }
+    virtual void replay(const SpoolerReplayCompleteOperation &) override { }
+    virtual void replay(const MoveOperation &) override { }
+    virtual void replay(const CreateBucketOperation &) override { }
+    virtual void replay(const CompactLidSpaceOperation &) override { }
+    virtual NewConfigOperation::IStreamHandler &getNewConfigStreamHandler() override {
+        return _streamHandler;
+    }
+    virtual document::DocumentTypeRepo &getDeserializeRepo() override {
+        return _repo;
+    }
+
+    size_t numDocuments() const { return _counts.size(); }
+
+    std::vector<DocCount> getHottest(size_t maxDocs) const {
+        std::vector<DocCount> result(_counts.begin(), _counts.end());
+        auto byCountDesc = [](const DocCount &lhs, const DocCount &rhs) { return lhs.second > rhs.second; };
+        size_t numDocs = std::min(maxDocs, result.size());
+        std::partial_sort(result.begin(), result.begin() + numDocs, result.end(), byCountDesc);
+        result.resize(numDocs);
+        return result;
+    }
+};
+
+
 /**
  * Class that receives packets from the tls as part of a domain visit
  * and dispatches each packet entry to the ReplayPacketDispatcher that
@@ -320,6 +389,64 @@ public:
 };
 
 
+/**
+ * Per operation type statistics gathered while replaying a tls domain.
+ */
+struct OperationStats
+{
+    size_t   count;
+    size_t   bytes;
+    uint64_t replayNs;
+    OperationStats() : count(0), bytes(0), replayNs(0) {}
+};
+
+
+/**
+ * Class that receives packets from the tls as part of a domain visit
+ * and times the deserialization and dispatch of each packet entry.
+ */
+class TimingVisitorCallback : public TransLogClient::Session::Callback
+{
+private:
+    ReplayPacketDispatcher _dispatcher;
+    std::map<uint32_t, OperationStats> _stats;
+    bool _eof;
+
+public:
+    TimingVisitorCallback(IReplayPacketHandler &handler)
+        : _dispatcher(handler),
+          _stats(),
+          _eof(false)
+    {
+    }
+    virtual RPC::Result receive(const Packet &packet) override {
+        vespalib::nbostream_longlivedbuf handle(packet.getHandle().c_str(), packet.getHandle().size());
+        try {
+            while (handle.size() > 0) {
+                Packet::Entry entry;
+                entry.deserialize(handle);
+                fastos::StopWatch timer;
+                timer.start();
+                _dispatcher.replayEntry(entry);
+                timer.stop();
+                OperationStats &stats = _stats[entry.type()];
+                ++stats.count;
+                stats.bytes += entry.data().size();
+                stats.replayNs += timer.elapsed().ns();
+            }
+        } catch (const std::exception &e) {
+            std::cerr << "Error while handling transaction log packet: '"
+                << std::string(e.what()) << "'" << std::endl;
+            return RPC::ERROR;
+        }
+        return RPC::OK;
+    }
+    virtual void eof() override { _eof = true; }
+    bool isEof() const { return _eof; }
+    const std::map<uint32_t, OperationStats> &getStats() const { return _stats; }
+};
+
+
 /**
  * Interface for a utility.
  */
@@ -582,6 +709,138 @@ DumpDocumentsOptions::createUtility() const
 }
 
 
+/**
+ * Program options used by ReplayStatsUtility.
+ */
+struct ReplayStatsOptions : public DumpOperationsOptions
+{
+    uint32_t hotDocs;
+    double applyCostUs;
+    ReplayStatsOptions(int argc, const char* const* argv);
+    ~ReplayStatsOptions();
+    static std::string command() { return "replaystats"; }
+    virtual std::string toString() const override {
+        return vespalib::make_string("%s, hotdocs=%u, applycost=%f",
+                                     DumpOperationsOptions::toString().c_str(),
+                                     hotDocs, applyCostUs);
+    }
+    virtual Utility::UP createUtility() const override;
+};
+
+ReplayStatsOptions::ReplayStatsOptions(int argc, const char* const* argv)
+    : DumpOperationsOptions(argc, argv)
+{
+    _opts.addOption("hotdocs", hotDocs, 10u, "Number of most frequently touched documents to list");
+    _opts.addOption("applycost", applyCostUs, 0.0,
+                    "Estimated cost (in microseconds) of applying a document operation to a document db, "
+                    "added to the measured replay cost when projecting replay time");
+    _opts.setSyntaxMessage("Utility to replay a range of operations ([first,last]) in a tls domain "
+                           "and report per operation type replay cost, hot documents and projected replay time");
+}
+ReplayStatsOptions::~ReplayStatsOptions() {}
+
+
+/**
+ * Utility to replay a range of operations in a tls domain and report
+ * the cost of doing so.
+ */
+class ReplayStatsUtility : public BaseUtility
+{
+protected:
+    const ReplayStatsOptions &_ropts;
+
+    static const char *typeName(uint32_t type) {
+        switch (type) {
+        case FeedOperation::PUT: return "put";
+        case FeedOperation::REMOVE: return "remove";
+        case FeedOperation::REMOVE_BATCH: return "remove_batch";
+        case FeedOperation::UPDATE_42: return "update_42";
+        case FeedOperation::NOOP: return "noop";
+        case FeedOperation::NEW_CONFIG: return "new_config";
+        case FeedOperation::WIPE_HISTORY: return "wipe_history";
+        case FeedOperation::DELETE_BUCKET: return "delete_bucket";
+        case FeedOperation::SPLIT_BUCKET: return "split_bucket";
+        case FeedOperation::JOIN_BUCKETS: return "join_buckets";
+        case FeedOperation::PRUNE_REMOVED_DOCUMENTS: return "prune_removed_documents";
+        case FeedOperation::SPOOLER_REPLAY_START: return "spooler_replay_start";
+        case FeedOperation::SPOOLER_REPLAY_COMPLETE: return "spooler_replay_complete";
+        case FeedOperation::MOVE: return "move";
+        case FeedOperation::CREATE_BUCKET: return "create_bucket";
+        case FeedOperation::COMPACT_LID_SPACE: return "compact_lid_space";
+        case FeedOperation::UPDATE: return "update";
+        default: return "unknown";
+        }
+    }
+
+    static bool isDocumentOperation(uint32_t type) {
+        return type == FeedOperation::PUT || type == FeedOperation::REMOVE ||
+            type == FeedOperation::UPDATE_42 || type == FeedOperation::UPDATE ||
+            type == FeedOperation::MOVE;
+    }
+
+public:
+    ReplayStatsUtility(const ReplayStatsOptions &ropts)
+        : BaseUtility(ropts),
+          _ropts(ropts)
+    {
+    }
+    virtual int run() override {
+        std::cout << ReplayStatsOptions::command() << ": " << _ropts.toString() << std::endl;
+        DocTypeRepo repo(_ropts.configDir);
+        HotDocumentCounter handler(repo.docTypeRepo);
+        TimingVisitorCallback callback(handler);
+        fastos::StopWatch timer;
+        timer.start();
+        TransLogClient::Visitor::UP visitor = _client.createVisitor(_ropts.domainName, callback);
+        bool visitOk = visitor->visit(_ropts.firstSerialNum-1, _ropts.lastSerialNum);
+        if (!visitOk) {
+            std::cerr << "Visiting domain '" << _ropts.domainName << "' [" << _ropts.firstSerialNum << ","
+                << _ropts.lastSerialNum << "] failed" << std::endl;
+            return 1;
+        }
+        for (size_t i = 0; !callback.isEof() && (i < 60 * 60 * 100); i++ ) {
+            FastOS_Thread::Sleep(10);
+        }
+        timer.stop();
+
+        size_t totalCount = 0;
+        size_t documentOps = 0;
+        uint64_t totalReplayNs = 0;
+        std::cout << "Operation statistics:" << std::endl;
+        for (const auto &entry : callback.getStats()) {
+            const OperationStats &stats = entry.second;
+            std::cout << "  " << typeName(entry.first) << ": count=" << stats.count <<
+                ", bytes=" << stats.bytes <<
+                ", avgbytes=" << (stats.bytes / stats.count) <<
+                ", replaytime=" << (stats.replayNs / 1000000.0) << " ms" <<
+                ", avgreplaytime=" << (stats.replayNs / 1000.0 / stats.count) << " us" << std::endl;
+            totalCount += stats.count;
+            totalReplayNs += stats.replayNs;
+            if (isDocumentOperation(entry.first)) {
+                documentOps += stats.count;
+            }
+        }
+        std::cout << "Hottest documents (of " << handler.numDocuments() << " touched):" << std::endl;
+        for (const auto &doc : handler.getHottest(_ropts.hotDocs)) {
+            std::cout << "  " << doc.first << ": " << doc.second << " operations" << std::endl;
+        }
+        double projectedSec = totalReplayNs / 1000000000.0 + documentOps * _ropts.applyCostUs / 1000000.0;
+        std::cout << "Total: operations=" << totalCount <<
+            ", documentoperations=" << documentOps <<
+            ", replaytime=" << (totalReplayNs / 1000000.0) << " ms" <<
+            ", visittime=" << timer.elapsed().sec() << " s" << std::endl;
+        std::cout << "Projected replay time on restart: " << projectedSec << " s" << std::endl;
+        return 0;
+    }
+};
+
+Utility::UP
+ReplayStatsOptions::createUtility() const
+{
+    return Utility::UP(new ReplayStatsUtility(*this));
+}
+
+
 /**
  * Main application.
  */
@@ -610,6 +869,8 @@ private:
         DumpOperationsOptions(_argc, _argv).usage();
         replaceFirstArg(DumpDocumentsOptions::command());
         DumpDocumentsOptions(_argc, _argv).usage();
+        replaceFirstArg(ReplayStatsOptions::command());
+        ReplayStatsOptions(_argc, _argv).usage();
     }
 
 public:
@@ -638,6 +899,9 @@ App::Main() {
     } else if (strcmp(_argv[1], DumpDocumentsOptions::command().c_str()) == 0) {
         combineFirstArgs();
         opts.reset(new DumpDocumentsOptions(_argc-1, _argv+1));
+    } else if (strcmp(_argv[1], ReplayStatsOptions::command().c_str()) == 0) {
+        combineFirstArgs();
+        opts.reset(new ReplayStatsOptions(_argc-1, _argv+1));
     }
     if (opts.get() != NULL) {
         try {
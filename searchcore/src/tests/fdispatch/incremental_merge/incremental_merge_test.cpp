@@ -0,0 +1,87 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/log/log.h>
+LOG_SETUP("incremental_merge_test");
+#include <vespa/vespalib/testkit/testapp.h>
+
+#include <vespa/searchcore/fdispatch/search/incremental_merge.h>
+
+typedef FastS_IncrementalHitMerger::FS4_hit FS4_hit;
+
+std::vector<FS4_hit>
+makeHits(uint32_t partId, const std::vector<std::pair<uint32_t, search::HitRank>> &spec)
+{
+    std::vector<FS4_hit> hits(spec.size());
+    for (size_t i = 0; i < spec.size(); ++i) {
+        hits[i].HT_SetGlobalID(document::GlobalId::calculateFirstInBucket(document::BucketId(16, spec[i].first)));
+        hits[i].HT_SetMetric(spec[i].second);
+        hits[i].HT_SetPartID(partId);
+    }
+    return hits;
+}
+
+std::vector<FastS_hitresult>
+getHits(const FastS_IncrementalHitMerger &merger, size_t bufSize)
+{
+    std::vector<FastS_hitresult> buf(bufSize);
+    buf.resize(merger.fill(&buf[0], &buf[0] + buf.size()));
+    return buf;
+}
+
+TEST("requireThatResultsAreMergedInRankOrder")
+{
+    FastS_IncrementalHitMerger merger(10);
+    auto a = makeHits(0, {{1, 10.0}, {2, 7.0}, {3, 3.0}});
+    auto b = makeHits(1, {{4, 9.0}, {5, 8.0}, {6, 1.0}});
+    merger.addResult(&a[0], a.size());
+    merger.addResult(&b[0], b.size());
+    EXPECT_EQUAL(2u, merger.getNumResults());
+    auto hits = getHits(merger, 10);
+    ASSERT_EQUAL(6u, hits.size());
+    std::vector<search::HitRank> expRank = {10.0, 9.0, 8.0, 7.0, 3.0, 1.0};
+    std::vector<uint32_t> expPart = {0, 1, 1, 0, 0, 1};
+    for (size_t i = 0; i < hits.size(); ++i) {
+        EXPECT_EQUAL(expRank[i], hits[i].HT_GetMetric());
+        EXPECT_EQUAL(expPart[i], hits[i].HT_GetPartID());
+    }
+}
+
+TEST("requireThatOnlyMaxHitsAreKept")
+{
+    FastS_IncrementalHitMerger merger(3);
+    auto a = makeHits(0, {{1, 5.0}, {2, 4.0}, {3, 1.0}});
+    auto b = makeHits(1, {{4, 6.0}, {5, 2.0}});
+    merger.addResult(&a[0], a.size());
+    merger.addResult(&b[0], b.size());
+    EXPECT_EQUAL(3u, merger.getNumHits());
+    auto hits = getHits(merger, 2);
+    ASSERT_EQUAL(2u, hits.size());
+    EXPECT_EQUAL(6.0, hits[0].HT_GetMetric());
+    EXPECT_EQUAL(5.0, hits[1].HT_GetMetric());
+}
+
+TEST("requireThatDuplicateGlobalIdsAreRemoved")
+{
+    FastS_IncrementalHitMerger merger(10);
+    auto a = makeHits(0, {{1, 5.0}, {2, 4.0}});
+    auto b = makeHits(1, {{1, 5.0}, {3, 3.0}});
+    merger.addResult(&a[0], a.size());
+    merger.addResult(&b[0], b.size());
+    auto hits = getHits(merger, 10);
+    ASSERT_EQUAL(3u, hits.size());
+    EXPECT_EQUAL(0u, hits[0].HT_GetPartID());
+    EXPECT_EQUAL(4.0, hits[1].HT_GetMetric());
+    EXPECT_EQUAL(3.0, hits[2].HT_GetMetric());
+}
+
+TEST("requireThatEmptyResultsAreCounted")
+{
+    FastS_IncrementalHitMerger merger(10);
+    merger.addResult(nullptr, 0);
+    EXPECT_EQUAL(1u, merger.getNumResults());
+    EXPECT_EQUAL(0u, merger.getNumHits());
+    EXPECT_TRUE(merger.valid());
+    merger.invalidate();
+    EXPECT_FALSE(merger.valid());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
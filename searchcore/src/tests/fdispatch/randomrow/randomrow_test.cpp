@@ -5,6 +5,7 @@ LOG_SETUP("randomrow_test");
 
 #include <vespa/searchcore/fdispatch/search/plain_dataset.h>
 
+using fdispatch::SearchTimePercentile;
 using fdispatch::StateOfRows;
 
 TEST("requireThatEmpyStateReturnsRowZero")
@@ -85,4 +86,30 @@ TEST("require randomness")
     EXPECT_EQUAL(333ul, counts[2]);
 }
 
+TEST("require that search time percentile is invalid until enough samples are seen")
+{
+    SearchTimePercentile p(90.0, 32);
+    EXPECT_FALSE(p.valid());
+    p.updateSearchTime(1.0);
+    EXPECT_FALSE(p.valid());
+    p.updateSearchTime(2.0);
+    EXPECT_TRUE(p.valid());
+    EXPECT_EQUAL(2.0, p.getPercentile());
+}
+
+TEST("require that search time percentile is estimated from recent samples")
+{
+    SearchTimePercentile p(90.0, 64);
+    for (size_t i(0); i < 64; i++) {
+        p.updateSearchTime(64.0 - i);
+    }
+    EXPECT_EQUAL(64u, p.numSamples());
+    EXPECT_EQUAL(58.0, p.getPercentile());
+    for (size_t i(0); i < 64; i++) {
+        p.updateSearchTime(100.0 + i);
+    }
+    EXPECT_EQUAL(64u, p.numSamples());
+    EXPECT_EQUAL(157.0, p.getPercentile());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -288,6 +288,24 @@ TEST_F("testGroupingManager", DoomFixture()) {
     ASSERT_TRUE(!manager.empty());
 }
 
+TEST_F("require that relevance order limit only covers ordered groupings", DoomFixture()) {
+    GroupingContext context(f1.clock, f1.timeOfDoom);
+    GroupingManager manager(context);
+    EXPECT_EQUAL(0u, manager.getRelevanceOrderLimit(100));
+
+    Grouping topN;
+    topN.setRoot(Group().addResult(SumAggregationResult().setExpression(MU<AttributeNode>("attr0"))))
+        .setTopN(10);
+    context.addGrouping(GroupingContext::GroupingPtr(new Grouping(topN)));
+    EXPECT_EQUAL(10u, manager.getRelevanceOrderLimit(100));
+    EXPECT_EQUAL(5u, manager.getRelevanceOrderLimit(5));
+
+    Grouping all;
+    all.setRoot(Group().addResult(SumAggregationResult().setExpression(MU<AttributeNode>("attr0"))));
+    context.addGrouping(GroupingContext::GroupingPtr(new Grouping(all)));
+    EXPECT_EQUAL(100u, manager.getRelevanceOrderLimit(100));
+}
+
 TEST_F("testGroupingSession", DoomFixture()) {
     MyWorld world;
     world.basicSetup();
@@ -4,11 +4,14 @@
 #include <vespa/searchcore/proton/attribute/attribute_directory.h>
 #include <vespa/searchcore/proton/attribute/attribute_factory.h>
 #include <vespa/searchcore/proton/attribute/attribute_initializer.h>
+#include <vespa/searchcore/proton/attribute/attribute_load_limiter.h>
 #include <vespa/searchcore/proton/attribute/attributedisklayout.h>
+#include <vespa/searchcore/proton/attribute/parallel_attributes_initializer.h>
 #include <vespa/searchcore/proton/test/attribute_utils.h>
 #include <vespa/searchlib/attribute/attributefactory.h>
 #include <vespa/searchlib/test/directory_handler.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <thread>
 
 using search::attribute::Config;
 using search::attribute::BasicType;
@@ -196,6 +199,77 @@ TEST("require that too old attribute is not loaded")
     EXPECT_EQUAL(1u, av->getNumDocs());
 }
 
+TEST("require that estimated load size is based on saved attribute files")
+{
+    saveAttr("a", int32_sv, 10, 2);
+    Fixture f;
+    EXPECT_LESS(0u, f.createInitializer({"a", int32_sv}, 5)->getEstimatedLoadSize());
+    EXPECT_EQUAL(0u, f.createInitializer({"b", int32_sv}, 5)->getEstimatedLoadSize());
+}
+
+TEST("require that attributes are loaded in parallel in order of adding")
+{
+    saveAttr("a", int32_sv, 10, 2);
+    saveAttr("b", int32_sv, 10, 3);
+    saveAttr("c", int32_sv, 10, 4);
+    Fixture f;
+    AttributeLoadLimiter limiter(2, 0);
+    ParallelAttributesInitializer initializer(limiter);
+    initializer.add(f.createInitializer({"c", int32_sv}, 5));
+    initializer.add(f.createInitializer({"a", int32_sv}, 5));
+    initializer.add(f.createInitializer({"d", int32_sv}, 5));
+    initializer.add(f.createInitializer({"b", int32_sv}, 5));
+    initializer.load(1);
+    const auto &attrs = initializer.getInitializedAttributes();
+    ASSERT_EQUAL(4u, attrs.size());
+    EXPECT_EQUAL("c", attrs[0].getAttribute()->getName());
+    EXPECT_EQUAL(4u, attrs[0].getAttribute()->getCreateSerialNum());
+    EXPECT_EQUAL("a", attrs[1].getAttribute()->getName());
+    EXPECT_EQUAL(2u, attrs[1].getAttribute()->getCreateSerialNum());
+    EXPECT_EQUAL("d", attrs[2].getAttribute()->getName());
+    EXPECT_EQUAL(5u, attrs[2].getAttribute()->getCreateSerialNum());
+    EXPECT_EQUAL("b", attrs[3].getAttribute()->getName());
+    EXPECT_EQUAL(2u, attrs[3].getAttribute()->getNumDocs());
+    EXPECT_EQUAL(0u, limiter.getLoads());
+}
+
+TEST("require that load limiter always allows a single load")
+{
+    AttributeLoadLimiter limiter(2, 100);
+    {
+        auto guard = limiter.acquire(1000);
+        EXPECT_EQUAL(1u, limiter.getLoads());
+        EXPECT_EQUAL(1000u, limiter.getMemoryUsage());
+    }
+    EXPECT_EQUAL(0u, limiter.getLoads());
+    EXPECT_EQUAL(0u, limiter.getMemoryUsage());
+}
+
+TEST("require that load limiter blocks load exceeding memory limit")
+{
+    AttributeLoadLimiter limiter(2, 100);
+    auto guard = std::make_unique<AttributeLoadLimiter::Guard>(limiter.acquire(60));
+    std::thread loader([&limiter]() { auto otherGuard = limiter.acquire(60); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQUAL(1u, limiter.getLoads());
+    EXPECT_EQUAL(60u, limiter.getMemoryUsage());
+    guard.reset();
+    loader.join();
+    EXPECT_EQUAL(0u, limiter.getLoads());
+}
+
+TEST("require that load limiter blocks load exceeding max loads")
+{
+    AttributeLoadLimiter limiter(1, 0);
+    auto guard = std::make_unique<AttributeLoadLimiter::Guard>(limiter.acquire(10));
+    std::thread loader([&limiter]() { auto otherGuard = limiter.acquire(10); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQUAL(1u, limiter.getLoads());
+    guard.reset();
+    loader.join();
+    EXPECT_EQUAL(0u, limiter.getLoads());
+}
+
 }
 
 TEST_MAIN()
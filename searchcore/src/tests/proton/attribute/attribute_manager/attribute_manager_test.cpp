@@ -7,6 +7,7 @@ LOG_SETUP("attribute_manager_test");
 #include <vespa/searchcommon/attribute/attributecontent.h>
 #include <vespa/searchcommon/attribute/iattributevector.h>
 #include <vespa/searchcore/proton/attribute/attribute_collection_spec_factory.h>
+#include <vespa/searchcore/proton/attribute/attribute_load_limiter.h>
 #include <vespa/searchcore/proton/attribute/attribute_manager_initializer.h>
 #include <vespa/searchcore/proton/attribute/attribute_writer.h>
 #include <vespa/searchcore/proton/attribute/attributemanager.h>
@@ -231,6 +232,7 @@ struct ParallelAttributeManager
     std::shared_ptr<AttributeManager::SP> mgr;
     vespalib::ThreadStackExecutor masterExecutor;
     ExecutorThreadService master;
+    AttributeLoadLimiter loadLimiter;
     AttributeManagerInitializer::SP initializer;
 
     ParallelAttributeManager(search::SerialNum configSerialNum, AttributeManager::SP baseAttrMgr,
@@ -249,10 +251,11 @@ ParallelAttributeManager::ParallelAttributeManager(search::SerialNum configSeria
       mgr(std::make_shared<AttributeManager::SP>()),
       masterExecutor(1, 128 * 1024),
       master(masterExecutor),
+      loadLimiter(3, 0),
       initializer(std::make_shared<AttributeManagerInitializer>(configSerialNum, documentMetaStoreInitTask,
                                                                 documentMetaStore, baseAttrMgr, attrCfg,
                                                                 attributeGrow, attributeGrowNumDocs,
-                                                                fastAccessAttributesOnly, master, mgr))
+                                                                fastAccessAttributesOnly, master, loadLimiter, mgr))
 {
     documentMetaStore->setCommittedDocIdLimit(docIdLimit);
     vespalib::ThreadStackExecutor executor(3, 128 * 1024);
@@ -175,6 +175,18 @@ checkSelect(const CachedSelect::SP &cs,
 }
 
 
+bool
+checkPreFilter(const CachedSelect::SP &cs,
+               uint32_t docId,
+               const Result &exp)
+{
+    SelectContext ctx(*cs);
+    ctx._docId = docId;
+    ctx.getAttributeGuards();
+    return checkSelect(cs->_attrPreFilter, ctx, exp);
+}
+
+
 class MyIntAv : public SvIntAttr
 {
     mutable uint32_t _gets;
@@ -592,6 +604,53 @@ TEST_F("Test that basic select works", TestFixture)
 }
 
 
+TEST_F("Test that attribute pre filter is used for mixed selections", TestFixture)
+{
+    MyDB &db(*f._db);
+
+    db.addDoc(1u, "doc:test:1", "hello", "null", 45, 37);
+    db.addDoc(2u, "doc:test:2", "gotcha", "foo", 3, 25);
+    db.addDoc(3u, "doc:test:3", "gotcha", "foo", noIntVal, noIntVal);
+    db.addDoc(4u, "doc:test:4", "null", "foo", noIntVal, noIntVal);
+
+    CachedSelect::SP cs;
+
+    cs = f.testParse("test.aa == 3", "test");
+    EXPECT_TRUE(cs->_attrSelect.get() != NULL);
+    EXPECT_TRUE(cs->_attrPreFilter.get() == NULL);
+
+    cs = f.testParse("test.ia == \"hello\"", "test");
+    EXPECT_TRUE(cs->_attrSelect.get() == NULL);
+    EXPECT_TRUE(cs->_attrPreFilter.get() == NULL);
+
+    cs = f.testParse("test.aa == 3 and test.ia == \"gotcha\"", "test");
+    EXPECT_TRUE(cs->_attrSelect.get() == NULL);
+    EXPECT_TRUE(cs->_attrPreFilter.get() != NULL);
+    EXPECT_EQUAL(2u, cs->_fieldNodes);
+    EXPECT_EQUAL(1u, cs->_svAttrFieldNodes);
+    TEST_DO(checkSelect(cs, db.getDoc(1u), Result::False));
+    TEST_DO(checkSelect(cs, db.getDoc(2u), Result::True));
+    TEST_DO(checkSelect(cs, db.getDoc(3u), Result::False));
+    TEST_DO(checkPreFilter(cs, 1u, Result::False));
+    TEST_DO(checkPreFilter(cs, 2u, Result::Invalid));
+    TEST_DO(checkPreFilter(cs, 3u, Result::False));
+
+    cs = f.testParse("test.aa == 3 or test.ia == \"gotcha\"", "test");
+    EXPECT_TRUE(cs->_attrSelect.get() == NULL);
+    EXPECT_TRUE(cs->_attrPreFilter.get() != NULL);
+    TEST_DO(checkSelect(cs, db.getDoc(3u), Result::True));
+    TEST_DO(checkPreFilter(cs, 1u, Result::Invalid));
+    TEST_DO(checkPreFilter(cs, 2u, Result::True));
+    TEST_DO(checkPreFilter(cs, 3u, Result::Invalid));
+
+    cs = f.testParse("not (test.aa == 3 or id == \"doc:test:1\")", "test");
+    EXPECT_TRUE(cs->_attrSelect.get() == NULL);
+    EXPECT_TRUE(cs->_attrPreFilter.get() != NULL);
+    TEST_DO(checkPreFilter(cs, 1u, Result::Invalid));
+    TEST_DO(checkPreFilter(cs, 2u, Result::False));
+}
+
+
 TEST_F("Test performance when using attributes", TestFixture)
 {
     MyDB &db(*f._db);
@@ -2,7 +2,9 @@
 
 #include <tests/proton/common/dummydbowner.h>
 #include <vespa/config/helper/configgetter.hpp>
+#include <vespa/eval/eval/value_cache/constant_tensor_loader.h>
 #include <vespa/eval/tensor/default_tensor.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
 #include <vespa/eval/tensor/serialization/typed_binary_format.h>
 #include <vespa/eval/tensor/tensor_factory.h>
 #include <vespa/document/test/make_bucket_space.h>
@@ -31,6 +33,8 @@
 #include <vespa/searchlib/transactionlog/translogserver.h>
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/encoding/base64.h>
+#include <vespa/vespalib/util/simple_thread_bundle.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/testkit/testapp.h>
 
 #include <vespa/log/log.h>
@@ -171,6 +175,7 @@ public:
     bool _mkdirOk;
     matching::QueryLimiter _queryLimiter;
     vespalib::Clock _clock;
+    vespalib::eval::ConstantTensorLoader _constantValueFactory;
     DummyWireService _dummy;
     config::DirSpec _spec;
     DocumentDBConfigHelper _configMgr;
@@ -190,6 +195,7 @@ public:
           _mkdirOk(FastOS_File::MakeDirectory("tmpdb")),
           _queryLimiter(),
           _clock(),
+          _constantValueFactory(vespalib::tensor::DefaultTensorEngine::ref()),
           _dummy(),
           _spec(TEST_PATH("")),
           _configMgr(_spec, getDocTypeName()),
@@ -210,10 +216,12 @@ public:
         _configMgr.nextGeneration(0);
         if (! FastOS_File::MakeDirectory((std::string("tmpdb/") + docTypeName).c_str())) { abort(); }
         _ddb.reset(new DocumentDB("tmpdb", _configMgr.getConfig(), "tcp/localhost:9013", _queryLimiter, _clock,
+                                  _constantValueFactory,
                                   DocTypeName(docTypeName), makeBucketSpace(),
 				  *b->getProtonConfigSP(), *this, _summaryExecutor, _summaryExecutor,
                                   _tls, _dummy, _fileHeaderContext, ConfigStore::UP(new MemoryConfigStore),
-                                  std::make_shared<vespalib::ThreadStackExecutor>(16, 128 * 1024), _hwInfo)),
+                                  std::make_shared<vespalib::ThreadStackExecutor>(16, 128 * 1024),
+                                  DocumentDB::InitializeThreads(), _hwInfo)),
         _ddb->start();
         _ddb->waitForOnlineState();
         _aw = AttributeWriter::UP(new AttributeWriter(_ddb->getReadySubDB()->getAttributeManager()));
@@ -324,6 +332,7 @@ private:
     void requireThatAdapterHandlesMultipleDocuments();
     void requireThatAdapterHandlesDocumentIdField();
     void requireThatDocsumRequestIsProcessed();
+    void requireThatDocsumRequestIsProcessedInParallel();
     void requireThatRewritersAreUsed();
     void requireThatAttributesAreUsed();
     void requireThatSummaryAdapterHandlesPutAndRemove();
@@ -637,6 +646,42 @@ Test::requireThatDocsumRequestIsProcessed()
 }
 
 
+void
+Test::requireThatDocsumRequestIsProcessedInParallel()
+{
+    Schema s;
+    s.addSummaryField(Schema::SummaryField("a", schema::DataType::INT32));
+
+    BuildContext bc(s);
+    DBContext dc(bc._repo, getDocTypeName());
+    const uint32_t numDocs = 20;
+    DocsumRequest req;
+    req.resultClassName = "class1";
+    for (uint32_t lid = 1; lid <= numDocs; ++lid) {
+        vespalib::string id = vespalib::make_string("doc::%u", lid);
+        dc.put(*bc._bld.startDocument(id).
+               startSummaryField("a").
+               addInt(lid * 10).
+               endField().
+               endDocument(),
+               lid);
+        req.hits.push_back(DocsumRequest::Hit(DocumentId(id).getGlobalId()));
+    }
+    req.hits.push_back(DocsumRequest::Hit(gid9));
+
+    vespalib::SimpleThreadBundle threadBundle(4);
+    DocsumReply::UP rep = dc._ddb->getDocsums(req, threadBundle);
+    EXPECT_EQUAL(numDocs + 1, rep->docsums.size());
+    for (uint32_t i = 0; i < numDocs; ++i) {
+        EXPECT_EQUAL(i + 1, rep->docsums[i].docid);
+        EXPECT_EQUAL(req.hits[i].gid, rep->docsums[i].gid);
+        EXPECT_TRUE(assertSlime(vespalib::make_string("{a:%u}", (i + 1) * 10), *rep, i, false));
+    }
+    EXPECT_EQUAL(search::endDocId, rep->docsums[numDocs].docid);
+    EXPECT_TRUE(rep->docsums[numDocs].data.get() == NULL);
+}
+
+
 void
 Test::requireThatRewritersAreUsed()
 {
@@ -1278,6 +1323,7 @@ Test::Main()
     TEST_DO(requireThatAdapterHandlesMultipleDocuments());
     TEST_DO(requireThatAdapterHandlesDocumentIdField());
     TEST_DO(requireThatDocsumRequestIsProcessed());
+    TEST_DO(requireThatDocsumRequestIsProcessedInParallel());
     TEST_DO(requireThatRewritersAreUsed());
     TEST_DO(requireThatAttributesAreUsed());
     TEST_DO(requireThatAnnotationsAreUsed());
@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include <vespa/document/test/make_bucket_space.h>
+#include <vespa/searchcore/proton/attribute/attribute_load_limiter.h>
 #include <vespa/searchcore/proton/attribute/imported_attributes_repo.h>
 #include <vespa/searchcore/proton/bucketdb/bucketdbhandler.h>
 #include <vespa/searchcore/proton/common/hw_info.h>
@@ -182,6 +183,7 @@ struct MyFastAccessContext
     LegacyAttributeMetrics _legacyAttributeMetrics;
     AttributeMetricsCollection _attributeMetricsCollection;
     MyMetricsWireService _wireService;
+    AttributeLoadLimiter _attributeLoadLimiter;
     FastAccessContext _ctx;
     MyFastAccessContext(IThreadingService &writeService,
                         ThreadStackExecutorBase &summaryExecutor,
@@ -203,7 +205,8 @@ MyFastAccessContext::MyFastAccessContext(IThreadingService &writeService, Thread
       _attributeMetrics(NULL), _legacyAttributeMetrics(NULL),
       _attributeMetricsCollection(_attributeMetrics, _legacyAttributeMetrics),
       _wireService(),
-      _ctx(_storeOnlyCtx._ctx, _attributeMetricsCollection, NULL, _wireService)
+      _attributeLoadLimiter(1, 0),
+      _ctx(_storeOnlyCtx._ctx, _attributeMetricsCollection, NULL, _wireService, _attributeLoadLimiter)
 {}
 MyFastAccessContext::~MyFastAccessContext() {}
 
@@ -95,9 +95,14 @@ struct MyDocumentRetriever : public DocumentRetrieverBaseForTest
 {
     DocumentTypeRepo::SP _repo;
     DocumentVector       _docs;
-    MyDocumentRetriever(DocumentTypeRepo::SP repo) : _repo(repo), _docs() {
+    mutable size_t       _visitCount;
+    MyDocumentRetriever(DocumentTypeRepo::SP repo) : _repo(repo), _docs(), _visitCount(0) {
         _docs.push_back(Document::SP()); // lid 0 invalid
     }
+    void visitDocuments(const LidVector &lids, search::IDocumentVisitor &visitor, ReadConsistency readConsistency) const override {
+        ++_visitCount;
+        DocumentRetrieverBaseForTest::visitDocuments(lids, visitor, readConsistency);
+    }
     virtual const document::DocumentTypeRepo &getDocumentTypeRepo() const override { return *_repo; }
     virtual void getBucketMetaData(const storage::spi::Bucket &,
                                    DocumentMetaData::Vector &) const override {}
@@ -288,6 +293,18 @@ TEST_F("require that bucket is cached when IDocumentMoveHandler handles move ope
     EXPECT_FALSE(f._bucketDb.takeGuard()->isCachedBucket(f._source.bucket(1)));
 }
 
+TEST_F("require that documents of a move step are retrieved in one batch", MoveFixture)
+{
+    f.setupForBucket(f._source.bucket(1), 6, 9);
+    f.moveDocuments(3);
+    EXPECT_EQUAL(3u, f._handler._moves.size());
+    EXPECT_EQUAL(1u, f._source._realRetriever->_visitCount);
+    f.moveDocuments(3);
+    EXPECT_TRUE(f._mover.bucketDone());
+    EXPECT_EQUAL(5u, f._handler._moves.size());
+    EXPECT_EQUAL(2u, f._source._realRetriever->_visitCount);
+}
+
 TEST_F("require that we can move documents in several steps", MoveFixture)
 {
     f.setupForBucket(f._source.bucket(1), 6, 9);
@@ -4,6 +4,8 @@
 #include <vespa/document/datatype/documenttype.h>
 #include <vespa/fastos/file.h>
 #include <vespa/document/test/make_bucket_space.h>
+#include <vespa/eval/eval/value_cache/constant_tensor_loader.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
 #include <vespa/searchcore/proton/attribute/flushableattribute.h>
 #include <vespa/searchcore/proton/common/feedtoken.h>
 #include <vespa/searchcore/proton/common/statusreport.h>
@@ -70,6 +72,7 @@ struct Fixture {
     TransLogServer _tls;
     matching::QueryLimiter _queryLimiter;
     vespalib::Clock _clock;
+    vespalib::eval::ConstantTensorLoader _constantValueFactory;
 
     Fixture();
     ~Fixture();
@@ -84,7 +87,8 @@ Fixture::Fixture()
       _fileHeaderContext(),
       _tls("tmp", 9014, ".", _fileHeaderContext),
       _queryLimiter(),
-      _clock()
+      _clock(),
+      _constantValueFactory(vespalib::tensor::DefaultTensorEngine::ref())
 {
     DocumentDBConfig::DocumenttypesConfigSP documenttypesConfig(new DocumenttypesConfig());
     DocumentType docType("typea", 0);
@@ -99,11 +103,11 @@ Fixture::Fixture()
                               tuneFileDocumentDB));
     mgr.forwardConfig(b);
     mgr.nextGeneration(0);
-    _db.reset(new DocumentDB(".", mgr.getConfig(), "tcp/localhost:9014", _queryLimiter, _clock, DocTypeName("typea"),
+    _db.reset(new DocumentDB(".", mgr.getConfig(), "tcp/localhost:9014", _queryLimiter, _clock, _constantValueFactory, DocTypeName("typea"),
                              makeBucketSpace(),
                              *b->getProtonConfigSP(), _myDBOwner, _summaryExecutor, _summaryExecutor, _tls, _dummy,
                              _fileHeaderContext, ConfigStore::UP(new MemoryConfigStore),
-                             std::make_shared<vespalib::ThreadStackExecutor>(16, 128 * 1024), _hwInfo));
+                             std::make_shared<vespalib::ThreadStackExecutor>(16, 128 * 1024), DocumentDB::InitializeThreads(), _hwInfo));
     _db->start();
     _db->waitForOnlineState();
 }
@@ -229,6 +233,27 @@ TEST_F("require that session manager can be explored", Fixture)
     EXPECT_TRUE(DocumentDBExplorer(f._db).get_child("session"));
 }
 
+TEST_F("require that initializer task timings can be explored", Fixture)
+{
+    auto explorer = DocumentDBExplorer(f._db).get_child("initializer");
+    ASSERT_TRUE(explorer);
+    Slime slime;
+    SlimeInserter inserter(slime);
+    explorer->get_state(inserter, true);
+    const vespalib::slime::Inspector &tasks = slime.get()["allTasks"];
+    EXPECT_LESS(0u, tasks.entries());
+    EXPECT_EQUAL(tasks.entries(), size_t(slime.get()["tasks"].asLong()));
+    bool foundSummary = false;
+    for (size_t i = 0; i < tasks.entries(); ++i) {
+        EXPECT_TRUE(tasks[i]["seconds"].asDouble() >= 0.0);
+        if (tasks[i]["name"].asString().make_string() == "0.ready.summary") {
+            foundSummary = true;
+            EXPECT_TRUE(tasks[i]["ioBound"].asBool());
+        }
+    }
+    EXPECT_TRUE(foundSummary);
+}
+
 TEST_F("require that document db registers reference", Fixture)
 {
     auto &registry = f._myDBOwner._registry;
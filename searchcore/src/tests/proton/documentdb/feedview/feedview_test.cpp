@@ -1075,6 +1075,35 @@ TEST_F("require that update() to attribute only updates attribute and not docume
     requireThatUpdateOnlyUpdatesAttributeAndNotDocumentStore(f);
 }
 
+TEST_F("require that repeated updates to fast-access attribute never touch document store",
+       FastAccessFeedViewFixture)
+{
+    f.maw._attrs.insert("a1");
+    putDocumentAndUpdate(f, "a1");
+    for (uint64_t ts = 30; ts < 60; ts += 10) {
+        DocumentContext dc("doc:test:1", ts, f.getBuilder());
+        dc.addFieldUpdate(f.getBuilder(), "a1");
+        f.updateAndWait(dc);
+    }
+    EXPECT_EQUAL(1u, f.msa._store._lastSyncToken); // document store not updated
+    assertAttributeUpdate(5u, DocumentId("doc:test:1"), 1, f.maw);
+}
+
+TEST_F("require that update to both fast-access attribute and other field updates document store",
+       FastAccessFeedViewFixture)
+{
+    f.maw._attrs.insert("a1");
+    DocumentContext dc1 = f.doc1();
+    f.putAndWait(dc1);
+    DocumentContext dc2("doc:test:1", 20, f.getBuilder());
+    dc2.addFieldUpdate(f.getBuilder(), "a1");
+    dc2.addFieldUpdate(f.getBuilder(), "s1");
+    f.updateAndWait(dc2);
+
+    EXPECT_EQUAL(2u, f.msa._store._lastSyncToken); // document store updated
+    assertAttributeUpdate(2u, DocumentId("doc:test:1"), 1, f.maw);
+}
+
 TEST_F("require that update to non fast-access attribute also updates document store",
         FastAccessFeedViewFixture)
 {
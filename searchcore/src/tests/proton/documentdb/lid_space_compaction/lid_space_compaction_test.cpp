@@ -238,10 +238,11 @@ struct JobFixtureBase
                    double resourceLimitFactor = RESOURCE_LIMIT_FACTOR,
                    double interval = JOB_DELAY,
                    bool nodeRetired = false,
-                   uint32_t maxOutstandingMoveOps = MAX_OUTSTANDING_MOVE_OPS)
+                   uint32_t maxOutstandingMoveOps = MAX_OUTSTANDING_MOVE_OPS,
+                   uint32_t maxDocsToMove = 1)
         : _handler(maxOutstandingMoveOps != MAX_OUTSTANDING_MOVE_OPS),
           _job(DocumentDBLidSpaceCompactionConfig(interval,
-                  allowedLidBloat, allowedLidBloatFactor, false, maxDocsToScan),
+                  allowedLidBloat, allowedLidBloatFactor, false, maxDocsToScan, maxDocsToMove),
                _handler, _storer, _frozenHandler, _diskMemUsageNotifier,
                BlockableMaintenanceJobConfig(resourceLimitFactor, maxOutstandingMoveOps),
                _clusterStateHandler, nodeRetired)
@@ -598,9 +599,9 @@ TEST_F("require that job is re-enabled when node is no longer retired", JobFixtu
 
 struct JobFixtureWithMaxOutstanding : public JobFixtureBase {
     MyCountJobRunner runner;
-    JobFixtureWithMaxOutstanding(uint32_t maxOutstandingMoveOps)
+    JobFixtureWithMaxOutstanding(uint32_t maxOutstandingMoveOps, uint32_t maxDocsToMove = 1)
         : JobFixtureBase(ALLOWED_LID_BLOAT, ALLOWED_LID_BLOAT_FACTOR, MAX_DOCS_TO_SCAN,
-                         RESOURCE_LIMIT_FACTOR, JOB_DELAY, false, maxOutstandingMoveOps),
+                         RESOURCE_LIMIT_FACTOR, JOB_DELAY, false, maxOutstandingMoveOps, maxDocsToMove),
           runner(_job)
     {}
     void assertRunToBlocked() {
@@ -657,6 +658,49 @@ TEST_F("require that job is blocked if it has too many outstanding move operatio
     TEST_DO(f.assertJobContext(4, 7, 3, 7, 1));
 }
 
+struct JobFixtureWithMaxDocsToMove : public JobFixtureBase {
+    MyDirectJobRunner _jobRunner;
+    JobFixtureWithMaxDocsToMove(uint32_t maxDocsToMove)
+        : JobFixtureBase(ALLOWED_LID_BLOAT, ALLOWED_LID_BLOAT_FACTOR, MAX_DOCS_TO_SCAN,
+                         RESOURCE_LIMIT_FACTOR, JOB_DELAY, false, MAX_OUTSTANDING_MOVE_OPS, maxDocsToMove),
+          _jobRunner(_job)
+    {}
+};
+
+TEST_F("require that job moves several documents per run (max=3)", JobFixtureWithMaxDocsToMove(3))
+{
+    f.setupThreeDocumentsToCompact();
+    EXPECT_FALSE(f.run());
+    TEST_DO(f.assertJobContext(4, 7, 3, 0, 0));
+    f.endScan().compact();
+    TEST_DO(f.assertJobContext(4, 7, 3, 7, 1));
+}
+
+TEST_F("require that job moves several documents per run (max=2)", JobFixtureWithMaxDocsToMove(2))
+{
+    f.setupThreeDocumentsToCompact();
+    EXPECT_FALSE(f.run());
+    TEST_DO(f.assertJobContext(3, 8, 2, 0, 0));
+    EXPECT_FALSE(f.run()); // last move and end of scan
+    TEST_DO(f.assertJobContext(4, 7, 3, 0, 0));
+    f.compact();
+    TEST_DO(f.assertJobContext(4, 7, 3, 7, 1));
+}
+
+TEST_F("require that job moving several documents per run is blocked by too many outstanding move operations", JobFixtureWithMaxOutstanding(2, 3))
+{
+    f.setupThreeDocumentsToCompact();
+
+    TEST_DO(f.assertRunToBlocked());
+    TEST_DO(f.assertJobContext(3, 8, 2, 0, 0));
+
+    f.unblockJob(1);
+    TEST_DO(f.assertRunToNotBlocked()); // last move and end of scan
+    TEST_DO(f.assertJobContext(4, 7, 3, 0, 0));
+    f.compact();
+    TEST_DO(f.assertJobContext(4, 7, 3, 7, 1));
+}
+
 TEST_MAIN()
 {
     TEST_RUN_ALL();
@@ -23,6 +23,7 @@ struct Fixture {
         builder.indexing.tasklimit = 500;
         builder.indexing.semiunboundtasklimit = 50000;
         builder.feeding.concurrency = 0.5;
+        builder.indexing.attribute.rebalance = true;
         return builder;
     }
     ThreadingServiceConfig make(uint32_t cpuCores) {
@@ -60,6 +61,11 @@ TEST_F("require that semiunbound task limit is scaled based on indexing threads"
     EXPECT_EQUAL(12500u, f.make(24).semiUnboundTaskLimit());
 }
 
+TEST_F("require that attribute writer rebalancing is set", Fixture)
+{
+    EXPECT_TRUE(f.make(24).rebalanceAttributeWriter());
+}
+
 TEST_MAIN()
 {
     TEST_RUN_ALL();
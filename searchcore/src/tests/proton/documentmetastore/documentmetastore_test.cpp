@@ -591,6 +591,36 @@ TEST("requireThatWeCanStoreBucketIdAndTimestamp")
     }
 }
 
+TEST("requireThatManyLidsCanBeRetrievedAtOnce")
+{
+    DocumentMetaStore dms(createBucketDB());
+    uint32_t numLids = 1000;
+
+    dms.constructFreeList();
+    for (uint32_t lid = 1; lid <= numLids; ++lid) {
+        addGid(dms, createGid(lid), Timestamp(lid + timestampBias));
+    }
+    std::vector<GlobalId> gids;
+    for (uint32_t lid = numLids + 100; lid > 0; lid -= 3) {
+        gids.push_back(createGid(lid));
+        if (lid < 3) {
+            break;
+        }
+    }
+    gids.push_back(createGid(7));
+    std::vector<uint32_t> lids;
+    dms.getLids(gids, lids);
+    ASSERT_EQUAL(gids.size(), lids.size());
+    for (size_t i = 0; i < gids.size(); ++i) {
+        uint32_t lid = 0;
+        bool found = dms.getLid(gids[i], lid);
+        EXPECT_EQUAL(found ? lid : 0u, lids[i]);
+    }
+    EXPECT_EQUAL(7u, lids.back());
+    dms.getLids(std::vector<GlobalId>(), lids);
+    EXPECT_EQUAL(0u, lids.size());
+}
+
 TEST("requireThatGidsCanBeSavedAndLoaded")
 {
     DocumentMetaStore dms1(createBucketDB());
@@ -1067,6 +1097,29 @@ TEST("requireThatBlackListBlueprintIsCreated")
                                 true,  f.dms.getCommittedDocIdLimit()));
 }
 
+TEST("requireThatBlackListBlueprintEstimatesInactiveLids")
+{
+    UserDocFixture f;
+    f.dms.constructFreeList();
+    f.addGlobalIds();
+
+    f.dms.setBucketState(f.bid1, true);
+    Blueprint::UP blackList = f.dms.createBlackListBlueprint();
+    EXPECT_EQUAL(3u, blackList->getState().estimate().estHits);
+    EXPECT_FALSE(blackList->getState().estimate().empty);
+
+    f.dms.setBucketState(f.bid2, true);
+    blackList = f.dms.createBlackListBlueprint();
+    EXPECT_EQUAL(0u, blackList->getState().estimate().estHits);
+    EXPECT_TRUE(blackList->getState().estimate().empty);
+
+    f.dms.remove(7);
+    f.dms.removeComplete(7);
+    blackList = f.dms.createBlackListBlueprint();
+    EXPECT_EQUAL(1u, blackList->getState().estimate().estHits);
+    EXPECT_FALSE(blackList->getState().estimate().empty);
+}
+
 TEST("requireThatDocumentAndMetaEntryCountIsUpdated")
 {
     UserDocFixture f;
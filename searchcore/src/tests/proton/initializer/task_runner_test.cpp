@@ -47,6 +47,18 @@ public:
 };
 
 
+class IoTask : public NamedTask
+{
+public:
+    IoTask(const vespalib::string &name, TestLog &log)
+        : NamedTask(name, log)
+    {
+    }
+
+    bool isIoBound() const override { return true; }
+};
+
+
 struct TestJob {
     TestLog::UP _log;
     InitializerTask::SP _root;
@@ -138,6 +150,38 @@ TEST_F("multiple threads, dag graph", Fixture(10))
     LOG(info, "dabc=%d, dbac=%d", dabc_count, dbac_count);
 }
 
+TEST("io bound tasks are run by io executor when given")
+{
+    vespalib::ThreadStackExecutor executor(2, 128 * 1024);
+    vespalib::ThreadStackExecutor ioExecutor(1, 128 * 1024);
+    TaskRunner taskRunner(executor, &ioExecutor);
+    TestLog log;
+    InitializerTask::SP A(std::make_shared<IoTask>("A", log));
+    InitializerTask::SP B(std::make_shared<NamedTask>("B", log));
+    InitializerTask::SP C(std::make_shared<IoTask>("C", log));
+    B->addDependency(A);
+    C->addDependency(B);
+    taskRunner.runTask(C);
+    EXPECT_EQUAL("ABC", log.result());
+    EXPECT_EQUAL(2u, ioExecutor.getStats().acceptedTasks);
+    EXPECT_EQUAL(1u, executor.getStats().acceptedTasks);
+}
+
+TEST_F("task timings are reported with dependencies first", Fixture(4))
+{
+    TestJob job = TestJob::setupDiamond();
+    job._root->setName("root");
+    f.run(job._root);
+    TaskRunner::TaskTimings timings = TaskRunner::getTaskTimings(job._root);
+    ASSERT_EQUAL(4u, timings.size());
+    EXPECT_TRUE(timings[0].name.find("NamedTask") != vespalib::string::npos);
+    EXPECT_EQUAL("root", timings[3].name);
+    for (const auto &timing : timings) {
+        EXPECT_TRUE(timing.seconds >= 0.0);
+        EXPECT_FALSE(timing.ioBound);
+    }
+}
+
 TEST_MAIN()
 {
     TEST_RUN_ALL();
@@ -2,10 +2,12 @@
 #include <vespa/searchcore/proton/matchengine/matchengine.h>
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/searchlib/engine/docsumreply.h>
+#include <vespa/searchlib/engine/errorcodes.h>
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <mutex>
 #include <condition_variable>
 #include <chrono>
+#include <thread>
 
 using namespace proton;
 using namespace search::engine;
@@ -150,6 +152,42 @@ TEST("requireThatBundlesAreUsed")
     EXPECT_EQUAL(5u, handler->bundleSize);
 }
 
+TEST("requireThatThreadsPerSearchIsFixedByDefault")
+{
+    MatchEngine engine(16, 4, 7);
+    EXPECT_EQUAL(4u, engine.getThreadsPerSearch(1));
+    EXPECT_EQUAL(4u, engine.getThreadsPerSearch(16));
+}
+
+TEST("requireThatAdaptiveThreadsPerSearchFollowsLoad")
+{
+    MatchEngine engine(16, 4, 7, false, true);
+    EXPECT_EQUAL(4u, engine.getThreadsPerSearch(0));
+    EXPECT_EQUAL(4u, engine.getThreadsPerSearch(1));
+    EXPECT_EQUAL(4u, engine.getThreadsPerSearch(4));
+    EXPECT_EQUAL(3u, engine.getThreadsPerSearch(5));
+    EXPECT_EQUAL(2u, engine.getThreadsPerSearch(8));
+    EXPECT_EQUAL(1u, engine.getThreadsPerSearch(16));
+    EXPECT_EQUAL(1u, engine.getThreadsPerSearch(100));
+}
+
+TEST("requireThatAdaptiveBundleUsesAllThreadsAtLowLoad")
+{
+    MatchEngine engine(15, 5, 7, false, true);
+    engine.setOnline();
+    engine.setNodeUp(true);
+
+    ObserveBundleMatchHandler::SP handler(new ObserveBundleMatchHandler());
+    DocTypeName dtnvfoo("foo");
+    engine.putSearchHandler(dtnvfoo, handler);
+
+    LocalSearchClient client;
+    SearchRequest::Source request(new SearchRequest());
+    engine.search(std::move(request), client);
+    SearchReply::UP reply = client.getReply(10000);
+    EXPECT_EQUAL(5u, handler->bundleSize);
+}
+
 TEST("requireThatHandlersCanBeRemoved")
 {
     MatchEngine engine(1, 1, 7);
@@ -200,6 +238,54 @@ TEST("requireThatEmptySearchReplyIsReturnedWhenEngineIsClosed")
     EXPECT_EQUAL(7u, reply->getDistributionKey());
 }
 
+class SlowSearchHandler : public MySearchHandler {
+public:
+    search::engine::SearchReply::UP match(const ISearchHandler::SP &handler,
+                                          const search::engine::SearchRequest &request,
+                                          vespalib::ThreadBundle &threadBundle) const override {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        return MySearchHandler::match(handler, request, threadBundle);
+    }
+};
+
+SearchReply::UP
+performSearchWithTimeout(MatchEngine &engine, uint32_t timeoutMs)
+{
+    auto request = std::make_unique<SearchRequest>();
+    request->setTimeout(timeoutMs * fastos::TimeStamp::MS);
+    LocalSearchClient client;
+    SearchReply::UP reply = engine.search(SearchRequest::Source(request.release()), client);
+    if (reply) {
+        return reply;
+    }
+    return client.getReply(10000);
+}
+
+TEST("requireThatRequestsWithLessTimeLeftThanServiceTimeAreRejected")
+{
+    MatchEngine engine(1, 1, 7);
+    engine.setOnline();
+    engine.setNodeUp(true);
+    engine.putSearchHandler(DocTypeName("foo"), std::make_shared<SlowSearchHandler>());
+
+    SearchReply::UP reply = performSearchWithTimeout(engine, 1);
+    ASSERT_TRUE(reply);
+    EXPECT_EQUAL(search::engine::ECODE_NO_ERROR, reply->errorCode);
+    EXPECT_TRUE(engine.getServiceTimeEstimate() > 0);
+
+    engine.setAdmissionControl(true);
+    reply = performSearchWithTimeout(engine, 1);
+    ASSERT_TRUE(reply);
+    EXPECT_EQUAL(search::engine::ECODE_OVERLOADED, reply->errorCode);
+    EXPECT_EQUAL(7u, reply->getDistributionKey());
+    EXPECT_EQUAL(1u, engine.getNumRejected());
+
+    reply = performSearchWithTimeout(engine, 10000);
+    ASSERT_TRUE(reply);
+    EXPECT_EQUAL(search::engine::ECODE_NO_ERROR, reply->errorCode);
+    EXPECT_EQUAL(1u, engine.getNumRejected());
+}
+
 TEST("requireThatStateIsReported")
 {
     MatchEngine engine(1, 1, 7);
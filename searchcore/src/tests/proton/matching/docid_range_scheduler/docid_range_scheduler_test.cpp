@@ -305,4 +305,115 @@ TEST_MT_FF("require that the adaptive scheduler handles fewer documents than thr
 
 //-----------------------------------------------------------------------------
 
+TEST("require that the work stealing scheduler starts by dividing the docid space equally") {
+    WorkStealingDocidRangeScheduler scheduler(4, 100, 16);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 15u);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 5)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(5, 9)));
+    TEST_DO(verify_range(scheduler.first_range(2), DocidRange(9, 13)));
+    TEST_DO(verify_range(scheduler.first_range(3), DocidRange(13, 16)));
+    EXPECT_EQUAL(scheduler.total_size(0), 4u);
+    EXPECT_EQUAL(scheduler.total_size(1), 4u);
+    EXPECT_EQUAL(scheduler.total_size(2), 4u);
+    EXPECT_EQUAL(scheduler.total_size(3), 3u);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 0u);
+}
+
+TEST("require that the work stealing scheduler reports the full span to all threads") {
+    WorkStealingDocidRangeScheduler scheduler(3, 1, 16);
+    TEST_DO(verify_range(scheduler.total_span(0), DocidRange(1,16)));
+    TEST_DO(verify_range(scheduler.total_span(1), DocidRange(1,16)));
+    TEST_DO(verify_range(scheduler.total_span(2), DocidRange(1,16)));
+}
+
+TEST("require that the work stealing scheduler hands out local work in increasing docid order") {
+    WorkStealingDocidRangeScheduler scheduler(1, 1, 101);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 26)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(26, 44)));
+    EXPECT_EQUAL(scheduler.total_size(0), 43u);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 57u);
+    uint32_t expect_begin = 44;
+    for (DocidRange range = scheduler.next_range(0); !range.empty(); range = scheduler.next_range(0)) {
+        EXPECT_EQUAL(range.begin, expect_begin);
+        expect_begin = range.end;
+    }
+    EXPECT_EQUAL(expect_begin, 101u);
+    EXPECT_EQUAL(scheduler.total_size(0), 100u);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 0u);
+}
+
+TEST("require that the work stealing scheduler lets idle threads steal half of the remaining work") {
+    WorkStealingDocidRangeScheduler scheduler(2, 1, 21);
+    DocidRange range = scheduler.first_range(0);
+    while (range.end <= 11) {
+        range = scheduler.next_range(0);
+    }
+    TEST_DO(verify_range(range, DocidRange(16, 17)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(11, 12)));
+    EXPECT_EQUAL(scheduler.total_size(0), 11u);
+    EXPECT_EQUAL(scheduler.total_size(1), 1u);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 8u);
+}
+
+TEST("require that the work stealing scheduler respects the minimal task size") {
+    WorkStealingDocidRangeScheduler scheduler(2, 3, 12);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 4)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(4, 7)));
+    // a range with size 5 will not be split
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange()));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(7, 10)));
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange(10, 12)));
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange()));
+}
+
+TEST_MT_FF("require that the work stealing scheduler assigns each docid exactly once",
+           8, WorkStealingDocidRangeScheduler(num_threads, 1, 100000),
+           std::vector<std::vector<DocidRange>>(num_threads))
+{
+    for (DocidRange range = f1.first_range(thread_id); !range.empty(); range = f1.next_range(thread_id)) {
+        f2[thread_id].push_back(range);
+    }
+    TEST_BARRIER();
+    if (thread_id == 0) {
+        std::vector<DocidRange> all;
+        for (size_t i = 0; i < num_threads; ++i) {
+            all.insert(all.end(), f2[i].begin(), f2[i].end());
+            size_t size = 0;
+            for (DocidRange range: f2[i]) {
+                size += range.size();
+            }
+            EXPECT_EQUAL(f1.total_size(i), size);
+        }
+        std::sort(all.begin(), all.end(), [](DocidRange a, DocidRange b) { return (a.begin < b.begin); });
+        uint32_t expect_begin = 1;
+        for (DocidRange range: all) {
+            EXPECT_EQUAL(range.begin, expect_begin);
+            expect_begin = range.end;
+        }
+        EXPECT_EQUAL(expect_begin, 100000u);
+        EXPECT_EQUAL(f1.unassigned_size(), 0u);
+    }
+}
+
+TEST_MT_F("require that the work stealing scheduler protects against documents underflow",
+          2, WorkStealingDocidRangeScheduler(num_threads, 1, 0))
+{
+    TEST_DO(verify_range(f1.first_range(thread_id), DocidRange()));
+    EXPECT_EQUAL(f1.total_size(thread_id), 0u);
+    EXPECT_EQUAL(f1.unassigned_size(), 0u);
+}
+
+TEST_MT_F("require that the work stealing scheduler handles fewer documents than threads",
+          4, WorkStealingDocidRangeScheduler(num_threads, 1, 3))
+{
+    for (DocidRange docid_range = f1.first_range(thread_id);
+         !docid_range.empty();
+         docid_range = f1.next_range(thread_id))
+    {
+        EXPECT_TRUE(docid_range.size() == 1);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -12,6 +12,9 @@ typedef MatchLoopCommunicator::Range Range;
 typedef MatchLoopCommunicator::RangePair RangePair;
 typedef MatchLoopCommunicator::feature_t feature_t;
 typedef MatchLoopCommunicator::Matches Matches;
+typedef MatchLoopCommunicator::Hit Hit;
+typedef MatchLoopCommunicator::Hits Hits;
+typedef MatchLoopCommunicator::TaggedHits TaggedHits;
 
 std::vector<feature_t> makeScores(size_t id) {
     switch (id) {
@@ -24,6 +27,15 @@ std::vector<feature_t> makeScores(size_t id) {
     return Box<feature_t>();
 }
 
+Hits makeHits(size_t id) {
+    Hits hits;
+    std::vector<feature_t> scores = makeScores(id);
+    for (size_t i = 0; i < scores.size(); ++i) {
+        hits.emplace_back(id * 10 + i, scores[i]);
+    }
+    return hits;
+}
+
 RangePair makeRanges(size_t id) {
     switch (id) {
     case 0: return std::make_pair(Range(5, 5), Range(7, 7));
@@ -75,6 +87,45 @@ TEST_MT_F("require that selectBest works with some empty threads", 10, MatchLoop
     }
 }
 
+TEST_F("require that second phase work is the best hits for single thread", MatchLoopCommunicator(num_threads, 3)) {
+    TaggedHits work = f1.get_second_phase_work(makeHits(0), 0);
+    ASSERT_EQUAL(3u, work.size());
+    for (size_t i = 0; i < work.size(); ++i) {
+        EXPECT_EQUAL(i, work[i].first.first);
+        EXPECT_EQUAL(0u, work[i].second);
+    }
+    Hits result = f1.complete_second_phase(work, 0);
+    ASSERT_EQUAL(3u, result.size());
+    EXPECT_EQUAL(makeHits(0)[2].first, result[2].first);
+}
+
+TEST_MT_F("require that second phase work is balanced across threads and returned to owners", 5, MatchLoopCommunicator(num_threads, 13)) {
+    TaggedHits work = f1.get_second_phase_work(makeHits(thread_id), thread_id);
+    EXPECT_TRUE(work.size() == 2u || work.size() == 3u);
+    for (auto &hit : work) {
+        hit.first.second = hit.first.first; // second phase score
+    }
+    Hits result = f1.complete_second_phase(work, thread_id);
+    if (thread_id < 3) {
+        EXPECT_EQUAL(3u, result.size());
+    } else {
+        EXPECT_EQUAL(2u, result.size());
+    }
+    for (const auto &hit : result) {
+        EXPECT_EQUAL(thread_id, hit.first / 10);
+        EXPECT_EQUAL(hit.first, hit.second);
+    }
+}
+
+TEST_MT_F("require that second phase work handles threads without hits", 4, MatchLoopCommunicator(num_threads, 4)) {
+    Hits hits = (thread_id == 0) ? makeHits(0) : Hits();
+    TaggedHits work = f1.get_second_phase_work(hits, thread_id);
+    ASSERT_EQUAL(1u, work.size());
+    EXPECT_EQUAL(0u, work[0].second);
+    Hits result = f1.complete_second_phase(work, thread_id);
+    EXPECT_EQUAL((thread_id == 0) ? 4u : 0u, result.size());
+}
+
 TEST_F("require that rangeCover is identity function for single thread", MatchLoopCommunicator(num_threads, 5)) {
     RangePair res = f1.rangeCover(std::make_pair(Range(2, 4), Range(3, 5)));
     EXPECT_EQUAL(2, res.first.low);
@@ -206,6 +206,24 @@ TEST("require that no limiter has no behavior") {
     EXPECT_FALSE(limiter.was_limited());
 }
 
+TEST("require that early termination limiter stops the search") {
+    EarlyTerminationLimiter et_limiter(100);
+    MaybeMatchPhaseLimiter &limiter = et_limiter;
+    EXPECT_TRUE(limiter.is_enabled());
+    EXPECT_FALSE(limiter.was_limited());
+    EXPECT_EQUAL(100u, limiter.sample_hits_per_thread(1));
+    EXPECT_EQUAL(34u, limiter.sample_hits_per_thread(3));
+    SearchIterator::UP search = prepare(new MockSearch("search"));
+    search->seek(500);
+    search = limiter.maybe_limit(std::move(search), 0.5, 10000);
+    EXPECT_TRUE(limiter.was_limited());
+    EXPECT_TRUE(search->isAtEnd());
+    EXPECT_TRUE(dynamic_cast<MockSearch*>(search.get()) == nullptr);
+    limiter.updateDocIdSpaceEstimate(500, 4500);
+    limiter.updateDocIdSpaceEstimate(5000, 0);
+    EXPECT_EQUAL(5500u, limiter.getDocIdSpaceEstimate());
+}
+
 TEST("require that the match phase limiter may chose not to limit the query") {
     FakeRequestContext requestContext;
     MockSearchable searchable;
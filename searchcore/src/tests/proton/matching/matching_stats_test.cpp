@@ -36,6 +36,24 @@ TEST("requireThatDocCountsAddUp") {
     EXPECT_EQUAL(2u, stats.limited_queries());
 }
 
+TEST("requireThatResultCacheCountsAddUp") {
+    MatchingStats stats;
+    EXPECT_EQUAL(0u, stats.resultCacheHits());
+    EXPECT_EQUAL(0u, stats.resultCacheMisses());
+    EXPECT_EQUAL(&stats.add(MatchingStats().resultCacheHits(3).resultCacheMisses(1)), &stats);
+    EXPECT_EQUAL(&stats.add(MatchingStats().resultCacheHits(2).resultCacheMisses(4)), &stats);
+    EXPECT_EQUAL(5u, stats.resultCacheHits());
+    EXPECT_EQUAL(5u, stats.resultCacheMisses());
+}
+
+TEST("requireThatRejectedQueryCountsAddUp") {
+    MatchingStats stats;
+    EXPECT_EQUAL(0u, stats.queriesRejected());
+    EXPECT_EQUAL(&stats.add(MatchingStats().queriesRejected(2)), &stats);
+    EXPECT_EQUAL(&stats.add(MatchingStats().queriesRejected(3)), &stats);
+    EXPECT_EQUAL(5u, stats.queriesRejected());
+}
+
 TEST("requireThatAverageTimesAreRecorded") {
     MatchingStats stats;
     EXPECT_APPROX(0.0, stats.matchTimeAvg(), 0.00001);
@@ -82,6 +100,19 @@ TEST("requireThatAverageTimesAreRecorded") {
     EXPECT_EQUAL(4u, stats.queryLatencyCount());
 }
 
+TEST("requireThatQueryLatencyDistributionIsRecorded") {
+    MatchingStats stats;
+    EXPECT_TRUE(stats.queryLatencyHistogram().empty());
+    for (size_t i = 0; i < 99; ++i) {
+        stats.add(MatchingStats().queryLatency(0.01));
+    }
+    stats.add(MatchingStats().queryLatency(0.01).queryLatency(2.0));
+    EXPECT_EQUAL(100u, stats.queryLatencyHistogram().getCount());
+    EXPECT_APPROX(0.01, stats.queryLatencyHistogram().getPercentile(0.5), 0.002);
+    EXPECT_EQUAL(2.0, stats.queryLatencyHistogram().getMax());
+    EXPECT_GREATER(stats.queryLatencyHistogram().getPercentile(0.999), 1.0);
+}
+
 TEST("requireThatPartitionsAreAddedCorrectly") {
     MatchingStats all1;
     EXPECT_EQUAL(0u, all1.docsMatched());
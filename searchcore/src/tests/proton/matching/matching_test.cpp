@@ -4,6 +4,7 @@
 
 #include <vespa/document/base/globalid.h>
 #include <initializer_list>
+#include <set>
 #include <vespa/searchcommon/attribute/iattributecontext.h>
 #include <vespa/searchcore/proton/test/bucketfactory.h>
 #include <vespa/searchcore/proton/documentmetastore/documentmetastore.h>
@@ -23,12 +24,14 @@
 #include <vespa/searchlib/engine/docsumrequest.h>
 #include <vespa/searchlib/engine/searchrequest.h>
 #include <vespa/searchlib/engine/docsumreply.h>
+#include <vespa/searchlib/engine/errorcodes.h>
 #include <vespa/searchlib/engine/searchreply.h>
 #include <vespa/searchlib/fef/properties.h>
 #include <vespa/searchlib/query/tree/querybuilder.h>
 #include <vespa/searchlib/query/tree/stackdumpcreator.h>
 #include <vespa/searchlib/queryeval/isourceselector.h>
 #include <vespa/vespalib/util/simple_thread_bundle.h>
+#include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/searchcore/proton/matching/match_params.h>
 #include <vespa/searchcore/proton/matching/match_tools.h>
 #include <vespa/searchcore/proton/matching/match_context.h>
@@ -297,7 +300,10 @@ struct MyWorld {
     }
 
     SearchReply::UP performSearch(SearchRequest::SP req, size_t threads) {
-        Matcher::SP matcher = createMatcher();
+        return performSearch(createMatcher(), req, threads);
+    }
+
+    SearchReply::UP performSearch(Matcher::SP matcher, SearchRequest::SP req, size_t threads) {
         SearchSession::OwnershipBundle owned_objects;
         owned_objects.search_handler.reset(new MySearchHandler(matcher));
         owned_objects.context.reset(new MatchContext(
@@ -422,6 +428,73 @@ TEST("require that matching is performed (multi-threaded)") {
     }
 }
 
+TEST("require that span trace is returned when requested (multi-threaded)") {
+    for (size_t threads = 1; threads <= 4; ++threads) {
+        MyWorld world;
+        world.basicSetup();
+        world.basicResults();
+        SearchRequest::SP request = world.createSimpleRequest("f1", "spread");
+        SearchReply::UP plain = world.performSearch(request, threads);
+        EXPECT_FALSE(plain->propertiesMap.traceProperties().lookup("spans").found());
+        request->propertiesMap.lookupCreate(search::MapNames::TRACE).add("spans", "true");
+        SearchReply::UP reply = world.performSearch(request, threads);
+        EXPECT_EQUAL(9u, reply->hits.size());
+        search::fef::Property spans = reply->propertiesMap.traceProperties().lookup("spans");
+        ASSERT_TRUE(spans.found());
+        vespalib::Slime slime;
+        vespalib::slime::BinaryFormat::decode(vespalib::Memory(spans.get()), slime);
+        const vespalib::slime::Inspector &list = slime.get()["spans"];
+        size_t firstPhase = 0;
+        std::set<vespalib::string> names;
+        for (size_t i = 0; i < list.entries(); ++i) {
+            vespalib::string name = list[i]["name"].asString().make_string();
+            names.insert(name);
+            if (name == "first_phase") {
+                ++firstPhase;
+            }
+            EXPECT_GREATER_EQUAL(list[i]["duration_ms"].asDouble(), 0.0);
+        }
+        EXPECT_EQUAL(threads, firstPhase);
+        EXPECT_EQUAL(1u, names.count("queue"));
+        EXPECT_EQUAL(1u, names.count("setup"));
+        EXPECT_EQUAL(1u, names.count("match"));
+        EXPECT_EQUAL(1u, names.count("match_thread"));
+        EXPECT_EQUAL(1u, names.count("process_result"));
+        EXPECT_EQUAL(1u, names.count("make_reply"));
+    }
+}
+
+TEST("require that queries exceeding the cost limit are rejected while others are in flight") {
+    MyWorld world;
+    world.basicSetup();
+    world.basicResults();
+    world.queryLimiter.configure(0, 1.0, 1000000, 5);
+    SearchRequest::SP request = world.createSimpleRequest("f1", "spread");
+    {
+        QueryLimiter::Token::UP inFlight = world.queryLimiter.admit(1);
+        ASSERT_TRUE(inFlight);
+        SearchReply::UP reply = world.performSearch(request, 1);
+        EXPECT_EQUAL(uint32_t(search::engine::ECODE_OVERLOADED), reply->errorCode);
+        EXPECT_EQUAL(0u, reply->hits.size());
+        EXPECT_EQUAL(1u, world.matchingStats.queriesRejected());
+    }
+    EXPECT_EQUAL(0u, world.queryLimiter.getCostInFlight());
+    SearchReply::UP reply = world.performSearch(request, 1);
+    EXPECT_EQUAL(uint32_t(search::engine::ECODE_NO_ERROR), reply->errorCode);
+    EXPECT_EQUAL(9u, reply->hits.size());
+    EXPECT_EQUAL(0u, world.queryLimiter.getCostInFlight());
+}
+
+TEST("require that query cost admission is unlimited by default") {
+    QueryLimiter limiter;
+    auto first = limiter.admit(1000000);
+    auto second = limiter.admit(1000000);
+    EXPECT_TRUE(first && second);
+    EXPECT_EQUAL(0u, limiter.getCostInFlight());
+    EXPECT_EQUAL(10u, QueryLimiter::estimateCost(10, false));
+    EXPECT_EQUAL(20u, QueryLimiter::estimateCost(10, true));
+}
+
 TEST("require that matching also returns hits when only bitvector is used (multi-threaded)") {
     for (size_t threads = 1; threads <= 16; ++threads) {
         MyWorld world;
@@ -457,6 +530,23 @@ TEST("require that ranking is performed (multi-threaded)") {
     }
 }
 
+TEST("require that eager ranking gives the same result (multi-threaded)") {
+    for (size_t threads = 1; threads <= 4; ++threads) {
+        MyWorld world;
+        world.basicSetup();
+        world.basicResults();
+        world.set_property(indexproperties::matching::EagerRanking::NAME, "true");
+        SearchRequest::SP request = world.createSimpleRequest("f1", "spread");
+        SearchReply::UP reply = world.performSearch(request, threads);
+        EXPECT_EQUAL(9u, world.matchingStats.docsRanked());
+        ASSERT_TRUE(reply->hits.size() == 9u);
+        EXPECT_EQUAL(document::DocumentId("doc::900").getGlobalId(),  reply->hits[0].gid);
+        EXPECT_EQUAL(900.0, reply->hits[0].metric);
+        EXPECT_EQUAL(document::DocumentId("doc::800").getGlobalId(),  reply->hits[1].gid);
+        EXPECT_EQUAL(800.0, reply->hits[1].metric);
+    }
+}
+
 TEST("require that re-ranking is performed (multi-threaded)") {
     for (size_t threads = 1; threads <= 16; ++threads) {
         MyWorld world;
@@ -484,6 +574,79 @@ TEST("require that re-ranking is performed (multi-threaded)") {
     }
 }
 
+TEST("require that balanced re-ranking reuses first phase scores (multi-threaded)") {
+    for (size_t threads = 1; threads <= 16; ++threads) {
+        MyWorld world;
+        world.basicSetup();
+        world.set_property(indexproperties::rank::SecondPhase::NAME, "firstPhase*2");
+        world.set_property(indexproperties::hitcollector::HeapSize::NAME, "3");
+        world.set_property(indexproperties::matching::BalancedSecondPhase::NAME, "true");
+        SearchRequest::SP request = world.createSimpleRequest("f1", "spread");
+        SearchReply::UP reply = world.performSearch(request, threads);
+        EXPECT_EQUAL(9u, world.matchingStats.docsMatched());
+        EXPECT_EQUAL(9u, world.matchingStats.docsRanked());
+        EXPECT_EQUAL(3u, world.matchingStats.docsReRanked());
+        ASSERT_TRUE(reply->hits.size() == 9u);
+        EXPECT_EQUAL(document::DocumentId("doc::900").getGlobalId(),  reply->hits[0].gid);
+        EXPECT_EQUAL(1800.0, reply->hits[0].metric);
+        EXPECT_EQUAL(document::DocumentId("doc::800").getGlobalId(),  reply->hits[1].gid);
+        EXPECT_EQUAL(1600.0, reply->hits[1].metric);
+        EXPECT_EQUAL(document::DocumentId("doc::700").getGlobalId(),  reply->hits[2].gid);
+        EXPECT_EQUAL(1400.0, reply->hits[2].metric);
+        EXPECT_EQUAL(document::DocumentId("doc::600").getGlobalId(),  reply->hits[3].gid);
+        EXPECT_EQUAL(600.0, reply->hits[3].metric);
+        EXPECT_EQUAL(document::DocumentId("doc::500").getGlobalId(),  reply->hits[4].gid);
+        EXPECT_EQUAL(500.0, reply->hits[4].metric);
+    }
+}
+
+TEST("require that result cache is used for repeated queries until content changes") {
+    MyWorld world;
+    world.basicSetup();
+    world.basicResults();
+    world.set_property(indexproperties::matching::ResultCacheSize::NAME, "10");
+    Matcher::SP matcher = world.createMatcher();
+    SearchRequest::SP request = world.createSimpleRequest("f1", "spread");
+    SearchReply::UP reply1 = world.performSearch(matcher, request, 1);
+    EXPECT_EQUAL(0u, world.matchingStats.resultCacheHits());
+    EXPECT_EQUAL(1u, world.matchingStats.resultCacheMisses());
+    EXPECT_EQUAL(1u, world.matchingStats.queries());
+    SearchReply::UP reply2 = world.performSearch(matcher, request, 1);
+    EXPECT_EQUAL(1u, world.matchingStats.resultCacheHits());
+    EXPECT_EQUAL(1u, world.matchingStats.resultCacheMisses());
+    EXPECT_EQUAL(1u, world.matchingStats.queries());
+    ASSERT_EQUAL(9u, reply2->hits.size());
+    EXPECT_EQUAL(reply1->totalHitCount, reply2->totalHitCount);
+    EXPECT_EQUAL(reply1->hits[0].gid, reply2->hits[0].gid);
+    EXPECT_EQUAL(reply1->hits[0].metric, reply2->hits[0].metric);
+    SearchRequest::SP other = world.createSimpleRequest("f1", "foo");
+    world.performSearch(matcher, other, 1);
+    EXPECT_EQUAL(2u, world.matchingStats.resultCacheMisses());
+    world.searchContext.setLimit(world.searchContext.getDocIdLimit() + 1);
+    world.performSearch(matcher, request, 1);
+    EXPECT_EQUAL(1u, world.matchingStats.resultCacheHits());
+    EXPECT_EQUAL(3u, world.matchingStats.resultCacheMisses());
+}
+
+TEST("require that result cache evicts least recently used and expired entries") {
+    ResultCache cache(2, fastos::TimeStamp(10 * fastos::TimeStamp::SEC));
+    SearchReply reply;
+    reply.totalHitCount = 42;
+    cache.insert("a", "t1", 0, reply);
+    cache.insert("b", "t1", 0, reply);
+    EXPECT_TRUE(cache.find("a", "t1", 0));
+    cache.insert("c", "t1", 0, reply);
+    EXPECT_EQUAL(2u, cache.size());
+    EXPECT_FALSE(cache.find("b", "t1", 0));
+    EXPECT_FALSE(cache.find("a", "t2", 0));
+    EXPECT_EQUAL(1u, cache.size());
+    SearchReply::UP cached = cache.find("c", "t1", 5 * fastos::TimeStamp::SEC);
+    ASSERT_TRUE(cached);
+    EXPECT_EQUAL(42u, cached->totalHitCount);
+    EXPECT_FALSE(cache.find("c", "t1", 11 * fastos::TimeStamp::SEC));
+    EXPECT_EQUAL(0u, cache.size());
+}
+
 TEST("require that sortspec can be used (multi-threaded)") {
     for (size_t threads = 1; threads <= 16; ++threads) {
         MyWorld world;
@@ -502,6 +665,22 @@ TEST("require that sortspec can be used (multi-threaded)") {
     }
 }
 
+TEST("require that only the best sorted hits are kept while matching (multi-threaded)") {
+    for (size_t threads = 1; threads <= 16; ++threads) {
+        MyWorld world;
+        world.basicSetup();
+        world.basicResults();
+        SearchRequest::SP request = world.createSimpleRequest("f1", "spread");
+        request->sortSpec = "-a1";
+        request->maxhits = 2;
+        SearchReply::UP reply = world.performSearch(request, threads);
+        EXPECT_EQUAL(9u, reply->totalHitCount);
+        ASSERT_EQUAL(2u, reply->hits.size());
+        EXPECT_EQUAL(document::DocumentId("doc::900").getGlobalId(),  reply->hits[0].gid);
+        EXPECT_EQUAL(document::DocumentId("doc::800").getGlobalId(),  reply->hits[1].gid);
+    }
+}
+
 ExpressionNode::UP createAttr() { return std::make_unique<AttributeNode>("a1"); }
 TEST("require that grouping is performed (multi-threaded)") {
     for (size_t threads = 1; threads <= 16; ++threads) {
@@ -112,6 +112,17 @@ TEST("require that partial results without sort data are merged correctly") {
     TEST_DO(checkMerge(std::vector<double>(), std::vector<double>(), 10, std::vector<double>()));
 }
 
+TEST("require that partial results are merged correctly when one side dominates") {
+    TEST_DO(checkMerge(make_box(5.0, 4.0, 3.0), make_box(2.0, 1.0), 4, make_box(5.0, 4.0, 3.0, 2.0)));
+    TEST_DO(checkMerge(make_box(2.0, 1.0), make_box(5.0, 4.0, 3.0), 4, make_box(5.0, 4.0, 3.0, 2.0)));
+    TEST_DO(checkMerge(make_box(5.0, 4.0, 3.0), make_box(2.0, 1.0), 2, make_box(5.0, 4.0)));
+    TEST_DO(checkMerge(make_box(2.0, 1.0), make_box(5.0, 4.0, 3.0), 2, make_box(5.0, 4.0)));
+    TEST_DO(checkMerge(make_box(6.0, 3.0, 2.0, 1.0), make_box(5.0, 4.0), 4, make_box(6.0, 5.0, 4.0, 3.0)));
+    TEST_DO(checkMerge(make_box<std::string>("a", "b", "c"), make_box<std::string>("d", "e"), 4, make_box<std::string>("a", "b", "c", "d")));
+    TEST_DO(checkMerge(make_box<std::string>("d", "e"), make_box<std::string>("a", "b", "c"), 4, make_box<std::string>("a", "b", "c", "d")));
+    TEST_DO(checkMerge(make_box<std::string>("a", "d", "e", "f"), make_box<std::string>("b", "c"), 4, make_box<std::string>("a", "b", "c", "d")));
+}
+
 TEST("require that partial results with sort data are merged correctly") {
     TEST_DO(checkMerge(make_box<std::string>("a", "c", "e"), make_box<std::string>("b", "d"), 3, make_box<std::string>("a", "b", "c")));
     TEST_DO(checkMerge(make_box<std::string>("b", "d"), make_box<std::string>("a", "c", "e"), 3, make_box<std::string>("a", "b", "c")));
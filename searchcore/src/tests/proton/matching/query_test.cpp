@@ -2,7 +2,9 @@
 // Unit tests for query.
 
 #include <vespa/document/datatype/positiondatatype.h>
+#include <vespa/searchcore/proton/matching/cached_filter_blueprint.h>
 #include <vespa/searchcore/proton/matching/fakesearchcontext.h>
+#include <vespa/searchcore/proton/matching/filter_cache.h>
 #include <vespa/searchcore/proton/matching/matchdatareservevisitor.h>
 #include <vespa/searchcore/proton/matching/blueprintbuilder.h>
 #include <vespa/searchcore/proton/matching/query.h>
@@ -10,11 +12,16 @@
 #include <vespa/searchcore/proton/matching/resolveviewvisitor.h>
 #include <vespa/searchcore/proton/matching/termdataextractor.h>
 #include <vespa/searchcore/proton/matching/viewresolver.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/attributevector.h>
+#include <vespa/searchlib/common/bitvector.h>
 #include <vespa/searchlib/features/utils.h>
 #include <vespa/searchlib/fef/itermfielddata.h>
 #include <vespa/searchlib/fef/matchdata.h>
 #include <vespa/searchlib/fef/matchdatalayout.h>
+#include <vespa/searchlib/fef/test/attribute_map.h>
 #include <vespa/searchlib/fef/test/indexenvironment.h>
+#include <vespa/searchlib/fef/test/mock_attribute_context.h>
 #include <vespa/searchlib/query/tree/customtypetermvisitor.h>
 #include <vespa/searchlib/query/tree/querybuilder.h>
 #include <vespa/searchlib/query/tree/stackdumpcreator.h>
@@ -39,6 +46,10 @@ using search::fef::MatchData;
 using search::fef::MatchDataLayout;
 using search::fef::TermFieldMatchData;
 using search::fef::TermFieldHandle;
+using search::attribute::BasicType;
+using search::attribute::Config;
+using search::AttributeFactory;
+using search::AttributeVector;
 using search::query::CustomTypeTermVisitor;
 using search::query::Node;
 using search::query::QueryBuilder;
@@ -101,6 +112,7 @@ class Test : public vespalib::TestApp {
     void requireThatWeakAndBlueprintsAreCreatedCorrectly();
     void requireThatParallelWandBlueprintsAreCreatedCorrectly();
     void requireThatBlackListBlueprintCanBeUsed();
+    void requireThatUnrankedAttributeFiltersAreCached();
 
 public:
     ~Test();
@@ -235,6 +247,7 @@ public:
     virtual void visit(ProtonWandTerm &) override {}
     virtual void visit(ProtonPredicateQuery &) override {}
     virtual void visit(ProtonRegExpTerm &) override {}
+    virtual void visit(ProtonNearestNeighborTerm &) override {}
 };
 
 void Test::requireThatTermsAreLookedUp() {
@@ -386,6 +399,7 @@ public:
     virtual void visit(ProtonWandTerm &) override {}
     virtual void visit(ProtonPredicateQuery &) override {}
     virtual void visit(ProtonRegExpTerm &) override {}
+    virtual void visit(ProtonNearestNeighborTerm &) override {}
 };
 
 void Test::requireThatTermDataIsFilledIn() {
@@ -855,6 +869,54 @@ Test::requireThatBlackListBlueprintCanBeUsed()
     EXPECT_EQUAL(exp, act);
 }
 
+FilterCache::Entry::SP
+buildCachedFilter(ProtonStringTerm &node, const FakeRequestContext &requestContext,
+                  FakeSearchContext &context, FilterCache &cache)
+{
+    MatchDataLayout mdl;
+    MatchDataReserveVisitor visitor(mdl);
+    node.accept(visitor);
+    Blueprint::UP blueprint = BlueprintBuilder::build(requestContext, node, context, cache, mdl);
+    auto cached = dynamic_cast<const CachedFilterBlueprint *>(blueprint.get());
+    return (cached != nullptr) ? cached->entry() : FilterCache::Entry::SP();
+}
+
+void
+Test::requireThatUnrankedAttributeFiltersAreCached()
+{
+    AttributeVector::SP attr = AttributeFactory::createAttribute(field, Config(BasicType::INT32));
+    fef_test::AttributeMap attributes;
+    attributes.add(attr);
+    fef_test::MockAttributeContext attributeContext(attributes);
+    FakeRequestContext requestContext(&attributeContext);
+
+    const string term = "bar";
+    FakeSearchContext context(10);
+    context.attr().addResult(field, term, FakeResult().doc(1).doc(3));
+
+    ProtonStringTerm node(term, field, 1, Weight(2));
+    node.setRanked(false);
+    node.resolve(ViewResolver(), attribute_index_env);
+
+    FilterCache cache(10);
+    FilterCache::Entry::SP entry = buildCachedFilter(node, requestContext, context, cache);
+    ASSERT_TRUE(entry.get() != nullptr);
+    EXPECT_EQUAL(2u, entry->bits->countTrueBits());
+    EXPECT_TRUE(entry->bits->testBit(1));
+    EXPECT_TRUE(entry->bits->testBit(3));
+    EXPECT_EQUAL(1u, cache.size());
+    EXPECT_EQUAL(entry.get(), buildCachedFilter(node, requestContext, context, cache).get());
+
+    attr->commit(true);
+    FilterCache::Entry::SP newEntry = buildCachedFilter(node, requestContext, context, cache);
+    ASSERT_TRUE(newEntry.get() != nullptr);
+    EXPECT_NOT_EQUAL(entry.get(), newEntry.get());
+    EXPECT_EQUAL(1u, cache.size());
+
+    node.setRanked(true);
+    EXPECT_TRUE(buildCachedFilter(node, requestContext, context, cache).get() == nullptr);
+}
+
 Test::~Test() {}
 
 int
@@ -887,6 +949,7 @@ Test::Main()
     TEST_CALL(requireThatWeakAndBlueprintsAreCreatedCorrectly);
     TEST_CALL(requireThatParallelWandBlueprintsAreCreatedCorrectly);
     TEST_CALL(requireThatBlackListBlueprintCanBeUsed);
+    TEST_CALL(requireThatUnrankedAttributeFiltersAreCached);
 
     TEST_DONE();
 }
@@ -0,0 +1,69 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/searchcore/proton/matching/sampled_query_log.h>
+#include <vespa/vespalib/util/stringfmt.h>
+
+using proton::matching::SampledQueryLog;
+
+SampledQueryLog::Entry makeEntry(double totalTime) {
+    SampledQueryLog::Entry entry;
+    entry.total_time = totalTime;
+    entry.blueprint = vespalib::make_string("query-%g", totalTime);
+    return entry;
+}
+
+size_t countSampled(SampledQueryLog &log, size_t numQueries) {
+    size_t sampled = 0;
+    for (size_t i = 0; i < numQueries; ++i) {
+        if (log.sample()) {
+            ++sampled;
+        }
+    }
+    return sampled;
+}
+
+TEST("require that the configured fraction of queries is sampled") {
+    SampledQueryLog none(0.0, 4);
+    SampledQueryLog some(0.25, 4);
+    SampledQueryLog all(1.0, 4);
+    EXPECT_EQUAL(0u, countSampled(none, 100));
+    EXPECT_EQUAL(25u, countSampled(some, 100));
+    EXPECT_EQUAL(100u, countSampled(all, 100));
+    EXPECT_EQUAL(25u, some.numSampled());
+}
+
+TEST("require that sample fraction is clamped") {
+    EXPECT_EQUAL(0.0, SampledQueryLog(-1.0, 4).getSampleFraction());
+    EXPECT_EQUAL(1.0, SampledQueryLog(2.0, 4).getSampleFraction());
+}
+
+TEST("require that only the most expensive queries are kept, most expensive first") {
+    SampledQueryLog log(1.0, 3);
+    for (double t: {5.0, 1.0, 7.0, 3.0, 9.0, 2.0}) {
+        log.add(makeEntry(t));
+    }
+    auto entries = log.getEntries();
+    ASSERT_EQUAL(3u, entries.size());
+    EXPECT_EQUAL(9.0, entries[0].total_time);
+    EXPECT_EQUAL(7.0, entries[1].total_time);
+    EXPECT_EQUAL(5.0, entries[2].total_time);
+    EXPECT_EQUAL("query-9", entries[0].blueprint);
+}
+
+TEST("require that feature profiles are aggregated by feature name") {
+    SampledQueryLog log(1.0, 3);
+    search::fef::FeatureProfiler a;
+    search::fef::FeatureProfiler b;
+    a.start();
+    a.stop(a.resolve("attribute(foo)"));
+    b.start();
+    b.stop(b.resolve("attribute(foo)"));
+    log.addFeatureProfile(a);
+    log.addFeatureProfile(b);
+    auto features = log.getFeatureProfile();
+    ASSERT_EQUAL(1u, features.size());
+    EXPECT_EQUAL("attribute(foo)", features[0].name);
+    EXPECT_EQUAL(2u, features[0].count);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
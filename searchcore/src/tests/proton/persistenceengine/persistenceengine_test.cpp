@@ -599,6 +599,51 @@ TEST_F("require that remove is NOT rejected if resource limit is reached", Simpl
 }
 
 
+TEST_F("require that feed batch operations are routed to handlers with one result each", SimpleFixture)
+{
+    storage::spi::LoadType loadType(0, "default");
+    Context context(loadType, storage::spi::Priority(0),
+                    storage::spi::Trace::TraceLevel(0));
+    f.hset.handler2.setExistingTimestamp(tstamp3);
+    storage::spi::FeedBatch batch;
+    batch.addPut(tstamp1, doc1);
+    batch.addPut(tstamp1, doc3);
+    batch.addRemoveIfFound(tstamp2, docId2);
+    batch.addRemove(tstamp3, docId3);
+    storage::spi::FeedBatchResult results = f.engine.feedBatch(bucket1, batch, context);
+    ASSERT_EQUAL(4u, results.size());
+    EXPECT_FALSE(results[0].hasError());
+    EXPECT_EQUAL(Result(Result::PERMANENT_ERROR, "No handler for document type 'type3'"), results[1]);
+    EXPECT_FALSE(results[2].hasError());
+    EXPECT_TRUE(results[2].wasFound());
+    EXPECT_FALSE(results[3].hasError());
+    EXPECT_FALSE(results[3].wasFound());
+    assertHandler(bucket1, tstamp1, docId1, f.hset.handler1);
+    assertHandler(bucket1, tstamp2, docId2, f.hset.handler2);
+}
+
+
+TEST_F("require that puts in feed batch are rejected if resource limit is reached", SimpleFixture)
+{
+    f._writeFilter._acceptWriteOperation = false;
+    f._writeFilter._message = "Disk is full";
+
+    storage::spi::LoadType loadType(0, "default");
+    Context context(loadType, storage::spi::Priority(0),
+                    storage::spi::Trace::TraceLevel(0));
+    storage::spi::FeedBatch batch;
+    batch.addPut(tstamp1, doc1);
+    batch.addRemove(tstamp1, docId1);
+    storage::spi::FeedBatchResult results = f.engine.feedBatch(bucket1, batch, context);
+    ASSERT_EQUAL(2u, results.size());
+    EXPECT_EQUAL(Result(Result::RESOURCE_EXHAUSTED,
+                        "Put operation rejected for document 'id:type1:type1::1': 'Disk is full'"),
+                 results[0]);
+    EXPECT_FALSE(results[1].hasError());
+    EXPECT_FALSE(results[1].wasFound());
+}
+
+
 TEST_F("require that listBuckets() is routed to handlers and merged", SimpleFixture)
 {
     f.hset.prepareListBuckets();
@@ -7,6 +7,7 @@
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/searchcore/proton/reference/i_gid_to_lid_change_listener.h>
 #include <vespa/searchcore/proton/reference/gid_to_lid_change_handler.h>
+#include <algorithm>
 #include <map>
 #include <vespa/log/log.h>
 LOG_SETUP("gid_to_lid_change_handler_test");
@@ -25,6 +26,8 @@ GlobalId toGid(vespalib::stringref docId) {
 }
 
 vespalib::string doc1("id:test:music::1");
+vespalib::string doc2("id:test:music::2");
+vespalib::string doc3("id:test:music::3");
 
 }
 
@@ -33,6 +36,7 @@ class ListenerStats {
     std::mutex _lock;
     uint32_t  _putChanges;
     uint32_t  _removeChanges;
+    uint32_t  _removeBatches;
     uint32_t  _createdListeners;
     uint32_t  _registeredListeners;
     uint32_t  _destroyedListeners;
@@ -42,6 +46,7 @@ public:
         : _lock(),
           _putChanges(0u),
           _removeChanges(0u),
+          _removeBatches(0u),
           _createdListeners(0u),
           _registeredListeners(0u),
           _destroyedListeners(0u)
@@ -61,6 +66,12 @@ public:
         lock_guard guard(_lock);
         ++_removeChanges;
     }
+    void notifyRemoves(uint32_t numGids) {
+        lock_guard guard(_lock);
+        _removeChanges += numGids;
+        ++_removeBatches;
+    }
+    uint32_t getRemoveBatches() const { return _removeBatches; }
     void markCreatedListener()    { lock_guard guard(_lock); ++_createdListeners; }
     void markRegisteredListener() { lock_guard guard(_lock); ++_registeredListeners; }
     void markDestroyedListener()  { lock_guard guard(_lock); ++_destroyedListeners; }
@@ -103,6 +114,10 @@ public:
     virtual ~MyListener() { _stats.markDestroyedListener(); }
     virtual void notifyPutDone(GlobalId, uint32_t) override { _stats.notifyPutDone(); }
     virtual void notifyRemove(GlobalId) override { _stats.notifyRemove(); }
+    virtual void notifyRemoves(const std::vector<GlobalId> &gids) override {
+        EXPECT_TRUE(std::is_sorted(gids.begin(), gids.end()));
+        _stats.notifyRemoves(gids.size());
+    }
     virtual void notifyRegistered() override { _stats.markRegisteredListener(); }
     virtual const vespalib::string &getName() const override { return _name; }
     virtual const vespalib::string &getDocTypeName() const override { return _docTypeName; }
@@ -150,6 +165,10 @@ struct Fixture
         _handler->notifyRemoveDone(gid, serialNum);
     }
 
+    void notifyRemoves(const std::vector<GlobalId> &gids, SerialNum serialNum) {
+        _handler->notifyRemoves(gids, serialNum);
+    }
+
     void removeListeners(const vespalib::string &docTypeName,
                          const std::set<vespalib::string> &keepNames) {
         _handler->removeListeners(docTypeName, keepNames);
@@ -243,6 +262,8 @@ public:
     {
         TEST_DO(_stats.assertChanges(expPutChanges, expRemoveChanges));
     }
+
+    uint32_t getRemoveBatches() const { return _stats.getRemoveBatches(); }
 };
 
 TEST_F("Test that put is ignored if we have a pending remove", StatsFixture)
@@ -303,6 +324,21 @@ TEST_F("Test that out of order notifyPutDone is partially handled", StatsFixture
     TEST_DO(f.assertChanges(2, 1));
 }
 
+TEST_F("Test that batched removes notify listener once", StatsFixture)
+{
+    f.notifyRemove(toGid(doc2), 10);
+    TEST_DO(f.assertChanges(0, 1));
+    f.notifyRemoves({ toGid(doc3), toGid(doc1), toGid(doc2) }, 20);
+    TEST_DO(f.assertChanges(0, 3));
+    EXPECT_EQUAL(1u, f.getRemoveBatches());
+    f.notifyRemoveDone(toGid(doc2), 10);
+    f.notifyRemoveDone(toGid(doc1), 20);
+    f.notifyRemoveDone(toGid(doc2), 20);
+    f.notifyRemoveDone(toGid(doc3), 20);
+    f.notifyPutDone(toGid(doc1), 11, 30);
+    TEST_DO(f.assertChanges(1, 3));
+}
+
 }
 
 TEST_MAIN()
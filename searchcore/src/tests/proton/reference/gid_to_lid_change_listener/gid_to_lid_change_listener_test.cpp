@@ -1,5 +1,6 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include <vespa/vespalib/testkit/testapp.h>
+#include <algorithm>
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/document/base/documentid.h>
 #include <vespa/searchlib/common/sequencedtaskexecutor.h>
@@ -98,6 +99,10 @@ struct Fixture
         _listener->notifyPutDone(gid, referencedDoc);
     }
 
+    void notifyRemoves(const std::vector<GlobalId> &gids) {
+        _listener->notifyRemoves(gids);
+    }
+
     void notifyListenerRegistered() {
         _listener->notifyRegistered();
     }
@@ -122,6 +127,25 @@ TEST_F("Test that we can use gid to lid change listener", Fixture)
     TEST_DO(f.assertRefLid(10, 3));
 }
 
+TEST_F("Test that batched removes clear referenced lids", Fixture)
+{
+    f.ensureDocIdLimit(4);
+    f.set(1, toGid(doc1));
+    f.set(2, toGid(doc2));
+    f.set(3, toGid(doc3));
+    f.commit();
+    f.allocListener();
+    f.notifyPutDone(toGid(doc1), 10);
+    f.notifyPutDone(toGid(doc2), 20);
+    f.notifyPutDone(toGid(doc3), 30);
+    std::vector<GlobalId> gids({ toGid(doc1), toGid(doc3) });
+    std::sort(gids.begin(), gids.end());
+    f.notifyRemoves(gids);
+    TEST_DO(f.assertRefLid(0, 1));
+    TEST_DO(f.assertRefLid(20, 2));
+    TEST_DO(f.assertRefLid(0, 3));
+}
+
 TEST_F("Test that referenced lids are populated when listener is registered", Fixture)
 {
     f.ensureDocIdLimit(6);
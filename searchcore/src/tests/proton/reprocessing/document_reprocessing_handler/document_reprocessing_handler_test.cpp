@@ -16,11 +16,13 @@ struct MyProcessor : public ReprocessingType
     typedef std::shared_ptr<MyProcessor<ReprocessingType, DocumentType> > SP;
     uint32_t _lid;
     DocumentId _docId;
+    std::vector<uint32_t> _lids;
 
-    MyProcessor() : _lid(0), _docId() {}
+    MyProcessor() : _lid(0), _docId(), _lids() {}
     virtual void handleExisting(uint32_t lid, DocumentType doc) override {
         _lid = lid;
         _docId = doc.getId();
+        _lids.push_back(lid);
     }
 };
 
@@ -33,15 +35,15 @@ struct FixtureBase
 {
     DocumentReprocessingHandler _handler;
     DocBuilder _docBuilder;
-    FixtureBase(uint32_t docIdLimit);
+    FixtureBase(uint32_t docIdLimit, uint32_t readerTaskLimit);
     ~FixtureBase();
     Document::UP createDoc() {
         return _docBuilder.startDocument(DOC_ID).endDocument();
     }
 };
 
-FixtureBase::FixtureBase(uint32_t docIdLimit)
-    : _handler(docIdLimit),
+FixtureBase::FixtureBase(uint32_t docIdLimit, uint32_t readerTaskLimit)
+    : _handler(docIdLimit, readerTaskLimit),
       _docBuilder(Schema())
 { }
 FixtureBase::~FixtureBase() {}
@@ -54,8 +56,8 @@ struct ReaderFixture : public FixtureBase
         : ReaderFixture(std::numeric_limits<uint32_t>::max())
     {
     }
-    ReaderFixture(uint32_t docIdLimit)
-        : FixtureBase(docIdLimit),
+    ReaderFixture(uint32_t docIdLimit, uint32_t readerTaskLimit = 0)
+        : FixtureBase(docIdLimit, readerTaskLimit),
           _reader1(new MyReader()),
           _reader2(new MyReader())
     {
@@ -73,7 +75,7 @@ struct RewriterFixture : public FixtureBase
     {
     }
     RewriterFixture(uint32_t docIdLimit)
-        : FixtureBase(docIdLimit),
+        : FixtureBase(docIdLimit, 0),
           _rewriter1(new MyRewriter()),
           _rewriter2(new MyRewriter())
     {
@@ -120,6 +122,30 @@ TEST_F("require that handler skips out of range visit to rewriters",
     EXPECT_EQUAL(DocumentId().toString(), f._rewriter2->_docId.toString());
 }
 
+TEST_F("require that handler can hand shared documents to readers on separate thread",
+       ReaderFixture(std::numeric_limits<uint32_t>::max(), 2))
+{
+    std::shared_ptr<const Document> doc(f.createDoc());
+    for (uint32_t lid = 1; lid <= 10; ++lid) {
+        f._handler.visitShared(lid, doc);
+    }
+    f._handler.visit(11u, *doc);
+    f._handler.done();
+    std::vector<uint32_t> expLids({1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11});
+    EXPECT_TRUE(expLids == f._reader1->_lids);
+    EXPECT_TRUE(expLids == f._reader2->_lids);
+    EXPECT_EQUAL(DOC_ID, f._reader2->_docId.toString());
+}
+
+TEST_F("require that handler skips out of range shared visit to readers",
+       ReaderFixture(10, 2))
+{
+    f._handler.visitShared(23u, std::shared_ptr<const Document>(f.createDoc()));
+    f._handler.done();
+    EXPECT_EQUAL(0u, f._reader1->_lid);
+    EXPECT_EQUAL(0u, f._reader2->_lid);
+}
+
 TEST_MAIN()
 {
     TEST_RUN_ALL();
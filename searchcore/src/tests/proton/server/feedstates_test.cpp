@@ -13,6 +13,7 @@ LOG_SETUP("feedstates_test");
 #include <vespa/searchcore/proton/server/ireplayconfig.h>
 #include <vespa/searchcore/proton/server/memoryconfigstore.h>
 #include <vespa/searchcore/proton/test/dummy_feed_view.h>
+#include <vespa/searchlib/common/sequencedtaskexecutor.h>
 #include <vespa/searchlib/common/serialnum.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/testkit/testapp.h>
@@ -36,12 +37,16 @@ struct MyFeedView : public test::DummyFeedView {
     TestDocRepo repo;
     DocumentTypeRepo::SP repo_sp;
     int remove_handled;
+    std::vector<SerialNum> remove_serials;
 
     MyFeedView();
     ~MyFeedView();
 
     const DocumentTypeRepo::SP &getDocumentTypeRepo() const override { return repo_sp; }
-    void handleRemove(FeedToken , const RemoveOperation &) override { ++remove_handled; }
+    void handleRemove(FeedToken , const RemoveOperation &op) override {
+        ++remove_handled;
+        remove_serials.push_back(op.getSerialNum());
+    }
 };
 
 MyFeedView::MyFeedView() : repo_sp(repo.getTypeRepoSp()), remove_handled(0) {}
@@ -69,11 +74,11 @@ struct Fixture
     bucketdb::BucketDBHandler _bucketDBHandler;
     ReplayTransactionLogState state;
 
-    Fixture();
+    Fixture(search::ISequencedTaskExecutor *deserializeExecutor = nullptr);
     ~Fixture();
 };
 
-Fixture::Fixture()
+Fixture::Fixture(search::ISequencedTaskExecutor *deserializeExecutor)
     : feed_view1(),
       feed_view2(),
       feed_view_ptr(&feed_view1),
@@ -81,7 +86,7 @@ Fixture::Fixture()
       config_store(),
       _bucketDB(),
       _bucketDBHandler(_bucketDB),
-      state("doctypename", feed_view_ptr, _bucketDBHandler, replay_config, config_store)
+      state("doctypename", feed_view_ptr, _bucketDBHandler, replay_config, config_store, deserializeExecutor)
 {
 }
 Fixture::~Fixture() {}
@@ -94,11 +99,11 @@ struct RemoveOperationContext
     nbostream str;
     std::unique_ptr<Packet> packet;
 
-    RemoveOperationContext(search::SerialNum serial);
+    RemoveOperationContext(search::SerialNum serial, uint32_t numOps = 1);
     ~RemoveOperationContext();
 };
 
-RemoveOperationContext::RemoveOperationContext(search::SerialNum serial)
+RemoveOperationContext::RemoveOperationContext(search::SerialNum serial, uint32_t numOps)
     : doc_id("doc:foo:bar"),
       op(BucketFactory::getBucketId(doc_id), Timestamp(10), doc_id),
       str(), packet()
@@ -106,7 +111,9 @@ RemoveOperationContext::RemoveOperationContext(search::SerialNum serial)
     op.serialize(str);
     ConstBufferRef buf(str.c_str(), str.wp());
     packet.reset(new Packet());
-    packet->add(Packet::Entry(serial, FeedOperation::REMOVE, buf));
+    for (uint32_t i = 0; i < numOps; ++i) {
+        packet->add(Packet::Entry(serial + i, FeedOperation::REMOVE, buf));
+    }
 }
 RemoveOperationContext::~RemoveOperationContext() {}
 TEST_F("require that active FeedView can change during replay", Fixture)
@@ -138,6 +145,28 @@ TEST_F("require that replay progress is tracked", Fixture)
     EXPECT_EQUAL(0.5, progress.getProgress());
 }
 
+struct ParallelFixture {
+    search::SequencedTaskExecutor executor;
+    Fixture f;
+    ParallelFixture() : executor(4), f(&executor) {}
+};
+
+TEST_F("require that operations are replayed in order when deserialized in parallel", ParallelFixture)
+{
+    RemoveOperationContext opCtx(10, 200);
+    TlsReplayProgress progress("test", 10, 209);
+    PacketWrapper::SP wrap(new PacketWrapper(*opCtx.packet, &progress));
+    InstantExecutor executor;
+
+    f.f.state.receive(wrap, executor);
+    EXPECT_EQUAL(200, f.f.feed_view1.remove_handled);
+    ASSERT_EQUAL(200u, f.f.feed_view1.remove_serials.size());
+    for (uint32_t i = 0; i < 200; ++i) {
+        EXPECT_EQUAL(10u + i, f.f.feed_view1.remove_serials[i]);
+    }
+    EXPECT_EQUAL(209u, progress.getCurrent());
+}
+
 }  // namespace
 
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -12,6 +12,8 @@ FastS_QueryPerf::FastS_QueryPerf()
       queryTime(0),
       dropCnt(0),
       timeoutCnt(0),
+      hedgedCnt(0),
+      hedgeWinCnt(0),
       _lastQueryCnt(0),
       _lastQueryTime(0.0)
 {
@@ -26,6 +28,8 @@ FastS_QueryPerf::reset()
     queryTime  = 0;
     dropCnt    = 0;
     timeoutCnt = 0;
+    hedgedCnt  = 0;
+    hedgeWinCnt = 0;
 }
 
 void
@@ -36,6 +40,8 @@ FastS_QueryPerf::log()
     EV_COUNT("queries",          queryCnt);
     EV_COUNT("dropped_queries",  dropCnt);
     EV_COUNT("timedout_queries", timeoutCnt);
+    EV_COUNT("hedged_queries",   hedgedCnt);
+    EV_COUNT("hedged_query_wins", hedgeWinCnt);
     if (queryCnt > _lastQueryCnt) {
         double avgQueryTime = (queryTime - _lastQueryTime)
                               / ((double)(queryCnt - _lastQueryCnt));
@@ -12,6 +12,8 @@ struct FastS_QueryPerf
     double   queryTime;
     uint32_t dropCnt;
     uint32_t timeoutCnt;
+    uint32_t hedgedCnt;
+    uint32_t hedgeWinCnt;
 
     FastS_QueryPerf();
 
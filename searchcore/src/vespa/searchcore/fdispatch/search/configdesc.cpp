@@ -51,6 +51,9 @@ FastS_DataSetDesc::FastS_DataSetDesc(uint32_t datasetid)
       _higherCoverageMinDocSumWait(0.1),
       _higherCoverageBaseDocSumWait(0.1),
       _minimalDocSumCoverage(100.0),
+      _hedgedQueryPercentile(0.0),
+      _hedgedQueryMinWait(0.01),
+      _incrementalMerge(false),
       _engineCnt(0),
       _enginesHead(NULL),
       _enginesTail(NULL),
@@ -313,6 +316,9 @@ FastS_DataSetCollDesc::ReadConfig(const PartitionsConfig& partmap)
         dataset->setHigherCoverageMinDocSumWait(dsconfig.higherCoverageMindocsumwait);
         dataset->setHigherCoverageBaseDocSumWait(dsconfig.higherCoverageBasedocsumwait);
         dataset->setMinimalDocSumCoverage(dsconfig.minimalDocsumcoverage);
+        dataset->setHedgedQueryPercentile(dsconfig.hedgedQueryPercentile);
+        dataset->setHedgedQueryMinWait(dsconfig.hedgedQueryMinwait);
+        dataset->setIncrementalMerge(dsconfig.incrementalMerge);
         FastS_DataSetDesc::QueryDistributionMode distMode(dsconfig.querydistribution,
                                                           dsconfig.minGroupCoverage,
                                                           dsconfig.latencyDecayRate);
@@ -160,6 +160,9 @@ private:
     double   _higherCoverageMinDocSumWait;
     double   _higherCoverageBaseDocSumWait;
     double   _minimalDocSumCoverage;
+    double   _hedgedQueryPercentile;
+    double   _hedgedQueryMinWait;
+    bool     _incrementalMerge;
 
     uint32_t          _engineCnt;    // number of search engines in dataset
     FastS_EngineDesc *_enginesHead;  // first engine in dataset
@@ -334,6 +337,36 @@ public:
         return _minimalDocSumCoverage;
     }
 
+    void
+    setHedgedQueryPercentile(double hedgedQueryPercentile) {
+        _hedgedQueryPercentile = hedgedQueryPercentile;
+    }
+
+    double
+    getHedgedQueryPercentile() const {
+        return _hedgedQueryPercentile;
+    }
+
+    void
+    setHedgedQueryMinWait(double hedgedQueryMinWait) {
+        _hedgedQueryMinWait = hedgedQueryMinWait;
+    }
+
+    double
+    getHedgedQueryMinWait() const {
+        return _hedgedQueryMinWait;
+    }
+
+    void
+    setIncrementalMerge(bool incrementalMerge) {
+        _incrementalMerge = incrementalMerge;
+    }
+
+    bool
+    getIncrementalMerge() const {
+        return _incrementalMerge;
+    }
+
     void FinalizeConfig();
 };
 
@@ -11,6 +11,8 @@
 FastS_DataSetBase::total_t::total_t()
     : _estimates(0),
       _nTimedOut(0),
+      _nHedged(0),
+      _nHedgeWins(0),
       _nOverload(0),
       _normalTimeStat()
 {
@@ -294,6 +296,20 @@ FastS_DataSetBase::CountTimeout()
 }
 
 
+void
+FastS_DataSetBase::CountHedgedQuery()
+{
+    ++_total._nHedged;
+}
+
+
+void
+FastS_DataSetBase::CountHedgedQueryWin()
+{
+    ++_total._nHedgeWins;
+}
+
+
 void
 FastS_DataSetBase::addPerformance(FastS_QueryPerf &qp)
 {
@@ -306,6 +322,8 @@ FastS_DataSetBase::addPerformance(FastS_QueryPerf &qp)
     qp.queryTime  += totals._totalAccTime;
     qp.dropCnt    += _total._nOverload;
     qp.timeoutCnt += _total._nTimedOut;
+    qp.hedgedCnt  += _total._nHedged;
+    qp.hedgeWinCnt += _total._nHedgeWins;
 }
 
 
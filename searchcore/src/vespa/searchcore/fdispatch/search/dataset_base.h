@@ -48,6 +48,8 @@ public:
         };
         std::atomic<uint32_t> _estimates;
         std::atomic<uint32_t> _nTimedOut;
+        std::atomic<uint32_t> _nHedged;
+        std::atomic<uint32_t> _nHedgeWins;
         uint32_t _nOverload;
         uint32_t _timestats[_timestatslots];
         FastS_TimeStatHistory _normalTimeStat;
@@ -204,6 +206,8 @@ public:
     void UpdateSearchTime(double tnow, double elapsed, bool timedout);
     void UpdateEstimateCount();
     void CountTimeout();
+    void CountHedgedQuery();
+    void CountHedgedQueryWin();
 
     void ScheduleCheckTempFail();
     virtual void DeQueueHeadWakeup_HasLock();
@@ -34,7 +34,9 @@ FastS_FNET_SearchNode::FastS_FNET_SearchNode(FastS_FNET_Search *search, uint32_t
       _partid(partid),
       _rowid(0),
       _stamp(0),
+      _hedgedNode(NULL),
       _qresult(NULL),
+      _qresultRowid(0),
       _queryTime(0.0),
       _flags(),
       _docidCnt(0),
@@ -237,6 +239,12 @@ FastS_FNET_Search::Timeout::PerformTask()
     _search->HandleTimeout();
 }
 
+void
+FastS_FNET_Search::HedgeTimeout::PerformTask()
+{
+    _search->HandleHedgeTimeout();
+}
+
 //---------------------------------------------------------------------
 
 void
@@ -535,11 +543,16 @@ FastS_FNET_Search::FastS_FNET_Search(FastS_DataSetCollection *dsc,
       _timeKeeper(timeKeeper),
       _startTime(timeKeeper->GetTime()),
       _timeout(dataset->GetAppContext()->GetFNETScheduler(), this),
+      _hedgeTimeout(dataset->GetAppContext()->GetFNETScheduler(), this),
       _util(),
+      _groupMerger(),
+      _incrementalMerger(),
       _dsc(dsc),
       _dataset(dataset),
       _datasetActiveCostRef(true),
       _nodes(),
+      _hedgeNodes(),
+      _queryPacket(),
       _nodesConnected(false),
       _estParts(0),
       _estPartCutoff(dataset->GetEstimatePartCutoff()),
@@ -576,6 +589,8 @@ FastS_FNET_Search::FastS_FNET_Search(FastS_DataSetCollection *dsc,
 FastS_FNET_Search::~FastS_FNET_Search()
 {
     _timeout.Kill();
+    _hedgeTimeout.Kill();
+    _hedgeNodes.clear();
     _nodes.clear();
     _util.DropResult();
     dropDatasetActiveCostRef();
@@ -603,23 +618,42 @@ FastS_FNET_Search::GotQueryResult(FastS_FNET_SearchNode *node,
         return;
     }
 
+    // the result from a hedged query is used for the node it was sent for
+    FastS_FNET_SearchNode *owner = (node->getHedgedNode() != NULL) ? node->getHedgedNode() : node;
     if (_FNET_mode == FNET_QUERY &&
-        node->_flags._pendingQuery) {
-        FastS_assert(node->_qresult == NULL);
-        node->_qresult = qrx;
+        node->_flags._pendingQuery &&
+        owner->_flags._pendingQuery) {
+        FastS_assert(owner->_qresult == NULL);
+        owner->_qresult = qrx;
+        owner->_qresultRowid = node->GetRowID();
         EncodePartIDs(node->getPartID(), node->GetRowID(),
                       (qrx->_features & search::fs4transport::QRF_MLD) != 0,
                       qrx->_hits, qrx->_hits + qrx->_numDocs);
+        if (_incrementalMerger) {
+            if ((qrx->_features & search::fs4transport::QRF_SORTDATA) != 0) {
+                _incrementalMerger->invalidate();
+            }
+            _incrementalMerger->addResult(qrx->_hits, qrx->_numDocs);
+        }
         LOG(spam, "Got result from row(%d), part(%d) = hits(%d), numDocs(%" PRIu64 ")", node->GetRowID(), node->getPartID(), qrx->_numDocs, qrx->_totNumDocs);
         node->_flags._pendingQuery = false;
+        owner->_flags._pendingQuery = false;
         _pendingQueries--;
         _goodQueries++;
         double tnow = GetTimeKeeper()->GetTime();
         node->_queryTime = tnow - _startTime;
+        owner->_queryTime = node->_queryTime;
         node->GetEngine()->UpdateSearchTime(tnow, node->_queryTime, false);
+        if (_dataset->useHedgedQueries()) {
+            _dataset->updateNodeSearchTime(tnow - _queryStartTime);
+        }
+        if (node != owner) {
+            _dataset->CountHedgedQueryWin();
+        }
         adjustQueryTimeout();
         node->dropCost();
     } else {
+        dropHedgedQuery(node);
         qrx->Free();
     }
     EndFNETWork(std::move(searchGuard));
@@ -661,6 +695,10 @@ FastS_FNET_Search::LostSearchNode(FastS_FNET_SearchNode *node)
     if (!searchGuard) {
         return;
     }
+    if (dropHedgedQuery(node)) {
+        EndFNETWork(std::move(searchGuard));
+        return;
+    }
 
     if (_FNET_mode == FNET_QUERY && node->_flags._pendingQuery) {
         FastS_assert(_pendingQueries > 0);
@@ -689,6 +727,10 @@ FastS_FNET_Search::GotEOL(FastS_FNET_SearchNode *node)
     }
 
     LOG(spam, "Got EOL from row(%d), part(%d) = pendingQ(%d) pendingDocsum(%d)", node->GetRowID(), node->getPartID(), node->_flags._pendingQuery, node->_pendingDocsums);
+    if (dropHedgedQuery(node)) {
+        EndFNETWork(std::move(searchGuard));
+        return;
+    }
     if (_FNET_mode == FNET_QUERY && node->_flags._pendingQuery) {
         FastS_assert(_pendingQueries > 0);
         _pendingQueries--;
@@ -724,6 +766,12 @@ FastS_FNET_Search::GotError(FastS_FNET_SearchNode *node,
         node->_flags._pendingQuery,
         node->_pendingDocsums);
 
+    if (dropHedgedQuery(node)) {
+        error->Free();
+        EndFNETWork(std::move(searchGuard));
+        return;
+    }
+
     if (_FNET_mode == FNET_QUERY && node->_flags._pendingQuery) {
         FastS_assert(_pendingQueries > 0);
         _pendingQueries--;
@@ -804,6 +852,62 @@ FastS_FNET_Search::HandleTimeout()
     EndFNETWork(std::move(searchGuard));
 }
 
+bool
+FastS_FNET_Search::dropHedgedQuery(FastS_FNET_SearchNode *node)
+{
+    // the node a hedged query was sent for is still pending, or already done
+    if (node->getHedgedNode() == NULL) {
+        return false;
+    }
+    node->_flags._pendingQuery = false;
+    node->dropCost();
+    return true;
+}
+
+void
+FastS_FNET_Search::sendHedgedQuery(const std::unique_lock<std::mutex> &dsGuard, FastS_FNET_SearchNode &node)
+{
+    node._flags._hedgedQuery = true;
+    FastS_EngineBase *engine = _dataset->getPartition(dsGuard, node.getPartID());
+    if (engine == nullptr) {
+        return;
+    }
+    if (engine->GetFNETEngine() == node.GetEngine()) {
+        engine->SubCost(); // no other node available for this partition
+        return;
+    }
+    FastS_FNET_SearchNode::UP hedgeNode(new FastS_FNET_SearchNode(this, node.getPartID()));
+    hedgeNode->setHedgedNode(&node);
+    hedgeNode->Connect_HasDSLock(engine->GetFNETEngine());
+    hedgeNode->_flags._pendingQuery = true;
+    LOG(debug, "Sending hedged query for part(%d) from row(%d) to row(%d)", node.getPartID(), node.GetRowID(), hedgeNode->GetRowID());
+    if (hedgeNode->PostPacket(new FS4Packet_Shared(_queryPacket))) {
+        _dataset->CountHedgedQuery();
+    } else {
+        hedgeNode->_flags._pendingQuery = false;
+    }
+    _hedgeNodes.push_back(std::move(hedgeNode));
+}
+
+void
+FastS_FNET_Search::HandleHedgeTimeout()
+{
+    auto searchGuard(BeginFNETWork());
+    if (!searchGuard) {
+        return;
+    }
+
+    if (_FNET_mode == FNET_QUERY) {
+        auto dsGuard(_dataset->getDsGuard());
+        for (FastS_FNET_SearchNode & node : _nodes) {
+            if (node._flags._pendingQuery && !node._flags._hedgedQuery) {
+                sendHedgedQuery(dsGuard, node);
+            }
+        }
+    }
+    EndFNETWork(std::move(searchGuard));
+}
+
 std::unique_lock<std::mutex>
 FastS_FNET_Search::BeginFNETWork()
 {
@@ -835,23 +939,57 @@ FastS_FNET_Search::ShouldLimitHitsPerNode() const
 }
 
 
+bool
+FastS_FNET_Search::MergeHitsIncremental()
+{
+    if (!_incrementalMerger || !_incrementalMerger->valid()) {
+        return false;
+    }
+    uint32_t numDocs = 0;
+    uint32_t numResults = 0;
+    uint64_t totalHits = 0;
+    search::HitRank maxRank =
+        std::numeric_limits<search::HitRank>::is_integer ?
+        std::numeric_limits<search::HitRank>::min() :
+        - std::numeric_limits<search::HitRank>::max();
+    for (const FastS_FNET_SearchNode & node : _nodes) {
+        if (node._qresult != NULL) {
+            numDocs += node._qresult->_numDocs;
+            totalHits += node._qresult->_totNumDocs;
+            maxRank = std::max(maxRank, node._qresult->_maxRank);
+            ++numResults;
+        }
+    }
+    if (numResults != _incrementalMerger->getNumResults()) {
+        return false;
+    }
+    FastS_QueryResult *result = _util.GetQueryResult();
+    result->_totalHitCount = totalHits;
+    result->_maxRank = maxRank;
+    ST_SetNumHits(numDocs);
+    ST_AdjustNumHits(_incrementalMerger->fill(ST_GetAlignedHitBuf(), ST_GetAlignedHitBufEnd()));
+    return true;
+}
+
 void
 FastS_FNET_Search::MergeHits()
 {
-    FastS_HitMerger<FastS_FNETMerge> merger(this);
-    merger.MergeHits();
+    if (!MergeHitsIncremental()) {
+        FastS_HitMerger<FastS_FNETMerge> merger(this);
+        merger.MergeHits();
 
-    if (_util.IsEstimate())
-        return;
+        if (_util.IsEstimate())
+            return;
 
-    if (ShouldLimitHitsPerNode())
-        _dataset->UpdateMaxHitsPerNodeLog(merger.WasIncomplete(), merger.WasFuzzy());
+        if (ShouldLimitHitsPerNode())
+            _dataset->UpdateMaxHitsPerNodeLog(merger.WasIncomplete(), merger.WasFuzzy());
+    }
 
     if (!_queryArgs->groupSpec.empty()) {
         _groupMerger.reset(new search::grouping::MergingManager(_dataset->GetPartBits(), _dataset->GetRowBits()));
         for (const FastS_FNET_SearchNode & node : _nodes) {
             if (node._qresult != NULL) {
-                _groupMerger->addResult(node.getPartID(), node.GetRowID(),
+                _groupMerger->addResult(node.getPartID(), node._qresultRowid,
                                         ((node._qresult->_features & search::fs4transport::QRF_MLD) != 0),
                                         node._qresult->_groupData, node._qresult->_groupDataLen);
             }
@@ -1064,6 +1202,10 @@ FastS_FNET_Search::Search(uint32_t searchOffset,
                            ? _dataset->GetMaxHitsPerNode()
                            : _util.GetAlignedMaxHits();
 
+    if (_dataset->useIncrementalMerge() && !_util.IsEstimate() && !ShouldLimitHitsPerNode()) {
+        _incrementalMerger.reset(new FastS_IncrementalHitMerger(_util.GetAlignedMaxHits()));
+    }
+
     // set up expected _queryNodes, _pendingQueries and node->_flags._pendingQuery state
     for (FastS_FNET_SearchNode & node : _nodes) {
         if (node.IsConnected()) {
@@ -1084,11 +1226,11 @@ FastS_FNET_Search::Search(uint32_t searchOffset,
         _queryStartTime = GetTimeKeeper()->GetTime();
         _timeout.Schedule(_adjustedQueryTimeOut);
     }
-    FNET_Packet::SP shared(new FS4Packet_PreSerialized(*setupQueryPacket(hitsPerNode, qflags, _queryArgs->propertiesMap)));
+    _queryPacket.reset(new FS4Packet_PreSerialized(*setupQueryPacket(hitsPerNode, qflags, _queryArgs->propertiesMap)));
     for (uint32_t i = 0; i < _nodes.size(); i++) {
         FastS_FNET_SearchNode & node = _nodes[i];
         if (node.IsConnected()) {
-            FNET_Packet::UP qx(new FS4Packet_Shared(shared));
+            FNET_Packet::UP qx(new FS4Packet_Shared(_queryPacket));
             LOG(spam, "posting packet to node %d='%s'\npacket=%s", i, node.toString().c_str(), qx->Print(0).c_str());
             if (node.PostPacket(qx.release())) {
                 ++num_send_ok;
@@ -1124,6 +1266,11 @@ FastS_FNET_Search::Search(uint32_t searchOffset,
             if (all_down) {
                 SetError(search::engine::ECODE_ALL_PARTITIONS_DOWN, NULL);
             }
+        } else if (searchPath.empty() && !_util.IsEstimate() && _dataset->useHedgedQueries()) {
+            double hedgeDelay = 0.0;
+            if (_dataset->getHedgedQueryDelay(hedgeDelay) && hedgeDelay < _adjustedQueryTimeOut) {
+                _hedgeTimeout.Schedule(hedgeDelay);
+            }
         }
     }
 
@@ -10,6 +10,7 @@
 #include <vespa/searchcore/fdispatch/search/search_path.h>
 #include <vespa/searchcore/fdispatch/search/querycacheutil.h>
 #include <vespa/searchcore/fdispatch/search/fnet_engine.h>
+#include <vespa/searchcore/fdispatch/search/incremental_merge.h>
 
 class FastS_FNET_Engine;
 class FastS_FNET_Search;
@@ -36,10 +37,12 @@ private:
     uint32_t                 _partid;   // engine partition id
     uint32_t                 _rowid;    // engine row id
     uint32_t                 _stamp;    // engine timestamp
+    FastS_FNET_SearchNode   *_hedgedNode; // node we send a hedged query for
 
 public:
 
     FS4Packet_QUERYRESULTX *_qresult; // query result packet
+    uint32_t                _qresultRowid; // row id of node giving the query result
     double                  _queryTime;
     struct Flags {
         Flags() :
@@ -47,13 +50,15 @@ public:
             _docsumMld(false),
             _queryTimeout(false),
             _docsumTimeout(false),
-            _needSubCost(false)
+            _needSubCost(false),
+            _hedgedQuery(false)
         { }
         bool  _pendingQuery;   // is query pending ?
         bool  _docsumMld;
         bool  _queryTimeout;
         bool  _docsumTimeout;
         bool  _needSubCost;
+        bool  _hedgedQuery;    // has a hedged query been sent ?
     };
 
     Flags       _flags;
@@ -105,6 +110,9 @@ public:
     uint32_t GetRowID() const     { return _rowid; }
     uint32_t GetTimeStamp() const { return _stamp; }
 
+    FastS_FNET_SearchNode *getHedgedNode() const { return _hedgedNode; }
+    void setHedgedNode(FastS_FNET_SearchNode *node) { _hedgedNode = node; }
+
     FastS_FNET_SearchNode * allocExtraDocsumNode(bool mld, uint32_t rowid, uint32_t rowbits);
 
     FastS_FNET_Engine *GetEngine() const { return _engine; }
@@ -207,6 +215,21 @@ public:
         void PerformTask() override;
     };
 
+    class HedgeTimeout : public FNET_Task
+    {
+    private:
+        HedgeTimeout(const HedgeTimeout &);
+        HedgeTimeout& operator=(const HedgeTimeout &);
+
+        FastS_FNET_Search *_search;
+
+    public:
+        HedgeTimeout(FNET_Scheduler *scheduler, FastS_FNET_Search *search)
+            : FNET_Task(scheduler),
+              _search(search) {}
+        void PerformTask() override;
+    };
+
     enum FNETMode {
         FNET_NONE    = 0x00,
         FNET_QUERY   = 0x01,
@@ -218,12 +241,16 @@ private:
     FastS_TimeKeeper        *_timeKeeper;
     double                   _startTime;
     Timeout                  _timeout;
+    HedgeTimeout             _hedgeTimeout;
     FastS_QueryCacheUtil     _util;
     std::unique_ptr<search::grouping::MergingManager> _groupMerger;
+    std::unique_ptr<FastS_IncrementalHitMerger> _incrementalMerger;
     FastS_DataSetCollection *_dsc;  // owner keeps this alive
     FastS_FNET_DataSet      *_dataset;
     bool             _datasetActiveCostRef;
     std::vector<FastS_FNET_SearchNode> _nodes;
+    std::vector<FastS_FNET_SearchNode::UP> _hedgeNodes;
+    FNET_Packet::SP          _queryPacket;
     bool                     _nodesConnected;
 
     uint32_t                 _estParts;
@@ -271,6 +298,8 @@ private:
     uint32_t getNextFixedRow();
     uint32_t getFixedRowCandidate();
     uint32_t getHashedRow() const;
+    void sendHedgedQuery(const std::unique_lock<std::mutex> &dsGuard, FastS_FNET_SearchNode &node);
+    bool dropHedgedQuery(FastS_FNET_SearchNode *node);
 
     std::unique_lock<std::mutex> BeginFNETWork();
     void EndFNETWork(std::unique_lock<std::mutex> searchGuard);
@@ -295,8 +324,10 @@ public:
     void GotError(FastS_FNET_SearchNode *node, search::fs4transport::FS4Packet_ERROR *error);
 
     void HandleTimeout();
+    void HandleHedgeTimeout();
 
     bool ShouldLimitHitsPerNode() const;
+    bool MergeHitsIncremental();
     void MergeHits();
     void CheckCoverage();
     void CheckQueryTimes();
@@ -0,0 +1,61 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "incremental_merge.h"
+#include <vespa/vespalib/stllike/hash_set.h>
+#include <vespa/vespalib/stllike/hash_set.hpp>
+
+FastS_IncrementalHitMerger::FastS_IncrementalHitMerger(uint32_t maxHits)
+    : _hits(),
+      _tmp(),
+      _maxHits(maxHits),
+      _numResults(0),
+      _valid(true)
+{
+}
+
+FastS_IncrementalHitMerger::~FastS_IncrementalHitMerger() {}
+
+void
+FastS_IncrementalHitMerger::addResult(const FS4_hit *hits, uint32_t numHits)
+{
+    ++_numResults;
+    if (!_valid || numHits == 0 || _maxHits == 0) {
+        return;
+    }
+    _tmp.clear();
+    _tmp.reserve(std::min(_maxHits, static_cast<uint32_t>(_hits.size()) + numHits));
+    vespalib::hash_set<document::GlobalId, document::GlobalId::hash> seen(_maxHits * 3);
+    auto old = _hits.begin();
+    const FS4_hit *pt = hits;
+    const FS4_hit *end = hits + numHits;
+    while (_tmp.size() < _maxHits && (old != _hits.end() || pt != end)) {
+        // hits already merged win ties, like earlier nodes in the heap merge
+        if (pt == end || (old != _hits.end() && old->HT_GetMetric() >= pt->HT_GetMetric())) {
+            if (seen.insert(old->HT_GetGlobalID()).second) {
+                _tmp.push_back(*old);
+            }
+            ++old;
+        } else {
+            if (seen.insert(pt->HT_GetGlobalID()).second) {
+                _tmp.emplace_back();
+                FastS_hitresult &dst = _tmp.back();
+                dst.HT_SetGlobalID(pt->HT_GetGlobalID());
+                dst.HT_SetMetric(pt->HT_GetMetric());
+                dst.HT_SetPartID(pt->HT_GetPartID());
+                dst.setDistributionKey(pt->getDistributionKey());
+            }
+            ++pt;
+        }
+    }
+    _hits.swap(_tmp);
+}
+
+uint32_t
+FastS_IncrementalHitMerger::fill(FastS_hitresult *beg, FastS_hitresult *end) const
+{
+    uint32_t cnt = 0;
+    for (auto itr = _hits.begin(); itr != _hits.end() && beg != end; ++itr, ++beg, ++cnt) {
+        *beg = *itr;
+    }
+    return cnt;
+}
@@ -0,0 +1,46 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchcore/fdispatch/common/search.h>
+#include <vespa/searchlib/common/packets.h>
+#include <vector>
+
+/**
+ * Keeps the best hits seen so far while rank ordered query results
+ * arrive from the search nodes, so that the final merge only needs to
+ * copy the hits out. Hits are kept in decreasing rank order with
+ * duplicate global ids removed, and never more than maxHits of them.
+ * Results with sort data can not be merged this way; the merger is
+ * then invalidated and the regular heap merge must be used.
+ **/
+class FastS_IncrementalHitMerger
+{
+public:
+    typedef search::fs4transport::FS4Packet_QUERYRESULTX::FS4_hit FS4_hit;
+
+private:
+    std::vector<FastS_hitresult> _hits;
+    std::vector<FastS_hitresult> _tmp;
+    uint32_t                     _maxHits;
+    uint32_t                     _numResults;
+    bool                         _valid;
+
+public:
+    FastS_IncrementalHitMerger(uint32_t maxHits);
+    ~FastS_IncrementalHitMerger();
+
+    void addResult(const FS4_hit *hits, uint32_t numHits);
+    void invalidate() { _valid = false; }
+
+    bool valid() const { return _valid; }
+    uint32_t getNumResults() const { return _numResults; }
+    uint32_t getNumHits() const { return _hits.size(); }
+
+    /**
+     * Copy the merged hits into the given buffer.
+     *
+     * @return number of hits copied
+     **/
+    uint32_t fill(FastS_hitresult *beg, FastS_hitresult *end) const;
+};
@@ -211,6 +211,11 @@ FastS_PlainDataSet::FastS_PlainDataSet(FastS_AppContext *appCtx,
       _higherCoverageMinDocSumWait(desc->getHigherCoverageMinDocSumWait()),
       _higherCoverageBaseDocSumWait(desc->getHigherCoverageBaseDocSumWait()),
       _minimalDocSumCoverage(desc->getMinimalDocSumCoverage()),
+      _hedgedQueryPercentile(desc->getHedgedQueryPercentile()),
+      _hedgedQueryMinWait(desc->getHedgedQueryMinWait()),
+      _incrementalMerge(desc->getIncrementalMerge()),
+      _nodeSearchTimesLock(),
+      _nodeSearchTimes(desc->getHedgedQueryPercentile(), 1024),
       _maxHitsPerNode(desc->GetMaxHitsPerNode()),
       _estimateParts(desc->GetEstimateParts()),
       _estimatePartCutoff(desc->GetEstPartCutoff()),
@@ -275,6 +280,24 @@ FastS_PlainDataSet::updateSearchTime(double searchTime, uint32_t rowId)
     _stateOfRows.updateSearchTime(searchTime, rowId);
 }
 
+void
+FastS_PlainDataSet::updateNodeSearchTime(double searchTime)
+{
+    std::lock_guard<std::mutex> guard(_nodeSearchTimesLock);
+    _nodeSearchTimes.updateSearchTime(searchTime);
+}
+
+bool
+FastS_PlainDataSet::getHedgedQueryDelay(double &delay)
+{
+    std::lock_guard<std::mutex> guard(_nodeSearchTimesLock);
+    if (!_nodeSearchTimes.valid()) {
+        return false;
+    }
+    delay = std::max(_nodeSearchTimes.getPercentile(), _hedgedQueryMinWait);
+    return true;
+}
+
 uint32_t
 FastS_PlainDataSet::getRandomWeightedRow() const
 {
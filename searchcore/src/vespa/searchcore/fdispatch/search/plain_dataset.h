@@ -124,6 +124,11 @@ protected:
     double       _higherCoverageMinDocSumWait;
     double       _higherCoverageBaseDocSumWait;
     double       _minimalDocSumCoverage;
+    double       _hedgedQueryPercentile;
+    double       _hedgedQueryMinWait;
+    bool         _incrementalMerge;
+    std::mutex   _nodeSearchTimesLock;
+    fdispatch::SearchTimePercentile _nodeSearchTimes;
     uint32_t     _maxHitsPerNode;     // Max hits requested from single node
     uint32_t     _estimateParts;      // number of partitions used for estimate
     uint32_t     _estimatePartCutoff; // First partition not used for estimate
@@ -199,6 +204,12 @@ public:
     double getHigherCoverageMinDocSumWait() const { return _higherCoverageMinDocSumWait; }
     double getHigherCoverageBaseDocSumWait() const { return _higherCoverageBaseDocSumWait; }
     double getMinimalDocSumCoverage() const { return _minimalDocSumCoverage; }
+    bool useHedgedQueries() const {
+        return (_hedgedQueryPercentile > 0.0) && !useFixedRowDistribution();
+    }
+    bool useIncrementalMerge() const { return _incrementalMerge; }
+    void updateNodeSearchTime(double searchTime);
+    bool getHedgedQueryDelay(double &delay);
 
     // API
     //----
@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include <vespa/searchcore/fdispatch/search/rowstate.h>
+#include <algorithm>
 
 namespace fdispatch {
 
@@ -74,4 +75,38 @@ StateOfRows::getActiveDocs() const
     return r;
 }
 
+SearchTimePercentile::SearchTimePercentile(double percentile, size_t windowSize) :
+    _percentile(std::min(std::max(percentile, 0.0), 100.0)),
+    _samples(std::max(windowSize, size_t(1)), 0.0),
+    _nextSample(0),
+    _numSamples(0),
+    _samplesSinceRecalc(0),
+    _recalcInterval(std::max(_samples.size() / 16, size_t(1))),
+    _value(0.0),
+    _valid(false)
+{
+}
+
+void
+SearchTimePercentile::updateSearchTime(double searchTime)
+{
+    _samples[_nextSample] = searchTime;
+    _nextSample = (_nextSample + 1) % _samples.size();
+    _numSamples = std::min(_numSamples + 1, _samples.size());
+    if (++_samplesSinceRecalc >= _recalcInterval) {
+        recalculate();
+    }
+}
+
+void
+SearchTimePercentile::recalculate()
+{
+    std::vector<double> sorted(_samples.begin(), _samples.begin() + _numSamples);
+    size_t idx = std::min(static_cast<size_t>(_percentile * _numSamples / 100.0), _numSamples - 1);
+    std::nth_element(sorted.begin(), sorted.begin() + idx, sorted.end());
+    _value = sorted[idx];
+    _valid = true;
+    _samplesSinceRecalc = 0;
+}
+
 }
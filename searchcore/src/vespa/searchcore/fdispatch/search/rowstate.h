@@ -60,4 +60,29 @@ private:
     size_t _invalidActiveDocsCounter;
 };
 
+/**
+ * SearchTimePercentile keeps a window of the most recent search times
+ * reported by single nodes and estimates a percentile of them. It is
+ * used to decide how long to wait for a node before a hedged query is
+ * sent to another node serving the same partition.
+ **/
+class SearchTimePercentile {
+public:
+    SearchTimePercentile(double percentile, size_t windowSize);
+    void updateSearchTime(double searchTime);
+    bool valid() const { return _valid; }
+    double getPercentile() const { return _value; }
+    size_t numSamples() const { return _numSamples; }
+private:
+    void recalculate();
+    double              _percentile;
+    std::vector<double> _samples;
+    size_t              _nextSample;
+    size_t              _numSamples;
+    size_t              _samplesSinceRecalc;
+    size_t              _recalcInterval;
+    double              _value;
+    bool                _valid;
+};
+
 }
@@ -94,6 +94,20 @@ GroupingManager::groupUnordered(const RankedHit *searchResults, uint32_t binSize
     }
 }
 
+size_t
+GroupingManager::getRelevanceOrderLimit(uint32_t binSize) const
+{
+    size_t limit = 0;
+    const GroupingContext::GroupingList &groupingList(_groupingContext.getGroupingList());
+    for (size_t i = 0; i < groupingList.size(); ++i) {
+        const Grouping & g = *groupingList[i];
+        if ( ! g.needResort() ) {
+            limit = std::max(limit, g.getMaxN(binSize));
+        }
+    }
+    return limit;
+}
+
 void
 GroupingManager::merge(GroupingContext &ctx)
 {
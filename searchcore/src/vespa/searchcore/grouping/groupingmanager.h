@@ -71,6 +71,17 @@ public:
      **/
     void groupUnordered(const RankedHit *searchResults, uint32_t binSize, const BitVector * overflow);
 
+    /**
+     * Calculate how many of the best hits must be in relevance order
+     * before calling groupInRelevanceOrder. Groupings that resort, or
+     * that only look at their top N hits, do not need the complete
+     * result set to be sorted.
+     *
+     * @return number of hits that must be sorted, 0 if none
+     * @param binSize size of search result array
+     **/
+    size_t getRelevanceOrderLimit(uint32_t binSize) const;
+
     /**
      * Merge another grouping context into the underlying context of
      * this manager. Both contexts must have the same groupings in the
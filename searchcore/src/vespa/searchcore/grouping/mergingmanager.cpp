@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include "mergingmanager.h"
 #include <map>
+#include <vector>
 #include <vespa/searchlib/aggregation/grouping.h>
 #include <vespa/searchlib/aggregation/fs4hit.h>
 #include <vespa/vespalib/objects/objectpredicate.h>
@@ -102,14 +103,14 @@ MergingManager::merge()
 }
 
 typedef std::unique_ptr<Grouping>    UP;
-typedef std::map<uint32_t, UP> MAP;
-typedef MAP::iterator ITR;
+typedef std::vector<UP> LIST;
+typedef std::map<uint32_t, LIST> MAP;
 
 namespace {
 
-void mergeOne(MAP & map, const MergingManager::Entry & input, uint32_t partBits, uint32_t rowBits) __attribute__((noinline));
+void collectOne(MAP & map, const MergingManager::Entry & input, uint32_t partBits, uint32_t rowBits) __attribute__((noinline));
 
-void mergeOne(MAP & map, const MergingManager::Entry & input, uint32_t partBits, uint32_t rowBits) {
+void collectOne(MAP & map, const MergingManager::Entry & input, uint32_t partBits, uint32_t rowBits) {
     PathMangler pathMangler(partBits, rowBits, input.partId, input.rowId, input.mld);
     vespalib::nbostream is(input.data, input.length);
     vespalib::NBOSerializer nis(is);
@@ -119,11 +120,23 @@ void mergeOne(MAP & map, const MergingManager::Entry & input, uint32_t partBits,
         UP g(new Grouping());
         g->deserialize(nis);
         g->select(pathMangler, pathMangler);
-        ITR pos = map.find(g->getId());
-        if (pos == map.end()) {
-            map[g->getId()] = std::move(g);
-        } else {
-            pos->second->merge(*g);
+        map[g->getId()].push_back(std::move(g));
+    }
+}
+
+/**
+ * Merge the groupings pairwise, as a balanced tree, into the first
+ * one. Merging two groupings is linear in the size of both, so
+ * accumulating them one by one is quadratic in the number of inputs
+ * when the groups are mostly disjoint. Left hand sides are always
+ * earlier in the list, so the result is the same as for a
+ * sequential merge.
+ */
+void mergeList(LIST & list) {
+    for (size_t step = 1; step < list.size(); step *= 2) {
+        for (size_t i = 0; (i + step) < list.size(); i += 2 * step) {
+            list[i]->merge(*list[i + step]);
+            list[i + step].reset();
         }
     }
 }
@@ -136,16 +149,18 @@ MergingManager::fullMerge()
     MAP map;
     for (size_t i = 0; i < _input.size(); ++i) {
         if ((_input[i].data != NULL) && (_input[i].length > 0)) {
-            mergeOne(map, _input[i], _partBits, _rowBits);
+            collectOne(map, _input[i], _partBits, _rowBits);
         }
     }
     vespalib::nbostream os;
     vespalib::NBOSerializer nos(os);
     nos << (uint32_t)map.size();
     for (auto & entry : map) {
-        entry.second->postMerge();
-        entry.second->sortById();
-        entry.second->serialize(nos);
+        mergeList(entry.second);
+        Grouping & g = *entry.second[0];
+        g.postMerge();
+        g.sortById();
+        g.serialize(nos);
     }
     _resultLen = os.size();
     _result = (char *) malloc(os.size());
@@ -259,4 +259,22 @@ AttributeInitializer::init() const
     }
 }
 
+uint64_t
+AttributeInitializer::getEstimatedLoadSize() const
+{
+    search::SerialNum serialNum = _attrDir->getFlushedSerialNum();
+    if (_attrDir->empty() || (serialNum == 0)) {
+        return 0;
+    }
+    vespalib::string snapshotDir = vespalib::dirname(_attrDir->getAttributeFileName(serialNum));
+    if (!vespalib::isDirectory(snapshotDir)) {
+        return 0;
+    }
+    uint64_t size = 0;
+    for (const auto &name : vespalib::listDirectory(snapshotDir)) {
+        size += vespalib::getFileSize(snapshotDir + "/" + name);
+    }
+    return size;
+}
+
 } // namespace proton
@@ -53,6 +53,12 @@ public:
     ~AttributeInitializer();
 
     AttributeInitializerResult init() const;
+
+    /**
+     * Returns the size of the files of the saved attribute vector to
+     * be loaded, used as an estimate of the memory needed to load it.
+     */
+    uint64_t getEstimatedLoadSize() const;
     uint64_t getCurrentSerialNum() const { return _currentSerialNum; }
 };
 
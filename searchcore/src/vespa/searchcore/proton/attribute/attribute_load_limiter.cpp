@@ -0,0 +1,90 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "attribute_load_limiter.h"
+#include <algorithm>
+#include <cassert>
+
+namespace proton {
+
+AttributeLoadLimiter::Guard::Guard(AttributeLoadLimiter &limiter, uint64_t estimatedMemoryUsage)
+    : _limiter(&limiter),
+      _estimatedMemoryUsage(estimatedMemoryUsage)
+{
+}
+
+AttributeLoadLimiter::Guard::Guard(Guard &&rhs)
+    : _limiter(rhs._limiter),
+      _estimatedMemoryUsage(rhs._estimatedMemoryUsage)
+{
+    rhs._limiter = nullptr;
+}
+
+AttributeLoadLimiter::Guard::~Guard()
+{
+    if (_limiter != nullptr) {
+        _limiter->release(_estimatedMemoryUsage);
+    }
+}
+
+AttributeLoadLimiter::AttributeLoadLimiter(uint32_t maxLoads, uint64_t memoryLimit)
+    : _maxLoads(std::max(1u, maxLoads)),
+      _memoryLimit(memoryLimit),
+      _loads(0),
+      _memoryUsage(0),
+      _lock(),
+      _cond()
+{
+}
+
+AttributeLoadLimiter::~AttributeLoadLimiter()
+{
+    assert(_loads == 0);
+}
+
+bool
+AttributeLoadLimiter::canLoad(uint64_t estimatedMemoryUsage) const
+{
+    if (_loads == 0) {
+        return true;
+    }
+    if (_loads >= _maxLoads) {
+        return false;
+    }
+    return (_memoryLimit == 0) || (_memoryUsage + estimatedMemoryUsage <= _memoryLimit);
+}
+
+void
+AttributeLoadLimiter::release(uint64_t estimatedMemoryUsage)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    assert(_loads > 0);
+    --_loads;
+    _memoryUsage -= estimatedMemoryUsage;
+    _cond.notify_all();
+}
+
+AttributeLoadLimiter::Guard
+AttributeLoadLimiter::acquire(uint64_t estimatedMemoryUsage)
+{
+    std::unique_lock<std::mutex> guard(_lock);
+    _cond.wait(guard, [this, estimatedMemoryUsage]() { return canLoad(estimatedMemoryUsage); });
+    ++_loads;
+    _memoryUsage += estimatedMemoryUsage;
+    return Guard(*this, estimatedMemoryUsage);
+}
+
+uint32_t
+AttributeLoadLimiter::getLoads()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _loads;
+}
+
+uint64_t
+AttributeLoadLimiter::getMemoryUsage()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _memoryUsage;
+}
+
+} // namespace proton
@@ -0,0 +1,60 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace proton {
+
+/**
+ * Class limiting the number of attribute vectors loaded concurrently
+ * and the sum of their estimated memory usage. A load is always
+ * allowed when no other load is in progress, even if its estimated
+ * memory usage alone exceeds the limit.
+ */
+class AttributeLoadLimiter
+{
+private:
+    const uint32_t          _maxLoads;
+    const uint64_t          _memoryLimit; // 0 means no limit
+    uint32_t                _loads;
+    uint64_t                _memoryUsage;
+    std::mutex              _lock;
+    std::condition_variable _cond;
+
+    bool canLoad(uint64_t estimatedMemoryUsage) const;
+    void release(uint64_t estimatedMemoryUsage);
+
+public:
+    /**
+     * Guard representing a load in progress. The load is finished
+     * when the guard is destroyed.
+     */
+    class Guard {
+        AttributeLoadLimiter *_limiter;
+        uint64_t              _estimatedMemoryUsage;
+    public:
+        Guard(AttributeLoadLimiter &limiter, uint64_t estimatedMemoryUsage);
+        Guard(const Guard &) = delete;
+        Guard &operator=(const Guard &) = delete;
+        Guard(Guard &&rhs);
+        ~Guard();
+    };
+
+    AttributeLoadLimiter(uint32_t maxLoads, uint64_t memoryLimit);
+    ~AttributeLoadLimiter();
+
+    /**
+     * Blocks until a load with the given estimated memory usage is
+     * allowed to start.
+     */
+    Guard acquire(uint64_t estimatedMemoryUsage);
+    uint32_t getMaxLoads() const { return _maxLoads; }
+    uint64_t getMemoryLimit() const { return _memoryLimit; }
+    uint32_t getLoads();
+    uint64_t getMemoryUsage();
+};
+
+} // namespace proton
@@ -1,7 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "attribute_manager_initializer.h"
-#include "attributes_initializer_base.h"
+#include "parallel_attributes_initializer.h"
 #include "attribute_collection_spec_factory.h"
 #include <vespa/searchcorespi/index/i_thread_service.h>
 #include <future>
@@ -17,28 +17,30 @@ using initializer::InitializerTask;
 
 namespace {
 
-class AttributeInitializerTask : public InitializerTask
+/**
+ * Task loading all attribute vectors of an attribute manager
+ * concurrently once the document meta store has been loaded, since
+ * the attribute vectors are padded to its docid limit.
+ */
+class AttributesLoadTask : public InitializerTask
 {
 private:
-    AttributeInitializer::UP _initializer;
+    std::shared_ptr<ParallelAttributesInitializer> _initializer;
     DocumentMetaStore::SP _documentMetaStore;
     InitializedAttributesResult &_result;
 
 public:
-    AttributeInitializerTask(AttributeInitializer::UP initializer,
-                             DocumentMetaStore::SP documentMetaStore,
-                             InitializedAttributesResult &result)
+    AttributesLoadTask(std::shared_ptr<ParallelAttributesInitializer> initializer,
+                       DocumentMetaStore::SP documentMetaStore,
+                       InitializedAttributesResult &result)
         : _initializer(std::move(initializer)),
           _documentMetaStore(documentMetaStore),
           _result(result)
     {}
 
     void run() override {
-        AttributeInitializerResult result = _initializer->init();
-        if (result) {
-            AttributesInitializerBase::considerPadAttribute(*result.getAttribute(),
-                                                            _initializer->getCurrentSerialNum(),
-                                                            _documentMetaStore->getCommittedDocIdLimit());
+        _initializer->load(_documentMetaStore->getCommittedDocIdLimit());
+        for (const auto &result : _initializer->getInitializedAttributes()) {
             _result.add(result);
         }
     }
@@ -89,45 +91,6 @@ AttributeManagerInitializerTask::run()
     _promise.set_value();
 }
 
-class AttributeInitializerTasksBuilder : public IAttributeInitializerRegistry
-{
-private:
-    InitializerTask &_attrMgrInitTask;
-    InitializerTask::SP _documentMetaStoreInitTask;
-    DocumentMetaStore::SP _documentMetaStore;
-    InitializedAttributesResult &_attributesResult;
-
-public:
-    AttributeInitializerTasksBuilder(InitializerTask &attrMgrInitTask,
-                                     InitializerTask::SP documentMetaStoreInitTask,
-                                     DocumentMetaStore::SP documentMetaStore,
-                                     InitializedAttributesResult &attributesResult);
-    ~AttributeInitializerTasksBuilder();
-    void add(AttributeInitializer::UP initializer) override;
-};
-
-AttributeInitializerTasksBuilder::AttributeInitializerTasksBuilder(InitializerTask &attrMgrInitTask,
-                                                                   InitializerTask::SP documentMetaStoreInitTask,
-                                                                   DocumentMetaStore::SP documentMetaStore,
-                                                                   InitializedAttributesResult &attributesResult)
-    : _attrMgrInitTask(attrMgrInitTask),
-      _documentMetaStoreInitTask(documentMetaStoreInitTask),
-      _documentMetaStore(documentMetaStore),
-      _attributesResult(attributesResult)
-{ }
-
-AttributeInitializerTasksBuilder::~AttributeInitializerTasksBuilder() {}
-
-void
-AttributeInitializerTasksBuilder::add(AttributeInitializer::UP initializer) {
-    InitializerTask::SP attributeInitTask =
-            std::make_shared<AttributeInitializerTask>(std::move(initializer),
-                                                       _documentMetaStore,
-                                                       _attributesResult);
-    attributeInitTask->addDependency(_documentMetaStoreInitTask);
-    _attrMgrInitTask.addDependency(attributeInitTask);
-}
-
 }
 
 AttributeCollectionSpec::UP
@@ -147,6 +110,7 @@ AttributeManagerInitializer::AttributeManagerInitializer(SerialNum configSerialN
                                                          size_t attributeGrowNumDocs,
                                                          bool fastAccessAttributesOnly,
                                                          searchcorespi::index::IThreadService &master,
+                                                         AttributeLoadLimiter &loadLimiter,
                                                          std::shared_ptr<AttributeManager::SP> attrMgrResult)
     : _configSerialNum(configSerialNum),
       _documentMetaStore(documentMetaStore),
@@ -160,9 +124,13 @@ AttributeManagerInitializer::AttributeManagerInitializer(SerialNum configSerialN
       _attrMgrResult(attrMgrResult)
 {
     addDependency(documentMetaStoreInitTask);
-    AttributeInitializerTasksBuilder tasksBuilder(*this, documentMetaStoreInitTask, documentMetaStore, _attributesResult);
+    auto attributesInitializer = std::make_shared<ParallelAttributesInitializer>(loadLimiter);
     AttributeCollectionSpec::UP attrSpec = createAttributeSpec();
-    _attrMgr = std::make_shared<AttributeManager>(*baseAttrMgr, *attrSpec, tasksBuilder);
+    _attrMgr = std::make_shared<AttributeManager>(*baseAttrMgr, *attrSpec, *attributesInitializer);
+    InitializerTask::SP loadTask = std::make_shared<AttributesLoadTask>(std::move(attributesInitializer),
+                                                                        documentMetaStore, _attributesResult);
+    loadTask->addDependency(documentMetaStoreInitTask);
+    addDependency(loadTask);
 }
 
 void
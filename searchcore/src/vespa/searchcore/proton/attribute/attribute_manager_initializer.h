@@ -14,6 +14,8 @@ namespace searchcorespi { namespace index { class IThreadService; } }
 
 namespace proton {
 
+class AttributeLoadLimiter;
+
 /**
  * Class used to initialize an attribute manager.
  */
@@ -43,6 +45,7 @@ public:
                                 size_t attributeGrowNumDocs,
                                 bool fastAccessAttributesOnly,
                                 searchcorespi::index::IThreadService &master,
+                                AttributeLoadLimiter &loadLimiter,
                                 std::shared_ptr<AttributeManager::SP> attrMgrResult);
 
     virtual void run() override;
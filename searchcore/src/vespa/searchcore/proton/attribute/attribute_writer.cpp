@@ -9,6 +9,7 @@
 #include <vespa/searchlib/attribute/attributevector.hpp>
 #include <vespa/searchlib/attribute/imported_attribute_vector.h>
 #include <vespa/searchlib/common/isequencedtaskexecutor.h>
+#include <vespa/vespalib/util/stringfmt.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.server.attributeadapter");
@@ -16,6 +17,7 @@ LOG_SETUP(".proton.server.attributeadapter");
 using namespace document;
 using namespace search;
 using search::attribute::ImportedAttributeVector;
+using vespalib::make_string;
 
 namespace proton {
 
@@ -71,17 +73,75 @@ ensureLidSpace(SerialNum serialNum, DocumentIdT lid, AttributeVector &attr)
     }
 }
 
+/*
+ * Value to put into one attribute. Top level numeric fields feeding single
+ * value numeric attributes are read directly from the serialized document
+ * instead of being materialized as field values.
+ */
+struct PutValue
+{
+    enum class Kind : uint8_t { FIELD_VALUE, INTEGER, FLOATING_POINT };
+    Kind           _kind;
+    int64_t        _intValue;
+    double         _floatValue;
+    FieldValue::UP _fieldValue;
+
+    PutValue() : _kind(Kind::FIELD_VALUE), _intValue(0), _floatValue(0.0), _fieldValue() {}
+};
+
+bool
+readNumericPutValue(const Document &doc, const FieldPath &fieldPath, const AttributeVector &attr, PutValue &value)
+{
+    if (fieldPath.size() != 1 || fieldPath[0].getType() != FieldPathEntry::STRUCT_FIELD || attr.hasMultiValue()) {
+        return false;
+    }
+    const Field &field = fieldPath[0].getFieldRef();
+    if (attr.getClass().inherits(IntegerAttribute::classId)) {
+        if (doc.getFields().getIntegerFieldValue(field, value._intValue)) {
+            value._kind = PutValue::Kind::INTEGER;
+            return true;
+        }
+    } else if (attr.getClass().inherits(FloatingPointAttribute::classId)) {
+        if (doc.getFields().getFloatingPointFieldValue(field, value._floatValue)) {
+            value._kind = PutValue::Kind::FLOATING_POINT;
+            return true;
+        }
+    }
+    return false;
+}
+
 void
-applyPutToAttribute(SerialNum serialNum, const FieldValue::UP &fieldValue, DocumentIdT lid,
+applyPutValue(const PutValue &value, DocumentIdT lid, AttributeVector &attr)
+{
+    switch (value._kind) {
+    case PutValue::Kind::INTEGER:
+        if (!static_cast<IntegerAttribute &>(attr).update(lid, value._intValue)) {
+            throw UpdateException(make_string("attribute update failed: %s[%u] = %" PRId64,
+                                              attr.getName().c_str(), lid, value._intValue));
+        }
+        break;
+    case PutValue::Kind::FLOATING_POINT:
+        if (!static_cast<FloatingPointAttribute &>(attr).update(lid, value._floatValue)) {
+            throw UpdateException(make_string("attribute update failed: %s[%u] = %g",
+                                              attr.getName().c_str(), lid, value._floatValue));
+        }
+        break;
+    default:
+        if (value._fieldValue.get()) {
+            AttrUpdate::handleValue(attr, lid, *value._fieldValue);
+        } else {
+            attr.clearDoc(lid);
+        }
+    }
+}
+
+void
+applyPutToAttribute(SerialNum serialNum, const PutValue &value, DocumentIdT lid,
                     bool immediateCommit, AttributeVector &attr,
                     AttributeWriter::OnWriteDoneType)
 {
     ensureLidSpace(serialNum, lid, attr);
-    if (fieldValue.get()) {
-        AttrUpdate::handleValue(attr, lid, *fieldValue);
-    } else {
-        attr.clearDoc(lid);
-    }
+    applyPutValue(value, lid, attr);
     if (immediateCommit) {
         attr.commit(serialNum, serialNum);
     }
@@ -198,7 +258,7 @@ class PutTask : public vespalib::Executor::Task
     const uint32_t       _lid;
     const bool           _immediateCommit;
     std::remove_reference_t<AttributeWriter::OnWriteDoneType> _onWriteDone;
-    std::vector<FieldValue::UP> _fieldValues;
+    std::vector<PutValue> _values;
 public:
     PutTask(const AttributeWriter::WriteContext &wc, SerialNum serialNum, const Document &doc, uint32_t lid, bool immediateCommit, AttributeWriter::OnWriteDoneType onWriteDone);
     virtual ~PutTask() override;
@@ -213,13 +273,14 @@ PutTask::PutTask(const AttributeWriter::WriteContext &wc, SerialNum serialNum, c
       _onWriteDone(onWriteDone)
 {
     const auto &fieldPaths = _wc.getFieldPaths();
-    _fieldValues.reserve(fieldPaths.size());
-    for (const auto &fieldPath : fieldPaths) {
-        FieldValue::UP fv;
-        if (!fieldPath.empty()) {
-            fv = doc.getNestedFieldValue(fieldPath.getFullRange());
+    const auto &attributes = _wc.getAttributes();
+    _values.resize(fieldPaths.size());
+    for (size_t fieldId = 0; fieldId < fieldPaths.size(); ++fieldId) {
+        const auto &fieldPath = fieldPaths[fieldId];
+        PutValue &value = _values[fieldId];
+        if (!fieldPath.empty() && !readNumericPutValue(doc, fieldPath, *attributes[fieldId], value)) {
+            value._fieldValue = doc.getNestedFieldValue(fieldPath.getFullRange());
         }
-        _fieldValues.emplace_back(std::move(fv));
     }
 }
 
@@ -235,7 +296,7 @@ PutTask::run()
     for (auto attrp : attributes) {
         AttributeVector &attr = *attrp;
         if (attr.getStatus().getLastSyncToken() < _serialNum) {
-            applyPutToAttribute(_serialNum, _fieldValues[fieldId], _lid, _immediateCommit, attr, _onWriteDone);
+            applyPutToAttribute(_serialNum, _values[fieldId], _lid, _immediateCommit, attr, _onWriteDone);
         }
         ++fieldId;
     }
@@ -0,0 +1,60 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "parallel_attributes_initializer.h"
+#include "attribute_load_limiter.h"
+#include <vespa/searchlib/attribute/attributevector.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+
+using vespalib::makeLambdaTask;
+
+namespace proton {
+
+ParallelAttributesInitializer::ParallelAttributesInitializer(AttributeLoadLimiter &limiter)
+    : AttributesInitializerBase(),
+      _limiter(limiter),
+      _initializers()
+{
+}
+
+ParallelAttributesInitializer::~ParallelAttributesInitializer() {}
+
+void
+ParallelAttributesInitializer::add(AttributeInitializer::UP initializer)
+{
+    _initializers.push_back(std::move(initializer));
+}
+
+void
+ParallelAttributesInitializer::load(uint32_t docIdLimit)
+{
+    if (_initializers.empty()) {
+        return;
+    }
+    std::vector<search::AttributeVector::SP> attributes(_initializers.size());
+    {
+        uint32_t numThreads = std::min(static_cast<size_t>(_limiter.getMaxLoads()), _initializers.size());
+        vespalib::ThreadStackExecutor executor(numThreads, 128 * 1024);
+        for (size_t i = 0; i < _initializers.size(); ++i) {
+            const AttributeInitializer &initializer = *_initializers[i];
+            search::AttributeVector::SP &attribute = attributes[i];
+            executor.execute(makeLambdaTask([this, &initializer, &attribute, docIdLimit]() {
+                AttributeLoadLimiter::Guard guard(_limiter.acquire(initializer.getEstimatedLoadSize()));
+                AttributeInitializerResult result = initializer.init();
+                if (result) {
+                    considerPadAttribute(*result.getAttribute(), initializer.getCurrentSerialNum(), docIdLimit);
+                    attribute = result.getAttribute();
+                }
+            }));
+        }
+        executor.sync();
+    }
+    for (const auto &attribute : attributes) {
+        if (attribute) {
+            _initializedAttributes.emplace_back(attribute);
+        }
+    }
+    _initializers.clear();
+}
+
+} // namespace proton
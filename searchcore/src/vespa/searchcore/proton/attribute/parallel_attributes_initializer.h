@@ -0,0 +1,38 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "attributes_initializer_base.h"
+
+namespace proton {
+
+class AttributeLoadLimiter;
+
+/**
+ * Class that initializes and loads a set of attribute vectors
+ * concurrently, using a thread pool bounded by the given load
+ * limiter. The limiter is typically shared between the document
+ * sub databases of a document database, bounding the memory used for
+ * loading across all of them.
+ */
+class ParallelAttributesInitializer : public AttributesInitializerBase
+{
+private:
+    AttributeLoadLimiter &_limiter;
+    std::vector<AttributeInitializer::UP> _initializers;
+
+public:
+    ParallelAttributesInitializer(AttributeLoadLimiter &limiter);
+    ~ParallelAttributesInitializer();
+    void add(AttributeInitializer::UP initializer) override;
+
+    /**
+     * Loads all added attribute vectors and pads them to the given
+     * docid limit. Initialized attributes are kept in the order they
+     * were added.
+     */
+    void load(uint32_t docIdLimit);
+    const AttributesVector &getInitializedAttributes() const { return _initializedAttributes; }
+};
+
+} // namespace proton
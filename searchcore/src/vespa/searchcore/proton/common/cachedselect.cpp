@@ -6,6 +6,9 @@
 #include <vespa/searchlib/attribute/iattributemanager.h>
 #include <vespa/searchlib/attribute/attributevector.h>
 #include <vespa/document/select/parser.h>
+#include <vespa/document/select/compare.h>
+#include <vespa/document/select/invalidconstant.h>
+#include <vespa/document/select/traversingvisitor.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.common.cachedselect");
@@ -15,6 +18,8 @@ namespace proton {
 using search::AttributeVector;
 using search::AttributeGuard;
 using document::select::FieldValueNode;
+using document::select::Compare;
+using document::select::InvalidConstant;
 using search::attribute::CollectionType;
 
 namespace {
@@ -110,6 +115,61 @@ AttrVisitor::visitFieldValueNode(const FieldValueNode &expr)
     }
 }
 
+/*
+ * Checks if a comparison can be evaluated using only single value
+ * attributes, i.e. without retrieving the document.
+ */
+class NeedsDocumentVisitor : public document::select::TraversingVisitor
+{
+public:
+    bool _needsDocument;
+
+    NeedsDocumentVisitor() : _needsDocument(false) { }
+
+    void visitFieldValueNode(const FieldValueNode &expr) override {
+        if (dynamic_cast<const AttributeFieldValueNode *>(&expr) == nullptr) {
+            _needsDocument = true;
+        }
+    }
+    void visitIdValueNode(const document::select::IdValueNode &) override { _needsDocument = true; }
+    void visitVariableValueNode(const document::select::VariableValueNode &) override { _needsDocument = true; }
+};
+
+/*
+ * Replace comparisons that need the document with invalid constants.
+ * Since and, or and not treat invalid as unknown, a False result for
+ * the new expression implies a False result for the original one.
+ */
+class AttrPreFilterVisitor : public document::select::CloningVisitor
+{
+public:
+    void visitComparison(const Compare &expr) override;
+    void visitDocumentType(const document::select::DocType &) override { setInvalid(); }
+private:
+    void setInvalid();
+};
+
+void
+AttrPreFilterVisitor::visitComparison(const Compare &expr)
+{
+    NeedsDocumentVisitor needsDocument;
+    expr.visit(needsDocument);
+    if (needsDocument._needsDocument) {
+        setInvalid();
+    } else {
+        CloningVisitor::visitComparison(expr);
+    }
+}
+
+void
+AttrPreFilterVisitor::setInvalid()
+{
+    _constVal = true;
+    _priority = InvalidConstPriority;
+    _resultSet.add(document::select::Result::Invalid);
+    _node.reset(new InvalidConstant("invalid"));
+}
+
 }
 
 CachedSelect::CachedSelect()
@@ -122,7 +182,8 @@ CachedSelect::CachedSelect()
       _allFalse(false),
       _allTrue(false),
       _allInvalid(false),
-      _attrSelect()
+      _attrSelect(),
+      _attrPreFilter()
 { }
 
 CachedSelect::~CachedSelect() { }
@@ -179,6 +240,10 @@ CachedSelect::set(const vespalib::string &selection,
     _svAttrFieldNodes = av._svAttrs;
     if (_fieldNodes == _svAttrFieldNodes) {
         _attrSelect = std::move(av.getNode());
+    } else if (_svAttrFieldNodes > 0u) {
+        AttrPreFilterVisitor pv;
+        av.getNode()->visit(pv);
+        _attrPreFilter = std::move(pv.getNode());
     }
 }
 
@@ -45,7 +45,18 @@ public:
      * SelectContext class and populate _docId instead).
      */
     std::unique_ptr<document::select::Node> _attrSelect;
-    
+
+    /*
+     * If expression references both single value attributes and other
+     * fields then this is the expression with all comparisons that
+     * need the document replaced by invalid constants.  It can be
+     * evaluated the same way as _attrSelect, and a False result means
+     * that the full expression is False for the document, thus the
+     * document does not need to be retrieved.
+     */
+    std::unique_ptr<document::select::Node> _attrPreFilter;
+
+
     CachedSelect();
     ~CachedSelect();
 
@@ -34,6 +34,15 @@ namespace {
 Memory DOCSUMS("docsums");
 Memory DOCSUM("docsum");
 
+// Do not hand fewer hits than this to a thread of its own.
+const uint32_t MIN_HITS_PER_THREAD = 4;
+
+struct DocsumPart : vespalib::Runnable {
+    std::function<void()> fill;
+    explicit DocsumPart(std::function<void()> fill_in) : fill(std::move(fill_in)) {}
+    void run() override { fill(); }
+};
+
 }
 
 void
@@ -54,30 +63,75 @@ DocsumContext::initState()
     }
 }
 
-DocsumReply::UP
-DocsumContext::createReply()
+size_t
+DocsumContext::numParallelParts() const
+{
+    if (_threadBundle == nullptr) {
+        return 1;
+    }
+    return std::max(size_t(1), std::min(_threadBundle->size(), size_t(_docsumState._docsumcnt / MIN_HITS_PER_THREAD)));
+}
+
+void
+DocsumContext::insertDocsums(GetDocsumsState & state, IDocsumStore & store, DocsumReply & reply, uint32_t offset)
 {
-    DocsumReply::UP reply(new DocsumReply());
     search::RawBuf buf(4096);
-    _docsumWriter.InitState(_attrMgr, &_docsumState);
-    reply->docsums.resize(_docsumState._docsumcnt);
     SymbolTable::UP symbols = std::make_unique<SymbolTable>();
-    IDocsumWriter::ResolveClassInfo rci = _docsumWriter.resolveClassInfo(_docsumState._args.getResultClassName(), _docsumStore.getSummaryClassId());
-    for (uint32_t i = 0; i < _docsumState._docsumcnt; ++i) {
+    IDocsumWriter::ResolveClassInfo rci = _docsumWriter.resolveClassInfo(state._args.getResultClassName(), store.getSummaryClassId());
+    for (uint32_t i = 0; i < state._docsumcnt; ++i) {
         buf.reset();
-        uint32_t docId = _docsumState._docsumbuf[i];
-        reply->docsums[i].docid = docId;
+        uint32_t docId = state._docsumbuf[i];
+        DocsumReply::Docsum & docsum = reply.docsums[offset + i];
+        docsum.docid = docId;
         if (docId != search::endDocId && !rci.mustSkip) {
             Slime slime(Slime::Params(std::move(symbols)));
             vespalib::slime::SlimeInserter inserter(slime);
-            _docsumWriter.insertDocsum(rci, docId, &_docsumState, &_docsumStore, slime, inserter);
+            _docsumWriter.insertDocsum(rci, docId, &state, &store, slime, inserter);
             uint32_t docsumLen = (slime.get().type().getId() != NIX::ID)
                                    ? IDocsumWriter::slime2RawBuf(slime, buf)
                                    : 0;
-            reply->docsums[i].setData(buf.GetDrainPos(), docsumLen);
+            docsum.setData(buf.GetDrainPos(), docsumLen);
             symbols = Slime::reclaimSymbols(std::move(slime));
         }
     }
+}
+
+DocsumReply::UP
+DocsumContext::createReply()
+{
+    DocsumReply::UP reply(new DocsumReply());
+    reply->docsums.resize(_docsumState._docsumcnt);
+    size_t numParts = numParallelParts();
+    if (numParts <= 1) {
+        _docsumWriter.InitState(_attrMgr, &_docsumState);
+        insertDocsums(_docsumState, _docsumStore, *reply, 0);
+        return reply;
+    }
+    std::vector<std::unique_ptr<GetDocsumsState>> states;
+    std::vector<IDocsumStore::UP> stores;
+    std::vector<std::unique_ptr<DocsumPart>> parts;
+    std::vector<vespalib::Runnable *> targets;
+    uint32_t docsumCnt = _docsumState._docsumcnt;
+    for (size_t part = 0; part < numParts; ++part) {
+        uint32_t begin = (docsumCnt * part) / numParts;
+        uint32_t end = (docsumCnt * (part + 1)) / numParts;
+        auto state = std::make_unique<GetDocsumsState>(*this);
+        state->_args.Copy(&_docsumState._args);
+        state->_docsumcnt = end - begin;
+        state->_docsumbuf = (uint32_t*)malloc(sizeof(uint32_t) * state->_docsumcnt);
+        std::copy(_docsumState._docsumbuf + begin, _docsumState._docsumbuf + end, state->_docsumbuf);
+        _docsumWriter.InitState(_attrMgr, state.get());
+        IDocsumStore::UP store = _storeFactory();
+        GetDocsumsState & stateRef = *state;
+        IDocsumStore & storeRef = *store;
+        DocsumReply & replyRef = *reply;
+        parts.push_back(std::make_unique<DocsumPart>([this, &stateRef, &storeRef, &replyRef, begin]()
+                                                     { insertDocsums(stateRef, storeRef, replyRef, begin); }));
+        targets.push_back(parts.back().get());
+        states.push_back(std::move(state));
+        stores.push_back(std::move(store));
+    }
+    _threadBundle->run(targets);
     return reply;
 }
 
@@ -129,11 +183,25 @@ DocsumContext::DocsumContext(const DocsumRequest & request,
     _attrCtx(attrCtx),
     _attrMgr(attrMgr),
     _docsumState(*this),
-    _sessionMgr(sessionMgr)
+    _sessionMgr(sessionMgr),
+    _threadBundle(nullptr),
+    _storeFactory(),
+    _featureLock(),
+    _summaryFeaturesFilled(false),
+    _summaryFeatures(),
+    _rankFeaturesFilled(false),
+    _rankFeatures()
 {
     initState();
 }
 
+void
+DocsumContext::useThreadBundle(vespalib::ThreadBundle & threadBundle, StoreFactory storeFactory)
+{
+    _threadBundle = &threadBundle;
+    _storeFactory = std::move(storeFactory);
+}
+
 DocsumReply::UP
 DocsumContext::getDocsums()
 {
@@ -146,22 +214,30 @@ DocsumContext::getDocsums()
 void
 DocsumContext::FillSummaryFeatures(search::docsummary::GetDocsumsState * state, search::docsummary::IDocsumEnvironment *)
 {
-    assert(&_docsumState == state);
-    if (_matcher->canProduceSummaryFeatures()) {
-        state->_summaryFeatures = _matcher->getSummaryFeatures(_request, _searchCtx, _attrCtx, _sessionMgr);
+    std::lock_guard<std::mutex> guard(_featureLock);
+    if (!_summaryFeaturesFilled) {
+        if (_matcher->canProduceSummaryFeatures()) {
+            _summaryFeatures = _matcher->getSummaryFeatures(_request, _searchCtx, _attrCtx, _sessionMgr);
+        }
+        _summaryFeaturesFilled = true;
     }
+    state->_summaryFeatures = _summaryFeatures;
     state->_summaryFeaturesCached = false;
 }
 
 void
 DocsumContext::FillRankFeatures(search::docsummary::GetDocsumsState * state, search::docsummary::IDocsumEnvironment *)
 {
-    assert(&_docsumState == state);
     // check if we are allowed to run
     if ((state->_args.GetQueryFlags() & search::fs4transport::QFLAG_DUMP_FEATURES) == 0) {
         return;
     }
-    state->_rankFeatures = _matcher->getRankFeatures(_request, _searchCtx, _attrCtx, _sessionMgr);
+    std::lock_guard<std::mutex> guard(_featureLock);
+    if (!_rankFeaturesFilled) {
+        _rankFeatures = _matcher->getRankFeatures(_request, _searchCtx, _attrCtx, _sessionMgr);
+        _rankFeaturesFilled = true;
+    }
+    state->_rankFeatures = _rankFeatures;
 }
 
 namespace {
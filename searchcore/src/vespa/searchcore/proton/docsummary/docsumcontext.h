@@ -7,6 +7,9 @@
 #include <vespa/searchsummary/docsummary/docsumwriter.h>
 #include <vespa/searchlib/engine/docsumrequest.h>
 #include <vespa/searchlib/engine/docsumreply.h>
+#include <vespa/vespalib/util/thread_bundle.h>
+#include <functional>
+#include <mutex>
 
 namespace proton {
 
@@ -15,6 +18,8 @@ namespace proton {
  * creating a docsum reply.
  **/
 class DocsumContext : public search::docsummary::GetDocsumsStateCallback {
+public:
+    using StoreFactory = std::function<std::unique_ptr<search::docsummary::IDocsumStore>()>;
 private:
     const search::engine::DocsumRequest  & _request;
     search::docsummary::IDocsumWriter    & _docsumWriter;
@@ -25,8 +30,18 @@ private:
     search::IAttributeManager            & _attrMgr;
     search::docsummary::GetDocsumsState    _docsumState;
     matching::SessionManager             & _sessionMgr;
+    vespalib::ThreadBundle               * _threadBundle;
+    StoreFactory                           _storeFactory;
+    std::mutex                             _featureLock;
+    bool                                   _summaryFeaturesFilled;
+    search::FeatureSet::SP                 _summaryFeatures;
+    bool                                   _rankFeaturesFilled;
+    search::FeatureSet::SP                 _rankFeatures;
 
     void initState();
+    size_t numParallelParts() const;
+    void insertDocsums(search::docsummary::GetDocsumsState & state, search::docsummary::IDocsumStore & store,
+                       search::engine::DocsumReply & reply, uint32_t offset);
     search::engine::DocsumReply::UP createReply();
     std::unique_ptr<vespalib::Slime> createSlimeReply();
 
@@ -42,6 +57,13 @@ public:
                   search::IAttributeManager & attrMgr,
                   matching::SessionManager & sessionMgr);
 
+    /**
+     * Let the legacy reply format be filled by the threads in the given
+     * bundle. Each thread gets its own state and a docsum store created
+     * by the given factory, as neither can be shared between threads.
+     **/
+    void useThreadBundle(vespalib::ThreadBundle & threadBundle, StoreFactory storeFactory);
+
     search::engine::DocsumReply::UP getDocsums();
 
     // Implements GetDocsumsStateCallback
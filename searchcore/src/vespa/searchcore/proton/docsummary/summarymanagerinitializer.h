@@ -44,6 +44,7 @@ public:
                               IBucketizerSP bucketizer,
                               std::shared_ptr<SummaryManager::SP> result);
     ~SummaryManagerInitializer();
+    bool isIoBound() const override { return true; }
     void run() override;
 };
 
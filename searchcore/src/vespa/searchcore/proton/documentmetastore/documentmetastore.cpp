@@ -18,6 +18,7 @@
 #include <vespa/searchlib/common/rcuvector.hpp>
 #include <vespa/searchlib/query/queryterm.h>
 #include <vespa/fastos/file.h>
+#include <numeric>
 #include "document_meta_store_versions.h"
 
 
@@ -716,6 +717,39 @@ DocumentMetaStore::getLid(const GlobalId &gid, DocId &lid) const
     return true;
 }
 
+void
+DocumentMetaStore::getLids(const std::vector<GlobalId> &gids, std::vector<DocId> &lids) const
+{
+    lids.assign(gids.size(), 0);
+    if (gids.empty()) {
+        return;
+    }
+    // Look up the gids in tree order, stepping a single iterator
+    // forwards instead of searching from the root for each gid.
+    std::vector<uint32_t> order(gids.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(),
+              [&](uint32_t lhs, uint32_t rhs) { return (*_gidCompare)(gids[lhs], gids[rhs]); });
+    TreeType::FrozenView frozenTreeView = _gidToLidMap.getFrozenView();
+    KeyComp firstComp(gids[order[0]], _metaDataStore, *_gidCompare);
+    TreeType::ConstIterator itr = frozenTreeView.lowerBound(KeyComp::FIND_DOC_ID, firstComp);
+    for (uint32_t idx : order) {
+        if (!itr.valid()) {
+            break;
+        }
+        KeyComp comp(gids[idx], _metaDataStore, *_gidCompare);
+        if (comp(itr.getKey(), KeyComp::FIND_DOC_ID)) {
+            itr.seek(KeyComp::FIND_DOC_ID, comp);
+            if (!itr.valid()) {
+                break;
+            }
+        }
+        if (!comp(KeyComp::FIND_DOC_ID, itr.getKey())) {
+            lids[idx] = itr.getKey();
+        }
+    }
+}
+
 void
 DocumentMetaStore::constructFreeList()
 {
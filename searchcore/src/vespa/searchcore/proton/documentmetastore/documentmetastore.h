@@ -204,6 +204,7 @@ public:
     bool getGid(DocId lid, GlobalId &gid) const override;
     bool getGidEvenIfMoved(DocId lid, GlobalId &gid) const override;
     bool getLid(const GlobalId & gid, DocId &lid) const override;
+    void getLids(const std::vector<GlobalId> &gids, std::vector<DocId> &lids) const override;
     search::DocumentMetaData getMetaData(const GlobalId &gid) const override;
     void getMetaData(const BucketId &bucketId, search::DocumentMetaData::Vector &result) const override;
     DocId   getNumUsedLids() const override { return _lidAlloc.getNumUsedLids(); }
@@ -33,6 +33,7 @@ public:
                                  const vespalib::string &subDbName,
                                  const vespalib::string &docTypeName,
                                  DocumentMetaStore::SP dms);
+    virtual bool isIoBound() const override { return true; }
     virtual void run() override;
 };
 
@@ -57,6 +57,7 @@ struct IDocumentMetaStore : public search::IDocumentMetaStore,
 
     virtual Iterator upperBound(const GlobalId &gid) const = 0;
 
+    using search::IDocumentMetaStore::getLids;
     virtual void getLids(const BucketId &bucketId, std::vector<DocId> &lids) = 0;
 
     virtual search::AttributeGuard getActiveLidsGuard() const = 0;
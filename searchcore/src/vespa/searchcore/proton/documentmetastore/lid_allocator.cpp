@@ -250,12 +250,14 @@ private:
     }
 
 public:
-    BlackListBlueprint(AttributeVector::SearchContext::UP searchCtx)
+    BlackListBlueprint(AttributeVector::SearchContext::UP searchCtx, uint32_t numInactiveLids)
         : SimpleLeafBlueprint(FieldSpecBaseList()),
           _searchCtx(std::move(searchCtx)),
           _matchDataVector()
     {
-        setEstimate(HitEstimate(0, false));
+        // An empty black list is removed by the optimizer, so a query over
+        // a fully active lid space does not pay for the filter.
+        setEstimate(HitEstimate(numInactiveLids, numInactiveLids == 0));
     }
 
     ~BlackListBlueprint() {
@@ -271,8 +273,12 @@ Blueprint::UP
 LidAllocator::createBlackListBlueprint() const
 {
     QueryTermSimple::UP term(new QueryTermSimple("0", QueryTermSimple::WORD));
+    // Lid 0 is never active, and is not counted as an inactive lid.
+    uint32_t numLids = _activeLids.getNumDocs();
+    uint32_t numInactiveLids = (numLids > _numActiveLids + 1) ? (numLids - 1 - _numActiveLids) : 0u;
     return Blueprint::UP(
-            new BlackListBlueprint(_activeLids.getSearch(std::move(term), SearchContextParams())));
+            new BlackListBlueprint(_activeLids.getSearch(std::move(term), SearchContextParams()),
+                                   numInactiveLids));
 }
 
 void
@@ -13,6 +13,7 @@ IndexManagerInitializer(const vespalib::string &baseDir,
                         const searchcorespi::index::WarmupConfig & warmupCfg,
                         size_t maxFlushed,
                         size_t cacheSize,
+                        uint32_t fusionThreads,
                         const search::index::Schema &schema,
                         search::SerialNum serialNum,
                         searchcorespi::IIndexManager::Reconfigurer & reconfigurer,
@@ -26,6 +27,7 @@ IndexManagerInitializer(const vespalib::string &baseDir,
       _warmupCfg(warmupCfg),
       _maxFlushed(maxFlushed),
       _cacheSize(cacheSize),
+      _fusionThreads(fusionThreads),
       _schema(schema),
       _serialNum(serialNum),
       _reconfigurer(reconfigurer),
@@ -50,6 +52,7 @@ IndexManagerInitializer::run()
                      _warmupCfg,
                      _maxFlushed,
                      _cacheSize,
+                     _fusionThreads,
                      _schema,
                      _serialNum,
                      _reconfigurer,
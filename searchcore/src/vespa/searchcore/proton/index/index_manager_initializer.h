@@ -19,6 +19,7 @@ class IndexManagerInitializer :  public initializer::InitializerTask
     const searchcorespi::index::WarmupConfig    _warmupCfg;
     size_t                                      _maxFlushed;
     size_t                                      _cacheSize;
+    uint32_t                                    _fusionThreads;
     const search::index::Schema                 _schema;
     search::SerialNum                           _serialNum;
     searchcorespi::IIndexManager::Reconfigurer &_reconfigurer;
@@ -34,6 +35,7 @@ public:
                             const searchcorespi::index::WarmupConfig & warmupCfg,
                             size_t maxFlushed,
                             size_t cacheSize,
+                            uint32_t fusionThreads,
                             const search::index::Schema &schema,
                             search::SerialNum serialNum,
                             searchcorespi::IIndexManager::Reconfigurer & reconfigurer,
@@ -43,6 +45,7 @@ public:
                             const search::TuneFileAttributes & tuneFileAttributes,
                             const search::common::FileHeaderContext & fileHeaderContext,
                             std::shared_ptr<searchcorespi::IIndexManager::SP> indexManager);
+    virtual bool isIoBound() const override { return true; }
     virtual void run() override;
 };
 
@@ -27,10 +27,12 @@ namespace proton {
 IndexManager::MaintainerOperations::MaintainerOperations(const FileHeaderContext &fileHeaderContext,
                                                          const TuneFileIndexManager &tuneFileIndexManager,
                                                          size_t cacheSize,
+                                                         uint32_t fusionThreads,
                                                          searchcorespi::index::
                                                          IThreadingService &
                                                          threadingService)
     : _cacheSize(cacheSize),
+      _fusionThreads(fusionThreads),
       _fileHeaderContext(fileHeaderContext),
       _tuneFileIndexing(tuneFileIndexManager._indexing),
       _tuneFileSearch(tuneFileIndexManager._search),
@@ -74,7 +76,7 @@ IndexManager::MaintainerOperations::runFusion(const Schema &schema,
     const bool dynamic_k_doc_pos_occ_format = false;
     return Fusion::merge(schema, outputDir, sources, selectorArray,
                          dynamic_k_doc_pos_occ_format,
-                         _tuneFileIndexing, fileHeaderContext);
+                         _tuneFileIndexing, fileHeaderContext, _fusionThreads);
 }
 
 
@@ -82,6 +84,7 @@ IndexManager::IndexManager(const vespalib::string &baseDir,
                            const WarmupConfig & warmup,
                            const size_t maxFlushed,
                            const size_t cacheSize,
+                           uint32_t fusionThreads,
                            const Schema &schema,
                            SerialNum serialNum,
                            Reconfigurer &reconfigurer,
@@ -91,7 +94,7 @@ IndexManager::IndexManager(const vespalib::string &baseDir,
                            const search::TuneFileAttributes &tuneFileAttributes,
                            const search::common::FileHeaderContext &fileHeaderContext) :
     _operations(fileHeaderContext, tuneFileIndexManager, cacheSize,
-                threadingService),
+                fusionThreads, threadingService),
     _maintainer(IndexMaintainerConfig(baseDir,
                                       warmup,
                                       maxFlushed,
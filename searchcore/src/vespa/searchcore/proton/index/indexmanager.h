@@ -20,6 +20,7 @@ public:
     class MaintainerOperations : public searchcorespi::index::IIndexMaintainerOperations {
     private:
         const size_t _cacheSize;
+        const uint32_t _fusionThreads;
         const search::common::FileHeaderContext &_fileHeaderContext;
         const search::TuneFileIndexing _tuneFileIndexing;
         const search::TuneFileSearch _tuneFileSearch;
@@ -29,6 +30,7 @@ public:
         MaintainerOperations(const search::common::FileHeaderContext &fileHeaderContext,
                              const search::TuneFileIndexManager &tuneFileIndexManager,
                              size_t cacheSize,
+                             uint32_t fusionThreads,
                              searchcorespi::index::IThreadingService &
                              threadingService);
 
@@ -57,6 +59,7 @@ public:
                  const searchcorespi::index::WarmupConfig & warmup,
                  size_t maxFlushed,
                  size_t cacheSize,
+                 uint32_t fusionThreads,
                  const Schema &schema,
                  SerialNum serialNum,
                  Reconfigurer &reconfigurer,
@@ -1,12 +1,15 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "initializer_task.h"
+#include <vespa/vespalib/util/classname.h>
 
 namespace proton::initializer {
 
 InitializerTask::InitializerTask()
     : _state(State::BLOCKED),
-      _dependencies()
+      _dependencies(),
+      _name(),
+      _runTime(clock::duration::zero())
 {
 }
 
@@ -22,5 +25,12 @@ InitializerTask::addDependency(SP dependency)
     _dependencies.emplace_back(std::move(dependency));
 }
 
+
+vespalib::string
+InitializerTask::getName() const
+{
+    return _name.empty() ? vespalib::getClassName(*this) : _name;
+}
+
 } // namespace proton::initializer
 
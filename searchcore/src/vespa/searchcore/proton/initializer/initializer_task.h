@@ -1,6 +1,8 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include <vespa/vespalib/stllike/string.h>
+#include <chrono>
 #include <memory>
 #include <vector>
 
@@ -16,14 +18,17 @@ class InitializerTask {
 public:
     using SP = std::shared_ptr<InitializerTask>;
     using List = std::vector<SP>;
+    using clock = std::chrono::steady_clock;
     enum class State {
         BLOCKED,
         RUNNING,
         DONE
     };
 private:
-    State           _state;
-    List            _dependencies;
+    State             _state;
+    List              _dependencies;
+    vespalib::string  _name;
+    clock::duration   _runTime;
 public:
     InitializerTask();
     virtual ~InitializerTask();
@@ -32,6 +37,21 @@ public:
     void setRunning() { _state = State::RUNNING; }
     void setDone() { _state = State::DONE; }
     void addDependency(SP dependency);
+    /*
+     * Name used when reporting task durations, defaults to the class name.
+     */
+    void setName(const vespalib::string &name) { _name = name; }
+    vespalib::string getName() const;
+    /*
+     * Time spent in run(), excluding time waiting for a thread.
+     */
+    void setRunTime(clock::duration runTime) { _runTime = runTime; }
+    clock::duration getRunTime() const { return _runTime; }
+    /*
+     * Tasks mostly waiting for disk reads are run by a separate io
+     * executor when one is given to the task runner.
+     */
+    virtual bool isIoBound() const { return false; }
     virtual void run() = 0;
 };
 
@@ -10,7 +10,13 @@ using vespalib::makeLambdaTask;
 namespace proton::initializer {
 
 TaskRunner::TaskRunner(vespalib::Executor &executor)
+    : TaskRunner(executor, nullptr)
+{
+}
+
+TaskRunner::TaskRunner(vespalib::Executor &executor, vespalib::Executor *ioExecutor)
     : _executor(executor),
+      _ioExecutor(ioExecutor),
       _runningTasks(0u)
 {
 }
@@ -72,9 +78,12 @@ TaskRunner::internalRunTask(InitializerTask::SP task, Context::SP context)
     assert(task->getState() == State::BLOCKED);
     setTaskRunning(*task);
     auto done(makeLambdaTask([=]() { setTaskDone(*task, context); }));
-    _executor.execute(makeLambdaTask([=, done(std::move(done))]() mutable
-                                     {   task->run();
-                                         context->execute(std::move(done)); }));
+    vespalib::Executor &executor = (task->isIoBound() && (_ioExecutor != nullptr)) ? *_ioExecutor : _executor;
+    executor.execute(makeLambdaTask([=, done(std::move(done))]() mutable
+                                    {   auto start = InitializerTask::clock::now();
+                                        task->run();
+                                        task->setRunTime(InitializerTask::clock::now() - start);
+                                        context->execute(std::move(done)); }));
 }
 
 void
@@ -114,6 +123,34 @@ TaskRunner::pollTask(Context::SP context)
     internalRunTasks(readyTasks, context);
 }
 
+namespace {
+
+void
+collectTaskTimings(const InitializerTask::SP &task, TaskRunner::TaskTimings &timings,
+                   vespalib::hash_set<const void *> &visited)
+{
+    if (!visited.insert(task.get()).second) {
+        return;
+    }
+    for (const auto &dep : task->getDependencies()) {
+        collectTaskTimings(dep, timings, visited);
+    }
+    timings.emplace_back(task->getName(),
+                         std::chrono::duration<double>(task->getRunTime()).count(),
+                         task->isIoBound());
+}
+
+}
+
+TaskRunner::TaskTimings
+TaskRunner::getTaskTimings(const InitializerTask::SP &rootTask)
+{
+    TaskTimings timings;
+    vespalib::hash_set<const void *> visited;
+    collectTaskTimings(rootTask, timings, visited);
+    return timings;
+}
+
 void
 TaskRunner::runTask(InitializerTask::SP rootTask,
                     vespalib::Executor &contextExecutor,
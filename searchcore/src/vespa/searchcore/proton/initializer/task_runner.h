@@ -16,6 +16,7 @@ namespace initializer {
 class TaskRunner {
     // Executor for the tasks, not to be confused by the context executor.
     vespalib::Executor      &_executor;     // can be multithreaded
+    vespalib::Executor      *_ioExecutor;   // optional, runs io bound tasks
     uint32_t                 _runningTasks; // used by context executor
     using State = InitializerTask::State;
     using TaskList = InitializerTask::List;
@@ -57,7 +58,17 @@ class TaskRunner {
 
     void pollTask(Context::SP context);
 public:
+    struct TaskTiming {
+        vespalib::string name;
+        double           seconds;
+        bool             ioBound;
+        TaskTiming(const vespalib::string &name_in, double seconds_in, bool ioBound_in)
+            : name(name_in), seconds(seconds_in), ioBound(ioBound_in) {}
+    };
+    using TaskTimings = std::vector<TaskTiming>;
+
     TaskRunner(vespalib::Executor &executor);
+    TaskRunner(vespalib::Executor &executor, vespalib::Executor *ioExecutor);
 
     virtual ~TaskRunner();
 
@@ -68,6 +79,11 @@ public:
     void runTask(InitializerTask::SP rootTask,
                  vespalib::Executor &contextExecutor,
                  vespalib::Executor::Task::UP doneTask);
+
+    /*
+     * Run time of each task in the graph, dependencies before dependers.
+     */
+    static TaskTimings getTaskTimings(const InitializerTask::SP &rootTask);
 };
 
 } // namespace proton::initializer
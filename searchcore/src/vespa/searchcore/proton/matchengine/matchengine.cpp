@@ -2,6 +2,8 @@
 #include "matchengine.h"
 #include <vespa/searchcore/proton/common/state_reporter_utils.h>
 #include <vespa/vespalib/data/slime/cursor.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/searchlib/engine/errorcodes.h>
 #include <algorithm>
 
 #include <vespa/log/log.h>
@@ -32,22 +34,34 @@ public:
 };
 
 
+// Weight of the newest sample in the moving average of service time.
+constexpr int64_t SERVICE_TIME_SMOOTHING = 8;
+
 } // namespace anon
 
 namespace proton {
 
 using namespace vespalib::slime;
 
-MatchEngine::MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey)
+MatchEngine::MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey,
+                         bool numaAware, bool adaptiveThreadsPerSearch)
     : _lock(),
       _distributionKey(distributionKey),
+      _numThreads(std::max(size_t(1), numThreads)),
+      _threadsPerSearch(std::max(size_t(1), threadsPerSearch)),
+      _adaptiveThreadsPerSearch(adaptiveThreadsPerSearch),
       _closed(false),
       _handlers(),
-      _executor(std::max(size_t(1), numThreads / threadsPerSearch), 256 * 1024),
-      _threadBundlePool(std::max(size_t(1), threadsPerSearch)),
+      _executor(adaptiveThreadsPerSearch ? _numThreads : std::max(size_t(1), numThreads / threadsPerSearch), 256 * 1024),
+      _numaNodes(numaAware ? std::make_unique<vespalib::NumaNodes>() : std::unique_ptr<vespalib::NumaNodes>()),
+      _threadBundlePool(std::max(size_t(1), threadsPerSearch), _numaNodes.get()),
       _online(false),
       _nodeUp(false),
-      _inService(false)
+      _inService(false),
+      _admissionControl(false),
+      _serviceTimeEstimate(0),
+      _numRejected(0),
+      _activeSearches(0)
 {
     // empty
 }
@@ -105,9 +119,16 @@ MatchEngine::search(search::engine::SearchRequest::Source request,
 
         return ret;
     }
+    if (shouldReject(*request.get())) {
+        return createRejectReply(*request.get());
+    }
     vespalib::Executor::Task::UP task;
     task.reset(new SearchTask(*this, std::move(request), client));
-    _executor.execute(std::move(task));
+    _activeSearches.fetch_add(1, std::memory_order_relaxed);
+    task = _executor.execute(std::move(task));
+    if (task) {
+        _activeSearches.fetch_sub(1, std::memory_order_relaxed);
+    }
     return search::engine::SearchReply::UP();
 }
 
@@ -115,36 +136,96 @@ void
 MatchEngine::performSearch(search::engine::SearchRequest::Source req,
                            search::engine::SearchClient &client)
 {
-    search::engine::SearchReply::UP ret(new search::engine::SearchReply);
+    search::engine::SearchReply::UP ret;
 
-    if (req.get() != NULL) {
-        ISearchHandler::SP searchHandler;
-        vespalib::SimpleThreadBundle::UP threadBundle = _threadBundlePool.obtain();
-        { // try to find the match handler corresponding to the specified search doc type
-            std::lock_guard<std::mutex> guard(_lock);
-            DocTypeName docTypeName(*req.get());
-            searchHandler = _handlers.getHandler(docTypeName);
-        }
-        if (searchHandler.get() != NULL) {
-            ret = searchHandler->match(searchHandler, *req.get(), *threadBundle);
-        } else {
-            HandlerMap<ISearchHandler>::Snapshot::UP snapshot;
-            {
-                std::lock_guard<std::mutex> guard(_lock);
-                snapshot = _handlers.snapshot();
-            }
-            if (snapshot->valid()) {
-                ISearchHandler::SP handler = snapshot->getSP();
-                ret = handler->match(handler, *req.get(), *threadBundle); // use the first handler
-            }
-        }
-        _threadBundlePool.release(std::move(threadBundle));
+    if (req.get() == NULL) {
+        ret.reset(new search::engine::SearchReply);
+    } else if (shouldReject(*req.get())) {
+        ret = createRejectReply(*req.get());
+    } else {
+        fastos::StopWatch serviceTime;
+        serviceTime.start();
+        ret = doSearch(*req.get());
+        serviceTime.stop();
+        updateServiceTimeEstimate(serviceTime.elapsed());
     }
     ret->request = req.release();
     ret->setDistributionKey(_distributionKey);
+    _activeSearches.fetch_sub(1, std::memory_order_relaxed);
     client.searchDone(std::move(ret));
 }
 
+bool
+MatchEngine::shouldReject(const search::engine::SearchRequest &request) const
+{
+    return _admissionControl.load(std::memory_order_relaxed) &&
+           (request.getTimeLeft().val() < _serviceTimeEstimate.load(std::memory_order_relaxed));
+}
+
+search::engine::SearchReply::UP
+MatchEngine::createRejectReply(const search::engine::SearchRequest &request)
+{
+    _numRejected.fetch_add(1, std::memory_order_relaxed);
+    auto ret = std::make_unique<search::engine::SearchReply>();
+    ret->setDistributionKey(_distributionKey);
+    ret->errorCode = search::engine::ECODE_OVERLOADED;
+    ret->errorMessage = vespalib::make_string("Rejected: %" PRId64 " ms left is less than the estimated service time of %" PRId64 " ms",
+                                              request.getTimeLeft().ms(), getServiceTimeEstimate().ms());
+    return ret;
+}
+
+void
+MatchEngine::updateServiceTimeEstimate(fastos::TimeStamp serviceTime)
+{
+    int64_t estimate = _serviceTimeEstimate.load(std::memory_order_relaxed);
+    _serviceTimeEstimate.store(estimate + (serviceTime.val() - estimate) / SERVICE_TIME_SMOOTHING, std::memory_order_relaxed);
+}
+
+size_t
+MatchEngine::getThreadsPerSearch(size_t activeSearches) const
+{
+    if (!_adaptiveThreadsPerSearch) {
+        return _threadsPerSearch;
+    }
+    return std::max(size_t(1), std::min(_threadsPerSearch, _numThreads / std::max(size_t(1), activeSearches)));
+}
+
+search::engine::SearchReply::UP
+MatchEngine::doSearch(const search::engine::SearchRequest &req)
+{
+    search::engine::SearchReply::UP ret(new search::engine::SearchReply);
+    ISearchHandler::SP searchHandler;
+    vespalib::SimpleThreadBundle::UP simpleThreadBundle = _threadBundlePool.obtain();
+    if (_numaNodes) {
+        _numaNodes->bindCurrentThread(simpleThreadBundle->numaNode());
+    }
+    vespalib::LimitedThreadBundleWrapper threadBundle(*simpleThreadBundle,
+            getThreadsPerSearch(_activeSearches.load(std::memory_order_relaxed)));
+    { // try to find the match handler corresponding to the specified search doc type
+        std::lock_guard<std::mutex> guard(_lock);
+        DocTypeName docTypeName(req);
+        searchHandler = _handlers.getHandler(docTypeName);
+    }
+    if (searchHandler.get() != NULL) {
+        ret = searchHandler->match(searchHandler, req, threadBundle);
+    } else {
+        HandlerMap<ISearchHandler>::Snapshot::UP snapshot;
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            snapshot = _handlers.snapshot();
+        }
+        if (snapshot->valid()) {
+            ISearchHandler::SP handler = snapshot->getSP();
+            ret = handler->match(handler, req, threadBundle); // use the first handler
+        }
+    }
+    _threadBundlePool.release(std::move(simpleThreadBundle));
+    if (_numaNodes) {
+        _numaNodes->unbindCurrentThread();
+    }
+    return ret;
+}
+
 void MatchEngine::setOnline()
 {
     _online = true;
@@ -195,9 +276,14 @@ MatchEngine::reportStatus() const
 void
 MatchEngine::get_state(const Inserter &inserter, bool full) const
 {
-    (void) full;
     Cursor &object = inserter.insertObject();
     StateReporterUtils::convertToSlime(*reportStatus(), ObjectInserter(object, "status"));
+    if (full) {
+        Cursor &admission = object.setObject("admission");
+        admission.setBool("enabled", _admissionControl.load(std::memory_order_relaxed));
+        admission.setLong("serviceTimeEstimateMs", getServiceTimeEstimate().ms());
+        admission.setLong("rejected", getNumRejected());
+    }
 }
 
 } // namespace proton
@@ -9,6 +9,7 @@
 #include <vespa/vespalib/net/state_explorer.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/util/simple_thread_bundle.h>
+#include <atomic>
 #include <mutex>
 
 namespace proton {
@@ -19,13 +20,26 @@ class MatchEngine : public search::engine::SearchServer,
 private:
     std::mutex                         _lock;
     const uint32_t                     _distributionKey;
+    const size_t                       _numThreads;
+    const size_t                       _threadsPerSearch;
+    const bool                         _adaptiveThreadsPerSearch;
     bool                               _closed;
     HandlerMap<ISearchHandler>         _handlers;
     vespalib::ThreadStackExecutor      _executor;
+    std::unique_ptr<vespalib::NumaNodes> _numaNodes;
     vespalib::SimpleThreadBundle::Pool _threadBundlePool;
     bool                               _online;
     bool                               _nodeUp;
     bool                               _inService;
+    std::atomic<bool>                  _admissionControl;
+    std::atomic<int64_t>               _serviceTimeEstimate;
+    std::atomic<uint64_t>              _numRejected;
+    std::atomic<size_t>                _activeSearches;
+
+    bool shouldReject(const search::engine::SearchRequest &request) const;
+    search::engine::SearchReply::UP createRejectReply(const search::engine::SearchRequest &request);
+    void updateServiceTimeEstimate(fastos::TimeStamp serviceTime);
+    search::engine::SearchReply::UP doSearch(const search::engine::SearchRequest &req);
 
 public:
     /**
@@ -45,8 +59,14 @@ public:
      * @param numThreads Number of threads allocated for handling search requests.
      * @param threadsPerSearch number of threads used for each search
      * @param distributionKey distributionkey of this node.
+     * @param numaAware run all threads of a search on a single NUMA node,
+     *                  spreading searches over the nodes.
+     * @param adaptiveThreadsPerSearch let up to numThreads searches run
+     *                  concurrently, each using at most threadsPerSearch
+     *                  threads, fewer the more searches are active.
      */
-    MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey);
+    MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey,
+                bool numaAware = false, bool adaptiveThreadsPerSearch = false);
 
     /**
      * Frees any allocated resources. this will also stop all internal threads
@@ -61,6 +81,14 @@ public:
      **/
     vespalib::ThreadStackExecutor::Stats getExecutorStats() { return _executor.getStats(); }
 
+    /**
+     * Returns the number of threads a search should use when the given
+     * number of searches (including itself) are queued or running. This
+     * is always threadsPerSearch unless adaptive threads per search is
+     * enabled.
+     **/
+    size_t getThreadsPerSearch(size_t activeSearches) const;
+
     /**
      * Closes the request handler interface. This will prevent any more data
      * from entering this object, allowing you to flush all pending operations
@@ -145,6 +173,19 @@ public:
 
     StatusReport::UP reportStatus() const;
 
+    /**
+     * Enable deadline aware admission control. A request is rejected
+     * with an overloaded error when it is received, and again when it
+     * is dequeued, if its time left is below the estimated service time.
+     */
+    void setAdmissionControl(bool enabled) { _admissionControl = enabled; }
+
+    /** Moving average of the time spent matching a request. */
+    fastos::TimeStamp getServiceTimeEstimate() const { return fastos::TimeStamp(_serviceTimeEstimate.load(std::memory_order_relaxed)); }
+
+    /** Number of requests rejected by admission control. */
+    uint64_t getNumRejected() const { return _numRejected.load(std::memory_order_relaxed); }
+
     // Implements SearchServer.
     search::engine::SearchReply::UP search(
             search::engine::SearchRequest::Source request,
@@ -59,31 +59,44 @@ AttributeLimiter::toString(DiversityCutoffStrategy strategy)
 SearchIterator::UP
 AttributeLimiter::create_search(size_t want_hits, size_t max_group_size, bool strictSearch)
 {
-    std::lock_guard<std::mutex> guard(_lock);
     const uint32_t my_field_id = 0;
     search::fef::MatchDataLayout layout;
     auto my_handle = layout.allocTermField(my_field_id);
-    if ( ! _blueprint ) {
-        const uint32_t no_unique_id = 0;
-        string range_spec = make_string("[;;%s%zu", (_descending)? "-" : "", want_hits);
-        if (max_group_size < want_hits) {
-            size_t cutoffGroups = (_diversityCutoffFactor*want_hits)/max_group_size;
-            range_spec.append(make_string(";%s;%zu;%zu;%s]", _diversity_attribute.c_str(), max_group_size,
-                                          cutoffGroups, toString(_diversityCutoffStrategy).c_str()));
-        } else {
-            range_spec.push_back(']');
+    search::fef::MatchData *match_data = nullptr;
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        if ( ! _blueprint ) {
+            _blueprint = create_blueprint(want_hits, max_group_size, strictSearch, my_field_id, my_handle);
         }
-        Range range(range_spec);
-        SimpleRangeTerm node(range, _attribute_name, no_unique_id, Weight(0));
-        FieldSpecList field; // single field API is protected
-        field.add(FieldSpec(_attribute_name, my_field_id, my_handle));
-        _blueprint = _searchable_attributes.createBlueprint(_requestContext, field, node);
-        _blueprint->fetchPostings(strictSearch);
-        _estimatedHits = _blueprint->getState().estimate().estHits;
-        _blueprint->freeze();
+        _match_datas.push_back(layout.createMatchData());
+        match_data = _match_datas.back().get();
     }
-    _match_datas.push_back(layout.createMatchData());
-    return _blueprint->createSearch(*_match_datas.back(), strictSearch);
+    // The blueprint is frozen, so each thread creates its iterator without holding the lock
+    return _blueprint->createSearch(*match_data, strictSearch);
+}
+
+Blueprint::UP
+AttributeLimiter::create_blueprint(size_t want_hits, size_t max_group_size, bool strictSearch,
+                                   uint32_t field_id, search::fef::TermFieldHandle handle)
+{
+    const uint32_t no_unique_id = 0;
+    string range_spec = make_string("[;;%s%zu", (_descending)? "-" : "", want_hits);
+    if (max_group_size < want_hits) {
+        size_t cutoffGroups = (_diversityCutoffFactor*want_hits)/max_group_size;
+        range_spec.append(make_string(";%s;%zu;%zu;%s]", _diversity_attribute.c_str(), max_group_size,
+                                      cutoffGroups, toString(_diversityCutoffStrategy).c_str()));
+    } else {
+        range_spec.push_back(']');
+    }
+    Range range(range_spec);
+    SimpleRangeTerm node(range, _attribute_name, no_unique_id, Weight(0));
+    FieldSpecList field; // single field API is protected
+    field.add(FieldSpec(_attribute_name, field_id, handle));
+    Blueprint::UP blueprint = _searchable_attributes.createBlueprint(_requestContext, field, node);
+    blueprint->fetchPostings(strictSearch);
+    _estimatedHits = blueprint->getState().estimate().estHits;
+    blueprint->freeze();
+    return blueprint;
 }
 
 } // namespace proton::matching
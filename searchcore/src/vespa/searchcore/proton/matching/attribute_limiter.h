@@ -38,6 +38,8 @@ public:
     static DiversityCutoffStrategy toDiversityCutoffStrategy(const vespalib::stringref & strategy);
 private:
     const vespalib::string & toString(DiversityCutoffStrategy strategy);
+    search::queryeval::Blueprint::UP create_blueprint(size_t want_hits, size_t max_group_size, bool strictSearch,
+                                                      uint32_t field_id, search::fef::TermFieldHandle handle);
     search::queryeval::Searchable            & _searchable_attributes;
     const search::queryeval::IRequestContext & _requestContext;
     vespalib::string                           _attribute_name;
@@ -2,19 +2,32 @@
 
 #include "querynodes.h"
 #include "blueprintbuilder.h"
+#include "cached_filter_blueprint.h"
+#include "filter_cache.h"
+#include <vespa/searchcommon/attribute/iattributevector.h>
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/fef/matchdata.h>
 #include <vespa/searchlib/query/tree/customtypevisitor.h>
 #include <vespa/searchlib/queryeval/leaf_blueprints.h>
 #include <vespa/searchlib/queryeval/intermediate_blueprints.h>
 #include <vespa/searchlib/queryeval/equiv_blueprint.h>
 #include <vespa/searchlib/queryeval/get_weight_from_node.h>
+#include <vespa/vespalib/stllike/asciistream.h>
+#include <algorithm>
 
 using namespace search::queryeval;
+using search::attribute::IAttributeVector;
+using search::fef::MatchData;
+using search::fef::MatchDataLayout;
 
 namespace proton {
 namespace matching {
 
 namespace {
 
+Blueprint::UP buildBlueprint(const IRequestContext &requestContext, search::query::Node &node, ISearchContext &context,
+                             FilterCache *filterCache, const MatchDataLayout *mdl);
+
 struct Mixer {
     std::unique_ptr<OrBlueprint> attributes;
 
@@ -55,13 +68,19 @@ class BlueprintBuilderVisitor :
 private:
     const IRequestContext & _requestContext;
     ISearchContext &_context;
+    FilterCache    *_filterCache;
+    const MatchDataLayout *_mdl;
     Blueprint::UP   _result;
 
+    Blueprint::UP buildChild(search::query::Node &node) {
+        return buildBlueprint(_requestContext, node, _context, _filterCache, _mdl);
+    }
+
     void buildChildren(IntermediateBlueprint &parent,
                        const std::vector<search::query::Node *> &children)
     {
         for (size_t i = 0; i < children.size(); ++i) {
-            parent.addChild(BlueprintBuilder::build(_requestContext, *children[i], _context));
+            parent.addChild(buildChild(*children[i]));
         }
     }
 
@@ -78,7 +97,7 @@ private:
         for (size_t i = 0; i < n.getChildren().size(); ++i) {
             search::query::Node &node = *n.getChildren()[i];
             uint32_t weight = getWeightFromNode(node).percent();
-            wand->addTerm(BlueprintBuilder::build(_requestContext, node, _context), weight);
+            wand->addTerm(buildChild(node), weight);
         }
         _result = std::move(result);
     }
@@ -94,7 +113,7 @@ private:
         for (size_t i = 0; i < n.getChildren().size(); ++i) {
             search::query::Node &node = *n.getChildren()[i];
             double w = getWeightFromNode(node).percent();
-            eq->addTerm(BlueprintBuilder::build(_requestContext, node, _context), w / eqw);
+            eq->addTerm(buildChild(node), w / eqw);
         }
         n.setDocumentFrequency(_result->getState().estimate().estHits, _context.getDocIdLimit());
     }
@@ -147,11 +166,15 @@ protected:
     virtual void visit(ProtonSuffixTerm &n)    override { buildTerm(n); }
     virtual void visit(ProtonPredicateQuery &n) override { buildTerm(n); }
     virtual void visit(ProtonRegExpTerm &n)    override { buildTerm(n); }
+    virtual void visit(ProtonNearestNeighborTerm &n) override { buildTerm(n); }
 
 public:
-    BlueprintBuilderVisitor(const IRequestContext & requestContext, ISearchContext &context) :
+    BlueprintBuilderVisitor(const IRequestContext & requestContext, ISearchContext &context,
+                            FilterCache *filterCache, const MatchDataLayout *mdl) :
         _requestContext(requestContext),
         _context(context),
+        _filterCache(filterCache),
+        _mdl(mdl),
         _result()
     { }
     Blueprint::UP build() {
@@ -160,6 +183,191 @@ public:
     }
 };
 
+/**
+ * Builds the filter cache key of a query subtree; a normalized string
+ * describing everything that affects the result of the subtree. Only
+ * subtrees of AND/OR/ANDNOT over unranked simple terms searching
+ * attribute fields only are filters that can be cached.
+ */
+class FilterKeyBuilder : public search::query::CustomTypeVisitor<ProtonNodeTypes>
+{
+private:
+    bool                                _ok;
+    vespalib::string                    _key;
+    std::vector<vespalib::string>      &_attributes;
+    FieldSpecBaseList                  &_fields;
+
+    vespalib::string buildChildKey(search::query::Node &node) {
+        FilterKeyBuilder builder(_attributes, _fields);
+        node.accept(builder);
+        _ok = _ok && builder.ok();
+        return builder.key();
+    }
+
+    template <typename NodeType>
+    void buildIntermediate(const char *name, NodeType &n, size_t numOrderedChildren) {
+        const auto &children = n.getChildren();
+        std::vector<vespalib::string> keys;
+        for (size_t i = 0; _ok && (i < children.size()); ++i) {
+            keys.push_back(buildChildKey(*children[i]));
+        }
+        std::sort(keys.begin() + std::min(numOrderedChildren, keys.size()), keys.end());
+        vespalib::asciistream os;
+        os << name << "(";
+        for (size_t i = 0; i < keys.size(); ++i) {
+            os << ((i > 0) ? "," : "") << keys[i];
+        }
+        os << ")";
+        _key = os.str();
+    }
+
+    template <typename NodeType>
+    void buildTerm(const char *name, NodeType &n) {
+        if (n.isRanked() || (n.numFields() == 0)) {
+            _ok = false;
+            return;
+        }
+        std::vector<vespalib::string> fieldNames;
+        for (size_t i = 0; i < n.numFields(); ++i) {
+            const ProtonTermData::FieldEntry &field = n.field(i);
+            if (!field.attribute_field) {
+                _ok = false;
+                return;
+            }
+            fieldNames.push_back(field.field_name);
+            _attributes.push_back(field.field_name);
+            _fields.add(field.fieldSpec());
+        }
+        std::sort(fieldNames.begin(), fieldNames.end());
+        vespalib::asciistream term;
+        term << n.getTerm();
+        vespalib::asciistream os;
+        os << name << "(";
+        for (const auto &fieldName: fieldNames) {
+            os << fieldName << ";";
+        }
+        os << term.size() << ":" << term.str() << ")";
+        _key = os.str();
+    }
+
+    void notCacheable() { _ok = false; }
+
+protected:
+    void visit(ProtonAnd &n)     override { buildIntermediate("and", n, 0); }
+    void visit(ProtonAndNot &n)  override { buildIntermediate("andnot", n, 1); }
+    void visit(ProtonOr &n)      override { buildIntermediate("or", n, 0); }
+    void visit(ProtonWeakAnd &)  override { notCacheable(); }
+    void visit(ProtonEquiv &)    override { notCacheable(); }
+    void visit(ProtonRank &)     override { notCacheable(); }
+    void visit(ProtonNear &)     override { notCacheable(); }
+    void visit(ProtonONear &)    override { notCacheable(); }
+
+    void visit(ProtonWeightedSetTerm &) override { notCacheable(); }
+    void visit(ProtonDotProduct &) override { notCacheable(); }
+    void visit(ProtonWandTerm &) override { notCacheable(); }
+
+    void visit(ProtonPhrase &)          override { notCacheable(); }
+    void visit(ProtonNumberTerm &n)     override { buildTerm("number", n); }
+    void visit(ProtonLocationTerm &)    override { notCacheable(); }
+    void visit(ProtonPrefixTerm &n)     override { buildTerm("prefix", n); }
+    void visit(ProtonRangeTerm &n)      override { buildTerm("range", n); }
+    void visit(ProtonStringTerm &n)     override { buildTerm("string", n); }
+    void visit(ProtonSubstringTerm &n)  override { buildTerm("substring", n); }
+    void visit(ProtonSuffixTerm &n)     override { buildTerm("suffix", n); }
+    void visit(ProtonPredicateQuery &)  override { notCacheable(); }
+    void visit(ProtonRegExpTerm &n)     override { buildTerm("regexp", n); }
+    void visit(ProtonNearestNeighborTerm &) override { notCacheable(); }
+
+public:
+    FilterKeyBuilder(std::vector<vespalib::string> &attributes, FieldSpecBaseList &fields)
+        : _ok(true), _key(), _attributes(attributes), _fields(fields) {}
+    bool ok() const { return _ok; }
+    const vespalib::string &key() const { return _key; }
+};
+
+/**
+ * Describes the attribute content the result of a filter subtree was
+ * calculated from. Returns an empty string if some attribute does not
+ * track its content generation.
+ */
+vespalib::string
+makeGenerations(const IRequestContext &requestContext, std::vector<vespalib::string> attributes, uint32_t docIdLimit)
+{
+    std::sort(attributes.begin(), attributes.end());
+    attributes.erase(std::unique(attributes.begin(), attributes.end()), attributes.end());
+    vespalib::asciistream os;
+    os << docIdLimit;
+    for (const auto &name: attributes) {
+        const IAttributeVector *attr = requestContext.getAttribute(name);
+        if ((attr == nullptr) || (attr->getContentGeneration() == IAttributeVector::UNTRACKED_GENERATION)) {
+            return vespalib::string();
+        }
+        os << ";" << name << "=" << attr->getContentGeneration();
+    }
+    return os.str();
+}
+
+/**
+ * Calculate the result of a filter subtree for the full docid space.
+ */
+std::shared_ptr<const search::BitVector>
+calculateFilter(const IRequestContext &requestContext, search::query::Node &node, ISearchContext &context,
+                const MatchDataLayout &mdl)
+{
+    Blueprint::UP blueprint = buildBlueprint(requestContext, node, context, nullptr, nullptr);
+    blueprint = Blueprint::optimize(std::move(blueprint));
+    blueprint->fetchPostings(true);
+    blueprint->freeze();
+    MatchData::UP md = mdl.createMatchData();
+    SearchIterator::UP search = blueprint->createSearch(*md, true);
+    search->initRange(1, context.getDocIdLimit());
+    std::shared_ptr<search::BitVector> bits(search->get_hits(1).release());
+    bits->countTrueBits(); // make the cached count valid before sharing the bit vector
+    return bits;
+}
+
+Blueprint::UP
+buildCachedFilter(const IRequestContext &requestContext, search::query::Node &node, ISearchContext &context,
+                  FilterCache &filterCache, const MatchDataLayout &mdl)
+{
+    std::vector<vespalib::string> attributes;
+    FieldSpecBaseList fields;
+    FilterKeyBuilder keyBuilder(attributes, fields);
+    node.accept(keyBuilder);
+    if (!keyBuilder.ok()) {
+        return Blueprint::UP();
+    }
+    uint32_t docIdLimit = context.getDocIdLimit();
+    vespalib::string generations = makeGenerations(requestContext, std::move(attributes), docIdLimit);
+    if (generations.empty()) {
+        return Blueprint::UP();
+    }
+    FilterCache::Entry::SP entry = filterCache.find(keyBuilder.key(), generations);
+    if (!entry) {
+        entry = std::make_shared<FilterCache::Entry>(calculateFilter(requestContext, node, context, mdl),
+                                                     docIdLimit, generations);
+        filterCache.insert(keyBuilder.key(), entry);
+    }
+    return std::make_unique<CachedFilterBlueprint>(fields, std::move(entry));
+}
+
+Blueprint::UP
+buildBlueprint(const IRequestContext &requestContext, search::query::Node &node, ISearchContext &context,
+               FilterCache *filterCache, const MatchDataLayout *mdl)
+{
+    Blueprint::UP result;
+    if (filterCache != nullptr) {
+        result = buildCachedFilter(requestContext, node, context, *filterCache, *mdl);
+    }
+    if (!result) {
+        BlueprintBuilderVisitor visitor(requestContext, context, filterCache, mdl);
+        node.accept(visitor);
+        result = visitor.build();
+    }
+    result->setDocIdLimit(context.getDocIdLimit());
+    return result;
+}
+
 } // namespace proton::matching::<unnamed>
 
 search::queryeval::Blueprint::UP
@@ -167,11 +375,17 @@ BlueprintBuilder::build(const IRequestContext & requestContext,
                         search::query::Node &node,
                         ISearchContext &context)
 {
-    BlueprintBuilderVisitor visitor(requestContext, context);
-    node.accept(visitor);
-    Blueprint::UP result = visitor.build();
-    result->setDocIdLimit(context.getDocIdLimit());
-    return result;
+    return buildBlueprint(requestContext, node, context, nullptr, nullptr);
+}
+
+search::queryeval::Blueprint::UP
+BlueprintBuilder::build(const IRequestContext & requestContext,
+                        search::query::Node &node,
+                        ISearchContext &context,
+                        FilterCache &filterCache,
+                        const search::fef::MatchDataLayout &mdl)
+{
+    return buildBlueprint(requestContext, node, context, &filterCache, &mdl);
 }
 
 }  // namespace matching
@@ -6,9 +6,13 @@
 #include <vespa/searchlib/query/tree/node.h>
 #include <vespa/searchlib/queryeval/blueprint.h>
 
+namespace search::fef { class MatchDataLayout; }
+
 namespace proton {
 namespace matching {
 
+class FilterCache;
+
 struct BlueprintBuilder {
     /**
      * Build a tree of blueprints from the query tree and inject
@@ -18,6 +22,19 @@ struct BlueprintBuilder {
     build(const search::queryeval::IRequestContext & requestContext,
           search::query::Node &node,
           ISearchContext &context);
+
+    /**
+     * Build a tree of blueprints like above, but take the results of
+     * filter subtrees from the given cache. Filter subtrees not found
+     * in the cache are evaluated for the full docid space (using match
+     * data created from the given layout) and added to the cache.
+     */
+    static search::queryeval::Blueprint::UP
+    build(const search::queryeval::IRequestContext & requestContext,
+          search::query::Node &node,
+          ISearchContext &context,
+          FilterCache &filterCache,
+          const search::fef::MatchDataLayout &mdl);
 };
 
 }  // namespace matching
@@ -0,0 +1,32 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "cached_filter_blueprint.h"
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/common/bitvectoriterator.h>
+#include <cassert>
+
+using search::BitVectorIterator;
+using search::fef::TermFieldMatchDataArray;
+using search::queryeval::FieldSpecBaseList;
+using search::queryeval::SearchIterator;
+
+namespace proton::matching {
+
+CachedFilterBlueprint::CachedFilterBlueprint(const FieldSpecBaseList &fields, FilterCache::Entry::SP entry)
+    : SimpleLeafBlueprint(fields),
+      _entry(std::move(entry))
+{
+    uint32_t hits = _entry->bits->countTrueBits();
+    setEstimate(HitEstimate(hits, (hits == 0)));
+}
+
+CachedFilterBlueprint::~CachedFilterBlueprint() {}
+
+CachedFilterBlueprint::SearchIteratorUP
+CachedFilterBlueprint::createLeafSearch(const TermFieldMatchDataArray &tfmda, bool strict) const
+{
+    assert(tfmda.size() > 0);
+    return BitVectorIterator::create(_entry->bits.get(), _entry->docIdLimit, *tfmda[0], strict);
+}
+
+}
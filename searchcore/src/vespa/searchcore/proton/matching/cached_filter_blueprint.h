@@ -0,0 +1,31 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "filter_cache.h"
+#include <vespa/searchlib/queryeval/blueprint.h>
+
+namespace proton::matching {
+
+/**
+ * Leaf blueprint searching a filter subtree result found in (or just
+ * added to) the filter cache. The fields are those searched by the
+ * terms of the subtree. Since filter terms are not ranked, match data
+ * is only unpacked for the first field.
+ **/
+class CachedFilterBlueprint : public search::queryeval::SimpleLeafBlueprint
+{
+private:
+    FilterCache::Entry::SP _entry;
+
+protected:
+    SearchIteratorUP
+    createLeafSearch(const search::fef::TermFieldMatchDataArray &tfmda, bool strict) const override;
+
+public:
+    CachedFilterBlueprint(const search::queryeval::FieldSpecBaseList &fields, FilterCache::Entry::SP entry);
+    ~CachedFilterBlueprint();
+    const FilterCache::Entry::SP &entry() const { return _entry; }
+};
+
+}
@@ -160,4 +160,96 @@ AdaptiveDocidRangeScheduler::share_range(size_t thread_id, DocidRange todo)
 
 //-----------------------------------------------------------------------------
 
+DocidRange
+WorkStealingDocidRangeScheduler::take_local(size_t thread_id)
+{
+    std::atomic<uint64_t> &todo = _workers[thread_id].todo;
+    uint64_t old_value = todo.load(std::memory_order_acquire);
+    for (;;) {
+        DocidRange range = unpack(old_value);
+        if (range.empty()) {
+            return DocidRange();
+        }
+        // take a fraction of what is left, leaving the rest for thieves
+        uint32_t size = std::min(range.size(), std::max(size_t(_min_task), range.size() / 4));
+        DocidRange rest(range.begin + size, range.end);
+        if (todo.compare_exchange_weak(old_value, pack(rest),
+                                       std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            _workers[thread_id].assigned.fetch_add(size, std::memory_order_relaxed);
+            return DocidRange(range.begin, rest.begin);
+        }
+    }
+}
+
+bool
+WorkStealingDocidRangeScheduler::steal(size_t thread_id)
+{
+    const size_t num_threads = _workers.size();
+    for (;;) {
+        size_t victim = thread_id;
+        uint64_t victim_value = 0;
+        size_t victim_size = 0;
+        for (size_t i = 1; i < num_threads; ++i) {
+            size_t candidate = (thread_id + i) % num_threads;
+            uint64_t value = _workers[candidate].todo.load(std::memory_order_acquire);
+            size_t size = unpack(value).size();
+            if (size > victim_size) {
+                victim = candidate;
+                victim_value = value;
+                victim_size = size;
+            }
+        }
+        if (victim_size < (2 * size_t(_min_task))) {
+            // what is left is too small to split; the owners will finish it
+            return false;
+        }
+        DocidRange range = unpack(victim_value);
+        uint32_t mid = range.begin + (range.size() / 2);
+        if (_workers[victim].todo.compare_exchange_strong(victim_value, pack(DocidRange(range.begin, mid)),
+                                                          std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            // our own todo is empty, so nobody else will touch it until it is published here
+            _workers[thread_id].todo.store(pack(DocidRange(mid, range.end)), std::memory_order_release);
+            return true;
+        }
+    }
+}
+
+WorkStealingDocidRangeScheduler::WorkStealingDocidRangeScheduler(size_t num_threads, uint32_t min_task, uint32_t docid_limit)
+    : _splitter(DocidRange(1, docid_limit), num_threads),
+      _min_task(std::max(1u, min_task)),
+      _workers(num_threads)
+{
+    for (size_t i = 0; i < num_threads; ++i) {
+        _workers[i].todo.store(pack(_splitter.get(i)), std::memory_order_relaxed);
+    }
+}
+
+WorkStealingDocidRangeScheduler::~WorkStealingDocidRangeScheduler() {}
+
+DocidRange
+WorkStealingDocidRangeScheduler::next_range(size_t thread_id)
+{
+    do {
+        DocidRange range = take_local(thread_id);
+        if (!range.empty()) {
+            return range;
+        }
+    } while (steal(thread_id));
+    return DocidRange();
+}
+
+size_t
+WorkStealingDocidRangeScheduler::unassigned_size() const
+{
+    size_t sum = 0;
+    for (const Worker &worker: _workers) {
+        sum += unpack(worker.todo.load(std::memory_order_relaxed)).size();
+    }
+    return sum;
+}
+
+//-----------------------------------------------------------------------------
+
 }
@@ -205,5 +205,52 @@ public:
     DocidRange share_range(size_t, DocidRange todo) override;
 };
 
+/**
+ * A lock-free scheduler that begins by giving each thread an equal
+ * part of the docid space and then lets threads that run out of work
+ * steal from the others. Each thread consumes its own part front to
+ * back, taking a fraction of what remains at a time. An idle thread
+ * steals the upper half of the largest remaining part owned by
+ * another thread. The remaining part of each thread is kept as a
+ * single packed docid range that is updated with compare-and-swap,
+ * making both local progress and stealing free from locking. Stolen
+ * ranges will not be taken in increasing docid order, but no
+ * cooperation from the worker is needed, so the idle observer is
+ * always zero and 'share_range' will never split the range.
+ **/
+class WorkStealingDocidRangeScheduler : public DocidRangeScheduler
+{
+private:
+    struct alignas(64) Worker {
+        std::atomic<uint64_t> todo;
+        std::atomic<size_t>   assigned;
+        Worker() : todo(0), assigned(0) {}
+    };
+    static uint64_t pack(DocidRange range) {
+        return ((uint64_t(range.begin) << 32) | range.end);
+    }
+    static DocidRange unpack(uint64_t value) {
+        return DocidRange(uint32_t(value >> 32), uint32_t(value));
+    }
+    DocidRangeSplitter  _splitter;
+    uint32_t            _min_task;
+    std::vector<Worker> _workers;
+
+    VESPA_DLL_LOCAL DocidRange take_local(size_t thread_id);
+    VESPA_DLL_LOCAL bool steal(size_t thread_id);
+public:
+    WorkStealingDocidRangeScheduler(size_t num_threads, uint32_t min_task, uint32_t docid_limit);
+    ~WorkStealingDocidRangeScheduler();
+    DocidRange first_range(size_t thread_id) override { return next_range(thread_id); }
+    DocidRange next_range(size_t thread_id) override;
+    DocidRange total_span(size_t) const override { return _splitter.full_range(); }
+    size_t total_size(size_t thread_id) const override {
+        return _workers[thread_id].assigned.load(std::memory_order_relaxed);
+    }
+    size_t unassigned_size() const override;
+    IdleObserver make_idle_observer() const override { return IdleObserver(); }
+    DocidRange share_range(size_t, DocidRange todo) override { return todo; }
+};
+
 } // namespace proton::matching
 } // namespace proton
@@ -1,11 +1,13 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "document_scorer.h"
+#include <algorithm>
 
 using search::feature_t;
 using search::fef::FeatureResolver;
 using search::fef::RankProgram;
 using search::fef::LazyValue;
+using search::fef::MatchData;
 using search::queryeval::SearchIterator;
 
 namespace proton {
@@ -36,5 +38,18 @@ DocumentScorer::score(uint32_t docId)
     return doScore(docId);
 }
 
+void
+DocumentScorer::score(IMatchLoopCommunicator::TaggedHits &hits, MatchData &md)
+{
+    auto docIdOrder = [](const IMatchLoopCommunicator::TaggedHit &a, const IMatchLoopCommunicator::TaggedHit &b)
+                      { return (a.first.first < b.first.first); };
+    std::sort(hits.begin(), hits.end(), docIdOrder);
+    for (auto &hit : hits) {
+        md.set_first_phase_score(hit.first.first, hit.first.second);
+        hit.first.second = doScore(hit.first.first);
+    }
+    md.clear_first_phase_score();
+}
+
 } // namespace proton::matching
 } // namespace proton
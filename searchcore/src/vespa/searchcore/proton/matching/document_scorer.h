@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "i_match_loop_communicator.h"
 #include <vespa/searchlib/fef/rank_program.h>
 #include <vespa/searchlib/queryeval/hitcollector.h>
 #include <vespa/searchlib/queryeval/searchiterator.h>
@@ -30,6 +31,13 @@ public:
     }
 
     virtual search::feature_t score(uint32_t docId) override;
+
+    /**
+     * Replace the score of the given hits with the calculated score.
+     * The current score of each hit is made available through the
+     * match data as the first phase score of that document.
+     **/
+    void score(IMatchLoopCommunicator::TaggedHits &hits, search::fef::MatchData &md);
 };
 
 } // namespace proton::matching
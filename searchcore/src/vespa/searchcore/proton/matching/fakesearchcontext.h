@@ -64,6 +64,10 @@ public:
     uint32_t getDocIdLimit() override {
         return _docIdLimit;
     }
+
+    search::SerialNum getIndexSerialNum() override {
+        return _indexes->getSerialNum();
+    }
     virtual const vespalib::Doom & getDoom() const { return _doom; }
 };
 
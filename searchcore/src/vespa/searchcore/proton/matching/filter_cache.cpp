@@ -0,0 +1,64 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "filter_cache.h"
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+
+namespace proton::matching {
+
+FilterCache::Entry::~Entry() {}
+
+FilterCache::FilterCache(size_t maxEntries)
+    : _mutex(),
+      _cache(),
+      _maxEntries(maxEntries)
+{
+}
+
+FilterCache::~FilterCache()
+{
+}
+
+FilterCache::Entry::SP
+FilterCache::find(const vespalib::string &key, const vespalib::string &generations) const
+{
+    LockGuard guard(_mutex);
+    auto itr = _cache.find(key);
+    if ((itr != _cache.end()) && (itr->second->generations == generations)) {
+        return itr->second;
+    }
+    return Entry::SP();
+}
+
+void
+FilterCache::insert(const vespalib::string &key, Entry::SP entry)
+{
+    LockGuard guard(_mutex);
+    auto itr = _cache.find(key);
+    if (itr != _cache.end()) {
+        itr->second = std::move(entry);
+        return;
+    }
+    if (_cache.size() >= _maxEntries) {
+        _cache.clear();
+    }
+    if (_maxEntries > 0) {
+        _cache.insert(std::make_pair(key, std::move(entry)));
+    }
+}
+
+size_t
+FilterCache::size() const
+{
+    LockGuard guard(_mutex);
+    return _cache.size();
+}
+
+void
+FilterCache::clear()
+{
+    LockGuard guard(_mutex);
+    _cache.clear();
+}
+
+}
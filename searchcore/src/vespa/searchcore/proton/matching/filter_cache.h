@@ -0,0 +1,62 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <memory>
+#include <mutex>
+
+namespace search { class BitVector; }
+
+namespace proton::matching {
+
+/**
+ * Cache of filter subtree results (as bit vectors) shared by the
+ * queries evaluated by a matcher. Entries are keyed by a normalized
+ * form of the query subtree. Each entry also records the content
+ * generations of the attributes searched (and the docid limit) when
+ * the result was calculated; an entry is only used by queries seeing
+ * the same generations.
+ *
+ * The cache holds at most maxEntries entries. Inserting a new key
+ * into a full cache drops all entries.
+ **/
+class FilterCache
+{
+public:
+    struct Entry {
+        using SP = std::shared_ptr<const Entry>;
+        std::shared_ptr<const search::BitVector> bits;
+        uint32_t docIdLimit;
+        vespalib::string generations;
+        Entry(std::shared_ptr<const search::BitVector> bits_in, uint32_t docIdLimit_in,
+              const vespalib::string &generations_in)
+            : bits(std::move(bits_in)), docIdLimit(docIdLimit_in), generations(generations_in) {}
+        ~Entry();
+    };
+
+private:
+    using LockGuard = std::lock_guard<std::mutex>;
+    using Cache = vespalib::hash_map<vespalib::string, Entry::SP>;
+
+    mutable std::mutex _mutex;
+    Cache              _cache;
+    size_t             _maxEntries;
+
+public:
+    FilterCache(size_t maxEntries);
+    ~FilterCache();
+    size_t maxEntries() const { return _maxEntries; }
+
+    /**
+     * Returns the entry for the given key if it was calculated with
+     * the given attribute generations, otherwise an empty pointer.
+     **/
+    Entry::SP find(const vespalib::string &key, const vespalib::string &generations) const;
+    void insert(const vespalib::string &key, Entry::SP entry);
+    size_t size() const;
+    void clear();
+};
+
+}
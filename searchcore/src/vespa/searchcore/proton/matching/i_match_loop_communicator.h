@@ -6,6 +6,7 @@
 #include <vespa/searchlib/queryeval/scores.h>
 #include <utility>
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace proton {
@@ -15,6 +16,10 @@ struct IMatchLoopCommunicator {
     typedef search::feature_t feature_t;
     typedef search::queryeval::Scores Range;
     typedef std::pair<Range, Range> RangePair;
+    typedef std::pair<uint32_t, feature_t> Hit;
+    typedef std::vector<Hit> Hits;
+    typedef std::pair<Hit, size_t> TaggedHit; // hit and id of the thread owning it
+    typedef std::vector<TaggedHit> TaggedHits;
     struct Matches {
         size_t hits;
         size_t docs;
@@ -28,6 +33,10 @@ struct IMatchLoopCommunicator {
     virtual double estimate_match_frequency(const Matches &matches) = 0;
     virtual size_t selectBest(const std::vector<feature_t> &sortedScores) = 0;
     virtual RangePair rangeCover(const RangePair &ranges) = 0;
+    // select the globally best hits and hand them out evenly across threads for re-ranking
+    virtual TaggedHits get_second_phase_work(const Hits &sortedHits, size_t thread_id) = 0;
+    // return re-ranked hits to the threads owning them
+    virtual Hits complete_second_phase(const TaggedHits &my_results, size_t thread_id) = 0;
     virtual ~IMatchLoopCommunicator() {}
 };
 
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/searchlib/queryeval/searchable.h>
+#include <vespa/searchlib/common/serialnum.h>
 
 #include <memory>
 
@@ -56,6 +57,15 @@ public:
      **/
     virtual uint32_t getDocIdLimit() = 0;
 
+    /**
+     * Obtain the serial number of the last operation reflected in
+     * the index fields searchable. Used to detect index changes
+     * between queries.
+     *
+     * @return index serial number
+     **/
+    virtual search::SerialNum getIndexSerialNum() = 0;
+
     /**
      * Deleting the context will trigger cleanup in the
      * implementation.
@@ -2,6 +2,7 @@
 
 #include "match_loop_communicator.h"
 #include <vespa/vespalib/util/priority_queue.h>
+#include <cassert>
 
 namespace proton {
 namespace matching {
@@ -9,7 +10,9 @@ namespace matching {
 MatchLoopCommunicator::MatchLoopCommunicator(size_t threads, size_t topN)
     : _estimate_match_frequency(threads),
       _selectBest(threads, topN),
-      _rangeCover(threads)
+      _rangeCover(threads),
+      _get_second_phase_work(threads, topN),
+      _complete_second_phase(threads)
 {}
 MatchLoopCommunicator::~MatchLoopCommunicator() {}
 
@@ -49,6 +52,59 @@ MatchLoopCommunicator::SelectBest::mingle()
     }
 }
 
+namespace {
+
+struct BestHitCmp {
+    const std::vector<const IMatchLoopCommunicator::Hits *> &hits;
+    const std::vector<size_t> &pos;
+    BestHitCmp(const std::vector<const IMatchLoopCommunicator::Hits *> &hits_in,
+               const std::vector<size_t> &pos_in)
+        : hits(hits_in), pos(pos_in) {}
+    bool operator()(const uint32_t &a, const uint32_t &b) const {
+        return ((*hits[a])[pos[a]].second > (*hits[b])[pos[b]].second);
+    }
+};
+
+}
+
+void
+MatchLoopCommunicator::GetSecondPhaseWork::mingle()
+{
+    std::vector<const Hits *> hits(size());
+    std::vector<size_t> pos(size(), 0);
+    vespalib::PriorityQueue<uint32_t, BestHitCmp> queue(BestHitCmp(hits, pos));
+    for (size_t i = 0; i < size(); ++i) {
+        hits[i] = in(i).first;
+        if (!hits[i]->empty()) {
+            queue.push(i);
+        }
+    }
+    for (size_t picked = 0; picked < topN && !queue.empty(); ++picked) {
+        uint32_t i = queue.front();
+        out(picked % size()).emplace_back((*hits[i])[pos[i]], in(i).second);
+        if (hits[i]->size() > ++pos[i]) {
+            queue.adjust();
+        } else {
+            queue.pop_front();
+        }
+    }
+}
+
+void
+MatchLoopCommunicator::CompleteSecondPhase::mingle()
+{
+    std::vector<size_t> owner(size());
+    for (size_t i = 0; i < size(); ++i) {
+        assert(in(i).second < size());
+        owner[in(i).second] = i;
+    }
+    for (size_t i = 0; i < size(); ++i) {
+        for (const auto &hit : *in(i).first) {
+            out(owner[hit.second]).push_back(hit.first);
+        }
+    }
+}
+
 void
 MatchLoopCommunicator::RangeCover::mingle()
 {
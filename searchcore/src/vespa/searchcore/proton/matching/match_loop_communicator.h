@@ -37,9 +37,22 @@ private:
             : vespalib::Rendezvous<RangePair, RangePair>(n) {}
         virtual void mingle() override;
     };
+    struct GetSecondPhaseWork : vespalib::Rendezvous<std::pair<const Hits *, size_t>, TaggedHits> {
+        size_t topN;
+        GetSecondPhaseWork(size_t n, size_t topN_in)
+            : vespalib::Rendezvous<std::pair<const Hits *, size_t>, TaggedHits>(n), topN(topN_in) {}
+        virtual void mingle() override;
+    };
+    struct CompleteSecondPhase : vespalib::Rendezvous<std::pair<const TaggedHits *, size_t>, Hits> {
+        CompleteSecondPhase(size_t n)
+            : vespalib::Rendezvous<std::pair<const TaggedHits *, size_t>, Hits>(n) {}
+        virtual void mingle() override;
+    };
     EstimateMatchFrequency _estimate_match_frequency;
     SelectBest             _selectBest;
     RangeCover             _rangeCover;
+    GetSecondPhaseWork     _get_second_phase_work;
+    CompleteSecondPhase    _complete_second_phase;
 
 public:
     MatchLoopCommunicator(size_t threads, size_t topN);
@@ -54,6 +67,12 @@ public:
     virtual RangePair rangeCover(const RangePair &ranges) override {
         return _rangeCover.rendezvous(ranges);
     }
+    virtual TaggedHits get_second_phase_work(const Hits &sortedHits, size_t thread_id) override {
+        return _get_second_phase_work.rendezvous(std::make_pair(&sortedHits, thread_id));
+    }
+    virtual Hits complete_second_phase(const TaggedHits &my_results, size_t thread_id) override {
+        return _complete_second_phase.rendezvous(std::make_pair(&my_results, thread_id));
+    }
 };
 
 } // namespace matching
@@ -36,12 +36,23 @@ struct TimedMatchLoopCommunicator : IMatchLoopCommunicator {
         rerank_time.stop();
         return result;
     }
+    virtual TaggedHits get_second_phase_work(const Hits &sortedHits, size_t thread_id) override {
+        TaggedHits result = communicator.get_second_phase_work(sortedHits, thread_id);
+        rerank_time.start();
+        return result;
+    }
+    virtual Hits complete_second_phase(const TaggedHits &my_results, size_t thread_id) override {
+        return communicator.complete_second_phase(my_results, thread_id);
+    }
 };
 
 DocidRangeScheduler::UP
-createScheduler(uint32_t numThreads, uint32_t numSearchPartitions, uint32_t numDocs)
+createScheduler(uint32_t numThreads, uint32_t numSearchPartitions, bool useWorkStealing, uint32_t numDocs)
 {
     if (numSearchPartitions == 0) {
+        if (useWorkStealing) {
+            return std::make_unique<WorkStealingDocidRangeScheduler>(numThreads, 1, numDocs);
+        }
         return std::make_unique<AdaptiveDocidRangeScheduler>(numThreads, 1, numDocs);
     }
     if (numSearchPartitions <= numThreads) {
@@ -58,14 +69,17 @@ MatchMaster::match(const MatchParams &params,
                    const MatchToolsFactory &matchToolsFactory,
                    ResultProcessor &resultProcessor,
                    uint32_t distributionKey,
-                   uint32_t numSearchPartitions)
+                   uint32_t numSearchPartitions,
+                   bool useWorkStealing,
+                   vespalib::SpanTrace *spanTrace)
 {
     fastos::StopWatch query_latency_time;
     query_latency_time.start();
     vespalib::DualMergeDirector mergeDirector(threadBundle.size());
     MatchLoopCommunicator communicator(threadBundle.size(), params.heapSize);
     TimedMatchLoopCommunicator timedCommunicator(communicator);
-    DocidRangeScheduler::UP scheduler = createScheduler(threadBundle.size(), numSearchPartitions, params.numDocs);
+    DocidRangeScheduler::UP scheduler = createScheduler(threadBundle.size(), numSearchPartitions,
+                                                        useWorkStealing, params.numDocs);
 
     std::vector<MatchThread::UP> threadState;
     std::vector<vespalib::Runnable*> targets;
@@ -76,12 +90,16 @@ MatchMaster::match(const MatchParams &params,
             static_cast<IMatchLoopCommunicator&>(communicator);
         threadState.emplace_back(std::make_unique<MatchThread>(i, threadBundle.size(),
                         params, matchToolsFactory, com, *scheduler,
-                        resultProcessor, mergeDirector, distributionKey));
+                        resultProcessor, mergeDirector, distributionKey, spanTrace));
         targets.push_back(threadState.back().get());
     }
     resultProcessor.prepareThreadContextCreation(threadBundle.size());
     threadBundle.run(targets);
-    ResultProcessor::Result::UP reply = resultProcessor.makeReply(threadState[0]->extract_result());
+    ResultProcessor::Result::UP reply;
+    {
+        vespalib::SpanTrace::Scope makeReplySpan(spanTrace, "make_reply");
+        reply = resultProcessor.makeReply(threadState[0]->extract_result());
+    }
     query_latency_time.stop();
     double query_time_s = query_latency_time.elapsed().sec();
     double rerank_time_s = timedCommunicator.rerank_time.elapsed().sec();
@@ -5,7 +5,7 @@
 #include "result_processor.h"
 #include "matching_stats.h"
 
-namespace vespalib { class ThreadBundle; }
+namespace vespalib { class ThreadBundle; class SpanTrace; }
 namespace search { class FeatureSet; }
 
 namespace proton {
@@ -29,7 +29,9 @@ public:
                                       const MatchToolsFactory &matchToolsFactory,
                                       ResultProcessor &resultProcessor,
                                       uint32_t distributionKey,
-                                      uint32_t numSearchPartitions);
+                                      uint32_t numSearchPartitions,
+                                      bool useWorkStealing,
+                                      vespalib::SpanTrace *spanTrace = nullptr);
 
     static std::shared_ptr<search::FeatureSet>
     getFeatureSet(const MatchToolsFactory &matchToolsFactory,
@@ -2,6 +2,7 @@
 
 #include "match_phase_limiter.h"
 #include <vespa/searchlib/queryeval/andsearchstrict.h>
+#include <vespa/searchlib/queryeval/emptysearch.h>
 #include <vespa/log/log.h>
 
 LOG_SETUP(".proton.matching.match_phase_limiter");
@@ -11,6 +12,7 @@ using search::queryeval::Searchable;
 using search::queryeval::IRequestContext;
 using search::queryeval::AndSearchStrict;
 using search::queryeval::NoUnpack;
+using search::queryeval::EmptySearch;
 
 namespace proton {
 namespace matching {
@@ -145,5 +147,37 @@ MatchPhaseLimiter::getDocIdSpaceEstimate() const
     return _coverage.getEstimate();
 }
 
+EarlyTerminationLimiter::EarlyTerminationLimiter(size_t wanted_hits)
+    : _wantedHits(wanted_hits),
+      _wasLimited(false),
+      _searched(0)
+{
+}
+
+size_t
+EarlyTerminationLimiter::sample_hits_per_thread(size_t num_threads) const
+{
+    return std::max(size_t(1), (_wantedHits + num_threads - 1) / num_threads);
+}
+
+SearchIterator::UP
+EarlyTerminationLimiter::maybe_limit(SearchIterator::UP search, double, size_t)
+{
+    uint32_t current_id = search->getDocId();
+    uint32_t end_id = search->getEndId();
+    LOG(debug, "Terminating match phase early at docid=%u, end_docid=%u", current_id, end_id);
+    _wasLimited = true;
+    search.reset(new EmptySearch());
+    search->initRange(current_id + 1, end_id);
+    return search;
+}
+
+void
+EarlyTerminationLimiter::updateDocIdSpaceEstimate(size_t searchedDocIdSpace, size_t)
+{
+    // the remaining docid space is never searched after early termination
+    _searched += searchedDocIdSpace;
+}
+
 } // namespace proton::matching
 } // namespace proton
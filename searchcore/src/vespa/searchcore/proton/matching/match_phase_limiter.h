@@ -69,6 +69,29 @@ struct NoMatchPhaseLimiter : MaybeMatchPhaseLimiter {
     size_t getDocIdSpaceEstimate() const override { return std::numeric_limits<size_t>::max(); }
 };
 
+/**
+ * This class is used when early termination is configured. Each match
+ * thread stops matching after collecting its share of the wanted
+ * hits. Matching is done in docid order, so the hits returned are the
+ * best ones only when the lid space is ordered by document quality.
+ **/
+class EarlyTerminationLimiter : public MaybeMatchPhaseLimiter
+{
+private:
+    const size_t        _wantedHits;
+    std::atomic<bool>   _wasLimited;
+    std::atomic<size_t> _searched;
+
+public:
+    EarlyTerminationLimiter(size_t wanted_hits);
+    bool is_enabled() const override { return true; }
+    bool was_limited() const override { return _wasLimited; }
+    size_t sample_hits_per_thread(size_t num_threads) const override;
+    SearchIterator::UP maybe_limit(SearchIterator::UP search, double match_freq, size_t num_docs) override;
+    void updateDocIdSpaceEstimate(size_t searchedDocIdSpace, size_t remainingDocIdSpace) override;
+    size_t getDocIdSpaceEstimate() const override { return _searched; }
+};
+
 /**
  * This class is is used when rank phase limiting is configured.
  **/
@@ -69,19 +69,28 @@ LazyValue get_score_feature(const RankProgram &rankProgram) {
 //-----------------------------------------------------------------------------
 
 MatchThread::Context::Context(double rankDropLimit, MatchTools &tools, HitCollector &hits,
-                              uint32_t num_threads)
+                              uint32_t num_threads, FastS_SortKeyFilter *sortKeyFilter)
     : matches(0),
+      skipped(0),
       _matches_limit(tools.match_limiter().sample_hits_per_thread(num_threads)),
       _score_feature(get_score_feature(tools.rank_program())),
+      _eager_program(),
       _ranking(tools.rank_program()),
       _rankDropLimit(rankDropLimit),
       _hits(hits),
-      _softDoom(tools.getSoftDoom())
+      _softDoom(tools.getSoftDoom()),
+      _sortKeyFilter(sortKeyFilter)
 {
+    if (tools.use_eager_ranking()) {
+        _eager_program = tools.rank_program().get_seed_executors();
+    }
 }
 
 void
 MatchThread::Context::rankHit(uint32_t docId) {
+    for (FeatureExecutor *executor: _eager_program) {
+        executor->eager_execute(docId);
+    }
     double score = _score_feature.as_number(docId);
     // convert NaN and Inf scores to -Inf
     if (__builtin_expect(std::isnan(score) || std::isinf(score), false)) {
@@ -172,7 +181,7 @@ void
 MatchThread::match_loop(MatchTools &tools, HitCollector &hits)
 {
     bool softDoomed = false;
-    Context context(matchParams.rankDropLimit, tools, hits, num_threads);
+    Context context(matchParams.rankDropLimit, tools, hits, num_threads, sort_key_filter.get());
     for (DocidRange docid_range = scheduler.first_range(thread_id);
          !docid_range.empty() && ! softDoomed;
          docid_range = scheduler.next_range(thread_id))
@@ -180,6 +189,7 @@ MatchThread::match_loop(MatchTools &tools, HitCollector &hits)
         softDoomed = inner_match_loop<Strategy, do_rank, do_limit, do_share_work>(context, tools, docid_range);
     }
     uint32_t matches = context.matches;
+    skipped_hits += context.skipped;
     if (do_limit && context.isBelowLimit()) {
         const size_t searchedSoFar = scheduler.total_size(thread_id);
         LOG(debug, "Limit not reached (had %d) at docid=%d which is after %zu docs.",
@@ -241,6 +251,19 @@ MatchThread::match_loop_helper(MatchTools &tools, HitCollector &hits)
 
 //-----------------------------------------------------------------------------
 
+void
+MatchThread::setupSortKeyFilter(const ResultProcessor::Context &context)
+{
+    // Hits can only be skipped while matching when all of them are sorted on attribute values and nothing
+    // else needs them.
+    uint32_t ntop = matchParams.offset + matchParams.hits;
+    if (!match_with_ranking && (ntop > 0) && context.sort->hasSortData() && !context.grouping &&
+        context.sort->sortSpec.hasFixedWidthPrefix())
+    {
+        sort_key_filter = std::make_unique<FastS_SortKeyFilter>(context.sort->sortSpec, ntop);
+    }
+}
+
 search::ResultSet::UP
 MatchThread::findMatches(MatchTools &tools)
 {
@@ -253,9 +276,31 @@ MatchThread::findMatches(MatchTools &tools)
         LOG(debug, "SearchIterator after MultiBitVectorIteratorBase::optimize(): %s", tools.search().asString().c_str());
     }
     HitCollector hits(matchParams.numDocs, matchParams.arraySize, matchParams.heapSize);
-    match_loop_helper(tools, hits);
+    {
+        vespalib::SpanTrace::Scope firstPhaseSpan(span_trace, "first_phase", thread_id);
+        match_loop_helper(tools, hits);
+    }
     if (tools.has_second_phase_rank()) {
-        { // 2nd phase ranking
+        vespalib::SpanTrace::Scope secondPhaseSpan(span_trace, "second_phase", thread_id);
+        if (tools.use_balanced_second_phase()) { // 2nd phase ranking, balanced across threads
+            tools.setup_second_phase();
+            // hits to re-rank may come from any thread
+            tools.search().initRange(1, matchParams.numDocs);
+            auto sorted_hits = hits.getSortedHeapHits();
+            WaitTimer get_work_timer(wait_time_s);
+            auto my_work = communicator.get_second_phase_work(sorted_hits, thread_id);
+            get_work_timer.done();
+            if (tools.getHardDoom().doom()) {
+                my_work.clear();
+            }
+            DocumentScorer scorer(tools.rank_program(), tools.search());
+            scorer.score(my_work, tools.match_data());
+            thread_stats.docsReRanked(my_work.size());
+            WaitTimer complete_timer(wait_time_s);
+            auto my_results = communicator.complete_second_phase(my_work, thread_id);
+            complete_timer.done();
+            hits.setReRankedHits(std::move(my_results));
+        } else { // 2nd phase ranking
             tools.setup_second_phase();
             DocidRange docid_range = scheduler.total_span(thread_id);
             tools.search().initRange(docid_range.begin, docid_range.end);
@@ -302,7 +347,11 @@ MatchThread::processResult(const Doom & hardDoom,
         man.groupUnordered(hits, numHits, bits);
     }
     if (hardDoom.doom()) return;
-    size_t sortLimit = hasGrouping ? numHits : context.result->maxSize();
+    size_t sortLimit = context.result->maxSize();
+    if (hasGrouping) {
+        search::grouping::GroupingManager man(*context.grouping);
+        sortLimit = std::max(sortLimit, man.getRelevanceOrderLimit(numHits));
+    }
     context.sort->sorter->sortResults(hits, numHits, sortLimit);
     if (hardDoom.doom()) return;
     if (hasGrouping) {
@@ -311,7 +360,7 @@ MatchThread::processResult(const Doom & hardDoom,
     }
     if (hardDoom.doom()) return;
     PartialResult &pr = *context.result;
-    pr.totalHits(totalHits);
+    pr.totalHits(totalHits + skipped_hits);
     size_t maxHits = std::min(numHits, pr.maxSize());
     if (pr.hasSortData()) {
         FastS_SortSpec &spec = context.sort->sortSpec;
@@ -346,7 +395,8 @@ MatchThread::MatchThread(size_t thread_id_in,
                          DocidRangeScheduler &sched,
                          ResultProcessor &rp,
                          vespalib::DualMergeDirector &md,
-                         uint32_t distributionKey) :
+                         uint32_t distributionKey,
+                         vespalib::SpanTrace *spanTrace) :
     thread_id(thread_id_in),
     num_threads(num_threads_in),
     matchParams(mp),
@@ -362,22 +412,27 @@ MatchThread::MatchThread(size_t thread_id_in,
     total_time_s(0.0),
     match_time_s(0.0),
     wait_time_s(0.0),
-    match_with_ranking(mtf.has_first_phase_rank() && mp.save_rank_scores())
+    match_with_ranking(mtf.has_first_phase_rank() && mp.save_rank_scores()),
+    sort_key_filter(),
+    skipped_hits(0),
+    span_trace(spanTrace)
 {
 }
 
 void
 MatchThread::run()
 {
+    vespalib::SpanTrace::Scope threadSpan(span_trace, "match_thread", thread_id);
     fastos::StopWatch total_time;
     fastos::StopWatch match_time;
     total_time.start();
     match_time.start();
     MatchTools::UP matchTools = matchToolsFactory.createMatchTools();
+    resultContext = resultProcessor.createThreadContext(matchTools->getHardDoom(), thread_id, _distributionKey);
+    setupSortKeyFilter(*resultContext);
     search::ResultSet::UP result = findMatches(*matchTools);
     match_time.stop();
     match_time_s = match_time.elapsed().sec();
-    resultContext = resultProcessor.createThreadContext(matchTools->getHardDoom(), thread_id, _distributionKey);
     {
         WaitTimer get_token_timer(wait_time_s);
         QueryLimiter::Token::UP processToken(
@@ -387,11 +442,13 @@ MatchThread::run()
                         resultContext->sort->hasSortData(),
                         resultContext->grouping.get() != 0));
         get_token_timer.done();
+        vespalib::SpanTrace::Scope processSpan(span_trace, "process_result", thread_id);
         processResult(matchTools->getHardDoom(), std::move(result), *resultContext);
     }
     total_time.stop();
     total_time_s = total_time.elapsed().sec();
     thread_stats.active_time(total_time_s - wait_time_s).wait_time(wait_time_s);
+    vespalib::SpanTrace::Scope mergeSpan(span_trace, "merge", thread_id);
     mergeDirector.dualMerge(thread_id, *resultContext->result, resultContext->groupingSource);
 }
 
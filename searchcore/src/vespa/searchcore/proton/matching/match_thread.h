@@ -11,6 +11,7 @@
 #include "docid_range_scheduler.h"
 #include <vespa/vespalib/util/runnable.h>
 #include <vespa/vespalib/util/dual_merge_director.h>
+#include <vespa/vespalib/trace/span_trace.h>
 #include <vespa/searchlib/common/resultset.h>
 #include <vespa/searchlib/common/sortresults.h>
 #include <vespa/searchlib/queryeval/hitcollector.h>
@@ -29,6 +30,7 @@ public:
     using HitCollector = search::queryeval::HitCollector;
     using RankProgram = search::fef::RankProgram;
     using LazyValue = search::fef::LazyValue;
+    using FeatureExecutor = search::fef::FeatureExecutor;
     using Doom = vespalib::Doom;
 
 private:
@@ -48,24 +50,36 @@ private:
     double                        match_time_s;
     double                        wait_time_s;
     bool                          match_with_ranking;
+    std::unique_ptr<FastS_SortKeyFilter> sort_key_filter;
+    uint32_t                      skipped_hits;
+    vespalib::SpanTrace          *span_trace;
 
     class Context {
     public:
         Context(double rankDropLimit, MatchTools &tools, HitCollector &hits,
-                uint32_t num_threads) __attribute__((noinline));
+                uint32_t num_threads, FastS_SortKeyFilter *sortKeyFilter) __attribute__((noinline));
         void rankHit(uint32_t docId);
-        void addHit(uint32_t docId) { _hits.addHit(docId, search::zero_rank_value); }
+        void addHit(uint32_t docId) {
+            if ((_sortKeyFilter == nullptr) || _sortKeyFilter->accept(docId)) {
+                _hits.addHit(docId, search::zero_rank_value);
+            } else {
+                ++skipped;
+            }
+        }
         bool isBelowLimit() const { return matches < _matches_limit; }
         bool    isAtLimit() const { return matches == _matches_limit; }
         bool   atSoftDoom() const { return _softDoom.doom(); }
         uint32_t                 matches;
+        uint32_t                 skipped;
     private:
         uint32_t                 _matches_limit;
         LazyValue                _score_feature;
+        std::vector<FeatureExecutor *> _eager_program;
         RankProgram             &_ranking;
         double                   _rankDropLimit;
         HitCollector            &_hits;
         const Doom              &_softDoom;
+        FastS_SortKeyFilter     *_sortKeyFilter;
     };
 
     double estimate_match_frequency(uint32_t matches, uint32_t searchedSoFar) __attribute__((noinline));
@@ -85,6 +99,7 @@ private:
     template <bool do_rank> void match_loop_helper_rank(MatchTools &tools, HitCollector &hits);
     void match_loop_helper(MatchTools &tools, HitCollector &hits);
 
+    void setupSortKeyFilter(const ResultProcessor::Context &context);
     search::ResultSet::UP findMatches(MatchTools &tools);
 
     void processResult(const Doom & hardDoom, search::ResultSet::UP result, ResultProcessor::Context &context);
@@ -102,7 +117,8 @@ public:
                 DocidRangeScheduler &sched,
                 ResultProcessor &rp,
                 vespalib::DualMergeDirector &md,
-                uint32_t distributionKey);
+                uint32_t distributionKey,
+                vespalib::SpanTrace *spanTrace = nullptr);
     virtual void run() override;
     const MatchingStats::Partition &get_thread_stats() const { return thread_stats; }
     double get_match_time() const { return match_time_s; }
@@ -50,7 +50,7 @@ MatchTools::setup(search::fef::RankProgram::UP rank_program, double termwise_lim
     HandleRecorder recorder;
     {
         HandleRecorder::Binder bind(recorder);
-        _rank_program->setup(*_match_data, _queryEnv, _featureOverrides);
+        _rank_program->setup(*_match_data, _queryEnv, _featureOverrides, _feature_profiler.get());
     }
     bool can_reuse_search = (_search && !_search_has_changed &&
                              contains_all(_used_handles, recorder.getHandles()));
@@ -71,7 +71,8 @@ MatchTools::MatchTools(QueryLimiter & queryLimiter,
                        const QueryEnvironment & queryEnv,
                        const MatchDataLayout & mdl,
                        const RankSetup & rankSetup,
-                       const Properties & featureOverrides)
+                       const Properties & featureOverrides,
+                       std::shared_ptr<SampledQueryLog> profile_sink)
     : _queryLimiter(queryLimiter),
       _softDoom(softDoom),
       _hardDoom(hardDoom),
@@ -81,15 +82,35 @@ MatchTools::MatchTools(QueryLimiter & queryLimiter,
       _rankSetup(rankSetup),
       _featureOverrides(featureOverrides),
       _match_data(mdl.createMatchData()),
+      _profile_sink(std::move(profile_sink)),
+      _feature_profiler(),
       _rank_program(),
       _search(),
       _used_handles(),
       _search_has_changed(false)
 {
+    if (_profile_sink) {
+        _feature_profiler = std::make_unique<search::fef::FeatureProfiler>();
+    }
 }
 
 MatchTools::~MatchTools()
 {
+    if (_feature_profiler && !_feature_profiler->empty()) {
+        _profile_sink->addFeatureProfile(*_feature_profiler);
+    }
+}
+
+bool
+MatchTools::use_eager_ranking() const
+{
+    return EagerRanking::lookup(_queryEnv.getProperties(), _rankSetup.getUseEagerRanking());
+}
+
+bool
+MatchTools::use_balanced_second_phase() const
+{
+    return BalancedSecondPhase::lookup(_queryEnv.getProperties(), _rankSetup.getUseBalancedSecondPhase());
 }
 
 void
@@ -133,7 +154,8 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
                   const IIndexEnvironment    & indexEnv,
                   const RankSetup            & rankSetup,
                   const Properties           & rankProperties,
-                  const Properties           & featureOverrides)
+                  const Properties           & featureOverrides,
+                  FilterCache                * filterCache)
     : _queryLimiter(queryLimiter),
       _requestContext(softDoom, attributeContext),
       _hardDoom(hardDoom),
@@ -142,13 +164,17 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
       _queryEnv(indexEnv, attributeContext, rankProperties),
       _mdl(),
       _rankSetup(rankSetup),
-      _featureOverrides(featureOverrides)
+      _featureOverrides(featureOverrides),
+      _profile_sink()
 {
     _valid = _query.buildTree(queryStack, location, viewResolver, indexEnv);
     if (_valid) {
         _query.extractTerms(_queryEnv.terms());
         _query.extractLocations(_queryEnv.locations());
         _query.setBlackListBlueprint(metaStore.createBlackListBlueprint());
+        if (filterCache != nullptr) {
+            _query.setFilterCache(*filterCache);
+        }
         _query.reserveHandles(_requestContext, searchContext, _mdl);
         _query.optimize();
         _query.fetchPostings();
@@ -164,6 +190,7 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
         uint32_t diversity_min_groups = DiversityMinGroups::lookup(rankProperties);
         double diversity_cutoff_factor = DiversityCutoffFactor::lookup(rankProperties);
         vespalib::string diversity_cutoff_strategy = DiversityCutoffStrategy::lookup(rankProperties);
+        uint32_t early_termination_hits = EarlyTerminationHits::lookup(rankProperties, _rankSetup.getEarlyTerminationHits());
         if (!limit_attribute.empty() && limit_maxhits > 0) {
             _match_limiter.reset(new MatchPhaseLimiter(metaStore.getCommittedDocIdLimit(), searchContext.getAttributes(), _requestContext,
                             limit_attribute, limit_maxhits, !limit_ascending, limit_max_filter_coverage,
@@ -179,6 +206,8 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
                             _rankSetup.getDiversityAttribute(), _rankSetup.getDiversityMinGroups(),
                             _rankSetup.getDiversityCutoffFactor(),
                             AttributeLimiter::toDiversityCutoffStrategy(_rankSetup.getDiversityCutoffStrategy())));
+        } else if (early_termination_hits > 0) {
+            _match_limiter.reset(new EarlyTerminationLimiter(early_termination_hits));
         }
     }
     if (_match_limiter.get() == nullptr) {
@@ -194,7 +223,7 @@ MatchToolsFactory::createMatchTools() const
     assert(_valid);
     return MatchTools::UP(
             new MatchTools(_queryLimiter, _requestContext.getSoftDoom(), _hardDoom, _query, *_match_limiter, _queryEnv,
-                           _mdl, _rankSetup, _featureOverrides));
+                           _mdl, _rankSetup, _featureOverrides, _profile_sink));
 }
 
 }
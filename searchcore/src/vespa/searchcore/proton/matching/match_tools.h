@@ -11,6 +11,7 @@
 #include "match_phase_limiter.h"
 #include "handlerecorder.h"
 #include "requestcontext.h"
+#include "sampled_query_log.h"
 
 #include <vespa/vespalib/util/clock.h>
 #include <vespa/searchlib/queryeval/blueprint.h>
@@ -32,6 +33,8 @@ private:
     const search::fef::RankSetup          &_rankSetup;
     const search::fef::Properties         &_featureOverrides;
     search::fef::MatchData::UP             _match_data;
+    std::shared_ptr<SampledQueryLog>       _profile_sink;
+    std::unique_ptr<search::fef::FeatureProfiler> _feature_profiler;
     search::fef::RankProgram::UP           _rank_program;
     search::queryeval::SearchIterator::UP  _search;
     HandleRecorder::HandleSet              _used_handles;
@@ -49,14 +52,18 @@ public:
                const QueryEnvironment &queryEnv,
                const search::fef::MatchDataLayout &mdl,
                const search::fef::RankSetup &rankSetup,
-               const search::fef::Properties &featureOverrides);
+               const search::fef::Properties &featureOverrides,
+               std::shared_ptr<SampledQueryLog> profile_sink = std::shared_ptr<SampledQueryLog>());
     ~MatchTools();
     const vespalib::Doom &getSoftDoom() const { return _softDoom; }
     const vespalib::Doom &getHardDoom() const { return _hardDoom; }
     QueryLimiter & getQueryLimiter() { return _queryLimiter; }
     MaybeMatchPhaseLimiter &match_limiter() { return _match_limiter; }
     bool has_second_phase_rank() const { return !_rankSetup.getSecondPhaseRank().empty(); }
+    bool use_eager_ranking() const;
+    bool use_balanced_second_phase() const;
     const search::fef::MatchData &match_data() const { return *_match_data; }
+    search::fef::MatchData &match_data() { return *_match_data; }
     search::fef::RankProgram &rank_program() { return *_rank_program; }
     search::queryeval::SearchIterator &search() { return *_search; }
     search::queryeval::SearchIterator::UP borrow_search() { return std::move(_search); }
@@ -80,6 +87,7 @@ private:
     search::fef::MatchDataLayout    _mdl;
     const search::fef::RankSetup  & _rankSetup;
     const search::fef::Properties & _featureOverrides;
+    std::shared_ptr<SampledQueryLog> _profile_sink;
     bool                            _valid;
 public:
     typedef std::unique_ptr<MatchToolsFactory> UP;
@@ -96,12 +104,19 @@ public:
                       const search::fef::IIndexEnvironment &indexEnv,
                       const search::fef::RankSetup &rankSetup,
                       const search::fef::Properties &rankProperties,
-                      const search::fef::Properties &featureOverrides);
+                      const search::fef::Properties &featureOverrides,
+                      FilterCache *filterCache);
     ~MatchToolsFactory();
     bool valid() const { return _valid; }
     const MaybeMatchPhaseLimiter &match_limiter() const { return *_match_limiter; }
     MatchTools::UP createMatchTools() const;
+    /**
+     * Let all match tools created after this call profile their rank
+     * programs and report the result to the given log.
+     **/
+    void profile_features(std::shared_ptr<SampledQueryLog> sink) { _profile_sink = std::move(sink); }
     search::queryeval::Blueprint::HitEstimate estimate() const { return _query.estimate(); }
+    vespalib::string describe_query() const { return _query.describe(); }
     bool has_first_phase_rank() const { return !_rankSetup.getFirstPhaseRank().empty(); }
 };
 
@@ -14,6 +14,9 @@
 #include <vespa/searchlib/engine/searchreply.h>
 #include <vespa/searchlib/features/setup.h>
 #include <vespa/searchlib/fef/test/plugin/setup.h>
+#include <vespa/vespalib/stllike/asciistream.h>
+#include <vespa/vespalib/trace/span_trace.h>
+#include <vespa/searchlib/common/mapnames.h>
 #include <cmath>
 
 #include <vespa/log/log.h>
@@ -27,6 +30,7 @@ using search::DocumentMetaData;
 using search::LidUsageStats;
 using search::FeatureSet;
 using search::attribute::IAttributeContext;
+using search::attribute::IAttributeVector;
 using search::fef::MatchDataLayout;
 using search::fef::MatchData;
 using search::queryeval::Blueprint;
@@ -42,6 +46,7 @@ struct StupidMetaStore : search::IDocumentMetaStore {
     bool getGid(DocId, GlobalId &) const override { return false; }
     bool getGidEvenIfMoved(DocId, GlobalId &) const override { return false; }
     bool getLid(const GlobalId &, DocId &) const override { return false; }
+    void getLids(const std::vector<GlobalId> &gids, std::vector<DocId> &lids) const override { lids.assign(gids.size(), 0); }
     DocumentMetaData getMetaData(const GlobalId &) const override { return DocumentMetaData(); }
     void getMetaData(const BucketId &, DocumentMetaData::Vector &) const override { }
     DocId getCommittedDocIdLimit() const override { return 1; }
@@ -64,31 +69,54 @@ FeatureSet::SP findFeatureSet(const DocsumRequest &req,
     return MatchMaster::getFeatureSet(mtf, docs, summaryFeatures);
 }
 
+// Span tracing is requested per query with the trace property 'spans=true'.
+std::unique_ptr<vespalib::SpanTrace>
+createSpanTrace(const SearchRequest &request)
+{
+    search::fef::Property spans = request.propertiesMap.traceProperties().lookup("spans");
+    if (!spans.found() || (spans.get() != "true")) {
+        return std::unique_ptr<vespalib::SpanTrace>();
+    }
+    auto trace = std::make_unique<vespalib::SpanTrace>(request.getReceiveTime());
+    trace->addSpan("queue", 0, request.getReceiveTime(), vespalib::SpanTrace::clock::now());
+    return trace;
+}
+
+// number of profiled queries kept by each matcher
+constexpr size_t MAX_SAMPLED_QUERIES = 16;
+
 size_t numThreads(size_t hits, size_t minHits) {
     return static_cast<size_t>(std::ceil(double(hits) / double(minHits)));
 }
 
-class LimitedThreadBundleWrapper final : public vespalib::ThreadBundle
-{
-public:
-    LimitedThreadBundleWrapper(vespalib::ThreadBundle &threadBundle, uint32_t maxThreads) :
-        _threadBundle(threadBundle),
-        _maxThreads(std::min(maxThreads, static_cast<uint32_t>(threadBundle.size())))
-    { }
-private:
-    size_t size() const override { return _maxThreads; }
-    void run(const std::vector<vespalib::Runnable*> &targets) override {
-        _threadBundle.run(targets);
-    }
-    vespalib::ThreadBundle &_threadBundle;
-    const uint32_t          _maxThreads;
-};
-
 bool willNotNeedRanking(const SearchRequest & request, const GroupingContext & groupingContext) {
     return (!groupingContext.needRanking() && (request.maxhits == 0))
            || (!request.sortSpec.empty() && (request.sortSpec.find("[rank]") == vespalib::string::npos));
 }
 
+/**
+ * Describe the content searched by a query, as needed to validate
+ * cached results. Returns an empty token if some of the content is
+ * not tracked.
+ */
+vespalib::string
+makeResultCacheToken(ISearchContext &searchContext, const IAttributeContext &attrContext,
+                     const search::IDocumentMetaStore &metaStore)
+{
+    vespalib::asciistream os;
+    os << searchContext.getDocIdLimit() << ";" << metaStore.getCurrentGeneration()
+       << ";" << searchContext.getIndexSerialNum();
+    std::vector<const IAttributeVector *> attributes;
+    attrContext.getAttributeList(attributes);
+    for (const IAttributeVector *attr: attributes) {
+        if (attr->getContentGeneration() == IAttributeVector::UNTRACKED_GENERATION) {
+            return vespalib::string();
+        }
+        os << ";" << attr->getName() << "=" << attr->getContentGeneration();
+    }
+    return os.str();
+}
+
 }  // namespace proton::matching::<unnamed>
 
 FeatureSet::SP
@@ -138,7 +166,10 @@ Matcher::Matcher(const search::index::Schema &schema,
       _stats(),
       _clock(clock),
       _queryLimiter(queryLimiter),
-      _distributionKey(distributionKey)
+      _distributionKey(distributionKey),
+      _filterCache(),
+      _resultCache(),
+      _sampledQueries()
 {
     search::features::setup_search_features(_blueprintFactory);
     search::fef::test::setup_fef_test_plugin(_blueprintFactory);
@@ -147,6 +178,19 @@ Matcher::Matcher(const search::index::Schema &schema,
     if (!_rankSetup->compile()) {
         throw vespalib::IllegalArgumentException("failed to compile rank setup", VESPA_STRLOC);
     }
+    uint32_t filterCacheSize = FilterCacheSize::lookup(props);
+    if (filterCacheSize > 0) {
+        _filterCache = std::make_unique<FilterCache>(filterCacheSize);
+    }
+    uint32_t resultCacheSize = ResultCacheSize::lookup(props);
+    if (resultCacheSize > 0) {
+        double maxAge = ResultCacheMaxAge::lookup(props);
+        _resultCache = std::make_unique<ResultCache>(resultCacheSize, fastos::TimeStamp(fastos::TimeStamp::Seconds(maxAge)));
+    }
+    double querySampleFraction = QuerySampleFraction::lookup(props);
+    if (querySampleFraction > 0.0) {
+        _sampledQueries = std::make_shared<SampledQueryLog>(querySampleFraction, MAX_SAMPLED_QUERIES);
+    }
 }
 
 MatchingStats
@@ -181,7 +225,8 @@ Matcher::create_match_tools_factory(const search::engine::Request &request,
     return std::make_unique<MatchToolsFactory>(_queryLimiter, vespalib::Doom(_clock, safeDoom),
                                                vespalib::Doom(_clock, request.getTimeOfDoom()), searchContext,
                                                attrContext, request.getStackRef(), request.location, _viewResolver,
-                                               metaStore, _indexEnv, *_rankSetup, rankProperties, feature_overrides);
+                                               metaStore, _indexEnv, *_rankSetup, rankProperties, feature_overrides,
+                                               _filterCache.get());
 }
 
 SearchReply::UP
@@ -219,8 +264,11 @@ Matcher::match(const SearchRequest &request,
 {
     fastos::StopWatch total_matching_time;
     total_matching_time.start();
+    std::unique_ptr<vespalib::SpanTrace> spanTrace = createSpanTrace(request);
+    vespalib::SpanTrace::clock::time_point setupStart = vespalib::SpanTrace::clock::now();
     MatchingStats my_stats;
     SearchReply::UP reply = std::make_unique<SearchReply>();
+    std::unique_ptr<SampledQueryLog::Entry> sampledQuery;
     { // we want to measure full set-up and tear-down time as part of
       // collateral time
         GroupingContext groupingContext(_clock, request.getTimeOfDoom(),
@@ -228,6 +276,8 @@ Matcher::match(const SearchRequest &request,
         SessionId sessionId(&request.sessionId[0], request.sessionId.size());
         bool shouldCacheSearchSession = false;
         bool shouldCacheGroupingSession = false;
+        vespalib::string resultCacheKey;
+        vespalib::string resultCacheToken;
         if (!sessionId.empty()) {
             const Properties &cache_props = request.propertiesMap.cacheProperties();
             shouldCacheGroupingSession = cache_props.lookup("grouping").found();
@@ -239,6 +289,18 @@ Matcher::match(const SearchRequest &request,
                 }
             }
         }
+        if (_resultCache && sessionId.empty()) {
+            resultCacheKey = ResultCache::makeKey(request);
+            resultCacheToken = makeResultCacheToken(searchContext, attrContext, metaStore);
+            if (!resultCacheToken.empty()) {
+                SearchReply::UP cached = _resultCache->find(resultCacheKey, resultCacheToken, _clock.getTimeNS());
+                if (cached) {
+                    std::lock_guard<std::mutex> guard(_statsLock);
+                    _stats.add(MatchingStats().resultCacheHits(1));
+                    return cached;
+                }
+            }
+        }
         const Properties *feature_overrides = &request.propertiesMap.featureOverrides();
         if (shouldCacheSearchSession) {
             owned_objects.feature_overrides.reset(new Properties(*feature_overrides));
@@ -251,6 +313,20 @@ Matcher::match(const SearchRequest &request,
             reply->errorMessage = "query execution failed (invalid query)";
             return reply;
         }
+        QueryLimiter::Token::UP costToken = _queryLimiter.admit(
+                QueryLimiter::estimateCost(mtf->estimate().estHits, !_rankSetup->getSecondPhaseRank().empty()));
+        if (!costToken) {
+            reply->errorCode = ECODE_OVERLOADED;
+            reply->errorMessage = "query rejected (estimated cost exceeds the cost limit)";
+            std::lock_guard<std::mutex> guard(_statsLock);
+            _stats.add(MatchingStats().queriesRejected(1));
+            return reply;
+        }
+        if (_sampledQueries && _sampledQueries->sample()) {
+            sampledQuery = std::make_unique<SampledQueryLog::Entry>();
+            sampledQuery->blueprint = mtf->describe_query();
+            mtf->profile_features(_sampledQueries);
+        }
 
         MatchParams params(searchContext.getDocIdLimit(), _rankSetup->getHeapSize(), _rankSetup->getArraySize(),
                            _rankSetup->getRankScoreDropLimit(), request.offset, request.maxhits,
@@ -261,13 +337,24 @@ Matcher::match(const SearchRequest &request,
 
         const Properties & rankProperties = request.propertiesMap.rankProperties();
         size_t numThreadsPerSearch = computeNumThreadsPerSearch(mtf->estimate(), rankProperties);
-        LimitedThreadBundleWrapper limitedThreadBundle(threadBundle, numThreadsPerSearch);
+        vespalib::LimitedThreadBundleWrapper limitedThreadBundle(threadBundle, numThreadsPerSearch);
         MatchMaster master;
         uint32_t numSearchPartitions = NumSearchPartitions::lookup(rankProperties,
                                                                    _rankSetup->getNumSearchPartitions());
-        ResultProcessor::Result::UP result = master.match(params, limitedThreadBundle, *mtf, rp,
-                                                          _distributionKey, numSearchPartitions);
+        bool useWorkStealing = WorkStealing::lookup(rankProperties, _rankSetup->getUseWorkStealing());
+        if (spanTrace) {
+            spanTrace->addSpan("setup", 0, setupStart, vespalib::SpanTrace::clock::now());
+        }
+        ResultProcessor::Result::UP result;
+        {
+            vespalib::SpanTrace::Scope matchSpan(spanTrace.get(), "match");
+            result = master.match(params, limitedThreadBundle, *mtf, rp, _distributionKey,
+                                  numSearchPartitions, useWorkStealing, spanTrace.get());
+        }
         my_stats = MatchMaster::getStats(std::move(master));
+        if (!resultCacheToken.empty()) {
+            my_stats.resultCacheMisses(1);
+        }
 
         bool wasLimited = mtf->match_limiter().was_limited();
         size_t spaceEstimate = mtf->match_limiter().getDocIdSpaceEstimate();
@@ -309,9 +396,27 @@ Matcher::match(const SearchRequest &request,
         coverage.setCovered(covered);
         LOG(debug, "numThreadsPerSearch = %zu. Configured = %d, estimated hits=%d, totalHits=%ld",
             numThreadsPerSearch, _rankSetup->getNumThreadsPerSearch(), estHits, reply->totalHitCount);
+        if (!resultCacheToken.empty() && (reply->errorCode == 0) && (coverage.getDegradeReason() == 0)) {
+            _resultCache->insert(resultCacheKey, resultCacheToken, _clock.getTimeNS(), *reply);
+        }
     }
     total_matching_time.stop();
+    if (spanTrace) {
+        reply->propertiesMap.lookupCreate(search::MapNames::TRACE).add("spans", spanTrace->encode());
+    }
     my_stats.queryCollateralTime(total_matching_time.elapsed().sec() - my_stats.queryLatencyAvg());
+    if (sampledQuery) {
+        sampledQuery->total_time = total_matching_time.elapsed().sec();
+        sampledQuery->setup_time = my_stats.queryCollateralTimeAvg();
+        sampledQuery->match_time = my_stats.matchTimeAvg();
+        sampledQuery->grouping_time = my_stats.groupingTimeAvg();
+        sampledQuery->rerank_time = my_stats.rerankTimeAvg();
+        sampledQuery->docs_matched = my_stats.docsMatched();
+        sampledQuery->docs_ranked = my_stats.docsRanked();
+        sampledQuery->docs_reranked = my_stats.docsReRanked();
+        sampledQuery->threads = my_stats.getNumPartitions();
+        _sampledQueries->add(std::move(*sampledQuery));
+    }
     {
         fastos::TimeStamp softLimit = uint64_t((1.0 - _rankSetup->getSoftTimeoutTailCost()) * request.getTimeout());
         fastos::TimeStamp duration = request.getTimeUsed();
@@ -2,9 +2,12 @@
 
 #pragma once
 
+#include "filter_cache.h"
 #include "i_constant_value_repo.h"
 #include "indexenvironment.h"
 #include "matching_stats.h"
+#include "result_cache.h"
+#include "sampled_query_log.h"
 #include "search_session.h"
 #include "viewresolver.h"
 #include <vespa/searchcore/proton/matching/querylimiter.h>
@@ -57,6 +60,9 @@ private:
     const vespalib::Clock        &_clock;
     QueryLimiter                 &_queryLimiter;
     uint32_t                      _distributionKey;
+    std::unique_ptr<FilterCache>  _filterCache;
+    std::unique_ptr<ResultCache>  _resultCache;
+    std::shared_ptr<SampledQueryLog> _sampledQueries;
 
     search::FeatureSet::SP
     getFeatureSet(const search::engine::DocsumRequest & req,
@@ -107,6 +113,12 @@ public:
      **/
     MatchingStats getStats();
 
+    /**
+     * Returns the log of profiled queries, or nullptr if query
+     * profiling is disabled for this rank profile.
+     **/
+    const SampledQueryLog *getSampledQueryLog() const { return _sampledQueries.get(); }
+
     /**
      * Create the low-level tools needed to perform matching. This
      * function is exposed for testing purposes.
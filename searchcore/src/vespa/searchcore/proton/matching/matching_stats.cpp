@@ -18,6 +18,9 @@ MatchingStats::Partition &get_writable_partition(std::vector<MatchingStats::Part
 MatchingStats::MatchingStats()
     : _queries(0),
       _limited_queries(0),
+      _resultCacheHits(0),
+      _resultCacheMisses(0),
+      _queriesRejected(0),
       _docsMatched(0),
       _docsRanked(0),
       _docsReRanked(0),
@@ -25,6 +28,7 @@ MatchingStats::MatchingStats()
       _softDoomFactor(0.5),
       _queryCollateralTime(),
       _queryLatency(),
+      _queryLatencyHistogram(),
       _matchTime(),
       _groupingTime(),
       _rerankTime(),
@@ -54,6 +58,9 @@ MatchingStats::add(const MatchingStats &rhs)
 
     _queries += rhs._queries;
     _limited_queries += rhs._limited_queries;
+    _resultCacheHits += rhs._resultCacheHits;
+    _resultCacheMisses += rhs._resultCacheMisses;
+    _queriesRejected += rhs._queriesRejected;
 
     _docsMatched += rhs._docsMatched;
     _docsRanked += rhs._docsRanked;
@@ -62,6 +69,7 @@ MatchingStats::add(const MatchingStats &rhs)
 
     _queryCollateralTime.add(rhs._queryCollateralTime);
     _queryLatency.add(rhs._queryLatency);
+    _queryLatencyHistogram.merge(rhs._queryLatencyHistogram);
     _matchTime.add(rhs._matchTime);
     _groupingTime.add(rhs._groupingTime);
     _rerankTime.add(rhs._rerankTime);
@@ -71,6 +79,15 @@ MatchingStats::add(const MatchingStats &rhs)
     return *this;
 }
 
+MatchingStats &
+MatchingStats::queryLatency(double time_s)
+{
+    _queryLatency.set(time_s);
+    _queryLatencyHistogram.clear();
+    _queryLatencyHistogram.add(time_s);
+    return *this;
+}
+
 MatchingStats &
 MatchingStats::updatesoftDoomFactor(double hardLimit, double softLimit, double duration) {
     if (duration < softLimit) {
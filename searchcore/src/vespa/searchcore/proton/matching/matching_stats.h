@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <vespa/metrics/histogram.h>
 #include <vector>
 #include <cstddef>
 
@@ -83,6 +84,9 @@ public:
 private:
     size_t                 _queries;
     size_t                 _limited_queries;
+    size_t                 _resultCacheHits;
+    size_t                 _resultCacheMisses;
+    size_t                 _queriesRejected;
     size_t                 _docsMatched;
     size_t                 _docsRanked;
     size_t                 _docsReRanked;
@@ -90,6 +94,7 @@ private:
     double                 _softDoomFactor;
     Avg                    _queryCollateralTime;
     Avg                    _queryLatency;
+    metrics::Histogram     _queryLatencyHistogram;
     Avg                    _matchTime;
     Avg                    _groupingTime;
     Avg                    _rerankTime;
@@ -109,6 +114,15 @@ public:
     MatchingStats &limited_queries(size_t value) { _limited_queries = value; return *this; }
     size_t limited_queries() const { return _limited_queries; }
 
+    MatchingStats &resultCacheHits(size_t value) { _resultCacheHits = value; return *this; }
+    size_t resultCacheHits() const { return _resultCacheHits; }
+
+    MatchingStats &resultCacheMisses(size_t value) { _resultCacheMisses = value; return *this; }
+    size_t resultCacheMisses() const { return _resultCacheMisses; }
+
+    MatchingStats &queriesRejected(size_t value) { _queriesRejected = value; return *this; }
+    size_t queriesRejected() const { return _queriesRejected; }
+
     MatchingStats &docsMatched(size_t value) { _docsMatched = value; return *this; }
     size_t docsMatched() const { return _docsMatched; }
 
@@ -128,9 +142,10 @@ public:
     double queryCollateralTimeAvg() const { return _queryCollateralTime.avg(); }
     size_t queryCollateralTimeCount() const { return _queryCollateralTime.count(); }
 
-    MatchingStats &queryLatency(double time_s) { _queryLatency.set(time_s); return *this; }
+    MatchingStats &queryLatency(double time_s);
     double queryLatencyAvg() const { return _queryLatency.avg(); }
     size_t queryLatencyCount() const { return _queryLatency.count(); }
+    const metrics::Histogram &queryLatencyHistogram() const { return _queryLatencyHistogram; }
 
     MatchingStats &matchTime(double time_s) { _matchTime.set(time_s); return *this; }
     double matchTimeAvg() const { return _matchTime.avg(); }
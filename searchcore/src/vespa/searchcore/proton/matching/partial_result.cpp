@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "partial_result.h"
+#include <algorithm>
 
 namespace proton {
 namespace matching {
@@ -14,30 +15,47 @@ bool before(const search::RankedHit &a, const search::RankedHit &b) {
     return (a._docId < b._docId);
 }
 
+/**
+ * Count how many of the n best hits of a merged result are taken
+ * from the lhs side. Both sides are sorted; before(i, j) tells if
+ * lhs hit i goes before rhs hit j. Ties are resolved in favor of rhs.
+ **/
+template <typename Before>
+size_t countFromLhs(size_t n, size_t lhs_size, size_t rhs_size, Before before) {
+    size_t lo = (n > rhs_size) ? (n - rhs_size) : 0;
+    size_t hi = std::min(n, lhs_size);
+    while (lo < hi) {
+        size_t i = lo + (hi - lo) / 2;
+        if (before(i, n - i - 1)) {
+            lo = i + 1;
+        } else {
+            hi = i;
+        }
+    }
+    return lo;
+}
+
+// Hits are merged in place, back to front, after locating the split
+// point between the sides with a binary search. This avoids
+// allocating a new vector, and copying hits that are already in the
+// right place, for each merge step.
+
 void mergeHits(size_t maxHits,
                std::vector<search::RankedHit> &hits,
                const std::vector<search::RankedHit> &rhs_hits)
 {
-    std::vector<search::RankedHit> my_hits;
-    std::swap(hits, my_hits);
-    hits.reserve(maxHits);
-    const search::RankedHit *a_pos = &my_hits[0];
-    const search::RankedHit *a_end = a_pos + my_hits.size();
-    const search::RankedHit *b_pos = &rhs_hits[0];
-    const search::RankedHit *b_end = b_pos + rhs_hits.size();
-    while (a_pos < a_end && b_pos < b_end && hits.size() < maxHits) {
-        if (before(*a_pos, *b_pos)) {
-            hits.push_back(*a_pos++);
+    size_t n = std::min(maxHits, hits.size() + rhs_hits.size());
+    size_t a = countFromLhs(n, hits.size(), rhs_hits.size(),
+                            [&](size_t i, size_t j) { return before(hits[i], rhs_hits[j]); });
+    size_t b = n - a;
+    hits.resize(n);
+    for (size_t k = n; b > 0; ) {
+        if (a > 0 && !before(hits[a - 1], rhs_hits[b - 1])) {
+            hits[--k] = hits[--a];
         } else {
-            hits.push_back(*b_pos++);
+            hits[--k] = rhs_hits[--b];
         }
     }
-    while (a_pos < a_end && hits.size() < maxHits) {
-        hits.push_back(*a_pos++);
-    }
-    while (b_pos < b_end && hits.size() < maxHits) {
-        hits.push_back(*b_pos++);
-    }
 }
 
 bool before(const PartialResult::SortRef &a, uint32_t docid_a,
@@ -58,41 +76,28 @@ size_t mergeHits(size_t maxHits,
                  const std::vector<search::RankedHit> &rhs_hits,
                  const std::vector<PartialResult::SortRef> &rhs_sortData)
 {
-    size_t sortDataSize = 0;
-    std::vector<search::RankedHit> my_hits;
-    std::vector<PartialResult::SortRef> my_sortData;
-    std::swap(hits, my_hits);
-    std::swap(sortData, my_sortData);
-    hits.reserve(maxHits);
-    sortData.reserve(maxHits);
-    const search::RankedHit *a_pos = &my_hits[0];
-    const search::RankedHit *a_end = a_pos + my_hits.size();
-    const search::RankedHit *b_pos = &rhs_hits[0];
-    const search::RankedHit *b_end = b_pos + rhs_hits.size();
-    const PartialResult::SortRef *a_sort_pos = &my_sortData[0];
-    const PartialResult::SortRef *b_sort_pos = &rhs_sortData[0];
-    while (a_pos < a_end && b_pos < b_end && hits.size() < maxHits) {
-        if (before(*a_sort_pos, a_pos->_docId,
-                   *b_sort_pos, b_pos->_docId))
-        {
-            hits.push_back(*a_pos++);
-            sortDataSize += a_sort_pos->second;
-            sortData.push_back(*a_sort_pos++);
+    auto lhs_before = [&](size_t i, size_t j) {
+        return before(sortData[i], hits[i]._docId, rhs_sortData[j], rhs_hits[j]._docId);
+    };
+    size_t n = std::min(maxHits, hits.size() + rhs_hits.size());
+    size_t a = countFromLhs(n, hits.size(), rhs_hits.size(), lhs_before);
+    size_t b = n - a;
+    hits.resize(n);
+    sortData.resize(n);
+    for (size_t k = n; b > 0; ) {
+        if (a > 0 && !lhs_before(a - 1, b - 1)) {
+            --k, --a;
+            hits[k] = hits[a];
+            sortData[k] = sortData[a];
         } else {
-            hits.push_back(*b_pos++);
-            sortDataSize += b_sort_pos->second;
-            sortData.push_back(*b_sort_pos++);
+            --k, --b;
+            hits[k] = rhs_hits[b];
+            sortData[k] = rhs_sortData[b];
         }
     }
-    while (a_pos < a_end && hits.size() < maxHits) {
-        hits.push_back(*a_pos++);
-        sortDataSize += a_sort_pos->second;
-        sortData.push_back(*a_sort_pos++);
-    }
-    while (b_pos < b_end && hits.size() < maxHits) {
-        hits.push_back(*b_pos++);
-        sortDataSize += b_sort_pos->second;
-        sortData.push_back(*b_sort_pos++);
+    size_t sortDataSize = 0;
+    for (const auto &sortRef: sortData) {
+        sortDataSize += sortRef.second;
     }
     return sortDataSize;
 }
@@ -79,7 +79,13 @@ void AddLocationNode(const string &location_str, Node::UP &query_tree, Location
 }
 }  // namespace
 
-Query::Query() {}
+Query::Query()
+    : _query_tree(),
+      _blueprint(),
+      _location(),
+      _blackListBlueprint(),
+      _filterCache(nullptr)
+{}
 Query::~Query() {}
 
 bool
@@ -124,7 +130,11 @@ Query::reserveHandles(const IRequestContext & requestContext, ISearchContext &co
     MatchDataReserveVisitor reserve_visitor(mdl);
     _query_tree->accept(reserve_visitor);
 
-    _blueprint = BlueprintBuilder::build(requestContext, *_query_tree, context);
+    if (_filterCache != nullptr) {
+        _blueprint = BlueprintBuilder::build(requestContext, *_query_tree, context, *_filterCache, mdl);
+    } else {
+        _blueprint = BlueprintBuilder::build(requestContext, *_query_tree, context);
+    }
     LOG(debug, "original blueprint:\n%s\n", _blueprint->asString().c_str());
     if (_blackListBlueprint.get() != NULL) {
         std::unique_ptr<AndNotBlueprint> andNotBlueprint(new AndNotBlueprint());
@@ -14,6 +14,7 @@ namespace proton::matching {
 
 class ViewResolver;
 class ISearchContext;
+class FilterCache;
 
 class Query
 {
@@ -23,6 +24,7 @@ private:
     Blueprint::UP           _blueprint;
     search::fef::Location   _location;
     Blueprint::UP           _blackListBlueprint;
+    FilterCache            *_filterCache;
 
 public:
     Query();
@@ -63,6 +65,15 @@ public:
      **/
     void setBlackListBlueprint(Blueprint::UP blackListBlueprint);
 
+    /**
+     * Use the given cache for the results of filter subtrees when
+     * building the blueprint tree in reserveHandles. The cache must
+     * outlive this query.
+     *
+     * @param filterCache cache of filter subtree results
+     **/
+    void setFilterCache(FilterCache &filterCache) { _filterCache = &filterCache; }
+
     /**
      * Reserve room for terms in the query in the given match data
      * layout. This function also prepares the createSearch function
@@ -100,6 +111,12 @@ public:
      * @return estimate of hits produced.
      */
     Blueprint::HitEstimate estimate() const;
+
+    /**
+     * Describe the blueprint tree used to match this query, including
+     * the hit estimate of each node.
+     **/
+    vespalib::string describe() const { return _blueprint->asString(); }
 };
 
 }
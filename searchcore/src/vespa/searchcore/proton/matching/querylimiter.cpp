@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include "querylimiter.h"
 #include <chrono>
+#include <limits>
 
 namespace proton {
 namespace matching {
@@ -37,22 +38,65 @@ QueryLimiter::releaseToken()
     _cond.notify_one();
 }
 
+QueryLimiter::CostToken::~CostToken()
+{
+    _limiter.releaseCost(_cost);
+}
+
+void
+QueryLimiter::releaseCost(uint64_t cost)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _costInFlight -= cost;
+}
+
 QueryLimiter::QueryLimiter() :
     _lock(),
     _cond(),
     _activeThreads(0),
+    _costInFlight(0),
     _maxThreads(-1),
     _coverage(1.0),
-    _minHits(std::numeric_limits<uint32_t>::max())
+    _minHits(std::numeric_limits<uint32_t>::max()),
+    _maxCost(0)
 {
 }
 
 void
-QueryLimiter::configure(int maxThreads, double coverage, uint32_t minHits)
+QueryLimiter::configure(int maxThreads, double coverage, uint32_t minHits, uint64_t maxCost)
 {
     _maxThreads = maxThreads;
     _coverage = coverage;
     _minHits = minHits;
+    _maxCost = maxCost;
+}
+
+uint64_t
+QueryLimiter::estimateCost(uint32_t estHits, bool hasSecondPhase)
+{
+    return uint64_t(estHits) * (hasSecondPhase ? 2 : 1);
+}
+
+QueryLimiter::Token::UP
+QueryLimiter::admit(uint64_t cost)
+{
+    uint64_t maxCost = _maxCost;
+    if (maxCost == 0) {
+        return Token::UP(new NoLimitToken());
+    }
+    std::lock_guard<std::mutex> guard(_lock);
+    if ((_costInFlight > 0) && (_costInFlight + cost > maxCost)) {
+        return Token::UP();
+    }
+    _costInFlight += cost;
+    return Token::UP(new CostToken(*this, cost));
+}
+
+uint64_t
+QueryLimiter::getCostInFlight() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _costInFlight;
 }
 
 QueryLimiter::Token::UP
@@ -22,9 +22,33 @@ public:
     };
 public:
     QueryLimiter();
-    void configure(int maxThreads, double coverage, uint32_t minHits);
+    void configure(int maxThreads, double coverage, uint32_t minHits, uint64_t maxCost = 0);
     Token::UP getToken(const Doom & doom, uint32_t numDocs, uint32_t numHits, bool hasSorting, bool hasGrouping);
+
+    /**
+     * Estimated cost of a query, based on the estimated number of hits
+     * and whether they will be ranked in a second phase as well.
+     **/
+    static uint64_t estimateCost(uint32_t estHits, bool hasSecondPhase);
+
+    /**
+     * Admit a query with the given estimated cost. The returned token
+     * holds the cost as in flight until it is destroyed. Returns an
+     * empty token if admitting the query would bring the total cost in
+     * flight above the configured max. A query is always admitted when
+     * nothing else is in flight, and always when no max is configured.
+     **/
+    Token::UP admit(uint64_t cost);
+    uint64_t getCostInFlight() const;
 private:
+    class CostToken : public Token {
+    private:
+        QueryLimiter & _limiter;
+        uint64_t       _cost;
+    public:
+        CostToken(QueryLimiter & limiter, uint64_t cost) : _limiter(limiter), _cost(cost) { }
+        ~CostToken() override;
+    };
     class NoLimitToken : public Token {
     };
     class LimitedToken : public Token {
@@ -36,14 +60,17 @@ private:
     };
     void grabToken(const Doom & doom);
     void releaseToken();
-    std::mutex              _lock;
+    void releaseCost(uint64_t cost);
+    mutable std::mutex      _lock;
     std::condition_variable _cond;
     volatile int _activeThreads;
+    uint64_t     _costInFlight;
 
     // These are updated asynchronously at reconfig.
     volatile int      _maxThreads;
     volatile double   _coverage;
     volatile uint32_t _minHits;
+    volatile uint64_t _maxCost;
 };
 
 } // namespace matching
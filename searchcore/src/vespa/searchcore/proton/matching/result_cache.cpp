@@ -0,0 +1,134 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "result_cache.h"
+#include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/searchlib/engine/searchrequest.h>
+#include <vespa/vespalib/stllike/asciistream.h>
+#include <vespa/vespalib/stllike/lrucache_map.hpp>
+#include <algorithm>
+
+using search::engine::SearchRequest;
+using search::fef::IPropertiesVisitor;
+using search::fef::Properties;
+using search::fef::Property;
+
+namespace proton::matching {
+
+namespace {
+
+void appendField(vespalib::asciistream &os, vespalib::stringref value) {
+    os << value.size() << ':' << value;
+}
+
+struct KeyBuilder : IPropertiesVisitor {
+    vespalib::asciistream &os;
+    KeyBuilder(vespalib::asciistream &os_in) : os(os_in) {}
+    void visitProperty(const Property::Value &key, const Property &values) override {
+        appendField(os, key);
+        os << values.size();
+        for (uint32_t i = 0; i < values.size(); ++i) {
+            appendField(os, values.getAt(i));
+        }
+    }
+};
+
+} // namespace proton::matching::<unnamed>
+
+ResultCache::Entry::Entry(std::unique_ptr<const SearchReply> reply_in, const vespalib::string &token_in,
+                          fastos::TimeStamp created_in)
+    : reply(std::move(reply_in)),
+      token(token_in),
+      created(created_in)
+{
+}
+
+ResultCache::Entry::~Entry() {}
+
+ResultCache::ResultCache(size_t maxEntries, fastos::TimeStamp maxAge)
+    : _mutex(),
+      _cache(maxEntries),
+      _maxAge(maxAge)
+{
+}
+
+ResultCache::~ResultCache()
+{
+}
+
+size_t
+ResultCache::maxEntries() const
+{
+    return _cache.capacity();
+}
+
+std::unique_ptr<ResultCache::SearchReply>
+ResultCache::find(const vespalib::string &key, const vespalib::string &token, fastos::TimeStamp now)
+{
+    Entry::SP entry;
+    {
+        LockGuard guard(_mutex);
+        if (!_cache.hasKey(key)) {
+            return std::unique_ptr<SearchReply>();
+        }
+        entry = _cache[key];
+        bool expired = (_maxAge > 0) && (now - entry->created > _maxAge);
+        if (expired || (entry->token != token)) {
+            _cache.erase(key);
+            return std::unique_ptr<SearchReply>();
+        }
+    }
+    return std::make_unique<SearchReply>(*entry->reply);
+}
+
+void
+ResultCache::insert(const vespalib::string &key, const vespalib::string &token,
+                    fastos::TimeStamp now, const SearchReply &reply)
+{
+    auto entry = std::make_shared<const Entry>(std::make_unique<const SearchReply>(reply), token, now);
+    LockGuard guard(_mutex);
+    if (_cache.capacity() > 0) {
+        _cache[key] = std::move(entry);
+    }
+}
+
+size_t
+ResultCache::size() const
+{
+    LockGuard guard(_mutex);
+    return _cache.size();
+}
+
+void
+ResultCache::clear()
+{
+    LockGuard guard(_mutex);
+    while (!_cache.empty()) {
+        _cache.erase(_cache.begin());
+    }
+}
+
+vespalib::string
+ResultCache::makeKey(const SearchRequest &request)
+{
+    vespalib::asciistream os;
+    appendField(os, request.ranking);
+    os << request.queryFlags << ';' << request.offset << ';' << request.maxhits << ';';
+    appendField(os, request.location);
+    appendField(os, request.sortSpec);
+    appendField(os, vespalib::stringref(request.groupSpec.data(), request.groupSpec.size()));
+    appendField(os, request.getStackRef());
+    std::vector<std::pair<vespalib::string, const Properties *>> maps;
+    for (const auto &props: request.propertiesMap) {
+        maps.emplace_back(props.first, &props.second);
+    }
+    std::sort(maps.begin(), maps.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+    KeyBuilder builder(os);
+    for (const auto &entry: maps) {
+        appendField(os, entry.first);
+        os << entry.second->numKeys();
+        entry.second->visitProperties(builder);
+    }
+    return os.str();
+}
+
+}
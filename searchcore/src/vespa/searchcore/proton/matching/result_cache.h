@@ -0,0 +1,79 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/lrucache_map.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <vespa/fastos/timestamp.h>
+#include <memory>
+#include <mutex>
+
+namespace search::engine {
+    class SearchRequest;
+    class SearchReply;
+}
+
+namespace proton::matching {
+
+/**
+ * Cache of complete query results shared by the queries evaluated by
+ * a matcher. Entries are keyed by a normalized form of the search
+ * request (see makeKey). Each entry also records a token describing
+ * the searchable content (serial numbers and generations) when the
+ * result was calculated; an entry is only used by queries seeing the
+ * same content. Entries older than the max age are not used either,
+ * which bounds how long a result may be served after changes that
+ * are not reflected in the token.
+ *
+ * The cache holds at most maxEntries entries, evicting the least
+ * recently used entry when full.
+ **/
+class ResultCache
+{
+public:
+    using SearchReply = search::engine::SearchReply;
+
+    struct Entry {
+        using SP = std::shared_ptr<const Entry>;
+        std::unique_ptr<const SearchReply> reply;
+        vespalib::string token;
+        fastos::TimeStamp created;
+        Entry(std::unique_ptr<const SearchReply> reply_in, const vespalib::string &token_in,
+              fastos::TimeStamp created_in);
+        ~Entry();
+    };
+
+private:
+    using LockGuard = std::lock_guard<std::mutex>;
+    using Cache = vespalib::lrucache_map<vespalib::LruParam<vespalib::string, Entry::SP>>;
+
+    mutable std::mutex _mutex;
+    Cache              _cache;
+    fastos::TimeStamp  _maxAge;
+
+public:
+    ResultCache(size_t maxEntries, fastos::TimeStamp maxAge);
+    ~ResultCache();
+    size_t maxEntries() const;
+    fastos::TimeStamp maxAge() const { return _maxAge; }
+
+    /**
+     * Returns a copy of the cached reply for the given key if it was
+     * calculated with the given content token and has not expired,
+     * otherwise an empty pointer. Stale entries are dropped.
+     **/
+    std::unique_ptr<SearchReply> find(const vespalib::string &key, const vespalib::string &token,
+                                      fastos::TimeStamp now);
+    void insert(const vespalib::string &key, const vespalib::string &token,
+                fastos::TimeStamp now, const SearchReply &reply);
+    size_t size() const;
+    void clear();
+
+    /**
+     * Create a cache key covering all parts of the request that
+     * affect the reply produced by the matcher.
+     **/
+    static vespalib::string makeKey(const search::engine::SearchRequest &request);
+};
+
+}
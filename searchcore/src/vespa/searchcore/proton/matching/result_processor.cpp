@@ -28,7 +28,7 @@ ResultProcessor::Result::~Result() { }
 
 ResultProcessor::Sort::Sort(uint32_t partitionId, const vespalib::Doom & doom, IAttributeContext &ac, const vespalib::string &ss)
     : sorter(FastS_DefaultResultSorter::instance()),
-      _ucaFactory(std::make_unique<search::uca::UcaConverterFactory>()),
+      _ucaFactory(std::make_unique<search::uca::UcaConverterFactory>(true)),
       sortSpec(partitionId, doom, *_ucaFactory)
 {
     if (!ss.empty() && sortSpec.Init(ss.c_str(), ac)) {
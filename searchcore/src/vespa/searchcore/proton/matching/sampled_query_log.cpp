@@ -0,0 +1,83 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "sampled_query_log.h"
+#include <algorithm>
+
+namespace proton::matching {
+
+namespace {
+
+struct MoreExpensive {
+    bool operator()(const SampledQueryLog::Entry &a, const SampledQueryLog::Entry &b) const {
+        return (a.total_time > b.total_time);
+    }
+};
+
+}
+
+SampledQueryLog::SampledQueryLog(double sampleFraction, size_t maxEntries)
+    : _sampleFraction(std::min(std::max(sampleFraction, 0.0), 1.0)),
+      _maxEntries(std::max(maxEntries, size_t(1))),
+      _numQueries(0),
+      _numSampled(0),
+      _lock(),
+      _entries(),
+      _features()
+{
+}
+
+SampledQueryLog::~SampledQueryLog() = default;
+
+bool
+SampledQueryLog::sample()
+{
+    uint64_t n = _numQueries.fetch_add(1, std::memory_order_relaxed);
+    bool sampled = (uint64_t((n + 1) * _sampleFraction) != uint64_t(n * _sampleFraction));
+    if (sampled) {
+        _numSampled.fetch_add(1, std::memory_order_relaxed);
+    }
+    return sampled;
+}
+
+void
+SampledQueryLog::add(Entry entry)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    if (_entries.size() >= _maxEntries) {
+        if (entry.total_time <= _entries.front().total_time) {
+            return;
+        }
+        std::pop_heap(_entries.begin(), _entries.end(), MoreExpensive());
+        _entries.pop_back();
+    }
+    _entries.push_back(std::move(entry));
+    std::push_heap(_entries.begin(), _entries.end(), MoreExpensive());
+}
+
+void
+SampledQueryLog::addFeatureProfile(const search::fef::FeatureProfiler &profile)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _features.merge(profile);
+}
+
+std::vector<SampledQueryLog::Entry>
+SampledQueryLog::getEntries() const
+{
+    std::vector<Entry> result;
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        result = _entries;
+    }
+    std::sort(result.begin(), result.end(), MoreExpensive());
+    return result;
+}
+
+std::vector<search::fef::FeatureProfiler::Stats>
+SampledQueryLog::getFeatureProfile() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _features.report();
+}
+
+}
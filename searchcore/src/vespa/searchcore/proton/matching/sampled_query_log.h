@@ -0,0 +1,73 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchlib/fef/feature_profiler.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace proton::matching {
+
+/**
+ * Profiles of a sampled fraction of the queries evaluated by a
+ * matcher. Each profile records the time spent in each match phase
+ * together with the optimized blueprint tree (including hit
+ * estimates) used to match the query. Only the most expensive
+ * profiles are kept, which makes it possible to find expensive query
+ * shapes in production without re-running the queries. The time spent
+ * in each rank feature is aggregated across all sampled queries.
+ **/
+class SampledQueryLog
+{
+public:
+    struct Entry {
+        double           total_time = 0.0;
+        double           setup_time = 0.0;
+        double           match_time = 0.0;
+        double           grouping_time = 0.0;
+        double           rerank_time = 0.0;
+        size_t           docs_matched = 0;
+        size_t           docs_ranked = 0;
+        size_t           docs_reranked = 0;
+        size_t           threads = 0;
+        vespalib::string blueprint;
+    };
+
+private:
+    const double          _sampleFraction;
+    const size_t          _maxEntries;
+    std::atomic<uint64_t> _numQueries;
+    std::atomic<uint64_t> _numSampled;
+    mutable std::mutex    _lock;
+    std::vector<Entry>    _entries; // min-heap on total time
+    search::fef::FeatureProfiler _features;
+
+public:
+    SampledQueryLog(double sampleFraction, size_t maxEntries);
+    ~SampledQueryLog();
+
+    /**
+     * Returns true if the next query should be profiled. Queries are
+     * sampled evenly, not randomly, so that the fraction is exact.
+     **/
+    bool sample();
+    void add(Entry entry);
+    void addFeatureProfile(const search::fef::FeatureProfiler &profile);
+
+    /**
+     * Returns the kept profiles, most expensive first.
+     **/
+    std::vector<Entry> getEntries() const;
+
+    /**
+     * Returns the aggregated time spent per rank feature, most
+     * expensive (by self time) first.
+     **/
+    std::vector<search::fef::FeatureProfiler::Stats> getFeatureProfile() const;
+    uint64_t numSampled() const { return _numSampled.load(std::memory_order_relaxed); }
+    double getSampleFraction() const { return _sampleFraction; }
+};
+
+}
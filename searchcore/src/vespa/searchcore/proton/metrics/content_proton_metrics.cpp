@@ -7,7 +7,8 @@ namespace proton {
 ContentProtonMetrics::ContentProtonMetrics()
     : metrics::MetricSet("content.proton", "", "Search engine metrics", nullptr),
       transactionLog(this),
-      resourceUsage(this)
+      resourceUsage(this),
+      rankingExpression(this)
 {
 }
 
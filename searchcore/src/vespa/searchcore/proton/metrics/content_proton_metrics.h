@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/metrics/metrics.h>
+#include "ranking_expression_metrics.h"
 #include "resource_usage_metrics.h"
 #include "trans_log_server_metrics.h"
 
@@ -20,6 +21,7 @@ struct ContentProtonMetrics : metrics::MetricSet
 {
     TransLogServerMetrics transactionLog;
     ResourceUsageMetrics resourceUsage;
+    RankingExpressionMetrics rankingExpression;
 
     ContentProtonMetrics();
     ~ContentProtonMetrics();
@@ -4,19 +4,59 @@
 
 namespace proton {
 
+static_assert(ExecutorMetrics::Stats::QUEUE_TIME_BUCKETS == 8, "queue time histogram metrics must match buckets");
+
+void
+ExecutorMetrics::QueueTimeHistogram::update(const Stats::QueueTimeHistogram &histogram)
+{
+    lt10us.inc(histogram[0]);
+    lt100us.inc(histogram[1]);
+    lt1ms.inc(histogram[2]);
+    lt10ms.inc(histogram[3]);
+    lt100ms.inc(histogram[4]);
+    lt1s.inc(histogram[5]);
+    lt10s.inc(histogram[6]);
+    rest.inc(histogram[7]);
+}
+
+ExecutorMetrics::QueueTimeHistogram::QueueTimeHistogram(metrics::MetricSet *parent)
+    : metrics::MetricSet("queuetimehistogram", "", "Number of tasks per queue time interval", parent),
+      lt10us("lt_10us", "", "Number of tasks that waited less than 10 microseconds", this),
+      lt100us("lt_100us", "", "Number of tasks that waited from 10 to 100 microseconds", this),
+      lt1ms("lt_1ms", "", "Number of tasks that waited from 100 microseconds to 1 millisecond", this),
+      lt10ms("lt_10ms", "", "Number of tasks that waited from 1 to 10 milliseconds", this),
+      lt100ms("lt_100ms", "", "Number of tasks that waited from 10 to 100 milliseconds", this),
+      lt1s("lt_1s", "", "Number of tasks that waited from 100 milliseconds to 1 second", this),
+      lt10s("lt_10s", "", "Number of tasks that waited from 1 to 10 seconds", this),
+      rest("rest", "", "Number of tasks that waited 10 seconds or more", this)
+{
+}
+
+ExecutorMetrics::QueueTimeHistogram::~QueueTimeHistogram() = default;
+
 void
-ExecutorMetrics::update(const vespalib::ThreadStackExecutorBase::Stats &stats)
+ExecutorMetrics::update(const Stats &stats)
 {
     maxPending.set(stats.maxPendingTasks);
     accepted.inc(stats.acceptedTasks);
     rejected.inc(stats.rejectedTasks);
+    executed.inc(stats.executedTasks);
+    queueTime.addTotalValueWithCount(stats.totalQueueTime, stats.executedTasks);
+    maxQueueTime.set(stats.maxQueueTime);
+    utilization.set(stats.getUtilization());
+    queueTimeHistogram.update(stats.queueTimeHistogram);
 }
 
 ExecutorMetrics::ExecutorMetrics(const std::string &name, metrics::MetricSet *parent)
     : metrics::MetricSet(name, "", "Instance specific thread executor metrics", parent),
       maxPending("maxpending", "", "Maximum number of pending (active + queued) tasks", this),
       accepted("accepted", "", "Number of accepted tasks", this),
-      rejected("rejected", "", "Number of rejected tasks", this)
+      rejected("rejected", "", "Number of rejected tasks", this),
+      executed("executed", "", "Number of executed tasks", this),
+      queueTime("queuetime", "", "Time (in seconds) tasks waited in queue before being run", this),
+      maxQueueTime("maxqueuetime", "", "Maximum time (in seconds) a task waited in queue before being run", this),
+      utilization("utilization", "", "Ratio of time the executor threads were busy running tasks", this),
+      queueTimeHistogram(this)
 {
 }
 
@@ -11,14 +11,36 @@ namespace proton {
 
 struct ExecutorMetrics : metrics::MetricSet
 {
+    using Stats = vespalib::ThreadStackExecutorBase::Stats;
+
+    struct QueueTimeHistogram : metrics::MetricSet
+    {
+        metrics::LongCountMetric lt10us;
+        metrics::LongCountMetric lt100us;
+        metrics::LongCountMetric lt1ms;
+        metrics::LongCountMetric lt10ms;
+        metrics::LongCountMetric lt100ms;
+        metrics::LongCountMetric lt1s;
+        metrics::LongCountMetric lt10s;
+        metrics::LongCountMetric rest;
+
+        void update(const Stats::QueueTimeHistogram &histogram);
+        QueueTimeHistogram(metrics::MetricSet *parent);
+        ~QueueTimeHistogram();
+    };
+
     metrics::LongValueMetric maxPending;
     metrics::LongCountMetric accepted;
     metrics::LongCountMetric rejected;
+    metrics::LongCountMetric executed;
+    metrics::DoubleAverageMetric queueTime;
+    metrics::DoubleValueMetric maxQueueTime;
+    metrics::DoubleValueMetric utilization;
+    QueueTimeHistogram queueTimeHistogram;
 
-    void update(const vespalib::ThreadStackExecutorBase::Stats &stats);
+    void update(const Stats &stats);
     ExecutorMetrics(const std::string &name, metrics::MetricSet *parent);
     ~ExecutorMetrics();
 };
 
 } // namespace proton
-
@@ -43,6 +43,7 @@ LegacyDocumentDBMetrics::MatchingMetrics::update(const MatchingStats &stats)
     queries.inc(stats.queries());
     queryCollateralTime.addValueBatch(stats.queryCollateralTimeAvg(), stats.queryCollateralTimeCount());
     queryLatency.addValueBatch(stats.queryLatencyAvg(), stats.queryLatencyCount());
+    queryLatencyHistogram.addHistogram(stats.queryLatencyHistogram());
 }
 
 LegacyDocumentDBMetrics::MatchingMetrics::MatchingMetrics(MetricSet *parent)
@@ -53,7 +54,8 @@ LegacyDocumentDBMetrics::MatchingMetrics::MatchingMetrics(MetricSet *parent)
       queries("queries", "", "Number of queries executed", this),
       softDoomFactor("softdoomfactor", "", "Factor used to compute soft-timeout", this),
       queryCollateralTime("querycollateraltime", "", "Average time spent setting up and tearing down queries", this),
-      queryLatency("querylatency", "", "Average latency when matching a query", this)
+      queryLatency("querylatency", "", "Average latency when matching a query", this),
+      queryLatencyHistogram("querylatencyhistogram", "", "Distribution of latency when matching a query", this)
 { }
 
 LegacyDocumentDBMetrics::MatchingMetrics::~MatchingMetrics() {}
@@ -63,6 +65,9 @@ LegacyDocumentDBMetrics::MatchingMetrics::RankProfileMetrics::RankProfileMetrics
     : MetricSet(name, "", "Rank profile metrics", parent),
       queries("queries", "", "Number of queries executed", this),
       limited_queries("limitedqueries", "", "Number of queries limited in match phase", this),
+      resultCacheHits("resultcachehits", "", "Number of queries answered from the result cache", this),
+      resultCacheMisses("resultcachemisses", "", "Number of queries not found in the result cache", this),
+      queriesRejected("queriesrejected", "", "Number of queries rejected by the cost limit", this),
       matchTime("match_time", "", "Average time for matching a query", this),
       groupingTime("grouping_time", "", "Average time spent on grouping", this),
       rerankTime("rerank_time", "", "Average time spent on 2nd phase ranking", this)
@@ -101,6 +106,9 @@ LegacyDocumentDBMetrics::MatchingMetrics::RankProfileMetrics::update(const Match
 {
     queries.inc(stats.queries());
     limited_queries.inc(stats.limited_queries());
+    resultCacheHits.inc(stats.resultCacheHits());
+    resultCacheMisses.inc(stats.resultCacheMisses());
+    queriesRejected.inc(stats.queriesRejected());
     matchTime.addValueBatch(stats.matchTimeAvg(), stats.matchTimeCount());
     groupingTime.addValueBatch(stats.groupingTimeAvg(), stats.groupingTimeCount());
     rerankTime.addValueBatch(stats.rerankTimeAvg(), stats.rerankTimeCount());
@@ -152,6 +160,7 @@ LegacyDocumentDBMetrics::LegacyDocumentDBMetrics(const std::string &docTypeName,
       executor("executor", this),
       indexExecutor("indexexecutor", this),
       summaryExecutor("summaryexecutor", this),
+      attributeExecutor("attributeexecutor", this),
       sessionManager(this),
       ready("ready", this),
       notReady("notready", this),
@@ -5,6 +5,7 @@
 #include "legacy_attribute_metrics.h"
 #include "executor_metrics.h"
 #include "sessionmanager_metrics.h"
+#include <vespa/metrics/histogrammetric.h>
 #include <vespa/metrics/summetric.h>
 #include <vespa/searchcore/proton/matching/matching_stats.h>
 
@@ -49,6 +50,7 @@ struct LegacyDocumentDBMetrics : metrics::MetricSet
         metrics::DoubleValueMetric softDoomFactor;
         metrics::DoubleAverageMetric queryCollateralTime;
         metrics::DoubleAverageMetric queryLatency;
+        metrics::HistogramMetric queryLatencyHistogram;
 
         struct RankProfileMetrics : metrics::MetricSet {
             struct DocIdPartition : metrics::MetricSet {
@@ -68,6 +70,9 @@ struct LegacyDocumentDBMetrics : metrics::MetricSet
 
             metrics::LongCountMetric     queries;
             metrics::LongCountMetric     limited_queries;        
+            metrics::LongCountMetric     resultCacheHits;
+            metrics::LongCountMetric     resultCacheMisses;
+            metrics::LongCountMetric     queriesRejected;
             metrics::DoubleAverageMetric matchTime;
             metrics::DoubleAverageMetric groupingTime;
             metrics::DoubleAverageMetric rerankTime;
@@ -116,6 +121,7 @@ struct LegacyDocumentDBMetrics : metrics::MetricSet
     ExecutorMetrics                              executor;
     ExecutorMetrics                              indexExecutor;
     ExecutorMetrics                              summaryExecutor;
+    ExecutorMetrics                              attributeExecutor;
     search::grouping::SessionManagerMetrics      sessionManager;
     SubDBMetrics                                 ready;
     SubDBMetrics                                 notReady;
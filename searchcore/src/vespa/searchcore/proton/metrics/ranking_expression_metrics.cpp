@@ -0,0 +1,18 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "ranking_expression_metrics.h"
+
+namespace proton {
+
+RankingExpressionMetrics::RankingExpressionMetrics(metrics::MetricSet *parent)
+    : MetricSet("ranking_expression", "", "Metrics for compilation of ranking expressions", parent),
+      compiled("compiled", "", "The number of ranking expressions compiled since startup", this),
+      cached("cached", "", "The number of compiled ranking expressions currently in use", this),
+      compileTime("compile_time", "", "The total time spent compiling ranking expressions since startup (seconds)", this),
+      maxCompileTime("max_compile_time", "", "The longest time spent compiling a single ranking expression (seconds)", this)
+{
+}
+
+RankingExpressionMetrics::~RankingExpressionMetrics() {}
+
+} // namespace proton
@@ -0,0 +1,23 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/metrics/metrics.h>
+
+namespace proton {
+
+/**
+ * Metrics for compilation of ranking expressions.
+ */
+struct RankingExpressionMetrics : metrics::MetricSet
+{
+    metrics::LongValueMetric compiled;
+    metrics::LongValueMetric cached;
+    metrics::DoubleValueMetric compileTime;
+    metrics::DoubleValueMetric maxCompileTime;
+
+    RankingExpressionMetrics(metrics::MetricSet *parent);
+    ~RankingExpressionMetrics();
+};
+
+} // namespace proton
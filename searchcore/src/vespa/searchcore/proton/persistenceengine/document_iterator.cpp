@@ -144,6 +144,9 @@ public:
             } else {
                 _select = (cs._attrSelect ? cs._attrSelect->clone()
                                           : cs._select->clone());
+                if (cs._attrPreFilter) {
+                    _preFilter = cs._attrPreFilter->clone();
+                }
                 using document::select::GidFilter;
                 _gidFilter = GidFilter::for_selection_root_node(*_select);
                 _sc.reset(new SelectContext(*_cs));
@@ -175,6 +178,9 @@ public:
         if (!_gidFilter.gid_might_match_selection(meta.gid)) {
             return false;
         }
+        if (_preFilter && (_preFilter->contains(*_sc) == document::select::Result::False)) {
+            return false;
+        }
         return (! _cs->_attrSelect) ||
                 (_cs->_attrSelect && (_select->contains(*_sc) == document::select::Result::True));
     }
@@ -192,6 +198,7 @@ private:
     uint32_t                       _docidLimit;
     CachedSelect::SP               _cs;
     document::select::Node::UP     _select;
+    document::select::Node::UP     _preFilter;
     document::select::GidFilter    _gidFilter;
     std::unique_ptr<SelectContext> _sc;
 };
@@ -321,29 +321,41 @@ PersistenceEngine::getBucketInfo(const Bucket& b) const
 
 
 Result
-PersistenceEngine::put(const Bucket& b, Timestamp t, const document::Document::SP& doc, Context&)
+PersistenceEngine::getPutHandler(const Bucket& b, Timestamp t, const Document& doc,
+                                 IPersistenceHandler::SP& handler) const
 {
     if (!_writeFilter.acceptWriteOperation()) {
         IResourceWriteFilter::State state = _writeFilter.getAcceptState();
         if (!state.acceptWriteOperation()) {
             return Result(Result::RESOURCE_EXHAUSTED,
                           make_string("Put operation rejected for document '%s': '%s'",
-                                      doc->getId().toString().c_str(), state.message().c_str()));
+                                      doc.getId().toString().c_str(), state.message().c_str()));
         }
     }
-    std::shared_lock<std::shared_timed_mutex> rguard(_rwMutex);
-    DocTypeName docType(doc->getType());
+    DocTypeName docType(doc.getType());
     LOG(spam, "put(%s, %" PRIu64 ", (\"%s\", \"%s\"))", b.toString().c_str(), static_cast<uint64_t>(t.getValue()),
-        docType.toString().c_str(), doc->getId().toString().c_str());
-    if (!doc->getId().hasDocType()) {
+        docType.toString().c_str(), doc.getId().toString().c_str());
+    if (!doc.getId().hasDocType()) {
         return Result(Result::PERMANENT_ERROR,
-                      make_string("Old id scheme not supported in elastic mode (%s)", doc->getId().toString().c_str()));
+                      make_string("Old id scheme not supported in elastic mode (%s)", doc.getId().toString().c_str()));
     }
-    IPersistenceHandler::SP handler = getHandler(b.getBucketSpace(), docType);
+    handler = getHandler(b.getBucketSpace(), docType);
     if (!handler) {
         return Result(Result::PERMANENT_ERROR,
                       make_string("No handler for document type '%s'", docType.toString().c_str()));
     }
+    return Result();
+}
+
+Result
+PersistenceEngine::put(const Bucket& b, Timestamp t, const document::Document::SP& doc, Context&)
+{
+    std::shared_lock<std::shared_timed_mutex> rguard(_rwMutex);
+    IPersistenceHandler::SP handler;
+    Result result = getPutHandler(b, t, *doc, handler);
+    if (result.hasError()) {
+        return result;
+    }
     TransportLatch latch(1);
     handler->handlePut(feedtoken::make(latch), b, t, doc);
     latch.await();
@@ -370,6 +382,68 @@ PersistenceEngine::remove(const Bucket& b, Timestamp t, const DocumentId& did, C
 }
 
 
+PersistenceEngine::FeedBatchResult
+PersistenceEngine::feedBatch(const Bucket& b, const FeedBatch& batch, Context&)
+{
+    std::shared_lock<std::shared_timed_mutex> rguard(_rwMutex);
+    LOG(spam, "feedBatch(%s, %zu operations)", b.toString().c_str(), batch.size());
+    // Hand all operations to the feed pipeline before waiting for any of
+    // them, so they are written to the transaction log and applied back to
+    // back instead of paying a full round trip each.
+    std::vector<std::unique_ptr<TransportLatch>> latches;
+    std::vector<Result> errors;
+    std::vector<IPersistenceHandler::SP> putHandlers;
+    std::vector<HandlerSnapshot::UP> removeHandlers;
+    latches.reserve(batch.size());
+    errors.reserve(batch.size());
+    for (const FeedBatch::Operation& op : batch.getOperations()) {
+        if (op.getType() == FeedBatch::Type::PUT) {
+            IPersistenceHandler::SP handler;
+            errors.push_back(getPutHandler(b, op.getTimestamp(), *op.getDocument(), handler));
+            if (errors.back().hasError()) {
+                latches.emplace_back();
+                continue;
+            }
+            latches.push_back(std::make_unique<TransportLatch>(1));
+            handler->handlePut(feedtoken::make(*latches.back()), b, op.getTimestamp(), op.getDocument());
+            putHandlers.push_back(std::move(handler));
+        } else {
+            errors.emplace_back();
+            HandlerSnapshot::UP snap = getHandlerSnapshot(b.getBucketSpace(), op.getDocumentId());
+            if (!snap) {
+                latches.emplace_back();
+                continue;
+            }
+            latches.push_back(std::make_unique<TransportLatch>(snap->size()));
+            for (; snap->handlers().valid(); snap->handlers().next()) {
+                IPersistenceHandler *handler = snap->handlers().get();
+                handler->handleRemove(feedtoken::make(*latches.back()), b, op.getTimestamp(), op.getDocumentId());
+            }
+            removeHandlers.push_back(std::move(snap));
+        }
+    }
+    FeedBatchResult results;
+    results.reserve(batch.size());
+    for (size_t i = 0; i < latches.size(); ++i) {
+        TransportLatch *latch = latches[i].get();
+        if (errors[i].hasError()) {
+            results.emplace_back(errors[i].getErrorCode(), errors[i].getErrorMessage());
+        } else if (latch == nullptr) {
+            results.emplace_back(false);
+        } else {
+            latch->await();
+            if (batch.getOperations()[i].getType() != FeedBatch::Type::PUT) {
+                results.push_back(latch->getRemoveResult());
+            } else if (latch->getResult().hasError()) {
+                results.emplace_back(latch->getResult().getErrorCode(), latch->getResult().getErrorMessage());
+            } else {
+                results.emplace_back(false);
+            }
+        }
+    }
+    return results;
+}
+
 PersistenceEngine::UpdateResult
 PersistenceEngine::update(const Bucket& b, Timestamp t, const DocumentUpdate::SP& upd, Context&)
 {
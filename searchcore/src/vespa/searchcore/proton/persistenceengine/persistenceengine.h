@@ -21,6 +21,8 @@ private:
     using PersistenceHandlerSequence = vespalib::Sequence<IPersistenceHandler *>;
     using HandlerSnapshot = PersistenceHandlerMap::HandlerSnapshot;
     using DocumentUpdate = document::DocumentUpdate;
+    using FeedBatch = storage::spi::FeedBatch;
+    using FeedBatchResult = storage::spi::FeedBatchResult;
     using Bucket = storage::spi::Bucket;
     using BucketIdListResult = storage::spi::BucketIdListResult;
     using BucketInfo = storage::spi::BucketInfo;
@@ -87,6 +89,8 @@ private:
     HandlerSnapshot::UP getHandlerSnapshot(document::BucketSpace bucketSpace,
                                            const document::DocumentId &docId) const;
 
+    Result getPutHandler(const Bucket &b, Timestamp t, const document::Document &doc,
+                         IPersistenceHandler::SP &handler) const;
     void saveClusterState(BucketSpace bucketSpace, const ClusterState &calc);
     ClusterState::SP savedClusterState(BucketSpace bucketSpace) const;
 
@@ -114,6 +118,7 @@ public:
     virtual Result put(const Bucket&, Timestamp, const document::Document::SP&, Context&) override;
     virtual RemoveResult remove(const Bucket&, Timestamp, const document::DocumentId&, Context&) override;
     virtual UpdateResult update(const Bucket&, Timestamp, const document::DocumentUpdate::SP&, Context&) override;
+    virtual FeedBatchResult feedBatch(const Bucket&, const FeedBatch&, Context&) override;
     virtual GetResult get(const Bucket&, const document::FieldSet&, const document::DocumentId&, Context&) const override;
     virtual CreateIteratorResult createIterator(const Bucket&, const document::FieldSet&, const Selection&,
                                                 IncludedVersions, Context&) override;
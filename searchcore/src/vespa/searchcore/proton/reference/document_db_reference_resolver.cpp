@@ -145,6 +145,9 @@ DocumentDBReferenceResolver::createImportedAttributesRepo(const IAttributeManage
         AttributeVector::SP targetAttr = getTargetDocumentDB(refAttr->getName())->getAttribute(attr.targetfield);
         ImportedAttributeVector::SP importedAttr =
                 std::make_shared<ImportedAttributeVector>(attr.name, refAttr, targetAttr, documentMetaStore, useSearchCache);
+        if (attr.materialize) {
+            importedAttr->enableMaterializedValues();
+        }
         result->add(importedAttr->getName(), importedAttr);
     }
     return result;
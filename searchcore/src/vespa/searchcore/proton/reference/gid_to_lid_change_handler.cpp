@@ -5,6 +5,7 @@
 #include <vespa/searchcorespi/index/i_thread_service.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/vespalib/util/lambdatask.h>
+#include <algorithm>
 #include <cassert>
 
 using vespalib::makeLambdaTask;
@@ -63,25 +64,51 @@ GidToLidChangeHandler::notifyPutDone(GlobalId gid, uint32_t lid, SerialNum seria
     notifyPutDone(gid, lid);
 }
 
-void
-GidToLidChangeHandler::notifyRemove(GlobalId gid, SerialNum serialNum)
+bool
+GidToLidChangeHandler::addPendingRemove(GlobalId gid, SerialNum serialNum)
 {
-    lock_guard guard(_lock);
     auto insRes = _pendingRemove.insert(std::make_pair(gid, PendingRemoveEntry(serialNum)));
     if (!insRes.second) {
         auto &entry = insRes.first->second;
         assert(entry.removeSerialNum < serialNum);
         assert(entry.putSerialNum < serialNum);
-        if (entry.removeSerialNum < entry.putSerialNum) {
-            notifyRemove(gid);
-        }
+        bool needNotify = (entry.removeSerialNum < entry.putSerialNum);
         entry.removeSerialNum = serialNum;
         ++entry.refCount;
-    } else {
+        return needNotify;
+    }
+    return true;
+}
+
+void
+GidToLidChangeHandler::notifyRemove(GlobalId gid, SerialNum serialNum)
+{
+    lock_guard guard(_lock);
+    if (addPendingRemove(gid, serialNum)) {
         notifyRemove(gid);
     }
 }
 
+void
+GidToLidChangeHandler::notifyRemoves(const std::vector<GlobalId> &gids, SerialNum serialNum)
+{
+    lock_guard guard(_lock);
+    std::vector<GlobalId> changed;
+    changed.reserve(gids.size());
+    for (const auto &gid : gids) {
+        if (addPendingRemove(gid, serialNum)) {
+            changed.push_back(gid);
+        }
+    }
+    if (changed.empty()) {
+        return;
+    }
+    std::sort(changed.begin(), changed.end());
+    for (const auto &listener : _listeners) {
+        listener->notifyRemoves(changed);
+    }
+}
+
 void
 GidToLidChangeHandler::notifyRemoveDone(GlobalId gid, SerialNum serialNum)
 {
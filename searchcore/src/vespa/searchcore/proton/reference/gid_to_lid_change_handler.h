@@ -47,6 +47,7 @@ class GidToLidChangeHandler : public std::enable_shared_from_this<GidToLidChange
 
     void notifyPutDone(GlobalId gid, uint32_t lid);
     void notifyRemove(GlobalId gid);
+    bool addPendingRemove(GlobalId gid, SerialNum serialNum);
 public:
     GidToLidChangeHandler();
     virtual ~GidToLidChangeHandler();
@@ -54,6 +55,7 @@ public:
     virtual void notifyPutDone(GlobalId gid, uint32_t lid, SerialNum serialNum) override;
     virtual void notifyRemove(GlobalId gid, SerialNum serialNum) override;
     virtual void notifyRemoveDone(GlobalId gid, SerialNum serialNum) override;
+    virtual void notifyRemoves(const std::vector<GlobalId> &gids, SerialNum serialNum) override;
 
     /**
      * Close handler, further notifications are blocked.
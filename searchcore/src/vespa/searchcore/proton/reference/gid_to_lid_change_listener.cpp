@@ -45,6 +45,21 @@ GidToLidChangeListener::notifyRemove(document::GlobalId gid)
     future.wait();
 }
 
+void
+GidToLidChangeListener::notifyRemoves(const std::vector<document::GlobalId> &gids)
+{
+    std::promise<void> promise;
+    auto future = promise.get_future();
+    _attributeFieldWriter.executeLambda(_executorId,
+                                        [this, &promise, &gids]() {
+                                            for (const auto &gid : gids) {
+                                                _attr->notifyReferencedRemove(gid);
+                                            }
+                                            promise.set_value();
+                                        });
+    future.wait();
+}
+
 void
 GidToLidChangeListener::notifyRegistered()
 {
@@ -32,6 +32,7 @@ public:
     virtual ~GidToLidChangeListener();
     virtual void notifyPutDone(document::GlobalId gid, uint32_t lid) override;
     virtual void notifyRemove(document::GlobalId gid) override;
+    virtual void notifyRemoves(const std::vector<document::GlobalId> &gids) override;
     virtual void notifyRegistered() override;
     virtual const vespalib::string &getName() const override;
     virtual const vespalib::string &getDocTypeName() const override;
@@ -4,10 +4,10 @@
 
 #include <set>
 #include <memory>
+#include <vector>
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/searchlib/common/serialnum.h>
-
-namespace document { class GlobalId; }
+#include <vespa/document/base/globalid.h>
 
 namespace proton {
 
@@ -43,6 +43,16 @@ public:
     virtual void notifyPutDone(GlobalId gid, uint32_t lid, SerialNum serialNum) = 0;
     virtual void notifyRemove(GlobalId gid, SerialNum serialNum) = 0;
     virtual void notifyRemoveDone(GlobalId gid, SerialNum serialNum) = 0;
+
+    /**
+     * Notify removal of a batch of gids with the same serial number.
+     * Listeners are notified once for the whole batch.
+     */
+    virtual void notifyRemoves(const std::vector<GlobalId> &gids, SerialNum serialNum) {
+        for (const auto &gid : gids) {
+            notifyRemove(gid, serialNum);
+        }
+    }
 };
 
 } // namespace proton
@@ -4,8 +4,8 @@
 
 #include <stdint.h>
 #include <vespa/vespalib/stllike/string.h>
-
-namespace document { class GlobalId; }
+#include <vespa/document/base/globalid.h>
+#include <vector>
 
 namespace proton {
 
@@ -19,6 +19,14 @@ public:
     virtual ~IGidToLidChangeListener() { }
     virtual void notifyPutDone(document::GlobalId gid, uint32_t lid) = 0;
     virtual void notifyRemove(document::GlobalId gid) = 0;
+    /*
+     * Notify removal of a batch of gids, sorted by gid.
+     */
+    virtual void notifyRemoves(const std::vector<document::GlobalId> &gids) {
+        for (const auto &gid : gids) {
+            notifyRemove(gid);
+        }
+    }
     virtual void notifyRegistered() = 0;
     virtual const vespalib::string &getName() const = 0;
     virtual const vespalib::string &getDocTypeName() const = 0;
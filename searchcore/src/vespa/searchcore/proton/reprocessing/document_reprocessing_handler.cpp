@@ -1,12 +1,22 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "document_reprocessing_handler.h"
+#include <vespa/vespalib/util/blockingthreadstackexecutor.h>
+#include <vespa/vespalib/util/lambdatask.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.reprocessing.document_reprocessing_handler");
 
+using vespalib::makeLambdaTask;
+
 namespace proton {
 
+namespace {
+
+constexpr uint32_t READER_STACK_SIZE = 128 * 1024;
+
+}
+
 void
 DocumentReprocessingHandler::rewriteVisit(uint32_t lid, document::Document &doc)
 {
@@ -20,23 +30,60 @@ DocumentReprocessingHandler::rewriteVisit(uint32_t lid, document::Document &doc)
     }
 }
 
+void
+DocumentReprocessingHandler::readVisit(uint32_t lid, const document::Document &doc)
+{
+    for (const auto &reader : _readers) {
+        reader->handleExisting(lid, doc);
+    }
+}
+
 DocumentReprocessingHandler::DocumentReprocessingHandler(uint32_t docIdLimit)
+    : DocumentReprocessingHandler(docIdLimit, 0)
+{}
+
+DocumentReprocessingHandler::DocumentReprocessingHandler(uint32_t docIdLimit, uint32_t readerTaskLimit)
     : _readers(),
       _rewriters(),
       _rewriteVisitor(*this),
-      _docIdLimit(docIdLimit)
-{}
+      _docIdLimit(docIdLimit),
+      _readerExecutor()
+{
+    if (readerTaskLimit > 0) {
+        _readerExecutor = std::make_unique<vespalib::BlockingThreadStackExecutor>(1, READER_STACK_SIZE, readerTaskLimit);
+    }
+}
 
-DocumentReprocessingHandler::~DocumentReprocessingHandler() {}
+DocumentReprocessingHandler::~DocumentReprocessingHandler()
+{
+    if (_readerExecutor) {
+        _readerExecutor->sync();
+    }
+}
 
 void
 DocumentReprocessingHandler::visit(uint32_t lid, const document::Document &doc)
 {
     if (lid == 0 || lid >= _docIdLimit)
         return;
-    for (const auto &reader : _readers) {
-        reader->handleExisting(lid, doc);
+    if (_readerExecutor) {
+        // Caller keeps ownership, so wait for queued documents to keep order.
+        _readerExecutor->sync();
+    }
+    readVisit(lid, doc);
+}
+
+void
+DocumentReprocessingHandler::visitShared(uint32_t lid, std::shared_ptr<const document::Document> doc)
+{
+    if (lid == 0 || lid >= _docIdLimit)
+        return;
+    if (!_readerExecutor) {
+        readVisit(lid, *doc);
+        return;
     }
+    _readerExecutor->execute(makeLambdaTask([this, lid, doc = std::move(doc)]()
+                                            { readVisit(lid, *doc); }));
 }
 
 void
@@ -48,6 +95,9 @@ DocumentReprocessingHandler::visit(uint32_t lid)
 void
 DocumentReprocessingHandler::done()
 {
+    if (_readerExecutor) {
+        _readerExecutor->sync();
+    }
     for (const auto &reader : _readers) {
         reader->done();
     }
@@ -5,11 +5,18 @@
 #include "i_reprocessing_handler.h"
 #include <vespa/searchlib/docstore/idocumentstore.h>
 
+namespace vespalib { class BlockingThreadStackExecutor; }
+
 namespace proton {
 
 /**
  * Class that is a visitor over a document store and proxies all documents
  * to the registered readers and rewriters upon visiting.
+ *
+ * When a reader task limit is given, documents visited by the read-only
+ * visitor are handed to the readers on a separate thread, overlapping
+ * document store decoding with attribute population. At most task limit
+ * documents are queued before the visitor is blocked.
  */
 class DocumentReprocessingHandler : public IReprocessingHandler,
                                     public search::IDocumentStoreReadVisitor
@@ -34,11 +41,14 @@ private:
     RewriterVector _rewriters;
     RewriteVisitor _rewriteVisitor;
     uint32_t       _docIdLimit;
+    std::unique_ptr<vespalib::BlockingThreadStackExecutor> _readerExecutor;
 
     void rewriteVisit(uint32_t lid, document::Document &doc);
+    void readVisit(uint32_t lid, const document::Document &doc);
 
 public:
     DocumentReprocessingHandler(uint32_t docIdLimit);
+    DocumentReprocessingHandler(uint32_t docIdLimit, uint32_t readerTaskLimit);
     ~DocumentReprocessingHandler();
 
     bool hasReaders() const {
@@ -71,6 +81,8 @@ public:
 
     virtual void visit(uint32_t lid) override;
 
+    virtual void visitShared(uint32_t lid, std::shared_ptr<const document::Document> doc) override;
+
     void done();
 };
 
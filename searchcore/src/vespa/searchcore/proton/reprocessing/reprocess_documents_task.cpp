@@ -12,13 +12,14 @@ ReprocessDocumentsTask(IReprocessingInitializer &initializer,
                        const proton::ISummaryManager::SP &sm,
                        const document::DocumentTypeRepo::SP &docTypeRepo,
                        const vespalib::string &subDbName,
-                       uint32_t docIdLimit)
+                       uint32_t docIdLimit,
+                       uint32_t readerTaskLimit)
     : _sm(sm),
       _docTypeRepo(docTypeRepo),
       _subDbName(subDbName),
       _visitorProgress(0.0),
       _visitorCost(0.0),
-      _handler(docIdLimit),
+      _handler(docIdLimit, readerTaskLimit),
       _startTime(0),
       _loggedProgress(0.0),
       _loggedTime(0)
@@ -35,7 +35,8 @@ public:
                            const proton::ISummaryManager::SP &sm,
                            const document::DocumentTypeRepo::SP &docTypeRepo,
                            const vespalib::string &subDbName,
-                           uint32_t docIdLimit);
+                           uint32_t docIdLimit,
+                           uint32_t readerTaskLimit = 0);
 
     virtual void
     run() override;
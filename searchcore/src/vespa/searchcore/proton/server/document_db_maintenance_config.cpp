@@ -55,7 +55,8 @@ DocumentDBLidSpaceCompactionConfig::DocumentDBLidSpaceCompactionConfig()
       _allowedLidBloat(1000000000),
       _allowedLidBloatFactor(1.0),
       _disabled(false),
-      _maxDocsToScan(10000)
+      _maxDocsToScan(10000),
+      _maxDocsToMove(1)
 {
 }
 
@@ -63,13 +64,15 @@ DocumentDBLidSpaceCompactionConfig::DocumentDBLidSpaceCompactionConfig(double in
                                                                        uint32_t allowedLidBloat,
                                                                        double allowedLidBloatFactor,
                                                                        bool disabled,
-                                                                       uint32_t maxDocsToScan)
+                                                                       uint32_t maxDocsToScan,
+                                                                       uint32_t maxDocsToMove)
     : _delay(std::min(MAX_DELAY_SEC, interval)),
       _interval(interval),
       _allowedLidBloat(allowedLidBloat),
       _allowedLidBloatFactor(allowedLidBloatFactor),
       _disabled(disabled),
-      _maxDocsToScan(maxDocsToScan)
+      _maxDocsToScan(maxDocsToScan),
+      _maxDocsToMove(std::max(maxDocsToMove, 1u))
 {
 }
 
@@ -88,7 +91,8 @@ DocumentDBLidSpaceCompactionConfig::operator==(const DocumentDBLidSpaceCompactio
            _interval == rhs._interval &&
            _allowedLidBloat == rhs._allowedLidBloat &&
            _allowedLidBloatFactor == rhs._allowedLidBloatFactor &&
-           _disabled == rhs._disabled;
+           _disabled == rhs._disabled &&
+           _maxDocsToMove == rhs._maxDocsToMove;
 }
 
 
@@ -49,6 +49,7 @@ private:
     double   _allowedLidBloatFactor;
     bool     _disabled;
     uint32_t _maxDocsToScan;
+    uint32_t _maxDocsToMove;
 
 public:
     DocumentDBLidSpaceCompactionConfig();
@@ -56,7 +57,8 @@ public:
                                        uint32_t allowedLidBloat,
                                        double allowwedLidBloatFactor,
                                        bool disabled = false,
-                                       uint32_t maxDocsToScan = 10000);
+                                       uint32_t maxDocsToScan = 10000,
+                                       uint32_t maxDocsToMove = 1);
 
     static DocumentDBLidSpaceCompactionConfig createDisabled();
     bool operator==(const DocumentDBLidSpaceCompactionConfig &rhs) const;
@@ -66,6 +68,7 @@ public:
     double getAllowedLidBloatFactor() const { return _allowedLidBloatFactor; }
     bool isDisabled() const { return _disabled; }
     uint32_t getMaxDocsToScan() const { return _maxDocsToScan; }
+    uint32_t getMaxDocsToMove() const { return _maxDocsToMove; }
 };
 
 class BlockableMaintenanceJobConfig {
@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "document_subdb_explorer.h"
+#include "matchers_explorer.h"
 
 #include <vespa/searchcore/proton/attribute/attribute_manager_explorer.h>
 #include <vespa/searchcore/proton/documentmetastore/document_meta_store_explorer.h>
@@ -19,6 +20,7 @@ const vespalib::string DOCUMENT_META_STORE = "documentmetastore";
 const vespalib::string DOCUMENT_STORE = "documentstore";
 const vespalib::string ATTRIBUTE = "attribute";
 const vespalib::string INDEX = "index";
+const vespalib::string MATCHERS = "matchers";
 
 }
 
@@ -44,6 +46,9 @@ DocumentSubDBExplorer::get_children_names() const
     if (_subDb.getIndexManager().get() != nullptr) {
         children.push_back(INDEX);
     }
+    if (_subDb.getMatchers().get() != nullptr) {
+        children.push_back(MATCHERS);
+    }
     return children;
 }
 
@@ -67,6 +72,11 @@ DocumentSubDBExplorer::get_child(vespalib::stringref name) const
         if (idxMgr.get() != nullptr) {
             return std::unique_ptr<StateExplorer>(new IndexManagerExplorer(std::move(idxMgr)));
         }
+    } else if (name == MATCHERS) {
+        Matchers::SP matchers = _subDb.getMatchers();
+        if (matchers.get() != nullptr) {
+            return std::unique_ptr<StateExplorer>(new MatchersExplorer(std::move(matchers)));
+        }
     }
     return std::unique_ptr<StateExplorer>();
 }
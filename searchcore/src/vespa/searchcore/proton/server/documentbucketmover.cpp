@@ -7,6 +7,7 @@
 #include <vespa/searchcore/proton/documentmetastore/i_document_meta_store.h>
 #include <vespa/searchcore/proton/feedoperation/moveoperation.h>
 #include <vespa/searchcore/proton/persistenceengine/i_document_retriever.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
 
 using document::BucketId;
 using document::Document;
@@ -21,21 +22,14 @@ typedef IDocumentMetaStore::Iterator Iterator;
 void
 DocumentBucketMover::moveDocument(DocumentIdT lid,
                                   const document::GlobalId &gid,
-                                  Timestamp timestamp)
+                                  Timestamp timestamp,
+                                  Document::SP doc)
 {
-    Document::SP doc(_source->_retriever->getDocument(lid).release());
     if (!doc || doc->getId().getGlobalId() != gid)
         return; // Failed to retrieve document, removed or changed identity
-    // TODO(geirst): what if doc is NULL?
     BucketId bucketId = _bucket.stripUnused();
     MoveOperation op(bucketId, timestamp, doc, DbDocumentId(_source->_subDbId, lid), _targetSubDbId);
-
-    // We cache the bucket for the document we are going to move to avoid getting
-    // inconsistent bucket info (getBucketInfo()) while moving between ready and not-ready
-    // sub dbs as the bucket info is not updated atomically in this case.
-    _bucketDb->takeGuard()->cacheBucket(bucketId);
     _handler->handleMove(op, _limiter.beginOperation());
-    _bucketDb->takeGuard()->uncacheBucket();
 }
 
 
@@ -73,6 +67,22 @@ DocumentBucketMover::setupForBucket(const BucketId &bucket,
 namespace
 {
 
+/**
+ * Collects the documents of a move batch, which are read from the document store in one go.
+ */
+class DocumentCollector : public search::IDocumentVisitor
+{
+public:
+    vespalib::hash_map<DocumentIdT, Document::SP> _docs;
+    DocumentCollector() : _docs() { }
+    void visit(uint32_t lid, Document::UP doc) override {
+        if (doc) {
+            _docs[lid] = Document::SP(doc.release());
+        }
+    }
+    bool allowVisitCaching() const override { return false; }
+};
+
 class MoveKey
 {
 public:
@@ -129,9 +139,27 @@ DocumentBucketMover::moveDocuments(size_t maxDocsToMove)
     if (itr == end) {
         setBucketDone();
     }
+    if (toMove.empty()) {
+        return;
+    }
+    IDocumentRetriever::LidVector lids;
+    lids.reserve(toMove.size());
     for (const MoveKey & key : toMove) {
-        moveDocument(key._lid, key._gid, key._timestamp);
+        lids.push_back(key._lid);
     }
+    DocumentCollector collector;
+    _source->_retriever->visitDocuments(lids, collector, storage::spi::ReadConsistency::STRONG);
+
+    // We cache the bucket for the documents we are going to move to avoid getting
+    // inconsistent bucket info (getBucketInfo()) while moving between ready and not-ready
+    // sub dbs as the bucket info is not updated atomically in this case.
+    _bucketDb->takeGuard()->cacheBucket(_bucket.stripUnused());
+    for (const MoveKey & key : toMove) {
+        auto found = collector._docs.find(key._lid);
+        moveDocument(key._lid, key._gid, key._timestamp,
+                     (found != collector._docs.end()) ? found->second : Document::SP());
+    }
+    _bucketDb->takeGuard()->uncacheBucket();
 }
 
 
@@ -8,6 +8,8 @@
 #include <persistence/spi/types.h>
 #include "ifrozenbuckethandler.h"
 
+namespace document { class Document; }
+
 namespace proton {
 
 class BucketDBOwner;
@@ -18,7 +20,8 @@ class MaintenanceDocumentSubDB;
 /**
  * Class used to move all documents in a bucket from a source sub database
  * to a target sub database. The actual moving is handled by a given instance
- * of IDocumentMoveHandler.
+ * of IDocumentMoveHandler. The documents of each batch are read from the
+ * document store in one operation.
  */
 class DocumentBucketMover
 {
@@ -35,7 +38,8 @@ private:
 
     void moveDocument(search::DocumentIdT lid,
                       const document::GlobalId &gid,
-                      storage::spi::Timestamp timestamp);
+                      storage::spi::Timestamp timestamp,
+                      std::shared_ptr<document::Document> doc);
 
     void setBucketDone();
 public:
@@ -75,6 +75,7 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
                        const vespalib::string &tlsSpec,
                        matching::QueryLimiter &queryLimiter,
                        const vespalib::Clock &clock,
+                       const vespalib::eval::ConstantValueFactory &constantValueFactory,
                        const DocTypeName &docTypeName,
                        document::BucketSpace bucketSpace,
                        const ProtonConfig &protonCfg,
@@ -86,6 +87,7 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
                        const FileHeaderContext &fileHeaderContext,
                        ConfigStore::UP config_store,
                        InitializeThreads initializeThreads,
+                       InitializeThreads initializeIoThreads,
                        const HwInfo &hwInfo)
     : IDocumentDBConfigOwner(),
       IReplayConfig(),
@@ -100,8 +102,10 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
       _writeServiceConfig(ThreadingServiceConfig::make(protonCfg, hwInfo.cpu())),
       _writeService(_writeServiceConfig.indexingThreads(),
                     indexing_thread_stack_size,
-                    _writeServiceConfig.defaultTaskLimit()),
+                    _writeServiceConfig.defaultTaskLimit(),
+                    _writeServiceConfig.rebalanceAttributeWriter()),
       _initializeThreads(initializeThreads),
+      _initializeIoThreads(initializeIoThreads),
       _initConfigSnapshot(),
       _initConfigSerialNum(0u),
       _pendingConfigSnapshot(configSnapshot),
@@ -111,6 +115,7 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
       _activeConfigSnapshotGeneration(0),
       _activeConfigSnapshotSerialNum(0u),
       _initGate(),
+      _initTaskTimings(),
       _clusterStateHandler(_writeService.master()),
       _bucketHandler(_writeService.master()),
       _protonIndexCfg(protonCfg.index),
@@ -128,7 +133,7 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
       _feedHandler(_writeService, tlsSpec, docTypeName, _state, *this, _writeFilter, *this, tlsDirectWriter),
       _subDBs(*this, *this, _feedHandler, _docTypeName, _writeService, warmupExecutor,
               summaryExecutor, fileHeaderContext, metricsWireService, getMetricsCollection(),
-              queryLimiter, clock, _configMutex, _baseDir, protonCfg, hwInfo),
+              queryLimiter, clock, constantValueFactory, _configMutex, _baseDir, protonCfg, hwInfo),
       _maintenanceController(_writeService.master(), summaryExecutor, _docTypeName),
       _visibility(_feedHandler, _writeService, _feedView),
       _lidSpaceCompactionHandlers(),
@@ -212,16 +217,22 @@ DocumentDB::internalInit()
 
 class InitDoneTask : public vespalib::Executor::Task {
     DocumentDB::InitializeThreads _initializeThreads;
+    DocumentDB::InitializeThreads _initializeIoThreads;
     std::shared_ptr<TaskRunner>   _taskRunner;
+    InitializerTask::SP           _rootTask;
     DocumentDBConfig::SP          _configSnapshot;
     DocumentDB&                   _self;
 public:
     InitDoneTask(DocumentDB::InitializeThreads initializeThreads,
+                 DocumentDB::InitializeThreads initializeIoThreads,
                  std::shared_ptr<TaskRunner> taskRunner,
+                 InitializerTask::SP rootTask,
                  DocumentDBConfig::SP configSnapshot,
                  DocumentDB& self)
         : _initializeThreads(std::move(initializeThreads)),
+          _initializeIoThreads(std::move(initializeIoThreads)),
           _taskRunner(std::move(taskRunner)),
+          _rootTask(std::move(rootTask)),
           _configSnapshot(std::move(configSnapshot)),
           _self(self)
     {
@@ -230,7 +241,7 @@ public:
     ~InitDoneTask();
 
     void run() override {
-        _self.initFinish(std::move(_configSnapshot));
+        _self.initFinish(std::move(_configSnapshot), TaskRunner::getTaskTimings(_rootTask));
     }
 };
 
@@ -246,17 +257,24 @@ DocumentDB::initManagers()
     InitializerTask::SP rootTask =
         _subDBs.createInitializer(*configSnapshot, _initConfigSerialNum, _protonIndexCfg);
     InitializeThreads initializeThreads = _initializeThreads;
+    InitializeThreads initializeIoThreads = _initializeIoThreads;
     _initializeThreads.reset();
-    std::shared_ptr<TaskRunner> taskRunner(std::make_shared<TaskRunner>(*initializeThreads));
-    auto doneTask = std::make_unique<InitDoneTask>(std::move(initializeThreads), taskRunner,
-                                                   std::move(configSnapshot), *this);
+    _initializeIoThreads.reset();
+    std::shared_ptr<TaskRunner> taskRunner(std::make_shared<TaskRunner>(*initializeThreads, initializeIoThreads.get()));
+    auto doneTask = std::make_unique<InitDoneTask>(std::move(initializeThreads), std::move(initializeIoThreads),
+                                                   taskRunner, rootTask, std::move(configSnapshot), *this);
     taskRunner->runTask(rootTask, _writeService.master(), std::move(doneTask));
 }
 
 void
-DocumentDB::initFinish(DocumentDBConfig::SP configSnapshot)
+DocumentDB::initFinish(DocumentDBConfig::SP configSnapshot,
+                       TaskRunner::TaskTimings initTaskTimings)
 {
     // Called by executor thread
+    {
+        lock_guard guard(_configMutex);
+        _initTaskTimings = std::move(initTaskTimings);
+    }
     _bucketHandler.setReadyBucketHandler(_subDBs.getReadySubDB()->getDocumentMetaStoreContext().get());
     _subDBs.initViews(*configSnapshot, _sessionManager);
     _syncFeedViewEnabled = true;
@@ -268,6 +286,13 @@ DocumentDB::initFinish(DocumentDBConfig::SP configSnapshot)
 }
 
 
+TaskRunner::TaskTimings
+DocumentDB::getInitializerTaskTimings() const
+{
+    lock_guard guard(_configMutex);
+    return _initTaskTimings;
+}
+
 void
 DocumentDB::newConfigSnapshot(DocumentDBConfig::SP snapshot)
 {
@@ -674,7 +699,8 @@ DocumentDB::startTransactionLogReplay()
                                       getBackingStore().lastSyncToken(),
                                       oldestFlushedSerial,
                                       newestFlushedSerial,
-                                      *_config_store);
+                                      *_config_store,
+                                      _writeServiceConfig.parallelReplay());
     _initGate.countDown();
 
     LOG(debug, "DocumentDB(%s): Database started.", _docTypeName.toString().c_str());
@@ -730,6 +756,13 @@ DocumentDB::getDocsums(const DocsumRequest & request)
     return view->getDocsums(request);
 }
 
+std::unique_ptr<DocsumReply>
+DocumentDB::getDocsums(const DocsumRequest & request, vespalib::ThreadBundle &threadBundle)
+{
+    ISearchHandler::SP view(_subDBs.getReadySubDB()->getSearchView());
+    return view->getDocsums(request, threadBundle);
+}
+
 IFlushTarget::List
 DocumentDB::getFlushTargets()
 {
@@ -1228,6 +1261,7 @@ DocumentDB::updateLegacyMetrics(LegacyDocumentDBMetrics &metrics)
     metrics.executor.update(_writeService.getMasterExecutor().getStats());
     metrics.summaryExecutor.update(_writeService.getSummaryExecutor().getStats());
     metrics.indexExecutor.update(_writeService.getIndexExecutor().getStats());
+    metrics.attributeExecutor.update(_writeService.getAttributeFieldWriter().getStats());
     metrics.sessionManager.update(_sessionManager->getGroupingStats());
     updateDocstoreMetrics(metrics.docstore, _subDBs, _lastDocStoreCacheStats);
     metrics.numDocs.set(getNumDocs());
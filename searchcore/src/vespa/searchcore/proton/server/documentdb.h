@@ -19,6 +19,7 @@
 #include "maintenancecontroller.h"
 #include "threading_service_config.h"
 #include "visibilityhandler.h"
+#include <vespa/searchcore/proton/initializer/task_runner.h>
 
 #include <vespa/metrics/updatehook.h>
 #include <vespa/searchcore/proton/attribute/attribute_usage_filter.h>
@@ -86,6 +87,8 @@ private:
     ExecutorThreadingService      _writeService;
     // threads for initializer tasks during proton startup
     InitializeThreads             _initializeThreads;
+    // optional threads for io bound initializer tasks, shared by all document dbs
+    InitializeThreads             _initializeIoThreads;
 
     typedef search::SerialNum      SerialNum;
     typedef fastos::TimeStamp      TimeStamp;
@@ -103,6 +106,7 @@ private:
     SerialNum                     _activeConfigSnapshotSerialNum;
 
     vespalib::Gate                _initGate;
+    initializer::TaskRunner::TaskTimings _initTaskTimings; // protected by _configMutex
 
     typedef DocumentDBConfig::ComparisonResult ConfigComparisonResult;
 
@@ -137,7 +141,8 @@ private:
     DocumentDBConfig::SP getActiveConfig() const;
     void internalInit();
     void initManagers();
-    void initFinish(DocumentDBConfig::SP configSnapshot);
+    void initFinish(DocumentDBConfig::SP configSnapshot,
+                    initializer::TaskRunner::TaskTimings initTaskTimings);
     void performReconfig(DocumentDBConfig::SP configSnapshot);
     void closeSubDBs();
 
@@ -226,6 +231,7 @@ public:
      *                 database.
      * @param tlsSpec The frt connection spec for the TLS.
      * @param docType The document type that this database will handle.
+     * @param constantValueFactory Factory for ranking constants, shared by all databases.
      * @param docMgrCfg Current document manager config
      * @param docMgrSP  The document manager holding the document type.
      * @param protonCfg The global proton config this database is a part of.
@@ -237,6 +243,7 @@ public:
                const vespalib::string &tlsSpec,
                matching::QueryLimiter &queryLimiter,
                const vespalib::Clock &clock,
+               const vespalib::eval::ConstantValueFactory &constantValueFactory,
                const DocTypeName &docTypeName,
                document::BucketSpace bucketSpace,
                const ProtonConfig &protonCfg,
@@ -248,6 +255,7 @@ public:
                const search::common::FileHeaderContext &fileHeaderContext,
                ConfigStore::UP config_store,
                InitializeThreads initializeThreads,
+               InitializeThreads initializeIoThreads,
                const HwInfo &hwInfo);
 
     /**
@@ -258,6 +266,12 @@ public:
         return *_sessionManager;
     }
 
+    /**
+     * Run time of each initializer task used when loading this
+     * document db, empty until initialization is done.
+     **/
+    initializer::TaskRunner::TaskTimings getInitializerTaskTimings() const;
+
     /**
      * Frees any allocated resources. This will also stop the internal thread
      * and wait for it to finish. All pending tasks are deleted.
@@ -370,6 +384,9 @@ public:
     std::unique_ptr<search::engine::DocsumReply>
     getDocsums(const search::engine::DocsumRequest & request);
 
+    std::unique_ptr<search::engine::DocsumReply>
+    getDocsums(const search::engine::DocsumRequest & request, vespalib::ThreadBundle &threadBundle);
+
     IFlushTargetList getFlushTargets();
     void flushDone(SerialNum flushedSerial);
 
@@ -129,7 +129,9 @@ buildMaintenanceConfig(const BootstrapConfig::SP &bootstrapConfig,
                     proton.lidspacecompaction.interval,
                     proton.lidspacecompaction.allowedlidbloat,
                     proton.lidspacecompaction.allowedlidbloatfactor,
-                    isDocumentTypeGlobal),
+                    isDocumentTypeGlobal,
+                    DocumentDBLidSpaceCompactionConfig().getMaxDocsToScan(),
+                    proton.lidspacecompaction.maxdocstomove),
             AttributeUsageFilterConfig(
                     proton.writefilter.attribute.enumstorelimit,
                     proton.writefilter.attribute.multivaluelimit),
@@ -158,7 +160,10 @@ deriveCompression(const T & config) {
 DocumentStore::Config
 getStoreConfig(const ProtonConfig::Summary::Cache & cache)
 {
-    return DocumentStore::Config(deriveCompression(cache.compression), cache.maxbytes, cache.initialentries).allowVisitCaching(cache.allowvisitcaching);
+    return DocumentStore::Config(deriveCompression(cache.compression), cache.maxbytes, cache.initialentries)
+            .allowVisitCaching(cache.allowvisitcaching)
+            .cacheShards(cache.shards)
+            .cacheAdmissionWindow(cache.admissionwindow);
 }
 
 LogDocumentStore::Config
@@ -173,6 +178,9 @@ deriveConfig(const ProtonConfig::Summary & summary, const ProtonConfig::Flush::M
     logConfig.setMaxFileSize(log.maxfilesize)
             .setMaxDiskBloatFactor(std::min(flush.diskbloatfactor, flush.each.diskbloatfactor))
             .setMaxBucketSpread(log.maxbucketspread).setMinFileSizeFactor(log.minfilesizefactor)
+            .setMaxDictionarySize(chunk.dictionary.maxbytes)
+            .setWriteBufferBytes(log.writebuffer.maxbytes)
+            .setMaxCompactReadBytesPerSecond(log.compact.maxreadbytespersecond)
             .compact2ActiveFile(log.compact2activefile).compactCompression(deriveCompression(log.compact.compression))
             .setFileConfig(fileConfig).disableCrcOnRead(chunk.skipcrconread);
     return LogDocumentStore::Config(config, logConfig);
@@ -8,6 +8,7 @@
 #include "maintenancecontroller.h"
 #include "searchabledocsubdb.h"
 
+#include <vespa/searchcore/proton/attribute/attribute_load_limiter.h>
 #include <vespa/searchcore/proton/metrics/documentdb_metrics_collection.h>
 
 using proton::matching::SessionManager;
@@ -30,6 +31,7 @@ DocumentSubDBCollection::DocumentSubDBCollection(
         DocumentDBMetricsCollection &metrics,
         matching::QueryLimiter &queryLimiter,
         const vespalib::Clock &clock,
+        const vespalib::eval::ConstantValueFactory &constantValueFactory,
         std::mutex &configMutex,
         const vespalib::string &baseDir,
         const ProtonConfig &protonCfg,
@@ -43,7 +45,8 @@ DocumentSubDBCollection::DocumentSubDBCollection(
       _retrievers(),
       _reprocessingRunner(),
       _bucketDB(),
-      _bucketDBHandler()
+      _bucketDBHandler(),
+      _attributeLoadLimiter()
 {
     const ProtonConfig::Grow & growCfg = protonCfg.grow;
     const ProtonConfig::Distribution & distCfg = protonCfg.distribution;
@@ -54,6 +57,11 @@ DocumentSubDBCollection::DocumentSubDBCollection(
     search::GrowStrategy notReadyGrowth(growCfg.initial * (distCfg.redundancy - distCfg.searchablecopies), growCfg.factor, growCfg.add);
     size_t attributeGrowNumDocs(growCfg.numdocs);
     size_t numSearcherThreads = protonCfg.numsearcherthreads;
+    uint32_t reprocessingReaderTaskLimit = protonCfg.reprocessing.readertasklimit;
+    const ProtonConfig::Initialize::Attributes & attributesInitCfg = protonCfg.initialize.attributes;
+    uint32_t attributeLoadThreads = (attributesInitCfg.threads > 0) ? attributesInitCfg.threads : hwInfo.cpu().cores();
+    uint64_t attributeLoadMemoryLimit = attributesInitCfg.memorylimit * hwInfo.memory().sizeBytes();
+    _attributeLoadLimiter = std::make_unique<AttributeLoadLimiter>(attributeLoadThreads, attributeLoadMemoryLimit);
 
     StoreOnlyDocSubDB::Context context(owner,
                                        tlSyncer,
@@ -78,16 +86,19 @@ DocumentSubDBCollection::DocumentSubDBCollection(
                         SubDbType::READY),
                         true,
                         true,
-                        false),
+                        false,
+                        reprocessingReaderTaskLimit),
                         numSearcherThreads),
                 SearchableDocSubDB::Context(FastAccessDocSubDB::Context
                         (context,
                          AttributeMetricsCollection(metrics.getTaggedMetrics().ready.attributes,
                                                     metrics.getLegacyMetrics().ready.attributes),
                         &metrics.getLegacyMetrics().attributes,
-                        metricsWireService),
+                        metricsWireService,
+                        *_attributeLoadLimiter),
                         queryLimiter,
                         clock,
+                        constantValueFactory,
                         warmupExecutor)));
     _subDBs.push_back
         (new StoreOnlyDocSubDB(StoreOnlyDocSubDB::Config(docTypeName,
@@ -109,12 +120,14 @@ DocumentSubDBCollection::DocumentSubDBCollection(
                         SubDbType::NOTREADY),
                         true,
                         true,
-                        true),
+                        true,
+                        reprocessingReaderTaskLimit),
                 FastAccessDocSubDB::Context(context,
                         AttributeMetricsCollection(metrics.getTaggedMetrics().notReady.attributes,
                                                    metrics.getLegacyMetrics().notReady.attributes),
                         NULL,
-                        metricsWireService)));
+                        metricsWireService,
+                        *_attributeLoadLimiter)));
 }
 
 
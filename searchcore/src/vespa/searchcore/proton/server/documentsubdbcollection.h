@@ -12,6 +12,7 @@ namespace vespalib {
     class Clock;
     class ThreadExecutor;
     class ThreadStackExecutorBase;
+    namespace eval { struct ConstantValueFactory; }
 }
 
 namespace search {
@@ -25,6 +26,7 @@ namespace searchcorespi {
 }
 
 namespace proton {
+class AttributeLoadLimiter;
 class DocumentDBConfig;
 class DocumentDBMetricsCollection;
 class MaintenanceController;
@@ -73,6 +75,7 @@ private:
     ReprocessingRunner _reprocessingRunner;
     std::shared_ptr<BucketDBOwner> _bucketDB;
     std::unique_ptr<bucketdb::BucketDBHandler> _bucketDBHandler;
+    std::unique_ptr<AttributeLoadLimiter> _attributeLoadLimiter;
 
 public:
     DocumentSubDBCollection(
@@ -88,6 +91,7 @@ public:
             DocumentDBMetricsCollection &metrics,
             matching::QueryLimiter & queryLimiter,
             const vespalib::Clock &clock,
+            const vespalib::eval::ConstantValueFactory &constantValueFactory,
             std::mutex &configMutex,
             const vespalib::string &baseDir,
             const vespa::config::search::core::ProtonConfig &protonCfg,
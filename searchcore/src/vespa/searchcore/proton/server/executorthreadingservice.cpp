@@ -9,7 +9,8 @@ namespace proton {
 
 ExecutorThreadingService::ExecutorThreadingService(uint32_t threads,
                                                    uint32_t stackSize,
-                                                   uint32_t taskLimit)
+                                                   uint32_t taskLimit,
+                                                   bool rebalanceAttributeWriter)
 
     : _masterExecutor(1, stackSize),
       _indexExecutor(1, stackSize, taskLimit),
@@ -19,7 +20,7 @@ ExecutorThreadingService::ExecutorThreadingService(uint32_t threads,
       _summaryService(_summaryExecutor),
       _indexFieldInverter(threads, taskLimit),
       _indexFieldWriter(threads, taskLimit),
-      _attributeFieldWriter(threads, taskLimit)
+      _attributeFieldWriter(threads, taskLimit, rebalanceAttributeWriter)
 {
 }
 
@@ -32,10 +32,12 @@ public:
      *
      * @stackSize The size of the stack of the underlying executors.
      * @taskLimit The task limit for the index executor.
+     * @rebalanceAttributeWriter Move attributes between attribute field writer threads based on load.
      */
     ExecutorThreadingService(uint32_t threads = 1,
                              uint32_t stackSize = 128 * 1024,
-                             uint32_t taskLimit = 1000);
+                             uint32_t taskLimit = 1000,
+                             bool rebalanceAttributeWriter = false);
     ~ExecutorThreadingService();
 
     /**
@@ -59,6 +61,9 @@ public:
     vespalib::ThreadStackExecutorBase &getSummaryExecutor() {
         return _summaryExecutor;
     }
+    search::SequencedTaskExecutor &getAttributeFieldWriter() {
+        return _attributeFieldWriter;
+    }
 
     /**
      * Implements IThreadingService
@@ -73,16 +73,19 @@ FastAccessDocSubDB::createAttributeManagerInitializer(const DocumentDBConfig &co
                                                _writeService.attributeFieldWriter(),
                                                attrFactory,
                                                _hwInfo);
-    return std::make_shared<AttributeManagerInitializer>(configSerialNum,
-                                                         documentMetaStoreInitTask,
-                                                         documentMetaStore,
-                                                         baseAttrMgr,
-                                                         (_hasAttributes ? configSnapshot.getAttributesConfig() : AttributesConfig()),
-                                                         _attributeGrow,
-                                                         _attributeGrowNumDocs,
-                                                         _fastAccessAttributesOnly,
-                                                         _writeService.master(),
-                                                         attrMgrResult);
+    auto task = std::make_shared<AttributeManagerInitializer>(configSerialNum,
+                                                            documentMetaStoreInitTask,
+                                                            documentMetaStore,
+                                                            baseAttrMgr,
+                                                            (_hasAttributes ? configSnapshot.getAttributesConfig() : AttributesConfig()),
+                                                            _attributeGrow,
+                                                            _attributeGrowNumDocs,
+                                                            _fastAccessAttributesOnly,
+                                                            _writeService.master(),
+                                                            _attributeLoadLimiter,
+                                                            attrMgrResult);
+    task->setName(getSubDbName() + ".attribute");
+    return task;
 }
 
 void
@@ -195,17 +198,20 @@ FastAccessDocSubDB::createReprocessingTask(IReprocessingInitializer &initializer
             getSummaryManager(),
             docTypeRepo,
             getSubDbName(),
-            docIdLimit));
+            docIdLimit,
+            _reprocessingReaderTaskLimit));
 }
 
 FastAccessDocSubDB::FastAccessDocSubDB(const Config &cfg, const Context &ctx)
     : Parent(cfg._storeOnlyCfg, ctx._storeOnlyCtx),
       _hasAttributes(cfg._hasAttributes),
       _fastAccessAttributesOnly(cfg._fastAccessAttributesOnly),
+      _reprocessingReaderTaskLimit(cfg._reprocessingReaderTaskLimit),
       _initAttrMgr(),
       _fastAccessFeedView(),
       _subAttributeMetrics(ctx._subAttributeMetrics),
       _totalAttributeMetrics(ctx._totalAttributeMetrics),
+      _attributeLoadLimiter(ctx._attributeLoadLimiter),
       _addMetrics(cfg._addMetrics),
       _metricsWireService(ctx._metricsWireService),
       _docIdLimit(0)
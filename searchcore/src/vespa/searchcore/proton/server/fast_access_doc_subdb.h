@@ -10,6 +10,8 @@
 
 namespace proton {
 
+class AttributeLoadLimiter;
+
 /**
  * The fast-access sub database keeps fast-access attribute fields in memory
  * in addition to the underlying document store managed by the parent class.
@@ -31,14 +33,17 @@ public:
         const bool                      _hasAttributes;
         const bool                      _addMetrics;
         const bool                      _fastAccessAttributesOnly;
+        const uint32_t                  _reprocessingReaderTaskLimit;
         Config(const StoreOnlyDocSubDB::Config &storeOnlyCfg,
                bool hasAttributes,
                bool addMetrics,
-               bool fastAccessAttributesOnly)
+               bool fastAccessAttributesOnly,
+               uint32_t reprocessingReaderTaskLimit = 0)
         : _storeOnlyCfg(storeOnlyCfg),
           _hasAttributes(hasAttributes),
           _addMetrics(addMetrics),
-          _fastAccessAttributesOnly(fastAccessAttributesOnly)
+          _fastAccessAttributesOnly(fastAccessAttributesOnly),
+          _reprocessingReaderTaskLimit(reprocessingReaderTaskLimit)
         { }
     };
 
@@ -48,14 +53,17 @@ public:
         const AttributeMetricsCollection &_subAttributeMetrics;
         LegacyAttributeMetrics          *_totalAttributeMetrics;
         MetricsWireService              &_metricsWireService;
+        AttributeLoadLimiter            &_attributeLoadLimiter;
         Context(const StoreOnlyDocSubDB::Context &storeOnlyCtx,
                 const AttributeMetricsCollection &subAttributeMetrics,
                 LegacyAttributeMetrics *totalAttributeMetrics,
-                MetricsWireService &metricsWireService)
+                MetricsWireService &metricsWireService,
+                AttributeLoadLimiter &attributeLoadLimiter)
         : _storeOnlyCtx(storeOnlyCtx),
           _subAttributeMetrics(subAttributeMetrics),
           _totalAttributeMetrics(totalAttributeMetrics),
-          _metricsWireService(metricsWireService)
+          _metricsWireService(metricsWireService),
+          _attributeLoadLimiter(attributeLoadLimiter)
         { }
     };
 
@@ -65,10 +73,12 @@ private:
 
     const bool                    _hasAttributes;
     const bool                    _fastAccessAttributesOnly;
+    const uint32_t                _reprocessingReaderTaskLimit;
     AttributeManager::SP          _initAttrMgr;
     Configurer::FeedViewVarHolder _fastAccessFeedView;
     AttributeMetricsCollection    _subAttributeMetrics;
     LegacyAttributeMetrics       *_totalAttributeMetrics;
+    AttributeLoadLimiter         &_attributeLoadLimiter;
 
     std::shared_ptr<initializer::InitializerTask>
     createAttributeManagerInitializer(const DocumentDBConfig &configSnapshot,
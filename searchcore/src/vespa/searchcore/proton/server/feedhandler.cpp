@@ -368,13 +368,16 @@ FeedHandler::close()
 void
 FeedHandler::replayTransactionLog(SerialNum flushedIndexMgrSerial, SerialNum flushedSummaryMgrSerial,
                                   SerialNum oldestFlushedSerial, SerialNum newestFlushedSerial,
-                                  ConfigStore &config_store)
+                                  ConfigStore &config_store, bool parallelDeserialize)
 {
     (void) newestFlushedSerial;
     assert(_activeFeedView);
     assert(_bucketDBHandler);
+    search::ISequencedTaskExecutor *deserializeExecutor =
+        parallelDeserialize ? &_writeService.attributeFieldWriter() : nullptr;
     FeedState::SP state = make_shared<ReplayTransactionLogState>
-                          (getDocTypeName(), _activeFeedView, *_bucketDBHandler, _replayConfig, config_store);
+                          (getDocTypeName(), _activeFeedView, *_bucketDBHandler, _replayConfig, config_store,
+                           deserializeExecutor);
     changeFeedState(state);
     // Resurrected attribute vector might cause oldestFlushedSerial to
     // be lower than _prunedSerialNum, so don't warn for now.
@@ -177,6 +177,9 @@ public:
      * @param flushedSummaryMgrSerial The flushed serial number of the
      *                                document store.
      * @param config_store            Reference to the config store.
+     * @param parallelDeserialize     Whether to deserialize the replayed
+     *                                operations in parallel on the
+     *                                attribute field writer executor.
      */
 
     void
@@ -184,7 +187,8 @@ public:
                          SerialNum flushedSummaryMgrSerial,
                          SerialNum oldestFlushedSerial,
                          SerialNum newestFlushedSerial,
-                         ConfigStore &config_store);
+                         ConfigStore &config_store,
+                         bool parallelDeserialize = false);
 
     /**
      * Called when a flush is done and allows pruning of the transaction log.
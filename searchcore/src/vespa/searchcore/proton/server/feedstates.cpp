@@ -8,8 +8,11 @@
 #include <vespa/searchcore/proton/bucketdb/ibucketdbhandler.h>
 #include <vespa/searchcore/proton/common/eventlogger.h>
 #include <vespa/searchlib/common/idestructorcallback.h>
+#include <vespa/searchlib/common/isequencedtaskexecutor.h>
 #include <vespa/vespalib/util/closuretask.h>
+#include <vespa/vespalib/util/count_down_latch.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/lambdatask.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.server.feedstates");
@@ -17,6 +20,7 @@ LOG_SETUP(".proton.server.feedstates");
 using search::transactionlog::Packet;
 using search::transactionlog::RPC;
 using search::SerialNum;
+using search::ISequencedTaskExecutor;
 using vespalib::Executor;
 using vespalib::IllegalStateException;
 using vespalib::makeClosure;
@@ -31,6 +35,11 @@ typedef vespalib::Closure1<const Packet::Entry &>::UP EntryHandler;
 
 const search::SerialNum REPLAY_PROGRESS_INTERVAL = 50000;
 
+// Number of packet entries deserialized by each task during parallel replay
+const size_t DESERIALIZE_ENTRIES_PER_TASK = 32;
+// Number of component ids used to spread deserialize tasks over the executors
+const uint64_t DESERIALIZE_PARTITIONS = 64;
+
 void
 handleProgress(TlsReplayProgress &progress, SerialNum currentSerial)
 {
@@ -62,6 +71,95 @@ handlePacket(PacketWrapper::SP wrap, EntryHandler entryHandler)
     wrap->gate.countDown();
 }
 
+std::vector<FeedOperation::UP>
+deserializeEntries(const std::vector<Packet::Entry> &entries, size_t begin, size_t end,
+                   const document::DocumentTypeRepo &repo, ISequencedTaskExecutor &executor)
+{
+    size_t numEntries = end - begin;
+    std::vector<FeedOperation::UP> ops(numEntries);
+    size_t numTasks = (numEntries + DESERIALIZE_ENTRIES_PER_TASK - 1) / DESERIALIZE_ENTRIES_PER_TASK;
+    if (numTasks <= 1) {
+        for (size_t i = 0; i < numEntries; ++i) {
+            ops[i] = ReplayPacketDispatcher::deserializeEntry(entries[begin + i], repo);
+        }
+        return ops;
+    }
+    vespalib::CountDownLatch latch(numTasks);
+    std::vector<std::exception_ptr> failures(numTasks);
+    for (size_t task = 0; task < numTasks; ++task) {
+        size_t taskBegin = task * DESERIALIZE_ENTRIES_PER_TASK;
+        size_t taskEnd = std::min(taskBegin + DESERIALIZE_ENTRIES_PER_TASK, numEntries);
+        executor.execute(task % DESERIALIZE_PARTITIONS,
+                         [&entries, &repo, &ops, &failures, &latch, begin, task, taskBegin, taskEnd]() {
+            try {
+                for (size_t i = taskBegin; i < taskEnd; ++i) {
+                    ops[i] = ReplayPacketDispatcher::deserializeEntry(entries[begin + i], repo);
+                }
+            } catch (...) {
+                failures[task] = std::current_exception();
+            }
+            latch.countDown();
+        });
+    }
+    latch.await();
+    for (const auto &failure : failures) {
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+    }
+    return ops;
+}
+
+/**
+ * Replay a packet with the feed operations deserialized in parallel
+ * on the given executor. Operations are still replayed one by one in
+ * serial number order in the calling (master) thread, as lid
+ * allocation in the document meta store depends on that order. The
+ * attribute and index writes of the replayed operations are already
+ * spread over their own sequenced executors by the feed view.
+ */
+void
+handlePacketParallel(const PacketWrapper::SP &wrap, IReplayPacketHandler &packet_handler,
+                     ISequencedTaskExecutor &executor)
+{
+    std::vector<Packet::Entry> entries;
+    vespalib::nbostream_longlivedbuf handle(wrap->packet.getHandle().c_str(), wrap->packet.getHandle().size());
+    while (handle.size() > 0) {
+        entries.emplace_back();
+        entries.back().deserialize(handle);
+    }
+    ReplayPacketDispatcher dispatcher(packet_handler);
+    size_t begin = 0;
+    while (begin < entries.size()) {
+        // A new config might change the document type repo, so it splits the packet
+        size_t end = begin;
+        while ((end < entries.size()) && (entries[end].type() != FeedOperation::NEW_CONFIG)) {
+            ++end;
+        }
+        std::vector<FeedOperation::UP> ops = deserializeEntries(entries, begin, end,
+                                                                packet_handler.getDeserializeRepo(), executor);
+        if (end < entries.size()) {
+            ++end;
+        }
+        for (size_t i = begin; i < end; ++i) {
+            const Packet::Entry &entry = entries[i];
+            LOG(spam, "replay packet entry: entrySerial(%" PRIu64 "), entryType(%u)",
+                entry.serial(), entry.type());
+            if (i - begin < ops.size()) {
+                dispatcher.replayOperation(*ops[i - begin]);
+            } else {
+                dispatcher.replayEntry(entry);
+            }
+            if (wrap->progress != NULL) {
+                handleProgress(*wrap->progress, entry.serial());
+            }
+        }
+        begin = end;
+    }
+    wrap->result = RPC::OK;
+    wrap->gate.countDown();
+}
+
 class TransactionLogReplayPacketHandler : public IReplayPacketHandler {
     IFeedView *& _feed_view_ptr;  // Pointer can be changed in executor thread.
     IBucketDBHandler &_bucketDBHandler;
@@ -150,16 +248,26 @@ ReplayTransactionLogState::ReplayTransactionLogState(
         IFeedView *& feed_view_ptr,
         IBucketDBHandler &bucketDBHandler,
         IReplayConfig &replay_config,
-        FeedConfigStore &config_store)
+        FeedConfigStore &config_store,
+        ISequencedTaskExecutor *deserializeExecutor)
     : FeedState(REPLAY_TRANSACTION_LOG),
       _doc_type_name(name),
       _packet_handler(new TransactionLogReplayPacketHandler(
                       feed_view_ptr, bucketDBHandler,
-                      replay_config, config_store)) {
+                      replay_config, config_store)),
+      _deserializeExecutor(deserializeExecutor) {
 }
 
 void ReplayTransactionLogState::receive(const PacketWrapper::SP &wrap,
                                         Executor &executor) {
+    if (_deserializeExecutor != nullptr) {
+        IReplayPacketHandler &packet_handler = *_packet_handler;
+        ISequencedTaskExecutor &deserializeExecutor = *_deserializeExecutor;
+        executor.execute(vespalib::makeLambdaTask([wrap, &packet_handler, &deserializeExecutor]() {
+            handlePacketParallel(wrap, packet_handler, deserializeExecutor);
+        }));
+        return;
+    }
     EntryHandler closure = makeClosure(&startDispatch, _packet_handler.get());
     executor.execute(makeTask(makeClosure(&handlePacket, wrap, std::move(closure))));
 }
@@ -6,6 +6,8 @@
 #include <vespa/searchcore/proton/server/feedstate.h>
 #include <vespa/searchcore/proton/server/ireplaypackethandler.h>
 
+namespace search { class ISequencedTaskExecutor; }
+
 namespace proton {
 
 /**
@@ -45,17 +47,21 @@ public:
 /**
  * The feed handler is replaying the transaction log.
  * Replayed messages from the transaction log are sent to the active feed view.
+ * If a deserialize executor is given, the operations in each packet are
+ * deserialized in parallel on it before being replayed in order.
  */
 class ReplayTransactionLogState : public FeedState {
     vespalib::string _doc_type_name;
     std::unique_ptr<IReplayPacketHandler> _packet_handler;
+    search::ISequencedTaskExecutor *_deserializeExecutor;
 
 public:
     ReplayTransactionLogState(const vespalib::string &name,
             IFeedView *& feed_view_ptr,
             bucketdb::IBucketDBHandler &bucketDBHandler,
             IReplayConfig &replay_config,
-            FeedConfigStore &config_store);
+            FeedConfigStore &config_store,
+            search::ISequencedTaskExecutor *deserializeExecutor = nullptr);
 
     virtual void handleOperation(FeedToken, FeedOperation::UP op) override {
         throwExceptionInHandleOperation(_doc_type_name, *op);
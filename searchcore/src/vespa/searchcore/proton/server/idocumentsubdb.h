@@ -37,6 +37,7 @@ class IReplayConfig;
 class ISearchHandler;
 class ISummaryAdapter;
 class ISummaryManager;
+class Matchers;
 class ReconfigParams;
 
 /**
@@ -111,6 +112,7 @@ public:
     virtual std::unique_ptr<IDocumentRetriever> getDocumentRetriever() = 0;
 
     virtual matching::MatchingStats getMatcherStats(const vespalib::string &rankProfile) const = 0;
+    virtual std::shared_ptr<Matchers> getMatchers() const = 0;
     virtual void close() = 0;
     virtual std::shared_ptr<IDocumentDBReference> getDocumentDBReference() = 0;
     virtual void tearDownReferences(IDocumentDBReferenceResolver &resolver) = 0;
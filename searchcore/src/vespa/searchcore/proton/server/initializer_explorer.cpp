@@ -0,0 +1,37 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "initializer_explorer.h"
+#include <vespa/vespalib/data/slime/cursor.h>
+
+using vespalib::slime::Cursor;
+using vespalib::slime::Inserter;
+
+namespace proton {
+
+InitializerExplorer::InitializerExplorer(initializer::TaskRunner::TaskTimings timings)
+    : _timings(std::move(timings))
+{
+}
+
+void
+InitializerExplorer::get_state(const Inserter &inserter, bool full) const
+{
+    Cursor &object = inserter.insertObject();
+    double totalSeconds = 0.0;
+    for (const auto &timing : _timings) {
+        totalSeconds += timing.seconds;
+    }
+    object.setLong("tasks", _timings.size());
+    object.setDouble("totalTaskSeconds", totalSeconds);
+    if (full) {
+        Cursor &array = object.setArray("allTasks");
+        for (const auto &timing : _timings) {
+            Cursor &task = array.addObject();
+            task.setString("name", timing.name);
+            task.setDouble("seconds", timing.seconds);
+            task.setBool("ioBound", timing.ioBound);
+        }
+    }
+}
+
+} // namespace proton
@@ -0,0 +1,26 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchcore/proton/initializer/task_runner.h>
+#include <vespa/vespalib/net/state_explorer.h>
+
+namespace proton {
+
+/**
+ * Class used to explore the run time of the initializer tasks used when
+ * loading a document database.
+ */
+class InitializerExplorer : public vespalib::StateExplorer
+{
+private:
+    initializer::TaskRunner::TaskTimings _timings;
+
+public:
+    InitializerExplorer(initializer::TaskRunner::TaskTimings timings);
+
+    // Implements vespalib::StateExplorer
+    virtual void get_state(const vespalib::slime::Inserter &inserter, bool full) const override;
+};
+
+} // namespace proton
@@ -45,25 +45,32 @@ LidSpaceCompactionJob::getNextDocument(const LidUsageStats &stats)
 bool
 LidSpaceCompactionJob::scanDocuments(const LidUsageStats &stats)
 {
-    if (_scanItr->valid()) {
-        DocumentMetaData document = getNextDocument(stats);
-        if (document.valid()) {
-            IFrozenBucketHandler::ExclusiveBucketGuard::UP bucketGuard = _frozenHandler.acquireExclusiveBucket(document.bucketId);
-            if ( ! bucketGuard ) {
-                // the job is blocked until the bucket for this document is thawed
-                setBlocked(BlockedReason::FROZEN_BUCKET);
-                _retryFrozenDocument = true;
-                return true;
-            } else {
-                MoveOperation::UP op = _handler.createMoveOperation(document, stats.getLowestFreeLid());
-                search::IDestructorCallback::SP context = _moveOpsLimiter->beginOperation();
-                _opStorer.storeOperation(*op, context);
-                _handler.handleMove(*op, std::move(context));
-                if (isBlocked(BlockedReason::OUTSTANDING_OPS)) {
-                    return true;
-                }
-            }
+    LidUsageStats currStats = stats;
+    uint32_t docsMoved = 0;
+    while (_scanItr->valid()) {
+        DocumentMetaData document = getNextDocument(currStats);
+        if (!document.valid()) {
+            break;
         }
+        IFrozenBucketHandler::ExclusiveBucketGuard::UP bucketGuard = _frozenHandler.acquireExclusiveBucket(document.bucketId);
+        if ( ! bucketGuard ) {
+            // the job is blocked until the bucket for this document is thawed
+            setBlocked(BlockedReason::FROZEN_BUCKET);
+            _retryFrozenDocument = true;
+            return true;
+        }
+        MoveOperation::UP op = _handler.createMoveOperation(document, currStats.getLowestFreeLid());
+        search::IDestructorCallback::SP context = _moveOpsLimiter->beginOperation();
+        _opStorer.storeOperation(*op, context);
+        _handler.handleMove(*op, std::move(context));
+        if (isBlocked(BlockedReason::OUTSTANDING_OPS)) {
+            return true;
+        }
+        if (++docsMoved >= _cfg.getMaxDocsToMove()) {
+            break;
+        }
+        // the move changed the lid usage, so the next document is moved to a new free lid
+        currStats = _handler.getLidStatus();
     }
     if (!_scanItr->valid()){
         if (shouldRestartScanDocuments(_handler.getLidStatus())) {
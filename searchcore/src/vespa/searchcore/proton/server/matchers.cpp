@@ -43,6 +43,18 @@ Matchers::getStats(const vespalib::string &name) const
         matching::MatchingStats();
 }
 
+std::map<vespalib::string, matching::Matcher::SP>
+Matchers::getProfilingMatchers() const
+{
+    std::map<vespalib::string, matching::Matcher::SP> result;
+    for (const auto &entry : _rpmap) {
+        if (entry.second->getSampledQueryLog() != nullptr) {
+            result[entry.first] = entry.second;
+        }
+    }
+    return result;
+}
+
 matching::Matcher::SP
 Matchers::lookup(const vespalib::string &name) const
 {
@@ -4,6 +4,7 @@
 
 #include <vespa/searchcore/proton/matching/matcher.h>
 #include <vespa/vespalib/stllike/hash_map.h>
+#include <map>
 
 namespace proton {
 
@@ -24,6 +25,8 @@ public:
     matching::MatchingStats getStats() const;
     matching::MatchingStats getStats(const vespalib::string &name) const;
     matching::Matcher::SP lookup(const vespalib::string &name) const;
+    // matchers profiling a sampled fraction of their queries, by rank profile
+    std::map<vespalib::string, matching::Matcher::SP> getProfilingMatchers() const;
 };
 
 } // namespace proton
@@ -0,0 +1,74 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "matchers_explorer.h"
+#include <vespa/vespalib/data/slime/slime.h>
+
+using proton::matching::SampledQueryLog;
+using search::fef::FeatureProfiler;
+using vespalib::slime::Cursor;
+using vespalib::slime::Inserter;
+
+namespace proton {
+
+namespace {
+
+void
+convertQueryToSlime(const SampledQueryLog::Entry &query, bool full, Cursor &object)
+{
+    object.setDouble("totalTime", query.total_time);
+    object.setDouble("setupTime", query.setup_time);
+    object.setDouble("matchTime", query.match_time);
+    object.setDouble("groupingTime", query.grouping_time);
+    object.setDouble("rerankTime", query.rerank_time);
+    object.setLong("docsMatched", query.docs_matched);
+    object.setLong("docsRanked", query.docs_ranked);
+    object.setLong("docsReRanked", query.docs_reranked);
+    object.setLong("threads", query.threads);
+    if (full) {
+        object.setString("blueprint", query.blueprint);
+    }
+}
+
+double
+toSeconds(FeatureProfiler::duration time)
+{
+    return std::chrono::duration<double>(time).count();
+}
+
+void
+convertFeatureToSlime(const FeatureProfiler::Stats &feature, Cursor &object)
+{
+    object.setString("name", feature.name);
+    object.setLong("count", feature.count);
+    object.setDouble("selfTime", toSeconds(feature.self_time));
+    object.setDouble("totalTime", toSeconds(feature.total_time));
+}
+
+}
+
+MatchersExplorer::MatchersExplorer(Matchers::SP matchers)
+    : _matchers(std::move(matchers))
+{
+}
+
+void
+MatchersExplorer::get_state(const Inserter &inserter, bool full) const
+{
+    Cursor &object = inserter.insertObject();
+    for (const auto &entry : _matchers->getProfilingMatchers()) {
+        const SampledQueryLog &log = *entry.second->getSampledQueryLog();
+        Cursor &rankProfile = object.setObject(entry.first);
+        rankProfile.setDouble("sampleFraction", log.getSampleFraction());
+        rankProfile.setLong("sampledQueries", log.numSampled());
+        Cursor &queries = rankProfile.setArray("slowestQueries");
+        for (const auto &query : log.getEntries()) {
+            convertQueryToSlime(query, full, queries.addObject());
+        }
+        Cursor &features = rankProfile.setArray("featureCost");
+        for (const auto &feature : log.getFeatureProfile()) {
+            convertFeatureToSlime(feature, features.addObject());
+        }
+    }
+}
+
+} // namespace proton
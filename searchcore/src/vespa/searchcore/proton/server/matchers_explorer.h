@@ -0,0 +1,26 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "matchers.h"
+#include <vespa/vespalib/net/state_explorer.h>
+
+namespace proton {
+
+/**
+ * Class used to explore the profiled queries of the matchers in a
+ * document sub database.
+ */
+class MatchersExplorer : public vespalib::StateExplorer
+{
+private:
+    Matchers::SP _matchers;
+
+public:
+    MatchersExplorer(Matchers::SP matchers);
+
+    // Implements vespalib::StateExplorer
+    virtual void get_state(const vespalib::slime::Inserter &inserter, bool full) const override;
+};
+
+} // namespace proton
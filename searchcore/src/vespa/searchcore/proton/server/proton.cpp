@@ -22,6 +22,8 @@
 #include <vespa/searchcommon/common/schemaconfigurer.h>
 #include <vespa/document/base/exceptions.h>
 #include <vespa/document/datatype/documenttype.h>
+#include <vespa/eval/eval/llvm/compile_cache.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/util/closuretask.h>
 #include <vespa/vespalib/util/host_name.h>
@@ -36,6 +38,7 @@ LOG_SETUP(".proton.server.proton");
 using document::DocumentTypeRepo;
 using vespalib::FileHeader;
 using vespalib::IllegalStateException;
+using vespalib::eval::CompileCache;
 using vespalib::Slime;
 using vespalib::slime::ArrayInserter;
 using vespalib::slime::Cursor;
@@ -94,6 +97,7 @@ deriveCompactionCompressionThreads(const ProtonConfig &proton,
 }
 
 const vespalib::string CUSTOM_COMPONENT_API_PATH = "/state/v1/custom/component";
+const vespalib::string CPU_PROFILE_API_PATH = "/state/v1/profile";
 
 }
 
@@ -182,6 +186,9 @@ Proton::Proton(const config::ConfigUri & configUri,
       _genericStateHandler(CUSTOM_COMPONENT_API_PATH, *this),
       _customComponentBindToken(),
       _customComponentRootToken(),
+      _cpuProfileHandler(),
+      _cpuProfileBindToken(),
+      _cpuProfileRootToken(),
       _stateServer(),
       _fs4Server(),
       // This executor can only have 1 thread as it is used for
@@ -191,6 +198,8 @@ Proton::Proton(const config::ConfigUri & configUri,
       _protonConfigFetcher(configUri, _protonConfigurer, subscribeTimeout),
       _warmupExecutor(),
       _summaryExecutor(),
+      _tensorLoader(),
+      _constantValueCache(),
       _queryLimiter(),
       _clock(0.010),
       _threadPool(128 * 1024),
@@ -202,6 +211,7 @@ Proton::Proton(const config::ConfigUri & configUri,
       _initStarted(false),
       _initComplete(false),
       _initDocumentDbsInSequence(false),
+      _initializeIoThreads(),
       _hwInfo(),
       _hwInfoSampler(),
       _documentDBReferenceRegistry()
@@ -254,9 +264,12 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
     _tls.reset(new TLS(_configUri.createWithNewId(protonConfig.tlsconfigid), _fileHeaderContext));
     _matchEngine.reset(new MatchEngine(protonConfig.numsearcherthreads,
                                        protonConfig.numthreadspersearch,
-                                       protonConfig.distributionkey));
+                                       protonConfig.distributionkey,
+                                       protonConfig.numaawaresearch,
+                                       protonConfig.adaptivethreadspersearch));
+    _matchEngine->setAdmissionControl(protonConfig.search.admission.enabled);
     _distributionKey = protonConfig.distributionkey;
-    _summaryEngine.reset(new SummaryEngine(protonConfig.numsummarythreads));
+    _summaryEngine.reset(new SummaryEngine(protonConfig.numsummarythreads, protonConfig.numthreadspersummary));
     _docsumBySlime.reset(new DocsumBySlime(*_summaryEngine));
     IFlushStrategy::SP strategy;
     const ProtonConfig::Flush & flush(protonConfig.flush);
@@ -276,6 +289,10 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
     }
     vespalib::mkdir(protonConfig.basedir + "/documents", true);
     vespalib::chdir(protonConfig.basedir);
+    // Ranking constants are shared by all document dbs, and parsed tensors are cached on disk across restarts
+    _tensorLoader = std::make_unique<vespalib::eval::ConstantTensorLoader>(vespalib::tensor::DefaultTensorEngine::ref(),
+                                                                           protonConfig.basedir + "/rank_constants");
+    _constantValueCache = std::make_unique<vespalib::eval::ConstantValueCache>(*_tensorLoader);
     _tls->start();
     _flushEngine.reset(new FlushEngine(std::make_shared<flushengine::TlsStatsFactory>(_tls->getTransLogServer()),
                                        strategy, flush.maxconcurrent, flush.idleinterval*1000));
@@ -303,8 +320,12 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
         initializeThreads = std::make_shared<vespalib::ThreadStackExecutor>(protonConfig.initialize.threads, 128 * 1024);
         _initDocumentDbsInSequence = (protonConfig.initialize.threads == 1);
     }
+    if (protonConfig.initialize.iothreads > 0) {
+        _initializeIoThreads = std::make_shared<vespalib::ThreadStackExecutor>(protonConfig.initialize.iothreads, 128 * 1024);
+    }
     _protonConfigurer.applyInitialConfig(initializeThreads);
     initializeThreads.reset();
+    _initializeIoThreads.reset();
 
     RPCHooks::Params rpcParams(*this, protonConfig.rpcport, _configUri.getConfigId());
     rpcParams.slobrok_config = _configUri.createWithNewId(protonConfig.slobrokconfigid);
@@ -316,6 +337,12 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
     _stateServer.reset(new vespalib::StateServer(protonConfig.httpport, _healthAdapter, _metricsEngine->metrics_producer(), *this));
     _customComponentBindToken = _stateServer->repo().bind(CUSTOM_COMPONENT_API_PATH, _genericStateHandler);
     _customComponentRootToken = _stateServer->repo().add_root_resource(CUSTOM_COMPONENT_API_PATH);
+    if (protonConfig.cpuprofile.enabled) {
+        _cpuProfileHandler = std::make_unique<vespalib::CpuProfileHandler>(protonConfig.cpuprofile.defaultseconds,
+                                                                           protonConfig.cpuprofile.maxseconds);
+        _cpuProfileBindToken = _stateServer->repo().bind(CPU_PROFILE_API_PATH, *_cpuProfileHandler);
+        _cpuProfileRootToken = _stateServer->repo().add_root_resource(CPU_PROFILE_API_PATH);
+    }
 
     _executor.sync();
     waitForOnlineState();
@@ -348,7 +375,11 @@ Proton::applyConfig(const BootstrapConfig::SP & configSnapshot)
 
     _queryLimiter.configure(protonConfig.search.memory.limiter.maxthreads,
                             protonConfig.search.memory.limiter.mincoverage,
-                            protonConfig.search.memory.limiter.minhits);
+                            protonConfig.search.memory.limiter.minhits,
+                            protonConfig.search.memory.limiter.maxcost);
+    if (_matchEngine) {
+        _matchEngine->setAdmissionControl(protonConfig.search.admission.enabled);
+    }
     const DocumentTypeRepo::SP repo = configSnapshot->getDocumentTypeRepoSP();
 
     _diskMemUsageSampler->setConfig(diskMemUsageSamplerConfig(protonConfig, _hwInfo));
@@ -399,6 +430,8 @@ Proton::~Proton()
     _protonConfigFetcher.close();
     _protonConfigurer.setAllowReconfig(false);
     _executor.sync();
+    _cpuProfileRootToken.reset();
+    _cpuProfileBindToken.reset();
     _customComponentRootToken.reset();
     _customComponentBindToken.reset();
     _stateServer.reset();
@@ -446,6 +479,8 @@ Proton::~Proton()
     _tls.reset();
     _warmupExecutor.reset();
     _summaryExecutor.reset();
+    _constantValueCache.reset();
+    _tensorLoader.reset();
     _clock.stop();
     LOG(debug, "Explicit destructor done");
 }
@@ -534,6 +569,7 @@ Proton::addDocumentDB(const document::DocumentType &docType,
                                       config.tlsspec,
                                       _queryLimiter,
                                       _clock,
+                                      *_constantValueCache,
                                       docTypeName,
                                       bucketSpace,
                                       config,
@@ -545,6 +581,7 @@ Proton::addDocumentDB(const document::DocumentType &docType,
                                       _fileHeaderContext,
                                       std::move(config_store),
                                       initializeThreads,
+                                      (_isInitializing ? _initializeIoThreads : InitializeThreads()),
                                       _hwInfo));
     try {
         ret->start();
@@ -710,6 +747,11 @@ Proton::updateMetrics(const vespalib::MonitorGuard &)
         metrics.resourceUsage.memoryMappings.set(usageFilter.getMemoryStats().getMappingsCount());
         metrics.resourceUsage.openFileDescriptors.set(countOpenFiles());
         metrics.resourceUsage.feedingBlocked.set((usageFilter.acceptWriteOperation() ? 0.0 : 1.0));
+        CompileCache::Stats compileStats = CompileCache::get_stats();
+        metrics.rankingExpression.compiled.set(compileStats.num_compiled);
+        metrics.rankingExpression.cached.set(CompileCache::num_cached());
+        metrics.rankingExpression.compileTime.set(compileStats.total_compile_time_s);
+        metrics.rankingExpression.maxCompileTime.set(compileStats.max_compile_time_s);
     }
     {
         LegacyProtonMetrics &metrics = _metricsEngine->legacyRoot();
@@ -12,6 +12,8 @@
 #include "proton_configurer.h"
 #include "rpc_hooks.h"
 #include "bootstrapconfig.h"
+#include <vespa/eval/eval/value_cache/constant_tensor_loader.h>
+#include <vespa/eval/eval/value_cache/constant_value_cache.h>
 #include <vespa/searchcore/proton/common/hw_info.h>
 #include <vespa/searchcore/proton/flushengine/flushengine.h>
 #include <vespa/searchcore/proton/matchengine/matchengine.h>
@@ -27,6 +29,7 @@
 #include <vespa/searchlib/engine/transportserver.h>
 #include <vespa/searchlib/transactionlog/translogserverapp.h>
 #include <vespa/vespalib/net/component_config_producer.h>
+#include <vespa/vespalib/net/cpu_profile_handler.h>
 #include <vespa/vespalib/net/generic_state_handler.h>
 #include <vespa/vespalib/net/json_get_handler.h>
 #include <vespa/vespalib/net/state_explorer.h>
@@ -106,6 +109,9 @@ private:
     vespalib::GenericStateHandler   _genericStateHandler;
     vespalib::JsonHandlerRepo::Token::UP _customComponentBindToken;
     vespalib::JsonHandlerRepo::Token::UP _customComponentRootToken;
+    std::unique_ptr<vespalib::CpuProfileHandler> _cpuProfileHandler;
+    vespalib::JsonHandlerRepo::Token::UP _cpuProfileBindToken;
+    vespalib::JsonHandlerRepo::Token::UP _cpuProfileRootToken;
     vespalib::StateServer::UP       _stateServer;
     TransportServer::UP             _fs4Server;
     vespalib::ThreadStackExecutor   _executor;
@@ -113,6 +119,8 @@ private:
     ProtonConfigFetcher             _protonConfigFetcher;
     std::unique_ptr<vespalib::ThreadStackExecutorBase> _warmupExecutor;
     std::unique_ptr<vespalib::ThreadStackExecutorBase> _summaryExecutor;
+    std::unique_ptr<vespalib::eval::ConstantTensorLoader> _tensorLoader;
+    std::unique_ptr<vespalib::eval::ConstantValueCache> _constantValueCache;
     matching::QueryLimiter          _queryLimiter;
     vespalib::Clock                 _clock;
     FastOS_ThreadPool               _threadPool;
@@ -124,6 +132,7 @@ private:
     bool                            _initStarted;
     bool                            _initComplete;
     bool                            _initDocumentDbsInSequence;
+    InitializeThreads               _initializeIoThreads;
     HwInfo                          _hwInfo;
     std::unique_ptr<HwInfoSampler>  _hwInfoSampler;
     std::shared_ptr<IDocumentDBReferenceRegistry> _documentDBReferenceRegistry;
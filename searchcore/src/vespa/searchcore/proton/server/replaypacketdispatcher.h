@@ -19,7 +19,7 @@ private:
     IReplayPacketHandler &_handler;
 
     template <typename OperationType>
-    void replay(OperationType &op, vespalib::nbostream &is, const Packet::Entry &entry);
+    void replay(const FeedOperation &op);
 
 protected:
     virtual void
@@ -32,6 +32,19 @@ public:
     ~ReplayPacketDispatcher();
 
     void replayEntry(const Packet::Entry &entry);
+
+    /**
+     * Deserialize the feed operation in the given packet entry without
+     * replaying it. This does not touch the handler, and can be called
+     * from any thread. Returns an empty pointer for new config entries,
+     * as these must be replayed in order by replayEntry().
+     */
+    static FeedOperation::UP deserializeEntry(const Packet::Entry &entry, const document::DocumentTypeRepo &repo);
+
+    /**
+     * Replay a feed operation returned by deserializeEntry().
+     */
+    void replayOperation(const FeedOperation &op);
 };
 
 } // namespace proton
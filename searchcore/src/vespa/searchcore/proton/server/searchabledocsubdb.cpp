@@ -16,7 +16,6 @@
 #include <vespa/searchcorespi/plugin/iindexmanagerfactory.h>
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/util/closuretask.h>
-#include <vespa/eval/tensor/default_tensor_engine.h>
 #include <vespa/vespalib/util/exceptions.h>
 
 using vespa::config::search::AttributesConfig;
@@ -43,9 +42,7 @@ SearchableDocSubDB::SearchableDocSubDB(const Config &cfg, const Context &ctx)
       _indexWriter(),
       _rSearchView(),
       _rFeedView(),
-      _tensorLoader(vespalib::tensor::DefaultTensorEngine::ref()),
-      _constantValueCache(_tensorLoader),
-      _constantValueRepo(_constantValueCache),
+      _constantValueRepo(ctx._constantValueFactory),
       _configurer(_iSummaryMgr, _rSearchView, _rFeedView, ctx._queryLimiter, _constantValueRepo, ctx._clock,
                   getSubDbName(), ctx._fastUpdCtx._storeOnlyCtx._owner.getDistributionKey()),
       _numSearcherThreads(cfg._numSearcherThreads),
@@ -98,11 +95,12 @@ createIndexManagerInitializer(const DocumentDBConfig &configSnapshot,
     Schema::SP schema(configSnapshot.getSchemaSP());
     vespalib::string vespaIndexDir(_baseDir + "/index");
     // Note: const_cast for reconfigurer role
-    return std::make_shared<IndexManagerInitializer>
+    auto task = std::make_shared<IndexManagerInitializer>
         (vespaIndexDir,
          searchcorespi::index::WarmupConfig(indexCfg.warmup.time, indexCfg.warmup.unpack),
          indexCfg.maxflushed,
          indexCfg.cache.size,
+         indexCfg.fusion.threads,
          *schema,
          configSerialNum,
          const_cast<SearchableDocSubDB &>(*this),
@@ -112,6 +110,8 @@ createIndexManagerInitializer(const DocumentDBConfig &configSnapshot,
          configSnapshot.getTuneFileDocumentDBSP()->_attr,
          _fileHeaderContext,
          indexManager);
+    task->setName(getSubDbName() + ".index");
+    return task;
 }
 
 void
@@ -342,6 +342,12 @@ SearchableDocSubDB::getMatcherStats(const vespalib::string &rankProfile) const
     return _rSearchView.get()->getMatcherStats(rankProfile);
 }
 
+std::shared_ptr<Matchers>
+SearchableDocSubDB::getMatchers() const
+{
+    return _rSearchView.get()->getMatchers();
+}
+
 void
 SearchableDocSubDB::updateLidReuseDelayer(const LidReuseDelayerConfig &config)
 {
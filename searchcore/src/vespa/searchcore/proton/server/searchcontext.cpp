@@ -23,7 +23,13 @@ uint32_t SearchContext::getDocIdLimit()
     return _docIdLimit;
 }
 
-SearchContext::SearchContext(const Searchable::SP &indexSearchable, uint32_t docIdLimit)
+search::SerialNum
+SearchContext::getIndexSerialNum()
+{
+    return _indexSearchable->getSerialNum();
+}
+
+SearchContext::SearchContext(const searchcorespi::IndexSearchable::SP &indexSearchable, uint32_t docIdLimit)
     : _indexSearchable(indexSearchable),
       _attributeBlueprintFactory(),
       _docIdLimit(docIdLimit)
@@ -3,6 +3,7 @@
 
 #include <vespa/searchlib/attribute/attribute_blueprint_factory.h>
 #include <vespa/searchcore/proton/matching/isearchcontext.h>
+#include <vespa/searchcorespi/index/indexsearchable.h>
 
 namespace proton {
 
@@ -16,16 +17,17 @@ class SearchContext : public matching::ISearchContext
 {
 private:
     /// Snapshot of the indexes used.
-    Searchable::SP                    _indexSearchable;
-    search::AttributeBlueprintFactory _attributeBlueprintFactory;
-    uint32_t                          _docIdLimit;
+    searchcorespi::IndexSearchable::SP _indexSearchable;
+    search::AttributeBlueprintFactory  _attributeBlueprintFactory;
+    uint32_t                           _docIdLimit;
 
     Searchable &getIndexes() override;
     Searchable &getAttributes() override;
     uint32_t getDocIdLimit() override;
+    search::SerialNum getIndexSerialNum() override;
 
 public:
-    SearchContext(const Searchable::SP &indexSearchable, uint32_t docIdLimit);
+    SearchContext(const searchcorespi::IndexSearchable::SP &indexSearchable, uint32_t docIdLimit);
 };
 
 } // namespace proton
@@ -24,6 +24,12 @@ SearchHandlerProxy::getDocsums(const DocsumRequest & request)
     return _documentDB->getDocsums(request);
 }
 
+std::unique_ptr<search::engine::DocsumReply>
+SearchHandlerProxy::getDocsums(const DocsumRequest & request, vespalib::ThreadBundle &threadBundle)
+{
+    return _documentDB->getDocsums(request, threadBundle);
+}
+
 std::unique_ptr<search::engine::SearchReply>
 SearchHandlerProxy::match(const ISearchHandler::SP &searchHandler,
                           const SearchRequest &req,
@@ -17,6 +17,7 @@ public:
 
     virtual~SearchHandlerProxy();
     std::unique_ptr<DocsumReply> getDocsums(const DocsumRequest & request) override;
+    std::unique_ptr<DocsumReply> getDocsums(const DocsumRequest & request, ThreadBundle &threadBundle) override;
     std::unique_ptr<SearchReply> match(const ISearchHandler::SP &searchHandler, const SearchRequest &req, ThreadBundle &threadBundle) const override;
 };
 
@@ -34,11 +34,17 @@ convertGidsToLids(const DocsumRequest & request,
                   const search::IDocumentMetaStore &metaStore,
                   uint32_t docIdLimit)
 {
-    document::GlobalId empty;
-    uint32_t lid = 0;
+    std::vector<document::GlobalId> gids;
+    gids.reserve(request.hits.size());
+    for (const DocsumRequest::Hit & h : request.hits) {
+        gids.push_back(h.gid);
+    }
+    std::vector<uint32_t> lids;
+    metaStore.getLids(gids, lids);
     for (size_t i = 0; i < request.hits.size(); ++i) {
         const DocsumRequest::Hit & h = request.hits[i];
-        if (metaStore.getLid(h.gid, lid) && lid < docIdLimit) {
+        uint32_t lid = lids[i];
+        if (lid != 0 && lid < docIdLimit) {
             h.docid = lid;
         } else {
             h.docid = search::endDocId;
@@ -117,6 +123,18 @@ SearchView::~SearchView() {}
 
 DocsumReply::UP
 SearchView::getDocsums(const DocsumRequest & req)
+{
+    return getDocsums(req, nullptr);
+}
+
+DocsumReply::UP
+SearchView::getDocsums(const DocsumRequest & req, ThreadBundle &threadBundle)
+{
+    return getDocsums(req, &threadBundle);
+}
+
+DocsumReply::UP
+SearchView::getDocsums(const DocsumRequest & req, ThreadBundle *threadBundle)
 {
     LOG(spam, "getDocsums(): resultClass(%s), numHits(%zu)", req.resultClassName.c_str(), req.hits.size());
     if (_summarySetup->getResultConfig().  LookupResultClassId(req.resultClassName.c_str()) == ResultConfig::NoClassID()) {
@@ -124,10 +142,10 @@ SearchView::getDocsums(const DocsumRequest & req)
                      req.resultClassName.c_str(), req.hits.size());
         return createEmptyReply(req);
     }
-    SearchView::InternalDocsumReply reply = getDocsumsInternal(req);
+    SearchView::InternalDocsumReply reply = getDocsumsInternal(req, threadBundle);
     while ( ! reply.second ) {
         LOG(debug, "Must refetch docsums since the lids have moved.");
-        reply = getDocsumsInternal(req);
+        reply = getDocsumsInternal(req, threadBundle);
     }
     if ( ! req.useRootSlime()) {
         convertLidsToGids(*reply.first, req);
@@ -136,7 +154,7 @@ SearchView::getDocsums(const DocsumRequest & req)
 }
 
 SearchView::InternalDocsumReply
-SearchView::getDocsumsInternal(const DocsumRequest & req)
+SearchView::getDocsumsInternal(const DocsumRequest & req, ThreadBundle *threadBundle)
 {
     IDocumentMetaStoreContext::IReadGuard::UP readGuard = _matchView->getDocumentMetaStore()->getReadGuard();
     const search::IDocumentMetaStore & metaStore = readGuard->get();
@@ -150,6 +168,9 @@ SearchView::getDocsumsInternal(const DocsumRequest & req)
     DocsumContext::UP ctx(new DocsumContext(req, _summarySetup->getDocsumWriter(), *store, matcher,
                                             mctx->getSearchContext(), mctx->getAttributeContext(),
                                             *_summarySetup->getAttributeManager(), *getSessionManager()));
+    if (threadBundle != nullptr) {
+        ctx->useThreadBundle(*threadBundle, [this, &req]() { return _summarySetup->createDocsumStore(req.resultClassName); });
+    }
     SearchView::InternalDocsumReply reply(ctx->getDocsums(), true);
     uint64_t endGeneration = readGuard->get().getCurrentGeneration();
     if (startGeneration != endGeneration) {
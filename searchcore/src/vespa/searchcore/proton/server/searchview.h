@@ -32,9 +32,11 @@ public:
     matching::MatchingStats getMatcherStats(const vespalib::string &rankProfile) const { return _matchView->getMatcherStats(rankProfile); }
 
     std::unique_ptr<DocsumReply> getDocsums(const DocsumRequest & req) override;
+    std::unique_ptr<DocsumReply> getDocsums(const DocsumRequest & req, ThreadBundle &threadBundle) override;
     std::unique_ptr<SearchReply> match(const ISearchHandler::SP &self, const SearchRequest &req, vespalib::ThreadBundle &threadBundle) const override;
 private:
-    InternalDocsumReply getDocsumsInternal(const DocsumRequest & req);
+    std::unique_ptr<DocsumReply> getDocsums(const DocsumRequest & req, ThreadBundle *threadBundle);
+    InternalDocsumReply getDocsumsInternal(const DocsumRequest & req, ThreadBundle *threadBundle);
     ISummaryManager::ISummarySetup::SP _summarySetup;
     MatchView::SP                      _matchView;
 };
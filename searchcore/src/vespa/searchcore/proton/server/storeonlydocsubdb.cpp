@@ -244,9 +244,11 @@ createSummaryManagerInitializer(const search::LogDocumentStore::Config & storeCf
 {
     GrowStrategy grow = _attributeGrow;
     vespalib::string baseDir(_baseDir + "/summary");
-    return std::make_shared<SummaryManagerInitializer>
+    auto task = std::make_shared<SummaryManagerInitializer>
         (grow, baseDir, getSubDbName(), _docTypeName, _summaryExecutor,
          storeCfg, tuneFile, _fileHeaderContext, _tlSyncer, bucketizer, result);
+    task->setName(getSubDbName() + ".summary");
+    return task;
 }
 
 void
@@ -277,8 +279,10 @@ createDocumentMetaStoreInitializer(const search::TuneFileAttributes &tuneFile,
     // their constructors.
     *result = std::make_shared<DocumentMetaStoreInitializerResult>
               (std::make_shared<DocumentMetaStore>(_bucketDB, attrFileName, grow, gidCompare, _subDbType), tuneFile);
-    return std::make_shared<documentmetastore::DocumentMetaStoreInitializer>
+    auto task = std::make_shared<documentmetastore::DocumentMetaStoreInitializer>
         (baseDir, getSubDbName(), _docTypeName.toString(), (*result)->documentMetaStore());
+    task->setName(getSubDbName() + ".documentmetastore");
+    return task;
 }
 
 
@@ -515,6 +519,12 @@ StoreOnlyDocSubDB::getMatcherStats(const vespalib::string &rankProfile) const
     return MatchingStats();
 }
 
+std::shared_ptr<Matchers>
+StoreOnlyDocSubDB::getMatchers() const
+{
+    return std::shared_ptr<Matchers>();
+}
+
 void
 StoreOnlyDocSubDB::close()
 {
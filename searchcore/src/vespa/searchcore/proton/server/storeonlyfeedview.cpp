@@ -615,9 +615,7 @@ StoreOnlyFeedView::removeDocuments(const RemoveDocumentsOperation &op, bool remo
     std::vector<document::GlobalId> gidsToRemove;
     if (useDMS) {
         gidsToRemove = getGidsToRemove(_metaStore, lidsToRemove);
-        for (const auto &gid : gidsToRemove) {
-            _gidToLidChangeHandler.notifyRemove(gid, serialNum);
-        }
+        _gidToLidChangeHandler.notifyRemoves(gidsToRemove, serialNum);
         _metaStore.removeBatch(lidsToRemove, ctx->getDocIdLimit());
         _metaStore.commit(serialNum, serialNum);
         explicitReuseLids = _lidReuseDelayer.delayReuse(lidsToRemove);
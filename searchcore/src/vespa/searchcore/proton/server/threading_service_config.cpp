@@ -10,10 +10,14 @@ using ProtonConfig = ThreadingServiceConfig::ProtonConfig;
 
 ThreadingServiceConfig::ThreadingServiceConfig(uint32_t indexingThreads_,
                                                uint32_t defaultTaskLimit_,
-                                               uint32_t semiUnboundTaskLimit_)
+                                               uint32_t semiUnboundTaskLimit_,
+                                               bool parallelReplay_,
+                                               bool rebalanceAttributeWriter_)
     : _indexingThreads(indexingThreads_),
       _defaultTaskLimit(defaultTaskLimit_),
-      _semiUnboundTaskLimit(semiUnboundTaskLimit_)
+      _semiUnboundTaskLimit(semiUnboundTaskLimit_),
+      _parallelReplay(parallelReplay_),
+      _rebalanceAttributeWriter(rebalanceAttributeWriter_)
 {
 }
 
@@ -37,7 +41,9 @@ ThreadingServiceConfig::make(const ProtonConfig &cfg,
     uint32_t indexingThreads = calculateIndexingThreads(cfg, cpuInfo);
     return ThreadingServiceConfig(indexingThreads,
                                   cfg.indexing.tasklimit,
-                                  (cfg.indexing.semiunboundtasklimit / indexingThreads));
+                                  (cfg.indexing.semiunboundtasklimit / indexingThreads),
+                                  cfg.feeding.replay.parallel,
+                                  cfg.indexing.attribute.rebalance);
 }
 
 }
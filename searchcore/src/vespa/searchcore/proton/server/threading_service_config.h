@@ -18,11 +18,15 @@ private:
     uint32_t _indexingThreads;
     uint32_t _defaultTaskLimit;
     uint32_t _semiUnboundTaskLimit;
+    bool _parallelReplay;
+    bool _rebalanceAttributeWriter;
 
 private:
     ThreadingServiceConfig(uint32_t indexingThreads_,
                            uint32_t defaultTaskLimit_,
-                           uint32_t semiUnboundTaskLimit_);
+                           uint32_t semiUnboundTaskLimit_,
+                           bool parallelReplay_,
+                           bool rebalanceAttributeWriter_);
 
 public:
     static ThreadingServiceConfig make(const ProtonConfig &cfg,
@@ -31,6 +35,8 @@ public:
     uint32_t indexingThreads() const { return _indexingThreads; }
     uint32_t defaultTaskLimit() const { return _defaultTaskLimit; }
     uint32_t semiUnboundTaskLimit() const { return _semiUnboundTaskLimit; }
+    bool parallelReplay() const { return _parallelReplay; }
+    bool rebalanceAttributeWriter() const { return _rebalanceAttributeWriter; }
 };
 
 }
@@ -1,7 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include "docsum_by_slime.h"
 #include <vespa/vespalib/util/compressor.h>
-#include <vespa/searchlib/util/slime_output_raw_buf_adapter.h>
+#include <vespa/vespalib/data/output.h>
 #include <vespa/searchlib/common/packets.h>
 #include <vespa/fnet/frt/rpcrequest.h>
 #include <vespa/vespalib/data/databuffer.h>
@@ -49,6 +49,34 @@ private:
     std::vector<DocsumRequest::Hit> & _hits;
 };
 
+/**
+ * Slime output writing directly into a DataBuffer, so the encoded
+ * buffer can be handed over to the rpc reply without copying it.
+ **/
+class DataBufferOutput : public vespalib::Output
+{
+public:
+    DataBufferOutput(DataBuffer & buf) : _buf(buf) { }
+    vespalib::WritableMemory reserve(size_t bytes) override {
+        _buf.ensureFree(bytes);
+        return vespalib::WritableMemory(_buf.getFree(), _buf.getFreeLen());
+    }
+    Output &commit(size_t bytes) override {
+        _buf.moveFreeToData(bytes);
+        return *this;
+    }
+private:
+    DataBuffer & _buf;
+};
+
+void
+addBlob(FRT_Values & ret, DataBuffer & buf)
+{
+    assert(buf.getDeadLen() == 0);
+    uint32_t len = buf.getDataLen();
+    ret.AddData(buf.stealBuffer(), len);
+}
+
 CompressionConfig
 getCompressionConfig()
 {
@@ -122,17 +150,18 @@ DocsumByRPC::getDocsums(FRT_RPCRequest & req)
     vespalib::Slime::UP summaries = _slimeDocsumServer.getDocsums(summariesToGet.get());
     assert(summaries);  // Mandatory, not optional.
 
-    search::RawBuf rbuf(4096);
-    search::SlimeOutputRawBufAdapter output(rbuf);
+    DataBuffer encoded(4096);
+    DataBufferOutput output(encoded);
     BinaryFormat::encode(*summaries, output);
-    ConstBufferRef buf(rbuf.GetDrainPos(), rbuf.GetUsedLen());
-    DataBuffer compressed(rbuf.GetWritableDrainPos(0), rbuf.GetUsedLen());
+    ConstBufferRef buf(encoded.getData(), encoded.getDataLen());
+    DataBuffer compressed(0);
     CompressionConfig::Type type = compress(getCompressionConfig(), buf, compressed, true);
 
+    // Hand the encoded or compressed buffer over to the reply instead of copying it.
     FRT_Values &ret = *req.GetReturn();
     ret.AddInt8(type);
     ret.AddInt32(buf.size());
-    ret.AddData(compressed.getData(), compressed.getDataLen());
+    addBlob(ret, (type == CompressionConfig::NONE) ? encoded : compressed);
 }
 
 }
@@ -38,6 +38,15 @@ public:
      */
     virtual std::unique_ptr<DocsumReply> getDocsums(const DocsumRequest & request) = 0;
 
+    /**
+     * Same as above, but the handler may use the given thread bundle to
+     * generate the summaries of the requested hits in parallel.
+     */
+    virtual std::unique_ptr<DocsumReply> getDocsums(const DocsumRequest & request, ThreadBundle &threadBundle) {
+        (void) threadBundle;
+        return getDocsums(request);
+    }
+
     virtual std::unique_ptr<SearchReply>
     match(const ISearchHandler::SP &self, const SearchRequest &req, ThreadBundle &threadBundle) const = 0;
 };
@@ -32,11 +32,12 @@ public:
 
 namespace proton {
 
-SummaryEngine::SummaryEngine(size_t numThreads)
+SummaryEngine::SummaryEngine(size_t numThreads, size_t threadsPerSummary)
     : _lock(),
       _closed(false),
       _handlers(),
-      _executor(numThreads, 128 * 1024)
+      _executor(numThreads, 128 * 1024),
+      _threadBundlePool(std::max(size_t(1), threadsPerSummary))
 {
     // empty
 }
@@ -101,9 +102,10 @@ SummaryEngine::getDocsums(DocsumRequest::UP req)
     DocsumReply::UP reply = std::make_unique<DocsumReply>();
 
     if (req) {
+        vespalib::SimpleThreadBundle::UP threadBundle = _threadBundlePool.obtain();
         ISearchHandler::SP searchHandler = getSearchHandler(DocTypeName(*req));
         if (searchHandler) {
-            reply = searchHandler->getDocsums(*req);
+            reply = searchHandler->getDocsums(*req, *threadBundle);
         } else {
             vespalib::Sequence<ISearchHandler*>::UP snapshot;
             {
@@ -111,9 +113,10 @@ SummaryEngine::getDocsums(DocsumRequest::UP req)
                 snapshot = _handlers.snapshot();
             }
             if (snapshot->valid()) {
-                reply = snapshot->get()->getDocsums(*req); // use the first handler
+                reply = snapshot->get()->getDocsums(*req, *threadBundle); // use the first handler
             }
         }
+        _threadBundlePool.release(std::move(threadBundle));
     }
     reply->request = std::move(req);
     return reply;
@@ -5,6 +5,7 @@
 #include <vespa/searchcore/proton/summaryengine/isearchhandler.h>
 #include <vespa/searchlib/engine/docsumapi.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
+#include <vespa/vespalib/util/simple_thread_bundle.h>
 #include <vespa/searchcore/proton/common/doctypename.h>
 #include <mutex>
 
@@ -21,6 +22,7 @@ private:
     bool                          _closed;
     HandlerMap<ISearchHandler>    _handlers;
     vespalib::ThreadStackExecutor _executor;
+    vespalib::SimpleThreadBundle::Pool _threadBundlePool;
 
 public:
     /**
@@ -38,8 +40,9 @@ public:
      * using the putSearchHandler() method.
      *
      * @param numThreads Number of threads allocated for handling summary requests.
+     * @param threadsPerSummary Number of threads used to fill the hits of a single request.
      */
-    SummaryEngine(size_t numThreads);
+    SummaryEngine(size_t numThreads, size_t threadsPerSummary = 1);
 
     /**
      * Frees any allocated resources. This will also stop all internal threads
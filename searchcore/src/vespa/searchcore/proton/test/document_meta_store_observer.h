@@ -36,6 +36,9 @@ struct DocumentMetaStoreObserver : public IDocumentMetaStore
     virtual bool getLid(const GlobalId &gid, DocId &lid) const override {
         return _store.getLid(gid, lid);
     }
+    virtual void getLids(const std::vector<GlobalId> &gids, std::vector<DocId> &lids) const override {
+        _store.getLids(gids, lids);
+    }
     virtual search::DocumentMetaData getMetaData(const GlobalId &gid) const override {
         return _store.getMetaData(gid);
     }
@@ -201,6 +201,7 @@ private:
     virtual void visit(SuffixTerm &n)      override { visitTerm(n); }
     virtual void visit(PredicateQuery &n)  override { visitTerm(n); }
     virtual void visit(RegExpTerm &n)      override { visitTerm(n); }
+    virtual void visit(NearestNeighborTerm &n) override { visitTerm(n); }
 
 public:
     CreateBlueprintVisitor(const IIndexCollection &indexes,
@@ -2,10 +2,12 @@
 #include "warmupindexcollection.h"
 #include "idiskindex.h"
 #include <vespa/vespalib/util/closuretask.h>
+#include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/searchlib/fef/matchdatalayout.h>
 #include <vespa/searchlib/query/tree/termnodes.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/vespalib/stllike/hash_set.h>
+#include <vespa/fastos/file.h>
 #include <vespa/log/log.h>
 
 LOG_SETUP(".searchcorespi.index.warmupindexcollection");
@@ -29,6 +31,30 @@ class FieldTermMap : public vespalib::hash_map<uint32_t, TermMap>
 
 };
 
+namespace {
+
+/**
+ * Order in which disk index files are prefetched. Dictionaries are
+ * needed by every term lookup, then bitvectors and posting lists.
+ * Returns -1 for files that are not prefetched.
+ */
+int
+prefetchPriority(const vespalib::string &fileName)
+{
+    if (fileName.find("dictionary") == 0) {
+        return 0;
+    }
+    if (fileName.find("boolocc") == 0) {
+        return 1;
+    }
+    if (fileName.find("posocc") == 0) {
+        return 2;
+    }
+    return -1;
+}
+
+}
+
 WarmupIndexCollection::WarmupIndexCollection(const WarmupConfig & warmupConfig,
                                              ISearchableIndexCollection::SP prev,
                                              ISearchableIndexCollection::SP next,
@@ -51,6 +77,48 @@ WarmupIndexCollection::WarmupIndexCollection(const WarmupConfig & warmupConfig,
     }
     LOG(debug, "For %g seconds I will warm up '%s' %s unpack.", warmupConfig.getDuration(), typeid(_warmup).name(), warmupConfig.getUnpack() ? "with" : "without");
     LOG(debug, "%s", toString().c_str());
+    const IDiskIndex *diskIndex = dynamic_cast<const IDiskIndex *>(&_warmup);
+    if (diskIndex != nullptr) {
+        vespalib::string indexDir = diskIndex->getIndexDir();
+        _executor.execute(vespalib::makeLambdaTask([this, indexDir]() { prefetchIndexFiles(indexDir); }));
+    }
+}
+
+void
+WarmupIndexCollection::prefetchIndexFiles(const vespalib::string &indexDir)
+{
+    std::vector<std::pair<int, vespalib::string>> files;
+    FastOS_DirectoryScan dirScan(indexDir.c_str());
+    while (dirScan.ReadNext()) {
+        if (!dirScan.IsDirectory() || dirScan.GetName()[0] == '.') {
+            continue;
+        }
+        vespalib::string fieldDir = indexDir + "/" + dirScan.GetName();
+        FastOS_DirectoryScan fieldScan(fieldDir.c_str());
+        while (fieldScan.ReadNext()) {
+            vespalib::string name = fieldScan.GetName();
+            int priority = prefetchPriority(name);
+            if (priority >= 0 && !fieldScan.IsDirectory()) {
+                files.emplace_back(priority, fieldDir + "/" + name);
+            }
+        }
+    }
+    std::stable_sort(files.begin(), files.end(),
+                     [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+    size_t prefetchedBytes = 0;
+    for (const auto &file : files) {
+        if (_warmupEndTime == 0 || ClockSystem::now() >= _warmupEndTime) {
+            break;
+        }
+        FastOS_File fastosFile(file.second.c_str());
+        if (fastosFile.OpenReadOnly()) {
+            int64_t size = fastosFile.GetSize();
+            fastosFile.willNeed(0, size);
+            prefetchedBytes += size;
+            fastosFile.Close();
+        }
+    }
+    LOG(debug, "Prefetched %zu bytes from %zu files in '%s'", prefetchedBytes, files.size(), indexDir.c_str());
 }
 
 void
@@ -90,6 +90,12 @@ private:
     };
 
     void fireWarmup(Task::UP task);
+    /**
+     * Asks the kernel to read the dictionary, bitvector and posting
+     * files of the disk index being warmed up into the page cache, so
+     * that the first queries against it do not pay for cold reads.
+     */
+    void prefetchIndexFiles(const vespalib::string &indexDir);
     bool handledBefore(uint32_t fieldId, const Node &term);
 
     const WarmupConfig               _warmupConfig;
@@ -6,6 +6,7 @@
 #include <vespa/searchlib/attribute/attributefactory.h>
 #include <vespa/vespalib/data/fileheader.h>
 #include <fstream>
+#include <unordered_set>
 
 #include <vespa/searchlib/attribute/attributevector.hpp>
 #include <vespa/fastlib/io/bufferedfile.h>
@@ -21,6 +22,7 @@ private:
     void load(const AttributePtr & ptr);
     void applyUpdate(const AttributePtr & ptr);
     void printContent(const AttributePtr & ptr, std::ostream & os);
+    void printStats(const AttributePtr & ptr, std::ostream & os);
     void usage();
 
 public:
@@ -95,12 +97,52 @@ LoadAttribute::printContent(const AttributePtr & ptr, std::ostream & os)
     }
 }
 
+void
+LoadAttribute::printStats(const AttributePtr & ptr, std::ostream & os)
+{
+    uint32_t sz = ptr->getMaxValueCount();
+    std::vector<uint64_t> valueCountHist;
+    std::unordered_set<std::string> uniqueValues;
+    uint64_t totalValues = 0;
+    uint32_t maxValueCount = 0;
+    vespalib::string *buf = new vespalib::string[sz];
+    for (uint32_t doc = 0; doc < ptr->getNumDocs(); ++doc) {
+        uint32_t valueCount = ptr->get(doc, buf, sz);
+        assert(valueCount <= sz);
+        if (valueCount >= valueCountHist.size()) {
+            valueCountHist.resize(valueCount + 1);
+        }
+        ++valueCountHist[valueCount];
+        totalValues += valueCount;
+        maxValueCount = std::max(maxValueCount, valueCount);
+        for (uint32_t i = 0; i < valueCount; ++i) {
+            uniqueValues.insert(buf[i]);
+        }
+    }
+    delete [] buf;
+    uint32_t numDocs = ptr->getNumDocs();
+    os << "numDocs: " << numDocs << std::endl;
+    os << "totalValues: " << totalValues << std::endl;
+    os << "uniqueValues: " << uniqueValues.size() << std::endl;
+    os << "avgValueCount: " << (numDocs != 0 ? static_cast<double>(totalValues) / numDocs : 0.0) << std::endl;
+    os << "maxValueCount: " << maxValueCount << std::endl;
+    os << "memoryUsage: used=" << ptr->getStatus().getUsed() <<
+        " allocated=" << ptr->getStatus().getAllocated() << std::endl;
+    os << "valueCount histogram:" << std::endl;
+    for (uint32_t valueCount = 0; valueCount < valueCountHist.size(); ++valueCount) {
+        if (valueCountHist[valueCount] != 0) {
+            os << "    " << valueCount << ": " << valueCountHist[valueCount] << std::endl;
+        }
+    }
+}
+
 void
 LoadAttribute::usage()
 {
     std::cout << "usage: vespa-attribute-inspect [-p (print content to <attribute>.out)]" << std::endl;
     std::cout << "                     [-a (apply a single update)]" << std::endl;
     std::cout << "                     [-s (save attribute to <attribute>.save.dat)]" << std::endl;
+    std::cout << "                     [-t (print value count and cardinality statistics)]" << std::endl;
     std::cout << "                     <attribute>" << std::endl;
 }
 
@@ -113,12 +155,13 @@ LoadAttribute::Main()
     bool doFastSearch = false;
     bool doEnableEnumeratedSave = false;
     bool doHuge = false;
+    bool doPrintStats = false;
 
     int idx = 1;
     char opt;
     const char * arg;
     bool optError = false;
-    while ((opt = GetOpt("pasf:eh", arg, idx)) != -1) {
+    while ((opt = GetOpt("pasf:eht", arg, idx)) != -1) {
         switch (opt) {
         case 'p':
             doPrintContent = true;
@@ -144,6 +187,9 @@ LoadAttribute::Main()
         case 's':
             doSave = true;
             break;
+        case 't':
+            doPrintStats = true;
+            break;
         default:
             optError = true;
             break;
@@ -196,6 +242,12 @@ LoadAttribute::Main()
         of.close();
     }
 
+    if (doPrintStats) {
+        timer.SetNow();
+        printStats(ptr, std::cout);
+        std::cout << "stats time: " << timer.MilliSecsToNow() / 1000 << " seconds " << std::endl;
+    }
+
     if (doSave) {
         vespalib::string saveFile = fileName + ".save";
         std::cout << "saving attribute: " << saveFile << std::endl;
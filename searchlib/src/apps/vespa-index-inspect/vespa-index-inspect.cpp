@@ -9,17 +9,21 @@
 #include <vespa/searchlib/diskindex/docidmapper.h>
 #include <vespa/searchlib/diskindex/wordnummapper.h>
 #include <vespa/searchlib/diskindex/fieldreader.h>
+#include <vespa/searchlib/diskindex/bitvectoridxfile.h>
 #include <vespa/searchlib/index/dummyfileheadercontext.h>
 #include <vespa/searchlib/queryeval/searchiterator.h>
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
 #include <vespa/fastos/app.h>
+#include <vespa/fastos/timestamp.h>
 #include <iostream>
+#include <queue>
 #include <getopt.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP("vespa-index-inspect");
 
 using search::TuneFileSeqRead;
+using search::diskindex::BitVectorIdxFileWrite;
 using search::diskindex::DocIdMapping;
 using search::diskindex::FieldReader;
 using search::diskindex::PageDict4FileSeqRead;
@@ -852,6 +856,325 @@ DumpWordsSubApp::run()
 }
 
 
+class StatsSubApp : public SubApp
+{
+    typedef std::pair<uint64_t, vespalib::string> NumDocsAndWord;
+    typedef std::priority_queue<NumDocsAndWord, std::vector<NumDocsAndWord>,
+                                std::greater<NumDocsAndWord>> LargestWords;
+
+    vespalib::string _indexDir;
+    FieldOptions _fieldOptions;
+    uint32_t _seekTestWords;
+    DocIdMapping _dm;
+
+    static uint32_t log2Bucket(uint64_t value) {
+        uint32_t bucket = 0;
+        while (value > 1) {
+            value >>= 1;
+            ++bucket;
+        }
+        return bucket;
+    }
+public:
+    StatsSubApp(FastOS_Application &app);
+    virtual ~StatsSubApp();
+    virtual void usage(bool showHeader) override;
+    virtual bool getOptions() override;
+    virtual int run() override;
+    void fieldStats(const SchemaUtil::IndexIterator &index);
+    void seekStats(const vespalib::string &fieldDir, LargestWords &largest);
+};
+
+
+StatsSubApp::StatsSubApp(FastOS_Application &app)
+    : SubApp(app),
+      _indexDir("."),
+      _fieldOptions(),
+      _seekTestWords(10u),
+      _dm()
+{
+}
+
+
+StatsSubApp::~StatsSubApp()
+{
+}
+
+
+void
+StatsSubApp::usage(bool showHeader)
+{
+    using std::cerr;
+    if (showHeader)
+        usageHeader();
+    cerr <<
+        "vespa-index-inspect stats [--indexdir indexDir]\n"
+        " [--field field] [--seektestwords numWords]\n"
+        "\n";
+}
+
+
+bool
+StatsSubApp::getOptions()
+{
+    int c;
+    const char *optArgument = NULL;
+    int longopt_index = 0;
+    static struct option longopts[] = {
+        { "indexdir", 1, NULL, 0 },
+        { "field", 1, NULL, 0 },
+        { "seektestwords", 1, NULL, 0 },
+        { NULL, 0, NULL, 0 }
+    };
+    enum longopts_enum {
+        LONGOPT_INDEXDIR,
+        LONGOPT_FIELD,
+        LONGOPT_SEEKTESTWORDS
+    };
+    int optIndex = 2;
+    while ((c = _app.GetOptLong("i:",
+                                optArgument,
+                                optIndex,
+                                longopts,
+                                &longopt_index)) != -1) {
+        switch (c) {
+        case 0:
+            switch (longopt_index) {
+            case LONGOPT_INDEXDIR:
+                _indexDir = optArgument;
+                break;
+            case LONGOPT_FIELD:
+                _fieldOptions.addField(optArgument);
+                break;
+            case LONGOPT_SEEKTESTWORDS:
+                _seekTestWords = atoi(optArgument);
+                break;
+            default:
+                if (optArgument != NULL) {
+                    LOG(error,
+                        "longopt %s with arg %s",
+                        longopts[longopt_index].name, optArgument);
+                } else {
+                    LOG(error,
+                        "longopt %s",
+                        longopts[longopt_index].name);
+                }
+            }
+            break;
+        case 'i':
+            _indexDir = optArgument;
+            break;
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
+
+void
+StatsSubApp::fieldStats(const SchemaUtil::IndexIterator &index)
+{
+    vespalib::string fieldDir = _indexDir + "/" + index.getName();
+    PageDict4FileSeqRead wordList;
+    search::TuneFileSeqRead tuneFileRead;
+    if (!wordList.open(fieldDir + "/dictionary", tuneFileRead)) {
+        LOG(error,
+            "Could not open wordlist %s/dictionary", fieldDir.c_str());
+        exit(1);
+    }
+    uint32_t bitVectorLimit = BitVectorIdxFileWrite::getBitVectorLimit(_dm._docIdLimit);
+    std::vector<uint64_t> histWords;
+    std::vector<uint64_t> histDocs;
+    std::vector<uint64_t> histBits;
+    uint64_t numWords = 0;
+    uint64_t totalDocs = 0;
+    uint64_t totalBits = 0;
+    uint64_t bitVectorWords = 0;
+    uint64_t skipWords = 0;
+    uint64_t segmentedWords = 0;
+    uint64_t numSegments = 0;
+    LargestWords largest;
+    uint64_t wordNum = 0;
+    vespalib::string word;
+    PostingListCounts counts;
+    for (;;) {
+        wordList.readWord(word, wordNum, counts);
+        if (wordNum == wordList.noWordNumHigh())
+            break;
+        uint32_t bucket = log2Bucket(counts._numDocs);
+        if (bucket >= histWords.size()) {
+            histWords.resize(bucket + 1);
+            histDocs.resize(bucket + 1);
+            histBits.resize(bucket + 1);
+        }
+        ++histWords[bucket];
+        histDocs[bucket] += counts._numDocs;
+        histBits[bucket] += counts._bitLength;
+        ++numWords;
+        totalDocs += counts._numDocs;
+        totalBits += counts._bitLength;
+        if (counts._numDocs > bitVectorLimit)
+            ++bitVectorWords;
+        if (counts._numDocs >= 64u || counts._segments.size() > 1)
+            ++skipWords;
+        if (counts._segments.size() > 1) {
+            ++segmentedWords;
+            numSegments += counts._segments.size();
+        }
+        if (_seekTestWords > 0u) {
+            largest.push(NumDocsAndWord(counts._numDocs, word));
+            if (largest.size() > _seekTestWords)
+                largest.pop();
+        }
+    }
+    if (!wordList.close()) {
+        LOG(error,
+            "Could not close wordlist %s/dictionary", fieldDir.c_str());
+        exit(1);
+    }
+    std::cout << "field = " << index.getName() << '\n' <<
+        " words = " << numWords <<
+        ", postings = " << totalDocs <<
+        ", bits = " << totalBits <<
+        ", bitsPerPosting = " <<
+        (totalDocs != 0 ? static_cast<double>(totalBits) / totalDocs : 0.0) << '\n' <<
+        " docIdLimit = " << _dm._docIdLimit <<
+        ", bitVectorLimit = " << bitVectorLimit <<
+        ", bitVectorWords = " << bitVectorWords << '\n' <<
+        " skipWords = " << skipWords <<
+        ", segmentedWords = " << segmentedWords <<
+        ", segments = " << numSegments << '\n';
+    std::cout << " postinglength histogram (numDocs >= 2^n):\n";
+    for (uint32_t bucket = 0; bucket < histWords.size(); ++bucket) {
+        if (histWords[bucket] == 0)
+            continue;
+        std::cout << "  n = " << bucket <<
+            ", words = " << histWords[bucket] <<
+            ", postings = " << histDocs[bucket] <<
+            ", bitsPerPosting = " <<
+            static_cast<double>(histBits[bucket]) / histDocs[bucket] << '\n';
+    }
+    if (!largest.empty())
+        seekStats(fieldDir, largest);
+}
+
+
+void
+StatsSubApp::seekStats(const vespalib::string &fieldDir, LargestWords &largest)
+{
+    std::unique_ptr<DictionaryFileRandRead> dict(new PageDict4RandRead);
+    search::TuneFileRandRead tuneFileRead;
+    vespalib::string dictName = fieldDir + "/dictionary";
+    if (!dict->open(dictName, tuneFileRead)) {
+        LOG(error,
+            "Could not open dictionary %s",
+            dictName.c_str());
+        exit(1);
+    }
+    std::unique_ptr<PostingListFileRandRead> postingfile(new Zc4PosOccRandRead);
+    vespalib::string mangledName = fieldDir + "/posocc.dat.compressed";
+    if (!postingfile->open(mangledName, tuneFileRead)) {
+        LOG(error,
+            "Could not open posting list file %s",
+            mangledName.c_str());
+        exit(1);
+    }
+    std::vector<NumDocsAndWord> words;
+    while (!largest.empty()) {
+        words.push_back(largest.top());
+        largest.pop();
+    }
+    // Sparse seeks exercise the skip info, as a selective AND would.
+    uint32_t seekStride = std::max(1u, _dm._docIdLimit / 1000u);
+    std::cout << " seek costs for largest posting lists" <<
+        " (sparse seek stride " << seekStride << "):\n";
+    for (auto i = words.rbegin(), ie = words.rend(); i != ie; ++i) {
+        PostingListOffsetAndCounts offsetAndCounts;
+        uint64_t wordNum = 0;
+        if (!dict->lookup(i->second, wordNum, offsetAndCounts))
+            continue;
+        PostingListHandle handle;
+        handle._bitOffset = offsetAndCounts._offset;
+        handle._bitLength = offsetAndCounts._counts._bitLength;
+        handle._file = postingfile.get();
+        handle._file->readPostingList(offsetAndCounts._counts, 0, 0, handle);
+        TermFieldMatchData tfmd;
+        TermFieldMatchDataArray tfmda;
+        tfmda.add(&tfmd);
+
+        std::unique_ptr<SearchIterator> sb(handle.createIterator(offsetAndCounts._counts, tfmda));
+        fastos::StopWatch scanTimer;
+        scanTimer.start();
+        sb->initFullRange();
+        uint64_t hits = 0;
+        uint32_t docId = 1;
+        while (!sb->isAtEnd()) {
+            if (sb->seek(docId)) {
+                ++hits;
+                ++docId;
+            } else {
+                docId = sb->getDocId();
+            }
+        }
+        scanTimer.stop();
+        double scanNs = scanTimer.elapsed().ns();
+
+        sb.reset(handle.createIterator(offsetAndCounts._counts, tfmda));
+        fastos::StopWatch seekTimer;
+        seekTimer.start();
+        sb->initFullRange();
+        uint64_t seeks = 0;
+        for (docId = 1; docId < _dm._docIdLimit && !sb->isAtEnd(); docId += seekStride) {
+            sb->seek(docId);
+            ++seeks;
+        }
+        seekTimer.stop();
+        double seekNs = seekTimer.elapsed().ns();
+        std::cout << "  word = \"" << i->second << "\"" <<
+            ", numDocs = " << i->first <<
+            ", bits = " << offsetAndCounts._counts._bitLength <<
+            ", segments = " << offsetAndCounts._counts._segments.size() <<
+            ", scanNsPerHit = " << (hits != 0 ? scanNs / hits : 0.0) <<
+            ", sparseNsPerSeek = " << (seeks != 0 ? seekNs / seeks : 0.0) << '\n';
+    }
+    postingfile->close();
+    dict->close();
+}
+
+
+int
+StatsSubApp::run()
+{
+    Schema schema;
+    std::string schemaName = _indexDir + "/schema.txt";
+    if (!schema.loadFromFile(schemaName)) {
+        LOG(error,
+            "Could not load schema from %s", schemaName.c_str());
+        exit(1);
+    }
+    _fieldOptions.validateFields(schema);
+    if (!_dm.readDocIdLimit(_indexDir)) {
+        LOG(error,
+            "Could not read docid limit from %s", _indexDir.c_str());
+        exit(1);
+    }
+    if (!_fieldOptions.empty()) {
+        for (uint32_t fieldId : _fieldOptions._ids) {
+            SchemaUtil::IndexIterator index(schema, fieldId);
+            fieldStats(index);
+        }
+    } else {
+        SchemaUtil::IndexIterator index(schema);
+        while (index.isValid()) {
+            fieldStats(index);
+            ++index;
+        }
+    }
+    return 0;
+}
+
+
 class VespaIndexInspectApp : public FastOS_Application
 {
 public:
@@ -872,6 +1195,7 @@ VespaIndexInspectApp::usage()
 {
     ShowPostingListSubApp(*this).usage(true);
     DumpWordsSubApp(*this).usage(false);
+    StatsSubApp(*this).usage(false);
 }
 
 
@@ -887,6 +1211,8 @@ VespaIndexInspectApp::Main()
         subApp.reset(new ShowPostingListSubApp(*this));
     else if (strcmp(_argv[1], "dumpwords") == 0)
         subApp.reset(new DumpWordsSubApp(*this));
+    else if (strcmp(_argv[1], "stats") == 0)
+        subApp.reset(new StatsSubApp(*this));
     if (subApp.get() != NULL) {
         if (!subApp->getOptions()) {
             subApp->usage(true);
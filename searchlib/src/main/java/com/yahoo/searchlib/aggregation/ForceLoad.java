@@ -25,6 +25,7 @@ public class ForceLoad {
                 "CountAggregationResult",
                 "AverageAggregationResult",
                 "ExpressionCountAggregationResult",
+                "QuantileAggregationResult",
                 "hll.SparseSketch",
                 "hll.NormalSketch"
         };
@@ -0,0 +1,228 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+package com.yahoo.searchlib.aggregation;
+
+import com.yahoo.searchlib.expression.FloatResultNode;
+import com.yahoo.searchlib.expression.ResultNode;
+import com.yahoo.vespa.objects.Deserializer;
+import com.yahoo.vespa.objects.ObjectVisitor;
+import com.yahoo.vespa.objects.Serializer;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Comparator;
+import java.util.List;
+
+/**
+ * Estimates quantiles of the values of an expression. The search nodes keep a mergeable sketch (a t-digest) of the
+ * observed values in bounded memory, and the sketches are merged here using the same compression as in the backend
+ * (searchlib/grouping/tdigest.cpp). Any quantile can be estimated from the merged sketch, the rank of this result
+ * is the estimate of the configured quantile.
+ */
+public class QuantileAggregationResult extends AggregationResult {
+
+    public static final int classId = registerClass(0x4000 + 98, QuantileAggregationResult.class);
+    public static final double DEFAULT_COMPRESSION = 100.0;
+
+    private double quantile;
+    private double compression = DEFAULT_COMPRESSION;
+    private double min = Double.POSITIVE_INFINITY;
+    private double max = Double.NEGATIVE_INFINITY;
+    private double totalWeight = 0.0;
+    private double[] means = new double[0];
+    private double[] weights = new double[0];
+
+    /**
+     * Constructor used for deserialization. Will be instantiated with an empty sketch.
+     */
+    @SuppressWarnings("unused")
+    public QuantileAggregationResult() {
+        this(0.5);
+    }
+
+    public QuantileAggregationResult(double quantile) {
+        this.quantile = quantile;
+    }
+
+    /**
+     * Creates a result from a compressed sketch, given as centroids in increasing mean order.
+     */
+    public QuantileAggregationResult(double quantile, double min, double max, double[] means, double[] weights) {
+        if (means.length != weights.length) {
+            throw new IllegalArgumentException("Got " + means.length + " means but " + weights.length + " weights.");
+        }
+        this.quantile = quantile;
+        this.min = min;
+        this.max = max;
+        this.means = means.clone();
+        this.weights = weights.clone();
+        for (double weight : weights) {
+            totalWeight += weight;
+        }
+    }
+
+    public double getQuantile() {
+        return quantile;
+    }
+
+    public QuantileAggregationResult setQuantile(double quantile) {
+        this.quantile = quantile;
+        return this;
+    }
+
+    /** Returns the number of values that have been aggregated into the sketch. */
+    public double getCount() {
+        return totalWeight;
+    }
+
+    /**
+     * Returns the estimated value at the given quantile, in the range [0, 1], of the aggregated values.
+     *
+     * @param q the quantile to estimate
+     * @return the estimated value, or 0 if nothing has been aggregated
+     */
+    public double estimate(double q) {
+        int n = means.length;
+        if (n == 0) {
+            return 0.0;
+        }
+        if (n == 1) {
+            return means[0];
+        }
+        double target = Math.min(Math.max(q, 0.0), 1.0) * totalWeight;
+        double center = weights[0] / 2.0;
+        if (target <= center) {
+            return min + (means[0] - min) * (target / center);
+        }
+        for (int i = 0; i + 1 < n; ++i) {
+            double nextCenter = center + (weights[i] + weights[i + 1]) / 2.0;
+            if (target <= nextCenter) {
+                return means[i] + (means[i + 1] - means[i]) * (target - center) / (nextCenter - center);
+            }
+            center = nextCenter;
+        }
+        double tail = weights[n - 1] / 2.0;
+        return means[n - 1] + (max - means[n - 1]) * Math.min((target - center) / tail, 1.0);
+    }
+
+    @Override
+    public ResultNode getRank() {
+        return new FloatResultNode(estimate(quantile));
+    }
+
+    @Override
+    protected void onMerge(AggregationResult obj) {
+        QuantileAggregationResult other = (QuantileAggregationResult)obj;
+        if (other.totalWeight == 0.0) {
+            return;
+        }
+        List<double[]> all = new ArrayList<>(means.length + other.means.length);
+        for (int i = 0; i < means.length; ++i) {
+            all.add(new double[] { means[i], weights[i] });
+        }
+        for (int i = 0; i < other.means.length; ++i) {
+            all.add(new double[] { other.means[i], other.weights[i] });
+        }
+        totalWeight += other.totalWeight;
+        min = Math.min(min, other.min);
+        max = Math.max(max, other.max);
+        compress(all);
+    }
+
+    private double scale(double q) {
+        return compression * Math.asin(2.0 * Math.min(Math.max(q, 0.0), 1.0) - 1.0) / (2.0 * Math.PI);
+    }
+
+    private void compress(List<double[]> all) {
+        all.sort(Comparator.comparingDouble(c -> c[0]));
+        List<double[]> result = new ArrayList<>();
+        double before = 0.0;
+        double[] current = all.get(0).clone();
+        for (int i = 1; i < all.size(); ++i) {
+            double[] next = all.get(i);
+            double proposed = current[1] + next[1];
+            if (scale((before + proposed) / totalWeight) - scale(before / totalWeight) <= 1.0) {
+                current[0] += (next[0] - current[0]) * next[1] / proposed;
+                current[1] = proposed;
+            } else {
+                before += current[1];
+                result.add(current);
+                current = next.clone();
+            }
+        }
+        result.add(current);
+        means = new double[result.size()];
+        weights = new double[result.size()];
+        for (int i = 0; i < result.size(); ++i) {
+            means[i] = result.get(i)[0];
+            weights[i] = result.get(i)[1];
+        }
+    }
+
+    @Override
+    protected boolean equalsAggregation(AggregationResult obj) {
+        QuantileAggregationResult other = (QuantileAggregationResult)obj;
+        return quantile == other.quantile &&
+               compression == other.compression &&
+               totalWeight == other.totalWeight &&
+               Arrays.equals(means, other.means) &&
+               Arrays.equals(weights, other.weights);
+    }
+
+    @Override
+    public int hashCode() {
+        return super.hashCode() + Double.hashCode(quantile) + Arrays.hashCode(means);
+    }
+
+    @Override
+    public QuantileAggregationResult clone() {
+        QuantileAggregationResult obj = (QuantileAggregationResult)super.clone();
+        obj.means = means.clone();
+        obj.weights = weights.clone();
+        return obj;
+    }
+
+    @Override
+    protected void onSerialize(Serializer buf) {
+        super.onSerialize(buf);
+        buf.putDouble(null, quantile);
+        buf.putDouble(null, compression);
+        buf.putDouble(null, min);
+        buf.putDouble(null, max);
+        buf.putInt(null, means.length);
+        for (int i = 0; i < means.length; ++i) {
+            buf.putDouble(null, means[i]);
+            buf.putDouble(null, weights[i]);
+        }
+    }
+
+    @Override
+    protected void onDeserialize(Deserializer buf) {
+        super.onDeserialize(buf);
+        quantile = buf.getDouble(null);
+        compression = buf.getDouble(null);
+        min = buf.getDouble(null);
+        max = buf.getDouble(null);
+        int size = buf.getInt(null);
+        means = new double[size];
+        weights = new double[size];
+        totalWeight = 0.0;
+        for (int i = 0; i < size; ++i) {
+            means[i] = buf.getDouble(null);
+            weights[i] = buf.getDouble(null);
+            totalWeight += weights[i];
+        }
+    }
+
+    @Override
+    protected int onGetClassId() {
+        return classId;
+    }
+
+    @Override
+    public void visitMembers(ObjectVisitor visitor) {
+        super.visitMembers(visitor);
+        visitor.visit("quantile", quantile);
+        visitor.visit("count", totalWeight);
+        visitor.visit("estimate", estimate(quantile));
+    }
+}
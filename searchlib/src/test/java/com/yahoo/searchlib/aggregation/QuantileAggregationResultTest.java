@@ -0,0 +1,81 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+package com.yahoo.searchlib.aggregation;
+
+import com.yahoo.vespa.objects.BufferSerializer;
+import com.yahoo.vespa.objects.Identifiable;
+import org.junit.Test;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+public class QuantileAggregationResultTest {
+
+    private static QuantileAggregationResult singletons(double quantile, double... values) {
+        double[] weights = new double[values.length];
+        java.util.Arrays.fill(weights, 1.0);
+        return new QuantileAggregationResult(quantile, values[0], values[values.length - 1], values, weights);
+    }
+
+    @Test
+    public void empty_result_estimates_zero() {
+        QuantileAggregationResult result = new QuantileAggregationResult();
+        assertEquals(0.5, result.getQuantile(), 0);
+        assertEquals(0.0, result.getCount(), 0);
+        assertEquals(0.0, result.getRank().getFloat(), 0);
+    }
+
+    @Test
+    public void rank_is_estimate_of_configured_quantile() {
+        QuantileAggregationResult result = singletons(0.5, 1, 2, 3, 4, 5);
+        assertEquals(3.0, result.getRank().getFloat(), 0.0001);
+        assertEquals(1.0, result.estimate(0.0), 0);
+        assertEquals(5.0, result.estimate(1.0), 0);
+        result.setQuantile(0.9);
+        assertEquals(result.estimate(0.9), result.getRank().getFloat(), 0);
+    }
+
+    @Test
+    public void results_are_merged() {
+        QuantileAggregationResult a = singletons(0.5, 1, 2, 3);
+        QuantileAggregationResult b = singletons(0.5, 4, 5);
+        a.merge(b);
+        assertEquals(5.0, a.getCount(), 0);
+        assertEquals(1.0, a.estimate(0.0), 0);
+        assertEquals(5.0, a.estimate(1.0), 0);
+        assertEquals(3.0, a.estimate(0.5), 0.0001);
+
+        QuantileAggregationResult empty = new QuantileAggregationResult();
+        empty.merge(a);
+        assertEquals(a.getCount(), empty.getCount(), 0);
+        assertEquals(a.estimate(0.5), empty.estimate(0.5), 0);
+    }
+
+    @Test
+    public void merged_sketch_is_bounded() {
+        QuantileAggregationResult result = new QuantileAggregationResult(0.99);
+        for (int i = 0; i < 100; ++i) {
+            double[] values = new double[100];
+            for (int j = 0; j < values.length; ++j) {
+                values[j] = i * 100 + j;
+            }
+            result.merge(singletons(0.99, values));
+        }
+        assertEquals(10000.0, result.getCount(), 0);
+        assertEquals(9900.0, result.getRank().getFloat(), 50.0);
+        assertEquals(5000.0, result.estimate(0.5), 100.0);
+    }
+
+    @Test
+    public void result_can_be_serialized() {
+        QuantileAggregationResult result = singletons(0.75, 1.5, 30.125, 100.25);
+        BufferSerializer buf = new BufferSerializer();
+        result.serializeWithId(buf);
+        buf.flip();
+        Identifiable obj = Identifiable.create(buf);
+        assertTrue(obj instanceof QuantileAggregationResult);
+        QuantileAggregationResult copy = (QuantileAggregationResult)obj;
+        assertEquals(result, copy);
+        assertEquals(0.75, copy.getQuantile(), 0);
+        assertEquals(result.getRank().getFloat(), copy.getRank().getFloat(), 0);
+    }
+}
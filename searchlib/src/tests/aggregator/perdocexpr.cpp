@@ -243,6 +243,51 @@ TEST("require that StandardDeviationAggregationResult aggregates multi-value exp
     EXPECT_APPROX(41.5, aggr.getRank().getFloat(), 0.1);
 }
 
+TEST("require that QuantileAggregationResult rank is the estimated quantile") {
+    QuantileAggregationResult aggr;
+    for (int64_t i = 1; i <= 101; ++i) {
+        aggr.setExpression(MU<ConstantNode>(MU<Int64ResultNode>(i))).
+                aggregate(DocId(i), HitRank(1));
+    }
+    EXPECT_EQUAL(0.5, aggr.getQuantile());
+    EXPECT_APPROX(51.0, aggr.getRank().getFloat(), 1.0);
+    aggr.setQuantile(0.9);
+    EXPECT_APPROX(91.0, aggr.getRank().getFloat(), 1.0);
+    EXPECT_EQUAL(101.0, aggr.estimate(1.0));
+}
+
+TEST("require that QuantileAggregationResult can be merged") {
+    QuantileAggregationResult aggr1;
+    aggr1.setExpression(createVectorFloat(std::vector<double>({1.0, 2.0, 3.0}))).
+            aggregate(DocId(42), HitRank(21));
+    QuantileAggregationResult aggr2;
+    aggr2.setExpression(createVectorFloat(std::vector<double>({4.0, 5.0}))).
+            aggregate(DocId(43), HitRank(8));
+
+    aggr1.merge(aggr2);
+    EXPECT_EQUAL(5.0, aggr1.getDigest().getTotalWeight());
+    EXPECT_EQUAL(1.0, aggr1.estimate(0.0));
+    EXPECT_EQUAL(5.0, aggr1.estimate(1.0));
+    EXPECT_APPROX(3.0, aggr1.getRank().getFloat(), 0.01);
+}
+
+TEST("require that QuantileAggregationResult can be serialized") {
+    QuantileAggregationResult aggr1;
+    aggr1.setQuantile(0.99).setExpression(createVectorFloat(std::vector<double>({1.5, 100.25, 30.125}))).
+            aggregate(DocId(42), HitRank(21));
+
+    nbostream os;
+    NBOSerializer nos(os);
+    nos << aggr1;
+    Identifiable::UP obj = Identifiable::create(nos);
+    auto *aggr2 = dynamic_cast<QuantileAggregationResult *>(obj.get());
+    ASSERT_TRUE(aggr2);
+    EXPECT_TRUE(os.empty());
+    EXPECT_EQUAL(0.99, aggr2->getQuantile());
+    EXPECT_TRUE(aggr1.getDigest() == aggr2->getDigest());
+    EXPECT_EQUAL(aggr1.getRank().getFloat(), aggr2->getRank().getFloat());
+}
+
 void testAdd(const ResultNode &a, const ResultNode &b, const ResultNode &c) {
     AddFunctionNode func;
     func.appendArg(MU<ConstantNode>(ResultNode::UP(a.clone())))
@@ -9,6 +9,7 @@
 #include <vespa/searchlib/attribute/attributefactory.h>
 #include <vespa/searchlib/attribute/attributememorysavetarget.h>
 #include <vespa/searchlib/attribute/singlenumericattribute.h>
+#include <vespa/searchlib/attribute/singlenumericattribute.hpp>
 #include <vespa/searchlib/attribute/multinumericattribute.h>
 #include <vespa/searchlib/attribute/singlestringattribute.h>
 #include <vespa/searchlib/attribute/multistringattribute.h>
@@ -214,6 +215,7 @@ private:
     void testGeneration();
 
     void testCreateSerialNum();
+    void testDeltaSave();
 
     void testPredicateHeaderTags();
 
@@ -566,6 +568,24 @@ void AttributeTest::testReload()
         testReloadInt(iv1, iv2, iv3, 0);
         testReloadInt(iv1, iv2, iv3, 100);
     }
+    {
+        Config cfg(BasicType::INT32, CollectionType::SINGLE);
+        cfg.setMmapLoad(true);
+        AttributePtr iv1 = createAttribute("smmsint32_1", cfg);
+        AttributePtr iv2 = createAttribute("smmsint32_2", cfg);
+        AttributePtr iv3 = createAttribute("smmsint32_3", cfg);
+        testReloadInt(iv1, iv2, iv3, 0);
+        testReloadInt(iv1, iv2, iv3, 100);
+    }
+    {
+        Config cfg(BasicType::INT32, CollectionType::SINGLE);
+        cfg.setHugePages(true);
+        AttributePtr iv1 = createAttribute("shpsint32_1", cfg);
+        AttributePtr iv2 = createAttribute("shpsint32_2", cfg);
+        AttributePtr iv3 = createAttribute("shpsint32_3", cfg);
+        testReloadInt(iv1, iv2, iv3, 0);
+        testReloadInt(iv1, iv2, iv3, 100);
+    }
     // CollectionType::ARRAY
     {
         Config cfg(BasicType::INT8, CollectionType::ARRAY);
@@ -1994,6 +2014,48 @@ AttributeTest::testCreateSerialNum()
     EXPECT_EQUAL(42u, attr2->getCreateSerialNum());
 }
 
+void
+AttributeTest::testDeltaSave()
+{
+    using IntAttribute = SingleValueNumericAttribute<IntegerAttributeTemplate<int32_t>>;
+    Config cfg(BasicType::INT32);
+    AttributePtr attr = createAttribute("deltaint32", cfg);
+    IntAttribute &ia = dynamic_cast<IntAttribute &>(*attr);
+    vespalib::string delta1 = baseFileName("deltaint32.delta1");
+    vespalib::string delta2 = baseFileName("deltaint32.delta2");
+    EXPECT_FALSE(ia.saveDelta(delta1));
+    ia.enableDeltaTracking();
+    attr->addDocs(10);
+    for (uint32_t lid = 0; lid < 10; ++lid) {
+        ia.update(lid, lid);
+    }
+    attr->commit();
+    EXPECT_TRUE(attr->save());
+
+    ia.update(3, 30);
+    ia.update(7, 70);
+    attr->commit();
+    EXPECT_TRUE(ia.saveDelta(delta1));
+    ia.update(7, 71);
+    ia.update(9, 90);
+    attr->commit();
+    EXPECT_TRUE(ia.saveDelta(delta2));
+
+    AttributePtr attr2 = createAttribute("deltaint32", cfg);
+    EXPECT_TRUE(attr2->load());
+    IntAttribute &ia2 = dynamic_cast<IntAttribute &>(*attr2);
+    EXPECT_EQUAL(7, ia2.get(7));
+    EXPECT_TRUE(ia2.loadDelta(delta1));
+    EXPECT_TRUE(ia2.loadDelta(delta2));
+    for (uint32_t lid = 0; lid < 10; ++lid) {
+        EXPECT_EQUAL(ia.get(lid), ia2.get(lid));
+    }
+    EXPECT_EQUAL(30, ia2.get(3));
+    EXPECT_EQUAL(71, ia2.get(7));
+    EXPECT_EQUAL(90, ia2.get(9));
+    EXPECT_FALSE(ia2.loadDelta(baseFileName("deltaint32.missing")));
+}
+
 void
 AttributeTest::testPredicateHeaderTags()
 {
@@ -2356,6 +2418,7 @@ int AttributeTest::Main()
     testNullProtection();
     testGeneration();
     testCreateSerialNum();
+    TEST_DO(testDeltaSave());
     testPredicateHeaderTags();
     TEST_DO(testCompactLidSpace());
     TEST_DO(requireThatAddressSpaceUsageIsReported());
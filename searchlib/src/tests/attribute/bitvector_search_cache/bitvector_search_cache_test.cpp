@@ -60,4 +60,31 @@ TEST_F("require that cache can be cleared", Fixture)
     EXPECT_TRUE(f.cache.find("bar").get() == nullptr);
 }
 
+TEST("require that sparse posting lists are cached as doc id arrays")
+{
+    BitVectorSP bitVector(BitVector::create(1000));
+    bitVector->setBit(3);
+    bitVector->setBit(500);
+    bitVector->invalidateCachedCount();
+    auto entry = Entry::create(IDocumentMetaStoreContext::IReadGuard::UP(), bitVector, 1000);
+    EXPECT_TRUE(entry->bitVector.get() == nullptr);
+    ASSERT_EQUAL(2u, entry->docIds.size());
+    EXPECT_EQUAL(3u, entry->docIds[0]._key);
+    EXPECT_EQUAL(500u, entry->docIds[1]._key);
+    EXPECT_EQUAL(1000u, entry->docIdLimit);
+}
+
+TEST("require that dense posting lists are cached as bit vectors")
+{
+    BitVectorSP bitVector(BitVector::create(100));
+    bitVector->setBit(3);
+    bitVector->setBit(50);
+    bitVector->setBit(70);
+    bitVector->setBit(90);
+    bitVector->invalidateCachedCount();
+    auto entry = Entry::create(IDocumentMetaStoreContext::IReadGuard::UP(), bitVector, 100);
+    EXPECT_EQUAL(bitVector, entry->bitVector);
+    EXPECT_TRUE(entry->docIds.empty());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -132,6 +132,32 @@ TEST_F("require string lookup works correctly", StringFixture) {
     verify_invalid_lookup(f1.api->lookup("bar"));
 }
 
+void verify_batch_lookup(const IDocumentWeightAttribute &api, const std::vector<vespalib::string> &terms,
+                         const std::vector<bool> &expect_valid)
+{
+    std::vector<IDocumentWeightAttribute::LookupResult> results;
+    api.lookup(terms, results);
+    ASSERT_EQUAL(terms.size(), results.size());
+    for (size_t i = 0; i < terms.size(); ++i) {
+        TEST_STATE(terms[i].c_str());
+        if (expect_valid[i]) {
+            verify_valid_lookup(results[i]);
+        } else {
+            verify_invalid_lookup(results[i]);
+        }
+    }
+}
+
+TEST_F("require that batched integer lookup works correctly", LongFixture) {
+    verify_batch_lookup(*f1.api, {"222", "111", "x", "-5", "111", "1000"}, {false, true, false, false, true, false});
+    verify_batch_lookup(*f1.api, {}, {});
+}
+
+TEST_F("require that batched string lookup works correctly", StringFixture) {
+    verify_batch_lookup(*f1.api, {"zap", "FOO", "bar", "foo", ""}, {false, true, false, true, false});
+    verify_batch_lookup(*f1.api, {}, {});
+}
+
 void verify_posting(const IDocumentWeightAttribute &api, const char *term) {
     auto result = api.lookup(term);
     ASSERT_TRUE(result.posting_idx.valid());
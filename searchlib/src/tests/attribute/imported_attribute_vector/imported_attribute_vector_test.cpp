@@ -3,6 +3,7 @@
 #include <vespa/searchlib/test/imported_attribute_fixture.h>
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
 #include <vespa/searchcommon/attribute/search_context_params.h>
+#include <vespa/searchlib/attribute/materialized_imported_values.h>
 
 namespace search {
 namespace attribute {
@@ -137,6 +138,42 @@ checkSingleMappedValueCount()
     EXPECT_EQUAL(1u, f.get_imported_attr()->getValueCount(DocId(1)));
 }
 
+TEST_F("Read guard uses materialized values that follow target attribute changes", Fixture) {
+    reset_with_single_value_reference_mappings<IntegerAttribute, int32_t>(
+            f, BasicType::INT32,
+            {{DocId(1), dummy_gid(3), DocId(3), 1234},
+             {DocId(3), dummy_gid(7), DocId(7), 5678}});
+    f.imported_attr->enableMaterializedValues();
+    ASSERT_TRUE(f.imported_attr->getMaterializedValues());
+    const auto &values = *f.imported_attr->getMaterializedValues();
+    {
+        auto guard = f.imported_attr->makeReadGuard(false);
+        EXPECT_EQUAL(1234, guard->getInt(DocId(1)));
+        EXPECT_EQUAL(5678.0, guard->getFloat(DocId(3)));
+    }
+    EXPECT_EQUAL(1u, values.getRebuilds());
+    {
+        auto guard = f.imported_attr->makeReadGuard(false);
+        EXPECT_EQUAL(1234, guard->getInt(DocId(1)));
+    }
+    EXPECT_EQUAL(1u, values.getRebuilds());
+    auto target = std::dynamic_pointer_cast<IntegerAttribute>(f.target_attr);
+    ASSERT_TRUE(target->update(DocId(3), 4321));
+    target->commit();
+    {
+        auto guard = f.imported_attr->makeReadGuard(false);
+        EXPECT_EQUAL(4321, guard->getInt(DocId(1)));
+        EXPECT_EQUAL(5678, guard->getInt(DocId(3)));
+    }
+    EXPECT_EQUAL(2u, values.getRebuilds());
+}
+
+TEST_F("Materialized values are not used for multi-value target attribute", Fixture) {
+    f.reset_with_new_target_attr(create_array_attribute<IntegerAttribute>(BasicType::INT32));
+    f.imported_attr->enableMaterializedValues();
+    EXPECT_FALSE(f.imported_attr->getMaterializedValues());
+}
+
 TEST("getValueCount() is 1 for mapped single value attribute") {
     TEST_DO(checkSingleMappedValueCount<Fixture>());
     TEST_DO(checkSingleMappedValueCount<ReadGuardFixture>());
@@ -385,6 +385,23 @@ TEST_F("Bit vector from search cache is used if found", SearchCacheFixture)
     EXPECT_EQUAL(0u, f.document_meta_store->get_read_guard_cnt);
 }
 
+TEST_F("Doc id array from search cache is used if found", SearchCacheFixture)
+{
+    BitVectorSearchCache::DocIds docIds;
+    docIds.emplace_back(2, search::btree::BTreeNoLeafData());
+    docIds.emplace_back(6, search::btree::BTreeNoLeafData());
+    f.imported_attr->getSearchCache()->insert("5678",
+                                              std::make_shared<BitVectorSearchCache::Entry>(IDocumentMetaStoreContext::IReadGuard::UP(),
+                                                                                            std::move(docIds),
+                                                                                            f.imported_attr->getNumDocs()));
+    auto ctx = f.create_context(word_term("5678"));
+    ctx->fetchPostings(true);
+    TermFieldMatchData match;
+    auto iter = f.create_strict_iterator(*ctx, match);
+    TEST_DO(f.assertSearch({2, 6}, *iter));
+    EXPECT_EQUAL(0u, f.document_meta_store->get_read_guard_cnt);
+}
+
 void
 assertBitVector(const std::vector<uint32_t> &expDocIds, const BitVector &bitVector)
 {
@@ -5,6 +5,7 @@
 #include <vespa/searchlib/attribute/multi_value_mapping.hpp>
 #include <vespa/searchlib/attribute/not_implemented_attribute.h>
 #include <vespa/searchlib/util/rand48.h>
+#include <vespa/searchcommon/common/compaction_strategy.h>
 #include <vespa/vespalib/util/generationhandler.h>
 #include <vespa/vespalib/test/insertion_operators.h>
 #include <vespa/vespalib/stllike/hash_set.h>
@@ -13,6 +14,7 @@
 LOG_SETUP("multivaluemapping_test");
 
 using search::datastore::ArrayStoreConfig;
+using search::CompactionStrategy;
 
 template <typename EntryT>
 void
@@ -132,6 +134,17 @@ public:
         _attr.commit();
         _attr.incGeneration();
     }
+    bool considerCompact(const CompactionStrategy &compactionStrategy) {
+        _attr.commit();
+        _attr.incGeneration();
+        _mvMapping.updateStat();
+        bool compacted = _mvMapping.considerCompact(compactionStrategy);
+        _attr.commit();
+        _attr.incGeneration();
+        return compacted;
+    }
+    bool isCompacting() const { return _mvMapping.isCompacting(); }
+    void setCompactionLidsPerStep(uint32_t lidsPerStep) { _mvMapping.setCompactionLidsPerStep(lidsPerStep); }
 };
 
 class IntFixture : public Fixture<int>
@@ -324,4 +337,34 @@ TEST_F("Test that compaction works", IntFixture(3, 64, 512, 129))
     EXPECT_LESS(bufferCountAfter, bufferCountBefore);
 }
 
+TEST_F("Test that incremental compaction works", IntFixture(3, 64, 512, 129))
+{
+    uint32_t addDocs = 10;
+    uint32_t bufferCountBefore = 0;
+    do {
+        f.addRandomDocs(addDocs);
+        addDocs *= 2;
+        bufferCountBefore = f.countBuffers();
+    } while (bufferCountBefore < 10 || f.size() < 100000);
+    uint32_t docIdLimit = f.size();
+    for (uint32_t docId = 0; docId < docIdLimit / 2; ++docId) {
+        f.clearDoc(docId);
+    }
+    f.setCompactionLidsPerStep(docIdLimit / 8);
+    CompactionStrategy compactionStrategy(0.2, 0.2);
+    EXPECT_TRUE(f.considerCompact(compactionStrategy));
+    uint32_t steps = 1;
+    while (f.isCompacting()) {
+        TEST_DO(f.checkRefMapping());
+        f.addRandomDoc();
+        EXPECT_TRUE(f.considerCompact(compactionStrategy));
+        ++steps;
+    }
+    LOG(info, "Compacted in %u steps", steps);
+    EXPECT_LESS_EQUAL(8u, steps);
+    EXPECT_LESS_EQUAL(steps, 9u);
+    TEST_DO(f.checkRefMapping());
+    EXPECT_LESS(f.countBuffers(), bufferCountBefore);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
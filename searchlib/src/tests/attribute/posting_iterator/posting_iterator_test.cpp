@@ -0,0 +1,109 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/searchlib/attribute/attributeiterators.hpp>
+#include <vespa/searchlib/attribute/dociditerator.h>
+#include <vespa/searchlib/btree/btree.hpp>
+#include <vespa/searchlib/btree/btreeroot.hpp>
+#include <vespa/searchlib/btree/btreenodeallocator.hpp>
+#include <vespa/searchlib/btree/btreenodestore.hpp>
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+
+using namespace search;
+using search::btree::BTreeNoLeafData;
+using search::fef::TermFieldMatchData;
+
+using PostingTree = btree::BTree<uint32_t, BTreeNoLeafData, btree::NoAggregated,
+                                 std::less<uint32_t>, btree::BTreeDefaultTraits>;
+using PostingIterator = FilterAttributePostingListIteratorT<InnerAttributePostingListIterator>;
+
+constexpr uint32_t docid_limit = 10000;
+
+std::vector<AttributePosting> make_postings(uint32_t step) {
+    std::vector<AttributePosting> result;
+    for (uint32_t docid = step; docid < docid_limit; docid += step) {
+        result.emplace_back(docid, BTreeNoLeafData());
+    }
+    return result;
+}
+
+BitVector::UP make_hits(uint32_t step) {
+    BitVector::UP result = BitVector::create(1, docid_limit);
+    for (uint32_t docid = step; docid < docid_limit; docid += step) {
+        result->setBit(docid);
+    }
+    result->invalidateCachedCount();
+    return result;
+}
+
+struct Fixture {
+    PostingTree        tree;
+    TermFieldMatchData tfmd;
+    Fixture(uint32_t step) : tree(), tfmd() {
+        for (const auto &posting: make_postings(step)) {
+            tree.insert(posting._key, posting.getData());
+        }
+    }
+    queryeval::SearchIterator::UP make_iterator() {
+        return std::make_unique<PostingIterator>(&tfmd, tree.begin());
+    }
+};
+
+TEST("require that galloping seek in docid array finds first docid not below target") {
+    auto postings = make_postings(3);
+    for (uint32_t start = 0; start < 5; ++start) {
+        for (uint32_t target = 1; target < docid_limit + 2; target += 7) {
+            DocIdIterator<AttributePosting> itr;
+            itr.set(&postings[0] + start, &postings[0] + postings.size());
+            itr.seek(target);
+            auto expect = std::lower_bound(postings.begin() + start, postings.end(), AttributePosting(target, BTreeNoLeafData()));
+            if (expect == postings.end()) {
+                EXPECT_FALSE(itr.valid());
+            } else {
+                ASSERT_TRUE(itr.valid());
+                EXPECT_EQUAL(expect->_key, itr.getKey());
+            }
+        }
+    }
+}
+
+TEST("require that posting list iterator seeks to next docid in posting list") {
+    Fixture f(3);
+    queryeval::SearchIterator::UP itr = f.make_iterator();
+    itr->initRange(1, docid_limit);
+    EXPECT_EQUAL(3u, itr->getDocId());
+    EXPECT_FALSE(itr->seek(5));
+    EXPECT_EQUAL(6u, itr->getDocId());
+    EXPECT_TRUE(itr->seek(3000));
+    EXPECT_FALSE(itr->seek(docid_limit - 2));
+    EXPECT_EQUAL(docid_limit - 1, itr->getDocId());
+    EXPECT_FALSE(itr->seek(docid_limit));
+    EXPECT_TRUE(itr->isAtEnd());
+}
+
+TEST("require that posting list is intersected with sparse and dense results") {
+    for (uint32_t hit_step: {1u, 2u, 5u, 1000u}) {
+        Fixture f(3);
+        queryeval::SearchIterator::UP itr = f.make_iterator();
+        itr->initRange(1, docid_limit);
+        BitVector::UP result = make_hits(hit_step);
+        BitVector::UP expect = make_hits(hit_step);
+        expect->andWith(*make_hits(3));
+        itr->and_hits_into(*result, 1);
+        EXPECT_TRUE(*expect == *result);
+        EXPECT_EQUAL(expect->countTrueBits(), result->countTrueBits());
+    }
+}
+
+TEST("require that intersection with empty posting list clears all hits") {
+    PostingTree tree;
+    TermFieldMatchData tfmd;
+    queryeval::SearchIterator::UP itr = std::make_unique<PostingIterator>(&tfmd, tree.begin());
+    itr->initRange(1, docid_limit);
+    BitVector::UP result = make_hits(2);
+    itr->and_hits_into(*result, 1);
+    EXPECT_EQUAL(0u, result->countTrueBits());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -12,6 +12,11 @@
 #include <vespa/searchlib/query/tree/point.h>
 #include <vespa/searchlib/query/tree/simplequery.h>
 #include <vespa/searchlib/queryeval/fake_requestcontext.h>
+#include <vespa/searchlib/queryeval/nearest_neighbor_blueprint.h>
+#include <vespa/searchlib/tensor/dense_tensor_attribute.h>
+#include <vespa/eval/tensor/tensor.h>
+#include <vespa/eval/tensor/tensor_factory.h>
+#include <vespa/vespalib/test/insertion_operators.h>
 #include <vespa/vespalib/testkit/testapp.h>
 
 #include <vespa/log/log.h>
@@ -29,6 +34,7 @@ using search::query::Location;
 using search::query::Node;
 using search::query::Point;
 using search::query::SimpleLocationTerm;
+using search::query::SimpleNearestNeighborTerm;
 using search::query::SimplePrefixTerm;
 using search::query::SimpleStringTerm;
 using search::query::Weight;
@@ -36,6 +42,11 @@ using search::queryeval::Blueprint;
 using search::queryeval::FieldSpec;
 using search::queryeval::SearchIterator;
 using search::queryeval::FakeRequestContext;
+using search::queryeval::NearestNeighborBlueprint;
+using search::tensor::DenseTensorAttribute;
+using vespalib::eval::ValueType;
+using vespalib::tensor::DenseTensorCells;
+using vespalib::tensor::TensorFactory;
 using std::string;
 using std::vector;
 using namespace search::attribute;
@@ -49,6 +60,8 @@ class Test : public vespalib::TestApp {
     void requireThatPrefixTermsWork();
     void requireThatLocationTermsWork();
     void requireThatFastSearchLocationTermsWork();
+    void requireThatNearestNeighborTermsWork();
+    void requireThatNearestNeighborTermWithoutIndexGivesEmptyBlueprint();
 
     bool search(const string &term, IAttributeManager &attribute_manager);
     bool search(const Node &term, IAttributeManager &attribute_manager);
@@ -67,6 +80,8 @@ Test::Main()
     TEST_DO(requireThatPrefixTermsWork());
     TEST_DO(requireThatLocationTermsWork());
     TEST_DO(requireThatFastSearchLocationTermsWork());
+    TEST_DO(requireThatNearestNeighborTermsWork());
+    TEST_DO(requireThatNearestNeighborTermWithoutIndexGivesEmptyBlueprint());
 
     TEST_DONE();
 }
@@ -234,6 +249,63 @@ void Test::requireThatFastSearchLocationTermsWork() {
 #endif
 }
 
+MyAttributeManager makeDenseTensorAttribute(bool useHnswIndex) {
+    Config cfg(BasicType::TENSOR, CollectionType::SINGLE);
+    cfg.setTensorType(ValueType::from_spec("tensor(x[2])"));
+    if (useHnswIndex) {
+        cfg.setHnswIndexParams(HnswIndexParams(true, 4, 20));
+    }
+    DenseTensorAttribute *attr = new DenseTensorAttribute(field, cfg);
+    attr->addReservedDoc();
+    for (uint32_t docId = 1; docId < 10; ++docId) {
+        AttributeVector::DocId docid;
+        attr->addDoc(docid);
+        assert(docid == docId);
+        attr->setTensor(docId, *TensorFactory::createDense(DenseTensorCells({ {{{"x", 0}}, double(docId)},
+                                                                              {{{"x", 1}}, 0.0} })));
+        attr->commit();
+    }
+    return MyAttributeManager(attr);
+}
+
+std::vector<uint32_t> searchNearestNeighbor(const Node &node, IAttributeManager &attribute_manager) {
+    AttributeContext ac(attribute_manager);
+    FakeRequestContext requestContext(&ac);
+    MatchData::UP md(MatchData::makeTestInstance(1, 1));
+    AttributeBlueprintFactory source;
+    Blueprint::UP result = source.createBlueprint(requestContext, FieldSpec(field, 0, 0), node);
+    std::vector<uint32_t> hits;
+    ASSERT_TRUE(result.get());
+    result->fetchPostings(true);
+    result->setDocIdLimit(10);
+    SearchIterator::UP iterator = result->createSearch(*md, true);
+    iterator->initRange(1, 10);
+    for (uint32_t docId = 1; docId < 10; ++docId) {
+        if (iterator->seek(docId)) {
+            iterator->unpack(docId);
+            EXPECT_GREATER(md->resolveTermField(0)->getRawScore(), 0.0);
+            hits.push_back(docId);
+        }
+    }
+    return hits;
+}
+
+void Test::requireThatNearestNeighborTermsWork() {
+    MyAttributeManager attribute_manager = makeDenseTensorAttribute(true);
+
+    SimpleNearestNeighborTerm node({6.1, 0.0}, field, 0, Weight(0), 3, 10);
+    EXPECT_EQUAL(std::vector<uint32_t>({5, 6, 7}), searchNearestNeighbor(node, attribute_manager));
+    SimpleNearestNeighborTerm farNode({-100.0, 0.0}, field, 0, Weight(0), 2, 10);
+    EXPECT_EQUAL(std::vector<uint32_t>({1, 2}), searchNearestNeighbor(farNode, attribute_manager));
+}
+
+void Test::requireThatNearestNeighborTermWithoutIndexGivesEmptyBlueprint() {
+    MyAttributeManager attribute_manager = makeDenseTensorAttribute(false);
+
+    SimpleNearestNeighborTerm node({6.1, 0.0}, field, 0, Weight(0), 3, 10);
+    EXPECT_EQUAL(std::vector<uint32_t>(), searchNearestNeighbor(node, attribute_manager));
+}
+
 }  // namespace
 
 TEST_APPHOOK(Test);
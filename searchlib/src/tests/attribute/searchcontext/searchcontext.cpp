@@ -273,6 +273,10 @@ private:
                                                        int64_t maxValue);
     void requireThatOutOfBoundsSearchTermGivesZeroHits();
 
+    void requireThatGetHitsMatchesSeekForSingleValueRange(const vespalib::string &name, const Config &cfg);
+    void requireThatGetHitsMatchesSeekForSingleValueRange();
+    void requireThatRangeSearchSkipsBlocksOnlyWhenNoValueCanMatch();
+
     // init maps with config objects
     void initIntegerConfig();
     void initFloatConfig();
@@ -1787,6 +1791,85 @@ SearchContextTest::requireThatOutOfBoundsSearchTermGivesZeroHits()
     }
 }
 
+void
+SearchContextTest::requireThatGetHitsMatchesSeekForSingleValueRange(const vespalib::string &name,
+                                                                    const Config &cfg)
+{
+    LOG(info, "requireThatGetHitsMatchesSeekForSingleValueRange: vector '%s'", name.c_str());
+    AttributePtr a = AttributeFactory::createAttribute(name, cfg);
+    IntegerAttribute &ia = dynamic_cast<IntegerAttribute &>(*a);
+    addReservedDoc(*a);
+    uint32_t numDocs = 300;
+    a->addDocs(numDocs - 1);
+    for (uint32_t docId = 1; docId < numDocs; ++docId) {
+        ia.update(docId, docId % 7);
+    }
+    ia.commit(true);
+    for (uint32_t beginId : {1u, 64u, 67u}) {
+        TermFieldMatchData dummy;
+        SearchContextPtr sc = getSearch(ia, "[2;4]");
+        sc->fetchPostings(false);
+        SearchBasePtr sb = sc->createIterator(&dummy, false);
+        sb->initRange(beginId, numDocs);
+        BitVector::UP hits = sb->get_hits(beginId);
+        uint32_t expHits = 0;
+        for (uint32_t docId = beginId; docId < numDocs; ++docId) {
+            uint32_t value = docId % 7;
+            bool expHit = (value >= 2 && value <= 4);
+            EXPECT_EQUAL(expHit, hits->testBit(docId));
+            expHits += expHit ? 1 : 0;
+        }
+        EXPECT_EQUAL(expHits, hits->countTrueBits());
+    }
+}
+
+void
+SearchContextTest::requireThatGetHitsMatchesSeekForSingleValueRange()
+{
+    requireThatGetHitsMatchesSeekForSingleValueRange("s-int32", _integerCfg["s-int32"]);
+    requireThatGetHitsMatchesSeekForSingleValueRange("s-int8", Config(BasicType::INT8, CollectionType::SINGLE));
+}
+
+void
+SearchContextTest::requireThatRangeSearchSkipsBlocksOnlyWhenNoValueCanMatch()
+{
+    LOG(info, "requireThatRangeSearchSkipsBlocksOnlyWhenNoValueCanMatch()");
+    AttributePtr a = AttributeFactory::createAttribute("s-int32", _integerCfg["s-int32"]);
+    IntegerAttribute &ia = dynamic_cast<IntegerAttribute &>(*a);
+    addReservedDoc(*a);
+    uint32_t numDocs = 3 * 4096 + 100;
+    a->addDocs(numDocs - 1);
+    for (uint32_t docId = 1; docId < numDocs; ++docId) {
+        ia.update(docId, (docId / 4096) * 100 + (docId % 10));
+    }
+    ia.commit(true);
+    {
+        ResultSetPtr rs = performSearch(ia, "[100;101]");
+        EXPECT_EQUAL(820u, rs->getNumHits());
+        EXPECT_EQUAL(4100u, rs->getArray()[0]._docId);
+    }
+    // Values moved into a block that was skipped before must be found
+    ia.update(5, 101);
+    ia.update(3 * 4096 + 50, 100);
+    ia.commit(true);
+    {
+        ResultSetPtr rs = performSearch(ia, "[100;101]");
+        EXPECT_EQUAL(822u, rs->getNumHits());
+        EXPECT_EQUAL(5u, rs->getArray()[0]._docId);
+        EXPECT_EQUAL(3u * 4096 + 50, rs->getArray()[rs->getNumHits() - 1]._docId);
+    }
+    {
+        TermFieldMatchData dummy;
+        SearchContextPtr sc = getSearch(ia, "[100;101]");
+        sc->fetchPostings(false);
+        SearchBasePtr sb = sc->createIterator(&dummy, false);
+        sb->initRange(1, numDocs);
+        BitVector::UP hits = sb->get_hits(1);
+        EXPECT_EQUAL(822u, hits->countTrueBits());
+        EXPECT_TRUE(hits->testBit(5));
+        EXPECT_TRUE(hits->testBit(3 * 4096 + 50));
+    }
+}
 
 void
 SearchContextTest::initIntegerConfig()
@@ -1918,6 +2001,8 @@ SearchContextTest::Main()
     TEST_DO(requireThatInvalidSearchTermGivesZeroHits());
     TEST_DO(requireThatFlagAttributeHandlesTheByteRange());
     TEST_DO(requireThatOutOfBoundsSearchTermGivesZeroHits());
+    TEST_DO(requireThatGetHitsMatchesSeekForSingleValueRange());
+    TEST_DO(requireThatRangeSearchSkipsBlocksOnlyWhenNoValueCanMatch());
 
     TEST_DONE();
 }
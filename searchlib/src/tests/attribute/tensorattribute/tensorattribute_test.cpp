@@ -8,11 +8,13 @@
 #include <vespa/eval/tensor/tensor_factory.h>
 #include <vespa/eval/tensor/default_tensor.h>
 #include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/test/insertion_operators.h>
 #include <vespa/vespalib/data/fileheader.h>
 #include <vespa/fastos/file.h>
 #include <vespa/log/log.h>
 LOG_SETUP("tensorattribute_test");
 
+using search::attribute::HnswIndexParams;
 using search::tensor::TensorAttribute;
 using search::tensor::DenseTensorAttribute;
 using search::tensor::GenericTensorAttribute;
@@ -56,9 +58,11 @@ struct Fixture
     vespalib::tensor::DefaultTensor::builder _builder;
     bool _denseTensors;
     bool _useDenseTensorAttribute;
+    bool _useHnswIndex;
 
     Fixture(const vespalib::string &typeSpec,
-            bool useDenseTensorAttribute = false)
+            bool useDenseTensorAttribute = false,
+            bool useHnswIndex = false)
         : _cfg(BasicType::TENSOR, CollectionType::SINGLE),
           _name("test"),
           _typeSpec(typeSpec),
@@ -66,9 +70,13 @@ struct Fixture
           _attr(),
           _builder(),
           _denseTensors(false),
-          _useDenseTensorAttribute(useDenseTensorAttribute)
+          _useDenseTensorAttribute(useDenseTensorAttribute),
+          _useHnswIndex(useHnswIndex)
     {
         _cfg.setTensorType(ValueType::from_spec(typeSpec));
+        if (useHnswIndex) {
+            _cfg.setHnswIndexParams(HnswIndexParams(true, 4, 20));
+        }
         if (_cfg.tensorType().is_dense()) {
             _denseTensors = true;
         }
@@ -333,6 +341,17 @@ Fixture::testCompaction()
     TEST_DO(assertGetTensor(*filltensor, 2));
     TEST_DO(assertGetTensor(*simpletensor, 3));
     TEST_DO(assertGetTensor(*emptyxytensor, 4));
+    if (_useHnswIndex) {
+        AttributeGuard guard(_attr);
+        const auto &index = *dynamic_cast<const DenseTensorAttribute &>(*_tensorAttr).nearestNeighborIndex();
+        std::vector<double> query(6, 0.0);
+        std::vector<uint32_t> hits;
+        for (const auto &hit : index.findTopK(3, vespalib::ConstArrayRef<double>(query), 10)) {
+            hits.push_back(hit.docId);
+        }
+        std::sort(hits.begin(), hits.end());
+        EXPECT_EQUAL(std::vector<uint32_t>({2, 3, 4}), hits);
+    }
 }
 
 void
@@ -403,6 +422,27 @@ TEST("Test dense tensors with dense tensor attribute")
     testAll([]() { return std::make_shared<Fixture>(denseSpec, true); });
 }
 
+TEST("Test dense tensors with dense tensor attribute with hnsw index")
+{
+    testAll([]() { return std::make_shared<Fixture>(denseSpec, true, true); });
+}
+
+TEST("Test that hnsw index memory usage is included in attribute status")
+{
+    Fixture plain(denseSpec, true);
+    Fixture indexed(denseSpec, true, true);
+    for (uint32_t docId = 1; docId < 20; ++docId) {
+        Tensor::UP tensor = plain.createDenseTensor({ {{{"x",0},{"y",0}}, double(docId)},
+                                                      {{{"x",1},{"y",2}}, double(docId % 3)} });
+        plain.setTensor(docId, *tensor);
+        indexed.setTensor(docId, *tensor);
+    }
+    search::attribute::Status plainStatus = plain.getStatus();
+    search::attribute::Status indexedStatus = indexed.getStatus();
+    EXPECT_GREATER(indexedStatus.getUsed(), plainStatus.getUsed());
+    EXPECT_GREATER(indexedStatus.getAllocated(), plainStatus.getAllocated());
+}
+
 TEST("Test dense tensors with generic tensor attribute with unbound x and y dims")
 {
     testAll([]() { return std::make_shared<Fixture>(denseAbstractSpec_xy); });
@@ -185,6 +185,7 @@ private:
     void requireThatTreeRemoveStealWorks();
     void requireThatNodeRemoveWorks();
     void requireThatNodeLowerBoundWorks();
+    void requireThatNodeKeySearchMatchesBinarySearch();
     void requireThatWeCanInsertAndRemoveFromTree();
     void requireThatSortedTreeInsertWorks();
     void requireThatCornerCaseTreeFindWorks();
@@ -669,6 +670,28 @@ Test::requireThatNodeLowerBoundWorks()
     cleanup(g, m, nPair.ref, n);
 }
 
+void
+Test::requireThatNodeKeySearchMatchesBinarySearch()
+{
+    using KeySearch = BTreeNodeKeySearch<uint32_t, std::less<uint32_t>>;
+    std::less<uint32_t> comp;
+    Rand48 rnd;
+    rnd.srand48(42);
+    for (uint32_t numKeys = 0; numKeys <= 32; ++numKeys) {
+        std::vector<uint32_t> keys;
+        for (uint32_t i = 0; i < numKeys; ++i) {
+            keys.push_back(rnd.lrand48() % 64);
+        }
+        std::sort(keys.begin(), keys.end());
+        const uint32_t *b = keys.data();
+        const uint32_t *e = keys.data() + keys.size();
+        for (uint32_t key = 0; key <= 65; ++key) {
+            EXPECT_EQUAL(std::lower_bound(b, e, key) - b, KeySearch::lower_bound(b, e, key, comp) - b);
+            EXPECT_EQUAL(std::upper_bound(b, e, key) - b, KeySearch::upper_bound(b, e, key, comp) - b);
+        }
+    }
+}
+
 void
 generateData(std::vector<LeafPair> & data, size_t numEntries)
 {
@@ -1494,6 +1517,7 @@ Test::Main()
     requireThatTreeRemoveStealWorks();
     requireThatNodeRemoveWorks();
     requireThatNodeLowerBoundWorks();
+    requireThatNodeKeySearchMatchesBinarySearch();
     requireThatWeCanInsertAndRemoveFromTree();
     requireThatSortedTreeInsertWorks();
     requireThatCornerCaseTreeFindWorks();
@@ -298,4 +298,20 @@ TEST("test small expand")
     g.trimHoldLists(2);
 }
 
+TEST("require that huge page allocation is kept when expanding")
+{
+    GenerationHolder g;
+    constexpr size_t hugePageElems = vespalib::alloc::MemoryAllocator::HUGEPAGE_SIZE / sizeof(int32_t);
+    RcuVectorBase<int32_t> v(16, 100, 0, g, Alloc::allocHugePages());
+    EXPECT_EQUAL(hugePageElems, v.capacity());
+    EXPECT_EQUAL(hugePageElems * sizeof(int32_t), v.getMemoryUsage().allocatedBytesOnHugePages());
+    v.ensure_size(hugePageElems + 1);
+    EXPECT_LESS(hugePageElems, v.capacity());
+    EXPECT_EQUAL(v.getMemoryUsage().allocatedBytes(), v.getMemoryUsage().allocatedBytesOnHugePages());
+    RcuVectorBase<int32_t> plain(16, 100, 0, g);
+    EXPECT_EQUAL(0u, plain.getMemoryUsage().allocatedBytesOnHugePages());
+    g.transferHoldLists(1);
+    g.trimHoldLists(2);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
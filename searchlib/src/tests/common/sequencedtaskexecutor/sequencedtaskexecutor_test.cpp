@@ -4,6 +4,7 @@
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/vespalib/test/insertion_operators.h>
 
+#include <algorithm>
 #include <mutex>
 #include <condition_variable>
 #include <unistd.h>
@@ -19,8 +20,8 @@ class Fixture
 public:
     SequencedTaskExecutor _threads;
 
-    Fixture()
-        : _threads(2)
+    Fixture(bool rebalance = false)
+        : _threads(2, 1000, rebalance)
     {
     }
 };
@@ -234,6 +235,40 @@ TEST_F("require that executeLambda works", Fixture)
     EXPECT_EQUAL(5, i);
 }
 
+TEST_F("require that each component id gets its own executor id when rebalancing", Fixture(true))
+{
+    uint32_t id0 = f._threads.getExecutorId(0);
+    uint32_t id1 = f._threads.getExecutorId(1);
+    uint32_t id2 = f._threads.getExecutorId(2);
+    EXPECT_NOT_EQUAL(id0, id1);
+    EXPECT_NOT_EQUAL(id0, id2);
+    EXPECT_NOT_EQUAL(id1, id2);
+    EXPECT_EQUAL(id0, f._threads.getExecutorId(0));
+}
+
+TEST_F("require that tasks with same component id are run in order when rebalancing", Fixture(true))
+{
+    constexpr uint32_t numComponents = 5;
+    constexpr uint32_t numTasks = 5000;
+    std::vector<std::vector<uint32_t>> seen(numComponents);
+    for (uint32_t i = 0; i < numTasks; ++i) {
+        uint32_t component = (i % 3 == 0) ? 0 : (i % numComponents);
+        f._threads.execute(component, [&seen, component, i]()
+                           {
+                               if (component == 0) {
+                                   usleep(10);
+                               }
+                               seen[component].push_back(i);
+                           });
+    }
+    f._threads.sync();
+    uint32_t total = 0;
+    for (const auto &values : seen) {
+        EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+        total += values.size();
+    }
+    EXPECT_EQUAL(numTasks, total);
+}
 
 }
 
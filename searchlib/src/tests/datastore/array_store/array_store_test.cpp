@@ -27,8 +27,9 @@ struct Fixture
     ArrayStoreType store;
     ReferenceStore refStore;
     generation_t generation;
-    Fixture(uint32_t maxSmallArraySize)
-        : store(ArrayStoreConfig(maxSmallArraySize, ArrayStoreConfig::AllocSpec(16, RefT::offsetSize(), 8 * 1024))),
+    Fixture(uint32_t maxSmallArraySize, bool usePaging = false)
+        : store(ArrayStoreConfig(maxSmallArraySize, ArrayStoreConfig::AllocSpec(16, RefT::offsetSize(), 8 * 1024)).
+                setUsePaging(usePaging)),
           refStore(),
           generation(1)
     {}
@@ -309,6 +310,32 @@ TEST_F("require that used, onHold and dead memory usage is tracked for large arr
                                     dead(f.largeArraySize())));
 }
 
+TEST_F("require that small arrays can be stored in paged buffers", NumberFixture(3, true))
+{
+    f.assertAdd({1});
+    f.assertAdd({2,3});
+    f.assertAdd({4,5,6});
+    f.assertAdd({7,8,9,10});
+    EntryRef ref = f.getEntryRef({2,3});
+    EXPECT_TRUE(f.store.bufferState(ref).isPaged());
+    EXPECT_FALSE(f.store.bufferState(f.getEntryRef({7,8,9,10})).isPaged());
+    MemoryUsage usage = f.store.getMemoryUsage();
+    EXPECT_LESS(0u, usage.allocatedBytesPaged());
+    EXPECT_LESS(0u, usage.residentBytesPaged());
+    EXPECT_LESS_EQUAL(usage.residentBytesPaged(), usage.allocatedBytesPaged());
+    EXPECT_LESS_EQUAL(usage.residentBytes(), usage.allocatedBytes());
+    f.remove({2,3});
+    f.trimHoldLists();
+    TEST_DO(f.assertStoreContent());
+}
+
+TEST_F("require that buffers are not paged by default", NumberFixture(3))
+{
+    f.add({2,3});
+    EXPECT_FALSE(f.store.bufferState(f.getEntryRef({2,3})).isPaged());
+    EXPECT_EQUAL(0u, f.store.getMemoryUsage().allocatedBytesPaged());
+}
+
 TEST_F("require that address space usage is ratio between used clusters and number of possible clusters", NumberFixture(3))
 {
     f.add({2,2});
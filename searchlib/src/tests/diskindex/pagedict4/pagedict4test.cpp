@@ -823,6 +823,55 @@ testWords(const std::string &logname,
         (void) closeres;
         LOG(info, "%s: pagedict4 randverify OK", logname.c_str());
     }
+    {
+        std::unique_ptr<DictionaryFileRandRead> drr(new PageDict4RandRead);
+        search::TuneFileRandRead tuneFileRead;
+        tuneFileRead.setWantMemoryMap();
+        bool openres = drr->open("fakedict",
+                                 tuneFileRead);
+        assert(openres);
+        (void) openres;
+        PostingListOffsetAndCounts rOffsetAndCounts;
+        PostingListOffsetAndCounts cOffsetAndCounts;
+        std::string missWord;
+        for (uint32_t pass = 0; pass < 2; ++pass) {
+            uint64_t wordNum = 1;
+            for (std::vector<WordCounts>::const_iterator
+                     i = myrand.begin(),
+                     ie = myrand.end();
+                 i != ie;
+                 ++i, ++wordNum) {
+                makeCounts(counts, *i, chunkSize);
+                uint64_t checkWordNum = 0;
+                bool lres = drr->lookup(i->_word, checkWordNum,
+                                        rOffsetAndCounts);
+                assert(lres);
+                assert(wordNum == checkWordNum);
+                assert(rOffsetAndCounts._counts == counts);
+                // Repeated lookup is served by the per-thread cache
+                checkWordNum = 0;
+                lres = drr->lookup(i->_word, checkWordNum,
+                                   cOffsetAndCounts);
+                assert(lres);
+                assert(wordNum == checkWordNum);
+                assert(cOffsetAndCounts._offset == rOffsetAndCounts._offset);
+                assert(cOffsetAndCounts._counts == rOffsetAndCounts._counts);
+
+                missWord = i->_word;
+                missWord.append(1, '\1');
+                checkWordNum = 0;
+                lres = drr->lookup(missWord, checkWordNum,
+                                   rOffsetAndCounts);
+                assert(!lres);
+                assert(checkWordNum == wordNum + 1);
+                (void) lres;
+            }
+        }
+        bool closeres = drr->close();
+        assert(closeres);
+        (void) closeres;
+        LOG(info, "%s: pagedict4 mmap randverify OK", logname.c_str());
+    }
 }
 
 
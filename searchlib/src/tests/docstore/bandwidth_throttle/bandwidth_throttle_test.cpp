@@ -0,0 +1,37 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/searchlib/docstore/bandwidththrottle.h>
+
+using search::docstore::BandwidthThrottle;
+using namespace std::chrono;
+using Clock = BandwidthThrottle::Clock;
+
+TEST("require that consumption is spread over time") {
+    BandwidthThrottle throttle(1000);
+    Clock::time_point now = Clock::now();
+    EXPECT_TRUE(Clock::duration::zero() == throttle.consume(500, now));
+    EXPECT_TRUE(milliseconds(500) == duration_cast<milliseconds>(throttle.consume(1000, now)));
+    EXPECT_TRUE(milliseconds(1500) == duration_cast<milliseconds>(throttle.consume(100, now)));
+    EXPECT_TRUE(milliseconds(600) == duration_cast<milliseconds>(throttle.consume(100, now + milliseconds(1000))));
+}
+
+TEST("require that idle time is not saved up") {
+    BandwidthThrottle throttle(1000);
+    Clock::time_point now = Clock::now();
+    EXPECT_TRUE(Clock::duration::zero() == throttle.consume(1000, now));
+    now += seconds(10);
+    EXPECT_TRUE(Clock::duration::zero() == throttle.consume(1000, now));
+    EXPECT_TRUE(milliseconds(1000) == duration_cast<milliseconds>(throttle.consume(1000, now)));
+}
+
+TEST("require that throttle sleeps when bandwidth is exceeded") {
+    BandwidthThrottle throttle(100000);
+    Clock::time_point start = Clock::now();
+    throttle.throttle(1000);
+    throttle.throttle(1000);
+    throttle.throttle(1000);
+    EXPECT_GREATER_EQUAL(duration_cast<milliseconds>(Clock::now() - start).count(), 20);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -8,11 +8,14 @@
 #include <vespa/searchlib/docstore/chunkformats.h>
 #include <vespa/vespalib/objects/hexdump.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 
 LOG_SETUP("chunk_test");
 
 using namespace search;
 using vespalib::compression::CompressionConfig;
+using vespalib::compression::ZStdDictionary;
 
 TEST("require that Chunk obey limits")
 {
@@ -98,4 +101,42 @@ TEST("require that V2 can create and handle lz4, zstd, and none") {
     verifyChunkCompression(CompressionConfig::ZSTD, MY_LONG_STRING, strlen(MY_LONG_STRING), 282);
 }
 
+vespalib::string makeDocument(size_t i) {
+    return vespalib::make_string("{\"title\":\"Document %zu of a series\",\"price\":%zu,\"category\":\"books\","
+                                 "\"description\":\"A rather repetitive description of item %zu\"}", i, i*7, i % 13);
+}
+
+TEST("require that V2 can use a trained zstd dictionary") {
+    vespalib::string samples;
+    std::vector<size_t> sampleSizes;
+    for (size_t i(0); i < 2000; i++) {
+        vespalib::string doc = makeDocument(i);
+        samples += doc;
+        sampleSizes.push_back(doc.size());
+    }
+    std::vector<char> data = ZStdDictionary::train(vespalib::ConstBufferRef(samples.c_str(), samples.size()), sampleSizes, 4096);
+    ASSERT_FALSE(data.empty());
+    ZStdDictionary dictionary(data.data(), data.size());
+
+    vespalib::string doc = makeDocument(4711);
+    CompressionConfig cfg(CompressionConfig::ZSTD);
+    ChunkFormatV2 plain(10);
+    plain.getBuffer().write(doc.c_str(), doc.size());
+    vespalib::DataBuffer plainBuffer;
+    plain.pack(7, plainBuffer, cfg);
+    ChunkFormatV2 chunk(10);
+    chunk.getBuffer().write(doc.c_str(), doc.size());
+    vespalib::DataBuffer buffer;
+    chunk.pack(7, buffer, cfg, &dictionary);
+    EXPECT_LESS(buffer.getDataLen(), plainBuffer.getDataLen());
+
+    ChunkFormat::UP deserialized = ChunkFormat::deserialize(buffer.getData(), buffer.getDataLen(), false, &dictionary);
+    std::vector<char> v(doc.size());
+    deserialized->getBuffer().read(&v[0], doc.size());
+    EXPECT_EQUAL(0, memcmp(doc.c_str(), &v[0], doc.size()));
+    ChunkFormat::UP deserializedPlain = ChunkFormat::deserialize(plainBuffer.getData(), plainBuffer.getDataLen(), false, &dictionary);
+    deserializedPlain->getBuffer().read(&v[0], doc.size());
+    EXPECT_EQUAL(0, memcmp(doc.c_str(), &v[0], doc.size()));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -2,6 +2,7 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/searchlib/docstore/logdocumentstore.h>
 #include <vespa/searchlib/docstore/cachestats.h>
+#include <vespa/searchlib/docstore/value.h>
 #include <vespa/document/repo/documenttyperepo.h>
 
 using namespace search;
@@ -61,6 +62,60 @@ TEST_FFF("require that cached docstore lookups are counted",
     EXPECT_EQUAL(1u, f3.getCacheStats().misses);
 }
 
+DocumentStore::Config
+makeShardedConfig() {
+    return DocumentStore::Config(CompressionConfig::NONE, 100000, 100).cacheShards(4).cacheAdmissionWindow(1000);
+}
+
+TEST_FFF("require that sharded docstore cache with admission window counts lookups",
+         DocumentStore::Config(makeShardedConfig()), NullDataStore(), DocumentStore(f1, f2))
+{
+    f3.read(1, repo);
+    f3.read(1, repo);
+    EXPECT_EQUAL(2u, f3.getCacheStats().misses);
+    EXPECT_EQUAL(0u, f3.getCacheStats().hits);
+}
+
+void
+fillPayload(vespalib::DataBuffer & buf, size_t len) {
+    for (size_t i(0); i < len; i++) {
+        char c = 'a' + (i % 7);
+        buf.writeBytes(&c, 1);
+    }
+}
+
+void
+verifyValue(const vespalib::string & expected, const docstore::Value & value) {
+    vespalib::DataBuffer uncompressed;
+    value.decompressTo(uncompressed);
+    EXPECT_EQUAL(expected.size(), value.getUncompressedSize());
+    EXPECT_EQUAL(expected, vespalib::stringref(uncompressed.getData(), uncompressed.getDataLen()));
+}
+
+TEST("require that Value keeps compressed data in a buffer of exact size") {
+    vespalib::DataBuffer buf(4096);
+    fillPayload(buf, 1000);
+    vespalib::string expected(buf.getData(), buf.getDataLen());
+    docstore::Value value;
+    value.set(std::move(buf), 1000, CompressionConfig(CompressionConfig::LZ4));
+    EXPECT_EQUAL(CompressionConfig::LZ4, value.getCompression());
+    EXPECT_LESS(value.size(), 1000u);
+    EXPECT_EQUAL(value.size(), value.allocatedSize());
+    TEST_DO(verifyValue(expected, value));
+}
+
+TEST("require that Value keeps uncompressed data in a buffer of exact size") {
+    vespalib::DataBuffer buf(4096);
+    fillPayload(buf, 1000);
+    vespalib::string expected(buf.getData(), buf.getDataLen());
+    docstore::Value value;
+    value.set(std::move(buf), 1000, CompressionConfig(CompressionConfig::NONE));
+    EXPECT_EQUAL(CompressionConfig::NONE, value.getCompression());
+    EXPECT_EQUAL(1000u, value.size());
+    EXPECT_EQUAL(1000u, value.allocatedSize());
+    TEST_DO(verifyValue(expected, value));
+}
+
 TEST("require that DocumentStore::Config equality operator detects inequality") {
     using C = DocumentStore::Config;
     EXPECT_TRUE(C() == C());
@@ -68,6 +123,8 @@ TEST("require that DocumentStore::Config equality operator detects inequality")
     EXPECT_FALSE(C(CompressionConfig::NONE, 100000, 100) == C(CompressionConfig::NONE, 100000, 99));
     EXPECT_FALSE(C(CompressionConfig::NONE, 100000, 100) == C(CompressionConfig::NONE, 100001, 100));
     EXPECT_FALSE(C(CompressionConfig::NONE, 100000, 100) == C(CompressionConfig::LZ4, 100000, 100));
+    EXPECT_FALSE(C().cacheShards(4) == C());
+    EXPECT_FALSE(C().cacheAdmissionWindow(1000) == C());
 }
 
 TEST("require that LogDocumentStore::Config equality operator detects inequality") {
@@ -4,6 +4,7 @@
 #include <vespa/document/repo/configbuilder.h>
 #include <vespa/document/repo/documenttyperepo.h>
 #include <vespa/document/datatype/documenttype.h>
+#include <vespa/searchlib/docstore/bucketorderedwritebuffer.h>
 #include <vespa/searchlib/docstore/chunkformats.h>
 #include <vespa/searchlib/docstore/logdocumentstore.h>
 #include <vespa/searchlib/docstore/storebybucket.h>
@@ -13,6 +14,7 @@
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/test/insertion_operators.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
 #include <iomanip>
 
@@ -656,6 +658,64 @@ TEST("testWriteRead") {
     FastOS_File::EmptyAndRemoveDirectory("empty");
 }
 
+class CollectingBufferVisitor : public IBufferVisitor {
+public:
+    std::vector<std::pair<uint32_t, vespalib::string>> _visited;
+    void visit(uint32_t lid, vespalib::ConstBufferRef buf) override {
+        _visited.emplace_back(lid, vespalib::string(buf.c_str(), buf.size()));
+    }
+};
+
+vespalib::string
+makeBlob(uint32_t lid)
+{
+    vespalib::asciistream os;
+    os << "blob for lid " << lid << " ";
+    for (uint32_t i(0); i < 10; i++) {
+        os << (lid * 7 + i) << " ";
+    }
+    return os.str();
+}
+
+void
+verifyBatchRead(const LogDataStore & datastore, const std::vector<uint32_t> & lids, size_t expectedCount)
+{
+    CollectingBufferVisitor visitor;
+    datastore.read(lids, visitor);
+    EXPECT_EQUAL(expectedCount, visitor._visited.size());
+    vespalib::hash_set<uint32_t> seen;
+    for (const auto & entry : visitor._visited) {
+        EXPECT_TRUE(seen.insert(entry.first).second);
+        EXPECT_EQUAL(makeBlob(entry.first), entry.second);
+    }
+}
+
+TEST("require that batch read of many chunks returns all entries when chunks are decompressed in parallel") {
+    TmpDirectory dir("batchread");
+    LogDataStore::Config config;
+    config.setFileConfig(WriteableFileChunk::Config(CompressionConfig(CompressionConfig::LZ4), 512));
+    DummyFileHeaderContext fileHeaderContext;
+    MyTlSyncer tlSyncer;
+    std::vector<uint32_t> lids;
+    {
+        vespalib::ThreadStackExecutor executor(1, 128*1024);
+        LogDataStore datastore(executor, dir.getDir(), config, GrowStrategy(),
+                               TuneFileSummary(), fileHeaderContext, tlSyncer, nullptr);
+        for (uint32_t lid(1); lid <= 1000; lid++) {
+            vespalib::string blob = makeBlob(lid);
+            datastore.write(lid, lid, blob.c_str(), blob.size());
+            lids.push_back(lid);
+        }
+        datastore.flush(datastore.initFlush(1000));
+    }
+    vespalib::ThreadStackExecutor executor(4, 128*1024);
+    LogDataStore datastore(executor, dir.getDir(), config, GrowStrategy(),
+                           TuneFileSummary(), fileHeaderContext, tlSyncer, nullptr);
+    TEST_DO(verifyBatchRead(datastore, lids, 1000));
+    TEST_DO(verifyBatchRead(datastore, {3, 500, 1001, 999, 7}, 4));
+    TEST_DO(verifyBatchRead(datastore, {42}, 1));
+}
+
 TEST("requireThatSyncTokenIsUpdatedAfterFlush") {
 #if 0
     std::string file = "sync.dat";
@@ -732,6 +792,44 @@ TEST("testBucketDensityComputer") {
     EXPECT_EQUAL(0u, nonRecording.getNumBuckets());
 }
 
+class CollectingWriter : public BucketOrderedWriteBuffer::IWrite {
+public:
+    void write(uint64_t serialNum, uint32_t lid, const void *buffer, size_t sz) override {
+        (void) serialNum;
+        _lids.push_back(lid);
+        _data.emplace_back(static_cast<const char *>(buffer), sz);
+    }
+    std::vector<uint32_t> _lids;
+    std::vector<vespalib::string> _data;
+};
+
+TEST("require that BucketOrderedWriteBuffer drains entries ordered on bucket") {
+    DummyBucketizer bucketizer(3);
+    BucketOrderedWriteBuffer buffer;
+    for (uint32_t lid(1); lid <= 6; lid++) {
+        vespalib::string data = vespalib::make_string("doc-%u", lid);
+        buffer.add(lid, lid, data.c_str(), data.size());
+    }
+    buffer.add(7, 4, "newer", 5);
+    EXPECT_EQUAL(6u, buffer.size());
+    EXPECT_EQUAL(30u, buffer.sizeBytes());
+    EXPECT_EQUAL(7u, buffer.getMaxSerialNum());
+    EXPECT_TRUE(buffer.remove(5));
+    EXPECT_FALSE(buffer.remove(5));
+    vespalib::DataBuffer read;
+    EXPECT_EQUAL(5, buffer.read(4, read));
+    EXPECT_EQUAL("newer", vespalib::string(read.getData(), read.getDataLen()));
+    EXPECT_EQUAL(-1, buffer.read(5, read));
+
+    CollectingWriter writer;
+    buffer.drain(&bucketizer, writer);
+    // Buckets in key order are lid%3 == 0, 2, 1. Within a bucket the entries are in serial order.
+    EXPECT_EQUAL(std::vector<uint32_t>({3, 6, 2, 1, 4}), writer._lids);
+    EXPECT_EQUAL("newer", writer._data[4]);
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQUAL(0u, buffer.sizeBytes());
+}
+
 LogDataStore::Config
 getBasicConfig(size_t maxFileSize)
 {
@@ -765,12 +863,15 @@ struct Fixture {
     Fixture(const vespalib::string &dirName = "tmp",
             bool dirCleanup = true,
             size_t maxFileSize = 4096 * 2)
+        : Fixture(dirName, dirCleanup, getBasicConfig(maxFileSize))
+    { }
+    Fixture(const vespalib::string &dirName, bool dirCleanup, const LogDataStore::Config &config)
         : executor(1, 0x10000),
           dir(dirName),
           serialNum(0),
           fileHeaderCtx(),
           tlSyncer(),
-          store(executor, dirName, getBasicConfig(maxFileSize), GrowStrategy(),
+          store(executor, dirName, config, GrowStrategy(),
                 TuneFileSummary(), fileHeaderCtx, tlSyncer, nullptr)
     {
         dir.cleanup(dirCleanup);
@@ -951,6 +1052,61 @@ LogDataStore::NameIdSet create(std::vector<size_t> list) {
     return l;
 }
 
+vespalib::string
+genDocument(uint32_t lid, uint32_t version)
+{
+    return vespalib::make_string("{\"title\":\"Document %u of a series\",\"version\":%u,\"category\":\"books\","
+                                 "\"description\":\"A rather repetitive description of item %u\"}", lid, version, lid % 13);
+}
+
+struct DictionaryFixture : public Fixture {
+    DictionaryFixture(bool dirCleanup)
+        : Fixture("tmp", dirCleanup,
+                  getBasicConfig(0x8000).setMaxDictionarySize(0x1000).setMaxDiskBloatFactor(0.1)
+                          .setFileConfig(WriteableFileChunk::Config({CompressionConfig::ZSTD, 9, 60}, 0x1000)))
+    { }
+    void writeDocuments(uint32_t fromLid, uint32_t toLid, uint32_t version) {
+        for (uint32_t lid = fromLid; lid < toLid; ++lid) {
+            vespalib::string data = genDocument(lid, version);
+            store.write(nextSerialNum(), lid, data.c_str(), data.size());
+        }
+    }
+    void assertDocuments(uint32_t fromLid, uint32_t toLid, uint32_t version) {
+        for (uint32_t lid = fromLid; lid < toLid; ++lid) {
+            vespalib::DataBuffer buffer;
+            store.read(lid, buffer);
+            EXPECT_EQUAL(genDocument(lid, version), vespalib::string(buffer.getData(), buffer.getDataLen()));
+        }
+    }
+};
+
+TEST("require that compression dictionary is trained during compaction and used after restart")
+{
+    {
+        DictionaryFixture f(false);
+        f.writeDocuments(0, 3000, 0);
+        ASSERT_GREATER(f.store.getFileChunkStats().size(), 2u);
+        f.writeDocuments(0, 1500, 1);
+        EXPECT_FALSE(f.store.getCompressionDictionary());
+        f.flush();
+        f.store.compact(f.serialNum);
+        EXPECT_TRUE(f.store.getCompressionDictionary());
+        f.writeDocuments(3000, 3500, 0);
+        TEST_DO(f.assertDocuments(0, 1500, 1));
+        TEST_DO(f.assertDocuments(1500, 3500, 0));
+        f.flush();
+    }
+    {
+        DictionaryFixture f(true);
+        EXPECT_TRUE(f.store.getCompressionDictionary());
+        TEST_DO(f.assertDocuments(0, 1500, 1));
+        TEST_DO(f.assertDocuments(1500, 3500, 0));
+        f.serialNum = f.store.lastSyncToken() + 1;
+        f.writeDocuments(3500, 4000, 0);
+        TEST_DO(f.assertDocuments(3500, 4000, 0));
+    }
+}
+
 TEST("require that findIncompleteCompactedFiles does expected filtering") {
     EXPECT_TRUE(LogDataStore::findIncompleteCompactedFiles(create({1,3,100,200,202,204})).empty());
     LogDataStore::NameIdSet toRemove = LogDataStore::findIncompleteCompactedFiles(create({1,3,100,200,201,204}));
@@ -967,6 +1123,28 @@ TEST("require that findIncompleteCompactedFiles does expected filtering") {
 
 }
 
+TEST("require that buffered writes are readable, removable and persisted on flush")
+{
+    {
+        Fixture f("tmp", false, getBasicConfig(4096 * 2).setWriteBufferBytes(3000));
+        f.write(1).write(2);
+        TEST_DO(f.assertDocIdLimit(0));
+        TEST_DO(f.assertContent({1,2}, 3));
+        f.store.remove(f.nextSerialNum(), 2);
+        TEST_DO(f.assertContent({1}, 3));
+        f.write(3).write(4);
+        TEST_DO(f.assertDocIdLimit(5));
+        f.write(5).write(6);
+        TEST_DO(f.assertContent({1,3,4,5,6}, 7));
+        f.flush();
+        TEST_DO(f.assertDocIdLimit(7));
+    }
+    {
+        Fixture f("tmp");
+        TEST_DO(f.assertContent({1,3,4,5,6}, 7));
+    }
+}
+
 TEST("require that config equality operator detects inequality") {
     using C = LogDataStore::Config;
     EXPECT_TRUE(C() == C());
@@ -974,10 +1152,13 @@ TEST("require that config equality operator detects inequality") {
     EXPECT_FALSE(C() == C().setMaxDiskBloatFactor(0.3));
     EXPECT_FALSE(C() == C().setMaxBucketSpread(0.3));
     EXPECT_FALSE(C() == C().setMinFileSizeFactor(0.3));
+    EXPECT_FALSE(C() == C().setMaxDictionarySize(0x10000));
     EXPECT_FALSE(C() == C().setFileConfig(WriteableFileChunk::Config({}, 70)));
     EXPECT_FALSE(C() == C().disableCrcOnRead(true));
     EXPECT_FALSE(C() == C().compact2ActiveFile(false));
     EXPECT_FALSE(C() == C().compactCompression({CompressionConfig::ZSTD}));
+    EXPECT_FALSE(C() == C().setWriteBufferBytes(0x10000));
+    EXPECT_FALSE(C() == C().setMaxCompactReadBytesPerSecond(0x10000));
 }
 
 TEST_MAIN() {
@@ -0,0 +1,215 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/fef/test/ftlib.h>
+#include <vespa/searchlib/fef/indexproperties.h>
+#include <vespa/searchlib/features/internal_sum_reduce_prod_join_feature.h>
+#include <vespa/searchlib/tensor/generic_tensor_attribute.h>
+#include <vespa/eval/eval/tensor_spec.h>
+#include <vespa/eval/eval/value_type.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
+#include <vespa/eval/tensor/tensor.h>
+#include <vespa/eval/tensor/serialization/typed_binary_format.h>
+#include <vespa/vespalib/objects/nbostream.h>
+
+using search::feature_t;
+using namespace search::fef;
+using namespace search::fef::indexproperties;
+using namespace search::fef::test;
+using namespace search::features;
+using search::AttributeFactory;
+using search::tensor::GenericTensorAttribute;
+using search::tensor::SparseTensorView;
+using vespalib::eval::TensorSpec;
+using vespalib::eval::ValueType;
+using vespalib::tensor::DefaultTensorEngine;
+using vespalib::tensor::Tensor;
+using CollectionType = FieldInfo::CollectionType;
+
+typedef search::attribute::Config AVC;
+typedef search::attribute::BasicType AVBT;
+typedef search::attribute::CollectionType AVCT;
+typedef search::AttributeVector::SP AttributePtr;
+typedef FtTestApp FTA;
+
+namespace {
+
+Tensor::UP make_tensor(const TensorSpec &spec) {
+    auto tensor = DefaultTensorEngine::ref().from_spec(spec);
+    return Tensor::UP(dynamic_cast<Tensor*>(tensor.release()));
+}
+
+}
+
+struct SetupFixture
+{
+    InternalSumReduceProdJoinBlueprint blueprint;
+    IndexEnvironment indexEnv;
+    SetupFixture()
+        : blueprint(),
+          indexEnv()
+    {
+        addAttribute("sparse", "tensor(x{})");
+        addAttribute("sparse2d", "tensor(x{},y{})");
+        addAttribute("dense", "tensor(x[3])");
+        type::QueryFeature::set(indexEnv.getProperties(), "query", "tensor(x{})");
+        type::QueryFeature::set(indexEnv.getProperties(), "query2d", "tensor(x{},y{})");
+        type::QueryFeature::set(indexEnv.getProperties(), "queryy", "tensor(y{})");
+        type::QueryFeature::set(indexEnv.getProperties(), "querydense", "tensor(x[3])");
+    }
+
+    void addAttribute(const vespalib::string &name, const vespalib::string &tensorType) {
+        FieldInfo attrInfo(FieldType::ATTRIBUTE, CollectionType::SINGLE, name, 0);
+        attrInfo.set_data_type(FieldInfo::DataType::TENSOR);
+        indexEnv.getFields().push_back(attrInfo);
+        type::Attribute::set(indexEnv.getProperties(), name, tensorType);
+    }
+};
+
+TEST_F("require that blueprint can be created", SetupFixture())
+{
+    EXPECT_TRUE(FTA::assertCreateInstance(f.blueprint, "internalSumReduceProdJoin"));
+}
+
+TEST_F("require that setup succeeds with sparse tensor attribute and query of same type", SetupFixture())
+{
+    FTA::FT_SETUP_OK(f.blueprint, f.indexEnv,
+                     StringList().add("sparse").add("query"),
+                     StringList(),
+                     StringList().add("scalar"));
+}
+
+TEST_F("require that setup fails if attribute does not exist", SetupFixture())
+{
+    FTA::FT_SETUP_FAIL(f.blueprint, f.indexEnv, StringList().add("foo").add("query"));
+}
+
+TEST_F("require that setup fails if types are unknown", SetupFixture())
+{
+    f.addAttribute("untyped", "");
+    FTA::FT_SETUP_FAIL(f.blueprint, f.indexEnv, StringList().add("untyped").add("query"));
+    FTA::FT_SETUP_FAIL(f.blueprint, f.indexEnv, StringList().add("sparse").add("bar"));
+}
+
+TEST_F("require that setup fails if types differ", SetupFixture())
+{
+    FTA::FT_SETUP_FAIL(f.blueprint, f.indexEnv, StringList().add("sparse").add("queryy"));
+}
+
+TEST_F("require that setup fails if tensor type has other than a single mapped dimension", SetupFixture())
+{
+    FTA::FT_SETUP_FAIL(f.blueprint, f.indexEnv, StringList().add("sparse2d").add("query2d"));
+    FTA::FT_SETUP_FAIL(f.blueprint, f.indexEnv, StringList().add("dense").add("querydense"));
+}
+
+TEST("require that sparse tensor view decodes stored cells") {
+    auto tensor = make_tensor(TensorSpec("tensor(x{})").add({{"x", "a"}}, 3).add({{"x", "bb"}}, -5.5));
+    vespalib::nbostream stream;
+    vespalib::tensor::TypedBinaryFormat::serialize(stream, *tensor);
+    SparseTensorView view(stream.peek(), stream.size());
+    ASSERT_TRUE(view.valid());
+    EXPECT_EQUAL("x", view.dimension());
+    EXPECT_EQUAL(2u, view.numCells());
+    std::map<vespalib::string, double> cells;
+    view.forEachCell([&](vespalib::stringref label, double value) { cells[label] = value; });
+    EXPECT_EQUAL(2u, cells.size());
+    EXPECT_EQUAL(3.0, cells["a"]);
+    EXPECT_EQUAL(-5.5, cells["bb"]);
+}
+
+TEST("require that sparse tensor view is invalid for other tensor types") {
+    for (const auto &spec : {TensorSpec("tensor(x[2])").add({{"x", 1}}, 3),
+                             TensorSpec("tensor(x{},y{})").add({{"x", "a"}, {"y", "b"}}, 3)}) {
+        auto tensor = make_tensor(spec);
+        vespalib::nbostream stream;
+        vespalib::tensor::TypedBinaryFormat::serialize(stream, *tensor);
+        EXPECT_FALSE(SparseTensorView(stream.peek(), stream.size()).valid());
+    }
+    EXPECT_FALSE(SparseTensorView().valid());
+}
+
+struct ExecFixture
+{
+    BlueprintFactory factory;
+    FtFeatureTest test;
+    ExecFixture(const vespalib::string &feature)
+        : factory(),
+          test(factory, feature)
+    {
+        factory.addPrototype(std::make_shared<InternalSumReduceProdJoinBlueprint>());
+        setupAttributeVectors();
+        setupQueryEnvironment();
+        ASSERT_TRUE(test.setup());
+    }
+
+    void setupAttributeVectors() {
+        test.getIndexEnv().getBuilder().addField(FieldType::ATTRIBUTE, CollectionType::SINGLE, "tensorattr");
+        type::Attribute::set(test.getIndexEnv().getProperties(), "tensorattr", "tensor(x{})");
+        AVC config(AVBT::TENSOR, AVCT::SINGLE);
+        config.setTensorType(ValueType::from_spec("tensor(x{})"));
+        AttributePtr attr = AttributeFactory::createAttribute("tensorattr", config);
+        attr->addReservedDoc();
+        attr->addDocs(2);
+        attr->clearDoc(1);
+        attr->clearDoc(2);
+        attr->commit();
+        test.getIndexEnv().getAttributeMap().add(attr);
+        auto *tensorAttr = dynamic_cast<GenericTensorAttribute *>(attr.get());
+        ASSERT_TRUE(tensorAttr != nullptr);
+        tensorAttr->setTensor(1, *make_tensor(TensorSpec("tensor(x{})")
+                                              .add({{"x", "a"}}, 3)
+                                              .add({{"x", "b"}}, 5)
+                                              .add({{"x", "c"}}, 7)));
+        attr->commit();
+    }
+
+    void setQueryTensor(const vespalib::string &name, const TensorSpec &spec) {
+        auto tensor = make_tensor(spec);
+        vespalib::nbostream stream;
+        vespalib::tensor::TypedBinaryFormat::serialize(stream, *tensor);
+        test.getQueryEnv().getProperties().add(name, vespalib::stringref(stream.peek(), stream.size()));
+        type::QueryFeature::set(test.getIndexEnv().getProperties(), name, spec.type());
+    }
+
+    void setupQueryEnvironment() {
+        setQueryTensor("tensorquery", TensorSpec("tensor(x{})")
+                       .add({{"x", "a"}}, 11)
+                       .add({{"x", "c"}}, 13)
+                       .add({{"x", "d"}}, 17));
+        setQueryTensor("nomatch", TensorSpec("tensor(x{})")
+                       .add({{"x", "e"}}, 19));
+        type::QueryFeature::set(test.getIndexEnv().getProperties(), "null", "tensor(x{})");
+    }
+
+    bool evaluatesTo(feature_t expectedValue, uint32_t docId = 1) {
+        return test.execute(expectedValue, 0.000001, docId);
+    }
+};
+
+TEST_F("require that executor returns sum of products of matching cells",
+       ExecFixture("internalSumReduceProdJoin(tensorattr,tensorquery)"))
+{
+    EXPECT_TRUE(f.evaluatesTo(3 * 11 + 7 * 13));
+}
+
+TEST_F("require that executor returns 0 for document without tensor",
+       ExecFixture("internalSumReduceProdJoin(tensorattr,tensorquery)"))
+{
+    EXPECT_TRUE(f.evaluatesTo(0.0, 2));
+}
+
+TEST_F("require that executor returns 0 if no cells match",
+       ExecFixture("internalSumReduceProdJoin(tensorattr,nomatch)"))
+{
+    EXPECT_TRUE(f.evaluatesTo(0.0));
+}
+
+TEST_F("require that executor returns 0 if query tensor is not found",
+       ExecFixture("internalSumReduceProdJoin(tensorattr,null)"))
+{
+    EXPECT_TRUE(f.evaluatesTo(0.0));
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -1182,7 +1182,7 @@ Test::testDotProduct()
             assertDotProduct(0,  "(6:5,7:5)",             1, "wsint");
             assertDotProduct(55, "(1:1,2:2,3:3,4:4,5:5)", 1, "wsint");
         }
-        std::vector<const char *> attributes = {"arrint", "arrfloat", "arrint_fast", "arrfloat_fast"};
+        std::vector<const char *> attributes = {"arrint", "arrfloat", "arrint_fast", "arrfloat_fast", "arrbyte"};
         for (const char * name : attributes) {
             assertDotProduct(0,  "()",                    1, name);
             assertDotProduct(0,  "(6:5,7:5)",             1, name);
@@ -1197,6 +1197,11 @@ Test::testDotProduct()
         { // Sparse float array attribute.
             assertDotProduct(17, "(0:1,3:4,50:97)", 1, "arrfloat");
         }
+        { // int8 array attribute, query values are clamped to the int8 range
+            assertDotProduct(-5, "[-1 0 0 0 0]", 1, "arrbyte");
+            assertDotProduct(635, "[0 0 0 0 500]", 1, "arrbyte");
+            assertDotProduct(17, "(0:1,3:4,50:97)", 1, "arrbyte");
+        }
 
         assertDotProduct(0, "(0:1,3:4,50:97)", 1, "sint"); // attribute of the wrong type
         assertDotProduct(17, "(0:1,3:4,50:97)", 1, "sint", "arrfloat"); // attribute override
@@ -1251,7 +1256,8 @@ Test::setupForDotProductTest(FtFeatureTest & ft)
                                     {"arrint", AVBT::INT32, AVCT::ARRAY, false},
                                     {"arrfloat", AVBT::FLOAT, AVCT::ARRAY, false},
                                     {"arrint_fast", AVBT::INT32, AVCT::ARRAY, true},
-                                    {"arrfloat_fast", AVBT::FLOAT, AVCT::ARRAY, true}
+                                    {"arrfloat_fast", AVBT::FLOAT, AVCT::ARRAY, true},
+                                    {"arrbyte", AVBT::INT8, AVCT::ARRAY, false}
                                   };
     AttributePtr a = AttributeFactory::createAttribute("wsstr", AVC(AVBT::STRING, AVCT::WSET));
     AttributePtr c = AttributeFactory::createAttribute("sint", AVC(AVBT::INT32, AVCT::SINGLE));
@@ -0,0 +1,99 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+
+#include <vespa/eval/eval/function.h>
+#include <vespa/searchlib/features/sum_reduce_prod_join_replacer.h>
+#include <vespa/searchlib/features/rankingexpression/feature_name_extractor.h>
+#include <vespa/searchlib/fef/test/indexenvironment.h>
+#include <vespa/searchlib/fef/blueprint.h>
+
+using search::features::SumReduceProdJoinReplacer;
+using search::features::rankingexpression::ExpressionReplacer;
+using search::features::rankingexpression::FeatureNameExtractor;
+using search::fef::Blueprint;
+using search::fef::FeatureExecutor;
+using search::fef::FeatureType;
+using search::fef::IDumpFeatureVisitor;
+using search::fef::IIndexEnvironment;
+using search::fef::IQueryEnvironment;
+using search::fef::test::IndexEnvironment;
+using vespalib::Stash;
+using vespalib::eval::Function;
+
+struct MyBlueprint : Blueprint {
+    bool &was_used;
+    MyBlueprint(bool &was_used_out) : Blueprint("my_bp"), was_used(was_used_out) {}
+    void visitDumpFeatures(const IIndexEnvironment &, IDumpFeatureVisitor &) const override {}
+    Blueprint::UP createInstance() const override { return std::make_unique<MyBlueprint>(was_used); }
+    bool setup(const IIndexEnvironment &, const std::vector<vespalib::string> &params) override {
+        EXPECT_EQUAL(getName(), "my_bp(foo,bar)");
+        ASSERT_TRUE(params.size() == 2);
+        EXPECT_EQUAL(params[0], "foo");
+        EXPECT_EQUAL(params[1], "bar");
+        describeOutput("out", "my output", FeatureType::number());
+        was_used = true;
+        return true;
+    }
+    FeatureExecutor &createExecutor(const IQueryEnvironment &, vespalib::Stash &) const override {
+        abort();
+    }
+};
+
+bool replaced(const vespalib::string &expr) {
+    bool was_used = false;
+    ExpressionReplacer::UP replacer = SumReduceProdJoinReplacer::create(std::make_unique<MyBlueprint>(was_used));
+    Function rank_function = Function::parse(expr, FeatureNameExtractor());
+    if (!EXPECT_TRUE(!rank_function.has_error())) {
+        fprintf(stderr, "parse error: %s\n", rank_function.dump().c_str());
+    }
+    auto result = replacer->maybe_replace(rank_function, IndexEnvironment());
+    EXPECT_EQUAL(bool(result), was_used);
+    return was_used;
+}
+
+TEST("require that matching expression with appropriate inputs is replaced") {
+    EXPECT_TRUE(replaced("reduce(attribute(foo)*query(bar),sum)"));
+}
+
+TEST("require that input feature parameter lists have flexible matching") {
+    EXPECT_TRUE(replaced("reduce(attribute( foo )*query ( bar ),sum)"));
+}
+
+TEST("require that expression using tensor join with lambda can also be replaced") {
+    EXPECT_TRUE(replaced("reduce(join(attribute(foo),query(bar),f(x,y)(x*y)),sum)"));
+}
+
+TEST("require that parameter ordering does not matter") {
+    EXPECT_TRUE(replaced("reduce(query(bar)*attribute(foo),sum)"));
+    EXPECT_TRUE(replaced("reduce(join(query(bar),attribute(foo),f(x,y)(x*y)),sum)"));
+    EXPECT_TRUE(replaced("reduce(join(attribute(foo),query(bar),f(x,y)(y*x)),sum)"));
+}
+
+TEST("require that unrelated inputs are not replaced") {
+    EXPECT_TRUE(!replaced("reduce(foo*bar,sum)"));
+    EXPECT_TRUE(!replaced("reduce(attribute(foo)*attribute(bar),sum)"));
+    EXPECT_TRUE(!replaced("reduce(query(foo)*query(bar),sum)"));
+    EXPECT_TRUE(!replaced("reduce(attribute(foo,1)*query(bar),sum)"));
+}
+
+TEST("require that other aggregators are not replaced") {
+    EXPECT_TRUE(!replaced("reduce(attribute(foo)*query(bar),max)"));
+    EXPECT_TRUE(!replaced("reduce(attribute(foo)*query(bar),avg)"));
+}
+
+TEST("require that partial reduce is not replaced") {
+    EXPECT_TRUE(!replaced("reduce(attribute(foo)*query(bar),sum,x)"));
+}
+
+TEST("require that other joins are not replaced") {
+    EXPECT_TRUE(!replaced("reduce(attribute(foo)+query(bar),sum)"));
+    EXPECT_TRUE(!replaced("reduce(join(attribute(foo),query(bar),f(x,y)(x+y)),sum)"));
+    EXPECT_TRUE(!replaced("reduce(join(attribute(foo),query(bar),f(x,y)(x*x)),sum)"));
+}
+
+TEST("require that reduce must be the root operation") {
+    EXPECT_TRUE(!replaced("reduce(attribute(foo)*query(bar),sum)+1"));
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
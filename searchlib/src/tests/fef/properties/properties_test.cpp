@@ -226,6 +226,13 @@ TEST("test stuff") {
             EXPECT_TRUE(!eval::LazyExpressions::check(p, true));
             EXPECT_TRUE(!eval::LazyExpressions::check(p, false));
         }
+        { // vespa.eval.async_compile
+            EXPECT_EQUAL(eval::AsyncCompile::NAME, vespalib::string("vespa.eval.async_compile"));
+            Properties p;
+            EXPECT_TRUE(!eval::AsyncCompile::check(p));
+            p = Properties().add("vespa.eval.async_compile", "true");
+            EXPECT_TRUE(eval::AsyncCompile::check(p));
+        }
         { // vespa.rank.firstphase
             EXPECT_EQUAL(rank::FirstPhase::NAME, vespalib::string("vespa.rank.firstphase"));
             EXPECT_EQUAL(rank::FirstPhase::DEFAULT_VALUE, vespalib::string("nativeRank"));
@@ -295,6 +302,62 @@ TEST("test stuff") {
             p.add("vespa.matching.numsearchpartitions", "50");
             EXPECT_EQUAL(matching::NumSearchPartitions::lookup(p), 50u);
         }
+        { // vespa.matching.workstealing
+            EXPECT_EQUAL(matching::WorkStealing::NAME, vespalib::string("vespa.matching.workstealing"));
+            EXPECT_EQUAL(matching::WorkStealing::DEFAULT_VALUE, false);
+            Properties p;
+            EXPECT_EQUAL(matching::WorkStealing::lookup(p), false);
+            p.add("vespa.matching.workstealing", "true");
+            EXPECT_EQUAL(matching::WorkStealing::lookup(p), true);
+        }
+        { // vespa.matching.eagerranking
+            EXPECT_EQUAL(matching::EagerRanking::NAME, vespalib::string("vespa.matching.eagerranking"));
+            EXPECT_EQUAL(matching::EagerRanking::DEFAULT_VALUE, false);
+            Properties p;
+            EXPECT_EQUAL(matching::EagerRanking::lookup(p), false);
+            p.add("vespa.matching.eagerranking", "true");
+            EXPECT_EQUAL(matching::EagerRanking::lookup(p), true);
+        }
+        { // vespa.matching.balancedsecondphase
+            EXPECT_EQUAL(matching::BalancedSecondPhase::NAME, vespalib::string("vespa.matching.balancedsecondphase"));
+            EXPECT_EQUAL(matching::BalancedSecondPhase::DEFAULT_VALUE, false);
+            Properties p;
+            EXPECT_EQUAL(matching::BalancedSecondPhase::lookup(p), false);
+            p.add("vespa.matching.balancedsecondphase", "true");
+            EXPECT_EQUAL(matching::BalancedSecondPhase::lookup(p), true);
+        }
+        { // vespa.matching.filtercachesize
+            EXPECT_EQUAL(matching::FilterCacheSize::NAME, vespalib::string("vespa.matching.filtercachesize"));
+            EXPECT_EQUAL(matching::FilterCacheSize::DEFAULT_VALUE, 0u);
+            Properties p;
+            EXPECT_EQUAL(matching::FilterCacheSize::lookup(p), 0u);
+            p.add("vespa.matching.filtercachesize", "100");
+            EXPECT_EQUAL(matching::FilterCacheSize::lookup(p), 100u);
+        }
+        { // vespa.matching.resultcachesize
+            EXPECT_EQUAL(matching::ResultCacheSize::NAME, vespalib::string("vespa.matching.resultcachesize"));
+            EXPECT_EQUAL(matching::ResultCacheSize::DEFAULT_VALUE, 0u);
+            Properties p;
+            EXPECT_EQUAL(matching::ResultCacheSize::lookup(p), 0u);
+            p.add("vespa.matching.resultcachesize", "100");
+            EXPECT_EQUAL(matching::ResultCacheSize::lookup(p), 100u);
+        }
+        { // vespa.matching.resultcachemaxage
+            EXPECT_EQUAL(matching::ResultCacheMaxAge::NAME, vespalib::string("vespa.matching.resultcachemaxage"));
+            EXPECT_EQUAL(matching::ResultCacheMaxAge::DEFAULT_VALUE, 0.0);
+            Properties p;
+            EXPECT_EQUAL(matching::ResultCacheMaxAge::lookup(p), 0.0);
+            p.add("vespa.matching.resultcachemaxage", "2.5");
+            EXPECT_EQUAL(matching::ResultCacheMaxAge::lookup(p), 2.5);
+        }
+        { // vespa.matching.querysamplefraction
+            EXPECT_EQUAL(matching::QuerySampleFraction::NAME, vespalib::string("vespa.matching.querysamplefraction"));
+            EXPECT_EQUAL(matching::QuerySampleFraction::DEFAULT_VALUE, 0.0);
+            Properties p;
+            EXPECT_EQUAL(matching::QuerySampleFraction::lookup(p), 0.0);
+            p.add("vespa.matching.querysamplefraction", "0.01");
+            EXPECT_EQUAL(matching::QuerySampleFraction::lookup(p), 0.01);
+        }
         { // vespa.matchphase.degradation.attribute
             EXPECT_EQUAL(matchphase::DegradationAttribute::NAME, vespalib::string("vespa.matchphase.degradation.attribute"));
             EXPECT_EQUAL(matchphase::DegradationAttribute::DEFAULT_VALUE, "");
@@ -359,6 +422,15 @@ TEST("test stuff") {
             p.add("vespa.matchphase.diversity.mingroups", "5");
             EXPECT_EQUAL(matchphase::DiversityMinGroups::lookup(p), 5u);
         }
+        { // vespa.matchphase.earlytermination.hits
+            EXPECT_EQUAL(matchphase::EarlyTerminationHits::NAME, vespalib::string("vespa.matchphase.earlytermination.hits"));
+            EXPECT_EQUAL(matchphase::EarlyTerminationHits::DEFAULT_VALUE, 0u);
+            Properties p;
+            EXPECT_EQUAL(matchphase::EarlyTerminationHits::lookup(p), 0u);
+            EXPECT_EQUAL(matchphase::EarlyTerminationHits::lookup(p, 10), 10u);
+            p.add("vespa.matchphase.earlytermination.hits", "100");
+            EXPECT_EQUAL(matchphase::EarlyTerminationHits::lookup(p), 100u);
+        }
         { // vespa.hitcollector.heapsize
             EXPECT_EQUAL(hitcollector::HeapSize::NAME, vespalib::string("vespa.hitcollector.heapsize"));
             EXPECT_EQUAL(hitcollector::HeapSize::DEFAULT_VALUE, 100u);
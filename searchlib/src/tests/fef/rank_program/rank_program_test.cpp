@@ -12,6 +12,7 @@
 #include <vespa/searchlib/fef/test/plugin/sum.h>
 #include <vespa/searchlib/fef/test/plugin/double.h>
 #include <vespa/searchlib/fef/rank_program.h>
+#include <vespa/searchlib/fef/feature_profiler.h>
 #include <vespa/searchlib/fef/test/test_features.h>
 
 using namespace search::fef;
@@ -73,8 +74,9 @@ struct Fixture {
     MatchData::UP match_data;
     RankProgram program;
     size_t track_cnt;
+    FeatureProfiler *profiler;
     Fixture() : factory(), indexEnv(), resolver(new BlueprintResolver(factory, indexEnv)),
-                overrides(), match_data(), program(resolver), track_cnt(0)
+                overrides(), match_data(), program(resolver), track_cnt(0), profiler(nullptr)
     {
         factory.addPrototype(Blueprint::SP(new BoxingBlueprint()));
         factory.addPrototype(Blueprint::SP(new DocidBlueprint()));
@@ -90,6 +92,11 @@ struct Fixture {
                                      value ? "true" : "false");
         return *this;
     }
+    Fixture &async_compile(bool value) {
+        indexEnv.getProperties().add(indexproperties::eval::AsyncCompile::NAME,
+                                     value ? "true" : "false");
+        return *this;
+    }
     Fixture &add_expr(const vespalib::string &name, const vespalib::string &expr) {
         vespalib::string feature_name = expr_feature(name);
         vespalib::string expr_name = feature_name + ".rankingScript";
@@ -105,12 +112,16 @@ struct Fixture {
         overrides.add(feature, vespalib::make_string("%g", value));
         return *this;
     }
+    Fixture &profile(FeatureProfiler &profiler_in) {
+        profiler = &profiler_in;
+        return *this;
+    }
     Fixture &compile() {
         ASSERT_TRUE(resolver->compile());
         MatchDataLayout mdl;
         QueryEnvironment queryEnv(&indexEnv);
         match_data = mdl.createMatchData();
-        program.setup(*match_data, queryEnv, overrides);
+        program.setup(*match_data, queryEnv, overrides, profiler);
         return *this;
     }
     double get(uint32_t docid = default_docid) {
@@ -297,6 +308,74 @@ TEST_F("require that auto-unboxing of non-const object values work", Fixture())
     EXPECT_EQUAL(0u, count_const_features(f1.program));
 }
 
+TEST_F("require that seed executors can be run eagerly and skip const features", Fixture()) {
+    f1.add("track(mysum(track(value(10)),track(ivalue(5))))");
+    f1.add("ivalue(7)");
+    f1.compile();
+    EXPECT_EQUAL(7u, f1.program.num_executors());
+    auto executors = f1.program.get_seed_executors();
+    EXPECT_EQUAL(5u, executors.size());
+    size_t track_cnt = f1.track_cnt;
+    for (FeatureExecutor *executor: executors) {
+        executor->eager_execute(3);
+    }
+    EXPECT_EQUAL(f1.track_cnt, track_cnt + 2);
+    EXPECT_EQUAL(15.0, f1.get("track(mysum(track(value(10)),track(ivalue(5))))", 3));
+    EXPECT_EQUAL(7.0, f1.get("ivalue(7)", 3));
+    EXPECT_EQUAL(f1.track_cnt, track_cnt + 2);
+}
+
+const FeatureProfiler::Stats *find_stats(const std::vector<FeatureProfiler::Stats> &report, const vespalib::string &name) {
+    for (const auto &stats: report) {
+        if (stats.name == name) {
+            return &stats;
+        }
+    }
+    return nullptr;
+}
+
+TEST_F("require that execution of non-const features can be profiled", Fixture()) {
+    FeatureProfiler profiler;
+    f1.add("track(mysum(track(value(10)),track(ivalue(5))))").profile(profiler).compile();
+    EXPECT_EQUAL(15.0, f1.get(1));
+    EXPECT_EQUAL(15.0, f1.get(2));
+    EXPECT_EQUAL(15.0, f1.get(2));
+    auto report = profiler.report();
+    EXPECT_EQUAL(4u, report.size());
+    EXPECT_TRUE(find_stats(report, "value(10)") == nullptr);
+    EXPECT_TRUE(find_stats(report, "track(value(10))") == nullptr);
+    const auto *outer = find_stats(report, "track(mysum(track(value(10)),track(ivalue(5))))");
+    const auto *sum = find_stats(report, "mysum(track(value(10)),track(ivalue(5)))");
+    const auto *inner = find_stats(report, "ivalue(5)");
+    ASSERT_TRUE(outer != nullptr);
+    ASSERT_TRUE(sum != nullptr);
+    ASSERT_TRUE(inner != nullptr);
+    EXPECT_EQUAL(2u, outer->count);
+    EXPECT_EQUAL(2u, sum->count);
+    EXPECT_EQUAL(2u, inner->count);
+    EXPECT_TRUE(outer->total_time >= sum->total_time);
+    EXPECT_TRUE(sum->total_time >= inner->total_time);
+    EXPECT_TRUE(outer->total_time >= outer->self_time);
+}
+
+TEST("require that feature profiles can be merged by name") {
+    FeatureProfiler a;
+    FeatureProfiler b;
+    a.start();
+    a.stop(a.resolve("foo"));
+    b.start();
+    b.stop(b.resolve("bar"));
+    b.start();
+    b.stop(b.resolve("foo"));
+    a.merge(b);
+    auto report = a.report();
+    EXPECT_EQUAL(2u, report.size());
+    ASSERT_TRUE(find_stats(report, "foo") != nullptr);
+    ASSERT_TRUE(find_stats(report, "bar") != nullptr);
+    EXPECT_EQUAL(2u, find_stats(report, "foo")->count);
+    EXPECT_EQUAL(1u, find_stats(report, "bar")->count);
+}
+
 TEST_F("require that non-lazy ranking expression always calculates all inputs", Fixture()) {
     f1.lazy_expressions(false);
     f1.add_expr("rank", "if(docid<10,track(ivalue(1)),track(ivalue(2)))");
@@ -325,6 +404,56 @@ TEST_F("require that lazy ranking expression only calculates needed inputs", Fix
     EXPECT_EQUAL(f1.track_cnt, 2u);
 }
 
+TEST_F("require that eager execution leaves inputs of lazy ranking expressions to lazy evaluation", Fixture()) {
+    f1.lazy_expressions(true);
+    f1.add_expr("rank", "if(docid<10,track(ivalue(1)),track(ivalue(2)))");
+    f1.compile();
+    auto executors = f1.program.get_seed_executors();
+    ASSERT_EQUAL(1u, executors.size());
+    EXPECT_TRUE(executors[0]->has_conditional_inputs());
+    executors[0]->eager_execute(5);
+    EXPECT_EQUAL(f1.track_cnt, 1u);
+    EXPECT_EQUAL(f1.get(expr_feature("rank"),  5), 1.0);
+    EXPECT_EQUAL(f1.track_cnt, 1u);
+    executors[0]->eager_execute(15);
+    EXPECT_EQUAL(f1.track_cnt, 2u);
+    EXPECT_EQUAL(f1.get(expr_feature("rank"), 15), 2.0);
+}
+
+TEST_F("require that eager execution runs all inputs of non-lazy ranking expressions", Fixture()) {
+    f1.lazy_expressions(false);
+    f1.add_expr("rank", "if(docid<10,track(ivalue(1)),track(ivalue(2)))");
+    f1.compile();
+    auto executors = f1.program.get_seed_executors();
+    EXPECT_EQUAL(6u, executors.size());
+    for (FeatureExecutor *executor: executors) {
+        EXPECT_FALSE(executor->has_conditional_inputs());
+        executor->eager_execute(5);
+    }
+    EXPECT_EQUAL(f1.track_cnt, 2u);
+    EXPECT_EQUAL(f1.get(expr_feature("rank"),  5), 1.0);
+    EXPECT_EQUAL(f1.track_cnt, 2u);
+}
+
+TEST_F("require that ranking expressions without conditions have no conditional inputs", Fixture()) {
+    f1.lazy_expressions(true);
+    f1.add_expr("rank", "track(ivalue(1))+track(ivalue(2))");
+    f1.compile();
+    auto executors = f1.program.get_seed_executors();
+    EXPECT_EQUAL(5u, executors.size());
+    for (FeatureExecutor *executor: executors) {
+        EXPECT_FALSE(executor->has_conditional_inputs());
+    }
+}
+
+TEST_F("require that ranking expressions can be compiled in the background", Fixture()) {
+    f1.async_compile(true);
+    f1.add_expr("rank", "if(docid<10,ivalue(1),ivalue(2))");
+    f1.compile();
+    EXPECT_EQUAL(f1.get(expr_feature("rank"),  5), 1.0);
+    EXPECT_EQUAL(f1.get(expr_feature("rank"), 15), 2.0);
+}
+
 TEST_F("require that interpreted ranking expressions are always lazy", Fixture()) {
     f1.lazy_expressions(false);
     f1.add_expr("rank", "if(docid<10,box(track(ivalue(1))),track(ivalue(2)))");
@@ -242,4 +242,26 @@ TEST("require that MatchData soft_reset retains appropriate state") {
     EXPECT_EQUAL(new_term->getDocId(), TermFieldMatchData::invalidId());
 }
 
+TEST("require that positions can be skipped to by key") {
+    TermFieldMatchData tmd;
+    tmd.reset(1);
+    for (uint32_t pos = 0; pos < 100; pos += 2) {
+        tmd.appendPosition(TermFieldMatchDataPosition(0, pos, 1, 100));
+    }
+    tmd.appendPosition(TermFieldMatchDataPosition(3, 5, 1, 10));
+    using Key = TermFieldMatchDataPositionKey;
+    auto seek = [&tmd](TermFieldMatchData::PositionsIterator pos, const Key &key) {
+        return TermFieldMatchData::seekPosition(pos, tmd.end(), key);
+    };
+    EXPECT_TRUE(seek(tmd.begin(), Key(0, 0)) == tmd.begin());
+    EXPECT_TRUE(seek(tmd.begin(), Key(0, 1)) == tmd.begin() + 1);
+    EXPECT_TRUE(seek(tmd.begin(), Key(0, 64)) == tmd.begin() + 32);
+    EXPECT_TRUE(seek(tmd.begin(), Key(0, 97)) == tmd.begin() + 49);
+    EXPECT_TRUE(seek(tmd.begin(), Key(1, 0)) == tmd.begin() + 50);
+    EXPECT_TRUE(seek(tmd.begin() + 40, Key(0, 10)) == tmd.begin() + 40);
+    EXPECT_TRUE(seek(tmd.begin() + 40, Key(3, 5)) == tmd.begin() + 50);
+    EXPECT_TRUE(seek(tmd.begin(), Key(3, 6)) == tmd.end());
+    EXPECT_TRUE(seek(tmd.end(), Key(0, 0)) == tmd.end());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -146,6 +146,7 @@ public:
     void testAggregationGroupOrder();
     void testAggregationGroupRank();
     void testAggregationGroupCapping();
+    void testAggregationSpill();
     void testMergeSimpleSum();
     void testMergeLevels();
     void testMergeGroups();
@@ -705,6 +706,63 @@ Test::testAggregationGroupCapping()
 
 //-----------------------------------------------------------------------------
 
+/**
+ * Verify that spilling groups to disk while aggregating gives the same
+ * result as keeping all groups in memory.
+ **/
+void
+Test::testAggregationSpill()
+{
+    AggregationContext ctx;
+    IntAttrBuilder attr("attr");
+    IntAttrBuilder attr2("attr2");
+    for (uint32_t i = 0; i < 100; ++i) {
+        attr.add(i % 37);
+        attr2.add(i % 5);
+        ctx.result().add(i, 100 - i);
+    }
+    ctx.add(attr.sp());
+    ctx.add(attr2.sp());
+
+    std::vector<Grouping> requests;
+    requests.push_back(Grouping().setFirstLevel(0).setLastLevel(1)
+                       .addLevel(std::move(GroupingLevel().setMaxGroups(5).setExpression(MU<AttributeNode>("attr"))
+                                           .addAggregationResult(createAggr<SumAggregationResult>(MU<AttributeNode>("attr2")))
+                                           .addOrderBy(MU<AggregationRefNode>(0), false))));
+    requests.push_back(Grouping().setFirstLevel(0).setLastLevel(2)
+                       .addLevel(createGL(MU<AttributeNode>("attr"), MU<AttributeNode>("attr2")))
+                       .addLevel(createGL(MU<AttributeNode>("attr2"), MU<AttributeNode>("attr"))));
+    for (const Grouping & request : requests) {
+        Grouping plain = request;
+        ctx.setup(plain);
+        plain.aggregate(ctx.result().hits(), ctx.result().size());
+        Grouping spilled = request;
+        spilled.setSpill(4, 3, ".");
+        ctx.setup(spilled);
+        spilled.aggregate(ctx.result().hits(), ctx.result().size());
+        EXPECT_EQUAL(plain.getRoot().asString(), spilled.getRoot().asString());
+    }
+    {
+        Grouping request = requests[1];
+        ctx.setup(request);
+        request.preAggregate(false);
+        GroupSpiller spiller(3, ".");
+        for (uint32_t i = 0; i < 100; ++i) {
+            request.aggregate(i, 0.0);
+            if (i % 10 == 9) {
+                spiller.spill(request.root());
+                EXPECT_EQUAL(0u, request.getRoot().getChildrenSize());
+            }
+        }
+        EXPECT_EQUAL(100u, spiller.getSpilledGroups());
+        request.root().postAggregate();
+        spiller.unspill(request.root(), request.getLevels(), 0);
+        EXPECT_EQUAL(37u, request.getRoot().getChildrenSize());
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 /**
  * Test merging the sum of the values from a single attribute vector
  * that was collected directly into the root node. Consider this a
@@ -1900,6 +1958,7 @@ Test::Main()
     testAggregationGroupOrder();
     testAggregationGroupRank();
     testAggregationGroupCapping();
+    testAggregationSpill();
     testMergeSimpleSum();
     testMergeLevels();
     testMergeGroups();
@@ -0,0 +1,97 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+// Unit tests for tdigest.
+
+#include <vespa/log/log.h>
+LOG_SETUP("tdigest_test");
+
+#include <vespa/searchlib/grouping/tdigest.h>
+#include <vespa/vespalib/objects/nboserializer.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/testkit/testapp.h>
+
+using vespalib::NBOSerializer;
+using vespalib::nbostream;
+using namespace search;
+
+namespace {
+
+TDigest makeDigest(uint32_t begin, uint32_t end, uint32_t step = 1) {
+    TDigest digest;
+    for (uint32_t i = begin; i < end; i += step) {
+        digest.add(i);
+    }
+    return digest;
+}
+
+TEST("require that empty digest estimates zero") {
+    TDigest digest;
+    EXPECT_TRUE(digest.empty());
+    EXPECT_EQUAL(0.0, digest.quantile(0.5));
+}
+
+TEST("require that single value is estimated exactly") {
+    TDigest digest;
+    digest.add(42.0);
+    EXPECT_EQUAL(42.0, digest.quantile(0.0));
+    EXPECT_EQUAL(42.0, digest.quantile(0.5));
+    EXPECT_EQUAL(42.0, digest.quantile(1.0));
+}
+
+TEST("require that quantiles of uniform values are estimated") {
+    TDigest digest = makeDigest(0, 100001);
+    EXPECT_EQUAL(0.0, digest.quantile(0.0));
+    EXPECT_EQUAL(100000.0, digest.quantile(1.0));
+    EXPECT_APPROX(50000.0, digest.quantile(0.5), 500.0);
+    EXPECT_APPROX(90000.0, digest.quantile(0.9), 500.0);
+    EXPECT_APPROX(99000.0, digest.quantile(0.99), 100.0);
+    EXPECT_APPROX(99900.0, digest.quantile(0.999), 20.0);
+}
+
+TEST("require that number of centroids is bounded") {
+    TDigest digest = makeDigest(0, 100000);
+    digest.compress();
+    EXPECT_EQUAL(100000.0, digest.getTotalWeight());
+    EXPECT_LESS(digest.getCentroids().size(), 2 * digest.getCompression());
+}
+
+TEST("require that merged digests estimate the combined values") {
+    TDigest even = makeDigest(0, 100000, 2);
+    TDigest odd = makeDigest(1, 100000, 2);
+    even.merge(odd);
+    EXPECT_EQUAL(100000.0, even.getTotalWeight());
+    EXPECT_EQUAL(0.0, even.getMin());
+    EXPECT_EQUAL(99999.0, even.getMax());
+    EXPECT_APPROX(50000.0, even.quantile(0.5), 500.0);
+    EXPECT_APPROX(99000.0, even.quantile(0.99), 100.0);
+}
+
+TEST("require that digest can be serialized and deserialized") {
+    TDigest digest = makeDigest(0, 1234);
+    nbostream stream;
+    NBOSerializer serializer(stream);
+    digest.serialize(serializer);
+    TDigest digest2(10);
+    digest2.deserialize(serializer);
+    EXPECT_TRUE(stream.empty());
+    EXPECT_TRUE(digest == digest2);
+    EXPECT_EQUAL(digest.quantile(0.75), digest2.quantile(0.75));
+}
+
+TEST("require that empty digest can be serialized and merged") {
+    TDigest empty;
+    nbostream stream;
+    NBOSerializer serializer(stream);
+    empty.serialize(serializer);
+    TDigest digest = makeDigest(0, 10);
+    TDigest empty2;
+    empty2.deserialize(serializer);
+    EXPECT_TRUE(empty2.empty());
+    digest.merge(empty2);
+    EXPECT_EQUAL(10.0, digest.getTotalWeight());
+    EXPECT_EQUAL(0.0, digest.getMin());
+    EXPECT_EQUAL(9.0, digest.getMax());
+}
+
+}  // namespace
+
+TEST_MAIN() { TEST_RUN_ALL(); }
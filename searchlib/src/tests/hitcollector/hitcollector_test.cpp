@@ -251,6 +251,44 @@ TEST_F("require that scores for 2nd phase candidates can be retrieved", Descendi
     EXPECT_EQUAL(96, scores[4]);
 }
 
+TEST_F("require that 2nd phase candidates can be retrieved with docids", DescendingScoreFixture)
+{
+    f.addHits();
+    std::vector<HitCollector::Hit> hits = f.hc.getSortedHeapHits();
+    ASSERT_EQUAL(5u, hits.size());
+    for (uint32_t i = 0; i < 5; ++i) {
+        EXPECT_EQUAL(i, hits[i].first);
+        EXPECT_EQUAL(100 - i, hits[i].second);
+    }
+}
+
+TEST_F("require that hits re-ranked elsewhere can be set", AscendingScoreFixture)
+{
+    f.addHits();
+    std::vector<HitCollector::Hit> hits = f.hc.getSortedHeapHits();
+    hits.resize(3);
+    for (auto &hit : hits) {
+        hit.second = hit.first;
+    }
+    f.hc.setReRankedHits(hits);
+    EXPECT_EQUAL(117, f.hc.getRanges().first.low);
+    EXPECT_EQUAL(119, f.hc.getRanges().first.high);
+    EXPECT_EQUAL(17, f.hc.getRanges().second.low);
+    EXPECT_EQUAL(19, f.hc.getRanges().second.high);
+
+    std::vector<RankedHit> expRh;
+    for (uint32_t i = 10; i < 20; ++i) {  // 10 last are the best
+        expRh.push_back(RankedHit(i, f.calculateScore(i)));
+        if (i >= 17) { // hits re-ranked elsewhere (3 last)
+            expRh.back()._rankValue = i;
+        } else {
+            expRh.back()._rankValue -= 100; // rescaled below final range
+        }
+    }
+    std::unique_ptr<ResultSet> rs = f.hc.getResultSet();
+    TEST_DO(checkResult(*rs.get(), expRh));
+}
+
 TEST("require that score ranges can be read and set.") {
     std::pair<Scores, Scores> ranges =
         std::make_pair(Scores(1.0, 2.0), Scores(3.0, 4.0));
@@ -1148,6 +1148,30 @@ TEST_F("requireThatInverterHandlesRemoveViaDocumentRemover",
     EXPECT_TRUE(assertPostingList("[]", f._d.find("c", 1)));
 }
 
+TEST_F("require that features of removed documents are accounted as dead",
+       DictionaryFixture<Fixture>)
+{
+    f._b.startDocument("doc::1");
+    f._b.startIndexField("f0").addStr("a").addStr("b").endField();
+    Document::UP doc1 = f._b.endDocument();
+    f._inv.invertDocument(1, *doc1.get());
+    f._invertThreads.sync();
+    myPushDocument(f._inv, f._d);
+    f._pushThreads.sync();
+    myCommit(f._d, f._pushThreads);
+    DataStoreBase::MemStats beforeStats = getFeatureStoreMemStats(f._d);
+
+    myremove(1, f._inv, f._d, f._invertThreads);
+    f._pushThreads.sync();
+    myCommit(f._d, f._pushThreads);
+    myCommit(f._d, f._pushThreads);
+    DataStoreBase::MemStats afterStats = getFeatureStoreMemStats(f._d);
+    EXPECT_EQUAL(beforeStats._usedElems, afterStats._usedElems);
+    EXPECT_EQUAL(0u, afterStats._holdElems);
+    EXPECT_LESS(beforeStats._deadElems, afterStats._deadElems);
+}
+
+
 class UriFixture
 {
 public:
@@ -6,6 +6,7 @@
 #include <vespa/searchlib/fef/matchdata.h>
 #include <vespa/searchlib/fef/matchdatalayout.h>
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/common/bitvectoriterator.h>
 #include <vespa/searchlib/index/docbuilder.h>
 #include <vespa/searchlib/query/tree/simplequery.h>
 #include <vespa/searchlib/queryeval/booleanmatchiteratorwrapper.h>
@@ -381,7 +382,7 @@ TEST("requireThatNumDocsAndDocIdLimitIsReturned")
 
 TEST("requireThatWeUnderstandTheMemoryFootprint")
 {
-    constexpr size_t BASE_SIZE = 118860u;
+    constexpr size_t BASE_SIZE = 161868u;
     {
         Setup setup;
         Index index(setup);
@@ -441,4 +442,64 @@ TEST("requireThatWeCanFakeBitVector")
     }
 }
 
+namespace {
+
+SearchIterator::UP
+createFilterSearch(Searchable &searchable, MatchData::UP &match_data, const std::string &word)
+{
+    uint32_t fieldId = 0;
+    MatchDataLayout mdl;
+    FakeRequestContext requestContext;
+    TermFieldHandle handle = mdl.allocTermField(fieldId);
+    match_data = mdl.createMatchData();
+    FieldSpec field(title, fieldId, handle, true);
+    FieldSpecList fields;
+    fields.add(field);
+    Blueprint::UP res = searchable.createBlueprint(requestContext, fields, makeTerm(word));
+    res->fetchPostings(true);
+    SearchIterator::UP search = res->createSearch(*match_data, true);
+    search->initFullRange();
+    return search;
+}
+
+}
+
+TEST("requireThatCommonWordsAreBackedByBitVectors")
+{
+    Index index(Setup().field(title));
+    for (uint32_t docId = 1; docId <= 20; ++docId) {
+        index.doc(docId).field(title).add(foo);
+        if (docId == 3) {
+            index.add(bar);
+        }
+        index.commit();
+    }
+    Searchable &searchable = index.index;
+    MatchData::UP match_data;
+    SearchIterator::UP search = createFilterSearch(searchable, match_data, foo);
+    EXPECT_TRUE(dynamic_cast<BitVectorIterator *>(search.get()) != nullptr);
+    EXPECT_EQUAL("1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20", toString(*search));
+    search = createFilterSearch(searchable, match_data, bar);
+    EXPECT_TRUE(dynamic_cast<BooleanMatchIteratorWrapper *>(search.get()) != nullptr);
+    EXPECT_EQUAL("3", toString(*search));
+    FakeResult ranked;
+    for (uint32_t docId = 1; docId <= 20; ++docId) {
+        ranked.doc(docId).len(docId == 3 ? 2 : 1).pos(0);
+    }
+    EXPECT_TRUE(verifyResult(ranked, searchable, title, makeTerm(foo)));
+
+    index.remove(4);
+    index.doc(25).field(title).add(foo).commit();
+    search = createFilterSearch(searchable, match_data, foo);
+    EXPECT_TRUE(dynamic_cast<BitVectorIterator *>(search.get()) != nullptr);
+    EXPECT_EQUAL("1,2,3,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,25", toString(*search));
+
+    for (uint32_t docId = 5; docId <= 20; ++docId) {
+        index.remove(docId);
+    }
+    search = createFilterSearch(searchable, match_data, foo);
+    EXPECT_TRUE(dynamic_cast<BooleanMatchIteratorWrapper *>(search.get()) != nullptr);
+    EXPECT_EQUAL("1,2,3,25", toString(*search));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,107 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/searchlib/common/sequencedtaskexecutor.h>
+#include <vespa/searchlib/index/docbuilder.h>
+#include <vespa/searchlib/memoryindex/memoryindex.h>
+#include <vespa/searchlib/util/rand48.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <chrono>
+
+#include <vespa/log/log.h>
+LOG_SETUP("memoryindex_benchmark_test");
+
+using document::Document;
+using search::index::DocBuilder;
+using search::index::Schema;
+using search::index::schema::DataType;
+using search::memoryindex::MemoryIndex;
+
+namespace {
+
+constexpr uint32_t NUM_FIELDS = 4;
+constexpr uint32_t NUM_DOCS = 20000;
+constexpr uint32_t WORDS_PER_FIELD = 100;
+constexpr uint32_t VOCABULARY_SIZE = 100000;
+constexpr uint32_t DOCS_PER_COMMIT = 100;
+
+Schema
+makeSchema()
+{
+    Schema schema;
+    for (uint32_t i = 0; i < NUM_FIELDS; ++i) {
+        schema.addIndexField(Schema::IndexField(vespalib::make_string("f%u", i), DataType::STRING));
+    }
+    return schema;
+}
+
+/**
+ * Builds documents with string fields drawing words from a fixed
+ * vocabulary, so that the dictionary keeps growing during the run.
+ */
+struct DocumentGenerator {
+    DocBuilder builder;
+    search::Rand48 rnd;
+
+    DocumentGenerator(const Schema &schema) : builder(schema), rnd() {}
+
+    std::vector<Document::UP> make(uint32_t numDocs) {
+        std::vector<Document::UP> docs;
+        docs.reserve(numDocs);
+        for (uint32_t docId = 1; docId <= numDocs; ++docId) {
+            builder.startDocument(vespalib::make_string("doc::%u", docId));
+            for (uint32_t field = 0; field < NUM_FIELDS; ++field) {
+                builder.startIndexField(vespalib::make_string("f%u", field));
+                for (uint32_t i = 0; i < WORDS_PER_FIELD; ++i) {
+                    builder.addStr(vespalib::make_string("w%lu", rnd.lrand48() % VOCABULARY_SIZE));
+                }
+                builder.endField();
+            }
+            docs.push_back(builder.endDocument());
+        }
+        return docs;
+    }
+};
+
+double
+feedDocuments(const Schema &schema, const std::vector<Document::UP> &docs, uint32_t threads)
+{
+    search::SequencedTaskExecutor invertThreads(threads);
+    search::SequencedTaskExecutor pushThreads(threads);
+    MemoryIndex index(schema, invertThreads, pushThreads);
+    auto before = std::chrono::steady_clock::now();
+    uint32_t docId = 1;
+    for (const auto &doc : docs) {
+        index.insertDocument(docId, *doc);
+        if ((docId % DOCS_PER_COMMIT) == 0) {
+            index.commit(std::shared_ptr<search::IDestructorCallback>());
+        }
+        ++docId;
+    }
+    index.commit(std::shared_ptr<search::IDestructorCallback>());
+    invertThreads.sync();
+    pushThreads.sync();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - before;
+    EXPECT_EQUAL(docs.size(), index.getNumDocs());
+    return elapsed.count();
+}
+
+}
+
+TEST("benchmark inverting and pushing documents to memory index")
+{
+    Schema schema(makeSchema());
+    DocumentGenerator generator(schema);
+    std::vector<Document::UP> docs = generator.make(NUM_DOCS);
+    for (uint32_t threads : {1u, 2u, 4u}) {
+        double seconds = feedDocuments(schema, docs, threads);
+        double docsPerSecond = docs.size() / seconds;
+        // Each thread count is used for both invert and push threads
+        fprintf(stderr, "threads=%u: %u docs (%u fields, %u words per field) in %.3f s: "
+                "%.0f docs/s, %.0f docs/s per core\n",
+                threads, NUM_DOCS, NUM_FIELDS, WORDS_PER_FIELD, seconds,
+                docsPerSecond, docsPerSecond / (2 * threads));
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
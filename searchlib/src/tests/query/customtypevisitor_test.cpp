@@ -53,6 +53,9 @@ struct MyDotProduct : DotProduct { MyDotProduct() : DotProduct("view", 0, Weight
 struct MyWandTerm : WandTerm { MyWandTerm() : WandTerm("view", 0, Weight(42), 57, 67, 77.7) {} };
 struct MyPredicateQuery : InitTerm<PredicateQuery> {};
 struct MyRegExpTerm : InitTerm<RegExpTerm>  {};
+struct MyNearestNeighborTerm : NearestNeighborTerm {
+    MyNearestNeighborTerm() : NearestNeighborTerm(Type(), "view", 0, Weight(42), 10, 0) {}
+};
 
 struct MyQueryNodeTypes {
     typedef MyAnd And;
@@ -76,6 +79,7 @@ struct MyQueryNodeTypes {
     typedef MyWandTerm WandTerm;
     typedef MyPredicateQuery PredicateQuery;
     typedef MyRegExpTerm RegExpTerm;
+    typedef MyNearestNeighborTerm NearestNeighborTerm;
 };
 
 class MyCustomVisitor : public CustomTypeVisitor<MyQueryNodeTypes>
@@ -110,6 +114,7 @@ public:
     virtual void visit(MyWandTerm &) override { setVisited<MyWandTerm>(); }
     virtual void visit(MyPredicateQuery &) override { setVisited<MyPredicateQuery>(); }
     virtual void visit(MyRegExpTerm &) override { setVisited<MyRegExpTerm>(); }
+    virtual void visit(MyNearestNeighborTerm &) override { setVisited<MyNearestNeighborTerm>(); }
 };
 
 template <class T>
@@ -148,6 +153,7 @@ Test::Main()
     TEST_CALL(requireThatNodeIsVisited<MyWandTerm>);
     TEST_CALL(requireThatNodeIsVisited<MyPredicateQuery>);
     TEST_CALL(requireThatNodeIsVisited<MyRegExpTerm>);
+    TEST_CALL(requireThatNodeIsVisited<MyNearestNeighborTerm>);
 
     TEST_DONE();
 }
@@ -66,6 +66,8 @@ public:
     virtual void visit(PredicateQuery &) override
     { isVisited<PredicateQuery>() = true; }
     virtual void visit(RegExpTerm &) override { isVisited<RegExpTerm>() = true; }
+    virtual void visit(NearestNeighborTerm &) override
+    { isVisited<NearestNeighborTerm>() = true; }
 };
 
 template <class T>
@@ -106,6 +108,8 @@ void Test::requireThatAllNodesCanBeVisited() {
             new SimplePredicateQuery(PredicateQueryTerm::UP(),
                                      "field", 0, Weight(0)));
     checkVisit<RegExpTerm>(new SimpleRegExpTerm("t", "field", 0, Weight(0)));
+    checkVisit<NearestNeighborTerm>(
+            new SimpleNearestNeighborTerm({1.0, 2.0}, "field", 0, Weight(0), 10, 0));
 }
 
 }  // namespace
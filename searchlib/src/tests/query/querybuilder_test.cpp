@@ -42,6 +42,10 @@ const int max_distance = 20;
 const uint32_t x_aspect = 0;
 const Location location(position, max_distance, x_aspect);
 
+std::vector<double> getQueryVector() {
+    return {1.5, -2.0, 0.25};
+}
+
 PredicateQueryTerm::UP getPredicateQueryTerm() {
     PredicateQueryTerm::UP pqt(new PredicateQueryTerm);
     pqt->addFeature("key", "value");
@@ -52,7 +56,7 @@ PredicateQueryTerm::UP getPredicateQueryTerm() {
 template <class NodeTypes>
 Node::UP createQueryTree() {
     QueryBuilder<NodeTypes> builder;
-    builder.addAnd(9);
+    builder.addAnd(10);
     {
         builder.addRank(2);
         {
@@ -109,6 +113,7 @@ Node::UP createQueryTree() {
             builder.addStringTerm(str[2], view[2], id[2], weight[2]);
         }
         builder.addRegExpTerm(str[5], view[5], id[5], weight[5]);
+        builder.addNearestNeighborTerm(getQueryVector(), view[6], id[6], weight[6], 100, 50);
     }
     Node::UP node = builder.build();
     ASSERT_TRUE(node.get());
@@ -161,11 +166,12 @@ void checkQueryTreeTypes(Node *node) {
     typedef typename NodeTypes::WeakAnd WeakAnd;
     typedef typename NodeTypes::PredicateQuery PredicateQuery;
     typedef typename NodeTypes::RegExpTerm RegExpTerm;
+    typedef typename NodeTypes::NearestNeighborTerm NearestNeighborTerm;
 
     ASSERT_TRUE(node);
     And *and_node = dynamic_cast<And *>(node);
     ASSERT_TRUE(and_node);
-    EXPECT_EQUAL(9u, and_node->getChildren().size());
+    EXPECT_EQUAL(10u, and_node->getChildren().size());
 
 
     Rank *rank = dynamic_cast<Rank *>(and_node->getChildren()[0]);
@@ -285,6 +291,12 @@ void checkQueryTreeTypes(Node *node) {
     RegExpTerm *regexp_term =
         dynamic_cast<RegExpTerm *>(and_node->getChildren()[8]);
     EXPECT_TRUE(checkTerm(regexp_term, str[5], view[5], id[5], weight[5]));
+
+    NearestNeighborTerm *nn_term =
+        dynamic_cast<NearestNeighborTerm *>(and_node->getChildren()[9]);
+    EXPECT_TRUE(checkTerm(nn_term, getQueryVector(), view[6], id[6], weight[6]));
+    EXPECT_EQUAL(100u, nn_term->get_target_num_hits());
+    EXPECT_EQUAL(50u, nn_term->get_explore_additional_hits());
 }
 
 struct AbstractTypes {
@@ -308,6 +320,7 @@ struct AbstractTypes {
     typedef search::query::WeakAnd WeakAnd;
     typedef search::query::PredicateQuery PredicateQuery;
     typedef search::query::RegExpTerm RegExpTerm;
+    typedef search::query::NearestNeighborTerm NearestNeighborTerm;
 };
 
 // Builds a tree with simplequery and checks that the results have the
@@ -393,6 +406,12 @@ struct MyRegExpTerm : RegExpTerm {
         : RegExpTerm(t, f, i, w) {
     }
 };
+struct MyNearestNeighborTerm : NearestNeighborTerm {
+    MyNearestNeighborTerm(Type t, const string &f, int32_t i, Weight w,
+                          uint32_t target_num_hits, uint32_t explore_additional_hits)
+        : NearestNeighborTerm(std::move(t), f, i, w, target_num_hits, explore_additional_hits) {
+    }
+};
 
 struct MyQueryNodeTypes {
     typedef MyAnd And;
@@ -416,6 +435,7 @@ struct MyQueryNodeTypes {
     typedef MyWandTerm WandTerm;
     typedef MyPredicateQuery PredicateQuery;
     typedef MyRegExpTerm RegExpTerm;
+    typedef MyNearestNeighborTerm NearestNeighborTerm;
 };
 
 TEST("require that Custom Query Trees Can Be Built") {
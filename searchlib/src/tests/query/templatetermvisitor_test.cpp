@@ -70,6 +70,7 @@ void Test::requireThatAllTermsCanBeVisited() {
     EXPECT_TRUE(checkVisit<SimpleSuffixTerm>());
     EXPECT_TRUE(checkVisit<SimplePredicateQuery>());
     EXPECT_TRUE(checkVisit<SimpleRegExpTerm>());
+    EXPECT_TRUE(checkVisit(new SimpleNearestNeighborTerm({1.0, 2.0}, "field", 0, Weight(0), 10, 0)));
     EXPECT_TRUE(checkVisit(new SimplePhrase("field", 0, Weight(0))));
     EXPECT_TRUE(!checkVisit(new SimpleAnd));
     EXPECT_TRUE(!checkVisit(new SimpleAndNot));
@@ -39,7 +39,7 @@ public:
     }
 
     virtual SearchIterator::UP
-    createIntermediateSearch(const MultiSearch::Children &subSearches,
+    createIntermediateSearch(MultiSearch::Children subSearches,
                              bool strict, MatchData &md) const override
     {
         return SearchIterator::UP(new MySearch("or", subSearches, &md, strict));
@@ -56,7 +56,7 @@ class OtherOr : public OrBlueprint
 private:
 public:
     virtual SearchIterator::UP
-    createIntermediateSearch(const MultiSearch::Children &subSearches,
+    createIntermediateSearch(MultiSearch::Children subSearches,
                              bool strict, MatchData &md) const override
     {
         return SearchIterator::UP(new MySearch("or", subSearches, &md, strict));
@@ -86,7 +86,7 @@ public:
     }
 
     virtual SearchIterator::UP
-    createIntermediateSearch(const MultiSearch::Children &subSearches,
+    createIntermediateSearch(MultiSearch::Children subSearches,
                              bool strict, MatchData &md) const override
     {
         return SearchIterator::UP(new MySearch("and", subSearches, &md, strict));
@@ -103,7 +103,7 @@ class OtherAnd : public AndBlueprint
 private:
 public:
     virtual SearchIterator::UP
-    createIntermediateSearch(const MultiSearch::Children &subSearches,
+    createIntermediateSearch(MultiSearch::Children subSearches,
                              bool strict, MatchData &md) const override
     {
         return SearchIterator::UP(new MySearch("and", subSearches, &md, strict));
@@ -118,7 +118,7 @@ class OtherAndNot : public AndNotBlueprint
 {
 public:
     virtual SearchIterator::UP
-    createIntermediateSearch(const MultiSearch::Children &subSearches,
+    createIntermediateSearch(MultiSearch::Children subSearches,
                              bool strict, MatchData &md) const override
     {
         return SearchIterator::UP(new MySearch("andnot", subSearches, &md, strict));
@@ -672,6 +672,7 @@ getExpectedBlueprint()
            "        estHits: 9\n"
            "        tree_size: 2\n"
            "        allow_termwise_eval: 0\n"
+           "        cost_tier: 1\n"
            "    }\n"
            "    sourceId: 4294967295\n"
            "    docid_limit: 0\n"
@@ -690,6 +691,7 @@ getExpectedBlueprint()
            "                estHits: 9\n"
            "                tree_size: 1\n"
            "                allow_termwise_eval: 1\n"
+           "                cost_tier: 1\n"
            "            }\n"
            "            sourceId: 4294967295\n"
            "            docid_limit: 0\n"
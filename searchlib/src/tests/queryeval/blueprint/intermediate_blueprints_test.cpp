@@ -135,6 +135,50 @@ TEST("test And Blueprint") {
     // createSearch tested by iterator unit test
 }
 
+TEST("require that And Blueprint sorts children on cost tier before estimate") {
+    AndBlueprint b;
+    std::vector<Blueprint *> children;
+    Blueprint::UP c1 = ap(MyLeafSpec(20).create());
+    Blueprint::UP c2 = ap(MyLeafSpec(10).cost_tier(Blueprint::State::COST_TIER_EXPENSIVE).create());
+    Blueprint::UP c3 = ap(MyLeafSpec(30).create());
+    Blueprint::UP c4 = ap(MyLeafSpec(5).cost_tier(Blueprint::State::COST_TIER_EXPENSIVE).create());
+    children.push_back(c1.get());
+    children.push_back(c2.get());
+    children.push_back(c3.get());
+    children.push_back(c4.get());
+    b.sort(children);
+    EXPECT_EQUAL(c1.get(), children[0]);
+    EXPECT_EQUAL(c3.get(), children[1]);
+    EXPECT_EQUAL(c4.get(), children[2]);
+    EXPECT_EQUAL(c2.get(), children[3]);
+}
+
+TEST("require that cost tier is calculated for intermediate blueprints") {
+    AndBlueprint a;
+    OrBlueprint o;
+    EXPECT_EQUAL(Blueprint::State::COST_TIER_MAX, a.getState().cost_tier());
+    EXPECT_EQUAL(Blueprint::State::COST_TIER_NORMAL, o.getState().cost_tier());
+    a.addChild(ap(MyLeafSpec(10).cost_tier(Blueprint::State::COST_TIER_EXPENSIVE).create()));
+    o.addChild(ap(MyLeafSpec(10).cost_tier(Blueprint::State::COST_TIER_EXPENSIVE).create()));
+    EXPECT_EQUAL(Blueprint::State::COST_TIER_EXPENSIVE, a.getState().cost_tier());
+    EXPECT_EQUAL(Blueprint::State::COST_TIER_EXPENSIVE, o.getState().cost_tier());
+    a.addChild(ap(MyLeafSpec(20).create()));
+    o.addChild(ap(MyLeafSpec(20).create()));
+    EXPECT_EQUAL(Blueprint::State::COST_TIER_NORMAL, a.getState().cost_tier());
+    EXPECT_EQUAL(Blueprint::State::COST_TIER_EXPENSIVE, o.getState().cost_tier());
+}
+
+TEST("require that the cheapest child is strict in an optimized And Blueprint") {
+    Blueprint::UP top = ap(new AndBlueprint());
+    static_cast<AndBlueprint &>(*top).addChild(ap(MyLeafSpec(5).cost_tier(Blueprint::State::COST_TIER_EXPENSIVE).create()));
+    static_cast<AndBlueprint &>(*top).addChild(ap(MyLeafSpec(50).create()));
+    top = Blueprint::optimize(std::move(top));
+    const IntermediateBlueprint &and_bp = static_cast<const IntermediateBlueprint &>(*top);
+    ASSERT_EQUAL(2u, and_bp.childCnt());
+    EXPECT_EQUAL(50u, and_bp.getChild(0).getState().estimate().estHits);
+    EXPECT_EQUAL(5u, and_bp.getChild(1).getState().estimate().estHits);
+}
+
 TEST("test Or Blueprint") {
     OrBlueprint b;
     { // combine
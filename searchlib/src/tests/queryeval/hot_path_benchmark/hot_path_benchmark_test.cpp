@@ -0,0 +1,277 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/fef/blueprintfactory.h>
+#include <vespa/searchlib/fef/blueprintresolver.h>
+#include <vespa/searchlib/fef/matchdatalayout.h>
+#include <vespa/searchlib/fef/rank_program.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/fef/test/indexenvironment.h>
+#include <vespa/searchlib/fef/test/plugin/sum.h>
+#include <vespa/searchlib/fef/test/queryenvironment.h>
+#include <vespa/searchlib/fef/test/test_features.h>
+#include <vespa/searchlib/query/queryterm.h>
+#include <vespa/searchlib/queryeval/andsearch.h>
+#include <vespa/searchlib/queryeval/dot_product_search.h>
+#include <vespa/searchlib/queryeval/hitcollector.h>
+#include <vespa/searchlib/queryeval/orsearch.h>
+#include <vespa/searchlib/queryeval/wand/weak_and_search.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <vespa/vespalib/util/stringfmt.h>
+
+using namespace search::attribute;
+using namespace search::fef;
+using namespace search::queryeval;
+using search::AttributeFactory;
+using search::AttributeVector;
+using search::IntegerAttribute;
+using search::QueryTermSimple;
+using search::fef::test::DocidBlueprint;
+using search::fef::test::SumBlueprint;
+using vespalib::BenchmarkTimer;
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Benchmark of the operators used when matching and ranking a
+ * query. The time spent per document in the searched document id
+ * space is reported for each operator, which makes it possible to
+ * compare numbers across runs with different corpus sizes. The
+ * number of documents is taken from the HOT_PATH_BENCHMARK_DOCS
+ * environment variable (default 1M), and each measurement is the
+ * best of repeated runs within HOT_PATH_BENCHMARK_BUDGET seconds
+ * (default 1.0).
+ **/
+
+uint32_t get_num_docs() {
+    const char *value = getenv("HOT_PATH_BENCHMARK_DOCS");
+    return (value != nullptr) ? strtoul(value, nullptr, 10) : 1000000;
+}
+
+double get_budget() {
+    const char *value = getenv("HOT_PATH_BENCHMARK_BUDGET");
+    return (value != nullptr) ? strtod(value, nullptr) : 1.0;
+}
+
+const uint32_t num_docs = get_num_docs();
+const double budget = get_budget();
+
+void report(const vespalib::string &name, double seconds) {
+    fprintf(stderr, "%-48s %10.2f ns/doc\n", name.c_str(), (seconds * 1000000000.0) / num_docs);
+}
+
+//-----------------------------------------------------------------------------
+
+// synthetic posting list with a hit in every step'th document
+struct ModSearch : SearchIterator {
+    uint32_t step;
+    uint32_t limit;
+    TermFieldMatchData *tfmd;
+    ModSearch(uint32_t step_in, uint32_t limit_in, TermFieldMatchData *tfmd_in = nullptr)
+        : step(step_in), limit(limit_in), tfmd(tfmd_in) {}
+    void doSeek(uint32_t docid) override {
+        uint32_t hit = ((docid + step - 1) / step) * step;
+        if (hit < limit) {
+            setDocId(hit);
+        } else {
+            setAtEnd();
+        }
+    }
+    void doUnpack(uint32_t docid) override {
+        if (tfmd != nullptr) {
+            tfmd->reset(docid);
+        }
+    }
+};
+
+size_t run_search(SearchIterator &search, bool unpack) {
+    size_t hits = 0;
+    search.initRange(1, num_docs);
+    for (uint32_t docid = search.seekFirst(1); !search.isAtEnd(docid); docid = search.seekNext(docid + 1)) {
+        if (unpack) {
+            search.unpack(docid);
+        }
+        ++hits;
+    }
+    return hits;
+}
+
+// children hit 1/2, 1/3, 1/4, ... of the documents
+struct Children {
+    MatchData::UP md;
+    std::vector<SearchIterator *> search;
+    std::vector<TermFieldMatchData *> tfmd;
+    std::vector<int32_t> weight;
+    Children(size_t n) : md(), search(), tfmd(), weight() {
+        MatchDataLayout layout;
+        std::vector<TermFieldHandle> handles;
+        for (size_t i = 0; i < n; ++i) {
+            handles.push_back(layout.allocTermField(0));
+        }
+        md = layout.createMatchData();
+        for (size_t i = 0; i < n; ++i) {
+            tfmd.push_back(md->resolveTermField(handles[i]));
+            search.push_back(new ModSearch(i + 2, num_docs, tfmd.back()));
+            weight.push_back(100 + i);
+        }
+    }
+    ~Children() {
+        for (SearchIterator *child: search) {
+            delete child;
+        }
+    }
+    std::vector<SearchIterator *> release() {
+        std::vector<SearchIterator *> result;
+        std::swap(result, search);
+        return result;
+    }
+    wand::Terms terms() {
+        wand::Terms result;
+        for (size_t i = 0; i < search.size(); ++i) {
+            result.push_back(wand::Term(search[i], weight[i], num_docs / (i + 2), tfmd[i]));
+        }
+        search.clear();
+        return result;
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+TEST("benchmark AND") {
+    for (size_t n: {2, 4, 8}) {
+        double t = BenchmarkTimer::benchmark([n](){
+                Children children(n);
+                SearchIterator::UP search(AndSearch::create(children.release(), true));
+                run_search(*search, true);
+            }, budget);
+        report(vespalib::make_string("AND(%zu children)", n), t);
+    }
+}
+
+TEST("benchmark OR") {
+    for (size_t n: {2, 4, 8}) {
+        double t = BenchmarkTimer::benchmark([n](){
+                Children children(n);
+                SearchIterator::UP search(OrSearch::create(children.release(), true));
+                run_search(*search, true);
+            }, budget);
+        report(vespalib::make_string("OR(%zu children)", n), t);
+    }
+}
+
+TEST("benchmark WeakAnd") {
+    for (size_t n: {4, 16, 64}) {
+        double t = BenchmarkTimer::benchmark([n](){
+                Children children(n);
+                SearchIterator::UP search(WeakAndSearch::create(children.terms(), 100, true));
+                run_search(*search, true);
+            }, budget);
+        report(vespalib::make_string("WeakAnd(%zu children, 100 hits)", n), t);
+    }
+}
+
+TEST("benchmark DotProduct") {
+    for (size_t n: {4, 16, 64}) {
+        double t = BenchmarkTimer::benchmark([n](){
+                Children children(n);
+                TermFieldMatchData tfmd;
+                std::vector<int32_t> weights = children.weight;
+                std::vector<TermFieldMatchData *> child_tfmd = children.tfmd;
+                SearchIterator::UP search = DotProductSearch::create(children.release(), tfmd, child_tfmd,
+                                                                     weights, std::move(children.md));
+                run_search(*search, true);
+            }, budget);
+        report(vespalib::make_string("DotProduct(%zu children)", n), t);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+struct IntAttribute {
+    AttributeVector::SP attr;
+    IntAttribute() : attr(AttributeFactory::createAttribute("int", Config(BasicType::INT32))) {
+        IntegerAttribute &int_attr = dynamic_cast<IntegerAttribute &>(*attr);
+        attr->addReservedDoc();
+        for (uint32_t docid = 1; docid < num_docs; ++docid) {
+            uint32_t added;
+            attr->addDoc(added);
+            int_attr.update(added, docid % 100);
+        }
+        attr->commit(true);
+    }
+    AttributeVector::SearchContext::UP search(const vespalib::string &term) const {
+        return attr->getSearch(std::make_unique<QueryTermSimple>(term, QueryTermSimple::WORD), SearchContextParams());
+    }
+};
+
+TEST_F("benchmark attribute search context", IntAttribute()) {
+    const IntAttribute &attr = f1;
+    for (const char *term: {"42", "[10;19]", "[0;89]"}) {
+        double t = BenchmarkTimer::benchmark([&attr, term](){
+                AttributeVector::SearchContext::UP context = attr.search(term);
+                TermFieldMatchData tfmd;
+                context->fetchPostings(true);
+                SearchIterator::UP search = context->createIterator(&tfmd, true);
+                run_search(*search, true);
+            }, budget);
+        report(vespalib::make_string("attribute iterator(int32 in %s)", term), t);
+    }
+    for (const char *term: {"42", "[0;89]"}) {
+        double t = BenchmarkTimer::benchmark([&attr, term](){
+                AttributeVector::SearchContext::UP context = attr.search(term);
+                size_t hits = 0;
+                for (uint32_t docid = 1; docid < num_docs; ++docid) {
+                    hits += context->cmp(docid) ? 1 : 0;
+                }
+                EXPECT_TRUE(hits > 0);
+            }, budget);
+        report(vespalib::make_string("attribute cmp(int32 in %s)", term), t);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST("benchmark RankProgram") {
+    BlueprintFactory factory;
+    factory.addPrototype(Blueprint::SP(new DocidBlueprint()));
+    factory.addPrototype(Blueprint::SP(new SumBlueprint()));
+    search::fef::test::IndexEnvironment indexEnv;
+    for (const char *feature: {"docid", "mysum(docid,docid)", "mysum(mysum(docid,docid),mysum(docid,docid))"}) {
+        BlueprintResolver::SP resolver(new BlueprintResolver(factory, indexEnv));
+        resolver->addSeed(feature);
+        ASSERT_TRUE(resolver->compile());
+        double t = BenchmarkTimer::benchmark([&resolver, &indexEnv](){
+                MatchDataLayout mdl;
+                search::fef::test::QueryEnvironment queryEnv(&indexEnv);
+                MatchData::UP md = mdl.createMatchData();
+                RankProgram program(resolver);
+                program.setup(*md, queryEnv);
+                LazyValue seed = program.get_seeds().resolve(0);
+                double sum = 0.0;
+                for (uint32_t docid = 1; docid < num_docs; ++docid) {
+                    sum += seed.as_number(docid);
+                }
+                EXPECT_TRUE(sum > 0.0);
+            }, budget);
+        report(vespalib::make_string("RankProgram(%s)", feature), t);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST("benchmark HitCollector") {
+    for (uint32_t heap_size: {100, 1000, 10000}) {
+        double t = BenchmarkTimer::benchmark([heap_size](){
+                HitCollector hc(num_docs, heap_size, 0);
+                for (uint32_t docid = 1; docid < num_docs; ++docid) {
+                    hc.addHit(docid, (docid * 2654435761u) % 1000003);
+                }
+                std::unique_ptr<search::ResultSet> result = hc.getResultSet();
+                EXPECT_EQUAL(heap_size, result->getArrayUsed());
+            }, budget);
+        report(vespalib::make_string("HitCollector(heap %u)", heap_size), t);
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
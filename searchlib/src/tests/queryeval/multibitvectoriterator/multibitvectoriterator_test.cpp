@@ -18,6 +18,8 @@ using namespace search;
 
 //-----------------------------------------------------------------------------
 
+typedef std::vector<uint32_t> H;
+
 class Test : public vespalib::TestApp
 {
 public:
@@ -27,12 +29,15 @@ public:
     void testOr();
     void testAndWith();
     void testEndGuard();
+    template <typename T>
+    void testSparseChunks(bool strict, const H & expected);
     template<typename T>
     void testThatOptimizePreservesUnpack();
     template <typename T>
     void testOptimizeCommon(bool isAnd);
     template <typename T>
     void testOptimizeAndOr();
+    void testOptimizeAndNot();
     template <typename T>
     void testSearch(bool strict);
     int Main() override;
@@ -58,8 +63,6 @@ void Test::setup()
     }
 }
 
-typedef std::vector<uint32_t> H;
-
 H
 seekNoReset(SearchIterator & s, uint32_t start, uint32_t docIdLimit)
 {
@@ -129,7 +132,9 @@ Test::testAndWith()
 void
 Test::testAndNot()
 {
-    testOptimizeCommon<AndNotSearch>(false);
+    // and-not of only bitvectors becomes an and with inverted negatives, which accepts filters
+    testOptimizeCommon<AndNotSearch>(true);
+    testOptimizeAndNot();
     testSearch<AndNotSearch>(false);
     testSearch<AndNotSearch>(true);
 }
@@ -481,6 +486,63 @@ Test::testOptimizeAndOr()
     }
 }
 
+void
+Test::testOptimizeAndNot()
+{
+    TermFieldMatchData tfmd;
+    TermFieldMatchDataArray tfmda;
+    tfmda.add(&tfmd);
+    uint32_t docIdLimit(_bvs[0]->size());
+    {
+        MultiSearch::Children children;
+        children.push_back(BitVectorIterator::create(_bvs[0].get(), tfmda, true).release());
+        children.push_back(BitVectorIterator::create(_bvs[1].get(), tfmda, false).release());
+        children.push_back(BitVectorIterator::create(_bvs[2].get(), tfmda, false).release());
+
+        SearchIterator::UP s(AndNotSearch::create(children, true));
+        H expected = seek(*s, docIdLimit);
+        s = MultiBitVectorIteratorBase::optimize(std::move(s));
+        EXPECT_TRUE(dynamic_cast<const MultiBitVectorIteratorBase *>(s.get()) != NULL);
+        EXPECT_TRUE(dynamic_cast<const MultiBitVectorIteratorBase *>(s.get())->isStrict());
+        EXPECT_TRUE(expected == seek(*s, docIdLimit));
+        for (uint32_t docId : expected) {
+            EXPECT_TRUE(_bvs[0]->testBit(docId));
+            EXPECT_FALSE(_bvs[1]->testBit(docId));
+            EXPECT_FALSE(_bvs[2]->testBit(docId));
+        }
+    }
+    {
+        MultiSearch::Children children;
+        children.push_back(BitVectorIterator::create(_bvs[0].get(), tfmda, false).release());
+        children.push_back(new EmptySearch());
+        children.push_back(BitVectorIterator::create(_bvs[1].get(), tfmda, false).release());
+
+        SearchIterator::UP s(AndNotSearch::create(children, false));
+        s = MultiBitVectorIteratorBase::optimize(std::move(s));
+        EXPECT_TRUE(dynamic_cast<const AndNotSearch *>(s.get()) != NULL);
+        const MultiSearch & m(dynamic_cast<const MultiSearch &>(*s));
+        EXPECT_EQUAL(2u, m.getChildren().size());
+        EXPECT_TRUE(dynamic_cast<const MultiBitVectorIteratorBase *>(m.getChildren()[0]) != NULL);
+        EXPECT_TRUE(dynamic_cast<const EmptySearch *>(m.getChildren()[1]) != NULL);
+    }
+    {
+        // negatives with a different docid limit are kept apart from the positive child
+        BitVector::UP shorter = BitVector::create(docIdLimit / 2);
+        MultiSearch::Children children;
+        children.push_back(BitVectorIterator::create(_bvs[0].get(), tfmda, false).release());
+        children.push_back(BitVectorIterator::create(_bvs[1].get(), tfmda, false).release());
+        children.push_back(BitVectorIterator::create(shorter.get(), tfmda, false).release());
+
+        SearchIterator::UP s(AndNotSearch::create(children, false));
+        s = MultiBitVectorIteratorBase::optimize(std::move(s));
+        EXPECT_TRUE(dynamic_cast<const AndNotSearch *>(s.get()) != NULL);
+        const MultiSearch & m(dynamic_cast<const MultiSearch &>(*s));
+        EXPECT_EQUAL(2u, m.getChildren().size());
+        EXPECT_TRUE(dynamic_cast<const BitVectorIterator *>(m.getChildren()[0]) != NULL);
+        EXPECT_TRUE(dynamic_cast<const MultiBitVectorIteratorBase *>(m.getChildren()[1]) != NULL);
+    }
+}
+
 void
 Test::testEndGuard()
 {
@@ -503,6 +565,39 @@ Test::testEndGuard()
     EXPECT_FALSE(m.seek(_bvs[0]->size()+987));
 }
 
+template <typename T>
+void
+Test::testSparseChunks(bool strict, const H & expected)
+{
+    TermFieldMatchData tfmd;
+    TermFieldMatchDataArray tfmda;
+    tfmda.add(&tfmd);
+    BitVector::UP a = BitVector::create(10000);
+    BitVector::UP b = BitVector::create(10000);
+    for (uint32_t docId : {5u, 700u, 5000u, 9999u}) {
+        a->setBit(docId);
+    }
+    for (uint32_t docId : {700u, 1200u, 9999u}) {
+        b->setBit(docId);
+    }
+    a->invalidateCachedCount();
+    b->invalidateCachedCount();
+    MultiSearch::Children children;
+    children.push_back(BitVectorIterator::create(a.get(), tfmda, strict).release());
+    children.push_back(BitVectorIterator::create(b.get(), tfmda, strict).release());
+    SearchIterator::UP s(T::create(children, strict));
+    s = MultiBitVectorIteratorBase::optimize(std::move(s));
+    EXPECT_TRUE(dynamic_cast<const MultiBitVectorIteratorBase *>(s.get()) != NULL);
+    H hits = seek(*s, a->size());
+    EXPECT_TRUE(expected == hits);
+    // searching a later range first must not leave stale chunks behind
+    s->initRange(6000, 10000);
+    EXPECT_TRUE(H({9999}) == seekNoReset(*s, 6000, 10000));
+    s->initRange(1, 6000);
+    H firstHits = seekNoReset(*s, 1, 6000);
+    EXPECT_TRUE(H(expected.begin(), expected.end() - 1) == firstHits);
+}
+
 int
 Test::Main()
 {
@@ -522,6 +617,11 @@ Test::Main()
     TEST_FLUSH();
     testAndWith();
     TEST_FLUSH();
+    testSparseChunks<AndSearch>(false, H({700, 9999}));
+    testSparseChunks<AndSearch>(true, H({700, 9999}));
+    testSparseChunks<OrSearch>(false, H({5, 700, 1200, 5000, 9999}));
+    testSparseChunks<OrSearch>(true, H({5, 700, 1200, 5000, 9999}));
+    TEST_FLUSH();
     TEST_DONE();
 }
 
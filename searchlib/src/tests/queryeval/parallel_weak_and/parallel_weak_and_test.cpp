@@ -593,6 +593,7 @@ TEST_F("require that asString() on blueprint works", BlueprintAsStringFixture)
                               "        estHits: 2\n"
                               "        tree_size: 2\n"
                               "        allow_termwise_eval: 0\n"
+                              "        cost_tier: 1\n"
                               "    }\n"
                               "    sourceId: 4294967295\n"
                               "    docid_limit: 0\n"
@@ -614,6 +615,7 @@ TEST_F("require that asString() on blueprint works", BlueprintAsStringFixture)
                               "                estHits: 2\n"
                               "                tree_size: 1\n"
                               "                allow_termwise_eval: 1\n"
+                              "                cost_tier: 1\n"
                               "            }\n"
                               "            sourceId: 4294967295\n"
                               "            docid_limit: 0\n"
@@ -684,4 +686,30 @@ TEST("verify search iterator conformance") {
     }
 }
 
+TEST("require that block-max skipping gives the same hits as plain wand") {
+    DocumentWeightAttributeHelper helper;
+    helper.add_docs(2000);
+    SimpleResult expect;
+    for (uint32_t docid = 1; docid < 2000; ++docid) {
+        bool high = ((docid % 97) == 0) || ((docid % 89) == 0);
+        helper.set_doc(docid, (docid % 2) + 1, high ? 50 : 1);
+        if (high) {
+            expect.addHit(docid);
+        }
+    }
+    std::vector<int32_t> weights({1, 1});
+    std::vector<IDocumentWeightAttribute::LookupResult> dict_entries({helper.dwa().lookup("1"), helper.dwa().lookup("2")});
+    DummyHeap heap;
+    MatchParams match_params(heap, 10, 1.0, 1);
+    for (bool use_dwa: {false, true}) {
+        for (bool strict: {false, true}) {
+            TermFieldMatchData tfmd;
+            SearchIterator::UP search = create_wand(use_dwa, tfmd, match_params, weights, dict_entries, helper.dwa(), strict);
+            SimpleResult actual;
+            actual.search(*search, 2000);
+            EXPECT_EQUAL(expect, actual);
+        }
+    }
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -254,6 +254,19 @@ TEST("require that insufficient interval coverage prevents match") {
     EXPECT_FALSE(search.seek(3));
 }
 
+TEST("require that interval coverage from a previous document is not reused") {
+    MyPostingList plists[] = {{{2, 0x00010001},
+                               {3, 0x00020002}},
+                              {{2, 0x00020002}}};
+    MF mf{0, 0, 0, 0};
+    CV cv{0, 0, 2, 1};
+    IR ir{0, 0, 2, 2};
+    PredicateSearch search(&mf[0], &ir[0], 0xffff, cv, make_posting_lists_vector(plists), tfmda);
+    search.initFullRange();
+    EXPECT_TRUE(search.seek(2));
+    EXPECT_FALSE(search.seek(3));
+}
+
 TEST("require that intervals are sorted") {
     MyPostingList plists[] = {{{2, 0x00010001}},
                               {{2, 0x0003ffff}},
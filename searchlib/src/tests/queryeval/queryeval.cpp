@@ -235,6 +235,21 @@ TEST("testAnd") {
     EXPECT_EQUAL(res, expect);
 }
 
+TEST("require that AND and OR take over the children vector without copying it") {
+    TermFieldMatchData tfmd;
+    for (bool strict : {false, true}) {
+        MultiSearch::Children andChildren = { new TrueSearch(tfmd), new TrueSearch(tfmd) };
+        const SearchIterator * const * andStorage = andChildren.data();
+        SearchIterator::UP andSearch(AndSearch::create(std::move(andChildren), strict));
+        EXPECT_EQUAL(andStorage, static_cast<MultiSearch &>(*andSearch).getChildren().data());
+
+        MultiSearch::Children orChildren = { new TrueSearch(tfmd), new TrueSearch(tfmd) };
+        const SearchIterator * const * orStorage = orChildren.data();
+        SearchIterator::UP orSearch(OrSearch::create(std::move(orChildren), strict));
+        EXPECT_EQUAL(orStorage, static_cast<MultiSearch &>(*orSearch).getChildren().data());
+    }
+}
+
 TEST("mutisearch and initRange") {
 }
 
@@ -49,6 +49,8 @@ class Test : public vespalib::TestApp {
     void requireThatIteratorFindsLongPhrase(bool useBlueprint);
     void requireThatStrictIteratorFindsNextMatch(bool useBlueprint);
     void requireThatPhrasesAreUnpacked(bool useBlueprint);
+    void requireThatPhrasesMustMatchWithinOneElement(bool useBlueprint);
+    void requireThatCommonTermsAreNotUnpackedWhenRareTermsDoNotLineUp();
     void requireThatTermsCanBeEvaluatedInPriorityOrder();
     void requireThatBlueprintExposesFieldWithEstimate();
     void requireThatBlueprintForcesPositionDataOnChildren();
@@ -69,12 +71,15 @@ Test::Main()
     TEST_DO(requireThatIteratorFindsLongPhrase(false));
     TEST_DO(requireThatStrictIteratorFindsNextMatch(false));
     TEST_DO(requireThatPhrasesAreUnpacked(false));
+    TEST_DO(requireThatPhrasesMustMatchWithinOneElement(false));
     TEST_DO(requireThatTermsCanBeEvaluatedInPriorityOrder());
+    TEST_DO(requireThatCommonTermsAreNotUnpackedWhenRareTermsDoNotLineUp());
 
     TEST_DO(requireThatIteratorFindsSimplePhrase(true));
     TEST_DO(requireThatIteratorFindsLongPhrase(true));
     TEST_DO(requireThatStrictIteratorFindsNextMatch(true));
     TEST_DO(requireThatPhrasesAreUnpacked(true));
+    TEST_DO(requireThatPhrasesMustMatchWithinOneElement(true));
     TEST_DO(requireThatBlueprintExposesFieldWithEstimate());
     TEST_DO(requireThatBlueprintForcesPositionDataOnChildren());
     TEST_DO(requireThatIteratorHonorsFutureDoom());
@@ -112,6 +117,7 @@ public:
     void setStrict(bool strict) { _strict = strict; }
     void setOrder(const vector<uint32_t> &order) { _order = order; }
     const TermFieldMatchData &tmd() const { return *_md->resolveTermField(phrase_handle); }
+    const TermFieldMatchData &childTmd(uint32_t idx) const { return *_md->resolveTermField(childHandle(idx)); }
 
     PhraseSearchTest &addTerm(const string &term, bool last) {
         return addTerm(term, FakeResult()
@@ -287,6 +293,48 @@ void Test::requireThatPhrasesAreUnpacked(bool useBlueprint) {
     EXPECT_EQUAL(21u, (test.tmd().begin() + 1)->getPosition());
 }
 
+void Test::requireThatPhrasesMustMatchWithinOneElement(bool useBlueprint) {
+    PhraseSearchTest test;
+    test.addTerm("foo", FakeResult()
+                 .doc(doc_match).elem(0).pos(3).pos(20).elem(1).pos(7)
+                 .doc(doc_no_match).elem(0).pos(3).elem(1).pos(7));
+    test.addTerm("bar", FakeResult()
+                 .doc(doc_match).elem(0).pos(9).elem(1).pos(2).pos(8)
+                 .doc(doc_no_match).elem(1).pos(4).pos(9));
+    test.fetchPostings(useBlueprint);
+    unique_ptr<SearchIterator> search(test.createSearch(useBlueprint));
+    EXPECT_TRUE(!search->seek(1u));
+    EXPECT_TRUE(search->seek(doc_match));
+    search->unpack(doc_match);
+    ASSERT_EQUAL(1, std::distance(test.tmd().begin(), test.tmd().end()));
+    EXPECT_EQUAL(1u, test.tmd().begin()->getElementId());
+    EXPECT_EQUAL(7u, test.tmd().begin()->getPosition());
+    EXPECT_TRUE(!search->seek(doc_no_match));
+}
+
+void Test::requireThatCommonTermsAreNotUnpackedWhenRareTermsDoNotLineUp() {
+    PhraseSearchTest test;
+    test.addTerm("foo", FakeResult()
+                 .doc(doc_match).pos(1).pos(11)
+                 .doc(doc_no_match).pos(1).pos(11));
+    test.addTerm("bar", FakeResult()
+                 .doc(doc_match).pos(12)
+                 .doc(doc_no_match).pos(5));
+    test.addTerm("baz", FakeResult()
+                 .doc(doc_match).pos(3).pos(13)
+                 .doc(doc_no_match).pos(3).pos(13));
+    test.setOrder({1, 0, 2});
+
+    test.fetchPostings(false);
+    unique_ptr<SearchIterator> search(test.createSearch(false));
+    EXPECT_TRUE(search->seek(doc_match));
+    EXPECT_EQUAL(doc_match, test.childTmd(2).getDocId());
+    EXPECT_TRUE(!search->seek(doc_no_match));
+    EXPECT_EQUAL(doc_no_match, test.childTmd(1).getDocId());
+    EXPECT_EQUAL(doc_no_match, test.childTmd(0).getDocId());
+    EXPECT_EQUAL(doc_match, test.childTmd(2).getDocId());
+}
+
 void Test::requireThatTermsCanBeEvaluatedInPriorityOrder() {
     vector<uint32_t> order;
     order.push_back(2);
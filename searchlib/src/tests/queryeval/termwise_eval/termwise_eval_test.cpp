@@ -260,6 +260,34 @@ TEST("require that termwise filter search produces appropriate results") {
     }
 }
 
+TEST("require that termwise search evaluated in small blocks produces appropriate results") {
+    for (uint32_t block_size: {1, 2, 3, 64}) {
+        for (uint32_t begin: {1, 2, 5}) {
+            for (uint32_t end: {6, 7, 10}) {
+                for (bool strict_search: {true, false}) {
+                    for (bool strict_wrapper: {true, false}) {
+                        TEST_STATE(make_string("block_size: %u, begin: %u, end: %u, strict_search: %s, strict_wrapper: %s",
+                                        block_size, begin, end, strict_search ? "true" : "false",
+                                        strict_wrapper ? "true" : "false").c_str());
+                        auto search = make_termwise(make_search(strict_search), strict_wrapper, block_size);
+                        TEST_DO(verify(make_expect(begin, end), *search, begin, end));
+                        auto filter = make_termwise(make_filter_search(strict_search), strict_wrapper, block_size);
+                        TEST_DO(verify(make_expect(begin, end), *filter, begin, end));
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST("require that strict termwise search skips blocks without hits") {
+    auto search = make_termwise(UP(OR({TERM({2}, true), TERM({9}, true)}, true)), true, 2);
+    TEST_DO(verify({2,9}, *search, 1, 10));
+    search->initRange(3, 10);
+    EXPECT_TRUE(search->seek(3) == false);
+    EXPECT_EQUAL(9u, search->getDocId());
+}
+
 TEST("require that termwise ANDNOT with single term works") {
     TEST_DO(verify({2,3,4}, *make_termwise(UP(ANDNOT({TERM({1,2,3,4,5}, true)}, true)), true), 2, 5));
 }
@@ -276,6 +304,13 @@ TEST("require that termwise wrapper is rewindable") {
     TEST_DO(verify(make_expect(1, 5), *search, 1, 5));
 }
 
+TEST("require that termwise wrapper evaluated in blocks is rewindable") {
+    auto search = make_termwise(make_search(true), true, 2);
+    TEST_DO(verify(make_expect(3, 7), *search, 3, 7));
+    TEST_DO(verify(make_expect(1, 5), *search, 1, 5));
+    TEST_DO(verify(make_expect(3, 7), *search, 3, 7));
+}
+
 //-----------------------------------------------------------------------------
 
 TEST("require that leaf blueprints allow termwise evaluation by default") {
@@ -629,9 +664,11 @@ TEST("require that termwise blueprint helper calculates unpack info correctly")
 }
 
 class Verifier : public search::test::SearchIteratorVerifier {
+    uint32_t _block_size;
 public:
+    Verifier(uint32_t block_size = termwise_default_block_size) : _block_size(block_size) {}
     SearchIterator::UP create(bool strict) const override {
-        return make_termwise(createIterator(getExpectedDocIds(), strict), strict);
+        return make_termwise(createIterator(getExpectedDocIds(), strict), strict, _block_size);
     }
 };
 TEST("test terwise adheres to search iterator requirements.") {
@@ -639,6 +676,11 @@ TEST("test terwise adheres to search iterator requirements.") {
     verifier.verify();
 }
 
+TEST("test terwise evaluated in blocks adheres to search iterator requirements.") {
+    Verifier verifier(7);
+    verifier.verify();
+}
+
 //-----------------------------------------------------------------------------
 
 TEST_MAIN() { TEST_RUN_ALL(); }
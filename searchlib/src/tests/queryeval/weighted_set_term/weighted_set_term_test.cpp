@@ -215,6 +215,66 @@ TEST("verify search iterator conformance with document weight iterator children"
     verifier.verify();
 }
 
+struct MixedPostingsFixture {
+    DocumentWeightAttributeHelper helper;
+    std::vector<int32_t> weights;
+    MixedPostingsFixture() : helper(), weights() {
+        helper.add_docs(1000);
+        // keys 0-9 get short posting lists, key 100 gets a long one
+        for (uint32_t docid = 1; docid < 1000; ++docid) {
+            helper.set_doc(docid, (docid % 10 == 0) ? (docid / 100) : 100, 1);
+        }
+    }
+    SearchIterator::UP create(TermFieldMatchData &tfmd) {
+        std::vector<DocumentWeightIterator> children;
+        weights.clear();
+        for (int key : {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 100}) {
+            auto dict_entry = helper.dwa().lookup(vespalib::make_string("%d", key));
+            helper.dwa().create(dict_entry.posting_idx, children);
+            weights.push_back((key == 100) ? 5 : (10 + key));
+        }
+        return WeightedSetTermSearch::create(tfmd, weights, std::move(children));
+    }
+    static int32_t expected_weight(uint32_t docid) {
+        return (docid % 10 == 0) ? (10 + (docid / 100)) : 5;
+    }
+};
+
+TEST_F("require that short and long posting lists are combined", MixedPostingsFixture) {
+    TermFieldMatchData tfmd;
+    SearchIterator::UP search = f1.create(tfmd);
+    search->initRange(1, 1000);
+    for (uint32_t docid = 1; docid < 1000; ++docid) {
+        EXPECT_TRUE(search->seek(docid));
+        search->unpack(docid);
+        FieldPositionsIterator itr = tfmd.getIterator();
+        ASSERT_TRUE(itr.valid());
+        EXPECT_EQUAL(MixedPostingsFixture::expected_weight(docid), itr.getElementWeight());
+        itr.next();
+        EXPECT_FALSE(itr.valid());
+    }
+    EXPECT_FALSE(search->seek(1000));
+    EXPECT_TRUE(search->isAtEnd());
+}
+
+TEST_F("require that short posting lists are combined when weights are not needed", MixedPostingsFixture) {
+    TermFieldMatchData tfmd;
+    tfmd.tagAsNotNeeded();
+    SearchIterator::UP search = f1.create(tfmd);
+    search->initRange(1, 1000);
+    search->seek(1);
+    uint32_t hits = 0;
+    for (uint32_t docid = search->getDocId(); !search->isAtEnd(); docid = search->getDocId()) {
+        EXPECT_EQUAL(hits + 1, docid);
+        ++hits;
+        search->seek(docid + 1);
+    }
+    EXPECT_EQUAL(999u, hits);
+    search->initRange(1, 1000);
+    BitVector::UP hits_bv = search->get_hits(1);
+    EXPECT_EQUAL(999u, hits_bv->countTrueBits());
+}
+
 struct VerifyMatchData {
     struct MyBlueprint : search::queryeval::SimpleLeafBlueprint {
         VerifyMatchData &vmd;
@@ -505,6 +505,7 @@ void RankSetupTest::testRankSetup()
     env.getProperties().add(matchphase::DiversityMinGroups::NAME, "37");
     env.getProperties().add(matchphase::DiversityCutoffFactor::NAME, "7.1");
     env.getProperties().add(matchphase::DiversityCutoffStrategy::NAME, "strict");
+    env.getProperties().add(matchphase::EarlyTerminationHits::NAME, "25");
     env.getProperties().add(hitcollector::HeapSize::NAME, "50");
     env.getProperties().add(hitcollector::ArraySize::NAME, "60");
     env.getProperties().add(hitcollector::EstimatePoint::NAME, "70");
@@ -530,6 +531,7 @@ void RankSetupTest::testRankSetup()
     EXPECT_EQUAL(rs.getDiversityMinGroups(), 37u);
     EXPECT_EQUAL(rs.getDiversityCutoffFactor(), 7.1);
     EXPECT_EQUAL(rs.getDiversityCutoffStrategy(), "strict");
+    EXPECT_EQUAL(rs.getEarlyTerminationHits(), 25u);
     EXPECT_EQUAL(rs.getHeapSize(), 50u);
     EXPECT_EQUAL(rs.getArraySize(), 60u);
     EXPECT_EQUAL(rs.getEstimatePoint(), 70u);
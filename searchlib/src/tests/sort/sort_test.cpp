@@ -30,6 +30,7 @@ public:
     void testStringCaseInsensitiveSort();
     void testSortSpec();
     void testSameAsJavaOrder();
+    void testCachedSortKeys();
 };
 
 struct LoadedStrings
@@ -275,6 +276,26 @@ void Test::testSameAsJavaOrder()
     }
 }
 
+void Test::testCachedSortKeys()
+{
+    UcaConverterFactory cachingFactory(true);
+    BlobConverter::UP cached = cachingFactory.create("nn_no", "TERTIARY");
+    UcaConverter plain("nn_no", "TERTIARY");
+    UcaSortKeyCache::SP cache = UcaSortKeyCache::get("nn_no", "TERTIARY");
+    ASSERT_TRUE(cache);
+    EXPECT_EQUAL(0u, cache->size());
+    std::vector<vespalib::string> values = { "Ærlig", "aarhus", "Ærlig", "zebra", "aarhus" };
+    for (const vespalib::string & value : values) {
+        ConstBufferRef src(value.c_str(), value.size() + 1);
+        ConstBufferRef expKey = plain.convert(src);
+        vespalib::string exp(expKey.c_str(), expKey.size());
+        ConstBufferRef key = cached->convert(src);
+        EXPECT_EQUAL(exp, vespalib::string(key.c_str(), key.size()));
+    }
+    EXPECT_EQUAL(3u, cache->size());
+    EXPECT_TRUE(cache.get() == UcaSortKeyCache::get("nn_no", "TERTIARY").get());
+    EXPECT_TRUE(cache.get() != UcaSortKeyCache::get("nn_no", "PRIMARY").get());
+}
 
 TEST_APPHOOK(Test);
 
@@ -290,6 +311,7 @@ int Test::Main()
     testSortSpec();
     testIcu();
     testSameAsJavaOrder();
+    testCachedSortKeys();
 
     TEST_DONE();
 }
@@ -69,8 +69,9 @@ private:
     template<typename T, typename V>
     int compareTemplate(T *vector, uint32_t a, uint32_t b);
     int compare(AttributeVector *vector, AttrType type, uint32_t a, uint32_t b);
+    int compareHits(const std::vector<Spec> &spec, VectorMap &vec, const RankedHit &a, const RankedHit &b);
     void sortAndCheck(const std::vector<Spec> &spec, uint32_t num,
-                      uint32_t unique, const std::vector<std::string> &strValues);
+                      uint32_t unique, const std::vector<std::string> &strValues, uint32_t topn = 0);
 public:
     MultilevelSortTest() : _sortMethod(0) { srand(time(NULL)); }
     void testSortMethod(int method);
@@ -192,10 +193,41 @@ MultilevelSortTest::compare(AttributeVector *vector, AttrType type, uint32_t a,
     }
 }
 
+int
+MultilevelSortTest::compareHits(const std::vector<Spec> &spec, VectorMap &vec, const RankedHit &a, const RankedHit &b)
+{
+    for (uint32_t j = 0; j < spec.size(); ++j) {
+        int cmp = 0;
+        if (spec[j]._type == RANK) {
+            if (a._rankValue < b._rankValue) {
+                cmp = -1;
+            } else if (a._rankValue > b._rankValue) {
+                cmp = 1;
+            }
+        } else if (spec[j]._type == DOCID) {
+            if (a._docId < b._docId) {
+                cmp = -1;
+            } else if (a._docId > b._docId) {
+                cmp = 1;
+            }
+        } else {
+            AttributeVector *av = vec[spec[j]._name].get();
+            cmp = compare(av, spec[j]._type, a._docId, b._docId);
+        }
+        if (cmp != 0) {
+            return spec[j]._asc ? cmp : -cmp;
+        }
+    }
+    return 0;
+}
+
 void
 MultilevelSortTest::sortAndCheck(const std::vector<Spec> &spec, uint32_t num,
-                                 uint32_t unique, const std::vector<std::string> &strValues)
+                                 uint32_t unique, const std::vector<std::string> &strValues, uint32_t topn)
 {
+    if (topn == 0) {
+        topn = num;
+    }
     VectorMap vec;
     // generate attribute vectors
     for (uint32_t i = 0; i < spec.size(); ++i) {
@@ -265,46 +297,19 @@ MultilevelSortTest::sortAndCheck(const std::vector<Spec> &spec, uint32_t num,
 
     FastOS_Time timer;
     timer.SetNow();
-    sorter.sortResults(hits, num, num);
+    sorter.sortResults(hits, num, topn);
     LOG(info, "sort time = %f ms", timer.MilliSecsToNow());
 
-    uint32_t *offsets = new uint32_t[num + 1];
-    char *buf = new char[sorter.getSortDataSize(0, num)];
-    sorter.copySortData(0, num, offsets, buf);
+    uint32_t *offsets = new uint32_t[topn + 1];
+    char *buf = new char[sorter.getSortDataSize(0, topn)];
+    sorter.copySortData(0, topn, offsets, buf);
 
     // check results
-    for (uint32_t i = 0; i < num - 1; ++i) {
-        for (uint32_t j = 0; j < spec.size(); ++j) {
-            int cmp = 0;
-            if (spec[j]._type == RANK) {
-                if (hits[i]._rankValue < hits[i+1]._rankValue) {
-                    cmp = -1;
-                } else if (hits[i]._rankValue > hits[i+1]._rankValue) {
-                    cmp = 1;
-                }
-            } else if (spec[j]._type == DOCID) {
-                if (hits[i]._docId < hits[i+1]._docId) {
-                    cmp = -1;
-                } else if (hits[i]._docId > hits[i+1]._docId) {
-                    cmp = 1;
-                }
-            } else {
-                AttributeVector *av = vec[spec[j]._name].get();
-                cmp = compare(av, spec[j]._type,
-                              hits[i]._docId, hits[i+1]._docId);
-            }
-            if (spec[j]._asc) {
-                EXPECT_TRUE(cmp <= 0);
-                if (cmp < 0) {
-                    break;
-                }
-            } else {
-                EXPECT_TRUE(cmp >= 0);
-                if (cmp > 0) {
-                    break;
-                }
-            }
-        }
+    for (uint32_t i = topn; i < num; ++i) {
+        EXPECT_TRUE(compareHits(spec, vec, hits[topn - 1], hits[i]) <= 0);
+    }
+    for (uint32_t i = 0; i < topn - 1; ++i) {
+        EXPECT_TRUE(compareHits(spec, vec, hits[i], hits[i+1]) <= 0);
         // check binary sort data
         uint32_t minLen = std::min(sorter._sortDataArray[i]._len,
                           sorter._sortDataArray[i+1]._len);
@@ -317,9 +322,9 @@ MultilevelSortTest::sortAndCheck(const std::vector<Spec> &spec, uint32_t num,
                      buf + offsets[i], sorter._sortDataArray[i]._len);
         EXPECT_TRUE(cmp == 0);
     }
-    EXPECT_TRUE(sorter._sortDataArray[num-1]._len == (offsets[num] - offsets[num-1]));
-    int cmp = memcmp(&sorter._binarySortData[0] + sorter._sortDataArray[num-1]._idx,
-                 buf + offsets[num-1], sorter._sortDataArray[num-1]._len);
+    EXPECT_TRUE(sorter._sortDataArray[topn-1]._len == (offsets[topn] - offsets[topn-1]));
+    int cmp = memcmp(&sorter._binarySortData[0] + sorter._sortDataArray[topn-1]._idx,
+                 buf + offsets[topn-1], sorter._sortDataArray[topn-1]._len);
     EXPECT_TRUE(cmp == 0);
 
     delete [] hits;
@@ -362,6 +367,22 @@ void MultilevelSortTest::testSortMethod(int method)
         sortAndCheck(spec, 5000, 8, strValues);
         srand(time(NULL));
         sortAndCheck(spec, 5000, 8, strValues);
+
+        // Only the best hits are sorted, after selecting candidates on the first level.
+        srand(13579);
+        sortAndCheck(spec, 5000, 8, strValues, 10);
+        std::vector<Spec> stringFirst(spec.rbegin() + 2, spec.rend());
+        sortAndCheck(stringFirst, 5000, 8, strValues, 10);
+    }
+    {
+        std::vector<std::string> none;
+        uint32_t num = 5000;
+        uint32_t topn = 20;
+        sortAndCheck(std::vector<Spec>(1, Spec("int8", INT8, true)), num, 0, none, topn);
+        sortAndCheck(std::vector<Spec>(1, Spec("int64", INT64, false)), num, 0, none, topn);
+        sortAndCheck(std::vector<Spec>(1, Spec("float", FLOAT, true)), num, 0, none, topn);
+        sortAndCheck(std::vector<Spec>(1, Spec("double", DOUBLE, false)), num, 0, none, topn);
+        sortAndCheck(std::vector<Spec>(1, Spec("rank", RANK, false)), num, 0, none, topn);
     }
     {
         std::vector<std::string> none;
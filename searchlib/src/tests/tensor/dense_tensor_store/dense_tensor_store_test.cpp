@@ -9,6 +9,7 @@ LOG_SETUP("dense_tensor_store_test");
 #include <vespa/eval/tensor/tensor.h>
 #include <vespa/eval/tensor/dense/mutable_dense_tensor_view.h>
 
+using search::attribute::TensorCellType;
 using search::tensor::DenseTensorStore;
 using vespalib::eval::TensorSpec;
 using vespalib::eval::ValueType;
@@ -28,8 +29,9 @@ makeTensor(const TensorSpec &spec)
 struct Fixture
 {
     DenseTensorStore store;
-    Fixture(const vespalib::string &tensorType)
-        : store(ValueType::from_spec(tensorType))
+    Fixture(const vespalib::string &tensorType,
+            TensorCellType cellType = TensorCellType::DOUBLE)
+        : store(ValueType::from_spec(tensorType), cellType)
     {}
     void assertSetAndGetTensor(const TensorSpec &tensorSpec) {
         Tensor::UP expTensor = makeTensor(tensorSpec);
@@ -47,7 +49,8 @@ struct Fixture
     }
     void assertTensorView(EntryRef ref, const Tensor &expTensor) {
         MutableDenseTensorView actTensor(store.type());
-        store.getTensor(ref, actTensor);
+        std::vector<double> decodedCells;
+        store.getTensor(ref, actTensor, decodedCells);
         EXPECT_EQUAL(expTensor.toSpec(), actTensor.toSpec());
     }
 };
@@ -111,5 +114,36 @@ TEST_F("require that empty 3d tensor has size 1 in un-bound dimensions", Fixture
                                    add({{"x", 0}, {"y", 1}, {"z", 0}}, 0));
 }
 
+TEST_F("require that we can store tensor with float cells", Fixture("tensor(x[],y[2])", TensorCellType::FLOAT))
+{
+    EXPECT_EQUAL(4u, f.store.getCellSize());
+    f.assertSetAndGetTensor(TensorSpec("tensor(x[2],y[2])").
+                                       add({{"x", 0}, {"y", 0}}, 2.5).
+                                       add({{"x", 0}, {"y", 1}}, -3).
+                                       add({{"x", 1}, {"y", 0}}, 0.125).
+                                       add({{"x", 1}, {"y", 1}}, 1024));
+}
+
+TEST_F("require that we can store tensor with bfloat16 cells", Fixture("tensor(x[3])", TensorCellType::BFLOAT16))
+{
+    EXPECT_EQUAL(2u, f.store.getCellSize());
+    f.assertSetAndGetTensor(TensorSpec("tensor(x[3])").
+                                       add({{"x", 0}}, 2.5).
+                                       add({{"x", 1}}, -3).
+                                       add({{"x", 2}}, 0.125));
+}
+
+TEST("require that bfloat16 cells are rounded to nearest") {
+    std::vector<double> cells({1.0 + 1.0 / 256, 1.0 + 1.0 / 64, 1.0 + 3.0 / 256, 1.0 / 3});
+    std::vector<uint16_t> encoded(cells.size());
+    std::vector<double> decoded(cells.size());
+    DenseTensorStore::encodeCells(TensorCellType::BFLOAT16, &cells[0], cells.size(), &encoded[0]);
+    DenseTensorStore::decodeCells(TensorCellType::BFLOAT16, &encoded[0], cells.size(), &decoded[0]);
+    EXPECT_EQUAL(1.0, decoded[0]);
+    EXPECT_EQUAL(1.0 + 1.0 / 64, decoded[1]);
+    EXPECT_EQUAL(1.0 + 1.0 / 64, decoded[2]);
+    EXPECT_APPROX(1.0 / 3, decoded[3], 1.0 / 256);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
 
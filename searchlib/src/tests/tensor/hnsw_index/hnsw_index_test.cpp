@@ -0,0 +1,232 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/log/log.h>
+LOG_SETUP("hnsw_index_test");
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/test/insertion_operators.h>
+#include <vespa/searchlib/tensor/hnsw_index.h>
+#include <vespa/vespalib/util/generationhandler.h>
+#include <algorithm>
+#include <random>
+
+using search::attribute::HnswIndexParams;
+using search::tensor::DocVectorAccess;
+using search::tensor::HnswIndex;
+using vespalib::GenerationHandler;
+using vespalib::GenerationHolder;
+
+using Neighbor = HnswIndex::Neighbor;
+using CellsRef = vespalib::ConstArrayRef<double>;
+
+class MyDocVectorAccess : public DocVectorAccess
+{
+    std::vector<std::vector<double>> _vectors;
+public:
+    MyDocVectorAccess() : _vectors() {}
+    void set(uint32_t docId, std::vector<double> vector) {
+        if (docId >= _vectors.size()) {
+            _vectors.resize(docId + 1);
+        }
+        _vectors[docId] = std::move(vector);
+    }
+    void clear(uint32_t docId) { set(docId, std::vector<double>()); }
+    CellsRef getVector(uint32_t docId, std::vector<double> &decodedCells) const override {
+        (void) decodedCells;
+        if (docId >= _vectors.size()) {
+            return CellsRef();
+        }
+        return CellsRef(_vectors[docId]);
+    }
+};
+
+struct Fixture
+{
+    MyDocVectorAccess vectors;
+    GenerationHandler genHandler;
+    GenerationHolder genHolder;
+    HnswIndex index;
+    Fixture(uint32_t maxLinksPerNode = 4, uint32_t neighborsToExploreAtInsert = 20)
+        : vectors(),
+          genHandler(),
+          genHolder(),
+          index(vectors, HnswIndexParams(true, maxLinksPerNode, neighborsToExploreAtInsert), genHolder)
+    {
+    }
+    ~Fixture() {
+        genHolder.clearHoldLists();
+    }
+    void add(uint32_t docId, std::vector<double> vector) {
+        vectors.set(docId, std::move(vector));
+        index.addDocument(docId);
+        commit();
+    }
+    void remove(uint32_t docId) {
+        index.removeDocument(docId);
+        vectors.clear(docId);
+        commit();
+    }
+    void commit() {
+        index.transferHoldLists(genHandler.getCurrentGeneration());
+        genHolder.transferHoldLists(genHandler.getCurrentGeneration());
+        genHandler.incGeneration();
+        genHandler.updateFirstUsedGeneration();
+        index.trimHoldLists(genHandler.getFirstUsedGeneration());
+        genHolder.trimHoldLists(genHandler.getFirstUsedGeneration());
+    }
+    std::vector<uint32_t> topK(uint32_t k, std::vector<double> vector, uint32_t exploreK = 100) {
+        std::vector<uint32_t> result;
+        for (const auto &hit : index.findTopK(k, CellsRef(vector), exploreK)) {
+            result.push_back(hit.docId);
+        }
+        return result;
+    }
+};
+
+using DocIds = std::vector<uint32_t>;
+
+TEST_F("require that empty index has no hits", Fixture)
+{
+    EXPECT_EQUAL(-1, f.index.getEntryLevel());
+    EXPECT_EQUAL(DocIds(), f.topK(3, {0.0, 0.0}));
+}
+
+TEST_F("require that nearest neighbors are found in order of distance", Fixture)
+{
+    f.add(1, {0.0, 0.0});
+    f.add(2, {1.0, 0.0});
+    f.add(3, {2.0, 0.0});
+    f.add(4, {3.0, 0.0});
+    f.add(5, {4.0, 0.0});
+    EXPECT_EQUAL(DocIds({3, 4, 2}), f.topK(3, {2.1, 0.0}));
+    EXPECT_EQUAL(DocIds({1}), f.topK(1, {-5.0, 0.0}));
+    EXPECT_EQUAL(DocIds({5, 4, 3, 2, 1}), f.topK(10, {10.0, 0.0}));
+    auto hits = f.index.findTopK(1, CellsRef(std::vector<double>({4.0, 2.0})), 10);
+    ASSERT_EQUAL(1u, hits.size());
+    EXPECT_EQUAL(4.0, hits[0].distance);
+}
+
+TEST_F("require that documents without vector are not added", Fixture)
+{
+    f.index.addDocument(7);
+    EXPECT_FALSE(f.index.hasDocument(7));
+    EXPECT_EQUAL(-1, f.index.getEntryLevel());
+}
+
+TEST_F("require that removed documents are not returned", Fixture)
+{
+    f.add(1, {0.0, 0.0});
+    f.add(2, {1.0, 0.0});
+    f.add(3, {2.0, 0.0});
+    f.remove(2);
+    EXPECT_FALSE(f.index.hasDocument(2));
+    EXPECT_EQUAL(DocIds({1, 3}), f.topK(3, {0.9, 0.0}));
+    f.remove(1);
+    f.remove(3);
+    EXPECT_EQUAL(-1, f.index.getEntryLevel());
+    EXPECT_EQUAL(DocIds(), f.topK(3, {0.9, 0.0}));
+    f.add(4, {5.0, 5.0});
+    EXPECT_EQUAL(4u, f.index.getEntryDocId());
+    EXPECT_EQUAL(DocIds({4}), f.topK(3, {0.9, 0.0}));
+}
+
+TEST_F("require that links are bounded and point to present documents", Fixture(2, 10))
+{
+    std::minstd_rand rnd(42);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    for (uint32_t docId = 1; docId <= 200; ++docId) {
+        f.add(docId, {dist(rnd), dist(rnd)});
+    }
+    for (uint32_t docId = 1; docId <= 200; docId += 3) {
+        f.remove(docId);
+    }
+    for (uint32_t docId = 1; docId <= 200; ++docId) {
+        if (!f.index.hasDocument(docId)) {
+            continue;
+        }
+        for (uint32_t level = 0; level < f.index.getNumLevels(docId); ++level) {
+            auto links = f.index.getLinksForTest(docId, level);
+            EXPECT_LESS_EQUAL(links.size(), (level == 0) ? 4u : 2u);
+            for (uint32_t link : links) {
+                EXPECT_TRUE(f.index.hasDocument(link));
+                EXPECT_NOT_EQUAL(docId, link);
+            }
+        }
+    }
+    EXPECT_TRUE(f.index.hasDocument(f.index.getEntryDocId()));
+    EXPECT_EQUAL(int32_t(f.index.getNumLevels(f.index.getEntryDocId())) - 1, f.index.getEntryLevel());
+}
+
+TEST_F("require that compaction frees dead link and level arrays and keeps the graph", Fixture(4, 20))
+{
+    std::minstd_rand rnd(7);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    for (uint32_t docId = 1; docId <= 300; ++docId) {
+        f.add(docId, {dist(rnd), dist(rnd)});
+    }
+    for (uint32_t docId = 1; docId <= 300; ++docId) {
+        if ((docId % 3) != 0) {
+            f.remove(docId);
+        }
+    }
+    std::vector<std::vector<double>> queries;
+    std::vector<DocIds> expHits;
+    for (uint32_t q = 0; q < 10; ++q) {
+        queries.push_back({dist(rnd), dist(rnd)});
+        expHits.push_back(f.topK(5, queries.back()));
+    }
+    size_t deadBefore = f.index.getMemoryUsage().deadBytes();
+    for (uint32_t i = 0; i < 10; ++i) {
+        f.index.compactWorst();
+        f.commit();
+    }
+    EXPECT_LESS(f.index.getMemoryUsage().deadBytes(), deadBefore);
+    for (uint32_t q = 0; q < queries.size(); ++q) {
+        EXPECT_EQUAL(expHits[q], f.topK(5, queries[q]));
+    }
+    for (uint32_t docId = 3; docId <= 300; docId += 3) {
+        EXPECT_TRUE(f.index.hasDocument(docId));
+        for (uint32_t level = 0; level < f.index.getNumLevels(docId); ++level) {
+            for (uint32_t link : f.index.getLinksForTest(docId, level)) {
+                EXPECT_TRUE(f.index.hasDocument(link));
+            }
+        }
+    }
+}
+
+TEST_F("require that recall is good compared to exact search", Fixture(16, 100))
+{
+    std::minstd_rand rnd(17);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<std::vector<double>> docs;
+    for (uint32_t docId = 0; docId < 2000; ++docId) {
+        docs.push_back({dist(rnd), dist(rnd), dist(rnd), dist(rnd)});
+        f.add(docId, docs.back());
+    }
+    uint32_t k = 10;
+    uint32_t found = 0;
+    uint32_t numQueries = 50;
+    for (uint32_t q = 0; q < numQueries; ++q) {
+        std::vector<double> query({dist(rnd), dist(rnd), dist(rnd), dist(rnd)});
+        std::vector<Neighbor> exact;
+        for (uint32_t docId = 0; docId < docs.size(); ++docId) {
+            double sum = 0.0;
+            for (size_t i = 0; i < query.size(); ++i) {
+                sum += (docs[docId][i] - query[i]) * (docs[docId][i] - query[i]);
+            }
+            exact.emplace_back(docId, sum);
+        }
+        std::sort(exact.begin(), exact.end(),
+                  [](const Neighbor &lhs, const Neighbor &rhs) { return lhs.distance < rhs.distance; });
+        DocIds approx = f.topK(k, query, 50);
+        EXPECT_EQUAL(k, approx.size());
+        for (uint32_t i = 0; i < k; ++i) {
+            if (std::find(approx.begin(), approx.end(), exact[i].docId) != approx.end()) {
+                ++found;
+            }
+        }
+    }
+    double recall = double(found) / (k * numQueries);
+    LOG(info, "recall@%u = %f", k, recall);
+    EXPECT_GREATER(recall, 0.95);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -15,6 +15,7 @@ using namespace transactionlog;
 using namespace document;
 using namespace vespalib;
 using search::index::DummyFileHeaderContext;
+using vespalib::compression::CompressionConfig;
 
 vespalib::string myhex(const void * b, size_t sz)
 {
@@ -54,6 +55,8 @@ private:
     void testSync();
     void testTruncateOnShortRead();
     void testTruncateOnVersionMismatch();
+    void testCompressedEntries();
+    void testVisitUsingMmap();
 };
 
 TEST_APPHOOK(Test);
@@ -651,6 +654,83 @@ void Test::testMany()
     }
 }
 
+void Test::testCompressedEntries()
+{
+    const unsigned int NUM_PACKETS = 100;
+    const unsigned int NUM_ENTRIES = 100;
+    const unsigned int TOTAL_NUM_ENTRIES = NUM_PACKETS * NUM_ENTRIES;
+    {
+        DummyFileHeaderContext fileHeaderContext;
+        TransLogServer tlss("test14", 18377, ".", fileHeaderContext, 0x8000, 4, DomainPart::xxh64,
+                            CompressionConfig(CompressionConfig::LZ4, 0, 100));
+        TransLogClient tls("tcp/localhost:18377");
+
+        createDomainTest(tls, "compressed", 0);
+        TransLogClient::Session::UP s1 = openDomainTest(tls, "compressed");
+        fillDomainTest(s1.get(), NUM_PACKETS, NUM_ENTRIES);
+        TEST_DO(assertStatus(*s1, 1u, TOTAL_NUM_ENTRIES, TOTAL_NUM_ENTRIES));
+        CallBackManyTest ca(2);
+        TransLogClient::Visitor::UP visitor = tls.createVisitor("compressed", ca);
+        ASSERT_TRUE(visitor.get());
+        ASSERT_TRUE( visitor->visit(2, TOTAL_NUM_ENTRIES) );
+        for (size_t i(0); ! ca._eof && (i < 60000); i++ ) { FastOS_Thread::Sleep(10); }
+        ASSERT_TRUE( ca._eof );
+        EXPECT_EQUAL(ca._count, TOTAL_NUM_ENTRIES);
+        EXPECT_EQUAL(ca._value, TOTAL_NUM_ENTRIES);
+
+        createDomainTest(tls, "zeros", 1);
+        TransLogClient::Session::UP s2 = openDomainTest(tls, "zeros");
+        fillDomainTest(s2.get(), 10, 10, 4096);
+        DomainInfo info = tlss.getDomainStats()["zeros"];
+        EXPECT_GREATER(info.uncompressedByteSize, 10 * info.byteSize);
+    }
+    {
+        // Compression is recorded per file, so the log can be replayed without it configured.
+        DummyFileHeaderContext fileHeaderContext;
+        TransLogServer tlss("test14", 18377, ".", fileHeaderContext, 0x1000000);
+        TransLogClient tls("tcp/localhost:18377");
+
+        TransLogClient::Session::UP s1 = openDomainTest(tls, "compressed");
+        TEST_DO(assertStatus(*s1, 1u, TOTAL_NUM_ENTRIES, TOTAL_NUM_ENTRIES));
+        CallBackManyTest ca(2);
+        TransLogClient::Visitor::UP visitor = tls.createVisitor("compressed", ca);
+        ASSERT_TRUE(visitor.get());
+        ASSERT_TRUE( visitor->visit(2, TOTAL_NUM_ENTRIES) );
+        for (size_t i(0); ! ca._eof && (i < 60000); i++ ) { FastOS_Thread::Sleep(10); }
+        ASSERT_TRUE( ca._eof );
+        EXPECT_EQUAL(ca._count, TOTAL_NUM_ENTRIES);
+        EXPECT_EQUAL(ca._value, TOTAL_NUM_ENTRIES);
+        TEST_DO(assertVisitStats(tls, "zeros", 0, 100, 1, 100, 100, 100));
+        DomainInfo info = tlss.getDomainStats()["zeros"];
+        EXPECT_GREATER(info.uncompressedByteSize, 10 * info.byteSize);
+    }
+}
+
+void Test::testVisitUsingMmap()
+{
+    const unsigned int NUM_PACKETS = 1000;
+    const unsigned int NUM_ENTRIES = 100;
+    const unsigned int TOTAL_NUM_ENTRIES = NUM_PACKETS * NUM_ENTRIES;
+    DummyFileHeaderContext fileHeaderContext;
+    TransLogServer tlss("test15", 18377, ".", fileHeaderContext, 0x80000, 4, DomainPart::xxh64,
+                        CompressionConfig(), true);
+    TransLogClient tls("tcp/localhost:18377");
+
+    createDomainTest(tls, "mmap", 0);
+    TransLogClient::Session::UP s1 = openDomainTest(tls, "mmap");
+    fillDomainTest(s1.get(), NUM_PACKETS, NUM_ENTRIES);
+    EXPECT_GREATER(countFiles("test15/mmap"), 2u);
+    CallBackManyTest ca(2);
+    TransLogClient::Visitor::UP visitor = tls.createVisitor("mmap", ca);
+    ASSERT_TRUE(visitor.get());
+    ASSERT_TRUE( visitor->visit(2, TOTAL_NUM_ENTRIES) );
+    for (size_t i(0); ! ca._eof && (i < 60000); i++ ) { FastOS_Thread::Sleep(10); }
+    ASSERT_TRUE( ca._eof );
+    EXPECT_EQUAL(ca._count, TOTAL_NUM_ENTRIES);
+    EXPECT_EQUAL(ca._value, TOTAL_NUM_ENTRIES);
+    TEST_DO(assertVisitStats(tls, "mmap", 0, TOTAL_NUM_ENTRIES, 1, TOTAL_NUM_ENTRIES, TOTAL_NUM_ENTRIES, TOTAL_NUM_ENTRIES));
+}
+
 void Test::testErase()
 {
     const unsigned int NUM_PACKETS = 1000;
@@ -893,6 +973,9 @@ int Test::Main()
     testTruncateOnVersionMismatch();
 
     testCrcVersions();
-    
+
+    testCompressedEntries();
+    testVisitUsingMmap();
+
     TEST_DONE();
 }
@@ -0,0 +1,69 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/searchlib/util/foldedstringcompare.h>
+
+using search::FoldedStringCompare;
+
+namespace {
+
+int sign(int value) { return (value > 0) - (value < 0); }
+
+int compareFolded(const char *key, const char *okey) {
+    return sign(FoldedStringCompare().compareFolded(key, okey));
+}
+
+int compareFoldedPrefix(const char *key, const char *okey, size_t prefixLen) {
+    return sign(FoldedStringCompare().compareFoldedPrefix(key, okey, prefixLen));
+}
+
+int compare(const char *key, const char *okey) {
+    return sign(FoldedStringCompare().compare(key, okey));
+}
+
+}
+
+TEST("require that ascii strings are compared case insensitive") {
+    EXPECT_EQUAL(0, compareFolded("", ""));
+    EXPECT_EQUAL(0, compareFolded("abc", "abc"));
+    EXPECT_EQUAL(0, compareFolded("aBc", "AbC"));
+    EXPECT_EQUAL(-1, compareFolded("abc", "abd"));
+    EXPECT_EQUAL(1, compareFolded("ABD", "abc"));
+    EXPECT_EQUAL(-1, compareFolded("ab", "abc"));
+    EXPECT_EQUAL(1, compareFolded("abc", "AB"));
+    EXPECT_EQUAL(-1, compareFolded("", "a"));
+    // '_' sorts between upper and lower case letters, folding must be done before comparing
+    EXPECT_EQUAL(-1, compareFolded("_", "A"));
+    EXPECT_EQUAL(-1, compareFolded("_", "a"));
+}
+
+TEST("require that strings with non-ascii characters are compared case insensitive") {
+    EXPECT_EQUAL(0, compareFolded("h\xc3\xa5kon", "H\xc3\x85KON"));
+    EXPECT_EQUAL(0, compareFolded("\xc3\x85", "\xc3\xa5"));
+    EXPECT_EQUAL(-1, compareFolded("hakon", "h\xc3\xa5kon"));
+    EXPECT_EQUAL(1, compareFolded("h\xc3\xa5kon", "hakon"));
+    EXPECT_EQUAL(-1, compareFolded("h\xc3\xa5kon", "h\xc3\xa5kons"));
+    EXPECT_EQUAL(1, compareFolded("h\xc3\xa5kon", "h\xc3\xa5"));
+    // U+00E5 (lowercase a with ring) sorts after all ascii characters
+    EXPECT_EQUAL(1, compareFolded("\xc3\xa5", "z"));
+    EXPECT_EQUAL(-1, compareFolded("z", "\xc3\x85"));
+}
+
+TEST("require that prefix compare only looks at the given number of characters") {
+    EXPECT_EQUAL(0, compareFoldedPrefix("abcdef", "ABCxyz", 3));
+    EXPECT_EQUAL(-1, compareFoldedPrefix("abcdef", "ABCxyz", 4));
+    EXPECT_EQUAL(0, compareFoldedPrefix("ab", "AB", 5));
+    EXPECT_EQUAL(-1, compareFoldedPrefix("ab", "ABC", 5));
+    EXPECT_EQUAL(0, compareFoldedPrefix("h\xc3\xa5kon", "H\xc3\x85Kxx", 3));
+    EXPECT_EQUAL(-1, compareFoldedPrefix("h\xc3\xa5kon", "H\xc3\x85Kxx", 4));
+    EXPECT_EQUAL(0, compareFoldedPrefix("abc", "xyz", 0));
+}
+
+TEST("require that compare falls back to case sensitive compare for folded equal strings") {
+    EXPECT_EQUAL(0, compare("abc", "abc"));
+    EXPECT_EQUAL(-1, compare("ABC", "abc"));
+    EXPECT_EQUAL(1, compare("abc", "ABC"));
+    EXPECT_EQUAL(-1, compare("abc", "ABD"));
+    EXPECT_EQUAL(-1, compare("H\xc3\x85KON", "h\xc3\xa5kon"));
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -36,6 +36,7 @@ IMPLEMENT_AGGREGATIONRESULT(AverageAggregationResult, AggregationResult);
 IMPLEMENT_AGGREGATIONRESULT(XorAggregationResult,     AggregationResult);
 IMPLEMENT_AGGREGATIONRESULT(ExpressionCountAggregationResult, AggregationResult);
 IMPLEMENT_AGGREGATIONRESULT(StandardDeviationAggregationResult, AggregationResult);
+IMPLEMENT_AGGREGATIONRESULT(QuantileAggregationResult, AggregationResult);
 
 AggregationResult::AggregationResult() :
     _expressionTree(new ExpressionTree()),
@@ -576,6 +577,66 @@ void StandardDeviationAggregationResult::visitMembers(vespalib::ObjectVisitor &v
     visit(visitor, "sumOfSquared", _sumOfSquared);
 }
 
+QuantileAggregationResult::QuantileAggregationResult()
+    : AggregationResult(), _quantile(0.5), _digest(), _rank()
+{ }
+
+QuantileAggregationResult::~QuantileAggregationResult() {}
+
+const ResultNode &
+QuantileAggregationResult::onGetRank() const
+{
+    _digest.compress();
+    _rank.set(_digest.quantile(_quantile));
+    return _rank;
+}
+
+void QuantileAggregationResult::onMerge(const AggregationResult &r) {
+    const QuantileAggregationResult &result =
+            Identifiable::cast<const QuantileAggregationResult &>(r);
+    _digest.merge(result._digest);
+}
+
+void QuantileAggregationResult::onAggregate(const ResultNode &result) {
+    if (result.isMultiValue()) {
+        const ResultNodeVector &v = static_cast<const ResultNodeVector &>(result);
+        for (size_t i(0), m(v.size()); i < m; i++) {
+            _digest.add(v.get(i).getFloat());
+        }
+    } else {
+        _digest.add(result.getFloat());
+    }
+}
+
+void QuantileAggregationResult::onReset()
+{
+    _digest = TDigest(_digest.getCompression());
+}
+
+Serializer & QuantileAggregationResult::onSerialize(Serializer & os) const
+{
+    AggregationResult::onSerialize(os);
+    os << _quantile;
+    _digest.serialize(os);
+    return os;
+}
+
+Deserializer & QuantileAggregationResult::onDeserialize(Deserializer & is)
+{
+    AggregationResult::onDeserialize(is);
+    is >> _quantile;
+    _digest.deserialize(is);
+    return is;
+}
+
+void QuantileAggregationResult::visitMembers(vespalib::ObjectVisitor &visitor) const
+{
+    AggregationResult::visitMembers(visitor);
+    visit(visitor, "quantile", _quantile);
+    visit(visitor, "count", _digest.getTotalWeight());
+    visit(visitor, "estimate", onGetRank().getFloat());
+}
+
 }
 
 // this function was added by ../../forcelink.sh
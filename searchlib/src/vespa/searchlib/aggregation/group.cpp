@@ -420,6 +420,22 @@ Group::Value::merge(const std::vector<GroupingLevel> &levels,
     _childInfo._allChildren = 0;
 }
 
+void
+Group::Value::partitionChildren(std::vector<Group> & partitions)
+{
+    assert((_childInfo._childMap != NULL) || (_childInfo._allChildren <= getChildrenSize()));
+    for (ChildP *it(_children), *mt(_children + getChildrenSize()); it != mt; ++it) {
+        partitions[(*it)->getId().hash() % partitions.size()]._aggr.addChild(*it);
+        reset(*it);
+    }
+    delete [] _children;
+    _children = NULL;
+    setChildrenSize(0);
+    if (_childInfo._childMap != NULL) {
+        _childInfo._childMap->clear();
+    }
+}
+
 void
 Group::Value::prune(const Value & b, uint32_t lastLevel, uint32_t currentLevel) {
     GroupList keep = new ChildP[b.getChildrenSize()];
@@ -100,6 +100,7 @@ private:
         void mergePartial(const GroupingLevelList &levels, uint32_t firstLevel, uint32_t lastLevel,
                           uint32_t currentLevel, const Value & b);
         void merge(const GroupingLevelList & levels, uint32_t firstLevel, uint32_t currentLevel, const Value & rhs);
+        void partitionChildren(std::vector<Group> & partitions);
         void prune(const Value & b, uint32_t lastLevel, uint32_t currentLevel);
         void postMerge(const std::vector<GroupingLevel> &levels, uint32_t firstLevel, uint32_t currentLevel);
         void partialCopy(const Value & rhs);
@@ -254,6 +255,22 @@ public:
     void collect(const Doc & docId, HitRank rank) { _aggr.collect(docId, rank); }
     void postAggregate() { _aggr.postAggregate(); }
     void merge(const std::vector<GroupingLevel> &levels, uint32_t firstLevel, uint32_t currentLevel, Group &b);
+
+    /**
+     * Merge the children of another tree into the children of this group,
+     * leaving the results collected by this group untouched. The children
+     * of both groups must be sorted by id.
+     **/
+    void mergeChildren(const std::vector<GroupingLevel> &levels, uint32_t firstLevel, uint32_t currentLevel, Group &b) {
+        _aggr.merge(levels, firstLevel, currentLevel, b._aggr);
+    }
+
+    /**
+     * Move the children of this group into the given groups, picking the
+     * partition from the hash of the child id. Can be used during
+     * aggregation, in which case new children can be added afterwards.
+     **/
+    void partitionChildren(std::vector<Group> & partitions) { _aggr.partitionChildren(partitions); }
     void executeOrderBy() { _aggr.executeOrderBy(); }
     void sortById() { _aggr.sortById(); }
 
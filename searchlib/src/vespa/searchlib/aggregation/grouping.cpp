@@ -116,7 +116,11 @@ Grouping::Grouping()
       _levels(),
       _root(),
       _clock(NULL),
-      _timeOfDoom(0)
+      _timeOfDoom(0),
+      _maxInMemoryGroups(0),
+      _spillPartitions(0),
+      _spillDir(),
+      _spiller()
 {
 }
 
@@ -167,6 +171,13 @@ Grouping::preAggregate(bool isOrdered)
         _levels[i].prepare(this, i, isOrdered);
     }
     _root.preAggregate();
+    _spiller.reset();
+    // No need to spill if the first level is frozen or capped below the limit.
+    if ((_maxInMemoryGroups > 0) && !_levels.empty() && (_firstLevel == 0) &&
+        _levels[0].allowMoreGroups(_maxInMemoryGroups))
+    {
+        _spiller = std::make_shared<GroupSpiller>(_spillPartitions, _spillDir);
+    }
 }
 
 void Grouping::aggregate(DocId from, DocId to)
@@ -268,11 +279,13 @@ void Grouping::aggregate(const RankedHit * rankedHit, unsigned int len, const Bi
 void Grouping::aggregate(DocId docId, HitRank rank)
 {
     _root.aggregate(*this, 0, docId, rank);
+    spillIfNeeded();
 }
 
 void Grouping::aggregate(const document::Document & doc, HitRank rank)
 {
     _root.aggregate(*this, 0, doc, rank);
+    spillIfNeeded();
 }
 
 void Grouping::convertToGlobalId(const search::IDocumentMetaStore &metaStore)
@@ -284,6 +297,12 @@ void Grouping::convertToGlobalId(const search::IDocumentMetaStore &metaStore)
 void Grouping::postAggregate()
 {
     _root.postAggregate();
+    if (_spiller) {
+        if (_spiller->getSpilledGroups() > 0) {
+            _spiller->unspill(_root, _levels, _firstLevel);
+        }
+        _spiller.reset();
+    }
 }
 
 void Grouping::sortById()
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "groupinglevel.h"
+#include "groupspiller.h"
 #include <vespa/searchlib/common/rankedhit.h>
 #include <vespa/vespalib/util/clock.h>
 
@@ -32,10 +33,19 @@ private:
     Group              _root;       // the grouping tree
     const vespalib::Clock *_clock;      // An optional clock to be used for timeout handling.
     fastos::TimeStamp      _timeOfDoom; // Used if clock is specified. This is time when request expires.
+    uint32_t           _maxInMemoryGroups; // Spill top level groups when exceeded, 0 means never spill.
+    uint32_t           _spillPartitions;   // Number of partitions used when spilling.
+    vespalib::string   _spillDir;          // Directory used for spill files.
+    GroupSpiller::SP   _spiller;           // Only present between preAggregate and postAggregate.
 
     bool hasExpired() const { return _clock->getTimeNS() >= _timeOfDoom; }
     void aggregateWithoutClock(const RankedHit * rankedHit, unsigned int len);
     void aggregateWithClock(const RankedHit * rankedHit, unsigned int len);
+    void spillIfNeeded() {
+        if (_spiller && (_root.getChildrenSize() >= _maxInMemoryGroups)) {
+            _spiller->spill(_root);
+        }
+    }
     void postProcess();
 public:
     DECLARE_IDENTIFIABLE_NS2(search, aggregation, Grouping);
@@ -61,6 +71,21 @@ public:
     Grouping &setClock(const vespalib::Clock * clock) { _clock = clock; return *this; }
     Grouping &setTimeOfDoom(fastos::TimeStamp timeOfDoom) { _timeOfDoom = timeOfDoom; return *this; }
 
+    /**
+     * Bound the number of top level groups kept in memory while
+     * aggregating. When the limit is reached the groups are hashed into
+     * partitions and spilled to temporary files in the given directory, to
+     * be merged back one partition at a time by postAggregate. This is a
+     * local setting, it is not serialized. Spilling is only done when the
+     * first level is unfrozen and not already capped below the limit.
+     **/
+    Grouping &setSpill(uint32_t maxInMemoryGroups, uint32_t numPartitions, const vespalib::string &dir) {
+        _maxInMemoryGroups = maxInMemoryGroups;
+        _spillPartitions = numPartitions;
+        _spillDir = dir;
+        return *this;
+    }
+
     unsigned int getId()     const { return _id; }
     bool valid()             const { return _valid; }
     bool getAll()            const { return _all; }
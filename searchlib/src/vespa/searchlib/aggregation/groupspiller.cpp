@@ -0,0 +1,146 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "groupspiller.h"
+#include "groupinglevel.h"
+#include <vespa/vespalib/objects/nboserializer.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <stdexcept>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+namespace search::aggregation {
+
+using vespalib::make_string;
+using vespalib::nbostream;
+using vespalib::NBOSerializer;
+
+GroupSpiller::GroupSpiller(uint32_t numPartitions, const vespalib::string &dir)
+    : _dir(dir),
+      _partitions(std::max(1u, numPartitions)),
+      _spilledGroups(0)
+{
+}
+
+GroupSpiller::~GroupSpiller()
+{
+    for (Partition &partition : _partitions) {
+        if (partition._fd >= 0) {
+            ::close(partition._fd);
+        }
+    }
+}
+
+void
+GroupSpiller::open(Partition &partition)
+{
+    vespalib::string name = _dir + "/groupspill.XXXXXX";
+    std::vector<char> path(name.c_str(), name.c_str() + name.size() + 1);
+    int fd = ::mkstemp(&path[0]);
+    if (fd < 0) {
+        throw std::runtime_error(make_string("Failed creating grouping spill file in '%s': %s",
+                                             _dir.c_str(), strerror(errno)));
+    }
+    // The file is only referenced through the descriptor, and is gone when it is closed.
+    ::unlink(&path[0]);
+    partition._fd = fd;
+    partition._size = 0;
+}
+
+void
+GroupSpiller::append(Partition &partition, const char *buf, size_t sz)
+{
+    if (partition._fd < 0) {
+        open(partition);
+    }
+    while (sz > 0) {
+        ssize_t written = ::pwrite(partition._fd, buf, sz, partition._size);
+        if (written <= 0) {
+            throw std::runtime_error(make_string("Failed writing %zu bytes to grouping spill file: %s",
+                                                 sz, strerror(errno)));
+        }
+        buf += written;
+        sz -= written;
+        partition._size += written;
+    }
+}
+
+void
+GroupSpiller::read(const Partition &partition, uint64_t offset, char *buf, size_t sz) const
+{
+    while (sz > 0) {
+        ssize_t got = ::pread(partition._fd, buf, sz, offset);
+        if (got <= 0) {
+            throw std::runtime_error(make_string("Failed reading %zu bytes from grouping spill file: %s",
+                                                 sz, strerror(errno)));
+        }
+        buf += got;
+        sz -= got;
+        offset += got;
+    }
+}
+
+void
+GroupSpiller::spill(Group &group)
+{
+    std::vector<Group> parts(_partitions.size());
+    group.partitionChildren(parts);
+    for (size_t i(0), m(parts.size()); i < m; i++) {
+        Group & part = parts[i];
+        if (part.getChildrenSize() == 0) {
+            continue;
+        }
+        part.postAggregate();
+        part.sortById();
+        _spilledGroups += part.getChildrenSize();
+        nbostream stream;
+        NBOSerializer serializer(stream);
+        serializer << part;
+        uint32_t chunkSize = stream.size();
+        append(_partitions[i], reinterpret_cast<const char *>(&chunkSize), sizeof(chunkSize));
+        append(_partitions[i], stream.peek(), stream.size());
+    }
+}
+
+void
+GroupSpiller::load(Partition &partition, Group &group, const GroupingLevelList &levels, uint32_t firstLevel)
+{
+    std::vector<char> buf;
+    for (uint64_t offset(0); offset < partition._size; ) {
+        uint32_t chunkSize(0);
+        read(partition, offset, reinterpret_cast<char *>(&chunkSize), sizeof(chunkSize));
+        offset += sizeof(chunkSize);
+        buf.resize(chunkSize);
+        read(partition, offset, &buf[0], chunkSize);
+        offset += chunkSize;
+        nbostream stream(&buf[0], chunkSize);
+        NBOSerializer deserializer(stream);
+        Group chunk;
+        deserializer >> chunk;
+        group.mergeChildren(levels, firstLevel, 0, chunk);
+    }
+    ::close(partition._fd);
+    partition._fd = -1;
+    partition._size = 0;
+}
+
+void
+GroupSpiller::unspill(Group &group, const GroupingLevelList &levels, uint32_t firstLevel)
+{
+    spill(group);
+    Group merged;
+    for (Partition &partition : _partitions) {
+        if (partition._fd < 0) {
+            continue;
+        }
+        Group part;
+        load(partition, part, levels, firstLevel);
+        part.postMerge(levels, firstLevel, 0);
+        part.sortById();
+        merged.mergeChildren(levels, firstLevel, 0, part);
+    }
+    group.mergeChildren(levels, firstLevel, 0, merged);
+}
+
+}
@@ -0,0 +1,70 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "group.h"
+#include <vespa/vespalib/stllike/string.h>
+
+namespace search::aggregation {
+
+/**
+ * Moves the groups below the root of a grouping tree out of memory while
+ * aggregating, so that groupings with a huge number of groups can be
+ * computed within a bounded amount of memory.
+ *
+ * The groups are partitioned on the hash of their id and appended to one
+ * temporary file per partition. When aggregation is done the partitions
+ * are merged one at a time, and each merged partition is pruned to the
+ * max number of groups of the level before the next one is loaded. Since
+ * all occurrences of a group id end up in the same partition, the groups
+ * of a merged partition are complete, and the pruned result is the same
+ * as if all groups had been kept in memory.
+ **/
+class GroupSpiller
+{
+public:
+    using GroupingLevelList = Group::GroupingLevelList;
+    using SP = std::shared_ptr<GroupSpiller>;
+
+    /**
+     * @param numPartitions The number of partitions to hash groups into.
+     * @param dir The directory where the temporary files are created.
+     **/
+    GroupSpiller(uint32_t numPartitions, const vespalib::string &dir);
+    GroupSpiller(const GroupSpiller &) = delete;
+    GroupSpiller & operator = (const GroupSpiller &) = delete;
+    ~GroupSpiller();
+
+    /**
+     * Move all children of the given group to the partition files.
+     **/
+    void spill(Group &group);
+
+    /**
+     * Merge all spilled groups, and the children still in memory, back into
+     * the children of the given group. Each partition is pruned with
+     * postMerge before the next one is merged. The given group must not be
+     * in the aggregation state.
+     **/
+    void unspill(Group &group, const GroupingLevelList &levels, uint32_t firstLevel);
+
+    size_t getSpilledGroups() const { return _spilledGroups; }
+    uint32_t getNumPartitions() const { return _partitions.size(); }
+
+private:
+    struct Partition {
+        int      _fd;
+        uint64_t _size;
+        Partition() : _fd(-1), _size(0) { }
+    };
+
+    void open(Partition &partition);
+    void append(Partition &partition, const char *buf, size_t sz);
+    void read(const Partition &partition, uint64_t offset, char *buf, size_t sz) const;
+    void load(Partition &partition, Group &group, const GroupingLevelList &levels, uint32_t firstLevel);
+
+    vespalib::string       _dir;
+    std::vector<Partition> _partitions;
+    size_t                 _spilledGroups;
+};
+
+}
@@ -0,0 +1,39 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "aggregationresult.h"
+#include <vespa/searchlib/grouping/tdigest.h>
+#include <vespa/searchlib/expression/floatresultnode.h>
+
+namespace search::aggregation {
+
+/**
+ * Estimates quantiles of the observed values of an expression. This
+ * class keeps a mergeable sketch of the values in bounded memory. The
+ * rank of the aggregation result is the estimate of the configured
+ * quantile, other quantiles can be estimated from the same sketch on
+ * the QR server.
+ */
+class QuantileAggregationResult : public AggregationResult
+{
+public:
+    DECLARE_AGGREGATIONRESULT(QuantileAggregationResult);
+    QuantileAggregationResult();
+    ~QuantileAggregationResult();
+
+    QuantileAggregationResult &setQuantile(double quantile) { _quantile = quantile; return *this; }
+    double getQuantile() const { return _quantile; }
+    double estimate(double quantile) const { return _digest.quantile(quantile); }
+    const TDigest &getDigest() const { _digest.compress(); return _digest; }
+
+    void visitMembers(vespalib::ObjectVisitor &visitor) const override;
+private:
+    const ResultNode &onGetRank() const override;
+    void onPrepare(const ResultNode &, bool) override { }
+
+    double                              _quantile;
+    mutable TDigest                     _digest;
+    mutable expression::FloatResultNode _rank;
+};
+
+}
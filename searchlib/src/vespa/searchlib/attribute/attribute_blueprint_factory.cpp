@@ -21,6 +21,8 @@
 #include <vespa/searchlib/queryeval/dot_product_blueprint.h>
 #include <vespa/searchlib/queryeval/wand/parallel_weak_and_blueprint.h>
 #include <vespa/searchlib/queryeval/predicate_blueprint.h>
+#include <vespa/searchlib/queryeval/nearest_neighbor_blueprint.h>
+#include <vespa/searchlib/tensor/dense_tensor_attribute.h>
 #include <vespa/searchlib/queryeval/wand/parallel_weak_and_search.h>
 #include <vespa/searchlib/queryeval/weighted_set_term_search.h>
 #include <vespa/searchlib/queryeval/weighted_set_term_blueprint.h>
@@ -28,6 +30,7 @@
 
 
 #include <vespa/vespalib/util/regexp.h>
+#include <limits>
 #include <sstream>
 
 #include <vespa/log/log.h>
@@ -39,6 +42,7 @@ using search::fef::TermFieldMatchData;
 using search::fef::TermFieldMatchDataArray;
 using search::fef::TermFieldMatchDataPosition;
 using search::query::Location;
+using search::query::NearestNeighborTerm;
 using search::query::LocationTerm;
 using search::query::Node;
 using search::query::NumberTerm;
@@ -58,6 +62,7 @@ using search::queryeval::DotProductBlueprint;
 using search::queryeval::FieldSpec;
 using search::queryeval::FieldSpecBaseList;
 using search::queryeval::IRequestContext;
+using search::queryeval::NearestNeighborBlueprint;
 using search::queryeval::NoUnpack;
 using search::queryeval::OrLikeSearch;
 using search::queryeval::OrSearch;
@@ -233,6 +238,7 @@ public:
         uint32_t estHits = _attribute.getNumDocs();
         HitEstimate estimate(estHits, estHits == 0);
         setEstimate(estimate);
+        set_cost_tier(State::COST_TIER_EXPENSIVE);
     }
 
     const search::common::Location &location() const { return _location; }
@@ -256,9 +262,13 @@ Blueprint::UP make_location_blueprint(const FieldSpec &field, const IAttributeVe
     {
         return Blueprint::UP(new queryeval::EmptyBlueprint(field));
     }
-    ZCurve::RangeVector rangeVector = ZCurve::find_ranges(
-            location.getMinX(), location.getMinY(),
-            location.getMaxX(), location.getMaxY());
+    ZCurve::RangeVector rangeVector = (location.getRadius() != std::numeric_limits<uint32_t>::max())
+        ? ZCurve::find_ranges(location.getMinX(), location.getMinY(),
+                              location.getMaxX(), location.getMaxY(),
+                              location.getX(), location.getY(),
+                              location.getXAspect(), location.getRadius())
+        : ZCurve::find_ranges(location.getMinX(), location.getMinY(),
+                              location.getMaxX(), location.getMaxY());
     LocationPreFilterBlueprint *pre_filter = new LocationPreFilterBlueprint(field, attribute, rangeVector);
     Blueprint::UP pre_filter_bp(pre_filter);
     if (!pre_filter->should_use()) {
@@ -296,8 +306,7 @@ public:
         _terms.reserve(size_hint);
     }
 
-    void addTerm(const vespalib::string &term, int32_t weight) {
-        IDocumentWeightAttribute::LookupResult result = _attr.lookup(term);
+    void addTerm(const IDocumentWeightAttribute::LookupResult &result, int32_t weight) {
         HitEstimate childEst(result.posting_size, (result.posting_size == 0));
         if (!childEst.empty) {
             if (_estimate.empty) {
@@ -362,8 +371,7 @@ public:
         _terms.reserve(size_hint);
     }
 
-    void addTerm(const vespalib::string &term, int32_t weight) {
-        IDocumentWeightAttribute::LookupResult result = _attr.lookup(term);
+    void addTerm(const IDocumentWeightAttribute::LookupResult &result, int32_t weight) {
         HitEstimate childEst(result.posting_size, (result.posting_size == 0));
         if (!childEst.empty) {
             if (_estimate.empty) {
@@ -489,6 +497,20 @@ public:
         }
     }
 
+    void visitNearestNeighbor(NearestNeighborTerm &n) {
+        const tensor::DenseTensorAttribute *attr =
+            dynamic_cast<const tensor::DenseTensorAttribute *>(&_attr);
+        if ((attr == nullptr) || (attr->nearestNeighborIndex() == nullptr)) {
+            LOG(warning, "Trying to apply a NearestNeighborTerm node to an "
+                "attribute without a nearest neighbor index.");
+            setResult(Blueprint::UP(new queryeval::EmptyBlueprint(_field)));
+        } else {
+            setResult(make_UP(new NearestNeighborBlueprint(_field, *attr, n.getTerm(),
+                                                           n.get_target_num_hits(),
+                                                           n.get_explore_additional_hits())));
+        }
+    }
+
     void visit(NumberTerm & n) override { visitTerm(n, true); }
     void visit(LocationTerm &n) override { visitLocation(n); }
     void visit(PrefixTerm & n) override { visitTerm(n); }
@@ -524,15 +546,24 @@ public:
     }
     void visit(PredicateQuery &n) override { visitPredicate(n); }
     void visit(RegExpTerm & n) override { visitTerm(n); }
+    void visit(NearestNeighborTerm &n) override { visitNearestNeighbor(n); }
 
     template <typename WS, typename NODE>
     void createDirectWeightedSet(WS *bp, NODE &n) {
         Blueprint::UP result(bp);
+        std::vector<vespalib::string> terms;
+        std::vector<uint32_t> weights;
+        terms.reserve(n.getChildren().size());
+        weights.reserve(n.getChildren().size());
         for (size_t i = 0; i < n.getChildren().size(); ++i) {
             const search::query::Node &node = *n.getChildren()[i];
-            vespalib::string term = search::queryeval::termAsString(node);
-            uint32_t weight = search::queryeval::getWeightFromNode(node).percent();
-            bp->addTerm(term, weight);
+            terms.push_back(search::queryeval::termAsString(node));
+            weights.push_back(search::queryeval::getWeightFromNode(node).percent());
+        }
+        std::vector<IDocumentWeightAttribute::LookupResult> lookups;
+        _dwa->lookup(terms, lookups);
+        for (size_t i = 0; i < lookups.size(); ++i) {
+            bp->addTerm(lookups[i], weights[i]);
         }
         setResult(std::move(result));
     }
@@ -15,6 +15,7 @@ const vespalib::string createIfNonExistentTag = "collectiontype.createIfNonExist
 const vespalib::string removeIfZeroTag = "collectiontype.removeIfZero";
 const vespalib::string createSerialNumTag = "createSerialNum";
 const vespalib::string tensorTypeTag = "tensortype";
+const vespalib::string tensorCellTypeTag = "tensorcelltype";
 const vespalib::string predicateArityTag = "predicate.arity";
 const vespalib::string predicateLowerBoundTag = "predicate.lower_bound";
 const vespalib::string predicateUpperBoundTag = "predicate.upper_bound";
@@ -26,6 +27,7 @@ AttributeHeader::AttributeHeader()
       _basicType(attribute::BasicType::Type::NONE),
       _collectionType(attribute::CollectionType::Type::SINGLE),
       _tensorType(vespalib::eval::ValueType::error_type()),
+      _tensorCellType(TensorCellType::DOUBLE),
       _enumerated(false),
       _collectionTypeParamsSet(false),
       _predicateParamsSet(false),
@@ -55,6 +57,7 @@ AttributeHeader::AttributeHeader(const vespalib::string &fileName,
       _basicType(basicType),
       _collectionType(collectionType),
       _tensorType(tensorType),
+      _tensorCellType(TensorCellType::DOUBLE),
       _enumerated(enumerated),
       _collectionTypeParamsSet(false),
       _predicateParamsSet(false),
@@ -97,6 +100,9 @@ AttributeHeader::internalExtractTags(const vespalib::GenericHeader &header)
     if (_basicType.type() == BasicType::Type::TENSOR) {
         assert(header.hasTag(tensorTypeTag));
         _tensorType = vespalib::eval::ValueType::from_spec(header.getTag(tensorTypeTag).asString());
+        if (header.hasTag(tensorCellTypeTag)) {
+            _tensorCellType = TensorCellType(header.getTag(tensorCellTypeTag).asString());
+        }
     }
     if (_basicType.type() == BasicType::Type::PREDICATE) {
         if (header.hasTag(predicateArityTag)) {
@@ -147,6 +153,9 @@ AttributeHeader::addTags(vespalib::GenericHeader &header) const
     }
     if (_basicType.type() == attribute::BasicType::Type::TENSOR) {
         header.putTag(Tag(tensorTypeTag, _tensorType.to_spec()));;
+        if (_tensorCellType != TensorCellType::DOUBLE) {
+            header.putTag(Tag(tensorCellTypeTag, _tensorCellType.asString()));
+        }
     }
     if (_basicType.type() == attribute::BasicType::Type::PREDICATE) {
         const auto & params = _predicateParams;
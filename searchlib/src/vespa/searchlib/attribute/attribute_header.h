@@ -6,6 +6,7 @@
 #include <vespa/searchcommon/attribute/basictype.h>
 #include <vespa/searchcommon/attribute/collectiontype.h>
 #include <vespa/searchcommon/attribute/predicate_params.h>
+#include <vespa/searchcommon/attribute/tensor_cell_type.h>
 #include <vespa/eval/eval/value_type.h>
 
 namespace vespalib { class GenericHeader; }
@@ -23,6 +24,7 @@ private:
     BasicType _basicType;
     CollectionType _collectionType;
     vespalib::eval::ValueType _tensorType;
+    TensorCellType _tensorCellType;
     bool        _enumerated;
     bool        _collectionTypeParamsSet;
     bool        _predicateParamsSet;
@@ -55,6 +57,8 @@ public:
     const BasicType & getBasicType() const { return _basicType; }
     const CollectionType &getCollectionType() const { return _collectionType; }
     const vespalib::eval::ValueType &getTensorType() const { return _tensorType; }
+    TensorCellType getTensorCellType() const { return _tensorCellType; }
+    void setTensorCellType(TensorCellType tensorCellType) { _tensorCellType = tensorCellType; }
     bool hasMultiValue() const;
     bool hasWeightedSetType() const;
     uint32_t getNumDocs() const { return _numDocs; }
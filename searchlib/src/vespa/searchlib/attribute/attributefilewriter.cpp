@@ -21,6 +21,10 @@ namespace {
 
 const uint32_t headerAlign = 4096;
 const uint32_t MIN_ALIGNMENT = 4096;
+// Written data is synced and dropped from the page cache in chunks of
+// this size. Attribute files are only read when loading, and keeping
+// them cached would evict pages used for serving queries.
+const uint64_t DROP_FROM_CACHE_CHUNK_SIZE = 64 * 1024 * 1024;
 
 void
 writeDirectIOAligned(FastOS_FileInterface &file, const void *buf,
@@ -52,6 +56,7 @@ updateHeader(const vespalib::string &name, uint64_t fileBitSize)
     h.putTag(Tag("fileBitSize", fileBitSize));
     h.rewriteFile(f);
     f.Sync();
+    f.dropFromCache();
     f.Close();
 }
 
@@ -104,7 +109,8 @@ AttributeFileWriter(const TuneFileAttributes &tuneFileAttributes,
       _fileHeaderContext(fileHeaderContext),
       _header(header),
       _desc(desc),
-      _fileBitSize(0)
+      _fileBitSize(0),
+      _unsyncedBytes(0)
 { }
 
 
@@ -166,6 +172,19 @@ AttributeFileWriter::writeBuf(Buffer buf)
     // TODO: pad to DirectIO boundary when burning bridges
     writeDirectIOAligned(*_file, buf->getData(), bufLen);
     _fileBitSize += bufLen * 8;
+    _unsyncedBytes += bufLen;
+    if (_unsyncedBytes >= DROP_FROM_CACHE_CHUNK_SIZE) {
+        syncAndDropFromCache();
+    }
+}
+
+
+void
+AttributeFileWriter::syncAndDropFromCache()
+{
+    _file->Sync();
+    _file->dropFromCache();
+    _unsyncedBytes = 0;
 }
 
 
@@ -173,7 +192,7 @@ void
 AttributeFileWriter::close()
 {
     if (_file->IsOpened()) {
-        _file->Sync();
+        syncAndDropFromCache();
         _file->Close();
         updateHeader(_file->GetFileName(), _fileBitSize);
     }
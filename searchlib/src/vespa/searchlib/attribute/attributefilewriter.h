@@ -28,8 +28,10 @@ class AttributeFileWriter : public IAttributeFileWriter
     const attribute::AttributeHeader &_header;
     vespalib::string _desc;
     uint64_t _fileBitSize;
+    uint64_t _unsyncedBytes;
 
     void addTags(vespalib::GenericHeader &header);
+    void syncAndDropFromCache();
 
     void writeHeader();
 public:
@@ -27,6 +27,8 @@ protected:
     void or_hits_into(const SC & sc, BitVector & result, uint32_t begin_id) const;
     template <typename SC>
     std::unique_ptr<BitVector> get_hits(const SC & sc, uint32_t begin_id) const;
+    template <typename PL>
+    void and_posting_hits_into(PL & iterator, BitVector & result, uint32_t begin_id) const;
     void visitMembers(vespalib::ObjectVisitor &visitor) const override;
     fef::TermFieldMatchData * _matchData;
     fef::TermFieldMatchDataPosition * _matchPosition;
@@ -10,6 +10,7 @@
 #include <vespa/searchlib/query/queryterm.h>
 #include <vespa/searchlib/common/bitvector.h>
 #include <vespa/vespalib/objects/visit.h>
+#include <limits>
 
 namespace search {
 
@@ -28,15 +29,82 @@ AttributeIteratorBase::or_hits_into(const SC & sc, BitVector & result, uint32_t
 }
 
 
+/**
+ * Intersect the result with a posting list by seeking the posting
+ * list to each remaining hit and clearing the bits skipped over. This
+ * is cheaper than building a bitvector of the full posting list when
+ * the result is sparse compared to the posting list.
+ */
+template <typename PL>
+void
+AttributeIteratorBase::and_posting_hits_into(PL & iterator, BitVector & result, uint32_t begin_id) const {
+    uint32_t end_id = std::min(getEndId(), result.size());
+    uint32_t docId = result.getFirstTrueBit(begin_id);
+    while (docId < end_id) {
+        if (iterator.valid() && (iterator.getKey() < docId)) {
+            iterator.seek(docId);
+        }
+        uint32_t key = (iterator.valid() && (iterator.getKey() < end_id)) ? iterator.getKey() : end_id;
+        result.clearInterval(docId, key);
+        if (key == end_id) {
+            break;
+        }
+        docId = result.getNextTrueBit(key);
+        if (docId == key) {
+            docId = result.getNextTrueBit(key + 1);
+        }
+    }
+    result.invalidateCachedCount();
+}
+
+namespace attributeiterators {
+
+/*
+ * Search contexts that can produce hits a word at a time provide
+ * fillHits(); all others are evaluated one document at a time.
+ */
 template <typename SC>
-std::unique_ptr<BitVector>
-AttributeIteratorBase::get_hits(const SC & sc, uint32_t begin_id) const {
-    BitVector::UP result = BitVector::create(begin_id, getEndId());
-    for (uint32_t docId(std::max(begin_id, getDocId())); docId < getEndId(); docId++) {
+auto
+fillHits(const SC & sc, BitVector & result, uint32_t begin, uint32_t end, int)
+    -> decltype(sc.fillHits(result, begin, end))
+{
+    sc.fillHits(result, begin, end);
+}
+
+template <typename SC>
+auto
+nextCandidate(const SC & sc, uint32_t docId, uint32_t & runEnd, int)
+    -> decltype(sc.nextCandidate(docId, runEnd))
+{
+    return sc.nextCandidate(docId, runEnd);
+}
+
+template <typename SC>
+uint32_t
+nextCandidate(const SC &, uint32_t docId, uint32_t & runEnd, long)
+{
+    runEnd = std::numeric_limits<uint32_t>::max();
+    return docId;
+}
+
+template <typename SC>
+void
+fillHits(const SC & sc, BitVector & result, uint32_t begin, uint32_t end, long)
+{
+    for (uint32_t docId(begin); docId < end; docId++) {
         if (sc.cmp(docId)) {
-            result->setBit(docId);
+            result.setBit(docId);
         }
     }
+}
+
+}
+
+template <typename SC>
+std::unique_ptr<BitVector>
+AttributeIteratorBase::get_hits(const SC & sc, uint32_t begin_id) const {
+    BitVector::UP result = BitVector::create(begin_id, getEndId());
+    attributeiterators::fillHits(sc, *result, std::max(begin_id, getDocId()), getEndId(), 0);
     result->invalidateCachedCount();
     return result;
 }
@@ -93,7 +161,7 @@ template <typename PL>
 void
 AttributePostingListIteratorT<PL>::doSeek(uint32_t docId)
 {
-    _iterator.linearSeek(docId);
+    _iterator.seek(docId);
     if (_iterator.valid()) {
         setDocId(_iterator.getKey());
     } else {
@@ -127,7 +195,7 @@ AttributePostingListIteratorT<PL>::or_hits_into(BitVector & result, uint32_t beg
 template <typename PL>
 void
 AttributePostingListIteratorT<PL>::and_hits_into(BitVector &result, uint32_t begin_id) {
-    result.andWith(*get_hits(begin_id));
+    and_posting_hits_into(_iterator, result, begin_id);
 }
 
 template <typename PL>
@@ -157,14 +225,14 @@ FilterAttributePostingListIteratorT<PL>::or_hits_into(BitVector & result, uint32
 template <typename PL>
 void
 FilterAttributePostingListIteratorT<PL>::and_hits_into(BitVector &result, uint32_t begin_id) {
-    result.andWith(*get_hits(begin_id));
+    and_posting_hits_into(_iterator, result, begin_id);
 }
 
 template <typename PL>
 void
 FilterAttributePostingListIteratorT<PL>::doSeek(uint32_t docId)
 {
-    _iterator.linearSeek(docId);
+    _iterator.seek(docId);
     if (_iterator.valid()) {
         setDocId(_iterator.getKey());
     } else {
@@ -358,10 +426,14 @@ template <typename SC>
 void
 AttributeIteratorStrict<SC>::doSeek(uint32_t docId)
 {
-    for (uint32_t nextId = docId; !isAtEnd(nextId); ++nextId) {
-        if (_searchContext.cmp(nextId, _weight)) {
-            setDocId(nextId);
-            return;
+    uint32_t runEnd;
+    for (uint32_t nextId = docId; !isAtEnd(nextId); ) {
+        nextId = attributeiterators::nextCandidate(_searchContext, nextId, runEnd, 0);
+        for (; nextId < runEnd && !isAtEnd(nextId); ++nextId) {
+            if (_searchContext.cmp(nextId, _weight)) {
+                setDocId(nextId);
+                return;
+            }
         }
     }
     setAtEnd();
@@ -371,10 +443,14 @@ template <typename SC>
 void
 FilterAttributeIteratorStrict<SC>::doSeek(uint32_t docId)
 {
-    for (uint32_t nextId = docId; !isAtEnd(nextId); ++nextId) {
-        if (_searchContext.cmp(nextId)) {
-            setDocId(nextId);
-            return;
+    uint32_t runEnd;
+    for (uint32_t nextId = docId; !isAtEnd(nextId); ) {
+        nextId = attributeiterators::nextCandidate(_searchContext, nextId, runEnd, 0);
+        for (; nextId < runEnd && !isAtEnd(nextId); ++nextId) {
+            if (_searchContext.cmp(nextId)) {
+                setDocId(nextId);
+                return;
+            }
         }
     }
     setAtEnd();
@@ -43,6 +43,10 @@ const vespalib::string docIdLimitTag = "docIdLimit";
 
 constexpr size_t DIRECTIO_ALIGNMENT(4096);
 
+// Attributes are read by all match threads, spread their generation
+// guards across cache lines.
+constexpr uint32_t GENERATION_READER_SLOTS = 16;
+
 template <typename T>
 struct FuncMax : public std::binary_function<T, T, T> {
     T operator() (const T & x, const T & y) const {
@@ -161,7 +165,7 @@ AttributeVector::AttributeVector(const vespalib::stringref &baseFileName, const
       _config(c),
       _interlock(std::make_shared<attribute::Interlock>()),
       _enumLock(),
-      _genHandler(),
+      _genHandler(GENERATION_READER_SLOTS),
       _genHolder(),
       _status(Status::createName((_baseFileName.getIndexName() +
                                   (_baseFileName.getSnapshotName().empty() ?
@@ -467,7 +471,7 @@ AttributeVector::save(IAttributeSaveTarget &saveTarget)
 
 attribute::AttributeHeader
 AttributeVector::createAttributeHeader() const {
-    return attribute::AttributeHeader(getBaseFileName(),
+    attribute::AttributeHeader header(getBaseFileName(),
                                    getConfig().basicType(),
                                    getConfig().collectionType(),
                                    getConfig().basicType().type() == BasicType::Type::TENSOR
@@ -481,6 +485,10 @@ AttributeVector::createAttributeHeader() const {
                                    getTotalValueCount(),
                                    getCreateSerialNum(),
                                    getVersion());
+    if (getConfig().basicType().type() == BasicType::Type::TENSOR && getConfig().tensorType().is_dense()) {
+        header.setTensorCellType(getConfig().tensorCellType());
+    }
+    return header;
 }
 
 void AttributeVector::onSave(IAttributeSaveTarget &) { abort(); }
@@ -512,6 +512,8 @@ public:
     // type-safe down-cast to attribute supporting direct document weight iterators
     const IDocumentWeightAttribute *asDocumentWeightAttribute() const override;
 
+    uint64_t getContentGeneration() const override { return getCurrentGeneration(); }
+
     /**
        - Search for equality
        - Range search
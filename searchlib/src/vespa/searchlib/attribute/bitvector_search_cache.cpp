@@ -8,6 +8,21 @@ namespace search::attribute {
 
 using BitVectorSP = BitVectorSearchCache::BitVectorSP;
 
+BitVectorSearchCache::Entry::~Entry() = default;
+
+BitVectorSearchCache::Entry::SP
+BitVectorSearchCache::Entry::create(ReadGuardUP dmsReadGuard, BitVectorSP bitVector, uint32_t docIdLimit)
+{
+    uint64_t numHits = bitVector->countTrueBits();
+    if (numHits * sizeof(DocIdPosting) * 8 >= docIdLimit) {
+        return std::make_shared<Entry>(std::move(dmsReadGuard), std::move(bitVector), docIdLimit);
+    }
+    DocIds docIds;
+    docIds.reserve(numHits);
+    bitVector->foreach_truebit([&docIds](uint32_t docId) { docIds.emplace_back(docId, btree::BTreeNoLeafData()); });
+    return std::make_shared<Entry>(std::move(dmsReadGuard), std::move(docIds), docIdLimit);
+}
+
 BitVectorSearchCache::BitVectorSearchCache()
     : _mutex(),
       _cache()
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <vespa/searchlib/btree/btree_key_data.h>
 #include <vespa/searchlib/common/i_document_meta_store_context.h>
 #include <vespa/vespalib/stllike/hash_map.h>
 #include <vespa/vespalib/stllike/string.h>
@@ -16,6 +17,9 @@ namespace attribute {
 
 /**
  * Class that caches posting lists (as bit vectors) for a set of search terms.
+ * Sparse posting lists are cached as sorted arrays of doc ids instead, as a
+ * bit vector costs one bit per document in the corpus regardless of the
+ * number of hits.
  *
  * Lifetime of cached bit vectors is controlled by calling clear() at regular intervals.
  */
@@ -23,6 +27,8 @@ class BitVectorSearchCache {
 public:
     using BitVectorSP = std::shared_ptr<BitVector>;
     using ReadGuardUP = IDocumentMetaStoreContext::IReadGuard::UP;
+    using DocIdPosting = btree::BTreeKeyData<uint32_t, btree::BTreeNoLeafData>;
+    using DocIds = std::vector<DocIdPosting>;
 
     struct Entry {
         using SP = std::shared_ptr<Entry>;
@@ -30,9 +36,19 @@ public:
         // in the bit vector are re-used until the guard is released.
         ReadGuardUP dmsReadGuard;
         BitVectorSP bitVector;
+        DocIds docIds; // used instead of bit vector when sparse
         uint32_t docIdLimit;
         Entry(ReadGuardUP dmsReadGuard_, BitVectorSP bitVector_, uint32_t docIdLimit_)
-            : dmsReadGuard(std::move(dmsReadGuard_)), bitVector(std::move(bitVector_)), docIdLimit(docIdLimit_) {}
+            : dmsReadGuard(std::move(dmsReadGuard_)), bitVector(std::move(bitVector_)), docIds(), docIdLimit(docIdLimit_) {}
+        Entry(ReadGuardUP dmsReadGuard_, DocIds docIds_, uint32_t docIdLimit_)
+            : dmsReadGuard(std::move(dmsReadGuard_)), bitVector(), docIds(std::move(docIds_)), docIdLimit(docIdLimit_) {}
+        ~Entry();
+
+        /**
+         * Creates an entry for the given posting list, converting it
+         * to a doc id array if that uses less memory than the bit vector.
+         */
+        static SP create(ReadGuardUP dmsReadGuard, BitVectorSP bitVector, uint32_t docIdLimit);
     };
 
 private:
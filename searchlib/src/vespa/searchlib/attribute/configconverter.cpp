@@ -10,6 +10,8 @@ namespace {
 
 using search::attribute::CollectionType;
 using search::attribute::BasicType;
+using search::attribute::HnswIndexParams;
+using search::attribute::TensorCellType;
 using vespalib::eval::ValueType;
 
 typedef std::map<AttributesConfig::Attribute::Datatype, BasicType::Type> DataTypeMap;
@@ -69,6 +71,9 @@ ConfigConverter::convert(const AttributesConfig::Attribute & cfg)
     retval.setEnableOnlyBitVector(cfg.enableonlybitvector);
     retval.setIsFilter(cfg.enableonlybitvector);
     retval.setFastAccess(cfg.fastaccess);
+    retval.setMmapLoad(cfg.mmapload);
+    retval.setHugePages(cfg.hugepages);
+    retval.setPaged(cfg.paged);
     predicateParams.setArity(cfg.arity);
     predicateParams.setBounds(cfg.lowerbound, cfg.upperbound);
     predicateParams.setDensePostingListThreshold(cfg.densepostinglistthreshold);
@@ -79,6 +84,10 @@ ConfigConverter::convert(const AttributesConfig::Attribute & cfg)
         } else {
             retval.setTensorType(ValueType::tensor_type({}));
         }
+        retval.setTensorCellType(TensorCellType(cfg.tensorcelltype));
+        retval.setHnswIndexParams(HnswIndexParams(cfg.hnsw.enabled,
+                                                  cfg.hnsw.maxlinkspernode,
+                                                  cfg.hnsw.neighborstoexploreatinsert));
     }
     return retval;
 }
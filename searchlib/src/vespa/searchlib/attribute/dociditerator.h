@@ -32,6 +32,23 @@ public:
         }
     }
 
+    /**
+     * Galloping search: probe forward with doubling steps until the
+     * docid is passed, then binary search the last step.
+     */
+    void seek(uint32_t docId) {
+        const P *low = _cur;
+        size_t step = 1;
+        while ((size_t(_end - low) > step) && (low[step]._key < docId)) {
+            low += step;
+            step *= 2;
+        }
+        const P *high = (size_t(_end - low) > step) ? (low + step + 1) : _end;
+        P keyWrap;
+        keyWrap._key = docId;
+        _cur = std::lower_bound<const P *, P>(low, high, keyWrap);
+    }
+
     uint32_t getKey() const { return _cur->_key; }
     inline int32_t getData() const { return _cur->getData(); }
 
@@ -15,6 +15,10 @@ EnumAttribute(const vespalib::string &baseFileName,
       _enumStore(0, cfg.fastSearch())
 {
     this->setEnum(true);
+    if (cfg.paged()) {
+        _enumStore.setUsePaging(true);
+        _enumStore.reset(0);
+    }
 }
 
 template <typename B>
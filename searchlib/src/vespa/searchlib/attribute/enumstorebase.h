@@ -306,6 +306,12 @@ public:
 
     void fallbackResize(uint64_t bytesNeeded);
     bool getPendingCompact() const { return _type.getPendingCompact(); }
+    /**
+     * Allocate buffers backed by files, see BufferTypeBase::setUsePaging().
+     * Only affects buffers activated later, call reset() afterwards to also
+     * reallocate the current buffer.
+     */
+    void setUsePaging(bool usePaging) { _type.setUsePaging(usePaging); }
     void clearPendingCompact() { _type.clearPendingCompact(); }
 
     template <typename Tree>
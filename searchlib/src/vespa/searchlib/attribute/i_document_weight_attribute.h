@@ -4,6 +4,8 @@
 
 #include <vespa/searchlib/datastore/entryref.h>
 #include <vespa/searchlib/btree/btreeiterator.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <vector>
 
 namespace search {
 
@@ -23,6 +25,19 @@ struct IDocumentWeightAttribute
             : posting_idx(posting_idx_in), posting_size(posting_size_in), min_weight(min_weight_in), max_weight(max_weight_in) {}
     };
     virtual LookupResult lookup(const vespalib::string &term) const = 0;
+    /**
+     * Look up several terms at once. The result for terms[i] is stored
+     * in results[i]. Attributes may override this to visit the terms in
+     * dictionary order, walking the dictionary once instead of doing a
+     * full lookup for each term.
+     **/
+    virtual void lookup(const std::vector<vespalib::string> &terms, std::vector<LookupResult> &results) const {
+        results.clear();
+        results.reserve(terms.size());
+        for (const vespalib::string &term : terms) {
+            results.push_back(lookup(term));
+        }
+    }
     virtual void create(datastore::EntryRef idx, std::vector<DocumentWeightIterator> &dst) const = 0;
     virtual DocumentWeightIterator create(datastore::EntryRef idx) const = 0;
     virtual ~IDocumentWeightAttribute() {}
@@ -4,6 +4,7 @@
 #include "imported_attribute_vector_read_guard.h"
 #include "imported_search_context.h"
 #include "bitvector_search_cache.h"
+#include "materialized_imported_values.h"
 #include <vespa/searchlib/query/queryterm.h>
 #include <vespa/vespalib/util/exceptions.h>
 
@@ -21,7 +22,8 @@ ImportedAttributeVector::ImportedAttributeVector(
       _target_attribute(std::move(target_attribute)),
       _document_meta_store(std::move(document_meta_store)),
       _search_cache(use_search_cache ? std::make_shared<BitVectorSearchCache>() :
-                    std::shared_ptr<BitVectorSearchCache>())
+                    std::shared_ptr<BitVectorSearchCache>()),
+      _materialized_values()
 {
 }
 
@@ -34,7 +36,8 @@ ImportedAttributeVector::ImportedAttributeVector(vespalib::stringref name,
       _reference_attribute(std::move(reference_attribute)),
       _target_attribute(std::move(target_attribute)),
       _document_meta_store(std::move(document_meta_store)),
-      _search_cache(std::move(search_cache))
+      _search_cache(std::move(search_cache)),
+      _materialized_values()
 {
 }
 
@@ -45,7 +48,8 @@ std::unique_ptr<ImportedAttributeVector>
 ImportedAttributeVector::makeReadGuard(bool stableEnumGuard) const
 {
     return std::make_unique<ImportedAttributeVectorReadGuard>
-        (getName(), getReferenceAttribute(), getTargetAttribute(), getDocumentMetaStore(), getSearchCache(), stableEnumGuard);
+        (getName(), getReferenceAttribute(), getTargetAttribute(), getDocumentMetaStore(), getSearchCache(),
+         getMaterializedValues(), stableEnumGuard);
 }
 
 const vespalib::string& search::attribute::ImportedAttributeVector::getName() const {
@@ -133,6 +137,11 @@ const IDocumentWeightAttribute *ImportedAttributeVector::asDocumentWeightAttribu
     return nullptr;
 }
 
+uint64_t ImportedAttributeVector::getContentGeneration() const {
+    // Content also depends on the parent document meta store, which is not tracked
+    return UNTRACKED_GENERATION;
+}
+
 BasicType::Type ImportedAttributeVector::getBasicType() const {
     return _target_attribute->getBasicType();
 }
@@ -149,6 +158,12 @@ bool ImportedAttributeVector::hasEnum() const {
     return _target_attribute->hasEnum();
 }
 
+void ImportedAttributeVector::enableMaterializedValues() {
+    if (!_materialized_values && MaterializedImportedValues::supports(*_target_attribute)) {
+        _materialized_values = std::make_shared<MaterializedImportedValues>();
+    }
+}
+
 void ImportedAttributeVector::clearSearchCache() {
     if (_search_cache) {
         _search_cache->clear();
@@ -16,6 +16,7 @@ class IDocumentMetaStoreContext;
 namespace attribute {
 
 class BitVectorSearchCache;
+class MaterializedImportedValues;
 
 /**
  * Attribute vector which does not store values of its own, but rather serves as a
@@ -64,6 +65,7 @@ public:
     std::unique_ptr<ISearchContext> createSearchContext(std::unique_ptr<QueryTermSimple> term,
                                                         const SearchContextParams &params) const override;
     const IDocumentWeightAttribute *asDocumentWeightAttribute() const override;
+    uint64_t getContentGeneration() const override;
     BasicType::Type getBasicType() const override;
     size_t getFixedWidth() const override;
     CollectionType::Type getCollectionType() const override;
@@ -82,6 +84,14 @@ public:
         return _search_cache;
     }
     void clearSearchCache();
+    const std::shared_ptr<MaterializedImportedValues> &getMaterializedValues() const {
+        return _materialized_values;
+    }
+    /*
+     * Let read guards use a materialized copy of the target values
+     * indexed by local lid. Only used for single value numeric targets.
+     */
+    void enableMaterializedValues();
 
     /*
      * Create an imported attribute with a snapshot of lid to lid mapping.
@@ -99,6 +109,7 @@ protected:
     std::shared_ptr<AttributeVector>           _target_attribute;
     std::shared_ptr<IDocumentMetaStoreContext> _document_meta_store;
     std::shared_ptr<BitVectorSearchCache>      _search_cache;
+    std::shared_ptr<MaterializedImportedValues> _materialized_values;
 };
 
 } // attribute
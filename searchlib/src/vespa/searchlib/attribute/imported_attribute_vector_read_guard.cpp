@@ -13,6 +13,7 @@ ImportedAttributeVectorReadGuard::ImportedAttributeVectorReadGuard(
         std::shared_ptr<AttributeVector> target_attribute,
         std::shared_ptr<IDocumentMetaStoreContext> document_meta_store,
         std::shared_ptr<BitVectorSearchCache> search_cache,
+        std::shared_ptr<MaterializedImportedValues> materialized_values,
         bool stableEnumGuard)
     : ImportedAttributeVector(name, std::move(reference_attribute), std::move(target_attribute),
                               std::move(document_meta_store), std::move(search_cache)),
@@ -20,9 +21,16 @@ ImportedAttributeVectorReadGuard::ImportedAttributeVectorReadGuard(
       _reference_attribute_guard(_reference_attribute),
       _target_attribute_guard(stableEnumGuard ? std::shared_ptr<AttributeVector>() : _target_attribute),
       _target_attribute_enum_guard(stableEnumGuard ? _target_attribute : std::shared_ptr<AttributeVector>()),
-      _mapper(_reference_attribute->getGidToLidMapperFactory()->getMapper())
+      _mapper(_reference_attribute->getGidToLidMapperFactory()->getMapper()),
+      _materialized()
 {
+    auto referenceGeneration = _reference_attribute->getCurrentGeneration();
+    auto targetGeneration = _target_attribute->getCurrentGeneration();
     _referencedLids = _reference_attribute->getReferencedLids();
+    if (materialized_values) {
+        _materialized = materialized_values->get(referenceGeneration, *_target_attribute,
+                                                 targetGeneration, _referencedLids);
+    }
 }
 
 ImportedAttributeVectorReadGuard::~ImportedAttributeVectorReadGuard() {
@@ -33,10 +41,20 @@ uint32_t ImportedAttributeVectorReadGuard::getValueCount(uint32_t doc) const {
 }
 
 IAttributeVector::largeint_t ImportedAttributeVectorReadGuard::getInt(DocId doc) const {
+    if (hasMaterialized(doc)) {
+        return _materialized->_ints.empty()
+            ? static_cast<largeint_t>(_materialized->_floats[doc])
+            : _materialized->_ints[doc];
+    }
     return _target_attribute->getInt(getReferencedLid(doc));
 }
 
 double ImportedAttributeVectorReadGuard::getFloat(DocId doc) const {
+    if (hasMaterialized(doc)) {
+        return _materialized->_ints.empty()
+            ? _materialized->_floats[doc]
+            : static_cast<double>(_materialized->_ints[doc]);
+    }
     return _target_attribute->getFloat(getReferencedLid(doc));
 }
 
@@ -4,6 +4,7 @@
 
 #include "imported_attribute_vector.h"
 #include "attributeguard.h"
+#include "materialized_imported_values.h"
 
 namespace search { class IGidToLidMapper; }
 
@@ -25,6 +26,11 @@ class ImportedAttributeVectorReadGuard : public ImportedAttributeVector
     AttributeGuard                      _target_attribute_guard;
     AttributeEnumGuard                  _target_attribute_enum_guard;
     std::unique_ptr<IGidToLidMapper>    _mapper;
+    std::shared_ptr<const MaterializedImportedValues::Values> _materialized;
+
+    bool hasMaterialized(uint32_t lid) const {
+        return _materialized && lid < _materialized->size();
+    }
 
     uint32_t getReferencedLid(uint32_t lid) const {
         return _referencedLids[lid];
@@ -36,6 +42,7 @@ public:
                                      std::shared_ptr<AttributeVector> target_attribute,
                                      std::shared_ptr<IDocumentMetaStoreContext> document_meta_store,
                                      std::shared_ptr<BitVectorSearchCache> search_cache,
+                                     std::shared_ptr<MaterializedImportedValues> materialized_values,
                                      bool stableEnumGuard);
     ~ImportedAttributeVectorReadGuard();
 
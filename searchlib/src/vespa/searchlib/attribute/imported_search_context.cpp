@@ -51,6 +51,16 @@ unsigned int ImportedSearchContext::approximateHits() const {
 std::unique_ptr<queryeval::SearchIterator>
 ImportedSearchContext::createIterator(fef::TermFieldMatchData* matchData, bool strict) {
     if (_searchCacheLookup) {
+        if (!_searchCacheLookup->bitVector) {
+            if (_searchCacheLookup->docIds.empty()) {
+                return SearchIterator::UP(new EmptySearch());
+            }
+            using DocIt = DocIdIterator<BitVectorSearchCache::DocIdPosting>;
+            DocIt postings;
+            const auto &docIds = _searchCacheLookup->docIds;
+            postings.set(&docIds[0], &docIds[docIds.size()]);
+            return std::make_unique<FilterAttributePostingListIteratorT<DocIt>>(matchData, postings);
+        }
         return BitVectorIterator::create(_searchCacheLookup->bitVector.get(), _searchCacheLookup->docIdLimit, *matchData, strict);
     }
     if (_merger.hasArray()) {
@@ -219,7 +229,7 @@ ImportedSearchContext::considerAddSearchCacheEntry()
 {
     if (_useSearchCache && _merger.hasBitVector()) {
         assert(_dmsReadGuard);
-        auto cacheEntry = std::make_shared<BitVectorSearchCache::Entry>(std::move(_dmsReadGuard), _merger.getBitVectorSP(), _merger.getDocIdLimit());
+        auto cacheEntry = BitVectorSearchCache::Entry::create(std::move(_dmsReadGuard), _merger.getBitVectorSP(), _merger.getDocIdLimit());
         _imported_attribute.getSearchCache()->insert(_queryTerm, std::move(cacheEntry));
     }
 }
@@ -43,6 +43,14 @@ public:
         return _children[ref].getData();
     }
 
+    // max weight and end of the posting btree leaf the child is positioned in
+    int32_t get_block_max_weight(uint16_t ref) const {
+        return _children[ref].getLeafAggregated().getMax();
+    }
+    uint32_t get_block_end(uint16_t ref) const {
+        return _children[ref].getLeafLastKey() + 1;
+    }
+
     std::unique_ptr<BitVector> get_hits(uint32_t begin_id, uint32_t end_id);
     void or_hits_into(BitVector &result, uint32_t begin_id);
 
@@ -6,6 +6,8 @@
 #include "loadedenumvalue.h"
 #include "multi_value_mapping.h"
 #include <vespa/vespalib/util/array.hpp>
+#include <fcntl.h>
+#include <unistd.h>
 
 using search::multivalue::Value;
 using search::multivalue::WeightedValue;
@@ -40,5 +42,21 @@ INSTANTIATE_VALUE(int64_t);
 INSTANTIATE_VALUE(float);
 INSTANTIATE_VALUE(double);
 
+vespalib::alloc::Alloc
+mapDataPrivate(const vespalib::string &fileName, uint64_t headerLen, size_t dataSize)
+{
+    if ((dataSize == 0) || ((headerLen % getpagesize()) != 0)) {
+        return vespalib::alloc::Alloc();
+    }
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return vespalib::alloc::Alloc();
+    }
+    // The mapping keeps its own reference to the file
+    vespalib::alloc::Alloc mapped = vespalib::alloc::Alloc::mmapFilePrivate(fd, headerLen, dataSize);
+    close(fd);
+    return mapped;
+}
+
 } // namespace search::attribute
 } // namespace search
@@ -4,6 +4,7 @@
 
 #include "attributevector.h"
 #include "readerbase.h"
+#include <vespa/vespalib/util/alloc.h>
 #include <vespa/vespalib/util/arrayref.h>
 
 namespace search {
@@ -32,5 +33,15 @@ loadFromEnumeratedSingleValue(Vector &vector,
                               vespalib::ConstArrayRef<typename Vector::ValueType> enumValueToValueMap,
                               Saver saver) __attribute((noinline));
 
+/*
+ * Function for mapping the data part of a saved attribute file
+ * private (copy-on-write) instead of reading it, see
+ * vespalib::alloc::Alloc::mmapFilePrivate(). Returns an empty
+ * allocation if the data can not be mapped, e.g. if the header
+ * length is not a multiple of the page size.
+ */
+vespalib::alloc::Alloc
+mapDataPrivate(const vespalib::string &fileName, uint64_t headerLen, size_t dataSize);
+
 } // namespace search::attribute
 } // namespace search
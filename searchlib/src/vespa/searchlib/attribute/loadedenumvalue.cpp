@@ -2,13 +2,62 @@
 
 #include "loadedenumvalue.h"
 #include <vespa/searchlib/common/sort.h>
+#include <vespa/vespalib/util/array.hpp>
+#include <algorithm>
+#include <vector>
 
 namespace search {
 namespace attribute {
 
+namespace {
+
+/*
+ * Values are loaded in document order, so a stable counting sort on
+ * the enum value gives the same (enum, docId) order as the radix sort
+ * in a single scatter pass.  Returns false when the preconditions do
+ * not hold and the caller must fall back to a comparison based sort.
+ */
+bool
+countingSortLoadedByEnum(LoadedEnumAttributeVector &loaded)
+{
+    uint32_t maxEnum = 0;
+    uint32_t prevDocId = 0;
+    for (const auto &value : loaded) {
+        if (value.getDocId() < prevDocId) {
+            return false;
+        }
+        prevDocId = value.getDocId();
+        maxEnum = std::max(maxEnum, value.getEnum());
+    }
+    if (maxEnum >= loaded.size()) {
+        return false;
+    }
+    std::vector<size_t> offsets(static_cast<size_t>(maxEnum) + 1, 0);
+    for (const auto &value : loaded) {
+        ++offsets[value.getEnum()];
+    }
+    size_t sum = 0;
+    for (auto &offset : offsets) {
+        size_t count = offset;
+        offset = sum;
+        sum += count;
+    }
+    LoadedEnumAttributeVector sorted(loaded.size());
+    for (const auto &value : loaded) {
+        sorted[offsets[value.getEnum()]++] = value;
+    }
+    loaded.swap(sorted);
+    return true;
+}
+
+}
+
 void
 sortLoadedByEnum(LoadedEnumAttributeVector &loaded)
 {
+    if (loaded.size() > 1 && countingSortLoadedByEnum(loaded)) {
+        return;
+    }
     ShiftBasedRadixSorter<LoadedEnumAttribute,
         LoadedEnumAttribute::EnumRadix,
         LoadedEnumAttribute::EnumCompare, 56>::
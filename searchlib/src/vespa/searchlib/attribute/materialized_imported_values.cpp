@@ -0,0 +1,65 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "materialized_imported_values.h"
+#include "attributevector.h"
+
+namespace search::attribute {
+
+MaterializedImportedValues::Values::Values(generation_t referenceGeneration, generation_t targetGeneration)
+    : _referenceGeneration(referenceGeneration),
+      _targetGeneration(targetGeneration),
+      _ints(),
+      _floats()
+{
+}
+
+MaterializedImportedValues::Values::~Values() = default;
+
+MaterializedImportedValues::MaterializedImportedValues()
+    : _lock(),
+      _values(),
+      _rebuilds(0)
+{
+}
+
+MaterializedImportedValues::~MaterializedImportedValues() = default;
+
+bool
+MaterializedImportedValues::supports(const AttributeVector &target)
+{
+    return (target.getCollectionType() == CollectionType::SINGLE) &&
+        (target.isIntegerType() || target.isFloatingPointType());
+}
+
+std::shared_ptr<const MaterializedImportedValues::Values>
+MaterializedImportedValues::get(generation_t referenceGeneration,
+                                const AttributeVector &target,
+                                generation_t targetGeneration,
+                                ReferencedLids referencedLids)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    if (_values &&
+        _values->_referenceGeneration == referenceGeneration &&
+        _values->_targetGeneration == targetGeneration &&
+        _values->size() >= referencedLids.size())
+    {
+        return _values;
+    }
+    auto values = std::make_shared<Values>(referenceGeneration, targetGeneration);
+    if (target.isIntegerType()) {
+        values->_ints.reserve(referencedLids.size());
+        for (uint32_t targetLid : referencedLids) {
+            values->_ints.push_back(target.getInt(targetLid));
+        }
+    } else {
+        values->_floats.reserve(referencedLids.size());
+        for (uint32_t targetLid : referencedLids) {
+            values->_floats.push_back(target.getFloat(targetLid));
+        }
+    }
+    _values = values;
+    ++_rebuilds;
+    return _values;
+}
+
+}
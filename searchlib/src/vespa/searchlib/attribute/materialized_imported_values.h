@@ -0,0 +1,69 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchcommon/attribute/iattributevector.h>
+#include <vespa/vespalib/util/arrayref.h>
+#include <vespa/vespalib/util/generationhandler.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace search { class AttributeVector; }
+
+namespace search::attribute {
+
+class ReferenceAttribute;
+
+/**
+ * Materialized mirror of a single value numeric target attribute,
+ * indexed by local lid in the document type importing it. Lookups via
+ * the mirror avoid the lid mapping and the virtual call into the target
+ * attribute, at the cost of one value per local document.
+ *
+ * The mirror is tagged with the generations of the reference attribute
+ * and the target attribute it was built from, and is rebuilt by the
+ * next read guard seeing a newer generation in either of them.
+ */
+class MaterializedImportedValues {
+public:
+    using generation_t = vespalib::GenerationHandler::generation_t;
+    using largeint_t = IAttributeVector::largeint_t;
+    using ReferencedLids = vespalib::ConstArrayRef<uint32_t>;
+
+    class Values {
+    public:
+        generation_t             _referenceGeneration;
+        generation_t             _targetGeneration;
+        std::vector<largeint_t>  _ints;
+        std::vector<double>      _floats;
+
+        Values(generation_t referenceGeneration, generation_t targetGeneration);
+        ~Values();
+        size_t size() const { return std::max(_ints.size(), _floats.size()); }
+    };
+
+private:
+    std::mutex                    _lock;
+    std::shared_ptr<const Values> _values;
+    uint64_t                      _rebuilds;
+
+public:
+    MaterializedImportedValues();
+    ~MaterializedImportedValues();
+
+    static bool supports(const AttributeVector &target);
+
+    /**
+     * Returns values matching the current generations of the given
+     * attributes, which must be guarded by the caller. The referenced
+     * lids must be snapshotted after the generations were sampled.
+     */
+    std::shared_ptr<const Values> get(generation_t referenceGeneration,
+                                      const AttributeVector &target,
+                                      generation_t targetGeneration,
+                                      ReferencedLids referencedLids);
+    uint64_t getRebuilds() const { return _rebuilds; }
+};
+
+}
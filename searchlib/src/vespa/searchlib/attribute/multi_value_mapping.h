@@ -46,6 +46,7 @@ public:
     void doneLoadFromMultiValue() { _store.setInitializing(false); }
 
     virtual void compactWorst(bool compactMemory, bool compactAddressSpace) override;
+    virtual datastore::ICompactionContext::UP startCompactWorst(bool compactMemory, bool compactAddressSpace) override;
 
     virtual AddressSpace getAddressSpaceUsage() const override;
     virtual MemoryUsage getArrayStoreMemoryUsage() const override;
@@ -19,6 +19,8 @@ MultiValueMapping<EntryT,RefT>::MultiValueMapping(const datastore::ArrayStoreCon
 template <typename EntryT, typename RefT>
 MultiValueMapping<EntryT,RefT>::~MultiValueMapping()
 {
+    // Finish any incremental compaction while the store is still alive
+    _compactionContext.reset();
 }
 
 template <typename EntryT, typename RefT>
@@ -57,6 +59,13 @@ MultiValueMapping<EntryT,RefT>::compactWorst(bool compactMemory, bool compactAdd
     }
 }
 
+template <typename EntryT, typename RefT>
+datastore::ICompactionContext::UP
+MultiValueMapping<EntryT,RefT>::startCompactWorst(bool compactMemory, bool compactAddressSpace)
+{
+    return _store.compactWorst(compactMemory, compactAddressSpace);
+}
+
 template <typename EntryT, typename RefT>
 MemoryUsage
 MultiValueMapping<EntryT,RefT>::getArrayStoreMemoryUsage() const
@@ -11,6 +11,8 @@ namespace {
 // minimum dead bytes in multi value mapping before consider compaction
 constexpr size_t DEAD_BYTES_SLACK = 0x10000u;
 constexpr size_t DEAD_CLUSTERS_SLACK = 0x10000u;
+// number of lids visited by each incremental compaction step
+constexpr uint32_t COMPACTION_LIDS_PER_STEP = 0x10000u;
 
 }
 
@@ -19,7 +21,10 @@ MultiValueMappingBase::MultiValueMappingBase(const GrowStrategy &gs,
     : _indices(gs, genHolder),
       _totalValues(0u),
       _cachedArrayStoreMemoryUsage(),
-      _cachedArrayStoreAddressSpaceUsage(0, 0, (1ull << 32))
+      _cachedArrayStoreAddressSpaceUsage(0, 0, (1ull << 32)),
+      _compactionContext(),
+      _compactionLidCursor(0u),
+      _compactionLidsPerStep(COMPACTION_LIDS_PER_STEP)
 {
 }
 
@@ -84,9 +89,32 @@ MultiValueMappingBase::updateStat()
     return retval;
 }
 
+void
+MultiValueMappingBase::compactStep()
+{
+    uint32_t lidLimit = _indices.size();
+    uint32_t end = lidLimit;
+    if (_compactionLidCursor < lidLimit && lidLimit - _compactionLidCursor > _compactionLidsPerStep) {
+        end = _compactionLidCursor + _compactionLidsPerStep;
+    }
+    if (_compactionLidCursor < end) {
+        _compactionContext->compact(vespalib::ArrayRef<EntryRef>(&_indices[_compactionLidCursor],
+                                                                end - _compactionLidCursor));
+        _compactionLidCursor = end;
+    }
+    if (_compactionLidCursor >= lidLimit) {
+        // All refs into the compacted buffers have been moved, buffers are put on hold.
+        _compactionContext.reset();
+    }
+}
+
 bool
 MultiValueMappingBase::considerCompact(const CompactionStrategy &compactionStrategy)
 {
+    if (_compactionContext) {
+        compactStep();
+        return true;
+    }
     size_t usedBytes = _cachedArrayStoreMemoryUsage.usedBytes();
     size_t deadBytes = _cachedArrayStoreMemoryUsage.deadBytes();
     size_t usedClusters = _cachedArrayStoreAddressSpaceUsage.used();
@@ -96,7 +124,9 @@ MultiValueMappingBase::considerCompact(const CompactionStrategy &compactionStrat
     bool compactAddressSpace = ((deadClusters >= DEAD_CLUSTERS_SLACK) &&
                                 (usedClusters * compactionStrategy.getMaxDeadAddressSpaceRatio() < deadClusters));
     if (compactMemory || compactAddressSpace) {
-        compactWorst(compactMemory, compactAddressSpace);
+        _compactionContext = startCompactWorst(compactMemory, compactAddressSpace);
+        _compactionLidCursor = 0;
+        compactStep();
         return true;
     }
     return false;
@@ -3,9 +3,11 @@
 #pragma once
 
 #include <vespa/searchlib/datastore/entryref.h>
+#include <vespa/searchlib/datastore/i_compaction_context.h>
 #include <vespa/searchlib/common/rcuvector.h>
 #include <vespa/searchlib/common/address_space.h>
 #include <vespa/vespalib/stllike/hash_map.h>
+#include <algorithm>
 #include <functional>
 
 namespace search {
@@ -28,6 +30,9 @@ protected:
     size_t    _totalValues;
     MemoryUsage _cachedArrayStoreMemoryUsage;
     AddressSpace _cachedArrayStoreAddressSpaceUsage;
+    datastore::ICompactionContext::UP _compactionContext;
+    uint32_t  _compactionLidCursor;
+    uint32_t  _compactionLidsPerStep;
 
     MultiValueMappingBase(const GrowStrategy &gs, vespalib::GenerationHolder &genHolder);
     virtual ~MultiValueMappingBase();
@@ -55,7 +60,18 @@ public:
     uint32_t getNumKeys() const { return _indices.size(); }
     uint32_t getCapacityKeys() const { return _indices.capacity(); }
     virtual void compactWorst(bool compatMemory, bool compactAddressSpace) = 0;
+    virtual datastore::ICompactionContext::UP startCompactWorst(bool compactMemory, bool compactAddressSpace) = 0;
+    /**
+     * Compacts the worst buffers incrementally. Each call moves the
+     * arrays for a bounded number of lids, and the compacted buffers
+     * are put on hold when all lids have been visited. Returns true
+     * if any refs might have changed, i.e. a new generation is needed.
+     */
     bool considerCompact(const CompactionStrategy &compactionStrategy);
+    bool isCompacting() const { return static_cast<bool>(_compactionContext); }
+    void setCompactionLidsPerStep(uint32_t lidsPerStep) { _compactionLidsPerStep = std::max(lidsPerStep, 1u); }
+private:
+    void compactStep();
 };
 
 } // namespace search::attribute
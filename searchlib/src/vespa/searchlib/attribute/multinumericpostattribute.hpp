@@ -110,6 +110,54 @@ MultiValueNumericPostingAttribute<B, M>::DocumentWeightAttributeAdapter::lookup(
     return LookupResult();
 }
 
+template <typename B, typename M>
+void
+MultiValueNumericPostingAttribute<B, M>::DocumentWeightAttributeAdapter::lookup(const std::vector<vespalib::string> &terms,
+                                                                                std::vector<LookupResult> &results) const
+{
+    std::vector<std::pair<int64_t, uint32_t>> sortedTerms;
+    sortedTerms.reserve(terms.size());
+    for (uint32_t i = 0; i < terms.size(); ++i) {
+        char *end = nullptr;
+        int64_t int_term = strtoll(terms[i].c_str(), &end, 10);
+        if (*end == '\0') {
+            sortedTerms.emplace_back(int_term, i);
+        }
+    }
+    std::sort(sortedTerms.begin(), sortedTerms.end());
+
+    const Dictionary &dictionary = self._enumStore.getPostingDictionary();
+    const FrozenDictionary frozenDictionary(dictionary.getFrozenView());
+    DictionaryConstIterator dictItr(btree::BTreeNode::Ref(), dictionary.getAllocator());
+    std::vector<datastore::EntryRef> pidxs(terms.size());
+    for (size_t i = 0; i < sortedTerms.size(); ++i) {
+        ComparatorType comp(self._enumStore, sortedTerms[i].first);
+        if (i == 0) {
+            dictItr.lower_bound(frozenDictionary.getRoot(), EnumIndex(), comp);
+        } else if (comp(dictItr.getKey(), EnumIndex())) {
+            dictItr.seek(EnumIndex(), comp);
+        }
+        if (!dictItr.valid()) {
+            break;
+        }
+        if (!comp(EnumIndex(), dictItr.getKey())) {
+            pidxs[sortedTerms[i].second] = dictItr.getData();
+        }
+    }
+
+    const PostingList &plist = self.getPostingList();
+    results.clear();
+    results.reserve(terms.size());
+    for (datastore::EntryRef pidx : pidxs) {
+        if (pidx.valid()) {
+            auto minmax = plist.getAggregated(pidx);
+            results.emplace_back(pidx, plist.frozenSize(pidx), minmax.getMin(), minmax.getMax());
+        } else {
+            results.emplace_back();
+        }
+    }
+}
+
 template <typename B, typename M>
 void
 MultiValueNumericPostingAttribute<B, M>::DocumentWeightAttributeAdapter::create(datastore::EntryRef idx, std::vector<DocumentWeightIterator> &dst) const
@@ -31,6 +31,7 @@ private:
         const MultiValueStringPostingAttributeT &self;
         DocumentWeightAttributeAdapter(const MultiValueStringPostingAttributeT &self_in) : self(self_in) {}
         virtual LookupResult lookup(const vespalib::string &term) const override final;
+        virtual void lookup(const std::vector<vespalib::string> &terms, std::vector<LookupResult> &results) const override final;
         virtual void create(datastore::EntryRef idx, std::vector<DocumentWeightIterator> &dst) const override final;
         virtual DocumentWeightIterator create(datastore::EntryRef idx) const override final;
     };
@@ -120,6 +120,51 @@ MultiValueStringPostingAttributeT<B, T>::DocumentWeightAttributeAdapter::lookup(
     return LookupResult();
 }
 
+template <typename B, typename T>
+void
+MultiValueStringPostingAttributeT<B, T>::DocumentWeightAttributeAdapter::lookup(const std::vector<vespalib::string> &terms,
+                                                                                std::vector<LookupResult> &results) const
+{
+    std::vector<uint32_t> order(terms.size());
+    for (uint32_t i = 0; i < terms.size(); ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&terms](uint32_t a, uint32_t b) {
+                  return FoldedComparatorType::compareFolded(terms[a].c_str(), terms[b].c_str()) < 0;
+              });
+
+    const Dictionary &dictionary = self._enumStore.getPostingDictionary();
+    const FrozenDictionary frozenDictionary(dictionary.getFrozenView());
+    DictionaryConstIterator dictItr(btree::BTreeNode::Ref(), dictionary.getAllocator());
+    std::vector<datastore::EntryRef> pidxs(terms.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        FoldedComparatorType comp(self._enumStore, terms[order[i]].c_str());
+        if (i == 0) {
+            dictItr.lower_bound(frozenDictionary.getRoot(), EnumIndex(), comp);
+        } else if (comp(dictItr.getKey(), EnumIndex())) {
+            dictItr.seek(EnumIndex(), comp);
+        }
+        if (!dictItr.valid()) {
+            break;
+        }
+        if (!comp(EnumIndex(), dictItr.getKey())) {
+            pidxs[order[i]] = dictItr.getData();
+        }
+    }
+
+    const PostingList &plist = self.getPostingList();
+    results.clear();
+    results.reserve(terms.size());
+    for (datastore::EntryRef pidx : pidxs) {
+        if (pidx.valid()) {
+            auto minmax = plist.getAggregated(pidx);
+            results.emplace_back(pidx, plist.frozenSize(pidx), minmax.getMin(), minmax.getMax());
+        } else {
+            results.emplace_back();
+        }
+    }
+}
+
 template <typename B, typename T>
 void
 MultiValueStringPostingAttributeT<B, T>::DocumentWeightAttributeAdapter::create(datastore::EntryRef idx, std::vector<DocumentWeightIterator> &dst) const
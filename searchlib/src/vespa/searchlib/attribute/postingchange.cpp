@@ -19,7 +19,9 @@ removeDupAdditions(PostingChange<AttributePosting>::A &additions)
         return;
     if (additions.size() == 1)
         return;
-    std::sort(additions.begin(), additions.end());
+    if (!std::is_sorted(additions.begin(), additions.end())) {
+        std::sort(additions.begin(), additions.end());
+    }
     Iterator i = additions.begin();
     Iterator ie = additions.end();
     Iterator d = i;
@@ -47,7 +49,9 @@ removeDupAdditions(PostingChange<AttributeWeightPosting>::A &additions)
         return;
     if (additions.size() == 1u)
         return;
-    std::sort(additions.begin(), additions.end());
+    if (!std::is_sorted(additions.begin(), additions.end())) {
+        std::sort(additions.begin(), additions.end());
+    }
     Iterator i = additions.begin();
     Iterator ie = additions.end();
     Iterator d = i;
@@ -79,7 +83,9 @@ removeDupRemovals(std::vector<uint32_t> &removals)
         return;
     if (removals.size() == 1u)
         return;
-    std::sort(removals.begin(), removals.end());
+    if (!std::is_sorted(removals.begin(), removals.end())) {
+        std::sort(removals.begin(), removals.end());
+    }
     Iterator i = removals.begin();
     Iterator ie = removals.end();
     Iterator d = i;
@@ -12,7 +12,8 @@ SingleValueEnumAttributeBase(const Config & c, GenerationHolder &genHolder)
     : _enumIndices(c.getGrowStrategy().getDocsInitialCapacity(),
                    c.getGrowStrategy().getDocsGrowPercent(),
                    c.getGrowStrategy().getDocsGrowDelta(),
-                   genHolder)
+                   genHolder,
+                   c.hugePages() ? vespalib::alloc::Alloc::allocHugePages() : vespalib::alloc::Alloc::alloc())
 {
 }
 
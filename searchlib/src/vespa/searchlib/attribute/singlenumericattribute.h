@@ -26,6 +26,35 @@ private:
 
     typedef attribute::RcuVectorBase<T> DataVector;
     DataVector _data;
+    // Conservative min and max of the defined values in each block of
+    // lids. Only widened on update, used by searches to skip blocks.
+    DataVector _blockMin;
+    DataVector _blockMax;
+    // Lids changed since the last save, only maintained when delta tracking is enabled.
+    bool              _trackDeltas;
+    std::vector<bool> _changedLids;
+
+    bool ensureBlockRange(DocId doc);
+    void widenBlockRange(DocId doc, T v) {
+        if (attribute::isUndefined(v)) {
+            return;
+        }
+        uint32_t blockId = doc >> BLOCK_RANGE_BITS;
+        if (v < _blockMin[blockId]) {
+            _blockMin[blockId] = v;
+        }
+        if (_blockMax[blockId] < v) {
+            _blockMax[blockId] = v;
+        }
+    }
+    void rebuildBlockRanges();
+
+    void markChanged(DocId doc) {
+        if (doc >= _changedLids.size()) {
+            _changedLids.resize(doc + 1);
+        }
+        _changedLids[doc] = true;
+    }
 
     T getFromEnum(EnumHandle e) const override {
         (void) e;
@@ -40,6 +69,14 @@ private:
     {
     private:
         const T * _data;
+        const T * _blockMin;
+        const T * _blockMax;
+        uint32_t  _numBlocks;
+        bool      _useBlockRange;
+
+        bool blockMayMatch(uint32_t blockId) const {
+            return this->mayMatchRange(_blockMin[blockId], _blockMax[blockId]);
+        }
 
         bool onCmp(DocId docId, int32_t & weight) const override {
             return cmp(docId, weight);
@@ -64,6 +101,20 @@ private:
             return this->match(v);
         }
 
+        /**
+         * Set the bits for all matching documents in [begin, end) a
+         * full 64-bit word at a time. The inner loop has no branches
+         * and is vectorized by the compiler.
+         */
+        void fillHits(BitVector &result, uint32_t begin, uint32_t end) const;
+
+        /**
+         * Return the first docid >= docId in a block that may contain
+         * matches, and the end of the run of docids that must be
+         * checked one by one.
+         */
+        uint32_t nextCandidate(uint32_t docId, uint32_t &runEnd) const;
+
         Int64Range getAsIntegerTerm() const override;
 
         std::unique_ptr<queryeval::SearchIterator>
@@ -78,6 +129,9 @@ protected:
     }
 
 public:
+    // Each block summarizes 1 << BLOCK_RANGE_BITS lids.
+    static constexpr uint32_t BLOCK_RANGE_BITS = 12;
+
     SingleValueNumericAttribute(const vespalib::string & baseFileName,
                                 const AttributeVector::Config & c =
                                 AttributeVector::Config(AttributeVector::
@@ -177,6 +231,26 @@ public:
     void clearDocs(DocId lidLow, DocId lidLimit) override;
     void onShrinkLidSpace() override;
     std::unique_ptr<AttributeSaver> onInitSave() override;
+
+    /**
+     * Start tracking which lids are changed, so that saveDelta() can write
+     * only those values instead of a complete snapshot.
+     */
+    void enableDeltaTracking() { _trackDeltas = true; }
+    bool isDeltaTrackingEnabled() const { return _trackDeltas; }
+
+    /**
+     * Write the values of the lids changed since the last save (full or
+     * delta) to the given file and forget about them. Returns false if
+     * delta tracking is not enabled or the file could not be written.
+     */
+    bool saveDelta(const vespalib::string & fileName);
+
+    /**
+     * Apply a delta written by saveDelta() on top of the loaded snapshot.
+     * Deltas must be applied in the order they were written.
+     */
+    bool loadDelta(const vespalib::string & fileName);
 };
 
 }
@@ -8,6 +8,8 @@
 #include "primitivereader.h"
 #include "attributeiterators.hpp"
 #include <vespa/searchlib/queryeval/emptysearch.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/fastos/file.h>
 
 namespace search {
 
@@ -18,7 +20,12 @@ SingleValueNumericAttribute(const vespalib::string & baseFileName, const Attribu
     _data(c.getGrowStrategy().getDocsInitialCapacity(),
           c.getGrowStrategy().getDocsGrowPercent(),
           c.getGrowStrategy().getDocsGrowDelta(),
-          getGenerationHolder())
+          getGenerationHolder(),
+          c.hugePages() ? vespalib::alloc::Alloc::allocHugePages() : vespalib::alloc::Alloc::alloc()),
+    _blockMin(16, 100, 0, getGenerationHolder()),
+    _blockMax(16, 100, 0, getGenerationHolder()),
+    _trackDeltas(false),
+    _changedLids()
 { }
 
 template <typename B>
@@ -37,13 +44,20 @@ SingleValueNumericAttribute<B>::onCommit()
         // apply updates
         typename B::ValueModifier valueGuard(this->getValueModifier());
         for (const auto & change : this->_changes) {
+            if (_trackDeltas) {
+                markChanged(change._doc);
+            }
             if (change._type == ChangeBase::UPDATE) {
+                widenBlockRange(change._doc, change._data);
                 std::atomic_thread_fence(std::memory_order_release);
                 _data[change._doc] = change._data;
             } else if (change._type >= ChangeBase::ADD && change._type <= ChangeBase::DIV) {
+                T v = this->applyArithmetic(_data[change._doc], change);
+                widenBlockRange(change._doc, v);
                 std::atomic_thread_fence(std::memory_order_release);
-                _data[change._doc] = this->applyArithmetic(_data[change._doc], change);
+                _data[change._doc] = v;
             } else if (change._type == ChangeBase::CLEARDOC) {
+                widenBlockRange(change._doc, this->_defaultValue._data);
                 std::atomic_thread_fence(std::memory_order_release);
                 _data[change._doc] = this->_defaultValue._data;
             }
@@ -61,6 +75,8 @@ void
 SingleValueNumericAttribute<B>::onUpdateStat()
 {
     MemoryUsage usage = _data.getMemoryUsage();
+    usage.merge(_blockMin.getMemoryUsage());
+    usage.merge(_blockMax.getMemoryUsage());
     usage.mergeGenerationHeldBytes(getGenerationHolder().getHeldBytes());
     usage.merge(this->getChangeVectorMemoryUsage());
     this->updateStatistics(_data.size(), _data.size(),
@@ -73,10 +89,40 @@ SingleValueNumericAttribute<B>::onAddDocs(DocId lidLimit) {
     _data.reserve(lidLimit);
 }
 
+template <typename B>
+bool
+SingleValueNumericAttribute<B>::ensureBlockRange(DocId doc)
+{
+    bool incGen = false;
+    uint32_t blockId = doc >> BLOCK_RANGE_BITS;
+    while (_blockMin.size() <= blockId) {
+        incGen |= _blockMin.isFull() || _blockMax.isFull();
+        _blockMin.push_back(std::numeric_limits<T>::max());
+        _blockMax.push_back(std::numeric_limits<T>::lowest());
+    }
+    return incGen;
+}
+
+template <typename B>
+void
+SingleValueNumericAttribute<B>::rebuildBlockRanges()
+{
+    _blockMin.reset();
+    _blockMax.reset();
+    size_t numBlocks = (_data.size() + (1u << BLOCK_RANGE_BITS) - 1) >> BLOCK_RANGE_BITS;
+    _blockMin.unsafe_reserve(numBlocks);
+    _blockMax.unsafe_reserve(numBlocks);
+    ensureBlockRange(_data.size());
+    for (DocId lid = 0; lid < _data.size(); ++lid) {
+        widenBlockRange(lid, _data[lid]);
+    }
+}
+
 template <typename B>
 bool
 SingleValueNumericAttribute<B>::addDoc(DocId & doc) {
     bool incGen = _data.isFull();
+    incGen |= ensureBlockRange(B::getNumDocs());
     _data.push_back(attribute::getUndefined<T>());
     std::atomic_thread_fence(std::memory_order_release);
     B::incNumDocs();
@@ -119,6 +165,7 @@ SingleValueNumericAttribute<B>::onLoadEnumerated(ReaderBase &attrReader)
                                    udatBuffer->size() / sizeof(T));
     attribute::loadFromEnumeratedSingleValue(_data, getGenerationHolder(), attrReader,
                                              map, attribute::NoSaveLoadedEnum());
+    rebuildBlockRanges();
     return true;
 }
 
@@ -140,11 +187,21 @@ SingleValueNumericAttribute<B>::onLoad()
     
     const size_t sz(attrReader.getDataCount());
     getGenerationHolder().clearHoldLists();
-    _data.reset();
-    _data.unsafe_reserve(sz);
-    for (uint32_t i = 0; i < sz; ++i) {
-        _data.push_back(attrReader.getNextData());
+    vespalib::alloc::Alloc mapped;
+    if (this->getConfig().mmapLoad()) {
+        // The saved data has the in-memory layout, pages are copied when first written
+        mapped = attribute::mapDataPrivate(this->getBaseFileName() + ".dat", attrReader.getDatHeaderLen(), sz * sizeof(T));
     }
+    if (mapped.get() != nullptr) {
+        _data.unsafe_reset(vespalib::Array<T>(std::move(mapped), sz));
+    } else {
+        _data.reset();
+        _data.unsafe_reserve(sz);
+        for (uint32_t i = 0; i < sz; ++i) {
+            _data.push_back(attrReader.getNextData());
+        }
+    }
+    rebuildBlockRanges();
 
     B::setNumDocs(sz);
     B::setCommittedDocIdLimit(sz);
@@ -187,6 +244,11 @@ SingleValueNumericAttribute<B>::onShrinkLidSpace()
     uint32_t committedDocIdLimit = this->getCommittedDocIdLimit();
     assert(_data.size() >= committedDocIdLimit);
     _data.shrink(committedDocIdLimit);
+    size_t numBlocks = (committedDocIdLimit + (1u << BLOCK_RANGE_BITS) - 1) >> BLOCK_RANGE_BITS;
+    if (numBlocks < _blockMin.size()) {
+        _blockMin.shrink(numBlocks);
+        _blockMax.shrink(numBlocks);
+    }
     this->setNumDocs(committedDocIdLimit);
 }
 
@@ -196,10 +258,86 @@ SingleValueNumericAttribute<B>::onInitSave()
 {
     const uint32_t numDocs(this->getCommittedDocIdLimit());
     assert(numDocs <= _data.size());
+    // A full snapshot contains every value, earlier deltas are no longer needed.
+    _changedLids.clear();
     return std::make_unique<SingleValueNumericAttributeSaver>
         (this->createAttributeHeader(), &_data[0], numDocs * sizeof(T));
 }
 
+namespace attribute {
+
+// Magic number for delta files written by SingleValueNumericAttribute::saveDelta.
+constexpr uint32_t SINGLE_NUMERIC_DELTA_MAGIC = 0x5344656c;
+
+}
+
+template <typename B>
+bool
+SingleValueNumericAttribute<B>::saveDelta(const vespalib::string & fileName)
+{
+    if (!_trackDeltas) {
+        return false;
+    }
+    const uint32_t numDocs(this->getCommittedDocIdLimit());
+    std::vector<DocId> lids;
+    for (DocId lid = 0; lid < _changedLids.size() && lid < numDocs; ++lid) {
+        if (_changedLids[lid]) {
+            lids.push_back(lid);
+        }
+    }
+    vespalib::nbostream os;
+    os << attribute::SINGLE_NUMERIC_DELTA_MAGIC << static_cast<uint32_t>(sizeof(T)) << static_cast<uint32_t>(lids.size());
+    for (DocId lid : lids) {
+        os << static_cast<uint32_t>(lid) << _data[lid];
+    }
+    FastOS_File file(fileName.c_str());
+    if (!file.OpenWriteOnlyTruncate()) {
+        return false;
+    }
+    bool ok = (file.Write2(os.peek(), os.size()) == ssize_t(os.size())) && file.Sync() && file.Close();
+    if (ok) {
+        _changedLids.clear();
+    }
+    return ok;
+}
+
+template <typename B>
+bool
+SingleValueNumericAttribute<B>::loadDelta(const vespalib::string & fileName)
+{
+    FastOS_File file(fileName.c_str());
+    if (!file.OpenReadOnly()) {
+        return false;
+    }
+    int64_t fileSize = file.GetSize();
+    if (fileSize < int64_t(3 * sizeof(uint32_t))) {
+        return false;
+    }
+    std::vector<char> buf(fileSize);
+    if (file.Read(&buf[0], fileSize) != fileSize) {
+        return false;
+    }
+    vespalib::nbostream is(&buf[0], buf.size());
+    uint32_t magic(0), valueSize(0), count(0);
+    is >> magic >> valueSize >> count;
+    if ((magic != attribute::SINGLE_NUMERIC_DELTA_MAGIC) || (valueSize != sizeof(T)) ||
+        (is.size() != count * (sizeof(uint32_t) + sizeof(T))))
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t lid(0);
+        T value;
+        is >> lid >> value;
+        if (lid < _data.size()) {
+            widenBlockRange(lid, value);
+            _data[lid] = value;
+        }
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    return true;
+}
+
 template <typename B>
 template <typename M>
 bool SingleValueNumericAttribute<B>::SingleSearchContext<M>::valid() const { return M::isValid(); }
@@ -210,9 +348,75 @@ SingleValueNumericAttribute<B>::SingleSearchContext<M>::SingleSearchContext(Quer
                                                                             const NumericAttribute & toBeSearched) :
     M(*qTerm, true),
     AttributeVector::SearchContext(toBeSearched),
-    _data(&static_cast<const SingleValueNumericAttribute<B> &>(toBeSearched)._data[0])
+    _data(&static_cast<const SingleValueNumericAttribute<B> &>(toBeSearched)._data[0]),
+    _blockMin(&static_cast<const SingleValueNumericAttribute<B> &>(toBeSearched)._blockMin[0]),
+    _blockMax(&static_cast<const SingleValueNumericAttribute<B> &>(toBeSearched)._blockMax[0]),
+    _numBlocks(static_cast<const SingleValueNumericAttribute<B> &>(toBeSearched)._blockMin.size()),
+    _useBlockRange(!this->match(attribute::getUndefined<T>()))
 { }
 
+template <typename B>
+template <typename M>
+uint32_t
+SingleValueNumericAttribute<B>::SingleSearchContext<M>::nextCandidate(uint32_t docId, uint32_t &runEnd) const
+{
+    runEnd = std::numeric_limits<uint32_t>::max();
+    if (!_useBlockRange) {
+        return docId;
+    }
+    uint32_t blockId = docId >> BLOCK_RANGE_BITS;
+    if (blockId >= _numBlocks) {
+        return docId;
+    }
+    if (!blockMayMatch(blockId)) {
+        do {
+            ++blockId;
+        } while (blockId < _numBlocks && !blockMayMatch(blockId));
+        docId = blockId << BLOCK_RANGE_BITS;
+    }
+    if (blockId < _numBlocks) {
+        runEnd = (blockId + 1) << BLOCK_RANGE_BITS;
+    }
+    return docId;
+}
+
+
+template <typename B>
+template <typename M>
+void
+SingleValueNumericAttribute<B>::SingleSearchContext<M>::fillHits(BitVector &result, uint32_t begin, uint32_t end) const
+{
+    using Word = BitWord::Word;
+    constexpr uint32_t wordLen = BitWord::WordLen;
+    uint32_t docId = begin;
+    for (; docId < end && (docId % wordLen) != 0; ++docId) {
+        if (cmp(docId)) {
+            result.setBit(docId);
+        }
+    }
+    Word *words = static_cast<Word *>(result.getStart());
+    constexpr uint32_t blockMask = (1u << BLOCK_RANGE_BITS) - 1;
+    for (; docId + wordLen <= end; docId += wordLen) {
+        if (_useBlockRange && ((docId & blockMask) == 0) &&
+            ((docId >> BLOCK_RANGE_BITS) < _numBlocks) && !blockMayMatch(docId >> BLOCK_RANGE_BITS))
+        {
+            // Continues at the start of the next block
+            docId += blockMask + 1 - wordLen;
+            continue;
+        }
+        const T *values = _data + docId;
+        Word bits = 0;
+        for (uint32_t i = 0; i < wordLen; ++i) {
+            bits |= static_cast<Word>(this->match(values[i])) << i;
+        }
+        words[BitWord::wordNum(docId)] |= bits;
+    }
+    for (; docId < end; ++docId) {
+        if (cmp(docId)) {
+            result.setBit(docId);
+        }
+    }
+}
 
 template <typename B>
 template <typename M>
@@ -357,6 +357,26 @@ public:
         return _leaf.valid();
     }
 
+    /**
+     * Get aggregated values for the current leaf node.  Iterator must
+     * be valid.  Can be used as a local upper bound for all elements
+     * up to and including getLeafLastKey().
+     */
+    const AggrT &
+    getLeafAggregated() const
+    {
+        return _leaf.getNode()->getAggregated();
+    }
+
+    /**
+     * Get last key in the current leaf node.  Iterator must be valid.
+     */
+    const KeyType &
+    getLeafLastKey() const
+    {
+        return _leaf.getNode()->getLastKey();
+    }
+
     /**
      * Return the number of elements in the tree.
      */
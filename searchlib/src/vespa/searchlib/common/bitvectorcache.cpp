@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include "bitvectorcache.h"
 #include <vespa/vespalib/stllike/hash_map.hpp>
+#include <vespa/vespalib/stllike/hash_set.hpp>
 #include <algorithm>
 
 #include <vespa/log/log.h>
@@ -218,3 +219,5 @@ BitVectorCache::adjustDocIdLimit(uint32_t docId)
 }
 
 }
+
+VESPALIB_SWISS_HASH_SET_INSTANTIATE_H(search::BitVectorCache::Key, vespalib::hash<search::BitVectorCache::Key>);
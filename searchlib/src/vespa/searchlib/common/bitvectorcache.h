@@ -25,7 +25,7 @@ class BitVectorCache
 {
 public:
     typedef uint64_t Key;
-    typedef vespalib::hash_set<Key> KeySet;
+    typedef vespalib::hash_set<Key, vespalib::hash<Key>, std::equal_to<Key>, vespalib::swiss_probing> KeySet;
     typedef std::vector<std::pair<Key, size_t>> KeyAndCountSet;
     typedef CondensedBitVector::CountVector CountVector;
     typedef vespalib::GenerationHolder GenerationHolder;
@@ -68,7 +68,7 @@ private:
         int32_t  _chunkId;
         uint32_t _chunkIndex;
     };
-    typedef vespalib::hash_map<Key, KeyMeta> Key2Index;
+    typedef vespalib::hash_map<Key, KeyMeta, vespalib::hash<Key>, std::equal_to<Key>, vespalib::swiss_probing> Key2Index;
     typedef std::vector<std::pair<Key, KeyMeta *>> SortedKeyMeta;
     typedef std::vector<CondensedBitVector::SP> ChunkV;
 
@@ -95,6 +95,13 @@ struct IDocumentMetaStore {
      **/
     virtual bool getLid(const GlobalId &gid, DocId &lid) const = 0;
 
+    /**
+     * Retrieves the lids associated with the given gids. Lid 0 is
+     * used for gids that are not found. This is cheaper than calling
+     * getLid() for each gid when looking up many gids at once.
+     **/
+    virtual void getLids(const std::vector<GlobalId> &gids, std::vector<DocId> &lids) const = 0;
+
     /**
      * Retrieves the meta data for the document with the given gid.
      **/
@@ -45,6 +45,7 @@ protected:
     using GenerationHolder = vespalib::GenerationHolder;
 private:
     Array              _data;
+    Alloc              _alloc;      // Allocation strategy for new data vectors
     size_t             _growPercent;
     size_t             _growDelta;
     GenerationHolder   &_genHolder;
@@ -121,6 +122,11 @@ public:
     const T & operator[](size_t i) const { return _data[i]; }
 
     void reset();
+    /**
+     * Replace the underlying data with the given array, e.g. one
+     * backed by a private file mapping. Assumes no readers at this moment.
+     */
+    void unsafe_reset(Array &&data);
     void shrink(size_t newSize) __attribute__((noinline));
 };
 
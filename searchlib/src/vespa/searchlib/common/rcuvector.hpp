@@ -42,17 +42,24 @@ template <typename T>
 void
 RcuVectorBase<T>::reset() {
     // Assumes no readers at this moment
-    Array().swap(_data);
+    Array(_alloc).swap(_data);
     _data.reserve(16);
 }
 
+template <typename T>
+void
+RcuVectorBase<T>::unsafe_reset(Array &&data) {
+    // Assumes no readers at this moment
+    _data = std::move(data);
+}
+
 template <typename T>
 RcuVectorBase<T>::~RcuVectorBase() { }
 
 template <typename T>
 void
 RcuVectorBase<T>::expand(size_t newCapacity) {
-    std::unique_ptr<Array> tmpData(new Array());
+    std::unique_ptr<Array> tmpData(new Array(_alloc));
     tmpData->reserve(newCapacity);
     tmpData->resize(_data.size());
     memcpy(tmpData->begin(), _data.begin(), _data.size() * sizeof(T));
@@ -83,7 +90,7 @@ RcuVectorBase<T>::shrink(size_t newSize)
         return;
     }
     if (!_data.try_unreserve(wantedCapacity)) {
-        std::unique_ptr <Array> tmpData(new Array());
+        std::unique_ptr <Array> tmpData(new Array(_alloc));
         tmpData->reserve(wantedCapacity);
         tmpData->resize(newSize);
         for (uint32_t i = 0; i < newSize; ++i) {
@@ -103,6 +110,7 @@ template <typename T>
 RcuVectorBase<T>::RcuVectorBase(GenerationHolder &genHolder,
                                 const Alloc &initialAlloc)
     : _data(initialAlloc),
+      _alloc(initialAlloc.create(0)),
       _growPercent(100),
       _growDelta(0),
       _genHolder(genHolder)
@@ -117,6 +125,7 @@ RcuVectorBase<T>::RcuVectorBase(size_t initialCapacity,
                                 GenerationHolder &genHolder,
                                 const Alloc &initialAlloc)
     : _data(initialAlloc),
+      _alloc(initialAlloc.create(0)),
       _growPercent(growPercent),
       _growDelta(growDelta),
       _genHolder(genHolder)
@@ -140,6 +149,9 @@ RcuVectorBase<T>::getMemoryUsage() const
     MemoryUsage retval;
     retval.incAllocatedBytes(_data.capacity() * sizeof(T));
     retval.incUsedBytes(_data.size() * sizeof(T));
+    if (_alloc.usesHugePages()) {
+        retval.incAllocatedBytesOnHugePages(_data.capacity() * sizeof(T));
+    }
     return retval;
 }
 
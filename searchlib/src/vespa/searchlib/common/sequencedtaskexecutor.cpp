@@ -1,6 +1,9 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "sequencedtaskexecutor.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 
 using vespalib::BlockingThreadStackExecutor;
 
@@ -9,12 +12,57 @@ namespace search {
 namespace {
 
 constexpr uint32_t stackSize = 128 * 1024;
+// Number of scheduled tasks between each sampling of lane load
+constexpr uint32_t loadSampleInterval = 1024;
 
 }
 
+struct SequencedTaskExecutor::Lane
+{
+    uint32_t              threadId;
+    std::atomic<uint32_t> pending;
+    std::atomic<uint64_t> busyTime;  // ns, updated by worker threads
+    uint64_t              load;      // busy time in last sample
+
+    explicit Lane(uint32_t threadId_)
+        : threadId(threadId_),
+          pending(0),
+          busyTime(0),
+          load(0)
+    {
+    }
+};
+
+class SequencedTaskExecutor::LaneTask : public vespalib::Executor::Task
+{
+    Lane &_lane;
+    vespalib::Executor::Task::UP _task;
+public:
+    LaneTask(Lane &lane, vespalib::Executor::Task::UP task)
+        : _lane(lane),
+          _task(std::move(task))
+    {
+    }
 
-SequencedTaskExecutor::SequencedTaskExecutor(uint32_t threads, uint32_t taskLimit)
-    : _executors()
+    void run() override {
+        using clock = std::chrono::steady_clock;
+        clock::time_point start = clock::now();
+        _task->run();
+        _task.reset();
+        uint64_t busyTime = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+        _lane.busyTime.fetch_add(busyTime, std::memory_order_relaxed);
+        // Lane may be moved to another thread after this
+        _lane.pending.fetch_sub(1, std::memory_order_release);
+    }
+};
+
+SequencedTaskExecutor::SequencedTaskExecutor(uint32_t threads, uint32_t taskLimit, bool rebalance)
+    : _executors(),
+      _ids(),
+      _rebalance(rebalance),
+      _lanes(),
+      _executorLoad(threads, 0),
+      _tasksSinceSample(0)
 {
     for (uint32_t id = 0; id < threads; ++id) {
         auto executor = std::make_unique<BlockingThreadStackExecutor>(1, stackSize, taskLimit);
@@ -40,7 +88,11 @@ SequencedTaskExecutor::getExecutorId(uint64_t componentId)
 {
     auto itr = _ids.find(componentId);
     if (itr == _ids.end()) {
-        auto insarg = std::make_pair(componentId, _ids.size() % _executors.size());
+        size_t threadId = _ids.size() % _executors.size();
+        if (_rebalance) {
+            _lanes.push_back(std::make_unique<Lane>(threadId));
+        }
+        auto insarg = std::make_pair(componentId, _rebalance ? (_lanes.size() - 1) : threadId);
         auto insres = _ids.insert(insarg);
         assert(insres.second);
         itr = insres.first;
@@ -49,14 +101,64 @@ SequencedTaskExecutor::getExecutorId(uint64_t componentId)
 }
 
 void
-SequencedTaskExecutor::executeTask(uint32_t executorId, vespalib::Executor::Task::UP task)
+SequencedTaskExecutor::sampleLoad()
+{
+    std::fill(_executorLoad.begin(), _executorLoad.end(), 0);
+    for (auto &lane : _lanes) {
+        lane->load = lane->busyTime.exchange(0, std::memory_order_relaxed);
+        _executorLoad[lane->threadId] += lane->load;
+    }
+    _tasksSinceSample = 0;
+}
+
+void
+SequencedTaskExecutor::maybeMoveLane(Lane &lane)
 {
-    assert(executorId < _executors.size());
-    vespalib::ThreadStackExecutorBase &executor(*_executors[executorId]);
+    if (lane.load == 0) {
+        return;
+    }
+    uint32_t best = lane.threadId;
+    for (uint32_t threadId = 0; threadId < _executorLoad.size(); ++threadId) {
+        if (_executorLoad[threadId] < _executorLoad[best]) {
+            best = threadId;
+        }
+    }
+    if (_executorLoad[best] + lane.load < _executorLoad[lane.threadId]) {
+        _executorLoad[lane.threadId] -= lane.load;
+        _executorLoad[best] += lane.load;
+        lane.threadId = best;
+    }
+}
+
+void
+SequencedTaskExecutor::executeOnThread(uint32_t threadId, vespalib::Executor::Task::UP task)
+{
+    assert(threadId < _executors.size());
+    vespalib::ThreadStackExecutorBase &executor(*_executors[threadId]);
     auto rejectedTask = executor.execute(std::move(task));
     assert(!rejectedTask);
 }
 
+void
+SequencedTaskExecutor::executeTask(uint32_t executorId, vespalib::Executor::Task::UP task)
+{
+    if (!_rebalance) {
+        executeOnThread(executorId, std::move(task));
+        return;
+    }
+    assert(executorId < _lanes.size());
+    Lane &lane = *_lanes[executorId];
+    if (++_tasksSinceSample >= loadSampleInterval) {
+        sampleLoad();
+    }
+    // Only move a lane when all its previous tasks are done, to keep order
+    if (lane.pending.load(std::memory_order_acquire) == 0) {
+        maybeMoveLane(lane);
+    }
+    lane.pending.fetch_add(1, std::memory_order_relaxed);
+    executeOnThread(lane.threadId, std::make_unique<LaneTask>(lane, std::move(task)));
+}
+
 
 void
 SequencedTaskExecutor::sync()
@@ -66,5 +168,14 @@ SequencedTaskExecutor::sync()
     }
 }
 
+vespalib::ThreadStackExecutorBase::Stats
+SequencedTaskExecutor::getStats()
+{
+    vespalib::ThreadStackExecutorBase::Stats stats;
+    for (auto &executor : _executors) {
+        stats += executor->getStats();
+    }
+    return stats;
+}
 
 } // namespace search
@@ -18,15 +18,32 @@ namespace search
 /**
  * Class to run multiple tasks in parallel, but tasks with same
  * id has to be run in sequence.
+ *
+ * When rebalancing is enabled, each component id gets its own lane
+ * (the executor id handed out to callers) and the time spent running
+ * tasks is tracked per lane. A lane without pending tasks can be moved
+ * to a less loaded thread when its next task is scheduled, which keeps
+ * tasks with the same id in sequence while spreading hot components.
  */
 class SequencedTaskExecutor : public ISequencedTaskExecutor
 {
+    struct Lane;
+    class LaneTask;
+
     std::vector<std::shared_ptr<vespalib::BlockingThreadStackExecutor>> _executors;
     vespalib::hash_map<size_t, size_t> _ids;
+    bool _rebalance;
+    std::vector<std::unique_ptr<Lane>> _lanes;
+    std::vector<uint64_t> _executorLoad;   // busy time per thread in last sample
+    uint32_t _tasksSinceSample;
+
+    void sampleLoad();
+    void maybeMoveLane(Lane &lane);
+    void executeOnThread(uint32_t threadId, vespalib::Executor::Task::UP task);
 public:
     using ISequencedTaskExecutor::getExecutorId;
 
-    SequencedTaskExecutor(uint32_t threads, uint32_t taskLimit = 1000);
+    SequencedTaskExecutor(uint32_t threads, uint32_t taskLimit = 1000, bool rebalance = false);
 
     ~SequencedTaskExecutor();
 
@@ -37,6 +54,11 @@ public:
     virtual void executeTask(uint32_t executorId, vespalib::Executor::Task::UP task) override;
 
     virtual void sync() override;
+
+    /**
+     * Observe and reset stats, summed over all underlying executors.
+     */
+    vespalib::ThreadStackExecutorBase::Stats getStats();
 };
 
 } // namespace search
@@ -23,6 +23,15 @@ namespace {
 
 constexpr size_t MMAP_LIMIT = 0x2000000;
 
+// Only the best topn hits are put in order when they are fewer than 1/PARTIAL_SORT_FACTOR of all hits.
+constexpr uint64_t PARTIAL_SORT_FACTOR = 16;
+
+bool
+usePartialSort(uint32_t n, uint32_t topn)
+{
+    return (topn > 0) && (topn * PARTIAL_SORT_FACTOR < n);
+}
+
 template<typename T>
 class RadixHelper
 {
@@ -486,12 +495,71 @@ public:
 };
 
 
+bool
+FastS_SortSpec::hasFixedWidthPrefix() const
+{
+    if (_vectors.empty() || (_vectors[0]._type > DESC_VECTOR)) {
+        return false;
+    }
+    size_t width = _vectors[0]._vector->getFixedWidth();
+    return (width > 0) && (width <= sizeof(uint64_t));
+}
+
+uint64_t
+FastS_SortSpec::getPrefixKey(uint32_t docId) const
+{
+    const VectorRef & first = _vectors[0];
+    uint8_t buf[sizeof(uint64_t)] = {0};
+    if (first._type == ASC_VECTOR) {
+        first._vector->serializeForAscendingSort(docId, buf, sizeof(buf), first._converter);
+    } else {
+        first._vector->serializeForDescendingSort(docId, buf, sizeof(buf), first._converter);
+    }
+    uint64_t key(0);
+    for (uint8_t byte : buf) {
+        key = (key << 8) | byte;
+    }
+    return key;
+}
+
+/**
+ * Moves the hits that may end up among the best topn to the front of the array, and returns how many they are.
+ * The first sort level is a fixed width attribute, so its serialized sort key fits in an integer that
+ * orders the hits like the full key does. Hits with a first level key after the key of the topn'th hit can
+ * not be among the best topn and need neither the full key serialized nor to be sorted.
+ **/
+uint32_t
+FastS_SortSpec::selectTopCandidates(RankedHit a[], uint32_t n, uint32_t topn)
+{
+    Array<uint64_t> keys(n, Alloc::alloc(0, MMAP_LIMIT));
+    for (uint32_t i(0); i < n; ++i) {
+        keys[i] = getPrefixKey(a[i].getDocId());
+    }
+    Array<uint64_t> order(keys);
+    std::nth_element(order.begin(), order.begin() + (topn - 1), order.end());
+    const uint64_t limit = order[topn - 1];
+    uint32_t numCandidates(0);
+    for (uint32_t i(0); i < n; ++i) {
+        if (keys[i] <= limit) {
+            std::swap(a[numCandidates++], a[i]);
+        }
+    }
+    return numCandidates;
+}
+
 void
 FastS_SortSpec::sortResults(RankedHit a[], uint32_t n, uint32_t topn)
 {
+    bool partial = usePartialSort(n, topn);
+    if (partial && hasFixedWidthPrefix()) {
+        n = selectTopCandidates(a, n, topn);
+        partial = usePartialSort(n, topn);
+    }
     initSortData(a, n);
     SortData * sortData = &_sortDataArray[0];
-    if (_method == 0) {
+    if (partial) {
+        std::partial_sort(sortData, sortData + topn, sortData + n, StdSortDataCompare(&_binarySortData[0]));
+    } else if (_method == 0) {
         search::qsort<7, 40, SortData, FastS_SortSpec>(sortData, n, this);
     } else if (_method == 1) {
         std::sort(sortData, sortData + n, StdSortDataCompare(&_binarySortData[0]));
@@ -504,3 +572,33 @@ FastS_SortSpec::sortResults(RankedHit a[], uint32_t n, uint32_t topn)
         a[i]._docId = _sortDataArray[i]._docId;
     }
 }
+
+//-----------------------------------------------------------------------------
+
+FastS_SortKeyFilter::FastS_SortKeyFilter(const FastS_SortSpec &sortSpec, uint32_t ntop)
+    : _sortSpec(sortSpec),
+      _ntop(ntop),
+      _heap()
+{
+    _heap.reserve(ntop);
+}
+
+FastS_SortKeyFilter::~FastS_SortKeyFilter() = default;
+
+bool
+FastS_SortKeyFilter::accept(uint32_t docId)
+{
+    uint64_t key = _sortSpec.getPrefixKey(docId);
+    if (_heap.size() < _ntop) {
+        _heap.push_back(key);
+        std::push_heap(_heap.begin(), _heap.end());
+        return true;
+    }
+    if (key < _heap.front()) {
+        std::pop_heap(_heap.begin(), _heap.end());
+        _heap.back() = key;
+        std::push_heap(_heap.begin(), _heap.end());
+        return true;
+    }
+    return (key == _heap.front());
+}
@@ -131,6 +131,7 @@ private:
 
     bool Add(search::attribute::IAttributeContext & vecMan, const search::common::SortInfo & sInfo);
     void initSortData(const search::RankedHit *a, uint32_t n);
+    uint32_t selectTopCandidates(search::RankedHit a[], uint32_t n, uint32_t topn);
     uint8_t * realloc(uint32_t n, size_t & variableWidth, uint32_t & available, uint32_t & dataSize, uint8_t *mySortData);
 
 public:
@@ -152,6 +153,34 @@ public:
     bool hasSortData() const;
     void initWithoutSorting(const search::RankedHit * hits, uint32_t hitCnt);
     static int Compare(const FastS_SortSpec *self, const SortData &a, const SortData &b);
+    /**
+     * @return is the first sort level a fixed width attribute whose sort key fits in an integer?
+     **/
+    bool hasFixedWidthPrefix() const;
+    /**
+     * @return the first level sort key of the given document as an integer ordered like the full key.
+     **/
+    uint64_t getPrefixKey(uint32_t docId) const;
+};
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Keeps the first level sort keys of the best ntop hits seen so far in a bounded heap.
+ * Used while matching to skip hits that can not be among the best ntop hits.
+ * Hits tying with the worst of the best are accepted. ntop must be positive.
+ **/
+class FastS_SortKeyFilter
+{
+private:
+    const FastS_SortSpec  & _sortSpec;
+    uint32_t                _ntop;
+    std::vector<uint64_t>   _heap;
+
+public:
+    FastS_SortKeyFilter(const FastS_SortSpec &sortSpec, uint32_t ntop);
+    ~FastS_SortKeyFilter();
+    bool accept(uint32_t docId);
 };
 
 //-----------------------------------------------------------------------------
@@ -84,6 +84,28 @@ public:
         }
     }
     void remove(EntryRef ref);
+
+    /**
+     * Get a writable reference to an array that has already been added.
+     * Only the writer thread may use this, and only for updates where
+     * readers can observe each single element write, e.g. replacing
+     * one EntryRef with another.
+     */
+    vespalib::ArrayRef<EntryT> getWritable(EntryRef ref) {
+        if (!ref.valid()) {
+            return vespalib::ArrayRef<EntryT>();
+        }
+        RefT internalRef(ref);
+        uint32_t typeId = _store.getTypeId(internalRef.bufferId());
+        if (typeId != _largeArrayTypeId) {
+            size_t arraySize = getArraySize(typeId);
+            EntryT *buf = _store.template getBufferEntry<EntryT>(internalRef.bufferId(), internalRef.offset() * arraySize);
+            return vespalib::ArrayRef<EntryT>(buf, arraySize);
+        } else {
+            LargeArray *buf = _store.template getBufferEntry<LargeArray>(internalRef.bufferId(), internalRef.offset());
+            return vespalib::ArrayRef<EntryT>(&(*buf)[0], buf->size());
+        }
+    }
     ICompactionContext::UP compactWorst(bool compactMemory, bool compactAddressSpace);
     MemoryUsage getMemoryUsage() const { return _store.getMemoryUsage(); }
 
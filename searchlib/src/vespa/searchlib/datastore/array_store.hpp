@@ -39,6 +39,7 @@ ArrayStore<EntryT, RefT>::initArrayTypes(const ArrayStoreConfig &cfg)
         const AllocSpec &spec = cfg.specForSize(arraySize);
         _smallArrayTypes.push_back(std::make_unique<SmallArrayType>
                                            (arraySize, spec.minArraysInBuffer, spec.maxArraysInBuffer, spec.numArraysForNewBuffer));
+        _smallArrayTypes.back()->setUsePaging(cfg.usePaging());
         uint32_t typeId = _store.addType(_smallArrayTypes.back().get());
         assert(typeId == arraySize); // Enforce 1-to-1 mapping between type ids and sizes for small arrays
     }
@@ -35,6 +35,7 @@ public:
 
 private:
     AllocSpecVector _allocSpecs;
+    bool _usePaging;
 
     /**
      * Setup an array store with arrays of size [1-(allocSpecs.size()-1)] allocated in buffers and
@@ -53,6 +54,13 @@ public:
     size_t maxSmallArraySize() const { return _allocSpecs.size() - 1; }
     const AllocSpec &specForSize(size_t arraySize) const;
 
+    /**
+     * Allocate buffers for small arrays backed by files, see
+     * BufferTypeBase::setUsePaging(). Large arrays are always heap allocated.
+     */
+    ArrayStoreConfig &setUsePaging(bool usePaging) { _usePaging = usePaging; return *this; }
+    bool usePaging() const { return _usePaging; }
+
     /**
      * Generate a config that is optimized for the given memory huge page size.
      */
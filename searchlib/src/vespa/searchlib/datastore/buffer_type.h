@@ -25,6 +25,8 @@ protected:
     size_t _activeUsedElems;    // used elements in all but last active buffer
     size_t _holdUsedElems;  // used elements in all held buffers
     const size_t *_lastUsedElems; // used elements in last active buffer
+    bool _useHugePages;     // Allocate buffers backed by transparent huge pages
+    bool _usePaging;        // Allocate buffers backed by files, which can be paged out
 
 public:
     class CleanContext {
@@ -71,6 +73,19 @@ public:
     uint32_t getActiveBuffers() const { return _activeBuffers; }
     uint32_t getMaxClusters() const { return _maxClusters; }
     uint32_t getNumClustersForNewBuffer() const { return _numClustersForNewBuffer; }
+    bool useHugePages() const { return _useHugePages; }
+    /**
+     * Allocate new buffers aligned to huge pages and advised to be backed by
+     * transparent huge pages. Reduces TLB misses for large randomly accessed buffers.
+     */
+    void setUseHugePages(bool useHugePages) { _useHugePages = useHugePages; }
+    bool usePaging() const { return _usePaging; }
+    /**
+     * Allocate new buffers as shared mappings of temporary files. Only the
+     * recently accessed pages stay resident, cold pages are left to the
+     * kernel to write back and evict. Meant for large, rarely accessed data.
+     */
+    void setUsePaging(bool usePaging) { _usePaging = usePaging; }
 };
 
 
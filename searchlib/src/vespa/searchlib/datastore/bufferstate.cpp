@@ -72,7 +72,9 @@ BufferState::onActive(uint32_t bufferId, uint32_t typeId,
     size_t allocClusters = typeHandler->calcClustersToAlloc(bufferId, sizeNeeded, false);
     size_t allocSize = allocClusters * typeHandler->getClusterSize();
     assert(allocSize >= reservedElements + sizeNeeded);
-    _buffer.create(allocSize * typeHandler->elementSize()).swap(_buffer);
+    Alloc initialAlloc = typeHandler->usePaging() ? Alloc::allocPaged() :
+                         typeHandler->useHugePages() ? Alloc::allocHugePages() : Alloc::alloc();
+    initialAlloc.create(allocSize * typeHandler->elementSize()).swap(_buffer);
     buffer = _buffer.get();
     assert(buffer != NULL || allocSize == 0u);
     _allocElems = allocSize;
@@ -150,6 +150,9 @@ public:
     size_t getExtraUsedBytes() const { return _extraUsedBytes; }
     size_t getExtraHoldBytes() const { return _extraHoldBytes; }
     bool getCompacting() const { return _compacting; }
+    bool usesHugePages() const { return _buffer.usesHugePages(); }
+    bool isPaged() const { return _buffer.isPaged(); }
+    size_t residentBytes() const { return _buffer.residentSize(); }
     void setCompacting() { _compacting = true; }
     void fallbackResize(uint32_t bufferId, uint64_t sizeNeeded, void *&buffer, Alloc &holdBuffer);
 
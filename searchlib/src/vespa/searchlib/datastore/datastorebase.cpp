@@ -224,6 +224,9 @@ DataStoreBase::getMemoryUsage() const
     usage.setUsedBytes(stats._usedBytes);
     usage.setDeadBytes(stats._deadBytes);
     usage.setAllocatedBytesOnHold(stats._holdBytes);
+    usage.incAllocatedBytesOnHugePages(stats._hugePageBytes);
+    usage.incAllocatedBytesPaged(stats._pagedBytes);
+    usage.incResidentBytesPaged(stats._pagedResidentBytes);
     return usage;
 }
 
@@ -312,6 +315,13 @@ DataStoreBase::getMemStats() const
             stats._usedBytes += (bState.size() * elementSize) + bState.getExtraUsedBytes();
             stats._deadBytes += bState.getDeadElems() * elementSize;
             stats._holdBytes += (bState.getHoldElems() * elementSize) + bState.getExtraHoldBytes();
+            if (bState.usesHugePages()) {
+                stats._hugePageBytes += bState.capacity() * elementSize;
+            }
+            if (bState.isPaged()) {
+                stats._pagedBytes += bState.capacity() * elementSize;
+                stats._pagedResidentBytes += std::min(bState.residentBytes(), bState.capacity() * elementSize);
+            }
         } else if (state == BufferState::HOLD) {
             size_t elementSize = typeHandler->elementSize();
             ++stats._holdBuffers;
@@ -323,6 +333,13 @@ DataStoreBase::getMemStats() const
             stats._usedBytes += (bState.size() * elementSize) + bState.getExtraUsedBytes();
             stats._deadBytes += bState.getDeadElems() * elementSize;
             stats._holdBytes += (bState.getHoldElems() * elementSize) + bState.getExtraHoldBytes();
+            if (bState.usesHugePages()) {
+                stats._hugePageBytes += bState.capacity() * elementSize;
+            }
+            if (bState.isPaged()) {
+                stats._pagedBytes += bState.capacity() * elementSize;
+                stats._pagedResidentBytes += std::min(bState.residentBytes(), bState.capacity() * elementSize);
+            }
         } else {
             abort();
         }
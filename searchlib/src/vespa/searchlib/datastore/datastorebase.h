@@ -97,6 +97,9 @@ public:
         uint64_t _usedBytes;
         uint64_t _deadBytes;
         uint64_t _holdBytes;
+        uint64_t _hugePageBytes;
+        uint64_t _pagedBytes;
+        uint64_t _pagedResidentBytes;
         uint32_t _freeBuffers;
         uint32_t _activeBuffers;
         uint32_t _holdBuffers;
@@ -110,6 +113,9 @@ public:
               _usedBytes(0),
               _deadBytes(0),
               _holdBytes(0),
+              _hugePageBytes(0),
+              _pagedBytes(0),
+              _pagedResidentBytes(0),
               _freeBuffers(0),
               _activeBuffers(0),
               _holdBuffers(0)
@@ -126,6 +132,9 @@ public:
             _usedBytes += rhs._usedBytes;
             _deadBytes += rhs._deadBytes;
             _holdBytes += rhs._holdBytes;
+            _hugePageBytes += rhs._hugePageBytes;
+            _pagedBytes += rhs._pagedBytes;
+            _pagedResidentBytes += rhs._pagedResidentBytes;
             _freeBuffers += rhs._freeBuffers;
             _activeBuffers += rhs._activeBuffers;
             _holdBuffers += rhs._holdBuffers;
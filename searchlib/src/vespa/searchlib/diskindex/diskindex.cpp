@@ -414,6 +414,7 @@ public:
     void visit(SuffixTerm &n)    override { visitTerm(n); }
     void visit(RegExpTerm &n)    override { visitTerm(n); }
     void visit(PredicateQuery &) override { }
+    void visit(NearestNeighborTerm &) override { }
 };
 
 
@@ -9,6 +9,9 @@
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/searchlib/common/documentsummary.h>
 #include <vespa/vespalib/util/error.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <atomic>
 #include <sstream>
 
 #include <vespa/log/log.h>
@@ -25,6 +28,7 @@ using search::index::Schema;
 using search::index::SchemaUtil;
 using search::index::schema::DataType;
 using vespalib::getLastErrorString;
+using vespalib::makeLambdaTask;
 
 
 namespace search {
@@ -43,7 +47,6 @@ Fusion::Fusion(bool dynamicKPosIndexFormat,
     : _schema(NULL),
       _oldIndexes(),
       _docIdLimit(0u),
-      _numWordIds(0u),
       _dynamicKPosIndexFormat(dynamicKPosIndexFormat),
       _outDir("merged"),
       _tuneFileIndexing(tuneFileIndexing),
@@ -53,7 +56,6 @@ Fusion::Fusion(bool dynamicKPosIndexFormat,
 
 Fusion::~Fusion()
 {
-    ReleaseMappingTables();
 }
 
 
@@ -103,7 +105,7 @@ Fusion::openInputWordReaders(const SchemaUtil::IndexIterator &index,
     for (auto &i : getOldIndexes()) {
         OldIndex &oi = *i;
         auto reader(std::make_unique<DictionaryWordReader>());
-        const vespalib::string &tmpindexpath = oi.getTmpPath();
+        const vespalib::string tmpindexpath = getFieldTmpPath(oi, index.getName());
         const vespalib::string &oldindexpath = oi.getPath();
         vespalib::string wordMapName = tmpindexpath + "/old2new.dat";
         vespalib::string fieldDir(oldindexpath + "/" + index.getName());
@@ -131,7 +133,9 @@ Fusion::openInputWordReaders(const SchemaUtil::IndexIterator &index,
 
 
 bool
-Fusion::renumberFieldWordIds(const SchemaUtil::IndexIterator &index)
+Fusion::renumberFieldWordIds(const SchemaUtil::IndexIterator &index,
+                             WordNumMappingList &list,
+                             uint64_t &numWordIds)
 {
     vespalib::string indexName = index.getName();
     LOG(debug, "Renumber word IDs for field %s", indexName.c_str());
@@ -146,7 +150,7 @@ Fusion::renumberFieldWordIds(const SchemaUtil::IndexIterator &index)
 
     heap.merge(out, 4);
     assert(heap.empty());
-    _numWordIds = out.getWordNum();
+    numWordIds = out.getWordNum();
 
     // Close files
     for (auto &i : readers) {
@@ -155,7 +159,7 @@ Fusion::renumberFieldWordIds(const SchemaUtil::IndexIterator &index)
 
     // Now read mapping files back into an array
     // XXX: avoid this, and instead make the array here
-    if (!ReadMappingFiles(&index))
+    if (!ReadMappingFiles(index, list))
         return false;
 
     LOG(debug, "Finished renumbering words IDs for field %s",
@@ -166,16 +170,36 @@ Fusion::renumberFieldWordIds(const SchemaUtil::IndexIterator &index)
 
 
 bool
-Fusion::mergeFields()
+Fusion::mergeFields(uint32_t numThreads)
 {
-   typedef SchemaUtil::IndexIterator IndexIterator;
+    typedef SchemaUtil::IndexIterator IndexIterator;
 
     const Schema &schema = getSchema();
-    for (IndexIterator index(schema); index.isValid(); ++index) {
-        if (!mergeField(index.getIndex()))
-            return false;
+    uint32_t numFields = schema.getNumIndexFields();
+    if (numThreads <= 1 || numFields <= 1) {
+        for (IndexIterator index(schema); index.isValid(); ++index) {
+            if (!mergeField(index.getIndex()))
+                return false;
+        }
+        return CleanTmpDirs();
     }
-    return true;
+    std::atomic<bool> failed(false);
+    {
+        vespalib::ThreadStackExecutor executor(std::min(numThreads, numFields),
+                                               128 * 1024);
+        for (IndexIterator index(schema); index.isValid(); ++index) {
+            uint32_t id = index.getIndex();
+            executor.execute(makeLambdaTask([this, id, &failed]() {
+                if (!failed && !mergeField(id)) {
+                    failed = true;
+                }
+            }));
+        }
+        executor.sync();
+    }
+    if (failed)
+        return false;
+    return CleanTmpDirs();
 }
 
 
@@ -201,16 +225,18 @@ Fusion::mergeField(uint32_t id)
     LOG(debug, "mergeField for field %s dir %s",
         indexName.c_str(), indexDir.c_str());
 
-    makeTmpDirs();
+    makeTmpDirs(indexName);
 
-    if (!renumberFieldWordIds(index)) {
+    WordNumMappingList list(_oldIndexes.size());
+    uint64_t numWordIds = 0;
+    if (!renumberFieldWordIds(index, list, numWordIds)) {
         LOG(error, "Could not renumber field word ids for field %s dir %s",
             indexName.c_str(), indexDir.c_str());
         return false;
     }
 
     // Tokamak
-    bool res = mergeFieldPostings(index);
+    bool res = mergeFieldPostings(index, list, numWordIds);
     if (!res) {
         LOG(error, "Could not merge field postings for field %s dir %s",
             indexName.c_str(), indexDir.c_str());
@@ -219,7 +245,7 @@ Fusion::mergeField(uint32_t id)
     if (!FileKit::createStamp(indexDir +  "/.mergeocc_done"))
         return false;
 
-    if (!CleanTmpDirs())
+    if (!cleanFieldTmpDirs(indexName))
         return false;
 
     LOG(debug, "Finished mergeField for field %s dir %s",
@@ -285,18 +311,19 @@ Fusion::selectCookedOrRawFeatures(Reader &reader, Writer &writer)
 
 bool
 Fusion::openInputFieldReaders(const SchemaUtil::IndexIterator &index,
+                              const WordNumMappingList &list,
                               std::vector<std::unique_ptr<FieldReader> > &
                               readers)
 {
     vespalib::string indexName = index.getName();
-    for (auto &i : _oldIndexes) {
-        OldIndex &oi = *i;
+    for (uint32_t i = 0; i < _oldIndexes.size(); ++i) {
+        OldIndex &oi = *_oldIndexes[i];
         const Schema &oldSchema = oi.getSchema();
         if (!index.hasOldFields(oldSchema, false)) {
             continue; // drop data
         }
         auto reader = FieldReader::allocFieldReader(index, oldSchema);
-        reader->setup(oi.getWordNumMapping(),
+        reader->setup(list[i],
                       oi.getDocIdMapping());
         if (!reader->open(oi.getPath() + "/" +
                           indexName + "/",
@@ -350,15 +377,17 @@ Fusion::setupMergeHeap(const std::vector<std::unique_ptr<FieldReader> > &
 
 
 bool
-Fusion::mergeFieldPostings(const SchemaUtil::IndexIterator &index)
+Fusion::mergeFieldPostings(const SchemaUtil::IndexIterator &index,
+                           const WordNumMappingList &list,
+                           uint64_t numWordIds)
 {
     std::vector<std::unique_ptr<FieldReader>> readers;
     PostingPriorityQueue<FieldReader> heap;
     /* OUTPUT */
-    FieldWriter fieldWriter(_docIdLimit, _numWordIds);
+    FieldWriter fieldWriter(_docIdLimit, numWordIds);
     vespalib::string indexName = index.getName();
 
-    if (!openInputFieldReaders(index, readers))
+    if (!openInputFieldReaders(index, list, readers))
         return false;
     if (!openFieldWriter(index, fieldWriter))
         return false;
@@ -382,15 +411,14 @@ Fusion::mergeFieldPostings(const SchemaUtil::IndexIterator &index)
 
 
 bool
-Fusion::ReadMappingFiles(const SchemaUtil::IndexIterator *index)
+Fusion::ReadMappingFiles(const SchemaUtil::IndexIterator &index,
+                         WordNumMappingList &list)
 {
-    ReleaseMappingTables();
-
     size_t numberOfOldIndexes = _oldIndexes.size();
     for (uint32_t i = 0; i < numberOfOldIndexes; i++)
     {
         OldIndex &oi = *_oldIndexes[i];
-        WordNumMapping &wordNumMapping = oi.getWordNumMapping();
+        WordNumMapping &wordNumMapping = list[i];
         std::vector<uint32_t> oldIndexes;
         const Schema &oldSchema = oi.getSchema();
         if (!SchemaUtil::getIndexIds(oldSchema,
@@ -401,41 +429,51 @@ Fusion::ReadMappingFiles(const SchemaUtil::IndexIterator *index)
             wordNumMapping.noMappingFile();
             continue;
         }
-        if (index && !index->hasOldFields(oldSchema, false)) {
+        if (!index.hasOldFields(oldSchema, false)) {
             continue; // drop data
         }
 
-        // Open word mapping file
-        vespalib::string old2newname = oi.getTmpPath() + "/old2new.dat";
-        wordNumMapping.readMappingFile(old2newname, _tuneFileIndexing._read);
+        // Word mapping file is streamed by the field readers
+        vespalib::string old2newname = getFieldTmpPath(oi, index.getName()) + "/old2new.dat";
+        wordNumMapping.setupMappingFile(old2newname, _tuneFileIndexing._read);
     }
 
     return true;
 }
 
 
-bool
-Fusion::ReleaseMappingTables()
+vespalib::string
+Fusion::getFieldTmpPath(const OldIndex &oldIndex,
+                        const vespalib::string &indexName) const
 {
-    size_t numberOfOldIndexes = _oldIndexes.size();
-    for (uint32_t i = 0; i < numberOfOldIndexes; i++)
-    {
-        OldIndex &oi = *_oldIndexes[i];
-        oi.getWordNumMapping().clear();
-    }
-    return true;
+    return oldIndex.getTmpPath() + "/" + indexName;
 }
 
 
 void
-Fusion::makeTmpDirs()
+Fusion::makeTmpDirs(const vespalib::string &indexName)
 {
     for (auto &i : getOldIndexes()) {
         OldIndex &oi = *i;
-        // Make tmpindex directories
-        const vespalib::string &tmpindexpath = oi.getTmpPath();
-        vespalib::mkdir(tmpindexpath, false);
+        // Make tmpindex directories, one sub directory per field
+        vespalib::mkdir(oi.getTmpPath(), false);
+        vespalib::mkdir(getFieldTmpPath(oi, indexName), false);
+    }
+}
+
+
+bool
+Fusion::cleanFieldTmpDirs(const vespalib::string &indexName)
+{
+    for (auto &i : getOldIndexes()) {
+        vespalib::string tmpindexpath = getFieldTmpPath(*i, indexName);
+        search::DirectoryTraverse dt(tmpindexpath.c_str());
+        if (!dt.RemoveTree()) {
+            LOG(error, "Failed to clean tmpdir %s", tmpindexpath.c_str());
+            return false;
+        }
     }
+    return true;
 }
 
 bool
@@ -514,7 +552,8 @@ Fusion::merge(const Schema &schema,
               const SelectorArray &selector,
               bool dynamicKPosOccFormat,
               const TuneFileIndexing &tuneFileIndexing,
-              const FileHeaderContext &fileHeaderContext)
+              const FileHeaderContext &fileHeaderContext,
+              uint32_t numThreads)
 {
     assert(sources.size() <= 255);
     uint32_t docIdLimit = selector.size();
@@ -583,7 +622,7 @@ Fusion::merge(const Schema &schema,
                            idx);
     }
     fusion->setDocIdLimit(trimmedDocIdLimit);
-    if (!fusion->mergeFields())
+    if (!fusion->mergeFields(numThreads))
         return false;
     return true;
 }
@@ -3,7 +3,10 @@
 #include "pagedict4randread.h"
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/data/fileheader.h>
+#include <vespa/vespalib/stllike/hash_fun.h>
 #include <vespa/fastos/file.h>
+#include <atomic>
+#include <sys/mman.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".diskindex.pagedict4randread");
@@ -14,6 +17,36 @@ vespalib::string myPId("PageDict4P.1");
 vespalib::string mySPId("PageDict4SP.1");
 vespalib::string mySSId("PageDict4SS.1");
 
+/*
+ * Small direct mapped cache of recent lookup results, one per thread.
+ * Entries are tagged with the id of the dictionary instance that
+ * produced them, and ids are never reused, thus entries belonging to
+ * closed dictionaries are never returned.
+ */
+struct LookupCacheEntry
+{
+    uint64_t _dictId;
+    vespalib::string _word;
+    bool _res;
+    uint64_t _wordNum;
+    search::index::PostingListOffsetAndCounts _offsetAndCounts;
+
+    LookupCacheEntry()
+        : _dictId(0u),
+          _word(),
+          _res(false),
+          _wordNum(0u),
+          _offsetAndCounts()
+    {
+    }
+};
+
+constexpr size_t lookupCacheSize = 64;
+
+thread_local LookupCacheEntry lookupCache[lookupCacheSize];
+
+std::atomic<uint64_t> nextLookupCacheId(1u);
+
 }
 
 using vespalib::getLastErrorString;
@@ -36,7 +69,8 @@ PageDict4RandRead::PageDict4RandRead()
       _pFileBitSize(0u),
       _ssHeaderLen(0u),
       _spHeaderLen(0u),
-      _pHeaderLen(0u)
+      _pHeaderLen(0u),
+      _lookupCacheId(0u)
 {
     _ssd.setReadContext(&_ssReadContext);
 }
@@ -149,6 +183,27 @@ bool
 PageDict4RandRead::lookup(const vespalib::stringref &word,
                           uint64_t &wordNum,
                           PostingListOffsetAndCounts &offsetAndCounts)
+{
+    if (_lookupCacheId == 0u) {
+        return lookupUncached(word, wordNum, offsetAndCounts);
+    }
+    LookupCacheEntry &entry = lookupCache[vespalib::hashValue(word.c_str(), word.size()) % lookupCacheSize];
+    if (entry._dictId != _lookupCacheId || entry._word != word) {
+        entry._dictId = 0u;
+        entry._res = lookupUncached(word, entry._wordNum, entry._offsetAndCounts);
+        entry._word = word;
+        entry._dictId = _lookupCacheId;
+    }
+    wordNum = entry._wordNum;
+    offsetAndCounts = entry._offsetAndCounts;
+    return entry._res;
+}
+
+
+bool
+PageDict4RandRead::lookupUncached(const vespalib::stringref &word,
+                                  uint64_t &wordNum,
+                                  PostingListOffsetAndCounts &offsetAndCounts)
 {
     SSLookupRes ssRes(_ssReader->lookup(word));
     if (!ssRes._res) {
@@ -201,6 +256,20 @@ PageDict4RandRead::lookup(const vespalib::stringref &word,
 }
 
 
+void
+PageDict4RandRead::prefetchSparsePages()
+{
+    size_t spSize = _spfile->GetSize();
+    void *spData = _spfile->MemoryMapPtr(0);
+    if (spData != nullptr && spSize > 0) {
+        int eCode = posix_madvise(spData, spSize, POSIX_MADV_WILLNEED);
+        if (eCode != 0) {
+            LOG(warning, "posix_madvise(WILLNEED) of %s failed: %d", _spfile->GetFileName(), eCode);
+        }
+    }
+}
+
+
 bool
 PageDict4RandRead::open(const vespalib::string &name,
                         const TuneFileRandRead &tuneFileRead)
@@ -214,6 +283,8 @@ PageDict4RandRead::open(const vespalib::string &name,
         _ssfile->enableMemoryMap(mmapFlags);
         _spfile->enableMemoryMap(mmapFlags);
         _pfile->enableMemoryMap(mmapFlags);
+        _spfile->setFAdviseOptions(tuneFileRead.getAdvise());
+        _pfile->setFAdviseOptions(tuneFileRead.getAdvise());
     } else if (tuneFileRead.getWantDirectIO()) {
         _ssfile->EnableDirectIO();
         _spfile->EnableDirectIO();
@@ -249,6 +320,11 @@ PageDict4RandRead::open(const vespalib::string &name,
                                            _spFileBitSize, _pHeaderLen, _pFileBitSize);
     _ssReader->setup(_ssd);
 
+    if (tuneFileRead.getWantMemoryMap()) {
+        // Sparse pages are touched by almost every lookup, page in up front.
+        prefetchSparsePages();
+        _lookupCacheId = nextLookupCacheId++;
+    }
     return true;
 }
 
@@ -256,6 +332,7 @@ PageDict4RandRead::open(const vespalib::string &name,
 bool
 PageDict4RandRead::close()
 {
+    _lookupCacheId = 0u;
     _ssReader.reset();
 
     _ssReadContext.dropComprBuf();
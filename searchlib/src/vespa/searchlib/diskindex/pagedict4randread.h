@@ -38,10 +38,14 @@ class PageDict4RandRead : public index::DictionaryFileRandRead
     uint32_t _ssHeaderLen;
     uint32_t _spHeaderLen;
     uint32_t _pHeaderLen;
+    uint64_t _lookupCacheId; // 0 when per-thread lookup cache is disabled
 
     void readSSHeader();
     void readSPHeader();
     void readPHeader();
+    bool lookupUncached(const vespalib::stringref &word, uint64_t &wordNum,
+                        PostingListOffsetAndCounts &offsetAndCounts);
+    void prefetchSparsePages();
 public:
     PageDict4RandRead();
     ~PageDict4RandRead();
@@ -6,9 +6,17 @@
 
 namespace search::diskindex {
 
+namespace {
+
+const size_t STREAMED_MAPPING_BUFFER_SIZE = 0x10000;
+
+}
+
 WordNumMapping::WordNumMapping()
     : _old2newwords(),
-      _oldDictSize(0u)
+      _oldDictSize(0u),
+      _mappingFileName(),
+      _tuneFileRead()
 {
 }
 
@@ -17,6 +25,7 @@ void
 WordNumMapping::readMappingFile(const vespalib::string &name,
                                 const TuneFileSeqRead &tuneFileRead)
 {
+    _mappingFileName.clear();
     // Open word mapping file
     Fast_BufferedFile old2newwordfile(new FastOS_File);
     if (tuneFileRead.getWantDirectIO())
@@ -38,9 +47,24 @@ WordNumMapping::readMappingFile(const vespalib::string &name,
 }
 
 
+void
+WordNumMapping::setupMappingFile(const vespalib::string &name,
+                                 const TuneFileSeqRead &tuneFileRead)
+{
+    _old2newwords.clear();
+    FastOS_StatInfo statInfo;
+    // XXX no checking for success
+    FastOS_File::Stat(name.c_str(), &statInfo);
+    _oldDictSize = static_cast<uint64_t>(statInfo._size / sizeof(uint64_t));
+    _mappingFileName = name;
+    _tuneFileRead = tuneFileRead;
+}
+
+
 void
 WordNumMapping::noMappingFile()
 {
+    _mappingFileName.clear();
     Array &map = _old2newwords;
     map.resize(2);
     map[0] = noWordNum();
@@ -55,6 +79,7 @@ WordNumMapping::clear()
     Array &map = _old2newwords;
     map.clear();
     _oldDictSize = 0;
+    _mappingFileName.clear();
 }
 
 
@@ -65,6 +90,66 @@ WordNumMapping::setup(uint32_t numWordIds)
 }
 
 
+WordNumMapper::WordNumMapper()
+    : _old2newwords(NULL),
+      _oldDictSize(0),
+      _mappingFile(),
+      _streamedWordNum(0),
+      _streamedMappedWordNum(0)
+{
+}
+
+
+WordNumMapper::WordNumMapper(const WordNumMapping &mapping)
+    : WordNumMapper()
+{
+    setup(mapping);
+}
+
+
+WordNumMapper::~WordNumMapper()
+{
+}
+
+
+void
+WordNumMapper::setup(const WordNumMapping &mapping)
+{
+    _old2newwords = mapping.getOld2NewWordNums();
+    _oldDictSize = mapping.getOldDictSize();
+    _mappingFile.reset();
+    _streamedWordNum = 0;
+    _streamedMappedWordNum = noWordNum();
+    if (_old2newwords == NULL && !mapping.getMappingFileName().empty()) {
+        _mappingFile = std::make_unique<Fast_BufferedFile>(new FastOS_File, STREAMED_MAPPING_BUFFER_SIZE);
+        if (mapping.getTuneFileRead().getWantDirectIO())
+            _mappingFile->EnableDirectIO();
+        // XXX no checking for success
+        _mappingFile->ReadOpen(mapping.getMappingFileName().c_str());
+    }
+}
+
+
+uint64_t
+WordNumMapper::mapStreamed(uint64_t wordNum)
+{
+    if (wordNum == 0u) {
+        return noWordNum();
+    }
+    if (wordNum > _oldDictSize) {
+        return noWordNumHigh();
+    }
+    assert(wordNum >= _streamedWordNum);
+    while (_streamedWordNum < wordNum) {
+        ssize_t readRes = _mappingFile->Read(&_streamedMappedWordNum, sizeof(_streamedMappedWordNum));
+        assert(readRes == static_cast<ssize_t>(sizeof(_streamedMappedWordNum)));
+        (void) readRes;
+        ++_streamedWordNum;
+    }
+    return _streamedMappedWordNum;
+}
+
+
 void
 WordNumMapper::sanityCheck(bool allowHoles)
 {
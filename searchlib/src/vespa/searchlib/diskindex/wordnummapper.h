@@ -5,6 +5,9 @@
 #include <vespa/vespalib/util/array.h>
 #include <vespa/vespalib/stllike/string.h>
 #include <limits>
+#include <memory>
+
+class Fast_BufferedFile;
 
 namespace search::diskindex {
 
@@ -22,6 +25,8 @@ class WordNumMapping
 
     Array _old2newwords;
     uint64_t _oldDictSize;
+    vespalib::string _mappingFileName; // Non-empty when mapping is streamed
+    TuneFileSeqRead _tuneFileRead;
 public:
 
     WordNumMapping();
@@ -33,7 +38,15 @@ public:
     }
 
     uint64_t getOldDictSize() const { return _oldDictSize; }
+    const vespalib::string &getMappingFileName() const { return _mappingFileName; }
+    const TuneFileSeqRead &getTuneFileRead() const { return _tuneFileRead; }
     void readMappingFile(const vespalib::string &name, const TuneFileSeqRead &tuneFileRead);
+    /*
+     * Use the mapping file without reading it into memory. Each mapper
+     * set up from this mapping streams the file through a small buffer,
+     * and must then map word numbers in increasing order.
+     */
+    void setupMappingFile(const vespalib::string &name, const TuneFileSeqRead &tuneFileRead);
     void noMappingFile();
     void clear();
     void setup(uint32_t numWordIds);
@@ -52,33 +65,27 @@ class WordNumMapper
 
     const uint64_t *_old2newwords;
     uint64_t _oldDictSize;
+    std::unique_ptr<Fast_BufferedFile> _mappingFile; // Streamed mapping
+    uint64_t _streamedWordNum;     // Last word number read from _mappingFile
+    uint64_t _streamedMappedWordNum;
 
+    uint64_t mapStreamed(uint64_t wordNum);
 public:
-    WordNumMapper()
-        : _old2newwords(NULL),
-          _oldDictSize(0)
-    {}
-
-    WordNumMapper(const WordNumMapping &mapping)
-        : _old2newwords(NULL),
-          _oldDictSize(0)
-    {
-        setup(mapping);
-    }
+    WordNumMapper();
+    WordNumMapper(const WordNumMapping &mapping);
+    ~WordNumMapper();
 
-    void setup(const WordNumMapping &mapping) {
-        _old2newwords = mapping.getOld2NewWordNums();
-        _oldDictSize = mapping.getOldDictSize();
-    }
+    void setup(const WordNumMapping &mapping);
 
-    uint64_t map(uint32_t wordNum) const {
-        return (_old2newwords != NULL)
-            ? _old2newwords[wordNum]
-            : wordNum;
+    uint64_t map(uint32_t wordNum) {
+        if (_old2newwords != NULL) {
+            return _old2newwords[wordNum];
+        }
+        return _mappingFile ? mapStreamed(wordNum) : wordNum;
     }
 
     uint64_t getMaxWordNum() const { return _oldDictSize; }
-    uint64_t getMaxMappedWordNum() const { return map(_oldDictSize); }
+    uint64_t getMaxMappedWordNum() { return map(_oldDictSize); }
     void sanityCheck(bool allowHoles);
 };
 
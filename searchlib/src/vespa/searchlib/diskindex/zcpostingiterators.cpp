@@ -16,6 +16,38 @@ using queryeval::RankedSearchIteratorBase;
 #define DEBUG_ZCPOSTING_PRINTF 0
 #define DEBUG_ZCPOSTING_ASSERT 0
 
+namespace {
+
+/*
+ * Skip groups of 8 docid deltas that are all encoded in a single byte,
+ * testing and summing the 8 bytes at once within a 64-bit word, as long
+ * as the last docid in the group is below the seek target.  Common
+ * words mostly have single byte docid deltas.
+ */
+const uint8_t *
+skipSmallDocIdDeltas(const uint8_t *valI, const uint8_t *valIEnd,
+                     uint32_t &oDocId, uint32_t docId, uint32_t &skipped)
+{
+    while (docId - oDocId > 8 && valI + 8 <= valIEnd) {
+        uint64_t deltas;
+        memcpy(&deltas, valI, sizeof(deltas));
+        if ((deltas & 0x8080808080808080ul) != 0) {
+            break;  // Multi byte delta in group
+        }
+        deltas = (deltas & 0x00ff00ff00ff00fful) + ((deltas >> 8) & 0x00ff00ff00ff00fful);
+        uint32_t lastDocId = oDocId + 8 + static_cast<uint32_t>((deltas * 0x0001000100010001ul) >> 48);
+        if (lastDocId >= docId) {
+            break;
+        }
+        oDocId = lastDocId;
+        valI += 8;
+        skipped += 8;
+    }
+    return valI;
+}
+
+}
+
 ZcIteratorBase::ZcIteratorBase(const TermFieldMatchDataArray &matchData, Position start, uint32_t docIdLimit) :
     RankedSearchIteratorBase(matchData),
     _docIdLimit(docIdLimit),
@@ -208,6 +240,7 @@ ZcPostingIteratorBase::ZcPostingIteratorBase(const TermFieldMatchDataArray &matc
     : ZcIteratorBase(matchData, start, docIdLimit),
       _valI(NULL),
       _valIBase(NULL),
+      _valIEnd(NULL),
       _featureSeekPos(0),
       _l1(),
       _l2(),
@@ -312,6 +345,7 @@ ZcPostingIterator<bigEndian>::readWordStart(uint32_t docIdLimit)
     const uint8_t *bcompr = d.getByteCompr();
     _valIBase = _valI = bcompr;
     bcompr += docIdsSize;
+    _valIEnd = bcompr;
     _l1.setup(prevDocId, _chunk._lastDocId, bcompr, l1SkipSize);
     _l2.setup(prevDocId, _chunk._lastDocId, bcompr, l2SkipSize);
     _l3.setup(prevDocId, _chunk._lastDocId, bcompr, l3SkipSize);
@@ -542,6 +576,11 @@ ZcPostingIteratorBase::doSeek(uint32_t docId)
     assert(docId <= _l4._skipDocId);
 #endif
     const uint8_t *oCompr = _valI;
+    if (oDocId < docId && docId - oDocId > 8) {
+        uint32_t skipped = 0;
+        oCompr = skipSmallDocIdDeltas(oCompr, _valIEnd, oDocId, docId, skipped);
+        incNeedUnpack(skipped);
+    }
     while (__builtin_expect(oDocId < docId, true)) {
 #if DEBUG_ZCPOSTING_ASSERT
         assert(oDocId <= _l1._skipDocId);
@@ -108,6 +108,7 @@ class ZcPostingIteratorBase : public ZcIteratorBase
 protected:
     const uint8_t *_valI;     // docid deltas
     const uint8_t *_valIBase; // start of docid deltas
+    const uint8_t *_valIEnd;  // end of docid deltas
     uint64_t _featureSeekPos;
 
     // Helper class for L1 skip info
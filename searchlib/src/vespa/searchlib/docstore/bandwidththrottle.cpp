@@ -0,0 +1,37 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "bandwidththrottle.h"
+#include <cassert>
+#include <thread>
+
+namespace search::docstore {
+
+BandwidthThrottle::BandwidthThrottle(size_t maxBytesPerSecond)
+    : _maxBytesPerSecond(maxBytesPerSecond),
+      _lock(),
+      _next()
+{
+    assert(maxBytesPerSecond > 0);
+}
+
+BandwidthThrottle::~BandwidthThrottle() { }
+
+BandwidthThrottle::Clock::duration
+BandwidthThrottle::consume(size_t bytes, Clock::time_point now)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    Clock::time_point start = std::max(_next, now);
+    _next = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(double(bytes) / _maxBytesPerSecond));
+    return start - now;
+}
+
+void
+BandwidthThrottle::throttle(size_t bytes)
+{
+    Clock::duration delay = consume(bytes, Clock::now());
+    if (delay > Clock::duration::zero()) {
+        std::this_thread::sleep_for(delay);
+    }
+}
+
+}
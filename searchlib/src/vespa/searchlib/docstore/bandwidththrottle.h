@@ -0,0 +1,35 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+
+namespace search::docstore {
+
+/**
+ * Limits the rate of background IO, e.g. reads done by compaction, to a number of bytes per second.
+ * Callers are delayed so that the bytes consumed so far are spread evenly over time.
+ * Time spent idle is not saved up, so an idle period is not followed by a burst.
+ */
+class BandwidthThrottle
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    BandwidthThrottle(size_t maxBytesPerSecond);
+    ~BandwidthThrottle();
+    /**
+     * Account for the given bytes consumed at the given time.
+     * @return how long the caller should wait before consuming them.
+     */
+    Clock::duration consume(size_t bytes, Clock::time_point now);
+    /** Account for the given bytes and sleep as long as required. */
+    void throttle(size_t bytes);
+    size_t getMaxBytesPerSecond() const { return _maxBytesPerSecond; }
+private:
+    const size_t      _maxBytesPerSecond;
+    std::mutex        _lock;
+    Clock::time_point _next;
+};
+
+}
@@ -0,0 +1,87 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "bucketorderedwritebuffer.h"
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <algorithm>
+
+namespace search::docstore {
+
+using document::BucketId;
+
+namespace {
+
+struct Order {
+    uint64_t _bucketKey;
+    uint64_t _serialNum;
+    uint32_t _lid;
+    bool operator < (const Order & rhs) const {
+        if (_bucketKey != rhs._bucketKey) {
+            return _bucketKey < rhs._bucketKey;
+        }
+        return _serialNum < rhs._serialNum;
+    }
+};
+
+}
+
+BucketOrderedWriteBuffer::BucketOrderedWriteBuffer()
+    : _entries(),
+      _sizeBytes(0),
+      _maxSerialNum(0)
+{ }
+
+BucketOrderedWriteBuffer::~BucketOrderedWriteBuffer() { }
+
+void
+BucketOrderedWriteBuffer::add(uint64_t serialNum, uint32_t lid, const void *buffer, size_t sz)
+{
+    remove(lid);
+    _entries[lid] = Entry(serialNum, buffer, sz);
+    _sizeBytes += sz;
+    _maxSerialNum = std::max(_maxSerialNum, serialNum);
+}
+
+bool
+BucketOrderedWriteBuffer::remove(uint32_t lid)
+{
+    auto found = _entries.find(lid);
+    if (found == _entries.end()) {
+        return false;
+    }
+    _sizeBytes -= found->second._data.size();
+    _entries.erase(found);
+    return true;
+}
+
+ssize_t
+BucketOrderedWriteBuffer::read(uint32_t lid, vespalib::DataBuffer & buffer) const
+{
+    auto found = _entries.find(lid);
+    if (found == _entries.end()) {
+        return -1;
+    }
+    const std::vector<char> & data = found->second._data;
+    buffer.writeBytes(data.data(), data.size());
+    return data.size();
+}
+
+void
+BucketOrderedWriteBuffer::drain(const IBucketizer * bucketizer, IWrite & writer)
+{
+    std::vector<Order> order;
+    order.reserve(_entries.size());
+    vespalib::GenerationHandler::Guard guard(bucketizer ? bucketizer->getGuard() : vespalib::GenerationHandler::Guard());
+    for (const auto & entry : _entries) {
+        uint64_t bucketKey = bucketizer ? bucketizer->getBucketOf(guard, entry.first).toKey() : 0;
+        order.push_back(Order{bucketKey, entry.second._serialNum, entry.first});
+    }
+    std::sort(order.begin(), order.end());
+    for (const Order & o : order) {
+        const Entry & entry = _entries[o._lid];
+        writer.write(entry._serialNum, o._lid, entry._data.data(), entry._data.size());
+    }
+    _entries.clear();
+    _sizeBytes = 0;
+}
+
+}
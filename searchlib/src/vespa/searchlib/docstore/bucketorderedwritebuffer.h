@@ -0,0 +1,68 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "ibucketizer.h"
+#include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <vector>
+
+namespace search::docstore {
+
+/**
+ * Holds recently written entries in memory so they can be appended to the active file
+ * grouped by bucket instead of in arrival order. Entries of the same bucket then end up in
+ * the same chunks, so visiting or moving a bucket touches fewer chunks.
+ * A newer write or a remove of a lid replaces the buffered entry.
+ * The buffer is not thread safe, the owner must serialize access.
+ */
+class BucketOrderedWriteBuffer
+{
+public:
+    class IWrite {
+    public:
+        virtual ~IWrite() { }
+        virtual void write(uint64_t serialNum, uint32_t lid, const void *buffer, size_t sz) = 0;
+    };
+    BucketOrderedWriteBuffer();
+    ~BucketOrderedWriteBuffer();
+
+    void add(uint64_t serialNum, uint32_t lid, const void *buffer, size_t sz);
+    /**
+     * Forget the buffered entry for the lid, if any.
+     * @return true if an entry was buffered.
+     */
+    bool remove(uint32_t lid);
+    /**
+     * Append the buffered entry for the lid to the given buffer.
+     * @return size of the entry, or -1 if no entry is buffered.
+     */
+    ssize_t read(uint32_t lid, vespalib::DataBuffer & buffer) const;
+    bool contains(uint32_t lid) const { return _entries.find(lid) != _entries.end(); }
+    /**
+     * Hand over all entries ordered on bucket, and on serial number within a bucket,
+     * leaving the buffer empty. With no bucketizer entries are drained in serial number order.
+     */
+    void drain(const IBucketizer * bucketizer, IWrite & writer);
+
+    size_t size() const { return _entries.size(); }
+    bool empty() const { return _entries.empty(); }
+    size_t sizeBytes() const { return _sizeBytes; }
+    uint64_t getMaxSerialNum() const { return _maxSerialNum; }
+    size_t getMemoryFootprint() const { return _sizeBytes + _entries.getMemoryConsumption(); }
+private:
+    struct Entry {
+        Entry() : _serialNum(0), _data() { }
+        Entry(uint64_t serialNum, const void *buffer, size_t sz)
+            : _serialNum(serialNum),
+              _data(static_cast<const char *>(buffer), static_cast<const char *>(buffer) + sz)
+        { }
+        uint64_t          _serialNum;
+        std::vector<char> _data;
+    };
+    vespalib::hash_map<uint32_t, Entry> _entries;
+    size_t                              _sizeBytes;
+    uint64_t                            _maxSerialNum;
+};
+
+}
@@ -12,6 +12,7 @@ namespace vespalib {
     class nbostream;
     class DataBuffer;
 }
+namespace vespalib::compression { class ZStdDictionary; }
 
 namespace search {
 
@@ -62,6 +63,7 @@ class Chunk {
 public:
     using UP = std::unique_ptr<Chunk>;
     using CompressionConfig = vespalib::compression::CompressionConfig;
+    using ZStdDictionary = vespalib::compression::ZStdDictionary;
     class Config {
     public:
         Config(size_t maxBytes) : _maxBytes(maxBytes) { }
@@ -85,7 +87,7 @@ public:
     };
     typedef std::vector<Entry> LidList;
     Chunk(uint32_t id, const Config & config);
-    Chunk(uint32_t id, const void * buffer, size_t len, bool skipcrc=false);
+    Chunk(uint32_t id, const void * buffer, size_t len, bool skipcrc=false, const ZStdDictionary * dictionary=nullptr);
     ~Chunk();
     LidMeta append(uint32_t lid, const void * buffer, size_t len);
     ssize_t read(uint32_t lid, vespalib::DataBuffer & buffer) const;
@@ -95,7 +97,8 @@ public:
     const LidList & getLids() const { return _lids; }
     LidList getUniqueLids() const;
     size_t getMaxPackSize(const CompressionConfig & compression) const;
-    void pack(uint64_t lastSerial, vespalib::DataBuffer & buffer, const CompressionConfig & compression);
+    void pack(uint64_t lastSerial, vespalib::DataBuffer & buffer, const CompressionConfig & compression,
+              const ZStdDictionary * dictionary=nullptr);
     uint64_t getLastSerial() const { return _lastSerial; }
     uint32_t getId() const { return _id; }
     bool validSerial() const { return getLastSerial() != static_cast<uint64_t>(-1l); }
@@ -19,7 +19,8 @@ ChunkException::ChunkException(const vespalib::stringref & msg, const vespalib::
 }
 
 void
-ChunkFormat::pack(uint64_t lastSerial, vespalib::DataBuffer & compressed, const CompressionConfig & compression)
+ChunkFormat::pack(uint64_t lastSerial, vespalib::DataBuffer & compressed, const CompressionConfig & compression,
+                  const ZStdDictionary * dictionary)
 {
     vespalib::nbostream & os = _dataBuf;
     os << lastSerial;
@@ -33,7 +34,7 @@ ChunkFormat::pack(uint64_t lastSerial, vespalib::DataBuffer & compressed, const
     const size_t oldPos(compressed.getDataLen());
     compressed.writeInt8(compression.type);
     compressed.writeInt32(os.size());
-    CompressionConfig::Type type(compress(compression, vespalib::ConstBufferRef(os.c_str(), os.size()), compressed, false));
+    CompressionConfig::Type type(compress(compression, vespalib::ConstBufferRef(os.c_str(), os.size()), compressed, false, dictionary));
     if (compression.type != type) {
         compressed.getData()[oldPos] = type;
     }
@@ -67,7 +68,7 @@ ChunkFormat::verifyCompression(uint8_t type)
 }
 
 ChunkFormat::UP
-ChunkFormat::deserialize(const void * buffer, size_t len, bool skipcrc)
+ChunkFormat::deserialize(const void * buffer, size_t len, bool skipcrc, const ZStdDictionary * dictionary)
 {
     uint8_t version(0);
     vespalib::nbostream raw(buffer, len);
@@ -84,15 +85,15 @@ ChunkFormat::deserialize(const void * buffer, size_t len, bool skipcrc)
     ChunkFormat::UP format;
     if (version == ChunkFormatV1::VERSION) {
         if (skipcrc) {
-            format.reset(new ChunkFormatV1(raw));
+            format.reset(new ChunkFormatV1(raw, dictionary));
         } else {
-            format.reset(new ChunkFormatV1(raw, crc32));
+            format.reset(new ChunkFormatV1(raw, crc32, dictionary));
         }
     } else if (version == ChunkFormatV2::VERSION) {
         if (skipcrc) {
-            format.reset(new ChunkFormatV2(raw));
+            format.reset(new ChunkFormatV2(raw, dictionary));
         } else {
-            format.reset(new ChunkFormatV2(raw, crc32));
+            format.reset(new ChunkFormatV2(raw, crc32, dictionary));
         }
     } else {
         throw ChunkException(make_string("Unknown version %d", version), VESPA_STRLOC);
@@ -124,7 +125,7 @@ ChunkFormat::verifyCrc(const vespalib::nbostream & is, uint32_t expectedCrc) con
 }
 
 void
-ChunkFormat::deserializeBody(vespalib::nbostream & is)
+ChunkFormat::deserializeBody(vespalib::nbostream & is, const ZStdDictionary * dictionary)
 {
     if (includeSerializedSize()) {
         uint32_t serializedSize(0);
@@ -143,7 +144,7 @@ ChunkFormat::deserializeBody(vespalib::nbostream & is)
     // This is a dirty trick to fool some odd sanity checking in DataBuffer::swap
     vespalib::DataBuffer uncompressed(const_cast<char *>(is.peek()), (size_t)0);
     vespalib::ConstBufferRef data(is.peek(), is.size() - sizeof(uint32_t));
-    decompress(CompressionConfig::Type(type), uncompressedLen, data, uncompressed, true);
+    decompress(CompressionConfig::Type(type), uncompressedLen, data, uncompressed, true, dictionary);
     assert(uncompressed.getData() == uncompressed.getDead());
     if (uncompressed.getData() != data.c_str()) {
         const size_t sz(uncompressed.getDataLen());
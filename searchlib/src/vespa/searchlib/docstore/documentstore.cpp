@@ -3,15 +3,14 @@
 #include "cachestats.h"
 #include "documentstore.h"
 #include "visitcache.h"
+#include "value.h"
 #include "ibucketizer.h"
-#include <vespa/vespalib/stllike/cache.hpp>
+#include <vespa/vespalib/stllike/sharded_cache.hpp>
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/util/compressor.h>
 
 using document::DocumentTypeRepo;
 using vespalib::compression::CompressionConfig;
-using vespalib::compression::compress;
-using vespalib::compression::decompress;
 
 namespace search {
 
@@ -45,68 +44,6 @@ using vespalib::nbostream;
 
 namespace docstore {
 
-class Value {
-public:
-    using Alloc = vespalib::alloc::Alloc;
-    typedef std::unique_ptr<Value> UP;
-
-    Value() : _compressedSize(0), _uncompressedSize(0), _compression(CompressionConfig::NONE) {}
-
-    Value(Value &&rhs) :
-            _compressedSize(rhs._compressedSize),
-            _uncompressedSize(rhs._uncompressedSize),
-            _compression(rhs._compression),
-            _buf(std::move(rhs._buf)) {}
-
-    Value(const Value &rhs) :
-            _compressedSize(rhs._compressedSize),
-            _uncompressedSize(rhs._uncompressedSize),
-            _compression(rhs._compression),
-            _buf(Alloc::alloc(rhs.size())) {
-        memcpy(get(), rhs.get(), size());
-    }
-
-    Value &operator=(Value &&rhs) {
-        _buf = std::move(rhs._buf);
-        _compressedSize = rhs._compressedSize;
-        _uncompressedSize = rhs._uncompressedSize;
-        _compression = rhs._compression;
-        return *this;
-    }
-
-    void setCompression(CompressionConfig::Type comp, size_t uncompressedSize) {
-        _compression = comp;
-        _uncompressedSize = uncompressedSize;
-    }
-
-    CompressionConfig::Type getCompression() const { return _compression; }
-
-    size_t getUncompressedSize() const { return _uncompressedSize; }
-
-    /**
-     * Compress buffer into temporary buffer and copy temporary buffer to
-     * value along with compression config.
-     */
-    void set(vespalib::DataBuffer &&buf, ssize_t len, const CompressionConfig &compression);
-
-    /**
-     * Decompress value into temporary buffer and deserialize document from
-     * the temporary buffer.
-     */
-    document::Document::UP deserializeDocument(const DocumentTypeRepo &repo);
-
-    size_t size() const { return _compressedSize; }
-    bool empty() const { return size() == 0; }
-    operator const void *() const { return _buf.get(); }
-    const void *get() const { return _buf.get(); }
-    void *get() { return _buf.get(); }
-private:
-    size_t _compressedSize;
-    size_t _uncompressedSize;
-    CompressionConfig::Type _compression;
-    Alloc _buf;
-};
-
 class BackingStore {
 public:
     BackingStore(IDataStore &store, const CompressionConfig &compression) :
@@ -125,36 +62,6 @@ private:
     CompressionConfig _compression;
 };
 
-void
-Value::set(vespalib::DataBuffer &&buf, ssize_t len, const CompressionConfig &compression) {
-    //Underlying buffer must be identical to allow swap.
-    vespalib::DataBuffer compressed(buf.getData(), 0u);
-    CompressionConfig::Type type = compress(compression, vespalib::ConstBufferRef(buf.getData(), len),
-                                            compressed, true);
-    _compressedSize = compressed.getDataLen();
-    if (buf.getData() == compressed.getData()) {
-        // Uncompressed so we can just steal the underlying buffer.
-        buf.stealBuffer().swap(_buf);
-    } else {
-        compressed.stealBuffer().swap(_buf);
-    }
-    assert(((type == CompressionConfig::NONE) &&
-            (len == ssize_t(_compressedSize))) ||
-           ((type != CompressionConfig::NONE) &&
-            (len > ssize_t(_compressedSize))));
-    setCompression(type, len);
-}
-
-
-document::Document::UP
-Value::deserializeDocument(const DocumentTypeRepo &repo) {
-    vespalib::DataBuffer uncompressed((char *) _buf.get(), (size_t) 0);
-    decompress(getCompression(), getUncompressedSize(), vespalib::ConstBufferRef(*this, size()), uncompressed, true);
-    vespalib::nbostream is(uncompressed.getData(), uncompressed.getDataLen());
-    return document::Document::UP(new document::Document(repo, is));
-}
-
-
 void
 BackingStore::visit(const IDocumentStore::LidVector &lids, const DocumentTypeRepo &repo,
                     IDocumentVisitor &visitor) const {
@@ -188,9 +95,11 @@ using CacheParams = vespalib::CacheParam<
         vespalib::size<docstore::Value>
 >;
 
-class Cache : public vespalib::cache<CacheParams> {
+class Cache : public vespalib::sharded_cache<CacheParams> {
 public:
-    Cache(BackingStore & b, size_t maxBytes) : vespalib::cache<CacheParams>(b, maxBytes) { }
+    Cache(BackingStore & b, size_t maxBytes, size_t numShards)
+        : vespalib::sharded_cache<CacheParams>(b, maxBytes, numShards)
+    { }
 };
 
 using VisitCache = docstore::VisitCache;
@@ -201,6 +110,8 @@ DocumentStore::Config::operator == (const Config &rhs) const {
     return (_maxCacheBytes == rhs._maxCacheBytes) &&
             (_allowVisitCaching == rhs._allowVisitCaching) &&
             (_initialCacheEntries == rhs._initialCacheEntries) &&
+            (_cacheShards == rhs._cacheShards) &&
+            (_cacheAdmissionWindow == rhs._cacheAdmissionWindow) &&
             (_compression == rhs._compression);
 }
 
@@ -210,11 +121,12 @@ DocumentStore::DocumentStore(const Config & config, IDataStore & store)
       _config(config),
       _backingStore(store),
       _store(new docstore::BackingStore(_backingStore, config.getCompression())),
-      _cache(new Cache(*_store, config.getMaxCacheBytes())),
+      _cache(new Cache(*_store, config.getMaxCacheBytes(), config.getCacheShards())),
       _visitCache(new VisitCache(store, config.getMaxCacheBytes(), config.getCompression())),
       _uncached_lookups(0)
 {
     _cache->reserveElements(config.getInitialCacheEntries());
+    _cache->admitOnSecondMiss(config.getCacheAdmissionWindow());
 }
 
 DocumentStore::~DocumentStore() {}
@@ -332,7 +244,6 @@ class DocumentStore::WrapVisitor : public IDataStoreVisitor
 {
     Visitor                 &_visitor;
     const DocumentTypeRepo  &_repo;
-    const CompressionConfig &_compression;
     IDocumentStore          &_ds;
     uint64_t                 _syncToken;
     
@@ -341,10 +252,10 @@ public:
 
     WrapVisitor(Visitor &visitor,
                 const DocumentTypeRepo &repo,
-                const CompressionConfig &compresion,
                 IDocumentStore &ds,
                 uint64_t syncToken);
     
+    inline void visitDocument(uint32_t lid, document::Document::UP doc);
     inline void rewrite(uint32_t lid, const document::Document &doc);
     inline void rewrite(uint32_t lid);
     inline void visitRemove(uint32_t lid);
@@ -366,6 +277,14 @@ public:
 };
 
 
+template <>
+void
+DocumentStore::WrapVisitor<IDocumentStoreReadVisitor>::
+visitDocument(uint32_t lid, document::Document::UP doc)
+{
+    _visitor.visitShared(lid, std::shared_ptr<const document::Document>(std::move(doc)));
+}
+
 template <>
 void
 DocumentStore::WrapVisitor<IDocumentStoreReadVisitor>::
@@ -418,6 +337,14 @@ visitRemove(uint32_t lid)
     (void) lid;
 }
 
+template <>
+void
+DocumentStore::WrapVisitor<IDocumentStoreRewriteVisitor>::
+visitDocument(uint32_t lid, document::Document::UP doc)
+{
+    _visitor.visit(lid, *doc);
+    rewrite(lid, *doc);
+}
 
 
 template <class Visitor>
@@ -426,22 +353,10 @@ DocumentStore::WrapVisitor<Visitor>::visit(uint32_t lid,
                                            const void *buffer,
                                            size_t sz)
 {
-    (void) lid;
-    (void) buffer;
-    (void) sz;
-    
-    Value value;
-    vespalib::DataBuffer buf(4096);
-    buf.clear();
-    buf.writeBytes(buffer, sz);
-    ssize_t len = sz;
-    if (len > 0) {
-        value.set(std::move(buf), len, _compression);
-    }
-    if (! value.empty()) {
-        document::Document::UP doc(value.deserializeDocument(_repo)); 
-        _visitor.visit(lid, *doc);
-        rewrite(lid, *doc);
+    if (sz > 0) {
+        // The visited buffer is the serialized document, deserialize it in place.
+        vespalib::nbostream is(buffer, sz);
+        visitDocument(lid, std::make_unique<document::Document>(_repo, is));
     } else {
         visitRemove(lid);
         rewrite(lid);
@@ -453,12 +368,10 @@ template <class Visitor>
 DocumentStore::WrapVisitor<Visitor>::
 WrapVisitor(Visitor &visitor,
             const DocumentTypeRepo &repo,
-            const CompressionConfig &compression,
             IDocumentStore &ds,
             uint64_t syncToken)
     : _visitor(visitor),
       _repo(repo),
-      _compression(compression),
       _ds(ds),
       _syncToken(syncToken)
 {
@@ -471,7 +384,6 @@ DocumentStore::accept(IDocumentStoreReadVisitor &visitor,
                       const DocumentTypeRepo &repo)
 {
     WrapVisitor<IDocumentStoreReadVisitor> wrap(visitor, repo,
-                                                _store->getCompression(),
                                                 *this,
                                                 _backingStore.
                                                 tentativeLastSyncToken());
@@ -487,7 +399,6 @@ DocumentStore::accept(IDocumentStoreRewriteVisitor &visitor,
 {
     WrapVisitor<IDocumentStoreRewriteVisitor> wrap(visitor,
                                                    repo,
-                                                   _store->getCompression(),
                                                    *this,
                                                    _backingStore.
                                                    tentativeLastSyncToken());
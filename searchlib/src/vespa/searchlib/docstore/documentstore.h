@@ -31,12 +31,16 @@ public:
             _compression(CompressionConfig::LZ4, 9, 70),
             _maxCacheBytes(1000000000),
             _initialCacheEntries(0),
+            _cacheShards(1),
+            _cacheAdmissionWindow(0),
             _allowVisitCaching(false)
         { }
         Config(const CompressionConfig & compression, size_t maxCacheBytes, size_t initialCacheEntries) :
             _compression((maxCacheBytes != 0) ? compression : CompressionConfig::NONE),
             _maxCacheBytes(maxCacheBytes),
             _initialCacheEntries(initialCacheEntries),
+            _cacheShards(1),
+            _cacheAdmissionWindow(0),
             _allowVisitCaching(false)
         { }
         const CompressionConfig & getCompression() const { return _compression; }
@@ -44,11 +48,22 @@ public:
         size_t getInitialCacheEntries() const { return _initialCacheEntries; }
         bool allowVisitCaching() const { return _allowVisitCaching; }
         Config & allowVisitCaching(bool allow) { _allowVisitCaching = allow; return *this; }
+        /** Number of independently locked parts of the document cache. Only applied on construction. */
+        size_t getCacheShards() const { return _cacheShards; }
+        Config & cacheShards(size_t shards) { _cacheShards = shards; return *this; }
+        /**
+         * When non-zero, a document is only inserted into the cache when it is missed twice within
+         * this many recent misses, so that a single scan does not flush the cache.
+         */
+        size_t getCacheAdmissionWindow() const { return _cacheAdmissionWindow; }
+        Config & cacheAdmissionWindow(size_t numKeys) { _cacheAdmissionWindow = numKeys; return *this; }
         bool operator == (const Config &) const;
     private:
         CompressionConfig _compression;
         size_t _maxCacheBytes;
         size_t _initialCacheEntries;
+        size_t _cacheShards;
+        size_t _cacheAdmissionWindow;
         bool   _allowVisitCaching;
     };
 
@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "filechunk.h"
+#include "bandwidththrottle.h"
 #include "data_store_file_chunk_stats.h"
 #include "summaryexceptions.h"
 #include "randreaders.h"
@@ -8,12 +9,14 @@
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/data/fileheader.h>
 #include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/encoding/base64.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/util/blockingthreadstackexecutor.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/util/array.hpp>
 #include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/fastos/file.h>
+#include <deque>
 #include <future>
 
 #include <vespa/log/log.h>
@@ -28,7 +31,9 @@ namespace {
 
 constexpr size_t ALIGNMENT=0x1000;
 constexpr size_t ENTRY_BIAS_SIZE=8;
+constexpr size_t SAMPLE_STRIDE=16;
 const vespalib::string DOC_ID_LIMIT_KEY("docIdLimit");
+const vespalib::string DICTIONARY_KEY("zstdDictionary");
 
 }
 
@@ -82,6 +87,7 @@ FileChunk::FileChunk(FileId fileId, NameId nameId, const vespalib::string & base
       _idxHeaderLen(0u),
       _lastPersistedSerialNum(0),
       _docIdLimit(std::numeric_limits<uint32_t>::max()),
+      _dictionary(),
       _modificationTime()
 {
     FastOS_File dataFile(_dataFileName.c_str());
@@ -274,6 +280,14 @@ FileChunk::enableRead()
     if (_dataHeaderLen == 0u) {
         throw std::runtime_error(make_string("bad file header: %s", _dataFileName.c_str()));
     }
+    if ( ! _dictionary) {
+        vespalib::DataBuffer h(_dataHeaderLen, ALIGNMENT);
+        _file->read(0, h, _dataHeaderLen);
+        GenericHeader::BufferReader rd(h);
+        GenericHeader header;
+        header.read(rd);
+        _dictionary = readDictionary(header);
+    }
 }
 
 size_t FileChunk::adjustSize(size_t sz) {
@@ -335,7 +349,8 @@ appendChunks(FixedParams * args, Chunk::UP chunk)
 
 void
 FileChunk::appendTo(vespalib::ThreadExecutor & executor, const IGetLid & db, IWriteData & dest,
-                    uint32_t numChunks, IFileChunkVisitorProgress *visitorProgress)
+                    uint32_t numChunks, IFileChunkVisitorProgress *visitorProgress,
+                    docstore::BandwidthThrottle * throttle)
 {
     assert(frozen() || visitorProgress);
     vespalib::GenerationHandler::Guard lidReadGuard(db.getLidReadGuard());
@@ -343,13 +358,16 @@ FileChunk::appendTo(vespalib::ThreadExecutor & executor, const IGetLid & db, IWr
     FixedParams fixedParams = {db, dest, lidReadGuard, getFileId().getId(), visitorProgress};
     vespalib::BlockingThreadStackExecutor singleExecutor(1, 64*1024, executor.getNumThreads()*2);
     for (size_t chunkId(0); chunkId < numChunks; chunkId++) {
+        if (throttle != nullptr) {
+            throttle->throttle(_chunkInfo[chunkId].getSize());
+        }
         std::promise<Chunk::UP> promisedChunk;
         std::future<Chunk::UP> futureChunk = promisedChunk.get_future();
         executor.execute(vespalib::makeLambdaTask([promise = std::move(promisedChunk), chunkId, this]() mutable {
             const ChunkInfo & cInfo(_chunkInfo[chunkId]);
             vespalib::DataBuffer whole(0ul, ALIGNMENT);
             FileRandRead::FSP keepAlive(_file->read(cInfo.getOffset(), whole, cInfo.getSize()));
-            promise.set_value(std::make_unique<Chunk>(chunkId, whole.getData(), whole.getDataLen()));
+            promise.set_value(std::make_unique<Chunk>(chunkId, whole.getData(), whole.getDataLen(), false, _dictionary.get()));
         }));
 
         singleExecutor.execute(vespalib::makeLambdaTask([args = &fixedParams, chunk = std::move(futureChunk)]() mutable {
@@ -361,30 +379,104 @@ FileChunk::appendTo(vespalib::ThreadExecutor & executor, const IGetLid & db, IWr
 }
 
 void
-FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor) const
+FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor,
+                vespalib::ThreadExecutor * executor) const
 {
     if (count == 0) { return; }
-    uint32_t prevChunk = begin->getChunkId();
-    uint32_t start(0);
-    for (size_t i(0); i < count; i++) {
-        const LidInfoWithLid & li = *(begin + i);
-        if (li.getChunkId() != prevChunk) {
-            ChunkInfo ci = _chunkInfo[prevChunk];
-            read(begin + start, i - start, ci, visitor);
-            prevChunk = li.getChunkId();
+    // Runs of lids residing in the same chunk, as (start, count).
+    std::vector<std::pair<size_t, size_t>> runs;
+    size_t start(0);
+    for (size_t i(1); i < count; i++) {
+        if ((begin + i)->getChunkId() != (begin + start)->getChunkId()) {
+            runs.emplace_back(start, i - start);
             start = i;
         }
     }
-    ChunkInfo ci = _chunkInfo[prevChunk];
-    read(begin + start, count - start, ci, visitor);
+    runs.emplace_back(start, count - start);
+    if ((executor == nullptr) || (runs.size() < 2)) {
+        for (const auto & run : runs) {
+            read(begin + run.first, run.second, _chunkInfo[(begin + run.first)->getChunkId()], visitor);
+        }
+        return;
+    }
+    // Keep a bounded number of chunks in flight, and visit them in order as they become ready.
+    const size_t maxPending = std::max(size_t(2), executor->getNumThreads() * 2);
+    std::deque<std::future<Chunk::UP>> pending;
+    size_t next(0);
+    auto startNext = [&]() {
+        uint32_t chunkId = (begin + runs[next].first)->getChunkId();
+        std::promise<Chunk::UP> promisedChunk;
+        pending.push_back(promisedChunk.get_future());
+        vespalib::Executor::Task::UP rejected =
+            executor->execute(vespalib::makeLambdaTask([promise = std::move(promisedChunk), chunkId,
+                                                        ci = _chunkInfo[chunkId], this]() mutable {
+                try {
+                    promise.set_value(readChunk(chunkId, ci));
+                } catch (...) {
+                    promise.set_exception(std::current_exception());
+                }
+            }));
+        if (rejected) {
+            rejected->run();
+        }
+        next++;
+    };
+    try {
+        for (const auto & run : runs) {
+            while ((next < runs.size()) && (pending.size() < maxPending)) {
+                startNext();
+            }
+            Chunk::UP chunk = pending.front().get();
+            pending.pop_front();
+            visitChunk(*chunk, begin + run.first, run.second, visitor);
+        }
+    } catch (...) {
+        // Tasks still in flight refer to this file chunk.
+        for (auto & future : pending) {
+            future.wait();
+        }
+        throw;
+    }
+}
+
+void
+FileChunk::willNeed(LidInfoWithLidV::const_iterator begin, size_t count) const
+{
+    uint32_t prevChunk = std::numeric_limits<uint32_t>::max();
+    for (size_t i(0); i < count; i++) {
+        uint32_t chunk = (begin + i)->getChunkId();
+        if ((chunk != prevChunk) && (chunk < _chunkInfo.size())) {
+            willNeed(_chunkInfo[chunk]);
+        }
+        prevChunk = chunk;
+    }
+}
+
+void
+FileChunk::willNeed(const ChunkInfo & ci) const
+{
+    _file->willNeed(ci.getOffset(), ci.getSize());
 }
 
 void
 FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo ci, IBufferVisitor & visitor) const
+{
+    Chunk::UP chunk = readChunk(begin->getChunkId(), ci);
+    visitChunk(*chunk, begin, count, visitor);
+}
+
+Chunk::UP
+FileChunk::readChunk(uint32_t chunkId, const ChunkInfo & ci) const
 {
     vespalib::DataBuffer whole(0ul, ALIGNMENT);
     FileRandRead::FSP keepAlive = _file->read(ci.getOffset(), whole, ci.getSize());
-    Chunk chunk(begin->getChunkId(), whole.getData(), whole.getDataLen(), _skipCrcOnRead);
+    return std::make_unique<Chunk>(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead, _dictionary.get());
+}
+
+void
+FileChunk::visitChunk(const Chunk & chunk, LidInfoWithLidV::const_iterator begin, size_t count,
+                      IBufferVisitor & visitor)
+{
     for (size_t i(0); i < count; i++) {
         const LidInfoWithLid & li = *(begin + i);
         vespalib::ConstBufferRef buf = chunk.getLid(li.getLid());
@@ -409,7 +501,7 @@ FileChunk::read(uint32_t lid, SubChunkId chunkId, const ChunkInfo & chunkInfo,
 {
     vespalib::DataBuffer whole(0ul, ALIGNMENT);
     FileRandRead::FSP keepAlive(_file->read(chunkInfo.getOffset(), whole, chunkInfo.getSize()));
-    Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead);
+    Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead, _dictionary.get());
     return chunk.read(lid, buffer);
 }
 
@@ -471,6 +563,25 @@ FileChunk::writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit)
     header.putTag(vespalib::GenericHeader::Tag(DOC_ID_LIMIT_KEY, docIdLimit));
 }
 
+FileChunk::ZStdDictionary::SP
+FileChunk::readDictionary(const vespalib::GenericHeader &header)
+{
+    if (header.hasTag(DICTIONARY_KEY)) {
+        const vespalib::string & encoded = header.getTag(DICTIONARY_KEY).asString();
+        std::string data = vespalib::Base64::decode(encoded.c_str(), encoded.size());
+        return std::make_shared<ZStdDictionary>(data.c_str(), data.size());
+    }
+    return ZStdDictionary::SP();
+}
+
+void
+FileChunk::writeDictionary(vespalib::GenericHeader &header, const ZStdDictionary &dictionary)
+{
+    vespalib::ConstBufferRef data = dictionary.getData();
+    std::string encoded = vespalib::Base64::encode(data.c_str(), data.size());
+    header.putTag(vespalib::GenericHeader::Tag(DICTIONARY_KEY, vespalib::string(encoded.c_str(), encoded.size())));
+}
+
 void
 FileChunk::verify(bool reportOnly) const
 {
@@ -485,7 +596,7 @@ FileChunk::verify(bool reportOnly) const
         vespalib::DataBuffer whole(0ul, ALIGNMENT);
         FileRandRead::FSP keepAlive(_file->read(ci.getOffset(), whole, ci.getSize()));
         try {
-            Chunk chunk(chunkId++, whole.getData(), whole.getDataLen());
+            Chunk chunk(chunkId++, whole.getData(), whole.getDataLen(), false, _dictionary.get());
             assert(chunk.getLastSerial() >= lastSerial);
             lastSerial = chunk.getLastSerial();
             if (errorInPrev) {
@@ -502,6 +613,31 @@ FileChunk::verify(bool reportOnly) const
     }
 }
 
+void
+FileChunk::sample(size_t maxBytes, vespalib::DataBuffer & samples, std::vector<size_t> & sampleSizes) const
+{
+    assert(frozen());
+    const size_t numChunks(_chunkInfo.size());
+    const size_t stride(std::min(numChunks, SAMPLE_STRIDE));
+    for (size_t first(0); first < stride; first++) {
+        for (size_t chunkId(first); chunkId < numChunks; chunkId += stride) {
+            if (samples.getDataLen() >= maxBytes) {
+                return;
+            }
+            const ChunkInfo & ci(_chunkInfo[chunkId]);
+            vespalib::DataBuffer whole(0ul, ALIGNMENT);
+            FileRandRead::FSP keepAlive(_file->read(ci.getOffset(), whole, ci.getSize()));
+            const Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead, _dictionary.get());
+            for (const Chunk::Entry & e : chunk.getLids()) {
+                if (e.netSize() > 0) {
+                    samples.writeBytes(chunk.getData().c_str() + e.getNetOffset(), e.netSize());
+                    sampleSizes.push_back(e.netSize());
+                }
+            }
+        }
+    }
+}
+
 uint32_t
 FileChunk::getNumChunks() const
 {
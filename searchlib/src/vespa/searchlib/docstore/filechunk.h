@@ -12,6 +12,7 @@
 #include <vespa/vespalib/stllike/hash_map.h>
 #include <vespa/searchlib/common/tunefileinfo.h>
 #include <vespa/vespalib/util/generationhandler.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 
 class FastOS_FileInterface;
 
@@ -24,6 +25,7 @@ namespace vespalib {
 namespace search {
 
 class DataStoreFileChunkStats;
+namespace docstore { class BandwidthThrottle; }
 
 class IWriteData
 {
@@ -105,13 +107,26 @@ public:
     typedef vespalib::hash_map<uint32_t, std::unique_ptr<vespalib::DataBuffer>> LidBufferMap;
     typedef std::unique_ptr<FileChunk> UP;
     typedef uint32_t SubChunkId;
+    using ZStdDictionary = vespalib::compression::ZStdDictionary;
     FileChunk(FileId fileId, NameId nameId, const vespalib::string &baseName, const TuneFileSummary &tune,
               const IBucketizer *bucketizer, bool skipCrcOnRead);
     virtual ~FileChunk();
 
     virtual size_t updateLidMap(const LockGuard &guard, ISetLid &lidMap, uint64_t serialNum, uint32_t docIdLimit);
     virtual ssize_t read(uint32_t lid, SubChunkId chunk, vespalib::DataBuffer & buffer) const;
-    virtual void read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor) const;
+    /**
+     * Visit the given lids, which must be sorted on chunk id. If an
+     * executor is given, chunks are read and decompressed on it in
+     * parallel, while the visitor is still called in chunk order from
+     * the calling thread.
+     */
+    virtual void read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor,
+                      vespalib::ThreadExecutor * executor) const;
+    /**
+     * Hint that the chunks holding the given lids will be read soon, so
+     * that the disk reads for all of them can be started up front.
+     */
+    virtual void willNeed(LidInfoWithLidV::const_iterator begin, size_t count) const;
     void remove(uint32_t lid, uint32_t size);
     virtual size_t getDiskFootprint() const { return _diskFootprint; }
     virtual size_t getMemoryFootprint() const;
@@ -162,8 +177,14 @@ public:
     virtual bool frozen() const { return true; }
     const vespalib::string & getName() const { return _name; }
     void compact(const IGetLid & iGetLid);
+    /**
+     * Read the first numChunks chunks and append the entries still referenced by db to dest.
+     * Chunks are read and decompressed in parallel by the executor. If a throttle is given
+     * the reads are limited to its bandwidth.
+     */
     void appendTo(vespalib::ThreadExecutor & executor, const IGetLid & db, IWriteData & dest,
-                  uint32_t numChunks, IFileChunkVisitorProgress *visitorProgress);
+                  uint32_t numChunks, IFileChunkVisitorProgress *visitorProgress,
+                  docstore::BandwidthThrottle * throttle = nullptr);
     /**
      * Must be called after chunk has been created to allow correct
      * underlying file object to be created.  Must be called before
@@ -181,6 +202,18 @@ public:
      */
     void verify(bool reportOnly) const;
 
+    /**
+     * The zstd dictionary chunks in this file are compressed with, if any.
+     * It is stored in the data file header.
+     */
+    const ZStdDictionary::SP & getDictionary() const { return _dictionary; }
+    /**
+     * Collect the uncompressed entries of chunks evenly spread across the file,
+     * back to back in samples, until maxBytes have been collected or the file
+     * is exhausted. Used for training a compression dictionary. File must be frozen.
+     */
+    void sample(size_t maxBytes, vespalib::DataBuffer & samples, std::vector<size_t> & sampleSizes) const;
+
     uint32_t      getNumChunks() const;
     size_t       getNumBuckets() const { return _sumNumBuckets; }
     size_t getNumUniqueBuckets() const { return _numUniqueBuckets; }
@@ -234,8 +267,14 @@ protected:
     void setNumUniqueBuckets(size_t numUniqueBuckets) { _numUniqueBuckets = numUniqueBuckets; }
     ssize_t read(uint32_t lid, SubChunkId chunkId, const ChunkInfo & chunkInfo, vespalib::DataBuffer & buffer) const;
     void read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo ci, IBufferVisitor & visitor) const;
+    Chunk::UP readChunk(uint32_t chunkId, const ChunkInfo & ci) const;
+    static void visitChunk(const Chunk & chunk, LidInfoWithLidV::const_iterator begin, size_t count,
+                           IBufferVisitor & visitor);
+    void willNeed(const ChunkInfo & ci) const;
     static uint32_t readDocIdLimit(vespalib::GenericHeader &header);
     static void writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit);
+    static ZStdDictionary::SP readDictionary(const vespalib::GenericHeader &header);
+    static void writeDictionary(vespalib::GenericHeader &header, const ZStdDictionary &dictionary);
 
     typedef vespalib::Array<ChunkInfo> ChunkInfoVector;
     const IBucketizer * _bucketizer;
@@ -248,6 +287,7 @@ protected:
     uint32_t            _idxHeaderLen;
     uint64_t            _lastPersistedSerialNum;
     uint32_t            _docIdLimit; // Limit when the file was created. Stored in idx file header.
+    ZStdDictionary::SP  _dictionary; // Set before any chunk is written or read. Stored in dat file header.
     fastos::TimeStamp   _modificationTime;
 };
 
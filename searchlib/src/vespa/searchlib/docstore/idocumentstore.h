@@ -18,6 +18,13 @@ public:
     virtual ~IDocumentStoreReadVisitor() { }
     virtual void visit(uint32_t lid, const document::Document &doc) = 0;
     virtual void visit(uint32_t lid) = 0;
+    /**
+     * Visit a document the visitor may keep after returning, e.g. to
+     * process it on another thread. Defaults to visiting it in place.
+     */
+    virtual void visitShared(uint32_t lid, std::shared_ptr<const document::Document> doc) {
+        visit(lid, *doc);
+    }
 };
 
 class IDocumentStoreRewriteVisitor
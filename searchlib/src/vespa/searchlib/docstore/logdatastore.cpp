@@ -2,10 +2,12 @@
 
 #include "storebybucket.h"
 #include "compacter.h"
+#include "bandwidththrottle.h"
 #include "logdatastore.h"
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/util/benchmark_timer.h>
 #include <vespa/vespalib/data/fileheader.h>
+#include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/searchlib/common/rcuvector.hpp>
 #include <vespa/vespalib/util/exceptions.h>
@@ -27,13 +29,24 @@ using std::runtime_error;
 using document::BucketId;
 using docstore::StoreByBucket;
 using docstore::BucketCompacter;
+using vespalib::compression::ZStdDictionary;
 using namespace std::literals;
 
+namespace {
+
+// Sample this many times the dictionary size when training it.
+constexpr size_t DICTIONARY_SAMPLE_FACTOR = 100;
+
+}
+
 LogDataStore::Config::Config()
     : _maxFileSize(1000000000ul),
       _maxDiskBloatFactor(0.2),
       _maxBucketSpread(2.5),
       _minFileSizeFactor(0.2),
+      _maxDictionarySize(0),
+      _writeBufferBytes(0),
+      _maxCompactReadBytesPerSecond(0),
       _skipCrcOnRead(false),
       _compact2ActiveFile(true),
       _compactCompression(CompressionConfig::LZ4),
@@ -46,6 +59,9 @@ LogDataStore::Config::operator == (const Config & rhs) const {
             (_maxDiskBloatFactor == rhs._maxDiskBloatFactor) &&
             (_maxFileSize == rhs._maxFileSize) &&
             (_minFileSizeFactor == rhs._minFileSizeFactor) &&
+            (_maxDictionarySize == rhs._maxDictionarySize) &&
+            (_writeBufferBytes == rhs._writeBufferBytes) &&
+            (_maxCompactReadBytesPerSecond == rhs._maxCompactReadBytesPerSecond) &&
             (_compact2ActiveFile == rhs._compact2ActiveFile) &&
             (_skipCrcOnRead == rhs._skipCrcOnRead) &&
             (_compactCompression == rhs._compactCompression) &&
@@ -74,7 +90,10 @@ LogDataStore::LogDataStore(vespalib::ThreadExecutor &executor, const vespalib::s
       _tlSyncer(tlSyncer),
       _bucketizer(bucketizer),
       _currentlyCompacting(),
-      _compactLidSpaceGeneration()
+      _compactLidSpaceGeneration(),
+      _dictionary(),
+      _writeBuffer(),
+      _hasBufferedWrites(false)
 {
     // Reserve space for 1TB summary in order to avoid locking.
     _fileChunks.reserve(LidInfo::getFileIdLimit());
@@ -86,7 +105,11 @@ LogDataStore::LogDataStore(vespalib::ThreadExecutor &executor, const vespalib::s
 }
 
 void LogDataStore::reconfigure(const Config & config) {
+    LockGuard guard(_updateLock);
     _config = config;
+    if (_config.getWriteBufferBytes() == 0) {
+        drainWriteBuffer(guard);
+    }
 }
 
 void
@@ -124,12 +147,56 @@ LogDataStore::updateLidMap(uint32_t lastFileChunkDocIdLimit)
     }
 }
 
+namespace {
+
+/**
+ * Call func(fileId, begin, count) for each run of lids residing in the same file.
+ * The lids must be sorted on file id.
+ */
+template <typename Func>
+void
+forEachFile(const LidInfoWithLidV & orderedLids, Func func)
+{
+    uint32_t prevFile = orderedLids[0].getFileId();
+    uint32_t start = 0;
+    for (size_t curr(1); curr < orderedLids.size(); curr++) {
+        const LidInfoWithLid & li = orderedLids[curr];
+        if (prevFile != li.getFileId()) {
+            func(prevFile, orderedLids.begin() + start, curr - start);
+            start = curr;
+            prevFile = li.getFileId();
+        }
+    }
+    func(prevFile, orderedLids.begin() + start, orderedLids.size() - start);
+}
+
+}
+
 void
 LogDataStore::read(const LidVector & lids, IBufferVisitor & visitor) const
 {
     LidInfoWithLidV orderedLids;
+    std::vector<std::pair<uint32_t, vespalib::DataBuffer::UP>> buffered;
+    if (hasBufferedWrites()) {
+        LockGuard updateGuard(_updateLock);
+        for (uint32_t lid : lids) {
+            if (_writeBuffer.contains(lid)) {
+                auto buf = std::make_unique<vespalib::DataBuffer>();
+                _writeBuffer.read(lid, *buf);
+                buffered.emplace_back(lid, std::move(buf));
+            }
+        }
+    }
+    for (const auto & entry : buffered) {
+        visitor.visit(entry.first, vespalib::ConstBufferRef(entry.second->getData(), entry.second->getDataLen()));
+    }
     GenerationHandler::Guard guard(_genHandler.takeGuard());
     for (uint32_t lid : lids) {
+        if ( ! buffered.empty() &&
+             std::find_if(buffered.begin(), buffered.end(), [lid](const auto & e) { return e.first == lid; }) != buffered.end())
+        {
+            continue;
+        }
         if (lid < getDocIdLimit()) {
             LidInfo li = _lidInfo[lid];
             if (!li.empty() && li.valid()) {
@@ -140,25 +207,27 @@ LogDataStore::read(const LidVector & lids, IBufferVisitor & visitor) const
     if (orderedLids.empty()) { return; }
 
     std::sort(orderedLids.begin(), orderedLids.end());
-    uint32_t prevFile = orderedLids[0].getFileId();
-    uint32_t start = 0;
-    for (size_t curr(1); curr < orderedLids.size(); curr++) {
-        const LidInfoWithLid & li = orderedLids[curr];
-        if (prevFile != li.getFileId()) {
-            const FileChunk & fc(*_fileChunks[prevFile]);
-            fc.read(orderedLids.begin() + start, curr - start, visitor);
-            start = curr;
-            prevFile = li.getFileId();
-        }
-    }
-    const FileChunk & fc(*_fileChunks[prevFile]);
-    fc.read(orderedLids.begin() + start, orderedLids.size() - start, visitor);
+    // Let the OS start fetching all needed chunks before they are read one by one.
+    forEachFile(orderedLids, [this](uint32_t fileId, LidInfoWithLidV::const_iterator begin, size_t count) {
+        _fileChunks[fileId]->willNeed(begin, count);
+    });
+    forEachFile(orderedLids, [this, &visitor](uint32_t fileId, LidInfoWithLidV::const_iterator begin, size_t count) {
+        _fileChunks[fileId]->read(begin, count, visitor, &_executor);
+    });
 }
 
 ssize_t
 LogDataStore::read(uint32_t lid, vespalib::DataBuffer& buffer) const
 {
     ssize_t sz(0);
+    if (hasBufferedWrites()) {
+        LockGuard guard(_updateLock);
+        sz = _writeBuffer.read(lid, buffer);
+        if (sz >= 0) {
+            return sz;
+        }
+        sz = 0;
+    }
     if (lid < getDocIdLimit()) {
         LidInfo li(0);
         {
@@ -178,10 +247,49 @@ void
 LogDataStore::write(uint64_t serialNum, uint32_t lid, const void * buffer, size_t len)
 {
     LockGuard guard(_updateLock);
+    if (_config.getWriteBufferBytes() != 0) {
+        _hasBufferedWrites.store(true, std::memory_order_release);
+        _writeBuffer.add(serialNum, lid, buffer, len);
+        if (_writeBuffer.sizeBytes() < _config.getWriteBufferBytes()) {
+            return;
+        }
+        drainWriteBuffer(guard);
+        WriteableFileChunk & active = getActive(guard);
+        requireSpace(std::move(guard), active);
+        return;
+    }
     WriteableFileChunk & active = getActive(guard);
     write(std::move(guard), active, serialNum,  lid, buffer, len);
 }
 
+void
+LogDataStore::drainWriteBuffer(const LockGuard & guard)
+{
+    if (_writeBuffer.empty()) {
+        return;
+    }
+    class Appender : public docstore::BucketOrderedWriteBuffer::IWrite {
+    public:
+        Appender(LogDataStore & store, const LockGuard & guard, WriteableFileChunk & active, uint64_t serialNum)
+            : _store(store), _guard(guard), _active(active), _serialNum(serialNum)
+        { }
+        void write(uint64_t, uint32_t lid, const void *buffer, size_t sz) override {
+            // The active file requires increasing serial numbers, so all entries get the newest one.
+            LidInfo lm = _active.append(_serialNum, lid, buffer, sz);
+            _store.setLid(_guard, lid, lm);
+        }
+    private:
+        LogDataStore       & _store;
+        const LockGuard    & _guard;
+        WriteableFileChunk & _active;
+        uint64_t             _serialNum;
+    };
+    WriteableFileChunk & active = getActive(guard);
+    Appender appender(*this, guard, active, std::max(active.getSerialNum(), _writeBuffer.getMaxSerialNum()));
+    _writeBuffer.drain(_bucketizer.get(), appender);
+    _hasBufferedWrites.store(false, std::memory_order_release);
+}
+
 void
 LogDataStore::write(LockGuard guard, FileId destinationFileId, uint32_t lid, const void * buffer, size_t len)
 {
@@ -208,6 +316,8 @@ LogDataStore::requireSpace(LockGuard guard, WriteableFileChunk & active)
     LOG(spam, "Checking file %s size %ld < %ld",
               active.getName().c_str(), oldSz, _config.getMaxFileSize());
     if (oldSz > _config.getMaxFileSize()) {
+        // Buffered entries might be older than what the closed file will claim to persist.
+        drainWriteBuffer(guard);
         FileId fileId = allocateFileId(guard);
         setNewFileChunk(guard, createWritableFile(fileId, active.getSerialNum()));
         setActive(guard, fileId);
@@ -247,7 +357,7 @@ uint64_t
 LogDataStore::tentativeLastSyncToken() const
 {
     LockGuard guard(_updateLock);
-    return getActive(guard).getSerialNum();
+    return std::max(getActive(guard).getSerialNum(), _writeBuffer.getMaxSerialNum());
 }
 
 fastos::TimeStamp
@@ -271,6 +381,7 @@ void
 LogDataStore::remove(uint64_t serialNum, uint32_t lid)
 {
     LockGuard guard(_updateLock);
+    _writeBuffer.remove(lid);
     if (lid < getDocIdLimit()) {
         LidInfo lm = _lidInfo[lid];
         if (lm.valid()) {
@@ -436,12 +547,14 @@ void LogDataStore::flushFileAndWait(LockGuard guard, WriteableFileChunk & file,
 
 SerialNum LogDataStore::flushActive(SerialNum syncToken) {
     LockGuard guard(_updateLock);
+    drainWriteBuffer(guard);
     WriteableFileChunk &active = getActive(guard);
     return flushFile(std::move(guard), active, syncToken);
 }
 
 void LogDataStore::flushActiveAndWait(SerialNum syncToken) {
     LockGuard guard(_updateLock);
+    drainWriteBuffer(guard);
     WriteableFileChunk &active = getActive(guard);
     return flushFileAndWait(std::move(guard), active, syncToken);
 }
@@ -466,6 +579,11 @@ void LogDataStore::compactFile(FileId fileId)
     NameId compactedNameId = fc->getNameId();
     LOG(info, "Compacting file '%s' which has bloat '%2.2f' and bucket-spread '%1.4f",
               fc->getName().c_str(), 100*fc->getDiskBloat()/double(fc->getDiskFootprint()), fc->getBucketSpread());
+    ZStdDictionary::SP dictionary = trainDictionary(*fc);
+    if (dictionary) {
+        LockGuard guard(_updateLock);
+        _dictionary = std::move(dictionary);
+    }
     IWriteData::UP compacter;
     FileId destinationFileId = FileId::active();
     if (_bucketizer) {
@@ -481,7 +599,11 @@ void LogDataStore::compactFile(FileId fileId)
         compacter.reset(new docstore::Compacter(*this));
     }
 
-    fc->appendTo(_executor, *this, *compacter, fc->getNumChunks(), nullptr);
+    std::unique_ptr<docstore::BandwidthThrottle> throttle;
+    if (_config.getMaxCompactReadBytesPerSecond() != 0) {
+        throttle = std::make_unique<docstore::BandwidthThrottle>(_config.getMaxCompactReadBytesPerSecond());
+    }
+    fc->appendTo(_executor, *this, *compacter, fc->getNumChunks(), nullptr, throttle.get());
 
     if (destinationFileId.isActive()) {
         flushActiveAndWait(0);
@@ -529,6 +651,7 @@ LogDataStore::memoryUsed() const
     size_t sz(memoryMeta());
     {
         LockGuard guard(_updateLock);
+        sz += _writeBuffer.getMemoryFootprint();
         for (const FileChunk::UP & fc : _fileChunks) {
             if (fc) {
                 sz += fc->getMemoryFootprint();
@@ -649,7 +772,7 @@ LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId name
     FileChunk::UP file(new WriteableFileChunk(_executor, fileId, nameId, getBaseDir(),
                                               serialNum, docIdLimit,
                                               _config.getFileConfig(), _tune, _fileHeaderContext,
-                                              _bucketizer.get(), _config.crcOnReadDisabled()));
+                                              _bucketizer.get(), _config.crcOnReadDisabled(), _dictionary));
     file->enableRead();
     return file;
 }
@@ -783,10 +906,16 @@ LogDataStore::preload()
         typedef NameIdSet::const_iterator It;
         for (It it(partList.begin()), mt(--partList.end()); it != mt; it++) {
             _fileChunks.push_back(createReadOnlyFile(FileId(_fileChunks.size()), *it));
+            if (_fileChunks.back()->getDictionary()) {
+                _dictionary = _fileChunks.back()->getDictionary();
+            }
         }
         _fileChunks.push_back(isReadOnly()
             ? createReadOnlyFile(FileId(_fileChunks.size()), *partList.rbegin())
             : createWritableFile(FileId(_fileChunks.size()), getMinLastPersistedSerialNum(), *partList.rbegin()));
+        if (_fileChunks.back()->getDictionary()) {
+            _dictionary = _fileChunks.back()->getDictionary();
+        }
     } else {
         if ( ! isReadOnly() ) {
             _fileChunks.push_back(createWritableFile(FileId::first(), 0));
@@ -998,6 +1127,28 @@ LogDataStore::computeNumberOfSignificantBucketIdBits(const IBucketizer & bucketi
     return msb;
 }
 
+ZStdDictionary::SP
+LogDataStore::trainDictionary(const FileChunk & source) const
+{
+    const size_t maxDictionarySize(_config.getMaxDictionarySize());
+    if ((maxDictionarySize == 0) || (_config.getFileConfig().getCompression().type != CompressionConfig::ZSTD)) {
+        return ZStdDictionary::SP();
+    }
+    vespalib::DataBuffer samples;
+    std::vector<size_t> sampleSizes;
+    source.sample(maxDictionarySize * DICTIONARY_SAMPLE_FACTOR, samples, sampleSizes);
+    std::vector<char> dictionary = ZStdDictionary::train(vespalib::ConstBufferRef(samples.getData(), samples.getDataLen()),
+                                                         sampleSizes, maxDictionarySize);
+    if (dictionary.empty()) {
+        LOG(info, "Could not train a compression dictionary from %ld samples of file '%s'",
+                  sampleSizes.size(), source.getName().c_str());
+        return ZStdDictionary::SP();
+    }
+    LOG(info, "Trained a compression dictionary of %ld bytes from %ld samples of file '%s'",
+              dictionary.size(), sampleSizes.size(), source.getName().c_str());
+    return std::make_shared<ZStdDictionary>(dictionary.data(), dictionary.size());
+}
+
 void
 LogDataStore::verify(bool reportOnly) const
 {
@@ -1189,10 +1340,18 @@ LogDataStore::getFileChunkStats() const
     return std::move(result);
 }
 
+FileChunk::ZStdDictionary::SP
+LogDataStore::getCompressionDictionary() const
+{
+    LockGuard guard(_updateLock);
+    return _dictionary;
+}
+
 void
 LogDataStore::compactLidSpace(uint32_t wantedDocLidLimit)
 {
     LockGuard guard(_updateLock);
+    drainWriteBuffer(guard);
     assert(wantedDocLidLimit <= getDocIdLimit());
     for (size_t i = wantedDocLidLimit; i < _lidInfo.size(); ++i) {
         _lidInfo[i] = LidInfo();
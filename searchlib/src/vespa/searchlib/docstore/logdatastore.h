@@ -3,6 +3,7 @@
 #pragma once
 
 #include "idatastore.h"
+#include "bucketorderedwritebuffer.h"
 #include "lid_info.h"
 #include "writeablefilechunk.h"
 #include <vespa/vespalib/util/compressionconfig.h>
@@ -42,6 +43,19 @@ public:
         Config & setMaxDiskBloatFactor(double v) { _maxDiskBloatFactor = v; return *this; }
         Config & setMaxBucketSpread(double v) { _maxBucketSpread = v; return *this; }
         Config & setMinFileSizeFactor(double v) { _minFileSizeFactor = v; return *this; }
+        /**
+         * Max size of the zstd dictionary trained from the file being compacted.
+         * The dictionary is used for all files created after it, both compaction
+         * targets and active files. 0 disables dictionary compression.
+         */
+        Config & setMaxDictionarySize(size_t v) { _maxDictionarySize = v; return *this; }
+        /**
+         * Bytes of written entries to hold in memory before appending them to the active
+         * file grouped by bucket. 0 appends entries in arrival order, which is the default.
+         */
+        Config & setWriteBufferBytes(size_t v) { _writeBufferBytes = v; return *this; }
+        /** Limit the read bandwidth used by compaction. 0 means unlimited, which is the default. */
+        Config & setMaxCompactReadBytesPerSecond(size_t v) { _maxCompactReadBytesPerSecond = v; return *this; }
 
         Config & compactCompression(CompressionConfig v) { _compactCompression = v; return *this; }
         Config & setFileConfig(WriteableFileChunk::Config v) { _fileConfig = v; return *this; }
@@ -50,6 +64,9 @@ public:
         double getMaxDiskBloatFactor() const { return _maxDiskBloatFactor; }
         double getMaxBucketSpread() const { return _maxBucketSpread; }
         double getMinFileSizeFactor() const { return _minFileSizeFactor; }
+        size_t getMaxDictionarySize() const { return _maxDictionarySize; }
+        size_t getWriteBufferBytes() const { return _writeBufferBytes; }
+        size_t getMaxCompactReadBytesPerSecond() const { return _maxCompactReadBytesPerSecond; }
 
         bool crcOnReadDisabled() const { return _skipCrcOnRead; }
         bool compact2ActiveFile() const { return _compact2ActiveFile; }
@@ -65,6 +82,9 @@ public:
         double                      _maxDiskBloatFactor;
         double                      _maxBucketSpread;
         double                      _minFileSizeFactor;
+        size_t                      _maxDictionarySize;
+        size_t                      _writeBufferBytes;
+        size_t                      _maxCompactReadBytesPerSecond;
         bool                        _skipCrcOnRead;
         bool                        _compact2ActiveFile;
         CompressionConfig           _compactCompression;
@@ -176,6 +196,11 @@ public:
     static NameIdSet findIncompleteCompactedFiles(const NameIdSet & partList);
 
     NameIdSet getAllActiveFiles() const;
+    /**
+     * The compression dictionary used for new chunks, if one has been trained
+     * or recovered from disk.
+     */
+    FileChunk::ZStdDictionary::SP getCompressionDictionary() const;
     void reconfigure(const Config & config);
 
 private:
@@ -241,10 +266,13 @@ private:
     vespalib::string createIdxFileName(NameId id) const;
 
     void requireSpace(LockGuard guard, WriteableFileChunk & active);
+    void drainWriteBuffer(const LockGuard & guard);
+    bool hasBufferedWrites() const { return _hasBufferedWrites.load(std::memory_order_acquire); }
     bool isReadOnly() const { return _readOnly; }
     void updateSerialNum();
 
     size_t computeNumberOfSignificantBucketIdBits(const IBucketizer & bucketizer, FileId fileId) const;
+    FileChunk::ZStdDictionary::SP trainDictionary(const FileChunk & source) const;
 
     /*
      * Protect against compactWorst() dropping file chunk.  Caller must hold
@@ -287,6 +315,9 @@ private:
     IBucketizer::SP                          _bucketizer;
     NameIdSet                                _currentlyCompacting;
     uint64_t                                 _compactLidSpaceGeneration;
+    FileChunk::ZStdDictionary::SP            _dictionary;
+    docstore::BucketOrderedWriteBuffer       _writeBuffer;
+    std::atomic<bool>                        _hasBufferedWrites;
 };
 
 } // namespace search
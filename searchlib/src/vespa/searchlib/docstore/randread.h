@@ -19,6 +19,12 @@ public:
     virtual ~FileRandRead() { }
     virtual FSP read(size_t offset, vespalib::DataBuffer & buffer, size_t sz) = 0;
     virtual int64_t getSize() = 0;
+    /**
+     * Hint that the given range will be read soon. Readers going
+     * through the page cache pass this on to the OS, so that several
+     * ranges can be fetched from disk in parallel.
+     */
+    virtual void willNeed(size_t offset, size_t sz) { (void) offset; (void) sz; }
 };
 
 }
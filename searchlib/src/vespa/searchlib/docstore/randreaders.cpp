@@ -89,6 +89,12 @@ MMapRandRead::getSize() {
     return _file->GetSize();
 }
 
+void
+MMapRandRead::willNeed(size_t offset, size_t sz)
+{
+    _file->willNeed(offset, sz);
+}
+
 const void *
 MMapRandRead::getMapping() {
     return _file->MemoryMapPtr(0);
@@ -151,6 +157,13 @@ MMapRandReadDynamic::getSize() {
     return _holder.get()->GetSize();
 }
 
+void
+MMapRandReadDynamic::willNeed(size_t offset, size_t sz)
+{
+    FSP file(_holder.get());
+    file->willNeed(offset, sz);
+}
+
 FileRandRead::FSP
 NormalRandRead::read(size_t offset, vespalib::DataBuffer & buffer, size_t sz)
 {
@@ -167,4 +180,10 @@ NormalRandRead::getSize()
     return _file->GetSize();
 }
 
+void
+NormalRandRead::willNeed(size_t offset, size_t sz)
+{
+    _file->willNeed(offset, sz);
+}
+
 }
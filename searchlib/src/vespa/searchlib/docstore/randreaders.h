@@ -29,6 +29,7 @@ public:
     MMapRandRead(const vespalib::string & fileName, int mmapFlags, int fadviseOptions);
     FSP read(size_t offset, vespalib::DataBuffer & buffer, size_t sz) override;
     int64_t getSize() override;
+    void willNeed(size_t offset, size_t sz) override;
     const void * getMapping();
 private:
     std::unique_ptr<FastOS_FileInterface>  _file;
@@ -40,6 +41,7 @@ public:
     MMapRandReadDynamic(const vespalib::string & fileName, int mmapFlags, int fadviseOptions);
     FSP read(size_t offset, vespalib::DataBuffer & buffer, size_t sz) override;
     int64_t getSize() override;
+    void willNeed(size_t offset, size_t sz) override;
 private:
     static bool contains(const FastOS_FileInterface & file, size_t sz);
     void remap(size_t end);
@@ -56,6 +58,7 @@ public:
     NormalRandRead(const vespalib::string & fileName);
     FSP read(size_t offset, vespalib::DataBuffer & buffer, size_t sz) override;
     int64_t getSize() override;
+    void willNeed(size_t offset, size_t sz) override;
 private:
     std::unique_ptr<FastOS_FileInterface>  _file;
 };
@@ -0,0 +1,53 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "value.h"
+#include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <cassert>
+
+using vespalib::compression::compress;
+using vespalib::compression::decompress;
+
+namespace search::docstore {
+
+void
+Value::set(vespalib::DataBuffer &&buf, ssize_t len, const CompressionConfig &compression) {
+    //Underlying buffer must be identical to allow swap.
+    vespalib::DataBuffer compressed(buf.getData(), 0u);
+    CompressionConfig::Type type = compress(compression, vespalib::ConstBufferRef(buf.getData(), len),
+                                            compressed, true);
+    _compressedSize = compressed.getDataLen();
+    if (buf.getData() == compressed.getData()) {
+        // Uncompressed so we can just steal the underlying buffer.
+        buf.stealBuffer().swap(_buf);
+    } else {
+        compressed.stealBuffer().swap(_buf);
+    }
+    if (_buf.size() > _compressedSize) {
+        // The read or compression buffer is sized for the worst case, keep only what is used.
+        Alloc exact = _buf.create(_compressedSize);
+        memcpy(exact.get(), _buf.get(), _compressedSize);
+        _buf.swap(exact);
+    }
+    assert(((type == CompressionConfig::NONE) &&
+            (len == ssize_t(_compressedSize))) ||
+           ((type != CompressionConfig::NONE) &&
+            (len > ssize_t(_compressedSize))));
+    setCompression(type, len);
+}
+
+void
+Value::decompressTo(vespalib::DataBuffer &dest) const {
+    decompress(getCompression(), getUncompressedSize(), vespalib::ConstBufferRef(*this, size()), dest, false);
+}
+
+document::Document::UP
+Value::deserializeDocument(const document::DocumentTypeRepo &repo) const {
+    // Uncompressed values are used in place.
+    vespalib::DataBuffer uncompressed((const char *) get(), (size_t) 0);
+    decompress(getCompression(), getUncompressedSize(), vespalib::ConstBufferRef(*this, size()), uncompressed, true);
+    vespalib::nbostream is(uncompressed.getData(), uncompressed.getDataLen());
+    return std::make_unique<document::Document>(repo, is);
+}
+
+}
@@ -0,0 +1,87 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/util/alloc.h>
+#include <vespa/vespalib/util/compressionconfig.h>
+#include <vespa/document/fieldvalue/document.h>
+
+namespace search::docstore {
+
+/**
+ * A serialized document as held by the document store cache. The serialized form is kept
+ * compressed in a buffer of exactly the compressed size, and is decompressed on every access.
+ */
+class Value {
+public:
+    using Alloc = vespalib::alloc::Alloc;
+    using CompressionConfig = vespalib::compression::CompressionConfig;
+    typedef std::unique_ptr<Value> UP;
+
+    Value() : _compressedSize(0), _uncompressedSize(0), _compression(CompressionConfig::NONE) {}
+
+    Value(Value &&rhs) :
+            _compressedSize(rhs._compressedSize),
+            _uncompressedSize(rhs._uncompressedSize),
+            _compression(rhs._compression),
+            _buf(std::move(rhs._buf)) {}
+
+    Value(const Value &rhs) :
+            _compressedSize(rhs._compressedSize),
+            _uncompressedSize(rhs._uncompressedSize),
+            _compression(rhs._compression),
+            _buf(Alloc::alloc(rhs.size())) {
+        memcpy(get(), rhs.get(), size());
+    }
+
+    Value &operator=(Value &&rhs) {
+        _buf = std::move(rhs._buf);
+        _compressedSize = rhs._compressedSize;
+        _uncompressedSize = rhs._uncompressedSize;
+        _compression = rhs._compression;
+        return *this;
+    }
+
+    void setCompression(CompressionConfig::Type comp, size_t uncompressedSize) {
+        _compression = comp;
+        _uncompressedSize = uncompressedSize;
+    }
+
+    CompressionConfig::Type getCompression() const { return _compression; }
+
+    size_t getUncompressedSize() const { return _uncompressedSize; }
+
+    /**
+     * Compress buffer into temporary buffer and copy temporary buffer to
+     * value along with compression config.
+     * The value keeps no more memory than the compressed size, so that the
+     * cache byte budget reflects the memory actually held.
+     */
+    void set(vespalib::DataBuffer &&buf, ssize_t len, const CompressionConfig &compression);
+
+    /**
+     * Append the decompressed serialized document to the given buffer.
+     */
+    void decompressTo(vespalib::DataBuffer &dest) const;
+
+    /**
+     * Decompress value into temporary buffer and deserialize document from
+     * the temporary buffer.
+     */
+    document::Document::UP deserializeDocument(const document::DocumentTypeRepo &repo) const;
+
+    size_t size() const { return _compressedSize; }
+    size_t allocatedSize() const { return _buf.size(); }
+    bool empty() const { return size() == 0; }
+    operator const void *() const { return _buf.get(); }
+    const void *get() const { return _buf.get(); }
+    void *get() { return _buf.get(); }
+private:
+    size_t _compressedSize;
+    size_t _uncompressedSize;
+    CompressionConfig::Type _compression;
+    Alloc _buf;
+};
+
+}
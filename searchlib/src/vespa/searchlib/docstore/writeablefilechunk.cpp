@@ -86,7 +86,8 @@ WriteableFileChunk(vespalib::ThreadExecutor &executor,
                    const TuneFileSummary &tune,
                    const FileHeaderContext &fileHeaderContext,
                    const IBucketizer * bucketizer,
-                   bool skipCrcOnRead)
+                   bool skipCrcOnRead,
+                   const ZStdDictionary::SP & dictionary)
     : FileChunk(fileId, nameId, baseName, tune, bucketizer, skipCrcOnRead),
       _config(config),
       _serialNum(initialSerialNum),
@@ -121,7 +122,7 @@ WriteableFileChunk(vespalib::ThreadExecutor &executor,
     if (_dataFile.OpenReadWrite()) {
         readDataHeader();
         if (_dataHeaderLen == 0) {
-            writeDataHeader(fileHeaderContext);
+            writeDataHeader(fileHeaderContext, dictionary);
         }
         _dataFile.SetPosition(_dataFile.GetSize());
         if (tune._write.getWantDirectIO()) {
@@ -208,7 +209,8 @@ seek_past(LidInfoWithLidV::const_iterator begin, LidInfoWithLidV::const_iterator
 }
 
 void
-WriteableFileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor) const
+WriteableFileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor,
+                         vespalib::ThreadExecutor * executor) const
 {
     if (count == 0) { return; }
     if (!frozen()) {
@@ -239,7 +241,31 @@ WriteableFileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, IB
             FileChunk::read(first, last - first, it.second, visitor);
         }
     } else {
-        FileChunk::read(begin, count, visitor);
+        FileChunk::read(begin, count, visitor, executor);
+    }
+}
+
+void
+WriteableFileChunk::willNeed(LidInfoWithLidV::const_iterator begin, size_t count) const
+{
+    if (!frozen()) {
+        std::vector<ChunkInfo> chunksOnFile;
+        {
+            LockGuard guard(_lock);
+            uint32_t prevChunk = std::numeric_limits<uint32_t>::max();
+            for (size_t i(0); i < count; i++) {
+                uint32_t chunk = (begin + i)->getChunkId();
+                if ((chunk != prevChunk) && (chunk < _chunkInfo.size()) && _chunkInfo[chunk].valid()) {
+                    chunksOnFile.push_back(_chunkInfo[chunk]);
+                }
+                prevChunk = chunk;
+            }
+        }
+        for (const ChunkInfo & ci : chunksOnFile) {
+            FileChunk::willNeed(ci);
+        }
+    } else {
+        FileChunk::willNeed(begin, count);
     }
 }
 
@@ -278,7 +304,7 @@ WriteableFileChunk::internalFlush(uint32_t chunkId, uint64_t serialNum)
     if (_alignment > 1) {
         tmp->getBuf().ensureFree(active->getMaxPackSize(_config.getCompression()) + _alignment - 1);
     }
-    active->pack(serialNum, tmp->getBuf(), _config.getCompression());
+    active->pack(serialNum, tmp->getBuf(), _config.getCompression(), _dictionary.get());
     tmp->setPayLoad();
     if (_alignment > 1) {
         const size_t padAfter((_alignment - tmp->getPayLoad() % _alignment) % _alignment);
@@ -727,6 +753,7 @@ WriteableFileChunk::readDataHeader()
         FileHeader h;
         _dataHeaderLen = h.readFile(_dataFile);
         _dataFile.SetPosition(_dataHeaderLen);
+        _dictionary = readDictionary(h);
     } catch (IllegalHeaderException &e) {
         _dataFile.SetPosition(0);
         try {
@@ -784,7 +811,7 @@ WriteableFileChunk::readIdxHeader(FastOS_FileInterface & idxFile)
 
 
 void
-WriteableFileChunk::writeDataHeader(const FileHeaderContext &fileHeaderContext)
+WriteableFileChunk::writeDataHeader(const FileHeaderContext &fileHeaderContext, const ZStdDictionary::SP & dictionary)
 {
     typedef FileHeader::Tag Tag;
     FileHeader h(headerAlign);
@@ -793,7 +820,11 @@ WriteableFileChunk::writeDataHeader(const FileHeaderContext &fileHeaderContext)
     assert(_dataFile.GetPosition() == 0);
     fileHeaderContext.addTags(h, _dataFile.GetFileName());
     h.putTag(Tag("desc", "Log data store chunk data"));
+    if (dictionary) {
+        writeDictionary(h, *dictionary);
+    }
     _dataHeaderLen = h.writeFile(_dataFile);
+    _dictionary = dictionary;
 }
 
 
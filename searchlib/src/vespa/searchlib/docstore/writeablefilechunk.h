@@ -46,11 +46,14 @@ public:
                        const vespalib::string & baseName, uint64_t initialSerialNum,
                        uint32_t docIdLimit, const Config & config,
                        const TuneFileSummary &tune, const common::FileHeaderContext &fileHeaderContext,
-                       const IBucketizer * bucketizer, bool crcOnReadDisabled);
+                       const IBucketizer * bucketizer, bool crcOnReadDisabled,
+                       const ZStdDictionary::SP & dictionary = ZStdDictionary::SP());
     ~WriteableFileChunk();
 
     ssize_t read(uint32_t lid, SubChunkId chunk, vespalib::DataBuffer & buffer) const override;
-    void read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor) const override;
+    void read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor,
+              vespalib::ThreadExecutor * executor) const override;
+    void willNeed(LidInfoWithLidV::const_iterator begin, size_t count) const override;
 
     LidInfo append(uint64_t serialNum, uint32_t lid, const void * buffer, size_t len);
     void flush(bool block, uint64_t syncToken);
@@ -87,7 +90,7 @@ private:
     ProcessedChunkQ drainQ();
     void readDataHeader();
     void readIdxHeader(FastOS_FileInterface & idxFile);
-    void writeDataHeader(const common::FileHeaderContext &fileHeaderContext);
+    void writeDataHeader(const common::FileHeaderContext &fileHeaderContext, const ZStdDictionary::SP & dictionary);
     bool needFlushPendingChunks(uint64_t serialNum, uint64_t datFileLen);
     bool needFlushPendingChunks(const vespalib::MonitorGuard & guard, uint64_t serialNum, uint64_t datFileLen);
     fastos::TimeStamp unconditionallyFlushPendingChunks(const vespalib::LockGuard & flushGuard, uint64_t serialNum, uint64_t datFileLen);
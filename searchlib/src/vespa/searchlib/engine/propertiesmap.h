@@ -123,6 +123,15 @@ public:
         return lookup(MapNames::MODEL);
     }
 
+    /**
+     * Obtain trace properties (used to request and return traces)
+     *
+     * @return trace properties
+     **/
+    const Props &traceProperties() const {
+        return lookup(MapNames::TRACE);
+    }
+
 };
 
 }
@@ -7,6 +7,7 @@ namespace engine {
 
 Request::Request(const fastos::TimeStamp &start_time)
     : _startTime(start_time),
+      _receiveTime(std::chrono::steady_clock::now()),
       _timeOfDoom(fastos::TimeStamp(fastos::TimeStamp::FUTURE)),
       ranking(),
       queryFlags(0),
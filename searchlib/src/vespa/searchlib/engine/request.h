@@ -4,6 +4,7 @@
 
 #include "propertiesmap.h"
 #include <vespa/fastos/timestamp.h>
+#include <chrono>
 
 namespace search::engine {
 
@@ -14,6 +15,8 @@ public:
     virtual ~Request();
     void setTimeout(const fastos::TimeStamp & timeout);
     fastos::TimeStamp getStartTime() const { return _startTime; }
+    /// Monotonic time of construction, used as origin for span traces.
+    std::chrono::steady_clock::time_point getReceiveTime() const { return _receiveTime; }
     fastos::TimeStamp getTimeOfDoom() const { return _timeOfDoom; }
     fastos::TimeStamp getTimeout() const { return _timeOfDoom -_startTime; }
     fastos::TimeStamp getTimeUsed() const;
@@ -26,6 +29,7 @@ public:
 
 private:
     const fastos::TimeStamp _startTime;
+    const std::chrono::steady_clock::time_point _receiveTime;
     fastos::TimeStamp       _timeOfDoom;
 public:
     /// Everything here should move up to private section and have accessors
@@ -13,14 +13,15 @@ namespace features {
 DenseTensorAttributeExecutor::
 DenseTensorAttributeExecutor(const DenseTensorAttribute *attribute)
     : _attribute(attribute),
-      _tensorView(_attribute->getConfig().tensorType())
+      _tensorView(_attribute->getConfig().tensorType()),
+      _decodedCells()
 {
 }
 
 void
 DenseTensorAttributeExecutor::execute(uint32_t docId)
 {
-    _attribute->getTensor(docId, _tensorView);
+    _attribute->getTensor(docId, _tensorView, _decodedCells);
     outputs().set_object(0, _tensorView);
 }
 
@@ -12,13 +12,15 @@ namespace features {
 
 /**
  * Executor for extracting dense tensors from an underlying dense tensor attribute
- * without copying cells data.
+ * without copying cells data. Cells stored with a compact cell type are
+ * converted to double in a buffer owned by the executor.
  */
 class DenseTensorAttributeExecutor : public fef::FeatureExecutor
 {
 private:
     const search::tensor::DenseTensorAttribute *_attribute;
     vespalib::tensor::MutableDenseTensorView _tensorView;
+    std::vector<double> _decodedCells;
 
 public:
     DenseTensorAttributeExecutor(const search::tensor::DenseTensorAttribute *attribute);
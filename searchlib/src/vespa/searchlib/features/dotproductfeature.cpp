@@ -329,6 +329,19 @@ parseVectors(const Property& prop, std::vector<T>& values, std::vector<uint32_t>
     }
 }
 
+// int8_t would be parsed as characters, so parse as int32_t and clamp to the int8_t range.
+template <>
+void
+parseVectors(const Property& prop, std::vector<int8_t>& values, std::vector<uint32_t>& indexes)
+{
+    std::vector<int32_t> wideValues;
+    parseVectors(prop, wideValues, indexes);
+    values.reserve(wideValues.size());
+    for (int32_t value : wideValues) {
+        values.push_back(static_cast<int8_t>(std::max(-128, std::min(127, value))));
+    }
+}
+
 }
 
 namespace dotproduct {
@@ -466,6 +479,8 @@ createFromObject(const IAttributeVector * attribute, const fef::Anything & objec
     if (attribute->getCollectionType() == attribute::CollectionType::ARRAY) {
         if (!isImportedAttribute(*attribute)) {
             switch (attribute->getBasicType()) {
+                case BasicType::INT8:
+                    return createForDirectArray<IntegerAttributeTemplate<int8_t>>(attribute, dynamic_cast<const ArrayParam<int8_t> &>(object), stash);
                 case BasicType::INT32:
                     return createForDirectArray<IntegerAttributeTemplate<int32_t>>(attribute, dynamic_cast<const ArrayParam<int32_t> &>(object), stash);
                 case BasicType::INT64:
@@ -479,6 +494,7 @@ createFromObject(const IAttributeVector * attribute, const fef::Anything & objec
             }
         } else {
             switch (attribute->getBasicType()) {
+                case BasicType::INT8:
                 case BasicType::INT32:
                 case BasicType::INT64:
                     return createForImportedArray<int64_t>(attribute, dynamic_cast<const ArrayParam<int64_t> &>(object), stash);
@@ -492,7 +508,7 @@ createFromObject(const IAttributeVector * attribute, const fef::Anything & objec
     }
     // TODO: Add support for creating executor for weighted set string / integer attribute
     //       where the query vector is represented as an object instead of a string.
-    LOG(warning, "The attribute vector '%s' is NOT of type array<int/long/float/double>"
+    LOG(warning, "The attribute vector '%s' is NOT of type array<byte/int/long/float/double>"
             ", returning executor with default value.", attribute->getName().c_str());
     return stash.create<SingleZeroValueExecutor>();
 }
@@ -502,6 +518,8 @@ FeatureExecutor * createTypedArrayExecutor(const IAttributeVector * attribute,
                                            vespalib::Stash & stash) {
     if (!isImportedAttribute(*attribute)) {
         switch (attribute->getBasicType()) {
+            case BasicType::INT8:
+                return &createForDirectArray<IntegerAttributeTemplate<int8_t>>(attribute, prop, stash);
             case BasicType::INT32:
                 return &createForDirectArray<IntegerAttributeTemplate<int32_t>>(attribute, prop, stash);
             case BasicType::INT64:
@@ -519,6 +537,7 @@ FeatureExecutor * createTypedArrayExecutor(const IAttributeVector * attribute,
         // on int32_t or float, or reinterpreting type casts will end up pointing at
         // data that is not of the correct size. Which would be Bad(tm).
         switch (attribute->getBasicType()) {
+            case BasicType::INT8:
             case BasicType::INT32:
             case BasicType::INT64:
                 return &createForImportedArray<IAttributeVector::largeint_t>(attribute, prop, stash);
@@ -572,7 +591,7 @@ createFromString(const IAttributeVector * attribute, const Property & prop, vesp
 
     if (executor == nullptr) {
         LOG(warning, "The attribute vector '%s' is not of type weighted set string/integer nor"
-                " array<int/long/float/double>, returning executor with default value.", attribute->getName().c_str());
+                " array<byte/int/long/float/double>, returning executor with default value.", attribute->getName().c_str());
         executor = &stash.create<SingleZeroValueExecutor>();
     }
     return *executor;
@@ -581,6 +600,8 @@ createFromString(const IAttributeVector * attribute, const Property & prop, vesp
 fef::Anything::UP attemptParseArrayQueryVector(const IAttributeVector & attribute, const Property & prop) {
     if (!isImportedAttribute(attribute)) {
         switch (attribute.getBasicType()) {
+            case BasicType::INT8:
+                return std::make_unique<ArrayParam<int8_t>>(prop);
             case BasicType::INT32:
                 return std::make_unique<ArrayParam<int32_t>>(prop);
             case BasicType::INT64:
@@ -596,6 +617,7 @@ fef::Anything::UP attemptParseArrayQueryVector(const IAttributeVector & attribut
         // See rationale in createTypedArrayExecutor() as to why we promote < 64 bit types
         // to their full-width equivalent when dealing with imported attributes.
         switch (attribute.getBasicType()) {
+            case BasicType::INT8:
             case BasicType::INT32:
             case BasicType::INT64:
                 return std::make_unique<ArrayParam<int64_t>>(prop);
@@ -5,6 +5,7 @@
 #include <vespa/searchlib/fef/properties.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/locale/c.h>
+#include <algorithm>
 #include <iostream>
 #include <set>
 
@@ -50,7 +51,7 @@ Computer::Computer(const vespalib::string &propertyNamespace, const PhraseSplitt
             _queryTerms.push_back(qt);
             _simpleMetrics.addSearchedTerm(qt.termData()->getWeight().percent());
             _queryTermFieldMatch.push_back(NULL);
-            _cachedHits.push_back(BitVectorData());
+            _cachedHits.push_back(PositionsData());
         }
     }
 
@@ -113,21 +114,23 @@ Computer::reset(uint32_t docId)
             }
 
             if (_useCachedHits && it.valid() && fieldLength != FieldPositionsIterator::UNKNOWN_LENGTH) {
-                // cache the field position iterator in a bit vector for faster lookup in
+                // cache the field positions in a sorted vector for faster lookup in
                 // findClosestInFieldBySemanticDistance()
-                _cachedHits[i].bitvector.clear();
+                std::vector<uint32_t> &positions = _cachedHits[i].positions;
+                positions.clear();
                 _cachedHits[i].valid = true;
-                if (_cachedHits[i].bitvector.size() < _fieldLength) {
-                    _cachedHits[i].bitvector.resize(_fieldLength);
-                }
                 for (; it.valid(); it.next()) {
                     uint32_t fieldPos = it.getPosition();
                     if (__builtin_expect(fieldPos < _fieldLength, true))
-                        _cachedHits[i].bitvector.setBit(fieldPos);
+                        positions.push_back(fieldPos);
                     else {
                         handleError(fieldPos, docId);
                     }
                 }
+                // positions are only sorted within each element
+                if (!std::is_sorted(positions.begin(), positions.end())) {
+                    std::sort(positions.begin(), positions.end());
+                }
             }
         }
         _queryTermFieldMatch[i] = tfmd;
@@ -164,19 +167,7 @@ Computer::findClosestInFieldBySemanticDistance(int i, int previousJ, uint32_t st
             return -1; // not matched
         }
 
-        const BitVector & hits = _cachedHits[i].bitvector;
-
-        for (uint32_t distance = startSemanticDistance; distance < _fieldLength; distance++) {
-            int j = semanticDistanceToFieldIndex(distance, previousJ);
-            if (j < 0) {
-                continue;
-            }
-
-            if (hits.testBit((uint32_t)j)) {
-                return distance;
-            }
-        }
-        return -1;
+        return findClosestInPositions(_cachedHits[i].positions, previousJ, startSemanticDistance);
     }
 
     const TermFieldMatchData *termFieldMatch = _queryTermFieldMatch[i];
@@ -201,6 +192,43 @@ Computer::findClosestInFieldBySemanticDistance(int i, int previousJ, uint32_t st
     return -1;
 }
 
+int
+Computer::findClosestInPositions(const std::vector<uint32_t> &positions, uint32_t zeroJ,
+                                 uint32_t startSemanticDistance) const
+{
+    if (positions.empty() || zeroJ > _fieldLength) {
+        return -1;
+    }
+    uint32_t firstSegmentLength = std::min(_params.getProximityLimit(), _fieldLength - zeroJ);
+    uint32_t secondSegmentLength = std::min(_params.getProximityLimit(), zeroJ);
+    // semantic distance ranges in the order they are visited, see semanticDistanceToFieldIndex()
+    uint32_t bounds[5] = { 0, firstSegmentLength, firstSegmentLength + secondSegmentLength,
+                           _fieldLength - zeroJ + secondSegmentLength, _fieldLength };
+    for (uint32_t range = 0; range < 4; ++range) {
+        uint32_t begin = std::max(bounds[range], startSemanticDistance);
+        uint32_t end = bounds[range + 1];
+        if (begin >= end) {
+            continue;
+        }
+        uint32_t beginJ = semanticDistanceToFieldIndex(begin, zeroJ);
+        uint32_t lastJ = semanticDistanceToFieldIndex(end - 1, zeroJ);
+        if ((range % 2) == 0) {
+            // forward: look for the first position at or after beginJ
+            auto pos = std::lower_bound(positions.begin(), positions.end(), beginJ);
+            if ((pos != positions.end()) && (*pos <= lastJ)) {
+                return begin + (*pos - beginJ);
+            }
+        } else {
+            // backward: look for the last position at or before beginJ
+            auto pos = std::upper_bound(positions.begin(), positions.end(), beginJ);
+            if ((pos != positions.begin()) && (*(--pos) >= lastJ)) {
+                return begin + (beginJ - *pos);
+            }
+        }
+    }
+    return -1;
+}
+
 int
 Computer::semanticDistanceToFieldIndex(int semanticDistance, uint32_t zeroJ) const
 {
@@ -6,7 +6,6 @@
 #include <vespa/searchlib/fef/matchdata.h>
 #include <vespa/searchlib/fef/phrasesplitter.h>
 #include <vespa/searchlib/features/queryterm.h>
-#include <vespa/searchlib/common/allocatedbitvector.h>
 #include <string>
 #include <vector>
 #include "metrics.h"
@@ -321,11 +320,18 @@ private:
      */
     void setOccurrenceCounts(Metrics &metrics);
 
+    /**
+     * Returns the smallest semantic distance not less than startSemanticDistance at which the given sorted
+     * positions have a match, or -1 if there is none. The semantic order visits the field in four ranges,
+     * so we do one binary search per range instead of testing one field index at a time.
+     */
+    int findClosestInPositions(const std::vector<uint32_t> &positions, uint32_t zeroJ,
+                               uint32_t startSemanticDistance) const;
+
     void handleError(uint32_t fieldPos, uint32_t docId) const __attribute__((noinline));
 
 
 private:
-    typedef std::shared_ptr<search::BitVector> BitVectorPtr;
     typedef std::vector<const search::fef::TermFieldMatchData *> TermFieldMatchDataVector;
 
     struct SegmentData {
@@ -335,9 +341,9 @@ private:
         bool valid;
     };
 
-    struct BitVectorData {
-        BitVectorData() : bitvector(0), valid(false) {}
-        search::AllocatedBitVector bitvector;
+    struct PositionsData {
+        PositionsData() : positions(), valid(false) {}
+        std::vector<uint32_t> positions; // sorted field positions
         bool valid;
     };
 
@@ -361,7 +367,7 @@ private:
     SimpleMetrics                              _simpleMetrics;  // The metrics used to compute simple features.
     std::vector<SegmentData>                   _segments;       // Known segment starting points.
     uint32_t                                   _alternativeSegmentationsTried;
-    std::vector<BitVectorData>                 _cachedHits;
+    std::vector<PositionsData>                 _cachedHits;
 };
 
 } // fieldmatch
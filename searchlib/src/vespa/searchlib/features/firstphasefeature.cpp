@@ -3,6 +3,7 @@
 #include "firstphasefeature.h"
 #include <vespa/searchlib/fef/featureexecutor.h>
 #include <vespa/searchlib/fef/indexproperties.h>
+#include <vespa/searchlib/fef/matchdata.h>
 #include <vespa/searchlib/fef/properties.h>
 
 using namespace search::fef;
@@ -11,9 +12,20 @@ namespace search {
 namespace features {
 
 void
-FirstPhaseExecutor::execute(uint32_t)
+FirstPhaseExecutor::handle_bind_match_data(const MatchData &md)
 {
-    outputs().set_number(0, inputs().get_number(0));
+    _md = &md;
+}
+
+void
+FirstPhaseExecutor::execute(uint32_t docId)
+{
+    if (_md != nullptr && _md->has_first_phase_score(docId)) {
+        // score cached from first phase, skip evaluating the expression
+        outputs().set_number(0, _md->get_first_phase_score());
+    } else {
+        outputs().set_number(0, inputs().get_number(0));
+    }
 }
 
 
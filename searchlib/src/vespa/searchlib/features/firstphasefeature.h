@@ -11,7 +11,11 @@ namespace features {
  * Implements the executor outputting the first phase ranking.
  */
 class FirstPhaseExecutor : public fef::FeatureExecutor {
+private:
+    const fef::MatchData *_md;
+    void handle_bind_match_data(const fef::MatchData &md) override;
 public:
+    FirstPhaseExecutor() : _md(nullptr) {}
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
 };
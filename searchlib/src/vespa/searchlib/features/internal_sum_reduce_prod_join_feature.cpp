@@ -0,0 +1,195 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "internal_sum_reduce_prod_join_feature.h"
+#include "valuefeature.h"
+
+#include <vespa/log/log.h>
+#include <vespa/searchlib/fef/featureexecutor.h>
+#include <vespa/searchlib/fef/indexproperties.h>
+#include <vespa/searchlib/fef/properties.h>
+#include <vespa/searchlib/tensor/generic_tensor_attribute.h>
+#include <vespa/eval/eval/value_type.h>
+#include <vespa/eval/tensor/tensor.h>
+#include <vespa/eval/tensor/tensor_address.h>
+#include <vespa/eval/tensor/tensor_visitor.h>
+#include <vespa/eval/tensor/serialization/typed_binary_format.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+
+LOG_SETUP(".features.internalsumreduceprodjoin");
+
+using namespace search::fef;
+using namespace search::fef::indexproperties;
+using search::attribute::IAttributeVector;
+using search::tensor::GenericTensorAttribute;
+using search::tensor::SparseTensorView;
+using search::tensor::TensorAttribute;
+using vespalib::eval::ValueType;
+using vespalib::tensor::Tensor;
+using vespalib::tensor::TensorAddress;
+using vespalib::tensor::TensorVisitor;
+using vespalib::tensor::TypedBinaryFormat;
+
+namespace search {
+namespace features {
+
+namespace {
+
+bool
+isSingleMappedDimension(const ValueType &type)
+{
+    return (type.is_tensor() && (type.dimensions().size() == 1) && type.dimensions()[0].is_mapped());
+}
+
+/**
+ * Query tensor cells, keyed on the label of the single dimension.
+ */
+class QueryCells : public TensorVisitor
+{
+    std::vector<std::pair<vespalib::string, double>> _cells;
+    vespalib::hash_map<vespalib::stringref, double> _map;
+public:
+    QueryCells() : _cells(), _map() {}
+    QueryCells(QueryCells &&) = default;
+    ~QueryCells() override;
+    void visit(const TensorAddress &address, double value) override {
+        if (address.elements().size() == 1) {
+            _cells.emplace_back(address.elements()[0].label(), value);
+        }
+    }
+    void syncMap() {
+        _map.resize(_cells.size() * 2);
+        for (const auto &cell : _cells) {
+            _map[cell.first] = cell.second;
+        }
+    }
+    bool empty() const { return _cells.empty(); }
+    double lookup(vespalib::stringref label) const {
+        auto itr = _map.find(label);
+        return (itr != _map.end()) ? itr->second : 0.0;
+    }
+};
+
+QueryCells::~QueryCells() = default;
+
+/**
+ * Visits the cells of a materialized attribute tensor, used when the
+ * attribute tensor can not be viewed directly in the tensor store.
+ */
+class SumProductVisitor : public TensorVisitor
+{
+    const QueryCells &_query;
+public:
+    feature_t sum;
+    SumProductVisitor(const QueryCells &query) : _query(query), sum(0.0) {}
+    void visit(const TensorAddress &address, double value) override {
+        if (address.elements().size() == 1) {
+            sum += value * _query.lookup(address.elements()[0].label());
+        }
+    }
+};
+
+class SumReduceProdJoinExecutor : public FeatureExecutor
+{
+    const TensorAttribute &_attribute;
+    const GenericTensorAttribute *_genericAttribute;
+    QueryCells _query;
+public:
+    SumReduceProdJoinExecutor(const TensorAttribute &attribute, QueryCells query)
+        : _attribute(attribute),
+          _genericAttribute(dynamic_cast<const GenericTensorAttribute *>(&attribute)),
+          _query(std::move(query))
+    {
+        _query.syncMap();
+    }
+    void execute(uint32_t docId) override {
+        if (_genericAttribute != nullptr) {
+            SparseTensorView view = _genericAttribute->getSparseTensorView(docId);
+            if (view.valid()) {
+                feature_t sum = 0.0;
+                view.forEachCell([&](vespalib::stringref label, double value)
+                                 { sum += value * _query.lookup(label); });
+                outputs().set_number(0, sum);
+                return;
+            }
+        }
+        SumProductVisitor visitor(_query);
+        auto tensor = _attribute.getTensor(docId);
+        if (tensor) {
+            tensor->accept(visitor);
+        }
+        outputs().set_number(0, visitor.sum);
+    }
+};
+
+}
+
+InternalSumReduceProdJoinBlueprint::InternalSumReduceProdJoinBlueprint() :
+        Blueprint("internalSumReduceProdJoin")
+{
+}
+
+InternalSumReduceProdJoinBlueprint::~InternalSumReduceProdJoinBlueprint()
+{
+}
+
+void
+InternalSumReduceProdJoinBlueprint::visitDumpFeatures(const IIndexEnvironment &,
+                                                      IDumpFeatureVisitor &) const
+{
+}
+
+Blueprint::UP
+InternalSumReduceProdJoinBlueprint::createInstance() const
+{
+    return Blueprint::UP(new InternalSumReduceProdJoinBlueprint());
+}
+
+ParameterDescriptions
+InternalSumReduceProdJoinBlueprint::getDescriptions() const
+{
+    return ParameterDescriptions().desc().attribute(ParameterDataTypeSet::normalOrTensorTypeSet(), ParameterCollection::ANY).string();
+}
+
+bool
+InternalSumReduceProdJoinBlueprint::setup(const IIndexEnvironment &env, const ParameterList &params)
+{
+    _attribute = params[0].getValue();
+    _query = params[1].getValue();
+    ValueType attributeType = ValueType::from_spec(type::Attribute::lookup(env.getProperties(), _attribute));
+    ValueType queryType = ValueType::from_spec(type::QueryFeature::lookup(env.getProperties(), _query));
+    if (!isSingleMappedDimension(attributeType) || (attributeType != queryType)) {
+        return false;
+    }
+    describeOutput("scalar", "Internal executor for optimized execution of reduce(join(A,Q,f(x,y)(x*y)),sum)");
+    env.hintAttributeAccess(_attribute);
+    return true;
+}
+
+FeatureExecutor &
+InternalSumReduceProdJoinBlueprint::createExecutor(const IQueryEnvironment &env, vespalib::Stash &stash) const
+{
+    const IAttributeVector *attribute = env.getAttributeContext().getAttribute(_attribute);
+    const TensorAttribute *tensorAttribute = dynamic_cast<const TensorAttribute *>(attribute);
+    if (tensorAttribute == nullptr) {
+        LOG(warning, "The attribute vector '%s' was not found or is not a tensor attribute, "
+                "returning executor with default value.",
+            _attribute.c_str());
+        return stash.create<SingleZeroValueExecutor>();
+    }
+    Property prop = env.getProperties().lookup(_query);
+    if (prop.found() && !prop.get().empty()) {
+        const vespalib::string &value = prop.get();
+        vespalib::nbostream stream(value.data(), value.size());
+        auto tensor = TypedBinaryFormat::deserialize(stream);
+        QueryCells query;
+        tensor->accept(query);
+        if (!query.empty()) {
+            return stash.create<SumReduceProdJoinExecutor>(*tensorAttribute, std::move(query));
+        }
+    }
+    return stash.create<SingleZeroValueExecutor>();
+}
+
+}
+}
@@ -0,0 +1,46 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchlib/fef/blueprint.h>
+
+namespace search {
+namespace features {
+
+/**
+ * Feature for the specific replacement of the expression:
+ *
+ *      reduce(
+ *          join(
+ *              attribute(A),
+ *              query(Q),
+ *              f(x,y)(x*y)
+ *          ),
+ *          sum
+ *      )
+ *
+ * where A is a tensor attribute and Q is a query tensor, both of the same
+ * sparse tensor type with a single mapped dimension. The cells of the
+ * attribute tensor are decoded lazily from the tensor store and probed
+ * against the query tensor, avoiding materializing the attribute tensor
+ * and the intermediate join result for each document.
+ */
+class InternalSumReduceProdJoinBlueprint : public fef::Blueprint {
+private:
+    vespalib::string _attribute;
+    vespalib::string _query;
+
+public:
+    InternalSumReduceProdJoinBlueprint();
+    ~InternalSumReduceProdJoinBlueprint();
+
+    fef::ParameterDescriptions getDescriptions() const override;
+    fef::Blueprint::UP createInstance() const override;
+    bool setup(const fef::IIndexEnvironment &env, const fef::ParameterList &params) override;
+    fef::FeatureExecutor &createExecutor(const fef::IQueryEnvironment &env, vespalib::Stash &stash) const override;
+    void visitDumpFeatures(const fef::IIndexEnvironment &env, fef::IDumpFeatureVisitor &visitor) const override;
+
+};
+
+}
+}
@@ -7,6 +7,7 @@
 #include <vespa/searchlib/features/rankingexpression/feature_name_extractor.h>
 #include <vespa/eval/tensor/default_tensor_engine.h>
 #include <vespa/eval/eval/param_usage.h>
+#include <vespa/vespalib/util/approx.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".features.rankingexpression");
@@ -68,10 +69,12 @@ class LazyCompiledRankingExpressionExecutor : public fef::FeatureExecutor
 private:
     using function_type = CompiledFunction::lazy_function;
     function_type _ranking_function;
+    bool          _conditional_inputs;
 
 public:
-    LazyCompiledRankingExpressionExecutor(const CompiledFunction &compiled_function);
+    LazyCompiledRankingExpressionExecutor(const CompiledFunction &compiled_function, bool conditional_inputs);
     bool isPure() override { return true; }
+    bool has_conditional_inputs() const override { return _conditional_inputs; }
     void execute(uint32_t docId) override;
 };
 
@@ -92,19 +95,25 @@ struct MyLazyParams : InterpretedFunction::LazyParams {
 };
 
 /**
- * Implements the executor for interpreted ranking expressions (with tensor support)
+ * Implements the executor for interpreted ranking expressions (with
+ * tensor support). Expressions with number output are interpreted
+ * while they are being compiled in the background.
  **/
+template <bool number_output>
 class InterpretedRankingExpressionExecutor : public fef::FeatureExecutor
 {
 private:
     const InterpretedFunction   &_function;
     InterpretedFunction::Context _context;
     MyLazyParams                 _params;
+    bool                         _conditional_inputs;
 
 public:
     InterpretedRankingExpressionExecutor(const InterpretedFunction &function,
-                                         ConstArrayRef<char> input_is_object);
+                                         ConstArrayRef<char> input_is_object,
+                                         bool conditional_inputs);
     bool isPure() override { return true; }
+    bool has_conditional_inputs() const override { return _conditional_inputs; }
     void execute(uint32_t docId) override;
 };
 
@@ -138,8 +147,10 @@ using Context = fef::FeatureExecutor::Inputs;
 double resolve_input(void *ctx, size_t idx) { return ((const Context *)(ctx))->get_number(idx); }
 Context *make_ctx(const Context &inputs) { return const_cast<Context *>(&inputs); }
 
-LazyCompiledRankingExpressionExecutor::LazyCompiledRankingExpressionExecutor(const CompiledFunction &compiled_function)
-    : _ranking_function(compiled_function.get_lazy_function())
+LazyCompiledRankingExpressionExecutor::LazyCompiledRankingExpressionExecutor(const CompiledFunction &compiled_function,
+                                                                             bool conditional_inputs)
+    : _ranking_function(compiled_function.get_lazy_function()),
+      _conditional_inputs(conditional_inputs)
 {
 }
 
@@ -151,18 +162,26 @@ LazyCompiledRankingExpressionExecutor::execute(uint32_t)
 
 //-----------------------------------------------------------------------------
 
-InterpretedRankingExpressionExecutor::InterpretedRankingExpressionExecutor(const InterpretedFunction &function,
-                                                                           ConstArrayRef<char> input_is_object)
+template <bool number_output>
+InterpretedRankingExpressionExecutor<number_output>::InterpretedRankingExpressionExecutor(const InterpretedFunction &function,
+                                                                                          ConstArrayRef<char> input_is_object,
+                                                                                          bool conditional_inputs)
     : _function(function),
       _context(function),
-      _params(inputs(), input_is_object)
+      _params(inputs(), input_is_object),
+      _conditional_inputs(conditional_inputs)
 {
 }
 
+template <bool number_output>
 void
-InterpretedRankingExpressionExecutor::execute(uint32_t)
+InterpretedRankingExpressionExecutor<number_output>::execute(uint32_t)
 {
-    outputs().set_object(0, _function.eval(_context, _params));
+    if (number_output) {
+        outputs().set_number(0, _function.eval(_context, _params).as_double());
+    } else {
+        outputs().set_object(0, _function.eval(_context, _params));
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -176,7 +195,8 @@ RankingExpressionBlueprint::RankingExpressionBlueprint(rankingexpression::Expres
       _intrinsic_expression(),
       _interpreted_function(),
       _compile_token(),
-      _input_is_object()
+      _input_is_object(),
+      _conditional_inputs(false)
 {
 }
 
@@ -257,14 +277,23 @@ RankingExpressionBlueprint::setup(const fef::IIndexEnvironment &env,
             script.c_str(), list_issues(issues.list).c_str());
         return false;
     }
+    for (double p_use: vespalib::eval::check_param_usage(rank_function)) {
+        if (!vespalib::approx_equal(p_use, 1.0)) {
+            _conditional_inputs = true;
+        }
+    }
     // avoid costly compilation when only verifying setup
     if (env.getFeatureMotivation() != env.FeatureMotivation::VERIFY_SETUP) {
         if (do_compile) {
             bool suggest_lazy = CompiledFunction::should_use_lazy_params(rank_function);
-            if (fef::indexproperties::eval::LazyExpressions::check(env.getProperties(), suggest_lazy)) {
-                _compile_token = CompileCache::compile(rank_function, PassParams::LAZY);
+            PassParams pass_params = fef::indexproperties::eval::LazyExpressions::check(env.getProperties(), suggest_lazy)
+                                     ? PassParams::LAZY
+                                     : PassParams::ARRAY;
+            if (fef::indexproperties::eval::AsyncCompile::check(env.getProperties())) {
+                _interpreted_function.reset(new InterpretedFunction(DefaultTensorEngine::ref(), rank_function, node_types));
+                _compile_token = CompileCache::compile_async(std::make_shared<Function>(std::move(rank_function)), pass_params);
             } else {
-                _compile_token = CompileCache::compile(rank_function, PassParams::ARRAY);
+                _compile_token = CompileCache::compile(rank_function, pass_params);
             }
         } else {
             _interpreted_function.reset(new InterpretedFunction(DefaultTensorEngine::ref(), rank_function, node_types));
@@ -289,17 +318,23 @@ RankingExpressionBlueprint::createExecutor(const fef::IQueryEnvironment &env, ve
     if (_intrinsic_expression) {
         return _intrinsic_expression->create_executor(env, stash);
     }
-    if (_interpreted_function) {
+    if (_compile_token) {
+        if (const CompiledFunction *compiled_function = _compile_token->try_get()) {
+            if (compiled_function->pass_params() == PassParams::ARRAY) {
+                return stash.create<CompiledRankingExpressionExecutor>(*compiled_function);
+            } else {
+                assert(compiled_function->pass_params() == PassParams::LAZY);
+                return stash.create<LazyCompiledRankingExpressionExecutor>(*compiled_function, _conditional_inputs);
+            }
+        }
+        // still compiling in the background
+        assert(_interpreted_function);
         ConstArrayRef<char> input_is_object = stash.copy_array<char>(_input_is_object);
-        return stash.create<InterpretedRankingExpressionExecutor>(*_interpreted_function, input_is_object);
-    }
-    assert(_compile_token.get() != nullptr); // will be nullptr for VERIFY_SETUP feature motivation
-    if (_compile_token->get().pass_params() == PassParams::ARRAY) {
-        return stash.create<CompiledRankingExpressionExecutor>(_compile_token->get());
-    } else {
-        assert(_compile_token->get().pass_params() == PassParams::LAZY);
-        return stash.create<LazyCompiledRankingExpressionExecutor>(_compile_token->get());
+        return stash.create<InterpretedRankingExpressionExecutor<true>>(*_interpreted_function, input_is_object, _conditional_inputs);
     }
+    assert(_interpreted_function); // will be nullptr for VERIFY_SETUP feature motivation
+    ConstArrayRef<char> input_is_object = stash.copy_array<char>(_input_is_object);
+    return stash.create<InterpretedRankingExpressionExecutor<false>>(*_interpreted_function, input_is_object, _conditional_inputs);
 }
 
 //-----------------------------------------------------------------------------
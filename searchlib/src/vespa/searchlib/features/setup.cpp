@@ -54,11 +54,13 @@
 #include "constant_feature.h"
 
 #include <vespa/searchlib/features/max_reduce_prod_join_replacer.h>
+#include <vespa/searchlib/features/sum_reduce_prod_join_replacer.h>
 #include <vespa/searchlib/features/rankingexpression/expression_replacer.h>
 
 using search::fef::Blueprint;
 using search::features::rankingexpression::ListExpressionReplacer;
 using search::features::MaxReduceProdJoinReplacer;
+using search::features::SumReduceProdJoinReplacer;
 
 namespace search {
 namespace features {
@@ -122,6 +124,7 @@ void setup_search_features(fef::IBlueprintRegistry & registry)
     // Ranking Expression
     auto replacers = std::make_unique<ListExpressionReplacer>();
     replacers->add(MaxReduceProdJoinReplacer::create());
+    replacers->add(SumReduceProdJoinReplacer::create());
     registry.addPrototype(std::make_shared<RankingExpressionBlueprint>(std::move(replacers)));
 }
 
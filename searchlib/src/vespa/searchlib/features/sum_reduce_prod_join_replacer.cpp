@@ -0,0 +1,119 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "sum_reduce_prod_join_replacer.h"
+#include <vespa/eval/eval/function.h>
+#include <vespa/eval/eval/basic_nodes.h>
+#include <vespa/eval/eval/operator_nodes.h>
+#include <vespa/eval/eval/tensor_nodes.h>
+#include <vespa/searchlib/features/rankingexpression/intrinsic_blueprint_adapter.h>
+#include <vespa/searchlib/fef/featurenameparser.h>
+
+namespace search::features {
+
+using fef::Blueprint;
+using fef::FeatureNameParser;
+using fef::IIndexEnvironment;
+using rankingexpression::ExpressionReplacer;
+using rankingexpression::IntrinsicBlueprintAdapter;
+using rankingexpression::IntrinsicExpression;
+using vespalib::eval::Aggr;
+using vespalib::eval::Function;
+using vespalib::eval::nodes::Mul;
+using vespalib::eval::nodes::Node;
+using vespalib::eval::nodes::Symbol;
+using vespalib::eval::nodes::TensorJoin;
+using vespalib::eval::nodes::TensorReduce;
+using vespalib::eval::nodes::as;
+
+namespace {
+
+bool match_params(const Node &a, const Node &b) {
+    bool first = false;
+    bool second = false;
+    for (int i = 0; i < 2; ++i) {
+        const Node &node = (i == 0) ? a : b;
+        if (auto symbol = as<Symbol>(node)) {
+            if (symbol->id() == 0) {
+                first = true;
+            } else if (symbol->id() == 1) {
+                second = true;
+            }
+        }
+    }
+    return (first && second);
+}
+
+bool match_prod_join(const Node &node) {
+    if (auto join = as<TensorJoin>(node)) {
+        const Node &root = join->lambda().root();
+        if (as<Mul>(root)) {
+            return match_params(root.get_child(0), root.get_child(1));
+        }
+    }
+    return false;
+}
+
+bool match_sum_reduce(const Node &node) {
+    auto reduce = as<TensorReduce>(node);
+    // only a full reduce is supported, as the feature produces a number
+    return (reduce && (reduce->aggr() == Aggr::SUM) && reduce->dimensions().empty());
+}
+
+bool match_function(const Function &function) {
+    const Node &expect_sum = function.root();
+    if ((function.num_params() == 2) && match_sum_reduce(expect_sum)) {
+        const Node &expect_mul = expect_sum.get_child(0);
+        if (as<Mul>(expect_mul) || match_prod_join(expect_mul)) {
+            return match_params(expect_mul.get_child(0), expect_mul.get_child(1));
+        }
+    }
+    return false;
+}
+
+struct MatchInputs {
+    vespalib::string attribute;
+    vespalib::string query;
+    MatchInputs() : attribute(), query() {}
+    void process(const vespalib::string &param) {
+        FeatureNameParser parser(param);
+        if (parser.valid() && (parser.parameters().size() == 1) && parser.output().empty()) {
+            if (parser.baseName() == "attribute") {
+                attribute = parser.parameters()[0];
+            } else if (parser.baseName() == "query") {
+                query = parser.parameters()[0];
+            }
+        }
+    }
+    bool matched() const {
+        return (!attribute.empty() && !query.empty());
+    }
+};
+
+struct SumReduceProdJoinReplacerImpl : ExpressionReplacer {
+    Blueprint::UP proto;
+    SumReduceProdJoinReplacerImpl(Blueprint::UP proto_in)
+        : proto(std::move(proto_in)) {}
+    IntrinsicExpression::UP maybe_replace(const Function &function,
+                                          const IIndexEnvironment &env) const override
+    {
+        if (match_function(function)) {
+            MatchInputs match_inputs;
+            match_inputs.process(function.param_name(0));
+            match_inputs.process(function.param_name(1));
+            if (match_inputs.matched()) {
+                return IntrinsicBlueprintAdapter::try_create(*proto, env, {match_inputs.attribute, match_inputs.query});
+            }
+        }
+        return IntrinsicExpression::UP(nullptr);
+    }
+};
+
+} // namespace search::features::<unnamed>
+
+ExpressionReplacer::UP
+SumReduceProdJoinReplacer::create(Blueprint::UP proto)
+{
+    return std::make_unique<SumReduceProdJoinReplacerImpl>(std::move(proto));
+}
+
+} // namespace search::features
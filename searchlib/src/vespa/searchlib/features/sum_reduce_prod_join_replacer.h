@@ -0,0 +1,35 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "internal_sum_reduce_prod_join_feature.h"
+#include <vespa/searchlib/features/rankingexpression/expression_replacer.h>
+
+namespace search::features {
+
+/**
+ * ExpressionReplacer that will replacing expressions on the form:
+ *
+ *      reduce(
+ *          join(
+ *              attribute(A),
+ *              query(Q),
+ *              f(x,y)(x*y)
+ *          ),
+ *          sum
+ *      )
+ *
+ * With a parameterized (A, Q) adaption of the given blueprint
+ * (default: InternalSumReduceProdJoinBlueprint). The blueprint decides
+ * whether the types of A and Q are supported; if its setup fails, the
+ * expression is left as is.
+ **/
+struct SumReduceProdJoinReplacer {
+    using ExpressionReplacer = rankingexpression::ExpressionReplacer;
+    static ExpressionReplacer::UP create(fef::Blueprint::UP proto);
+    static ExpressionReplacer::UP create() {
+        return create(std::make_unique<InternalSumReduceProdJoinBlueprint>());
+    }
+};
+
+} // namespace search::features
@@ -0,0 +1,99 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "feature_profiler.h"
+#include <algorithm>
+
+namespace search {
+namespace fef {
+
+FeatureProfiler::FeatureProfiler()
+    : _stats(),
+      _index(),
+      _stack()
+{
+}
+
+FeatureProfiler::~FeatureProfiler() {}
+
+uint32_t
+FeatureProfiler::resolve(const vespalib::string &name)
+{
+    auto pos = _index.find(name);
+    if (pos != _index.end()) {
+        return pos->second;
+    }
+    uint32_t id = _stats.size();
+    _stats.emplace_back(name);
+    _index[name] = id;
+    return id;
+}
+
+void
+FeatureProfiler::merge(const FeatureProfiler &rhs)
+{
+    for (const Stats &src: rhs._stats) {
+        Stats &dst = _stats[resolve(src.name)];
+        dst.count += src.count;
+        dst.self_time += src.self_time;
+        dst.total_time += src.total_time;
+    }
+}
+
+std::vector<FeatureProfiler::Stats>
+FeatureProfiler::report() const
+{
+    std::vector<Stats> result = _stats;
+    std::stable_sort(result.begin(), result.end(),
+                     [](const Stats &a, const Stats &b) { return (a.self_time > b.self_time); });
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+
+void
+ProfiledFeatureExecutor::handle_bind_inputs(vespalib::ConstArrayRef<LazyValue> inputs)
+{
+    _executor.bind_inputs(inputs);
+}
+
+void
+ProfiledFeatureExecutor::handle_bind_outputs(vespalib::ArrayRef<NumberOrObject> outputs)
+{
+    _executor.bind_outputs(outputs);
+}
+
+void
+ProfiledFeatureExecutor::handle_bind_match_data(const MatchData &md)
+{
+    _executor.bind_match_data(md);
+}
+
+ProfiledFeatureExecutor::ProfiledFeatureExecutor(FeatureExecutor &executor, FeatureProfiler &profiler, uint32_t id)
+    : _executor(executor),
+      _profiler(profiler),
+      _id(id)
+{
+}
+
+bool
+ProfiledFeatureExecutor::isPure()
+{
+    return _executor.isPure();
+}
+
+bool
+ProfiledFeatureExecutor::has_conditional_inputs() const
+{
+    return _executor.has_conditional_inputs();
+}
+
+void
+ProfiledFeatureExecutor::execute(uint32_t docId)
+{
+    _profiler.start();
+    _executor.lazy_execute(docId);
+    _profiler.stop(_id);
+}
+
+} // namespace fef
+} // namespace search
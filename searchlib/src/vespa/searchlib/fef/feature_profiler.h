@@ -0,0 +1,108 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "featureexecutor.h"
+#include <vespa/vespalib/stllike/string.h>
+#include <chrono>
+#include <map>
+#include <vector>
+
+namespace search {
+namespace fef {
+
+/**
+ * Measures the time spent in each feature executor of one or more
+ * rank programs. The time spent calculating the inputs of an
+ * executor is reported as part of the total time of the executor,
+ * but not as part of its self time. A profiler is not thread-safe;
+ * use one profiler per thread and merge them afterwards. Executors
+ * are identified by name, which means that profiles from different
+ * rank programs (e.g. first and second phase) can be merged.
+ **/
+class FeatureProfiler
+{
+public:
+    using clock = std::chrono::steady_clock;
+    using duration = std::chrono::nanoseconds;
+
+    struct Stats {
+        vespalib::string name;
+        size_t           count;
+        duration         self_time;
+        duration         total_time;
+        Stats(const vespalib::string &name_in)
+            : name(name_in), count(0), self_time(duration::zero()), total_time(duration::zero()) {}
+    };
+
+private:
+    struct Frame {
+        clock::time_point start;
+        duration          children;
+        Frame(clock::time_point start_in) : start(start_in), children(duration::zero()) {}
+    };
+
+    std::vector<Stats>                  _stats;
+    std::map<vespalib::string, uint32_t> _index;
+    std::vector<Frame>                  _stack;
+
+public:
+    FeatureProfiler();
+    ~FeatureProfiler();
+
+    /**
+     * Obtain the id used to report the execution of the named
+     * executor. The same name will always give the same id.
+     **/
+    uint32_t resolve(const vespalib::string &name);
+
+    void start() { _stack.emplace_back(clock::now()); }
+    void stop(uint32_t id) {
+        duration total = std::chrono::duration_cast<duration>(clock::now() - _stack.back().start);
+        duration self = total - _stack.back().children;
+        _stack.pop_back();
+        if (!_stack.empty()) {
+            _stack.back().children += total;
+        }
+        Stats &stats = _stats[id];
+        ++stats.count;
+        stats.self_time += self;
+        stats.total_time += total;
+    }
+
+    void merge(const FeatureProfiler &rhs);
+    bool empty() const { return _stats.empty(); }
+
+    /**
+     * Obtain the collected statistics, most expensive (by self time)
+     * executor first.
+     **/
+    std::vector<Stats> report() const;
+};
+
+/**
+ * Decorator that reports the execution of the wrapped feature
+ * executor to a profiler. Calculating the inputs of the wrapped
+ * executor happens inside its execute function, which makes nested
+ * profiled executors observe each other.
+ **/
+class ProfiledFeatureExecutor : public FeatureExecutor
+{
+private:
+    FeatureExecutor &_executor;
+    FeatureProfiler &_profiler;
+    uint32_t         _id;
+
+    void handle_bind_match_data(const MatchData &md) override;
+    void handle_bind_inputs(vespalib::ConstArrayRef<LazyValue> inputs) override;
+    void handle_bind_outputs(vespalib::ArrayRef<NumberOrObject> outputs) override;
+
+public:
+    ProfiledFeatureExecutor(FeatureExecutor &executor, FeatureProfiler &profiler, uint32_t id);
+    bool isPure() override;
+    bool has_conditional_inputs() const override;
+    void execute(uint32_t docId) override;
+};
+
+} // namespace fef
+} // namespace search
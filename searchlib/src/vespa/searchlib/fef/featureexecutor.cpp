@@ -17,6 +17,12 @@ FeatureExecutor::isPure()
     return false;
 }
 
+bool
+FeatureExecutor::has_conditional_inputs() const
+{
+    return false;
+}
+
 void
 FeatureExecutor::handle_bind_inputs(vespalib::ConstArrayRef<LazyValue>)
 {
@@ -140,6 +140,18 @@ public:
      **/
     virtual bool isPure();
 
+    /**
+     * Check if this feature executor might leave some of its inputs
+     * unread for a document, like a lazy ranking expression where an
+     * input is only used inside one branch of an if(). Inputs of such
+     * an executor are only calculated when they are actually read,
+     * and should not be run eagerly on its behalf. This method is
+     * implemented to return false by default.
+     *
+     * @return true if not all inputs are always read
+     **/
+    virtual bool has_conditional_inputs() const;
+
     /**
      * Make sure this executor has been executed for the given
      * document.
@@ -153,6 +165,19 @@ public:
         }
     }
 
+    /**
+     * Execute this executor for the given document without checking
+     * whether it has already been executed. Used when all executors
+     * of a program are run in dependency order, in which case the
+     * lazy checks done when reading the inputs will always succeed.
+     *
+     * @param docid the local document id being evaluated
+     **/
+    void eager_execute(uint32_t docid) {
+        _inputs.set_docid(docid);
+        execute(docid);
+    }
+
     /**
      * Virtual destructor to allow subclassing.
      **/
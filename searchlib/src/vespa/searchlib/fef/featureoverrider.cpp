@@ -30,6 +30,12 @@ FeatureOverrider::isPure()
     return _executor.isPure();
 }
 
+bool
+FeatureOverrider::has_conditional_inputs() const
+{
+    return _executor.has_conditional_inputs();
+}
+
 void
 FeatureOverrider::execute(uint32_t docId)
 {
@@ -39,6 +39,7 @@ public:
      **/
     FeatureOverrider(FeatureExecutor &executor, uint32_t outputIdx, feature_t value);
     bool isPure() override;
+    bool has_conditional_inputs() const override;
     void execute(uint32_t docId) override;
 };
 
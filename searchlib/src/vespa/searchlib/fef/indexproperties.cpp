@@ -84,6 +84,15 @@ LazyExpressions::check(const Properties &props, bool default_value)
     return lookupBool(props, NAME, default_value);
 }
 
+const vespalib::string AsyncCompile::NAME("vespa.eval.async_compile");
+const bool AsyncCompile::DEFAULT_VALUE(false);
+
+bool
+AsyncCompile::check(const Properties &props)
+{
+    return lookupBool(props, NAME, DEFAULT_VALUE);
+}
+
 } // namespace eval
 
 namespace rank {
@@ -190,6 +199,111 @@ NumSearchPartitions::lookup(const Properties &props, uint32_t defaultValue)
     return lookupUint32(props, NAME, defaultValue);
 }
 
+const vespalib::string WorkStealing::NAME("vespa.matching.workstealing");
+const bool WorkStealing::DEFAULT_VALUE(false);
+
+bool
+WorkStealing::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+bool
+WorkStealing::lookup(const Properties &props, bool defaultValue)
+{
+    return lookupBool(props, NAME, defaultValue);
+}
+
+const vespalib::string EagerRanking::NAME("vespa.matching.eagerranking");
+const bool EagerRanking::DEFAULT_VALUE(false);
+
+bool
+EagerRanking::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+bool
+EagerRanking::lookup(const Properties &props, bool defaultValue)
+{
+    return lookupBool(props, NAME, defaultValue);
+}
+
+const vespalib::string BalancedSecondPhase::NAME("vespa.matching.balancedsecondphase");
+const bool BalancedSecondPhase::DEFAULT_VALUE(false);
+
+bool
+BalancedSecondPhase::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+bool
+BalancedSecondPhase::lookup(const Properties &props, bool defaultValue)
+{
+    return lookupBool(props, NAME, defaultValue);
+}
+
+const vespalib::string FilterCacheSize::NAME("vespa.matching.filtercachesize");
+const uint32_t FilterCacheSize::DEFAULT_VALUE(0);
+
+uint32_t
+FilterCacheSize::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+uint32_t
+FilterCacheSize::lookup(const Properties &props, uint32_t defaultValue)
+{
+    return lookupUint32(props, NAME, defaultValue);
+}
+
+const vespalib::string ResultCacheSize::NAME("vespa.matching.resultcachesize");
+const uint32_t ResultCacheSize::DEFAULT_VALUE(0);
+
+uint32_t
+ResultCacheSize::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+uint32_t
+ResultCacheSize::lookup(const Properties &props, uint32_t defaultValue)
+{
+    return lookupUint32(props, NAME, defaultValue);
+}
+
+const vespalib::string ResultCacheMaxAge::NAME("vespa.matching.resultcachemaxage");
+const double ResultCacheMaxAge::DEFAULT_VALUE(0.0);
+
+double
+ResultCacheMaxAge::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+double
+ResultCacheMaxAge::lookup(const Properties &props, double defaultValue)
+{
+    return lookupDouble(props, NAME, defaultValue);
+}
+
+const vespalib::string QuerySampleFraction::NAME("vespa.matching.querysamplefraction");
+const double QuerySampleFraction::DEFAULT_VALUE(0.0);
+
+double
+QuerySampleFraction::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+double
+QuerySampleFraction::lookup(const Properties &props, double defaultValue)
+{
+    return lookupDouble(props, NAME, defaultValue);
+}
+
 const vespalib::string MinHitsPerThread::NAME("vespa.matching.minhitsperthread");
 const uint32_t MinHitsPerThread::DEFAULT_VALUE(0);
 
@@ -331,6 +445,21 @@ DiversityCutoffStrategy::lookup(const Properties &props)
     return lookupString(props, NAME, DEFAULT_VALUE);
 }
 
+const vespalib::string EarlyTerminationHits::NAME("vespa.matchphase.earlytermination.hits");
+const uint32_t EarlyTerminationHits::DEFAULT_VALUE(0);
+
+uint32_t
+EarlyTerminationHits::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+uint32_t
+EarlyTerminationHits::lookup(const Properties &props, uint32_t defaultValue)
+{
+    return lookupUint32(props, NAME, defaultValue);
+}
+
 
 }
 
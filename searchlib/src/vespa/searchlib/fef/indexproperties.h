@@ -29,6 +29,14 @@ struct LazyExpressions {
     static bool check(const Properties &props, bool default_value);
 };
 
+// compile expressions in the background, interpreting them until
+// compilation is done. affects rank/summary/dump
+struct AsyncCompile {
+    static const vespalib::string NAME;
+    static const bool DEFAULT_VALUE;
+    static bool check(const Properties &props);
+};
+
 } // namespace eval
 
 namespace rank {
@@ -133,6 +141,87 @@ namespace matching {
         static uint32_t lookup(const Properties &props);
         static uint32_t lookup(const Properties &props, uint32_t defaultValue);
     };
+    /**
+     * Property enabling work-stealing between the search threads of a
+     * single query. Only used when the docid space is not partitioned
+     * up front (numsearchpartitions is 0).
+     **/
+    struct WorkStealing {
+        static const vespalib::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool lookup(const Properties &props);
+        static bool lookup(const Properties &props, bool defaultValue);
+    };
+    /**
+     * Property enabling eager execution of the first phase rank
+     * program. All executors needed by the rank feature are run in
+     * dependency order for each ranked document, instead of being
+     * pulled in one by one through lazy evaluation.
+     **/
+    struct EagerRanking {
+        static const vespalib::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool lookup(const Properties &props);
+        static bool lookup(const Properties &props, bool defaultValue);
+    };
+    /**
+     * Property enabling balanced second phase ranking. The globally
+     * best hits are handed out evenly across the search threads for
+     * re-ranking, and the first phase score of each hit is reused
+     * by the firstPhase feature instead of being computed again.
+     **/
+    struct BalancedSecondPhase {
+        static const vespalib::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool lookup(const Properties &props);
+        static bool lookup(const Properties &props, bool defaultValue);
+    };
+    /**
+     * Property for the maximum number of filter subtree results (as
+     * bitvectors) cached across queries. Filter subtrees are subtrees
+     * of unranked terms searching attributes only. The default value
+     * is 0, which disables the cache.
+     **/
+    struct FilterCacheSize {
+        static const vespalib::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+        static uint32_t lookup(const Properties &props, uint32_t defaultValue);
+    };
+    /**
+     * Property for the maximum number of query results cached across
+     * queries. A cached result is only used as long as no documents
+     * have been fed since it was calculated. The default value is 0,
+     * which disables the cache.
+     **/
+    struct ResultCacheSize {
+        static const vespalib::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+        static uint32_t lookup(const Properties &props, uint32_t defaultValue);
+    };
+    /**
+     * Property for the maximum age (in seconds) of a cached query
+     * result. The default value is 0, which means no age limit.
+     **/
+    struct ResultCacheMaxAge {
+        static const vespalib::string NAME;
+        static const double DEFAULT_VALUE;
+        static double lookup(const Properties &props);
+        static double lookup(const Properties &props, double defaultValue);
+    };
+    /**
+     * Property for the fraction of queries that are profiled. The
+     * most expensive of the profiled queries are kept and can be
+     * inspected through the state explorer. The default value is 0,
+     * which disables profiling.
+     **/
+    struct QuerySampleFraction {
+        static const vespalib::string NAME;
+        static const double DEFAULT_VALUE;
+        static double lookup(const Properties &props);
+        static double lookup(const Properties &props, double defaultValue);
+    };
 }
 
 namespace softtimeout {
@@ -255,6 +344,21 @@ namespace matchphase {
         static const vespalib::string DEFAULT_VALUE;
         static vespalib::string lookup(const Properties &props);
     };
+    /**
+     * Property for the number of hits to collect before terminating
+     * the match phase early. Matching is done in docid order, so this
+     * only gives the best hits when the lid space is ordered by
+     * document quality. The wanted hits are spread evenly across the
+     * match threads. The default value is 0, which disables early
+     * termination. Match phase degradation takes precedence when
+     * enabled.
+     **/
+    struct EarlyTerminationHits {
+        static const vespalib::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+        static uint32_t lookup(const Properties &props, uint32_t defaultValue);
+    };
 
 } // namespace matchphase
 
@@ -7,7 +7,9 @@ namespace fef {
 
 MatchData::MatchData(const Params &cparams)
     : _termFields(cparams.numTermFields()),
-      _termwise_limit(1.0)
+      _termwise_limit(1.0),
+      _first_phase_docid(0),
+      _first_phase_score(0.0)
 {
 }
 
@@ -18,6 +20,7 @@ MatchData::soft_reset()
         tfmd.resetOnlyDocId(TermFieldMatchData::invalidId()).tagAsNeeded();
     }
     _termwise_limit = 1.0;
+    _first_phase_docid = 0;
 }
 
 MatchData::UP
@@ -18,6 +18,8 @@ class MatchData
 private:
     std::vector<TermFieldMatchData> _termFields;
     double                          _termwise_limit;
+    uint32_t                        _first_phase_docid;
+    double                          _first_phase_score;
 
 public:
     /**
@@ -80,6 +82,21 @@ public:
     double get_termwise_limit() const { return _termwise_limit; }
     void set_termwise_limit(double value) { _termwise_limit = value; }
 
+    /**
+     * The first phase score of the document currently being
+     * re-ranked, if known. Used by the firstPhase feature to avoid
+     * evaluating the first phase expression again in second phase.
+     **/
+    void set_first_phase_score(uint32_t docid, double score) {
+        _first_phase_docid = docid;
+        _first_phase_score = score;
+    }
+    void clear_first_phase_score() { _first_phase_docid = 0; }
+    bool has_first_phase_score(uint32_t docid) const {
+        return ((_first_phase_docid != 0) && (_first_phase_docid == docid));
+    }
+    double get_first_phase_score() const { return _first_phase_score; }
+
     /**
      * Obtain the number of term fields allocated in this match data
      * structure.
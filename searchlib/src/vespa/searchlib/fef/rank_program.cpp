@@ -2,6 +2,7 @@
 
 #include "rank_program.h"
 #include "featureoverrider.h"
+#include "feature_profiler.h"
 #include <vespa/vespalib/locale/c.h>
 #include <algorithm>
 
@@ -166,7 +167,8 @@ RankProgram::~RankProgram() {}
 void
 RankProgram::setup(const MatchData &md,
                    const IQueryEnvironment &queryEnv,
-                   const Properties &featureOverrides)
+                   const Properties &featureOverrides,
+                   FeatureProfiler *profiler)
 {
     assert(_executors.empty());
     std::vector<Override> overrides = prepare_overrides(_resolver->getFeatureMap(), featureOverrides);
@@ -200,6 +202,10 @@ RankProgram::setup(const MatchData &md,
             FeatureExecutor *tmp = executor;
             executor = &(stash.get().create<FeatureOverrider>(*tmp, override->ref.output, override->value));
         }
+        if ((profiler != nullptr) && !is_const) {
+            uint32_t id = profiler->resolve(specs[i].blueprint->getName());
+            executor = &(stash.get().create<ProfiledFeatureExecutor>(*executor, *profiler, id));
+        }
         executor->bind_inputs(inputs);
         executor->bind_outputs(outputs);
         executor->bind_match_data(md);
@@ -223,6 +229,32 @@ RankProgram::get_seeds(bool unbox_seeds) const
     return resolve(_resolver->getSeedMap(), unbox_seeds);
 }
 
+std::vector<FeatureExecutor *>
+RankProgram::get_seed_executors() const
+{
+    const auto &specs = _resolver->getExecutorSpecs();
+    std::vector<bool> needed(_executors.size(), false);
+    for (const auto &seed_entry: _resolver->getSeedMap()) {
+        needed[seed_entry.second.executor] = true;
+    }
+    for (size_t i = _executors.size(); i-- > 0; ) {
+        if (needed[i] && !_executors[i]->has_conditional_inputs()) {
+            for (const auto &ref: specs[i].inputs) {
+                needed[ref.executor] = true;
+            }
+        }
+    }
+    std::vector<FeatureExecutor *> result;
+    for (size_t i = 0; i < _executors.size(); ++i) {
+        const auto &outputs = _executors[i]->outputs();
+        bool is_const = ((outputs.size() > 0) && check_const(outputs.get_raw(0)));
+        if (needed[i] && !is_const) {
+            result.push_back(_executors[i]);
+        }
+    }
+    return result;
+}
+
 FeatureResolver
 RankProgram::get_all_features(bool unbox_seeds) const
 {
@@ -15,6 +15,8 @@
 namespace search {
 namespace fef {
 
+class FeatureProfiler;
+
 /**
  * A rank program is able to lazily calculate a set of feature
  * values. In order to access (and thereby calculate) output features
@@ -63,11 +65,14 @@ public:
     /**
      * Set up this rank program by creating the needed feature
      * executors and wiring them together. This function will also
-     * pre-calculate all constant features.
+     * pre-calculate all constant features. If a profiler is given,
+     * the execution of all non-const executors will be reported to
+     * it. The profiler must outlive this rank program.
      **/
     void setup(const MatchData &md,
                const IQueryEnvironment &queryEnv,
-               const Properties &featureOverrides = Properties());
+               const Properties &featureOverrides = Properties(),
+               FeatureProfiler *profiler = nullptr);
 
     /**
      * Obtain the names and storage locations of all seed features for
@@ -79,6 +84,18 @@ public:
      **/
     FeatureResolver get_seeds(bool unbox_seeds = true) const;
 
+    /**
+     * Obtain all non-const executors that are always needed to
+     * calculate the seeds of this rank program, ordered so that each
+     * executor comes after the executors it depends on. Running
+     * eager_execute on each of them for a document before reading the
+     * seeds replaces most of the recursive lazy evaluation with a
+     * flat loop. Inputs of executors with conditional inputs (lazy
+     * expressions using if) are left out, and are still calculated
+     * lazily only when they are read.
+     **/
+    std::vector<FeatureExecutor *> get_seed_executors() const;
+
     /**
      * Obtain the names and storage locations of all features for this
      * rank program. This method is intended for debugging and
@@ -38,6 +38,9 @@ RankSetup::RankSetup(const BlueprintFactory &factory, const IIndexEnvironment &i
       _numThreads(0),
       _minHitsPerThread(0),
       _numSearchPartitions(0),
+      _useWorkStealing(false),
+      _useEagerRanking(false),
+      _useBalancedSecondPhase(false),
       _heapSize(0),
       _arraySize(0),
       _estimatePoint(0),
@@ -57,6 +60,7 @@ RankSetup::RankSetup(const BlueprintFactory &factory, const IIndexEnvironment &i
       _diversityMinGroups(1),
       _diversityCutoffFactor(10.0),
       _diversityCutoffStrategy("loose"),
+      _earlyTerminationHits(0),
       _softTimeoutEnabled(false),
       _softTimeoutTailCost(0.1)
 { }
@@ -81,6 +85,9 @@ RankSetup::configure()
     setNumThreadsPerSearch(matching::NumThreadsPerSearch::lookup(_indexEnv.getProperties()));
     setMinHitsPerThread(matching::MinHitsPerThread::lookup(_indexEnv.getProperties()));
     setNumSearchPartitions(matching::NumSearchPartitions::lookup(_indexEnv.getProperties()));
+    setUseWorkStealing(matching::WorkStealing::lookup(_indexEnv.getProperties()));
+    setUseEagerRanking(matching::EagerRanking::lookup(_indexEnv.getProperties()));
+    setUseBalancedSecondPhase(matching::BalancedSecondPhase::lookup(_indexEnv.getProperties()));
     setHeapSize(hitcollector::HeapSize::lookup(_indexEnv.getProperties()));
     setArraySize(hitcollector::ArraySize::lookup(_indexEnv.getProperties()));
     setDegradationAttribute(matchphase::DegradationAttribute::lookup(_indexEnv.getProperties()));
@@ -93,6 +100,7 @@ RankSetup::configure()
     setDiversityMinGroups(matchphase::DiversityMinGroups::lookup(_indexEnv.getProperties()));
     setDiversityCutoffFactor(matchphase::DiversityCutoffFactor::lookup(_indexEnv.getProperties()));
     setDiversityCutoffStrategy(matchphase::DiversityCutoffStrategy::lookup(_indexEnv.getProperties()));
+    setEarlyTerminationHits(matchphase::EarlyTerminationHits::lookup(_indexEnv.getProperties()));
     setEstimatePoint(hitcollector::EstimatePoint::lookup(_indexEnv.getProperties()));
     setEstimateLimit(hitcollector::EstimateLimit::lookup(_indexEnv.getProperties()));
     setRankScoreDropLimit(hitcollector::RankScoreDropLimit::lookup(_indexEnv.getProperties()));
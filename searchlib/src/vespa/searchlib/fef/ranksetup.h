@@ -36,6 +36,9 @@ private:
     uint32_t                 _numThreads;
     uint32_t                 _minHitsPerThread;
     uint32_t                 _numSearchPartitions;
+    bool                     _useWorkStealing;
+    bool                     _useEagerRanking;
+    bool                     _useBalancedSecondPhase;
     uint32_t                 _heapSize;
     uint32_t                 _arraySize;
     uint32_t                 _estimatePoint;
@@ -55,6 +58,7 @@ private:
     uint32_t                 _diversityMinGroups;
     double                   _diversityCutoffFactor;
     vespalib::string         _diversityCutoffStrategy;
+    uint32_t                 _earlyTerminationHits;
     bool                     _softTimeoutEnabled;
     double                   _softTimeoutTailCost;
     double                   _softTimeoutFactor;
@@ -158,6 +162,18 @@ public:
 
     uint32_t getNumSearchPartitions() const { return _numSearchPartitions; }
 
+    void setUseWorkStealing(bool useWorkStealing) { _useWorkStealing = useWorkStealing; }
+
+    bool getUseWorkStealing() const { return _useWorkStealing; }
+
+    void setUseEagerRanking(bool useEagerRanking) { _useEagerRanking = useEagerRanking; }
+
+    bool getUseEagerRanking() const { return _useEagerRanking; }
+
+    void setUseBalancedSecondPhase(bool useBalancedSecondPhase) { _useBalancedSecondPhase = useBalancedSecondPhase; }
+
+    bool getUseBalancedSecondPhase() const { return _useBalancedSecondPhase; }
+
     /**
      * Sets the heap size to be used in the hit collector.
      *
@@ -233,6 +249,16 @@ public:
         return _diversityCutoffStrategy;
     }
 
+    /** get number of hits to collect before terminating the match phase early **/
+    uint32_t getEarlyTerminationHits() const {
+        return _earlyTerminationHits;
+    }
+
+    /** set number of hits to collect before terminating the match phase early **/
+    void setEarlyTerminationHits(uint32_t hits) {
+        _earlyTerminationHits = hits;
+    }
+
     /** set name of attribute to use for graceful degradation in match phase */
     void setDegradationAttribute(const vespalib::string &name) {
         _degradationAttribute = name;
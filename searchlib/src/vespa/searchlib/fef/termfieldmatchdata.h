@@ -5,6 +5,7 @@
 #include "fieldpositionsiterator.h"
 #include "fieldinfo.h"
 #include <vespa/searchlib/common/feature.h>
+#include <algorithm>
 #include <cstring>
 #include <cassert>
 
@@ -63,6 +64,30 @@ public:
     PositionsIterator begin() const { return allocated() ? getMultiple() : getFixed(); }
     PositionsIterator end() const { return allocated() ? getMultiple() + _sz : empty() ? getFixed() : getFixed()+1; }
     size_t size() const { return _sz; }
+
+    /**
+     * Skip forward to the first position that is not less than the
+     * given key. Positions are sorted, so we gallop ahead from the
+     * current position and binary search the last step. This is
+     * cheaper than stepping through long position lists one by one.
+     *
+     * @return first position not less than key, or end
+     **/
+    static PositionsIterator seekPosition(PositionsIterator pos, PositionsIterator end,
+                                          const TermFieldMatchDataPositionKey &key)
+    {
+        if ((pos == end) || !(*pos < key)) {
+            return pos;
+        }
+        size_t size = (end - pos);
+        size_t lo = 0;
+        size_t hi = 1;
+        while ((hi < size) && (pos[hi] < key)) {
+            lo = hi;
+            hi *= 2;
+        }
+        return std::lower_bound(pos + lo + 1, pos + std::min(hi, size), key);
+    }
     size_t capacity() const { return allocated() ? _data._positions._allocated : 1; }
     void reservePositions(size_t sz) {
         if (sz > capacity()) {
@@ -54,7 +54,7 @@ public:
         const GroupEngine & _engine;
     };
 
-    typedef vespalib::hash_set<GroupRef, GroupHash, GroupEqual> Children;
+    typedef vespalib::hash_set<GroupRef, GroupHash, GroupEqual, vespalib::swiss_probing> Children;
 
     /**
      * @param request The request creating this engine.
@@ -0,0 +1,173 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "tdigest.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace search {
+
+namespace {
+
+// Number of buffered values, relative to the compression, before the
+// buffer is merged into the centroid list.
+constexpr double BUFFER_FACTOR = 5.0;
+
+} // namespace search::<unnamed>
+
+TDigest::TDigest(double compression)
+    : _compression(std::max(compression, 1.0)),
+      _totalWeight(0.0),
+      _min(std::numeric_limits<double>::infinity()),
+      _max(-std::numeric_limits<double>::infinity()),
+      _centroids(),
+      _buffer()
+{ }
+
+TDigest::~TDigest() { }
+
+double
+TDigest::scale(double q) const
+{
+    return _compression * std::asin(2.0 * std::min(std::max(q, 0.0), 1.0) - 1.0) / (2.0 * M_PI);
+}
+
+void
+TDigest::add(double value, double weight)
+{
+    if (std::isnan(value) || !(weight > 0.0)) {
+        return;
+    }
+    _buffer.emplace_back(value, weight);
+    _totalWeight += weight;
+    _min = std::min(_min, value);
+    _max = std::max(_max, value);
+    if (_buffer.size() >= BUFFER_FACTOR * _compression) {
+        compress();
+    }
+}
+
+void
+TDigest::merge(const TDigest &rhs)
+{
+    if (rhs.empty()) {
+        return;
+    }
+    _buffer.insert(_buffer.end(), rhs._centroids.begin(), rhs._centroids.end());
+    _buffer.insert(_buffer.end(), rhs._buffer.begin(), rhs._buffer.end());
+    _totalWeight += rhs._totalWeight;
+    _min = std::min(_min, rhs._min);
+    _max = std::max(_max, rhs._max);
+    compress();
+}
+
+void
+TDigest::compress()
+{
+    if (_buffer.empty()) {
+        return;
+    }
+    std::vector<Centroid> all;
+    all.reserve(_centroids.size() + _buffer.size());
+    all.insert(all.end(), _centroids.begin(), _centroids.end());
+    all.insert(all.end(), _buffer.begin(), _buffer.end());
+    _buffer.clear();
+    std::stable_sort(all.begin(), all.end(),
+                     [](const Centroid &a, const Centroid &b) { return a.mean < b.mean; });
+    _centroids.clear();
+    double before = 0.0;
+    Centroid current = all[0];
+    for (size_t i = 1; i < all.size(); ++i) {
+        const Centroid &next = all[i];
+        double proposed = current.weight + next.weight;
+        if (scale((before + proposed) / _totalWeight) - scale(before / _totalWeight) <= 1.0) {
+            current.mean += (next.mean - current.mean) * next.weight / proposed;
+            current.weight = proposed;
+        } else {
+            before += current.weight;
+            _centroids.push_back(current);
+            current = next;
+        }
+    }
+    _centroids.push_back(current);
+}
+
+double
+TDigest::quantile(double q) const
+{
+    if (empty()) {
+        return 0.0;
+    }
+    if (!_buffer.empty()) {
+        TDigest tmp(*this);
+        tmp.compress();
+        return tmp.quantile(q);
+    }
+    const std::vector<Centroid> &c = _centroids;
+    if (c.size() == 1) {
+        return c[0].mean;
+    }
+    double target = std::min(std::max(q, 0.0), 1.0) * _totalWeight;
+    double center = c[0].weight / 2.0;
+    if (target <= center) {
+        return _min + (c[0].mean - _min) * (target / center);
+    }
+    for (size_t i = 0; (i + 1) < c.size(); ++i) {
+        double nextCenter = center + (c[i].weight + c[i + 1].weight) / 2.0;
+        if (target <= nextCenter) {
+            return c[i].mean + (c[i + 1].mean - c[i].mean) * (target - center) / (nextCenter - center);
+        }
+        center = nextCenter;
+    }
+    double tail = c.back().weight / 2.0;
+    return c.back().mean + (_max - c.back().mean) * std::min((target - center) / tail, 1.0);
+}
+
+void
+TDigest::serialize(vespalib::Serializer &os) const
+{
+    if (!_buffer.empty()) {
+        TDigest tmp(*this);
+        tmp.compress();
+        tmp.serialize(os);
+        return;
+    }
+    os << _compression << _min << _max;
+    os << static_cast<uint32_t>(_centroids.size());
+    for (const Centroid &c : _centroids) {
+        os << c.mean << c.weight;
+    }
+}
+
+void
+TDigest::deserialize(vespalib::Deserializer &is)
+{
+    uint32_t size(0);
+    is >> _compression >> _min >> _max >> size;
+    _centroids.clear();
+    _buffer.clear();
+    _totalWeight = 0.0;
+    _centroids.reserve(size);
+    for (uint32_t i = 0; i < size; ++i) {
+        double mean(0.0);
+        double weight(0.0);
+        is >> mean >> weight;
+        _centroids.emplace_back(mean, weight);
+        _totalWeight += weight;
+    }
+}
+
+bool
+TDigest::operator==(const TDigest &rhs) const
+{
+    TDigest a(*this);
+    TDigest b(rhs);
+    a.compress();
+    b.compress();
+    return (a._compression == b._compression) &&
+           (a._totalWeight == b._totalWeight) &&
+           (a.empty() || ((a._min == b._min) && (a._max == b._max))) &&
+           (a._centroids == b._centroids);
+}
+
+}
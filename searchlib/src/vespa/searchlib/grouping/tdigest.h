@@ -0,0 +1,63 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/objects/deserializer.h>
+#include <vespa/vespalib/objects/serializer.h>
+#include <vector>
+
+namespace search {
+
+/**
+ * Mergeable sketch used to estimate quantiles of a stream of values
+ * in bounded memory. Values are summarized as weighted centroids,
+ * where centroids near the tails are kept small and centroids near
+ * the median are allowed to grow. The number of centroids is bounded
+ * by the compression parameter.
+ *
+ * Added values are buffered and merged into the centroid list in
+ * batches. The serialized form is always compressed, and the same
+ * compression is done on the QR server when merging results from
+ * several nodes.
+ */
+class TDigest {
+public:
+    struct Centroid {
+        double mean;
+        double weight;
+        Centroid(double m, double w) : mean(m), weight(w) {}
+        bool operator==(const Centroid &rhs) const { return mean == rhs.mean && weight == rhs.weight; }
+    };
+    static constexpr double DEFAULT_COMPRESSION = 100.0;
+
+    explicit TDigest(double compression = DEFAULT_COMPRESSION);
+    ~TDigest();
+
+    void add(double value, double weight = 1.0);
+    void merge(const TDigest &rhs);
+    void compress();
+    double quantile(double q) const;
+
+    double getCompression() const { return _compression; }
+    double getTotalWeight() const { return _totalWeight; }
+    double getMin() const { return _min; }
+    double getMax() const { return _max; }
+    bool empty() const { return (_totalWeight == 0.0); }
+    // Centroids in increasing mean order. Only valid after compress().
+    const std::vector<Centroid> &getCentroids() const { return _centroids; }
+
+    void serialize(vespalib::Serializer &os) const;
+    void deserialize(vespalib::Deserializer &is);
+    bool operator==(const TDigest &rhs) const;
+private:
+    double scale(double q) const;
+
+    double                _compression;
+    double                _totalWeight;
+    double                _min;
+    double                _max;
+    std::vector<Centroid> _centroids;
+    std::vector<Centroid> _buffer;
+};
+
+}
@@ -140,6 +140,14 @@ FeatureStore::bitSize(uint32_t packedIndex, datastore::EntryRef ref)
 }
 
 
+void
+FeatureStore::holdFeatures(uint32_t packedIndex, datastore::EntryRef ref)
+{
+    uint64_t byteLen = (bitSize(packedIndex, ref) + 7) / 8;
+    _store.holdElem(ref, byteLen + RefType::pad(byteLen));
+}
+
+
 datastore::EntryRef
 FeatureStore::moveFeatures(uint32_t packedIndex,
                            datastore::EntryRef ref)
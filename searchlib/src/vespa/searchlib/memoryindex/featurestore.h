@@ -238,6 +238,16 @@ public:
         _store.clearHoldLists();
     }
 
+    /**
+     * Put features on hold, to be accounted as dead when no reader
+     * can see them anymore.
+     *
+     * @param packedIndex The field or field collection owning features
+     * @param ref         Reference to stored features
+     */
+    void
+    holdFeatures(uint32_t packedIndex, datastore::EntryRef ref);
+
     // Inherit doc from DataStoreBase
     std::vector<uint32_t>
     startCompact()
@@ -245,6 +255,23 @@ public:
         return _store.startCompact(_typeId);
     }
 
+    // Inherit doc from DataStoreBase
+    std::vector<uint32_t>
+    startCompactWorstBuffers()
+    {
+        return _store.startCompactWorstBuffers(true, false);
+    }
+
+    /**
+     * Returns true if the given features are stored in a buffer
+     * currently being compacted.
+     */
+    bool
+    isCompacting(datastore::EntryRef ref) const
+    {
+        return _store.getBufferState(RefType(ref).bufferId()).getCompacting();
+    }
+
     // Inherit doc from DataStoreBase
     void
     finishCompact(const std::vector<uint32_t> & toHold)
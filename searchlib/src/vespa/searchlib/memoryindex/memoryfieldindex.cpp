@@ -5,6 +5,8 @@
 #include <vespa/vespalib/util/exceptions.h>
 
 #include <vespa/searchlib/bitcompression/posocccompression.h>
+#include <vespa/searchlib/common/growablebitvector.h>
+#include <vespa/searchlib/diskindex/bitvectoridxfile.h>
 
 #include <vespa/searchlib/btree/btreenode.hpp>
 #include <vespa/searchlib/btree/btreenodeallocator.hpp>
@@ -24,6 +26,35 @@ using index::Schema;
 
 namespace memoryindex {
 
+namespace {
+
+constexpr size_t FEATURE_COMPACT_MIN_DEAD_BYTES = 0x10000u;
+constexpr double FEATURE_COMPACT_DEAD_RATIO = 0.2;
+
+class HeldBitVector : public vespalib::GenerationHeldBase
+{
+    std::unique_ptr<GrowableBitVector> _bitVector;
+public:
+    HeldBitVector(std::unique_ptr<GrowableBitVector> bitVector)
+        : GenerationHeldBase(sizeof(GrowableBitVector) + bitVector->extraByteSize()),
+          _bitVector(std::move(bitVector))
+    { }
+};
+
+void
+ensureBitVectorSize(GrowableBitVector &bv, uint32_t newSize)
+{
+    if (newSize <= bv.size()) {
+        return;
+    }
+    if (newSize > bv.capacity()) {
+        bv.reserve(std::max(newSize, bv.capacity() + bv.capacity() / 4 + 1024));
+    }
+    bv.extend(newSize);
+}
+
+}
+
 vespalib::asciistream &
 operator<<(vespalib::asciistream & os, const MemoryFieldIndex::WordKey & rhs)
 {
@@ -40,7 +71,10 @@ MemoryFieldIndex::MemoryFieldIndex(const Schema & schema, uint32_t fieldId)
       _featureStore(schema),
       _fieldId(fieldId),
       _remover(_wordStore),
-      _inserter(std::make_unique<OrderedDocumentInserter>(*this))
+      _inserter(std::make_unique<OrderedDocumentInserter>(*this)),
+      _bitVectors(),
+      _bitVectorHolder(),
+      _docIdLimit(1u)
 { }
 
 MemoryFieldIndex::~MemoryFieldIndex()
@@ -49,6 +83,11 @@ MemoryFieldIndex::~MemoryFieldIndex()
     _postingListStore.disableElemHoldList();
     _dict.disableFreeLists();
     _dict.disableElemHoldList();
+    for (BitVectorTree::Iterator it = _bitVectors.begin(); it.valid(); ++it) {
+        delete it.getData();
+    }
+    _bitVectors.clear();
+    _bitVectorHolder.clearHoldLists();
     // XXX: Kludge
     for (DictionaryTree::Iterator it = _dict.begin();
          it.valid(); ++it) {
@@ -94,13 +133,113 @@ MemoryFieldIndex::findFrozen(const vespalib::stringref word) const
     return PostingList::Iterator();
 }
 
+const BitVector *
+MemoryFieldIndex::findFrozenBitVector(const vespalib::stringref word) const
+{
+    DictionaryTree::ConstIterator itr =
+        _dict.getFrozenView().find(WordKey(datastore::EntryRef()),
+                                   KeyComp(_wordStore, word));
+    if (!itr.valid()) {
+        return nullptr;
+    }
+    BitVectorTree::ConstIterator bvItr =
+        _bitVectors.getFrozenView().find(itr.getKey()._wordRef.ref());
+    return bvItr.valid() ? bvItr.getData() : nullptr;
+}
+
+void
+MemoryFieldIndex::makeBitVector(datastore::EntryRef wordRef, datastore::EntryRef pidx)
+{
+    uint32_t size = _docIdLimit;
+    auto bv = std::make_unique<GrowableBitVector>(size, size, _bitVectorHolder);
+    _postingListStore.foreach_unfrozen_key(pidx, [&bv](uint32_t docId) { bv->setBit(docId); });
+    bv->invalidateCachedCount();
+    _bitVectors.insert(wordRef.ref(), bv.release());
+}
+
+void
+MemoryFieldIndex::dropBitVector(BitVectorTree::Iterator &itr)
+{
+    std::unique_ptr<GrowableBitVector> bv(itr.getData());
+    _bitVectors.remove(itr);
+    // Readers may still be using the bitvector
+    _bitVectorHolder.hold(std::make_unique<HeldBitVector>(std::move(bv)));
+}
+
+void
+MemoryFieldIndex::updateBitVector(datastore::EntryRef wordRef, datastore::EntryRef pidx,
+                                  const std::vector<PostingListKeyDataType> &adds,
+                                  const std::vector<uint32_t> &removes)
+{
+    if (!adds.empty() && adds.back()._key >= _docIdLimit) {
+        _docIdLimit = adds.back()._key + 1;
+    }
+    uint32_t bitVectorLimit = diskindex::BitVectorIdxFileWrite::getBitVectorLimit(_docIdLimit);
+    size_t docFreq = pidx.valid() ? _postingListStore.size(pidx) : 0u;
+    BitVectorTree::Iterator itr = _bitVectors.find(wordRef.ref());
+    if (!itr.valid()) {
+        if (docFreq > bitVectorLimit) {
+            makeBitVector(wordRef, pidx);
+        }
+        return;
+    }
+    if (docFreq < bitVectorLimit / 2) {
+        dropBitVector(itr);
+        return;
+    }
+    GrowableBitVector &bv = *itr.getData();
+    for (uint32_t docId : removes) {
+        if (docId < bv.size()) {
+            bv.clearBit(docId);
+        }
+    }
+    if (!adds.empty()) {
+        ensureBitVectorSize(bv, adds.back()._key + 1);
+        for (const auto &add : adds) {
+            bv.setBit(add._key);
+        }
+    }
+    bv.invalidateCachedCount();
+}
+
+
+void
+MemoryFieldIndex::holdFeatures(datastore::EntryRef pidx, const std::vector<uint32_t> &removes)
+{
+    if (!pidx.valid()) {
+        return;
+    }
+    PostingList::Iterator itr = _postingListStore.begin(pidx);
+    for (uint32_t docId : removes) {
+        if (itr.valid() && itr.getKey() < docId) {
+            itr.seek(docId);
+        }
+        if (!itr.valid()) {
+            break;
+        }
+        if (itr.getKey() == docId) {
+            _featureStore.holdFeatures(_fieldId, datastore::EntryRef(itr.getData()));
+        }
+    }
+}
+
+bool
+MemoryFieldIndex::shouldCompactFeatures() const
+{
+    MemoryUsage usage = _featureStore.getMemoryUsage();
+    return (usage.deadBytes() >= FEATURE_COMPACT_MIN_DEAD_BYTES) &&
+        (usage.deadBytes() > usage.usedBytes() * FEATURE_COMPACT_DEAD_RATIO);
+}
 
 void
 MemoryFieldIndex::compactFeatures()
 {
     std::vector<uint32_t> toHold;
 
-    toHold = _featureStore.startCompact();
+    toHold = _featureStore.startCompactWorstBuffers();
+    if (toHold.empty()) {
+        return;
+    }
     DictionaryTree::Iterator itr(_dict.begin());
     uint32_t packedIndex = _fieldId;
     for (; itr.valid(); ++itr) {
@@ -118,6 +257,9 @@ MemoryFieldIndex::compactFeatures()
 
                 // Filter on which buffers to move features from when
                 // performing incremental compaction.
+                if (!_featureStore.isCompacting(oldFeatures)) {
+                    continue;
+                }
 
                 datastore::EntryRef newFeatures = _featureStore.moveFeatures(packedIndex, oldFeatures);
 
@@ -137,6 +279,9 @@ MemoryFieldIndex::compactFeatures()
 
                 // Filter on which buffers to move features from when
                 // performing incremental compaction.
+                if (!_featureStore.isCompacting(oldFeatures)) {
+                    continue;
+                }
 
                 datastore::EntryRef newFeatures = _featureStore.moveFeatures(packedIndex, oldFeatures);
 
@@ -239,6 +384,13 @@ MemoryFieldIndex::getMemoryUsage() const
     usage.merge(_postingListStore.getMemoryUsage());
     usage.merge(_featureStore.getMemoryUsage());
     usage.merge(_remover.getStore().getMemoryUsage());
+    usage.merge(_bitVectors.getMemoryUsage());
+    for (BitVectorTree::Iterator it = _bitVectors.begin(); it.valid(); ++it) {
+        size_t bytes = sizeof(GrowableBitVector) + it.getData()->extraByteSize();
+        usage.incAllocatedBytes(bytes);
+        usage.incUsedBytes(bytes);
+    }
+    usage.incAllocatedBytesOnHold(_bitVectorHolder.getHeldBytes());
     return usage;
 }
 
@@ -326,6 +478,12 @@ class BTreeNodeAllocator<memoryindex::MemoryFieldIndex::WordKey,
                          BTreeDefaultTraits::INTERNAL_SLOTS,
                          BTreeDefaultTraits::LEAF_SLOTS>;
 
+template
+class BTreeNodeAllocator<uint32_t,
+                         GrowableBitVector *,
+                         search::btree::NoAggregated,
+                         BTreeDefaultTraits::INTERNAL_SLOTS,
+                         BTreeDefaultTraits::LEAF_SLOTS>;
 
 } // namespace btree
 } // namespace search
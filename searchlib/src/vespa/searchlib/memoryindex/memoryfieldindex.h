@@ -13,8 +13,13 @@
 #include <vespa/searchlib/index/indexbuilder.h>
 #include <vespa/searchlib/util/memoryusage.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/generationholder.h>
 
 namespace search {
+
+class BitVector;
+class GrowableBitVector;
+
 namespace memoryindex {
 
 class OrderedDocumentInserter;
@@ -74,6 +79,8 @@ public:
     typedef btree::BTree<WordKey, PostingListPtr,
                          search::btree::NoAggregated,
                          const KeyComp> DictionaryTree;
+    typedef btree::BTree<uint32_t, GrowableBitVector *,
+                         search::btree::NoAggregated> BitVectorTree; // word ref -> bitvector
 private:
     typedef vespalib::GenerationHandler GenerationHandler;
 
@@ -86,6 +93,12 @@ private:
     uint32_t                _fieldId;
     DocumentRemover         _remover;
     std::unique_ptr<OrderedDocumentInserter> _inserter;
+    BitVectorTree           _bitVectors;
+    vespalib::GenerationHolder _bitVectorHolder;
+    uint32_t                _docIdLimit;
+
+    void makeBitVector(datastore::EntryRef wordRef, datastore::EntryRef pidx);
+    void dropBitVector(BitVectorTree::Iterator &itr);
 
 public:
     datastore::EntryRef addWord(const vespalib::stringref word) {
@@ -106,6 +119,24 @@ public:
     PostingList::ConstIterator
     findFrozen(const vespalib::stringref word) const;
 
+    /**
+     * Returns the bitvector shadowing the posting list for the given
+     * word, or nullptr if the word is not common enough to have one.
+     * The bitvector stays valid while holding a generation guard.
+     */
+    const BitVector *findFrozenBitVector(const vespalib::stringref word) const;
+
+    /**
+     * Keeps the bitvector for a word in sync with its posting list
+     * after the posting list has been updated. A bitvector is created
+     * when the number of documents passes the same limit as used for
+     * bitvectors in the disk index, and dropped when it falls below
+     * half of that limit.
+     */
+    void updateBitVector(datastore::EntryRef wordRef, datastore::EntryRef pidx,
+                         const std::vector<PostingListKeyDataType> &adds,
+                         const std::vector<uint32_t> &removes);
+
     uint64_t getNumUniqueWords() const { return _numUniqueWords; }
     const FeatureStore & getFeatureStore() const { return _featureStore; }
     const WordStore &getWordStore() const { return _wordStore; }
@@ -115,6 +146,7 @@ private:
     void freeze() {
         _postingListStore.freeze();
         _dict.getAllocator().freeze();
+        _bitVectors.getAllocator().freeze();
     }
 
     void
@@ -125,6 +157,8 @@ private:
         _postingListStore.trimHoldLists(usedGen);
         _dict.getAllocator().trimHoldLists(usedGen);
         _featureStore.trimHoldLists(usedGen);
+        _bitVectors.getAllocator().trimHoldLists(usedGen);
+        _bitVectorHolder.trimHoldLists(usedGen);
     }
 
     void
@@ -135,6 +169,8 @@ private:
         _postingListStore.transferHoldLists(generation);
         _dict.getAllocator().transferHoldLists(generation);
         _featureStore.transferHoldLists(generation);
+        _bitVectors.getAllocator().transferHoldLists(generation);
+        _bitVectorHolder.transferHoldLists(generation);
     }
 
     void
@@ -148,9 +184,27 @@ public:
         return _generationHandler.takeGuard();
     }
 
+    /**
+     * Moves the features out of the feature store buffers with the
+     * most dead bytes, so that those buffers can be freed.
+     */
     void
     compactFeatures();
 
+    /**
+     * Returns true if enough of the feature store is dead for
+     * compactFeatures() to be worthwhile.
+     */
+    bool
+    shouldCompactFeatures() const;
+
+    /**
+     * Puts the features of the given documents in the given posting
+     * list on hold, before the documents are removed from it.
+     */
+    void
+    holdFeatures(datastore::EntryRef pidx, const std::vector<uint32_t> &removes);
+
     void dump(search::index::IndexBuilder & indexBuilder);
 
     MemoryUsage getMemoryUsage() const;
@@ -176,6 +230,9 @@ public:
     void commit()
     {
         _remover.flush();
+        if (shouldCompactFeatures()) {
+            compactFeatures();
+        }
         freeze();
         transferHoldLists();
         incGeneration();
@@ -266,6 +323,13 @@ class BTreeNodeAllocator<memoryindex::MemoryFieldIndex::WordKey,
                        BTreeDefaultTraits::INTERNAL_SLOTS,
                        BTreeDefaultTraits::LEAF_SLOTS>;
 
+extern template
+class BTreeNodeAllocator<uint32_t,
+                         GrowableBitVector *,
+                         search::btree::NoAggregated,
+                         BTreeDefaultTraits::INTERNAL_SLOTS,
+                         BTreeDefaultTraits::LEAF_SLOTS>;
+
 } // namespace search::btree
 
 } // namespace search
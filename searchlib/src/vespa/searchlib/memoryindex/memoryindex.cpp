@@ -6,6 +6,8 @@
 #include <vespa/searchlib/queryeval/create_blueprint_visitor_helper.h>
 #include <vespa/searchlib/queryeval/booleanmatchiteratorwrapper.h>
 #include <vespa/searchlib/queryeval/emptysearch.h>
+#include <vespa/searchlib/queryeval/equiv_blueprint.h>
+#include <vespa/searchlib/common/bitvectoriterator.h>
 #include <vespa/searchlib/queryeval/leaf_blueprints.h>
 #include <vespa/searchlib/common/sequencedtaskexecutor.h>
 #include <vespa/searchlib/btree/btreenodeallocator.hpp>
@@ -26,6 +28,7 @@ using index::Schema;
 using index::SchemaUtil;
 using query::NumberTerm;
 using query::LocationTerm;
+using query::NearestNeighborTerm;
 using query::Node;
 using query::PredicateQuery;
 using query::PrefixTerm;
@@ -40,6 +43,7 @@ using queryeval::CreateBlueprintVisitorHelper;
 using queryeval::Blueprint;
 using queryeval::BooleanMatchIteratorWrapper;
 using queryeval::EmptyBlueprint;
+using queryeval::EquivBlueprint;
 using queryeval::FieldSpecBase;
 using queryeval::FieldSpecBaseList;
 using queryeval::FieldSpec;
@@ -138,18 +142,31 @@ MemoryIndex::dump(IndexBuilder &indexBuilder)
 
 namespace {
 
+bool
+areAnyParentsEquiv(const Blueprint * node)
+{
+    return (node == nullptr)
+           ? false
+           : (dynamic_cast<const EquivBlueprint *>(node) != nullptr)
+             ? true
+             : areAnyParentsEquiv(node->getParent());
+}
+
 class MemTermBlueprint : public queryeval::SimpleLeafBlueprint
 {
 private:
     GenerationHandler::Guard               _genGuard;
     Dictionary::PostingList::ConstIterator _pitr;
+    const BitVector                       *_bitVector;
     const FeatureStore                    &_featureStore;
     const uint32_t                         _fieldId;
     const bool                             _useBitVector;
+    bool                                   _hasEquivParent;
 
 public:
     MemTermBlueprint(GenerationHandler::Guard &&genGuard,
                      Dictionary::PostingList::ConstIterator pitr,
+                     const BitVector *bitVector,
                      const FeatureStore &featureStore,
                      const FieldSpecBase &field,
                      uint32_t fieldId,
@@ -157,17 +174,28 @@ public:
         : SimpleLeafBlueprint(field),
           _genGuard(),
           _pitr(pitr),
+          _bitVector(bitVector),
           _featureStore(featureStore),
           _fieldId(fieldId),
-          _useBitVector(useBitVector)
+          _useBitVector(useBitVector),
+          _hasEquivParent(false)
     {
         _genGuard = std::move(genGuard);
         HitEstimate estimate(_pitr.size(), !_pitr.valid());
         setEstimate(estimate);
     }
 
+    void fetchPostings(bool) override {
+        _hasEquivParent = areAnyParentsEquiv(getParent());
+    }
+
     SearchIterator::UP
-    createLeafSearch(const TermFieldMatchDataArray &tfmda, bool) const override {
+    createLeafSearch(const TermFieldMatchDataArray &tfmda, bool strict) const override {
+        if ((_bitVector != nullptr) && (_useBitVector || (tfmda[0]->isNotNeeded() && !_hasEquivParent))) {
+            LOG(debug, "Return BitVectorIterator: fieldId(%u), docCount(%zu)",
+                _fieldId, _pitr.size());
+            return BitVectorIterator::create(_bitVector, _bitVector->size(), *tfmda[0], strict);
+        }
         SearchIterator::UP search(new PostingIterator(_pitr, _featureStore, _fieldId, tfmda));
         if (_useBitVector) {
             LOG(debug, "Return BooleanMatchIteratorWrapper: fieldId(%u), docCount(%zu)",
@@ -211,8 +239,9 @@ public:
         GenerationHandler::Guard genGuard = fieldIndex->takeGenerationGuard();
         Dictionary::PostingList::ConstIterator pitr
             = fieldIndex->findFrozen(termStr);
+        const BitVector *bitVector = fieldIndex->findFrozenBitVector(termStr);
         bool useBitVector = _field.isFilter();
-        setResult(make_UP(new MemTermBlueprint(std::move(genGuard), pitr,
+        setResult(make_UP(new MemTermBlueprint(std::move(genGuard), pitr, bitVector,
                                                fieldIndex->getFeatureStore(),
                                               _field, _fieldId, useBitVector)));
     }
@@ -225,6 +254,7 @@ public:
     void visit(SuffixTerm &n)    override { visitTerm(n); }
     void visit(RegExpTerm &n)    override { visitTerm(n); }
     void visit(PredicateQuery &) override { }
+    void visit(NearestNeighborTerm &) override { }
 
     void visit(NumberTerm &n) override {
         handleNumberTermAsText(n);
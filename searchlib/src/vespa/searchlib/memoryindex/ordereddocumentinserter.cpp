@@ -48,9 +48,9 @@ OrderedDocumentInserter::flushWord()
     if (_removes.empty() && _adds.empty()) {
         return;
     }
-    //XXX: Feature store leak, removed features not marked dead
     PostingListStore &postingListStore(_fieldIndex.getPostingListStore());
     datastore::EntryRef pidx(_dItr.getData());
+    _fieldIndex.holdFeatures(pidx, _removes);
     postingListStore.apply(pidx,
                            &_adds[0],
                            &_adds[0] + _adds.size(),
@@ -61,6 +61,7 @@ OrderedDocumentInserter::flushWord()
         std::atomic_thread_fence(std::memory_order_release);
         _dItr.writeData(pidx.ref());
     }
+    _fieldIndex.updateBitVector(_dItr.getKey()._wordRef, pidx, _adds, _removes);
     _removes.clear();
     _adds.clear();
 }
@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "postingiterator.h"
+#include <vespa/searchlib/common/bitvector.h>
 
 #include <vespa/searchlib/btree/btreenode.hpp>
 #include <vespa/searchlib/btree/btreenodeallocator.hpp>
@@ -52,6 +53,33 @@ PostingIterator::doSeek(uint32_t docId)
     }
 }
 
+std::unique_ptr<BitVector>
+PostingIterator::get_hits(uint32_t begin_id)
+{
+    BitVector::UP result(BitVector::create(begin_id, getEndId()));
+    for (; _itr.valid() && _itr.getKey() < getEndId(); ++_itr) {
+        result->setBit(_itr.getKey());
+    }
+    result->invalidateCachedCount();
+    clearUnpacked();
+    setAtEnd();
+    return result;
+}
+
+void
+PostingIterator::or_hits_into(BitVector &result, uint32_t begin_id)
+{
+    (void) begin_id;
+    for (; _itr.valid() && _itr.getKey() < getEndId(); ++_itr) {
+        if ( ! result.testBit(_itr.getKey()) ) {
+            result.setBit(_itr.getKey());
+        }
+    }
+    result.invalidateCachedCount();
+    clearUnpacked();
+    setAtEnd();
+}
+
 void
 PostingIterator::doUnpack(uint32_t docId)
 {
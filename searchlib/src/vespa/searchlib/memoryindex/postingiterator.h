@@ -36,6 +36,8 @@ public:
     void doSeek(uint32_t docId) override;
     void doUnpack(uint32_t docId) override;
     void initRange(uint32_t begin, uint32_t end) override;
+    std::unique_ptr<BitVector> get_hits(uint32_t begin_id) override;
+    void or_hits_into(BitVector &result, uint32_t begin_id) override;
     Trinary is_strict() const override { return Trinary::True; }
 };
 
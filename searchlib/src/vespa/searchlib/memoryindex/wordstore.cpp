@@ -2,6 +2,7 @@
 
 #include "wordstore.h"
 #include <vespa/searchlib/datastore/datastore.hpp>
+#include <cstring>
 
 namespace search {
 namespace memoryindex {
@@ -33,13 +34,8 @@ WordStore::addWord(const vespalib::stringref word)
     size_t bufferSize = RefType::align(wordSize);
     auto result = _store.rawAllocator<char>(_typeId).alloc(bufferSize);
     char *be = result.data;
-    for (size_t i = 0; i < word.size(); ++i) {
-        *be++ = word[i];
-    }
-    *be++ = 0;
-    for (size_t i = wordSize; i < bufferSize; ++i) {
-        *be++ = 0;
-    }
+    memcpy(be, word.data(), word.size());
+    memset(be + word.size(), 0, bufferSize - word.size());
     ++_numWords;
     return result.ref;
 }
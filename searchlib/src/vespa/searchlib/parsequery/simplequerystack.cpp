@@ -113,6 +113,7 @@ public:
         _name[search::ParseItem::ITEM_WAND] = 'A';
         _name[search::ParseItem::ITEM_PREDICATE_QUERY] = 'P';
         _name[search::ParseItem::ITEM_REGEXP] = '^';
+        _name[search::ParseItem::ITEM_NEAREST_NEIGHBOR] = 'V';
     }
     char operator[] (search::ParseItem::ItemType i) const { return _name[i]; }
     char operator[] (size_t i) const { return _name[i]; }
@@ -279,6 +280,25 @@ SimpleQueryStack::StackbufToString(const vespalib::stringref &theBuf)
             }
             break;
 
+        case search::ParseItem::ITEM_NEAREST_NEIGHBOR:
+        {
+            idxRefLen = static_cast<uint32_t>(ReadCompressedPositiveInt(p));
+            idxRef = p;
+            p += idxRefLen;
+            uint32_t targetNumHits = ReadCompressedPositiveInt(p);
+            uint32_t exploreAdditionalHits = ReadCompressedPositiveInt(p);
+            size_t cell_count = ReadCompressedPositiveInt(p);
+            result.append(make_string("%c/%d:%.*s/%u/%u(", _G_ItemName[type], idxRefLen, idxRefLen, idxRef,
+                                      targetNumHits, exploreAdditionalHits));
+            for (size_t i = 0; i < cell_count; ++i) {
+                double cell = vespalib::nbo::n2h(*reinterpret_cast<const double *>(p));
+                p += sizeof(double);
+                result.append(make_string("%s%g", (i > 0) ? "," : "", cell));
+            }
+            result.append(")~");
+            break;
+        }
+
         case search::ParseItem::ITEM_PREDICATE_QUERY:
         {
             idxRefLen = static_cast<uint32_t>(ReadCompressedPositiveInt(p));
@@ -25,6 +25,7 @@ SimpleQueryStackDumpIterator::SimpleQueryStackDumpIterator(const vespalib::strin
     _currArg2(0),
     _currArg3(0),
     _predicate_query_term(),
+    _currQueryVector(),
     _currIndexName(NULL),
     _currIndexNameLen(0),
     _currTerm(NULL),
@@ -246,6 +247,31 @@ SimpleQueryStackDumpIterator::next()
         }
         break;
 
+    case ParseItem::ITEM_NEAREST_NEIGHBOR:
+        try {
+            if (p >= _bufEnd) return false;
+            _currIndexNameLen = readCompressedPositiveInt(p);
+            _currIndexName = p;
+            p += _currIndexNameLen;
+            if (p > _bufEnd) return false;
+            _currArg1 = readCompressedPositiveInt(p); // targetNumHits
+            _currArg2 = readCompressedPositiveInt(p); // exploreAdditionalHits
+            size_t count = readCompressedPositiveInt(p);
+            if (p + count * sizeof(double) > _bufEnd) return false;
+            _currQueryVector.clear();
+            _currQueryVector.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                _currQueryVector.push_back(vespalib::nbo::n2h(*reinterpret_cast<const double *>(p)));
+                p += sizeof(double);
+            }
+        } catch (...) {
+            return false;
+        }
+        _currArity = 0;
+        _currTerm = NULL;
+        _currTermLen = 0;
+        break;
+
     case ParseItem::ITEM_WEIGHTED_SET:
     case ParseItem::ITEM_DOT_PRODUCT:
     case ParseItem::ITEM_WAND:
@@ -6,6 +6,7 @@
 #include <vespa/searchlib/query/tree/predicate_query_term.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <vector>
 
 namespace search {
 /**
@@ -50,6 +51,8 @@ private:
     double _currArg3;
     /** The predicate query specification */
     query::PredicateQueryTerm::UP _predicate_query_term;
+    /** The query vector of a nearest neighbor item */
+    std::vector<double> _currQueryVector;
     /** Pointer to the position of the index name in the current item */
     const char *_currIndexName;
     /** The length of the index name in the current item */
@@ -146,6 +149,8 @@ public:
     query::PredicateQueryTerm::UP getPredicateQueryTerm()
     { return std::move(_predicate_query_term); }
 
+    const std::vector<double> &getQueryVector() const { return _currQueryVector; }
+
     vespalib::stringref getIndexName() const { return vespalib::stringref(_currIndexName, _currIndexNameLen); }
     vespalib::stringref getTerm() const { return vespalib::stringref(_currTerm, _currTermLen); }
 };
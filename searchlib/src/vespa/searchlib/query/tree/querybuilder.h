@@ -200,6 +200,14 @@ createRegExpTerm(const vespalib::stringref &term, const vespalib::stringref &vie
     return new typename NodeTypes::RegExpTerm(term, view, id, weight);
 }
 
+template <class NodeTypes>
+typename NodeTypes::NearestNeighborTerm *
+createNearestNeighborTerm(std::vector<double> query_vector, const vespalib::stringref &view, int32_t id, Weight weight,
+                          uint32_t target_num_hits, uint32_t explore_additional_hits) {
+    return new typename NodeTypes::NearestNeighborTerm(std::move(query_vector), view, id, weight,
+                                                       target_num_hits, explore_additional_hits);
+}
+
 template <class NodeTypes>
 class QueryBuilder : public QueryBuilderBase {
     template <class T>
@@ -304,6 +312,13 @@ public:
         adjustWeight(weight);
         return addTerm(createRegExpTerm<NodeTypes>(term, view, id, weight));
     }
+    typename NodeTypes::NearestNeighborTerm &addNearestNeighborTerm(std::vector<double> query_vector, const stringref &view,
+                                                                    int32_t id, Weight weight, uint32_t target_num_hits,
+                                                                    uint32_t explore_additional_hits) {
+        adjustWeight(weight);
+        return addTerm(createNearestNeighborTerm<NodeTypes>(std::move(query_vector), view, id, weight,
+                                                            target_num_hits, explore_additional_hits));
+    }
 };
 
 }  // namespace query
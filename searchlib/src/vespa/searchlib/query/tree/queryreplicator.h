@@ -163,6 +163,14 @@ private:
                           node.getTerm(), node.getView(),
                           node.getId(), node.getWeight()));
     }
+
+    void visit(NearestNeighborTerm &node) override {
+        replicate(node, _builder.addNearestNeighborTerm(
+                          node.getTerm(), node.getView(),
+                          node.getId(), node.getWeight(),
+                          node.get_target_num_hits(),
+                          node.get_explore_additional_hits()));
+    }
 };
 
 }  // namespace query
@@ -26,6 +26,7 @@ class DotProduct;
 class WandTerm;
 class PredicateQuery;
 class RegExpTerm;
+class NearestNeighborTerm;
 
 struct QueryVisitor {
     virtual ~QueryVisitor() {}
@@ -51,6 +52,7 @@ struct QueryVisitor {
     virtual void visit(WandTerm &) = 0;
     virtual void visit(PredicateQuery &) = 0;
     virtual void visit(RegExpTerm &) = 0;
+    virtual void visit(NearestNeighborTerm &) = 0;
 };
 
 }  // namespace query
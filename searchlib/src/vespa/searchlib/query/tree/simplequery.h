@@ -100,6 +100,14 @@ struct SimpleRegExpTerm : RegExpTerm {
         : RegExpTerm(term, view, id, weight) {
     }
 };
+struct SimpleNearestNeighborTerm : NearestNeighborTerm {
+    SimpleNearestNeighborTerm(std::vector<double> query_vector, const vespalib::stringref &view,
+                              int32_t id, Weight weight, uint32_t target_num_hits,
+                              uint32_t explore_additional_hits)
+        : NearestNeighborTerm(std::move(query_vector), view, id, weight,
+                              target_num_hits, explore_additional_hits) {
+    }
+};
 
 
 struct SimpleQueryNodeTypes {
@@ -124,6 +132,7 @@ struct SimpleQueryNodeTypes {
     typedef SimpleWandTerm WandTerm;
     typedef SimplePredicateQuery PredicateQuery;
     typedef SimpleRegExpTerm RegExpTerm;
+    typedef SimpleNearestNeighborTerm NearestNeighborTerm;
 };
 
 }  // namespace query
@@ -246,6 +246,17 @@ class QueryNodeConverter : public QueryVisitor {
         createTerm(node, ParseItem::ITEM_REGEXP);
     }
 
+    void visit(NearestNeighborTerm &node) override {
+        createTerm(node, ParseItem::ITEM_NEAREST_NEIGHBOR);
+        appendCompressedPositiveNumber(node.get_target_num_hits());
+        appendCompressedPositiveNumber(node.get_explore_additional_hits());
+        const auto &cells = node.getTerm();
+        appendCompressedPositiveNumber(cells.size());
+        for (double cell : cells) {
+            appendDouble(cell);
+        }
+    }
+
 public:
     QueryNodeConverter()
         : _buf(4096)
@@ -275,6 +286,10 @@ void QueryNodeConverter::appendTerm(
     appendPredicateQueryTermVector(term.getFeatures());
     appendPredicateQueryTermVector(term.getRangeFeatures());
 }
+template <>
+void QueryNodeConverter::appendTerm(const TermBase<std::vector<double>> &) {
+    // The query vector is appended after the item parameters by the visitor.
+}
 template <typename V>
 void QueryNodeConverter::appendPredicateQueryTermVector(const V& v) {
     appendCompressedNumber(v.size());
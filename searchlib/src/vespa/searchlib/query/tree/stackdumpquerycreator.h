@@ -144,6 +144,9 @@ private:
                 t = &builder.addPredicateQuery(queryStack.getPredicateQueryTerm(), view, id, weight);
             } else if (type == ParseItem::ITEM_REGEXP) {
                 t = &builder.addRegExpTerm(term, view, id, weight);
+            } else if (type == ParseItem::ITEM_NEAREST_NEIGHBOR) {
+                t = &builder.addNearestNeighborTerm(queryStack.getQueryVector(), view, id, weight,
+                                                    queryStack.getArg1(), queryStack.getArg2());
             } else {
                 LOG(error, "Unable to create query tree from stack dump. node type = %d.", type);
             }
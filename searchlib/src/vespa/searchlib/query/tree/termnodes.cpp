@@ -24,5 +24,7 @@ LocationTerm::~LocationTerm() {}
 
 RegExpTerm::~RegExpTerm() {}
 
+NearestNeighborTerm::~NearestNeighborTerm() {}
+
 }  // namespace query
 }  // namespace search
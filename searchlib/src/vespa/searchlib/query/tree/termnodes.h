@@ -7,6 +7,7 @@
 #include "querynodemixin.h"
 #include "range.h"
 #include "term.h"
+#include <vector>
 
 namespace search {
 namespace query {
@@ -116,6 +117,31 @@ public:
     virtual ~RegExpTerm() = 0;
 };
 
+//-----------------------------------------------------------------------------
+
+/**
+ * Approximate nearest neighbor search in a dense tensor attribute. The
+ * term holds the cells of the query vector.
+ */
+class NearestNeighborTerm : public QueryNodeMixin<NearestNeighborTerm, TermBase<std::vector<double>>>
+{
+private:
+    uint32_t _target_num_hits;
+    uint32_t _explore_additional_hits;
+
+public:
+    NearestNeighborTerm(std::vector<double> query_vector, const vespalib::stringref &view,
+                        int32_t id, Weight weight, uint32_t target_num_hits,
+                        uint32_t explore_additional_hits)
+        : QueryNodeMixinType(std::move(query_vector), view, id, weight),
+          _target_num_hits(target_num_hits),
+          _explore_additional_hits(explore_additional_hits)
+    {}
+    virtual ~NearestNeighborTerm() = 0;
+    uint32_t get_target_num_hits() const { return _target_num_hits; }
+    uint32_t get_explore_additional_hits() const { return _explore_additional_hits; }
+};
+
 
 }  // namespace query
 }  // namespace search
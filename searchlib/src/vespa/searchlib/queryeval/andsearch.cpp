@@ -46,8 +46,8 @@ void AndSearch::doUnpack(uint32_t docid)
     }
 }
 
-AndSearch::AndSearch(const Children & children) :
-    MultiSearch(children),
+AndSearch::AndSearch(Children children) :
+    MultiSearch(std::move(children)),
     _estimate(std::numeric_limits<uint32_t>::max())
 {
 }
@@ -98,30 +98,30 @@ private:
 }
 
 AndSearch *
-AndSearch::create(const MultiSearch::Children &children, bool strict)
+AndSearch::create(MultiSearch::Children children, bool strict)
 {
     UnpackInfo unpackInfo;
     unpackInfo.forceAll();
-    return create(children, strict, unpackInfo);
+    return create(std::move(children), strict, unpackInfo);
 }
 
 AndSearch *
-AndSearch::create(const MultiSearch::Children &children, bool strict, const UnpackInfo & unpackInfo) {
+AndSearch::create(MultiSearch::Children children, bool strict, const UnpackInfo & unpackInfo) {
     if (strict) {
         if (unpackInfo.unpackAll()) {
-            return new AndSearchStrict<FullUnpack>(children, FullUnpack());
+            return new AndSearchStrict<FullUnpack>(std::move(children), FullUnpack());
         } else if(unpackInfo.empty()) {
-            return new AndSearchStrict<NoUnpack>(children, NoUnpack());
+            return new AndSearchStrict<NoUnpack>(std::move(children), NoUnpack());
         } else {
-            return new AndSearchStrict<SelectiveUnpack>(children, SelectiveUnpack(unpackInfo));
+            return new AndSearchStrict<SelectiveUnpack>(std::move(children), SelectiveUnpack(unpackInfo));
         }
     } else {
         if (unpackInfo.unpackAll()) {
-            return new AndSearchNoStrict<FullUnpack>(children, FullUnpack());
+            return new AndSearchNoStrict<FullUnpack>(std::move(children), FullUnpack());
         } else if (unpackInfo.empty()) {
-            return new AndSearchNoStrict<NoUnpack>(children, NoUnpack());
+            return new AndSearchNoStrict<NoUnpack>(std::move(children), NoUnpack());
         } else {
-            return new AndSearchNoStrict<SelectiveUnpack>(children, SelectiveUnpack(unpackInfo));
+            return new AndSearchNoStrict<SelectiveUnpack>(std::move(children), SelectiveUnpack(unpackInfo));
         }
     }
 }
@@ -15,8 +15,8 @@ class AndSearch : public MultiSearch
 {
 public:
     // Caller takes ownership of the returned SearchIterator.
-    static AndSearch *create(const Children &children, bool strict, const UnpackInfo & unpackInfo);
-    static AndSearch *create(const Children &children, bool strict);
+    static AndSearch *create(Children children, bool strict, const UnpackInfo & unpackInfo);
+    static AndSearch *create(Children children, bool strict);
 
     std::unique_ptr<BitVector> get_hits(uint32_t begin_id) override;
     void or_hits_into(BitVector &result, uint32_t begin_id) override;
@@ -25,7 +25,7 @@ public:
     AndSearch & estimate(uint32_t est) { _estimate = est; return *this; }
     uint32_t estimate() const { return _estimate; }
 protected:
-    AndSearch(const Children & children);
+    AndSearch(Children children);
     void doUnpack(uint32_t docid) override;
     UP andWith(UP filter, uint32_t estimate) override;
     UP offerFilterToChildren(UP filter, uint32_t estimate);
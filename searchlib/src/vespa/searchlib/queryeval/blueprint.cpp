@@ -64,6 +64,7 @@ Blueprint::min(const std::vector<HitEstimate> &data)
 Blueprint::State::State(const FieldSpecBaseList &fields_in)
     : _fields(fields_in),
       _estimate(),
+      _cost_tier(COST_TIER_NORMAL),
       _tree_size(1),
       _allow_termwise_eval(true)
 {
@@ -148,6 +149,7 @@ Blueprint::visitMembers(vespalib::ObjectVisitor &visitor) const
     visitor.visitInt("estHits", state.estimate().estHits);
     visitor.visitInt("tree_size", state.tree_size());
     visitor.visitInt("allow_termwise_eval", state.allow_termwise_eval());
+    visitor.visitInt("cost_tier", state.cost_tier());
     visitor.closeStruct();
     visitor.visitInt("sourceId", _sourceId);
     visitor.visitInt("docid_limit", _docid_limit);
@@ -206,6 +208,16 @@ IntermediateBlueprint::calculate_tree_size() const
     return nodes;
 }
 
+uint32_t
+IntermediateBlueprint::calculate_cost_tier() const
+{
+    uint32_t cost_tier = State::COST_TIER_MAX;
+    for (size_t i = 0; i < _children.size(); ++i) {
+        cost_tier = std::min(cost_tier, _children[i]->getState().cost_tier());
+    }
+    return cost_tier;
+}
+
 bool
 IntermediateBlueprint::infer_allow_termwise_eval() const
 {
@@ -282,6 +294,7 @@ IntermediateBlueprint::calculateState() const
 {
     State state(exposeFields());
     state.estimate(calculateEstimate());
+    state.cost_tier(calculate_cost_tier());
     state.allow_termwise_eval(infer_allow_termwise_eval());
     state.tree_size(calculate_tree_size());
     return state;
@@ -325,7 +338,7 @@ IntermediateBlueprint::createSearch(fef::MatchData &md, bool strict) const
         SearchIterator::UP search = _children[i]->createSearch(md, strictChild);
         subSearches.push_back(search.release());
     }
-    return createIntermediateSearch(subSearches, strict, md);
+    return createIntermediateSearch(std::move(subSearches), strict, md);
 }
 
 IntermediateBlueprint::IntermediateBlueprint()
@@ -509,6 +522,14 @@ LeafBlueprint::setEstimate(HitEstimate est)
     notifyChange();
 }
 
+void
+LeafBlueprint::set_cost_tier(uint32_t value)
+{
+    assert(value < State::COST_TIER_MAX);
+    _state.cost_tier(value);
+    notifyChange();
+}
+
 void
 LeafBlueprint::set_allow_termwise_eval(bool value)
 {
@@ -53,15 +53,24 @@ public:
     private:
         FieldSpecBaseList _fields;
         HitEstimate       _estimate;
+        uint32_t          _cost_tier;
         uint32_t          _tree_size;
         bool              _allow_termwise_eval;
 
     public:
+        // Relative cost of seeking the iterators of a blueprint. Blueprints
+        // in a lower tier are evaluated before blueprints in a higher tier
+        // when ordering the children of an AND, regardless of estimates.
+        static constexpr uint32_t COST_TIER_NORMAL = 1;
+        static constexpr uint32_t COST_TIER_EXPENSIVE = 2;
+        static constexpr uint32_t COST_TIER_MAX = 999;
+
         State(const FieldSpecBaseList &fields_in);
         ~State();
         void swap(State & rhs) {
             _fields.swap(rhs._fields);
             std::swap(_estimate, rhs._estimate);
+            std::swap(_cost_tier, rhs._cost_tier);
             std::swap(_tree_size, rhs._tree_size);
             std::swap(_allow_termwise_eval, rhs._allow_termwise_eval);
         }
@@ -87,6 +96,8 @@ public:
             uint32_t total_docs = std::max(total_hits, docid_limit);
             return double(total_hits) / double(total_docs);
         }
+        void cost_tier(uint32_t value) { _cost_tier = value; }
+        uint32_t cost_tier() const { return _cost_tier; }
         void tree_size(uint32_t value) { _tree_size = value; }
         uint32_t tree_size() const { return _tree_size; }
         void allow_termwise_eval(bool value) { _allow_termwise_eval = value; }
@@ -113,6 +124,18 @@ public:
         }
     };
 
+    // utility to get the lesser cost tier, then the lesser estimate, to sort first
+    struct TieredLessEstimate {
+        bool operator () (Blueprint * const &a, const Blueprint * const &b) const {
+            const State &lhs = a->getState();
+            const State &rhs = b->getState();
+            if (lhs.cost_tier() != rhs.cost_tier()) {
+                return (lhs.cost_tier() < rhs.cost_tier());
+            }
+            return (lhs.estimate() < rhs.estimate());
+        }
+    };
+
 private:
     Blueprint *_parent;
     uint32_t   _sourceId;
@@ -234,6 +257,10 @@ protected:
 
     virtual bool isPositive(size_t index) const { (void) index; return true; }
 
+    // The default is the cheapest tier among the children, since the
+    // cheapest child will drive the iteration.
+    virtual uint32_t calculate_cost_tier() const;
+
     bool should_do_termwise_eval(const UnpackInfo &unpack, double match_limit) const;
 
 public:
@@ -259,7 +286,7 @@ public:
     virtual void sort(std::vector<Blueprint*> &children) const = 0;
     virtual bool inheritStrict(size_t i) const = 0;
     virtual SearchIteratorUP
-    createIntermediateSearch(const std::vector<SearchIterator *> &subSearches,
+    createIntermediateSearch(std::vector<SearchIterator *> subSearches,
                              bool strict, fef::MatchData &md) const = 0;
 
     void visitMembers(vespalib::ObjectVisitor &visitor) const override;
@@ -279,6 +306,7 @@ private:
 protected:
     void optimize(Blueprint* &self) override final;
     void setEstimate(HitEstimate est);
+    void set_cost_tier(uint32_t value);
     void set_allow_termwise_eval(bool value);
     void set_tree_size(uint32_t value);
 
@@ -74,6 +74,7 @@ public:
     void visit(search::query::SubstringTerm &n) override = 0;
     void visit(search::query::SuffixTerm &n) override = 0;
     void visit(search::query::RegExpTerm &n) override = 0;
+    void visit(search::query::NearestNeighborTerm &n) override = 0;
 };
 
 } // namespace search::queryeval
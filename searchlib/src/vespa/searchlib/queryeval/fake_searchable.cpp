@@ -8,6 +8,7 @@
 
 using search::query::NumberTerm;
 using search::query::LocationTerm;
+using search::query::NearestNeighborTerm;
 using search::query::Node;
 using search::query::PredicateQuery;
 using search::query::PrefixTerm;
@@ -63,6 +64,7 @@ public:
     void visit(SuffixTerm &n) override { visitTerm(n); }
     void visit(PredicateQuery &n) override { visitTerm(n); }
     void visit(RegExpTerm &n) override { visitTerm(n); }
+    void visit(NearestNeighborTerm &n) override { visitTerm(n); }
 };
 
 template <class Map>
@@ -184,6 +184,19 @@ HitCollector::getSortedHeapScores()
     return scores;
 }
 
+std::vector<HitCollector::Hit>
+HitCollector::getSortedHeapHits()
+{
+    std::vector<Hit> sortedHits;
+    size_t hitsToReturn = std::min(_hits.size(), static_cast<size_t>(_maxReRankHitsSize));
+    sortedHits.reserve(hitsToReturn);
+    sortHitsByScore(hitsToReturn);
+    for (size_t i = 0; i < hitsToReturn; ++i) {
+        sortedHits.push_back(_hits[_scoreOrder[i]]);
+    }
+    return sortedHits;
+}
+
 size_t
 HitCollector::reRank(DocumentScorer &scorer)
 {
@@ -220,6 +233,32 @@ HitCollector::reRank(DocumentScorer &scorer, size_t count)
     return hitsToReRank;
 }
 
+void
+HitCollector::setReRankedHits(std::vector<Hit> hits)
+{
+    if (_hasReRanked || hits.empty()) {
+        return;
+    }
+    std::sort(hits.begin(), hits.end(), DocIdComparator());
+    Scores &initScores = _ranges.first;
+    Scores &finalScores = _ranges.second;
+    initScores = Scores(std::numeric_limits<feature_t>::max(),
+                        -std::numeric_limits<feature_t>::max());
+    finalScores = initScores;
+    for (const auto &hit : _hits) {
+        if (std::binary_search(hits.begin(), hits.end(), hit, DocIdComparator())) {
+            initScores.low = std::min(initScores.low, hit.second);
+            initScores.high = std::max(initScores.high, hit.second);
+        }
+    }
+    for (const auto &hit : hits) {
+        finalScores.low = std::min(finalScores.low, hit.second);
+        finalScores.high = std::max(finalScores.high, hit.second);
+    }
+    _reRankedHits = std::move(hits);
+    _hasReRanked = true;
+}
+
 std::pair<Scores, Scores>
 HitCollector::getRanges() const
 {
@@ -174,6 +174,12 @@ public:
      */
     std::vector<feature_t> getSortedHeapScores();
 
+    /**
+     * Returns the hits that are stored in the heap sorted on
+     * descending score. These are the candidates for re-ranking.
+     */
+    std::vector<Hit> getSortedHeapHits();
+
     /**
      * Re-ranks the m (=maxHeapSize) best hits by invoking the score()
      * method on the given document scorer. The best m hits are sorted on doc id
@@ -182,6 +188,14 @@ public:
     size_t reRank(DocumentScorer &scorer);
     size_t reRank(DocumentScorer &scorer, size_t count);
 
+    /**
+     * Installs hits that have been re-ranked outside this collector,
+     * e.g. by another match thread. The given hits must be a subset
+     * of the hits returned by getSortedHeapHits(), with the score
+     * replaced by the second phase score.
+     **/
+    void setReRankedHits(std::vector<Hit> hits);
+
     std::pair<Scores, Scores> getRanges() const;
     void setRanges(const std::pair<Scores, Scores> &ranges);
 
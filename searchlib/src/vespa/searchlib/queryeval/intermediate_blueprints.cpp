@@ -136,7 +136,7 @@ AndNotBlueprint::inheritStrict(size_t i) const
 }
 
 SearchIterator::UP
-AndNotBlueprint::createIntermediateSearch(const MultiSearch::Children &subSearches,
+AndNotBlueprint::createIntermediateSearch(MultiSearch::Children subSearches,
                                           bool strict, search::fef::MatchData &md) const
 {
     UnpackInfo unpackInfo(calculateUnpackInfo(md));
@@ -198,7 +198,7 @@ AndBlueprint::get_replacement()
 void
 AndBlueprint::sort(std::vector<Blueprint*> &children) const
 {
-    std::sort(children.begin(), children.end(), LessEstimate());
+    std::sort(children.begin(), children.end(), TieredLessEstimate());
 }
 
 bool
@@ -208,7 +208,7 @@ AndBlueprint::inheritStrict(size_t i) const
 }
 
 SearchIterator::UP
-AndBlueprint::createIntermediateSearch(const MultiSearch::Children &subSearches,
+AndBlueprint::createIntermediateSearch(MultiSearch::Children subSearches,
                                          bool strict, search::fef::MatchData & md) const
 {
     UnpackInfo unpackInfo(calculateUnpackInfo(md));
@@ -221,10 +221,10 @@ AndBlueprint::createIntermediateSearch(const MultiSearch::Children &subSearches,
         if (helper.children.size() == 1) {
             return SearchIterator::UP(helper.children.front());
         } else {
-            search = AndSearch::create(helper.children, strict, helper.termwise_unpack);
+            search = AndSearch::create(std::move(helper.children), strict, helper.termwise_unpack);
         }
     } else {
-        search = AndSearch::create(subSearches, strict, unpackInfo);
+        search = AndSearch::create(std::move(subSearches), strict, unpackInfo);
     }
     search->estimate(getState().estimate().estHits);
     return SearchIterator::UP(search);
@@ -272,6 +272,16 @@ OrBlueprint::get_replacement()
     return Blueprint::UP();
 }
 
+uint32_t
+OrBlueprint::calculate_cost_tier() const
+{
+    uint32_t cost_tier = State::COST_TIER_NORMAL;
+    for (size_t i = 0; i < childCnt(); ++i) {
+        cost_tier = std::max(cost_tier, getChild(i).getState().cost_tier());
+    }
+    return cost_tier;
+}
+
 void
 OrBlueprint::sort(std::vector<Blueprint*> &children) const
 {
@@ -285,7 +295,7 @@ OrBlueprint::inheritStrict(size_t) const
 }
 
 SearchIterator::UP
-OrBlueprint::createIntermediateSearch(const MultiSearch::Children &subSearches,
+OrBlueprint::createIntermediateSearch(MultiSearch::Children subSearches,
                                       bool strict, search::fef::MatchData & md) const
 {
     UnpackInfo unpackInfo(calculateUnpackInfo(md));
@@ -297,9 +307,9 @@ OrBlueprint::createIntermediateSearch(const MultiSearch::Children &subSearches,
         if (helper.children.size() == 1) {
             return SearchIterator::UP(helper.children.front());
         }
-        return SearchIterator::UP(OrSearch::create(helper.children, strict, helper.termwise_unpack));
+        return SearchIterator::UP(OrSearch::create(std::move(helper.children), strict, helper.termwise_unpack));
     }
-    return SearchIterator::UP(OrSearch::create(subSearches, strict, unpackInfo));
+    return SearchIterator::UP(OrSearch::create(std::move(subSearches), strict, unpackInfo));
 }
 
 //-----------------------------------------------------------------------------
@@ -335,7 +345,7 @@ WeakAndBlueprint::inheritStrict(size_t) const
 }
 
 SearchIterator::UP
-WeakAndBlueprint::createIntermediateSearch(const MultiSearch::Children &subSearches,
+WeakAndBlueprint::createIntermediateSearch(MultiSearch::Children subSearches,
                                            bool strict, search::fef::MatchData &) const
 {
     WeakAndSearch::Terms terms;
@@ -376,7 +386,7 @@ NearBlueprint::inheritStrict(size_t i) const
 }
 
 SearchIterator::UP
-NearBlueprint::createIntermediateSearch(const MultiSearch::Children &subSearches,
+NearBlueprint::createIntermediateSearch(MultiSearch::Children subSearches,
                                         bool strict, search::fef::MatchData &md) const
 {
     search::fef::TermFieldMatchDataArray tfmda;
@@ -417,7 +427,7 @@ ONearBlueprint::inheritStrict(size_t i) const
 }
 
 SearchIterator::UP
-ONearBlueprint::createIntermediateSearch(const MultiSearch::Children &subSearches,
+ONearBlueprint::createIntermediateSearch(MultiSearch::Children subSearches,
                                          bool strict, search::fef::MatchData &md) const
 {
     search::fef::TermFieldMatchDataArray tfmda;
@@ -482,7 +492,7 @@ RankBlueprint::inheritStrict(size_t i) const
 }
 
 SearchIterator::UP
-RankBlueprint::createIntermediateSearch(const MultiSearch::Children &subSearches,
+RankBlueprint::createIntermediateSearch(MultiSearch::Children subSearches,
                                         bool strict, search::fef::MatchData & md) const
 {
     UnpackInfo unpackInfo(calculateUnpackInfo(md));
@@ -559,7 +569,7 @@ SourceBlenderBlueprint::findSource(uint32_t sourceId) const
 }
 
 SearchIterator::UP
-SourceBlenderBlueprint::createIntermediateSearch(const MultiSearch::Children &subSearches,
+SourceBlenderBlueprint::createIntermediateSearch(MultiSearch::Children subSearches,
                                                  bool strict, search::fef::MatchData &) const
 {
     SourceBlenderSearch::Children children;
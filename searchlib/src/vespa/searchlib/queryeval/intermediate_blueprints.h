@@ -24,7 +24,7 @@ public:
     void sort(std::vector<Blueprint*> &children) const override;
     bool inheritStrict(size_t i) const override;
     SearchIterator::UP
-    createIntermediateSearch(const MultiSearch::Children &subSearches,
+    createIntermediateSearch(MultiSearch::Children subSearches,
                              bool strict, fef::MatchData &md) const override;
 private:
     bool isPositive(size_t index) const override { return index == 0; }
@@ -43,7 +43,7 @@ public:
     void sort(std::vector<Blueprint*> &children) const override;
     bool inheritStrict(size_t i) const override;
     SearchIterator::UP
-    createIntermediateSearch(const MultiSearch::Children &subSearches,
+    createIntermediateSearch(MultiSearch::Children subSearches,
                              bool strict, fef::MatchData &md) const override;
 };
 
@@ -51,6 +51,9 @@ public:
 
 class OrBlueprint : public IntermediateBlueprint
 {
+protected:
+    // all children must be seeked, so the most expensive child decides
+    uint32_t calculate_cost_tier() const override;
 public:
     bool supports_termwise_children() const override { return true; }
     HitEstimate combine(const std::vector<HitEstimate> &data) const override;
@@ -60,7 +63,7 @@ public:
     void sort(std::vector<Blueprint*> &children) const override;
     bool inheritStrict(size_t i) const override;
     SearchIterator::UP
-    createIntermediateSearch(const MultiSearch::Children &subSearches,
+    createIntermediateSearch(MultiSearch::Children subSearches,
                              bool strict, fef::MatchData &md) const override;
 };
 
@@ -78,7 +81,7 @@ public:
     void sort(std::vector<Blueprint*> &children) const override;
     bool inheritStrict(size_t i) const override;
     SearchIterator::UP
-    createIntermediateSearch(const MultiSearch::Children &subSearches,
+    createIntermediateSearch(MultiSearch::Children subSearches,
                              bool strict, fef::MatchData &md) const override;
 
     WeakAndBlueprint(uint32_t n) : _n(n) {}
@@ -105,7 +108,7 @@ public:
     void sort(std::vector<Blueprint*> &children) const override;
     bool inheritStrict(size_t i) const override;
     SearchIterator::UP
-    createIntermediateSearch(const MultiSearch::Children &subSearches,
+    createIntermediateSearch(MultiSearch::Children subSearches,
                              bool strict, fef::MatchData &md) const override;
 
     NearBlueprint(uint32_t window) : _window(window) {}
@@ -125,7 +128,7 @@ public:
     void sort(std::vector<Blueprint*> &children) const override;
     bool inheritStrict(size_t i) const override;
     SearchIterator::UP
-    createIntermediateSearch(const MultiSearch::Children &subSearches,
+    createIntermediateSearch(MultiSearch::Children subSearches,
                              bool strict, fef::MatchData &md) const override;
 
     ONearBlueprint(uint32_t window) : _window(window) {}
@@ -143,7 +146,7 @@ public:
     void sort(std::vector<Blueprint*> &children) const override;
     bool inheritStrict(size_t i) const override;
     SearchIterator::UP
-    createIntermediateSearch(const MultiSearch::Children &subSearches,
+    createIntermediateSearch(MultiSearch::Children subSearches,
                              bool strict, fef::MatchData &md) const override;
 };
 
@@ -167,7 +170,7 @@ public:
      */
     ssize_t findSource(uint32_t sourceId) const;
     SearchIterator::UP
-    createIntermediateSearch(const MultiSearch::Children &subSearches,
+    createIntermediateSearch(MultiSearch::Children subSearches,
                              bool strict, fef::MatchData &md) const override;
 
     /** check if this blueprint has the same source selector as the other */
@@ -10,12 +10,22 @@
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
 #include <vespa/searchlib/fef/termfieldmatchdataarray.h>
 #include <vespa/vespalib/util/optimized.h>
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
 
 namespace search {
 namespace queryeval {
 
+using vespalib::hwaccelrated::IAccelrated;
+
 namespace {
 
+const IAccelrated &
+accelrator()
+{
+    static IAccelrated::UP accel(IAccelrated::getAccelrator());
+    return *accel;
+}
+
 template<typename Update>
 class MultiBitVectorIterator : public MultiBitVectorIteratorBase
 {
@@ -25,6 +35,7 @@ protected:
     void updateLastValue(uint32_t docId);
     void strictSeek(uint32_t docId);
 private:
+    void fetchChunk(uint32_t index);
     void doSeek(uint32_t docId) override;
     bool isStrict() const override { return false; }
     bool acceptExtraFilter() const override { return Update::isAnd(); }
@@ -41,16 +52,34 @@ private:
     bool isStrict() const override { return true; }
 };
 
+template<typename Update>
+void MultiBitVectorIterator<Update>::fetchChunk(uint32_t index)
+{
+    const uint32_t chunkIndex(index / ChunkWords);
+    _update(accelrator(), chunkIndex * sizeof(_lastWords), _bvs, _lastWords);
+    _lastMaxDocIdLimitRequireFetch = (chunkIndex + 1) * ChunkLen;
+}
+
 template<typename Update>
 void MultiBitVectorIterator<Update>::updateLastValue(uint32_t docId)
 {
     if (docId >= _lastMaxDocIdLimit) {
         if (__builtin_expect(docId < _numDocs, true)) {
             const uint32_t index(wordNum(docId));
-            _lastValue = _bvs[0][index];
-            for(uint32_t i(1); i < _bvs.size(); i++) {
-                _lastValue = _update(_lastValue, _bvs[i][index]);
+            if (docId >= _lastMaxDocIdLimitRequireFetch) {
+                fetchChunk(index);
+                Word any(0);
+                for (size_t i(0); i < ChunkWords; i++) {
+                    any |= _lastWords[i];
+                }
+                if (any == 0) {
+                    // nothing set in this chunk, skip all of it
+                    _lastValue = 0;
+                    _lastMaxDocIdLimit = _lastMaxDocIdLimitRequireFetch;
+                    return;
+                }
             }
+            _lastValue = _lastWords[index % ChunkWords];
             _lastMaxDocIdLimit = (index + 1) * WordLen;
         } else {
             setAtEnd();
@@ -88,17 +117,17 @@ MultiBitVectorIterator<Update>::strictSeek(uint32_t docId)
 }
 
 struct And {
-    typedef BitWord::Word Word;
-    Word operator () (const Word a, const Word b) {
-        return a & b;
+    typedef std::vector<std::pair<const void *, bool>> Sources;
+    void operator () (const IAccelrated & accel, size_t offset, const Sources & src, void *dest) {
+        accel.and64(offset, src, dest);
     }
     static bool isAnd() { return true; }
 };
 
 struct Or {
-    typedef BitWord::Word Word;
-    Word operator () (const Word a, const Word b) {
-        return a | b;
+    typedef std::vector<std::pair<const void *, bool>> Sources;
+    void operator () (const IAccelrated & accel, size_t offset, const Sources & src, void *dest) {
+        accel.or64(offset, src, dest);
     }
     static bool isAnd() { return false; }
 };
@@ -119,9 +148,31 @@ bool hasAtLeast2Bitvectors(const MultiSearch::Children & children)
     return count >= 2;
 }
 
-size_t firstStealable(const MultiSearch & s)
+/**
+ * The positive child of an and-not can be combined with the negative
+ * bitvectors as long as they all cover the same docid range, since the
+ * negatives are then read inverted.
+ **/
+bool canMergeAndNot(const MultiSearch & s)
+{
+    const MultiSearch::Children & children(s.getChildren());
+    if ( ! s.isAndNot() || ! children[0]->isBitVector()) {
+        return false;
+    }
+    uint32_t docIdLimit(static_cast<const BitVectorIterator &>(*children[0]).getDocIdLimit());
+    for (size_t i(1); i < children.size(); i++) {
+        if (children[i]->isBitVector() &&
+            (static_cast<const BitVectorIterator &>(*children[i]).getDocIdLimit() != docIdLimit))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t firstStealable(const MultiSearch & s, bool mergeAndNot)
 {
-    return s.isAndNot() ? 1 : 0;
+    return (s.isAndNot() && ! mergeAndNot) ? 1 : 0;
 }
 
 bool canOptimize(const MultiSearch & s) {
@@ -137,11 +188,13 @@ MultiBitVectorIteratorBase::MultiBitVectorIteratorBase(const Children & children
     _numDocs(std::numeric_limits<unsigned int>::max()),
     _lastValue(0),
     _lastMaxDocIdLimit(0),
-    _bvs(children.size())
+    _lastMaxDocIdLimitRequireFetch(0),
+    _bvs()
 {
+    _bvs.reserve(children.size());
     for (size_t i(0); i < children.size(); i++) {
         const BitVectorIterator * bv = static_cast<const BitVectorIterator *>(children[i]);
-        _bvs[i] = reinterpret_cast<const Word *>(bv->getBitValues());
+        _bvs.emplace_back(bv->getBitValues(), false);
         _numDocs = std::min(_numDocs, bv->getDocIdLimit());
     }
 }
@@ -156,13 +209,22 @@ MultiBitVectorIteratorBase::andWith(UP filter, uint32_t estimate)
     (void) estimate;
     if (filter->isBitVector() && acceptExtraFilter()) {
         const BitVectorIterator & bv = static_cast<const BitVectorIterator &>(*filter);
-        _bvs.push_back(reinterpret_cast<const Word *>(bv.getBitValues()));
+        _bvs.emplace_back(bv.getBitValues(), false);
         insert(getChildren().size(), std::move(filter));
         _lastMaxDocIdLimit = 0;  // force reload
+        _lastMaxDocIdLimitRequireFetch = 0;
     }
     return filter;
 }
 
+void
+MultiBitVectorIteratorBase::initRange(uint32_t beginId, uint32_t endId)
+{
+    MultiSearch::initRange(beginId, endId);
+    _lastMaxDocIdLimit = 0;  // ranges may be searched in any order
+    _lastMaxDocIdLimitRequireFetch = 0;
+}
+
 void
 MultiBitVectorIteratorBase::doUnpack(uint32_t docid)
 {
@@ -196,14 +258,18 @@ MultiBitVectorIteratorBase::optimizeMultiSearch(SearchIterator::UP parentIt)
     if (canOptimize(parent)) {
         MultiSearch::Children stolen;
         std::vector<size_t> _unpackIndex;
+        std::vector<size_t> _invertIndex;
+        const bool mergeAndNot(canMergeAndNot(parent));
         bool strict(false);
         size_t insertPosition(0);
-        for (size_t it(firstStealable(parent)); it != parent.getChildren().size(); ) {
+        for (size_t it(firstStealable(parent, mergeAndNot)); it != parent.getChildren().size(); ) {
             if (parent.getChildren()[it]->isBitVector()) {
                 if (stolen.empty()) {
                     insertPosition = it;
                 }
-                if (parent.needUnpack(it)) {
+                if (mergeAndNot && ! stolen.empty()) {
+                    _invertIndex.push_back(stolen.size());
+                } else if (parent.needUnpack(it)) {
                     _unpackIndex.push_back(stolen.size());
                 }
                 SearchIterator::UP bit = parent.remove(it);
@@ -228,6 +294,12 @@ MultiBitVectorIteratorBase::optimizeMultiSearch(SearchIterator::UP parentIt)
             } else {
                 next.reset(new OrBVIterator(stolen));
             }
+        } else if (mergeAndNot) {
+            if (strict) {
+                next.reset(new AndBVIteratorStrict(stolen));
+            } else {
+                next.reset(new AndBVIterator(stolen));
+            }
         } else if (parent.isAndNot()) {
             if (strict) {
                 next.reset(new OrBVIteratorStrict(stolen));
@@ -239,6 +311,9 @@ MultiBitVectorIteratorBase::optimizeMultiSearch(SearchIterator::UP parentIt)
         for (size_t index : _unpackIndex) {
             nextM.addUnpackIndex(index);
         }
+        for (size_t index : _invertIndex) {
+            nextM.invert(index);
+        }
         if (parent.getChildren().empty()) {
             return next;
         } else {
@@ -23,10 +23,19 @@ public:
 protected:
     MultiBitVectorIteratorBase(const Children & children);
 
+    using Source = std::pair<const void *, bool>;
+    static constexpr size_t ChunkWords = 64 / sizeof(Word);
+    static constexpr size_t ChunkLen = ChunkWords * WordLen;
+
+    void initRange(uint32_t beginId, uint32_t endId) override;
+    void invert(size_t index) { _bvs[index].second = true; }
+
     uint32_t                _numDocs;
     Word                    _lastValue; // Last value computed
     uint32_t                _lastMaxDocIdLimit; // next documentid requiring recomputation.
-    std::vector<const Word  *> _bvs;
+    uint32_t                _lastMaxDocIdLimitRequireFetch; // next documentid requiring a new chunk.
+    std::vector<Source>     _bvs; // bitvectors and whether they are inverted
+    alignas(64) Word        _lastWords[ChunkWords]; // Last chunk computed
 private:
     virtual bool acceptExtraFilter() const = 0;
     UP andWith(UP filter, uint32_t estimate) override;
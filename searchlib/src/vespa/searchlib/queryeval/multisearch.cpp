@@ -37,8 +37,8 @@ MultiSearch::doUnpack(uint32_t docid)
     }
 }
 
-MultiSearch::MultiSearch(const Children & children)
-    : _children(children)
+MultiSearch::MultiSearch(Children children)
+    : _children(std::move(children))
 {
 }
 
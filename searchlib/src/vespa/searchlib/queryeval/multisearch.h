@@ -31,7 +31,7 @@ public:
      * @param children the search objects we are and'ing
      *        this object takes ownership of the children.
      **/
-    MultiSearch(const Children & children);
+    MultiSearch(Children children);
     virtual ~MultiSearch();
     const Children & getChildren() const { return _children; }
     virtual bool isAnd() const { return false; }
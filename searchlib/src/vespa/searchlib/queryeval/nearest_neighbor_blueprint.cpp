@@ -0,0 +1,60 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "nearest_neighbor_blueprint.h"
+#include "nearest_neighbor_iterator.h"
+#include "emptysearch.h"
+#include <vespa/searchlib/fef/termfieldmatchdataarray.h>
+#include <vespa/searchlib/tensor/dense_tensor_attribute.h>
+#include <algorithm>
+
+namespace search {
+namespace queryeval {
+
+NearestNeighborBlueprint::NearestNeighborBlueprint(const FieldSpecBase &field,
+                                                   const tensor::DenseTensorAttribute &attribute,
+                                                   std::vector<double> queryCells,
+                                                   uint32_t targetNumHits,
+                                                   uint32_t exploreAdditionalHits)
+    : ComplexLeafBlueprint(field),
+      _attribute(attribute),
+      _queryCells(std::move(queryCells)),
+      _targetNumHits(targetNumHits),
+      _exploreAdditionalHits(exploreAdditionalHits),
+      _hits()
+{
+    const tensor::HnswIndex *index = _attribute.nearestNeighborIndex();
+    bool empty = (index == nullptr) || (index->getEntryLevel() < 0) || (_targetNumHits == 0);
+    setEstimate(HitEstimate(empty ? 0 : _targetNumHits, empty));
+}
+
+NearestNeighborBlueprint::~NearestNeighborBlueprint()
+{
+}
+
+void
+NearestNeighborBlueprint::fetchPostings(bool strict)
+{
+    (void) strict;
+    const tensor::HnswIndex *index = _attribute.nearestNeighborIndex();
+    if ((index == nullptr) || (_targetNumHits == 0)) {
+        return;
+    }
+    vespalib::ConstArrayRef<double> vector(_queryCells);
+    _hits = index->findTopK(_targetNumHits, vector, _targetNumHits + _exploreAdditionalHits);
+    std::sort(_hits.begin(), _hits.end(),
+              [](const Neighbor &lhs, const Neighbor &rhs) { return (lhs.docId < rhs.docId); });
+}
+
+Blueprint::SearchIteratorUP
+NearestNeighborBlueprint::createLeafSearch(const fef::TermFieldMatchDataArray &tfmda, bool strict) const
+{
+    (void) strict;
+    assert(tfmda.size() == 1);
+    if (_hits.empty()) {
+        return std::make_unique<EmptySearch>();
+    }
+    return std::make_unique<NearestNeighborIterator>(_hits, *tfmda[0]);
+}
+
+}  // namespace search::queryeval
+}  // namespace search
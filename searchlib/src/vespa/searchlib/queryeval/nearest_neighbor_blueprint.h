@@ -0,0 +1,44 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "blueprint.h"
+#include <vespa/searchlib/tensor/hnsw_index.h>
+
+namespace search {
+namespace tensor { class DenseTensorAttribute; }
+namespace queryeval {
+
+/**
+ * Blueprint for a nearest neighbor search over a dense tensor
+ * attribute with an HNSW index. The top k hits are found when
+ * fetching postings, and iterated in docid order by the created
+ * search iterator.
+ */
+class NearestNeighborBlueprint : public ComplexLeafBlueprint
+{
+public:
+    using Neighbor = tensor::HnswIndex::Neighbor;
+
+private:
+    const tensor::DenseTensorAttribute &_attribute;
+    std::vector<double>                 _queryCells;
+    uint32_t                            _targetNumHits;
+    uint32_t                            _exploreAdditionalHits;
+    std::vector<Neighbor>               _hits;
+
+public:
+    NearestNeighborBlueprint(const FieldSpecBase &field,
+                             const tensor::DenseTensorAttribute &attribute,
+                             std::vector<double> queryCells,
+                             uint32_t targetNumHits,
+                             uint32_t exploreAdditionalHits);
+    ~NearestNeighborBlueprint();
+    const std::vector<Neighbor> &getHits() const { return _hits; }
+    void fetchPostings(bool strict) override;
+    SearchIteratorUP createLeafSearch(const fef::TermFieldMatchDataArray &tfmda,
+                                      bool strict) const override;
+};
+
+}  // namespace search::queryeval
+}  // namespace search
@@ -0,0 +1,51 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "nearest_neighbor_iterator.h"
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <cmath>
+
+namespace search {
+namespace queryeval {
+
+NearestNeighborIterator::NearestNeighborIterator(const std::vector<Neighbor> &hits, fef::TermFieldMatchData &tfmd)
+    : SearchIterator(),
+      _hits(hits),
+      _tfmd(tfmd),
+      _index(0)
+{
+}
+
+NearestNeighborIterator::~NearestNeighborIterator()
+{
+}
+
+void
+NearestNeighborIterator::initRange(uint32_t beginId, uint32_t endId)
+{
+    SearchIterator::initRange(beginId, endId);
+    _index = 0;
+}
+
+void
+NearestNeighborIterator::doSeek(uint32_t docId)
+{
+    while ((_index < _hits.size()) && (_hits[_index].docId < docId)) {
+        ++_index;
+    }
+    if ((_index == _hits.size()) || isAtEnd(_hits[_index].docId)) {
+        setAtEnd();
+        return;
+    }
+    setDocId(_hits[_index].docId);
+}
+
+void
+NearestNeighborIterator::doUnpack(uint32_t docId)
+{
+    // hnsw distances are squared euclidean distances
+    double distance = std::sqrt(_hits[_index].distance);
+    _tfmd.setRawScore(docId, 1.0 / (1.0 + distance));
+}
+
+}  // namespace search::queryeval
+}  // namespace search
@@ -0,0 +1,39 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "searchiterator.h"
+#include <vespa/searchlib/tensor/hnsw_index.h>
+
+namespace search {
+namespace fef { class TermFieldMatchData; }
+namespace queryeval {
+
+/**
+ * Search iterator over the hits found by a nearest neighbor search,
+ * given as neighbors sorted by docid. The raw score of a hit is
+ * 1/(1 + distance), where distance is the euclidean distance to the
+ * query vector.
+ */
+class NearestNeighborIterator : public SearchIterator
+{
+public:
+    using Neighbor = tensor::HnswIndex::Neighbor;
+
+private:
+    const std::vector<Neighbor> &_hits;
+    fef::TermFieldMatchData     &_tfmd;
+    uint32_t                     _index;
+
+protected:
+    void doSeek(uint32_t docId) override;
+    void doUnpack(uint32_t docId) override;
+
+public:
+    NearestNeighborIterator(const std::vector<Neighbor> &hits, fef::TermFieldMatchData &tfmd);
+    ~NearestNeighborIterator();
+    void initRange(uint32_t beginId, uint32_t endId) override;
+};
+
+}  // namespace search::queryeval
+}  // namespace search
@@ -13,6 +13,7 @@ namespace queryeval {
 
 namespace {
 
+using search::fef::TermFieldMatchData;
 using search::fef::TermFieldMatchDataArray;
 using search::fef::TermFieldMatchDataPositionKey;
 
@@ -176,14 +177,13 @@ struct Iterators
             if (!(lastAllowed < _maxOcc)) {
                 return true;
             }
-            do {
-                ++front.curPos;
-                if (front.curPos == front.endPos) {
-                    return false;
-                }
-                lastAllowed = *front.curPos;
-                lastAllowed.setPosition(front.curPos->getPosition() + window);
-            } while (lastAllowed < _maxOcc);
+            // skip to the first occurrence with _maxOcc inside its window
+            TermFieldMatchDataPositionKey firstAllowed(_maxOcc.getElementId(),
+                                                       (_maxOcc.getPosition() > window) ? (_maxOcc.getPosition() - window) : 0);
+            front.curPos = TermFieldMatchData::seekPosition(front.curPos + 1, front.endPos, firstAllowed);
+            if (front.curPos == front.endPos) {
+                return false;
+            }
 
             update(*front.curPos);
             _queue.adjust();
@@ -270,9 +270,8 @@ ONearSearch::Matcher::match(uint32_t docId)
             firstTermPos.getPosition(), lastAllowed.getPosition());
         for (uint32_t i = 1; i < numTerms; ++i) {
             LOG(spam, "Forwarding iterator for term %d beyond %d.", i, prevTermPos.getPosition());
-            while (pos[i] != inputs()[i]->end() && !(prevTermPos < *pos[i])) {
-                ++pos[i];
-            }
+            TermFieldMatchDataPositionKey nextTermPos(prevTermPos.getElementId(), prevTermPos.getPosition() + 1);
+            pos[i] = TermFieldMatchData::seekPosition(pos[i], inputs()[i]->end(), nextTermPos);
             if (pos[i] == inputs()[i]->end()) {
                 LOG(debug, "Reached end of occurrences for term %d without matching ONEAR.", i);
                 return false;
@@ -80,30 +80,30 @@ OrSearch::or_hits_into(BitVector &result, uint32_t begin_id)
 }
 
 SearchIterator *
-OrSearch::create(const MultiSearch::Children &children, bool strict) {
+OrSearch::create(MultiSearch::Children children, bool strict) {
     UnpackInfo unpackInfo;
     unpackInfo.forceAll();
-    return create(children, strict, unpackInfo);
+    return create(std::move(children), strict, unpackInfo);
 }
 
 SearchIterator *
-OrSearch::create(const MultiSearch::Children &children, bool strict, const UnpackInfo & unpackInfo) {
+OrSearch::create(MultiSearch::Children children, bool strict, const UnpackInfo & unpackInfo) {
     (void) unpackInfo;
     if (strict) {
         if (unpackInfo.unpackAll()) {
-            return new OrLikeSearch<true, FullUnpack>(children, FullUnpack());
+            return new OrLikeSearch<true, FullUnpack>(std::move(children), FullUnpack());
         } else if(unpackInfo.empty()) {
-            return new OrLikeSearch<true, NoUnpack>(children, NoUnpack());
+            return new OrLikeSearch<true, NoUnpack>(std::move(children), NoUnpack());
         } else {
-            return new OrLikeSearch<true, SelectiveUnpack>(children, SelectiveUnpack(unpackInfo));
+            return new OrLikeSearch<true, SelectiveUnpack>(std::move(children), SelectiveUnpack(unpackInfo));
         }
     } else {
         if (unpackInfo.unpackAll()) {
-            return new OrLikeSearch<false, FullUnpack>(children, FullUnpack());
+            return new OrLikeSearch<false, FullUnpack>(std::move(children), FullUnpack());
         } else if(unpackInfo.empty()) {
-            return new OrLikeSearch<false, NoUnpack>(children, NoUnpack());
+            return new OrLikeSearch<false, NoUnpack>(std::move(children), NoUnpack());
         } else {
-            return new OrLikeSearch<false, SelectiveUnpack>(children, SelectiveUnpack(unpackInfo));
+            return new OrLikeSearch<false, SelectiveUnpack>(std::move(children), SelectiveUnpack(unpackInfo));
         }
     }
 }
@@ -17,15 +17,15 @@ public:
     typedef MultiSearch::Children Children;
 
     // Caller takes ownership of the returned SearchIterator.
-    static SearchIterator *create(const Children &children, bool strict);
-    static SearchIterator *create(const Children &children, bool strict, const UnpackInfo & unpackInfo);
+    static SearchIterator *create(Children children, bool strict);
+    static SearchIterator *create(Children children, bool strict, const UnpackInfo & unpackInfo);
 
     std::unique_ptr<BitVector> get_hits(uint32_t begin_id) override;
     void or_hits_into(BitVector &result, uint32_t begin_id) override;
     void and_hits_into(BitVector &result, uint32_t begin_id) override;
 
 protected:
-    OrSearch(const  Children & children) : MultiSearch(children) { }
+    OrSearch(Children children) : MultiSearch(std::move(children)) { }
 private:
 
     bool isOr() const override { return true; }
@@ -106,7 +106,8 @@ PredicateSearch::PredicateSearch(const uint8_t * minFeatureVector,
       _intervals(_posting_lists.size()),
       _subqueries(_posting_lists.size()),
       _subquery_markers(new uint64_t[max_interval_range+1]),
-      _visited(new bool[max_interval_range+1]),
+      _visited(new uint32_t[max_interval_range+1]()),
+      _generation(0),
       _termFieldMatchData(tfmda.valid()? tfmda[0] : nullptr),
       _min_feature_vector(minFeatureVector),
       _interval_range_vector(interval_range_vector),
@@ -174,27 +175,35 @@ bool isNotInterval(uint32_t begin, uint32_t end) {
     return begin > end;
 }
 
-void markSubquery(uint32_t begin, uint32_t end, uint64_t subquery, uint64_t *subquery_markers, bool * visited) {
-    if (visited[begin]) {
-        visited[end] = true;
-        subquery_markers[end] |= subquery;
+// An interval boundary is visited in the current evaluation if it is
+// stamped with the current generation. Markers of boundaries that are
+// not visited are stale, and are reset on the first visit.
+void markSubquery(uint32_t begin, uint32_t end, uint64_t subquery, uint64_t *subquery_markers,
+                  uint32_t *visited, uint32_t generation) {
+    if (visited[begin] == generation) {
+        if (visited[end] == generation) {
+            subquery_markers[end] |= subquery;
+        } else {
+            visited[end] = generation;
+            subquery_markers[end] = subquery;
+        }
     }
 }
 
 // Returns the semantic interval end - or UINT32_MAX if no interval cover is possible
-uint32_t addInterval(uint32_t interval, uint64_t subquery,
-                     uint64_t *subquery_markers, bool * visited, uint32_t highest_end_seen) {
+uint32_t addInterval(uint32_t interval, uint64_t subquery, uint64_t *subquery_markers,
+                     uint32_t *visited, uint32_t generation, uint32_t highest_end_seen) {
     uint32_t begin = interval >> 16;
     uint32_t end = interval & 0xffff;
 
     if (isNotInterval(begin, end)) {
         // Note: End and begin values are swapped for zStar intervals
         if (highest_end_seen < end) return UINT32_MAX;
-        markSubquery(end, begin, ~(subquery_markers[end]), subquery_markers, visited);
+        markSubquery(end, begin, ~(subquery_markers[end]), subquery_markers, visited, generation);
         return begin;
     } else {
         if (highest_end_seen < begin - 1) return UINT32_MAX;
-        markSubquery(begin - 1, end, subquery_markers[begin - 1] & subquery, subquery_markers, visited);
+        markSubquery(begin - 1, end, subquery_markers[begin - 1] & subquery, subquery_markers, visited, generation);
         return end;
     }
 }
@@ -220,16 +229,20 @@ bool PredicateSearch::evaluateHit(uint32_t doc_id, uint32_t k) {
     size_t candidates = sortIntervals(doc_id, k);
 
     size_t interval_end = _interval_range_vector[doc_id];
-    memset(_subquery_markers, 0, sizeof(uint64_t) * (interval_end + 1));
-    memset(_visited, false, sizeof(bool) * (interval_end + 1));
+    // Start a new generation instead of clearing the markers for the
+    // whole interval range of the document.
+    if (__builtin_expect(++_generation == 0, false)) {
+        memset(_visited, 0, sizeof(uint32_t) * (_max_interval_range + 1));
+        _generation = 1;
+    }
     _subquery_markers[0] = UINT64_MAX;
-    _visited[0] = true;
+    _visited[0] = _generation;
 
     uint32_t highest_end_seen = 1;
     for (size_t i = 0; i < candidates; ) {
         size_t index = _sorted_indexes[i];
         uint32_t last_end_seen = addInterval(
-                _intervals[index], _subqueries[index], _subquery_markers, _visited, highest_end_seen);
+                _intervals[index], _subqueries[index], _subquery_markers, _visited, _generation, highest_end_seen);
         if (last_end_seen == UINT32_MAX) {
             return false;
         }
@@ -241,7 +254,7 @@ bool PredicateSearch::evaluateHit(uint32_t doc_id, uint32_t k) {
             ++i;
         }
     }
-    return _subquery_markers[interval_end] != 0;
+    return (_visited[interval_end] == _generation) && (_subquery_markers[interval_end] != 0);
 }
 
 size_t PredicateSearch::sortIntervals(uint32_t doc_id, uint32_t k) {
@@ -41,7 +41,8 @@ class PredicateSearch : public SearchIterator {
     std::vector<uint32_t> _intervals;
     std::vector<uint64_t> _subqueries;
     uint64_t *_subquery_markers;
-    bool * _visited;
+    uint32_t *_visited;
+    uint32_t _generation;
     fef::TermFieldMatchData *_termFieldMatchData;
     const uint8_t * _min_feature_vector;
     const IntervalRange * _interval_range_vector;
@@ -87,20 +87,6 @@ public:
         }
     }
 
-    bool hasMatch() {
-        if (_tmds.size() == 1) {
-            return true;
-        }
-
-        while (iterator(_eval_order[0]) != end(_eval_order[0])) {
-            if (match()) {
-                return true;
-            }
-            ++iterator(_eval_order[0]);
-        }
-        return false;
-    }
-
     void fillPositions(TermFieldMatchData &tmd) {
         if (_tmds.size() == 1) {
             for (TermFieldMatchData::PositionsIterator
@@ -129,15 +115,54 @@ bool allTermsHaveMatch(const SimplePhraseSearch::Children &terms,
 }
 }  // namespace
 
+/**
+ * Unpack the terms one at a time in evaluation order, keeping only
+ * the phrase start positions that are still possible. Common terms
+ * are evaluated last, so their positions are only decoded when all
+ * the rarer terms line up. All terms are unpacked when there is a
+ * match, which doUnpack depends on.
+ **/
+bool SimplePhraseSearch::phraseMatch(uint32_t doc_id) {
+    const Children &children = getChildren();
+    uint32_t first = _eval_order[0];
+    children[first]->doUnpack(doc_id);
+    if (children.size() == 1) {
+        return true;
+    }
+    const TermFieldMatchData &first_tmd = *_childMatch[first];
+    _candidates.clear();
+    for (It it = first_tmd.begin(); it != first_tmd.end(); ++it) {
+        // positions too early in the element can not start a phrase
+        if (it->getPosition() >= first) {
+            _candidates.emplace_back(it->getElementId(), it->getPosition() - first);
+        }
+    }
+    for (size_t i = 1; !_candidates.empty() && (i < _eval_order.size()); ++i) {
+        uint32_t word_index = _eval_order[i];
+        children[word_index]->doUnpack(doc_id);
+        const TermFieldMatchData &tmd = *_childMatch[word_index];
+        It pos = tmd.begin();
+        It end = tmd.end();
+        size_t num_kept = 0;
+        for (size_t j = 0; (j < _candidates.size()) && (pos != end); ++j) {
+            fef::TermFieldMatchDataPositionKey wanted(_candidates[j].getElementId(),
+                                                      _candidates[j].getPosition() + word_index);
+            pos = TermFieldMatchData::seekPosition(pos, end, wanted);
+            if ((pos != end) && (pos->key() == wanted)) {
+                _candidates[num_kept++] = _candidates[j];
+            }
+        }
+        _candidates.resize(num_kept);
+    }
+    return !_candidates.empty();
+}
+
 void SimplePhraseSearch::phraseSeek(uint32_t doc_id) {
     if (allTermsHaveMatch(getChildren(), _eval_order, doc_id)) {
         if ((_doom != nullptr) && _doom->doom()) {
             setAtEnd();
-        } else {
-            AndSearch::doUnpack(doc_id);
-            if (PhraseMatcher(_childMatch, _eval_order, _iterators).hasMatch()) {
-                setDocId(doc_id);
-            }
+        } else if (phraseMatch(doc_id)) {
+            setDocId(doc_id);
         }
     }
 }
@@ -155,7 +180,8 @@ SimplePhraseSearch::SimplePhraseSearch(const Children &children,
       _tmd(tmd),
       _doom(nullptr),
       _strict(strict),
-      _iterators(children.size())
+      _iterators(children.size()),
+      _candidates()
 {
     assert(!children.empty());
     assert(children.size() == _childMatch.size());
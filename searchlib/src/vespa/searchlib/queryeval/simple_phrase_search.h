@@ -27,9 +27,11 @@ class SimplePhraseSearch : public AndSearch
     bool                         _strict;
 
     typedef fef::TermFieldMatchData::PositionsIterator It;
-    // Reuse this vector instead of allocating a new one when needed.
+    // Reuse these vectors instead of allocating new ones when needed.
     std::vector<It> _iterators;
+    std::vector<fef::TermFieldMatchDataPositionKey> _candidates;
 
+    bool phraseMatch(uint32_t doc_id);
     void phraseSeek(uint32_t doc_id);
 
 public:
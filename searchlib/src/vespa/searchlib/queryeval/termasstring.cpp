@@ -18,6 +18,7 @@ using search::query::Equiv;
 using search::query::NumberTerm;
 using search::query::LocationTerm;
 using search::query::Near;
+using search::query::NearestNeighborTerm;
 using search::query::Node;
 using search::query::ONear;
 using search::query::Or;
@@ -100,6 +101,7 @@ struct TermAsStringVisitor : public QueryVisitor {
     void visit(SuffixTerm &n) override {visitTerm(n); }
     void visit(RegExpTerm &n) override {visitTerm(n); }
     void visit(PredicateQuery &) override {illegalVisit(); }
+    void visit(NearestNeighborTerm &) override {illegalVisit(); }
 };
 }  // namespace
 
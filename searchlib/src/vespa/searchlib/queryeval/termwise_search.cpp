@@ -14,35 +14,65 @@ struct TermwiseSearch : public SearchIterator {
     BitVector::UP      result;
     uint32_t           my_beginid;
     uint32_t           my_first_hit;
+    uint32_t           my_block_size;
+    uint32_t           my_block_beginid;
+    uint32_t           my_block_endid;
 
     bool same_range(uint32_t beginid, uint32_t endid) const {
         return ((beginid == my_beginid) && endid == getEndId());
     }
 
-    TermwiseSearch(SearchIterator::UP search_in)
-        : search(std::move(search_in)), result(), my_beginid(0), my_first_hit(0) {}
+    // Evaluate the underlying search for the docid window starting at
+    // beginid. Only the hits of the current window are kept in memory.
+    // Returns the docid of the underlying search right after initRange.
+    uint32_t load_block(uint32_t beginid) {
+        my_block_beginid = beginid;
+        my_block_endid = ((getEndId() - beginid) > my_block_size)
+                         ? (beginid + my_block_size)
+                         : getEndId();
+        search->initRange(my_block_beginid, my_block_endid);
+        uint32_t child_docid = search->getDocId();
+        result = search->get_hits(my_block_beginid);
+        return child_docid;
+    }
+
+    TermwiseSearch(SearchIterator::UP search_in, uint32_t block_size)
+        : search(std::move(search_in)), result(), my_beginid(0), my_first_hit(0),
+          my_block_size(std::max(block_size, 1u)), my_block_beginid(0), my_block_endid(0) {}
 
     Trinary is_strict() const override { return IS_STRICT ? Trinary::True : Trinary::False; }
     void initRange(uint32_t beginid, uint32_t endid) override {
         if (!same_range(beginid, endid)) {
             my_beginid = beginid;
             SearchIterator::initRange(beginid, endid);
-            search->initRange(beginid, endid);
-            my_first_hit = std::max(getDocId(), search->getDocId());
-            result = search->get_hits(beginid);
+            uint32_t child_docid = load_block(beginid);
+            my_first_hit = (child_docid < my_block_endid)
+                           ? std::max(getDocId(), child_docid)
+                           : getDocId();
+        } else if (my_block_beginid != my_beginid) {
+            load_block(my_beginid);
         }
         setDocId(my_first_hit);
     }
     void doSeek(uint32_t docid) override {
         if (__builtin_expect(isAtEnd(docid), false)) {
             setAtEnd();
-        } else if (IS_STRICT) {
+            return;
+        }
+        if (__builtin_expect(docid >= my_block_endid, false)) {
+            load_block(docid);
+        }
+        if (IS_STRICT) {
             uint32_t nextid = result->getNextTrueBit(docid);
-            if (__builtin_expect(isAtEnd(nextid), false)) {
-                setAtEnd();
-            } else {
-                setDocId(nextid);
+            while (__builtin_expect(nextid >= my_block_endid, false)) {
+                if (isAtEnd(my_block_endid)) {
+                    setAtEnd();
+                    return;
+                }
+                load_block(my_block_endid);
+                nextid = result->getNextTrueBit(my_block_beginid);
             }
+            setDocId(nextid);
         } else if (result->testBit(docid)) {
             setDocId(docid);
         }
@@ -51,16 +81,17 @@ struct TermwiseSearch : public SearchIterator {
     void visitMembers(vespalib::ObjectVisitor &visitor) const override {
         visit(visitor, "search", *search);
         visit(visitor, "strict", IS_STRICT);
+        visit(visitor, "block_size", my_block_size);
     }
 };
 
 SearchIterator::UP
-make_termwise(SearchIterator::UP search, bool strict)
+make_termwise(SearchIterator::UP search, bool strict, uint32_t block_size)
 {
     if (strict) {
-        return SearchIterator::UP(new TermwiseSearch<true>(std::move(search)));
+        return SearchIterator::UP(new TermwiseSearch<true>(std::move(search), block_size));
     } else {
-        return SearchIterator::UP(new TermwiseSearch<false>(std::move(search)));        
+        return SearchIterator::UP(new TermwiseSearch<false>(std::move(search), block_size));
     }
 }
 
@@ -10,8 +10,10 @@ namespace queryeval {
 /**
  * Creates a termwise wrapper for the given search. The wrapper will
  * perform termwise evaluation of the underlying search when the
- * initRange function is called. All hits for the active range are
- * stored in a bitvector fragment in the wrapper. The wrapper will act
+ * initRange function is called. The active range is evaluated in
+ * windows of at most block_size docids; hits for the current window
+ * are stored in a bitvector fragment in the wrapper, and the next
+ * window is evaluated when iteration moves past the end of it. The wrapper will act
  * as a normal iterator to be used for parallel query evaluation. Note
  * that no match data will be available for the hits returned by the
  * wrapper. Termwise evaluation should only ever be used for parts of
@@ -20,8 +22,11 @@ namespace queryeval {
  * @return wrapper performing termwise evaluation of the original search
  * @param search the search we want to perform termwise evaluation of
  * @param strict whether the wrapper itself should be a strict iterator
+ * @param block_size maximum number of docids evaluated at a time
  **/
-SearchIterator::UP make_termwise(SearchIterator::UP search, bool strict);
+constexpr uint32_t termwise_default_block_size = 64 * 1024;
+SearchIterator::UP make_termwise(SearchIterator::UP search, bool strict,
+                                 uint32_t block_size = termwise_default_block_size);
 
 } // namespace queryeval
 } // namespace search
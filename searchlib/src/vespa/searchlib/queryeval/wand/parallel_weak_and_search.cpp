@@ -44,6 +44,11 @@ private:
     void seek_strict(uint32_t docid) {
         _algo.set_candidate(_terms, _heaps, docid);
         while (_algo.solve_wand_constraint(_terms, _heaps, GreaterThan(_boostedThreshold))) {
+            if (VectorizedTerms::has_block_max &&
+                !_algo.check_block_max(_terms, _heaps, DotProductScorer(), GreaterThan(_boostedThreshold)))
+            {
+                continue; // candidate already moved past the block
+            }
             if (_algo.check_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold))) {
                 setDocId(_algo.get_candidate());
                 return;
@@ -244,6 +244,11 @@ public:
 
     ~VectorizedIteratorTerms();
     void unpack(uint16_t ref, uint32_t docid) { iteratorPack().unpack(ref, docid); }
+
+    // generic search iterators expose no block level upper bounds
+    static constexpr bool has_block_max = false;
+    int32_t get_block_max_weight(ref_t) const { return std::numeric_limits<int32_t>::max(); }
+    docid_t get_block_end(ref_t ref) { return docId(ref) + 1; }
     void visit_members(vespalib::ObjectVisitor &visitor) const;
     const Terms &input_terms() const { return _terms; }
 };
@@ -280,6 +285,11 @@ struct VectorizedAttributeTerms : VectorizedState<AttributeIteratorPack> {
         iteratorPack() = AttributeIteratorPack(std::move(iterators));
     }
     void visit_members(vespalib::ObjectVisitor &) const {}
+
+    // posting btree leaves carry their max weight as aggregated value
+    static constexpr bool has_block_max = true;
+    int32_t get_block_max_weight(ref_t ref) { return iteratorPack().get_block_max_weight(ref); }
+    docid_t get_block_end(ref_t ref) { return iteratorPack().get_block_end(ref); }
 };
 
 //-----------------------------------------------------------------------------
@@ -445,6 +455,15 @@ struct DotProductScorer
     static score_t calculateScore(VectorizedTerms &terms, ref_t ref, docid_t docId) {
         return terms.weight(ref) * (score_t)terms.get_weight(ref, docId);
     }
+
+    // upper bound for the term within the block it is currently positioned in
+    template <typename VectorizedTerms>
+    static score_t calculate_block_max_score(VectorizedTerms &terms, ref_t ref) {
+        if (terms.weight(ref) < 0) {
+            return terms.maxScore(ref);
+        }
+        return std::min(terms.maxScore(ref), terms.weight(ref) * (score_t)terms.get_block_max_weight(ref));
+    }
 };
 
 //-----------------------------------------------------------------------------
@@ -616,6 +635,33 @@ public:
         return true;
     }
 
+    /**
+     * Block-max check of the current candidate. Present terms are
+     * bounded by the max score of the block they are positioned in,
+     * while past terms keep their global max score. If the candidate
+     * cannot make it above the threshold, neither can any document
+     * before the end of the first present block or the next future
+     * document, and the candidate is moved there.
+     **/
+    template <typename VectorizedTerms, typename Heaps, typename Scorer, typename AboveThreshold>
+    bool check_block_max(VectorizedTerms &terms, Heaps &heaps, Scorer &&, AboveThreshold &&aboveThreshold) {
+        score_t max_score = (_maxUpperBound - _upperBound);
+        docid_t next_candidate = search::endDocId;
+        ref_t *end = heaps.present_end();
+        for (ref_t *ref = heaps.present_begin(); ref != end; ++ref) {
+            max_score += Scorer::calculate_block_max_score(terms, *ref);
+            next_candidate = std::min(next_candidate, terms.get_block_end(*ref));
+        }
+        if (aboveThreshold(max_score)) {
+            return true;
+        }
+        if (heaps.has_future()) {
+            next_candidate = std::min(next_candidate, terms.docId(heaps.future()));
+        }
+        set_candidate(terms, heaps, next_candidate);
+        return false;
+    }
+
     template <typename VectorizedTerms, typename Heaps, typename Scorer, typename AboveThreshold>
     bool check_score(VectorizedTerms &terms, Heaps &heaps, Scorer &&scorer, AboveThreshold &&aboveThreshold) {
         _partial_score = 0;
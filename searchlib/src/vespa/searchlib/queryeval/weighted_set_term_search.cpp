@@ -2,7 +2,9 @@
 
 #include "weighted_set_term_search.h"
 #include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/btree/btree_key_data.h>
 #include <vespa/vespalib/objects/visit.h>
+#include <algorithm>
 
 #include "iterator_pack.h"
 
@@ -11,6 +13,104 @@ using vespalib::ObjectVisitor;
 
 namespace search::queryeval {
 
+/**
+ * Posting lists that are short enough to be merged eagerly when the
+ * search is created, instead of being iterated through the heap. The
+ * merged postings are kept in an array sorted on docid, holding the
+ * weight of each term, or in a bitvector when the weights are not
+ * needed and the merged postings are dense.
+ */
+class MergedPostings
+{
+private:
+    using Posting = btree::BTreeKeyData<uint32_t, int32_t>;
+
+    std::vector<Posting> _array;
+    const Posting       *_pos;
+    const Posting       *_end;
+    BitVector::UP        _bitVector;
+
+public:
+    // Postings with at most this many entries are merged
+    static constexpr size_t SHORT_POSTING_SIZE = 128;
+
+    MergedPostings() : _array(), _pos(nullptr), _end(nullptr), _bitVector() {}
+
+    bool empty() const { return _array.empty() && !_bitVector; }
+
+    static bool isShort(const DocumentWeightIterator &itr) { return itr.size() <= SHORT_POSTING_SIZE; }
+
+    void add(DocumentWeightIterator itr, int32_t weight) {
+        for (; itr.valid(); ++itr) {
+            _array.emplace_back(itr.getKey(), weight);
+        }
+    }
+
+    void merge(bool needWeights) {
+        std::sort(_array.begin(), _array.end());
+        uint32_t docIdLimit = _array.empty() ? 1u : (_array.back()._key + 1);
+        // A bitvector costs one bit per document, the array 64 bits per posting.
+        if (!needWeights && ((_array.size() * 64) >= docIdLimit)) {
+            _bitVector = BitVector::create(docIdLimit);
+            for (const Posting &posting : _array) {
+                _bitVector->setBit(posting._key);
+            }
+            _bitVector->invalidateCachedCount();
+            std::vector<Posting>().swap(_array);
+        } else {
+            _pos = _array.data();
+            _end = _pos + _array.size();
+        }
+    }
+
+    void initRange(uint32_t begin) {
+        if (!_bitVector) {
+            const Posting *first = _array.data();
+            _pos = std::lower_bound(first, _end, Posting(begin, 0));
+        }
+    }
+
+    uint32_t seek(uint32_t docId) {
+        if (_bitVector) {
+            if (docId >= _bitVector->size()) {
+                return endDocId;
+            }
+            uint32_t nextId = _bitVector->getNextTrueBit(docId);
+            return (nextId < _bitVector->size()) ? nextId : endDocId;
+        }
+        while ((_pos < _end) && (_pos->_key < docId)) {
+            ++_pos;
+        }
+        return (_pos < _end) ? _pos->_key : endDocId;
+    }
+
+    template <typename Func>
+    void foreachWeight(uint32_t docId, Func func) const {
+        for (const Posting *pos = _pos; (pos < _end) && (pos->_key == docId); ++pos) {
+            func(pos->getData());
+        }
+    }
+
+    void or_hits_into(BitVector &result, uint32_t begin_id) const {
+        if (_bitVector) {
+            uint32_t limit = std::min(_bitVector->size(), result.size());
+            for (uint32_t docId = begin_id; docId < limit; ++docId) {
+                docId = _bitVector->getNextTrueBit(docId);
+                if (docId < limit) {
+                    result.setBit(docId);
+                }
+            }
+        } else {
+            for (const Posting *pos = std::lower_bound(_array.data(), _end, Posting(begin_id, 0));
+                 (pos < _end) && (pos->_key < result.size()); ++pos)
+            {
+                result.setBit(pos->_key);
+            }
+        }
+        result.invalidateCachedCount();
+    }
+};
+
 template <typename HEAP, typename IteratorPack>
 class WeightedSetTermSearchImpl : public WeightedSetTermSearch
 {
@@ -43,6 +143,8 @@ private:
     ref_t                                         *_data_stash;
     ref_t                                         *_data_end;
     IteratorPack                                   _children;
+    MergedPostings                                 _merged;
+    std::vector<int32_t>                           _unpackWeights;
 
     void seek_child(ref_t child, uint32_t docId) {
         _termPos[child] = _children.seek(child, docId);
@@ -51,40 +153,50 @@ private:
 public:
     WeightedSetTermSearchImpl(search::fef::TermFieldMatchData &tmd,
                               const std::vector<int32_t> &weights,
-                              IteratorPack &&iteratorPack)
+                              IteratorPack &&iteratorPack,
+                              MergedPostings &&merged)
         : _tmd(tmd),
           _weights(weights),
           _termPos(weights.size()),
-          _cmpDocId(&_termPos[0]),
-          _cmpWeight(&_weights[0]),
+          _cmpDocId(_termPos.data()),
+          _cmpWeight(_weights.data()),
           _data_space(),
           _data_begin(nullptr),
           _data_stash(nullptr),
           _data_end(nullptr),
-          _children(std::move(iteratorPack))
+          _children(std::move(iteratorPack)),
+          _merged(std::move(merged)),
+          _unpackWeights()
     {
         HEAP::require_left_heap();
-        assert(_children.size() > 0);
+        assert((_children.size() > 0) || !_merged.empty());
         assert(_children.size() == _weights.size());
         _data_space.reserve(_children.size());
         for (size_t i = 0; i < _children.size(); ++i) {
             _data_space.push_back(i);
         }
-        _data_begin = &_data_space[0];
+        _data_begin = _data_space.data();
         _data_end = _data_begin + _data_space.size();
         _tmd.reservePositions(_children.size());
     }
 
     void doSeek(uint32_t docId) override {
-        while (_data_stash < _data_end) {
-            seek_child(*_data_stash, docId);
-            HEAP::push(_data_begin, ++_data_stash, _cmpDocId);
+        uint32_t nextId = endDocId;
+        if (_data_begin < _data_end) {
+            while (_data_stash < _data_end) {
+                seek_child(*_data_stash, docId);
+                HEAP::push(_data_begin, ++_data_stash, _cmpDocId);
+            }
+            while (_termPos[HEAP::front(_data_begin, _data_stash)] < docId) {
+                seek_child(HEAP::front(_data_begin, _data_stash), docId);
+                HEAP::adjust(_data_begin, _data_stash, _cmpDocId);
+            }
+            nextId = _termPos[HEAP::front(_data_begin, _data_stash)];
         }
-        while (_termPos[HEAP::front(_data_begin, _data_stash)] < docId) {
-            seek_child(HEAP::front(_data_begin, _data_stash), docId);
-            HEAP::adjust(_data_begin, _data_stash, _cmpDocId);
+        if (!_merged.empty()) {
+            nextId = std::min(nextId, _merged.seek(docId));
         }
-        setDocId(_termPos[HEAP::front(_data_begin, _data_stash)]);
+        setDocId(nextId);
     }
 
     void doUnpack(uint32_t docId) override {
@@ -94,10 +206,24 @@ public:
         {
             HEAP::pop(_data_begin, _data_stash--, _cmpDocId);
         }
-        std::sort(_data_stash, _data_end, _cmpWeight);
+        if (_merged.empty()) {
+            std::sort(_data_stash, _data_end, _cmpWeight);
+            for (ref_t *ptr = _data_stash; ptr < _data_end; ++ptr) {
+                fef::TermFieldMatchDataPosition pos;
+                pos.setElementWeight(_weights[*ptr]);
+                _tmd.appendPosition(pos);
+            }
+            return;
+        }
+        _unpackWeights.clear();
         for (ref_t *ptr = _data_stash; ptr < _data_end; ++ptr) {
+            _unpackWeights.push_back(_weights[*ptr]);
+        }
+        _merged.foreachWeight(docId, [this](int32_t weight) { _unpackWeights.push_back(weight); });
+        std::sort(_unpackWeights.begin(), _unpackWeights.end(), std::greater<int32_t>());
+        for (int32_t weight : _unpackWeights) {
             fef::TermFieldMatchDataPosition pos;
-            pos.setElementWeight(_weights[*ptr]);
+            pos.setElementWeight(weight);
             _tmd.appendPosition(pos);
         }
     }
@@ -112,17 +238,25 @@ public:
         while (_data_stash < _data_end) {
             HEAP::push(_data_begin, ++_data_stash, _cmpDocId);
         }
+        _merged.initRange(begin);
     }
     Trinary is_strict() const override { return Trinary::True; }
 
     void visitMembers(vespalib::ObjectVisitor &) const override { }
 
     BitVector::UP get_hits(uint32_t begin_id) override {
-        return _children.get_hits(begin_id, getEndId());
+        BitVector::UP result = _children.get_hits(begin_id, getEndId());
+        if (!_merged.empty()) {
+            _merged.or_hits_into(*result, begin_id);
+        }
+        return result;
     }
 
     void or_hits_into(BitVector &result, uint32_t begin_id) override {
         _children.or_hits_into(result, begin_id);
+        if (!_merged.empty()) {
+            _merged.or_hits_into(result, begin_id);
+        }
     }
     void and_hits_into(BitVector &result, uint32_t begin_id) override {
         result.andWith(*get_hits(begin_id));
@@ -141,9 +275,9 @@ WeightedSetTermSearch::create(const std::vector<SearchIterator*> &children,
     typedef WeightedSetTermSearchImpl<vespalib::LeftHeap, SearchIteratorPack> HeapImpl;
 
     if (children.size() < 128) {
-        return new ArrayHeapImpl(tmd, weights, SearchIteratorPack(children, std::move(match_data)));
+        return new ArrayHeapImpl(tmd, weights, SearchIteratorPack(children, std::move(match_data)), MergedPostings());
     }
-    return new HeapImpl(tmd, weights, SearchIteratorPack(children, std::move(match_data)));
+    return new HeapImpl(tmd, weights, SearchIteratorPack(children, std::move(match_data)), MergedPostings());
 }
 
 //-----------------------------------------------------------------------------
@@ -156,10 +290,31 @@ WeightedSetTermSearch::create(search::fef::TermFieldMatchData &tmd,
     typedef WeightedSetTermSearchImpl<vespalib::LeftArrayHeap, AttributeIteratorPack> ArrayHeapImpl;
     typedef WeightedSetTermSearchImpl<vespalib::LeftHeap, AttributeIteratorPack> HeapImpl;
 
-    if (iterators.size() < 128) {
-        return SearchIterator::UP(new ArrayHeapImpl(tmd, weights, AttributeIteratorPack(std::move(iterators))));
+    size_t numShort = std::count_if(iterators.begin(), iterators.end(), MergedPostings::isShort);
+    if (numShort < 2) {
+        if (iterators.size() < 128) {
+            return SearchIterator::UP(new ArrayHeapImpl(tmd, weights, AttributeIteratorPack(std::move(iterators)), MergedPostings()));
+        }
+        return SearchIterator::UP(new HeapImpl(tmd, weights, AttributeIteratorPack(std::move(iterators)), MergedPostings()));
+    }
+    MergedPostings merged;
+    std::vector<int32_t> longWeights;
+    std::vector<DocumentWeightIterator> longIterators;
+    longWeights.reserve(iterators.size() - numShort);
+    longIterators.reserve(iterators.size() - numShort);
+    for (size_t i = 0; i < iterators.size(); ++i) {
+        if (MergedPostings::isShort(iterators[i])) {
+            merged.add(iterators[i], weights[i]);
+        } else {
+            longWeights.push_back(weights[i]);
+            longIterators.push_back(iterators[i]);
+        }
+    }
+    merged.merge(!tmd.isNotNeeded());
+    if (longIterators.size() < 128) {
+        return SearchIterator::UP(new ArrayHeapImpl(tmd, longWeights, AttributeIteratorPack(std::move(longIterators)), std::move(merged)));
     }
-    return SearchIterator::UP(new HeapImpl(tmd, weights, AttributeIteratorPack(std::move(iterators))));
+    return SearchIterator::UP(new HeapImpl(tmd, longWeights, AttributeIteratorPack(std::move(longIterators)), std::move(merged)));
 }
 
 //-----------------------------------------------------------------------------
@@ -8,6 +8,7 @@
 #include <vespa/fastlib/io/bufferedfile.h>
 #include <vespa/searchlib/attribute/readerbase.h>
 
+using search::attribute::TensorCellType;
 using vespalib::eval::ValueType;
 using vespalib::tensor::MutableDenseTensorView;
 using vespalib::tensor::Tensor;
@@ -21,6 +22,16 @@ namespace {
 
 constexpr uint32_t DENSE_TENSOR_ATTRIBUTE_VERSION = 1;
 const vespalib::string tensorTypeTag("tensortype");
+const vespalib::string tensorCellTypeTag("tensorcelltype");
+
+TensorCellType
+getTensorCellType(const vespalib::GenericHeader &header)
+{
+    if (header.hasTag(tensorCellTypeTag)) {
+        return TensorCellType(header.getTag(tensorCellTypeTag).asString());
+    }
+    return TensorCellType::DOUBLE;
+}
 
 class TensorReader : public ReaderBase
 {
@@ -28,6 +39,7 @@ private:
     static constexpr uint8_t tensorIsNotPresent = 0;
     static constexpr uint8_t tensorIsPresent = 1;
     vespalib::eval::ValueType _tensorType;
+    TensorCellType _cellType;
     uint32_t _numUnboundDims;
     size_t _numBoundCells;
     std::vector<uint32_t> _unboundDimSizes;
@@ -36,6 +48,7 @@ public:
     ~TensorReader();
     size_t getNumCells();
     const vespalib::eval::ValueType &tensorType() const { return _tensorType; }
+    TensorCellType cellType() const { return _cellType; }
     const std::vector<uint32_t> &getUnboundDimSizes() const { return _unboundDimSizes; }
     void readTensor(void *buf, size_t len) { _datFile->ReadBuf(buf, len); }
 };
@@ -43,6 +56,7 @@ public:
 TensorReader::TensorReader(AttributeVector &attr)
     : ReaderBase(attr),
     _tensorType(vespalib::eval::ValueType::from_spec(getDatHeader().getTag(tensorTypeTag).asString())),
+    _cellType(getTensorCellType(getDatHeader())),
     _numUnboundDims(0),
     _numBoundCells(1),
     _unboundDimSizes()
@@ -86,13 +100,18 @@ TensorReader::getNumCells() {
 DenseTensorAttribute::DenseTensorAttribute(const vespalib::stringref &baseFileName,
                                  const Config &cfg)
     : TensorAttribute(baseFileName, cfg, _denseTensorStore),
-      _denseTensorStore(cfg.tensorType())
+      _denseTensorStore(cfg.tensorType(), cfg.tensorCellType()),
+      _index()
 {
+    if (cfg.hnswIndexParams().enabled()) {
+        _index = std::make_unique<HnswIndex>(*this, cfg.hnswIndexParams(), getGenerationHolder());
+    }
 }
 
 
 DenseTensorAttribute::~DenseTensorAttribute()
 {
+    _index.reset();
     getGenerationHolder().clearHoldLists();
     _tensorStore.clearHoldLists();
 }
@@ -102,7 +121,82 @@ DenseTensorAttribute::setTensor(DocId docId, const Tensor &tensor)
 {
     RefType ref = _denseTensorStore.setTensor(
             (_tensorMapper ? *_tensorMapper->map(tensor) : tensor));
+    if (_index) {
+        _index->removeDocument(docId);
+    }
     setTensorRef(docId, ref);
+    if (_index) {
+        _index->addDocument(docId);
+    }
+}
+
+vespalib::ConstArrayRef<double>
+DenseTensorAttribute::getVector(uint32_t docId, std::vector<double> &decodedCells) const
+{
+    RefType ref;
+    if (docId < _refVector.size()) {
+        ref = _refVector[docId];
+    }
+    return _denseTensorStore.getVector(ref, decodedCells);
+}
+
+uint32_t
+DenseTensorAttribute::clearDoc(DocId docId)
+{
+    if (_index) {
+        _index->removeDocument(docId);
+    }
+    return TensorAttribute::clearDoc(docId);
+}
+
+void
+DenseTensorAttribute::clearDocs(DocId lidLow, DocId lidLimit)
+{
+    if (_index) {
+        for (DocId lid = lidLow; lid < lidLimit; ++lid) {
+            _index->removeDocument(lid);
+        }
+    }
+    TensorAttribute::clearDocs(lidLow, lidLimit);
+}
+
+void
+DenseTensorAttribute::onShrinkLidSpace()
+{
+    TensorAttribute::onShrinkLidSpace();
+    if (_index) {
+        _index->shrinkLidSpace(getCommittedDocIdLimit());
+    }
+}
+
+void
+DenseTensorAttribute::removeOldGenerations(generation_t firstUsed)
+{
+    if (_index) {
+        _index->trimHoldLists(firstUsed);
+    }
+    TensorAttribute::removeOldGenerations(firstUsed);
+}
+
+void
+DenseTensorAttribute::onGenerationChange(generation_t generation)
+{
+    if (_index) {
+        _index->transferHoldLists(generation - 1);
+    }
+    TensorAttribute::onGenerationChange(generation);
+}
+
+void
+DenseTensorAttribute::rebuildIndex()
+{
+    // The graph is not persisted, rebuild it from the loaded vectors.
+    uint32_t docIdLimit = getCommittedDocIdLimit();
+    for (uint32_t lid = 0; lid < docIdLimit; ++lid) {
+        if (_refVector[lid].valid()) {
+            _index->addDocument(lid);
+        }
+    }
 }
 
 
@@ -120,13 +214,13 @@ DenseTensorAttribute::getTensor(DocId docId) const
 }
 
 void
-DenseTensorAttribute::getTensor(DocId docId, MutableDenseTensorView &tensor) const
+DenseTensorAttribute::getTensor(DocId docId, MutableDenseTensorView &tensor, std::vector<double> &decodedCells) const
 {
     RefType ref;
     if (docId < getCommittedDocIdLimit()) {
         ref = _refVector[docId];
     }
-    _denseTensorStore.getTensor(ref, tensor);
+    _denseTensorStore.getTensor(ref, tensor, decodedCells);
 }
 
 bool
@@ -142,6 +236,10 @@ DenseTensorAttribute::onLoad()
            tensorReader.getDatHeader().getTag(tensorTypeTag).asString());
     uint32_t numDocs(tensorReader.getDocIdLimit());
     uint32_t cellSize(_denseTensorStore.getCellSize());
+    TensorCellType fileCellType(tensorReader.cellType());
+    TensorCellType cellType(_denseTensorStore.getCellType());
+    std::vector<char> fileCells;
+    std::vector<double> cells;
     _refVector.reset();
     _refVector.unsafe_reserve(numDocs);
     for (uint32_t lid = 0; lid < numDocs; ++lid) {
@@ -149,8 +247,17 @@ DenseTensorAttribute::onLoad()
         if (numCells != 0u) {
             const auto &unboundDimSizes = tensorReader.getUnboundDimSizes();
             auto raw = _denseTensorStore.allocRawBuffer(numCells, unboundDimSizes);
-            size_t rawLen = numCells * cellSize;
-            tensorReader.readTensor(raw.data, rawLen);
+            if (fileCellType == cellType) {
+                size_t rawLen = numCells * cellSize;
+                tensorReader.readTensor(raw.data, rawLen);
+            } else {
+                // cell type has changed since the attribute was saved
+                fileCells.resize(numCells * fileCellType.cellSize());
+                cells.resize(numCells);
+                tensorReader.readTensor(&fileCells[0], fileCells.size());
+                DenseTensorStore::decodeCells(fileCellType, &fileCells[0], numCells, &cells[0]);
+                DenseTensorStore::encodeCells(cellType, &cells[0], numCells, raw.data);
+            }
             _refVector.push_back(raw.ref);
         } else {
             _refVector.push_back(RefType());
@@ -158,6 +265,9 @@ DenseTensorAttribute::onLoad()
     }
     setNumDocs(numDocs);
     setCommittedDocIdLimit(numDocs);
+    if (_index) {
+        rebuildIndex();
+    }
     return true;
 }
 
@@ -178,6 +288,26 @@ void
 DenseTensorAttribute::compactWorst()
 {
     doCompactWorst<DenseTensorStore::RefType>();
+    if (_index) {
+        _index->compactWorst();
+    }
+}
+
+void
+DenseTensorAttribute::onUpdateStat()
+{
+    MemoryUsage total = _refVector.getMemoryUsage();
+    total.merge(_tensorStore.getMemoryUsage());
+    if (_index) {
+        total.merge(_index->getMemoryUsage());
+    }
+    total.mergeGenerationHeldBytes(getGenerationHolder().getHeldBytes());
+    this->updateStatistics(_refVector.size(),
+                           _refVector.size(),
+                           total.allocatedBytes(),
+                           total.usedBytes(),
+                           total.deadBytes(),
+                           total.allocatedBytesOnHold());
 }
 
 uint32_t
@@ -4,6 +4,8 @@
 
 #include "tensor_attribute.h"
 #include "dense_tensor_store.h"
+#include "doc_vector_access.h"
+#include "hnsw_index.h"
 
 namespace vespalib { namespace tensor { class MutableDenseTensorView; }}
 
@@ -13,11 +15,15 @@ namespace tensor {
 
 /**
  * Attribute vector class used to store dense tensors for all
- * documents in memory.
+ * documents in memory. If enabled in the config, the vectors are also
+ * kept in an HNSW graph for approximate nearest neighbor search.
  */
-class DenseTensorAttribute : public TensorAttribute
+class DenseTensorAttribute : public TensorAttribute, public DocVectorAccess
 {
     DenseTensorStore _denseTensorStore;
+    std::unique_ptr<HnswIndex> _index;
+
+    void rebuildIndex();
 public:
     DenseTensorAttribute(const vespalib::stringref &baseFileName, const Config &cfg);
     virtual ~DenseTensorAttribute();
@@ -26,8 +32,16 @@ public:
     virtual bool onLoad() override;
     virtual std::unique_ptr<AttributeSaver> onInitSave() override;
     virtual void compactWorst() override;
+    virtual void onUpdateStat() override;
     virtual uint32_t getVersion() const override;
-    void getTensor(DocId docId, vespalib::tensor::MutableDenseTensorView &tensor) const;
+    virtual uint32_t clearDoc(DocId docId) override;
+    virtual void clearDocs(DocId lidLow, DocId lidLimit) override;
+    virtual void onShrinkLidSpace() override;
+    virtual void removeOldGenerations(generation_t firstUsed) override;
+    virtual void onGenerationChange(generation_t generation) override;
+    virtual vespalib::ConstArrayRef<double> getVector(uint32_t docId, std::vector<double> &decodedCells) const override;
+    const HnswIndex *nearestNeighborIndex() const { return _index.get(); }
+    void getTensor(DocId docId, vespalib::tensor::MutableDenseTensorView &tensor, std::vector<double> &decodedCells) const;
 };
 
 
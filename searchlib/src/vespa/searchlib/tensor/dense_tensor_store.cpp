@@ -47,14 +47,15 @@ DenseTensorStore::BufferType::getReservedElements(uint32_t bufferId) const
         RefType::align(_unboundDimSizesSize);
 }
 
-DenseTensorStore::DenseTensorStore(const ValueType &type)
+DenseTensorStore::DenseTensorStore(const ValueType &type, CellType cellType)
     : TensorStore(_concreteStore),
       _concreteStore(),
       _bufferType(),
       _type(type),
       _numBoundCells(1u),
       _numUnboundDims(0u),
-      _cellSize(sizeof(double)),
+      _cellType(cellType),
+      _cellSize(cellType.cellSize()),
       _emptyCells()
 {
     for (const auto & dim : _type.dimensions()) {
@@ -157,6 +158,84 @@ DenseTensorStore::move(EntryRef ref)
 
 namespace {
 
+uint16_t floatToBFloat16(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    if ((bits & 0x7fffffffu) > 0x7f800000u) {
+        return ((bits >> 16) | 0x40u); // keep NaN quiet after truncation
+    }
+    bits += 0x7fffu + ((bits >> 16) & 1u); // round to nearest even
+    return (bits >> 16);
+}
+
+float bfloat16ToFloat(uint16_t value) {
+    uint32_t bits = (uint32_t(value) << 16);
+    float result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+}
+
+void
+DenseTensorStore::encodeCells(CellType cellType, const double *src, size_t numCells, void *dst)
+{
+    switch (cellType.type()) {
+    case CellType::FLOAT: {
+        float *floatDst = static_cast<float *>(dst);
+        for (size_t i = 0; i < numCells; ++i) {
+            floatDst[i] = src[i];
+        }
+        break;
+    }
+    case CellType::BFLOAT16: {
+        uint16_t *bfloat16Dst = static_cast<uint16_t *>(dst);
+        for (size_t i = 0; i < numCells; ++i) {
+            bfloat16Dst[i] = floatToBFloat16(src[i]);
+        }
+        break;
+    }
+    default:
+        memcpy(dst, src, numCells * sizeof(double));
+    }
+}
+
+void
+DenseTensorStore::decodeCells(CellType cellType, const void *src, size_t numCells, double *dst)
+{
+    switch (cellType.type()) {
+    case CellType::FLOAT: {
+        const float *floatSrc = static_cast<const float *>(src);
+        for (size_t i = 0; i < numCells; ++i) {
+            dst[i] = floatSrc[i];
+        }
+        break;
+    }
+    case CellType::BFLOAT16: {
+        const uint16_t *bfloat16Src = static_cast<const uint16_t *>(src);
+        for (size_t i = 0; i < numCells; ++i) {
+            dst[i] = bfloat16ToFloat(bfloat16Src[i]);
+        }
+        break;
+    }
+    default:
+        memcpy(dst, src, numCells * sizeof(double));
+    }
+}
+
+vespalib::ConstArrayRef<double>
+DenseTensorStore::getCells(const void *buffer, size_t numCells, std::vector<double> &decodedCells) const
+{
+    if (_cellType == CellType::DOUBLE) {
+        return DenseTensorView::CellsRef(static_cast<const double *>(buffer), numCells);
+    }
+    decodedCells.resize(numCells);
+    decodeCells(_cellType, buffer, numCells, &decodedCells[0]);
+    return DenseTensorView::CellsRef(&decodedCells[0], numCells);
+}
+
+namespace {
+
 void makeConcreteType(MutableDenseTensorView &tensor,
                       const void *buffer,
                       uint32_t numUnboundDims)
@@ -176,6 +255,15 @@ DenseTensorStore::getTensor(EntryRef ref) const
     }
     auto raw = getRawBuffer(ref);
     size_t numCells = getNumCells(raw);
+    if (_cellType != CellType::DOUBLE) {
+        DenseTensorView::Cells cells(numCells);
+        decodeCells(_cellType, raw, numCells, &cells[0]);
+        MutableDenseTensorView view(_type, DenseTensorView::CellsRef(&cells[0], numCells));
+        if (_numUnboundDims > 0) {
+            makeConcreteType(view, raw, _numUnboundDims);
+        }
+        return std::make_unique<DenseTensor>(view.fast_type(), std::move(cells));
+    }
     if (_numUnboundDims == 0) {
         return std::make_unique<DenseTensorView>
                 (_type,
@@ -191,7 +279,7 @@ DenseTensorStore::getTensor(EntryRef ref) const
 }
 
 void
-DenseTensorStore::getTensor(EntryRef ref, MutableDenseTensorView &tensor) const
+DenseTensorStore::getTensor(EntryRef ref, MutableDenseTensorView &tensor, std::vector<double> &decodedCells) const
 {
     if (!ref.valid()) {
         tensor.setCells(DenseTensorView::CellsRef(&_emptyCells[0], _emptyCells.size()));
@@ -201,13 +289,23 @@ DenseTensorStore::getTensor(EntryRef ref, MutableDenseTensorView &tensor) const
     } else {
         auto raw = getRawBuffer(ref);
         size_t numCells = getNumCells(raw);
-        tensor.setCells(DenseTensorView::CellsRef(static_cast<const double *>(raw), numCells));
+        tensor.setCells(getCells(raw, numCells, decodedCells));
         if (_numUnboundDims > 0) {
             makeConcreteType(tensor, raw, _numUnboundDims);
         }
     }
 }
 
+vespalib::ConstArrayRef<double>
+DenseTensorStore::getVector(EntryRef ref, std::vector<double> &decodedCells) const
+{
+    if (!ref.valid()) {
+        return vespalib::ConstArrayRef<double>();
+    }
+    auto raw = getRawBuffer(ref);
+    return getCells(raw, getNumCells(raw), decodedCells);
+}
+
 namespace
 {
 
@@ -263,7 +361,7 @@ DenseTensorStore::setDenseTensor(const TensorType &tensor)
     checkMatchingType(_type, tensor.type(), numCells);
     auto raw = allocRawBuffer(numCells);
     setDenseTensorUnboundDimSizes(raw.data, _type, _numUnboundDims, tensor.type());
-    memcpy(raw.data, &tensor.cellsRef()[0], numCells * _cellSize);
+    encodeCells(_cellType, &tensor.cellsRef()[0], numCells, raw.data);
     return raw.ref;
 }
 
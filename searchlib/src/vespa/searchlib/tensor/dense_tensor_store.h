@@ -4,6 +4,7 @@
 
 #include "tensor_store.h"
 #include <vespa/eval/eval/value_type.h>
+#include <vespa/searchcommon/attribute/tensor_cell_type.h>
 
 namespace vespalib { namespace tensor { class MutableDenseTensorView; }}
 
@@ -24,6 +25,10 @@ namespace tensor {
  * If both start of tensor dimension size information and start of
  * tensor cells were to be 32 byte aligned then tensors of type tensor(x[3])
  * would use 64 bytes.
+ *
+ * Cells can be stored in a more compact format than double (see
+ * TensorCellType). They are then converted when a tensor is set,
+ * and converted back to double when a tensor is read.
  */
 class DenseTensorStore : public TensorStore
 {
@@ -32,6 +37,7 @@ public:
     using RefType = datastore::AlignedEntryRefT<22, 5>;
     using DataStoreType = datastore::DataStoreT<RefType>;
     using ValueType = vespalib::eval::ValueType;
+    using CellType = search::attribute::TensorCellType;
 
     class BufferType : public datastore::BufferType<char>
     {
@@ -53,10 +59,12 @@ private:
     ValueType _type; // type of dense tensor
     size_t _numBoundCells; // product of bound dimension sizes
     uint32_t _numUnboundDims;
+    CellType _cellType;
     uint32_t _cellSize; // size of a cell (e.g. double => 8)
     std::vector<double> _emptyCells;
 
     size_t unboundCells(const void *buffer) const;
+    vespalib::ConstArrayRef<double> getCells(const void *buffer, size_t numCells, std::vector<double> &decodedCells) const;
 
     template <class TensorType>
     TensorStore::EntryRef
@@ -67,20 +75,33 @@ private:
     }
 
 public:
-    DenseTensorStore(const ValueType &type);
+    DenseTensorStore(const ValueType &type, CellType cellType = CellType::DOUBLE);
     virtual ~DenseTensorStore();
 
     const ValueType &type() const { return _type; }
     uint32_t unboundDimSizesSize() const { return _bufferType.unboundDimSizesSize(); }
     size_t getNumCells(const void *buffer) const;
+    CellType getCellType() const { return _cellType; }
     uint32_t getCellSize() const { return _cellSize; }
     const void *getRawBuffer(RefType ref) const;
     datastore::Handle<char> allocRawBuffer(size_t numCells, const std::vector<uint32_t> &unboundDimSizes);
     virtual void holdTensor(EntryRef ref) override;
     virtual EntryRef move(EntryRef ref) override;
     std::unique_ptr<Tensor> getTensor(EntryRef ref) const;
-    void getTensor(EntryRef ref, vespalib::tensor::MutableDenseTensorView &tensor) const;
+    /**
+     * Let the given view refer to the cells of the given tensor. The
+     * decoded cells buffer is used to hold the cells converted to
+     * double when the cell type is not double.
+     */
+    void getTensor(EntryRef ref, vespalib::tensor::MutableDenseTensorView &tensor, std::vector<double> &decodedCells) const;
+    /**
+     * Returns the cells of the given tensor, or an empty array if the
+     * ref is invalid.
+     */
+    vespalib::ConstArrayRef<double> getVector(EntryRef ref, std::vector<double> &decodedCells) const;
     EntryRef setTensor(const Tensor &tensor);
+    static void encodeCells(CellType cellType, const double *src, size_t numCells, void *dst);
+    static void decodeCells(CellType cellType, const void *src, size_t numCells, double *dst);
 };
 
 
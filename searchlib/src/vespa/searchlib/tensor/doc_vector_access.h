@@ -0,0 +1,29 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/arrayref.h>
+#include <vector>
+
+namespace search {
+namespace tensor {
+
+/**
+ * Interface used by a nearest neighbor index to get the vector
+ * (cells of a dense tensor) of a document.
+ */
+class DocVectorAccess
+{
+public:
+    virtual ~DocVectorAccess() {}
+
+    /**
+     * Returns the cells of the vector for the given document, or an
+     * empty array if the document has no vector. The decoded cells
+     * buffer is used if the cells must be converted to double.
+     */
+    virtual vespalib::ConstArrayRef<double> getVector(uint32_t docId, std::vector<double> &decodedCells) const = 0;
+};
+
+}  // namespace search::tensor
+}  // namespace search
@@ -70,6 +70,19 @@ GenericTensorAttribute::getTensor(DocId docId) const
     return _genericTensorStore.getTensor(ref);
 }
 
+SparseTensorView
+GenericTensorAttribute::getSparseTensorView(DocId docId) const
+{
+    RefType ref;
+    if (docId < getCommittedDocIdLimit()) {
+        ref = _refVector[docId];
+    }
+    if (!ref.valid()) {
+        return SparseTensorView();
+    }
+    return _genericTensorStore.getSparseTensorView(ref);
+}
+
 bool
 GenericTensorAttribute::onLoad()
 {
@@ -20,6 +20,12 @@ public:
     virtual ~GenericTensorAttribute();
     virtual void setTensor(DocId docId, const Tensor &tensor) override;
     virtual std::unique_ptr<Tensor> getTensor(DocId docId) const override;
+    /**
+     * Get a lazily decoded view of the tensor for the given document. The
+     * view is invalid if the document has no tensor or the tensor is not
+     * a sparse tensor with a single dimension.
+     */
+    SparseTensorView getSparseTensorView(DocId docId) const;
     virtual bool onLoad() override;
     virtual std::unique_ptr<AttributeSaver> onInitSave() override;
     virtual void compactWorst() override;
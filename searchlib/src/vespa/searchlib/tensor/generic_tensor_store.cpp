@@ -110,6 +110,16 @@ GenericTensorStore::getTensor(EntryRef ref) const
     return std::move(tensor);
 }
 
+SparseTensorView
+GenericTensorStore::getSparseTensorView(EntryRef ref) const
+{
+    auto raw = getRawBuffer(ref);
+    if (raw.second == 0u) {
+        return SparseTensorView();
+    }
+    return SparseTensorView(raw.first, raw.second);
+}
+
 TensorStore::EntryRef
 GenericTensorStore::setTensor(const Tensor &tensor)
 {
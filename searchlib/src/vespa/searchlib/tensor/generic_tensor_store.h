@@ -3,6 +3,7 @@
 #pragma once
 
 #include "tensor_store.h"
+#include "sparse_tensor_view.h"
 
 namespace search {
 
@@ -38,6 +39,8 @@ public:
 
     std::unique_ptr<Tensor> getTensor(EntryRef ref) const;
 
+    SparseTensorView getSparseTensorView(EntryRef ref) const;
+
     EntryRef setTensor(const Tensor &tensor);
 };
 
@@ -0,0 +1,451 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "hnsw_index.h"
+#include <vespa/searchlib/datastore/array_store.hpp>
+#include <vespa/vespalib/stllike/hash_set.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+
+namespace search {
+namespace tensor {
+
+namespace {
+
+// Arrays with up to this many levels per node are allocated in buffers, deeper nodes are very rare.
+constexpr size_t MAX_SMALL_LEVEL_ARRAY_SIZE = 16;
+constexpr size_t MIN_ARRAYS_FOR_NEW_BUFFER = 8 * 1024;
+constexpr double NOT_PRESENT = std::numeric_limits<double>::max();
+
+datastore::ArrayStoreConfig
+makeArrayStoreConfig(size_t maxSmallArraySize)
+{
+    return datastore::ArrayStoreConfig(maxSmallArraySize,
+                                       datastore::ArrayStoreConfig::AllocSpec(0, datastore::EntryRefT<19>::offsetSize(),
+                                                                              MIN_ARRAYS_FOR_NEW_BUFFER));
+}
+
+double
+squaredDistance(vespalib::ConstArrayRef<double> lhs, vespalib::ConstArrayRef<double> rhs)
+{
+    size_t numCells = std::min(lhs.size(), rhs.size());
+    double sum = 0.0;
+    for (size_t i = 0; i < numCells; ++i) {
+        double diff = lhs[i] - rhs[i];
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+struct GreaterDistance {
+    bool operator()(const HnswIndex::Neighbor &lhs, const HnswIndex::Neighbor &rhs) const {
+        return (lhs.distance > rhs.distance);
+    }
+};
+
+struct LesserDistance {
+    bool operator()(const HnswIndex::Neighbor &lhs, const HnswIndex::Neighbor &rhs) const {
+        return (lhs.distance < rhs.distance);
+    }
+};
+
+}
+
+HnswIndex::HnswIndex(const DocVectorAccess &vectors, const Config &cfg, vespalib::GenerationHolder &genHolder)
+    : _vectors(vectors),
+      _cfg(cfg),
+      _nodeRefs(1024, 50, 0, genHolder),
+      _levels(makeArrayStoreConfig(MAX_SMALL_LEVEL_ARRAY_SIZE)),
+      _links(makeArrayStoreConfig(2 * cfg.maxLinksPerNode())),
+      _entryDocId(0),
+      _entryLevel(-1),
+      _levelGenerator(),
+      _writerCells(),
+      _writerOtherCells()
+{
+}
+
+HnswIndex::~HnswIndex()
+{
+}
+
+uint32_t
+HnswIndex::drawLevel()
+{
+    // Levels are exponentially distributed, with 1/maxLinksPerNode of the nodes on each
+    // level also present on the level above.
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    double levelMultiplier = 1.0 / std::log(std::max(2u, _cfg.maxLinksPerNode()));
+    double uniform = distribution(_levelGenerator);
+    return std::floor(-std::log(1.0 - uniform) * levelMultiplier);
+}
+
+HnswIndex::LevelArrayRef
+HnswIndex::getLevels(uint32_t docId) const
+{
+    if (docId >= _nodeRefs.size()) {
+        return LevelArrayRef();
+    }
+    return _levels.get(_nodeRefs[docId]);
+}
+
+HnswIndex::LinkArrayRef
+HnswIndex::getLinks(uint32_t docId, uint32_t level) const
+{
+    LevelArrayRef levels = getLevels(docId);
+    if (level >= levels.size()) {
+        return LinkArrayRef();
+    }
+    return _links.get(levels[level]);
+}
+
+void
+HnswIndex::setLinks(uint32_t docId, uint32_t level, const std::vector<uint32_t> &links)
+{
+    vespalib::ArrayRef<EntryRef> levels = _levels.getWritable(_nodeRefs[docId]);
+    assert(level < levels.size());
+    EntryRef oldRef = levels[level];
+    EntryRef newRef = links.empty() ? EntryRef() : _links.add(LinkArrayRef(&links[0], links.size()));
+    std::atomic_thread_fence(std::memory_order_release);
+    levels[level] = newRef;
+    if (oldRef.valid()) {
+        _links.remove(oldRef);
+    }
+}
+
+void
+HnswIndex::addLink(uint32_t docId, uint32_t level, uint32_t link)
+{
+    LinkArrayRef oldLinks = getLinks(docId, level);
+    std::vector<uint32_t> links(oldLinks.cbegin(), oldLinks.cend());
+    links.push_back(link);
+    setLinks(docId, level, links);
+}
+
+void
+HnswIndex::removeLink(uint32_t docId, uint32_t level, uint32_t link)
+{
+    LinkArrayRef oldLinks = getLinks(docId, level);
+    std::vector<uint32_t> links;
+    links.reserve(oldLinks.size());
+    for (uint32_t oldLink : oldLinks) {
+        if (oldLink != link) {
+            links.push_back(oldLink);
+        }
+    }
+    if (links.size() != oldLinks.size()) {
+        setLinks(docId, level, links);
+    }
+}
+
+double
+HnswIndex::calcDistance(CellsRef lhs, uint32_t docId, std::vector<double> &decodedCells) const
+{
+    CellsRef rhs = _vectors.getVector(docId, decodedCells);
+    if (rhs.size() == 0) {
+        // removed document, possibly still linked from its former neighbors
+        return NOT_PRESENT;
+    }
+    return squaredDistance(lhs, rhs);
+}
+
+HnswIndex::Neighbor
+HnswIndex::findNearestInLevel(CellsRef vector, Neighbor entry, uint32_t level,
+                              std::vector<double> &decodedCells) const
+{
+    Neighbor nearest = entry;
+    bool improved = true;
+    while (improved) {
+        improved = false;
+        LinkArrayRef links = getLinks(nearest.docId, level);
+        for (uint32_t link : links) {
+            double distance = calcDistance(vector, link, decodedCells);
+            if (distance < nearest.distance) {
+                nearest = Neighbor(link, distance);
+                improved = true;
+            }
+        }
+    }
+    return nearest;
+}
+
+HnswIndex::NeighborVector
+HnswIndex::searchLevel(CellsRef vector, const NeighborVector &entries, uint32_t neighborsToFind,
+                       uint32_t level, std::vector<double> &decodedCells) const
+{
+    vespalib::hash_set<uint32_t> visited;
+    std::priority_queue<Neighbor, NeighborVector, GreaterDistance> candidates; // nearest on top
+    std::priority_queue<Neighbor, NeighborVector, LesserDistance> found;       // furthest on top
+    for (const auto &entry : entries) {
+        visited.insert(entry.docId);
+        if (entry.distance != NOT_PRESENT) {
+            candidates.push(entry);
+            found.push(entry);
+        }
+    }
+    while (found.size() > neighborsToFind) {
+        found.pop();
+    }
+    while (!candidates.empty()) {
+        Neighbor candidate = candidates.top();
+        if ((found.size() >= neighborsToFind) && (candidate.distance > found.top().distance)) {
+            break;
+        }
+        candidates.pop();
+        LinkArrayRef links = getLinks(candidate.docId, level);
+        for (uint32_t link : links) {
+            if (!visited.insert(link).second) {
+                continue;
+            }
+            double distance = calcDistance(vector, link, decodedCells);
+            if (distance == NOT_PRESENT) {
+                continue;
+            }
+            if ((found.size() < neighborsToFind) || (distance < found.top().distance)) {
+                candidates.emplace(link, distance);
+                found.emplace(link, distance);
+                if (found.size() > neighborsToFind) {
+                    found.pop();
+                }
+            }
+        }
+    }
+    NeighborVector result;
+    result.reserve(found.size());
+    while (!found.empty()) {
+        result.push_back(found.top());
+        found.pop();
+    }
+    std::reverse(result.begin(), result.end());
+    return result;
+}
+
+std::vector<uint32_t>
+HnswIndex::selectNeighbors(const NeighborVector &candidates, uint32_t maxLinks) const
+{
+    // Candidates are sorted by increasing distance; keep the nearest ones.
+    std::vector<uint32_t> result;
+    for (const auto &candidate : candidates) {
+        if (result.size() >= maxLinks) {
+            break;
+        }
+        result.push_back(candidate.docId);
+    }
+    return result;
+}
+
+void
+HnswIndex::shrinkLinks(uint32_t docId, uint32_t level)
+{
+    std::vector<double> cells;
+    std::vector<double> otherCells;
+    CellsRef vector = _vectors.getVector(docId, cells);
+    LinkArrayRef oldLinks = getLinks(docId, level);
+    NeighborVector candidates;
+    candidates.reserve(oldLinks.size());
+    for (uint32_t link : oldLinks) {
+        candidates.emplace_back(link, calcDistance(vector, link, otherCells));
+    }
+    std::sort(candidates.begin(), candidates.end(), LesserDistance());
+    std::vector<uint32_t> links = selectNeighbors(candidates, maxLinksAtLevel(level));
+    setLinks(docId, level, links);
+    // Links are kept bidirectional, drop the back links of the neighbors not selected.
+    for (size_t i = links.size(); i < candidates.size(); ++i) {
+        removeLink(candidates[i].docId, level, docId);
+    }
+}
+
+void
+HnswIndex::addDocument(uint32_t docId)
+{
+    _nodeRefs.ensure_size(docId + 1, EntryRef());
+    assert(!_nodeRefs[docId].valid());
+    CellsRef vector = _vectors.getVector(docId, _writerCells);
+    if (vector.size() == 0) {
+        return;
+    }
+    uint32_t level = drawLevel();
+    std::vector<EntryRef> emptyLevels(level + 1);
+    EntryRef levelsRef = _levels.add(LevelArrayRef(&emptyLevels[0], emptyLevels.size()));
+    std::atomic_thread_fence(std::memory_order_release);
+    _nodeRefs[docId] = levelsRef;
+    if (_entryLevel < 0) {
+        _entryDocId = docId;
+        _entryLevel = level;
+        return;
+    }
+    Neighbor entry(_entryDocId, calcDistance(vector, _entryDocId, _writerOtherCells));
+    for (int32_t searchLevel = _entryLevel; searchLevel > int32_t(level); --searchLevel) {
+        entry = findNearestInLevel(vector, entry, searchLevel, _writerOtherCells);
+    }
+    NeighborVector entries({entry});
+    for (int32_t linkLevel = std::min(int32_t(level), _entryLevel); linkLevel >= 0; --linkLevel) {
+        NeighborVector candidates = searchLevel(vector, entries, _cfg.neighborsToExploreAtInsert(),
+                                                linkLevel, _writerOtherCells);
+        std::vector<uint32_t> neighbors = selectNeighbors(candidates, maxLinksAtLevel(linkLevel));
+        setLinks(docId, linkLevel, neighbors);
+        for (uint32_t neighbor : neighbors) {
+            addLink(neighbor, linkLevel, docId);
+            if (getLinks(neighbor, linkLevel).size() > maxLinksAtLevel(linkLevel)) {
+                shrinkLinks(neighbor, linkLevel);
+            }
+        }
+        if (!candidates.empty()) {
+            entries = std::move(candidates);
+        }
+    }
+    if (int32_t(level) > _entryLevel) {
+        _entryDocId = docId;
+        _entryLevel = level;
+    }
+}
+
+void
+HnswIndex::chooseNewEntry(uint32_t removedDocId, LevelArrayRef removedLevels)
+{
+    for (uint32_t level = removedLevels.size(); level > 0; --level) {
+        for (uint32_t link : getLinks(removedDocId, level - 1)) {
+            if (hasDocument(link) && (link != removedDocId)) {
+                _entryDocId = link;
+                _entryLevel = getNumLevels(link) - 1;
+                return;
+            }
+        }
+    }
+    // The removed document was not linked to anything, scan for the highest remaining node.
+    _entryDocId = 0;
+    _entryLevel = -1;
+    for (uint32_t docId = 0; docId < _nodeRefs.size(); ++docId) {
+        if ((docId != removedDocId) && hasDocument(docId) && (int32_t(getNumLevels(docId)) - 1 > _entryLevel)) {
+            _entryDocId = docId;
+            _entryLevel = getNumLevels(docId) - 1;
+        }
+    }
+}
+
+void
+HnswIndex::removeDocument(uint32_t docId)
+{
+    if (!hasDocument(docId)) {
+        return;
+    }
+    LevelArrayRef levels = getLevels(docId);
+    if (docId == _entryDocId) {
+        chooseNewEntry(docId, levels);
+    }
+    std::vector<double> cells;
+    std::vector<double> otherCells;
+    for (uint32_t level = 0; level < levels.size(); ++level) {
+        LinkArrayRef links = getLinks(docId, level);
+        std::vector<uint32_t> neighbors(links.cbegin(), links.cend());
+        for (uint32_t neighbor : neighbors) {
+            removeLink(neighbor, level, docId);
+        }
+        // Reconnect the former neighbors with each other where both have free links.
+        for (uint32_t neighbor : neighbors) {
+            CellsRef vector = _vectors.getVector(neighbor, cells);
+            NeighborVector candidates;
+            for (uint32_t other : neighbors) {
+                LinkArrayRef neighborLinks = getLinks(neighbor, level);
+                if ((other != neighbor) &&
+                    (std::find(neighborLinks.cbegin(), neighborLinks.cend(), other) == neighborLinks.cend()))
+                {
+                    candidates.emplace_back(other, calcDistance(vector, other, otherCells));
+                }
+            }
+            std::sort(candidates.begin(), candidates.end(), LesserDistance());
+            for (const auto &candidate : candidates) {
+                if (getLinks(neighbor, level).size() >= maxLinksAtLevel(level)) {
+                    break;
+                }
+                if (getLinks(candidate.docId, level).size() < maxLinksAtLevel(level)) {
+                    addLink(neighbor, level, candidate.docId);
+                    addLink(candidate.docId, level, neighbor);
+                }
+            }
+        }
+        setLinks(docId, level, std::vector<uint32_t>());
+    }
+    EntryRef levelsRef = _nodeRefs[docId];
+    _nodeRefs[docId] = EntryRef();
+    _levels.remove(levelsRef);
+}
+
+HnswIndex::NeighborVector
+HnswIndex::findTopK(uint32_t k, CellsRef vector, uint32_t exploreK) const
+{
+    uint32_t entryDocId = _entryDocId;
+    int32_t entryLevel = _entryLevel;
+    if (entryLevel < 0) {
+        return NeighborVector();
+    }
+    std::vector<double> decodedCells;
+    Neighbor entry(entryDocId, calcDistance(vector, entryDocId, decodedCells));
+    for (int32_t level = entryLevel; level > 0; --level) {
+        entry = findNearestInLevel(vector, entry, level, decodedCells);
+    }
+    NeighborVector result = searchLevel(vector, NeighborVector({entry}), std::max(k, exploreK), 0, decodedCells);
+    if (result.size() > k) {
+        result.resize(k, Neighbor(0, 0.0));
+    }
+    return result;
+}
+
+void
+HnswIndex::shrinkLidSpace(uint32_t docIdLimit)
+{
+    if (_nodeRefs.size() > docIdLimit) {
+        _nodeRefs.shrink(docIdLimit);
+    }
+}
+
+void
+HnswIndex::compactWorst()
+{
+    datastore::ICompactionContext::UP linksContext(_links.compactWorst(true, false));
+    if (linksContext) {
+        for (size_t docId = 0; docId < _nodeRefs.size(); ++docId) {
+            if (_nodeRefs[docId].valid()) {
+                linksContext->compact(_levels.getWritable(_nodeRefs[docId]));
+            }
+        }
+    }
+    datastore::ICompactionContext::UP levelsContext(_levels.compactWorst(true, false));
+    if (levelsContext && (_nodeRefs.size() > 0)) {
+        levelsContext->compact(vespalib::ArrayRef<EntryRef>(&_nodeRefs[0], _nodeRefs.size()));
+    }
+}
+
+void
+HnswIndex::transferHoldLists(generation_t generation)
+{
+    _levels.transferHoldLists(generation);
+    _links.transferHoldLists(generation);
+}
+
+void
+HnswIndex::trimHoldLists(generation_t firstUsed)
+{
+    _levels.trimHoldLists(firstUsed);
+    _links.trimHoldLists(firstUsed);
+}
+
+MemoryUsage
+HnswIndex::getMemoryUsage() const
+{
+    MemoryUsage result = _nodeRefs.getMemoryUsage();
+    result.merge(_levels.getMemoryUsage());
+    result.merge(_links.getMemoryUsage());
+    return result;
+}
+
+}  // namespace search::tensor
+}  // namespace search
+
+namespace search::datastore {
+
+template class ArrayStore<uint32_t>;
+template class ArrayStore<EntryRef>;
+
+}
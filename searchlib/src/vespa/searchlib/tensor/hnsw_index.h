@@ -0,0 +1,127 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "doc_vector_access.h"
+#include <vespa/searchlib/common/rcuvector.h>
+#include <vespa/searchlib/datastore/array_store.h>
+#include <vespa/searchlib/datastore/entryref.h>
+#include <vespa/searchcommon/attribute/hnsw_index_params.h>
+#include <random>
+
+namespace search {
+namespace tensor {
+
+/**
+ * Approximate nearest neighbor index over the vectors of a dense
+ * tensor attribute, implemented as a Hierarchical Navigable Small
+ * World graph (Malkov and Yashunin, https://arxiv.org/abs/1603.09320).
+ *
+ * Each document in the graph has a random top level, and a list of
+ * links (docids of neighbors) for each level from 0 to its top level.
+ * Links are always bidirectional. Link lists are stored in an ArrayStore. A change to a link list
+ * allocates a new array, and the old one is put on hold until no
+ * reader can see it anymore. This lets search threads traverse the
+ * graph while a single writer thread adds and removes documents, as
+ * long as readers hold a generation guard of the owning attribute.
+ *
+ * Distances are squared euclidean distances.
+ */
+class HnswIndex
+{
+public:
+    using Config = search::attribute::HnswIndexParams;
+    using generation_t = vespalib::GenerationHandler::generation_t;
+
+    struct Neighbor {
+        uint32_t docId;
+        double distance;
+        Neighbor(uint32_t docId_in, double distance_in) : docId(docId_in), distance(distance_in) {}
+    };
+
+private:
+    using EntryRef = datastore::EntryRef;
+    using LinkArrayStore = datastore::ArrayStore<uint32_t>;
+    using LevelArrayStore = datastore::ArrayStore<EntryRef>;
+    using NodeRefVector = attribute::RcuVectorBase<EntryRef>;
+    using LinkArrayRef = LinkArrayStore::ConstArrayRef;
+    using LevelArrayRef = LevelArrayStore::ConstArrayRef;
+    using CellsRef = vespalib::ConstArrayRef<double>;
+    using NeighborVector = std::vector<Neighbor>;
+
+    const DocVectorAccess &_vectors;
+    Config                 _cfg;
+    NodeRefVector          _nodeRefs;   // docid -> ref to array with one link array ref per level
+    LevelArrayStore        _levels;
+    LinkArrayStore         _links;
+    uint32_t               _entryDocId;
+    int32_t                _entryLevel; // -1 when the graph is empty
+    std::minstd_rand       _levelGenerator;
+    std::vector<double>    _writerCells;
+    std::vector<double>    _writerOtherCells;
+
+    uint32_t maxLinksAtLevel(uint32_t level) const {
+        return (level == 0) ? (2 * _cfg.maxLinksPerNode()) : _cfg.maxLinksPerNode();
+    }
+    uint32_t drawLevel();
+    LevelArrayRef getLevels(uint32_t docId) const;
+    LinkArrayRef getLinks(uint32_t docId, uint32_t level) const;
+    void setLinks(uint32_t docId, uint32_t level, const std::vector<uint32_t> &links);
+    void addLink(uint32_t docId, uint32_t level, uint32_t link);
+    void removeLink(uint32_t docId, uint32_t level, uint32_t link);
+    double calcDistance(CellsRef lhs, uint32_t docId, std::vector<double> &decodedCells) const;
+    Neighbor findNearestInLevel(CellsRef vector, Neighbor entry, uint32_t level,
+                                std::vector<double> &decodedCells) const;
+    NeighborVector searchLevel(CellsRef vector, const NeighborVector &entries, uint32_t neighborsToFind,
+                               uint32_t level, std::vector<double> &decodedCells) const;
+    std::vector<uint32_t> selectNeighbors(const NeighborVector &candidates, uint32_t maxLinks) const;
+    void shrinkLinks(uint32_t docId, uint32_t level);
+    void chooseNewEntry(uint32_t removedDocId, LevelArrayRef removedLevels);
+
+public:
+    HnswIndex(const DocVectorAccess &vectors, const Config &cfg, vespalib::GenerationHolder &genHolder);
+    ~HnswIndex();
+
+    const Config &getConfig() const { return _cfg; }
+
+    /**
+     * Add the vector of the given document to the graph. The document
+     * must not already be present.
+     */
+    void addDocument(uint32_t docId);
+
+    /**
+     * Remove the given document from the graph, reconnecting its
+     * neighbors with each other where they have free links.
+     */
+    void removeDocument(uint32_t docId);
+
+    /**
+     * Find (approximately) the k nearest neighbors to the given vector,
+     * sorted by increasing distance. At least exploreK candidates are
+     * examined at the bottom level; a larger value gives better recall.
+     */
+    NeighborVector findTopK(uint32_t k, CellsRef vector, uint32_t exploreK) const;
+
+    bool hasDocument(uint32_t docId) const {
+        return (docId < _nodeRefs.size()) && _nodeRefs[docId].valid();
+    }
+    uint32_t getEntryDocId() const { return _entryDocId; }
+    int32_t getEntryLevel() const { return _entryLevel; }
+    uint32_t getNumLevels(uint32_t docId) const { return getLevels(docId).size(); }
+    LinkArrayRef getLinksForTest(uint32_t docId, uint32_t level) const { return getLinks(docId, level); }
+    void shrinkLidSpace(uint32_t docIdLimit);
+
+    /**
+     * Compact the worst buffers of the link and level array stores.
+     * Moved link arrays are updated in place in the level arrays, and
+     * moved level arrays in the docid mapping.
+     */
+    void compactWorst();
+    void transferHoldLists(generation_t generation);
+    void trimHoldLists(generation_t firstUsed);
+    MemoryUsage getMemoryUsage() const;
+};
+
+}  // namespace search::tensor
+}  // namespace search
@@ -0,0 +1,60 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "sparse_tensor_view.h"
+
+namespace search {
+
+namespace tensor {
+
+namespace {
+
+// Format id used by vespalib::tensor::TypedBinaryFormat for sparse tensors.
+constexpr uint32_t SPARSE_BINARY_FORMAT_TYPE = 1u;
+
+bool
+hasInt1_4Bytes(const char *pos, const char *end)
+{
+    return (pos < end) && ((!(*pos & 0x80)) || ((end - pos) >= 4));
+}
+
+}
+
+SparseTensorView::SparseTensorView()
+    : _cells(nullptr),
+      _dimension(),
+      _numCells(0),
+      _valid(false)
+{
+}
+
+SparseTensorView::SparseTensorView(const void *buf, uint32_t len)
+    : SparseTensorView()
+{
+    const char *pos = static_cast<const char *>(buf);
+    const char *end = pos + len;
+    if (!hasInt1_4Bytes(pos, end) || (readInt1_4Bytes(pos) != SPARSE_BINARY_FORMAT_TYPE)) {
+        return;
+    }
+    if (!hasInt1_4Bytes(pos, end) || (readInt1_4Bytes(pos) != 1u)) {
+        return;
+    }
+    if (!hasInt1_4Bytes(pos, end)) {
+        return;
+    }
+    uint32_t nameLen = readInt1_4Bytes(pos);
+    if ((end - pos) < nameLen) {
+        return;
+    }
+    _dimension = vespalib::stringref(pos, nameLen);
+    pos += nameLen;
+    if (!hasInt1_4Bytes(pos, end)) {
+        return;
+    }
+    _numCells = readInt1_4Bytes(pos);
+    _cells = pos;
+    _valid = true;
+}
+
+}  // namespace search::tensor
+
+}  // namespace search
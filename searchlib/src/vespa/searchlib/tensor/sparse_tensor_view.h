@@ -0,0 +1,92 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <cstdint>
+#include <cstring>
+
+namespace search {
+
+namespace tensor {
+
+/**
+ * View of a serialized sparse tensor with a single mapped dimension, as
+ * stored by GenericTensorStore. Cells are decoded lazily while being
+ * visited, so labels and values can be probed without materializing a
+ * tensor object.
+ *
+ * The view is only valid if the serialized tensor uses the sparse binary
+ * format and has exactly one dimension, otherwise valid() returns false
+ * and the tensor must be deserialized the normal way.
+ */
+class SparseTensorView
+{
+    const char *_cells;
+    vespalib::stringref _dimension;
+    uint32_t _numCells;
+    bool _valid;
+
+    static uint32_t readInt1_4Bytes(const char *&pos);
+    static vespalib::stringref readSmallString(const char *&pos);
+    static double readDouble(const char *&pos);
+public:
+    SparseTensorView();
+    SparseTensorView(const void *buf, uint32_t len);
+
+    bool valid() const { return _valid; }
+    vespalib::stringref dimension() const { return _dimension; }
+    uint32_t numCells() const { return _numCells; }
+
+    /**
+     * Call func(label, value) for each cell, in storage order.
+     */
+    template <typename Func>
+    void forEachCell(Func &&func) const {
+        const char *pos = _cells;
+        for (uint32_t i = 0; i < _numCells; ++i) {
+            vespalib::stringref label = readSmallString(pos);
+            func(label, readDouble(pos));
+        }
+    }
+};
+
+inline uint32_t
+SparseTensorView::readInt1_4Bytes(const char *&pos)
+{
+    const uint8_t *p = reinterpret_cast<const uint8_t *>(pos);
+    if (!(p[0] & 0x80)) {
+        pos += 1;
+        return p[0];
+    }
+    pos += 4;
+    return ((uint32_t(p[0] & 0x7f) << 24) | (uint32_t(p[1]) << 16) |
+            (uint32_t(p[2]) << 8) | uint32_t(p[3]));
+}
+
+inline vespalib::stringref
+SparseTensorView::readSmallString(const char *&pos)
+{
+    uint32_t len = readInt1_4Bytes(pos);
+    vespalib::stringref result(pos, len);
+    pos += len;
+    return result;
+}
+
+inline double
+SparseTensorView::readDouble(const char *&pos)
+{
+    const uint8_t *p = reinterpret_cast<const uint8_t *>(pos);
+    uint64_t bits = 0;
+    for (int i = 0; i < 8; ++i) {
+        bits = (bits << 8) | p[i];
+    }
+    pos += 8;
+    double result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+}  // namespace search::tensor
+
+}  // namespace search
@@ -17,14 +17,18 @@ using vespalib::makeClosure;
 using vespalib::Monitor;
 using vespalib::MonitorGuard;
 using search::common::FileHeaderContext;
+using vespalib::compression::CompressionConfig;
 using std::runtime_error;
 
 namespace search::transactionlog {
 
 Domain::Domain(const string &domainName, const string & baseDir, Executor & commitExecutor,
                Executor & sessionExecutor, uint64_t domainPartSize, DomainPart::Crc defaultCrcType,
+               const CompressionConfig &compression, bool visitUsingMmap,
                const FileHeaderContext &fileHeaderContext) :
     _defaultCrcType(defaultCrcType),
+    _compression(compression),
+    _visitUsingMmap(visitUsingMmap),
     _commitExecutor(commitExecutor),
     _sessionExecutor(sessionExecutor),
     _sessionId(1),
@@ -57,12 +61,12 @@ Domain::Domain(const string &domainName, const string & baseDir, Executor & comm
     }
     _sessionExecutor.sync();
     if (_parts.empty() || _parts.crbegin()->second->isClosed()) {
-        _parts[lastPart].reset(new DomainPart(_name, dir(), lastPart, _defaultCrcType, _fileHeaderContext, false));
+        _parts[lastPart].reset(new DomainPart(_name, dir(), lastPart, _defaultCrcType, _compression, _fileHeaderContext, false));
     }
 }
 
 void Domain::addPart(int64_t partId, bool isLastPart) {
-    DomainPart::SP dp(new DomainPart(_name, dir(), partId, _defaultCrcType, _fileHeaderContext, isLastPart));
+    DomainPart::SP dp(new DomainPart(_name, dir(), partId, _defaultCrcType, _compression, _fileHeaderContext, isLastPart));
     if (dp->size() == 0) {
         // Only last domain part is allowed to be truncated down to
         // empty size.
@@ -107,9 +111,12 @@ Domain::getDomainInfo() const
 {
     LockGuard guard(_lock);
     DomainInfo info(SerialNumRange(begin(guard), end(guard)), size(guard), byteSize(guard), _maxSessionRunTime);
+    info.uncompressedByteSize = 0;
     for (const auto &entry: _parts) {
         const DomainPart &part = *entry.second;
         info.parts.emplace_back(PartInfo(part.range(), part.size(), part.byteSize(), part.fileName()));
+        info.parts.back().uncompressedByteSize = part.uncompressedByteSize();
+        info.uncompressedByteSize += part.uncompressedByteSize();
     }
     return info;
 }
@@ -286,7 +293,7 @@ void Domain::commit(const Packet & packet)
         triggerSyncNow();
         waitPendingSync(_syncMonitor, _pendingSync);
         dp->close();
-        dp.reset(new DomainPart(_name, dir(), entry.serial(), _defaultCrcType, _fileHeaderContext, false));
+        dp.reset(new DomainPart(_name, dir(), entry.serial(), _defaultCrcType, _compression, _fileHeaderContext, false));
         {
             LockGuard guard(_lock);
             _parts[entry.serial()] = dp;
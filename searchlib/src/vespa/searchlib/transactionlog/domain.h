@@ -12,12 +12,13 @@ struct PartInfo {
     SerialNumRange range;
     size_t numEntries;
     size_t byteSize;
+    size_t uncompressedByteSize;
     vespalib::string file;
     PartInfo(SerialNumRange range_in, size_t numEntries_in,
              size_t byteSize_in,
              vespalib::stringref file_in)
         : range(range_in), numEntries(numEntries_in), byteSize(byteSize_in),
-          file(file_in) {}
+          uncompressedByteSize(byteSize_in), file(file_in) {}
 };
 
 struct DomainInfo {
@@ -25,12 +26,14 @@ struct DomainInfo {
     SerialNumRange range;
     size_t numEntries;
     size_t byteSize;
+    size_t uncompressedByteSize;
     DurationSeconds maxSessionRunTime;
     std::vector<PartInfo> parts;
     DomainInfo(SerialNumRange range_in, size_t numEntries_in, size_t byteSize_in, DurationSeconds maxSessionRunTime_in)
-        : range(range_in), numEntries(numEntries_in), byteSize(byteSize_in), maxSessionRunTime(maxSessionRunTime_in), parts() {}
+        : range(range_in), numEntries(numEntries_in), byteSize(byteSize_in), uncompressedByteSize(byteSize_in),
+          maxSessionRunTime(maxSessionRunTime_in), parts() {}
     DomainInfo()
-        : range(), numEntries(0), byteSize(0), maxSessionRunTime(), parts() {}
+        : range(), numEntries(0), byteSize(0), uncompressedByteSize(0), maxSessionRunTime(), parts() {}
 };
 
 typedef std::map<vespalib::string, DomainInfo> DomainStats;
@@ -42,6 +45,7 @@ public:
     using Executor = vespalib::ThreadExecutor;
     Domain(const vespalib::string &name, const vespalib::string &baseDir, Executor & commitExecutor,
            Executor & sessionExecutor, uint64_t domainPartSize, DomainPart::Crc defaultCrcType,
+           const vespalib::compression::CompressionConfig &compression, bool visitUsingMmap,
            const common::FileHeaderContext &fileHeaderContext);
 
     virtual ~Domain();
@@ -62,6 +66,8 @@ public:
 
     size_t byteSize() const;
     size_t getNumSessions() const { return _sessions.size(); }
+    // Visiting of closed parts reads directly from a sequentially advised memory mapping of the file.
+    bool visitUsingMmap() const { return _visitUsingMmap; }
 
     int startSession(int sessionId);
     int closeSession(int sessionId);
@@ -96,6 +102,8 @@ private:
     using DurationSeconds = std::chrono::duration<double>;
 
     DomainPart::Crc     _defaultCrcType;
+    const vespalib::compression::CompressionConfig _compression;
+    const bool          _visitUsingMmap;
     Executor          & _commitExecutor;
     Executor          & _sessionExecutor;
     std::atomic<int>    _sessionId;
@@ -5,6 +5,8 @@
 #include <vespa/vespalib/xxhash/xxhash.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/data/fileheader.h>
+#include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/util/compressor.h>
 #include <vespa/searchlib/common/fileheadercontext.h>
 #include <vespa/fastlib/io/bufferedfile.h>
 
@@ -20,6 +22,9 @@ using vespalib::LockGuard;
 using vespalib::nbostream;
 using vespalib::nbostream_longlivedbuf;
 using vespalib::alloc::Alloc;
+using vespalib::compression::CompressionConfig;
+using vespalib::ConstBufferRef;
+using vespalib::DataBuffer;
 using search::common::FileHeaderContext;
 using std::runtime_error;
 
@@ -27,6 +32,24 @@ namespace search::transactionlog {
 
 namespace {
 
+const vespalib::string COMPRESSION_TAG("entryCompression");
+
+// Compressed entry data is prefixed with the compression type and the uncompressed size.
+constexpr size_t COMPRESSED_ENTRY_HEADER_SIZE = sizeof(uint8_t) + sizeof(uint32_t);
+
+const char *
+compressionName(CompressionConfig::Type type)
+{
+    switch (type) {
+    case CompressionConfig::LZ4:
+        return "lz4";
+    case CompressionConfig::ZSTD:
+        return "zstd";
+    default:
+        abort();
+    }
+}
+
 void
 handleSync(FastOS_FileInterface &file) __attribute__ ((noinline));
 
@@ -34,7 +57,7 @@ string
 handleWriteError(const char *text,
                  FastOS_FileInterface &file,
                  int64_t lastKnownGoodPos,
-                 const Packet::Entry &entry,
+                 SerialNum serial,
                  int bufLen) __attribute__ ((noinline));
 
 bool
@@ -75,13 +98,13 @@ string
 handleWriteError(const char *text,
                  FastOS_FileInterface &file,
                  int64_t lastKnownGoodPos,
-                 const Packet::Entry &entry,
+                 SerialNum serial,
                  int bufLen)
 {
     string last(FastOS_File::getLastErrorString());
     string e(make_string("%s. File '%s' at position %" PRId64 " for entry %" PRIu64 " of length %u. "
                          "OS says '%s'. Rewind to last known good position %" PRId64 ".",
-                         text, file.GetFileName(), file.GetPosition(), entry.serial(), bufLen,
+                         text, file.GetFileName(), file.GetPosition(), serial, bufLen,
                          last.c_str(), lastKnownGoodPos));
     LOG(error, "%s",  e.c_str());
     if ( ! file.SetPosition(lastKnownGoodPos) ) {
@@ -193,6 +216,15 @@ DomainPart::buildPacketMapping(bool allowTruncate)
         _headerLen = header.readFile(transLog);
         transLog.SetPosition(_headerLen);
         currPos = _headerLen;
+        _compression.type = CompressionConfig::NONE;
+        if (header.hasTag(COMPRESSION_TAG)) {
+            const string &name = header.getTag(COMPRESSION_TAG).asString();
+            _compression.type = CompressionConfig::toType(name.c_str());
+            if ( ! _compression.useCompression()) {
+                throw runtime_error(make_string("Unknown entry compression '%s' in file %s",
+                                                name.c_str(), transLog.GetFileName()));
+            }
+        }
     } catch (const IllegalHeaderException &e) {
         transLog.SetPosition(0);
         try {
@@ -215,10 +247,15 @@ DomainPart::buildPacketMapping(bool allowTruncate)
         int64_t firstPos(currPos);
         bool full(false);
         Alloc buf;
+        DataBuffer decompressed;
         for(size_t i(0); !full && (currPos < fSize); i++) {
             Packet::Entry e;
             if (read(transLog, e, buf, allowTruncate)) {
                 if (e.valid()) {
+                    size_t storedSize(e.data().size());
+                    if (_compression.useCompression()) {
+                        e = decompressEntry(e, decompressed);
+                    }
                     if (i == 0) {
                         firstSerial = e.serial();
                         if (currPos == _headerLen) {
@@ -231,6 +268,9 @@ DomainPart::buildPacketMapping(bool allowTruncate)
                             lastSerial = e.serial();
                             currPos = transLog.GetPosition();
                             _sz++;
+                            if (storedSize < e.data().size()) {
+                                _compressionSavedBytes += e.data().size() - storedSize;
+                            }
                         } else {
                             transLog.SetPosition(currPos);
                         }
@@ -266,8 +306,11 @@ DomainPart::buildPacketMapping(bool allowTruncate)
 }
 
 DomainPart::DomainPart(const string & name, const string & baseDir, SerialNum s, Crc defaultCrc,
+                       const CompressionConfig &compression,
                        const FileHeaderContext &fileHeaderContext, bool allowTruncate) :
     _defaultCrc(defaultCrc),
+    _compression(compression),
+    _compressionSavedBytes(0),
     _lock(),
     _fileLock(),
     _range(s),
@@ -332,6 +375,9 @@ DomainPart::writeHeader(const FileHeaderContext &fileHeaderContext)
     assert(_transLog->GetPosition() == 0);
     fileHeaderContext.addTags(header, _transLog->GetFileName());
     header.putTag(Tag("desc", "Transaction log domain part file"));
+    if (_compression.useCompression()) {
+        header.putTag(Tag(COMPRESSION_TAG, compressionName(_compression.type)));
+    }
     _headerLen = header.writeFile(*_transLog);
 }
 
@@ -407,21 +453,32 @@ DomainPart::commit(SerialNum firstSerial, const Packet &packet)
     if (_range.from() == 0) {
         _range.from(firstSerial);
     }
-    for (size_t i(0); h.size() > 0; i++) {
-        //LOG(spam,
-        //"Pos(%d) Len(%d), Lim(%d), Remaining(%d)",
-        //h.getPos(), h.getLength(), h.getLimit(), h.getRemaining());
+    nbostream os;
+    DataBuffer compressed;
+    SerialNum lastSerial(_range.to());
+    size_t numEntries(0);
+    while (h.size() > 0) {
         Packet::Entry entry;
         entry.deserialize(h);
-        if (_range.to() < entry.serial()) {
-            write(*_transLog, entry);
-            _sz++;
-            _range.to(entry.serial());
+        if (lastSerial < entry.serial()) {
+            if (_compression.useCompression()) {
+                serialize(os, compressEntry(entry, compressed));
+            } else {
+                serialize(os, entry);
+            }
+            lastSerial = entry.serial();
+            numEntries++;
         } else {
             throw runtime_error(make_string("Incomming serial number(%ld) must be bigger than the last one (%ld).",
-                                            entry.serial(), _range.to()));
+                                            entry.serial(), lastSerial));
         }
     }
+    if (numEntries > 0) {
+        // All entries of the packet go to the file in a single write
+        write(*_transLog, firstSerial, lastSerial, os);
+        _sz += numEntries;
+        _range.to(lastSerial);
+    }
 
     bool merged(false);
     LockGuard guard(_lock);
@@ -542,15 +599,19 @@ DomainPart::visit(FastOS_FileInterface &file, SerialNumRange &r, Packet &packet)
     if (retval) {
         Packet newPacket;
         Alloc buf;
+        DataBuffer decompressed;
         for (bool full(false);!full && retval && (r.from() < r.to());) {
             Packet::Entry e;
             int64_t fPos = file.GetPosition();
-            retval = read(file, e, buf, false);
+            retval = file.IsMemoryMapped() ? readMapped(file, e) : read(file, e, buf, false);
             if (retval &&
                 e.valid() &&
                 (r.from() < e.serial()) &&
                 (e.serial() <= r.to())) {
                 try {
+                    if (_compression.useCompression()) {
+                        e = decompressEntry(e, decompressed);
+                    }
                     full = addPacket(newPacket, e);
                 } catch (const std::exception & ex) {
                     throw runtime_error(make_string("%s : Failed creating packet for visit %s(%" PRIu64 ") at pos(%" PRIu64 ", %" PRIu64 ")",
@@ -573,13 +634,52 @@ DomainPart::visit(FastOS_FileInterface &file, SerialNumRange &r, Packet &packet)
     return retval;
 }
 
+bool
+DomainPart::readMapped(FastOS_FileInterface &file, Packet::Entry &entry)
+{
+    constexpr size_t headerLen(sizeof(uint8_t) + sizeof(uint32_t));
+    int64_t pos(file.GetPosition());
+    const char *header = static_cast<const char *>(file.MemoryMapPtr(pos));
+    if (header == nullptr) {
+        return false; // Eof
+    }
+    if (file.MemoryMapPtr(pos + headerLen - 1) == nullptr) {
+        throw runtime_error(make_string("Short read of packet length at pos %" PRId64 ". %s", pos, getError(file).c_str()));
+    }
+    nbostream_longlivedbuf his(header, headerLen);
+    uint8_t version(-1);
+    uint32_t len(0);
+    his >> version >> len;
+    if ((version != ccitt_crc32) && (version != xxh64)) {
+        throw runtime_error(make_string("Version mismatch. Expected 'ccitt_crc32=1' or 'xxh64=2', got %d from '%s' at position %" PRId64,
+                                        version, file.GetFileName(), pos));
+    }
+    if ((len < sizeof(int32_t)) || (file.MemoryMapPtr(pos + headerLen + len - 1) == nullptr)) {
+        throw runtime_error(make_string("Short read of packet blob of %u bytes at pos %" PRId64 ". %s", len, pos, getError(file).c_str()));
+    }
+    const char *blob = header + headerLen;
+    nbostream_longlivedbuf is(blob, len);
+    entry.deserialize(is);
+    int32_t crc(0);
+    is >> crc;
+    int32_t crcVerify(calcCrc(static_cast<Crc>(version), blob, len - sizeof(crc)));
+    if (crc != crcVerify) {
+        throw runtime_error(make_string("Got bad crc for packet from '%s' (len pos=%" PRId64 ", len=%d) : crcVerify = %d, expected %d",
+                                        file.GetFileName(), pos + int64_t(sizeof(uint8_t)),
+                                        static_cast<int>(len), static_cast<int>(crcVerify), static_cast<int>(crc)));
+    }
+    if ( ! file.SetPosition(pos + headerLen + len)) {
+        throw runtime_error(make_string("Failed setting position %" PRId64 ". %s", pos + int64_t(headerLen + len), getError(file).c_str()));
+    }
+    return true;
+}
+
 void
-DomainPart::write(FastOS_FileInterface &file, const Packet::Entry &entry)
+DomainPart::serialize(nbostream &os, const Packet::Entry &entry) const
 {
-    int64_t lastKnownGoodPos(file.GetPosition());
     int32_t crc(0);
     uint32_t len(entry.serializedSize() + sizeof(crc));
-    nbostream os;
+    size_t entryStart(os.size());
     os << static_cast<uint8_t>(_defaultCrc);
     os << len;
     size_t start(os.size());
@@ -587,14 +687,53 @@ DomainPart::write(FastOS_FileInterface &file, const Packet::Entry &entry)
     size_t end(os.size());
     crc = calcCrc(_defaultCrc, os.c_str()+start, end - start);
     os << crc;
+    assert(os.size() - entryStart == len + sizeof(len) + sizeof(uint8_t));
+    (void) entryStart;
+}
+
+Packet::Entry
+DomainPart::compressEntry(const Packet::Entry &entry, DataBuffer &buf)
+{
+    buf.clear();
+    buf.writeInt8(CompressionConfig::NONE);
+    buf.writeInt32(entry.data().size());
+    CompressionConfig::Type type = vespalib::compression::compress(_compression, entry.data(), buf, false);
+    buf.getData()[0] = type;
+    if (buf.getDataLen() < entry.data().size()) {
+        _compressionSavedBytes.fetch_add(entry.data().size() - buf.getDataLen(), std::memory_order_relaxed);
+    }
+    return Packet::Entry(entry.serial(), entry.type(), ConstBufferRef(buf.getData(), buf.getDataLen()));
+}
+
+Packet::Entry
+DomainPart::decompressEntry(const Packet::Entry &entry, DataBuffer &buf) const
+{
+    const ConstBufferRef &data = entry.data();
+    if (data.size() < COMPRESSED_ENTRY_HEADER_SIZE) {
+        throw runtime_error(make_string("Compressed entry %" PRIu64 " in file %s is too short (%zu bytes)",
+                                        entry.serial(), _fileName.c_str(), data.size()));
+    }
+    nbostream_longlivedbuf is(data.c_str(), COMPRESSED_ENTRY_HEADER_SIZE);
+    uint8_t type(0);
+    uint32_t uncompressedSize(0);
+    is >> type >> uncompressedSize;
+    buf.clear();
+    ConstBufferRef payload(data.c_str() + COMPRESSED_ENTRY_HEADER_SIZE, data.size() - COMPRESSED_ENTRY_HEADER_SIZE);
+    vespalib::compression::decompress(CompressionConfig::toType(type), uncompressedSize, payload, buf, false);
+    return Packet::Entry(entry.serial(), entry.type(), ConstBufferRef(buf.getData(), buf.getDataLen()));
+}
+
+void
+DomainPart::write(FastOS_FileInterface &file, SerialNum firstSerial, SerialNum lastSerial, const nbostream &os)
+{
+    int64_t lastKnownGoodPos(file.GetPosition());
     size_t osSize = os.size();
-    assert(osSize == len + sizeof(len) + sizeof(uint8_t));
 
     LockGuard guard(_writeLock);
     if ( ! file.CheckedWrite(os.c_str(), osSize) ) {
-        throw runtime_error(handleWriteError("Failed writing the entry.", file, lastKnownGoodPos, entry, end - start));
+        throw runtime_error(handleWriteError("Failed writing the entries.", file, lastKnownGoodPos, firstSerial, osSize));
     }
-    _writtenSerial = entry.serial();
+    _writtenSerial = lastSerial;
     _byteSize.store(lastKnownGoodPos + osSize, std::memory_order_release);
 }
 
@@ -4,11 +4,13 @@
 #include "common.h"
 #include <vespa/vespalib/util/sync.h>
 #include <vespa/vespalib/util/memory.h>
+#include <vespa/vespalib/util/compressionconfig.h>
 #include <map>
 #include <vector>
 #include <atomic>
 
 class FastOS_FileInterface;
+namespace vespalib { class DataBuffer; }
 
 namespace search::common { class FileHeaderContext; }
 namespace search::transactionlog {
@@ -24,7 +26,12 @@ public:
         xxh64=2
     };
     typedef std::shared_ptr<DomainPart> SP;
+    /**
+     * New files compress the data of each entry as given by compression.
+     * Existing files keep the compression recorded in their file header.
+     */
     DomainPart(const vespalib::string &name, const vespalib::string &baseDir, SerialNum s, Crc defaultCrc,
+               const vespalib::compression::CompressionConfig &compression,
                const common::FileHeaderContext &FileHeaderContext, bool allowTruncate);
 
     ~DomainPart();
@@ -47,14 +54,24 @@ public:
     size_t      byteSize() const {
         return _byteSize.load(std::memory_order_acquire);
     }
+    // Size the entries would have had on disk without compression.
+    size_t uncompressedByteSize() const {
+        return byteSize() + _compressionSavedBytes.load(std::memory_order_relaxed);
+    }
+    vespalib::compression::CompressionConfig::Type getCompressionType() const { return _compression.type; }
     bool        isClosed() const;
 private:
     bool openAndFind(FastOS_FileInterface &file, const SerialNum &from);
     int64_t buildPacketMapping(bool allowTruncate);
 
     static bool read(FastOS_FileInterface &file, Packet::Entry &entry, vespalib::alloc::Alloc &buf, bool allowTruncate);
+    // Reads the next entry directly from the memory mapping of file. The entry data refers into the mapping.
+    static bool readMapped(FastOS_FileInterface &file, Packet::Entry &entry);
 
-    void write(FastOS_FileInterface &file, const Packet::Entry &entry);
+    void serialize(vespalib::nbostream &os, const Packet::Entry &entry) const;
+    Packet::Entry compressEntry(const Packet::Entry &entry, vespalib::DataBuffer &buf);
+    Packet::Entry decompressEntry(const Packet::Entry &entry, vespalib::DataBuffer &buf) const;
+    void write(FastOS_FileInterface &file, SerialNum firstSerial, SerialNum lastSerial, const vespalib::nbostream &os);
     static int32_t calcCrc(Crc crc, const void * buf, size_t len);
     void writeHeader(const common::FileHeaderContext &fileHeaderContext);
 
@@ -78,6 +95,8 @@ private:
     typedef std::vector<SkipInfo> SkipList;
     typedef std::map<SerialNum, Packet> PacketList;
     const Crc      _defaultCrc;
+    vespalib::compression::CompressionConfig _compression;
+    std::atomic<uint64_t> _compressionSavedBytes;
     vespalib::Lock _lock;
     vespalib::Lock _fileLock;
     SerialNumRange _range;
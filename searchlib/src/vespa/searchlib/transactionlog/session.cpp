@@ -4,6 +4,7 @@
 #include <vespa/fnet/frt/supervisor.h>
 #include <vespa/fastlib/io/bufferedfile.h>
 #include <vespa/vespalib/util/closuretask.h>
+#include <fcntl.h>
 #include <vespa/log/log.h>
 
 LOG_SETUP(".transactionlog.session");
@@ -14,6 +15,21 @@ namespace search::transactionlog {
 
 namespace {
     const double NEVER(-1.0);
+
+std::unique_ptr<FastOS_FileInterface>
+createVisitFile(bool useMmap)
+{
+    if (useMmap) {
+        auto file = std::make_unique<FastOS_File>();
+        file->setFAdviseOptions(POSIX_FADV_SEQUENTIAL);
+        file->enableMemoryMap(0);
+        return file;
+    }
+    auto file = std::make_unique<Fast_BufferedFile>();
+    file->EnableDirectIO();
+    return file;
+}
+
 }
 
 vespalib::Executor::Task::UP
@@ -63,10 +79,9 @@ Session::visit()
         // Must use findPart and iterate until no candidate parts found.
         DomainPart * dp(dpSafe.get());
         LOG(debug, "[%d] : Visiting the interval %" PRIu64 " - %" PRIu64 " in domain part [%" PRIu64 ", %" PRIu64 "]", _id, _range.from(), _range.to(), dp->range().from(), dp->range().to());
-        Fast_BufferedFile file;
-        file.EnableDirectIO();
+        std::unique_ptr<FastOS_FileInterface> file = createVisitFile(_domain->visitUsingMmap());
         for(bool more(true); ok() && more && (_range.from() < _range.to()); ) {
-            more = visit(file, *dp);
+            more = visit(*file, *dp);
         }
         // Nothing more in this DomainPart, force switch to next one.
         if (_range.from() < dp->range().to()) {
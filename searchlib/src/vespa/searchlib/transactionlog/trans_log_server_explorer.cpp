@@ -22,6 +22,7 @@ struct DomainExplorer : vespalib::StateExplorer {
         state.setLong("to", info.range.to());
         state.setLong("numEntries", info.numEntries);
         state.setLong("byteSize", info.byteSize);
+        state.setLong("uncompressedByteSize", info.uncompressedByteSize);
         if (full) {
             Cursor &array = state.setArray("parts");
             for (const PartInfo &part_in: info.parts) {
@@ -30,6 +31,7 @@ struct DomainExplorer : vespalib::StateExplorer {
                 part.setLong("to", part_in.range.to());
                 part.setLong("numEntries", part_in.numEntries);
                 part.setLong("byteSize", part_in.byteSize);
+                part.setLong("uncompressedByteSize", part_in.uncompressedByteSize);
                 part.setString("file", part_in.file);
                 {
                     FastOS_StatInfo stat_info;
@@ -13,6 +13,7 @@ using vespalib::make_string;
 using vespalib::stringref;
 using vespalib::IllegalArgumentException;
 using search::common::FileHeaderContext;
+using vespalib::compression::CompressionConfig;
 
 namespace search::transactionlog {
 
@@ -87,12 +88,15 @@ TransLogServer::TransLogServer(const vespalib::string &name, int listenPort, con
 
 TransLogServer::TransLogServer(const vespalib::string &name, int listenPort, const vespalib::string &baseDir,
                                const FileHeaderContext &fileHeaderContext, uint64_t domainPartSize,
-                               size_t maxThreads, DomainPart::Crc defaultCrcType)
+                               size_t maxThreads, DomainPart::Crc defaultCrcType,
+                               const CompressionConfig &compression, bool visitUsingMmap)
     : FRT_Invokable(),
       _name(name),
       _baseDir(baseDir),
       _domainPartSize(domainPartSize),
       _defaultCrcType(defaultCrcType),
+      _compression(compression),
+      _visitUsingMmap(visitUsingMmap),
       _commitExecutor(maxThreads, 128*1024),
       _sessionExecutor(maxThreads, 128*1024),
       _threadPool(8192, 1),
@@ -111,7 +115,8 @@ TransLogServer::TransLogServer(const vespalib::string &name, int listenPort, con
                 if ( ! domainName.empty()) {
                     try {
                         auto domain = std::make_shared<Domain>(domainName, dir(), _commitExecutor, _sessionExecutor,
-                                                               _domainPartSize, _defaultCrcType,_fileHeaderContext);
+                                                               _domainPartSize, _defaultCrcType, _compression,
+                                                               _visitUsingMmap, _fileHeaderContext);
                         _domains[domain->name()] = domain;
                     } catch (const std::exception & e) {
                         LOG(warning, "Failed creating %s domain on startup. Exception = %s", domainName.c_str(), e.what());
@@ -346,7 +351,8 @@ void TransLogServer::createDomain(FRT_RPCRequest *req)
     if ( !domain ) {
         try {
             domain = std::make_shared<Domain>(domainName, dir(), _commitExecutor, _sessionExecutor,
-                                              _domainPartSize, _defaultCrcType, _fileHeaderContext);
+                                              _domainPartSize, _defaultCrcType, _compression,
+                                              _visitUsingMmap, _fileHeaderContext);
             {
                 Guard domainGuard(_lock);
                 _domains[domain->name()] = domain;
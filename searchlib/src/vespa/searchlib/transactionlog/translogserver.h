@@ -23,7 +23,9 @@ public:
 
     TransLogServer(const vespalib::string &name, int listenPort, const vespalib::string &baseDir,
                    const common::FileHeaderContext &fileHeaderContext,
-                   uint64_t domainPartSize, size_t maxThreads, DomainPart::Crc defaultCrc);
+                   uint64_t domainPartSize, size_t maxThreads, DomainPart::Crc defaultCrc,
+                   const vespalib::compression::CompressionConfig &compression = vespalib::compression::CompressionConfig(),
+                   bool visitUsingMmap = false);
     TransLogServer(const vespalib::string &name, int listenPort, const vespalib::string &baseDir,
                    const common::FileHeaderContext &fileHeaderContext, uint64_t domainPartSize);
     TransLogServer(const vespalib::string &name, int listenPort, const vespalib::string &baseDir,
@@ -82,6 +84,8 @@ private:
     vespalib::string                    _baseDir;
     const uint64_t                      _domainPartSize;
     const DomainPart::Crc               _defaultCrcType;
+    const vespalib::compression::CompressionConfig _compression;
+    const bool                          _visitUsingMmap;
     vespalib::ThreadStackExecutor       _commitExecutor;
     vespalib::ThreadStackExecutor       _sessionExecutor;
     FastOS_ThreadPool                   _threadPool;
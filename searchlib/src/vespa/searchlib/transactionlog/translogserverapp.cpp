@@ -7,6 +7,7 @@
 LOG_SETUP(".translogserverapp");
 
 using search::common::FileHeaderContext;
+using vespalib::compression::CompressionConfig;
 
 namespace search::transactionlog {
 
@@ -34,13 +35,28 @@ DomainPart::Crc getCrc(searchlib::TranslogserverConfig::Crcmethod crcType)
     abort();
 }
 
+CompressionConfig::Type getCompression(searchlib::TranslogserverConfig::Compression::Type type)
+{
+    switch (type) {
+        case searchlib::TranslogserverConfig::Compression::NONE:
+            return CompressionConfig::NONE;
+        case searchlib::TranslogserverConfig::Compression::LZ4:
+            return CompressionConfig::LZ4;
+        case searchlib::TranslogserverConfig::Compression::ZSTD:
+            return CompressionConfig::ZSTD;
+    }
+    abort();
+}
+
 }
 
 void TransLogServerApp::start()
 {
     std::shared_ptr<searchlib::TranslogserverConfig> c = _tlsConfig.get();
     _tls.reset(new TransLogServer(c->servername, c->listenport, c->basedir, _fileHeaderContext,
-                                  c->filesizemax, c->maxthreads, getCrc(c->crcmethod)));
+                                  c->filesizemax, c->maxthreads, getCrc(c->crcmethod),
+                                  CompressionConfig(getCompression(c->compression.type), c->compression.level, 100),
+                                  c->visit.usemmap));
 }
 
 TransLogServerApp::~TransLogServerApp()
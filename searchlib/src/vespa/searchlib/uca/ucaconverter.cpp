@@ -15,17 +15,88 @@ using vespalib::make_string;
 
 namespace {
 std::mutex _GlobalDirtyICUThreadSafeLock;
+
+constexpr size_t MAX_SORT_KEY_CACHES = 64;
+constexpr size_t MAX_SORT_KEY_CACHE_ENTRIES = 0x10000;
+
+std::mutex _sortKeyCachesLock;
+vespalib::hash_map<vespalib::string, UcaSortKeyCache::SP> _sortKeyCaches;
+
+}
+
+UcaSortKeyCache::UcaSortKeyCache(size_t maxEntries)
+    : _lock(),
+      _map(),
+      _maxEntries(maxEntries)
+{ }
+
+UcaSortKeyCache::~UcaSortKeyCache() { }
+
+bool
+UcaSortKeyCache::lookup(vespalib::stringref src, vespalib::string & sortKey) const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    auto found = _map.find(src);
+    if (found == _map.end()) {
+        return false;
+    }
+    sortKey = found->second;
+    return true;
+}
+
+void
+UcaSortKeyCache::insert(vespalib::stringref src, vespalib::stringref sortKey)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    if (_map.size() < _maxEntries) {
+        _map[src] = sortKey;
+    }
+}
+
+size_t
+UcaSortKeyCache::size() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _map.size();
+}
+
+UcaSortKeyCache::SP
+UcaSortKeyCache::get(vespalib::stringref locale, vespalib::stringref strength)
+{
+    vespalib::string key(locale);
+    key += '\0';
+    key += strength;
+    std::lock_guard<std::mutex> guard(_sortKeyCachesLock);
+    auto found = _sortKeyCaches.find(key);
+    if (found != _sortKeyCaches.end()) {
+        return found->second;
+    }
+    if (_sortKeyCaches.size() >= MAX_SORT_KEY_CACHES) {
+        return SP();
+    }
+    SP cache = std::make_shared<UcaSortKeyCache>(MAX_SORT_KEY_CACHE_ENTRIES);
+    _sortKeyCaches[key] = cache;
+    return cache;
 }
 
 BlobConverter::UP
 UcaConverterFactory::create(stringref local, stringref strength) const {
+    if (_cacheSortKeys) {
+        return std::make_unique<UcaConverter>(local, strength, UcaSortKeyCache::get(local, strength));
+    }
     return std::make_unique<UcaConverter>(local, strength);
 }
 
-UcaConverter::UcaConverter(vespalib::stringref locale, vespalib::stringref strength) :
+UcaConverter::UcaConverter(vespalib::stringref locale, vespalib::stringref strength)
+    : UcaConverter(locale, strength, UcaSortKeyCache::SP())
+{ }
+
+UcaConverter::UcaConverter(vespalib::stringref locale, vespalib::stringref strength, UcaSortKeyCache::SP sortKeyCache) :
     _buffer(),
     _u16Buffer(128),
-    _collator()
+    _cachedKey(),
+    _collator(),
+    _sortKeyCache(std::move(sortKeyCache))
 {
     UErrorCode status = U_ZERO_ERROR;
     Collator *coll(NULL);
@@ -74,7 +145,7 @@ int UcaConverter::utf8ToUtf16(const ConstBufferRef & src) const
     return u16Wanted;
 }
 
-ConstBufferRef UcaConverter::onConvert(const ConstBufferRef & src) const
+ConstBufferRef UcaConverter::computeSortKey(const ConstBufferRef & src) const
 {
     int32_t u16Wanted(utf8ToUtf16(src));
     if (u16Wanted > (int)_u16Buffer.size()) {
@@ -91,5 +162,19 @@ ConstBufferRef UcaConverter::onConvert(const ConstBufferRef & src) const
     return ConstBufferRef(_buffer.ptr(), wanted);
 }
 
+ConstBufferRef UcaConverter::onConvert(const ConstBufferRef & src) const
+{
+    if ( ! _sortKeyCache) {
+        return computeSortKey(src);
+    }
+    vespalib::stringref key(src.c_str(), src.size());
+    if (_sortKeyCache->lookup(key, _cachedKey)) {
+        return ConstBufferRef(_cachedKey.data(), _cachedKey.size());
+    }
+    ConstBufferRef sortKey = computeSortKey(src);
+    _sortKeyCache->insert(key, vespalib::stringref(sortKey.c_str(), sortKey.size()));
+    return sortKey;
+}
+
 }
 }
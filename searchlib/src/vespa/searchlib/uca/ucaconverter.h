@@ -5,8 +5,10 @@
 #include <vespa/searchlib/common/converters.h>
 #include <vespa/searchcommon/common/iblobconverter.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/stllike/hash_map.h>
 #include <unicode/coll.h>
 #include <vector>
+#include <mutex>
 #include <cassert>
 
 namespace search {
@@ -16,9 +18,38 @@ using common::ConverterFactory;
 
 namespace uca {
 
+/**
+ * Process-wide cache of collation sort keys for a given (locale, strength),
+ * so that strings sorted over and over again across queries only go through
+ * ICU once. The cache stops accepting new entries when full.
+ */
+class UcaSortKeyCache {
+public:
+    using SP = std::shared_ptr<UcaSortKeyCache>;
+    UcaSortKeyCache(size_t maxEntries);
+    ~UcaSortKeyCache();
+    bool lookup(vespalib::stringref src, vespalib::string & sortKey) const;
+    void insert(vespalib::stringref src, vespalib::stringref sortKey);
+    size_t size() const;
+    /**
+     * Returns the shared cache for the given locale and strength, or an empty
+     * pointer if the maximum number of caches has been reached.
+     */
+    static SP get(vespalib::stringref locale, vespalib::stringref strength);
+private:
+    using Map = vespalib::hash_map<vespalib::string, vespalib::string>;
+    mutable std::mutex _lock;
+    Map                _map;
+    const size_t       _maxEntries;
+};
+
 class UcaConverterFactory : public ConverterFactory {
 public:
+    UcaConverterFactory() : UcaConverterFactory(false) { }
+    explicit UcaConverterFactory(bool cacheSortKeys) : _cacheSortKeys(cacheSortKeys) { }
     BlobConverter::UP create(stringref local, stringref strength) const override;
+private:
+    bool _cacheSortKeys;
 };
 
 class UcaConverter : public BlobConverter
@@ -26,6 +57,7 @@ class UcaConverter : public BlobConverter
 public:
     using Collator = icu::Collator;
     UcaConverter(vespalib::stringref locale, vespalib::stringref strength);
+    UcaConverter(vespalib::stringref locale, vespalib::stringref strength, UcaSortKeyCache::SP sortKeyCache);
     ~UcaConverter();
     const Collator & getCollator() const { return *_collator; }
 private:
@@ -55,10 +87,13 @@ private:
         }
     };
     int utf8ToUtf16(const ConstBufferRef & src) const;
+    ConstBufferRef computeSortKey(const ConstBufferRef & src) const;
     ConstBufferRef onConvert(const ConstBufferRef & src) const override;
     mutable Buffer               _buffer;
     mutable std::vector<UChar>   _u16Buffer;
+    mutable vespalib::string     _cachedKey;
     std::unique_ptr<Collator>      _collator;
+    UcaSortKeyCache::SP          _sortKeyCache;
 };
 
 }
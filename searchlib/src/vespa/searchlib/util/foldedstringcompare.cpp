@@ -3,11 +3,47 @@
 #include "foldedstringcompare.h"
 #include <vespa/vespalib/text/utf8.h>
 #include <vespa/vespalib/text/lowercase.h>
+#include <limits>
 
 using vespalib::LowerCase;
 
 namespace search {
 
+namespace {
+
+/*
+ * Most dictionary keys and query terms are plain ASCII, where folding
+ * is a table lookup per byte. Compare byte by byte while both keys are
+ * ASCII, and let the caller continue with full utf8 decoding from the
+ * returned positions if a non-ASCII character is met. Returns true if
+ * the comparison was decided, with the result in 'res'.
+ */
+bool
+compareFoldedAscii(const char *&key, const char *&okey, size_t &remaining, int &res)
+{
+    for (; remaining > 0; --remaining, ++key, ++okey) {
+        unsigned char kc = static_cast<unsigned char>(*key);
+        unsigned char oc = static_cast<unsigned char>(*okey);
+        if ((kc | oc) >= 0x80) {
+            return false;
+        }
+        unsigned char kval = LowerCase::convert(kc);
+        unsigned char oval = LowerCase::convert(oc);
+        if (kval != oval) {
+            res = (kval < oval) ? -1 : 1;
+            return true;
+        }
+        if (kval == 0) {
+            res = 0;
+            return true;
+        }
+    }
+    res = 0;
+    return true;
+}
+
+}
+
 size_t
 FoldedStringCompare::
 size(const char *key) const
@@ -19,6 +55,11 @@ int
 FoldedStringCompare::
 compareFolded(const char *key, const char *okey) const
 {
+    size_t remaining = std::numeric_limits<size_t>::max();
+    int res = 0;
+    if (compareFoldedAscii(key, okey, remaining, res)) {
+        return res;
+    }
     vespalib::Utf8ReaderForZTS kreader(key);
     vespalib::Utf8ReaderForZTS oreader(okey);
 
@@ -44,6 +85,10 @@ int
 FoldedStringCompare::
 compareFoldedPrefix(const char *key, const char *okey, size_t prefixLen) const
 {
+    int res = 0;
+    if (compareFoldedAscii(key, okey, prefixLen, res)) {
+        return res;
+    }
     vespalib::Utf8ReaderForZTS kreader(key);
     vespalib::Utf8ReaderForZTS oreader(okey);
 
@@ -12,32 +12,49 @@ private:
     size_t _usedBytes;
     size_t _deadBytes;
     size_t _allocatedBytesOnHold;
+    size_t _allocatedBytesOnHugePages;  // Part of allocated bytes backed by transparent huge pages
+    size_t _allocatedBytesPaged;        // Part of allocated bytes backed by files, which can be paged out
+    size_t _residentBytesPaged;         // Part of paged bytes currently resident in memory
 
 public:
     MemoryUsage()
         : _allocatedBytes(0),
           _usedBytes(0),
           _deadBytes(0),
-          _allocatedBytesOnHold(0)
+          _allocatedBytesOnHold(0),
+          _allocatedBytesOnHugePages(0),
+          _allocatedBytesPaged(0),
+          _residentBytesPaged(0)
     { }
 
     MemoryUsage(size_t allocated, size_t used, size_t dead, size_t onHold)
         : _allocatedBytes(allocated),
           _usedBytes(used),
           _deadBytes(dead),
-          _allocatedBytesOnHold(onHold)
+          _allocatedBytesOnHold(onHold),
+          _allocatedBytesOnHugePages(0),
+          _allocatedBytesPaged(0),
+          _residentBytesPaged(0)
     { }
 
     size_t allocatedBytes() const { return _allocatedBytes; }
     size_t usedBytes() const { return _usedBytes; }
     size_t deadBytes() const { return _deadBytes; }
     size_t allocatedBytesOnHold() const { return _allocatedBytesOnHold; }
+    size_t allocatedBytesOnHugePages() const { return _allocatedBytesOnHugePages; }
+    size_t allocatedBytesPaged() const { return _allocatedBytesPaged; }
+    size_t residentBytesPaged() const { return _residentBytesPaged; }
+    // Allocated bytes that are resident in memory, i.e. excluding paged out bytes
+    size_t residentBytes() const { return _allocatedBytes - _allocatedBytesPaged + _residentBytesPaged; }
     void incAllocatedBytes(size_t inc) { _allocatedBytes += inc; }
     void decAllocatedBytes(size_t dec) { _allocatedBytes -= dec; }
     void incUsedBytes(size_t inc) { _usedBytes += inc; }
     void incDeadBytes(size_t inc) { _deadBytes += inc; }
     void incAllocatedBytesOnHold(size_t inc) { _allocatedBytesOnHold += inc; }
     void decAllocatedBytesOnHold(size_t inc) { _allocatedBytesOnHold -= inc; }
+    void incAllocatedBytesOnHugePages(size_t inc) { _allocatedBytesOnHugePages += inc; }
+    void incAllocatedBytesPaged(size_t inc) { _allocatedBytesPaged += inc; }
+    void incResidentBytesPaged(size_t inc) { _residentBytesPaged += inc; }
     void setAllocatedBytes(size_t alloc) { _allocatedBytes = alloc; }
     void setUsedBytes(size_t used) { _usedBytes = used; }
     void setDeadBytes(size_t dead) { _deadBytes = dead; }
@@ -54,6 +71,9 @@ public:
         _usedBytes += rhs._usedBytes;
         _deadBytes += rhs._deadBytes;
         _allocatedBytesOnHold += rhs._allocatedBytesOnHold;
+        _allocatedBytesOnHugePages += rhs._allocatedBytesOnHugePages;
+        _allocatedBytesPaged += rhs._allocatedBytesPaged;
+        _residentBytesPaged += rhs._residentBytesPaged;
     }
 };
 
@@ -49,10 +49,12 @@ DynamicDocsumConfig::createFieldWriter(const string & fieldName, const string &
         SummaryFeaturesDFW *fw = new SummaryFeaturesDFW();
         fieldWriter.reset(fw);
         fw->init(getEnvironment());
+        fw->setFloatPrecision(argument == "float");
         rc = true;
     } else if (overrideName == "rankfeatures") {
         RankFeaturesDFW * fw = new RankFeaturesDFW();
         fw->init(getEnvironment());
+        fw->setFloatPrecision(argument == "float");
         fieldWriter.reset(fw);
         rc = true;
     } else if (overrideName == "empty") {
@@ -35,7 +35,7 @@ RankFeaturesDFW::insertField(uint32_t docid, GeneralResult *, GetDocsumsState *s
         vespalib::slime::Cursor& obj = target.insertObject();
         for (uint32_t i = 0; i < names.size(); ++i) {
             vespalib::Memory name(names[i].c_str(), names[i].size());
-            obj.setDouble(name, values[i]);
+            obj.setDouble(name, encodeFeature(values[i]));
         }
         return;
     }
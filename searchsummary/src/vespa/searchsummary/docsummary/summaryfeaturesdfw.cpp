@@ -45,7 +45,7 @@ SummaryFeaturesDFW::insertField(uint32_t docid, GeneralResult *, GetDocsumsState
         vespalib::slime::Cursor& obj = target.insertObject();
         for (uint32_t i = 0; i < names.size(); ++i) {
             vespalib::Memory name(names[i].c_str(), names[i].size());
-            obj.setDouble(name, values[i]);
+            obj.setDouble(name, encodeFeature(values[i]));
         }
         if (state->_summaryFeaturesCached) {
             obj.setDouble(_M_cached, 1.0);
@@ -84,6 +84,8 @@ void FeaturesDFW::featureDump(vespalib::JSONStringer & json, const vespalib::str
     json.appendKey(name);
     if (std::isnan(feature) || std::isinf(feature)) {
         json.appendNull();
+    } else if (_floatPrecision) {
+        json.appendFloat(feature);
     } else {
         json.appendDouble(feature);
     }
@@ -12,8 +12,21 @@ class IDocsumEnvironment;
 
 class FeaturesDFW : public IDocsumFieldWriter
 {
+private:
+    bool _floatPrecision;
 protected:
+    FeaturesDFW() : _floatPrecision(false) {}
     void featureDump(vespalib::JSONStringer & json, const vespalib::stringref & name, double feature);
+    /**
+     * Round to float precision when requested. The binary docsum
+     * format drops trailing zero bytes of doubles, so such values
+     * take 5 instead of 9 bytes.
+     **/
+    double encodeFeature(double feature) const {
+        return _floatPrecision ? static_cast<float>(feature) : feature;
+    }
+public:
+    void setFloatPrecision(bool value) { _floatPrecision = value; }
 };
 
 class SummaryFeaturesDFW : public FeaturesDFW
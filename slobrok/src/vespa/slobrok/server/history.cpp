@@ -10,14 +10,10 @@ namespace slobrok {
 void
 History::verify() const
 {
-    if (_entries.size() > 0) {
-        citer_t i = _entries.begin();
-        vespalib::GenCnt gen = i->gen;
-
-        while (++i != _entries.end()) {
-            gen.add();
-            LOG_ASSERT(gen == i->gen);
-        }
+    if (_entries.size() > 1) {
+        vespalib::GenCnt gen = _entries[_entries.size() - 2].gen;
+        gen.add();
+        LOG_ASSERT(gen == _entries.back().gen);
     }
 }
 
@@ -54,16 +50,16 @@ History::has(vespalib::GenCnt gen) const
 std::set<std::string>
 History::since(vespalib::GenCnt gen) const
 {
-    citer_t i = _entries.begin();
-    citer_t end = _entries.end();
-    while (i != end) {
-        if (i->gen == gen) break;
-        ++i;
+    // generations are consecutive, so the first entry to include can be found directly
+    size_t first = 0;
+    if (has(gen)) {
+        first = _entries.front().gen.distance(gen);
+    } else {
+        first = _entries.size();
     }
     std::set<std::string> ret;
-    while (i != end) {
+    for (citer_t i = _entries.begin() + first; i != _entries.end(); ++i) {
         ret.insert(i->name);
-        ++i;
     }
     LOG_ASSERT(ret.size() > 0);
     return ret;
@@ -122,31 +122,32 @@ void
 IncrementalFetch::completeReq()
 {
     vespalib::GenCnt newgen = _map.genCnt();
-    VisibleMap::MapDiff diff;
+    VisibleMap::MapDiff full;
+    const VisibleMap::MapDiff *diff = &full;
     FRT_Values &dst = *_req->GetReturn();
 
     if (newgen == _gen) { // no change
         dst.AddInt32(_gen.getAsInt());
     } else if (_map.hasHistory(_gen)) {
-        diff = _map.history(_gen);
+        diff = &_map.history(_gen);
         dst.AddInt32(_gen.getAsInt());
     } else {
         dst.AddInt32(0);
-        diff.updated = _map.allVisible();
+        full.updated = _map.allVisible();
     }
 
-    size_t sz = diff.removed.size();
+    size_t sz = diff->removed.size();
     FRT_StringValue *rem    = dst.AddStringArray(sz);
     for (uint32_t i = 0; i < sz; ++i) {
-        dst.SetString(&rem[i],  diff.removed[i].c_str());
+        dst.SetString(&rem[i],  diff->removed[i].c_str());
     }
 
-    sz = diff.updated.size();
+    sz = diff->updated.size();
     FRT_StringValue *names  = dst.AddStringArray(sz);
     FRT_StringValue *specs  = dst.AddStringArray(sz);
     for (uint32_t i = 0; i < sz; ++i) {
-        dst.SetString(&names[i],  diff.updated[i]->getName());
-        dst.SetString(&specs[i],  diff.updated[i]->getSpec());
+        dst.SetString(&names[i],  diff->updated[i]->getName());
+        dst.SetString(&specs[i],  diff->updated[i]->getSpec());
     }
 
     dst.AddInt32(newgen.getAsInt());
@@ -11,6 +11,7 @@ void
 VisibleMap::updated()
 {
     _genCnt.add();
+    _cachedDiffGen.reset();
     WaitList waitList;
     std::swap(waitList, _waitList);
     for (uint32_t i = 0; i < waitList.size(); ++i) {
@@ -123,10 +124,14 @@ VisibleMap::update(NamedService *rpcsrv) {
     return d;
 }
 
-VisibleMap::MapDiff
+const VisibleMap::MapDiff &
 VisibleMap::history(const vespalib::GenCnt& gen) const
 {
-    MapDiff retval;
+    if (_cachedDiffGen == gen) {
+        return _cachedDiff;
+    }
+    _cachedDiff.removed.clear();
+    _cachedDiff.updated.clear();
     std::set<std::string> names = _history.since(gen);
     for (std::set<std::string>::iterator it = names.begin();
          it != names.end();
@@ -134,12 +139,13 @@ VisibleMap::history(const vespalib::GenCnt& gen) const
     {
         const NamedService *val = lookup(it->c_str());
         if (val == NULL) {
-            retval.removed.push_back(*it);
+            _cachedDiff.removed.push_back(*it);
         } else {
-            retval.updated.push_back(val);
+            _cachedDiff.updated.push_back(val);
         }
     }
-    return retval;
+    _cachedDiffGen = gen;
+    return _cachedDiff;
 }
 
 VisibleMap::MapDiff::MapDiff() {}
@@ -148,7 +154,10 @@ VisibleMap::MapDiff::~MapDiff() {}
 VisibleMap::VisibleMap()
     : _map(NULL),
       _waitList(),
-      _genCnt(1)
+      _genCnt(1),
+      _history(),
+      _cachedDiffGen(),
+      _cachedDiff()
 {
 }
 VisibleMap::~VisibleMap()
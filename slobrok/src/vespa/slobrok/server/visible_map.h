@@ -53,6 +53,9 @@ private:
     WaitList         _waitList;
     vespalib::GenCnt _genCnt;
     History          _history;
+    // diff from _cachedDiffGen to _genCnt, shared by all mirrors waiting at the same generation
+    mutable vespalib::GenCnt _cachedDiffGen;
+    mutable MapDiff          _cachedDiff;
 
     static bool match(const char *name, const char *pattern);
 
@@ -78,7 +81,7 @@ public:
 
     bool hasHistory(vespalib::GenCnt gen) const { return _history.has(gen); }
 
-    MapDiff history(const vespalib::GenCnt& gen) const;
+    const MapDiff &history(const vespalib::GenCnt& gen) const;
 
     VisibleMap();
     ~VisibleMap();
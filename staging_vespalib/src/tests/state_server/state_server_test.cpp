@@ -10,6 +10,9 @@
 #include <vespa/vespalib/net/state_explorer.h>
 #include <vespa/vespalib/net/slime_explorer.h>
 #include <vespa/vespalib/net/generic_state_handler.h>
+#include <vespa/vespalib/net/cpu_profile_handler.h>
+#include <atomic>
+#include <thread>
 
 using namespace vespalib;
 
@@ -346,6 +349,40 @@ TEST_FFFF("require that metrics consumer is passed correctly",
     EXPECT_EQUAL("[\"ME\"]", f4.get(host_tag, total_metrics_path, my_params));
 }
 
+struct BusyThread {
+    std::atomic<bool> done;
+    std::thread thread;
+    BusyThread() : done(false), thread([this]() {
+            volatile uint64_t sum = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                sum = sum + 1;
+            }
+        }) {}
+    ~BusyThread() {
+        done = true;
+        thread.join();
+    }
+};
+
+TEST_FF("require that cpu profile samples busy threads", BusyThread(), CpuProfileHandler(0.1, 1.0)) {
+    CpuProfileHandler::Profile profile = CpuProfileHandler::sample(0.5, 1000);
+    EXPECT_TRUE(profile.ok);
+    EXPECT_GREATER(profile.samples, 0u);
+    EXPECT_FALSE(profile.stacks.empty());
+    size_t total = 0;
+    for (const auto &entry : profile.stacks) {
+        total += entry.second;
+    }
+    EXPECT_LESS_EQUAL(total, profile.samples);
+    std::map<vespalib::string,vespalib::string> my_params;
+    my_params["seconds"] = "0.2";
+    vespalib::string json = f2.get(host_tag, "/state/v1/profile", my_params);
+    Slime slime;
+    EXPECT_TRUE(slime::JsonFormat::decode(json, slime) > 0);
+    EXPECT_EQUAL(0.2, slime.get()["seconds"].asDouble());
+    EXPECT_TRUE(slime.get()["stacks"].valid());
+}
+
 void check_json(const vespalib::string &expect_json, const vespalib::string &actual_json) {
     Slime expect_slime;
     Slime actual_slime;
@@ -3,6 +3,7 @@
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/stllike/cache.hpp>
+#include <vespa/vespalib/stllike/sharded_cache.hpp>
 #include <map>
 
 using namespace vespalib;
@@ -41,6 +42,8 @@ private:
     void testCacheEntriesHonoured();
     void testCacheMaxSizeHonoured();
     void testThatMultipleRemoveOnOverflowIsFine();
+    void testShardedCache();
+    void testShardedCacheAdmitsOnSecondMiss();
 };
 
 int
@@ -53,6 +56,8 @@ Test::Main()
     testCacheEntriesHonoured();
     testCacheMaxSizeHonoured();
     testThatMultipleRemoveOnOverflowIsFine();
+    testShardedCache();
+    testShardedCacheAdmitsOnSecondMiss();
     TEST_DONE();
 }
 
@@ -161,3 +166,57 @@ void Test::testThatMultipleRemoveOnOverflowIsFine()
 
 
 TEST_APPHOOK(Test)
+
+void Test::testShardedCache()
+{
+    B m;
+    sharded_cache< CacheParam<P, B, zero<uint32_t>, size<string> > > cache(m, 4000, 4);
+    EXPECT_EQUAL(4u, cache.numShards());
+    EXPECT_EQUAL(4000u, cache.capacityBytes());
+    EXPECT_TRUE(cache.empty());
+    for (uint32_t i(0); i < 8; i++) {
+        m[i] = "value";
+    }
+    for (uint32_t i(0); i < 8; i++) {
+        EXPECT_EQUAL("value", cache.read(i));
+        EXPECT_TRUE(cache.hasKey(i));
+    }
+    EXPECT_EQUAL(8u, cache.size());
+    EXPECT_EQUAL(8u, cache.getMiss());
+    EXPECT_EQUAL(8u, cache.getInsert());
+    EXPECT_EQUAL("value", cache.read(3));
+    EXPECT_EQUAL(1u, cache.getHit());
+    cache.write(3, "changed");
+    EXPECT_EQUAL("changed", m[3]);
+    cache.invalidate(3);
+    EXPECT_FALSE(cache.hasKey(3));
+    EXPECT_EQUAL(1u, cache.getInvalidate());
+    cache.erase(4);
+    EXPECT_FALSE(cache.hasKey(4));
+    EXPECT_TRUE(m.find(4) == m.end());
+    EXPECT_EQUAL(6u, cache.size());
+}
+
+void Test::testShardedCacheAdmitsOnSecondMiss()
+{
+    B m;
+    sharded_cache< CacheParam<P, B, zero<uint32_t>, size<string> > > cache(m, -1, 2);
+    cache.admitOnSecondMiss(1000);
+    m[1] = "hot";
+    for (uint32_t i(100); i < 200; i++) {
+        m[i] = "scanned";
+    }
+    EXPECT_EQUAL("hot", cache.read(1));
+    EXPECT_FALSE(cache.hasKey(1));
+    EXPECT_EQUAL("hot", cache.read(1));
+    EXPECT_TRUE(cache.hasKey(1));
+    for (uint32_t i(100); i < 200; i++) {
+        EXPECT_EQUAL("scanned", cache.read(i));
+    }
+    EXPECT_EQUAL(1u, cache.size());
+    EXPECT_TRUE(cache.hasKey(1));
+    EXPECT_EQUAL(101u, cache.getNotAdmitted());
+    EXPECT_EQUAL(102u, cache.getMiss());
+    EXPECT_EQUAL("hot", cache.read(1));
+    EXPECT_EQUAL(1u, cache.getHit());
+}
@@ -0,0 +1,205 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "cpu_profile_handler.h"
+#include <vespa/vespalib/util/backtrace.h>
+#include <vespa/vespalib/util/classname.h>
+#include <vespa/vespalib/util/jsonwriter.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <execinfo.h>
+#include <signal.h>
+#include <sys/time.h>
+
+namespace vespalib {
+
+namespace {
+
+constexpr int MAX_FRAMES = 48;
+// frames belonging to the signal handler and the signal trampoline
+constexpr int IGNORE_TOP = 2;
+
+struct Sample {
+    int depth;
+    void *frames[MAX_FRAMES];
+};
+
+std::mutex _profileLock;
+Sample *_samples = nullptr;
+size_t _capacity = 0;
+std::atomic<size_t> _nextSample(0);
+
+void
+onSigProf(int)
+{
+    int savedErrno = errno;
+    size_t idx = _nextSample.fetch_add(1, std::memory_order_relaxed);
+    if (idx < _capacity) {
+        Sample &sample = _samples[idx];
+        sample.depth = getStackTraceFrames(sample.frames, MAX_FRAMES);
+    }
+    errno = savedErrno;
+}
+
+void
+setTimer(uint32_t intervalUs)
+{
+    struct itimerval timer;
+    timer.it_interval.tv_sec = intervalUs / 1000000;
+    timer.it_interval.tv_usec = intervalUs % 1000000;
+    timer.it_value = timer.it_interval;
+    setitimer(ITIMER_PROF, &timer, nullptr);
+}
+
+vespalib::string
+symbolName(const char *line)
+{
+    // Format is 'module(symbol+offset) [address]'
+    const char *open = strchr(line, '(');
+    const char *plus = (open != nullptr) ? strchr(open, '+') : nullptr;
+    if ((open != nullptr) && (plus != nullptr) && (plus > open + 1)) {
+        vespalib::string mangled(open + 1, plus - open - 1);
+        vespalib::string name = demangle(mangled.c_str());
+        return name.empty() ? mangled : name;
+    }
+    const char *end = (open != nullptr) ? open : line + strlen(line);
+    const char *slash = line;
+    for (const char *p = line; p < end; ++p) {
+        if (*p == '/') {
+            slash = p + 1;
+        }
+    }
+    return vespalib::string(slash, end - slash);
+}
+
+CpuProfileHandler::FoldedStacks
+foldStacks(const Sample *samples, size_t numSamples)
+{
+    std::vector<void *> addresses;
+    for (size_t i = 0; i < numSamples; ++i) {
+        for (int f = IGNORE_TOP; f < samples[i].depth; ++f) {
+            addresses.push_back(samples[i].frames[f]);
+        }
+    }
+    std::sort(addresses.begin(), addresses.end());
+    addresses.erase(std::unique(addresses.begin(), addresses.end()), addresses.end());
+    vespalib::hash_map<uint64_t, vespalib::string> names;
+    if ( ! addresses.empty()) {
+        char **symbols = backtrace_symbols(&addresses[0], addresses.size());
+        for (size_t i = 0; i < addresses.size(); ++i) {
+            uint64_t key = reinterpret_cast<uint64_t>(addresses[i]);
+            names[key] = (symbols != nullptr) ? symbolName(symbols[i]) : make_string("%p", addresses[i]);
+        }
+        free(symbols);
+    }
+    CpuProfileHandler::FoldedStacks stacks;
+    for (size_t i = 0; i < numSamples; ++i) {
+        vespalib::string folded;
+        for (int f = samples[i].depth - 1; f >= IGNORE_TOP; --f) {
+            if ( ! folded.empty()) {
+                folded.append(';');
+            }
+            folded.append(names[reinterpret_cast<uint64_t>(samples[i].frames[f])]);
+        }
+        if ( ! folded.empty()) {
+            ++stacks[folded];
+        }
+    }
+    return stacks;
+}
+
+} // namespace vespalib::<unnamed>
+
+CpuProfileHandler::CpuProfileHandler(double defaultSeconds, double maxSeconds)
+    : _defaultSeconds(defaultSeconds),
+      _maxSeconds(maxSeconds)
+{
+}
+
+CpuProfileHandler::~CpuProfileHandler() {}
+
+CpuProfileHandler::Profile
+CpuProfileHandler::sample(double seconds, uint32_t intervalUs)
+{
+    Profile profile;
+    std::unique_lock<std::mutex> guard(_profileLock, std::try_to_lock);
+    if ( ! guard.owns_lock()) {
+        return profile;
+    }
+    std::vector<Sample> samples(MAX_SAMPLES);
+    void *warmup[MAX_FRAMES];
+    getStackTraceFrames(warmup, MAX_FRAMES); // make sure unwinder is loaded before use in signal handler
+    _samples = &samples[0];
+    _capacity = samples.size();
+    _nextSample.store(0);
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+
+    struct sigaction action;
+    struct sigaction oldAction;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = onSigProf;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGPROF, &action, &oldAction);
+    setTimer(std::max(intervalUs, 1u));
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    setTimer(0);
+    sigaction(SIGPROF, &oldAction, nullptr);
+    // let handlers already running in other threads complete
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    size_t taken = _nextSample.load();
+    _samples = nullptr;
+    _capacity = 0;
+    profile.ok = true;
+    profile.seconds = seconds;
+    profile.samples = std::min(taken, samples.size());
+    profile.dropped = taken - profile.samples;
+    profile.stacks = foldStacks(&samples[0], profile.samples);
+    return profile;
+}
+
+vespalib::string
+CpuProfileHandler::get(const vespalib::string &, const vespalib::string &,
+                       const std::map<vespalib::string,vespalib::string> &params) const
+{
+    double seconds = _defaultSeconds;
+    auto found = params.find("seconds");
+    if (found != params.end()) {
+        seconds = strtod(found->second.c_str(), nullptr);
+    }
+    seconds = std::max(0.0, std::min(seconds, _maxSeconds));
+    Profile profile = sample(seconds);
+    JSONStringer json;
+    json.beginObject();
+    if ( ! profile.ok) {
+        json.appendKey("error");
+        json.appendString("cpu profile already in progress");
+    } else {
+        json.appendKey("seconds");
+        json.appendDouble(profile.seconds);
+        json.appendKey("samples");
+        json.appendUInt64(profile.samples);
+        json.appendKey("dropped");
+        json.appendUInt64(profile.dropped);
+        json.appendKey("stacks");
+        json.beginObject();
+        for (const auto &entry : profile.stacks) {
+            json.appendKey(entry.first);
+            json.appendUInt64(entry.second);
+        }
+        json.endObject();
+    }
+    json.endObject();
+    return json.toString();
+}
+
+} // namespace vespalib
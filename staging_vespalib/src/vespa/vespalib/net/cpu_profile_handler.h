@@ -0,0 +1,58 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "json_get_handler.h"
+#include <map>
+
+namespace vespalib {
+
+/**
+ * A json get handler that samples the call stacks of the running
+ * process for a limited amount of time and reports them in folded
+ * form ("root;caller;callee" -> count), suitable as input to flame
+ * graph tools. Sampling is driven by the ITIMER_PROF interval timer,
+ * so only threads actually consuming cpu are sampled. Only one
+ * profile can be collected at a time; concurrent requests are
+ * rejected. Bind it to a path (typically "/state/v1/profile") to
+ * enable it; the number of seconds to sample is given by the
+ * 'seconds' request parameter.
+ **/
+class CpuProfileHandler : public JsonGetHandler
+{
+public:
+    using FoldedStacks = std::map<vespalib::string, size_t>;
+
+    struct Profile {
+        bool          ok;
+        double        seconds;
+        size_t        samples;
+        size_t        dropped;
+        FoldedStacks  stacks;
+        Profile() : ok(false), seconds(0.0), samples(0), dropped(0), stacks() {}
+    };
+
+    static constexpr uint32_t DEFAULT_SAMPLE_INTERVAL_US = 10000;
+    static constexpr size_t MAX_SAMPLES = 64 * 1024;
+
+private:
+    double _defaultSeconds;
+    double _maxSeconds;
+
+public:
+    CpuProfileHandler(double defaultSeconds, double maxSeconds);
+    ~CpuProfileHandler() override;
+
+    /**
+     * Sample the stacks of this process for the given number of
+     * seconds. Returns a profile with ok == false if another profile
+     * is already being collected.
+     **/
+    static Profile sample(double seconds, uint32_t intervalUs = DEFAULT_SAMPLE_INTERVAL_US);
+
+    vespalib::string get(const vespalib::string &host,
+                         const vespalib::string &path,
+                         const std::map<vespalib::string,vespalib::string> &params) const override;
+};
+
+} // namespace vespalib
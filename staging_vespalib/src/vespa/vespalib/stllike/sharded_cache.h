@@ -0,0 +1,95 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "cache.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace vespalib {
+
+/**
+ * A set of @ref cache instances, each with its own lock and an equal share of the byte budget.
+ * A key always maps to the same shard, chosen by its hash, so concurrent readers of different
+ * keys seldom contend on the same lock.
+ *
+ * Optionally an object is only admitted into the cache the second time it is missed within a
+ * window of recent misses. A single scan over many objects then reads through the cache without
+ * evicting the objects that are read repeatedly.
+ */
+template< typename P >
+class sharded_cache
+{
+    typedef cache<P>                  Shard;
+protected:
+    typedef typename P::BackingStore  BackingStore;
+    typedef typename P::Hash          Hash;
+    typedef typename P::Key           K;
+    typedef typename P::Value         V;
+private:
+
+    /**
+     * Remembers hashes of recently missed keys in a bit vector that is cleared when a
+     * quarter of it has been set.
+     */
+    class DoorKeeper {
+    public:
+        DoorKeeper(size_t numBits);
+        /** Returns true if the hash was seen before, and remembers it otherwise. */
+        bool testAndSet(size_t hash);
+    private:
+        std::mutex            _lock;
+        std::vector<uint64_t> _bits;
+        size_t                _numSet;
+    };
+public:
+    /**
+     * @param backingStore is the store for populating the cache on a cache miss.
+     * @param maxBytes is the total byte budget, split evenly over the shards.
+     * @param numShards is the number of independently locked shards.
+     */
+    sharded_cache(BackingStore & b, size_t maxBytes, size_t numShards);
+    ~sharded_cache();
+
+    sharded_cache & maxElements(size_t elems);
+    sharded_cache & reserveElements(size_t elems);
+    sharded_cache & setCapacityBytes(size_t sz);
+    /**
+     * Only admit objects missed twice within the last numKeys misses of a shard.
+     * 0 admits every object, which is the default.
+     */
+    sharded_cache & admitOnSecondMiss(size_t numKeys);
+
+    size_t numShards()                 const { return _shards.size(); }
+    size_t capacity()                  const;
+    size_t capacityBytes()             const { return _maxBytes; }
+    size_t size()                      const;
+    size_t sizeBytes()                 const;
+    bool empty()                       const { return size() == 0; }
+
+    void erase(const K & key)                    { getShard(key).erase(key); }
+    void invalidate(const K & key)               { getShard(key).invalidate(key); }
+    V read(const K & key);
+    void write(const K & key, const V & value)   { getShard(key).write(key, value); }
+    bool hasKey(const K & key) const             { return getShard(key).hasKey(key); }
+
+    size_t          getHit() const;
+    size_t         getMiss() const;
+    size_t    getNotAdmitted() const { return _notAdmitted; }
+    size_t       getInsert() const;
+    size_t   getInvalidate() const;
+
+private:
+    size_t shardIndex(const K & key) const { return _hasher(key) % _shards.size(); }
+    Shard & getShard(const K & key) { return *_shards[shardIndex(key)]; }
+    const Shard & getShard(const K & key) const { return *_shards[shardIndex(key)]; }
+
+    Hash                                     _hasher;
+    BackingStore                           & _store;
+    size_t                                   _maxBytes;
+    std::vector<std::unique_ptr<Shard>>      _shards;
+    std::vector<std::unique_ptr<DoorKeeper>> _doorKeepers;
+    std::atomic<size_t>                      _notAdmitted;
+};
+
+}
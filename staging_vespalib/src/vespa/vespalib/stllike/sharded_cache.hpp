@@ -0,0 +1,157 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "sharded_cache.h"
+#include "cache.hpp"
+
+namespace vespalib {
+
+template< typename P >
+sharded_cache<P>::DoorKeeper::DoorKeeper(size_t numBits)
+    : _lock(),
+      _bits((numBits + 63) / 64, 0),
+      _numSet(0)
+{ }
+
+template< typename P >
+bool
+sharded_cache<P>::DoorKeeper::testAndSet(size_t hash)
+{
+    // spread the key hash, which may be the key itself, over the bit vector
+    uint64_t bit = (static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ul) % (_bits.size() * 64);
+    uint64_t mask = 1ul << (bit % 64);
+    std::lock_guard<std::mutex> guard(_lock);
+    uint64_t & word = _bits[bit / 64];
+    if ((word & mask) != 0) {
+        return true;
+    }
+    if (_numSet >= (_bits.size() * 64) / 4) {
+        std::fill(_bits.begin(), _bits.end(), 0);
+        _numSet = 0;
+    }
+    word |= mask;
+    _numSet++;
+    return false;
+}
+
+template< typename P >
+sharded_cache<P>::sharded_cache(BackingStore & b, size_t maxBytes, size_t numShards) :
+    _hasher(),
+    _store(b),
+    _maxBytes(maxBytes),
+    _shards(),
+    _doorKeepers(),
+    _notAdmitted(0)
+{
+    if (numShards == 0) {
+        numShards = 1;
+    }
+    for (size_t i(0); i < numShards; i++) {
+        _shards.emplace_back(std::make_unique<Shard>(b, maxBytes / numShards));
+    }
+}
+
+template< typename P >
+sharded_cache<P>::~sharded_cache() { }
+
+template< typename P >
+sharded_cache<P> &
+sharded_cache<P>::maxElements(size_t elems) {
+    for (auto & shard : _shards) {
+        shard->maxElements((elems + _shards.size() - 1) / _shards.size());
+    }
+    return *this;
+}
+
+template< typename P >
+sharded_cache<P> &
+sharded_cache<P>::reserveElements(size_t elems) {
+    for (auto & shard : _shards) {
+        shard->reserveElements(elems / _shards.size());
+    }
+    return *this;
+}
+
+template< typename P >
+sharded_cache<P> &
+sharded_cache<P>::setCapacityBytes(size_t sz) {
+    _maxBytes = sz;
+    for (auto & shard : _shards) {
+        shard->setCapacityBytes(sz / _shards.size());
+    }
+    return *this;
+}
+
+template< typename P >
+sharded_cache<P> &
+sharded_cache<P>::admitOnSecondMiss(size_t numKeys) {
+    _doorKeepers.clear();
+    if (numKeys > 0) {
+        // 4 bits per key keeps false positives low while the window fills up.
+        size_t bitsPerShard = std::max(size_t(64), (numKeys * 4) / _shards.size());
+        for (size_t i(0); i < _shards.size(); i++) {
+            _doorKeepers.emplace_back(std::make_unique<DoorKeeper>(bitsPerShard));
+        }
+    }
+    return *this;
+}
+
+template< typename P >
+typename P::Value
+sharded_cache<P>::read(const K & key)
+{
+    size_t index = shardIndex(key);
+    Shard & shard = *_shards[index];
+    if (_doorKeepers.empty() || shard.hasKey(key) || _doorKeepers[index]->testAndSet(_hasher(key))) {
+        return shard.read(key);
+    }
+    _notAdmitted.fetch_add(1);
+    V value;
+    _store.read(key, value);
+    return value;
+}
+
+#define VESPALIB_SHARDED_CACHE_SUM(method)        \
+    size_t sum(0);                                \
+    for (const auto & shard : _shards) {          \
+        sum += shard->method();                   \
+    }                                             \
+    return sum;
+
+template< typename P >
+size_t
+sharded_cache<P>::capacity() const { VESPALIB_SHARDED_CACHE_SUM(capacity) }
+
+template< typename P >
+size_t
+sharded_cache<P>::size() const { VESPALIB_SHARDED_CACHE_SUM(size) }
+
+template< typename P >
+size_t
+sharded_cache<P>::sizeBytes() const { VESPALIB_SHARDED_CACHE_SUM(sizeBytes) }
+
+template< typename P >
+size_t
+sharded_cache<P>::getHit() const { VESPALIB_SHARDED_CACHE_SUM(getHit) }
+
+template< typename P >
+size_t
+sharded_cache<P>::getMiss() const {
+    size_t sum(_notAdmitted);
+    for (const auto & shard : _shards) {
+        sum += shard->getMiss();
+    }
+    return sum;
+}
+
+template< typename P >
+size_t
+sharded_cache<P>::getInsert() const { VESPALIB_SHARDED_CACHE_SUM(getInsert) }
+
+template< typename P >
+size_t
+sharded_cache<P>::getInvalidate() const { VESPALIB_SHARDED_CACHE_SUM(getInvalidate) }
+
+#undef VESPALIB_SHARDED_CACHE_SUM
+
+}
@@ -26,6 +26,15 @@ GrowableByteBuffer::allocate(uint32_t len)
     return pos;
 }
 
+alloc::Alloc
+GrowableByteBuffer::stealBuffer()
+{
+    Alloc buf(Alloc::alloc(0));
+    buf.swap(_buffer);
+    _position = 0;
+    return buf;
+}
+
 void
 GrowableByteBuffer::putBytes(const char* buffer, uint32_t length)
 {
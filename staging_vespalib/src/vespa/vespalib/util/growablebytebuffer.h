@@ -37,6 +37,12 @@ public:
     */
     const char* getBuffer() const { return static_cast<const char *>(_buffer.get()); }
 
+    /**
+       Hands over the allocated buffer, holding position() bytes of data,
+       to the caller. This buffer is left empty.
+    */
+    vespalib::alloc::Alloc stealBuffer();
+
     /**
        Returns the current position.
     */
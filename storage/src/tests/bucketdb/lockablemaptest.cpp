@@ -16,6 +16,7 @@ struct LockableMapTest : public CppUnit::TestFixture {
     void testIterating();
     void testChunkedIterationIsTransparentAcrossChunkSizes();
     void testCanAbortDuringChunkedIteration();
+    void testReadOnlyIterationDoesNotWaitForBucketLocks();
     void testThreadSafetyStress();
     void testFindBuckets();
     void testFindBuckets2();
@@ -49,6 +50,7 @@ struct LockableMapTest : public CppUnit::TestFixture {
     CPPUNIT_TEST(testIterating);
     CPPUNIT_TEST(testChunkedIterationIsTransparentAcrossChunkSizes);
     CPPUNIT_TEST(testCanAbortDuringChunkedIteration);
+    CPPUNIT_TEST(testReadOnlyIterationDoesNotWaitForBucketLocks);
     CPPUNIT_TEST(testThreadSafetyStress);
     CPPUNIT_TEST(testFindBuckets);
     CPPUNIT_TEST(testFindBuckets2);
@@ -342,6 +344,37 @@ LockableMapTest::testCanAbortDuringChunkedIteration()
     CPPUNIT_ASSERT_EQUAL(expected, proc.toString());
 }
 
+void
+LockableMapTest::testReadOnlyIterationDoesNotWaitForBucketLocks()
+{
+    Map map;
+    bool preExisted;
+    map.insert(16, A(1, 2, 3), "foo", preExisted);
+    map.insert(11, A(4, 6, 0), "foo", preExisted);
+    map.insert(14, A(42, 0, 0), "foo", preExisted);
+
+    // Holding a bucket lock would make chunkedAll wait forever here.
+    Map::WrappedEntry locked = map.get(14, "foo");
+    locked->_val2 = 5;
+    {
+        EntryProcessor proc;
+        map.chunkedReadOnlyAll(proc, 1);
+        std::string expected("11 - A(4, 6, 0)\n"
+                             "14 - A(42, 0, 0)\n"
+                             "16 - A(1, 2, 3)\n");
+        CPPUNIT_ASSERT_EQUAL(expected, proc.toString());
+    }
+    A value;
+    CPPUNIT_ASSERT(map.getReadOnly(14, value));
+    CPPUNIT_ASSERT_EQUAL(A(42, 0, 0), value);
+    CPPUNIT_ASSERT(!map.getReadOnly(12, value));
+
+    // Written back values become visible to read-only lookups.
+    locked.write();
+    CPPUNIT_ASSERT(map.getReadOnly(14, value));
+    CPPUNIT_ASSERT_EQUAL(A(42, 5, 0), value);
+}
+
 namespace {
     struct LoadGiver : public document::Runnable {
         typedef std::shared_ptr<LoadGiver> SP;
@@ -16,6 +16,7 @@
 #include <vespa/storage/distributor/distributor.h>
 #include <vespa/storage/distributor/distributor_bucket_space.h>
 #include <vespa/vespalib/text/stringtokenizer.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 
 using namespace storage::api;
 using namespace storage::lib;
@@ -53,6 +54,7 @@ class BucketDBUpdaterTest : public CppUnit::TestFixture,
     CPPUNIT_TEST(testPendingClusterStateReceive);
     CPPUNIT_TEST(testPendingClusterStateMerge);
     CPPUNIT_TEST(testPendingClusterStateMergeReplicaChanged);
+    CPPUNIT_TEST(testPendingClusterStateParallelMergeMatchesSerialMerge);
     CPPUNIT_TEST(testPendingClusterStateWithGroupDown);
     CPPUNIT_TEST(testPendingClusterStateWithGroupDownAndNoHandover);
     CPPUNIT_TEST(testNoDbResurrectionForBucketNotOwnedInCurrentState);
@@ -114,6 +116,7 @@ protected:
     void testPendingClusterStateReceive();
     void testPendingClusterStateMerge();
     void testPendingClusterStateMergeReplicaChanged();
+    void testPendingClusterStateParallelMergeMatchesSerialMerge();
     void testPendingClusterStateWithGroupDown();
     void testPendingClusterStateWithGroupDownAndNoHandover();
     void testNoDbResurrectionForBucketNotOwnedInCurrentState();
@@ -444,7 +447,8 @@ public:
             const std::string& existingData,
             const lib::ClusterState& newState,
             const std::string& newData,
-            bool includeBucketInfo = false);
+            bool includeBucketInfo = false,
+            vespalib::ThreadExecutor* mergeExecutor = nullptr);
 
     std::string mergeBucketLists(
             const std::string& existingData,
@@ -1793,7 +1797,8 @@ BucketDBUpdaterTest::mergeBucketLists(
         const std::string& existingData,
         const lib::ClusterState& newState,
         const std::string& newData,
-        bool includeBucketInfo)
+        bool includeBucketInfo,
+        vespalib::ThreadExecutor* mergeExecutor)
 {
     framework::defaultimplementation::FakeClock clock;
     framework::MilliSecTimer timer(clock);
@@ -1813,7 +1818,7 @@ BucketDBUpdaterTest::mergeBucketLists(
                         beforeTime));
 
         parseInputData(existingData, beforeTime, *state, includeBucketInfo);
-        state->mergeIntoBucketDatabases();
+        state->mergeIntoBucketDatabases(mergeExecutor);
     }
 
     BucketDumper dumper_tmp(true);
@@ -1832,7 +1837,7 @@ BucketDBUpdaterTest::mergeBucketLists(
                         afterTime));
 
         parseInputData(newData, afterTime, *state, includeBucketInfo);
-        state->mergeIntoBucketDatabases();
+        state->mergeIntoBucketDatabases(mergeExecutor);
     }
 
     BucketDumper dumper(includeBucketInfo);
@@ -1942,6 +1947,50 @@ BucketDBUpdaterTest::testPendingClusterStateMergeReplicaChanged()
                     true));
 }
 
+namespace {
+
+std::string
+makeBucketList(uint16_t node, uint32_t from, uint32_t to, uint32_t step)
+{
+    std::ostringstream ost;
+    ost << node << ":";
+    for (uint32_t i = from; i < to; i += step) {
+        if (i != from) {
+            ost << ",";
+        }
+        ost << i;
+    }
+    return ost.str();
+}
+
+}
+
+void
+BucketDBUpdaterTest::testPendingClusterStateParallelMergeMatchesSerialMerge()
+{
+    vespalib::ThreadStackExecutor executor(4, 128 * 1024);
+    // Enough buckets to have entries in all ranges of the key space.
+    const std::string existing(makeBucketList(0, 0, 2000, 1) + "|" +
+                               makeBucketList(1, 0, 2000, 2) + "|" +
+                               makeBucketList(2, 1, 2000, 2));
+    const std::vector<std::pair<std::string, std::string>> transitions = {
+        // New node came up, with some of the existing buckets and some new ones
+        {"distributor:1 storage:4", makeBucketList(3, 1000, 3000, 3)},
+        // Node lost a disk and came back with fewer buckets
+        {"distributor:1 storage:3 .0.d:3 .0.d.1.s:d", makeBucketList(0, 0, 500, 1)},
+        // Node came back with no buckets
+        {"distributor:1 storage:3 .1.d:3 .1.d.1.s:d", "1:"},
+    };
+    for (const auto& transition : transitions) {
+        lib::ClusterState oldState("distributor:1 storage:3");
+        lib::ClusterState newState(transition.first);
+        std::string serial(mergeBucketLists(oldState, existing, newState, transition.second, true));
+        std::string parallel(mergeBucketLists(oldState, existing, newState, transition.second, true, &executor));
+        CPPUNIT_ASSERT(!serial.empty());
+        CPPUNIT_ASSERT_EQUAL(serial, parallel);
+    }
+}
+
 void
 BucketDBUpdaterTest::testNoDbResurrectionForBucketNotOwnedInCurrentState()
 {
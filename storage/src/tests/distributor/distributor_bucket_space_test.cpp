@@ -0,0 +1,67 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vdstestlib/cppunit/macros.h>
+#include <vespa/storage/distributor/distributor_bucket_space.h>
+#include <vespa/vdslib/distribution/distribution.h>
+#include <vespa/vdslib/state/clusterstate.h>
+
+namespace storage::distributor {
+
+using document::BucketId;
+
+class DistributorBucketSpaceTest : public CppUnit::TestFixture {
+    CPPUNIT_TEST_SUITE(DistributorBucketSpaceTest);
+    CPPUNIT_TEST(cached_ideal_nodes_match_distribution);
+    CPPUNIT_TEST(ideal_nodes_are_not_cached_with_disks_down);
+    CPPUNIT_TEST(clearing_cache_picks_up_new_cluster_state);
+    CPPUNIT_TEST_SUITE_END();
+
+    DistributorBucketSpace _space;
+
+    void verify_ideal_nodes(const lib::ClusterState& state);
+public:
+    void setUp() override {
+        _space.setDistribution(std::make_shared<lib::Distribution>(
+                lib::Distribution::getDefaultDistributionConfig(3, 10)));
+    }
+
+    void cached_ideal_nodes_match_distribution();
+    void ideal_nodes_are_not_cached_with_disks_down();
+    void clearing_cache_picks_up_new_cluster_state();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(DistributorBucketSpaceTest);
+
+void DistributorBucketSpaceTest::verify_ideal_nodes(const lib::ClusterState& state) {
+    const lib::Distribution& distribution(_space.getDistribution());
+    for (uint32_t bits : {8, 16, 20, 32, 33, 40, 58}) {
+        for (uint64_t raw : {0x0ULL, 0x1234ULL, 0xfedcba9876ULL, 0x123456789abcdefULL}) {
+            BucketId bucket(bits, raw);
+            // Twice, to also get the cached result
+            for (int i = 0; i < 2; ++i) {
+                CPPUNIT_ASSERT_EQUAL(distribution.getIdealStorageNodes(state, bucket),
+                                     _space.getIdealNodes(state, bucket));
+                CPPUNIT_ASSERT_EQUAL(distribution.getIdealStorageNodes(state, bucket, "ui"),
+                                     _space.getIdealNodes(state, bucket, "ui"));
+            }
+        }
+    }
+}
+
+void DistributorBucketSpaceTest::cached_ideal_nodes_match_distribution() {
+    verify_ideal_nodes(lib::ClusterState("bits:8 distributor:1 storage:10 .3.s:m .4.s:r"));
+}
+
+void DistributorBucketSpaceTest::ideal_nodes_are_not_cached_with_disks_down() {
+    verify_ideal_nodes(lib::ClusterState("bits:8 distributor:1 storage:10 .2.d:4 .2.d.1.s:d"));
+}
+
+void DistributorBucketSpaceTest::clearing_cache_picks_up_new_cluster_state() {
+    lib::ClusterState before("bits:8 distributor:1 storage:10");
+    lib::ClusterState after("bits:8 distributor:1 storage:10 .0.s:d .1.s:d .2.s:d .3.s:d");
+    verify_ideal_nodes(before);
+    _space.clearIdealNodesCache();
+    verify_ideal_nodes(after);
+}
+
+}
@@ -5,6 +5,7 @@
 #include <vespa/document/repo/documenttyperepo.h>
 #include <vespa/storage/distributor/externaloperationhandler.h>
 #include <vespa/storage/distributor/distributor.h>
+#include <vespa/storage/distributor/pendingmessagetracker.h>
 #include <tests/distributor/distributortestutil.h>
 #include <vespa/storageapi/message/persistence.h>
 #include <tests/common/dummystoragelink.h>
@@ -45,6 +46,10 @@ class GetOperationTest : public CppUnit::TestFixture, public DistributorTestUtil
     CPPUNIT_TEST(testMultiInconsistentBucketNotFoundDeleted);
     CPPUNIT_TEST(testMultipleCopiesWithFailureOnLocalNode);
     CPPUNIT_TEST(canGetDocumentsWhenAllReplicaNodesRetired);
+    CPPUNIT_TEST(weak_consistency_sends_to_single_replica_when_inconsistent);
+    CPPUNIT_TEST(weak_consistency_resends_to_other_replica_on_failure);
+    CPPUNIT_TEST(weak_consistency_prefers_replica_with_lowest_get_latency);
+    CPPUNIT_TEST(weak_consistency_asks_all_buckets_on_inconsistent_split);
     CPPUNIT_TEST_SUITE_END();
 
     document::DocumentTypeRepo::SP _repo;
@@ -70,7 +75,7 @@ public:
         op.reset();
     }
 
-    void sendGet() {
+    void sendGet(spi::ReadConsistency consistency = spi::ReadConsistency::STRONG) {
         std::shared_ptr<api::GetCommand> msg(
                 new api::GetCommand(makeDocumentBucket(document::BucketId(0)), docId, "[all]"));
 
@@ -78,10 +83,21 @@ public:
                                   getDistributorBucketSpace(),
                                   msg,
                                   getDistributor().getMetrics().
-                                  gets[msg->getLoadType()]));
+                                  gets[msg->getLoadType()],
+                                  consistency));
         op->start(_sender, framework::MilliSecTime(0));
     }
 
+    void recordGetLatency(uint16_t node, uint64_t latencyMs) {
+        PendingMessageTracker& tracker(getDistributor().getPendingMessageTracker());
+        auto get = std::make_shared<api::GetCommand>(makeDocumentBucket(bucketId), docId, "[all]");
+        get->setAddress(api::StorageMessageAddress("storage", lib::NodeType::STORAGE, node));
+        tracker.insert(get);
+        getClock().addMilliSecondsToTime(latencyMs);
+        std::unique_ptr<api::StorageReply> reply(get->makeReply());
+        tracker.reply(*reply);
+    }
+
     void sendReply(uint32_t idx,
                api::ReturnCode::Result result,
                std::string authorVal, uint32_t timestamp)
@@ -159,6 +175,10 @@ public:
     void testSendToAllInvalidCopies();
     void testMultipleCopiesWithFailureOnLocalNode();
     void canGetDocumentsWhenAllReplicaNodesRetired();
+    void weak_consistency_sends_to_single_replica_when_inconsistent();
+    void weak_consistency_resends_to_other_replica_on_failure();
+    void weak_consistency_prefers_replica_with_lowest_get_latency();
+    void weak_consistency_asks_all_buckets_on_inconsistent_split();
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(GetOperationTest);
@@ -568,5 +588,86 @@ GetOperationTest::canGetDocumentsWhenAllReplicaNodesRetired()
             _sender.getCommands(true));
 }
 
+void
+GetOperationTest::weak_consistency_sends_to_single_replica_when_inconsistent()
+{
+    setClusterState("distributor:1 storage:4");
+    addNodesToBucketDB(bucketId, "0=100/3/10,1=200/4/12");
+    sendGet(spi::ReadConsistency::WEAK);
+
+    CPPUNIT_ASSERT(dynamic_cast<GetOperation&>(*op).sendsToSingleReplica());
+    CPPUNIT_ASSERT_EQUAL(
+            std::string("Get => 0"),
+            _sender.getCommands(true));
+
+    replyWithDocument();
+
+    CPPUNIT_ASSERT_EQUAL(
+            std::string("GetReply(BucketId(0x0000000000000000), doc:test:uri, "
+                        "timestamp 100) ReturnCode(NONE)"),
+            _sender.getLastReply());
+}
+
+void
+GetOperationTest::weak_consistency_resends_to_other_replica_on_failure()
+{
+    setClusterState("distributor:1 storage:4");
+    addNodesToBucketDB(bucketId, "0=100/3/10,1=200/4/12");
+    sendGet(spi::ReadConsistency::WEAK);
+
+    CPPUNIT_ASSERT_EQUAL(
+            std::string("Get => 0"),
+            _sender.getCommands(true));
+
+    replyWithFailure();
+
+    CPPUNIT_ASSERT_EQUAL(
+            std::string("Get => 0,Get => 1"),
+            _sender.getCommands(true));
+
+    replyWithDocument();
+
+    CPPUNIT_ASSERT_EQUAL(
+            std::string("GetReply(BucketId(0x0000000000000000), doc:test:uri, "
+                        "timestamp 100) ReturnCode(NONE)"),
+            _sender.getLastReply());
+}
+
+void
+GetOperationTest::weak_consistency_prefers_replica_with_lowest_get_latency()
+{
+    setClusterState("distributor:1 storage:4");
+    addNodesToBucketDB(bucketId, "1=100/3/10,2=200/4/12,3=100/3/10");
+    recordGetLatency(1, 500);
+    recordGetLatency(2, 100);
+    recordGetLatency(3, 300);
+    sendGet(spi::ReadConsistency::WEAK);
+
+    CPPUNIT_ASSERT_EQUAL(
+            std::string("Get => 2"),
+            _sender.getCommands(true));
+
+    replyWithFailure();
+
+    CPPUNIT_ASSERT_EQUAL(
+            std::string("Get => 2,Get => 3"),
+            _sender.getCommands(true));
+}
+
+void
+GetOperationTest::weak_consistency_asks_all_buckets_on_inconsistent_split()
+{
+    setClusterState("distributor:1 storage:4");
+    addNodesToBucketDB(document::BucketId(16, 0x2a52), "0=100");
+    addNodesToBucketDB(document::BucketId(17, 0x2a52), "1=200");
+    sendGet(spi::ReadConsistency::WEAK);
+
+    // The document may be in either bucket, so a single replica is not enough.
+    CPPUNIT_ASSERT(!dynamic_cast<GetOperation&>(*op).sendsToSingleReplica());
+    CPPUNIT_ASSERT_EQUAL(
+            std::string("Get => 0,Get => 1"),
+            _sender.getCommands(true));
+}
+
 } // distributor
 } // storage
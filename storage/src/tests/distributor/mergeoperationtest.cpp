@@ -31,6 +31,7 @@ class MergeOperationTest : public CppUnit::TestFixture,
     CPPUNIT_TEST(onlyMarkRedundantRetiredReplicasAsSourceOnly);
     CPPUNIT_TEST(mark_post_merge_redundant_replicas_source_only);
     CPPUNIT_TEST(merge_operation_is_blocked_by_any_busy_target_node);
+    CPPUNIT_TEST(merge_command_has_estimated_size_of_largest_copy);
     CPPUNIT_TEST_SUITE_END();
 
     std::unique_ptr<PendingMessageTracker> _pendingTracker;
@@ -45,6 +46,7 @@ protected:
     void onlyMarkRedundantRetiredReplicasAsSourceOnly();
     void mark_post_merge_redundant_replicas_source_only();
     void merge_operation_is_blocked_by_any_busy_target_node();
+    void merge_command_has_estimated_size_of_largest_copy();
 
 public:
     void setUp() override {
@@ -505,5 +507,17 @@ void MergeOperationTest::merge_operation_is_blocked_by_any_busy_target_node() {
     CPPUNIT_ASSERT(op.isBlocked(*_pendingTracker));
 }
 
+void MergeOperationTest::merge_command_has_estimated_size_of_largest_copy() {
+    getClock().setAbsoluteTimeInSeconds(10);
+    addNodesToBucketDB(document::BucketId(16, 1), "0=10/1/1000/t,1=20/3/5000,2=10/1/1000/t");
+    _distributor->enableClusterState(lib::ClusterState("distributor:1 storage:3"));
+    MergeOperation op(BucketAndNodes(makeDocumentBucket(document::BucketId(16, 1)), toVector<uint16_t>(0, 1, 2)));
+    op.setIdealStateManager(&getIdealStateManager());
+    op.start(_sender, framework::MilliSecTime(0));
+
+    const auto& cmd(dynamic_cast<api::MergeBucketCommand&>(*_sender.commands[0]));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(5000), cmd.getEstimatedMergeBytes());
+}
+
 } // distributor
 } // storage
@@ -32,6 +32,7 @@ class PendingMessageTrackerTest : public CppUnit::TestFixture {
     CPPUNIT_TEST(totalPutLatencyIsTrackedForSingleRequest);
     CPPUNIT_TEST(statsAreTrackedSeparatelyPerNode);
     CPPUNIT_TEST(onlyPutMessagesAreTracked);
+    CPPUNIT_TEST(getLatencyIsTrackedSeparatelyFromPuts);
     CPPUNIT_TEST(totalPutLatencyIsAggregatedAcrossRequests);
     CPPUNIT_TEST(clearingMessagesDoesNotAffectStats);
     CPPUNIT_TEST(timeTravellingClockLatenciesNotRegistered);
@@ -54,6 +55,7 @@ public:
     void totalPutLatencyIsTrackedForSingleRequest();
     void statsAreTrackedSeparatelyPerNode();
     void onlyPutMessagesAreTracked();
+    void getLatencyIsTrackedSeparatelyFromPuts();
     void totalPutLatencyIsAggregatedAcrossRequests();
     void clearingMessagesDoesNotAffectStats();
     void timeTravellingClockLatenciesNotRegistered();
@@ -160,10 +162,25 @@ public:
         sendPutReply(*put, RequestBuilder().atTime(1000ms + latency));
     }
 
+    void sendGetAndReplyWithLatency(uint16_t node,
+                                    std::chrono::milliseconds latency)
+    {
+        assignMockedTime(1000ms);
+        auto get = createGetToNode(node);
+        _tracker->insert(get);
+        assignMockedTime(1000ms + latency);
+        auto getReply = get->makeReply();
+        _tracker->reply(*getReply);
+    }
+
     OperationStats getNodePutOperationStats(uint16_t node) {
         return _tracker->getNodeStats(node).puts;
     }
 
+    OperationStats getNodeGetOperationStats(uint16_t node) {
+        return _tracker->getNodeStats(node).gets;
+    }
+
     PendingMessageTracker& tracker() { return *_tracker; }
     auto& clock() { return _clock; }
 
@@ -208,6 +225,16 @@ private:
         return cmd;
     }
 
+    std::shared_ptr<api::GetCommand> createGetToNode(uint16_t node) const {
+        document::BucketId bucket(16, 1234);
+        auto cmd = std::make_shared<api::GetCommand>(
+                makeDocumentBucket(bucket),
+                document::DocumentId(createDummyIdString(bucket)),
+                "[all]");
+        cmd->setAddress(makeStorageAddress(node));
+        return cmd;
+    }
+
     void assignMockedTime(std::chrono::milliseconds time) {
         _clock.setAbsoluteTimeInMicroSeconds(time.count() * 1000);
     }
@@ -552,7 +579,10 @@ PendingMessageTrackerTest::nodeStatsCanBeOutputStreamed()
     std::string expected(
             "NodeStats(puts=OperationStats("
                 "totalLatency=56789ms, "
-                "numRequests=10))");
+                "numRequests=10), "
+                "gets=OperationStats("
+                "totalLatency=0ms, "
+                "numRequests=0))");
     CPPUNIT_ASSERT_EQUAL(expected, os.str());
 }
 
@@ -609,6 +639,18 @@ PendingMessageTrackerTest::onlyPutMessagesAreTracked()
                          fixture.getNodePutOperationStats(0));
 }
 
+void
+PendingMessageTrackerTest::getLatencyIsTrackedSeparatelyFromPuts()
+{
+    Fixture fixture;
+    fixture.sendGetAndReplyWithLatency(0, 300ms);
+    fixture.sendPutAndReplyWithLatency(0, 500ms);
+    CPPUNIT_ASSERT_EQUAL(makeOpStats(300ms, 1),
+                         fixture.getNodeGetOperationStats(0));
+    CPPUNIT_ASSERT_EQUAL(makeOpStats(500ms, 1),
+                         fixture.getNodePutOperationStats(0));
+}
+
 void
 PendingMessageTrackerTest::totalPutLatencyIsAggregatedAcrossRequests()
 {
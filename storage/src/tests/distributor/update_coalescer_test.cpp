@@ -0,0 +1,124 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vdstestlib/cppunit/macros.h>
+#include <vespa/storage/distributor/update_coalescer.h>
+#include <vespa/storageapi/message/persistence.h>
+#include <vespa/document/base/testdocrepo.h>
+#include <vespa/document/datatype/documenttype.h>
+#include <vespa/document/update/arithmeticvalueupdate.h>
+#include <vespa/document/update/documentupdate.h>
+#include <vespa/document/test/make_document_bucket.h>
+
+namespace storage::distributor {
+
+using document::test::makeDocumentBucket;
+using document::ArithmeticValueUpdate;
+using document::DocumentId;
+
+class UpdateCoalescerTest : public CppUnit::TestFixture {
+    CPPUNIT_TEST_SUITE(UpdateCoalescerTest);
+    CPPUNIT_TEST(updates_to_same_document_are_merged_in_order);
+    CPPUNIT_TEST(remove_between_updates_ends_mergeable_run);
+    CPPUNIT_TEST(conditional_updates_are_not_merged);
+    CPPUNIT_TEST(reply_to_merged_update_is_expanded_to_original_updates);
+    CPPUNIT_TEST_SUITE_END();
+
+    document::TestDocRepo _testRepo;
+    const document::DocumentType* _docType;
+
+    std::shared_ptr<api::UpdateCommand> makeUpdate(const std::string& id, int32_t increment) {
+        auto update = std::make_shared<document::DocumentUpdate>(*_docType, DocumentId(id));
+        document::FieldUpdate fup(_docType->getField("headerval"));
+        fup.addUpdate(ArithmeticValueUpdate(ArithmeticValueUpdate::Add, increment));
+        update->addUpdate(fup);
+        return std::make_shared<api::UpdateCommand>(makeDocumentBucket(document::BucketId(0)),
+                                                    update, api::Timestamp(0));
+    }
+
+public:
+    void setUp() override {
+        _docType = _testRepo.getTypeRepo().getDocumentType("testdoctype1");
+    }
+
+    void updates_to_same_document_are_merged_in_order();
+    void remove_between_updates_ends_mergeable_run();
+    void conditional_updates_are_not_merged();
+    void reply_to_merged_update_is_expanded_to_original_updates();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(UpdateCoalescerTest);
+
+void UpdateCoalescerTest::updates_to_same_document_are_merged_in_order() {
+    UpdateCoalescer coalescer;
+    UpdateCoalescer::MessageQueue msgs;
+    msgs.push_back(makeUpdate("id:foo:testdoctype1::a", 1));
+    msgs.push_back(makeUpdate("id:foo:testdoctype1::b", 2));
+    msgs.push_back(makeUpdate("id:foo:testdoctype1::a", 3));
+    msgs.push_back(makeUpdate("id:foo:testdoctype1::a", 4));
+
+    CPPUNIT_ASSERT_EQUAL(size_t(2), coalescer.coalesce(msgs));
+    CPPUNIT_ASSERT_EQUAL(size_t(2), msgs.size());
+    CPPUNIT_ASSERT_EQUAL(size_t(1), coalescer.pendingMergedUpdates());
+
+    auto& merged = dynamic_cast<api::UpdateCommand&>(*msgs[0]);
+    CPPUNIT_ASSERT_EQUAL(DocumentId("id:foo:testdoctype1::a"), merged.getDocumentId());
+    const auto& fieldUpdates = merged.getUpdate()->getUpdates();
+    CPPUNIT_ASSERT_EQUAL(size_t(3), fieldUpdates.size());
+    CPPUNIT_ASSERT(makeUpdate("id:foo:testdoctype1::a", 3)->getUpdate()->getUpdates()[0] == fieldUpdates[1]);
+    CPPUNIT_ASSERT(makeUpdate("id:foo:testdoctype1::a", 4)->getUpdate()->getUpdates()[0] == fieldUpdates[2]);
+    CPPUNIT_ASSERT_EQUAL(DocumentId("id:foo:testdoctype1::b"),
+                         dynamic_cast<api::UpdateCommand&>(*msgs[1]).getDocumentId());
+}
+
+void UpdateCoalescerTest::remove_between_updates_ends_mergeable_run() {
+    UpdateCoalescer coalescer;
+    UpdateCoalescer::MessageQueue msgs;
+    msgs.push_back(makeUpdate("id:foo:testdoctype1::a", 1));
+    msgs.push_back(std::make_shared<api::RemoveCommand>(makeDocumentBucket(document::BucketId(0)),
+                                                        DocumentId("id:foo:testdoctype1::a"), 0));
+    msgs.push_back(makeUpdate("id:foo:testdoctype1::a", 2));
+
+    CPPUNIT_ASSERT_EQUAL(size_t(0), coalescer.coalesce(msgs));
+    CPPUNIT_ASSERT_EQUAL(size_t(3), msgs.size());
+    CPPUNIT_ASSERT_EQUAL(size_t(0), coalescer.pendingMergedUpdates());
+}
+
+void UpdateCoalescerTest::conditional_updates_are_not_merged() {
+    UpdateCoalescer coalescer;
+    UpdateCoalescer::MessageQueue msgs;
+    auto conditional = makeUpdate("id:foo:testdoctype1::a", 1);
+    conditional->setCondition(documentapi::TestAndSetCondition("testdoctype1.headerval > 0"));
+    CPPUNIT_ASSERT(!UpdateCoalescer::canCoalesce(*conditional));
+    msgs.push_back(makeUpdate("id:foo:testdoctype1::a", 1));
+    msgs.push_back(conditional);
+
+    CPPUNIT_ASSERT_EQUAL(size_t(0), coalescer.coalesce(msgs));
+    CPPUNIT_ASSERT_EQUAL(size_t(2), msgs.size());
+}
+
+void UpdateCoalescerTest::reply_to_merged_update_is_expanded_to_original_updates() {
+    UpdateCoalescer coalescer;
+    UpdateCoalescer::MessageQueue msgs;
+    auto first = makeUpdate("id:foo:testdoctype1::a", 1);
+    auto second = makeUpdate("id:foo:testdoctype1::a", 2);
+    msgs.push_back(first);
+    msgs.push_back(second);
+    coalescer.coalesce(msgs);
+
+    auto& merged = dynamic_cast<api::UpdateCommand&>(*msgs[0]);
+    api::UpdateReply reply(merged, 1234);
+    reply.setResult(api::ReturnCode(api::ReturnCode::BUSY, "busy"));
+    auto expanded = coalescer.expandReply(reply);
+    CPPUNIT_ASSERT_EQUAL(size_t(2), expanded.size());
+    CPPUNIT_ASSERT_EQUAL(first->getMsgId(), expanded[0]->getMsgId());
+    CPPUNIT_ASSERT_EQUAL(second->getMsgId(), expanded[1]->getMsgId());
+    for (const auto& r : expanded) {
+        CPPUNIT_ASSERT_EQUAL(api::ReturnCode::BUSY, r->getResult().getResult());
+        CPPUNIT_ASSERT_EQUAL(api::Timestamp(1234),
+                             dynamic_cast<api::UpdateReply&>(*r).getOldTimestamp());
+    }
+    CPPUNIT_ASSERT_EQUAL(size_t(0), coalescer.pendingMergedUpdates());
+    CPPUNIT_ASSERT(coalescer.expandReply(reply).empty());
+}
+
+}
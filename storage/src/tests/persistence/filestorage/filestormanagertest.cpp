@@ -86,6 +86,8 @@ struct FileStorManagerTest : public CppUnit::TestFixture {
     void testHandlerPriorityBlocking();
     void testHandlerPriorityPreempt();
     void testHandlerMulti();
+    void testHandlerStripes();
+    void testHandlerStripePriority();
     void testHandlerTimeout();
     void testHandlerPause();
     void testHandlerPausedMultiThread();
@@ -124,6 +126,8 @@ struct FileStorManagerTest : public CppUnit::TestFixture {
     CPPUNIT_TEST(testHandlerPriorityBlocking);
     CPPUNIT_TEST(testHandlerPriorityPreempt);
     CPPUNIT_TEST(testHandlerMulti);
+    CPPUNIT_TEST(testHandlerStripes);
+    CPPUNIT_TEST(testHandlerStripePriority);
     CPPUNIT_TEST(testHandlerTimeout);
     CPPUNIT_TEST(testHandlerPause);
     CPPUNIT_TEST(testHandlerPausedMultiThread);
@@ -984,6 +988,131 @@ FileStorManagerTest::testHandlerMulti()
 }
 
 
+void
+FileStorManagerTest::testHandlerStripes()
+{
+    TestName testName("testHandlerStripes");
+    DummyStorageLink top;
+    DummyStorageLink *dummyManager;
+    top.push_back(std::unique_ptr<StorageLink>(
+                          dummyManager = new DummyStorageLink));
+    top.open();
+    ForwardingMessageSender messageSender(*dummyManager);
+
+    documentapi::LoadTypeSet loadTypes("raw:");
+    FileStorMetrics metrics(loadTypes.getMetricLoadTypes());
+    metrics.initDiskMetrics(_node->getPartitions().size(), loadTypes.getMetricLoadTypes(), 1);
+
+    FileStorHandler filestorHandler(messageSender, metrics, _node->getPartitions(),
+                                    _node->getComponentRegister(), 255, 0, 4);
+    filestorHandler.setGetNextMessageTimeout(50);
+    CPPUNIT_ASSERT_EQUAL(4u, filestorHandler.getNumStripes());
+
+    std::string content("Here is some content which is in all documents");
+    document::BucketIdFactory factory;
+    const uint32_t numBuckets = 16;
+    std::set<document::BucketId> buckets;
+    for (uint32_t i = 0; i < numBuckets; i++) {
+        std::ostringstream uri;
+        uri << "userdoc:footype:" << (i + 1) << ":bar";
+        Document::SP doc(createDocument(content, uri.str()).release());
+        document::BucketId bucket(16, factory.getBucketId(doc->getId()).getRawId());
+        buckets.insert(bucket);
+        filestorHandler.schedule(
+                api::StorageMessage::SP(new api::PutCommand(makeDocumentBucket(bucket), doc, i + 1)), 0);
+        filestorHandler.schedule(
+                api::StorageMessage::SP(new api::PutCommand(makeDocumentBucket(bucket), doc, i + 101)), 0);
+    }
+    CPPUNIT_ASSERT_EQUAL(numBuckets, (uint32_t)buckets.size());
+    CPPUNIT_ASSERT_EQUAL(2 * numBuckets, filestorHandler.getQueueSize());
+
+    // A thread bound to one stripe takes work from all of them, and gets
+    // the operations queued behind the one it locked from the same stripe.
+    std::vector<FileStorHandler::LockedMessage> locks;
+    std::set<document::BucketId> lockedBuckets;
+    for (uint32_t i = 0; i < numBuckets; i++) {
+        locks.push_back(filestorHandler.getNextMessage(0, 1, 255));
+        CPPUNIT_ASSERT(locks.back().second.get());
+        lockedBuckets.insert(locks.back().first->getBucket().getBucketId());
+    }
+    CPPUNIT_ASSERT(buckets == lockedBuckets);
+    CPPUNIT_ASSERT(!filestorHandler.getNextMessage(0, 2, 255).second.get());
+
+    for (auto& lock : locks) {
+        uint64_t firstTime = getPutTime(lock.second);
+        filestorHandler.getNextMessage(0, lock, 255);
+        CPPUNIT_ASSERT_EQUAL(firstTime + 100, getPutTime(lock.second));
+    }
+    CPPUNIT_ASSERT_EQUAL(0u, filestorHandler.getQueueSize());
+}
+
+void
+FileStorManagerTest::testHandlerStripePriority()
+{
+    TestName testName("testHandlerStripePriority");
+    DummyStorageLink top;
+    DummyStorageLink *dummyManager;
+    top.push_back(std::unique_ptr<StorageLink>(
+                          dummyManager = new DummyStorageLink));
+    top.open();
+    ForwardingMessageSender messageSender(*dummyManager);
+
+    documentapi::LoadTypeSet loadTypes("raw:");
+    FileStorMetrics metrics(loadTypes.getMetricLoadTypes());
+    metrics.initDiskMetrics(_node->getPartitions().size(), loadTypes.getMetricLoadTypes(), 1);
+
+    const uint32_t numStripes = 2;
+    FileStorHandler filestorHandler(messageSender, metrics, _node->getPartitions(),
+                                    _node->getComponentRegister(), 255, 0, numStripes);
+    filestorHandler.setGetNextMessageTimeout(50);
+
+    // Find one bucket in each stripe.
+    std::string content("Here is some content which is in all documents");
+    document::BucketIdFactory factory;
+    std::vector<Document::SP> docs(numStripes);
+    std::vector<document::BucketId> buckets(numStripes);
+    for (uint32_t user = 1, found = 0; found < numStripes; ++user) {
+        std::ostringstream uri;
+        uri << "userdoc:footype:" << user << ":bar";
+        Document::SP doc(createDocument(content, uri.str()).release());
+        document::BucketId bucket(16, factory.getBucketId(doc->getId()).getRawId());
+        uint32_t stripeId = document::Bucket::hash()(makeDocumentBucket(bucket)) % numStripes;
+        if (!docs[stripeId]) {
+            docs[stripeId] = doc;
+            buckets[stripeId] = bucket;
+            ++found;
+        }
+    }
+    auto schedulePut = [&](uint32_t stripeId, uint8_t priority, api::Timestamp timestamp) {
+        auto cmd = std::make_shared<api::PutCommand>(makeDocumentBucket(buckets[stripeId]), docs[stripeId], timestamp);
+        cmd->setPriority(priority);
+        filestorHandler.schedule(cmd, 0);
+    };
+
+    // A thread that only accepts high priorities skips the low priority
+    // operation in its own stripe and takes the one in the other stripe.
+    schedulePut(0, 200, 1);
+    schedulePut(1, 50, 2);
+    auto lock = filestorHandler.getNextMessage(0, 0, 100);
+    CPPUNIT_ASSERT(lock.second.get());
+    CPPUNIT_ASSERT_EQUAL(50, (int)lock.second->getPriority());
+    CPPUNIT_ASSERT_EQUAL(buckets[1], lock.first->getBucket().getBucketId());
+    lock = FileStorHandler::LockedMessage();
+    CPPUNIT_ASSERT(!filestorHandler.getNextMessage(0, 0, 100).second.get());
+
+    // Priority order is only kept within a stripe: a thread serves its own
+    // stripe before a higher priority operation queued in another one.
+    schedulePut(1, 20, 3);
+    lock = filestorHandler.getNextMessage(0, 0, 255);
+    CPPUNIT_ASSERT(lock.second.get());
+    CPPUNIT_ASSERT_EQUAL(200, (int)lock.second->getPriority());
+    lock = filestorHandler.getNextMessage(0, 0, 255);
+    CPPUNIT_ASSERT(lock.second.get());
+    CPPUNIT_ASSERT_EQUAL(20, (int)lock.second->getPriority());
+    lock = FileStorHandler::LockedMessage();
+    CPPUNIT_ASSERT_EQUAL(0u, filestorHandler.getQueueSize());
+}
+
 void
 FileStorManagerTest::testHandlerTimeout()
 {
@@ -149,6 +149,7 @@ class MergeThrottlerTest : public CppUnit::TestFixture {
     CPPUNIT_TEST(backpressure_busy_bounces_merges_for_configured_duration);
     CPPUNIT_TEST(source_only_merges_are_not_affected_by_backpressure);
     CPPUNIT_TEST(backpressure_evicts_all_queued_merges);
+    CPPUNIT_TEST(merges_are_throttled_by_estimated_bytes);
     CPPUNIT_TEST_SUITE_END();
 public:
     void setUp() override;
@@ -181,6 +182,7 @@ public:
     void backpressure_busy_bounces_merges_for_configured_duration();
     void source_only_merges_are_not_affected_by_backpressure();
     void backpressure_evicts_all_queued_merges();
+    void merges_are_throttled_by_estimated_bytes();
 private:
     static const int _storageNodeCount = 3;
     static const int _messageWaitTime = 100;
@@ -1636,4 +1638,41 @@ void MergeThrottlerTest::backpressure_evicts_all_queued_merges() {
 
 // TODO test message queue aborting (use rendezvous functionality--make guard)
 
+void MergeThrottlerTest::merges_are_throttled_by_estimated_bytes() {
+    _throttlers[0]->setMaxMergeBytes(1000);
+    std::vector<MergeBucketCommand::Node> nodes({0, 1, 2});
+    auto sendMergeOfSize = [&](uint64_t bucket, uint64_t bytes) {
+        auto cmd = std::make_shared<MergeBucketCommand>(makeDocumentBucket(BucketId(32, bucket)), nodes, 1234, 1);
+        cmd->setEstimatedMergeBytes(bytes);
+        _topLinks[0]->sendDown(cmd);
+    };
+
+    sendMergeOfSize(0xf00001, 600);
+    _topLinks[0]->waitForMessage(MessageType::MERGEBUCKET, _messageWaitTime);
+    StorageMessage::SP fwd = _topLinks[0]->getAndRemoveMessage(MessageType::MERGEBUCKET);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(600), static_cast<MergeBucketCommand&>(*fwd).getEstimatedMergeBytes());
+
+    // Does not fit within the limit, so it is queued. A smaller merge
+    // arriving later must not overtake it.
+    sendMergeOfSize(0xf00002, 600);
+    waitUntilMergeQueueIs(*_throttlers[0], 1, _messageWaitTime);
+    sendMergeOfSize(0xf00003, 300);
+    waitUntilMergeQueueIs(*_throttlers[0], 2, _messageWaitTime);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(600), _throttlers[0]->getActiveMergeBytes());
+
+    // Once the first merge is done, both queued merges fit. Equal priority
+    // merges are started smallest first.
+    auto reply = std::make_shared<MergeBucketReply>(static_cast<const MergeBucketCommand&>(*fwd));
+    reply->setResult(ReturnCode(ReturnCode::OK, "Great success! :D-|-<"));
+    _topLinks[0]->sendDown(reply);
+    _topLinks[0]->waitForMessages(3, _messageWaitTime);
+    waitUntilMergeQueueIs(*_throttlers[0], 0, _messageWaitTime);
+
+    StorageMessage::SP first = _topLinks[0]->getAndRemoveMessage(MessageType::MERGEBUCKET);
+    CPPUNIT_ASSERT_EQUAL(BucketId(32, 0xf00003), static_cast<MergeBucketCommand&>(*first).getBucketId());
+    StorageMessage::SP second = _topLinks[0]->getAndRemoveMessage(MessageType::MERGEBUCKET);
+    CPPUNIT_ASSERT_EQUAL(BucketId(32, 0xf00002), static_cast<MergeBucketCommand&>(*second).getBucketId());
+    CPPUNIT_ASSERT_EQUAL(uint64_t(900), _throttlers[0]->getActiveMergeBytes());
+}
+
 } // namespace storage
@@ -43,6 +43,14 @@ struct TestParams
         _parallelBuckets = n;
         return *this;
     }
+    TestParams& prefetchMemoryLimit(uint64_t bytes) {
+        _prefetchMemoryLimit = bytes;
+        return *this;
+    }
+    TestParams& maxAdaptiveDocBlockSize(uint32_t bytes) {
+        _maxAdaptiveDocBlockSize = bytes;
+        return *this;
+    }
     TestParams& autoReplyError(const mbus::Error& error) {
         _autoReplyError = error;
         return *this;
@@ -51,6 +59,8 @@ struct TestParams
     uint32_t _iteratorsPerBucket {1};
     uint32_t _maxVisitorMemoryUsage {UINT32_MAX};
     uint32_t _parallelBuckets {1};
+    uint64_t _prefetchMemoryLimit {1ull << 30};
+    uint32_t _maxAdaptiveDocBlockSize {0};
     mbus::Error _autoReplyError;
 };
 
@@ -75,6 +85,9 @@ private:
     CPPUNIT_TEST(testNoMoreIteratorsSentWhileMemoryUsedAboveLimit);
     CPPUNIT_TEST(testDumpVisitorInvokesStrongReadConsistencyIteration);
     CPPUNIT_TEST(testTestVisitorInvokesWeakReadConsistencyIteration);
+    CPPUNIT_TEST(testVisitorPrefetchesIteratorsForRequestedBuckets);
+    CPPUNIT_TEST(testVisitorPrefetchIsBoundedByPrefetchMemory);
+    CPPUNIT_TEST(testDocBlockSizeGrowsWhileClientAcksAreFast);
     CPPUNIT_TEST_SUITE_END();
 
     static uint32_t docCount;
@@ -103,6 +116,9 @@ public:
     void testNoMoreIteratorsSentWhileMemoryUsedAboveLimit();
     void testDumpVisitorInvokesStrongReadConsistencyIteration();
     void testTestVisitorInvokesWeakReadConsistencyIteration();
+    void testVisitorPrefetchesIteratorsForRequestedBuckets();
+    void testVisitorPrefetchIsBoundedByPrefetchMemory();
+    void testDocBlockSizeGrowsWhileClientAcksAreFast();
     // TODO:
     void testVisitMultipleBuckets() {}
 
@@ -111,6 +127,8 @@ public:
 
     struct VisitorOptions {
         std::string visitorType{"dumpvisitor"};
+        uint32_t bucketCount{1};
+        vdslib::Parameters parameters;
 
         VisitorOptions() {}
 
@@ -118,6 +136,14 @@ public:
             visitorType = type;
             return *this;
         }
+        VisitorOptions& withBucketCount(uint32_t count) {
+            bucketCount = count;
+            return *this;
+        }
+        VisitorOptions& withParameter(vespalib::stringref key, vespalib::stringref value) {
+            parameters.set(key, value);
+            return *this;
+        }
     };
 
     std::shared_ptr<api::CreateVisitorCommand> makeCreateVisitor(
@@ -191,6 +217,12 @@ VisitorTest::initializeTest(const TestParams& params)
     config.getConfig("stor-visitor").set(
             "visitor_memory_usage_limit",
             std::to_string(params._maxVisitorMemoryUsage));
+    config.getConfig("stor-visitor").set(
+            "iterator_prefetch_memory_limit",
+            std::to_string(params._prefetchMemoryLimit));
+    config.getConfig("stor-visitor").set(
+            "max_adaptive_docblocksize",
+            std::to_string(params._maxAdaptiveDocBlockSize));
 
     std::string rootFolder = getRootFolder(config);
 
@@ -493,7 +525,10 @@ VisitorTest::makeCreateVisitor(const VisitorOptions& options)
     api::StorageMessageAddress address("storage", lib::NodeType::STORAGE, 0);
     std::shared_ptr<api::CreateVisitorCommand> cmd(
             new api::CreateVisitorCommand(makeBucketSpace(), options.visitorType, "testvis", ""));
-    cmd->addBucketToBeVisited(document::BucketId(16, 3));
+    for (uint32_t i = 0; i < options.bucketCount; ++i) {
+        cmd->addBucketToBeVisited(document::BucketId(16, 3 + i));
+    }
+    cmd->setParameters(options.parameters);
     cmd->setAddress(address);
     cmd->setMaximumPendingReplyCount(UINT32_MAX);
     cmd->setControlDestination("foo/bar");
@@ -1011,4 +1046,53 @@ VisitorTest::testTestVisitorInvokesWeakReadConsistencyIteration()
             "testvisitor", spi::ReadConsistency::WEAK);
 }
 
+void
+VisitorTest::testVisitorPrefetchesIteratorsForRequestedBuckets()
+{
+    initializeTest(TestParams().parallelBuckets(1));
+    _top->sendDown(makeCreateVisitor(VisitorOptions()
+                                             .withBucketCount(4)
+                                             .withParameter("prefetchbuckets", "2")));
+
+    // The bucket being processed plus two prefetched ones.
+    fetchMultipleCommands<CreateIteratorCommand>(*_bottom, 3);
+    CPPUNIT_ASSERT(_manager->getPrefetchBudget().getUsed() > 0);
+}
+
+void
+VisitorTest::testVisitorPrefetchIsBoundedByPrefetchMemory()
+{
+    initializeTest(TestParams().parallelBuckets(1).prefetchMemoryLimit(0));
+    _top->sendDown(makeCreateVisitor(VisitorOptions()
+                                             .withBucketCount(4)
+                                             .withParameter("prefetchbuckets", "2")));
+
+    fetchSingleCommand<CreateIteratorCommand>(*_bottom);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0), _manager->getPrefetchBudget().getUsed());
+}
+
+void
+VisitorTest::testDocBlockSizeGrowsWhileClientAcksAreFast()
+{
+    initializeTest(TestParams().maxAdaptiveDocBlockSize(64 * 1024 * 1024));
+    _top->sendDown(makeCreateVisitor());
+    sendCreateIteratorReply();
+
+    GetIterCommand::SP getIterCmd(fetchSingleCommand<GetIterCommand>(*_bottom));
+    uint32_t initialSize = getIterCmd->getMaxByteSize();
+    sendGetIterReply(*getIterCmd, api::ReturnCode(api::ReturnCode::OK), 2);
+
+    std::vector<document::Document::SP> docs;
+    std::vector<document::DocumentId> docIds;
+    std::vector<std::string> infoMessages;
+    getMessagesAndReply(2, getSession(0), docs, docIds, infoMessages);
+
+    // The next iterator may have been requested before the client acked, but
+    // the one after that must use the grown docblock size.
+    getIterCmd = fetchSingleCommand<GetIterCommand>(*_bottom);
+    sendGetIterReply(*getIterCmd, api::ReturnCode(api::ReturnCode::OK), 2);
+    getIterCmd = fetchSingleCommand<GetIterCommand>(*_bottom);
+    CPPUNIT_ASSERT(getIterCmd->getMaxByteSize() > initialSize);
+}
+
 } // namespace storage
@@ -0,0 +1,381 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "btree_bucket_database.h"
+#include <vespa/storage/common/bucketoperationlogger.h>
+#include <vespa/searchlib/btree/btree.hpp>
+#include <vespa/searchlib/btree/btreeroot.hpp>
+#include <vespa/searchlib/btree/btreeiterator.hpp>
+#include <vespa/searchlib/btree/btreenode.hpp>
+#include <vespa/searchlib/btree/btreenodeallocator.hpp>
+#include <vespa/searchlib/btree/btreenodestore.hpp>
+#include <vespa/searchlib/datastore/array_store.hpp>
+#include <vespa/vespalib/util/backtrace.h>
+#include <ostream>
+#include <cassert>
+
+#include <vespa/log/bufferedlogger.h>
+LOG_SETUP(".btreebucketdatabase");
+
+using document::BucketId;
+using search::datastore::EntryRef;
+
+namespace storage {
+
+namespace {
+
+// Replica lists with more copies than this are stored as large arrays.
+constexpr size_t MAX_SMALL_REPLICA_ARRAY_SIZE = 16;
+constexpr size_t MIN_ARRAYS_FOR_NEW_BUFFER = 8 * 1024;
+
+search::datastore::ArrayStoreConfig
+makeArrayStoreConfig()
+{
+    using search::datastore::ArrayStoreConfig;
+    return ArrayStoreConfig(MAX_SMALL_REPLICA_ARRAY_SIZE,
+                            ArrayStoreConfig::AllocSpec(0, search::datastore::EntryRefT<19>::offsetSize(),
+                                                        MIN_ARRAYS_FOR_NEW_BUFFER));
+}
+
+/*
+ * The B-tree value holds the last garbage collection timestamp in the upper
+ * 32 bits and the replica array reference in the lower 32 bits.
+ */
+uint64_t
+packValue(uint32_t lastGarbageCollection, EntryRef ref)
+{
+    return ((static_cast<uint64_t>(lastGarbageCollection) << 32u) | ref.ref());
+}
+
+uint32_t
+lastGarbageCollectionFromValue(uint64_t value)
+{
+    return static_cast<uint32_t>(value >> 32u);
+}
+
+EntryRef
+replicaRefFromValue(uint64_t value)
+{
+    return EntryRef(static_cast<uint32_t>(value & 0xffffffffu));
+}
+
+/*
+ * All buckets contained in `bucket` (including itself) have keys in the
+ * range [bucket.toKey(), end), where end is the key of the first bucket
+ * having a greater bit prefix. Returns false if no such end exists, i.e.
+ * the subtree extends to the end of the key space.
+ */
+bool
+subtreeEndKey(const BucketId& bucket, uint64_t& end)
+{
+    const uint32_t usedBits = bucket.getUsedBits();
+    if (usedBits == 0) {
+        return false;
+    }
+    const uint32_t shift = 64 - usedBits;
+    const uint64_t prefix = bucket.toKey() >> shift;
+    if (prefix == (UINT64_C(0xffffffffffffffff) >> shift)) {
+        return false;
+    }
+    end = (prefix + 1) << shift;
+    return true;
+}
+
+/*
+ * Key of the bucket with the given number of used bits from the raw
+ * id. BucketId does not strip the location bits of a bucket using
+ * zero bits, so that case is handled explicitly.
+ */
+uint64_t
+bucketKey(uint32_t usedBits, uint64_t rawId)
+{
+    return ((usedBits == 0) ? 0 : BucketId(usedBits, rawId).toKey());
+}
+
+BucketId
+childBucket(const BucketId& bucket, uint8_t bit)
+{
+    const uint32_t usedBits = bucket.getUsedBits();
+    uint64_t raw = bucket.getId() & ~(UINT64_C(1) << usedBits);
+    raw |= (static_cast<uint64_t>(bit) << usedBits);
+    return BucketId(usedBits + 1, raw);
+}
+
+void __attribute__((noinline)) log_empty_bucket_insertion(const BucketId& id) {
+    // Use buffered logging to avoid spamming the logs in case this is triggered for
+    // many buckets simultaneously.
+    LOGBP(error, "Inserted empty bucket %s into database.\n%s",
+          id.toString().c_str(), vespalib::getStackTrace(2).c_str());
+}
+
+}
+
+BTreeBucketDatabase::BTreeBucketDatabase()
+    : _tree(),
+      _store(makeArrayStoreConfig()),
+      _generationHandler()
+{
+}
+
+BTreeBucketDatabase::~BTreeBucketDatabase()
+{
+    _tree.clear();
+    commitChanges();
+}
+
+uint64_t
+BTreeBucketDatabase::valueFromEntry(const Entry& entry)
+{
+    const auto& replicas = entry->getRawNodes();
+    EntryRef ref = _store.add(ReplicaStore::ConstArrayRef(replicas.data(), replicas.size()));
+    return packValue(entry->getLastGarbageCollectionTime(), ref);
+}
+
+BucketDatabase::Entry
+BTreeBucketDatabase::entryFromIterator(const ConstIterator& iter) const
+{
+    const uint64_t value = iter.getData();
+    auto replicas = _store.get(replicaRefFromValue(value));
+    return Entry(BucketId(BucketId::keyToBucketId(iter.getKey())),
+                 BucketInfo(lastGarbageCollectionFromValue(value),
+                            std::vector<BucketCopy>(replicas.begin(), replicas.end())));
+}
+
+/*
+ * Freezes the tree so that readers see the changes just made, puts memory
+ * released by those changes on hold and frees memory that no reader can
+ * observe anymore.
+ */
+void
+BTreeBucketDatabase::commitChanges()
+{
+    _tree.getAllocator().freeze();
+    auto currentGeneration = _generationHandler.getCurrentGeneration();
+    _tree.getAllocator().transferHoldLists(currentGeneration);
+    _store.transferHoldLists(currentGeneration);
+    _generationHandler.incGeneration();
+    _generationHandler.updateFirstUsedGeneration();
+    auto firstUsed = _generationHandler.getFirstUsedGeneration();
+    _tree.getAllocator().trimHoldLists(firstUsed);
+    _store.trimHoldLists(firstUsed);
+}
+
+vespalib::GenerationHandler::Guard
+BTreeBucketDatabase::acquireReadGuard() const
+{
+    return _generationHandler.takeGuard();
+}
+
+BucketDatabase::Entry
+BTreeBucketDatabase::get(const BucketId& bucket) const
+{
+    auto iter = _tree.getFrozenView().find(bucket.toKey());
+    if (iter.valid()) {
+        return entryFromIterator(iter);
+    }
+    return Entry::createInvalid();
+}
+
+void
+BTreeBucketDatabase::remove(const BucketId& bucket)
+{
+    LOG_BUCKET_OPERATION_NO_LOCK(bucket, "REMOVING from bucket db!");
+    auto iter = _tree.find(bucket.toKey());
+    if (!iter.valid()) {
+        return;
+    }
+    _store.remove(replicaRefFromValue(iter.getData()));
+    _tree.remove(iter);
+    commitChanges();
+}
+
+void
+BTreeBucketDatabase::update(const Entry& newEntry)
+{
+    assert(newEntry.valid());
+    if (newEntry->getNodeCount() == 0) {
+        log_empty_bucket_insertion(newEntry.getBucketId());
+    }
+    LOG_BUCKET_OPERATION_NO_LOCK(
+            newEntry.getBucketId(),
+            vespalib::make_string(
+                    "bucketdb insert of %s", newEntry.toString().c_str()));
+
+    const uint64_t key = newEntry.getBucketId().toKey();
+    const uint64_t value = valueFromEntry(newEntry);
+    auto iter = _tree.lowerBound(key);
+    if (iter.valid() && (iter.getKey() == key)) {
+        _store.remove(replicaRefFromValue(iter.getData()));
+        _tree.thaw(iter);
+        iter.writeData(value);
+    } else {
+        _tree.insert(iter, key, value);
+    }
+    commitChanges();
+}
+
+void
+BTreeBucketDatabase::getParents(const BucketId& childBucket,
+                                std::vector<Entry>& entries) const
+{
+    // Every ancestor of the child sorts before the child, and the
+    // ancestor with d used bits has the lowest key of all buckets
+    // contained within it. Probe each possible ancestor in turn.
+    const auto frozenView = _tree.getFrozenView();
+    const uint64_t childKey = childBucket.toKey();
+    for (uint32_t bits = 0; bits <= childBucket.getUsedBits(); ++bits) {
+        const uint64_t parentKey = bucketKey(bits, childBucket.getRawId());
+        auto iter = frozenView.lowerBound(parentKey);
+        if (!iter.valid() || (iter.getKey() > childKey)) {
+            break;
+        }
+        if (iter.getKey() == parentKey) {
+            entries.push_back(entryFromIterator(iter));
+        }
+    }
+}
+
+void
+BTreeBucketDatabase::getAll(const BucketId& bucket,
+                            std::vector<Entry>& entries) const
+{
+    getParents(bucket, entries);
+    // The bucket itself (if present) has already been added as a parent,
+    // so only strictly contained buckets remain.
+    auto iter = _tree.getFrozenView().upperBound(bucket.toKey());
+    uint64_t end = 0;
+    const bool bounded = subtreeEndKey(bucket, end);
+    for (; iter.valid() && (!bounded || (iter.getKey() < end)); ++iter) {
+        entries.push_back(entryFromIterator(iter));
+    }
+}
+
+BucketDatabase::Entry
+BTreeBucketDatabase::upperBound(const BucketId& value) const
+{
+    auto iter = _tree.getFrozenView().upperBound(value.toKey());
+    if (iter.valid()) {
+        return entryFromIterator(iter);
+    }
+    return Entry::createInvalid();
+}
+
+void
+BTreeBucketDatabase::forEach(EntryProcessor& processor,
+                             const BucketId& after) const
+{
+    for (auto iter = _tree.getFrozenView().upperBound(after.toKey()); iter.valid(); ++iter) {
+        if (!processor.process(entryFromIterator(iter))) {
+            break;
+        }
+    }
+}
+
+void
+BTreeBucketDatabase::forEach(MutableEntryProcessor& processor,
+                             const BucketId& after)
+{
+    // The guard keeps the nodes the iterator points into alive while
+    // entries changed by the processor are written back.
+    auto guard = acquireReadGuard();
+    for (auto iter = _tree.getFrozenView().upperBound(after.toKey()); iter.valid(); ++iter) {
+        Entry entry(entryFromIterator(iter));
+        Entry original(entry);
+        const bool keepGoing = processor.process(entry);
+        if (!(entry == original)) {
+            update(entry);
+        }
+        if (!keepGoing) {
+            break;
+        }
+    }
+}
+
+uint64_t
+BTreeBucketDatabase::size() const
+{
+    return _tree.getFrozenView().size();
+}
+
+void
+BTreeBucketDatabase::clear()
+{
+    for (auto iter = _tree.begin(); iter.valid(); ++iter) {
+        _store.remove(replicaRefFromValue(iter.getData()));
+    }
+    _tree.clear();
+    commitChanges();
+}
+
+bool
+BTreeBucketDatabase::subtreeHasEntries(const BucketId& bucket) const
+{
+    auto iter = _tree.getFrozenView().lowerBound(bucket.toKey());
+    if (!iter.valid()) {
+        return false;
+    }
+    uint64_t end = 0;
+    return (!subtreeEndKey(bucket, end) || (iter.getKey() < end));
+}
+
+BucketId
+BTreeBucketDatabase::getAppropriateBucket(uint16_t minBits,
+                                          const BucketId& bid)
+{
+    // The bucket must be split at least as deep as the deepest level at
+    // which the path towards `bid` has a sibling subtree containing buckets.
+    for (int32_t bits = static_cast<int32_t>(bid.getUsedBits()) - 1; bits >= 0; --bits) {
+        const BucketId parent(bits, bid.getRawId());
+        const BucketId sibling(childBucket(parent, bid.getBit(bits) == 0 ? 1 : 0));
+        if (subtreeHasEntries(sibling)) {
+            return BucketId(std::max(static_cast<int32_t>(minBits), bits + 1), bid.getRawId());
+        }
+    }
+    return BucketId(minBits, bid.getRawId());
+}
+
+uint32_t
+BTreeBucketDatabase::childCount(const BucketId& bucket) const
+{
+    if (bucket.getUsedBits() >= BucketId::maxNumBits) {
+        return 0;
+    }
+    return (static_cast<uint32_t>(subtreeHasEntries(childBucket(bucket, 0))) +
+            static_cast<uint32_t>(subtreeHasEntries(childBucket(bucket, 1))));
+}
+
+search::MemoryUsage
+BTreeBucketDatabase::getMemoryUsage() const
+{
+    search::MemoryUsage usage = _tree.getMemoryUsage();
+    usage.merge(_store.getMemoryUsage());
+    return usage;
+}
+
+namespace {
+    struct Writer : public BucketDatabase::EntryProcessor {
+        std::ostream& _ost;
+        Writer(std::ostream& ost) : _ost(ost) {}
+        bool process(const BucketDatabase::Entry& e) override {
+            _ost << e.toString() << "\n";
+            return true;
+        }
+    };
+}
+
+void
+BTreeBucketDatabase::print(std::ostream& out, bool verbose,
+                           const std::string& indent) const
+{
+    (void) indent;
+    if (verbose) {
+        Writer writer(out);
+        forEach(writer);
+    } else {
+        out << "Size(" << size() << ") Memory("
+            << getMemoryUsage().usedBytes() << ")";
+    }
+}
+
+}
+
+template class search::datastore::ArrayStore<storage::BucketCopy>;
@@ -0,0 +1,68 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "bucketdatabase.h"
+#include <vespa/searchlib/btree/btree.h>
+#include <vespa/searchlib/datastore/array_store.h>
+#include <vespa/vespalib/util/generationhandler.h>
+
+namespace storage {
+
+/**
+ * Bucket database implementation built around a B+tree keyed on the bucket
+ * key (see document::BucketId::toKey()), which sorts buckets in the same
+ * order as the bit tree of MapBucketDatabase. The replica list of each
+ * bucket lives in an ArrayStore and the tree only holds a reference to it
+ * packed together with the last garbage collection timestamp.
+ *
+ * All changes are copy-on-write and freed memory is held back until no
+ * reader can observe it anymore. A reader thread holding the guard returned
+ * by acquireReadGuard() may therefore call any of the const functions while
+ * a single writer thread is updating the database, without any locking.
+ */
+class BTreeBucketDatabase : public BucketDatabase
+{
+public:
+    BTreeBucketDatabase();
+    ~BTreeBucketDatabase();
+
+    Entry get(const document::BucketId& bucket) const override;
+    void remove(const document::BucketId& bucket) override;
+    void getParents(const document::BucketId& childBucket, std::vector<Entry>& entries) const override;
+    void getAll(const document::BucketId& bucket, std::vector<Entry>& entries) const override;
+    void update(const Entry& newEntry) override;
+    void forEach(EntryProcessor&, const document::BucketId& after = document::BucketId()) const override;
+    void forEach(MutableEntryProcessor&, const document::BucketId& after = document::BucketId()) override;
+    uint64_t size() const override;
+    void clear() override;
+
+    uint32_t childCount(const document::BucketId&) const override;
+    Entry upperBound(const document::BucketId& value) const override;
+
+    document::BucketId getAppropriateBucket(uint16_t minBits, const document::BucketId& bid) override;
+    void print(std::ostream& out, bool verbose, const std::string& indent) const override;
+
+    /**
+     * Returns a guard that keeps all memory visible to the current
+     * frozen view of the database alive for as long as it is held.
+     */
+    vespalib::GenerationHandler::Guard acquireReadGuard() const;
+
+    search::MemoryUsage getMemoryUsage() const;
+
+private:
+    using ReplicaStore = search::datastore::ArrayStore<BucketCopy>;
+    using BTree = search::btree::BTree<uint64_t, uint64_t>;
+    using ConstIterator = BTree::ConstIterator;
+
+    BTree _tree;
+    ReplicaStore _store;
+    vespalib::GenerationHandler _generationHandler;
+
+    Entry entryFromIterator(const ConstIterator& iter) const;
+    uint64_t valueFromEntry(const Entry& entry);
+    bool subtreeHasEntries(const document::BucketId& bucket) const;
+    void commitChanges();
+};
+
+}
@@ -204,9 +204,9 @@ namespace {
 StorBucketDatabase::Entry
 BucketManager::getBucketInfo(const document::Bucket &bucket) const
 {
-    StorBucketDatabase::WrappedEntry entry(
-            _component.getBucketDatabase(bucket.getBucketSpace()).get(bucket.getBucketId(), "BucketManager::getBucketInfo"));
-    return *entry;
+    StorBucketDatabase::Entry entry;
+    _component.getBucketDatabase(bucket.getBucketSpace()).getReadOnly(bucket.getBucketId(), entry);
+    return entry;
 }
 
 void
@@ -219,8 +219,7 @@ BucketManager::updateMetrics(bool updateDocCount)
     uint32_t diskCount = _component.getDiskCount();
     if (!updateDocCount || _doneInitialized) {
         MetricsUpdater m(diskCount);
-        _component.getBucketSpaceRepo().forEachBucketChunked(
-                m, "BucketManager::updateMetrics");
+        _component.getBucketSpaceRepo().forEachBucketChunkedReadOnly(m);
         if (updateDocCount) {
             for (uint16_t i = 0; i< diskCount; i++) {
                 _metrics->disks[i]->buckets.addValue(m.disk[i].buckets);
@@ -236,8 +235,7 @@ BucketManager::updateMetrics(bool updateDocCount)
 void BucketManager::updateMinUsedBits()
 {
     MetricsUpdater m(_component.getDiskCount());
-    _component.getBucketSpaceRepo().forEachBucketChunked(
-            m, "BucketManager::updateMetrics");
+    _component.getBucketSpaceRepo().forEachBucketChunkedReadOnly(m);
     // When going through to get sizes, we also record min bits
     MinimumUsedBitsTracker& bitTracker(_component.getMinUsedBitsTracker());
     if (bitTracker.getMinUsedBits() != m.lowestUsedBit) {
@@ -335,8 +333,7 @@ BucketManager::reportStatus(std::ostream& out,
         framework::PartlyXmlStatusReporter xmlReporter(*this, out, path);
         xmlReporter << vespalib::xml::XmlTag("buckets");
         BucketDBDumper dumper(xmlReporter.getStream());
-        _component.getBucketSpaceRepo().forEachBucketChunked(
-                dumper, "BucketManager::reportStatus");
+        _component.getBucketSpaceRepo().forEachBucketChunkedReadOnly(dumper);
         xmlReporter << vespalib::xml::XmlEndTag();
     } else {
         framework::PartlyHtmlStatusReporter htmlReporter(*this);
@@ -354,7 +351,7 @@ BucketManager::dump(std::ostream& out) const
 {
     vespalib::XmlOutputStream xos(out);
     BucketDBDumper dumper(xos);
-    _component.getBucketSpaceRepo().forEachBucketChunked(dumper, "BucketManager::dump");
+    _component.getBucketSpaceRepo().forEachBucketChunkedReadOnly(dumper);
 }
 
 
@@ -595,13 +592,11 @@ BucketManager::processRequestBucketInfoCommands(document::BucketSpace bucketSpac
     if (LOG_WOULD_LOG(spam)) {
         DistributorInfoGatherer<true> builder(
                 *clusterState, result, idFac, distribution);
-        _component.getBucketDatabase(bucketSpace).chunkedAll(builder,
-                        "BucketManager::processRequestBucketInfoCommands-1");
+        _component.getBucketDatabase(bucketSpace).chunkedReadOnlyAll(builder);
     } else {
         DistributorInfoGatherer<false> builder(
                 *clusterState, result, idFac, distribution);
-        _component.getBucketDatabase(bucketSpace).chunkedAll(builder,
-                        "BucketManager::processRequestBucketInfoCommands-2");
+        _component.getBucketDatabase(bucketSpace).chunkedReadOnlyAll(builder);
     }
     _metrics->fullBucketInfoLatency.addValue(
             runStartTime.getElapsedTimeAsDouble());
@@ -174,6 +174,25 @@ public:
                     const char* clientId,
                     uint32_t chunkSize = DEFAULT_CHUNK_SIZE);
 
+    /**
+     * Iterate over the entire database contents in chunks like chunkedAll(),
+     * but without acquiring or waiting for any bucket locks. The functor sees
+     * the value most recently written back for each bucket, and must only
+     * return CONTINUE or ABORT. Intended for read-only scans (bucket info
+     * requests, metric updates) that should not stall behind operations
+     * holding bucket locks.
+     */
+    template <typename Functor>
+    void chunkedReadOnlyAll(Functor& functor,
+                            uint32_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+    /**
+     * Copy the most recently written back value for the given key into
+     * `value` without taking the bucket lock. Returns false if the key
+     * does not exist.
+     */
+    bool getReadOnly(const key_type& key, mapped_type& value);
+
     void print(std::ostream& out, bool verbose, const std::string& indent) const override;
 
     /**
@@ -271,6 +290,11 @@ private:
                           const char* clientId,
                           const uint32_t chunkSize);
 
+    template <typename Functor>
+    bool processNextReadOnlyChunk(Functor& functor,
+                                  key_type& key,
+                                  const uint32_t chunkSize);
+
     /**
      * Returns the given bucket, its super buckets and its sub buckets.
      */
@@ -417,6 +417,61 @@ LockableMap<Map>::chunkedAll(Functor& functor,
     }
 }
 
+template <typename Map>
+template <typename Functor>
+bool
+LockableMap<Map>::processNextReadOnlyChunk(Functor& functor,
+                                           key_type& key,
+                                           const uint32_t chunkSize)
+{
+    mapped_type val;
+    std::lock_guard<std::mutex> guard(_lock);
+    typename Map::iterator it(_map.lower_bound(key));
+    for (uint32_t processed = 0; processed < chunkSize; ++processed, ++it) {
+        if (it == _map.end()) {
+            return false;
+        }
+        key = it->first;
+        val = it->second;
+        Decision d(functor(const_cast<const key_type&>(key), val));
+        assert(d == CONTINUE || d == ABORT);
+        if (d == ABORT) {
+            return false;
+        }
+    }
+    if (it == _map.end()) {
+        return false;
+    }
+    key = it->first;
+    return true;
+}
+
+template <typename Map>
+template <typename Functor>
+void
+LockableMap<Map>::chunkedReadOnlyAll(Functor& functor, uint32_t chunkSize)
+{
+    key_type key{};
+    while (processNextReadOnlyChunk(functor, key, chunkSize)) {
+        // Same rationale as in chunkedAll(); let writers grab the mutex.
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+template<typename Map>
+bool
+LockableMap<Map>::getReadOnly(const key_type& key, mapped_type& value)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    bool preExisted = false;
+    typename Map::iterator it = _map.find(key, false, preExisted);
+    if (it == _map.end()) {
+        return false;
+    }
+    value = it->second;
+    return true;
+}
+
 template<typename Map>
 void
 LockableMap<Map>::print(std::ostream& out, bool verbose,
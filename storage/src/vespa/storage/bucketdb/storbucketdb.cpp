@@ -80,6 +80,18 @@ StorBucketDatabase::get(const document::BucketId& bucket,
 #endif
 }
 
+bool
+StorBucketDatabase::getReadOnly(const document::BucketId& bucket, Entry& entry)
+{
+#if __WORDSIZE == 64
+    return LockableMap<JudyMultiMap<Entry> >::getReadOnly(
+                bucket.stripUnused().toKey(), entry);
+#else
+    return LockableMap<StdMapWrapper<document::BucketId::Type, Entry> >::getReadOnly(
+                bucket.stripUnused().toKey(), entry);
+#endif
+}
+
 template class JudyMultiMap<bucketdb::StorageBucketInfo>;
 
 } // storage
@@ -46,6 +46,12 @@ public:
 
     WrappedEntry get(const document::BucketId& bucket, const char* clientId,
                      Flag flags = NONE);
+
+    /**
+     * Copy the entry for the given bucket without taking its bucket lock.
+     * Only for read-only use; see LockableMap::getReadOnly().
+     */
+    bool getReadOnly(const document::BucketId& bucket, Entry& entry);
 };
 
 } // storage
@@ -43,6 +43,13 @@ public:
         }
     }
 
+    template <typename Functor>
+    void forEachBucketChunkedReadOnly(Functor &functor) const {
+        for (const auto &elem : _map) {
+            elem.second->bucketDatabase().chunkedReadOnlyAll(functor);
+        }
+    }
+
 };
 
 }
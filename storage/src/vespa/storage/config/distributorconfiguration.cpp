@@ -26,6 +26,8 @@ DistributorConfiguration::DistributorConfiguration(StorageComponent& component)
       _maxPendingMaintenanceOps(1000),
       _maxVisitorsPerNodePerClientVisitor(4),
       _minBucketsPerVisitor(5),
+      _bucketDbMergeThreads(1),
+      _maintenanceScanBatchSize(1),
       _maxClusterClockSkew(0),
       _inhibitMergeSendingOnBusyNodeDuration(std::chrono::seconds(60)),
       _doInlineSplit(true),
@@ -34,6 +36,8 @@ DistributorConfiguration::DistributorConfiguration(StorageComponent& component)
       _enableHostInfoReporting(true),
       _disableBucketActivation(false),
       _sequenceMutatingOperations(true),
+      _coalesceConcurrentUpdates(false),
+      _useWeakReadConsistencyForClientGets(false),
       _minimumReplicaCountingMode(ReplicaCountingMode::TRUSTED)
 { }
 
@@ -144,6 +148,14 @@ DistributorConfiguration::configure(const vespa::config::content::core::StorDist
     _enableHostInfoReporting = config.enableHostInfoReporting;
     _disableBucketActivation = config.disableBucketActivation;
     _sequenceMutatingOperations = config.sequenceMutatingOperations;
+    _coalesceConcurrentUpdates = config.coalesceConcurrentUpdates;
+    _useWeakReadConsistencyForClientGets = config.useWeakReadConsistencyForClientGets;
+    if (config.bucketDbMergeThreads > 0) {
+        _bucketDbMergeThreads = config.bucketDbMergeThreads;
+    }
+    if (config.maintenanceScanBatchSize > 0) {
+        _maintenanceScanBatchSize = config.maintenanceScanBatchSize;
+    }
 
     _minimumReplicaCountingMode = config.minimumReplicaCountingMode;
 
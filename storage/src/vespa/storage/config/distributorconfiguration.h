@@ -235,6 +235,34 @@ public:
     void setSequenceMutatingOperations(bool sequenceMutations) noexcept {
         _sequenceMutatingOperations = sequenceMutations;
     }
+
+    bool getCoalesceConcurrentUpdates() const noexcept {
+        return _coalesceConcurrentUpdates;
+    }
+    void setCoalesceConcurrentUpdates(bool coalesce) noexcept {
+        _coalesceConcurrentUpdates = coalesce;
+    }
+
+    uint32_t getBucketDbMergeThreads() const noexcept {
+        return _bucketDbMergeThreads;
+    }
+    void setBucketDbMergeThreads(uint32_t threads) noexcept {
+        _bucketDbMergeThreads = threads;
+    }
+
+    uint32_t getMaintenanceScanBatchSize() const noexcept {
+        return _maintenanceScanBatchSize;
+    }
+    void setMaintenanceScanBatchSize(uint32_t batchSize) noexcept {
+        _maintenanceScanBatchSize = batchSize;
+    }
+
+    bool getUseWeakReadConsistencyForClientGets() const noexcept {
+        return _useWeakReadConsistencyForClientGets;
+    }
+    void setUseWeakReadConsistencyForClientGets(bool useWeak) noexcept {
+        _useWeakReadConsistencyForClientGets = useWeak;
+    }
     
 private:
     DistributorConfiguration(const DistributorConfiguration& other);
@@ -263,6 +291,8 @@ private:
 
     uint32_t _maxVisitorsPerNodePerClientVisitor;
     uint32_t _minBucketsPerVisitor;
+    uint32_t _bucketDbMergeThreads;
+    uint32_t _maintenanceScanBatchSize;
 
     MaintenancePriorities _maintenancePriorities;
     std::chrono::seconds _maxClusterClockSkew;
@@ -274,6 +304,8 @@ private:
     bool _enableHostInfoReporting;
     bool _disableBucketActivation;
     bool _sequenceMutatingOperations;
+    bool _coalesceConcurrentUpdates;
+    bool _useWeakReadConsistencyForClientGets;
 
     DistrConfig::MinimumReplicaCountingMode _minimumReplicaCountingMode;
     
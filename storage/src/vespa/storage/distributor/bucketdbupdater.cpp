@@ -9,6 +9,7 @@
 #include <vespa/storageapi/message/persistence.h>
 #include <vespa/storageapi/message/removelocation.h>
 #include <vespa/storageapi/message/multioperation.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/util/xmlstream.h>
 
 #include <vespa/log/bufferedlogger.h>
@@ -27,7 +28,8 @@ BucketDBUpdater::BucketDBUpdater(Distributor& owner,
     : framework::StatusReporter("bucketdb", "Bucket DB Updater"),
       _distributorComponent(owner, bucketSpaceRepo, compReg, "Bucket DB Updater"),
       _sender(sender),
-      _transitionTimer(_distributorComponent.getClock())
+      _transitionTimer(_distributorComponent.getClock()),
+      _mergeExecutor()
 {
 }
 
@@ -482,10 +484,24 @@ BucketDBUpdater::isPendingClusterStateCompleted() const
     return _pendingClusterState.get() && _pendingClusterState->done();
 }
 
+vespalib::ThreadStackExecutor*
+BucketDBUpdater::getMergeExecutor()
+{
+    const uint32_t threads = _distributorComponent.getDistributor().getConfig().getBucketDbMergeThreads();
+    if (threads <= 1) {
+        return nullptr;
+    }
+    if (!_mergeExecutor || (_mergeExecutor->getNumThreads() != threads)) {
+        _mergeExecutor = std::make_unique<vespalib::ThreadStackExecutor>(threads, 128 * 1024);
+    }
+    return _mergeExecutor.get();
+}
+
 void
 BucketDBUpdater::processCompletedPendingClusterState()
 {
-    _pendingClusterState->mergeIntoBucketDatabases();
+    _pendingClusterState->mergeIntoBucketDatabases(getMergeExecutor(),
+                                                   &_distributorComponent.getDistributor().getMetrics());
 
     if (_pendingClusterState->getCommand().get()) {
         enableCurrentClusterStateInDistributor();
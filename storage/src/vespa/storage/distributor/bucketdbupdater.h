@@ -18,6 +18,8 @@
 #include <deque>
 #include <list>
 
+namespace vespalib { class ThreadStackExecutor; }
+
 namespace storage::distributor {
 
 class Distributor;
@@ -136,6 +138,7 @@ private:
                               BucketListMerger::BucketList& existing) const;
     void ensureTransitionTimerStarted();
     void completeTransitionTimer();
+    vespalib::ThreadStackExecutor* getMergeExecutor();
     /**
      * Adds all buckets contained in the bucket database
      * that are either contained
@@ -227,6 +230,7 @@ private:
     std::set<EnqueuedBucketRecheck> _enqueuedRechecks;
     OutdatedNodesMap         _outdatedNodesMap;
     framework::MilliSecTimer _transitionTimer;
+    std::unique_ptr<vespalib::ThreadStackExecutor> _mergeExecutor;
 };
 
 }
@@ -232,6 +232,15 @@ void Distributor::onClose() {
 void
 Distributor::sendUp(const std::shared_ptr<api::StorageMessage>& msg)
 {
+    if (msg->getType().isReply()) {
+        auto expanded = _updateCoalescer.expandReply(static_cast<const api::StorageReply&>(*msg));
+        if (!expanded.empty()) {
+            for (const auto& reply : expanded) {
+                sendUp(reply);
+            }
+            return;
+        }
+    }
     _pendingMessageTracker.insert(msg);
     if (_messageSender != 0) {
         _messageSender->sendUp(msg);
@@ -359,6 +368,9 @@ Distributor::enableClusterState(const lib::ClusterState& state)
 {
     lib::ClusterState oldState = _clusterState;
     _clusterState = state;
+    for (auto& space : *_bucketSpaceRepo) {
+        space.second->clearIdealNodesCache();
+    }
 
     lib::Node myNode(lib::NodeType::DISTRIBUTOR, _component.getIndex());
 
@@ -600,6 +612,9 @@ void Distributor::handle_or_propagate_message(const std::shared_ptr<api::Storage
 }
 
 void Distributor::startExternalOperations() {
+    if (getConfig().getCoalesceConcurrentUpdates() && (_fetchedMessages.size() > 1)) {
+        _updateCoalescer.coalesce(_fetchedMessages);
+    }
     for (auto& msg : _fetchedMessages) {
         if (is_client_request(*msg)) {
             MBUS_TRACE(msg->getTrace(), 9, "Distributor: adding to client request priority queue");
@@ -681,6 +696,16 @@ Distributor::scanNextBucket()
     return scanResult;
 }
 
+void
+Distributor::scanNextBuckets(uint32_t maxBuckets)
+{
+    for (uint32_t i = 0; i < maxBuckets; ++i) {
+        if (scanNextBucket().isDone()) {
+            break;
+        }
+    }
+}
+
 void
 Distributor::startNextMaintenanceOperation()
 {
@@ -707,7 +732,7 @@ Distributor::doNonCriticalTick(framework::ThreadIndex)
     handleStatusRequests();
     startExternalOperations();
     if (!initializing()) {
-        scanNextBucket();
+        scanNextBuckets(getConfig().getMaintenanceScanBatchSize());
         startNextMaintenanceOperation();
         if (isInRecoveryMode()) {
             signalWorkWasDone();
@@ -10,6 +10,7 @@
 #include "distributorinterface.h"
 
 #include "statusreporterdelegate.h"
+#include "update_coalescer.h"
 #include "distributor_host_info_reporter.h"
 #include <vespa/storage/distributor/maintenance/maintenancescheduler.h>
 #include <vespa/storage/distributor/bucketdb/bucketdbmetricupdater.h>
@@ -214,6 +215,8 @@ private:
     void updateInternalMetricsForCompletedScan();
     void scanAllBuckets();
     MaintenanceScanner::ScanResult scanNextBucket();
+    /** Scans up to maxBuckets buckets, stopping early if the scan completes. */
+    void scanNextBuckets(uint32_t maxBuckets);
     void enableNextConfig();
     void fetchStatusRequests();
     void fetchExternalMessages();
@@ -268,6 +271,7 @@ private:
     MessageQueue _messageQueue;
     ClientRequestPriorityQueue _client_request_priority_queue;
     MessageQueue _fetchedMessages;
+    UpdateCoalescer _updateCoalescer;
     framework::TickingThreadPool& _threadPool;
     vespalib::Monitor _statusMonitor;
 
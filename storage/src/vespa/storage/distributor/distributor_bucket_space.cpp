@@ -1,18 +1,87 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "distributor_bucket_space.h"
+#include <vespa/vdslib/state/clusterstate.h>
 
 namespace storage {
 namespace distributor {
 
+namespace {
+
+// Buckets using more bits get more bits mixed into their storage seed
+constexpr uint32_t MAX_SEED_CACHED_USED_BITS = 33;
+// Only hit with a very high number of distribution bits
+constexpr size_t MAX_CACHED_SEEDS = 1 << 20;
+
+}
+
 DistributorBucketSpace::DistributorBucketSpace()
     : _bucketDatabase(),
-      _distribution()
+      _distribution(),
+      _idealNodesCache(),
+      _idealNodesUpStates(),
+      _idealNodesCacheUsable(-1)
 {
 }
 
 DistributorBucketSpace::~DistributorBucketSpace() {
 }
 
+void
+DistributorBucketSpace::clearIdealNodesCache()
+{
+    _idealNodesCache.clear();
+    _idealNodesCacheUsable = -1;
+}
+
+bool
+DistributorBucketSpace::idealNodesCacheUsable(const lib::ClusterState& state) const
+{
+    if (_idealNodesCacheUsable < 0) {
+        // With disks down, ideal nodes also depend on the ideal disk of
+        // each bucket, which uses more bits than the storage seed.
+        _idealNodesCacheUsable = 1;
+        for (uint16_t i = 0; i < state.getNodeCount(lib::NodeType::STORAGE); ++i) {
+            if (state.getNodeState(lib::Node(lib::NodeType::STORAGE, i)).isAnyDiskDown()) {
+                _idealNodesCacheUsable = 0;
+                break;
+            }
+        }
+    }
+    return (_idealNodesCacheUsable != 0);
+}
+
+std::vector<uint16_t>
+DistributorBucketSpace::getIdealNodes(const lib::ClusterState& state,
+                                      const document::BucketId& bucket,
+                                      const char* upStates) const
+{
+    uint32_t distributionBits = state.getDistributionBitCount();
+    if (bucket.getUsedBits() > MAX_SEED_CACHED_USED_BITS
+        || bucket.getUsedBits() < distributionBits
+        || !idealNodesCacheUsable(state))
+    {
+        return _distribution->getIdealStorageNodes(state, bucket, upStates);
+    }
+    if (_idealNodesUpStates != upStates) {
+        _idealNodesCache.clear();
+        _idealNodesUpStates = upStates;
+    }
+    uint32_t seed = static_cast<uint32_t>(bucket.getRawId());
+    if (distributionBits < 32) {
+        seed &= (1u << distributionBits) - 1;
+    }
+    auto itr = _idealNodesCache.find(seed);
+    if (itr != _idealNodesCache.end()) {
+        return itr->second;
+    }
+    if (_idealNodesCache.size() >= MAX_CACHED_SEEDS) {
+        _idealNodesCache.clear();
+    }
+    std::vector<uint16_t> nodes(_distribution->getIdealStorageNodes(state, bucket, upStates));
+    _idealNodesCache.emplace(seed, nodes);
+    return nodes;
+}
+
 }
 }
@@ -3,7 +3,10 @@
 
 #include <vespa/storage/bucketdb/mapbucketdatabase.h>
 #include <vespa/vdslib/distribution/distribution.h>
+#include <vespa/vespalib/stllike/string.h>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace storage {
 
@@ -23,10 +26,19 @@ namespace distributor {
  *   Each bucket space _may_ operate with its own distribution config, in
  *   particular so that redundancy, ready copies etc can differ across
  *   bucket spaces.
+ * Ideal nodes cache
+ *   Ideal storage nodes of buckets, computed from the distribution config
+ *   and the current cluster state.
  */
 class DistributorBucketSpace {
     MapBucketDatabase _bucketDatabase;
     std::shared_ptr<const lib::Distribution> _distribution;
+    // Ideal nodes per storage seed, valid for the current cluster state
+    mutable std::unordered_map<uint32_t, std::vector<uint16_t>> _idealNodesCache;
+    mutable vespalib::string _idealNodesUpStates;
+    mutable int _idealNodesCacheUsable; // -1 if not yet known for the state
+
+    bool idealNodesCacheUsable(const lib::ClusterState& state) const;
 public:
     DistributorBucketSpace();
     ~DistributorBucketSpace();
@@ -45,6 +57,7 @@ public:
 
     void setDistribution(std::shared_ptr<const lib::Distribution> distribution) {
         _distribution = std::move(distribution);
+        clearIdealNodesCache();
     }
 
     // Precondition: setDistribution has been called at least once prior.
@@ -52,6 +65,21 @@ public:
         return *_distribution;
     }
 
+    /**
+     * Returns the ideal storage nodes of the bucket in the given state.
+     * All buckets sharing their storage seed (the least significant
+     * distribution bits, for buckets using at most 33 bits) have the same
+     * ideal nodes, so the nodes are only computed once per seed.
+     *
+     * The state must be the same for all calls until the cache is cleared.
+     */
+    std::vector<uint16_t> getIdealNodes(const lib::ClusterState& state,
+                                        const document::BucketId& bucket,
+                                        const char* upStates = "uim") const;
+
+    /** Must be called whenever the cluster state changes. */
+    void clearIdealNodesCache();
+
 };
 
 }
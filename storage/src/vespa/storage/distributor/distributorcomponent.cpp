@@ -50,7 +50,7 @@ std::vector<uint16_t>
 DistributorComponent::getIdealNodes(const document::Bucket &bucket) const
 {
     auto &bucketSpace(_bucketSpaceRepo.get(bucket.getBucketSpace()));
-    return bucketSpace.getDistribution().getIdealStorageNodes(
+    return bucketSpace.getIdealNodes(
             getClusterState(),
             bucket.getBucketId(),
             _distributor.getStorageNodeUpStates());
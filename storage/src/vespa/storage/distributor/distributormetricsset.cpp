@@ -24,6 +24,10 @@ DistributorMetricSet::DistributorMetricSet(const metrics::LoadTypeSet& lt)
               "state transition is preempted before completing, its elapsed "
               "time is counted as part of the total time spent for the final, "
               "completed state transition", this),
+      bucketDbMergeTime("bucket_db_merge_time", "",
+              "Time it takes to merge the bucket info received from the "
+              "content nodes into the database of a single bucket space "
+              "when completing a cluster state transition", this),
       recoveryModeTime("recoverymodeschedulingtime", "",
               "Time spent scheduling operations in recovery mode "
               "after receiving new cluster state", this),
@@ -22,6 +22,7 @@ public:
     metrics::LoadMetric<PersistenceOperationMetricSet> multioperations;
     metrics::LoadMetric<VisitorMetricSet> visits;
     metrics::DoubleAverageMetric stateTransitionTime;
+    metrics::DoubleAverageMetric bucketDbMergeTime;
     metrics::DoubleAverageMetric recoveryModeTime;
     metrics::LongValueMetric docsStored;
     metrics::LongValueMetric bytesStored;
@@ -240,11 +240,16 @@ IMPL_MSG_COMMAND_H(ExternalOperationHandler, Get)
         return true;
     }
 
+    const spi::ReadConsistency readConsistency(
+            getDistributor().getConfig().getUseWeakReadConsistencyForClientGets()
+            ? spi::ReadConsistency::WEAK
+            : spi::ReadConsistency::STRONG);
     _op = Operation::SP(new GetOperation(
                                 *this,
                                 _bucketSpaceRepo.get(cmd->getBucket().getBucketSpace()),
                                 cmd,
-                                getMetrics().gets[cmd->getLoadType()]));
+                                getMetrics().gets[cmd->getLoadType()],
+                                readConsistency));
     return true;
 }
 
@@ -19,7 +19,7 @@ operator<<(std::ostream& os, const OperationStats& op)
 std::ostream&
 operator<<(std::ostream& os, const NodeStats& stats)
 {
-    os << "NodeStats(puts=" << stats.puts << ')';
+    os << "NodeStats(puts=" << stats.puts << ", gets=" << stats.gets << ')';
     return os;
 }
 
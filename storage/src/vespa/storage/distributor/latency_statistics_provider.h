@@ -21,6 +21,7 @@ struct OperationStats {
 
 struct NodeStats {
     OperationStats puts;
+    OperationStats gets;
 };
 
 std::ostream&
@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include "getoperation.h"
 #include <vespa/storage/distributor/distributorcomponent.h>
+#include <vespa/storage/distributor/pendingmessagetracker.h>
 #include <vespa/storage/distributor/distributormetricsset.h>
 #include <vespa/storageapi/message/persistence.h>
 #include <vespa/vdslib/state/nodestate.h>
@@ -49,7 +50,8 @@ GetOperation::GroupId::operator==(const GroupId& other) const
 GetOperation::GetOperation(DistributorComponent& manager,
                            DistributorBucketSpace &bucketSpace,
                            const std::shared_ptr<api::GetCommand> & msg,
-                           PersistenceOperationMetricSet& metric)
+                           PersistenceOperationMetricSet& metric,
+                           spi::ReadConsistency desiredReadConsistency)
     : Operation(),
       _manager(manager),
       _bucketSpace(bucketSpace),
@@ -58,9 +60,12 @@ GetOperation::GetOperation(DistributorComponent& manager,
       _doc((document::Document*)NULL),
       _lastModified(0),
       _metric(metric),
-      _operationTimer(manager.getClock())
+      _operationTimer(manager.getClock()),
+      _sendToSingleReplica(false)
 {
     assignTargetNodeGroups();
+    _sendToSingleReplica = (desiredReadConsistency == spi::ReadConsistency::WEAK
+                            && allCopiesInSameBucket());
 }
 
 void
@@ -95,6 +100,54 @@ GetOperation::findBestUnsentTarget(const GroupVector& candidates) const
     return best;
 }
 
+bool
+GetOperation::allCopiesInSameBucket() const
+{
+    for (const auto& group : _responses) {
+        if (group.first.getBucketId() != _responses.begin()->first.getBucketId()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+double
+GetOperation::averageGetLatency(uint16_t node) const
+{
+    // Nodes without any observed gets are assumed to be fast, so that they
+    // get a chance to gather statistics.
+    const OperationStats stats(
+            _manager.getDistributor().getPendingMessageTracker().getNodeStats(node).gets);
+    if (stats.numRequests == 0) {
+        return 0.0;
+    }
+    return double(stats.totalLatency.count()) / stats.numRequests;
+}
+
+void
+GetOperation::sendToTarget(DistributorMessageSender& sender,
+                           const document::BucketId& id,
+                           BucketChecksumGroup& target)
+{
+    document::Bucket bucket(_msg->getBucket().getBucketSpace(), id);
+    std::shared_ptr<api::GetCommand> command(
+            std::make_shared<api::GetCommand>(
+                    bucket,
+                    _msg->getDocumentId(),
+                    _msg->getFieldSet(),
+                    _msg->getBeforeTimestamp()));
+    copyMessageSettings(*_msg, *command);
+
+    LOG(spam,
+        "Sending %s to node %d",
+        command->toString(true).c_str(),
+        target.copy.getNode());
+
+    target.sent = sender.sendToNode(lib::NodeType::STORAGE,
+                                    target.copy.getNode(),
+                                    command);
+}
+
 bool
 GetOperation::sendForChecksum(DistributorMessageSender& sender,
                               const document::BucketId& id,
@@ -103,38 +156,57 @@ GetOperation::sendForChecksum(DistributorMessageSender& sender,
     const int best = findBestUnsentTarget(res);
 
     if (best != -1) {
-        document::Bucket bucket(_msg->getBucket().getBucketSpace(), id);
-        std::shared_ptr<api::GetCommand> command(
-                std::make_shared<api::GetCommand>(
-                        bucket,
-                        _msg->getDocumentId(),
-                        _msg->getFieldSet(),
-                        _msg->getBeforeTimestamp()));
-        copyMessageSettings(*_msg, *command);
-
-        LOG(spam,
-            "Sending %s to node %d",
-            command->toString(true).c_str(),
-            res[best].copy.getNode());
-
-        res[best].sent = sender.sendToNode(lib::NodeType::STORAGE,
-                                           res[best].copy.getNode(),
-                                           command);
+        sendToTarget(sender, id, res[best]);
         return true;
     }
 
     return false;
 }
 
+bool
+GetOperation::sendToBestReplica(DistributorMessageSender& sender)
+{
+    const document::BucketId* bestBucket = nullptr;
+    BucketChecksumGroup* best = nullptr;
+    double bestLatency = 0.0;
+    for (auto& group : _responses) {
+        for (BucketChecksumGroup& candidate : group.second) {
+            if (candidate.sent) {
+                continue;
+            }
+            if (copyIsOnLocalNode(candidate.copy)) {
+                sendToTarget(sender, group.first.getBucketId(), candidate);
+                return true; // Can't get better match than this.
+            }
+            double latency = averageGetLatency(candidate.copy.getNode());
+            if (best == nullptr || latency < bestLatency) {
+                bestBucket = &group.first.getBucketId();
+                best = &candidate;
+                bestLatency = latency;
+            }
+        }
+    }
+    if (best == nullptr) {
+        return false;
+    }
+    sendToTarget(sender, *bestBucket, *best);
+    return true;
+}
+
 void
 GetOperation::onStart(DistributorMessageSender& sender)
 {
-    // Send one request for each unique group (BucketId/checksum)
     bool sent = false;
-    for (std::map<GroupId, GroupVector>::iterator iter = _responses.begin();
-         iter != _responses.end(); ++iter)
-    {
-        sent |= sendForChecksum(sender, iter->first.getBucketId(), iter->second);
+    if (_sendToSingleReplica) {
+        // Any replica will do, other replicas are only tried on failure.
+        sent = sendToBestReplica(sender);
+    } else {
+        // Send one request for each unique group (BucketId/checksum)
+        for (std::map<GroupId, GroupVector>::iterator iter = _responses.begin();
+             iter != _responses.end(); ++iter)
+        {
+            sent |= sendForChecksum(sender, iter->first.getBucketId(), iter->second);
+        }
     }
 
     // If nothing was sent (no useful copies), just return NOT_FOUND
@@ -178,10 +250,13 @@ GetOperation::onReceive(DistributorMessageSender& sender,
                         _returnCode = getreply->getResult();
                     }
 
-                    // Try to send to another node in this checksum group.
-                    bool sent = sendForChecksum(sender,
-                                                iter->first.getBucketId(),
-                                                iter->second);
+                    // Try to send to another node in this checksum group,
+                    // or to any other replica if one replica is enough.
+                    bool sent = (_sendToSingleReplica
+                                 ? sendToBestReplica(sender)
+                                 : sendForChecksum(sender,
+                                                   iter->first.getBucketId(),
+                                                   iter->second));
                     if (sent) {
                         allDone = false;
                     }
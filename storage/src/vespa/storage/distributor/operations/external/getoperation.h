@@ -6,6 +6,7 @@
 #include <vespa/storage/bucketdb/bucketcopy.h>
 #include <vespa/storageapi/messageapi/storagemessage.h>
 #include <vespa/storageframework/generic/clock/timer.h>
+#include <vespa/persistence/spi/read_consistency.h>
 
 namespace document { class Document; }
 
@@ -26,7 +27,8 @@ public:
     GetOperation(DistributorComponent& manager,
                  DistributorBucketSpace &bucketSpace,
                  const std::shared_ptr<api::GetCommand> & msg,
-                 PersistenceOperationMetricSet& metric);
+                 PersistenceOperationMetricSet& metric,
+                 spi::ReadConsistency desiredReadConsistency = spi::ReadConsistency::STRONG);
 
     void onClose(DistributorMessageSender& sender) override;
     void onStart(DistributorMessageSender& sender) override;
@@ -36,6 +38,13 @@ public:
 
     bool hasConsistentCopies() const;
 
+    /**
+     * Returns true if the get is only sent to a single replica at a time.
+     * This is the case for weak read consistency when all replicas belong
+     * to the same bucket, regardless of whether the replicas are in sync.
+     */
+    bool sendsToSingleReplica() const { return _sendToSingleReplica; }
+
 private:
     class GroupId {
     public:
@@ -84,12 +93,22 @@ private:
 
     PersistenceOperationMetricSet& _metric;
     framework::MilliSecTimer _operationTimer;
+    bool _sendToSingleReplica;
 
     void sendReply(DistributorMessageSender& sender);
+    void sendToTarget(DistributorMessageSender& sender, const document::BucketId& id, BucketChecksumGroup& target);
     bool sendForChecksum(DistributorMessageSender& sender, const document::BucketId& id, GroupVector& res);
+    /**
+     * Sends to the unsent replica with the lowest average get latency across
+     * all checksum groups, preferring a replica on the local node. Returns
+     * false if all replicas have already been sent to.
+     */
+    bool sendToBestReplica(DistributorMessageSender& sender);
 
     void assignTargetNodeGroups();
     bool copyIsOnLocalNode(const BucketCopy&) const;
+    bool allCopiesInSameBucket() const;
+    double averageGetLatency(uint16_t node) const;
     /**
      * Returns the vector index of the target to send to, or -1 if none
      * could be found (i.e. all targets have already been sent to).
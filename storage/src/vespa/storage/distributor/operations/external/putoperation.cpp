@@ -244,6 +244,7 @@ PutOperation::sendPutToBucketOnNode(
         node);
 
     copyMessageSettings(*_msg, *command);
+    command->setSerializedDocument(_msg->getSerializedDocument());
     command->setUpdateTimestamp(_msg->getUpdateTimestamp());
     command->setCondition(_msg->getCondition());
     putBatch.push_back(MessageTracker::ToSend(command, node));
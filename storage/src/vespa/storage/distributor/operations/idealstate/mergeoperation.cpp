@@ -2,6 +2,7 @@
 #include "mergeoperation.h"
 #include <vespa/storage/distributor/idealstatemanager.h>
 #include <vespa/storage/distributor/distributor_bucket_space.h>
+#include <algorithm>
 #include <array>
 
 #include <vespa/log/bufferedlogger.h>
@@ -89,6 +90,16 @@ MergeOperation::generateSortedNodeList(
     result.swap(nodes);
 }
 
+uint64_t
+MergeOperation::estimateMergeBytes(const std::vector<MergeMetaData>& nodes)
+{
+    uint64_t bytes = 0;
+    for (const MergeMetaData& node : nodes) {
+        bytes = std::max(bytes, uint64_t(node._copy->getTotalDocumentSize()));
+    }
+    return bytes;
+}
+
 namespace {
 
 struct NodeIndexComparator
@@ -143,6 +154,7 @@ MergeOperation::onStart(DistributorMessageSender& sender)
                 _mnodes,
                 _manager->getDistributorComponent().getUniqueTimestamp(),
                 clusterState.getVersion());
+        msg->setEstimatedMergeBytes(estimateMergeBytes(nodes));
 
         // Due to merge forwarding/chaining semantics, we must always send
         // the merge command to the lowest indexed storage node involved in
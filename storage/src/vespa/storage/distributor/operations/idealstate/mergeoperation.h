@@ -46,6 +46,12 @@ public:
             const document::BucketId&, MergeLimiter&,
             std::vector<MergeMetaData>&);
 
+    /**
+     * Estimates the amount of data each node in the merge may have to
+     * read or write, which is bounded by the size of the largest copy.
+     */
+    static uint64_t estimateMergeBytes(const std::vector<MergeMetaData>&);
+
     bool shouldBlockThisOperation(uint32_t messageType, uint8_t pri) const override;
     bool isBlocked(const PendingMessageTracker& pendingMessages) const override;
 private:
@@ -5,6 +5,9 @@
 #include "pendingclusterstate.h"
 #include "distributor_bucket_space.h"
 #include <vespa/storage/common/bucketoperationlogger.h>
+#include <vespa/vespalib/util/count_down_latch.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/threadexecutor.h>
 #include <algorithm>
 
 #include <vespa/log/log.h>
@@ -16,6 +19,114 @@ using lib::Node;
 using lib::NodeType;
 using lib::NodeState;
 
+namespace {
+
+// Splitting into more ranges than threads evens out ranges with more work.
+constexpr uint32_t MERGE_RANGES_PER_THREAD = 4;
+
+}
+
+PendingBucketSpaceDbTransition::MergeState::MergeState(uint32_t iter_in, uint32_t end_in)
+    : iter(iter_in),
+      end(end_in),
+      removedBuckets(),
+      missingEntries()
+{
+}
+
+PendingBucketSpaceDbTransition::MergeState::~MergeState() = default;
+
+/**
+ * Merges the entries within one range of the bucket key space with the
+ * database entries in the same range. The database is only read, so any
+ * number of ranges may be merged concurrently as long as nobody writes to
+ * the database meanwhile. Changed entries are collected for the caller to
+ * write back.
+ */
+class PendingBucketSpaceDbTransition::RangeMerger : public BucketDatabase::EntryProcessor
+{
+    const PendingBucketSpaceDbTransition &_transition;
+    const BucketDatabase                 &_db;
+    uint64_t                              _fromKey;
+    uint64_t                              _toKey;
+    bool                                  _lastRange;
+    MergeState                            _state;
+    std::vector<BucketDatabase::Entry>    _updatedEntries;
+
+    bool inRange(const document::BucketId& bucketId) const {
+        return (_lastRange || bucketId.toKey() < _toKey);
+    }
+public:
+    RangeMerger(const PendingBucketSpaceDbTransition &transition, const BucketDatabase &db,
+                uint64_t fromKey, uint64_t toKey, bool lastRange);
+    ~RangeMerger();
+
+    bool process(const BucketDatabase::Entry& e) override {
+        if (!inRange(e.getBucketId())) {
+            return false;
+        }
+        BucketDatabase::Entry entry(e);
+        // Buckets left without replicas are removed rather than updated.
+        if (_transition.mergeEntry(entry, _state) && (entry->getNodeCount() != 0)) {
+            _updatedEntries.push_back(std::move(entry));
+        }
+        return true;
+    }
+
+    void merge();
+    const MergeState &getState() const { return _state; }
+    const std::vector<BucketDatabase::Entry> &getUpdatedEntries() const { return _updatedEntries; }
+};
+
+namespace {
+
+uint32_t
+lowerBoundIndex(const PendingBucketSpaceDbTransition::EntryList& entries, uint64_t key)
+{
+    auto itr = std::lower_bound(entries.begin(), entries.end(), key,
+                                [](const auto& entry, uint64_t rhs) { return entry.bucketId.toKey() < rhs; });
+    return (itr - entries.begin());
+}
+
+}
+
+PendingBucketSpaceDbTransition::RangeMerger::RangeMerger(const PendingBucketSpaceDbTransition &transition,
+                                                         const BucketDatabase &db,
+                                                         uint64_t fromKey, uint64_t toKey, bool lastRange)
+    : _transition(transition),
+      _db(db),
+      _fromKey(fromKey),
+      _toKey(toKey),
+      _lastRange(lastRange),
+      _state(lowerBoundIndex(transition._entries, fromKey),
+             lastRange ? transition._entries.size() : lowerBoundIndex(transition._entries, toKey)),
+      _updatedEntries()
+{
+}
+
+PendingBucketSpaceDbTransition::RangeMerger::~RangeMerger() = default;
+
+void
+PendingBucketSpaceDbTransition::RangeMerger::merge()
+{
+    // Range start keys have no used bits count, so the bucket using all
+    // bits of the preceding location is the last bucket before the range.
+    document::BucketId before;
+    if (_fromKey != 0) {
+        const uint64_t beforeKey = (((_fromKey >> 6) - 1) << 6) | document::BucketId::maxNumBits;
+        before = document::BucketId(document::BucketId::keyToBucketId(beforeKey));
+    }
+    BucketDatabase::Entry first(_db.upperBound(before));
+    if (first.valid() && process(first)) {
+        _db.forEach(*this, first.getBucketId());
+    }
+    // All of the remaining were not already in the bucket database.
+    while (_state.iter < _state.end) {
+        _state.missingEntries.push_back(_transition.skipAllForSameBucket(_state));
+    }
+}
+
+
 PendingBucketSpaceDbTransition::PendingBucketSpaceDbTransition(const PendingClusterState &pendingClusterState,
                                                                DistributorBucketSpace &distributorBucketSpace,
                                                                bool distributionChanged,
@@ -24,9 +135,7 @@ PendingBucketSpaceDbTransition::PendingBucketSpaceDbTransition(const PendingClus
                                                                const lib::ClusterState &newClusterState,
                                                                api::Timestamp creationTimestamp)
     : _entries(),
-      _iter(0),
-      _removedBuckets(),
-      _missingEntries(),
+      _mergeState(0, 0),
       _clusterInfo(std::move(clusterInfo)),
       _outdatedNodes(newClusterState.getNodeCount(NodeType::STORAGE)),
       _prevClusterState(_clusterInfo->getClusterState()),
@@ -53,22 +162,22 @@ PendingBucketSpaceDbTransition::~PendingBucketSpaceDbTransition()
 }
 
 PendingBucketSpaceDbTransition::Range
-PendingBucketSpaceDbTransition::skipAllForSameBucket()
+PendingBucketSpaceDbTransition::skipAllForSameBucket(MergeState& state) const
 {
-    Range r(_iter, _iter);
+    Range r(state.iter, state.iter);
 
-    for (document::BucketId& bid = _entries[_iter].bucketId;
-         _iter < _entries.size() && _entries[_iter].bucketId == bid;
-         ++_iter)
+    for (const document::BucketId& bid = _entries[state.iter].bucketId;
+         state.iter < state.end && _entries[state.iter].bucketId == bid;
+         ++state.iter)
     {
     }
 
-    r.second = _iter;
+    r.second = state.iter;
     return r;
 }
 
 std::vector<BucketCopy>
-PendingBucketSpaceDbTransition::getCopiesThatAreNewOrAltered(BucketDatabase::Entry& info, const Range& range)
+PendingBucketSpaceDbTransition::getCopiesThatAreNewOrAltered(BucketDatabase::Entry& info, const Range& range) const
 {
     std::vector<BucketCopy> copiesToAdd;
     for (uint32_t i = range.first; i < range.second; ++i) {
@@ -83,7 +192,7 @@ PendingBucketSpaceDbTransition::getCopiesThatAreNewOrAltered(BucketDatabase::Ent
 }
 
 void
-PendingBucketSpaceDbTransition::insertInfo(BucketDatabase::Entry& info, const Range& range)
+PendingBucketSpaceDbTransition::insertInfo(BucketDatabase::Entry& info, const Range& range) const
 {
     std::vector<BucketCopy> copiesToAddOrUpdate(
             getCopiesThatAreNewOrAltered(info, range));
@@ -103,13 +212,13 @@ PendingBucketSpaceDbTransition::insertInfo(BucketDatabase::Entry& info, const Ra
 }
 
 std::string
-PendingBucketSpaceDbTransition::requestNodesToString()
+PendingBucketSpaceDbTransition::requestNodesToString() const
 {
     return _pendingClusterState.requestNodesToString();
 }
 
 bool
-PendingBucketSpaceDbTransition::removeCopiesFromNodesThatWereRequested(BucketDatabase::Entry& e, const document::BucketId& bucketId)
+PendingBucketSpaceDbTransition::removeCopiesFromNodesThatWereRequested(BucketDatabase::Entry& e, const document::BucketId& bucketId) const
 {
     bool updated = false;
     for (uint32_t i = 0; i < e->getNodeCount();) {
@@ -138,20 +247,29 @@ PendingBucketSpaceDbTransition::removeCopiesFromNodesThatWereRequested(BucketDat
 }
 
 bool
-PendingBucketSpaceDbTransition::databaseIteratorHasPassedBucketInfoIterator(const document::BucketId& bucketId) const
+PendingBucketSpaceDbTransition::databaseIteratorHasPassedBucketInfoIterator(const document::BucketId& bucketId,
+                                                                            const MergeState& state) const
 {
-    return (_iter < _entries.size()
-            && _entries[_iter].bucketId.toKey() < bucketId.toKey());
+    return (state.iter < state.end
+            && _entries[state.iter].bucketId.toKey() < bucketId.toKey());
 }
 
 bool
-PendingBucketSpaceDbTransition::bucketInfoIteratorPointsToBucket(const document::BucketId& bucketId) const
+PendingBucketSpaceDbTransition::bucketInfoIteratorPointsToBucket(const document::BucketId& bucketId,
+                                                                 const MergeState& state) const
 {
-    return _iter < _entries.size() && _entries[_iter].bucketId == bucketId;
+    return state.iter < state.end && _entries[state.iter].bucketId == bucketId;
 }
 
 bool
 PendingBucketSpaceDbTransition::process(BucketDatabase::Entry& e)
+{
+    mergeEntry(e, _mergeState);
+    return true;
+}
+
+bool
+PendingBucketSpaceDbTransition::mergeEntry(BucketDatabase::Entry& e, MergeState& state) const
 {
     document::BucketId bucketId(e.getBucketId());
 
@@ -161,27 +279,27 @@ PendingBucketSpaceDbTransition::process(BucketDatabase::Entry& e)
         bucketId.toString().c_str(),
         e.getBucketInfo().toString().c_str());
 
-    while (databaseIteratorHasPassedBucketInfoIterator(bucketId)) {
+    while (databaseIteratorHasPassedBucketInfoIterator(bucketId, state)) {
         LOG(spam, "Found new bucket %s, adding",
-            _entries[_iter].bucketId.toString().c_str());
+            _entries[state.iter].bucketId.toString().c_str());
 
-        _missingEntries.push_back(skipAllForSameBucket());
+        state.missingEntries.push_back(skipAllForSameBucket(state));
     }
 
     bool updated(removeCopiesFromNodesThatWereRequested(e, bucketId));
 
-    if (bucketInfoIteratorPointsToBucket(bucketId)) {
+    if (bucketInfoIteratorPointsToBucket(bucketId, state)) {
         LOG(spam, "Updating bucket %s",
-            _entries[_iter].bucketId.toString().c_str());
+            _entries[state.iter].bucketId.toString().c_str());
 
-        insertInfo(e, skipAllForSameBucket());
+        insertInfo(e, skipAllForSameBucket(state));
         updated = true;
     }
 
     if (updated) {
         // Remove bucket if we've previously removed all nodes from it
         if (e->getNodeCount() == 0) {
-            _removedBuckets.push_back(bucketId);
+            state.removedBuckets.push_back(bucketId);
         } else {
             e.getBucketInfo().updateTrusted();
         }
@@ -193,11 +311,11 @@ PendingBucketSpaceDbTransition::process(BucketDatabase::Entry& e)
         bucketId.toString().c_str(),
         e.getBucketInfo().toString().c_str());
 
-    return true;
+    return updated;
 }
 
-void
-PendingBucketSpaceDbTransition::addToBucketDB(BucketDatabase& db, const Range& range)
+BucketDatabase::Entry
+PendingBucketSpaceDbTransition::createNewEntry(const Range& range) const
 {
     LOG(spam, "Adding new bucket %s with %d copies",
         _entries[range.first].bucketId.toString().c_str(),
@@ -211,29 +329,89 @@ PendingBucketSpaceDbTransition::addToBucketDB(BucketDatabase& db, const Range& r
                     .getSeconds().getTime());
     }
     e.getBucketInfo().updateTrusted();
-    db.update(e);
+    return e;
 }
 
 void
-PendingBucketSpaceDbTransition::mergeIntoBucketDatabase()
+PendingBucketSpaceDbTransition::addToBucketDB(BucketDatabase& db, const Range& range)
 {
-    BucketDatabase &db(_distributorBucketSpace.getBucketDatabase());
-    std::sort(_entries.begin(), _entries.end());
+    db.update(createNewEntry(range));
+}
 
+void
+PendingBucketSpaceDbTransition::mergeSerially(BucketDatabase& db)
+{
+    _mergeState.iter = 0;
+    _mergeState.end = _entries.size();
     db.forEach(*this);
 
-    for (uint32_t i = 0; i < _removedBuckets.size(); ++i) {
-        db.remove(_removedBuckets[i]);
+    for (uint32_t i = 0; i < _mergeState.removedBuckets.size(); ++i) {
+        db.remove(_mergeState.removedBuckets[i]);
     }
-    _removedBuckets.clear();
+    _mergeState.removedBuckets.clear();
 
     // All of the remaining were not already in the bucket database.
-    while (_iter < _entries.size()) {
-        _missingEntries.push_back(skipAllForSameBucket());
+    while (_mergeState.iter < _mergeState.end) {
+        _mergeState.missingEntries.push_back(skipAllForSameBucket(_mergeState));
+    }
+
+    for (uint32_t i = 0; i < _mergeState.missingEntries.size(); ++i) {
+        addToBucketDB(db, _mergeState.missingEntries[i]);
+    }
+}
+
+void
+PendingBucketSpaceDbTransition::mergeInParallel(BucketDatabase& db, vespalib::ThreadExecutor& executor)
+{
+    // Ranges are split on location bit boundaries, so all entries for a
+    // bucket and all buckets sharing a location end up in the same range.
+    const uint32_t numRanges = std::max(size_t(1), executor.getNumThreads()) * MERGE_RANGES_PER_THREAD;
+    const uint64_t rangeSize = (std::numeric_limits<uint64_t>::max() / numRanges) & ~uint64_t(0x3f);
+    std::vector<std::unique_ptr<RangeMerger>> mergers;
+    mergers.reserve(numRanges);
+    for (uint32_t i = 0; i < numRanges; ++i) {
+        const bool lastRange = (i + 1 == numRanges);
+        mergers.push_back(std::make_unique<RangeMerger>(*this, db, rangeSize * i,
+                                                        lastRange ? 0 : rangeSize * (i + 1), lastRange));
+    }
+    vespalib::CountDownLatch latch(numRanges);
+    for (auto& merger : mergers) {
+        executor.execute(vespalib::makeLambdaTask([&latch, merger = merger.get()]() {
+            merger->merge();
+            latch.countDown();
+        }));
+    }
+    latch.await();
+
+    // The database is only changed once all ranges have been merged, in
+    // the same order as a serial merge would change it.
+    for (const auto& merger : mergers) {
+        for (const auto& entry : merger->getUpdatedEntries()) {
+            db.update(entry);
+        }
+    }
+    for (const auto& merger : mergers) {
+        for (const auto& bucketId : merger->getState().removedBuckets) {
+            db.remove(bucketId);
+        }
     }
+    for (const auto& merger : mergers) {
+        for (const auto& range : merger->getState().missingEntries) {
+            addToBucketDB(db, range);
+        }
+    }
+}
 
-    for (uint32_t i = 0; i < _missingEntries.size(); ++i) {
-        addToBucketDB(db, _missingEntries[i]);
+void
+PendingBucketSpaceDbTransition::mergeIntoBucketDatabase(vespalib::ThreadExecutor* executor)
+{
+    BucketDatabase &db(_distributorBucketSpace.getBucketDatabase());
+    std::sort(_entries.begin(), _entries.end());
+
+    if (executor != nullptr) {
+        mergeInParallel(db, *executor);
+    } else {
+        mergeSerially(db);
     }
 }
 
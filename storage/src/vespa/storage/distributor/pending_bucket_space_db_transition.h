@@ -7,6 +7,7 @@
 
 namespace storage::api { class RequestBucketInfoReply; }
 namespace storage::lib { class ClusterState; class State; }
+namespace vespalib { class ThreadExecutor; }
 
 namespace storage::distributor {
 
@@ -28,10 +29,23 @@ public:
 private:
     using Range = std::pair<uint32_t, uint32_t>;
 
+    /**
+     * Progress when merging the sorted entries in [iter, end> with the
+     * bucket database entries covering the same part of the key space.
+     */
+    struct MergeState {
+        uint32_t                        iter;
+        uint32_t                        end;
+        std::vector<document::BucketId> removedBuckets;
+        std::vector<Range>              missingEntries;
+
+        MergeState(uint32_t iter_in, uint32_t end_in);
+        ~MergeState();
+    };
+    class RangeMerger;
+
     EntryList                                 _entries;
-    uint32_t                                  _iter;
-    std::vector<document::BucketId>           _removedBuckets;
-    std::vector<Range>                        _missingEntries;
+    MergeState                                _mergeState;
     std::shared_ptr<const ClusterInformation> _clusterInfo;
 
     // Set for all nodes that may have changed state since that previous
@@ -57,11 +71,21 @@ private:
      * the range in the entry list for which they were found.
      * The range is [from, to>
      */
-    Range skipAllForSameBucket();
+    Range skipAllForSameBucket(MergeState& state) const;
 
-    std::vector<BucketCopy> getCopiesThatAreNewOrAltered(BucketDatabase::Entry& info, const Range& range);
-    void insertInfo(BucketDatabase::Entry& info, const Range& range);
+    /**
+     * Merges the entries for the given database entry into it, recording
+     * new buckets passed on the way and buckets left without replicas in
+     * the merge state. Returns whether the entry was changed.
+     */
+    bool mergeEntry(BucketDatabase::Entry& e, MergeState& state) const;
+
+    std::vector<BucketCopy> getCopiesThatAreNewOrAltered(BucketDatabase::Entry& info, const Range& range) const;
+    void insertInfo(BucketDatabase::Entry& info, const Range& range) const;
+    BucketDatabase::Entry createNewEntry(const Range& range) const;
     void addToBucketDB(BucketDatabase& db, const Range& range);
+    void mergeSerially(BucketDatabase& db);
+    void mergeInParallel(BucketDatabase& db, vespalib::ThreadExecutor& executor);
 
     bool nodeIsOutdated(uint16_t node) const {
         return (_outdatedNodes.find(node) != _outdatedNodes.end());
@@ -70,12 +94,12 @@ private:
     // Returns whether at least one replica was removed from the entry.
     // Does NOT implicitly update trusted status on remaining replicas; caller must do
     // this explicitly.
-    bool removeCopiesFromNodesThatWereRequested(BucketDatabase::Entry& e, const document::BucketId& bucketId);
+    bool removeCopiesFromNodesThatWereRequested(BucketDatabase::Entry& e, const document::BucketId& bucketId) const;
 
     // Helper methods for iterating over _entries
-    bool databaseIteratorHasPassedBucketInfoIterator(const document::BucketId& bucketId) const;
-    bool bucketInfoIteratorPointsToBucket(const document::BucketId& bucketId) const;
-    std::string requestNodesToString();
+    bool databaseIteratorHasPassedBucketInfoIterator(const document::BucketId& bucketId, const MergeState& state) const;
+    bool bucketInfoIteratorPointsToBucket(const document::BucketId& bucketId, const MergeState& state) const;
+    std::string requestNodesToString() const;
 
     bool distributorChanged();
     static bool nodeWasUpButNowIsDown(const lib::State &old, const lib::State &nw);
@@ -99,8 +123,14 @@ public:
                                    api::Timestamp creationTimestamp);
     ~PendingBucketSpaceDbTransition();
 
-    // Merges all the results with the corresponding bucket database.
-    void mergeIntoBucketDatabase();
+    /**
+     * Merges all the results with the corresponding bucket database. If an
+     * executor is given, the bucket key space is split into ranges that are
+     * merged concurrently by its threads without touching the database. The
+     * combined changes are then applied to the database by the calling
+     * thread in one go.
+     */
+    void mergeIntoBucketDatabase(vespalib::ThreadExecutor* executor = nullptr);
 
     // Adds the info from the reply to our list of information.
     void onRequestBucketInfoReply(const api::RequestBucketInfoReply &reply, uint16_t node);
@@ -5,7 +5,9 @@
 #include "bucketdbupdater.h"
 #include "distributor_bucket_space_repo.h"
 #include "distributor_bucket_space.h"
+#include "distributormetricsset.h"
 #include <vespa/storageframework/defaultimplementation/clock/realclock.h>
+#include <vespa/storageframework/generic/clock/timer.h>
 #include <vespa/storage/common/bucketoperationlogger.h>
 #include <vespa/vespalib/util/xmlstream.hpp>
 #include <climits>
@@ -276,10 +278,18 @@ PendingClusterState::requestNodesToString() const
 }
 
 void
-PendingClusterState::mergeIntoBucketDatabases()
+PendingClusterState::mergeIntoBucketDatabases(vespalib::ThreadExecutor* mergeExecutor,
+                                              DistributorMetricSet* metrics)
 {
     for (auto &elem : _pendingTransitions) {
-        elem.second->mergeIntoBucketDatabase();
+        framework::MilliSecTimer timer(_clock);
+        elem.second->mergeIntoBucketDatabase(mergeExecutor);
+        const double elapsedMs = timer.getElapsedTimeAsDouble();
+        LOG(debug, "Merged bucket info into database of bucket space %s in %.1f ms",
+            elem.first.toString().c_str(), elapsedMs);
+        if (metrics != nullptr) {
+            metrics->bucketDbMergeTime.addValue(elapsedMs);
+        }
     }
 }
 
@@ -13,6 +13,9 @@
 #include <unordered_map>
 #include <deque>
 
+namespace vespalib { class ThreadExecutor; }
+namespace storage { class DistributorMetricSet; }
+
 namespace storage::distributor {
 
 class DistributorMessageSender;
@@ -125,8 +128,12 @@ public:
 
     /**
      * Merges all the results with the corresponding bucket databases.
+     * If an executor is given, each bucket space is merged in parallel by
+     * its threads. If metrics are given, the time spent merging each bucket
+     * space is recorded.
      */
-    void mergeIntoBucketDatabases();
+    void mergeIntoBucketDatabases(vespalib::ThreadExecutor* mergeExecutor = nullptr,
+                                  DistributorMetricSet* metrics = nullptr);
     // Get pending transition for a specific bucket space. Only used by unit test.
     PendingBucketSpaceDbTransition &getPendingBucketSpaceDbTransition(document::BucketSpace bucketSpace);
 
@@ -150,6 +150,9 @@ PendingMessageTracker::updateNodeStatsOnReply(const MessageEntry& entry)
     case api::MessageType::PUT_ID:
         updateOperationStats(stats.puts, entry);
         break;
+    case api::MessageType::GET_ID:
+        updateOperationStats(stats.gets, entry);
+        break;
     default:
         return; // Message was for type not tracked by stats.
     }
@@ -76,7 +76,7 @@ StateChecker::Context::Context(const DistributorComponent& c,
       stats(statsTracker)
 {
     idealState =
-        distribution.getIdealStorageNodes(systemState, bucket.getBucketId());
+        distributorBucketSpace.getIdealNodes(systemState, bucket.getBucketId());
     unorderedIdealState.insert(idealState.begin(), idealState.end());
 }
 
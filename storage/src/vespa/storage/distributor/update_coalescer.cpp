@@ -0,0 +1,185 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "update_coalescer.h"
+#include <vespa/storageapi/message/persistence.h>
+#include <vespa/document/datatype/documenttype.h>
+#include <vespa/document/update/documentupdate.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <algorithm>
+
+namespace storage::distributor {
+
+namespace {
+
+bool isMergeableValueUpdate(const document::ValueUpdate& update) {
+    switch (update.getType()) {
+    case document::ValueUpdate::Assign:
+    case document::ValueUpdate::Arithmetic:
+    case document::ValueUpdate::Clear:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool sameUpdateKind(const api::UpdateCommand& a, const api::UpdateCommand& b) {
+    return ((a.getBucket().getBucketSpace() == b.getBucket().getBucketSpace())
+            && (a.getUpdate()->getCreateIfNonExistent() == b.getUpdate()->getCreateIfNonExistent())
+            && (&a.getUpdate()->getType() == &b.getUpdate()->getType()));
+}
+
+const document::DocumentId* mutatedDocumentId(const api::StorageMessage& msg) {
+    const auto& type = msg.getType();
+    if ((type == api::MessageType::PUT) || (type == api::MessageType::REMOVE)
+        || (type == api::MessageType::UPDATE))
+    {
+        return &static_cast<const api::TestAndSetCommand&>(msg).getDocumentId();
+    }
+    return nullptr;
+}
+
+}
+
+UpdateCoalescer::UpdateCoalescer() = default;
+UpdateCoalescer::~UpdateCoalescer() = default;
+
+bool
+UpdateCoalescer::canCoalesce(const api::UpdateCommand& cmd)
+{
+    const auto& update = cmd.getUpdate();
+    if (!update || cmd.getCondition().isPresent() || (cmd.getOldTimestamp() != 0)
+        || !update->getFieldPathUpdates().empty())
+    {
+        return false;
+    }
+    for (const auto& fieldUpdate : update->getUpdates()) {
+        for (const auto& valueUpdate : fieldUpdate.getUpdates()) {
+            if (!isMergeableValueUpdate(*valueUpdate)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+UpdateCoalescer::UpdateCommandSP
+UpdateCoalescer::merge(const std::vector<UpdateCommandSP>& updates) const
+{
+    const api::UpdateCommand& first = *updates.front();
+    auto mergedUpdate = std::make_shared<document::DocumentUpdate>(first.getUpdate()->getType(),
+                                                                   first.getDocumentId());
+    mergedUpdate->setCreateIfNonExistent(first.getUpdate()->getCreateIfNonExistent());
+    api::Timestamp timestamp = 0;
+    uint32_t timeout = 0;
+    uint8_t priority = first.getPriority();
+    for (const auto& cmd : updates) {
+        for (const auto& fieldUpdate : cmd->getUpdate()->getUpdates()) {
+            mergedUpdate->addUpdate(fieldUpdate);
+        }
+        timestamp = std::max(timestamp, cmd->getTimestamp());
+        timeout = std::max(timeout, cmd->getTimeout());
+        priority = std::min(priority, cmd->getPriority());
+    }
+    auto merged = std::make_shared<api::UpdateCommand>(first.getBucket(), mergedUpdate, timestamp);
+    merged->setPriority(priority);
+    merged->setTimeout(timeout);
+    merged->setLoadType(first.getLoadType());
+    merged->setSourceIndex(first.getSourceIndex());
+    return merged;
+}
+
+size_t
+UpdateCoalescer::coalesce(MessageQueue& msgs)
+{
+    // Document id -> indices (into msgs) of the current run of mergeable updates.
+    vespalib::hash_map<vespalib::string, std::vector<size_t>> runs;
+    std::vector<std::vector<size_t>> closedRuns;
+    auto closeRun = [&](const vespalib::string& key) {
+        auto found = runs.find(key);
+        if (found != runs.end()) {
+            if (found->second.size() > 1) {
+                closedRuns.emplace_back(std::move(found->second));
+            }
+            runs.erase(key);
+        }
+    };
+    for (size_t i = 0; i < msgs.size(); ++i) {
+        const document::DocumentId* id = mutatedDocumentId(*msgs[i]);
+        if (id == nullptr) {
+            continue;
+        }
+        vespalib::string key(id->toString());
+        if (msgs[i]->getType() != api::MessageType::UPDATE) {
+            closeRun(key);
+            continue;
+        }
+        const auto& cmd = static_cast<const api::UpdateCommand&>(*msgs[i]);
+        if (!canCoalesce(cmd)) {
+            closeRun(key);
+            continue;
+        }
+        auto found = runs.find(key);
+        if ((found != runs.end())
+            && !sameUpdateKind(static_cast<const api::UpdateCommand&>(*msgs[found->second.front()]), cmd))
+        {
+            closeRun(key);
+            found = runs.end();
+        }
+        if (found == runs.end()) {
+            runs[key].push_back(i);
+        } else {
+            found->second.push_back(i);
+        }
+    }
+    for (auto& run : runs) {
+        if (run.second.size() > 1) {
+            closedRuns.emplace_back(std::move(run.second));
+        }
+    }
+    if (closedRuns.empty()) {
+        return 0;
+    }
+    size_t removed = 0;
+    for (const auto& run : closedRuns) {
+        std::vector<UpdateCommandSP> originals;
+        originals.reserve(run.size());
+        for (size_t idx : run) {
+            originals.push_back(std::static_pointer_cast<api::UpdateCommand>(msgs[idx]));
+        }
+        auto merged = merge(originals);
+        msgs[run.front()] = merged;
+        for (size_t i = 1; i < run.size(); ++i) {
+            msgs[run[i]].reset();
+        }
+        removed += run.size() - 1;
+        _merged[merged->getMsgId()] = std::move(originals);
+    }
+    msgs.erase(std::remove(msgs.begin(), msgs.end(), std::shared_ptr<api::StorageMessage>()), msgs.end());
+    return removed;
+}
+
+std::vector<std::shared_ptr<api::StorageReply>>
+UpdateCoalescer::expandReply(const api::StorageReply& reply)
+{
+    std::vector<std::shared_ptr<api::StorageReply>> replies;
+    if (_merged.empty() || (reply.getType() != api::MessageType::UPDATE_REPLY)) {
+        return replies;
+    }
+    auto found = _merged.find(reply.getMsgId());
+    if (found == _merged.end()) {
+        return replies;
+    }
+    const auto& updateReply = static_cast<const api::UpdateReply&>(reply);
+    replies.reserve(found->second.size());
+    for (const auto& original : found->second) {
+        auto expanded = std::make_shared<api::UpdateReply>(*original, updateReply.getOldTimestamp());
+        expanded->setResult(updateReply.getResult());
+        expanded->setBucketInfo(updateReply.getBucketInfo());
+        replies.push_back(std::move(expanded));
+    }
+    _merged.erase(found);
+    return replies;
+}
+
+}
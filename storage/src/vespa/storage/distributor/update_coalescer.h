@@ -0,0 +1,62 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/storageapi/messageapi/storagemessage.h>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace storage::api {
+class StorageReply;
+class UpdateCommand;
+}
+
+namespace storage::distributor {
+
+/**
+ * Merges client updates towards the same document that arrive within the
+ * same batch of fetched messages into a single update, so that a burst of
+ * small partial updates results in one read-modify-write cycle instead of
+ * one per update.
+ *
+ * Only updates without a test-and-set condition, without field path
+ * updates and consisting solely of assign, arithmetic or clear value
+ * updates are merged. A put or remove towards a document ends the run of
+ * updates that can be merged for it, so operation ordering per document is
+ * preserved. Field updates are applied in arrival order.
+ *
+ * The reply to a merged update is expanded into one reply per original
+ * update by expandReply().
+ */
+class UpdateCoalescer {
+public:
+    using MessageQueue = std::vector<std::shared_ptr<api::StorageMessage>>;
+    using UpdateCommandSP = std::shared_ptr<api::UpdateCommand>;
+
+    UpdateCoalescer();
+    ~UpdateCoalescer();
+
+    static bool canCoalesce(const api::UpdateCommand& cmd);
+
+    /**
+     * Replaces each run of mergeable updates towards the same document in
+     * msgs with a single merged update, placed at the position of the
+     * first update of the run. Returns the number of updates removed.
+     */
+    size_t coalesce(MessageQueue& msgs);
+
+    /**
+     * If reply is the reply to a merged update, returns one reply per
+     * original update carrying the same result. Otherwise returns an empty
+     * vector and reply should be sent as is.
+     */
+    std::vector<std::shared_ptr<api::StorageReply>> expandReply(const api::StorageReply& reply);
+
+    size_t pendingMergedUpdates() const noexcept { return _merged.size(); }
+private:
+    UpdateCommandSP merge(const std::vector<UpdateCommandSP>& updates) const;
+
+    std::unordered_map<api::StorageMessage::Id, std::vector<UpdateCommandSP>> _merged;
+};
+
+}
@@ -9,10 +9,11 @@ FileStorHandler::FileStorHandler(MessageSender& sender,
                                  const spi::PartitionStateList& partitions,
                                  ServiceLayerComponentRegister& compReg,
                                  uint8_t maxPriorityToBlock,
-                                 uint8_t minPriorityToBeBlocking)
+                                 uint8_t minPriorityToBeBlocking,
+                                 uint32_t numStripes)
     : _impl(new FileStorHandlerImpl(
                 sender, metrics, partitions, compReg,
-                maxPriorityToBlock, minPriorityToBeBlocking))
+                maxPriorityToBlock, minPriorityToBeBlocking, numStripes))
 {
 }
 
@@ -68,6 +69,12 @@ FileStorHandler::getNextMessage(uint16_t thread, uint8_t lowestPriority)
     return _impl->getNextMessage(thread, lowestPriority);
 }
 
+FileStorHandler::LockedMessage
+FileStorHandler::getNextMessage(uint16_t thread, uint32_t stripeId, uint8_t lowestPriority)
+{
+    return _impl->getNextMessage(thread, stripeId, lowestPriority);
+}
+
 FileStorHandler::LockedMessage &
 FileStorHandler::getNextMessage(uint16_t thread,
                                 LockedMessage& lck,
@@ -148,6 +155,12 @@ FileStorHandler::getQueueSize(uint16_t disk) const
     return _impl->getQueueSize(disk);
 }
 
+uint32_t
+FileStorHandler::getNumStripes() const
+{
+    return _impl->getNumStripes();
+}
+
 void
 FileStorHandler::addMergeStatus(const document::Bucket& bucket,
                                 MergeStatus::SP ms)
@@ -77,7 +77,8 @@ public:
                     const spi::PartitionStateList&,
                     ServiceLayerComponentRegister&,
                     uint8_t maxPriorityToBlock,
-                    uint8_t minPriorityToBeBlocking);
+                    uint8_t minPriorityToBeBlocking,
+                    uint32_t numStripes = 1);
     ~FileStorHandler();
 
         // Commands used by file stor manager
@@ -135,6 +136,14 @@ public:
      */
     LockedMessage getNextMessage(uint16_t disk, uint8_t lowestPriority);
 
+    /**
+     * As above, but for a thread bound to the given queue stripe of the
+     * disk. The stripe is searched first, and the thread only waits for new
+     * messages to it; the other stripes are searched when it has nothing
+     * the thread can run.
+     */
+    LockedMessage getNextMessage(uint16_t disk, uint32_t stripeId, uint8_t lowestPriority);
+
     /**
      * Returns the next message for the same bucket.
      */
@@ -267,6 +276,9 @@ public:
     uint32_t getQueueSize() const;
     uint32_t getQueueSize(uint16_t disk) const;
 
+    /** Number of stripes the queue of each disk is split into. */
+    uint32_t getNumStripes() const;
+
     // Commands used by testing
     void setGetNextMessageTimeout(uint32_t timeout);
 
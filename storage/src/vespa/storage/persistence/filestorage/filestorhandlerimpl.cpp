@@ -30,9 +30,11 @@ FileStorHandlerImpl::FileStorHandlerImpl(
         const spi::PartitionStateList& partitions,
         ServiceLayerComponentRegister& compReg,
         uint8_t maxPriorityToBlock,
-        uint8_t minPriorityToBeBlocking)
+        uint8_t minPriorityToBeBlocking,
+        uint32_t numStripes)
     : _partitions(partitions),
       _component(compReg, "filestorhandlerimpl"),
+      _numStripes(std::max(numStripes, 1u)),
       _diskInfo(_component.getDiskCount()),
       _messageSender(sender),
       _bucketIdFactory(_component.getBucketIdFactory()),
@@ -42,6 +44,7 @@ FileStorHandlerImpl::FileStorHandlerImpl(
       _paused(false)
 {
     for (uint32_t i=0; i<_diskInfo.size(); ++i) {
+        _diskInfo[i].stripes = std::vector<Stripe>(_numStripes);
         _diskInfo[i].metrics = metrics.disks[i].get();
         assert(_diskInfo[i].metrics != 0);
     }
@@ -143,10 +146,13 @@ FileStorHandlerImpl::flush(bool killPendingMerges)
     for (uint32_t i=0; i<_diskInfo.size(); ++i) {
         LOG(debug, "Wait until queues and bucket locks released for disk '%d'", i);
         Disk& t(_diskInfo[i]);
-        vespalib::MonitorGuard lockGuard(t.lock);
-        while (t.getQueueSize() != 0 || !t.lockedBuckets.empty()) {
-            LOG(debug, "Still %d in queue and %ld locked buckets for disk '%d'", t.getQueueSize(), t.lockedBuckets.size(), i);
-            lockGuard.wait(100);
+        for (Stripe& stripe : t.stripes) {
+            vespalib::MonitorGuard lockGuard(stripe.lock);
+            while (stripe.getQueueSize() != 0 || !stripe.lockedBuckets.empty()) {
+                LOG(debug, "Still %d in queue and %ld locked buckets for disk '%d'",
+                    stripe.getQueueSize(), stripe.lockedBuckets.size(), i);
+                lockGuard.wait(100);
+            }
         }
         LOG(debug, "All queues and bucket locks released for disk '%d'", i);
     }
@@ -197,17 +203,19 @@ void
 FileStorHandlerImpl::setDiskState(uint16_t disk, DiskState state)
 {
     Disk& t(_diskInfo[disk]);
-    vespalib::MonitorGuard lockGuard(t.lock);
 
     // Mark disk closed
     t.setState(state);
-    if (state != FileStorHandler::AVAILABLE) {
-        while (t.queue.begin() != t.queue.end()) {
-            reply(*t.queue.begin()->_command, state);
-            t.queue.erase(t.queue.begin());
+    for (Stripe& stripe : t.stripes) {
+        vespalib::MonitorGuard lockGuard(stripe.lock);
+        if (state != FileStorHandler::AVAILABLE) {
+            while (stripe.queue.begin() != stripe.queue.end()) {
+                reply(*stripe.queue.begin()->_command, state);
+                stripe.queue.erase(stripe.queue.begin());
+            }
         }
+        lockGuard.broadcast();
     }
-    lockGuard.broadcast();
 }
 
 FileStorHandler::DiskState
@@ -226,8 +234,10 @@ FileStorHandlerImpl::close()
         }
         LOG(debug, "Closing disk[%d]", i);
         Disk& t(_diskInfo[i]);
-        vespalib::MonitorGuard lockGuard(t.lock);
-        lockGuard.broadcast();
+        for (Stripe& stripe : t.stripes) {
+            vespalib::MonitorGuard lockGuard(stripe.lock);
+            lockGuard.broadcast();
+        }
         LOG(debug, "Closed disk[%d]", i);
     }
 }
@@ -237,9 +247,7 @@ FileStorHandlerImpl::getQueueSize() const
 {
     uint32_t count = 0;
     for (uint32_t i=0; i<_diskInfo.size(); ++i) {
-        const Disk& t(_diskInfo[i]);
-        vespalib::MonitorGuard lockGuard(t.lock);
-        count += t.getQueueSize();
+        count += _diskInfo[i].getQueueSize();
     }
     return count;
 }
@@ -251,14 +259,15 @@ FileStorHandlerImpl::schedule(const std::shared_ptr<api::StorageMessage>& msg,
     assert(disk < _diskInfo.size());
     Disk& t(_diskInfo[disk]);
     MessageEntry messageEntry(msg, getStorageMessageBucket(*msg));
-    vespalib::MonitorGuard lockGuard(t.lock);
+    Stripe& stripe(t.stripe(messageEntry._bucket));
+    vespalib::MonitorGuard lockGuard(stripe.lock);
 
     if (t.getState() == FileStorHandler::AVAILABLE) {
         MBUS_TRACE(msg->getTrace(), 5, vespalib::make_string(
                 "FileStorHandler: Operation added to disk %d's queue with "
                 "priority %u", disk, msg->getPriority()));
 
-        t.queue.emplace_back(std::move(messageEntry));
+        stripe.queue.emplace_back(std::move(messageEntry));
 
         LOG(spam, "Queued operation %s with priority %u.",
             msg->getType().toString().c_str(),
@@ -279,18 +288,10 @@ FileStorHandlerImpl::pause(uint16_t disk, uint8_t priority) const {
 
     assert(disk < _diskInfo.size());
     const Disk& t(_diskInfo[disk]);
-    vespalib::MonitorGuard lockGuard(t.lock);
-
-    bool paused = true;
-    while (paused) {
-        paused = false;
-        for (auto& lockedBucket : t.lockedBuckets) {
-            if (lockedBucket.second.priority <= _minPriorityToBeBlocking) {
-                paused = true;
-                lockGuard.wait();
-                break;
-            }
-        }
+    vespalib::MonitorGuard lockGuard(t.blockingMonitor);
+
+    while (hasBlockingOperations(t)) {
+        lockGuard.wait();
     }
 }
 
@@ -329,37 +330,38 @@ FileStorHandlerImpl::abortQueuedCommandsForBuckets(
         Disk& disk,
         const AbortBucketOperationsCommand& cmd)
 {
-    Disk& t(disk);
-    vespalib::MonitorGuard diskLock(t.lock);
     typedef PriorityQueue::iterator iter_t;
     api::ReturnCode abortedCode(api::ReturnCode::ABORTED,
                                 "Sending distributor no longer owns "
                                 "bucket operation was bound to");
-    for (iter_t it(t.queue.begin()), e(t.queue.end()); it != e;) {
-        api::StorageMessage& msg(*it->_command);
-        if (messageMayBeAborted(msg) && cmd.shouldAbort(it->_bucket)) {
-            LOG(debug,
-                "Aborting operation %s as it is bound for bucket %s",
-                msg.toString().c_str(),
-                it->_bucket.getBucketId().toString().c_str());
-            std::shared_ptr<api::StorageReply> msgReply(
-                    static_cast<api::StorageCommand&>(msg).makeReply().release());
-            msgReply->setResult(abortedCode);
-            _messageSender.sendReply(msgReply);
-            
-            it = t.queue.erase(it);
-        } else {
-            ++it;
+    for (Stripe& stripe : disk.stripes) {
+        vespalib::MonitorGuard stripeLock(stripe.lock);
+        for (iter_t it(stripe.queue.begin()), e(stripe.queue.end()); it != e;) {
+            api::StorageMessage& msg(*it->_command);
+            if (messageMayBeAborted(msg) && cmd.shouldAbort(it->_bucket)) {
+                LOG(debug,
+                    "Aborting operation %s as it is bound for bucket %s",
+                    msg.toString().c_str(),
+                    it->_bucket.getBucketId().toString().c_str());
+                std::shared_ptr<api::StorageReply> msgReply(
+                        static_cast<api::StorageCommand&>(msg).makeReply().release());
+                msgReply->setResult(abortedCode);
+                _messageSender.sendReply(msgReply);
+
+                it = stripe.queue.erase(it);
+            } else {
+                ++it;
+            }
         }
     }
 }
 
 bool
-FileStorHandlerImpl::diskHasActiveOperationForAbortedBucket(
-        const Disk& disk,
+FileStorHandlerImpl::stripeHasActiveOperationForAbortedBucket(
+        const Stripe& stripe,
         const AbortBucketOperationsCommand& cmd) const
 {
-    for (auto& lockedBucket : disk.lockedBuckets) {
+    for (auto& lockedBucket : stripe.lockedBuckets) {
         if (cmd.shouldAbort(lockedBucket.first)) {
             LOG(spam,
                 "Disk had active operation for aborted bucket %s, "
@@ -376,11 +378,13 @@ FileStorHandlerImpl::waitUntilNoActiveOperationsForAbortedBuckets(
         Disk& disk,
         const AbortBucketOperationsCommand& cmd)
 {
-    vespalib::MonitorGuard guard(disk.lock);
-    while (diskHasActiveOperationForAbortedBucket(disk, cmd)) {
-        guard.wait();
+    for (Stripe& stripe : disk.stripes) {
+        vespalib::MonitorGuard guard(stripe.lock);
+        while (stripeHasActiveOperationForAbortedBucket(stripe, cmd)) {
+            guard.wait();
+        }
+        guard.broadcast();
     }
-    guard.broadcast();
 }
 
 void
@@ -400,13 +404,7 @@ FileStorHandlerImpl::abortQueuedOperations(
 bool
 FileStorHandlerImpl::hasBlockingOperations(const Disk& t) const
 {
-    for (auto& lockedBucket : t.lockedBuckets) {
-        if (lockedBucket.second.priority <= _minPriorityToBeBlocking) {
-            return true;
-        }
-    }
-
-    return false;
+    return (t.blockingOperations.load(std::memory_order_acquire) != 0);
 }
 
 void
@@ -414,7 +412,6 @@ FileStorHandlerImpl::updateMetrics(const MetricLockGuard &)
 {
     for (uint32_t i=0; i<_diskInfo.size(); ++i) {
         const Disk& t(_diskInfo[i]);
-        vespalib::MonitorGuard lockGuard(t.lock);
         t.metrics->pendingMerges.addValue(_mergeStates.size());
         t.metrics->queueSize.addValue(t.getQueueSize());
     }
@@ -440,8 +437,9 @@ FileStorHandlerImpl::getNextMessage(uint16_t disk,
         return lck;
     }
 
-    vespalib::MonitorGuard lockGuard(t.lock);
-    BucketIdx& idx = boost::multi_index::get<2>(t.queue);
+    Stripe& stripe(t.stripe(bucket));
+    vespalib::MonitorGuard lockGuard(stripe.lock);
+    BucketIdx& idx = boost::multi_index::get<2>(stripe.queue);
     std::pair<BucketIdx::iterator, BucketIdx::iterator> range = idx.equal_range(bucket);
 
     // No more for this bucket.
@@ -546,7 +544,8 @@ FileStorHandlerImpl::takeDiskBucketLockOwnership(
         const api::StorageMessage& msg)
 {
     return std::unique_ptr<FileStorHandler::BucketLockInterface>(
-            new BucketLock(guard, disk, bucket, msg.getPriority(), msg.getSummary()));
+            new BucketLock(guard, disk, bucket, msg.getPriority(), isBlocking(msg.getPriority()),
+                           msg.getSummary()));
 }
 
 std::unique_ptr<api::StorageReply>
@@ -563,8 +562,8 @@ FileStorHandlerImpl::makeQueueTimeoutReply(api::StorageMessage& msg) const
 
 namespace {
     bool
-    bucketIsLockedOnDisk(const document::Bucket &id, const FileStorHandlerImpl::Disk &t) {
-        return (id.getBucketId().getRawId() != 0 && t.isLocked(id));
+    bucketIsLockedInStripe(const document::Bucket &id, const FileStorHandlerImpl::Stripe &stripe) {
+        return (id.getBucketId().getRawId() != 0 && stripe.isLocked(id));
     }
 
     /**
@@ -581,8 +580,41 @@ namespace {
     }
 }
 
+FileStorHandler::LockedMessage
+FileStorHandlerImpl::tryGetMessage(vespalib::MonitorGuard & guard, Disk & t, Stripe & stripe,
+                                   uint8_t maxPriority, bool & found)
+{
+    PriorityIdx& idx(boost::multi_index::get<1>(stripe.queue));
+    PriorityIdx::iterator iter(idx.begin()), end(idx.end());
+
+    while (iter != end && bucketIsLockedInStripe(iter->_bucket, stripe)) {
+        iter++;
+    }
+    if (iter != end) {
+        api::StorageMessage &m(*iter->_command);
+
+        if (operationHasHighEnoughPriorityToBeRun(m, maxPriority)
+            && ! operationBlockedByHigherPriorityThread(m, t)
+            && ! isPaused())
+        {
+            found = true;
+            return getMessage(guard, t, idx, iter);
+        }
+    }
+    found = false;
+    return {};
+}
+
 FileStorHandler::LockedMessage
 FileStorHandlerImpl::getNextMessage(uint16_t disk, uint8_t maxPriority)
+{
+    // Threads without a stripe of their own start looking in the first one
+    // and only ever wait on it.
+    return getNextMessage(disk, 0, maxPriority);
+}
+
+FileStorHandler::LockedMessage
+FileStorHandlerImpl::getNextMessage(uint16_t disk, uint32_t stripeId, uint8_t maxPriority)
 {
     assert(disk < _diskInfo.size());
     if (!tryHandlePause(disk)) {
@@ -590,30 +622,35 @@ FileStorHandlerImpl::getNextMessage(uint16_t disk, uint8_t maxPriority)
     }
 
     Disk& t(_diskInfo[disk]);
+    const uint32_t numStripes = t.stripes.size();
+    stripeId %= numStripes;
 
-    vespalib::MonitorGuard lockGuard(t.lock);
     // Try to grab a message+lock, immediately retrying once after a wait
     // if none can be found and then exiting if the same is the case on the
     // second attempt. This is key to allowing the run loop to register
-    // ticks at regular intervals while not busy-waiting.
+    // ticks at regular intervals while not busy-waiting. Each attempt first
+    // looks in the stripe of the calling thread, then in the others.
     for (int attempt = 0; (attempt < 2) && ! diskIsClosed(disk); ++attempt) {
-        PriorityIdx& idx(boost::multi_index::get<1>(t.queue));
-        PriorityIdx::iterator iter(idx.begin()), end(idx.end());
-
-        while (iter != end && bucketIsLockedOnDisk(iter->_bucket, t)) {
-            iter++;
-        }
-        if (iter != end) {
-            api::StorageMessage &m(*iter->_command);
-
-            if (operationHasHighEnoughPriorityToBeRun(m, maxPriority)
-                && ! operationBlockedByHigherPriorityThread(m, t)
-                && ! isPaused())
-            {
-                return getMessage(lockGuard, t, idx, iter);
+        for (uint32_t i = 0; i < numStripes; ++i) {
+            Stripe& stripe(t.stripes[(stripeId + i) % numStripes]);
+            vespalib::MonitorGuard lockGuard(stripe.lock);
+            bool found = false;
+            FileStorHandler::LockedMessage msg(tryGetMessage(lockGuard, t, stripe, maxPriority, found));
+            if (found) {
+                return msg;
             }
         }
         if (attempt == 0) {
+            // A message may have been queued to our stripe after we scanned
+            // it, and its signal would then be lost. Look again under the
+            // lock we wait on before going to sleep.
+            Stripe& stripe(t.stripes[stripeId]);
+            vespalib::MonitorGuard lockGuard(stripe.lock);
+            bool found = false;
+            FileStorHandler::LockedMessage msg(tryGetMessage(lockGuard, t, stripe, maxPriority, found));
+            if (found) {
+                return msg;
+            }
             lockGuard.wait(_getNextMessageTimeout);
         }
     }
@@ -662,9 +699,10 @@ FileStorHandlerImpl::lock(const document::Bucket &bucket, uint16_t disk)
         bucket.getBucketId().toString().c_str(),
         disk);
 
-    vespalib::MonitorGuard lockGuard(t.lock);
+    Stripe& stripe(t.stripe(bucket));
+    vespalib::MonitorGuard lockGuard(stripe.lock);
 
-    while (bucket.getBucketId().getRawId() != 0 && t.isLocked(bucket)) {
+    while (bucket.getBucketId().getRawId() != 0 && stripe.isLocked(bucket)) {
         LOG(spam,
             "Contending for filestor lock for %s",
             bucket.getBucketId().toString().c_str());
@@ -672,7 +710,7 @@ FileStorHandlerImpl::lock(const document::Bucket &bucket, uint16_t disk)
     }
 
     std::shared_ptr<FileStorHandler::BucketLockInterface> locker(
-            new BucketLock(lockGuard, t, bucket, 255, "External lock"));
+            new BucketLock(lockGuard, t, bucket, 255, isBlocking(255), "External lock"));
 
     lockGuard.broadcast();
     return locker;
@@ -680,16 +718,16 @@ FileStorHandlerImpl::lock(const document::Bucket &bucket, uint16_t disk)
 
 namespace {
     struct MultiLockGuard {
-        std::map<uint16_t, vespalib::Monitor*> monitors;
+        std::map<uint32_t, vespalib::Monitor*> monitors;
         std::vector<std::shared_ptr<vespalib::MonitorGuard> > guards;
 
         MultiLockGuard() {}
 
-        void addLock(vespalib::Monitor& monitor, uint16_t index) {
+        void addLock(vespalib::Monitor& monitor, uint32_t index) {
             monitors[index] = &monitor;
         }
         void lock() {
-            for (std::map<uint16_t, vespalib::Monitor*>::iterator it
+            for (std::map<uint32_t, vespalib::Monitor*>::iterator it
                     = monitors.begin(); it != monitors.end(); ++it)
             {
                 guards.push_back(std::shared_ptr<vespalib::MonitorGuard>(
@@ -1049,7 +1087,7 @@ FileStorHandlerImpl::remapQueueNoLock(
         std::vector<RemapInfo*>& targets,
         Operation op)
 {
-    BucketIdx& idx(boost::multi_index::get<2>(from.queue));
+    BucketIdx& idx(boost::multi_index::get<2>(from.stripe(source.bucket).queue));
     std::pair<BucketIdx::iterator, BucketIdx::iterator> range(
             idx.equal_range(source.bucket));
 
@@ -1099,8 +1137,9 @@ FileStorHandlerImpl::remapQueueNoLock(
             }
         } else {
             entry._bucket = bucket;
-            // Move to correct disk queue if needed
-            _diskInfo[targetDisk].queue.emplace_back(std::move(entry));
+            // Move to correct disk queue if needed. The stripe of the new
+            // bucket on the target disk is always among the locked ones.
+            _diskInfo[targetDisk].stripe(bucket).queue.emplace_back(std::move(entry));
         }
     }
 
@@ -1116,11 +1155,11 @@ FileStorHandlerImpl::remapQueue(
     MultiLockGuard guard;
 
     Disk& from(_diskInfo[source.diskIndex]);
-    guard.addLock(from.lock, source.diskIndex);
+    guard.addLock(from.stripe(source.bucket).lock, globalStripeIndex(source.diskIndex, source.bucket));
 
     Disk& to1(_diskInfo[target.diskIndex]);
     if (target.bucket.getBucketId().getRawId() != 0) {
-        guard.addLock(to1.lock, target.diskIndex);
+        guard.addLock(to1.stripe(target.bucket).lock, globalStripeIndex(target.diskIndex, target.bucket));
     }
 
     std::vector<RemapInfo*> targets;
@@ -1143,16 +1182,16 @@ FileStorHandlerImpl::remapQueue(
     MultiLockGuard guard;
 
     Disk& from(_diskInfo[source.diskIndex]);
-    guard.addLock(from.lock, source.diskIndex);
+    guard.addLock(from.stripe(source.bucket).lock, globalStripeIndex(source.diskIndex, source.bucket));
 
     Disk& to1(_diskInfo[target1.diskIndex]);
     if (target1.bucket.getBucketId().getRawId() != 0) {
-        guard.addLock(to1.lock, target1.diskIndex);
+        guard.addLock(to1.stripe(target1.bucket).lock, globalStripeIndex(target1.diskIndex, target1.bucket));
     }
 
     Disk& to2(_diskInfo[target2.diskIndex]);
     if (target2.bucket.getBucketId().getRawId() != 0) {
-        guard.addLock(to2.lock, target2.diskIndex);
+        guard.addLock(to2.stripe(target2.bucket).lock, globalStripeIndex(target2.diskIndex, target2.bucket));
     }
 
     guard.lock();
@@ -1169,7 +1208,7 @@ FileStorHandlerImpl::failOperations(
         const document::Bucket &bucket, uint16_t fromDisk,
         const api::ReturnCode& err)
 {
-    Disk& from(_diskInfo[fromDisk]);
+    Stripe& from(_diskInfo[fromDisk].stripe(bucket));
     vespalib::MonitorGuard lockGuard(from.lock);
 
     BucketIdx& idx(boost::multi_index::get<2>(from.queue));
@@ -1233,34 +1272,45 @@ FileStorHandlerImpl::MessageEntry::MessageEntry(MessageEntry && entry) noexcept
 
 FileStorHandlerImpl::MessageEntry::~MessageEntry() { }
 
-FileStorHandlerImpl::Disk::Disk()
+FileStorHandlerImpl::Stripe::Stripe()
     : lock(),
       queue(),
-      lockedBuckets(100),
-      metrics(0),
-      state(FileStorHandler::AVAILABLE)
+      lockedBuckets(100)
 { }
 
-FileStorHandlerImpl::Disk::~Disk() { }
+FileStorHandlerImpl::Stripe::~Stripe() { }
 
 bool
-FileStorHandlerImpl::Disk::isLocked(const document::Bucket& bucket) const noexcept
+FileStorHandlerImpl::Stripe::isLocked(const document::Bucket& bucket) const noexcept
 {
     return (lockedBuckets.find(bucket) != lockedBuckets.end());
 }
 
+FileStorHandlerImpl::Disk::Disk()
+    : stripes(1),
+      metrics(0),
+      blockingOperations(0),
+      blockingMonitor(),
+      state(FileStorHandler::AVAILABLE)
+{ }
+
+FileStorHandlerImpl::Disk::~Disk() { }
+
 uint32_t
-FileStorHandlerImpl::Disk::getQueueSize() const noexcept
+FileStorHandlerImpl::Disk::getQueueSize() const
 {
-    return queue.size();
+    uint32_t count = 0;
+    for (const Stripe& stripe : stripes) {
+        vespalib::MonitorGuard lockGuard(stripe.lock);
+        count += stripe.getQueueSize();
+    }
+    return count;
 }
 
 uint32_t
 FileStorHandlerImpl::getQueueSize(uint16_t disk) const
 {
-    const Disk& t(_diskInfo[disk]);
-    vespalib::MonitorGuard lockGuard(t.lock);
-    return t.getQueueSize();
+    return _diskInfo[disk].getQueueSize();
 }
 
 FileStorHandlerImpl::BucketLock::BucketLock(
@@ -1268,16 +1318,21 @@ FileStorHandlerImpl::BucketLock::BucketLock(
         Disk& disk,
         const document::Bucket &bucket,
         uint8_t priority,
+        bool blocking,
         const vespalib::stringref & statusString)
     : _disk(disk),
-      _bucket(bucket)
+      _bucket(bucket),
+      _blocking(blocking && (bucket.getBucketId().getRawId() != 0))
 {
     (void) guard;
     if (_bucket.getBucketId().getRawId() != 0) {
         // Lock the bucket and wait until it is not the current operation for
         // the disk itself.
-        _disk.lockedBuckets.insert(
-                std::make_pair(_bucket, Disk::LockEntry(priority, statusString)));
+        _disk.stripe(_bucket).lockedBuckets.insert(
+                std::make_pair(_bucket, LockEntry(priority, statusString)));
+        if (_blocking) {
+            _disk.blockingOperations.fetch_add(1, std::memory_order_acq_rel);
+        }
         LOG(debug,
             "Locked bucket %s with priority %u",
             bucket.getBucketId().toString().c_str(),
@@ -1293,14 +1348,19 @@ FileStorHandlerImpl::BucketLock::BucketLock(
 FileStorHandlerImpl::BucketLock::~BucketLock()
 {
     if (_bucket.getBucketId().getRawId() != 0) {
-        vespalib::MonitorGuard lockGuard(_disk.lock);
-        _disk.lockedBuckets.erase(_bucket);
+        Stripe& stripe(_disk.stripe(_bucket));
+        vespalib::MonitorGuard lockGuard(stripe.lock);
+        stripe.lockedBuckets.erase(_bucket);
         LOG(debug, "Unlocked bucket %s", _bucket.getBucketId().toString().c_str());
         LOG_BUCKET_OPERATION_SET_LOCK_STATE(
                 _bucket.getBucketId(), "released filestor lock", true,
                 debug::BucketOperationLogger::State::BUCKET_UNLOCKED);
         lockGuard.broadcast();
     }
+    if (_blocking && (_disk.blockingOperations.fetch_sub(1, std::memory_order_acq_rel) == 1)) {
+        vespalib::MonitorGuard blockingGuard(_disk.blockingMonitor);
+        blockingGuard.broadcast();
+    }
 }
 
 std::string
@@ -1309,15 +1369,17 @@ FileStorHandlerImpl::dumpQueue(uint16_t disk) const
     std::ostringstream ost;
 
     const Disk& t(_diskInfo[disk]);
-    vespalib::MonitorGuard lockGuard(t.lock);
+    for (const Stripe& stripe : t.stripes) {
+        vespalib::MonitorGuard lockGuard(stripe.lock);
 
-    const PriorityIdx& idx = boost::multi_index::get<1>(t.queue);
-    for (PriorityIdx::const_iterator it = idx.begin();
-         it != idx.end();
-         it++)
-    {
-        ost << it->_bucket.getBucketId() << ": " << it->_command->toString() << " (priority: "
-            << (int)it->_command->getPriority() << ")\n";
+        const PriorityIdx& idx = boost::multi_index::get<1>(stripe.queue);
+        for (PriorityIdx::const_iterator it = idx.begin();
+             it != idx.end();
+             it++)
+        {
+            ost << it->_bucket.getBucketId() << ": " << it->_command->toString() << " (priority: "
+                << (int)it->_command->getPriority() << ")\n";
+        }
     }
 
     return ost.str();
@@ -1332,8 +1394,8 @@ FileStorHandlerImpl::getStatus(std::ostream& out,
     for (uint32_t i=0; i<_diskInfo.size(); ++i) {
         out << "<h2>Disk " << i << "</h2>\n";
         const Disk& t(_diskInfo[i]);
-        vespalib::MonitorGuard lockGuard(t.lock);
         out << "Queue size: " << t.getQueueSize() << "<br>\n";
+        out << "Stripes: " << t.stripes.size() << "<br>\n";
         out << "Disk state: ";
         switch (t.getState()) {
         case FileStorHandler::AVAILABLE: out << "AVAILABLE"; break;
@@ -1341,25 +1403,31 @@ FileStorHandlerImpl::getStatus(std::ostream& out,
         case FileStorHandler::CLOSED: out << "CLOSED"; break;
         }
         out << "<h4>Active operations</h4>\n";
-        for (const auto& lockedBucket : t.lockedBuckets) {
-            out << lockedBucket.second.statusString
-                << " (" << lockedBucket.first.getBucketId()
-                << ") Running for "
-                << (_component.getClock().getTimeInSeconds().getTime()
-                    - lockedBucket.second.timestamp)
-                << " secs<br/>\n";
+        for (const Stripe& stripe : t.stripes) {
+            vespalib::MonitorGuard lockGuard(stripe.lock);
+            for (const auto& lockedBucket : stripe.lockedBuckets) {
+                out << lockedBucket.second.statusString
+                    << " (" << lockedBucket.first.getBucketId()
+                    << ") Running for "
+                    << (_component.getClock().getTimeInSeconds().getTime()
+                        - lockedBucket.second.timestamp)
+                    << " secs<br/>\n";
+            }
         }
         if (!verbose) continue;
         out << "<h4>Input queue</h4>\n";
 
         out << "<ul>\n";
-        const PriorityIdx& idx = boost::multi_index::get<1>(t.queue);
-        for (PriorityIdx::const_iterator it = idx.begin();
-             it != idx.end();
-             it++)
-        {
-            out << "<li>" << it->_command->toString() << " (priority: "
-                << (int)it->_command->getPriority() << ")</li>\n";
+        for (const Stripe& stripe : t.stripes) {
+            vespalib::MonitorGuard lockGuard(stripe.lock);
+            const PriorityIdx& idx = boost::multi_index::get<1>(stripe.queue);
+            for (PriorityIdx::const_iterator it = idx.begin();
+                 it != idx.end();
+                 it++)
+            {
+                out << "<li>" << it->_command->toString() << " (priority: "
+                    << (int)it->_command->getPriority() << ")</li>\n";
+            }
         }
         out << "</ul>\n";
     }
@@ -1388,9 +1456,11 @@ FileStorHandlerImpl::waitUntilNoLocks()
 {
     for (uint32_t i=0; i<_diskInfo.size(); ++i) {
         const Disk& t(_diskInfo[i]);
-        vespalib::MonitorGuard lockGuard(t.lock);
-        while (!t.lockedBuckets.empty()) {
-            lockGuard.wait();
+        for (const Stripe& stripe : t.stripes) {
+            vespalib::MonitorGuard lockGuard(stripe.lock);
+            while (!stripe.lockedBuckets.empty()) {
+                lockGuard.wait();
+            }
         }
     }
 }
@@ -11,6 +11,10 @@
  * it makes it possible to lock buckets, by keeping track of current operation
  * for various threads, and not allowing them to get another operation of a
  * locked bucket until unlocked.
+ *
+ * The queue of each disk is split into stripes by bucket, each with its own
+ * lock. A thread normally serves its own stripe, and takes work from the
+ * other stripes of the disk when its own has nothing it can run.
  */
 
 #pragma once
@@ -81,28 +85,43 @@ public:
     typedef boost::multi_index::nth_index<PriorityQueue, 1>::type PriorityIdx;
     typedef boost::multi_index::nth_index<PriorityQueue, 2>::type BucketIdx;
 
-    struct Disk {
-        vespalib::Monitor lock;
-        PriorityQueue queue;
+    struct LockEntry {
+        uint32_t timestamp;
+        uint8_t priority;
+        vespalib::string statusString;
 
-        struct LockEntry {
-            uint32_t timestamp;
-            uint8_t priority;
-            vespalib::string statusString;
+        LockEntry()
+            : timestamp(0), priority(0), statusString()
+        { }
 
-            LockEntry()
-                : timestamp(0), priority(0), statusString()
-            { }
+        LockEntry(uint8_t priority_, vespalib::stringref status)
+            : timestamp(time(NULL)),
+              priority(priority_),
+              statusString(status)
+        { }
+    };
 
-            LockEntry(uint8_t priority_, vespalib::stringref status)
-                : timestamp(time(NULL)),
-                  priority(priority_),
-                  statusString(status)
-            { }
-        };
+    typedef vespalib::hash_map<document::Bucket, LockEntry, document::Bucket::hash> LockedBuckets;
 
-        typedef vespalib::hash_map<document::Bucket, LockEntry, document::Bucket::hash> LockedBuckets;
+    /**
+     * One shard of the queue of a disk. Each bucket maps to exactly one
+     * stripe, holding all queued operations and the lock for that bucket,
+     * so that threads working on different stripes never contend.
+     */
+    struct Stripe {
+        vespalib::Monitor lock;
+        PriorityQueue queue;
         LockedBuckets lockedBuckets;
+
+        Stripe();
+        ~Stripe();
+
+        bool isLocked(const document::Bucket&) const noexcept;
+        uint32_t getQueueSize() const noexcept { return queue.size(); }
+    };
+
+    struct Disk {
+        std::vector<Stripe> stripes;
         FileStorDiskMetrics* metrics;
 
         /**
@@ -123,8 +142,30 @@ public:
         Disk();
         ~Disk();
 
-        bool isLocked(const document::Bucket&) const noexcept;
-        uint32_t getQueueSize() const noexcept;
+        Stripe & stripe(const document::Bucket & bucket) {
+            return stripes[stripeIndex(bucket)];
+        }
+        const Stripe & stripe(const document::Bucket & bucket) const {
+            return stripes[stripeIndex(bucket)];
+        }
+        uint32_t stripeIndex(const document::Bucket & bucket) const noexcept {
+            return document::Bucket::hash()(bucket) % stripes.size();
+        }
+        /** Must be called with the lock of the stripe owning the bucket. */
+        bool isLocked(const document::Bucket& bucket) const noexcept {
+            return stripe(bucket).isLocked(bucket);
+        }
+        /** Takes the lock of every stripe in turn. */
+        uint32_t getQueueSize() const;
+
+        /**
+         * Number of locked buckets with a priority high enough to block lower
+         * priority operations. Kept outside the stripes so it can be checked
+         * without taking all their locks.
+         */
+        std::atomic<uint32_t> blockingOperations;
+        /** Broadcast whenever blockingOperations drops to zero. */
+        vespalib::Monitor blockingMonitor;
     private:
         std::atomic<DiskState> state;
     };
@@ -132,7 +173,7 @@ public:
     class BucketLock : public FileStorHandler::BucketLockInterface {
     public:
         BucketLock(const vespalib::MonitorGuard & guard, Disk& disk, const document::Bucket &bucket, uint8_t priority,
-                   const vespalib::stringref & statusString);
+                   bool blocking, const vespalib::stringref & statusString);
         ~BucketLock();
 
         const document::Bucket &getBucket() const override { return _bucket; }
@@ -140,6 +181,7 @@ public:
     private:
         Disk& _disk;
         document::Bucket _bucket;
+        bool _blocking;
     };
 
     FileStorHandlerImpl(MessageSender&,
@@ -147,7 +189,8 @@ public:
                         const spi::PartitionStateList&,
                         ServiceLayerComponentRegister&,
                         uint8_t maxPriorityToBlock,
-                        uint8_t minPriorityToBeBlocking);
+                        uint8_t minPriorityToBeBlocking,
+                        uint32_t numStripes = 1);
 
     ~FileStorHandlerImpl();
     void setGetNextMessageTimeout(uint32_t timeout) { _getNextMessageTimeout = timeout; }
@@ -160,6 +203,7 @@ public:
 
     void pause(uint16_t disk, uint8_t priority) const;
     FileStorHandler::LockedMessage getNextMessage(uint16_t disk, uint8_t lowestPriority);
+    FileStorHandler::LockedMessage getNextMessage(uint16_t disk, uint32_t stripeId, uint8_t lowestPriority);
     FileStorHandler::LockedMessage getMessage(vespalib::MonitorGuard & guard, Disk & t, PriorityIdx & idx, PriorityIdx::iterator iter);
 
     FileStorHandler::LockedMessage & getNextMessage(uint16_t disk, FileStorHandler::LockedMessage& lock,
@@ -178,6 +222,7 @@ public:
 
     uint32_t getQueueSize() const;
     uint32_t getQueueSize(uint16_t disk) const;
+    uint32_t getNumStripes() const { return _numStripes; }
 
     std::shared_ptr<FileStorHandler::BucketLockInterface>
     lock(const document::Bucket&, uint16_t disk);
@@ -196,6 +241,7 @@ public:
 private:
     const spi::PartitionStateList& _partitions;
     ServiceLayerComponent _component;
+    uint32_t _numStripes;
     std::vector<Disk> _diskInfo;
     MessageSender& _messageSender;
     const document::BucketIdFactory& _bucketIdFactory;
@@ -263,8 +309,17 @@ private:
     std::unique_ptr<api::StorageReply> makeQueueTimeoutReply(api::StorageMessage& msg) const;
     bool messageMayBeAborted(const api::StorageMessage& msg) const;
     bool hasBlockingOperations(const Disk& t) const;
+    bool isBlocking(uint8_t priority) const { return priority <= _minPriorityToBeBlocking; }
+
+    /**
+     * Looks for a message that can run now in the given stripe, and if one
+     * is found removes it from the queue and locks its bucket. The stripe
+     * lock must be held by the guard.
+     */
+    FileStorHandler::LockedMessage tryGetMessage(vespalib::MonitorGuard & guard, Disk & t, Stripe & stripe,
+                                                 uint8_t maxPriority, bool & found);
     void abortQueuedCommandsForBuckets(Disk& disk, const AbortBucketOperationsCommand& cmd);
-    bool diskHasActiveOperationForAbortedBucket(const Disk& disk, const AbortBucketOperationsCommand& cmd) const;
+    bool stripeHasActiveOperationForAbortedBucket(const Stripe& stripe, const AbortBucketOperationsCommand& cmd) const;
     void waitUntilNoActiveOperationsForAbortedBuckets(Disk& disk, const AbortBucketOperationsCommand& cmd);
 
     // Update hook
@@ -278,6 +333,9 @@ private:
                                   api::ReturnCode& returnCode);
 
     void remapQueueNoLock(Disk& from, const RemapInfo& source, std::vector<RemapInfo*>& targets, Operation op);
+    uint32_t globalStripeIndex(uint16_t disk, const document::Bucket& bucket) const {
+        return disk * _numStripes + _diskInfo[disk].stripeIndex(bucket);
+    }
 
     /**
      * Waits until the queue has no pending operations (i.e. no locks are
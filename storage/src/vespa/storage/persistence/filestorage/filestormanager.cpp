@@ -19,6 +19,7 @@
 #include <vespa/storageapi/message/state.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
 
 #include <vespa/log/bufferedlogger.h>
 LOG_SETUP(".persistence.filestor.manager");
@@ -120,33 +121,34 @@ FileStorManager::configure(std::unique_ptr<vespa::config::content::StorFilestorC
                 _component.getLoadTypes()->getMetricLoadTypes(),
                 (_config->threads.size() > 0) ? (_config->threads.size()) : 6);
 
+        // Lowest priority accepted by each thread of a disk. The threads
+        // accepting the broadest range of priorities are spread round-robin
+        // over the queue stripes, the others use the first stripe.
+        std::vector<uint8_t> threadPriorities;
+        if (_config->threads.size() == 0) {
+            threadPriorities = {255, 255, 255, 255, 100, 100};
+        } else {
+            for (const auto& thread : _config->threads) {
+                threadPriorities.push_back(thread.lowestpri);
+            }
+        }
+        uint8_t broadestPriority = *std::max_element(threadPriorities.begin(), threadPriorities.end());
+        uint32_t numStripes = std::max(1, _config->numQueueStripes);
+
         _filestorHandler.reset(new FileStorHandler(
                 *this, *_metrics, _partitions, _compReg,
-                _config->maxPriorityToBlock, _config->minPriorityToBeBlocking));
+                _config->maxPriorityToBlock, _config->minPriorityToBeBlocking, numStripes));
         for (uint32_t i=0; i<_component.getDiskCount(); ++i) {
             if (_partitions[i].isUp()) {
-                if (_config->threads.size() == 0) {
-                    LOG(spam, "Setting up disk %u", i);
-                    for (uint32_t j = 0; j < 4; j++) {
-                        _disks[i].push_back(DiskThread::SP(
-                                new PersistenceThread(_compReg, _configUri, *_provider, *_filestorHandler,
-                                                      *_metrics->disks[i]->threads[j], i, 255)));
-
-                    }
-                    for (uint32_t j = 4; j < 6; j++) {
-                        _disks[i].push_back(DiskThread::SP(
-                                new PersistenceThread(_compReg, _configUri, *_provider, *_filestorHandler,
-                                                      *_metrics->disks[i]->threads[j], i, 100)));
-                    }
-                }
-
-                for (uint16_t j = 0; j < _config->threads.size(); j++) {
-                    LOG(spam, "Setting up disk %u, thread %u with priority %d",
-                        i, j, _config->threads[j].lowestpri);
+                uint32_t nextStripeId = 0;
+                for (uint16_t j = 0; j < threadPriorities.size(); j++) {
+                    uint32_t stripeId = (threadPriorities[j] == broadestPriority) ? (nextStripeId++ % numStripes) : 0;
+                    LOG(spam, "Setting up disk %u, thread %u with priority %d on stripe %u",
+                        i, j, threadPriorities[j], stripeId);
                     _disks[i].push_back(DiskThread::SP(
                             new PersistenceThread(_compReg, _configUri, *_provider, *_filestorHandler,
-                                                  *_metrics->disks[i]->threads[j], i, _config->threads[j].lowestpri)));
-
+                                                  *_metrics->disks[i]->threads[j], i, threadPriorities[j],
+                                                  stripeId)));
                 }
             } else {
                 _filestorHandler->disable(i);
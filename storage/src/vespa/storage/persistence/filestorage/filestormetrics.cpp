@@ -14,6 +14,7 @@ FileStorThreadMetrics::Op::Op(const std::string& id, const std::string name, Met
       _name(name),
       count("count", "yamasdefault", "Number of requests processed.", this),
       latency("latency", "yamasdefault", "Latency of successful requests.", this),
+      latencyHistogram("latencyhistogram", "", "Distribution of latency of successful requests.", this, 1),
       failed("failed", "yamasdefault", "Number of failed requests.", this)
 { }
 
@@ -23,6 +23,7 @@ struct FileStorThreadMetrics : public metrics::MetricSet
         std::string _name;
         metrics::LongCountMetric count;
         metrics::DoubleAverageMetric latency;
+        metrics::HistogramMetric latencyHistogram;
         metrics::LongCountMetric failed;
 
         Op(const std::string& id, const std::string name, MetricSet* owner = 0);
@@ -21,13 +21,17 @@ public:
     std::vector<api::MergeBucketCommand::Node> nodeList;
     framework::MicroSecTime maxTimestamp;
     std::deque<api::GetBucketDiffCommand::Entry> diff;
+    // Range digests sent by the first node, and its entries, which are
+    // only listed once the other nodes have reported differing ranges.
+    std::vector<api::GetBucketDiffCommand::RangeDigest> digests;
+    std::vector<api::GetBucketDiffCommand::Entry> localEntries;
     api::StorageMessage::Id pendingId;
     std::shared_ptr<api::GetBucketDiffReply> pendingGetDiff;
     std::shared_ptr<api::ApplyBucketDiffReply> pendingApplyDiff;
     uint32_t timeout;
     framework::MilliSecTimer startTime;
     spi::Context context;
- 	
+
     MergeStatus(framework::Clock&, const metrics::LoadType&, api::StorageMessage::Priority, uint32_t traceLevel);
     ~MergeStatus();
 
@@ -0,0 +1,121 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "mergedigest.h"
+#include <cstring>
+#include <cassert>
+
+namespace storage {
+
+namespace {
+
+uint64_t mix(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/**
+ * Calls func(rangeIndex, begin, end) for the entries in each range.
+ */
+template <typename Func>
+void forEachRange(const std::vector<MergeDigest::Entry>& entries,
+                  const std::vector<MergeDigest::RangeDigest>& ranges,
+                  Func func)
+{
+    size_t pos = 0;
+    for (size_t r = 0; r < ranges.size(); ++r) {
+        size_t begin = pos;
+        bool last = (r + 1 == ranges.size());
+        while (pos < entries.size()
+               && (last || entries[pos]._timestamp < ranges[r]._end))
+        {
+            ++pos;
+        }
+        func(r, begin, pos);
+    }
+}
+
+} // anonymous namespace
+
+uint64_t
+MergeDigest::hashEntry(const Entry& entry)
+{
+    uint64_t gid[2] = { 0, 0 };
+    memcpy(gid, entry._gid.get(), document::GlobalId::LENGTH);
+    uint64_t h = mix(entry._timestamp);
+    h = mix(h ^ gid[0]);
+    h = mix(h ^ gid[1]);
+    h = mix(h ^ ((uint64_t(entry._headerSize) << 32) | entry._bodySize));
+    return mix(h ^ entry._flags);
+}
+
+std::vector<MergeDigest::RangeDigest>
+MergeDigest::build(const std::vector<Entry>& entries, uint32_t rangeSize)
+{
+    assert(rangeSize > 0);
+    std::vector<RangeDigest> ranges;
+    for (size_t i = rangeSize; i < entries.size(); i += rangeSize) {
+        api::Timestamp end = entries[i]._timestamp;
+        if (ranges.empty() || end > ranges.back()._end) {
+            ranges.emplace_back(end, 0, 0);
+        }
+    }
+    ranges.emplace_back(UINT64_MAX, 0, 0);
+    return digest(entries, ranges);
+}
+
+std::vector<MergeDigest::RangeDigest>
+MergeDigest::digest(const std::vector<Entry>& entries,
+                    const std::vector<RangeDigest>& ranges)
+{
+    std::vector<RangeDigest> result;
+    result.reserve(ranges.size());
+    forEachRange(entries, ranges, [&](size_t r, size_t begin, size_t end) {
+        uint64_t hash = 0;
+        for (size_t i = begin; i < end; ++i) {
+            hash += hashEntry(entries[i]);
+        }
+        result.emplace_back(ranges[r]._end, hash, end - begin);
+    });
+    return result;
+}
+
+void
+MergeDigest::compare(const std::vector<Entry>& local,
+                     const std::vector<RangeDigest>& ranges,
+                     uint16_t nodeBit,
+                     std::vector<uint16_t>& mismatch,
+                     std::vector<Entry>& differing)
+{
+    mismatch.resize(ranges.size(), 0);
+    std::vector<RangeDigest> own(digest(local, ranges));
+    forEachRange(local, ranges, [&](size_t r, size_t begin, size_t end) {
+        if (!(own[r] == ranges[r])) {
+            mismatch[r] |= nodeBit;
+            differing.insert(differing.end(), local.begin() + begin, local.begin() + end);
+        }
+    });
+}
+
+void
+MergeDigest::expand(const std::vector<Entry>& local,
+                    const std::vector<RangeDigest>& ranges,
+                    const std::vector<uint16_t>& mismatch,
+                    uint16_t allNodesMask,
+                    std::vector<Entry>& result)
+{
+    assert(mismatch.size() == ranges.size());
+    forEachRange(local, ranges, [&](size_t r, size_t begin, size_t end) {
+        if (mismatch[r] != 0) {
+            for (size_t i = begin; i < end; ++i) {
+                result.push_back(local[i]);
+                result.back()._hasMask |= (allNodesMask & ~mismatch[r]);
+            }
+        }
+    });
+}
+
+} // storage
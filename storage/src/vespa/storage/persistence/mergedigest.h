@@ -0,0 +1,63 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+/**
+ * Digests of bucket metadata over ranges of timestamps, used by merge to
+ * find where bucket copies differ without listing every entry.
+ *
+ * The first node in a merge chain splits its sorted entry list into ranges
+ * of a fixed number of entries and sends a digest (hash and count) of each
+ * range. The other nodes digest their own entries over the same timestamp
+ * ranges, and only list their entries in ranges where the digests differ.
+ * After a short outage the copies typically differ in a few ranges, so only
+ * a small fraction of the metadata has to be sent between the nodes.
+ */
+#pragma once
+
+#include <vespa/storageapi/message/bucket.h>
+#include <vector>
+
+namespace storage {
+
+struct MergeDigest {
+    typedef api::GetBucketDiffCommand::Entry Entry;
+    typedef api::GetBucketDiffCommand::RangeDigest RangeDigest;
+
+    /** Hash of everything identifying an entry, except its has mask. */
+    static uint64_t hashEntry(const Entry& entry);
+
+    /**
+     * Split the entries (sorted on timestamp) in ranges of about
+     * 'rangeSize' entries and digest each range. The last range is open
+     * ended, so that the ranges cover all timestamps.
+     */
+    static std::vector<RangeDigest> build(const std::vector<Entry>& entries,
+                                          uint32_t rangeSize);
+
+    /** Digest the entries (sorted on timestamp) over the given ranges. */
+    static std::vector<RangeDigest> digest(const std::vector<Entry>& entries,
+                                           const std::vector<RangeDigest>& ranges);
+
+    /**
+     * Compare the local entries with the given range digests. For each
+     * range that differs, 'nodeBit' is set in the range's mismatch mask
+     * and the local entries in the range are appended to 'differing'.
+     */
+    static void compare(const std::vector<Entry>& local,
+                        const std::vector<RangeDigest>& ranges,
+                        uint16_t nodeBit,
+                        std::vector<uint16_t>& mismatch,
+                        std::vector<Entry>& differing);
+
+    /**
+     * Used by the node that built the digests to list its own entries in
+     * the ranges where any node differs. Nodes that did not flag a range
+     * have the same entries in it, so their bits are set in the has mask
+     * of the listed entries.
+     */
+    static void expand(const std::vector<Entry>& local,
+                       const std::vector<RangeDigest>& ranges,
+                       const std::vector<uint16_t>& mismatch,
+                       uint16_t allNodesMask,
+                       std::vector<Entry>& result);
+};
+
+} // storage
@@ -2,6 +2,7 @@
 
 
 #include "mergehandler.h"
+#include "mergedigest.h"
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vdslib/distribution/distribution.h>
 #include <vespa/document/fieldset/fieldsets.h>
@@ -19,16 +20,19 @@ MergeHandler::MergeHandler(spi::PersistenceProvider& spi,
                            PersistenceUtil& env)
     : _spi(spi),
       _env(env),
-      _maxChunkSize(env._config.bucketMergeChunkSize)
+      _maxChunkSize(env._config.bucketMergeChunkSize),
+      _digestRangeSize(env._config.bucketMergeDigestRangeSize)
 {
 }
 
 MergeHandler::MergeHandler(spi::PersistenceProvider& spi,
                            PersistenceUtil& env,
-                           uint32_t maxChunkSize)
+                           uint32_t maxChunkSize,
+                           uint32_t digestRangeSize)
     : _spi(spi),
       _env(env),
-      _maxChunkSize(maxChunkSize)
+      _maxChunkSize(maxChunkSize),
+      _digestRangeSize(digestRangeSize)
 {
 }
 
@@ -1024,12 +1028,20 @@ MergeHandler::handleMergeBucket(api::MergeBucketCommand& cmd,
     }
     _env._metrics.mergeMetadataReadLatency.addValue(
             s->startTime.getElapsedTimeAsDouble());
+    if (_digestRangeSize > 0 && cmd2->getDiff().size() > _digestRangeSize) {
+        // Only list our entries in ranges the other nodes report as differing
+        s->digests = MergeDigest::build(cmd2->getDiff(), _digestRangeSize);
+        s->localEntries.swap(cmd2->getDiff());
+        cmd2->getDigests() = s->digests;
+        cmd2->getDigestMismatch().assign(s->digests.size(), 0);
+    }
     LOG(spam, "Sending GetBucketDiff %" PRIu64 " for %s to next node %u "
-        "with diff of %u entries.",
+        "with diff of %u entries and %u range digests.",
         cmd2->getMsgId(),
         bucket.toString().c_str(),
         s->nodeList[1].index,
-        uint32_t(cmd2->getDiff().size()));
+        uint32_t(cmd2->getDiff().size()),
+        uint32_t(cmd2->getDigests().size()));
     cmd2->setAddress(createAddress(_env._component.getClusterName(),
                                    s->nodeList[1].index));
     cmd2->setPriority(s->context.getPriority());
@@ -1059,6 +1071,19 @@ namespace {
                 VESPA_STRLOC);
     }
 
+    /** Mask of the nodes that should have all entries after the merge. */
+    uint16_t getCompleteMask(
+            const std::vector<api::MergeBucketCommand::Node>& nodeList)
+    {
+        uint16_t completeMask = 0;
+        for (uint32_t i=0; i<nodeList.size(); ++i) {
+            if (!nodeList[i].sourceOnly) {
+                completeMask |= (1 << i);
+            }
+        }
+        return completeMask;
+    }
+
     struct DiffEntryTimestampOrder
         : public std::binary_function<api::GetBucketDiffCommand::Entry,
                                       api::GetBucketDiffCommand::Entry, bool>
@@ -1203,6 +1228,13 @@ MergeHandler::handleGetBucketDiff(api::GetBucketDiffCommand& cmd,
                      "Bucket not found in buildBucketInfo step");
         return tracker;
     }
+    if (cmd.useDigests()) {
+        // Only pass on our entries in ranges that differ from the first node
+        std::vector<api::GetBucketDiffCommand::Entry> differing;
+        MergeDigest::compare(local, cmd.getDigests(), 1 << index,
+                             cmd.getDigestMismatch(), differing);
+        local.swap(differing);
+    }
     if (!mergeLists(remote, local, local)) {
         LOG(error, "Diffing %s found suspect entries.",
             bucket.toString().c_str());
@@ -1212,16 +1244,15 @@ MergeHandler::handleGetBucketDiff(api::GetBucketDiffCommand& cmd,
 
     // If last node in merge chain, we can send reply straight away
     if (index + 1u >= cmd.getNodes().size()) {
-        // Remove entries everyone has from list first.
-        uint16_t completeMask = 0;
-        for (uint32_t i=0; i<cmd.getNodes().size(); ++i) {
-            if (!cmd.getNodes()[i].sourceOnly) {
-                completeMask |= (1 << i);
-            }
-        }
+        // Remove entries everyone has from list first. When diffing by
+        // digests, the first node has not listed its entries yet, so it
+        // has to do this itself.
+        uint16_t completeMask = getCompleteMask(cmd.getNodes());
         std::vector<api::GetBucketDiffCommand::Entry> final;
         for (uint32_t i=0, n=local.size(); i<n; ++i) {
-            if ((local[i]._hasMask & completeMask) != completeMask) {
+            if (cmd.useDigests()
+                || (local[i]._hasMask & completeMask) != completeMask)
+            {
                 final.push_back(local[i]);
             }
         }
@@ -1257,6 +1288,8 @@ MergeHandler::handleGetBucketDiff(api::GetBucketDiffCommand& cmd,
         cmd2->setAddress(createAddress(_env._component.getClusterName(),
                                        cmd.getNodes()[index + 1].index));
         cmd2->getDiff().swap(local);
+        cmd2->getDigests() = cmd.getDigests();
+        cmd2->getDigestMismatch() = cmd.getDigestMismatch();
         cmd2->setPriority(cmd.getPriority());
         cmd2->setTimeout(cmd.getTimeout());
         s->pendingId = cmd2->getMsgId();
@@ -1297,6 +1330,41 @@ namespace {
 
 } // End of anonymous namespace
 
+void
+MergeHandler::addDigestDiff(const spi::Bucket& bucket,
+                            MergeStatus& s,
+                            const api::GetBucketDiffReply& reply) const
+{
+    uint16_t allNodes = (1u << s.nodeList.size()) - 1;
+    std::vector<uint16_t> mismatch(reply.getDigestMismatch());
+    if (mismatch.size() != s.digests.size()) {
+        // The other nodes did not understand the digests, and have listed
+        // all their entries. Treat every range as differing.
+        LOG(debug, "GetBucketDiffReply for %s did not contain range digest "
+                   "results. Listing all local entries.",
+            bucket.toString().c_str());
+        mismatch.assign(s.digests.size(), allNodes & ~1);
+    }
+    std::vector<api::GetBucketDiffCommand::Entry> local;
+    MergeDigest::expand(s.localEntries, s.digests, mismatch, allNodes, local);
+    if (!mergeLists(local, reply.getDiff(), local)) {
+        LOG(error, "Diffing %s found suspect entries.",
+            bucket.toString().c_str());
+    }
+    uint16_t completeMask = getCompleteMask(s.nodeList);
+    for (const auto& entry : local) {
+        if ((entry._hasMask & completeMask) != completeMask) {
+            s.diff.push_back(entry);
+        }
+    }
+    LOG(spam, "Merge(%s): %u of %u ranges differ, diff has %u entries.",
+        bucket.toString().c_str(),
+        uint32_t(std::count_if(mismatch.begin(), mismatch.end(),
+                               [](uint16_t m) { return m != 0; })),
+        uint32_t(mismatch.size()), uint32_t(s.diff.size()));
+    s.localEntries.clear();
+}
+
 void
 MergeHandler::handleGetBucketDiffReply(api::GetBucketDiffReply& reply,
                                        MessageSender& sender)
@@ -1336,9 +1404,13 @@ MergeHandler::handleGetBucketDiffReply(api::GetBucketDiffReply& reply,
 
                 // Get bucket diff should retrieve all info at once
                 assert(s.diff.size() == 0);
-                s.diff.insert(s.diff.end(),
-                              reply.getDiff().begin(),
-                              reply.getDiff().end());
+                if (!s.digests.empty()) {
+                    addDigestDiff(bucket, s, reply);
+                } else {
+                    s.diff.insert(s.diff.end(),
+                                  reply.getDiff().begin(),
+                                  reply.getDiff().end());
+                }
 
                 replyToSend = processBucketMerge(bucket, s, sender, s.context);
 
@@ -1357,6 +1429,8 @@ MergeHandler::handleGetBucketDiffReply(api::GetBucketDiffReply& reply,
                 "size %" PRIu64 ". Sending it on.",
                 bucket.toString().c_str(), reply.getDiff().size());
             s.pendingGetDiff->getDiff().swap(reply.getDiff());
+            s.pendingGetDiff->getDigestMismatch().swap(
+                    reply.getDigestMismatch());
         }
     } catch (std::exception& e) {
         _env._fileStorHandler.clearMergeStatus(
@@ -34,7 +34,8 @@ public:
     /** Used for unit testing */
     MergeHandler(spi::PersistenceProvider& spi,
                  PersistenceUtil& env,
-                 uint32_t maxChunkSize);
+                 uint32_t maxChunkSize,
+                 uint32_t digestRangeSize = 0);
 
     bool buildBucketInfoList(
             const spi::Bucket& bucket,
@@ -68,6 +69,15 @@ private:
     spi::PersistenceProvider& _spi;
     PersistenceUtil& _env;
     uint32_t _maxChunkSize;
+    uint32_t _digestRangeSize;
+
+    /**
+     * Builds the diff of a merge started with range digests, from our own
+     * entries in the differing ranges and the entries in the reply.
+     */
+    void addDigestDiff(const spi::Bucket& bucket,
+                       MergeStatus& status,
+                       const api::GetBucketDiffReply& reply) const;
 
     /** Returns a reply if merge is complete */
     api::StorageReply::SP processBucketMerge(const spi::Bucket& bucket,
@@ -23,7 +23,8 @@ PersistenceThread::PersistenceThread(ServiceLayerComponentRegister& compReg,
                                      FileStorHandler& filestorHandler,
                                      FileStorThreadMetrics& metrics,
                                      uint16_t deviceIndex,
-                                     uint8_t lowestPriority)
+                                     uint8_t lowestPriority,
+                                     uint32_t stripeId)
     : _env(configUri, compReg, filestorHandler, metrics, deviceIndex, lowestPriority, provider),
       _warnOnSlowOperations(5000),
       _spi(provider),
@@ -33,7 +34,8 @@ PersistenceThread::PersistenceThread(ServiceLayerComponentRegister& compReg,
       _context(documentapi::LoadType::DEFAULT, 0, 0),
       _bucketOwnershipNotifier(),
       _flushMonitor(),
-      _closed(false)
+      _closed(false),
+      _stripeId(stripeId)
 {
     std::ostringstream threadName;
     threadName << "Disk " << _env._partition << " thread " << (void*) this;
@@ -1097,6 +1099,25 @@ bool hasBucketInfo(const api::StorageMessage& msg)
              msg.getType().getId() == api::MessageType::JOINBUCKETS_ID));
 }
 
+/**
+ * Puts and removes can be fed to the provider as part of a batch, unless
+ * they have a test-and-set condition (which must be checked against the
+ * state left by the operations before it) or are traced (as the provider
+ * only gets one trace context per batch).
+ */
+bool isFeedBatchable(const api::StorageMessage& msg)
+{
+    if (msg.getType().getId() != api::MessageType::PUT_ID &&
+        msg.getType().getId() != api::MessageType::REMOVE_ID)
+    {
+        return false;
+    }
+    return (!static_cast<const api::TestAndSetCommand&>(msg).getCondition().isPresent() &&
+            msg.getTrace().getLevel() == 0);
+}
+
+const size_t MAX_FEED_BATCH_SIZE = 128;
+
 }
 
 void
@@ -1164,6 +1185,101 @@ PersistenceThread::flushAllReplies(
     replies.clear();
 }
 
+bool
+PersistenceThread::processFeedBatch(FileStorHandler::LockedMessage & lock,
+                                    std::vector<MessageTracker::UP>& trackers)
+{
+    document::Bucket bucket = lock.first->getBucket();
+    std::vector<std::shared_ptr<api::StorageMessage>> msgs;
+    std::vector<MessageTracker::UP> batchTrackers;
+    spi::FeedBatch batch;
+
+    _context = spi::Context(lock.second->getLoadType(), lock.second->getPriority(), 0);
+    while (lock.second.get() != 0 && isFeedBatchable(*lock.second) && batch.size() < MAX_FEED_BATCH_SIZE) {
+        std::shared_ptr<api::StorageMessage> msg(lock.second);
+        if (msg->getType().getId() == api::MessageType::PUT_ID) {
+            api::PutCommand& cmd(static_cast<api::PutCommand&>(*msg));
+            try {
+                getBucket(cmd.getDocumentId(), bucket);
+            } catch (std::exception&) {
+                // Leave it to the regular path, which fails it.
+                break;
+            }
+            batchTrackers.emplace_back(new MessageTracker(_env._metrics.put[cmd.getLoadType()],
+                                                          _env._component.getClock()));
+            batch.addPut(spi::Timestamp(cmd.getTimestamp()), cmd.getDocument());
+        } else {
+            api::RemoveCommand& cmd(static_cast<api::RemoveCommand&>(*msg));
+            try {
+                getBucket(cmd.getDocumentId(), bucket);
+            } catch (std::exception&) {
+                break;
+            }
+            batchTrackers.emplace_back(new MessageTracker(_env._metrics.remove[cmd.getLoadType()],
+                                                          _env._component.getClock()));
+            batch.addRemoveIfFound(spi::Timestamp(cmd.getTimestamp()), cmd.getDocumentId());
+        }
+        LOG(debug, "Adding command to feed batch: %s", msg->toString().c_str());
+        ++_env._metrics.operations;
+        msgs.push_back(std::move(msg));
+        _env._fileStorHandler.getNextMessage(_env._partition, lock, _env._lowestPriority);
+    }
+    if (batch.empty()) {
+        return false;
+    }
+
+    spi::FeedBatchResult results;
+    try {
+        results = _spi.feedBatch(spi::Bucket(bucket, spi::PartitionId(_env._partition)), batch, _context);
+        assert(results.size() == batch.size());
+    } catch (std::exception& e) {
+        LOG(debug, "Caught exception for feed batch of %zu operations to %s: %s",
+            batch.size(), bucket.toString().c_str(), e.what());
+        for (size_t i = 0; i < msgs.size(); ++i) {
+            batchTrackers[i]->fail(api::ReturnCode::INTERNAL_FAILURE, e.what());
+            batchTrackers[i]->generateReply(static_cast<api::StorageCommand&>(*msgs[i]));
+            ++_env._metrics.failedOperations;
+            trackers.push_back(std::move(batchTrackers[i]));
+        }
+        return true;
+    }
+
+    api::BucketInfo info;
+    bool haveInfo = false;
+    for (size_t i = 0; i < msgs.size(); ++i) {
+        api::StorageCommand& cmd(static_cast<api::StorageCommand&>(*msgs[i]));
+        MessageTracker& tracker(*batchTrackers[i]);
+        const spi::RemoveResult& result(results[i]);
+        bool ok = checkForError(result, tracker);
+        if (cmd.getType().getId() == api::MessageType::REMOVE_ID) {
+            api::RemoveCommand& removeCmd(static_cast<api::RemoveCommand&>(cmd));
+            if (ok) {
+                tracker.setReply(std::make_shared<api::RemoveReply>(
+                        removeCmd, result.wasFound() ? removeCmd.getTimestamp() : 0));
+            }
+            if (!result.wasFound()) {
+                ++_env._metrics.remove[cmd.getLoadType()].notFound;
+            }
+        }
+        tracker.generateReply(cmd);
+        if (tracker.getReply()->getResult().failed() || tracker.getResult().failed()) {
+            ++_env._metrics.failedOperations;
+        } else if (!haveInfo) {
+            // Every reply in the batch carries the bucket info as of the
+            // end of the batch, so it is only looked up once.
+            _env.setBucketInfo(tracker, bucket);
+            info = static_cast<api::BucketInfoReply&>(*tracker.getReply()).getBucketInfo();
+            haveInfo = true;
+        } else {
+            static_cast<api::BucketInfoReply&>(*tracker.getReply()).setBucketInfo(info);
+        }
+    }
+    for (auto& tracker : batchTrackers) {
+        trackers.push_back(std::move(tracker));
+    }
+    return true;
+}
+
 void PersistenceThread::processMessages(FileStorHandler::LockedMessage & lock)
 {
     std::vector<MessageTracker::UP> trackers;
@@ -1173,6 +1289,9 @@ void PersistenceThread::processMessages(FileStorHandler::LockedMessage & lock)
         LOG(debug, "Inside while loop %d, nodeIndex %d, ptr=%p",
             _env._partition, _env._nodeIndex, lock.second.get());
         std::shared_ptr<api::StorageMessage> msg(lock.second);
+        if (isFeedBatchable(*msg) && processFeedBatch(lock, trackers)) {
+            continue;
+        }
         bool batchable = isBatchable(*msg);
 
         // If the next operation wasn't batchable, we should flush
@@ -1233,7 +1352,7 @@ PersistenceThread::run(framework::ThreadHandle& thread)
 
         FileStorHandler::LockedMessage lock(
                 _env._fileStorHandler.getNextMessage(
-                    _env._partition, _env._lowestPriority));
+                    _env._partition, _stripeId, _env._lowestPriority));
 
         if (lock.first.get()) {
             processMessages(lock);
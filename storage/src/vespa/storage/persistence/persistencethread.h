@@ -21,7 +21,8 @@ class PersistenceThread final : public DiskThread, public Types
 public:
     PersistenceThread(ServiceLayerComponentRegister&, const config::ConfigUri & configUri,
                       spi::PersistenceProvider& provider, FileStorHandler& filestorHandler,
-                      FileStorThreadMetrics& metrics, uint16_t deviceIndex, uint8_t lowestPriority);
+                      FileStorThreadMetrics& metrics, uint16_t deviceIndex, uint8_t lowestPriority,
+                      uint32_t stripeId = 0);
     ~PersistenceThread();
 
     /** Waits for current operation to be finished. */
@@ -60,6 +61,7 @@ private:
     std::unique_ptr<BucketOwnershipNotifier> _bucketOwnershipNotifier;
     vespalib::Monitor         _flushMonitor;
     bool                      _closed;
+    uint32_t                  _stripeId;
 
     bool checkProviderBucketInfoMatches(const spi::Bucket&, const api::BucketInfo&) const;
 
@@ -78,6 +80,15 @@ private:
     MessageTracker::UP processMessage(api::StorageMessage& msg);
     void processMessages(FileStorHandler::LockedMessage & lock);
 
+    /**
+     * Feeds the put or remove in the lock, and the puts and removes queued
+     * right behind it for the same bucket, to the provider in one batch.
+     * Trackers for all of them are added to the given list. On return the
+     * lock holds the first message that was not part of the batch, if any.
+     * Returns false, leaving the lock untouched, if nothing could be batched.
+     */
+    bool processFeedBatch(FileStorHandler::LockedMessage & lock, std::vector<MessageTracker::UP>& trackers);
+
     // Thread main loop
     void run(framework::ThreadHandle&) override;
     bool checkForError(const spi::Result& response, MessageTracker& tracker);
@@ -29,7 +29,9 @@ MessageTracker::MessageTracker(FileStorThreadMetrics::Op& metric,
 MessageTracker::~MessageTracker()
 {
     if (_reply.get() && _reply->getResult().success()) {
-        _metric.latency.addValue(_timer.getElapsedTimeAsDouble());
+        double latency = _timer.getElapsedTimeAsDouble();
+        _metric.latency.addValue(latency);
+        _metric.latencyHistogram.addValue(latency);
     }
 }
 
@@ -109,6 +109,18 @@ ProviderErrorWrapper::update(const spi::Bucket& bucket,
     return checkResult(_impl.update(bucket, ts, docUpdate, context));
 }
 
+spi::FeedBatchResult
+ProviderErrorWrapper::feedBatch(const spi::Bucket& bucket,
+                                const spi::FeedBatch& batch,
+                                spi::Context& context)
+{
+    spi::FeedBatchResult results(_impl.feedBatch(bucket, batch, context));
+    for (auto& result : results) {
+        checkResult(result);
+    }
+    return results;
+}
+
 spi::GetResult
 ProviderErrorWrapper::get(const spi::Bucket& bucket,
                              const document::FieldSet& fieldSet,
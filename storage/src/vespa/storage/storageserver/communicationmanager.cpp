@@ -288,7 +288,8 @@ CommunicationManager::CommunicationManager(StorageComponentRegister& compReg, co
       _count(0),
       _configUri(configUri),
       _closed(false),
-      _docApiConverter(configUri, std::make_shared<PlaceHolderBucketResolver>())
+      _docApiConverter(configUri, std::make_shared<PlaceHolderBucketResolver>()),
+      _lazyDocumentDecoding(false)
 {
     _component.registerMetricUpdateHook(*this, framework::SecondTime(5));
     _component.registerMetric(_metrics);
@@ -421,9 +422,11 @@ void CommunicationManager::configure(std::unique_ptr<CommunicationManagerConfig>
                                                       90, config->mbus.compress.limit));
         // Configure messagebus here as we for legacy reasons have
         // config here.
+        _lazyDocumentDecoding = config->mbus.lazyDocumentDecoding;
         _mbus = std::make_unique<mbus::RPCMessageBus>(
                 mbus::ProtocolSet()
-                        .add(std::make_shared<documentapi::DocumentProtocol>(*_component.getLoadTypes(), _component.getTypeRepo()))
+                        .add(std::make_shared<documentapi::DocumentProtocol>(*_component.getLoadTypes(), _component.getTypeRepo(),
+                                                                             "", _lazyDocumentDecoding))
                         .add(std::make_shared<mbusprot::StorageProtocol>(_component.getTypeRepo(), *_component.getLoadTypes())),
                 params,
                 _configUri);
@@ -765,7 +768,7 @@ void CommunicationManager::updateMessagebusProtocol(
         const document::DocumentTypeRepo::SP &repo) {
     if (_mbus.get()) {
         framework::SecondTime now(_component.getClock().getTimeInSeconds());
-        mbus::IProtocol::SP newDocumentProtocol(new documentapi::DocumentProtocol( *_component.getLoadTypes(), repo));
+        mbus::IProtocol::SP newDocumentProtocol(new documentapi::DocumentProtocol( *_component.getLoadTypes(), repo, "", _lazyDocumentDecoding));
         std::lock_guard<std::mutex> guard(_earlierGenerationsLock);
         _earlierGenerations.push_back(std::make_pair(now, _mbus->getMessageBus().putProtocol(newDocumentProtocol)));
         mbus::IProtocol::SP newStorageProtocol(new mbusprot::StorageProtocol(repo, *_component.getLoadTypes()));
@@ -171,6 +171,7 @@ private:
     config::ConfigUri _configUri;
     std::atomic<bool> _closed;
     DocumentApiConverter _docApiConverter;
+    bool _lazyDocumentDecoding;
     framework::Thread::UP _thread;
 
     void updateMetrics(const MetricLockGuard &) override;
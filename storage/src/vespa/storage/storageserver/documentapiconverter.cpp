@@ -42,8 +42,13 @@ DocumentApiConverter::toStorageAPI(documentapi::DocumentMessage& fromMsg,
     case DocumentProtocol::MESSAGE_PUTDOCUMENT:
     {
         documentapi::PutDocumentMessage& from(static_cast<documentapi::PutDocumentMessage&>(fromMsg));
-        document::Bucket bucket = bucketResolver()->bucketFromId(from.getDocument().getId());
-        auto to = std::make_unique<api::PutCommand>(bucket, from.stealDocument(), from.getTimestamp());
+        std::vector<char> serialized;
+        document::Document::SP doc(from.stealDocument(serialized));
+        document::Bucket bucket = bucketResolver()->bucketFromId(doc->getId());
+        auto to = std::make_unique<api::PutCommand>(bucket, std::move(doc), from.getTimestamp());
+        if ( ! serialized.empty()) {
+            to->setSerializedDocument(std::make_shared<const std::vector<char>>(std::move(serialized)));
+        }
         to->setCondition(from.getCondition());
         toMsg = std::move(to);
         break;
@@ -46,6 +46,7 @@ MergeThrottler::ChainedMergeState::ChainedMergeState()
     : _cmd(),
       _cmdString(),
       _clusterStateVersion(0),
+      _estimatedBytes(0),
       _inCycle(false),
       _executingLocally(false),
       _unwinding(false),
@@ -57,6 +58,7 @@ MergeThrottler::ChainedMergeState::ChainedMergeState(const api::StorageMessage::
     : _cmd(cmd),
       _cmdString(cmd->toString()),
       _clusterStateVersion(static_cast<const api::MergeBucketCommand&>(*cmd).getClusterStateVersion()),
+      _estimatedBytes(static_cast<const api::MergeBucketCommand&>(*cmd).getEstimatedMergeBytes()),
       _inCycle(false),
       _executingLocally(executing),
       _unwinding(false),
@@ -190,6 +192,8 @@ MergeThrottler::MergeThrottler(
       _merges(),
       _queue(),
       _maxQueueSize(1024),
+      _maxMergeBytes(0),
+      _activeMergeBytes(0),
       _throttlePolicy(new mbus::StaticThrottlePolicy()),
       _queueSequence(0),
       _messageLock(),
@@ -221,6 +225,9 @@ MergeThrottler::configure(std::unique_ptr<vespa::config::content::core::StorServ
     if (newConfig->maxMergeQueueSize < 0) {
         throw config::InvalidConfigException("Max merge queue size cannot be less than 0");
     }
+    if (newConfig->maxMergeBytesPerNode < 0) {
+        throw config::InvalidConfigException("Max merge bytes per node cannot be less than 0");
+    }
     if (newConfig->resourceExhaustionMergeBackPressureDurationSecs < 0.0) {
         throw config::InvalidConfigException("Merge back-pressure duration cannot be less than 0");
     }
@@ -234,6 +241,7 @@ MergeThrottler::configure(std::unique_ptr<vespa::config::content::core::StorServ
     LOG(debug, "Setting new max queue size to %d",
         newConfig->maxMergeQueueSize);
     _maxQueueSize = newConfig->maxMergeQueueSize;
+    _maxMergeBytes = newConfig->maxMergeBytesPerNode;
     _backpressure_duration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
             std::chrono::duration<double>(newConfig->resourceExhaustionMergeBackPressureDurationSecs));
 }
@@ -351,6 +359,7 @@ MergeThrottler::onFlush(bool /*downwards*/)
         flushable.size());
 
     _merges.clear();
+    _activeMergeBytes = 0;
     _queue.clear();
     _messagesUp.clear();
     _messagesDown.clear();
@@ -381,6 +390,7 @@ MergeThrottler::forwardCommandToNode(
     fwdMerge->setSourceIndex(mergeCmd.getSourceIndex());
     fwdMerge->setPriority(mergeCmd.getPriority());
     fwdMerge->setTimeout(mergeCmd.getTimeout());
+    fwdMerge->setEstimatedMergeBytes(mergeCmd.getEstimatedMergeBytes());
     msgGuard.sendUp(fwdMerge);
 }
 
@@ -389,6 +399,7 @@ MergeThrottler::removeActiveMerge(ActiveMergeMap::iterator mergeIter)
 {
     LOG(debug, "Removed merge for %s from internal state",
         mergeIter->first.toString().c_str());
+    _activeMergeBytes -= mergeIter->second.getEstimatedBytes();
     _merges.erase(mergeIter);
 }
 
@@ -417,14 +428,28 @@ MergeThrottler::enqueueMerge(
     if (!validateNewMerge(mergeCmd, nodeSeq, msgGuard)) {
         return;
     }
-    _queue.insert(MergePriorityQueue::value_type(msg, _queueSequence++));
+    _queue.insert(MergePriorityQueue::value_type(msg, _queueSequence++,
+                                                 mergeCmd.getEstimatedMergeBytes()));
 }
 
 bool
-MergeThrottler::canProcessNewMerge() const
+MergeThrottler::canProcessNewMerge(uint64_t estimatedBytes) const
 {
     DummyMbusMessage<mbus::Message> dummyMsg;
-    return _throttlePolicy->canSend(dummyMsg, _merges.size());
+    if (!_throttlePolicy->canSend(dummyMsg, _merges.size())) {
+        return false;
+    }
+    // Always let one merge through, however large, to avoid starving it
+    return (_maxMergeBytes == 0
+            || _activeMergeBytes == 0
+            || _activeMergeBytes + estimatedBytes <= _maxMergeBytes);
+}
+
+void
+MergeThrottler::setMaxMergeBytes(uint64_t maxBytes)
+{
+    vespalib::LockGuard lock(_stateLock);
+    _maxMergeBytes = maxBytes;
 }
 
 bool
@@ -536,7 +561,8 @@ bool
 MergeThrottler::attemptProcessNextQueuedMerge(
         MessageGuard& msgGuard)
 {
-    if (!canProcessNewMerge()) {
+    uint64_t nextBytes = (_queue.empty() ? 0 : _queue.begin()->_cost);
+    if (!canProcessNewMerge(nextBytes)) {
         // Should never reach a non-sending state when there are
         // no to-be-replied merges that can trigger a new processing
         assert(!_merges.empty());
@@ -730,7 +756,9 @@ MergeThrottler::handleMessageDown(
 
         if (isMergeAlreadyKnown(msg)) {
             processCycledMergeCommand(msg, msgGuard);
-        } else if (canProcessNewMerge()) {
+        } else if (_queue.empty() && canProcessNewMerge(mergeCmd.getEstimatedMergeBytes())) {
+            // Merges waiting for room within the byte limit must not be
+            // overtaken by smaller merges arriving later
             processNewMergeCommand(msg, msgGuard);
         } else if (_queue.size() < _maxQueueSize) {
             enqueueMerge(msg, msgGuard); // Queue for later processing
@@ -832,6 +860,7 @@ MergeThrottler::processNewMergeCommand(
     // merge throttling window.
     assert(_merges.find(mergeCmd.getBucket()) == _merges.end());
     auto state = _merges.emplace(mergeCmd.getBucket(), ChainedMergeState(msg)).first;
+    _activeMergeBytes += state->second.getEstimatedBytes();
 
     LOG(debug, "Added merge %s to internal state",
         mergeCmd.toString().c_str());
@@ -1268,6 +1297,12 @@ MergeThrottler::reportHtmlStatus(std::ostream& out,
         out << "<p>Max pending: "
             << _throttlePolicy->getMaxPendingCount()
             << "</p>\n";
+        out << "<p>Estimated bytes of active merges: "
+            << _activeMergeBytes;
+        if (_maxMergeBytes != 0) {
+            out << " (max " << _maxMergeBytes << ")";
+        }
+        out << "</p>\n";
         out << "<p>Please see node metrics for performance numbers</p>\n";
         out << "<h3>Active merges ("
             << _merges.size()
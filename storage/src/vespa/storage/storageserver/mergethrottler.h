@@ -74,9 +74,10 @@ private:
         MessageType _msg;
         metrics::MetricTimer _startTimer;
         uint64_t _sequence;
+        uint64_t _cost;
 
-        StablePriorityOrderingWrapper(const MessageType& msg, uint64_t sequence)
-            : _msg(msg), _startTimer(), _sequence(sequence)
+        StablePriorityOrderingWrapper(const MessageType& msg, uint64_t sequence, uint64_t cost = 0)
+            : _msg(msg), _startTimer(), _sequence(sequence), _cost(cost)
         {
         }
 
@@ -86,8 +87,11 @@ private:
         }
 
         bool operator<(const StablePriorityOrderingWrapper& other) const {
-            if (_msg->getPriority() < other._msg->getPriority()) {
-                return true;
+            if (_msg->getPriority() != other._msg->getPriority()) {
+                return (_msg->getPriority() < other._msg->getPriority());
+            }
+            if (_cost != other._cost) {
+                return (_cost < other._cost);
             }
             return (_sequence < other._sequence);
         }
@@ -97,6 +101,7 @@ private:
         api::StorageMessage::SP _cmd;
         std::string _cmdString; // For being able to print message even when we don't own it
         uint64_t _clusterStateVersion;
+        uint64_t _estimatedBytes;
         bool _inCycle;
         bool _executingLocally;
         bool _unwinding;
@@ -132,6 +137,7 @@ private:
         void setAborted(bool aborted) { _aborted = aborted; }
 
         const std::string& getMergeCmdString() const { return _cmdString; }
+        uint64_t getEstimatedBytes() const { return _estimatedBytes; }
     };
 
     typedef std::map<document::Bucket, ChainedMergeState> ActiveMergeMap;
@@ -152,6 +158,8 @@ private:
     ActiveMergeMap _merges;
     MergePriorityQueue _queue;
     std::size_t _maxQueueSize;
+    uint64_t _maxMergeBytes;
+    uint64_t _activeMergeBytes;
     mbus::StaticThrottlePolicy::UP _throttlePolicy;
     uint64_t _queueSequence; // TODO: move into a stable priority queue class
     vespalib::Monitor _messageLock;
@@ -209,6 +217,9 @@ public:
 
     Metrics& getMetrics() { return *_metrics; }
     std::size_t getMaxQueueSize() const { return _maxQueueSize; }
+    // For unit testing only
+    void setMaxMergeBytes(uint64_t maxBytes);
+    uint64_t getActiveMergeBytes() const { return _activeMergeBytes; }
     void print(std::ostream& out, bool verbose, const std::string& indent) const override;
     void reportHtmlStatus(std::ostream&, const framework::HttpUrlPath&) const override;
 private:
@@ -332,9 +343,10 @@ private:
 
     /**
      * @return true if throttle policy says at least one additional
-     * merge can be processed.
+     * merge can be processed, and a merge of the given estimated size
+     * fits within the byte limit.
      */
-    bool canProcessNewMerge() const;
+    bool canProcessNewMerge(uint64_t estimatedBytes) const;
 
     bool merge_is_backpressure_throttled(const api::MergeBucketCommand& cmd) const;
     void bounce_backpressure_throttled_merge(const api::MergeBucketCommand& cmd, MessageGuard& guard);
@@ -0,0 +1,76 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "iterator_prefetch_budget.h"
+#include <algorithm>
+#include <cassert>
+
+namespace storage {
+
+IteratorPrefetchBudget::Reservation::Reservation(IteratorPrefetchBudget& budget,
+                                                 uint32_t buckets, uint64_t bytes)
+    : _budget(budget),
+      _buckets(buckets),
+      _bytes(bytes)
+{ }
+
+IteratorPrefetchBudget::Reservation::~Reservation()
+{
+    _budget.release(_bytes);
+}
+
+IteratorPrefetchBudget::IteratorPrefetchBudget(uint64_t limit)
+    : _lock(),
+      _limit(limit),
+      _used(0)
+{ }
+
+IteratorPrefetchBudget::~IteratorPrefetchBudget()
+{
+    assert(_used == 0);
+}
+
+std::unique_ptr<IteratorPrefetchBudget::Reservation>
+IteratorPrefetchBudget::reserve(uint32_t wantedBuckets, uint64_t bytesPerBucket)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    uint64_t available = (_used < _limit) ? (_limit - _used) : 0;
+    uint64_t buckets = (bytesPerBucket > 0) ? (available / bytesPerBucket) : wantedBuckets;
+    buckets = std::min(buckets, uint64_t(wantedBuckets));
+    if (buckets == 0) {
+        return std::unique_ptr<Reservation>();
+    }
+    uint64_t bytes = buckets * bytesPerBucket;
+    _used += bytes;
+    return std::make_unique<Reservation>(*this, buckets, bytes);
+}
+
+void
+IteratorPrefetchBudget::release(uint64_t bytes)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    assert(_used >= bytes);
+    _used -= bytes;
+}
+
+void
+IteratorPrefetchBudget::setLimit(uint64_t limit)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _limit = limit;
+}
+
+uint64_t
+IteratorPrefetchBudget::getLimit() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _limit;
+}
+
+uint64_t
+IteratorPrefetchBudget::getUsed() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _used;
+}
+
+}
@@ -0,0 +1,60 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+
+namespace storage {
+
+/**
+ * Node wide memory budget for visitors prefetching iterators for more
+ * buckets than the default number of parallel iterators. Each extra bucket
+ * may have a full document block pending towards the persistence threads,
+ * so visitors reserve one document block per extra bucket up front. The
+ * budget is shared by all visitor threads.
+ */
+class IteratorPrefetchBudget {
+public:
+    /**
+     * Memory reserved for a single visitor. The memory is given back to the
+     * budget when the reservation is destroyed.
+     */
+    class Reservation {
+    public:
+        Reservation(IteratorPrefetchBudget& budget, uint32_t buckets, uint64_t bytes);
+        ~Reservation();
+        Reservation(const Reservation&) = delete;
+        Reservation& operator=(const Reservation&) = delete;
+
+        uint32_t getBuckets() const noexcept { return _buckets; }
+        uint64_t getBytes() const noexcept { return _bytes; }
+    private:
+        IteratorPrefetchBudget& _budget;
+        uint32_t _buckets;
+        uint64_t _bytes;
+    };
+
+    explicit IteratorPrefetchBudget(uint64_t limit);
+    ~IteratorPrefetchBudget();
+
+    /**
+     * Reserve memory for up to wantedBuckets extra buckets of
+     * bytesPerBucket each. Fewer buckets are granted if the budget does not
+     * allow all of them. Returns nullptr if not even one bucket could be
+     * granted.
+     */
+    std::unique_ptr<Reservation> reserve(uint32_t wantedBuckets, uint64_t bytesPerBucket);
+
+    void setLimit(uint64_t limit);
+    uint64_t getLimit() const;
+    uint64_t getUsed() const;
+private:
+    void release(uint64_t bytes);
+
+    mutable std::mutex _lock;
+    uint64_t _limit;
+    uint64_t _used;
+};
+
+}
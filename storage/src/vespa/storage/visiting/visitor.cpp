@@ -251,6 +251,10 @@ Visitor::Visitor(StorageComponent& component)
       _startTime(_component.getClock().getTimeInMicros()),
       _hasSentReply(false),
       _docBlockSize(1024),
+      _minDocBlockSize(1024),
+      _maxDocBlockSize(1024),
+      _targetAckLatency(0),
+      _averageAckLatency(-1),
       _memoryUsageLimit(UINT32_MAX),
       _docBlockTimeout(180 * 1000),
       _visitorInfoTimeout(60 * 1000),
@@ -262,6 +266,7 @@ Visitor::Visitor(StorageComponent& component)
       _priority(api::StorageMessage::NORMAL),
       _result(api::ReturnCode::OK),
       _trace(DEFAULT_TRACE_MEMORY_LIMIT),
+      _prefetchReservation(),
       _messageHandler(0),
       _id(),
       _controlDestination(),
@@ -689,8 +694,11 @@ Visitor::handleDocumentApiReply(mbus::Reply::UP reply,
     auto meta = _visitorTarget.releaseMetaForMessageId(messageId);
 
     if (!reply->hasErrors()) {
-        metrics.averageMessageSendTime[getLoadType()].addValue(
-                (message->getTimeRemaining() - message->getTimeRemainingNow()) / 1000.0);
+        double ackLatency = message->getTimeRemaining() - message->getTimeRemainingNow();
+        metrics.averageMessageSendTime[getLoadType()].addValue(ackLatency / 1000.0);
+        if (message->getType() != documentapi::DocumentProtocol::MESSAGE_VISITORINFO) {
+            adjustDocBlockSize(ackLatency);
+        }
         LOG(debug, "Visitor '%s' reply %s for message ID %" PRIu64 " was OK", _id.c_str(),
             reply->toString().c_str(), messageId);
 
@@ -903,6 +911,32 @@ Visitor::onGetIterReply(const std::shared_ptr<GetIterReply>& reply,
     continueVisitor();
 }
 
+void
+Visitor::adjustDocBlockSize(double ackLatency)
+{
+    if (_maxDocBlockSize <= _minDocBlockSize) {
+        return;
+    }
+    _averageAckLatency = (_averageAckLatency < 0)
+            ? ackLatency
+            : (0.8 * _averageAckLatency + 0.2 * ackLatency);
+    // Grow while the client keeps up with plenty of margin, back off as soon
+    // as it falls behind. Halving and doubling keeps the size a multiple of
+    // the configured default.
+    uint32_t newSize = _docBlockSize;
+    if (_averageAckLatency * 2 < _targetAckLatency) {
+        newSize = std::min(uint64_t(_docBlockSize) * 2, uint64_t(_maxDocBlockSize));
+    } else if (_averageAckLatency > _targetAckLatency) {
+        newSize = std::max(_docBlockSize / 2, _minDocBlockSize);
+    }
+    if (newSize != _docBlockSize) {
+        LOG(debug, "Visitor '%s': Average client ack latency %.1f ms, "
+                   "changing docblock size from %u to %u.",
+            _id.c_str(), _averageAckLatency, _docBlockSize, newSize);
+        _docBlockSize = newSize;
+    }
+}
+
 void
 Visitor::sendDueQueuedMessages(framework::MicroSecTime timeNow)
 {
@@ -1042,6 +1076,12 @@ Visitor::getStatus(std::ostream& out, bool verbose) const
         out << "<tr><td>Max parallel buckets visited</td><td>"
             << _visitorOptions._maxParallel
             << "</td></tr>\n";
+        out << "<tr><td>Docblock size</td><td>" << _docBlockSize;
+        if (_maxDocBlockSize > _minDocBlockSize) {
+            out << " (adaptive " << _minDocBlockSize << " - " << _maxDocBlockSize
+                << ", average client ack latency " << _averageAckLatency << " ms)";
+        }
+        out << "</td></tr>\n";
         out << "<tr><td>Max parallel getiter requests per bucket visited"
             << "</td><td>" << _visitorOptions._maxParallelOneBucket
             << "</td></tr>\n";
@@ -13,6 +13,7 @@
 
 #include "visitormessagesession.h"
 #include "memory_bounded_trace.h"
+#include "iterator_prefetch_budget.h"
 #include <vespa/storageapi/messageapi/storagemessage.h>
 #include <vespa/storageapi/message/visitor.h>
 #include <vespa/document/select/orderingspecification.h>
@@ -22,6 +23,7 @@
 #include <vespa/persistence/spi/docentry.h>
 #include <vespa/persistence/spi/selection.h>
 #include <vespa/persistence/spi/read_consistency.h>
+#include <algorithm>
 #include <list>
 #include <deque>
 
@@ -296,6 +298,10 @@ private:
     bool _hasSentReply;
 
     uint32_t _docBlockSize;
+    uint32_t _minDocBlockSize;
+    uint32_t _maxDocBlockSize;
+    double _targetAckLatency;
+    double _averageAckLatency;
     uint32_t _memoryUsageLimit;
     framework::MilliSecTime _docBlockTimeout;
     framework::MilliSecTime _visitorInfoTimeout;
@@ -320,6 +326,7 @@ private:
 
     static constexpr size_t DEFAULT_TRACE_MEMORY_LIMIT = 65536;
     MemoryBoundedTrace _trace;
+    std::unique_ptr<IteratorPrefetchBudget::Reservation> _prefetchReservation;
 
     Visitor(const Visitor &);
     Visitor& operator=(const Visitor &);
@@ -368,8 +375,21 @@ public:
 
     void setFieldSet(const std::string& fieldSet) { _visitorOptions._fieldSet = fieldSet; }
     void visitRemoves() { _visitorOptions._visitRemoves = true; }
-    void setDocBlockSize(uint32_t size) { _docBlockSize = size; }
+    void setDocBlockSize(uint32_t size) {
+        _docBlockSize = size;
+        _minDocBlockSize = size;
+        _maxDocBlockSize = std::max(_maxDocBlockSize, size);
+    }
     uint32_t getDocBlockSize() const { return _docBlockSize; }
+    /**
+     * Let the docblock size grow up to maxSize while clients ack data
+     * messages faster than the target latency (in ms). Must be called after
+     * setDocBlockSize().
+     */
+    void setAdaptiveDocBlockSize(uint32_t maxSize, double targetAckLatency) {
+        _maxDocBlockSize = std::max(maxSize, _minDocBlockSize);
+        _targetAckLatency = targetAckLatency;
+    }
     void setMemoryUsageLimit(uint32_t limit) noexcept {
         _memoryUsageLimit = limit;
     }
@@ -503,6 +523,13 @@ public:
         { _visitorOptions._maxParallel = maxParallel; }
     void setMaxParallelPerBucket(uint32_t max)
         { _visitorOptions._maxParallelOneBucket = max; }
+    /**
+     * Hand over memory reserved for iterating more buckets in parallel than
+     * the default. The memory is released when the visitor is destroyed.
+     */
+    void setPrefetchReservation(std::unique_ptr<IteratorPrefetchBudget::Reservation> reservation)
+        { _prefetchReservation = std::move(reservation); }
+    uint32_t getMaxParallel() const { return _visitorOptions._maxParallel; }
 
     /**
      * Sends a message to the data handler for this visitor.
@@ -565,6 +592,7 @@ private:
      * violate maximum pending options.
      */
     void sendDueQueuedMessages(framework::MicroSecTime timeNow);
+    void adjustDocBlockSize(double ackLatency);
 
     /**
      * Whether visitor should enable and forward message bus traces for messages
@@ -25,6 +25,7 @@ VisitorManager::VisitorManager(const config::ConfigUri & configUri,
       framework::HtmlStatusReporter("visitorman", "Visitor Manager"),
       _componentRegister(componentRegister),
       _messageSessionFactory(messageSF),
+      _prefetchBudget(0),
       _visitorThread(),
       _visitorMessages(),
       _visitorLock(),
@@ -193,13 +194,15 @@ VisitorManager::configure(std::unique_ptr<vespa::config::content::core::StorVisi
                         new VisitorThread(i, _componentRegister,
                                           _messageSessionFactory,
                                           _visitorFactories,
-                                          *_metrics->threads[i], *this)),
+                                          *_metrics->threads[i], *this,
+                                          _prefetchBudget)),
                     std::map<api::VisitorId, std::string>()));
         }
     }
     _maxFixedConcurrentVisitors = maxConcurrentVisitorsFixed;
     _maxVariableConcurrentVisitors = maxConcurrentVisitorsVariable;
     _maxVisitorQueueSize = config->maxvisitorqueuesize;
+    _prefetchBudget.setLimit(std::max(config->iteratorPrefetchMemoryLimit, int64_t(0)));
 
     auto cmd = std::make_shared<PropagateVisitorConfig>(*config);
     for (auto& thread : _visitorThread) {
@@ -677,7 +680,9 @@ VisitorManager::reportHtmlStatus(std::ostream& out,
         out << "\n<p>Running " << visitorCount << " visitors. Max concurrent "
             << "visitors: fixed = " << _maxFixedConcurrentVisitors
             << ", variable = " << _maxVariableConcurrentVisitors
-            << ", waiting visitors " << _visitorQueue.size() << "<br>\n";
+            << ", waiting visitors " << _visitorQueue.size() << "<br>\n"
+            << "Iterator prefetch memory: " << _prefetchBudget.getUsed()
+            << " of " << _prefetchBudget.getLimit() << " bytes reserved<br>\n";
     }
         // Only one can access status at a time as _statusRequest only holds
         // answers from one request at a time
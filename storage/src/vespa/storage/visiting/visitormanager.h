@@ -20,6 +20,7 @@
 #pragma once
 
 #include "commandqueue.h"
+#include "iterator_prefetch_budget.h"
 #include "visitor.h"
 #include "visitormetrics.h"
 #include "visitorthread.h"
@@ -48,6 +49,7 @@ class VisitorManager : public framework::Runnable,
 private:
     StorageComponentRegister& _componentRegister;
     VisitorMessageSessionFactory& _messageSessionFactory;
+    IteratorPrefetchBudget _prefetchBudget;
     std::vector<std::pair<std::shared_ptr<VisitorThread>,
                           std::map<api::VisitorId, std::string>
                          > > _visitorThread;
@@ -117,6 +119,8 @@ public:
     }
     /** For unit testing */
     bool hasPendingMessageState() const;
+    /** For unit testing */
+    const IteratorPrefetchBudget& getPrefetchBudget() const { return _prefetchBudget; }
 
     void enforceQueueUsage() { _enforceQueueUse = true; }
 
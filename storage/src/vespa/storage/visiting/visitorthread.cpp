@@ -79,7 +79,8 @@ VisitorThread::VisitorThread(uint32_t threadIndex,
                              VisitorMessageSessionFactory& messageSessionFac,
                              VisitorFactory::Map& visitorFactories,
                              VisitorThreadMetrics& metrics,
-                             VisitorMessageHandler& sender)
+                             VisitorMessageHandler& sender,
+                             IteratorPrefetchBudget& prefetchBudget)
     : _visitors(),
       _recentlyCompleted(),
       _queue(),
@@ -94,7 +95,11 @@ VisitorThread::VisitorThread(uint32_t threadIndex,
       _iteratorsPerBucket(1),
       _defaultPendingMessages(0),
       _defaultDocBlockSize(0),
+      _maxAdaptiveDocBlockSize(0),
+      _docBlockTargetAckLatency(0),
       _visitorMemoryUsageLimit(UINT32_MAX),
+      _maxPrefetchBuckets(0),
+      _prefetchBudget(prefetchBudget),
       _defaultDocBlockTimeout(180000),
       _timeBetweenTicks(1000),
       _component(componentRegister, getThreadName(threadIndex)),
@@ -417,6 +422,8 @@ namespace {
                     mbus::Route::parse(cmd.getControlDestination())));
     }
 
+const vespalib::string PREFETCH_BUCKETS_PARAMETER("prefetchbuckets");
+
 void
 validateDocumentSelection(const document::DocumentTypeRepo& repo,
                           const document::select::Node& selection)
@@ -436,6 +443,31 @@ validateDocumentSelection(const document::DocumentTypeRepo& repo,
 
 }
 
+uint32_t
+VisitorThread::getParallelIterators(const api::CreateVisitorCommand& cmd, Visitor& visitor)
+{
+    if (!cmd.getParameters().hasValue(PREFETCH_BUCKETS_PARAMETER)) {
+        return _defaultParallelIterators;
+    }
+    // The bucket currently being processed plus the prefetched ones.
+    int32_t prefetch = cmd.getParameters().get(PREFETCH_BUCKETS_PARAMETER, int32_t(0));
+    uint32_t wanted = std::min(static_cast<uint32_t>(std::max(prefetch, 0)), _maxPrefetchBuckets) + 1;
+    wanted = std::min(wanted, std::max(static_cast<uint32_t>(cmd.getBuckets().size()), 1u));
+    if (wanted <= _defaultParallelIterators) {
+        return wanted;
+    }
+    auto reservation = _prefetchBudget.reserve(wanted - _defaultParallelIterators, _defaultDocBlockSize);
+    if (!reservation) {
+        LOG(debug, "CreateVisitor(%s): No iterator prefetch memory available, "
+                   "visiting %u buckets in parallel rather than %u.",
+            cmd.getInstanceId().c_str(), _defaultParallelIterators, wanted);
+        return _defaultParallelIterators;
+    }
+    uint32_t parallel = _defaultParallelIterators + reservation->getBuckets();
+    visitor.setPrefetchReservation(std::move(reservation));
+    return parallel;
+}
+
 bool
 VisitorThread::onCreateVisitor(
         const std::shared_ptr<api::CreateVisitorCommand>& cmd)
@@ -483,10 +515,11 @@ VisitorThread::onCreateVisitor(
             visitor->visitRemoves();
         }
 
-        visitor->setMaxParallel(_defaultParallelIterators);
+        visitor->setMaxParallel(getParallelIterators(*cmd, *visitor));
         visitor->setMaxParallelPerBucket(_iteratorsPerBucket);
 
         visitor->setDocBlockSize(_defaultDocBlockSize);
+        visitor->setAdaptiveDocBlockSize(_maxAdaptiveDocBlockSize, _docBlockTargetAckLatency);
         visitor->setMemoryUsageLimit(_visitorMemoryUsageLimit);
 
         visitor->setDocBlockTimeout(_defaultDocBlockTimeout);
@@ -641,7 +674,10 @@ VisitorThread::onInternal(const std::shared_ptr<api::InternalCommand>& cmd)
             _iteratorsPerBucket = config.iteratorsPerBucket;
             _defaultPendingMessages = config.defaultpendingmessages;
             _defaultDocBlockSize = config.defaultdocblocksize;
+            _maxAdaptiveDocBlockSize = std::max(config.maxAdaptiveDocblocksize, 0);
+            _docBlockTargetAckLatency = std::max(config.docblockTargetAckLatency, 0);
             _visitorMemoryUsageLimit = config.visitorMemoryUsageLimit;
+            _maxPrefetchBuckets = std::max(config.maxPrefetchBuckets, 0);
             _defaultDocBlockTimeout.setTime(config.defaultdocblocktimeout);
             _defaultVisitorInfoTimeout.setTime(config.defaultinfotimeout);
             if (_defaultParallelIterators < 1) {
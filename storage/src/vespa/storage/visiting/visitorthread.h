@@ -16,6 +16,7 @@
 #include "visitor.h"
 #include "visitormetrics.h"
 #include "visitormessagesessionfactory.h"
+#include "iterator_prefetch_budget.h"
 #include <vespa/storage/persistence/messages.h>
 #include <vespa/storage/common/storagecomponent.h>
 #include <vespa/storageframework/generic/metric/metricupdatehook.h>
@@ -82,7 +83,11 @@ class VisitorThread : public framework::Runnable,
     uint32_t _iteratorsPerBucket;
     uint32_t _defaultPendingMessages;
     uint32_t _defaultDocBlockSize;
+    uint32_t _maxAdaptiveDocBlockSize;
+    uint32_t _docBlockTargetAckLatency;
     uint32_t _visitorMemoryUsageLimit;
+    uint32_t _maxPrefetchBuckets;
+    IteratorPrefetchBudget& _prefetchBudget;
     framework::MilliSecTime _defaultDocBlockTimeout;
     framework::MilliSecTime _defaultVisitorInfoTimeout;
     uint32_t _timeBetweenTicks;
@@ -97,7 +102,8 @@ public:
                   VisitorMessageSessionFactory&,
                   VisitorFactory::Map&,
                   VisitorThreadMetrics& metrics,
-                  VisitorMessageHandler& sender);
+                  VisitorMessageHandler& sender,
+                  IteratorPrefetchBudget& prefetchBudget);
     ~VisitorThread();
 
     void processMessage(api::VisitorId visitorId, const std::shared_ptr<api::StorageMessage>& msg);
@@ -130,6 +136,13 @@ private:
                                            vespalib::asciistream & error);
 
     bool onCreateVisitor(const std::shared_ptr<api::CreateVisitorCommand>&) override;
+    /**
+     * Returns the number of buckets the visitor may iterate in parallel. A
+     * visitor may ask to prefetch iterators for more buckets than the default
+     * through the "prefetchbuckets" parameter, which is granted as far as the
+     * node wide prefetch memory budget allows.
+     */
+    uint32_t getParallelIterators(const api::CreateVisitorCommand&, Visitor&);
 
     bool onVisitorReply(const std::shared_ptr<api::StorageReply>& reply);
     bool onInternal(const std::shared_ptr<api::InternalCommand>&) override;
@@ -68,7 +68,8 @@ struct StorageProtocolTest : public CppUnit::TestFixture {
     template<typename Command>
     std::shared_ptr<Command> copyCommand(const std::shared_ptr<Command>&, vespalib::Version);
     template<typename Reply>
-    std::shared_ptr<Reply> copyReply(const std::shared_ptr<Reply>&);
+    std::shared_ptr<Reply> copyReply(const std::shared_ptr<Reply>&,
+                                     vespalib::Version version = vespalib::Version(5, 1, 0));
     void recordOutput(const api::StorageMessage& msg);
 
     void recordSerialization50();
@@ -101,12 +102,14 @@ struct StorageProtocolTest : public CppUnit::TestFixture {
     void testSetBucketState51();
 
     void testPutCommand52();
+    void testPutCommandWithSerializedDocument52();
     void testUpdateCommand52();
     void testRemoveCommand52();
 
     void testPutCommandWithBucketSpace6_0();
     void testCreateVisitorWithBucketSpace6_0();
     void testRequestBucketInfoWithBucketSpace6_0();
+    void testGetBucketDiffWithDigests6_0();
 
     CPPUNIT_TEST_SUITE(StorageProtocolTest);
 
@@ -142,6 +145,7 @@ struct StorageProtocolTest : public CppUnit::TestFixture {
 
     // 5.2 tests
     CPPUNIT_TEST(testPutCommand52);
+    CPPUNIT_TEST(testPutCommandWithSerializedDocument52);
     CPPUNIT_TEST(testUpdateCommand52);
     CPPUNIT_TEST(testRemoveCommand52);
 
@@ -149,6 +153,7 @@ struct StorageProtocolTest : public CppUnit::TestFixture {
     CPPUNIT_TEST(testPutCommandWithBucketSpace6_0);
     CPPUNIT_TEST(testCreateVisitorWithBucketSpace6_0);
     CPPUNIT_TEST(testRequestBucketInfoWithBucketSpace6_0);
+    CPPUNIT_TEST(testGetBucketDiffWithDigests6_0);
 
     CPPUNIT_TEST_SUITE_END();
 };
@@ -221,11 +226,11 @@ StorageProtocolTest::copyCommand(const std::shared_ptr<Command>& m, vespalib::Ve
 }
 
 template<typename Reply> std::shared_ptr<Reply>
-StorageProtocolTest::copyReply(const std::shared_ptr<Reply>& m)
+StorageProtocolTest::copyReply(const std::shared_ptr<Reply>& m, vespalib::Version version)
 {
     mbus::Reply::UP mbusMessage(new mbusprot::StorageReply(m));
-    mbus::Blob blob = _protocol.encode(_version5_1, *mbusMessage);
-    mbus::Routable::UP copy(_protocol.decode(_version5_1, blob));
+    mbus::Blob blob = _protocol.encode(version, *mbusMessage);
+    mbus::Routable::UP copy(_protocol.decode(version, blob));
     CPPUNIT_ASSERT(copy.get());
     mbusprot::StorageReply* copy2(
             dynamic_cast<mbusprot::StorageReply*>(copy.get()));
@@ -932,6 +937,29 @@ StorageProtocolTest::testPutCommand52()
     CPPUNIT_ASSERT_EQUAL(cmd->getCondition().getSelection(), cmd2->getCondition().getSelection());
 }
 
+void
+StorageProtocolTest::testPutCommandWithSerializedDocument52()
+{
+    ScopedName test("testPutCommandWithSerializedDocument52");
+
+    // The serialized form is written as is, so make it differ from the
+    // document object to see which one was encoded.
+    document::Document::SP received(_docMan.createDocument("received content"));
+    vespalib::nbostream stream;
+    received->serialize(stream);
+    auto serialized = std::make_shared<const std::vector<char>>(stream.peek(), stream.peek() + stream.size());
+
+    PutCommand::SP cmd(new PutCommand(_bucket, _testDoc, 14));
+    cmd->setSerializedDocument(serialized);
+    cmd->setCondition(TestAndSetCondition(CONDITION_STRING));
+
+    PutCommand::SP cmd2(copyCommand(cmd, _version5_2));
+    CPPUNIT_ASSERT_EQUAL(*received, *cmd2->getDocument());
+    CPPUNIT_ASSERT(!cmd2->getSerializedDocument());
+    CPPUNIT_ASSERT_EQUAL(Timestamp(14), cmd2->getTimestamp());
+    CPPUNIT_ASSERT_EQUAL(cmd->getCondition().getSelection(), cmd2->getCondition().getSelection());
+}
+
 void
 StorageProtocolTest::testUpdateCommand52()
 {
@@ -995,6 +1023,35 @@ StorageProtocolTest::testRequestBucketInfoWithBucketSpace6_0()
     CPPUNIT_ASSERT_EQUAL(ids, cmd2->getBuckets());
 }
 
+void
+StorageProtocolTest::testGetBucketDiffWithDigests6_0()
+{
+    ScopedName test("testGetBucketDiffWithDigests6_0");
+
+    std::vector<api::MergeBucketCommand::Node> nodes = {4, 13, 7};
+    std::vector<GetBucketDiffCommand::RangeDigest> digests = {
+        GetBucketDiffCommand::RangeDigest(1000, 0x1234567890abcdefULL, 64),
+        GetBucketDiffCommand::RangeDigest(UINT64_MAX, 42, 17)};
+    std::vector<uint16_t> mismatch = {0, 6};
+    auto cmd = std::make_shared<GetBucketDiffCommand>(_bucket, nodes, 1056);
+    cmd->getDigests() = digests;
+    cmd->getDigestMismatch() = mismatch;
+
+    auto cmd2 = copyCommand(cmd, _version6_0);
+    CPPUNIT_ASSERT(cmd2->useDigests());
+    CPPUNIT_ASSERT(digests == cmd2->getDigests());
+    CPPUNIT_ASSERT(mismatch == cmd2->getDigestMismatch());
+
+    auto reply = std::make_shared<GetBucketDiffReply>(*cmd2);
+    auto reply2 = copyReply(reply, _version6_0);
+    CPPUNIT_ASSERT(mismatch == reply2->getDigestMismatch());
+
+    // Digests are not sent to nodes running older versions
+    auto cmd3 = copyCommand(cmd, _version5_2);
+    CPPUNIT_ASSERT(!cmd3->useDigests());
+    CPPUNIT_ASSERT(cmd3->getDigestMismatch().empty());
+}
+
 void
 StorageProtocolTest::testStringOutputs()
 {
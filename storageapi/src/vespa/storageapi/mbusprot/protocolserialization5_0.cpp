@@ -118,7 +118,11 @@ void ProtocolSerialization5_0::onEncode(
 void ProtocolSerialization5_0::onEncode(
         GBBuf& buf, const api::PutCommand& msg) const
 {
-    SH::putDocument(msg.getDocument().get(), buf);
+    if (msg.getSerializedDocument()) {
+        SH::putSerializedDocument(*msg.getSerializedDocument(), buf);
+    } else {
+        SH::putDocument(msg.getDocument().get(), buf);
+    }
     putBucket(msg.getBucket(), buf);
     buf.putLong(msg.getTimestamp());
     buf.putLong(msg.getUpdateTimestamp());
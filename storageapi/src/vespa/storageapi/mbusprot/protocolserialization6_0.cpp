@@ -39,5 +39,93 @@ ProtocolSerialization6_0::putBucketSpace(document::BucketSpace bucketSpace, vesp
     buf.putLong(bucketSpace.getId());
 }
 
+void
+ProtocolSerialization6_0::putDigestMismatch(const std::vector<uint16_t> &mismatch, GBBuf &buf) const
+{
+    buf.putInt(mismatch.size());
+    for (uint16_t mask : mismatch) {
+        buf.putShort(mask);
+    }
+}
+
+void
+ProtocolSerialization6_0::getDigestMismatch(BBuf &buf, std::vector<uint16_t> &mismatch) const
+{
+    uint32_t count = SH::getInt(buf);
+    if (count > buf.getRemaining()) {
+        // Trigger out of bounds exception rather than out of memory error
+        buf.incPos(count);
+    }
+    mismatch.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        mismatch[i] = SH::getShort(buf);
+    }
+}
+
+void
+ProtocolSerialization6_0::onEncode(GBBuf &buf, const api::MergeBucketCommand &msg) const
+{
+    ProtocolSerialization5_0::onEncode(buf, msg);
+    buf.putLong(msg.getEstimatedMergeBytes());
+}
+
+api::StorageCommand::UP
+ProtocolSerialization6_0::onDecodeMergeBucketCommand(BBuf &buf) const
+{
+    api::StorageCommand::UP cmd(ProtocolSerialization5_0::onDecodeMergeBucketCommand(buf));
+    static_cast<api::MergeBucketCommand &>(*cmd).setEstimatedMergeBytes(SH::getLong(buf));
+    return cmd;
+}
+
+void
+ProtocolSerialization6_0::onEncode(GBBuf &buf, const api::GetBucketDiffCommand &msg) const
+{
+    ProtocolSerialization4_2::onEncode(buf, msg);
+    const std::vector<api::GetBucketDiffCommand::RangeDigest> &digests(msg.getDigests());
+    buf.putInt(digests.size());
+    for (const auto &digest : digests) {
+        buf.putLong(digest._end);
+        buf.putLong(digest._hash);
+        buf.putInt(digest._count);
+    }
+    putDigestMismatch(msg.getDigestMismatch(), buf);
+}
+
+void
+ProtocolSerialization6_0::onEncode(GBBuf &buf, const api::GetBucketDiffReply &msg) const
+{
+    ProtocolSerialization5_0::onEncode(buf, msg);
+    putDigestMismatch(msg.getDigestMismatch(), buf);
+}
+
+api::StorageCommand::UP
+ProtocolSerialization6_0::onDecodeGetBucketDiffCommand(BBuf &buf) const
+{
+    api::StorageCommand::UP cmd(ProtocolSerialization4_2::onDecodeGetBucketDiffCommand(buf));
+    auto &msg = static_cast<api::GetBucketDiffCommand &>(*cmd);
+    uint32_t count = SH::getInt(buf);
+    if (count > buf.getRemaining()) {
+        // Trigger out of bounds exception rather than out of memory error
+        buf.incPos(count);
+    }
+    std::vector<api::GetBucketDiffCommand::RangeDigest> &digests(msg.getDigests());
+    digests.resize(count);
+    for (auto &digest : digests) {
+        digest._end = SH::getLong(buf);
+        digest._hash = SH::getLong(buf);
+        digest._count = SH::getInt(buf);
+    }
+    getDigestMismatch(buf, msg.getDigestMismatch());
+    return cmd;
+}
+
+api::StorageReply::UP
+ProtocolSerialization6_0::onDecodeGetBucketDiffReply(const SCmd &cmd, BBuf &buf) const
+{
+    api::StorageReply::UP reply(ProtocolSerialization5_0::onDecodeGetBucketDiffReply(cmd, buf));
+    getDigestMismatch(buf, static_cast<api::GetBucketDiffReply &>(*reply).getDigestMismatch());
+    return reply;
+}
+
 }
 }
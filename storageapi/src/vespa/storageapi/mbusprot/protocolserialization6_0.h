@@ -11,10 +11,16 @@ namespace mbusprot {
 
 /**
  * Protocol serialization version adding decoding and encoding
- * of bucket space to almost all commands.
+ * of bucket space to almost all commands, of the range digests
+ * used to compare bucket contents in GetBucketDiff, and of the
+ * estimated size of merges.
  */
 class ProtocolSerialization6_0 : public ProtocolSerialization5_2
 {
+private:
+    void putDigestMismatch(const std::vector<uint16_t> &mismatch, GBBuf &buf) const;
+    void getDigestMismatch(BBuf &buf, std::vector<uint16_t> &mismatch) const;
+
 public:
     ProtocolSerialization6_0(const document::DocumentTypeRepo::SP &repo,
                              const documentapi::LoadTypeSet &loadTypes);
@@ -23,6 +29,13 @@ public:
     void putBucket(const document::Bucket &bucket, vespalib::GrowableByteBuffer &buf) const override;
     document::BucketSpace getBucketSpace(document::ByteBuffer &buf) const override;
     void putBucketSpace(document::BucketSpace bucketSpace, vespalib::GrowableByteBuffer &buf) const override;
+
+    void onEncode(GBBuf &, const api::MergeBucketCommand &) const override;
+    SCmd::UP onDecodeMergeBucketCommand(BBuf &) const override;
+    void onEncode(GBBuf &, const api::GetBucketDiffCommand &) const override;
+    void onEncode(GBBuf &, const api::GetBucketDiffReply &) const override;
+    SCmd::UP onDecodeGetBucketDiffCommand(BBuf &) const override;
+    SRep::UP onDecodeGetBucketDiffReply(const SCmd &, BBuf &) const override;
 };
 
 }
@@ -131,6 +131,13 @@ public:
         }
     }
 
+    static void putSerializedDocument(const std::vector<char>& serialized,
+                                      vespalib::GrowableByteBuffer& buf)
+    {
+        buf.putInt(serialized.size());
+        buf.putBytes(serialized.data(), serialized.size());
+    }
+
     static void putUpdate(document::DocumentUpdate* update,
                           vespalib::GrowableByteBuffer& buf)
     {
@@ -105,7 +105,8 @@ MergeBucketCommand::MergeBucketCommand(
       _nodes(nodes),
       _maxTimestamp(maxTimestamp),
       _clusterStateVersion(clusterStateVersion),
-      _chain(chain)
+      _chain(chain),
+      _estimatedMergeBytes(0)
 {}
 
 MergeBucketCommand::~MergeBucketCommand() {}
@@ -129,7 +130,7 @@ MergeBucketCommand::print(std::ostream& out, bool verbose, const std::string& in
     out << ", reasons to start: " << _reason;
     out << ")";
     if (verbose) {
-        out << " : ";
+        out << " : estimated bytes " << _estimatedMergeBytes << ", ";
         BucketCommand::print(out, verbose, indent);
     }
 }
@@ -208,7 +209,10 @@ GetBucketDiffCommand::GetBucketDiffCommand(
         Timestamp maxTimestamp)
     : BucketCommand(MessageType::GETBUCKETDIFF, bucket),
       _nodes(nodes),
-      _maxTimestamp(maxTimestamp)
+      _maxTimestamp(maxTimestamp),
+      _diff(),
+      _digests(),
+      _digestMismatch()
 {}
 
 GetBucketDiffCommand::~GetBucketDiffCommand() {}
@@ -223,6 +227,9 @@ GetBucketDiffCommand::print(std::ostream& out, bool verbose,
         if (i != 0) out << ", ";
         out << _nodes[i];
     }
+    if (!_digests.empty()) {
+        out << ", " << _digests.size() << " range digests";
+    }
     if (_diff.empty()) {
         out << ", no entries";
     } else if (verbose) {
@@ -246,7 +253,8 @@ GetBucketDiffReply::GetBucketDiffReply(const GetBucketDiffCommand& cmd)
     : BucketReply(cmd),
       _nodes(cmd.getNodes()),
       _maxTimestamp(cmd.getMaxTimestamp()),
-      _diff(cmd.getDiff())
+      _diff(cmd.getDiff()),
+      _digestMismatch(cmd.getDigestMismatch())
 {}
 
 GetBucketDiffReply::~GetBucketDiffReply() {}
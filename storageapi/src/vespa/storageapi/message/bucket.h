@@ -116,6 +116,7 @@ private:
     Timestamp _maxTimestamp;
     uint32_t _clusterStateVersion;
     std::vector<uint16_t> _chain;
+    uint64_t _estimatedMergeBytes;
 
 public:
     MergeBucketCommand(const document::Bucket &bucket,
@@ -131,6 +132,13 @@ public:
     uint32_t getClusterStateVersion() const { return _clusterStateVersion; }
     void setClusterStateVersion(uint32_t version) { _clusterStateVersion = version; }
     void setChain(const std::vector<uint16_t>& chain) { _chain = chain; }
+    /**
+     * Upper bound of the amount of data the merge may move, as estimated
+     * by the distributor from the bucket info of the copies. 0 if unknown.
+     * Used by the storage nodes to throttle merges by size.
+     */
+    uint64_t getEstimatedMergeBytes() const { return _estimatedMergeBytes; }
+    void setEstimatedMergeBytes(uint64_t bytes) { _estimatedMergeBytes = bytes; }
     void print(std::ostream& out, bool verbose, const std::string& indent) const override;
     DECLARE_STORAGECOMMAND(MergeBucketCommand, onMergeBucket)
 };
@@ -190,10 +198,34 @@ public:
         bool operator<(const Entry& e) const
             { return (_timestamp < e._timestamp); }
     };
+
+    /**
+     * Digest of the entries the first node in the merge chain has in a
+     * range of timestamps. The ranges are contiguous; the first starts
+     * at timestamp 0 and each range ends (exclusive) at '_end'.
+     *
+     * When digests are given, the first node does not list its entries.
+     * Each following node instead adds its own entries in the ranges
+     * where its digest differs, and flags those ranges in the digest
+     * mismatch masks (one bit per node, as for Entry::_hasMask).
+     */
+    struct RangeDigest {
+        Timestamp _end;
+        uint64_t _hash;
+        uint32_t _count;
+
+        RangeDigest() : _end(0), _hash(0), _count(0) {}
+        RangeDigest(Timestamp end, uint64_t hash, uint32_t count)
+            : _end(end), _hash(hash), _count(count) {}
+        bool operator==(const RangeDigest& d) const
+            { return (_end == d._end && _hash == d._hash && _count == d._count); }
+    };
 private:
     std::vector<Node> _nodes;
     Timestamp _maxTimestamp;
     std::vector<Entry> _diff;
+    std::vector<RangeDigest> _digests;
+    std::vector<uint16_t> _digestMismatch;
 
 public:
     GetBucketDiffCommand(const document::Bucket &bucket,
@@ -205,6 +237,11 @@ public:
     Timestamp getMaxTimestamp() const { return _maxTimestamp; }
     const std::vector<Entry>& getDiff() const { return _diff; }
     std::vector<Entry>& getDiff() { return _diff; }
+    const std::vector<RangeDigest>& getDigests() const { return _digests; }
+    std::vector<RangeDigest>& getDigests() { return _digests; }
+    const std::vector<uint16_t>& getDigestMismatch() const { return _digestMismatch; }
+    std::vector<uint16_t>& getDigestMismatch() { return _digestMismatch; }
+    bool useDigests() const { return !_digests.empty(); }
 
     void print(std::ostream& out, bool verbose, const std::string& indent) const override;
 
@@ -226,6 +263,7 @@ private:
     std::vector<Node> _nodes;
     Timestamp _maxTimestamp;
     std::vector<Entry> _diff;
+    std::vector<uint16_t> _digestMismatch;
 
 public:
     explicit GetBucketDiffReply(const GetBucketDiffCommand& cmd);
@@ -235,6 +273,9 @@ public:
     Timestamp getMaxTimestamp() const { return _maxTimestamp; }
     const std::vector<Entry>& getDiff() const { return _diff; }
     std::vector<Entry>& getDiff() { return _diff; }
+    /** Per range mismatch masks, set when the command used digests. */
+    const std::vector<uint16_t>& getDigestMismatch() const { return _digestMismatch; }
+    std::vector<uint16_t>& getDigestMismatch() { return _digestMismatch; }
     void print(std::ostream& out, bool verbose, const std::string& indent) const override;
 
     DECLARE_STORAGEREPLY(GetBucketDiffReply, onGetBucketDiffReply)
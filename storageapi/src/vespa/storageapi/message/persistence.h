@@ -42,7 +42,11 @@ public:
  * @brief Command for adding a document to the storage system.
  */
 class PutCommand : public TestAndSetCommand {
+public:
+    using SerializedDocument = std::shared_ptr<const std::vector<char>>;
+private:
     document::Document::SP _doc;
+    SerializedDocument _serializedDoc;
     Timestamp _timestamp;
     Timestamp _updateTimestamp;
 
@@ -64,6 +68,14 @@ public:
     const document::DocumentId& getDocumentId() const override { return _doc->getId(); }
     Timestamp getTimestamp() const { return _timestamp; }
 
+    /**
+     * The serialized form of getDocument() as received from the client, if
+     * known. Encoding writes these bytes as they are instead of serializing
+     * the document again. Must only be set while the document is unmodified.
+     */
+    void setSerializedDocument(SerializedDocument serialized) { _serializedDoc = std::move(serialized); }
+    const SerializedDocument& getSerializedDocument() const { return _serializedDoc; }
+
     uint32_t getMemoryFootprint() const override {
         return (_doc.get() ? 4096 : 0) + 20;
     }
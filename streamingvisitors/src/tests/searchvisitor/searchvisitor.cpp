@@ -23,6 +23,7 @@ private:
     std::unique_ptr<StorageComponent> _component;
     SearchEnvironment                 _env;
     void testSearchVisitor();
+    void testSearchVisitorWithPrepareThreads();
     void testSearchEnvironment();
     void testCreateSearchVisitor(const vespalib::string & dir, const vdslib::Parameters & parameters);
     void testOnlyRequireWeakReadConsistency();
@@ -53,9 +54,11 @@ createDocuments(const vespalib::string & dir)
     (void) dir;
     std::vector<spi::DocEntry::UP> documents;
     spi::Timestamp ts;
-    document::Document::UP doc(new document::Document());
-    spi::DocEntry::UP e(new spi::DocEntry(ts, 0, std::move(doc)));
-    documents.push_back(std::move(e));
+    for (size_t i(0); i < 5; i++) {
+        document::Document::UP doc(new document::Document());
+        spi::DocEntry::UP e(new spi::DocEntry(ts, 0, std::move(doc)));
+        documents.push_back(std::move(e));
+    }
     return documents;
 }
 
@@ -77,6 +80,11 @@ SearchVisitorTest::testSearchEnvironment()
 {
     EXPECT_TRUE(_env.getVSMAdapter("simple") != NULL);
     EXPECT_TRUE(_env.getRankManager("simple") != NULL);
+    vespalib::SimpleThreadBundle::Pool & pool = _env.getThreadBundlePool(3);
+    EXPECT_EQUAL(&pool, &_env.getThreadBundlePool(3));
+    vespalib::SimpleThreadBundle::UP bundle = pool.obtain();
+    EXPECT_EQUAL(3u, bundle->size());
+    pool.release(std::move(bundle));
 }
 
 void
@@ -98,6 +106,24 @@ SearchVisitorTest::testSearchVisitor()
     testCreateSearchVisitor("dir:" + TEST_PATH("cfg"), params);
 }
 
+void
+SearchVisitorTest::testSearchVisitorWithPrepareThreads()
+{
+    vdslib::Parameters params;
+    params.set("searchcluster", "aaa");
+    params.set("summarycount", "3");
+    params.set("rankprofile", "default");
+    params.set("preparethreads", "2");
+
+    QueryBuilder<SimpleQueryNodeTypes> builder;
+    builder.addStringTerm("maptest", "sddocname", 0, Weight(0));
+    Node::UP node = builder.build();
+    vespalib::string stackDump = StackDumpCreator::create(*node);
+
+    params.set("query", stackDump);
+    testCreateSearchVisitor("dir:" + TEST_PATH("cfg"), params);
+}
+
 void
 SearchVisitorTest::testOnlyRequireWeakReadConsistency()
 {
@@ -115,6 +141,7 @@ SearchVisitorTest::Main()
     TEST_INIT("searchvisitor_test");
 
     testSearchVisitor(); TEST_FLUSH();
+    testSearchVisitorWithPrepareThreads(); TEST_FLUSH();
     testSearchEnvironment(); TEST_FLUSH();
     testOnlyRequireWeakReadConsistency(); TEST_FLUSH();
 
@@ -52,13 +52,26 @@ SearchEnvironment::Env::~Env()
 SearchEnvironment::SearchEnvironment(const config::ConfigUri & configUri) :
     VisitorEnvironment(),
     _envMap(),
-    _configUri(configUri)
+    _configUri(configUri),
+    _threadBundlePools()
 { }
 
 SearchEnvironment::~SearchEnvironment()
 {
     vespalib::LockGuard guard(_lock);
     _threadLocals.clear();
+    _threadBundlePools.clear();
+}
+
+vespalib::SimpleThreadBundle::Pool &
+SearchEnvironment::getThreadBundlePool(size_t numThreads)
+{
+    vespalib::LockGuard guard(_lock);
+    std::unique_ptr<vespalib::SimpleThreadBundle::Pool> & pool = _threadBundlePools[numThreads];
+    if ( ! pool) {
+        pool = std::make_unique<vespalib::SimpleThreadBundle::Pool>(numThreads);
+    }
+    return *pool;
 }
 
 SearchEnvironment::Env &
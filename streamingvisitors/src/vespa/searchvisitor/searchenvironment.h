@@ -9,6 +9,8 @@
 #include <vespa/config/subscription/configuri.h>
 #include <vespa/vsm/vsm/vsm-adapter.h>
 #include <vespa/fastlib/text/normwordfolder.h>
+#include <vespa/vespalib/util/simple_thread_bundle.h>
+#include <map>
 
 namespace storage {
 
@@ -34,6 +36,7 @@ private:
     typedef vespalib::hash_map<vespalib::string, Env::SP> EnvMap;
     typedef std::unique_ptr<EnvMap> EnvMapUP;
     typedef std::vector<EnvMapUP> ThreadLocals;
+    typedef std::map<size_t, std::unique_ptr<vespalib::SimpleThreadBundle::Pool>> ThreadBundlePools;
 
     static __thread EnvMap * _localEnvMap;
     EnvMap                   _envMap;
@@ -41,6 +44,7 @@ private:
     vespalib::Lock           _lock;
     Fast_NormalizeWordFolder _wordFolder;
     config::ConfigUri        _configUri;
+    ThreadBundlePools        _threadBundlePools;
 
     Env & getEnv(const vespalib::string & searchcluster);
 
@@ -49,6 +53,11 @@ public:
     ~SearchEnvironment();
     const vsm::VSMAdapter * getVSMAdapter(const vespalib::string & searchcluster) { return getEnv(searchcluster).getVSMAdapter(); }
     const RankManager * getRankManager(const vespalib::string & searchcluster)    { return getEnv(searchcluster).getRankManager(); }
+    /**
+     * Returns the pool of thread bundles with the given number of threads,
+     * creating it on first use.
+     */
+    vespalib::SimpleThreadBundle::Pool & getThreadBundlePool(size_t numThreads);
 };
 
 }
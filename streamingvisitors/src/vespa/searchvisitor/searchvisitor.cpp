@@ -172,6 +172,7 @@ SearchVisitor::SearchVisitor(StorageComponent& component,
     _docSearchedCount(0),
     _hitCount(0),
     _hitsRejectedCount(0),
+    _prepareThreads(1),
     _query(),
     _queryResult(new documentapi::QueryResultMessage()),
     _fieldSearcherMap(),
@@ -218,6 +219,12 @@ void SearchVisitor::init(const Parameters & params)
     }
     _queryResult->getSearchResult().setWantedHitCount(wantedSummaryCount);
 
+    if (params.get("preparethreads", valueRef) ) {
+        vespalib::string tmp(valueRef.data(), valueRef.size());
+        _prepareThreads = std::max(1ul, strtoul(tmp.c_str(), NULL, 0));
+        LOG(debug, "Received prepare threads: %ld", _prepareThreads);
+    }
+
     if (params.get("rankprofile", valueRef) ) {
         vespalib::string tmp(valueRef.data(), valueRef.size());
         _rankController.setRankProfile(tmp);
@@ -885,6 +892,7 @@ SearchVisitor::handleDocuments(const document::BucketId&,
 
     const document::DocumentType* defaultDocType = _docTypeMapping.getDefaultDocumentType();
     assert(defaultDocType);
+    prepareDocuments(entries);
     for (const auto & entry : entries) {
         StorageDocument::UP document(new StorageDocument(entry->releaseDocument(), _fieldPathMap, highestFieldNo));
 
@@ -906,6 +914,59 @@ SearchVisitor::handleDocuments(const document::BucketId&,
     }
 }
 
+namespace {
+
+class PrepareDocumentsTask : public vespalib::Runnable {
+private:
+    const std::vector<spi::DocEntry::UP> & _entries;
+    size_t                                 _begin;
+    size_t                                 _end;
+public:
+    PrepareDocumentsTask(const std::vector<spi::DocEntry::UP> & entries, size_t begin, size_t end)
+        : _entries(entries),
+          _begin(begin),
+          _end(end)
+    { }
+    void run() override {
+        for (size_t i(_begin); i < _end; i++) {
+            const document::Document * doc = _entries[i]->getDocument();
+            if (doc == NULL) {
+                continue;
+            }
+            const document::StructFieldValue::Chunks & chunks = doc->getFields().getChunks();
+            for (size_t c(0); c < chunks.size(); c++) {
+                const document::SerializableArray::EntryMap & fields = chunks[c].getEntries();
+                if ( ! fields.empty()) {
+                    // Fetching any field decompresses the whole chunk.
+                    chunks[c].get(fields.front().id());
+                }
+            }
+        }
+    }
+};
+
+}
+
+void
+SearchVisitor::prepareDocuments(const std::vector<spi::DocEntry::UP>& entries)
+{
+    if ((_prepareThreads <= 1) || (entries.size() < 2)) {
+        return;
+    }
+    vespalib::SimpleThreadBundle::Pool & pool = _env.getThreadBundlePool(_prepareThreads);
+    vespalib::SimpleThreadBundle::UP bundle = pool.obtain();
+    size_t numTasks = std::min(bundle->size(), entries.size());
+    std::vector<std::unique_ptr<PrepareDocumentsTask>> tasks;
+    std::vector<vespalib::Runnable *> targets;
+    for (size_t i(0); i < numTasks; i++) {
+        tasks.push_back(std::make_unique<PrepareDocumentsTask>(entries, (entries.size() * i) / numTasks,
+                                                               (entries.size() * (i + 1)) / numTasks));
+        targets.push_back(tasks.back().get());
+    }
+    bundle->run(targets);
+    pool.release(std::move(bundle));
+}
+
 bool
 SearchVisitor::handleDocument(StorageDocument & document)
 {
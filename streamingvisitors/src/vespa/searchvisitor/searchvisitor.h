@@ -301,6 +301,14 @@ private:
                          std::vector<spi::DocEntry::UP>& entries,
                          HitCounter& hitCounter) override;
 
+    /**
+     * Decompresses the serialized fields of the given documents using
+     * _prepareThreads threads, so that the serial matching below does not
+     * have to. Matching, ranking and grouping share state per visitor and
+     * stay on the visitor thread.
+     */
+    void prepareDocuments(const std::vector<spi::DocEntry::UP>& entries);
+
     bool compatibleDocumentTypes(const document::DocumentType& typeA,
                                  const document::DocumentType& typeB) const;
 
@@ -424,6 +432,7 @@ private:
     size_t                                  _docSearchedCount;
     size_t                                  _hitCount;
     size_t                                  _hitsRejectedCount;
+    size_t                                  _prepareThreads;
     search::Query                           _query;
     std::unique_ptr<documentapi::QueryResultMessage>    _queryResult;
     vsm::FieldIdTSearcherMap                _fieldSearcherMap;
@@ -0,0 +1,56 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vbench/test/all.h>
+
+using namespace vbench;
+
+struct Fetcher : public vespalib::Runnable {
+    Provider<int> &provider;
+    std::vector<int> values;
+    Fetcher(Provider<int> &p) : provider(p), values() {}
+    void run() override {
+        for (std::unique_ptr<int> v = provider.provide(); v; v = provider.provide()) {
+            values.push_back(*v);
+        }
+    }
+};
+
+TEST("require that objects are queued until provided") {
+    Backlog<int> backlog;
+    backlog.handle(std::unique_ptr<int>(new int(1)));
+    backlog.handle(std::unique_ptr<int>(new int(2)));
+    EXPECT_EQUAL(2u, backlog.size());
+    EXPECT_EQUAL(1, *backlog.provide());
+    backlog.handle(std::unique_ptr<int>(new int(3)));
+    EXPECT_EQUAL(2, *backlog.provide());
+    EXPECT_EQUAL(3, *backlog.provide());
+    EXPECT_EQUAL(0u, backlog.size());
+    EXPECT_EQUAL(2u, backlog.maxSize());
+}
+
+TEST("require that closed backlog drains queued objects before providing nil") {
+    Backlog<int> backlog;
+    backlog.handle(std::unique_ptr<int>(new int(1)));
+    backlog.close();
+    backlog.handle(std::unique_ptr<int>(new int(2)));
+    EXPECT_EQUAL(1, *backlog.provide());
+    EXPECT_TRUE(backlog.provide().get() == nullptr);
+}
+
+TEST("require that waiting consumers get all objects") {
+    Backlog<int> backlog;
+    Fetcher fetcher(backlog);
+    vespalib::Thread thread(fetcher);
+    thread.start();
+    for (int i = 0; i < 100; ++i) {
+        backlog.handle(std::unique_ptr<int>(new int(i)));
+    }
+    backlog.close();
+    thread.join();
+    ASSERT_EQUAL(100u, fetcher.values.size());
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQUAL(i, fetcher.values[i]);
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,66 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vbench/test/all.h>
+
+using namespace vbench;
+
+TEST("require that bucket index and value range are consistent") {
+    for (uint64_t value: {0ul, 1ul, 2047ul, 2048ul, 2049ul, 4095ul, 4096ul, 123456789ul, 1ul << 40}) {
+        size_t idx = HdrHistogram::index(value);
+        EXPECT_LESS_EQUAL(HdrHistogram::lowest(idx), value);
+        EXPECT_GREATER_EQUAL(HdrHistogram::highest(idx), value);
+        EXPECT_EQUAL(idx, HdrHistogram::index(HdrHistogram::lowest(idx)));
+        EXPECT_EQUAL(idx, HdrHistogram::index(HdrHistogram::highest(idx)));
+        EXPECT_EQUAL(idx + 1, HdrHistogram::index(HdrHistogram::highest(idx) + 1));
+    }
+}
+
+TEST("require that relative precision is kept for large values") {
+    for (uint64_t value = 2048; value < (1ul << 40); value = value * 3 + 1) {
+        size_t idx = HdrHistogram::index(value);
+        double width = HdrHistogram::highest(idx) - HdrHistogram::lowest(idx) + 1;
+        EXPECT_LESS_EQUAL(width / value, 1.0 / 1024.0);
+    }
+}
+
+TEST("require that percentiles are estimated") {
+    HdrHistogram hist;
+    EXPECT_EQUAL(0u, hist.valueAt(50.0));
+    for (uint64_t i = 1; i <= 10000; ++i) {
+        hist.add(i * 1000);
+    }
+    EXPECT_EQUAL(10000u, hist.count());
+    EXPECT_EQUAL(1000u, hist.min());
+    EXPECT_EQUAL(10000000u, hist.max());
+    EXPECT_APPROX(5000000.0, hist.valueAt(50.0), 5000.0);
+    EXPECT_APPROX(9900000.0, hist.valueAt(99.0), 9900.0);
+    EXPECT_APPROX(9990000.0, hist.valueAt(99.9), 9990.0);
+    EXPECT_EQUAL(10000000u, hist.valueAt(100.0));
+    EXPECT_EQUAL(1000u, hist.valueAt(0.0));
+}
+
+TEST("require that histograms can be merged") {
+    HdrHistogram a;
+    HdrHistogram b;
+    a.add(10);
+    b.add(5);
+    b.add(1000000);
+    a.merge(b);
+    EXPECT_EQUAL(3u, a.count());
+    EXPECT_EQUAL(5u, a.min());
+    EXPECT_EQUAL(1000000u, a.max());
+    EXPECT_EQUAL(10u, a.valueAt(50.0));
+}
+
+TEST("require that percentile distribution ends at the max value") {
+    HdrHistogram hist;
+    for (uint64_t i = 1; i <= 1000; ++i) {
+        hist.add(i * 1000);
+    }
+    string dist = hist.percentileDistribution(1000.0);
+    fprintf(stderr, "%s", dist.c_str());
+    EXPECT_TRUE(dist.find("    1000.000 1.000000000000       1000\n") != string::npos);
+    EXPECT_TRUE(dist.find("#[Max     =     1000.000") != string::npos);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
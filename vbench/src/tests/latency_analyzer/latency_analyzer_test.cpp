@@ -30,7 +30,19 @@ TEST_FF("verify percentiles", RequestSink(), LatencyAnalyzer(f1)) {
     EXPECT_APPROX(5.0, stats.per50, 10e-6);
     EXPECT_APPROX(9.5, stats.per95, 10e-6);
     EXPECT_APPROX(9.9, stats.per99, 10e-6);
+    EXPECT_APPROX(9.99, stats.per999, 10e-6);
     fprintf(stderr, "%s", stats.toString().c_str());
 }
 
+TEST_FF("require that latencies beyond the linear histogram are kept", RequestSink(), LatencyAnalyzer(f1)) {
+    for (size_t i = 0; i < 1000; ++i) {
+        post(0.010, f2);
+    }
+    post(30.0, f2);
+    const HdrHistogram &hist = f2.getHistogram();
+    EXPECT_EQUAL(1001u, hist.count());
+    EXPECT_APPROX(10000.0, hist.valueAt(50.0), 10.0);
+    EXPECT_EQUAL(30000000u, hist.valueAt(100.0));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,45 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "handler.h"
+#include "provider.h"
+#include "closeable.h"
+#include <vespa/vespalib/util/sync.h>
+#include <vespa/vespalib/util/arrayqueue.hpp>
+
+namespace vbench {
+
+/**
+ * Unbounded queue of objects between threads. Objects received
+ * through the Handler interface are queued until a component asks for
+ * them through the Provider interface; a component asking for an
+ * object while the queue is empty will block. Unlike the Dispatcher,
+ * objects are never dropped when all consumers are busy. A closed
+ * backlog will discard incoming objects, hand out the objects still
+ * queued and then provide nil objects.
+ **/
+template <typename T>
+class Backlog : public Handler<T>,
+                public Provider<T>,
+                public Closeable
+{
+private:
+    vespalib::Monitor                          _monitor;
+    vespalib::ArrayQueue<std::unique_ptr<T> >  _queue;
+    size_t                                     _maxSize;
+    bool                                       _closed;
+
+public:
+    Backlog();
+    ~Backlog();
+    size_t size() const;
+    size_t maxSize() const;
+    void close() override;
+    void handle(std::unique_ptr<T> obj) override;
+    std::unique_ptr<T> provide() override;
+};
+
+} // namespace vbench
+
+#include "backlog.hpp"
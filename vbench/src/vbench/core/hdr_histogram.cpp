@@ -0,0 +1,140 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "hdr_histogram.h"
+#include <algorithm>
+#include <cmath>
+
+namespace vbench {
+
+namespace {
+
+uint32_t msb(uint64_t value) { return (63 - __builtin_clzll(value)); }
+
+} // namespace vbench::<unnamed>
+
+HdrHistogram::HdrHistogram()
+    : _counts(),
+      _total(0),
+      _min(0),
+      _max(0),
+      _sum(0.0)
+{
+}
+
+HdrHistogram::~HdrHistogram() {}
+
+size_t
+HdrHistogram::index(uint64_t value)
+{
+    if (value < (sub_bucket_half << 1)) {
+        return value;
+    }
+    uint32_t shift = msb(value) - sub_bucket_bits;
+    return ((shift + 1) * sub_bucket_half) + (value >> shift) - sub_bucket_half;
+}
+
+uint64_t
+HdrHistogram::lowest(size_t idx)
+{
+    if (idx < (sub_bucket_half << 1)) {
+        return idx;
+    }
+    uint32_t shift = (idx / sub_bucket_half) - 1;
+    return ((idx % sub_bucket_half) + sub_bucket_half) << shift;
+}
+
+uint64_t
+HdrHistogram::highest(size_t idx)
+{
+    if (idx < (sub_bucket_half << 1)) {
+        return idx;
+    }
+    uint32_t shift = (idx / sub_bucket_half) - 1;
+    return lowest(idx) + (uint64_t(1) << shift) - 1;
+}
+
+void
+HdrHistogram::add(uint64_t value)
+{
+    size_t idx = index(value);
+    if (idx >= _counts.size()) {
+        _counts.resize(idx + 1, 0);
+    }
+    ++_counts[idx];
+    if (_total == 0 || value < _min) {
+        _min = value;
+    }
+    if (_total == 0 || value > _max) {
+        _max = value;
+    }
+    ++_total;
+    _sum += value;
+}
+
+void
+HdrHistogram::merge(const HdrHistogram &rhs)
+{
+    if (rhs._total == 0) {
+        return;
+    }
+    if (rhs._counts.size() > _counts.size()) {
+        _counts.resize(rhs._counts.size(), 0);
+    }
+    for (size_t i = 0; i < rhs._counts.size(); ++i) {
+        _counts[i] += rhs._counts[i];
+    }
+    _min = (_total == 0) ? rhs._min : std::min(_min, rhs._min);
+    _max = (_total == 0) ? rhs._max : std::max(_max, rhs._max);
+    _total += rhs._total;
+    _sum += rhs._sum;
+}
+
+uint64_t
+HdrHistogram::valueAt(double percentile) const
+{
+    if (_total == 0) {
+        return 0;
+    }
+    double per = std::min(std::max(percentile, 0.0), 100.0);
+    size_t target = std::max(size_t(std::ceil((per / 100.0) * _total)), size_t(1));
+    size_t acc = 0;
+    for (size_t i = 0; i < _counts.size(); ++i) {
+        acc += _counts[i];
+        if (acc >= target) {
+            return std::min(highest(i), _max);
+        }
+    }
+    return _max;
+}
+
+string
+HdrHistogram::percentileDistribution(double unit, size_t ticksPerHalfDistance) const
+{
+    string str = strfmt("%12s %14s %10s %14s\n\n", "Value", "Percentile", "TotalCount", "1/(1-Percentile)");
+    if (_total == 0) {
+        return str;
+    }
+    ticksPerHalfDistance = std::max(ticksPerHalfDistance, size_t(1));
+    double per = 0.0;
+    size_t idx = 0;
+    size_t acc = _counts[0];
+    for (;;) {
+        size_t target = std::min(std::max(size_t(std::ceil((per / 100.0) * _total)), size_t(1)), _total);
+        while (acc < target) {
+            acc += _counts[++idx];
+        }
+        double value = std::min(highest(idx), _max) / unit;
+        if (acc == _total) {
+            str += strfmt("%12.3f %14.12f %10zu\n", value, 1.0, acc);
+            break;
+        }
+        str += strfmt("%12.3f %14.12f %10zu %14.2f\n", value, per / 100.0, acc, 1.0 / (1.0 - per / 100.0));
+        double halvings = std::floor(std::log2(100.0 / (100.0 - per))) + 1.0;
+        per += 100.0 / (ticksPerHalfDistance * std::pow(2.0, halvings));
+    }
+    str += strfmt("#[Mean    = %12.3f, Min            = %12.3f]\n", mean() / unit, _min / unit);
+    str += strfmt("#[Max     = %12.3f, Total count    = %12zu]\n", _max / unit, _total);
+    return str;
+}
+
+} // namespace vbench
@@ -0,0 +1,62 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "string.h"
+#include <cstdint>
+#include <vector>
+
+namespace vbench {
+
+/**
+ * Log-linear histogram of non-negative integer values in the style of
+ * HdrHistogram. Values are bucketed with a fixed relative precision
+ * (about 0.1%) across the whole value range, which keeps the tail of
+ * a latency distribution accurate without bounding the largest value
+ * that can be recorded. Memory usage grows with the logarithm of the
+ * largest recorded value.
+ **/
+class HdrHistogram
+{
+public:
+    static constexpr uint32_t sub_bucket_bits = 10;
+    static constexpr uint64_t sub_bucket_half = (uint64_t(1) << sub_bucket_bits);
+
+private:
+    std::vector<size_t> _counts;
+    size_t              _total;
+    uint64_t            _min;
+    uint64_t            _max;
+    double              _sum;
+
+public:
+    HdrHistogram();
+    ~HdrHistogram();
+
+    static size_t index(uint64_t value);
+    static uint64_t lowest(size_t idx);
+    static uint64_t highest(size_t idx);
+
+    void add(uint64_t value);
+    void merge(const HdrHistogram &rhs);
+    size_t count() const { return _total; }
+    uint64_t min() const { return _min; }
+    uint64_t max() const { return _max; }
+    double mean() const { return (_total > 0) ? (_sum / _total) : 0.0; }
+
+    /**
+     * The largest value equivalent (within the histogram precision)
+     * to the value at the given percentile [0, 100].
+     **/
+    uint64_t valueAt(double percentile) const;
+
+    /**
+     * Render the percentile distribution in the text format used by
+     * HdrHistogram, with values divided by 'unit'. The distance to
+     * 100% is halved every 'ticksPerHalfDistance' rows, making the
+     * output zoom in on the tail.
+     **/
+    string percentileDistribution(double unit, size_t ticksPerHalfDistance = 5) const;
+};
+
+} // namespace vbench
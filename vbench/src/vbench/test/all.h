@@ -36,6 +36,8 @@
 #include <vbench/core/provider.h>
 #include <vespa/vespalib/data/input_reader.h>
 #include <vbench/core/dispatcher.h>
+#include <vbench/core/backlog.h>
+#include <vbench/core/hdr_histogram.h>
 #include <vbench/core/stream.h>
 #include <vespa/vespalib/data/input.h>
 #include <vbench/test/simple_http_result_handler.h>
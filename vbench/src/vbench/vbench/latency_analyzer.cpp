@@ -38,6 +38,7 @@ LatencyAnalyzer::Stats::toString() const
     str += strfmt("  50%%: %g\n", per50);
     str += strfmt("  95%%: %g\n", per95);
     str += strfmt("  99%%: %g\n", per99);
+    str += strfmt("  99.9%%: %g\n", per999);
     str += "}\n";
     return str;
 }
@@ -48,7 +49,8 @@ LatencyAnalyzer::LatencyAnalyzer(Handler<Request> &next)
       _min(0.0),
       _max(0.0),
       _total(0.0),
-      _hist(10000, 0)
+      _hist(10000, 0),
+      _hdr()
 {
 }
 
@@ -65,6 +67,8 @@ void
 LatencyAnalyzer::report()
 {
     fprintf(stdout, "%s\n", getStats().toString().c_str());
+    fprintf(stdout, "Latency distribution (ms) {\n%s}\n\n",
+            _hdr.percentileDistribution(1000.0).c_str());
 }
 
 void
@@ -82,6 +86,7 @@ LatencyAnalyzer::addLatency(double latency)
     if (idx < _hist.size()) {
         ++_hist[idx];
     }
+    _hdr.add((uint64_t)(std::max(latency, 0.0) * 1000000.0 + 0.5));
 }
 
 LatencyAnalyzer::Stats
@@ -96,6 +101,7 @@ LatencyAnalyzer::getStats() const
     stats.per50 = getPercentile(50.0);
     stats.per95 = getPercentile(95.0);
     stats.per99 = getPercentile(99.0);
+    stats.per999 = getPercentile(99.9);
     return stats;
 }
 
@@ -3,12 +3,16 @@
 #pragma once
 
 #include "analyzer.h"
+#include <vbench/core/hdr_histogram.h>
 
 namespace vbench {
 
 /**
  * Component picking up the latency of successful requests and
- * calculating relevant aggregated values.
+ * calculating relevant aggregated values. The full latency
+ * distribution is also kept in a log-linear histogram, which is
+ * reported to show the tail without the 10 second cap of the linear
+ * histogram used for the summary percentiles.
  **/
 class LatencyAnalyzer : public Analyzer
 {
@@ -19,6 +23,7 @@ private:
     double               _max;
     double               _total;
     std::vector<size_t>  _hist;
+    HdrHistogram         _hdr;
 
     double getN(size_t n) const;
     double getPercentile(double per) const;
@@ -31,7 +36,8 @@ public:
         double per50;
         double per95;
         double per99;
-        Stats() : min(0), avg(0), max(0), per50(0), per95(0), per99(0) {}
+        double per999;
+        Stats() : min(0), avg(0), max(0), per50(0), per95(0), per99(0), per999(0) {}
         string toString() const;
     };
     LatencyAnalyzer(Handler<Request> &next);
@@ -39,6 +45,7 @@ public:
     void report() override;
     void addLatency(double latency);
     Stats getStats() const;
+    const HdrHistogram &getHistogram() const { return _hdr; }
 };
 
 } // namespace vbench
@@ -15,27 +15,38 @@ RequestScheduler::run()
     while (_queue.extract(_timer.sample(), list, sleepTime)) {
         for (size_t i = 0; i < list.size(); ++i) {
             Request::UP request = Request::UP(list[i].release());
-            _dispatcher.handle(std::move(request));
+            if (_openLoop) {
+                _backlog.handle(std::move(request));
+            } else {
+                _dispatcher.handle(std::move(request));
+            }
         }
         list.clear();
         thread.slumber(sleepTime);
     }
 }
 
-RequestScheduler::RequestScheduler(Handler<Request> &next, size_t numWorkers)
+RequestScheduler::RequestScheduler(Handler<Request> &next, size_t numWorkers, bool openLoop)
     : _timer(),
       _proxy(next),
       _queue(10.0, 0.020),
       _droppedTagger(_proxy),
       _dispatcher(_droppedTagger),
+      _backlog(),
+      _openLoop(openLoop),
       _thread(*this),
       _connectionPool(_timer),
       _workers()
 {
+    Provider<Request> &provider = _openLoop
+                                  ? static_cast<Provider<Request>&>(_backlog)
+                                  : static_cast<Provider<Request>&>(_dispatcher);
     for (size_t i = 0; i < numWorkers; ++i) {
-        _workers.push_back(std::unique_ptr<Worker>(new Worker(_dispatcher, _proxy, _connectionPool, _timer)));
+        _workers.push_back(std::unique_ptr<Worker>(new Worker(provider, _proxy, _connectionPool, _timer, _openLoop)));
+    }
+    if (!_openLoop) {
+        _dispatcher.waitForThreads(numWorkers, 256);
     }
-    _dispatcher.waitForThreads(numWorkers, 256);
 }
 
 void
@@ -72,6 +83,7 @@ RequestScheduler::join()
 {
     _thread.join();
     _dispatcher.close();
+    _backlog.close();
     for (size_t i = 0; i < _workers.size(); ++i) {
         _workers[i]->join();
     }
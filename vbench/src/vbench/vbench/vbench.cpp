@@ -20,7 +20,8 @@ VBench::VBench(const vespalib::Slime &cfg)
         }
     }
     _scheduler.reset(new RequestScheduler(*_analyzers.back(),
-                                          cfg.get()["http_threads"].asLong()));
+                                          cfg.get()["http_threads"].asLong(),
+                                          cfg.get()["open_loop"].asBool()));
     vespalib::slime::Inspector &inputs = cfg.get()["inputs"];
     for (size_t i = inputs.children(); i-- > 0; ) {
         vespalib::slime::Inspector &input = inputs[i];
@@ -13,7 +13,9 @@ Worker::run()
         if (request.get() == 0) {
             break;
         }
-        request->startTime(_timer.sample());
+        request->startTime(_fromScheduledTime
+                           ? request->scheduledTime()
+                           : _timer.sample());
         HttpClient::fetch(_pool, request->server(), request->url(), *request);
         request->endTime(_timer.sample());
         _next.handle(std::move(request));
@@ -21,12 +23,14 @@ Worker::run()
 }
 
 Worker::Worker(Provider<Request> &provider, Handler<Request> &next,
-               HttpConnectionPool &pool, Timer &timer)
+               HttpConnectionPool &pool, Timer &timer,
+               bool fromScheduledTime)
     : _thread(*this),
       _provider(provider),
       _next(next),
       _pool(pool),
-      _timer(timer)
+      _timer(timer),
+      _fromScheduledTime(fromScheduledTime)
 {
     _thread.start();
 }
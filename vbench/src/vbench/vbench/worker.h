@@ -16,7 +16,11 @@ namespace vbench {
  * Obtains requests from a request provider, performs the requests and
  * passes the requests along to a request handler. Runs its own
  * internal thread that will stop when the request provider starts
- * handing out empty requests.
+ * handing out empty requests. When 'fromScheduledTime' is set, the
+ * start time of each request is its scheduled time rather than the
+ * time the request was actually sent. Any time spent waiting for a
+ * free worker is then counted as latency, which avoids coordinated
+ * omission when the system under test falls behind the schedule.
  **/
 class Worker : public vespalib::Runnable,
                public vespalib::Joinable
@@ -27,12 +31,14 @@ private:
     Handler<Request>   &_next;
     HttpConnectionPool &_pool;
     Timer              &_timer;
+    bool                _fromScheduledTime;
 
     void run() override;
 public:
     typedef std::unique_ptr<Worker> UP;
     Worker(Provider<Request> &provider, Handler<Request> &next,
-           HttpConnectionPool &pool, Timer &timer);
+           HttpConnectionPool &pool, Timer &timer,
+           bool fromScheduledTime = false);
     void join() override { _thread.join(); }
 };
 
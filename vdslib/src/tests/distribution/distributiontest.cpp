@@ -1067,34 +1067,25 @@ DistributionTest::testRedundancyHierarchicalDistribution()
         CPPUNIT_ASSERT_EQUAL(d1, d2);
     }
 }
-/*
+// Manual benchmark of the ideal node calculation. Not registered as it
+// takes a while to run; enable the CPPUNIT_TEST entry to run it.
 void
 DistributionTest::testHierarchicalDistributionPerformance()
 {
     std::ostringstream ost;
     ost << "redundancy 2\n"
-        "group[62]\n"
+        "group[43]\n"
         "group[0].name mycluster\n"
-        "group[0].index 0\n"
-        "group[0].partitions *\n"
+        "group[0].index invalid\n"
+        "group[0].partitions 1|*\n"
         "group[0].nodes[0]\n";
 
     for (uint32_t i = 0; i < 21; ++i) {
-        int idx = (i * 3) + 1;
-
-        ost << "group[" << idx << "].name rack" << i << "\n"
-            << "group[" << idx << "].index 0." << i << "\n"
-            << "group[" << idx << "].partitions 1|*\n"
-            << "group[" << idx << "].nodes[0]\n";
-
-        for (uint32_t j = 0; j < 2; ++j) {
-            idx++;
-
+        int idx = (i * 2) + 1;
+        for (uint32_t j = 0; j < 2; ++j, ++idx) {
             ost << "group[" << idx << "].name switch" << idx << "\n"
-                << "group[" << idx << "].index 0." << i << "." << j << "\n"
-                << "group[" << idx << "].partitions 1|*\n"
+                << "group[" << idx << "].index " << idx - 1 << "\n"
                 << "group[" << idx << "].nodes[50]\n";
-
             for (uint32_t n = 0; n < 50; ++n) {
                 int nIdx = (i * 100 + j * 50 + n);
                 ost << "group[" << idx << "].nodes[" << n << "].index " << nIdx << "\n";
@@ -1102,25 +1093,23 @@ DistributionTest::testHierarchicalDistributionPerformance()
         }
     }
 
-    std::cerr << ost.str() << "\n";
-
-    Distribution distr(vespa::config::content::StorDistributionConfig(
-                               vespalib::StringTokenizer(ost.str(), "\n", "").getTokens()));
+    Distribution hierarchical(ost.str());
+    Distribution flat(Distribution::getDefaultDistributionConfig(2, 2100));
     ClusterState state("distributor:2100 storage:2100");
-
-    uint32_t timeNow = time(NULL);
     uint32_t numBuckets = 1000000;
 
-    std::vector<uint16_t> nodes;
-    for (uint32_t i = 0; i < numBuckets; i++) {
-        nodes = distr.getIdealStorageNodes(
-                state, document::BucketId(16, i), "u");
+    for (const Distribution *distr : { &hierarchical, &flat }) {
+        std::vector<uint16_t> nodes;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < numBuckets; i++) {
+            distr->getIdealNodes(NodeType::STORAGE, state, document::BucketId(16, i), nodes, "u");
+        }
+        std::chrono::duration<double> spent = std::chrono::steady_clock::now() - start;
+        std::cerr << (distr == &flat ? "Flat: " : "Hierarchical: ")
+                  << "did " << numBuckets << " in " << spent.count() << " seconds. ("
+                  << (numBuckets / spent.count()) << " ops/sec)\n";
     }
-
-    uint32_t timeSpent = time(NULL) - timeNow;
-    std::cerr << "Did " << numBuckets << " in " << timeSpent << " seconds. (" << ((double)numBuckets / (double)timeSpent) << " ops/sec)\n";
 }
-*/
 
 void
 DistributionTest::testHierarchicalDistribution()
@@ -11,7 +11,6 @@
 #include <vespa/config/print/asciiconfigreader.h>
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/config-stor-distribution.h>
-#include <list>
 #include <algorithm>
 #include <cmath>
 
@@ -384,11 +383,11 @@ namespace {
      * decrease redundancy below total reliability. If redundancy !=
      * total reliability, see if non-last entries can be removed.
      */
-    void trimResult(std::list<ScoredNode>& nodes, uint16_t redundancy) {
+    void trimResult(std::vector<ScoredNode>& nodes, uint16_t redundancy) {
             // Initially record total reliability and use the first elements
             // until satisfied.
         uint32_t totalReliability = 0;
-        for (std::list<ScoredNode>::iterator it = nodes.begin();
+        for (std::vector<ScoredNode>::iterator it = nodes.begin();
              it != nodes.end(); ++it)
         {
             if (totalReliability >= redundancy || it->_reliability == 0) {
@@ -400,17 +399,11 @@ namespace {
             // If we have too high reliability, see if we can remove something
             // else
         if (totalReliability > redundancy) {
-            for (std::list<ScoredNode>::reverse_iterator it = nodes.rbegin();
-                    it != nodes.rend();)
-            {
-                if (it->_reliability <= (totalReliability - redundancy)) {
-                    totalReliability -= it->_reliability;
-                    std::list<ScoredNode>::iterator deleteIt(it.base());
-                    ++it;
-                    nodes.erase(--deleteIt);
+            for (size_t i = nodes.size(); i-- > 0;) {
+                if (nodes[i]._reliability <= (totalReliability - redundancy)) {
+                    totalReliability -= nodes[i]._reliability;
+                    nodes.erase(nodes.begin() + i);
                     if (totalReliability == redundancy) break;
-                } else {
-                    ++it;
                 }
             }
         }
@@ -564,14 +557,18 @@ Distribution::getIdealNodes(const NodeType& nodeType,
     }
     RandomGen random(seed);
     uint32_t randomIndex = 0;
+    // Temporary place to hold the best scored nodes of each group, reused
+    // across groups to avoid allocations in this hot path.
+    std::vector<ScoredNode> tmpResults;
+    tmpResults.reserve(redundancy);
+    resultNodes.reserve(redundancy);
     for (uint32_t i=0, n=_groupDistribution.size(); i<n; ++i) {
         uint16_t groupRedundancy(_groupDistribution[i]._redundancy);
         const std::vector<uint16_t>& nodes(
                 _groupDistribution[i]._group->getNodes());
-        // Create temporary place to hold results. Use double linked list
-        // for cheap access to back(). Stuff in redundancy fake entries to
-        // avoid needing to check size during iteration.
-        std::list<ScoredNode> tmpResults(groupRedundancy, ScoredNode(0, 0, 0));
+        // Stuff in redundancy fake entries to avoid needing to check size
+        // during iteration. Entries are kept sorted on descending score.
+        tmpResults.assign(groupRedundancy, ScoredNode(0, 0, 0));
         for (uint32_t j=0, m=nodes.size(); j<m; ++j) {
             // Verify that the node is legal target before starting to grab
             // random number. Helps worst case of having to start new random
@@ -607,23 +604,18 @@ Distribution::getIdealNodes(const NodeType& nodeType,
                 score = std::pow(score, 1.0 / nodeState.getCapacity().getValue());
             }
             if (score > tmpResults.back()._score) {
-                for (std::list<ScoredNode>::iterator it = tmpResults.begin();
-                     it != tmpResults.end(); ++it)
-                {
-                    if (score > it->_score) {
-                        tmpResults.insert(it, ScoredNode(
-                                nodes[j], nodeState.getReliability(), score));
-                        break;
-                    }
+                size_t pos = 0;
+                while (!(score > tmpResults[pos]._score)) {
+                    ++pos;
                 }
                 tmpResults.pop_back();
+                tmpResults.insert(tmpResults.begin() + pos, ScoredNode(
+                        nodes[j], nodeState.getReliability(), score));
             }
         }
         trimResult(tmpResults, groupRedundancy);
-        for (std::list<ScoredNode>::iterator it = tmpResults.begin();
-                it != tmpResults.end(); ++it)
-        {
-            resultNodes.push_back(it->_index);
+        for (const ScoredNode& scored : tmpResults) {
+            resultNodes.push_back(scored._index);
         }
     }
 }
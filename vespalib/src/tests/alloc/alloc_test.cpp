@@ -3,7 +3,11 @@
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/vespalib/util/alloc.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <algorithm>
 #include <cstddef>
+#include <fcntl.h>
+#include <unistd.h>
+#include <vector>
 
 using namespace vespalib;
 using namespace vespalib::alloc;
@@ -246,4 +250,86 @@ TEST("auto alloced mmap alloc can not be shrinked below HUGEPAGE_SIZE/2 + 1 ") {
     EXPECT_EQUAL(SZ, buf.size());
 }
 
+TEST("huge page alloc is aligned and rounded to huge pages") {
+    Alloc buf = Alloc::allocHugePages(100);
+    EXPECT_EQUAL(size_t(MemoryAllocator::HUGEPAGE_SIZE), buf.size());
+    EXPECT_EQUAL(0u, reinterpret_cast<uintptr_t>(buf.get()) % MemoryAllocator::HUGEPAGE_SIZE);
+    EXPECT_TRUE(buf.usesHugePages());
+    memset(buf.get(), 0x55, buf.size());
+    Alloc other = buf.create(3 * MemoryAllocator::HUGEPAGE_SIZE + 1);
+    EXPECT_EQUAL(4ul * MemoryAllocator::HUGEPAGE_SIZE, other.size());
+    EXPECT_EQUAL(0u, reinterpret_cast<uintptr_t>(other.get()) % MemoryAllocator::HUGEPAGE_SIZE);
+    EXPECT_TRUE(other.usesHugePages());
+    EXPECT_FALSE(Alloc::allocMMap(100).usesHugePages());
+    EXPECT_FALSE(Alloc::alloc(100).usesHugePages());
+}
+
+TEST("huge page alloc is resized in whole huge pages") {
+    Alloc buf = Alloc::allocHugePages(2 * MemoryAllocator::HUGEPAGE_SIZE);
+    EXPECT_TRUE(buf.resize_inplace(MemoryAllocator::HUGEPAGE_SIZE + 1));
+    EXPECT_EQUAL(2ul * MemoryAllocator::HUGEPAGE_SIZE, buf.size());
+    EXPECT_TRUE(buf.resize_inplace(100));
+    EXPECT_EQUAL(size_t(MemoryAllocator::HUGEPAGE_SIZE), buf.size());
+}
+
+TEST("paged alloc is file backed and rounded to pages") {
+    Alloc buf = Alloc::allocPaged(100);
+    EXPECT_EQUAL(4096ul, buf.size());
+    EXPECT_TRUE(buf.isPaged());
+    EXPECT_FALSE(buf.usesHugePages());
+    memset(buf.get(), 0x55, buf.size());
+    EXPECT_EQUAL(0x55, static_cast<const unsigned char *>(buf.get())[4095]);
+    Alloc other = buf.create(3 * 4096 + 1);
+    EXPECT_EQUAL(4ul * 4096, other.size());
+    EXPECT_TRUE(other.isPaged());
+    EXPECT_FALSE(buf.resize_inplace(2 * 4096));
+    EXPECT_FALSE(Alloc::allocMMap(100).isPaged());
+    EXPECT_FALSE(Alloc::alloc(100).isPaged());
+}
+
+TEST("paged alloc reports resident size of touched pages") {
+    Alloc buf = Alloc::allocPaged(16 * 4096);
+    EXPECT_EQUAL(0u, buf.residentSize());
+    char *data = static_cast<char *>(buf.get());
+    data[0] = 1;
+    data[5 * 4096] = 1;
+    EXPECT_EQUAL(2ul * 4096, buf.residentSize());
+    Alloc heap = Alloc::allocHeap(100);
+    EXPECT_EQUAL(100u, heap.residentSize());
+    EXPECT_EQUAL(0u, Alloc::allocPaged().residentSize());
+}
+
+TEST("file can be mapped private") {
+    const char *fileName = "mapped_file";
+    int fd = open(fileName, O_CREAT | O_TRUNC | O_RDWR, 0644);
+    ASSERT_TRUE(fd >= 0);
+    std::vector<char> content(4096 + 100, 'a');
+    std::fill(content.begin() + 4096, content.end(), 'b');
+    ASSERT_EQUAL(static_cast<ssize_t>(content.size()), write(fd, &content[0], content.size()));
+    {
+        Alloc buf = Alloc::mmapFilePrivate(fd, 4096, 100);
+        ASSERT_TRUE(buf.get() != nullptr);
+        EXPECT_EQUAL(4096ul, buf.size());
+        char *data = static_cast<char *>(buf.get());
+        EXPECT_EQUAL('b', data[0]);
+        EXPECT_EQUAL('b', data[99]);
+        EXPECT_EQUAL(0, data[100]);
+        data[0] = 'c';
+        EXPECT_EQUAL('c', data[0]);
+        Alloc other = buf.create(100);
+        EXPECT_EQUAL(4096ul, other.size());
+    }
+    char onDisk = 0;
+    EXPECT_EQUAL(1, pread(fd, &onDisk, 1, 4096));
+    EXPECT_EQUAL('b', onDisk);
+    close(fd);
+    unlink(fileName);
+}
+
+TEST("mapping fails for bad file descriptor") {
+    Alloc buf = Alloc::mmapFilePrivate(-1, 0, 100);
+    EXPECT_TRUE(buf.get() == nullptr);
+    EXPECT_EQUAL(0ul, buf.size());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
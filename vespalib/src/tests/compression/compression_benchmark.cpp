@@ -0,0 +1,62 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <vespa/vespalib/data/databuffer.h>
+#include <vector>
+
+using namespace vespalib;
+using namespace vespalib::compression;
+
+// Measures compression throughput of the codecs for payload sizes
+// ranging from small messages to full document store chunks.
+
+std::vector<char> make_payload(size_t sz) {
+    std::vector<char> payload(sz);
+    uint32_t seed = 42;
+    for (size_t i = 0; i < sz; ++i) {
+        seed = seed * 1103515245 + 12345;
+        // Skewed alphabet gives text like compressibility.
+        payload[i] = 'a' + ((seed >> 16) % 26) % (1 + (i % 13));
+    }
+    return payload;
+}
+
+double measure_compress(const CompressionConfig &cfg, const std::vector<char> &payload, size_t &compressedSize) {
+    ConstBufferRef ref(payload.data(), payload.size());
+    size_t loops = std::max(size_t(1), size_t(1000000) / payload.size());
+    BenchmarkTimer timer(1.0);
+    while (timer.has_budget()) {
+        timer.before();
+        for (size_t i = 0; i < loops; ++i) {
+            DataBuffer compressed;
+            compress(cfg, ref, compressed, false);
+            compressedSize = compressed.getDataLen();
+        }
+        timer.after();
+    }
+    return (payload.size() * loops) / (timer.min_time() * 1000000.0);
+}
+
+TEST("benchmark compression codecs across payload sizes") {
+    std::vector<std::pair<const char *, CompressionConfig>> codecs;
+    CompressionConfig lz4Fast(CompressionConfig::LZ4, 0, 100);
+    lz4Fast.acceleration = 8;
+    codecs.emplace_back("lz4 acceleration 8", lz4Fast);
+    codecs.emplace_back("lz4", CompressionConfig(CompressionConfig::LZ4, 0, 100));
+    codecs.emplace_back("lz4 hc 9", CompressionConfig(CompressionConfig::LZ4, 9, 100));
+    codecs.emplace_back("zstd 1", CompressionConfig(CompressionConfig::ZSTD, 1, 100));
+    codecs.emplace_back("zstd 3", CompressionConfig(CompressionConfig::ZSTD, 3, 100));
+    for (size_t sz : {256, 4096, 65536, 1048576}) {
+        std::vector<char> payload = make_payload(sz);
+        for (const auto &codec : codecs) {
+            size_t compressedSize = 0;
+            double mbps = measure_compress(codec.second, payload, compressedSize);
+            fprintf(stderr, "%8zu bytes %-20s: %8.1f MB/s, ratio %.2f\n",
+                    sz, codec.first, mbps, double(sz) / compressedSize);
+        }
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -3,6 +3,7 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <vespa/vespalib/data/databuffer.h>
 
 #include <vespa/log/log.h>
@@ -40,6 +41,41 @@ TEST("requireThatZStdCompressFine") {
     EXPECT_EQUAL(64u, compressed.getDataLen());
 }
 
+TEST("requireThatLZ4AccelerationTradesRatioForSpeed") {
+    CompressionConfig cfg(CompressionConfig::Type::LZ4, 0, 100);
+    CompressionConfig fastCfg(cfg);
+    fastCfg.acceleration = 64;
+    EXPECT_FALSE(cfg == fastCfg);
+    ConstBufferRef ref(_G_compressableText.c_str(), _G_compressableText.size());
+    DataBuffer compressed;
+    DataBuffer fastCompressed;
+    EXPECT_EQUAL(CompressionConfig::Type::LZ4, compress(cfg, ref, compressed, false));
+    EXPECT_EQUAL(CompressionConfig::Type::LZ4, compress(fastCfg, ref, fastCompressed, false));
+    EXPECT_GREATER_EQUAL(fastCompressed.getDataLen(), compressed.getDataLen());
+    DataBuffer decompressed;
+    decompress(CompressionConfig::Type::LZ4, _G_compressableText.size(),
+               ConstBufferRef(fastCompressed.getData(), fastCompressed.getDataLen()), decompressed, false);
+    EXPECT_EQUAL(_G_compressableText, vespalib::string(decompressed.getData(), decompressed.getDataLen()));
+}
+
+TEST("requireThatZStdStreamCompressionCanBeDecompressed") {
+    ZStdStreamCompressor compressor(3);
+    DataBuffer compressed;
+    for (size_t i(0); i < 3; i++) {
+        compressor.add(ConstBufferRef(_G_compressableText.c_str(), _G_compressableText.size()), compressed);
+    }
+    EXPECT_EQUAL(3 * _G_compressableText.size(), compressor.getUncompressedSize());
+    size_t uncompressedSize = compressor.finish(compressed);
+    EXPECT_EQUAL(3 * _G_compressableText.size(), uncompressedSize);
+    EXPECT_EQUAL(0u, compressor.getUncompressedSize());
+    EXPECT_LESS(compressed.getDataLen(), uncompressedSize);
+    DataBuffer decompressed;
+    decompress(CompressionConfig::Type::ZSTD, uncompressedSize,
+               ConstBufferRef(compressed.getData(), compressed.getDataLen()), decompressed, false);
+    vespalib::string text(_G_compressableText);
+    EXPECT_EQUAL(text + text + text, vespalib::string(decompressed.getData(), decompressed.getDataLen()));
+}
+
 TEST_MAIN() {
     TEST_RUN_ALL();
 }
@@ -0,0 +1,48 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <atomic>
+
+using namespace vespalib;
+using namespace std::literals;
+
+// Measures the round trip latency of handing a single task to an
+// idle worker thread and observing that it has been run.
+
+struct FlagTask : public Executor::Task {
+    std::atomic<bool> &done;
+    FlagTask(std::atomic<bool> &done_in) : done(done_in) {}
+    void run() override { done.store(true, std::memory_order_release); }
+};
+
+double measure_handoff(std::chrono::nanoseconds max_spin, size_t num_tasks) {
+    ThreadStackExecutor executor(1, 128 * 1024);
+    executor.setMaxIdleSpin(max_spin);
+    std::atomic<bool> done(false);
+    BenchmarkTimer timer(1.0);
+    while (timer.has_budget()) {
+        timer.before();
+        for (size_t i = 0; i < num_tasks; ++i) {
+            done.store(false, std::memory_order_relaxed);
+            executor.execute(std::make_unique<FlagTask>(done));
+            while (!done.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+        }
+        timer.after();
+    }
+    return (timer.min_time() * 1000000.0) / num_tasks;
+}
+
+TEST("benchmark task handoff latency with and without idle spinning") {
+    size_t num_tasks = 1000;
+    for (std::chrono::nanoseconds max_spin: {0ns, 10000ns, 100000ns}) {
+        double us = measure_handoff(max_spin, num_tasks);
+        fprintf(stderr, "max idle spin: %zu ns -> handoff round trip: %g us\n",
+                size_t(max_spin.count()), us);
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
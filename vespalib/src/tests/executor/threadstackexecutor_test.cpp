@@ -5,6 +5,7 @@
 #include <vespa/vespalib/util/sync.h>
 #include <vespa/vespalib/util/backtrace.h>
 #include <atomic>
+#include <thread>
 
 using namespace vespalib;
 
@@ -158,6 +159,75 @@ TEST_MT_F("require that threads can wait for a specific task count", 7, WaitStat
     }
 }
 
+struct CountTask : public Executor::Task {
+    std::atomic<uint32_t> &cnt;
+    CountTask(std::atomic<uint32_t> &cnt_in) : cnt(cnt_in) {}
+    void run() override { cnt.fetch_add(1); }
+};
+
+TEST_F("require that tasks are run when idle workers are spinning", ThreadStackExecutor(4, 128000)) {
+    f1.setMaxIdleSpin(std::chrono::microseconds(100));
+    std::atomic<uint32_t> cnt(0);
+    for (uint32_t i = 0; i < 10000; ++i) {
+        EXPECT_TRUE(f1.execute(std::make_unique<CountTask>(cnt)).get() == nullptr);
+        if ((i % 100) == 0) {
+            f1.sync();
+        }
+    }
+    f1.sync();
+    EXPECT_EQUAL(10000u, cnt.load());
+    f1.setMaxIdleSpin(std::chrono::nanoseconds(0));
+    EXPECT_TRUE(f1.execute(std::make_unique<CountTask>(cnt)).get() == nullptr);
+    f1.sync();
+    EXPECT_EQUAL(10001u, cnt.load());
+}
+
+struct SleepTask : public Executor::Task {
+    void run() override { std::this_thread::sleep_for(std::chrono::milliseconds(10)); }
+};
+
+TEST_F("require that queue time and utilization are tracked", ThreadStackExecutor(1, 128000)) {
+    f1.getStats();
+    for (uint32_t i = 0; i < 5; ++i) {
+        EXPECT_TRUE(f1.execute(std::make_unique<SleepTask>()).get() == nullptr);
+    }
+    f1.sync();
+    ThreadStackExecutor::Stats stats = f1.getStats();
+    EXPECT_EQUAL(5u, stats.executedTasks);
+    EXPECT_GREATER_EQUAL(stats.busyTime, 0.05);
+    EXPECT_GREATER_EQUAL(stats.threadTime, stats.busyTime);
+    EXPECT_GREATER(stats.getUtilization(), 0.0);
+    EXPECT_GREATER_EQUAL(stats.maxQueueTime, 0.04);
+    EXPECT_GREATER_EQUAL(stats.totalQueueTime, 0.1);
+    size_t histogramTasks = 0;
+    for (size_t count : stats.queueTimeHistogram) {
+        histogramTasks += count;
+    }
+    EXPECT_EQUAL(5u, histogramTasks);
+    stats = f1.getStats();
+    EXPECT_EQUAL(0u, stats.executedTasks);
+    EXPECT_EQUAL(0.0, stats.busyTime);
+}
+
+TEST("require that queue time buckets are decades starting at 10us") {
+    using Stats = ThreadStackExecutor::Stats;
+    EXPECT_EQUAL(0u, Stats::getQueueTimeBucket(0.0));
+    EXPECT_EQUAL(0u, Stats::getQueueTimeBucket(0.000009));
+    EXPECT_EQUAL(1u, Stats::getQueueTimeBucket(0.00001));
+    EXPECT_EQUAL(3u, Stats::getQueueTimeBucket(0.005));
+    EXPECT_EQUAL(Stats::QUEUE_TIME_BUCKETS - 1, Stats::getQueueTimeBucket(100.0));
+    Stats a;
+    a.addExecutedTask(0.5, 1.0);
+    Stats b;
+    b.addExecutedTask(0.25, 2.0);
+    a += b;
+    EXPECT_EQUAL(2u, a.executedTasks);
+    EXPECT_EQUAL(0.75, a.totalQueueTime);
+    EXPECT_EQUAL(0.5, a.maxQueueTime);
+    EXPECT_EQUAL(3.0, a.busyTime);
+    EXPECT_EQUAL(0.375, a.getAvgQueueTime());
+}
+
 vespalib::string get_worker_stack_trace(ThreadStackExecutor &executor) {
     struct StackTraceTask : public Executor::Task {
         vespalib::string &trace;
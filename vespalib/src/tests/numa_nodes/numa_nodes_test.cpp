@@ -0,0 +1,44 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/util/numa_nodes.h>
+#include <algorithm>
+#include <sched.h>
+
+using namespace vespalib;
+using CpuList = NumaNodes::CpuList;
+
+bool contains(const CpuList &cpus, int cpu) {
+    return (std::find(cpus.begin(), cpus.end(), cpu) != cpus.end());
+}
+
+TEST("require that cpu lists are parsed") {
+    EXPECT_TRUE(CpuList() == NumaNodes::parseList(""));
+    EXPECT_TRUE(CpuList({0}) == NumaNodes::parseList("0"));
+    EXPECT_TRUE(CpuList({0, 1, 2, 3}) == NumaNodes::parseList("0-3"));
+    EXPECT_TRUE(CpuList({0, 1, 8, 10, 11}) == NumaNodes::parseList("0-1,8,10-11"));
+    EXPECT_TRUE(CpuList({4, 5}) == NumaNodes::parseList("4-5\n"));
+}
+
+TEST("require that all cpus are collected from all nodes") {
+    NumaNodes nodes({{4, 5}, {0, 1}});
+    EXPECT_EQUAL(2u, nodes.size());
+    EXPECT_TRUE(CpuList({4, 5}) == nodes.cpus(0));
+    EXPECT_TRUE(CpuList({0, 1, 4, 5}) == nodes.allCpus());
+}
+
+TEST("require that host has at least one node with cpus") {
+    NumaNodes nodes;
+    ASSERT_LESS_EQUAL(1u, nodes.size());
+    for (size_t node = 0; node < nodes.size(); ++node) {
+        EXPECT_FALSE(nodes.cpus(node).empty());
+    }
+}
+
+TEST("require that current thread can be bound to a node and unbound again") {
+    NumaNodes nodes;
+    EXPECT_TRUE(nodes.bindCurrentThread(0));
+    EXPECT_TRUE(contains(nodes.cpus(0), sched_getcpu()));
+    EXPECT_TRUE(nodes.unbindCurrentThread());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
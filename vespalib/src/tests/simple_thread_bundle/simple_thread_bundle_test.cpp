@@ -4,6 +4,8 @@
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/box.h>
 #include <vespa/vespalib/util/sync.h>
+#include <algorithm>
+#include <sched.h>
 
 using namespace vespalib;
 using namespace vespalib::fixed_thread_bundle;
@@ -187,4 +189,42 @@ TEST_MT_FF("require that bundle pool works with multiple threads", 32, SimpleThr
     f1.release(std::move(bundle));
 }
 
+struct CpuRecorder : Runnable {
+    int cpu;
+    CpuRecorder() : cpu(-1) {}
+    void run() override { cpu = sched_getcpu(); }
+};
+
+TEST_F("require that numa aware bundle pool hands out bundles from nodes round robin",
+       NumaNodes({NumaNodes().allCpus(), NumaNodes().allCpus()}))
+{
+    SimpleThreadBundle::Pool pool(3, &f1);
+    SimpleThreadBundle::UP b1 = pool.obtain();
+    SimpleThreadBundle::UP b2 = pool.obtain();
+    SimpleThreadBundle::UP b3 = pool.obtain();
+    EXPECT_EQUAL(0u, b1->numaNode());
+    EXPECT_EQUAL(1u, b2->numaNode());
+    EXPECT_EQUAL(0u, b3->numaNode());
+    SimpleThreadBundle *ptr = b2.get();
+    pool.release(std::move(b2));
+    pool.release(std::move(b1));
+    pool.release(std::move(b3));
+    SimpleThreadBundle::UP b4 = pool.obtain();
+    EXPECT_EQUAL(ptr, b4.get());
+}
+
+TEST_F("require that threads of numa aware bundle run on the cpus of its node", NumaNodes()) {
+    SimpleThreadBundle bundle(3, f1, f1.size() - 1);
+    std::vector<CpuRecorder> recorders(3);
+    std::vector<Runnable*> targets;
+    for (CpuRecorder &recorder : recorders) {
+        targets.push_back(&recorder);
+    }
+    bundle.run(targets);
+    const NumaNodes::CpuList &cpus = f1.cpus(f1.size() - 1);
+    for (size_t i = 1; i < recorders.size(); ++i) {
+        EXPECT_TRUE(std::find(cpus.begin(), cpus.end(), recorders[i].cpu) != cpus.end());
+    }
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -30,6 +31,31 @@ bool parse_json_bytes(const Memory & json, Slime &slime) {
 }
 
 
+Slime make_string_heavy_slime() {
+    Slime slime;
+    Cursor &arr = slime.setArray();
+    for (size_t i = 0; i < 1000; ++i) {
+        std::string str(100, 'a' + (i % 26));
+        if ((i % 10) == 0) {
+            str[i % 100] = '"';
+        }
+        arr.addString(str);
+    }
+    return slime;
+}
+
+template <typename F>
+void benchmark(const char *name, size_t numRep, size_t bytes, F &&f) {
+    vespalib::BenchmarkTimer timer(0.0);
+    timer.before();
+    for (size_t i(0); i < numRep; i++) {
+        f();
+    }
+    timer.after();
+    fprintf(stderr, "%s: %zu reps in %g s (%g MB/s)\n", name, numRep, timer.min_time(),
+            (numRep * bytes) / timer.min_time() / 1000000.0);
+}
+
 int main(int argc, char *argv[])
 {
     size_t numRep(10000);
@@ -42,8 +68,23 @@ int main(int argc, char *argv[])
     buf << file.rdbuf();
     std::string str = buf.str();
     Memory mem(str.c_str(), 18911);
-    for (size_t i(0); i < numRep; i++) {
-        Slime f;
-        assert(parse_json_bytes(mem, f));
-    }
+    benchmark("decode large_json", numRep, mem.size, [&mem]() {
+                  Slime f;
+                  assert(parse_json_bytes(mem, f));
+              });
+    Slime large;
+    assert(parse_json_bytes(mem, large));
+    std::string largeJson = make_json(large, true);
+    benchmark("encode large_json", numRep, largeJson.size(), [&large]() {
+                  make_json(large, true);
+              });
+    Slime strings = make_string_heavy_slime();
+    std::string stringsJson = make_json(strings, true);
+    benchmark("decode strings", numRep, stringsJson.size(), [&stringsJson]() {
+                  Slime f;
+                  assert(parse_json(stringsJson, f));
+              });
+    benchmark("encode strings", numRep, stringsJson.size(), [&strings]() {
+                  make_json(strings, true);
+              });
 }
@@ -669,4 +669,26 @@ TEST("require that decode failure results in 0 return value") {
     EXPECT_EQUAL(BinaryFormat::decode(buf.get(), slime), 0u);
 }
 
+TEST("require that decode_borrowed references data values in the input") {
+    Slime original;
+    Cursor &root = original.setObject();
+    std::string payload(10000, 'x');
+    root.setData("payload", Memory(payload));
+    root.setString("name", "foo");
+    root.setArray("list").addData(Memory("bar"));
+
+    SimpleBuffer buf;
+    BinaryFormat::encode(original, buf);
+    Memory input = buf.get();
+    Slime slime;
+    EXPECT_EQUAL(BinaryFormat::decode_borrowed(input, slime), input.size);
+    EXPECT_EQUAL(original, slime);
+    auto within_input = [&input](const Memory &mem) {
+        return (mem.data >= input.data) && ((mem.data + mem.size) <= (input.data + input.size));
+    };
+    EXPECT_TRUE(within_input(slime.get()["payload"].asData()));
+    EXPECT_TRUE(within_input(slime.get()["list"][0].asData()));
+    EXPECT_FALSE(within_input(slime.get()["name"].asString()));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
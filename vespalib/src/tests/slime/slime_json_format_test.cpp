@@ -277,6 +277,30 @@ TEST("decode string") {
     EXPECT_EQUAL(std::string("\xf4\x8f\xbf\xbf"), json_string("\\udbff\\udfff"));
 }
 
+TEST("strings with special characters at any position survive encoding and decoding") {
+    const char *specials[] = { "\"", "\\", "\n", "\x01", "\x1f", "'", "/", "\xc3\xa6" };
+    for (size_t len = 0; len < 20; ++len) {
+        for (size_t pos = 0; pos <= len; ++pos) {
+            for (const char *special: specials) {
+                std::string str(len, 'x');
+                str.insert(pos, special);
+                Slime slime;
+                slime.setString(str);
+                std::string json = make_json(slime, true);
+                Slime result;
+                EXPECT_EQUAL(json.size(), vespalib::slime::JsonFormat::decode(json, result));
+                EXPECT_EQUAL(str, result.get().asString().make_string());
+            }
+        }
+    }
+}
+
+TEST_F("encode string with characters needing escaping", Slime) {
+    f.setString("long plain prefix \" then \\ and \x01 and plain suffix");
+    EXPECT_EQUAL("\"long plain prefix \\\" then \\\\ and \\u0001 and plain suffix\"",
+                 make_json(f, true));
+}
+
 TEST_F("decode empty array", Slime) {
     EXPECT_TRUE(parse_json("[]", f));
     EXPECT_EQUAL(vespalib::slime::ARRAY::ID, f.get().type().getId());
@@ -6,6 +6,7 @@
 #include <vespa/vespalib/stllike/hash_map_equal.hpp>
 #include <cstddef>
 #include <algorithm>
+#include <set>
 
 using namespace vespalib;
 using std::make_pair;
@@ -477,4 +478,103 @@ TEST("test hash table capacity and size") {
     EXPECT_EQUAL(2048u, many.capacity());
 }
 
+template <typename K, typename V>
+using swiss_hash_map = hash_map<K, V, vespalib::hash<K>, std::equal_to<K>, swiss_probing>;
+
+TEST("test swiss hash map insert, find and erase")
+{
+    swiss_hash_map<int, int> map;
+    EXPECT_EQUAL(0u, map.size());
+    EXPECT_EQUAL(0u, map.capacity());
+    EXPECT_TRUE(map.begin() == map.end());
+    EXPECT_TRUE(map.find(7) == map.end());
+    map.erase(7);
+    EXPECT_TRUE(map.insert(make_pair(7, 70)).second);
+    EXPECT_FALSE(map.insert(make_pair(7, 71)).second);
+    EXPECT_EQUAL(70, map.find(7)->second);
+    EXPECT_EQUAL(1u, map.size());
+    for (int i(0); i < 10000; i++) {
+        map[i] = i*10;
+    }
+    EXPECT_EQUAL(10000u, map.size());
+    for (int i(0); i < 5000; i++) {
+        map.erase(i*2);
+    }
+    EXPECT_EQUAL(5000u, map.size());
+    for (int i(0); i < 10000; i++) {
+        EXPECT_EQUAL((i % 2) != 0, map.find(i) != map.end());
+    }
+    size_t visited(0);
+    for (const auto & entry : map) {
+        EXPECT_EQUAL(entry.first*10, entry.second);
+        ++visited;
+    }
+    EXPECT_EQUAL(5000u, visited);
+
+    swiss_hash_map<int, int> copy(map);
+    map.clear();
+    EXPECT_EQUAL(0u, map.size());
+    EXPECT_TRUE(map.begin() == map.end());
+    EXPECT_EQUAL(5000u, copy.size());
+    EXPECT_EQUAL(49990, copy.find(4999)->second);
+    map.swap(copy);
+    EXPECT_EQUAL(5000u, map.size());
+    EXPECT_EQUAL(0u, copy.size());
+    swiss_hash_map<int, int> moved(std::move(map));
+    EXPECT_EQUAL(5000u, moved.size());
+    swiss_hash_map<int, int> copied(moved);
+    EXPECT_TRUE(moved == copied);
+}
+
+TEST("test swiss hash set with colliding hash values and erase/insert cycles")
+{
+    hash_set<Foo, Foo::hash, std::equal_to<Foo>, swiss_probing> set;
+    std::set<int> expected;
+    srand(42);
+    for (size_t i(0); i < 20000; i++) {
+        int value = rand() % 500;
+        if ((rand() % 3) == 0) {
+            set.erase(Foo(value));
+            expected.erase(value);
+        } else {
+            EXPECT_EQUAL(expected.insert(value).second, set.insert(Foo(value)).second);
+        }
+        EXPECT_EQUAL(expected.size(), set.size());
+    }
+    for (int i(0); i < 500; i++) {
+        EXPECT_EQUAL(expected.count(i) != 0, set.find(Foo(i)) != set.end());
+    }
+    std::set<int> actual;
+    for (const Foo & foo : set) {
+        actual.insert(foo.i);
+    }
+    EXPECT_TRUE(expected == actual);
+    EXPECT_LESS_EQUAL(set.size(), set.capacity());
+    EXPECT_LESS(set.capacity(), 2048u);
+}
+
+TEST("test swiss hash set find with alternative key")
+{
+    hash_set<S, myhash, std::equal_to<S>, swiss_probing> set(1000);
+    for (size_t i(0); i < 10000; i++) {
+        set.insert(S(i));
+    }
+    EXPECT_TRUE(*set.find(S(1)) == S(1));
+    auto cit = set.find<uint32_t, myextract, vespalib::hash<uint32_t>, std::equal_to<uint32_t>>(7);
+    EXPECT_TRUE(*cit == S(7));
+    EXPECT_TRUE((set.find<uint32_t, myextract, vespalib::hash<uint32_t>, std::equal_to<uint32_t>>(10007) == set.end()));
+}
+
+TEST("test swiss hash map reserve keeps capacity") {
+    swiss_hash_map<int, int> map;
+    map.resize(1000);
+    size_t capacity = map.capacity();
+    EXPECT_LESS_EQUAL(1000u, capacity - capacity/8);
+    for (int i(0); i < 1000; i++) {
+        map[i] = i;
+    }
+    EXPECT_EQUAL(capacity, map.capacity());
+    EXPECT_LESS(map.getMemoryUsed(), map.getMemoryConsumption());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -63,6 +63,12 @@ size_t benchHashVespaLib2(size_t sz, size_t numLookups)
     return bench(set, sz, numLookups);
 }
 
+size_t benchHashVespaLibSwiss(size_t sz, size_t numLookups)
+{
+    vespalib::hash_set<uint32_t, vespalib::hash<uint32_t>, std::equal_to<uint32_t>, vespalib::swiss_probing> set;
+    return bench(set, sz, numLookups);
+}
+
 int main(int argc, char *argv[])
 {
     size_t count(1000);
@@ -82,17 +88,20 @@ int main(int argc, char *argv[])
     description['h'] = "std::hash_set";
     description['g'] = "vespalib::hash_set";
     description['G'] = "vespalib::hash_set with simple and modulator.";
+    description['s'] = "vespalib::hash_set with swiss probing.";
     size_t found(0);
     switch (type) {
     case 'm': found = benchMap(count, rep); break;
     case 'h': found = benchHashStl(count, rep); break;
     case 'g': found = benchHashVespaLib(count, rep); break;
     case 'G': found = benchHashVespaLib2(count, rep); break;
+    case 's': found = benchHashVespaLibSwiss(count, rep); break;
     default:
         printf("'m' = %s\n", description[type]);
         printf("'h' = %s\n", description[type]);
         printf("'g' = %s\n", description[type]);
         printf("'G' = %s\n", description[type]);
+        printf("'s' = %s\n", description[type]);
         printf("Unspecified type %c. Running map lookup benchmark\n", type);
         exit(1);
         break;
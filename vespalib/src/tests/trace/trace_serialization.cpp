@@ -5,6 +5,9 @@ LOG_SETUP("trace_test");
 #include <vespa/vespalib/trace/tracenode.h>
 #include <vespa/vespalib/trace/slime_trace_serializer.h>
 #include <vespa/vespalib/trace/slime_trace_deserializer.h>
+#include <vespa/vespalib/trace/span_trace.h>
+#include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/data/memory.h>
 
 using namespace vespalib;
 using namespace vespalib::slime;
@@ -106,4 +109,52 @@ TEST("test serialization and deserialization") {
     ASSERT_EQUAL(3u, root2.getNumChildren());
 }
 
+TEST("that spans are serialized relative to the origin in start order") {
+    using ms = std::chrono::milliseconds;
+    SpanTrace::clock::time_point origin = SpanTrace::clock::now();
+    SpanTrace trace(origin);
+    trace.addSpan("second_phase", 1, origin + ms(30), origin + ms(35));
+    trace.addSpan("first_phase", 1, origin + ms(10), origin + ms(30));
+    trace.addSpan("queue", 0, origin, origin + ms(10));
+    EXPECT_EQUAL(3u, trace.size());
+    Slime slime;
+    trace.toSlime(slime.setObject());
+    Inspector &spans = slime.get()["spans"];
+    ASSERT_EQUAL(3u, spans.entries());
+    EXPECT_EQUAL("queue", spans[0]["name"].asString().make_string());
+    EXPECT_EQUAL(0, spans[0]["thread"].asLong());
+    EXPECT_APPROX(0.0, spans[0]["start_ms"].asDouble(), 1e-6);
+    EXPECT_APPROX(10.0, spans[0]["duration_ms"].asDouble(), 1e-6);
+    EXPECT_EQUAL("first_phase", spans[1]["name"].asString().make_string());
+    EXPECT_EQUAL(1, spans[1]["thread"].asLong());
+    EXPECT_APPROX(10.0, spans[1]["start_ms"].asDouble(), 1e-6);
+    EXPECT_APPROX(20.0, spans[1]["duration_ms"].asDouble(), 1e-6);
+    EXPECT_EQUAL("second_phase", spans[2]["name"].asString().make_string());
+    EXPECT_APPROX(30.0, spans[2]["start_ms"].asDouble(), 1e-6);
+}
+
+TEST("that a span scope records a span only when tracing is enabled") {
+    SpanTrace trace(SpanTrace::clock::now());
+    {
+        SpanTrace::Scope enabled(&trace, "enabled", 3);
+        SpanTrace::Scope disabled(nullptr, "disabled", 4);
+    }
+    auto spans = trace.getSpans();
+    ASSERT_EQUAL(1u, spans.size());
+    EXPECT_EQUAL("enabled", spans[0].name);
+    EXPECT_EQUAL(3u, spans[0].thread);
+    EXPECT_TRUE(spans[0].start <= spans[0].end);
+}
+
+TEST("that an encoded span trace can be decoded") {
+    SpanTrace::clock::time_point origin = SpanTrace::clock::now();
+    SpanTrace trace(origin);
+    trace.addSpan("match", 2, origin, origin + std::chrono::milliseconds(5));
+    vespalib::string encoded = trace.encode();
+    Slime slime;
+    EXPECT_EQUAL(encoded.size(), BinaryFormat::decode(Memory(encoded), slime));
+    EXPECT_EQUAL("match", slime.get()["spans"][0]["name"].asString().make_string());
+    EXPECT_EQUAL(2, slime.get()["spans"][0]["thread"].asLong());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
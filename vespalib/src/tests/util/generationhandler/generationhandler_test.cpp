@@ -3,6 +3,8 @@
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/vespalib/util/generationhandler.h>
 #include <deque>
+#include <mutex>
+#include <thread>
 
 namespace vespalib {
 
@@ -15,6 +17,7 @@ private:
     void requireThatGuardsCanBeCopied();
     void requireThatTheFirstUsedGenerationIsCorrect();
     void requireThatGenerationCanGrowLarge();
+    void requireThatReaderSlotsAreSummed();
 public:
     int Main() override;
 };
@@ -138,6 +141,44 @@ Test::requireThatGenerationCanGrowLarge()
     }
 }
 
+void
+Test::requireThatReaderSlotsAreSummed()
+{
+    GenerationHandler gh(4);
+    std::vector<GenGuard> guards;
+    std::vector<std::thread> threads;
+    std::mutex lock;
+    for (size_t i = 0; i < 8; ++i) {
+        threads.emplace_back([&gh, &guards, &lock]() {
+                GenGuard guard = gh.takeGuard();
+                std::lock_guard<std::mutex> guardLock(lock);
+                guards.push_back(guard);
+                guards.push_back(std::move(guard));
+            });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQUAL(16u, gh.getGenerationRefCount(0));
+    gh.incGeneration();
+    EXPECT_EQUAL(0u, gh.getFirstUsedGeneration());
+    {
+        GenGuard g1 = gh.takeGuard();
+        EXPECT_EQUAL(1u, gh.getGenerationRefCount(1));
+    }
+    for (size_t i = 0; i < 15; ++i) {
+        guards.pop_back();
+        gh.updateFirstUsedGeneration();
+        EXPECT_EQUAL(0u, gh.getFirstUsedGeneration());
+        EXPECT_EQUAL(15u - i, gh.getGenerationRefCount(0));
+    }
+    guards.pop_back();
+    gh.updateFirstUsedGeneration();
+    EXPECT_EQUAL(1u, gh.getFirstUsedGeneration());
+    EXPECT_EQUAL(0u, gh.getGenerationRefCount());
+    EXPECT_EQUAL(false, gh.hasReaders());
+}
+
 int
 Test::Main()
 {
@@ -148,6 +189,7 @@ Test::Main()
     TEST_DO(requireThatGuardsCanBeCopied());
     TEST_DO(requireThatTheFirstUsedGenerationIsCorrect());
     TEST_DO(requireThatGenerationCanGrowLarge());
+    TEST_DO(requireThatReaderSlotsAreSummed());
 
     TEST_DONE();
 }
@@ -32,7 +32,7 @@ struct Fixture {
     std::atomic<int> _stopRead;
     bool _reportWork;
 
-    Fixture(uint32_t readThreads = 1);
+    Fixture(uint32_t readThreads = 1, uint32_t readerSlots = 1);
 
     ~Fixture();
 
@@ -49,8 +49,8 @@ private:
 };
 
 
-Fixture::Fixture(uint32_t readThreads)
-    : _generationHandler(),
+Fixture::Fixture(uint32_t readThreads, uint32_t readerSlots)
+    : _generationHandler(readerSlots),
       _readThreads(readThreads),
       _writer(1, 128 * 1024),
       _readers(readThreads, 128 * 1024),
@@ -165,4 +165,9 @@ TEST_F("stress test, 4 readers", Fixture(4))
     f.stressTest(1000000);
 }
 
+TEST_F("stress test, 4 readers, 4 reader slots", Fixture(4, 4))
+{
+    f.stressTest(1000000);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
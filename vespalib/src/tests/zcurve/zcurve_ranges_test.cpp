@@ -54,4 +54,59 @@ TEST("require that silly bounding box does not explode") {
     EXPECT_EQUAL(42u, ranges.size());
 }
 
+bool within(int x, int y, int cx, int cy, uint32_t x_aspect, uint32_t radius) {
+    uint32_t dx = (x > cx) ? (x - cx) : (cx - x);
+    if (x_aspect != 0) {
+        dx = (uint64_t(dx) * x_aspect) >> 32;
+    }
+    uint32_t dy = (y > cy) ? (y - cy) : (cy - y);
+    return (uint64_t(dx) * dx + uint64_t(dy) * dy) <= (uint64_t(radius) * radius);
+}
+
+int64_t total_estimate(const Z::RangeVector &ranges) {
+    int64_t estimate = 0;
+    for (auto range: ranges) {
+        estimate += (range.max() - range.min() + 1);
+    }
+    return estimate;
+}
+
+TEST("require that returned ranges contains circle") {
+    for (int cx: {-13, -1, 0, 1, 13}) {
+        for (int cy: {-13, 0, 13}) {
+            for (uint32_t radius: {0u, 1u, 5u, 20u}) {
+                for (uint32_t x_aspect: {0u, 0x80000000u}) {
+                    uint32_t max_dx = (x_aspect == 0) ? radius : 2 * radius + 1;
+                    int min_x = cx - max_dx, max_x = cx + max_dx;
+                    int min_y = cy - radius, max_y = cy + radius;
+                    Z::RangeVector ranges = Z::find_ranges(min_x, min_y, max_x, max_y,
+                                                           cx, cy, x_aspect, radius);
+                    for (int x = min_x; x <= max_x; ++x) {
+                        for (int y = min_y; y <= max_y; ++y) {
+                            if (within(x, y, cx, cy, x_aspect, radius)) {
+                                EXPECT_TRUE(inside(x, y, ranges));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST("require that circle ranges cut off bounding box corners") {
+    Z::RangeVector box = Z::find_ranges(-13, -13, 13, 13);
+    Z::RangeVector circle = Z::find_ranges(-13, -13, 13, 13, 0, 0, 0, 13);
+    EXPECT_LESS(total_estimate(circle), total_estimate(box));
+    EXPECT_LESS_EQUAL(circle.size(), 42u);
+}
+
+TEST("require that huge circle does not explode") {
+    Z::RangeVector ranges = Z::find_ranges(-2000000000, -2000000000, 2000000000, 2000000000,
+                                           0, 0, 0, 2000000000u);
+    EXPECT_LESS_EQUAL(ranges.size(), 42u);
+    EXPECT_TRUE(inside(0, 0, ranges));
+    EXPECT_TRUE(inside(1414213562, 1414213562, ranges));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
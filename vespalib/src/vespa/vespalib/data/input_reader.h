@@ -59,6 +59,20 @@ public:
         return obtain_slow();
     }
 
+    /**
+     * Look at the input data that is available without requesting
+     * more from the underlying Input. The returned Memory is only
+     * valid until the reader is used again. Use read(bytes) to
+     * consume (a prefix of) the peeked data.
+     *
+     * @return the available input data. Empty on eof or if the
+     *         reader has failed.
+     **/
+    Memory peek() {
+        obtain();
+        return Memory(data(), size());
+    }
+
     /**
      * Read a single byte. Reading past the end of the input will
      * result in the reader failing with input underflow.
@@ -2,6 +2,7 @@
 
 #include "binary_format.h"
 #include "slime.h"
+#include "external_memory.h"
 #include <vespa/vespalib/data/memory_input.h>
 
 namespace vespalib {
@@ -118,16 +119,25 @@ struct SymbolHandler {
     typedef typename std::conditional<remap_symbols, MappedSymbols, DirectSymbols>::type type;
 };
 
+// data value referencing (not owning) a region of the decoded input
+struct BorrowedMemory : ExternalMemory {
+    Memory memory;
+    BorrowedMemory(const Memory &memory_in) : memory(memory_in) {}
+    Memory get() const override { return memory; }
+};
+
 template <bool remap_symbols>
 struct BinaryDecoder : SymbolHandler<remap_symbols>::type {
 
     InputReader &in;
+    bool borrow_data;
 
     using SymbolHandler<remap_symbols>::type::hint_symbol_count;
     using SymbolHandler<remap_symbols>::type::add_symbol;
     using SymbolHandler<remap_symbols>::type::map_symbol;
 
-    BinaryDecoder(InputReader &input) : in(input) {}
+    BinaryDecoder(InputReader &input, bool borrow_data_in)
+        : in(input), borrow_data(borrow_data_in) {}
 
     Cursor &decodeNix(const Inserter &inserter) {
         return inserter.insertNix();
@@ -152,6 +162,9 @@ struct BinaryDecoder : SymbolHandler<remap_symbols>::type {
 
     Cursor &decodeData(const Inserter &inserter, uint32_t meta) {
         uint64_t size = read_size(in, meta);
+        if (borrow_data) {
+            return inserter.insertData(std::make_unique<BorrowedMemory>(in.read(size)));
+        }
         return inserter.insertData(in.read(size));
     }
 
@@ -225,10 +238,10 @@ BinaryDecoder<remap_symbols>::decodeObject(const Inserter &inserter, uint32_t me
 }
 
 template <bool remap_symbols>
-size_t decode(const Memory &memory, Slime &slime, const Inserter &inserter) {
+size_t decode(const Memory &memory, Slime &slime, const Inserter &inserter, bool borrow_data) {
     MemoryInput memory_input(memory);
     InputReader input(memory_input);
-    binary_format::BinaryDecoder<remap_symbols> decoder(input);
+    binary_format::BinaryDecoder<remap_symbols> decoder(input, borrow_data);
     decoder.decodeSymbolTable(slime);
     decoder.decodeValue(inserter);
     if (input.failed() && !remap_symbols) {
@@ -254,13 +267,19 @@ BinaryFormat::encode(const Slime &slime, Output &output)
 size_t
 BinaryFormat::decode(const Memory &memory, Slime &slime)
 {
-    return binary_format::decode<false>(memory, slime, SlimeInserter(slime));
+    return binary_format::decode<false>(memory, slime, SlimeInserter(slime), false);
+}
+
+size_t
+BinaryFormat::decode_borrowed(const Memory &memory, Slime &slime)
+{
+    return binary_format::decode<false>(memory, slime, SlimeInserter(slime), true);
 }
 
 size_t
 BinaryFormat::decode_into(const Memory &memory, Slime &slime, const Inserter &inserter)
 {
-    return binary_format::decode<true>(memory, slime, inserter);
+    return binary_format::decode<true>(memory, slime, inserter, false);
 }
 
 namespace binary_format {
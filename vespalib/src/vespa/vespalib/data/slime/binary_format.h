@@ -18,6 +18,15 @@ namespace slime {
 struct BinaryFormat {
     static void encode(const Slime &slime, Output &output);
     static size_t decode(const Memory &memory, Slime &slime);
+
+    /**
+     * Like decode, but data values reference the input buffer instead
+     * of being copied into the slime. Large binary payloads are thereby
+     * decoded without copying. The caller must keep the input memory
+     * alive and unchanged for as long as the slime is in use. Strings
+     * and symbols are still copied.
+     **/
+    static size_t decode_borrowed(const Memory &memory, Slime &slime);
     static size_t decode_into(const Memory &memory, Slime &slime, const Inserter &inserter);
 };
 
@@ -7,12 +7,68 @@
 #include <vespa/vespalib/data/memory_input.h>
 #include <vespa/vespalib/locale/c.h>
 #include <cmath>
+#include <cstring>
 #include <sstream>
 
 namespace vespalib::slime {
 
 namespace {
 
+// Strings are scanned a word at a time to find the bytes that need
+// special handling; the bytes in between are copied in bulk.
+
+constexpr uint64_t ONES = 0x0101010101010101ULL;
+constexpr uint64_t HIGH_BITS = 0x8080808080808080ULL;
+
+// non-zero if any byte in 'word' is less than 'n' (n <= 128)
+constexpr uint64_t hasLess(uint64_t word, uint8_t n) {
+    return ((word - ONES * n) & ~word & HIGH_BITS);
+}
+
+// non-zero if any byte in 'word' is equal to 'c'
+constexpr uint64_t hasByte(uint64_t word, uint8_t c) {
+    return hasLess(word ^ (ONES * c), 1);
+}
+
+// bytes that must be escaped when encoding a string
+struct EncodeSpecial {
+    bool word(uint64_t w) const {
+        return (hasByte(w, '"') | hasByte(w, '\\') | hasLess(w, 0x20)) != 0;
+    }
+    bool byte(uint8_t c) const {
+        return ((c == '"') || (c == '\\') || (c < 0x20));
+    }
+};
+
+// bytes that must be inspected when decoding a string
+struct DecodeSpecial {
+    uint8_t quote;
+    explicit DecodeSpecial(char quote_in) : quote(quote_in) {}
+    bool word(uint64_t w) const {
+        return (hasByte(w, quote) | hasByte(w, '\\') | hasLess(w, 1)) != 0;
+    }
+    bool byte(uint8_t c) const {
+        return ((c == quote) || (c == '\\') || (c == '\0'));
+    }
+};
+
+// number of bytes before the first special byte
+template <typename Special>
+size_t plainPrefix(const char *data, size_t size, const Special &special) {
+    size_t pos = 0;
+    for (; (pos + sizeof(uint64_t)) <= size; pos += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, data + pos, sizeof(uint64_t));
+        if (special.word(word)) {
+            break;
+        }
+    }
+    while ((pos < size) && !special.byte(data[pos])) {
+        ++pos;
+    }
+    return pos;
+}
+
 template <bool COMPACT>
 struct JsonEncoder : public ArrayTraverser,
                      public ObjectTraverser
@@ -75,6 +131,14 @@ struct JsonEncoder : public ArrayTraverser,
         const char *pos = memory.data;
         const char *end = memory.data + memory.size;
         for (; pos < end; ++pos) {
+            size_t plain = plainPrefix(pos, end - pos, EncodeSpecial());
+            memcpy(p, pos, plain);
+            p += plain;
+            len += plain;
+            pos += plain;
+            if (pos == end) {
+                break;
+            }
             uint8_t c = *pos;
             switch(c) {
             case '"':  *p++ = '\\'; *p++ = '"';  len += 2; break;
@@ -340,11 +404,16 @@ JsonDecoder::readString(vespalib::string &str)
         case '\0':
             in.fail("unterminated string");
             return;
-        default:
+        default: {
             str.push_back(c);
+            Memory input = in.peek();
+            size_t plain = plainPrefix(input.data, input.size, DecodeSpecial(quote));
+            str.append(input.data, plain);
+            in.read(plain);
             next();
             break;
         }
+        }
     }
 }
 
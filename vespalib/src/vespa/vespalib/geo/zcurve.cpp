@@ -45,6 +45,8 @@ public:
 
     size_t size() const { return _queue.size(); }
 
+    int64_t worst_error() { return _queue.empty() ? 0 : _queue.front().error(); }
+
     RangeVector extract_ranges() {
         RangeVector ranges;
         ranges.reserve(_queue.size());
@@ -57,36 +59,82 @@ public:
     }
 };
 
+/**
+ * A circle using the same x-aspect scaled distance as location search.
+ **/
+class ZCircle
+{
+private:
+    int32_t  _x;
+    int32_t  _y;
+    uint32_t _x_aspect;
+    uint64_t _radius2;
+
+    static uint32_t distance(int32_t pos, int32_t min, int32_t max) {
+        if (pos < min) {
+            return static_cast<uint32_t>(static_cast<int64_t>(min) - pos);
+        }
+        if (pos > max) {
+            return static_cast<uint32_t>(static_cast<int64_t>(pos) - max);
+        }
+        return 0;
+    }
+
+public:
+    ZCircle(int32_t x, int32_t y, uint32_t x_aspect, uint32_t radius)
+        : _x(x), _y(y), _x_aspect(x_aspect),
+          _radius2(static_cast<uint64_t>(radius) * radius) {}
+
+    bool intersects(const ZCurve::Area &area) const {
+        uint32_t dx = distance(_x, area.min.x, area.max.x);
+        if (_x_aspect != 0) {
+            dx = (static_cast<uint64_t>(dx) * _x_aspect) >> 32;
+        }
+        uint32_t dy = distance(_y, area.min.y, area.max.y);
+        return ((static_cast<uint64_t>(dx) * dx + static_cast<uint64_t>(dy) * dy) <= _radius2);
+    }
+};
+
 class ZAreaSplitter
 {
 private:
     typedef ZCurve::Area Area;
     typedef ZCurve::RangeVector RangeVector;
 
-    ZAreaQueue _queue;
+    ZAreaQueue     _queue;
+    const ZCircle *_circle;
+
+    void put(Area area) {
+        if ((_circle == nullptr) || _circle->intersects(area)) {
+            _queue.put(std::move(area));
+        }
+    }
 
 public:
-    ZAreaSplitter(int min_x, int min_y, int max_x, int max_y) : _queue() {
+    ZAreaSplitter(int min_x, int min_y, int max_x, int max_y, const ZCircle *circle = nullptr)
+        : _queue(),
+          _circle(circle)
+    {
         assert(min_x <= max_x);
         assert(min_y <= max_y);
         bool cross_x = (min_x < 0) != (max_x < 0);
         bool cross_y = (min_y < 0) != (max_y < 0);
         if (cross_x) {
             if (cross_y) {
-                _queue.put(Area(min_x, min_y,    -1,    -1));
-                _queue.put(Area(    0, min_y, max_x,    -1));
-                _queue.put(Area(min_x,     0,    -1, max_y));
-                _queue.put(Area(    0,     0, max_x, max_y));
+                put(Area(min_x, min_y,    -1,    -1));
+                put(Area(    0, min_y, max_x,    -1));
+                put(Area(min_x,     0,    -1, max_y));
+                put(Area(    0,     0, max_x, max_y));
             } else {
-                _queue.put(Area(min_x, min_y,    -1, max_y));
-                _queue.put(Area(    0, min_y, max_x, max_y));
+                put(Area(min_x, min_y,    -1, max_y));
+                put(Area(    0, min_y, max_x, max_y));
             }
         } else {
             if (cross_y) {
-                _queue.put(Area(min_x, min_y, max_x,    -1));
-                _queue.put(Area(min_x,     0, max_x, max_y));
+                put(Area(min_x, min_y, max_x,    -1));
+                put(Area(min_x,     0, max_x, max_y));
             } else {
-                _queue.put(Area(min_x, min_y, max_x, max_y));
+                put(Area(min_x, min_y, max_x, max_y));
             }
         }
     }
@@ -95,6 +143,8 @@ public:
 
     int64_t total_estimate() const { return _queue.total_estimate(); }
 
+    bool can_split() { return _queue.worst_error() > 0; }
+
     void split_worst() {
         Area area = _queue.get();
         uint32_t x_first_max, x_last_min;
@@ -102,12 +152,12 @@ public:
         uint32_t x_bits = bits::split_range(area.min.x, area.max.x, x_first_max, x_last_min);
         uint32_t y_bits = bits::split_range(area.min.y, area.max.y, y_first_max, y_last_min);
         if (x_bits > y_bits) {
-            _queue.put(Area(area.min.x, area.min.y, x_first_max, area.max.y));
-            _queue.put(Area(x_last_min, area.min.y,  area.max.x, area.max.y));
+            put(Area(area.min.x, area.min.y, x_first_max, area.max.y));
+            put(Area(x_last_min, area.min.y,  area.max.x, area.max.y));
         } else {
             assert(y_bits > 0);
-            _queue.put(Area(area.min.x, area.min.y, area.max.x, y_first_max));
-            _queue.put(Area(area.min.x, y_last_min, area.max.x,  area.max.y));
+            put(Area(area.min.x, area.min.y, area.max.x, y_first_max));
+            put(Area(area.min.x, y_last_min, area.max.x,  area.max.y));
         }
     }
 
@@ -142,6 +192,29 @@ ZCurve::find_ranges(int min_x, int min_y,
     return ranges;
 }
 
+ZCurve::RangeVector
+ZCurve::find_ranges(int min_x, int min_y,
+                    int max_x, int max_y,
+                    int32_t x, int32_t y,
+                    uint32_t x_aspect, uint32_t radius)
+{
+    int64_t total_size = ((max_x - min_x + 1L) * (max_y - min_y + 1L));
+    int64_t estimate_target = (total_size * 4);
+    ZCircle circle(x, y, x_aspect, radius);
+    ZAreaSplitter splitter(min_x, min_y, max_x, max_y, &circle);
+    // Splitting drops areas outside the circle, so use a few more
+    // ranges than needed for the bounding box to cut off its corners.
+    while (splitter.can_split() &&
+           (splitter.total_estimate() > estimate_target || splitter.num_ranges() < 16) &&
+           splitter.num_ranges() < 42)
+    {
+        splitter.split_worst();
+    }
+    RangeVector ranges = splitter.extract_ranges();
+    std::sort(ranges.begin(), ranges.end());
+    return ranges;
+}
+
 int64_t
 ZCurve::encodeSlow(int32_t x, int32_t y)
 {
@@ -183,7 +183,7 @@ public:
             assert((min_y <= max_y) && ((min_y < 0) == (max_y < 0)));
         }
         Area &operator=(Area &&rhs) { new ((void*)this) Area(rhs); return *this; }
-        int64_t size() const { return (max.x - min.x + 1) * (max.y - min.y + 1); }
+        int64_t size() const { return (int64_t(max.x) - min.x + 1) * (int64_t(max.y) - min.y + 1); }
         int64_t estimate() const { return (max.z - min.z + 1); }
         int64_t error() const { return estimate() - size(); }
     };
@@ -213,6 +213,20 @@ public:
     static RangeVector find_ranges(int min_x, int min_y,
                                    int max_x, int max_y);
 
+    /**
+     * Like find_ranges above, but only the points inside the bounding
+     * box that are also within the given radius of (x, y) need to be
+     * contained. The distance is calculated as in location search,
+     * with the x distance scaled by x_aspect / 2^32 (0 means no
+     * scaling). Parts of the bounding box that lie entirely outside
+     * the circle do not contribute ranges, which gives a tighter
+     * covering for radius searches than the bounding box alone.
+     **/
+    static RangeVector find_ranges(int min_x, int min_y,
+                                   int max_x, int max_y,
+                                   int32_t x, int32_t y,
+                                   uint32_t x_aspect, uint32_t radius);
+
     static int64_t
     encodeSlow(int32_t x, int32_t y);
 
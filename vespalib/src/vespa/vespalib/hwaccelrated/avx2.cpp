@@ -17,4 +17,16 @@ Avx2Accelrator::dotProduct(const double * af, const double * bf, size_t sz) cons
     return avx::dotProductSelectAlignment<double, 32>(af, bf, sz);
 }
 
+void
+Avx2Accelrator::and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const
+{
+    avx::combine64<32>(avx::And(), offset, src, dest);
+}
+
+void
+Avx2Accelrator::or64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const
+{
+    avx::combine64<32>(avx::Or(), offset, src, dest);
+}
+
 }
@@ -17,4 +17,16 @@ Avx512Accelrator::dotProduct(const double * af, const double * bf, size_t sz) co
     return avx::dotProductSelectAlignment<double, 64>(af, bf, sz);
 }
 
+void
+Avx512Accelrator::and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const
+{
+    avx::combine64<64>(avx::And(), offset, src, dest);
+}
+
+void
+Avx512Accelrator::or64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const
+{
+    avx::combine64<64>(avx::Or(), offset, src, dest);
+}
+
 }
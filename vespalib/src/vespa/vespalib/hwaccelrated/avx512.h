@@ -14,6 +14,8 @@ class Avx512Accelrator : public Avx2Accelrator
 public:
     float dotProduct(const float * a, const float * b, size_t sz) const override;
     double dotProduct(const double * a, const double * b, size_t sz) const override;
+    void and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const override;
+    void or64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const override;
 };
 
 }
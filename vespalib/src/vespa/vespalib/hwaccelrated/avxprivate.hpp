@@ -4,6 +4,7 @@
 
 #include <vespa/fastos/dynamiclibrary.h>
 #include <cstring>
+#include <vector>
 
 namespace vespalib::hwaccelrated::avx {
 
@@ -86,4 +87,45 @@ T dotProductSelectAlignment(const T * af, const T * bf, size_t sz)
     }
 }
 
+struct And {
+    template <typename V>
+    V operator () (const V & a, const V & b) const { return a & b; }
+};
+
+struct Or {
+    template <typename V>
+    V operator () (const V & a, const V & b) const { return a | b; }
+};
+
+template <size_t VLEN, typename Operation>
+VESPA_DLL_LOCAL void combine64(Operation operation, size_t offset,
+                               const std::vector<std::pair<const void *, bool>> &src, void *dest);
+
+template <size_t VLEN, typename Operation>
+void combine64(Operation operation, size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest)
+{
+    constexpr const size_t VectorsPerChunk = 64/VLEN;
+    typedef uint64_t V __attribute__ ((vector_size (VLEN)));
+    typedef uint64_t U __attribute__ ((vector_size (VLEN), aligned(1)));
+    V zero;
+    memset(&zero, 0, sizeof(zero));
+    const V ones = ~zero;
+    V result[VectorsPerChunk];
+    {
+        const U * s = reinterpret_cast<const U *>(static_cast<const char *>(src[0].first) + offset);
+        const V invert = src[0].second ? ones : zero;
+        for (size_t i(0); i < VectorsPerChunk; i++) {
+            result[i] = s[i] ^ invert;
+        }
+    }
+    for (size_t n(1); n < src.size(); n++) {
+        const U * s = reinterpret_cast<const U *>(static_cast<const char *>(src[n].first) + offset);
+        const V invert = src[n].second ? ones : zero;
+        for (size_t i(0); i < VectorsPerChunk; i++) {
+            result[i] = operation(result[i], s[i] ^ invert);
+        }
+    }
+    memcpy(dest, result, sizeof(result));
+}
+
 }
@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "generic.h"
+#include <algorithm>
 
 namespace vespalib::hwaccelrated {
 
@@ -30,6 +31,24 @@ multiplyAdd(const T * a, const T * b, size_t sz)
     return sum;
 }
 
+int64_t
+multiplyAddInt8(const int8_t * a, const int8_t * b, size_t sz)
+{
+    // Each product fits in 15 bits, so a block of 64k products can be summed
+    // in 32 bits. This lets the compiler vectorize the inner loop.
+    constexpr size_t BLOCK = 0x10000;
+    int64_t sum(0);
+    for (size_t start(0); start < sz; start += BLOCK) {
+        size_t end(std::min(sz, start + BLOCK));
+        int32_t partial(0);
+        for (size_t i(start); i < end; i++) {
+            partial += int32_t(a[i]) * int32_t(b[i]);
+        }
+        sum += partial;
+    }
+    return sum;
+}
+
 template<size_t UNROLL, typename Operation>
 void
 bitOperation(Operation operation, void * aOrg, const void * bOrg, size_t bytes) {
@@ -56,6 +75,28 @@ bitOperation(Operation operation, void * aOrg, const void * bOrg, size_t bytes)
     }
 }
 
+template<typename Operation>
+void
+combine64(Operation operation, size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest)
+{
+    constexpr size_t ChunkWords = 64/sizeof(uint64_t);
+    uint64_t *d(static_cast<uint64_t *>(dest));
+    {
+        const uint64_t *s(reinterpret_cast<const uint64_t *>(static_cast<const char *>(src[0].first) + offset));
+        const uint64_t invert(src[0].second ? ~uint64_t(0) : uint64_t(0));
+        for (size_t i(0); i < ChunkWords; i++) {
+            d[i] = s[i] ^ invert;
+        }
+    }
+    for (size_t n(1); n < src.size(); n++) {
+        const uint64_t *s(reinterpret_cast<const uint64_t *>(static_cast<const char *>(src[n].first) + offset));
+        const uint64_t invert(src[n].second ? ~uint64_t(0) : uint64_t(0));
+        for (size_t i(0); i < ChunkWords; i++) {
+            d[i] = operation(d[i], s[i] ^ invert);
+        }
+    }
+}
+
 }
 
 float
@@ -82,6 +123,12 @@ GenericAccelrator::dotProduct(const int64_t * a, const int64_t * b, size_t sz) c
     return multiplyAdd<long long, int64_t, 4>(a, b, sz);
 }
 
+int64_t
+GenericAccelrator::dotProduct(const int8_t * a, const int8_t * b, size_t sz) const
+{
+    return multiplyAddInt8(a, b, sz);
+}
+
 void
 GenericAccelrator::orBit(void * aOrg, const void * bOrg, size_t bytes) const
 {
@@ -113,4 +160,16 @@ GenericAccelrator::notBit(void * aOrg, size_t bytes) const
     }
 }
 
+void
+GenericAccelrator::and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const
+{
+    combine64([](uint64_t a, uint64_t b) { return a & b; }, offset, src, dest);
+}
+
+void
+GenericAccelrator::or64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const
+{
+    combine64([](uint64_t a, uint64_t b) { return a | b; }, offset, src, dest);
+}
+
 }
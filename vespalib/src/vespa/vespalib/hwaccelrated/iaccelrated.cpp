@@ -64,6 +64,61 @@ void verifyAccelrator(const IAccelrated & accel)
     delete [] b;
 }
 
+void verifyInt8Accelrator(const IAccelrated & accel)
+{
+    const size_t testLength(255);
+    int8_t a[testLength];
+    int8_t b[testLength];
+    for (size_t i(0); i < testLength; i++) {
+        a[i] = static_cast<int8_t>(int(i) - 128);
+        b[i] = static_cast<int8_t>(127 - int(i));
+    }
+    for (size_t j(0); j < 0x20; j++) {
+        int64_t sum(0);
+        for (size_t i(j); i < testLength; i++) {
+            sum += int64_t(a[i]) * int64_t(b[i]);
+        }
+        if (sum != accel.dotProduct(&a[j], &b[j], testLength - j)) {
+            fprintf(stderr, "Accelrator is not computing int8 dotproduct correctly.\n");
+            abort();
+        }
+    }
+}
+
+void verifyBitOperations(const IAccelrated & accel)
+{
+    const size_t numWords(64);
+    const size_t numSources(5);
+    uint64_t words[numSources][numWords];
+    std::vector<std::pair<const void *, bool>> src;
+    for (size_t n(0); n < numSources; n++) {
+        for (size_t i(0); i < numWords; i++) {
+            words[n][i] = (0x9e3779b97f4a7c15ul * (n * numWords + i + 1)) >> (n + 1);
+        }
+        src.emplace_back(words[n], (n % 2) == 1);
+    }
+    for (size_t offset(0); offset < numWords * sizeof(uint64_t); offset += 64) {
+        uint64_t andResult[8];
+        uint64_t orResult[8];
+        accel.and64(offset, src, andResult);
+        accel.or64(offset, src, orResult);
+        for (size_t i(0); i < 8; i++) {
+            const size_t word(offset/sizeof(uint64_t) + i);
+            uint64_t expectAnd(~uint64_t(0));
+            uint64_t expectOr(0);
+            for (size_t n(0); n < numSources; n++) {
+                uint64_t value(src[n].second ? ~words[n][word] : words[n][word]);
+                expectAnd &= value;
+                expectOr |= value;
+            }
+            if ((andResult[i] != expectAnd) || (orResult[i] != expectOr)) {
+                fprintf(stderr, "Accelrator is not computing bit operations correctly.\n");
+                abort();
+            }
+        }
+    }
+}
+
 class RuntimeVerificator
 {
 public:
@@ -77,12 +132,16 @@ RuntimeVerificator::RuntimeVerificator()
    verifyAccelrator<double>(generic); 
    verifyAccelrator<int32_t>(generic); 
    verifyAccelrator<int64_t>(generic); 
+   verifyInt8Accelrator(generic);
+   verifyBitOperations(generic);
 
    IAccelrated::UP thisCpu(IAccelrated::getAccelrator());
    verifyAccelrator<float>(*thisCpu); 
    verifyAccelrator<double>(*thisCpu); 
    verifyAccelrator<int32_t>(*thisCpu); 
    verifyAccelrator<int64_t>(*thisCpu); 
+   verifyInt8Accelrator(*thisCpu);
+   verifyBitOperations(*thisCpu);
    
 }
 
@@ -4,6 +4,7 @@
 
 #include <memory>
 #include <cstdint>
+#include <vector>
 
 namespace vespalib::hwaccelrated {
 
@@ -20,10 +21,20 @@ public:
     virtual double dotProduct(const double * a, const double * b, size_t sz) const = 0;
     virtual int64_t dotProduct(const int32_t * a, const int32_t * b, size_t sz) const = 0;
     virtual long long dotProduct(const int64_t * a, const int64_t * b, size_t sz) const = 0;
+    virtual int64_t dotProduct(const int8_t * a, const int8_t * b, size_t sz) const = 0;
     virtual void orBit(void * a, const void * b, size_t bytes) const = 0;
     virtual void andBit(void * a, const void * b, size_t bytes) const = 0;
     virtual void andNotBit(void * a, const void * b, size_t bytes) const = 0;
     virtual void notBit(void * a, size_t bytes) const = 0;
+    /**
+     * Combines one 64 byte chunk, starting at the given byte offset, of
+     * all sources with bitwise and/or and stores the 64 byte result in
+     * dest. The second member of each source tells whether it should be
+     * inverted before it is combined with the others. There must be at
+     * least one source.
+     **/
+    virtual void and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const = 0;
+    virtual void or64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const = 0;
 
     static IAccelrated::UP getAccelrator() __attribute__((noinline));
 };
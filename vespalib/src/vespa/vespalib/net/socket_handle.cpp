@@ -29,6 +29,17 @@ SocketHandle::write(const char *buf, size_t len)
     }
 }
 
+ssize_t
+SocketHandle::writev(const struct iovec *iov, int iovcnt)
+{
+    for (;;) {
+        ssize_t result = ::writev(_fd, iov, iovcnt);
+        if ((result >= 0) || (errno != EINTR)) {
+            return result;
+        }
+    }
+}
+
 SocketHandle
 SocketHandle::accept()
 {
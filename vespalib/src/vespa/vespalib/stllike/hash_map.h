@@ -1,7 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
-#include "hashtable.h"
+#include "swisstable.h"
 #include "hash_fun.h"
 
 namespace vespalib {
@@ -13,7 +13,7 @@ public:
     typedef std::pair<K, V> value_type;
     typedef K key_type;
     typedef V mapped_type;
-    using HashTable = hashtable< K, value_type, H, EQ, std::_Select1st< value_type >, M >;
+    using HashTable = typename hashtable_select< K, value_type, H, EQ, std::_Select1st< value_type >, M >::type;
 private:
     HashTable _ht;
 public:
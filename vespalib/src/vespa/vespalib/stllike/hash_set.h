@@ -1,7 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
-#include "hashtable.h"
+#include "swisstable.h"
 #include "hash_fun.h"
 #include <initializer_list>
 
@@ -11,7 +11,7 @@ template< typename K, typename H = vespalib::hash<K>, typename EQ = std::equal_t
 class hash_set
 {
 private:
-    using HashTable = hashtable< K, K, H, EQ, std::_Identity<K>, M>;
+    using HashTable = typename hashtable_select< K, K, H, EQ, std::_Identity<K>, M>::type;
     HashTable _ht;
 public:
     typedef typename HashTable::iterator iterator;
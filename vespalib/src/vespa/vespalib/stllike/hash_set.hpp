@@ -86,3 +86,6 @@ hash_set<K, H, EQ, M>::insert(const K & value) {
     template class vespalib::hashtable<K, K, H, std::equal_to<K>, std::_Identity<K>>; \
     template class vespalib::Array<vespalib::hash_node<K>>;
 
+#define VESPALIB_SWISS_HASH_SET_INSTANTIATE_H(K, H) \
+    template class vespalib::hash_set<K, H, std::equal_to<K>, vespalib::swiss_probing>;
+
@@ -0,0 +1,486 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "hashtable.h"
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <utility>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace vespalib {
+
+/**
+ * Policy selecting swisstable as the implementation of hash_map and
+ * hash_set, given in place of the modulator:
+ *
+ *   hash_map<K, V, vespalib::hash<K>, std::equal_to<K>, swiss_probing>
+ **/
+struct swiss_probing {};
+
+/**
+   Open addressing hashtable with the same interface as hashtable.
+
+   All values are stored directly in a single power of 2 sized slot
+   array, with one control byte per slot kept in a separate array. A
+   control byte tells if the slot is empty, erased, or full; full
+   slots store 7 bits of the hash value. Lookups probe groups of 16
+   control bytes at a time (using SSE2 when available) and only
+   compare keys for slots with matching hash bits. Compared to
+   hashtable this avoids the modulo operation and the chain
+   traversal, and a lookup typically touches one cache line of
+   control bytes and one slot.
+
+   The table grows when it is 7/8 full. Erased slots are reused by
+   later inserts, or reclaimed when the table is rehashed. As with
+   hashtable, insert might invalidate iterators.
+
+   Note that the hash function is expected to be of varying quality
+   (vespalib::hash of an integer is the integer itself), so the hash
+   values are mixed before use.
+**/
+class swisstable_base
+{
+public:
+    typedef int8_t ctrl_t;
+    static constexpr ctrl_t EMPTY = -128;
+    static constexpr ctrl_t DELETED = -2;
+    static constexpr size_t GROUP_WIDTH = 16;
+
+    /**
+     * A group of control bytes, matched in parallel.
+     **/
+    class Group {
+    public:
+        explicit Group(const ctrl_t *pos) {
+#ifdef __SSE2__
+            _ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos));
+#else
+            memcpy(_ctrl, pos, GROUP_WIDTH);
+#endif
+        }
+        /// Bit mask of the slots having the given control byte.
+        uint32_t match(ctrl_t value) const {
+#ifdef __SSE2__
+            return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(value), _ctrl));
+#else
+            uint32_t mask = 0;
+            for (size_t i = 0; i < GROUP_WIDTH; ++i) {
+                mask |= uint32_t(_ctrl[i] == value) << i;
+            }
+            return mask;
+#endif
+        }
+        uint32_t matchEmpty() const { return match(EMPTY); }
+        /// Bit mask of the slots not holding a value.
+        uint32_t matchEmptyOrDeleted() const {
+#ifdef __SSE2__
+            return _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), _ctrl));
+#else
+            uint32_t mask = 0;
+            for (size_t i = 0; i < GROUP_WIDTH; ++i) {
+                mask |= uint32_t(_ctrl[i] < -1) << i;
+            }
+            return mask;
+#endif
+        }
+    private:
+#ifdef __SSE2__
+        __m128i _ctrl;
+#else
+        ctrl_t  _ctrl[GROUP_WIDTH];
+#endif
+    };
+
+    static bool isFull(ctrl_t ctrl) { return ctrl >= 0; }
+    static uint32_t lowestBit(uint32_t mask) { return __builtin_ctz(mask); }
+    static uint32_t leadingZeros(uint32_t mask) { return __builtin_clz(mask) - (32 - GROUP_WIDTH); }
+
+    static size_t mix(size_t hash) {
+        uint64_t h = uint64_t(hash) * 0x9e3779b97f4a7c15ul;
+        return h ^ (h >> 29);
+    }
+    static size_t h1(size_t mixed) { return mixed >> 7; }
+    static ctrl_t h2(size_t mixed) { return mixed & 0x7f; }
+
+    /// Number of slots needed to hold the given number of values.
+    static size_t capacityFor(size_t numValues) {
+        size_t capacity = GROUP_WIDTH;
+        while ((capacity - capacity / 8) < numValues) {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+    static size_t maxValues(size_t capacity) { return capacity - capacity / 8; }
+
+    /// Control bytes of a table without slots, making lookups fail in the first group.
+    static ctrl_t *emptyGroup() {
+        alignas(16) static const ctrl_t empty[GROUP_WIDTH] = {
+            EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY,
+            EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY
+        };
+        return const_cast<ctrl_t *>(empty);
+    }
+};
+
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract >
+class swisstable : public swisstable_base
+{
+public:
+    class const_iterator;
+    class iterator {
+    public:
+        typedef std::ptrdiff_t difference_type;
+        typedef Value value_type;
+        typedef Value& reference;
+        typedef Value* pointer;
+        typedef std::forward_iterator_tag iterator_category;
+
+        iterator(swisstable * table, size_t slot) : _slot(slot), _table(table) { }
+        Value & operator * ()  const { return _table->_slots[_slot]; }
+        Value * operator -> () const { return & _table->_slots[_slot]; }
+        iterator & operator ++ () {
+            _slot = _table->nextFull(_slot + 1);
+            return *this;
+        }
+        iterator operator ++ (int) {
+            iterator prev = *this;
+            ++(*this);
+            return prev;
+        }
+        bool operator==(const iterator& rhs) const { return (_slot == rhs._slot); }
+        bool operator!=(const iterator& rhs) const { return (_slot != rhs._slot); }
+    private:
+        size_t       _slot;
+        swisstable * _table;
+
+        friend class swisstable::const_iterator;
+    };
+    class const_iterator {
+    public:
+        typedef std::ptrdiff_t difference_type;
+        typedef const Value value_type;
+        typedef const Value& reference;
+        typedef const Value* pointer;
+        typedef std::forward_iterator_tag iterator_category;
+
+        const_iterator(const swisstable * table, size_t slot) : _slot(slot), _table(table) { }
+        const_iterator(const iterator &i) : _slot(i._slot), _table(i._table) { }
+        const Value & operator * ()  const { return _table->_slots[_slot]; }
+        const Value * operator -> () const { return & _table->_slots[_slot]; }
+        const_iterator & operator ++ () {
+            _slot = _table->nextFull(_slot + 1);
+            return *this;
+        }
+        const_iterator operator ++ (int) {
+            const_iterator prev = *this;
+            ++(*this);
+            return prev;
+        }
+        bool operator==(const const_iterator& rhs) const { return (_slot == rhs._slot); }
+        bool operator!=(const const_iterator& rhs) const { return (_slot != rhs._slot); }
+    private:
+        size_t             _slot;
+        const swisstable * _table;
+    };
+    typedef std::pair<iterator, bool> insert_result;
+
+    swisstable(size_t reservedSpace = 0)
+        : _ctrl(emptyGroup()), _slots(nullptr), _capacity(0), _count(0), _growthLeft(0),
+          _hasher(), _equal(), _keyExtractor()
+    {
+        reserve(reservedSpace);
+    }
+    swisstable(size_t reservedSpace, const Hash & hasher, const Equal & equal)
+        : _ctrl(emptyGroup()), _slots(nullptr), _capacity(0), _count(0), _growthLeft(0),
+          _hasher(hasher), _equal(equal), _keyExtractor()
+    {
+        reserve(reservedSpace);
+    }
+    swisstable(const swisstable & rhs)
+        : _ctrl(emptyGroup()), _slots(nullptr), _capacity(0), _count(0), _growthLeft(0),
+          _hasher(rhs._hasher), _equal(rhs._equal), _keyExtractor(rhs._keyExtractor)
+    {
+        if (rhs._capacity > 0) {
+            allocate(rhs._capacity);
+            memcpy(_ctrl, rhs._ctrl, _capacity + GROUP_WIDTH);
+            for (size_t i = 0; i < _capacity; ++i) {
+                if (isFull(_ctrl[i])) {
+                    new (&_slots[i]) Value(rhs._slots[i]);
+                }
+            }
+            _count = rhs._count;
+            _growthLeft = rhs._growthLeft;
+        }
+    }
+    swisstable(swisstable && rhs)
+        : _ctrl(emptyGroup()), _slots(nullptr), _capacity(0), _count(0), _growthLeft(0),
+          _hasher(rhs._hasher), _equal(rhs._equal), _keyExtractor(rhs._keyExtractor)
+    {
+        swap(rhs);
+    }
+    swisstable & operator = (const swisstable & rhs) {
+        swisstable(rhs).swap(*this);
+        return *this;
+    }
+    swisstable & operator = (swisstable && rhs) {
+        swap(rhs);
+        return *this;
+    }
+    ~swisstable() { release(); }
+
+    iterator begin()             { return iterator(this, nextFull(0)); }
+    iterator end()               { return iterator(this, _capacity); }
+    const_iterator begin() const { return const_iterator(this, nextFull(0)); }
+    const_iterator end()   const { return const_iterator(this, _capacity); }
+    size_t capacity()      const { return _capacity; }
+    size_t size()          const { return _count; }
+    bool empty()           const { return _count == 0; }
+
+    template< typename AltKey, typename AltExtract, typename AltHash, typename AltEqual >
+    iterator find(const AltKey & key, const AltExtract & altExtract) {
+        return iterator(this, findSlot(key, AltHash()(key), AltEqual(), altExtract));
+    }
+    template< typename AltKey, typename AltExtract, typename AltHash, typename AltEqual >
+    iterator find(const AltKey & key) { return find<AltKey, AltExtract, AltHash, AltEqual>(key, AltExtract()); }
+    iterator find(const Key & key) {
+        return iterator(this, findSlot(key, _hasher(key), _equal, Identity()));
+    }
+    template< typename AltKey, typename AltExtract, typename AltHash, typename AltEqual >
+    const_iterator find(const AltKey & key, const AltExtract & altExtract) const {
+        return const_iterator(this, findSlot(key, AltHash()(key), AltEqual(), altExtract));
+    }
+    template< typename AltKey, typename AltExtract, typename AltHash, typename AltEqual >
+    const_iterator find(const AltKey & key) const { return find<AltKey, AltExtract, AltHash, AltEqual>(key, AltExtract()); }
+    const_iterator find(const Key & key) const {
+        return const_iterator(this, findSlot(key, _hasher(key), _equal, Identity()));
+    }
+
+    template <typename V>
+    insert_result insert(V && value) {
+        size_t mixed = mix(_hasher(_keyExtractor(value)));
+        size_t found = probe(_keyExtractor(value), mixed, _equal, Identity());
+        if (found != _capacity) {
+            return insert_result(iterator(this, found), false);
+        }
+        size_t slot = findInsertSlot(mixed);
+        if ((_growthLeft == 0) && (_ctrl[slot] != DELETED)) {
+            grow();
+            slot = findInsertSlot(mixed);
+        }
+        _growthLeft -= (_ctrl[slot] == EMPTY) ? 1 : 0;
+        new (&_slots[slot]) Value(std::forward<V>(value));
+        setCtrl(slot, h2(mixed));
+        ++_count;
+        return insert_result(iterator(this, slot), true);
+    }
+    void erase(const Key & key) {
+        size_t slot = findSlot(key, _hasher(key), _equal, Identity());
+        if (slot != _capacity) {
+            eraseSlot(slot);
+        }
+    }
+    void reserve(size_t sz) {
+        if (sz > maxValues(_capacity)) {
+            rehash(capacityFor(sz));
+        }
+    }
+    void clear() {
+        destroyValues();
+        if (_capacity > 0) {
+            memset(_ctrl, EMPTY, _capacity + GROUP_WIDTH);
+        }
+        _count = 0;
+        _growthLeft = maxValues(_capacity);
+    }
+    /// Makes room for at least newSize values without growing.
+    void resize(size_t newSize) { reserve(newSize); }
+    void swap(swisstable & rhs) {
+        std::swap(_ctrl, rhs._ctrl);
+        std::swap(_slots, rhs._slots);
+        std::swap(_capacity, rhs._capacity);
+        std::swap(_count, rhs._count);
+        std::swap(_growthLeft, rhs._growthLeft);
+        std::swap(_hasher, rhs._hasher);
+        std::swap(_equal, rhs._equal);
+        std::swap(_keyExtractor, rhs._keyExtractor);
+    }
+
+    /**
+     * Get an approximate number of the memory allocated (in bytes) by this hash table.
+     * Not including any data K would store outside of sizeof(K) of course.
+     */
+    size_t getMemoryConsumption() const {
+        return sizeof(swisstable) + ((_capacity > 0) ? (_capacity * (sizeof(Value) + 1) + GROUP_WIDTH) : 0);
+    }
+
+    /**
+     * Get an approximate number of memory used (in bytes) by this hash table.
+     * Note that getMemoryConsumption() >= getMemoryUsed().
+     */
+    size_t getMemoryUsed() const {
+        return sizeof(swisstable) + ((_capacity > 0) ? (_count * sizeof(Value) + _capacity + GROUP_WIDTH) : 0);
+    }
+
+private:
+    struct Identity {
+        const Key & operator()(const Key & key) const { return key; }
+    };
+
+    ctrl_t     *_ctrl;       // _capacity + GROUP_WIDTH bytes, the first group is cloned at the end
+    Value      *_slots;
+    size_t      _capacity;   // 0 or power of 2 >= GROUP_WIDTH
+    size_t      _count;
+    size_t      _growthLeft; // empty slots that can be filled before growing
+    Hash        _hasher;
+    Equal       _equal;
+    KeyExtract  _keyExtractor;
+
+    size_t mask() const { return _capacity - 1; }
+
+    size_t nextFull(size_t slot) const {
+        while ((slot < _capacity) && !isFull(_ctrl[slot])) {
+            ++slot;
+        }
+        return slot;
+    }
+
+    void setCtrl(size_t slot, ctrl_t value) {
+        _ctrl[slot] = value;
+        if (slot < GROUP_WIDTH) {
+            _ctrl[_capacity + slot] = value;
+        }
+    }
+
+    template <typename AltKey, typename AltEqual, typename AltExtract>
+    size_t probe(const AltKey & key, size_t mixed, AltEqual equal, const AltExtract & altExtract) const {
+        if (_capacity == 0) {
+            return _capacity;
+        }
+        ctrl_t h = h2(mixed);
+        size_t pos = h1(mixed) & mask();
+        for (size_t step = GROUP_WIDTH; ; step += GROUP_WIDTH) {
+            Group group(_ctrl + pos);
+            for (uint32_t m = group.match(h); m != 0; m &= (m - 1)) {
+                size_t slot = (pos + lowestBit(m)) & mask();
+                if (equal(altExtract(_keyExtractor(_slots[slot])), key)) {
+                    return slot;
+                }
+            }
+            if ((group.matchEmpty() != 0) || (step > _capacity)) {
+                return _capacity;
+            }
+            pos = (pos + step) & mask();
+        }
+    }
+
+    template <typename AltKey, typename AltEqual, typename AltExtract>
+    size_t findSlot(const AltKey & key, size_t hash, AltEqual equal, const AltExtract & altExtract) const {
+        return probe(key, mix(hash), equal, altExtract);
+    }
+
+    size_t findInsertSlot(size_t mixed) const {
+        if (_capacity == 0) {
+            return 0;
+        }
+        size_t pos = h1(mixed) & mask();
+        for (size_t step = GROUP_WIDTH; ; step += GROUP_WIDTH) {
+            uint32_t m = Group(_ctrl + pos).matchEmptyOrDeleted();
+            if (m != 0) {
+                return (pos + lowestBit(m)) & mask();
+            }
+            pos = (pos + step) & mask();
+        }
+    }
+
+    void eraseSlot(size_t slot) {
+        _slots[slot].~Value();
+        --_count;
+        // The slot can be marked empty (ending probes) only if no probe
+        // can have passed it, i.e. if no full window of GROUP_WIDTH
+        // slots around it was ever without empty slots.
+        size_t before = (slot - GROUP_WIDTH) & mask();
+        uint32_t emptyAfter = Group(_ctrl + slot).matchEmpty();
+        uint32_t emptyBefore = Group(_ctrl + before).matchEmpty();
+        bool wasNeverFull = (emptyBefore != 0) && (emptyAfter != 0) &&
+                            ((lowestBit(emptyAfter) + leadingZeros(emptyBefore)) < GROUP_WIDTH);
+        setCtrl(slot, wasNeverFull ? EMPTY : DELETED);
+        _growthLeft += wasNeverFull ? 1 : 0;
+    }
+
+    void grow() {
+        // Reclaim erased slots in place when they make up a large part of the table.
+        if ((_capacity > 0) && (_count * 16 <= _capacity * 7)) {
+            rehash(_capacity);
+        } else {
+            rehash(std::max(_capacity * 2, GROUP_WIDTH));
+        }
+    }
+
+    void allocate(size_t capacity) {
+        _ctrl = new ctrl_t[capacity + GROUP_WIDTH];
+        memset(_ctrl, EMPTY, capacity + GROUP_WIDTH);
+        _slots = static_cast<Value *>(::operator new(capacity * sizeof(Value)));
+        _capacity = capacity;
+        _count = 0;
+        _growthLeft = maxValues(capacity);
+    }
+
+    void destroyValues() {
+        for (size_t i = 0; i < _capacity; ++i) {
+            if (isFull(_ctrl[i])) {
+                _slots[i].~Value();
+            }
+        }
+    }
+
+    void release() {
+        destroyValues();
+        if (_capacity > 0) {
+            delete [] _ctrl;
+            ::operator delete(_slots);
+        }
+        _ctrl = emptyGroup();
+        _slots = nullptr;
+        _capacity = 0;
+    }
+
+    void rehash(size_t capacity) {
+        ctrl_t *oldCtrl = _ctrl;
+        Value *oldSlots = _slots;
+        size_t oldCapacity = _capacity;
+        allocate(capacity);
+        for (size_t i = 0; i < oldCapacity; ++i) {
+            if (isFull(oldCtrl[i])) {
+                size_t mixed = mix(_hasher(_keyExtractor(oldSlots[i])));
+                size_t slot = findInsertSlot(mixed);
+                new (&_slots[slot]) Value(std::move(oldSlots[i]));
+                oldSlots[i].~Value();
+                setCtrl(slot, h2(mixed));
+                ++_count;
+                --_growthLeft;
+            }
+        }
+        if (oldCapacity > 0) {
+            delete [] oldCtrl;
+            ::operator delete(oldSlots);
+        }
+    }
+};
+
+/**
+ * Selects the table implementation of hash_map and hash_set.
+ **/
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract, typename Modulator >
+struct hashtable_select {
+    using type = hashtable<Key, Value, Hash, Equal, KeyExtract, Modulator>;
+};
+
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract >
+struct hashtable_select<Key, Value, Hash, Equal, KeyExtract, swiss_probing> {
+    using type = swisstable<Key, Value, Hash, Equal, KeyExtract>;
+};
+
+}
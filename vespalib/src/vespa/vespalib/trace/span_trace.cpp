@@ -0,0 +1,82 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "span_trace.h"
+#include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/data/simple_buffer.h>
+#include <algorithm>
+
+using namespace vespalib::slime;
+
+namespace vespalib {
+
+namespace {
+
+double
+toMs(SpanTrace::clock::duration duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+}
+
+SpanTrace::SpanTrace(clock::time_point origin)
+    : _origin(origin),
+      _lock(),
+      _spans()
+{
+}
+
+SpanTrace::~SpanTrace() {}
+
+void
+SpanTrace::addSpan(const vespalib::stringref &name, uint32_t thread,
+                   clock::time_point start, clock::time_point end)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _spans.emplace_back(name, thread, start, end);
+}
+
+size_t
+SpanTrace::size() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _spans.size();
+}
+
+std::vector<SpanTrace::Span>
+SpanTrace::getSpans() const
+{
+    std::vector<Span> spans;
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        spans = _spans;
+    }
+    std::stable_sort(spans.begin(), spans.end(),
+                     [](const Span &a, const Span &b) { return a.start < b.start; });
+    return spans;
+}
+
+void
+SpanTrace::toSlime(Cursor &object) const
+{
+    Cursor &array = object.setArray("spans");
+    for (const Span &span : getSpans()) {
+        Cursor &entry = array.addObject();
+        entry.setString("name", span.name);
+        entry.setLong("thread", span.thread);
+        entry.setDouble("start_ms", toMs(span.start - _origin));
+        entry.setDouble("duration_ms", toMs(span.end - span.start));
+    }
+}
+
+vespalib::string
+SpanTrace::encode() const
+{
+    Slime slime;
+    toSlime(slime.setObject());
+    SimpleBuffer buf;
+    BinaryFormat::encode(slime, buf);
+    return buf.get().make_string();
+}
+
+} // namespace vespalib
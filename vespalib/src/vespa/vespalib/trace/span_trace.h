@@ -0,0 +1,88 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+namespace vespalib {
+
+namespace slime { class Cursor; }
+
+/**
+ * Records named spans with monotonic start and end timestamps for a
+ * single request. Spans may be added concurrently from several threads
+ * (e.g. one per match thread); each span is tagged with the id of the
+ * thread that produced it. Timestamps are reported relative to the
+ * origin of the trace, which is normally the time the request was
+ * received by the transport layer.
+ **/
+class SpanTrace
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    struct Span {
+        vespalib::string  name;
+        uint32_t          thread;
+        clock::time_point start;
+        clock::time_point end;
+        Span(const vespalib::stringref &name_in, uint32_t thread_in,
+             clock::time_point start_in, clock::time_point end_in)
+            : name(name_in), thread(thread_in), start(start_in), end(end_in) {}
+    };
+
+    /**
+     * Records a span from construction until destruction.
+     **/
+    class Scope
+    {
+        SpanTrace        *_trace;
+        vespalib::string  _name;
+        uint32_t          _thread;
+        clock::time_point _start;
+    public:
+        Scope(SpanTrace *trace, const vespalib::stringref &name, uint32_t thread = 0)
+            : _trace(trace), _name(), _thread(thread), _start()
+        {
+            if (_trace != nullptr) {
+                _name = name;
+                _start = clock::now();
+            }
+        }
+        Scope(const Scope &) = delete;
+        Scope & operator = (const Scope &) = delete;
+        ~Scope() {
+            if (_trace != nullptr) {
+                _trace->addSpan(_name, _thread, _start, clock::now());
+            }
+        }
+    };
+
+private:
+    clock::time_point  _origin;
+    mutable std::mutex _lock;
+    std::vector<Span>  _spans;
+
+public:
+    SpanTrace(clock::time_point origin);
+    ~SpanTrace();
+
+    clock::time_point getOrigin() const { return _origin; }
+    void addSpan(const vespalib::stringref &name, uint32_t thread,
+                 clock::time_point start, clock::time_point end);
+    size_t size() const;
+    /** Spans recorded so far, ordered by start time. **/
+    std::vector<Span> getSpans() const;
+
+    /**
+     * Serialize as { spans: [ { name, thread, start_ms, duration_ms } ] }
+     * with start_ms relative to the origin.
+     **/
+    void toSlime(slime::Cursor &object) const;
+    /** Encode the trace as binary slime. **/
+    vespalib::string encode() const;
+};
+
+} // namespace vespalib
@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include "alloc.h"
 #include <sys/mman.h>
+#include <sys/syscall.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/backtrace.h>
@@ -8,7 +9,10 @@
 #include <map>
 #include <atomic>
 #include <unordered_map>
+#include <algorithm>
+#include <vector>
 #include <vespa/fastos/file.h>
+#include <fcntl.h>
 #include <unistd.h>
 
 #include <vespa/log/log.h>
@@ -24,6 +28,10 @@ int  _G_HugeFlags = 0;
 const size_t _G_pageSize = getpagesize();
 size_t _G_MMapLogLimit = std::numeric_limits<size_t>::max();
 size_t _G_MMapNoCoreLimit = std::numeric_limits<size_t>::max();
+size_t _G_MMapInterleaveLimit = std::numeric_limits<size_t>::max();
+std::string _G_PagedDirectory("/tmp");
+// From linux/mempolicy.h, to avoid depending on libnuma for a single call.
+constexpr int MPOL_INTERLEAVE_MODE = 3;
 Lock _G_lock;
 std::atomic<size_t> _G_mmapCount(0);
 
@@ -70,6 +78,14 @@ void initializeEnvironment()
     _G_SilenceCoreOnOOM = (getenv("VESPA_SILENCE_CORE_ON_OOM") != nullptr) ? true : false;
     _G_MMapLogLimit = readOptionalEnvironmentVar("VESPA_MMAP_LOG_LIMIT", std::numeric_limits<size_t>::max());
     _G_MMapNoCoreLimit = readOptionalEnvironmentVar("VESPA_MMAP_NOCORE_LIMIT", std::numeric_limits<size_t>::max());
+    _G_MMapInterleaveLimit = readOptionalEnvironmentVar("VESPA_MMAP_INTERLEAVE_LIMIT", std::numeric_limits<size_t>::max());
+    const char * pagedDir = getenv("VESPA_PAGED_ALLOC_DIR");
+    if (pagedDir == nullptr) {
+        pagedDir = getenv("TMPDIR");
+    }
+    if ((pagedDir != nullptr) && (pagedDir[0] != '\0')) {
+        _G_PagedDirectory = pagedDir;
+    }
 }
 
 class Initialize {
@@ -88,6 +104,43 @@ size_t sum(const MMapStore & s)
     return sum;
 }
 
+void throwMMapFailure(size_t sz) __attribute__((noinline, noreturn));
+
+void throwMMapFailure(size_t sz) {
+    string stackTrace = getStackTrace(2);
+    string msg = make_string("Failed mmaping anonymous of size %ld errno(%d) from %s", sz, errno, stackTrace.c_str());
+    if (_G_SilenceCoreOnOOM) {
+        OOMException oom(msg);
+        oom.setPayload(std::make_unique<SilenceUncaughtException>(oom));
+        throw oom;
+    } else {
+        throw OOMException(msg);
+    }
+}
+
+/**
+ * Applies the no core, interleave and logging limits to a fresh anonymous mapping.
+ */
+void adviseAndTrack(void * buf, size_t sz, size_t mmapId, const string & stackTrace) {
+    if (sz >= _G_MMapNoCoreLimit) {
+        if (madvise(buf, sz, MADV_DONTDUMP) != 0) {
+            LOG(warning, "Failed madvise(%p, %ld, MADV_DONTDUMP) = '%s'", buf, sz, FastOS_FileInterface::getLastErrorString().c_str());
+        }
+    }
+    if (sz >= _G_MMapInterleaveLimit) {
+        // Spread the pages over all allowed NUMA nodes instead of the node of the first toucher.
+        unsigned long allNodes(~0ul);
+        if (syscall(SYS_mbind, buf, sz, MPOL_INTERLEAVE_MODE, &allNodes, sizeof(allNodes)*8, 0) != 0) {
+            LOG(warning, "Failed mbind(%p, %ld, MPOL_INTERLEAVE) = '%s'", buf, sz, FastOS_FileInterface::getLastErrorString().c_str());
+        }
+    }
+    if (sz >= _G_MMapLogLimit) {
+        LockGuard guard(_G_lock);
+        _G_HugeMappings[buf] = MMapInfo(mmapId, sz, stackTrace);
+        LOG(info, "%ld mappings of accumulated size %ld", _G_HugeMappings.size(), sum(_G_HugeMappings));
+    }
+}
+
 class MMapLimitAndAlignment {
 public:
     MMapLimitAndAlignment(size_t mmapLimit, size_t alignment);
@@ -145,6 +198,7 @@ public:
     size_t resize_inplace(PtrAndSize current, size_t newSize) const override;
     static size_t sresize_inplace(PtrAndSize current, size_t newSize);
     static PtrAndSize salloc(size_t sz, void * wantedAddress);
+    static PtrAndSize smapFile(int fd, size_t offset, size_t sz);
     static void sfree(PtrAndSize alloc);
     static MemoryAllocator & getDefault();
 private:
@@ -152,6 +206,27 @@ private:
     static size_t shrink_inplace(PtrAndSize current, size_t newSize);
 };
 
+class HugePageMMapAllocator : public MemoryAllocator {
+public:
+    PtrAndSize alloc(size_t sz) const override;
+    void free(PtrAndSize alloc) const override;
+    size_t resize_inplace(PtrAndSize current, size_t newSize) const override;
+    bool usesHugePages() const override { return true; }
+    static PtrAndSize salloc(size_t sz);
+    static MemoryAllocator & getDefault();
+};
+
+class PagedMMapAllocator : public MemoryAllocator {
+public:
+    PtrAndSize alloc(size_t sz) const override;
+    void free(PtrAndSize alloc) const override;
+    size_t resize_inplace(PtrAndSize current, size_t newSize) const override;
+    bool isPaged() const override { return true; }
+    static MemoryAllocator & getDefault();
+private:
+    static int createBackingFile(size_t sz);
+};
+
 class AutoAllocator : public MemoryAllocator {
 public:
     AutoAllocator(size_t mmapLimit, size_t alignment) : _mmapLimit(mmapLimit), _alignment(alignment) { }
@@ -213,6 +288,21 @@ alloc::AlignedHeapAllocator _G_4KalignedHeapAllocator(1024);
 alloc::AlignedHeapAllocator _G_1KalignedHeapAllocator(4096);
 alloc::AlignedHeapAllocator _G_512BalignedHeapAllocator(512);
 alloc::MMapAllocator _G_mmapAllocatorDefault;
+alloc::HugePageMMapAllocator _G_hugePageMMapAllocatorDefault;
+alloc::PagedMMapAllocator _G_pagedMMapAllocatorDefault;
+
+void
+adviseHugePages(void * buf, size_t sz)
+{
+#ifdef MADV_HUGEPAGE
+    if (madvise(buf, sz, MADV_HUGEPAGE) != 0) {
+        LOG(debug, "Failed madvise(%p, %ld, MADV_HUGEPAGE) = '%s'", buf, sz, FastOS_FileInterface::getLastErrorString().c_str());
+    }
+#else
+    (void) buf;
+    (void) sz;
+#endif
+}
 
 }
 
@@ -236,6 +326,14 @@ MemoryAllocator & MMapAllocator::getDefault() {
     return _G_mmapAllocatorDefault;
 }
 
+MemoryAllocator & HugePageMMapAllocator::getDefault() {
+    return _G_hugePageMMapAllocatorDefault;
+}
+
+MemoryAllocator & PagedMMapAllocator::getDefault() {
+    return _G_pagedMMapAllocatorDefault;
+}
+
 MemoryAllocator & AutoAllocator::getDefault() {
     return getAllocator(1 * MemoryAllocator::HUGEPAGE_SIZE, 0);
 }
@@ -312,32 +410,166 @@ MMapAllocator::salloc(size_t sz, void * wantedAddress)
             }
             buf = mmap(wantedAddress, sz, prot, flags, -1, 0);
             if (buf == MAP_FAILED) {
-                stackTrace = getStackTrace(1);
-                string msg = make_string("Failed mmaping anonymous of size %ld errno(%d) from %s", sz, errno, stackTrace.c_str());
-                if (_G_SilenceCoreOnOOM) {
-                    OOMException oom(msg);
-                    oom.setPayload(std::make_unique<SilenceUncaughtException>(oom));
-                    throw oom;
-                } else {
-                    throw OOMException(msg);
-                }
+                throwMMapFailure(sz);
             }
         } else {
             if (_G_hasHugePageFailureJustHappened) {
                 _G_hasHugePageFailureJustHappened = false;
             }
         }
-        if (sz >= _G_MMapNoCoreLimit) {
-            if (madvise(buf, sz, MADV_DONTDUMP) != 0) {
-                LOG(warning, "Failed madvise(%p, %ld, MADV_DONTDUMP) = '%s'", buf, sz, FastOS_FileInterface::getLastErrorString().c_str());
-            }
+        adviseAndTrack(buf, sz, mmapId, stackTrace);
+    }
+    return PtrAndSize(buf, sz);
+}
+
+MemoryAllocator::PtrAndSize
+HugePageMMapAllocator::alloc(size_t sz) const {
+    return salloc(sz);
+}
+
+MemoryAllocator::PtrAndSize
+HugePageMMapAllocator::salloc(size_t sz)
+{
+    if (sz == 0) {
+        return PtrAndSize(nullptr, 0);
+    }
+    sz = roundUpToHugePages(sz);
+    size_t mmapId = std::atomic_fetch_add(&_G_mmapCount, 1ul);
+    string stackTrace;
+    if (sz >= _G_MMapLogLimit) {
+        stackTrace = getStackTrace(1);
+        LOG(info, "mmap %ld of size %ld (huge pages) from %s", mmapId, sz, stackTrace.c_str());
+    }
+    // Map an extra huge page and trim both ends to get a huge page aligned start.
+    size_t mappedSz = sz + HUGEPAGE_SIZE;
+    char * mapped = static_cast<char *>(mmap(nullptr, mappedSz, PROT_READ | PROT_WRITE, MAP_ANON | MAP_PRIVATE, -1, 0));
+    if (mapped == MAP_FAILED) {
+        throwMMapFailure(sz);
+    }
+    char * buf = reinterpret_cast<char *>((reinterpret_cast<uintptr_t>(mapped) + (HUGEPAGE_SIZE - 1)) & ~uintptr_t(HUGEPAGE_SIZE - 1));
+    size_t head = buf - mapped;
+    size_t tail = mappedSz - head - sz;
+    if (head > 0) {
+        munmap(mapped, head);
+    }
+    if (tail > 0) {
+        munmap(buf + sz, tail);
+    }
+    adviseHugePages(buf, sz);
+    adviseAndTrack(buf, sz, mmapId, stackTrace);
+    return PtrAndSize(buf, sz);
+}
+
+void HugePageMMapAllocator::free(PtrAndSize alloc) const {
+    MMapAllocator::sfree(alloc);
+}
+
+size_t
+HugePageMMapAllocator::resize_inplace(PtrAndSize current, size_t newSize) const {
+    size_t resized = MMapAllocator::sresize_inplace(current, roundUpToHugePages(newSize));
+    if (resized > current.second) {
+        adviseHugePages(static_cast<char *>(current.first) + current.second, resized - current.second);
+    }
+    return resized;
+}
+
+int
+PagedMMapAllocator::createBackingFile(size_t sz)
+{
+    int fd = -1;
+#ifdef O_TMPFILE
+    fd = open(_G_PagedDirectory.c_str(), O_TMPFILE | O_RDWR | O_CLOEXEC, 0600);
+#endif
+    if (fd < 0) {
+        std::string pattern = _G_PagedDirectory + "/vespa-paged-XXXXXX";
+        fd = mkstemp(&pattern[0]);
+        if (fd >= 0) {
+            unlink(pattern.c_str());
         }
-        if (sz >= _G_MMapLogLimit) {
-            LockGuard guard(_G_lock);
-            _G_HugeMappings[buf] = MMapInfo(mmapId, sz, stackTrace);
-            LOG(info, "%ld mappings of accumulated size %ld", _G_HugeMappings.size(), sum(_G_HugeMappings));
+    }
+    if ((fd >= 0) && (ftruncate(fd, sz) != 0)) {
+        close(fd);
+        fd = -1;
+    }
+    return fd;
+}
+
+MemoryAllocator::PtrAndSize
+PagedMMapAllocator::alloc(size_t sz) const
+{
+    sz = roundUp2PageSize(sz);
+    if (sz == 0) {
+        return PtrAndSize(nullptr, 0);
+    }
+    int fd = createBackingFile(sz);
+    if (fd < 0) {
+        LOG(warning, "Failed creating backing file of size %ld in '%s': '%s'. Using anonymous memory instead.",
+            sz, _G_PagedDirectory.c_str(), FastOS_FileInterface::getLastErrorString().c_str());
+        return MMapAllocator::salloc(sz, nullptr);
+    }
+    size_t mmapId = std::atomic_fetch_add(&_G_mmapCount, 1ul);
+    string stackTrace;
+    if (sz >= _G_MMapLogLimit) {
+        stackTrace = getStackTrace(1);
+        LOG(info, "mmap %ld of size %ld (paged) from %s", mmapId, sz, stackTrace.c_str());
+    }
+    // The mapping keeps the (unlinked) file alive until it is unmapped.
+    void * buf = mmap(nullptr, sz, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (buf == MAP_FAILED) {
+        throwMMapFailure(sz);
+    }
+    // Avoid read ahead, pages are expected to be accessed sparsely.
+    if (madvise(buf, sz, MADV_RANDOM) != 0) {
+        LOG(debug, "Failed madvise(%p, %ld, MADV_RANDOM) = '%s'", buf, sz, FastOS_FileInterface::getLastErrorString().c_str());
+    }
+    adviseAndTrack(buf, sz, mmapId, stackTrace);
+    return PtrAndSize(buf, sz);
+}
+
+void
+PagedMMapAllocator::free(PtrAndSize alloc) const
+{
+    MMapAllocator::sfree(alloc);
+}
+
+size_t
+PagedMMapAllocator::resize_inplace(PtrAndSize, size_t) const
+{
+    // The backing file is not kept open, so the mapping can not be extended.
+    return 0;
+}
+
+MemoryAllocator::PtrAndSize
+MMapAllocator::smapFile(int fd, size_t offset, size_t sz)
+{
+    assert((offset % _G_pageSize) == 0);
+    sz = roundUp2PageSize(sz);
+    if (sz == 0) {
+        return PtrAndSize(nullptr, 0);
+    }
+    size_t mmapId = std::atomic_fetch_add(&_G_mmapCount, 1ul);
+    string stackTrace;
+    if (sz >= _G_MMapLogLimit) {
+        stackTrace = getStackTrace(1);
+        LOG(info, "mmap %ld of file (fd %d, offset %ld) of size %ld from %s", mmapId, fd, offset, sz, stackTrace.c_str());
+    }
+    void * buf = mmap(nullptr, sz, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, offset);
+    if (buf == MAP_FAILED) {
+        LOG(warning, "Failed mmaping file (fd %d, offset %ld) of size %ld: '%s'",
+            fd, offset, sz, FastOS_FileInterface::getLastErrorString().c_str());
+        return PtrAndSize(nullptr, 0);
+    }
+    if (sz >= _G_MMapNoCoreLimit) {
+        if (madvise(buf, sz, MADV_DONTDUMP) != 0) {
+            LOG(warning, "Failed madvise(%p, %ld, MADV_DONTDUMP) = '%s'", buf, sz, FastOS_FileInterface::getLastErrorString().c_str());
         }
     }
+    if (sz >= _G_MMapLogLimit) {
+        LockGuard guard(_G_lock);
+        _G_HugeMappings[buf] = MMapInfo(mmapId, sz, stackTrace);
+        LOG(info, "%ld mappings of accumulated size %ld", _G_HugeMappings.size(), sum(_G_HugeMappings));
+    }
     return PtrAndSize(buf, sz);
 }
 
@@ -465,6 +697,46 @@ Alloc::allocMMap(size_t sz)
     return Alloc(&MMapAllocator::getDefault(), sz);
 }
 
+Alloc
+Alloc::allocHugePages(size_t sz)
+{
+    return Alloc(&HugePageMMapAllocator::getDefault(), sz);
+}
+
+Alloc
+Alloc::allocPaged(size_t sz)
+{
+    return Alloc(&PagedMMapAllocator::getDefault(), sz);
+}
+
+size_t
+Alloc::residentSize() const
+{
+    if ((_alloc.first == nullptr) || !isPaged()) {
+        return size();
+    }
+    size_t pageSize = _G_pageSize;
+    std::vector<unsigned char> residency((size() + pageSize - 1) / pageSize);
+    if (mincore(_alloc.first, size(), &residency[0]) != 0) {
+        return size();
+    }
+    size_t residentPages = 0;
+    for (unsigned char page : residency) {
+        residentPages += (page & 1);
+    }
+    return std::min(size(), residentPages * pageSize);
+}
+
+Alloc
+Alloc::mmapFilePrivate(int fd, size_t offset, size_t sz)
+{
+    PtrAndSize mapped = MMapAllocator::smapFile(fd, offset, sz);
+    if (mapped.first == nullptr) {
+        return Alloc();
+    }
+    return Alloc(&MMapAllocator::getDefault(), mapped);
+}
+
 Alloc
 Alloc::alloc(size_t sz, size_t mmapLimit, size_t alignment)
 {
@@ -27,6 +27,14 @@ public:
      * @return true if successful.
      */
     virtual size_t resize_inplace(PtrAndSize current, size_t newSize) const = 0;
+    /*
+     * Tells if allocations are aligned to and advised to be backed by transparent huge pages.
+     */
+    virtual bool usesHugePages() const { return false; }
+    /*
+     * Tells if allocations are backed by a file, so the kernel can page them out.
+     */
+    virtual bool isPaged() const { return false; }
     static size_t roundUpToHugePages(size_t sz) {
         return (sz+(HUGEPAGE_SIZE-1)) & ~(HUGEPAGE_SIZE-1);
     }
@@ -57,6 +65,13 @@ public:
      * @return true if successful.
      */
     bool resize_inplace(size_t newSize);
+    bool usesHugePages() const { return (_allocator != nullptr) && _allocator->usesHugePages(); }
+    bool isPaged() const { return (_allocator != nullptr) && _allocator->isPaged(); }
+    /*
+     * Number of bytes currently resident in memory. Only paged allocations
+     * can be partially resident, other allocations report their full size.
+     */
+    size_t residentSize() const;
     Alloc(const Alloc &) = delete;
     Alloc & operator = (const Alloc &) = delete;
     Alloc(Alloc && rhs) :
@@ -94,6 +109,32 @@ public:
     static Alloc allocAlignedHeap(size_t sz, size_t alignment);
     static Alloc allocHeap(size_t sz=0);
     static Alloc allocMMap(size_t sz=0);
+    /**
+     * Anonymous mmap aligned to and rounded up to whole huge pages, advised
+     * (MADV_HUGEPAGE) to be backed by transparent huge pages. Reduces TLB
+     * misses for large randomly accessed buffers. Falls back to normal pages
+     * if transparent huge pages are not available.
+     */
+    static Alloc allocHugePages(size_t sz=0);
+    /**
+     * Maps sz bytes of the given file, starting at offset, with a private
+     * (copy-on-write) mapping. Pages are read from the file when first
+     * accessed and copied when first written; changes are never written
+     * back to the file. The offset must be a multiple of the page size.
+     * The allocation is released and resized like an anonymous mmap.
+     * Returns an empty allocation if the file could not be mapped.
+     */
+    static Alloc mmapFilePrivate(int fd, size_t offset, size_t sz);
+    /**
+     * Shared mmap of an unlinked temporary file, created in the directory
+     * given by VESPA_PAGED_ALLOC_DIR (or TMPDIR, default /tmp). The page
+     * cache keeps the hot pages resident, while cold pages are written back
+     * and evicted under memory pressure instead of occupying RAM. Meant
+     * for large, rarely accessed data. Read ahead is disabled. Falls back
+     * to anonymous memory if the file can not be created. These
+     * allocations can not be resized in place.
+     */
+    static Alloc allocPaged(size_t sz=0);
     /**
      * Optional alignment is assumed to be <= system page size, since mmap
      * is always used when size is above limit.
@@ -101,6 +142,7 @@ public:
     static Alloc alloc(size_t sz=0, size_t mmapLimit = MemoryAllocator::HUGEPAGE_SIZE, size_t alignment=0);
 private:
     Alloc(const MemoryAllocator * allocator, size_t sz) : _alloc(allocator->alloc(sz)), _allocator(allocator) { }
+    Alloc(const MemoryAllocator * allocator, PtrAndSize alloc) : _alloc(alloc), _allocator(allocator) { }
     void clear() {
         _alloc.first = nullptr;
         _alloc.second = 0;
@@ -21,20 +21,21 @@ struct CompressionConfig {
     };
 
     CompressionConfig()
-        : type(NONE), compressionLevel(0), threshold(90), minSize(0) {}
+        : type(NONE), compressionLevel(0), threshold(90), minSize(0), acceleration(1) {}
     CompressionConfig(Type t)
-        : type(t), compressionLevel(9), threshold(90), minSize(0) {}
+        : type(t), compressionLevel(9), threshold(90), minSize(0), acceleration(1) {}
 
     CompressionConfig(Type t, uint8_t level, uint8_t minRes)
-        : type(t), compressionLevel(level), threshold(minRes), minSize(0) {}
+        : type(t), compressionLevel(level), threshold(minRes), minSize(0), acceleration(1) {}
 
     CompressionConfig(Type t, uint8_t lvl, uint8_t minRes, size_t minSz)
-        : type(t), compressionLevel(lvl), threshold(minRes), minSize(minSz) {}
+        : type(t), compressionLevel(lvl), threshold(minRes), minSize(minSz), acceleration(1) {}
 
     bool operator==(const CompressionConfig& o) const {
         return (type == o.type
                 && compressionLevel == o.compressionLevel
-                && threshold == o.threshold);
+                && threshold == o.threshold
+                && acceleration == o.acceleration);
     }
     bool operator!=(const CompressionConfig& o) const {
         return !operator==(o);
@@ -70,6 +71,9 @@ struct CompressionConfig {
     uint8_t compressionLevel;
     uint8_t threshold;
     size_t minSize;
+    // Used by LZ4 below the high compression levels. Higher values trade
+    // compression ratio for speed, 1 is the regular LZ4 speed.
+    uint8_t acceleration;
 };
 
 class CompressionInfo
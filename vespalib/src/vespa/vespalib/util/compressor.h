@@ -8,6 +8,8 @@ namespace vespalib { class DataBuffer; }
 
 namespace vespalib::compression {
 
+class ZStdDictionary;
+
 class ICompressor
 {
 public:
@@ -28,6 +30,12 @@ public:
  */
 CompressionConfig::Type compress(const CompressionConfig & compression, const vespalib::ConstBufferRef & org, vespalib::DataBuffer & dest, bool allowSwap);
 
+/**
+ * As above, but zstd compression will use the given dictionary if it is non-null.
+ */
+CompressionConfig::Type compress(const CompressionConfig & compression, const vespalib::ConstBufferRef & org, vespalib::DataBuffer & dest, bool allowSwap,
+                                 const ZStdDictionary * dictionary);
+
 /**
  * Will try to decompress a buffer according to the config.
  * be met it will return NONE and dest will get the input buffer.
@@ -41,6 +49,13 @@ CompressionConfig::Type compress(const CompressionConfig & compression, const ve
  */
 void decompress(const CompressionConfig::Type & compression, size_t uncompressedLen, const vespalib::ConstBufferRef & org, vespalib::DataBuffer & dest, bool allowSwap);
 
+/**
+ * As above, but zstd decompression will use the given dictionary if it is non-null.
+ * It must be the dictionary the buffer was compressed with, if any.
+ */
+void decompress(const CompressionConfig::Type & compression, size_t uncompressedLen, const vespalib::ConstBufferRef & org, vespalib::DataBuffer & dest, bool allowSwap,
+                const ZStdDictionary * dictionary);
+
 size_t computeMaxCompressedsize(CompressionConfig::Type type, size_t uncompressedSize);
 
 }
@@ -1,16 +1,86 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "generationhandler.h"
+#include <algorithm>
 
 namespace vespalib {
 
+namespace {
+
+std::atomic<uint32_t> nextReaderThread(0);
+
+// Reader threads are spread evenly across reader slots
+uint32_t
+readerThreadId()
+{
+    thread_local uint32_t id = nextReaderThread.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+}
+
+GenerationHandler::GenerationHold::GenerationHold(uint32_t numSlots)
+    : _slots(new ReaderSlot[numSlots]),
+      _numSlots(numSlots),
+      _generation(0),
+      _next(0)
+{
+}
+
+GenerationHandler::GenerationHold::~GenerationHold()
+{
+    assert(getRefCount() == 0);
+}
+
+void
+GenerationHandler::GenerationHold::setValid()
+{
+    for (uint32_t slot = 0; slot < _numSlots; ++slot) {
+        assert(!valid(refCount(slot)));
+        refCount(slot).fetch_sub(1);
+    }
+}
+
+bool
+GenerationHandler::GenerationHold::setInvalid()
+{
+    for (uint32_t slot = 0; slot < _numSlots; ++slot) {
+        uint32_t refs = refCount(slot);
+        assert(valid(refs));
+        if ((refs != 0) ||
+            !refCount(slot).compare_exchange_strong(refs, 1, std::memory_order_seq_cst))
+        {
+            // Slot still in use, revert slots already marked invalid.
+            // Readers failing to acquire them in the meantime retry on
+            // the newest generation.
+            for (uint32_t i = 0; i < slot; ++i) {
+                refCount(i).fetch_sub(1);
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t
+GenerationHandler::GenerationHold::getRefCount() const
+{
+    uint32_t refs = 0;
+    for (uint32_t slot = 0; slot < _numSlots; ++slot) {
+        refs += _slots[slot]._refCount / 2;
+    }
+    return refs;
+}
+
 GenerationHandler::Guard::Guard()
-    : _hold(nullptr)
+    : _hold(nullptr),
+      _slot(0)
 {
 }
 
-GenerationHandler::Guard::Guard(GenerationHold *hold)
-    : _hold(hold->acquire())
+GenerationHandler::Guard::Guard(GenerationHold *hold, uint32_t slot)
+    : _hold(hold->acquire(slot)),
+      _slot(slot)
 {
 }
 
@@ -20,12 +90,14 @@ GenerationHandler::Guard::~Guard()
 }
 
 GenerationHandler::Guard::Guard(const Guard & rhs)
-    : _hold(GenerationHold::copy(rhs._hold))
+    : _hold(GenerationHold::copy(rhs._hold, rhs._slot)),
+      _slot(rhs._slot)
 {
 }
 
 GenerationHandler::Guard::Guard(Guard &&rhs)
-    : _hold(rhs._hold)
+    : _hold(rhs._hold),
+      _slot(rhs._slot)
 {
     rhs._hold = nullptr;
 }
@@ -35,7 +107,8 @@ GenerationHandler::Guard::operator=(const Guard & rhs)
 {
     if (&rhs != this) {
         cleanup();
-        _hold = GenerationHold::copy(rhs._hold);
+        _hold = GenerationHold::copy(rhs._hold, rhs._slot);
+        _slot = rhs._slot;
     }
     return *this;
 }
@@ -46,6 +119,7 @@ GenerationHandler::Guard::operator=(Guard &&rhs)
     if (&rhs != this) {
         cleanup();
         _hold = rhs._hold;
+        _slot = rhs._slot;
         rhs._hold = nullptr;
     }
     return *this;
@@ -74,15 +148,16 @@ GenerationHandler::updateFirstUsedGeneration()
 }
 
 
-GenerationHandler::GenerationHandler()
+GenerationHandler::GenerationHandler(uint32_t numReaderSlots)
     : _generation(0),
       _firstUsedGeneration(0),
       _last(nullptr),
       _first(nullptr),
       _free(nullptr),
-      _numHolds(0u)
+      _numHolds(0u),
+      _numReaderSlots(std::max(numReaderSlots, 1u))
 {
-    _last = _first = new GenerationHold;
+    _last = _first = new GenerationHold(_numReaderSlots);
     ++_numHolds;
     _last->_generation = _generation;
     _last->setValid();
@@ -104,10 +179,17 @@ GenerationHandler::~GenerationHandler(void)
     delete _first;
 }
 
+uint32_t
+GenerationHandler::readerSlot() const
+{
+    return (_numReaderSlots == 1) ? 0 : (readerThreadId() % _numReaderSlots);
+}
+
 GenerationHandler::Guard
 GenerationHandler::takeGuard() const
 {
-    Guard guard(_last);
+    uint32_t slot = readerSlot();
+    Guard guard(_last, slot);
     for (;;) {
         // Must check valid() after increasing refcount
         std::atomic_thread_fence(std::memory_order_acquire);
@@ -117,7 +199,7 @@ GenerationHandler::takeGuard() const
          * Clashed with writer freeing entry.  Must abandon current
          * guard and try again.
          */
-        guard = Guard(_last);
+        guard = Guard(_last, slot);
     }
     // Guard has been valid after bumping refCount
     return guard;
@@ -140,7 +222,7 @@ GenerationHandler::incGeneration()
     }
     GenerationHold *nhold = nullptr;
     if (_free == nullptr) {
-        nhold = new GenerationHold;
+        nhold = new GenerationHold(_numReaderSlots);
         ++_numHolds;
     } else {
         nhold = _free;
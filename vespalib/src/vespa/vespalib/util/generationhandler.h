@@ -5,6 +5,7 @@
 #include <stdint.h>
 #include <atomic>
 #include <cassert>
+#include <memory>
 
 namespace vespalib {
 
@@ -23,61 +24,57 @@ public:
      * This must be type stable memory, and cannot be freed before the
      * GenerationHandler is freed (i.e. when external methods ensure that
      * no readers are still active).
+     *
+     * The reference count is split into one or more reader slots, each
+     * on its own cache line. Readers use the slot selected by their
+     * thread, so that concurrent readers taking guards on the same
+     * generation do not all write to the same cache line. The writer
+     * sums the slots, and can only invalidate the hold when all slots
+     * are unused.
      */
     class GenerationHold
     {
-        // least significant bit is invalid flag
-        std::atomic<uint32_t> _refCount;
+        struct alignas(64) ReaderSlot {
+            // least significant bit is invalid flag
+            std::atomic<uint32_t> _refCount;
+            ReaderSlot() : _refCount(1) { }
+        };
+
+        std::unique_ptr<ReaderSlot[]> _slots;
+        uint32_t                      _numSlots;
 
         static bool valid(uint32_t refCount) { return (refCount & 1) == 0u; }
+        std::atomic<uint32_t> &refCount(uint32_t slot) { return _slots[slot]._refCount; }
     public:
         generation_t _generation;
         GenerationHold *_next;	// next free element or next newer element.
 
-        GenerationHold(void)
-            : _refCount(1),
-              _generation(0),
-              _next(0)
-        { }
-
-        ~GenerationHold()
-        {
-            assert(getRefCount() == 0);
-        }
+        GenerationHold(uint32_t numSlots);
+        ~GenerationHold();
 
-        void setValid() {
-            assert(!valid(_refCount));
-            _refCount.fetch_sub(1);
-        }
-        bool setInvalid() {
-            uint32_t refs = _refCount;
-            assert(valid(refs));
-            if (refs != 0) {
-                return false;
-            }
-            return _refCount.compare_exchange_strong(refs, 1,
-                                                     std::memory_order_seq_cst);
-        }
-        void release() { _refCount.fetch_sub(2); }
-        GenerationHold *acquire() {
-            if (valid(_refCount.fetch_add(2))) {
+        void setValid();
+        bool setInvalid();
+        void release(uint32_t slot) { refCount(slot).fetch_sub(2); }
+        GenerationHold *acquire(uint32_t slot) {
+            if (valid(refCount(slot).fetch_add(2))) {
                 return this;
             } else {
-                release();
+                release(slot);
                 return nullptr;
             }
         }
-        static GenerationHold *copy(GenerationHold *self) {
+        static GenerationHold *copy(GenerationHold *self, uint32_t slot) {
             if (self == nullptr) {
                 return nullptr;
             } else {
-                uint32_t oldRefCount = self->_refCount.fetch_add(2);
+                uint32_t oldRefCount = self->refCount(slot).fetch_add(2);
                 (void) oldRefCount;
                 assert(valid(oldRefCount));
                 return self;
             }
         }
-        uint32_t getRefCount() const { return _refCount / 2; }
+        uint32_t getRefCount() const;
+        uint32_t getNumSlots() const { return _numSlots; }
     };
 
     /**
@@ -86,15 +83,16 @@ public:
     class Guard {
     private:
         GenerationHold *_hold;
+        uint32_t        _slot;
         void cleanup() {
             if (_hold != nullptr) {
-                _hold->release();
+                _hold->release(_slot);
                 _hold = nullptr;
             }
         }
     public:
         Guard();
-        Guard(GenerationHold *hold); // hold is never nullptr
+        Guard(GenerationHold *hold, uint32_t slot); // hold is never nullptr
         ~Guard();
         Guard(const Guard & rhs);
         Guard(Guard &&rhs);
@@ -114,12 +112,19 @@ private:
     GenerationHold *_first;	// Points to "firstUsedGeneration" entry
     GenerationHold *_free;	// List of free entries
     uint32_t _numHolds;		// Number of allocated generation hold entries
+    uint32_t _numReaderSlots;	// Number of reader slots per generation hold
+
+    uint32_t readerSlot() const;
 
 public:
     /**
-     * Creates a new generation handler.
+     * Creates a new generation handler. With more than one reader slot,
+     * readers in different threads (mostly) update different cache
+     * lines when taking and releasing guards, at the cost of a larger
+     * generation hold and a slightly more expensive writer side. Use
+     * this for structures read by many threads concurrently.
      **/
-    GenerationHandler();
+    GenerationHandler(uint32_t numReaderSlots = 1);
 
     ~GenerationHandler();
 
@@ -4,12 +4,29 @@
 #include <vespa/vespalib/util/alloc.h>
 #include <lz4.h>
 #include <lz4hc.h>
+#include <algorithm>
 #include <cassert>
 
 using vespalib::alloc::Alloc;
 
 namespace vespalib::compression {
 
+namespace {
+
+thread_local Alloc _tlFastState;
+thread_local Alloc _tlHCState;
+
+void *
+getState(Alloc & state, size_t sz)
+{
+    if (state.size() < sz) {
+        state = Alloc::alloc(sz);
+    }
+    return state.get();
+}
+
+}
+
 size_t LZ4Compressor::adjustProcessLen(uint16_t, size_t len)   const { return LZ4_compressBound(len); }
 
 bool
@@ -20,11 +37,12 @@ LZ4Compressor::process(const CompressionConfig& config, const void * inputV, siz
     int sz(-1);
     int maxOutputLen = LZ4_compressBound(inputLen);
     if (config.compressionLevel > 6) {
-        Alloc state = Alloc::alloc(LZ4_sizeofStateHC());
-        sz = LZ4_compress_HC_extStateHC(state.get(), input, output, inputLen, maxOutputLen, config.compressionLevel);
+        void * state = getState(_tlHCState, LZ4_sizeofStateHC());
+        sz = LZ4_compress_HC_extStateHC(state, input, output, inputLen, maxOutputLen, config.compressionLevel);
     } else {
-        Alloc state = Alloc::alloc(LZ4_sizeofState());
-        sz = LZ4_compress_fast_extState(state.get(), input, output, inputLen, maxOutputLen, 1);
+        void * state = getState(_tlFastState, LZ4_sizeofState());
+        int acceleration = std::max(1, int(config.acceleration));
+        sz = LZ4_compress_fast_extState(state, input, output, inputLen, maxOutputLen, acceleration);
     }
     assert(sz != 0);
     outputLenV = sz;
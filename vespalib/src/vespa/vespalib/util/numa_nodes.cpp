@@ -0,0 +1,120 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "numa_nodes.h"
+#include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+#include <pthread.h>
+#include <sched.h>
+
+namespace vespalib {
+
+namespace {
+
+const vespalib::string SYSFS_NODE_DIR("/sys/devices/system/node");
+
+vespalib::string
+readFirstLine(const vespalib::string &fileName)
+{
+    std::ifstream file(fileName.c_str());
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+std::vector<NumaNodes::CpuList>
+loadNodes()
+{
+    std::vector<NumaNodes::CpuList> nodes;
+    for (int node : NumaNodes::parseList(readFirstLine(SYSFS_NODE_DIR + "/online"))) {
+        NumaNodes::CpuList cpus = NumaNodes::parseList(readFirstLine(make_string("%s/node%d/cpulist", SYSFS_NODE_DIR.c_str(), node)));
+        if (!cpus.empty()) {
+            nodes.push_back(std::move(cpus));
+        }
+    }
+    if (nodes.empty()) {
+        NumaNodes::CpuList cpus;
+        for (int cpu = 0, n = std::max(1u, std::thread::hardware_concurrency()); cpu < n; ++cpu) {
+            cpus.push_back(cpu);
+        }
+        nodes.push_back(std::move(cpus));
+    }
+    return nodes;
+}
+
+bool
+bindCurrentThreadTo(const NumaNodes::CpuList &cpus)
+{
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (int cpu : cpus) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &cpuSet);
+        }
+    }
+    return (pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0);
+}
+
+} // namespace vespalib::<unnamed>
+
+NumaNodes::NumaNodes()
+    : NumaNodes(loadNodes())
+{
+}
+
+NumaNodes::NumaNodes(std::vector<CpuList> nodes)
+    : _nodes(std::move(nodes)),
+      _allCpus()
+{
+    for (const CpuList &cpus : _nodes) {
+        _allCpus.insert(_allCpus.end(), cpus.begin(), cpus.end());
+    }
+    std::sort(_allCpus.begin(), _allCpus.end());
+}
+
+NumaNodes::~NumaNodes() = default;
+
+bool
+NumaNodes::bindCurrentThread(size_t node) const
+{
+    return bindCurrentThreadTo(_nodes[node % _nodes.size()]);
+}
+
+bool
+NumaNodes::unbindCurrentThread() const
+{
+    return bindCurrentThreadTo(_allCpus);
+}
+
+NumaNodes::CpuList
+NumaNodes::parseList(const vespalib::string &list)
+{
+    CpuList result;
+    const char *pos = list.c_str();
+    while (*pos != '\0') {
+        char *end = nullptr;
+        long first = strtol(pos, &end, 10);
+        if (end == pos) {
+            break;
+        }
+        long last = first;
+        pos = end;
+        if (*pos == '-') {
+            last = strtol(pos + 1, &end, 10);
+            pos = end;
+        }
+        for (long i = first; i <= last; ++i) {
+            result.push_back(i);
+        }
+        if (*pos == ',') {
+            ++pos;
+        } else {
+            break;
+        }
+    }
+    return result;
+}
+
+} // namespace vespalib
@@ -0,0 +1,47 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <vector>
+
+namespace vespalib {
+
+/**
+ * The NUMA nodes of this host, with the cpus belonging to each of
+ * them, as reported by sysfs. A host without NUMA information is
+ * seen as a single node holding all online cpus.
+ **/
+class NumaNodes
+{
+public:
+    using CpuList = std::vector<int>;
+private:
+    std::vector<CpuList> _nodes;
+    CpuList              _allCpus;
+public:
+    NumaNodes();
+    NumaNodes(std::vector<CpuList> nodes);
+    ~NumaNodes();
+    size_t size() const { return _nodes.size(); }
+    const CpuList &cpus(size_t node) const { return _nodes[node]; }
+    const CpuList &allCpus() const { return _allCpus; }
+
+    /**
+     * Restrict the calling thread to the cpus of the given node.
+     * @return false if the affinity could not be set.
+     **/
+    bool bindCurrentThread(size_t node) const;
+
+    /**
+     * Let the calling thread run on any cpu again.
+     **/
+    bool unbindCurrentThread() const;
+
+    /**
+     * Parse a sysfs cpu/node list like "0-3,8,10-11".
+     **/
+    static CpuList parseList(const vespalib::string &list);
+};
+
+} // namespace vespalib
@@ -49,50 +49,71 @@ Runnable::UP chain(Runnable::UP first, Runnable::UP second) {
 
 //-----------------------------------------------------------------------------
 
-SimpleThreadBundle::Pool::Pool(size_t bundleSize)
+SimpleThreadBundle::Pool::Pool(size_t bundleSize, const NumaNodes *numaNodes)
     : _lock(),
       _bundleSize(bundleSize),
-      _bundles()
+      _numaNodes(numaNodes),
+      _nextNode(0),
+      _bundles((numaNodes != nullptr) ? numaNodes->size() : 1)
 {
 }
 
 SimpleThreadBundle::Pool::~Pool()
 {
-    while (!_bundles.empty()) {
-        delete _bundles.back();
-        _bundles.pop_back();
+    for (auto &bundles : _bundles) {
+        while (!bundles.empty()) {
+            delete bundles.back();
+            bundles.pop_back();
+        }
     }
 }
 
 SimpleThreadBundle::UP
 SimpleThreadBundle::Pool::obtain()
 {
+    size_t node = 0;
     {
         LockGuard guard(_lock);
-        if (!_bundles.empty()) {
-            SimpleThreadBundle::UP ret(_bundles.back());
-            _bundles.pop_back();
+        node = _nextNode;
+        _nextNode = (_nextNode + 1) % _bundles.size();
+        std::vector<SimpleThreadBundle*> &bundles = _bundles[node];
+        if (!bundles.empty()) {
+            SimpleThreadBundle::UP ret(bundles.back());
+            bundles.pop_back();
             return ret;
         }
     }
-    return SimpleThreadBundle::UP(new SimpleThreadBundle(_bundleSize));
+    return (_numaNodes != nullptr)
+        ? SimpleThreadBundle::UP(new SimpleThreadBundle(_bundleSize, *_numaNodes, node))
+        : SimpleThreadBundle::UP(new SimpleThreadBundle(_bundleSize));
 }
 
 void
 SimpleThreadBundle::Pool::release(SimpleThreadBundle::UP bundle)
 {
     LockGuard guard(_lock);
-    _bundles.push_back(bundle.get());
+    _bundles[bundle->numaNode() % _bundles.size()].push_back(bundle.get());
     bundle.release();
 }
 
 //-----------------------------------------------------------------------------
 
 SimpleThreadBundle::SimpleThreadBundle(size_t size_in, Strategy strategy)
+    : SimpleThreadBundle(size_in, nullptr, 0, strategy)
+{
+}
+
+SimpleThreadBundle::SimpleThreadBundle(size_t size_in, const NumaNodes &numaNodes, size_t numaNode, Strategy strategy)
+    : SimpleThreadBundle(size_in, &numaNodes, numaNode, strategy)
+{
+}
+
+SimpleThreadBundle::SimpleThreadBundle(size_t size_in, const NumaNodes *numaNodes, size_t numaNode, Strategy strategy)
     : _work(),
       _signals(),
       _workers(),
-      _hook()
+      _hook(),
+      _numaNode(numaNode)
 {
     if (size_in == 0) {
         throw IllegalArgumentException("size must be greater than 0");
@@ -123,7 +144,7 @@ SimpleThreadBundle::SimpleThreadBundle(size_t size_in, Strategy strategy)
             _hook = std::move(hook);
         } else {
             size_t signal_idx = (strategy == USE_BROADCAST) ? 0 : (i - 1);
-            _workers.push_back(std::make_unique<Worker>(_signals[signal_idx], std::move(hook)));
+            _workers.push_back(std::make_unique<Worker>(_signals[signal_idx], std::move(hook), numaNodes, numaNode));
         }
     }
 }
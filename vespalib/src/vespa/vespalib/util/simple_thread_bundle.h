@@ -8,6 +8,7 @@
 #include "runnable.h"
 #include "thread_bundle.h"
 #include "noncopyable.hpp"
+#include "numa_nodes.h"
 
 namespace vespalib {
 
@@ -91,15 +92,22 @@ public:
     typedef std::unique_ptr<SimpleThreadBundle> UP;
     enum Strategy { USE_SIGNAL_LIST, USE_SIGNAL_TREE, USE_BROADCAST };
 
+    /**
+     * Pool of bundles. If NUMA nodes are given, the threads of each
+     * bundle are bound to a single node, and bundles from the nodes
+     * are handed out round robin.
+     **/
     class Pool
     {
     private:
         Lock _lock;
         size_t _bundleSize;
-        std::vector<SimpleThreadBundle*> _bundles;
+        const NumaNodes *_numaNodes;
+        size_t _nextNode;
+        std::vector<std::vector<SimpleThreadBundle*>> _bundles;
 
     public:
-        Pool(size_t bundleSize);
+        Pool(size_t bundleSize, const NumaNodes *numaNodes = nullptr);
         ~Pool();
         SimpleThreadBundle::UP obtain();
         void release(SimpleThreadBundle::UP bundle);
@@ -111,10 +119,17 @@ private:
         Thread thread;
         Signal &signal;
         Runnable::UP hook;
-        Worker(Signal &s, Runnable::UP h) : thread(*this), signal(s), hook(std::move(h)) {
+        const NumaNodes *numaNodes;
+        size_t numaNode;
+        Worker(Signal &s, Runnable::UP h, const NumaNodes *nodes, size_t node)
+            : thread(*this), signal(s), hook(std::move(h)), numaNodes(nodes), numaNode(node)
+        {
             thread.start();
         }
         void run() override {
+            if (numaNodes != nullptr) {
+                numaNodes->bindCurrentThread(numaNode);
+            }
             for (size_t gen = 0; signal.wait(gen) > 0; ) {
                 hook->run();
             }
@@ -125,10 +140,19 @@ private:
     std::vector<Signal>     _signals;
     std::vector<Worker::UP> _workers;
     Runnable::UP            _hook;
+    size_t                  _numaNode;
+
+    SimpleThreadBundle(size_t size, const NumaNodes *numaNodes, size_t numaNode, Strategy strategy);
 
 public:
     SimpleThreadBundle(size_t size, Strategy strategy = USE_SIGNAL_LIST);
+    /**
+     * All internal threads are bound to the given NUMA node. The
+     * thread calling run is left to the caller.
+     **/
+    SimpleThreadBundle(size_t size, const NumaNodes &numaNodes, size_t numaNode, Strategy strategy = USE_SIGNAL_LIST);
     ~SimpleThreadBundle();
+    size_t numaNode() const { return _numaNode; }
     size_t size() const override;
     void run(const std::vector<Runnable*> &targets) override;
 };
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "runnable.h"
+#include <algorithm>
 #include <vector>
 
 namespace vespalib {
@@ -35,5 +36,24 @@ struct ThreadBundle {
     virtual ~ThreadBundle() {}
 };
 
+/**
+ * Exposes only the first maxThreads threads of another thread bundle.
+ **/
+class LimitedThreadBundleWrapper final : public ThreadBundle
+{
+public:
+    LimitedThreadBundleWrapper(ThreadBundle &threadBundle, size_t maxThreads)
+        : _threadBundle(threadBundle),
+          _maxThreads(std::max(size_t(1), std::min(maxThreads, threadBundle.size())))
+    { }
+    size_t size() const override { return _maxThreads; }
+    void run(const std::vector<Runnable*> &targets) override {
+        _threadBundle.run(targets);
+    }
+private:
+    ThreadBundle &_threadBundle;
+    const size_t  _maxThreads;
+};
+
 } // namespace vespalib
 
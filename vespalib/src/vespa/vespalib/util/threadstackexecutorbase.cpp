@@ -2,9 +2,33 @@
 
 #include "threadstackexecutorbase.h"
 #include <vespa/fastos/thread.h>
+#include <algorithm>
 
 namespace vespalib {
 
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// lower bound on the spin budget after it has been increased
+constexpr uint64_t MIN_SPIN_BUDGET = 1000;
+
+uint64_t elapsed_ns(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+double to_s(Clock::duration duration) {
+    return std::chrono::duration<double>(duration).count();
+}
+
+void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+}
+
 namespace thread {
 
 struct ThreadInit : public FastOS_Runnable {
@@ -43,6 +67,69 @@ ThreadStackExecutorBase::BlockedThread::unblock()
 
 //-----------------------------------------------------------------------------
 
+ThreadStackExecutorBase::Stats::Stats()
+    : maxPendingTasks(0),
+      acceptedTasks(0),
+      rejectedTasks(0),
+      executedTasks(0),
+      totalQueueTime(0.0),
+      maxQueueTime(0.0),
+      busyTime(0.0),
+      threadTime(0.0),
+      queueTimeHistogram()
+{
+    queueTimeHistogram.fill(0);
+}
+
+ThreadStackExecutorBase::Stats &
+ThreadStackExecutorBase::Stats::operator+=(const Stats &rhs)
+{
+    maxPendingTasks += rhs.maxPendingTasks;
+    acceptedTasks += rhs.acceptedTasks;
+    rejectedTasks += rhs.rejectedTasks;
+    executedTasks += rhs.executedTasks;
+    totalQueueTime += rhs.totalQueueTime;
+    maxQueueTime = std::max(maxQueueTime, rhs.maxQueueTime);
+    busyTime += rhs.busyTime;
+    threadTime += rhs.threadTime;
+    for (size_t i = 0; i < QUEUE_TIME_BUCKETS; ++i) {
+        queueTimeHistogram[i] += rhs.queueTimeHistogram[i];
+    }
+    return *this;
+}
+
+void
+ThreadStackExecutorBase::Stats::addExecutedTask(double queueTime, double runTime)
+{
+    ++executedTasks;
+    totalQueueTime += queueTime;
+    maxQueueTime = std::max(maxQueueTime, queueTime);
+    busyTime += runTime;
+    ++queueTimeHistogram[getQueueTimeBucket(queueTime)];
+}
+
+size_t
+ThreadStackExecutorBase::Stats::getQueueTimeBucket(double queueTime)
+{
+    size_t bucket = 0;
+    while ((bucket + 1 < QUEUE_TIME_BUCKETS) && (queueTime >= getQueueTimeBucketLimit(bucket))) {
+        ++bucket;
+    }
+    return bucket;
+}
+
+double
+ThreadStackExecutorBase::Stats::getQueueTimeBucketLimit(size_t bucket)
+{
+    double limit = 0.00001;
+    for (size_t i = 0; i < bucket; ++i) {
+        limit *= 10.0;
+    }
+    return limit;
+}
+
+//-----------------------------------------------------------------------------
+
 void
 ThreadStackExecutorBase::block_thread(const LockGuard &, BlockedThread &blocked_thread)
 {
@@ -72,9 +159,23 @@ ThreadStackExecutorBase::assignTask(TaggedTask task, Worker &worker)
     worker.verify(/* idle: */ true);
     worker.idle = false;
     worker.task = std::move(task);
+    worker.handoff.store(true, std::memory_order_release);
     monitor.signal();
 }
 
+bool
+ThreadStackExecutorBase::spinForTask(Worker &worker)
+{
+    Clock::time_point start = Clock::now();
+    for (size_t i = 1; !worker.handoff.load(std::memory_order_acquire); ++i) {
+        if (((i % 64) == 0) && (elapsed_ns(start) >= worker.spinBudget)) {
+            return false;
+        }
+        cpu_relax();
+    }
+    return true;
+}
+
 bool
 ThreadStackExecutorBase::obtainTask(Worker &worker)
 {
@@ -83,6 +184,7 @@ ThreadStackExecutorBase::obtainTask(Worker &worker)
         if (!worker.idle) {
             assert(_taskCount != 0);
             --_taskCount;
+            _stats.addExecutedTask(worker.queueTime, worker.runTime);
             _barrier.completeEvent(worker.task.token);
             worker.idle = true;
         }
@@ -100,11 +202,28 @@ ThreadStackExecutorBase::obtainTask(Worker &worker)
         }
         _workers.push(&worker);
     }
+    uint64_t maxSpin = _maxIdleSpin.load(std::memory_order_relaxed);
+    Clock::time_point idleStart;
+    bool caught = false;
+    if (maxSpin > 0) {
+        idleStart = Clock::now();
+        caught = (worker.spinBudget > 0) && spinForTask(worker);
+    }
     {
         MonitorGuard monitor(worker.monitor);
         while (worker.idle) {
             monitor.wait();
         }
+        worker.handoff.store(false, std::memory_order_relaxed);
+    }
+    if (maxSpin > 0) {
+        // grow the budget when spinning (a bit longer) would have
+        // caught the task, shrink it when we would have blocked anyway
+        if (caught || (elapsed_ns(idleStart) < maxSpin)) {
+            worker.spinBudget = std::min(maxSpin, std::max(worker.spinBudget * 2, MIN_SPIN_BUDGET));
+        } else {
+            worker.spinBudget /= 2;
+        }
     }
     worker.idle = !worker.task.task;
     return !worker.idle;
@@ -117,8 +236,11 @@ ThreadStackExecutorBase::run()
     worker.verify(/* idle: */ true);
     while (obtainTask(worker)) {
         worker.verify(/* idle: */ false);
+        Clock::time_point start = Clock::now();
+        worker.queueTime = to_s(start - worker.task.enqueued);
         worker.task.task->run();
         worker.task.task.reset();
+        worker.runTime = to_s(Clock::now() - start);
     }
     _executorCompletion.await(); // to allow unsafe signaling
     worker.verify(/* idle: */ true);
@@ -132,6 +254,7 @@ ThreadStackExecutorBase::ThreadStackExecutorBase(uint32_t stackSize,
     : _pool(std::make_unique<FastOS_ThreadPool>(stackSize)),
       _monitor(),
       _stats(),
+      _statsStart(Clock::now()),
       _executorCompletion(),
       _tasks(),
       _workers(),
@@ -139,6 +262,7 @@ ThreadStackExecutorBase::ThreadStackExecutorBase(uint32_t stackSize,
       _taskCount(0),
       _taskLimit(taskLimit),
       _closed(false),
+      _maxIdleSpin(0),
       _thread_init(std::make_unique<thread::ThreadInit>(*this, std::move(init_fun)))
 {
     assert(taskLimit > 0);
@@ -159,6 +283,12 @@ size_t ThreadStackExecutorBase::getNumThreads() const {
     return _pool->GetNumStartedThreads();
 }
 
+void
+ThreadStackExecutorBase::setMaxIdleSpin(std::chrono::nanoseconds maxSpin)
+{
+    _maxIdleSpin.store((maxSpin.count() > 0) ? maxSpin.count() : 0, std::memory_order_relaxed);
+}
+
 void
 ThreadStackExecutorBase::internalSetTaskLimit(uint32_t taskLimit)
 {
@@ -172,10 +302,14 @@ ThreadStackExecutorBase::internalSetTaskLimit(uint32_t taskLimit)
 ThreadStackExecutorBase::Stats
 ThreadStackExecutorBase::getStats()
 {
+    Clock::time_point now = Clock::now();
+    size_t numThreads = getNumThreads();
     LockGuard lock(_monitor);
     Stats stats = _stats;
+    stats.threadTime = to_s(now - _statsStart) * numThreads;
     _stats = Stats();
     _stats.maxPendingTasks = _taskCount;
+    _statsStart = now;
     return stats;
 }
 
@@ -184,7 +318,7 @@ ThreadStackExecutorBase::execute(Task::UP task)
 {
     MonitorGuard monitor(_monitor);
     if (acceptNewTask(monitor)) {
-        TaggedTask taggedTask(std::move(task), _barrier.startEvent());
+        TaggedTask taggedTask(std::move(task), _barrier.startEvent(), Clock::now());
         ++_taskCount;
         ++_stats.acceptedTasks;
         _stats.maxPendingTasks = (_taskCount > _stats.maxPendingTasks)
@@ -8,6 +8,10 @@
 #include "sync.h"
 #include "gate.h"
 #include "runnable.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <vector>
 #include <functional>
@@ -40,22 +44,46 @@ public:
      * all stats are reset each time they are observed.
      **/
     struct Stats {
+        // Bucket i counts tasks that waited less than 10^(i-5)
+        // seconds (10us, 100us, ... 10s); the last bucket is open.
+        static constexpr size_t QUEUE_TIME_BUCKETS = 8;
+        using QueueTimeHistogram = std::array<size_t, QUEUE_TIME_BUCKETS>;
+
         size_t maxPendingTasks;
         size_t acceptedTasks;
         size_t rejectedTasks;
-        Stats() : maxPendingTasks(0), acceptedTasks(0), rejectedTasks(0) {}
+        size_t executedTasks;
+        double totalQueueTime; // seconds tasks waited before being run
+        double maxQueueTime;
+        double busyTime;       // seconds spent running tasks, all threads
+        double threadTime;     // seconds covered by these stats, all threads
+        QueueTimeHistogram queueTimeHistogram;
+        Stats();
+        Stats &operator+=(const Stats &rhs);
+        void addExecutedTask(double queueTime, double runTime);
+        double getAvgQueueTime() const {
+            return (executedTasks > 0) ? (totalQueueTime / executedTasks) : 0.0;
+        }
+        double getUtilization() const {
+            return (threadTime > 0.0) ? std::min(1.0, busyTime / threadTime) : 0.0;
+        }
+        static size_t getQueueTimeBucket(double queueTime);
+        static double getQueueTimeBucketLimit(size_t bucket);
     };
 
     using init_fun_t = std::function<int(Runnable&)>;
 
 private:
 
+    using TimePoint = std::chrono::steady_clock::time_point;
+
     struct TaggedTask {
         Task::UP task;
         uint32_t token;
-        TaggedTask() : task(nullptr), token(0) {}
-        TaggedTask(Task::UP task_in, uint32_t token_in)
-            : task(std::move(task_in)), token(token_in) {}
+        TimePoint enqueued;
+        TaggedTask() : task(nullptr), token(0), enqueued() {}
+        TaggedTask(Task::UP task_in, uint32_t token_in, TimePoint enqueued_in)
+            : task(std::move(task_in)), token(token_in), enqueued(enqueued_in) {}
         TaggedTask(TaggedTask &&rhs) = default;
         TaggedTask(const TaggedTask &rhs) = delete;
         TaggedTask &operator=(const TaggedTask &rhs) = delete;
@@ -63,6 +91,7 @@ private:
             assert(task.get() == nullptr); // no overwrites
             task = std::move(rhs.task);
             token = rhs.token;
+            enqueued = rhs.enqueued;
             return *this;
         }
     };
@@ -73,7 +102,12 @@ private:
         bool       idle;
         uint32_t   post_guard;
         TaggedTask task;
-        Worker() : monitor(), pre_guard(0xaaaaaaaa), idle(true), post_guard(0x55555555), task() {}
+        std::atomic<bool> handoff;
+        uint64_t   spinBudget;
+        double     queueTime; // for the last task run
+        double     runTime;
+        Worker() : monitor(), pre_guard(0xaaaaaaaa), idle(true), post_guard(0x55555555), task(),
+                   handoff(false), spinBudget(0), queueTime(0.0), runTime(0.0) {}
         void verify(bool expect_idle) {
             (void) expect_idle;
             assert(pre_guard == 0xaaaaaaaa);
@@ -101,6 +135,7 @@ private:
     std::unique_ptr<FastOS_ThreadPool>   _pool;
     Monitor                              _monitor;
     Stats                                _stats;
+    TimePoint                            _statsStart;
     Gate                                 _executorCompletion;
     ArrayQueue<TaggedTask>               _tasks;
     ArrayQueue<Worker*>                  _workers;
@@ -109,6 +144,7 @@ private:
     uint32_t                             _taskCount;
     uint32_t                             _taskLimit;
     bool                                 _closed;
+    std::atomic<uint64_t>                _maxIdleSpin;
     std::unique_ptr<thread::ThreadInit>  _thread_init;
 
     void block_thread(const LockGuard &, BlockedThread &blocked_thread);
@@ -133,6 +169,16 @@ private:
      **/
     bool obtainTask(Worker &worker);
 
+    /**
+     * Busy-wait for a task to be handed off to the given idle worker
+     * for at most its current spin budget. The budget is adapted by
+     * obtainTask based on how long the worker actually stayed idle.
+     *
+     * @return true if a task was handed off while spinning
+     * @param worker the idle worker
+     **/
+    bool spinForTask(Worker &worker);
+
     // Runnable (all workers live here)
     void run() override;
 
@@ -197,7 +243,8 @@ public:
     ThreadStackExecutorBase(const ThreadStackExecutorBase &) = delete;
     ThreadStackExecutorBase & operator = (const ThreadStackExecutorBase &) = delete;
     /**
-     * Observe and reset stats for this object.
+     * Observe and reset stats for this object. Queue time and busy
+     * time are accounted when a task completes.
      *
      * @return stats
      **/
@@ -225,6 +272,17 @@ public:
 
     size_t getNumThreads() const override;
 
+    /**
+     * Let idle worker threads spin for up to the given amount of time
+     * before blocking, trading cpu for lower handoff latency when
+     * tasks arrive in quick succession. Each worker adapts its spin
+     * budget within this limit; a limit of 0 (default) disables
+     * spinning.
+     *
+     * @param maxSpin upper limit on the time an idle worker will spin
+     **/
+    void setMaxIdleSpin(std::chrono::nanoseconds maxSpin);
+
     /**
      * Shut down this executor. This will make this executor reject
      * all new tasks.
@@ -3,8 +3,11 @@
 #include "zstdcompressor.h"
 #include <vespa/vespalib/util/alloc.h>
 #include <vespa/vespalib/util/sync.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/data/databuffer.h>
 #include <zstd.h>
-#include <vector>
+#include <zdict.h>
+#include <stdexcept>
 #include <cassert>
 
 using vespalib::alloc::Alloc;
@@ -33,6 +36,67 @@ private:
 thread_local std::unique_ptr<CompressContext>  _tlCompressState;
 thread_local std::unique_ptr<DecompressContext> _tlDecompressState;
 
+void
+checkStreamResult(size_t result)
+{
+    if (ZSTD_isError(result)) {
+        throw std::runtime_error(make_string("zstd stream compression failed: %s", ZSTD_getErrorName(result)));
+    }
+}
+
+}
+
+ZStdDictionary::ZStdDictionary(const void * data, size_t sz)
+    : _data(static_cast<const char *>(data), static_cast<const char *>(data) + sz),
+      _id(ZDICT_getDictID(data, sz)),
+      _decompressDictionary(ZSTD_createDDict(_data.data(), _data.size())),
+      _lock(),
+      _compressDictionaries()
+{
+    if (_decompressDictionary == nullptr) {
+        throw std::runtime_error(make_string("Failed creating zstd dictionary of %zu bytes", sz));
+    }
+}
+
+ZStdDictionary::~ZStdDictionary()
+{
+    for (auto & entry : _compressDictionaries) {
+        ZSTD_freeCDict(entry.second);
+    }
+    ZSTD_freeDDict(_decompressDictionary);
+}
+
+const ZSTD_CDict *
+ZStdDictionary::getCompressDictionary(int compressionLevel) const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    for (const auto & entry : _compressDictionaries) {
+        if (entry.first == compressionLevel) {
+            return entry.second;
+        }
+    }
+    ZSTD_CDict * dictionary = ZSTD_createCDict(_data.data(), _data.size(), compressionLevel);
+    if (dictionary == nullptr) {
+        throw std::runtime_error(make_string("Failed digesting zstd dictionary for compression level %d", compressionLevel));
+    }
+    _compressDictionaries.emplace_back(compressionLevel, dictionary);
+    return dictionary;
+}
+
+std::vector<char>
+ZStdDictionary::train(const ConstBufferRef & samples, const std::vector<size_t> & sampleSizes, size_t maxSize)
+{
+    if (sampleSizes.empty() || (maxSize == 0)) {
+        return std::vector<char>();
+    }
+    std::vector<char> dictionary(maxSize);
+    size_t sz = ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(), samples.data(),
+                                      sampleSizes.data(), sampleSizes.size());
+    if (ZDICT_isError(sz)) {
+        return std::vector<char>();
+    }
+    dictionary.resize(sz);
+    return dictionary;
 }
 
 size_t ZStdCompressor::adjustProcessLen(uint16_t, size_t len)   const { return ZSTD_compressBound(len); }
@@ -44,7 +108,10 @@ ZStdCompressor::process(const CompressionConfig& config, const void * inputV, si
     if ( ! _tlCompressState) {
         _tlCompressState = std::make_unique<CompressContext>();
     }
-    size_t sz = ZSTD_compressCCtx(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen, config.compressionLevel);
+    size_t sz = (_dictionary != nullptr)
+                ? ZSTD_compress_usingCDict(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen,
+                                           _dictionary->getCompressDictionary(config.compressionLevel))
+                : ZSTD_compressCCtx(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen, config.compressionLevel);
     assert( ! ZSTD_isError(sz) );
     outputLenV = sz;
     return ! ZSTD_isError(sz);
@@ -56,10 +123,55 @@ ZStdCompressor::unprocess(const void * inputV, size_t inputLen, void * outputV,
     if ( ! _tlDecompressState) {
         _tlDecompressState = std::make_unique<DecompressContext>();
     }
-    size_t sz = ZSTD_decompressDCtx(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen);
+    size_t sz = (_dictionary != nullptr)
+                ? ZSTD_decompress_usingDDict(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen,
+                                             _dictionary->getDecompressDictionary())
+                : ZSTD_decompressDCtx(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen);
     assert( ! ZSTD_isError(sz) );
     outputLenV = sz;
     return ! ZSTD_isError(sz);
 }
 
+ZStdStreamCompressor::ZStdStreamCompressor(int compressionLevel)
+    : _ctx(ZSTD_createCCtx()),
+      _uncompressedSize(0)
+{
+    checkStreamResult(ZSTD_CCtx_setParameter(_ctx, ZSTD_c_compressionLevel, compressionLevel));
+}
+
+ZStdStreamCompressor::~ZStdStreamCompressor()
+{
+    ZSTD_freeCCtx(_ctx);
+}
+
+void
+ZStdStreamCompressor::add(const ConstBufferRef & input, DataBuffer & dest)
+{
+    ZSTD_inBuffer in = { input.c_str(), input.size(), 0 };
+    while (in.pos < in.size) {
+        dest.ensureFree(ZSTD_CStreamOutSize());
+        ZSTD_outBuffer out = { dest.getFree(), dest.getFreeLen(), 0 };
+        checkStreamResult(ZSTD_compressStream2(_ctx, &out, &in, ZSTD_e_continue));
+        dest.moveFreeToData(out.pos);
+    }
+    _uncompressedSize += input.size();
+}
+
+size_t
+ZStdStreamCompressor::finish(DataBuffer & dest)
+{
+    ZSTD_inBuffer in = { nullptr, 0, 0 };
+    size_t remaining(0);
+    do {
+        dest.ensureFree(ZSTD_CStreamOutSize());
+        ZSTD_outBuffer out = { dest.getFree(), dest.getFreeLen(), 0 };
+        remaining = ZSTD_compressStream2(_ctx, &out, &in, ZSTD_e_end);
+        checkStreamResult(remaining);
+        dest.moveFreeToData(out.pos);
+    } while (remaining != 0);
+    size_t uncompressedSize = _uncompressedSize;
+    _uncompressedSize = 0;
+    return uncompressedSize;
+}
+
 }
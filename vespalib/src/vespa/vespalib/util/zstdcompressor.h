@@ -2,16 +2,92 @@
 #pragma once
 
 #include "compressor.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct ZSTD_CCtx_s;
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
 
 namespace vespalib::compression {
 
+/**
+ * A zstd dictionary trained from samples of the data it will be used for.
+ * It is digested once for decompression, and once per compression level
+ * used, so it can be shared by all threads compressing and decompressing
+ * small buffers of similar content.
+ */
+class ZStdDictionary
+{
+public:
+    using SP = std::shared_ptr<const ZStdDictionary>;
+    ZStdDictionary(const void * data, size_t sz);
+    ZStdDictionary(const ZStdDictionary &) = delete;
+    ZStdDictionary & operator = (const ZStdDictionary &) = delete;
+    ~ZStdDictionary();
+    ConstBufferRef getData() const { return ConstBufferRef(_data.data(), _data.size()); }
+    uint32_t getId() const { return _id; }
+    const ZSTD_CDict_s * getCompressDictionary(int compressionLevel) const;
+    const ZSTD_DDict_s * getDecompressDictionary() const { return _decompressDictionary; }
+
+    /**
+     * Train a dictionary of at most maxSize bytes from the samples that are
+     * stored back to back in samples. Returns an empty vector if there were
+     * too few samples to train a dictionary from.
+     */
+    static std::vector<char> train(const ConstBufferRef & samples, const std::vector<size_t> & sampleSizes, size_t maxSize);
+private:
+    std::vector<char>         _data;
+    uint32_t                  _id;
+    ZSTD_DDict_s            * _decompressDictionary;
+    mutable std::mutex        _lock;
+    mutable std::vector<std::pair<int, ZSTD_CDict_s *>> _compressDictionaries;
+};
+
 class ZStdCompressor : public ICompressor
 {
 public:
+    ZStdCompressor() : ZStdCompressor(nullptr) { }
+    /**
+     * Compress with the given dictionary. A null dictionary gives plain zstd.
+     * Decompressing data compressed without a dictionary is still fine.
+     */
+    ZStdCompressor(const ZStdDictionary * dictionary) : _dictionary(dictionary) { }
     bool process(const CompressionConfig& config, const void * input, size_t inputLen, void * output, size_t & outputLen) override;
     bool unprocess(const void * input, size_t inputLen, void * output, size_t & outputLen) override;
     size_t adjustProcessLen(uint16_t options, size_t len)   const override;
+private:
+    const ZStdDictionary * _dictionary;
 };
 
-}
+/**
+ * Compresses input handed over in pieces into a single zstd frame, so a
+ * caller producing data incrementally does not need to gather it first.
+ * The frame is decompressed with decompress() as any other zstd buffer.
+ * Negative compression levels select the fast zstd modes.
+ */
+class ZStdStreamCompressor
+{
+public:
+    ZStdStreamCompressor(int compressionLevel);
+    ZStdStreamCompressor(const ZStdStreamCompressor &) = delete;
+    ZStdStreamCompressor & operator = (const ZStdStreamCompressor &) = delete;
+    ~ZStdStreamCompressor();
+    /**
+     * Compress more input, appending any output produced so far to dest.
+     */
+    void add(const ConstBufferRef & input, DataBuffer & dest);
+    /**
+     * End the frame, appending the remaining output to dest, and return
+     * the uncompressed size of the frame. The compressor can be used for
+     * a new frame afterwards.
+     */
+    size_t finish(DataBuffer & dest);
+    size_t getUncompressedSize() const { return _uncompressedSize; }
+private:
+    ZSTD_CCtx_s * _ctx;
+    size_t        _uncompressedSize;
+};
 
+}
@@ -23,6 +23,7 @@ public:
     ChunkSList *exchangeAlloc(SizeClassT sc, ChunkSList * csl);
     ChunkSList *exactAlloc(size_t exactSize, SizeClassT sc, ChunkSList * csl) __attribute__((noinline));
     ChunkSList *returnMemory(SizeClassT sc, ChunkSList * csl) __attribute__((noinline));
+    ChunkSList *releaseCache(SizeClassT sc, ChunkSList * csl) __attribute__((noinline));
 
     DataSegment<MemBlockPtrT> & dataSegment()      { return _dataSegment; }
     void enableThreadSupport() __attribute__((noinline));
@@ -37,7 +38,7 @@ private:
     ChunkSList * getFree(SizeClassT sc) __attribute__((noinline));
     ChunkSList * getAlloc(SizeClassT sc) __attribute__((noinline));
     ChunkSList * malloc(const Guard & guard, SizeClassT sc) __attribute__((noinline));
-    ChunkSList * getChunks(const Guard & guard, size_t numChunks) __attribute__((noinline));
+    ChunkSList * getChunks(size_t numChunks) __attribute__((noinline));
     ChunkSList * allocChunkList(const Guard & guard) __attribute__((noinline));
     AllocPoolT(const AllocPoolT & ap);
     AllocPoolT & operator = (const AllocPoolT & ap);
@@ -57,7 +58,8 @@ private:
                  _exchangeAlloc(0),
                  _exchangeFree(0),
                  _exactAlloc(0),
-                 _return(0),_malloc(0) { }
+                 _return(0),_malloc(0),
+                 _releaseCache(0) { }
         std::atomic<size_t> _getAlloc;
         std::atomic<size_t> _getFree;
         std::atomic<size_t> _exchangeAlloc;
@@ -65,15 +67,17 @@ private:
         std::atomic<size_t> _exactAlloc;
         std::atomic<size_t> _return;
         std::atomic<size_t> _malloc;
+        std::atomic<size_t> _releaseCache;
         bool isUsed()       const {
             // Do not count _getFree.
-            return (_getAlloc || _exchangeAlloc || _exchangeFree || _exactAlloc || _return || _malloc);
+            return (_getAlloc || _exchangeAlloc || _exchangeFree || _exactAlloc || _return || _malloc || _releaseCache);
         }
     };
 
-    Mutex                       _mutex;
+    Mutex                       _mutex;       // Protects _chunkPool
     ChunkSList                * _chunkPool;
     AllocFree                   _scList[NUM_SIZE_CLASSES];
+    Mutex                       _scMutex[NUM_SIZE_CLASSES]; // Serializes refills per size class
     DataSegment<MemBlockPtrT> & _dataSegment;
     std::atomic<size_t>         _getChunks;
     std::atomic<size_t>         _getChunksSum;
@@ -32,6 +32,9 @@ template <typename MemBlockPtrT>
 void AllocPoolT<MemBlockPtrT>::enableThreadSupport()
 {
     _mutex.init();
+    for (Mutex & m : _scMutex) {
+        m.init();
+    }
 }
 
 template <typename MemBlockPtrT>
@@ -41,9 +44,9 @@ AllocPoolT<MemBlockPtrT>::getFree(SizeClassT sc)
     typename ChunkSList::AtomicHeadPtr & empty = _scList[sc]._empty;
     ChunkSList * csl(NULL);
     while ((csl = ChunkSList::linkOut(empty)) == NULL) {
-        Guard sync(_mutex);
+        Guard sync(_scMutex[sc]);
         if (empty.load(std::memory_order_relaxed)._ptr == NULL) {
-            ChunkSList * ncsl(getChunks(sync, 1));
+            ChunkSList * ncsl(getChunks(1));
             if (ncsl) {
                 ChunkSList::linkInList(empty, ncsl);
             } else {
@@ -63,7 +66,7 @@ AllocPoolT<MemBlockPtrT>::getAlloc(SizeClassT sc)
     ChunkSList * csl(NULL);
     typename ChunkSList::AtomicHeadPtr & full = _scList[sc]._full;
     while ((csl = ChunkSList::linkOut(full)) == NULL) {
-        Guard sync(_mutex);
+        Guard sync(_scMutex[sc]);
         if (full.load(std::memory_order_relaxed)._ptr == NULL) {
             ChunkSList * ncsl(malloc(sync, sc));
             if (ncsl) {
@@ -149,10 +152,26 @@ AllocPoolT<MemBlockPtrT>::returnMemory(SizeClassT sc,
     return completelyEmpty;
 }
 
+template <typename MemBlockPtrT>
+typename AllocPoolT<MemBlockPtrT>::ChunkSList *
+AllocPoolT<MemBlockPtrT>::releaseCache(SizeClassT sc,
+                                       typename AllocPoolT<MemBlockPtrT>::ChunkSList * csl)
+{
+    ChunkSList * ncsl(csl);
+    if ( ! csl->empty() ) {
+        AllocFree & af = _scList[sc];
+        ChunkSList::linkIn(af._full, csl, csl);
+        ncsl = getFree(sc);
+        USE_STAT2(_stat[sc]._releaseCache.fetch_add(1, std::memory_order_relaxed));
+    }
+    return ncsl;
+}
+
 template <typename MemBlockPtrT>
 typename AllocPoolT<MemBlockPtrT>::ChunkSList *
 AllocPoolT<MemBlockPtrT>::malloc(const Guard & guard, SizeClassT sc)
 {
+    (void) guard;
     const size_t numShifts =
         (sc <= MemBlockPtrT::SizeClassSpan) ? (MemBlockPtrT::SizeClassSpan - sc) : 0;
     size_t numBlocks = 1 << numShifts;
@@ -166,7 +185,7 @@ AllocPoolT<MemBlockPtrT>::malloc(const Guard & guard, SizeClassT sc)
                                                          int(_threadCacheLimit >> (MemBlockPtrT::MinClassSize + sc)))));
 
         const size_t numChunks = (numBlocks+(blocksPerChunk-1))/blocksPerChunk;
-        csl = getChunks(guard, numChunks);
+        csl = getChunks(numChunks);
         if (csl != NULL) {
             char *first = (char *) block;
             const size_t itemSize = cs;
@@ -195,8 +214,9 @@ AllocPoolT<MemBlockPtrT>::malloc(const Guard & guard, SizeClassT sc)
 
 template <typename MemBlockPtrT>
 typename AllocPoolT<MemBlockPtrT>::ChunkSList *
-AllocPoolT<MemBlockPtrT>::getChunks(const Guard & guard, size_t numChunks)
+AllocPoolT<MemBlockPtrT>::getChunks(size_t numChunks)
 {
+    Guard guard(_mutex);
     ChunkSList * csl(_chunkPool);
     ChunkSList * prev(csl);
     bool enough(true);
@@ -256,10 +276,10 @@ void AllocPoolT<MemBlockPtrT>::info(FILE * os, size_t level)
             if (s.isUsed()) {
                 fprintf(os, "SC %2ld(%10ld) GetAlloc(%6ld) GetFree(%6ld) "
                             "ExChangeAlloc(%6ld) ExChangeFree(%6ld) ExactAlloc(%6ld) "
-                            "Returned(%6ld) Malloc(%6ld)\n",
+                            "Returned(%6ld) Malloc(%6ld) ReleaseCache(%6ld)\n",
                             i, MemBlockPtrT::classSize(i), s._getAlloc.load(), s._getFree.load(),
                             s._exchangeAlloc.load(), s._exchangeFree.load(), s._exactAlloc.load(),
-                            s._return.load(), s._malloc.load());
+                            s._return.load(), s._malloc.load(), s._releaseCache.load());
             }
         }
     }
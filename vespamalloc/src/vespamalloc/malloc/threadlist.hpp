@@ -47,6 +47,7 @@ template <typename MemBlockPtrT, typename ThreadStatT>
 bool ThreadListT<MemBlockPtrT, ThreadStatT>::quitThisThread()
 {
     ThreadPool & tp = getCurrent();
+    tp.releaseCache();
     tp.quit();
     _threadCount.fetch_sub(1);
     return true;
@@ -35,6 +35,11 @@ public:
     bool isUsed() const;
     int osThreadId()       const { return _osThreadId; }
     void quit() { _osThreadId = 0; } // Implicit memory barrier
+    /**
+     * Hands all cached blocks back to the global pool, so memory held by
+     * exiting threads can be used by others. Must be called by the owning thread.
+     */
+    void releaseCache() __attribute__((noinline));
     void init(int thrId);
     static void setParams(size_t alwayReuseLimit, size_t threadCacheLimit);
     bool grabAvailable();
@@ -153,6 +153,18 @@ void ThreadPoolT<MemBlockPtrT, ThreadStatT>::free(MemBlockPtrT mem, SizeClassT s
     PARANOID_CHECK2(if (af._freeTo->full()) { *(int *)1 = 1; } );
 }
 
+template <typename MemBlockPtrT, typename ThreadStatT >
+void ThreadPoolT<MemBlockPtrT, ThreadStatT>::releaseCache()
+{
+    for (size_t i=0; (i < NELEMS(_memList)); i++) {
+        AllocFree & af = _memList[i];
+        if (af._allocFrom != NULL) {
+            af._allocFrom = _allocPool->releaseCache(i, af._allocFrom);
+            af._freeTo = _allocPool->releaseCache(i, af._freeTo);
+        }
+    }
+}
+
 template <typename MemBlockPtrT, typename ThreadStatT >
 bool ThreadPoolT<MemBlockPtrT, ThreadStatT>::isActive() const
 {
@@ -520,6 +520,14 @@ TEST("utf8 substring search") {
         fs.maxFieldLength(4);
         assertString(fs, "abc", "abc bcd abc", Hits().add(0));
     }
+    {
+        // ascii only fields are searched on folded bytes, others as ucs4
+        UTF8SubStringFieldSearcher fs(0);
+        assertString(fs, "abc", "xABC, yabc;abcabc", Hits().add(0).add(1).add(2).add(2));
+        assertString(fs, "abc", "x\xc3\xa6bc, yabc;abcabc", Hits().add(1).add(2).add(2));
+        assertString(fs, "a.b", "a.b a-b A.B", Hits().add(0).add(3));
+        assertString(fs, "bc", "abc\x1f\x1f" "bc bc", Hits().add(0).add(0).add(1));
+    }
     {
         UTF8SubstringSnippetModifier fs(0);
         EXPECT_TRUE(testUTF8SubStringFieldSearcher(fs));
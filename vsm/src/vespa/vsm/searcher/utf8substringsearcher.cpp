@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include <vespa/vsm/searcher/utf8substringsearcher.h>
+#include <cstring>
 
 using search::byte;
 using search::QueryTerm;
@@ -46,9 +47,76 @@ UTF8SubStringFieldSearcher::matchTerms(const FieldRef & f, const size_t mintsz)
     return words + 1; // we must also count the last word
 }
 
+bool
+UTF8SubStringFieldSearcher::matchTermAscii(const FieldRef & f, QueryTerm & qt, size_t & words)
+{
+    const cmptype_t * uterm;
+    termsize_t tsz = qt.term(uterm);
+    // A candidate must start with a word character, as the scalar
+    // version does not try to match inside separator sequences.
+    if ((tsz == 0) || (uterm[0] >= 0x80) || !iswordchar(uterm[0])) {
+        return false;
+    }
+    _folded.resize(tsz + f.size());
+    char * term = &_folded[0];
+    for (size_t i(0); i < tsz; i++) {
+        if (uterm[i] >= 0x80) {
+            return false;
+        }
+        term[i] = uterm[i];
+    }
+    const byte * n = reinterpret_cast<const byte *> (f.c_str());
+    char * fn0 = term + tsz;
+    size_t fl(0);
+    for (size_t i(0); i < f.size(); i++) {
+        byte c = n[i];
+        if (c >= 0x80) {
+            return false;
+        }
+        if (!isSeparatorCharacter(c)) {
+            fn0[fl++] = _foldCase[c];
+        }
+    }
+    termcount_t w(0);
+    if (tsz <= fl) {
+        const char * fn = fn0;
+        const char * fre = fn0 + fl - tsz;
+        while (fn <= fre) {
+            const char * candidate = static_cast<const char *>(memchr(fn, term[0], fre + 1 - fn));
+            const char * stop = (candidate != nullptr) ? candidate : (fre + 1);
+            // Count the words in front of the candidate. This is the
+            // scalar loop without the term comparisons that cannot match.
+            while (fn < stop) {
+                if ( ! iswordchar(*fn++) ) {
+                    w++;
+                    for (; (fn < fre) && ! iswordchar(*fn); fn++);
+                }
+            }
+            if (candidate == nullptr) {
+                break;
+            }
+            const char *tt = term, *et = term + tsz, *fnt = fn;
+            for (; (tt < et) && (*tt == *fnt); tt++, fnt++);
+            if (tt == et) {
+                fn = fnt;
+                addHit(qt, w);
+            } else {
+                fn++; // The candidate is a word character
+            }
+        }
+    }
+    NEED_CHAR_STAT(addPureUsAsciiField(f.size()));
+    words = w + 1; // we must also count the last word
+    return true;
+}
+
 size_t
 UTF8SubStringFieldSearcher::matchTerm(const FieldRef & f, QueryTerm & qt)
 {
+    size_t words(0);
+    if (matchTermAscii(f, qt, words)) {
+        return words;
+    }
     return matchTermSubstring(f, qt);
 }
 
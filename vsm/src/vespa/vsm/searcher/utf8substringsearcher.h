@@ -7,16 +7,27 @@ namespace vsm {
 
 /**
  * This class does substring utf8 searches.
+ * Single term searches in fields with only 7-bit ascii characters
+ * are done on folded bytes, using memchr to find the candidate
+ * positions.
  **/
 class UTF8SubStringFieldSearcher : public UTF8StringFieldSearcherBase
 {
 public:
     DUPLICATE(UTF8SubStringFieldSearcher);
-    UTF8SubStringFieldSearcher()             : UTF8StringFieldSearcherBase() { }
-    UTF8SubStringFieldSearcher(FieldIdT fId) : UTF8StringFieldSearcherBase(fId) { }
+    UTF8SubStringFieldSearcher()             : UTF8StringFieldSearcherBase(), _folded() { }
+    UTF8SubStringFieldSearcher(FieldIdT fId) : UTF8StringFieldSearcherBase(fId), _folded() { }
 protected:
     size_t matchTerm(const FieldRef & f, search::QueryTerm & qt) override;
     size_t matchTerms(const FieldRef & f, const size_t shortestTerm) override;
+private:
+    /**
+     * Matches the term the same way as matchTermSubstring, but on
+     * folded bytes. Returns false without adding any hits if the
+     * field or the term contains characters outside 7-bit ascii.
+     **/
+    bool matchTermAscii(const FieldRef & f, search::QueryTerm & qt, size_t & words);
+    std::vector<char> _folded;
 };
 
 }